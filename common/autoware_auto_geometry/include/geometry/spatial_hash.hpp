@@ -24,7 +24,10 @@
 #include <geometry/spatial_hash_config.hpp>
 #include <geometry/visibility_control.hpp>
 
-#include <unordered_map>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -48,6 +51,14 @@ namespace spatial_hash
 /// This implementation can support both 2D and 3D queries
 /// (though only one type per data structure), and can support queries of varying radius. This data
 /// structure cannot do near neighbor lookups for euclidean distance in arbitrary dimensions.
+///
+/// The points are stored in a flat array, which is grouped by bin with a counting sort on the first
+/// query after a modification, so that the points of a bin are contiguous. All buffers are reserved
+/// to the capacity on construction, so that clearing and refilling the data structure every frame
+/// does not allocate.
+///
+/// \note Modifying the data structure invalidates the results of previous near() queries, and the
+/// next query after a modification invalidates all iterators
 template <typename PointT, typename ConfigT>
 class GEOMETRY_PUBLIC SpatialHashBase
 {
@@ -58,8 +69,8 @@ class GEOMETRY_PUBLIC SpatialHashBase
     "SpatialHash only works with Config2d or Config3d");
 
 public:
-  using Hash = std::unordered_multimap<Index, PointT>;
-  using IT = typename Hash::const_iterator;
+  using Points = std::vector<PointT>;
+  using IT = typename Points::const_iterator;
   /// \brief Wrapper around an iterator and a distance (from some query point)
   class Output
   {
@@ -72,7 +83,7 @@ public:
     }
     /// \brief Get stored point
     /// \return A const reference to the stored point
-    const PointT & get_point() const { return m_iterator->second; }
+    const PointT & get_point() const { return *m_iterator; }
     /// \brief Get underlying iterator
     /// \return A copy of the underlying iterator
     IT get_iterator() const { return m_iterator; }
@@ -96,11 +107,34 @@ public:
   /// \param[in] cfg The configuration object for this class
   explicit SpatialHashBase(const ConfigT & cfg)
   : m_config{cfg},
-    m_hash(),
-    m_neighbors{},  // TODO(c.ho) reserve, but there's no default constructor for output
+    m_is_dense{(cfg.get_bin_count() / MAX_DENSE_BINS_PER_POINT) <= cfg.get_capacity()},
+    m_points{},
+    m_bins{},
+    m_sorted_points{},
+    m_sorted_bins{},
+    m_cells{},
+    m_cell_begin{},
+    m_cell_size{},
+    m_is_sorted{true},
+    m_neighbors{},
     m_bins_hit{},   // zero initialization (and below)
     m_neighbors_found{}
   {
+    const Index capacity = m_config.get_capacity();
+    m_points.reserve(capacity);
+    m_bins.reserve(capacity);
+    m_sorted_points.reserve(capacity);
+    m_sorted_bins.reserve(capacity);
+    m_cells.reserve(capacity);
+    if (m_is_dense) {
+      // begin and size of each bin, looked up directly by the bin index
+      m_cell_begin.resize(m_config.get_bin_count());
+      m_cell_size.resize(m_config.get_bin_count());
+    } else {
+      // begin of each occupied bin, looked up by a binary search on the occupied bins
+      m_cell_begin.reserve(capacity + 1U);
+    }
+    m_neighbors.reserve(capacity);
   }
 
   /// \brief Inserts point
@@ -133,39 +167,50 @@ public:
     }
   }
 
-  /// \brief Removes the specified element from the data structure
+  /// \brief Removes the specified element from the data structure by moving the last element in
+  ///        its place
   /// \param[in] point An iterator pointing to a point to be removed
-  /// \return An iterator pointing to the element after the erased element
+  /// \return An iterator pointing to the element after the erased element, i.e. the moved element
   /// \throw std::domain_error If pt is invalid or does not belong to this data structure
   ///
-  /// \note There is no reliable way to check if an iterator is invalid. The checks here are
-  /// based on a heuristic and is not guaranteed to find all invalid iterators. This method
-  /// should be used with care and only on valid iterators
+  /// \note Only iterators which point outside of the stored points are detected as invalid. This
+  /// method should be used with care and only on valid iterators
   IT erase(const IT point)
   {
-    if (end() == m_hash.find(point->first)) {
+    if ((point < cbegin()) || (point >= cend())) {
       throw std::domain_error{"SpatialHash: Attempting to erase invalid iterator"};
     }
-    return m_hash.erase(point);
+    const auto idx = static_cast<Index>(std::distance(cbegin(), point));
+    m_points[idx] = m_points.back();
+    m_bins[idx] = m_bins.back();
+    m_points.pop_back();
+    m_bins.pop_back();
+    m_is_sorted = false;
+    return cbegin() + static_cast<std::ptrdiff_t>(idx);
   }
 
   /// \brief Reset the state of the data structure
-  void clear() { m_hash.clear(); }
+  void clear()
+  {
+    m_points.clear();
+    m_bins.clear();
+    m_is_sorted = false;
+  }
   /// \brief Get current number of element stored in this data structure
   /// \return Number of stored elements
-  Index size() const { return m_hash.size(); }
+  Index size() const { return m_points.size(); }
   /// \brief Get the maximum capacity of the data structure
   /// \return The capacity of the data structure
   Index capacity() const { return m_config.get_capacity(); }
   /// \brief Whether the hash is empty
   /// \return True if data structure is empty
-  bool8_t empty() const { return m_hash.empty(); }
+  bool8_t empty() const { return m_points.empty(); }
   /// \brief Get iterator to beginning of data structure
   /// \return Iterator
-  IT begin() const { return m_hash.begin(); }
+  IT begin() const { return m_points.begin(); }
   /// \brief Get iterator to end of data structure
   /// \return Iterator
-  IT end() const { return m_hash.end(); }
+  IT end() const { return m_points.end(); }
   /// \brief Get iterator to beginning of data structure
   /// \return Iterator
   IT cbegin() const { return begin(); }
@@ -197,11 +242,66 @@ protected:
   {
     // reset output
     m_neighbors.clear();
+    for_each_near(x, y, z, radius, [this](const IT it, const float32_t dist2) {
+      // Only compute true distance if necessary
+      m_neighbors.emplace_back(it, sqrtf(dist2));
+    });
+    return m_neighbors;
+  }
+
+  /// \brief Calls a visitor on all points within a fixed radius of a reference point, without
+  ///        storing them
+  /// \param[in] x The x component of the reference point
+  /// \param[in] y The y component of the reference point
+  /// \param[in] z The z component of the reference point, respected only if the spatial hash is not
+  ///              2D.
+  /// \param[in] radius The radius within which to find all near points
+  /// \param[in] visitor Callable as visitor(const PointT & pt, float32_t distance) for each point
+  /// \tparam VisitorT The visitor type
+  template <typename VisitorT>
+  void visit_near_impl(
+    const float32_t x, const float32_t y, const float32_t z, const float32_t radius,
+    VisitorT && visitor)
+  {
+    for_each_near(x, y, z, radius, [&visitor](const IT it, const float32_t dist2) {
+      visitor(*it, sqrtf(dist2));
+    });
+  }
+
+private:
+  /// \brief Maximum number of bins per point of capacity for which the begin and size of every bin
+  ///        are stored, instead of only those of the occupied bins
+  static constexpr Index MAX_DENSE_BINS_PER_POINT = 16U;
+
+  /// \brief Internal insert method with no error checking
+  /// \param[in] pt The Point to insert
+  GEOMETRY_LOCAL IT insert_impl(const PointT & pt)
+  {
+    // Compute bin
+    const Index idx =
+      m_config.bin(point_adapter::x_(pt), point_adapter::y_(pt), point_adapter::z_(pt));
+    // Insert into bin
+    m_points.push_back(pt);
+    m_bins.push_back(idx);
+    m_is_sorted = false;
+    return end() - 1;
+  }
+
+  /// \brief Calls a function on all points within a fixed radius of a reference point
+  /// \param[in] func Callable as func(IT it, float32_t distance_squared) for each point
+  template <typename FuncT>
+  GEOMETRY_LOCAL void for_each_near(
+    const float32_t x, const float32_t y, const float32_t z, const float32_t radius, FuncT && func)
+  {
+    if (!m_is_sorted) {
+      sort();
+    }
     // Compute bin, bin range
     const Index3 ref_idx = m_config.index3(x, y, z);
     const float32_t radius2 = radius * radius;
     const details::BinRange idx_range = m_config.bin_range(ref_idx, radius);
     Index3 idx = idx_range.first;
+    Index neighbors_found = 0U;
     // For bins in radius
     do {  // guaranteed to have at least the bin ref_idx is in
       // update book-keeping
@@ -209,37 +309,104 @@ protected:
       // Iterating in a square/cube pattern is easier than constructing sphere pattern
       if (m_config.is_candidate_bin(ref_idx, idx, radius2)) {
         // For point in bin
-        const Index jdx = m_config.index(idx);
-        const auto range = m_hash.equal_range(jdx);
-        for (auto it = range.first; it != range.second; ++it) {
-          const auto & pt = it->second;
-          const float32_t dist2 = m_config.distance_squared(x, y, z, pt);
+        const auto range = find_cell(m_config.index(idx));
+        for (Index jdx = range.first; jdx < range.second; ++jdx) {
+          const float32_t dist2 = m_config.distance_squared(x, y, z, m_points[jdx]);
           if (dist2 <= radius2) {
-            // Only compute true distance if necessary
-            m_neighbors.emplace_back(it, sqrtf(dist2));
+            func(cbegin() + static_cast<std::ptrdiff_t>(jdx), dist2);
+            ++neighbors_found;
           }
         }
       }
     } while (m_config.next_bin(idx_range, idx));
     // update book-keeping
-    m_neighbors_found += m_neighbors.size();
-    return m_neighbors;
+    m_neighbors_found += neighbors_found;
   }
 
-private:
-  /// \brief Internal insert method with no error checking
-  /// \param[in] pt The Point to insert
-  GEOMETRY_LOCAL IT insert_impl(const PointT & pt)
+  /// \brief Get the range of the points of a bin, valid only while the points are sorted
+  /// \param[in] bin The bin index
+  /// \return The first index and one past the last index of the points in the bin
+  GEOMETRY_LOCAL std::pair<Index, Index> find_cell(const Index bin) const
   {
-    // Compute bin
-    const Index idx =
-      m_config.bin(point_adapter::x_(pt), point_adapter::y_(pt), point_adapter::z_(pt));
-    // Insert into bin
-    return m_hash.insert(std::make_pair(idx, pt));
+    if (m_is_dense) {
+      return {m_cell_begin[bin], m_cell_begin[bin] + m_cell_size[bin]};
+    }
+    const auto it = std::lower_bound(m_cells.begin(), m_cells.end(), bin);
+    if ((m_cells.end() == it) || (*it != bin)) {
+      return {};
+    }
+    const auto cdx = static_cast<Index>(std::distance(m_cells.begin(), it));
+    return {m_cell_begin[cdx], m_cell_begin[cdx + 1U]};
+  }
+
+  /// \brief Group the points by bin, with a counting sort if the begin of every bin is stored, or
+  ///        a comparison sort of the bin indices otherwise
+  GEOMETRY_LOCAL void sort()
+  {
+    m_sorted_points.resize(m_points.size());
+    m_sorted_bins.resize(m_bins.size());
+    if (m_is_dense) {
+      // only reset the bins occupied at the last sort
+      for (const Index bin : m_cells) {
+        m_cell_size[bin] = 0U;
+      }
+      m_cells.clear();
+      for (const Index bin : m_bins) {
+        if (0U == m_cell_size[bin]) {
+          m_cells.push_back(bin);
+        }
+        ++m_cell_size[bin];
+      }
+      // bins are laid out in their order of appearance, which is enough to make them contiguous
+      Index begin = 0U;
+      for (const Index bin : m_cells) {
+        m_cell_begin[bin] = begin;
+        begin += m_cell_size[bin];
+        m_cell_size[bin] = 0U;
+      }
+      for (Index idx = 0U; idx < m_points.size(); ++idx) {
+        const Index bin = m_bins[idx];
+        const Index jdx = m_cell_begin[bin] + m_cell_size[bin];
+        ++m_cell_size[bin];
+        m_sorted_points[jdx] = m_points[idx];
+        m_sorted_bins[jdx] = bin;
+      }
+    } else {
+      // m_cells is used as the permutation of the points before holding the occupied bins
+      m_cells.resize(m_points.size());
+      std::iota(m_cells.begin(), m_cells.end(), Index{});
+      std::stable_sort(m_cells.begin(), m_cells.end(), [this](const Index lhs, const Index rhs) {
+        return m_bins[lhs] < m_bins[rhs];
+      });
+      for (Index jdx = 0U; jdx < m_cells.size(); ++jdx) {
+        m_sorted_points[jdx] = m_points[m_cells[jdx]];
+        m_sorted_bins[jdx] = m_bins[m_cells[jdx]];
+      }
+      m_cells.clear();
+      m_cell_begin.clear();
+      for (Index jdx = 0U; jdx < m_sorted_bins.size(); ++jdx) {
+        if (m_cells.empty() || (m_cells.back() != m_sorted_bins[jdx])) {
+          m_cells.push_back(m_sorted_bins[jdx]);
+          m_cell_begin.push_back(jdx);
+        }
+      }
+      m_cell_begin.push_back(m_sorted_bins.size());
+    }
+    std::swap(m_points, m_sorted_points);
+    std::swap(m_bins, m_sorted_bins);
+    m_is_sorted = true;
   }
 
   const ConfigT m_config;
-  Hash m_hash;
+  const bool8_t m_is_dense;
+  Points m_points;
+  std::vector<Index> m_bins;
+  Points m_sorted_points;
+  std::vector<Index> m_sorted_bins;
+  std::vector<Index> m_cells;
+  std::vector<Index> m_cell_begin;
+  std::vector<Index> m_cell_size;
+  bool8_t m_is_sorted;
   OutputVector m_neighbors;
   Index m_bins_hit;
   Index m_neighbors_found;
@@ -282,6 +449,32 @@ public:
   {
     return near(point_adapter::x_(pt), point_adapter::y_(pt), radius);
   }
+
+  /// \brief Calls a visitor on all points within a fixed radius of a reference point, without
+  ///        storing them
+  /// \param[in] x The x component of the reference point
+  /// \param[in] y The y component of the reference point
+  /// \param[in] radius The radius within which to find all near points
+  /// \param[in] visitor Callable as visitor(const PointT & pt, float32_t distance) for each point
+  /// \tparam VisitorT The visitor type
+  template <typename VisitorT>
+  void visit_near(const float32_t x, const float32_t y, const float32_t radius, VisitorT && visitor)
+  {
+    this->visit_near_impl(x, y, 0.0F, radius, std::forward<VisitorT>(visitor));
+  }
+
+  /// \brief Calls a visitor on all points within a fixed radius of a reference point, without
+  ///        storing them
+  /// \param[in] pt The reference point. Only the x and y members are respected.
+  /// \param[in] radius The radius within which to find all near points
+  /// \param[in] visitor Callable as visitor(const PointT & pt, float32_t distance) for each point
+  /// \tparam VisitorT The visitor type
+  template <typename VisitorT>
+  void visit_near(const PointT & pt, const float32_t radius, VisitorT && visitor)
+  {
+    visit_near(
+      point_adapter::x_(pt), point_adapter::y_(pt), radius, std::forward<VisitorT>(visitor));
+  }
 };
 
 /// \brief Explicit specialization of SpatialHash for 3D configuration
@@ -317,6 +510,36 @@ public:
   {
     return near(point_adapter::x_(pt), point_adapter::y_(pt), point_adapter::z_(pt), radius);
   }
+
+  /// \brief Calls a visitor on all points within a fixed radius of a reference point, without
+  ///        storing them
+  /// \param[in] x The x component of the reference point
+  /// \param[in] y The y component of the reference point
+  /// \param[in] z The z component of the reference point
+  /// \param[in] radius The radius within which to find all near points
+  /// \param[in] visitor Callable as visitor(const PointT & pt, float32_t distance) for each point
+  /// \tparam VisitorT The visitor type
+  template <typename VisitorT>
+  void visit_near(
+    const float32_t x, const float32_t y, const float32_t z, const float32_t radius,
+    VisitorT && visitor)
+  {
+    this->visit_near_impl(x, y, z, radius, std::forward<VisitorT>(visitor));
+  }
+
+  /// \brief Calls a visitor on all points within a fixed radius of a reference point, without
+  ///        storing them
+  /// \param[in] pt The reference point.
+  /// \param[in] radius The radius within which to find all near points
+  /// \param[in] visitor Callable as visitor(const PointT & pt, float32_t distance) for each point
+  /// \tparam VisitorT The visitor type
+  template <typename VisitorT>
+  void visit_near(const PointT & pt, const float32_t radius, VisitorT && visitor)
+  {
+    visit_near(
+      point_adapter::x_(pt), point_adapter::y_(pt), point_adapter::z_(pt), radius,
+      std::forward<VisitorT>(visitor));
+  }
 };
 
 template <typename T>
@@ -172,6 +172,16 @@ public:
   /// \brief Get the maximum capacity of the spatial hash
   /// \return The capacity
   Index get_capacity() const { return m_capacity; }
+  /// \brief Get the number of bins of the lattice
+  /// \return The number of bins, saturated to the maximum value of Index if it overflows
+  Index get_bin_count() const
+  {
+    const Index z_count = m_max_z_idx + 1U;
+    if (z_count > (std::numeric_limits<Index>::max() / m_z_stride)) {
+      return std::numeric_limits<Index>::max();
+    }
+    return m_z_stride * z_count;
+  }
 
   /// \brief Getter for the side length, equivalently the lookup radius
   float32_t radius2() const { return m_side_length2; }
@@ -225,6 +225,71 @@ TYPED_TEST(TypedSpatialHashTest, 3d)
   EXPECT_EQ(count, 0U);
 }
 
+// visitor queries and modifications between queries, with every bin stored (dense) or only the
+// occupied ones (sparse)
+TYPED_TEST(TypedSpatialHashTest, VisitorAndModifications)
+{
+  using PointT = TypeParam;
+  const uint32_t points_per_ring = 16U;
+  const uint32_t num_rings = 8U;
+  const Config3d dense_cfg{-20.0F, 20.0F, -20.0F, 20.0F, -1.0F, 1.0F, 1.0F, 1024U};
+  const Config3d sparse_cfg{-200.0F, 200.0F, -200.0F, 200.0F, -200.0F, 200.0F, 1.0F, 1024U};
+  for (const auto & cfg : {dense_cfg, sparse_cfg}) {
+    SpatialHash3d<PointT> hash{cfg};
+    // check near(), visit_near() and brute force agree
+    const auto check_queries = [this, &hash](const float32_t r) {
+      for (const float32_t x : {0.0F, 2.5F, -7.0F}) {
+        PointT query = this->ref;
+        query.x = x;
+        uint32_t n_pts = 0U;
+        for (const auto & pt : hash) {
+          const float32_t dx = pt.x - query.x;
+          const float32_t dy = pt.y - query.y;
+          const float32_t dz = pt.z - query.z;
+          if ((dx * dx) + (dy * dy) + (dz * dz) <= r * r) {
+            ++n_pts;
+          }
+        }
+        const auto & neighbors = hash.near(query, r);
+        ASSERT_EQ(neighbors.size(), n_pts);
+        uint32_t points_visited = 0U;
+        hash.visit_near(query, r, [&](const PointT & pt, const float32_t dist) {
+          const float32_t dx = pt.x - query.x;
+          const float32_t dy = pt.y - query.y;
+          const float32_t dz = pt.z - query.z;
+          EXPECT_FLOAT_EQ(dist, sqrtf((dx * dx) + (dy * dy) + (dz * dz)));
+          EXPECT_LE(dist, r);
+          ++points_visited;
+        });
+        ASSERT_EQ(points_visited, n_pts);
+      }
+    };
+
+    this->add_points(hash, points_per_ring, num_rings, 1.0F);
+    check_queries(3.0F);
+    // erase every other point, then add points which go to the same bins as existing ones
+    for (auto it = hash.cbegin(); it != hash.cend();) {
+      it = hash.erase(it);
+      if (it != hash.cend()) {
+        ++it;
+      }
+    }
+    EXPECT_EQ(hash.size(), points_per_ring * num_rings / 2U);
+    EXPECT_THROW(hash.erase(hash.cend()), std::domain_error);
+    this->add_points(hash, points_per_ring, num_rings / 2U, 0.5F, 0.25F, 0.25F);
+    check_queries(3.0F);
+    check_queries(10.0F);
+    // rebuild from scratch as done every frame
+    hash.clear();
+    check_queries(3.0F);
+    this->add_points(hash, points_per_ring, num_rings, 1.5F);
+    const std::vector<PointT> too_many_pts(hash.capacity(), this->ref);
+    EXPECT_THROW(hash.insert(too_many_pts.begin(), too_many_pts.end()), std::length_error);
+    EXPECT_EQ(hash.size(), points_per_ring * num_rings);
+    check_queries(5.0F);
+  }
+}
+
 /// edge cases
 TEST(SpatialHashConfig, BadCases)
 {
@@ -29,8 +29,10 @@
 #include <bitset>
 #include <list>
 #include <memory>
+#include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace autoware
@@ -117,16 +119,48 @@ public:
   void reset() override
   {
     RosTopicDisplay::reset();
-    m_marker_common.clearMarkers();
+    clear_markers();
   }
 
-  void clear_markers() { m_marker_common.clearMarkers(); }
+  void clear_markers()
+  {
+    m_marker_common.clearMarkers();
+    m_previous_marker_ids.clear();
+    m_current_marker_ids.clear();
+  }
 
   void add_marker(visualization_msgs::msg::Marker::ConstSharedPtr marker_ptr)
   {
     m_marker_common.addMessage(marker_ptr);
   }
 
+  /// \brief Add the marker of the current message without clearing the markers of the previous
+  ///        one, so that the renderable of the marker with the same namespace and id is updated
+  ///        instead of being destroyed and created again
+  /// \param marker_ptr Marker with a namespace and id which are stable for the same object
+  void update_marker(visualization_msgs::msg::Marker::ConstSharedPtr marker_ptr)
+  {
+    m_current_marker_ids.emplace(marker_ptr->ns, marker_ptr->id);
+    m_marker_common.addMessage(marker_ptr);
+  }
+
+  /// \brief Delete the markers of the previous message which are not updated for the current one,
+  ///        to be called once all the markers of the current message are given to update_marker()
+  void remove_stale_markers()
+  {
+    for (const auto & marker_id : m_previous_marker_ids) {
+      if (m_current_marker_ids.count(marker_id) == 0) {
+        auto marker_ptr = std::make_shared<Marker>();
+        marker_ptr->ns = marker_id.first;
+        marker_ptr->id = marker_id.second;
+        marker_ptr->action = Marker::DELETE;
+        m_marker_common.addMessage(marker_ptr);
+      }
+    }
+    m_previous_marker_ids.swap(m_current_marker_ids);
+    m_current_marker_ids.clear();
+  }
+
 protected:
   /// \brief Convert given shape msg into a Marker
   /// \tparam ClassificationContainerT List type with ObjectClassificationMsg
@@ -366,6 +400,10 @@ private:
   rviz_common::properties::FloatProperty m_line_width_property;
   // Default topic name to be visualized
   std::string m_default_topic;
+  // Namespaces and ids of the markers added by update_marker() for the previous and the current
+  // message
+  std::set<std::pair<std::string, int32_t>> m_previous_marker_ids;
+  std::set<std::pair<std::string, int32_t>> m_current_marker_ids;
 
   std::vector<std_msgs::msg::ColorRGBA> predicted_path_colors;
 };
@@ -26,10 +26,11 @@ PredictedObjectsDisplay::PredictedObjectsDisplay() : ObjectPolygonDisplayBase("t
 
 void PredictedObjectsDisplay::processMessage(PredictedObjects::ConstSharedPtr msg)
 {
-  clear_markers();
   update_id_map(msg);
 
   for (const auto & object : msg->objects) {
+    const int32_t object_marker_id = uuid_to_marker_id(object.object_id);
+
     // Get marker for shape
     auto shape_marker = get_shape_marker_ptr(
       object.shape, object.kinematics.initial_pose_with_covariance.pose.position,
@@ -38,8 +39,8 @@ void PredictedObjectsDisplay::processMessage(PredictedObjects::ConstSharedPtr ms
     if (shape_marker) {
       auto shape_marker_ptr = shape_marker.value();
       shape_marker_ptr->header = msg->header;
-      shape_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(shape_marker_ptr);
+      shape_marker_ptr->id = object_marker_id;
+      update_marker(shape_marker_ptr);
     }
 
     // Get marker for label
@@ -49,8 +50,8 @@ void PredictedObjectsDisplay::processMessage(PredictedObjects::ConstSharedPtr ms
     if (label_marker) {
       auto label_marker_ptr = label_marker.value();
       label_marker_ptr->header = msg->header;
-      label_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(label_marker_ptr);
+      label_marker_ptr->id = object_marker_id;
+      update_marker(label_marker_ptr);
     }
 
     // Get marker for id
@@ -64,8 +65,8 @@ void PredictedObjectsDisplay::processMessage(PredictedObjects::ConstSharedPtr ms
     if (id_marker) {
       auto id_marker_ptr = id_marker.value();
       id_marker_ptr->header = msg->header;
-      id_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(id_marker_ptr);
+      id_marker_ptr->id = object_marker_id;
+      update_marker(id_marker_ptr);
     }
 
     // Get marker for pose with covariance
@@ -74,8 +75,8 @@ void PredictedObjectsDisplay::processMessage(PredictedObjects::ConstSharedPtr ms
     if (pose_with_covariance_marker) {
       auto pose_with_covariance_marker_ptr = pose_with_covariance_marker.value();
       pose_with_covariance_marker_ptr->header = msg->header;
-      pose_with_covariance_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(pose_with_covariance_marker_ptr);
+      pose_with_covariance_marker_ptr->id = object_marker_id;
+      update_marker(pose_with_covariance_marker_ptr);
     }
 
     // Get marker for velocity text
@@ -89,8 +90,8 @@ void PredictedObjectsDisplay::processMessage(PredictedObjects::ConstSharedPtr ms
     if (velocity_text_marker) {
       auto velocity_text_marker_ptr = velocity_text_marker.value();
       velocity_text_marker_ptr->header = msg->header;
-      velocity_text_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(velocity_text_marker_ptr);
+      velocity_text_marker_ptr->id = object_marker_id;
+      update_marker(velocity_text_marker_ptr);
     }
 
     // Get marker for twist
@@ -100,8 +101,8 @@ void PredictedObjectsDisplay::processMessage(PredictedObjects::ConstSharedPtr ms
     if (twist_marker) {
       auto twist_marker_ptr = twist_marker.value();
       twist_marker_ptr->header = msg->header;
-      twist_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(twist_marker_ptr);
+      twist_marker_ptr->id = object_marker_id;
+      update_marker(twist_marker_ptr);
     }
 
     // Add marker for each candidate path
@@ -113,9 +114,8 @@ void PredictedObjectsDisplay::processMessage(PredictedObjects::ConstSharedPtr ms
       if (predicted_path_marker) {
         auto predicted_path_marker_ptr = predicted_path_marker.value();
         predicted_path_marker_ptr->header = msg->header;
-        predicted_path_marker_ptr->id =
-          uuid_to_marker_id(object.object_id) + path_count * PATH_ID_CONSTANT;
-        add_marker(predicted_path_marker_ptr);
+        predicted_path_marker_ptr->id = object_marker_id + path_count * PATH_ID_CONSTANT;
+        update_marker(predicted_path_marker_ptr);
         path_count++;
       }
     }
@@ -131,13 +131,14 @@ void PredictedObjectsDisplay::processMessage(PredictedObjects::ConstSharedPtr ms
       if (path_confidence_marker) {
         auto path_confidence_marker_ptr = path_confidence_marker.value();
         path_confidence_marker_ptr->header = msg->header;
-        path_confidence_marker_ptr->id =
-          uuid_to_marker_id(object.object_id) + path_count * PATH_ID_CONSTANT;
-        add_marker(path_confidence_marker_ptr);
+        path_confidence_marker_ptr->id = object_marker_id + path_count * PATH_ID_CONSTANT;
+        update_marker(path_confidence_marker_ptr);
         path_count++;
       }
     }
   }
+
+  remove_stale_markers();
 }
 
 }  // namespace object_detection
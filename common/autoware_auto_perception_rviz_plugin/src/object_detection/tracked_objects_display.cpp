@@ -28,10 +28,11 @@ TrackedObjectsDisplay::TrackedObjectsDisplay() : ObjectPolygonDisplayBase("track
 
 void TrackedObjectsDisplay::processMessage(TrackedObjects::ConstSharedPtr msg)
 {
-  clear_markers();
   update_id_map(msg);
 
   for (const auto & object : msg->objects) {
+    const int32_t object_marker_id = uuid_to_marker_id(object.object_id);
+
     // Get marker for shape
     auto shape_marker = get_shape_marker_ptr(
       object.shape, object.kinematics.pose_with_covariance.pose.position,
@@ -40,8 +41,8 @@ void TrackedObjectsDisplay::processMessage(TrackedObjects::ConstSharedPtr msg)
     if (shape_marker) {
       auto shape_marker_ptr = shape_marker.value();
       shape_marker_ptr->header = msg->header;
-      shape_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(shape_marker_ptr);
+      shape_marker_ptr->id = object_marker_id;
+      update_marker(shape_marker_ptr);
     }
 
     // Get marker for label
@@ -51,8 +52,8 @@ void TrackedObjectsDisplay::processMessage(TrackedObjects::ConstSharedPtr msg)
     if (label_marker) {
       auto label_marker_ptr = label_marker.value();
       label_marker_ptr->header = msg->header;
-      label_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(label_marker_ptr);
+      label_marker_ptr->id = object_marker_id;
+      update_marker(label_marker_ptr);
     }
 
     // Get marker for id
@@ -66,8 +67,8 @@ void TrackedObjectsDisplay::processMessage(TrackedObjects::ConstSharedPtr msg)
     if (id_marker) {
       auto id_marker_ptr = id_marker.value();
       id_marker_ptr->header = msg->header;
-      id_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(id_marker_ptr);
+      id_marker_ptr->id = object_marker_id;
+      update_marker(id_marker_ptr);
     }
 
     // Get marker for pose with covariance
@@ -76,8 +77,8 @@ void TrackedObjectsDisplay::processMessage(TrackedObjects::ConstSharedPtr msg)
     if (pose_with_covariance_marker) {
       auto pose_with_covariance_marker_ptr = pose_with_covariance_marker.value();
       pose_with_covariance_marker_ptr->header = msg->header;
-      pose_with_covariance_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(pose_with_covariance_marker_ptr);
+      pose_with_covariance_marker_ptr->id = object_marker_id;
+      update_marker(pose_with_covariance_marker_ptr);
     }
 
     // Get marker for velocity text
@@ -90,8 +91,8 @@ void TrackedObjectsDisplay::processMessage(TrackedObjects::ConstSharedPtr msg)
     if (velocity_text_marker) {
       auto velocity_text_marker_ptr = velocity_text_marker.value();
       velocity_text_marker_ptr->header = msg->header;
-      velocity_text_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(velocity_text_marker_ptr);
+      velocity_text_marker_ptr->id = object_marker_id;
+      update_marker(velocity_text_marker_ptr);
     }
 
     // Get marker for twist
@@ -100,10 +101,12 @@ void TrackedObjectsDisplay::processMessage(TrackedObjects::ConstSharedPtr msg)
     if (twist_marker) {
       auto twist_marker_ptr = twist_marker.value();
       twist_marker_ptr->header = msg->header;
-      twist_marker_ptr->id = uuid_to_marker_id(object.object_id);
-      add_marker(twist_marker_ptr);
+      twist_marker_ptr->id = object_marker_id;
+      update_marker(twist_marker_ptr);
     }
   }
+
+  remove_stale_markers();
 }
 
 }  // namespace object_detection
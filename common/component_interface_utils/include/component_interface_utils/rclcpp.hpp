@@ -21,7 +21,9 @@
 #include <component_interface_utils/rclcpp/topic_publisher.hpp>
 #include <component_interface_utils/rclcpp/topic_subscription.hpp>
 
+#include <memory>
 #include <optional>
+#include <type_traits>
 #include <utility>
 
 namespace component_interface_utils
@@ -73,13 +75,32 @@ public:
     sub = create_subscription_impl<SpecT>(node_, std::forward<CallbackT>(callback));
   }
 
-  /// Relay message.
+  /// Relay message. The message is moved to the publisher to pass it without a copy in a process.
   template <class P, class S>
   void relay_message(P & pub, S & sub) const
   {
-    using MsgT = typename P::element_type::SpecType::Message::ConstSharedPtr;
+    using MsgT = typename P::element_type::SpecType::Message::UniquePtr;
     init_pub(pub);
-    init_sub(sub, [pub](MsgT msg) { pub->publish(*msg); });
+    init_sub(sub, [pub](MsgT msg) { pub->publish(std::move(msg)); });
+  }
+
+  /// Relay serialized message without deserialization, for the messages of the same type.
+  template <class P, class S>
+  void relay_serialized_message(P & pub, S & sub) const
+  {
+    // Serialized messages are not delivered via intra-process communication, so disable it not to
+    // miss the subscriptions of the same process.
+    using PubSpecT = typename P::element_type::SpecType;
+    using SubSpecT = typename S::element_type::SpecType;
+    using MsgT = std::shared_ptr<rclcpp::SerializedMessage>;
+    static_assert(std::is_same_v<typename PubSpecT::Message, typename SubSpecT::Message>);
+    rclcpp::PublisherOptions pub_options;
+    pub_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+    rclcpp::SubscriptionOptions sub_options;
+    sub_options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+    pub = create_publisher_impl<PubSpecT>(node_, pub_options);
+    sub = create_subscription_impl<SubSpecT>(
+      node_, [pub](MsgT msg) { pub->publish(*msg); }, sub_options);
   }
 
   /// Relay service.
@@ -54,24 +54,26 @@ typename Service<SpecT>::SharedPtr create_service_impl(
 
 /// Create a publisher using traits like services. This is a private implementation.
 template <class SpecT, class NodeT>
-typename Publisher<SpecT>::SharedPtr create_publisher_impl(NodeT * node)
+typename Publisher<SpecT>::SharedPtr create_publisher_impl(
+  NodeT * node, const rclcpp::PublisherOptions & options = rclcpp::PublisherOptions())
 {
   // This function is a wrapper for the following.
   // https://github.com/ros2/rclcpp/blob/48068130edbb43cdd61076dc1851672ff1a80408/rclcpp/include/rclcpp/node.hpp#L167-L205
-  auto publisher =
-    node->template create_publisher<typename SpecT::Message>(SpecT::name, get_qos<SpecT>());
+  auto publisher = node->template create_publisher<typename SpecT::Message>(
+    SpecT::name, get_qos<SpecT>(), options);
   return Publisher<SpecT>::make_shared(publisher);
 }
 
 /// Create a subscription using traits like services. This is a private implementation.
 template <class SpecT, class NodeT, class CallbackT>
 typename Subscription<SpecT>::SharedPtr create_subscription_impl(
-  NodeT * node, CallbackT && callback)
+  NodeT * node, CallbackT && callback,
+  const rclcpp::SubscriptionOptions & options = rclcpp::SubscriptionOptions())
 {
   // This function is a wrapper for the following.
   // https://github.com/ros2/rclcpp/blob/48068130edbb43cdd61076dc1851672ff1a80408/rclcpp/include/rclcpp/node.hpp#L207-L238
   auto subscription = node->template create_subscription<typename SpecT::Message>(
-    SpecT::name, get_qos<SpecT>(), std::forward<CallbackT>(callback));
+    SpecT::name, get_qos<SpecT>(), std::forward<CallbackT>(callback), options);
   return Subscription<SpecT>::make_shared(subscription);
 }
 
@@ -16,6 +16,9 @@
 #define COMPONENT_INTERFACE_UTILS__RCLCPP__TOPIC_PUBLISHER_HPP_
 
 #include <rclcpp/publisher.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+#include <utility>
 
 namespace component_interface_utils
 {
@@ -38,6 +41,12 @@ public:
   /// Publish a message.
   void publish(const typename SpecT::Message & msg) { publisher_->publish(msg); }
 
+  /// Publish a message without a copy for the intra-process subscriptions.
+  void publish(typename SpecT::Message::UniquePtr msg) { publisher_->publish(std::move(msg)); }
+
+  /// Publish a serialized message as it is.
+  void publish(const rclcpp::SerializedMessage & msg) { publisher_->publish(msg); }
+
 private:
   RCLCPP_DISABLE_COPY(Publisher)
   typename WrapType::SharedPtr publisher_;
@@ -42,12 +42,22 @@ struct Edge
   }
 };
 
+/// @brief Range of cells [from_col, to_col) of a row of the grid map buffer
+struct Span
+{
+  int row;
+  int from_col;
+  int to_col;
+};
+
 /** @brief A polygon iterator for grid_map::GridMap based on the scan line algorithm.
     @details This iterator allows to iterate over all cells whose center is inside a polygon. \
              This reproduces the behavior of the original grid_map::PolygonIterator which uses\
              a "point in polygon" check for each cell of the gridmap, making it very expensive\
              to run on large maps. In comparison, the scan line algorithm implemented here is \
              much more scalable.
+             The cells are calculated as spans of consecutive cells of a row which can also be\
+             used directly, e.g., to process a block of a layer at once instead of cell by cell.
 */
 class PolygonIterator
 {
@@ -71,6 +81,21 @@ public:
   /// @brief Indicates if iterator is past end.
   /// @return true if iterator is out of scope, false if end has not been reached.
   [[nodiscard]] bool isPastEnd() const;
+  /// @brief Get the spans of cells iterated on, in the order of iteration.
+  /// @return the spans of cells whose center is inside the polygon.
+  [[nodiscard]] const std::vector<Span> & getSpans() const;
+
+  /** @brief Calculate the spans of cells whose center is inside a polygon.
+      @details The spans are sorted by row, then by column, in the order of the scan line.\
+               A range of columns crossing the end of the circular buffer is split in 2 spans,\
+               so that the cells of a span are a block of the layer matrices, i.e.,\
+               layer.block(span.row, span.from_col, 1, span.to_col - span.from_col).
+      @param grid_map the grid map to calculate the spans on.
+      @param polygon the polygonal area.
+      @return the spans of cells whose center is inside the polygon.
+  */
+  static std::vector<Span> calculateSpans(
+    const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon);
 
 private:
   /** @brief Calculate sorted edges of the given polygon.
@@ -101,28 +126,11 @@ private:
     const std::vector<Edge> & edges, const grid_map::Position & origin,
     const grid_map::GridMap & grid_map);
 
-  // Helper functions
-  /// @brief Increment the current_line_ to the line with intersections
-  void goToNextLine();
-  /// @brief Calculate the initial current_col_ and the current_to_col_ for the current intersection
-  void calculateColumnIndexes();
-  /// @brief Calculate the current_index_ from the current_line_ and current_col_
-  void calculateIndex();
-
-  /// Gridmap info
-  int row_of_first_line_;
-  grid_map::Index map_start_idx_;
-  grid_map::Size map_size_;
-  double map_resolution_;
-  double map_origin_y_;
-  /// Intersections between scan lines and the polygon
-  std::vector<std::vector<double>> intersections_per_line_;
-  std::vector<double>::const_iterator intersection_iter_;
+  /// Spans of cells inside the polygon
+  std::vector<Span> spans_;
   /// current indexes
   grid_map::Index current_index_;
-  size_t current_line_;
-  int current_col_;
-  int current_to_col_;
+  size_t current_span_ = 0;
 };
 }  // namespace grid_map_utils
 
@@ -108,107 +108,93 @@ std::pair<int, int> PolygonIterator::calculateRowRange(
   return {min_row, max_row};
 }
 
-PolygonIterator::PolygonIterator(
+std::vector<Span> PolygonIterator::calculateSpans(
   const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon)
 {
+  std::vector<Span> spans;
   auto poly = polygon;
-  if (poly.nVertices() < 3) return;
+  if (poly.nVertices() < 3) return spans;
   // repeat the first vertex to get the last edge [last vertex, first vertex]
   if (poly.getVertex(0) != poly.getVertex(poly.nVertices() - 1)) poly.addVertex(poly.getVertex(0));
 
-  map_start_idx_ = grid_map.getStartIndex();
-  map_resolution_ = grid_map.getResolution();
-  map_size_ = grid_map.getSize();
+  const auto & map_start_idx = grid_map.getStartIndex();
+  const auto map_resolution = grid_map.getResolution();
+  const auto & map_size = grid_map.getSize();
   const auto origin = [&]() {
     grid_map::Position origin;
-    grid_map.getPosition(map_start_idx_, origin);
+    grid_map.getPosition(map_start_idx, origin);
     return origin;
   }();
-  map_origin_y_ = origin.y();
 
   // We make line scan left -> right / up -> down *in the index frame* (idx[0,0] is pos[up, left]).
   // In the position frame, this corresponds to high -> low Y values and high -> low X values.
   const std::vector<Edge> edges = calculateSortedEdges(poly);
-  if (edges.empty()) return;
+  if (edges.empty()) return spans;
   const auto from_to_row = calculateRowRange(edges, origin, grid_map);
-  intersections_per_line_ = calculateIntersectionsPerLine(edges, from_to_row, origin, grid_map);
-
-  row_of_first_line_ = from_to_row.first;
-  current_col_ = 0;
-  current_to_col_ = -1;
-  current_line_ = -1;  // goToNextLine() increments the line so assign -1 to start from 0
-
-  // Initialize iterator to the first (row,column) inside the Polygon
-  if (!intersections_per_line_.empty()) {
-    goToNextLine();
-    if (!isPastEnd()) {
-      calculateColumnIndexes();
-      calculateIndex();
+  const auto intersections_per_line =
+    calculateIntersectionsPerLine(edges, from_to_row, origin, grid_map);
+
+  for (size_t line = 0; line < intersections_per_line.size(); ++line) {
+    int row = map_start_idx(0) + from_to_row.first + static_cast<int>(line);
+    grid_map::wrapIndexToRange(row, map_size(0));
+    // the columns between each pair of intersections, an unpaired last intersection being ignored
+    const auto & intersections = intersections_per_line[line];
+    for (size_t i = 0; i + 1 < intersections.size(); i += 2) {
+      const auto dist_from_origin = origin.y() - intersections[i] + map_resolution;
+      const auto from_col =
+        std::clamp(static_cast<int>(dist_from_origin / map_resolution), 0, map_size(1) - 1);
+      const auto dist_to_origin = origin.y() - intersections[i + 1];
+      const auto to_col =
+        std::clamp(static_cast<int>(dist_to_origin / map_resolution), 0, map_size(1) - 1);
+      // Case where intersections do not encompass the center of a cell
+      if (to_col < from_col) continue;
+
+      int from_buffer_col = map_start_idx(1) + from_col;
+      grid_map::wrapIndexToRange(from_buffer_col, map_size(1));
+      const auto to_buffer_col = from_buffer_col + to_col - from_col + 1;
+      if (to_buffer_col <= map_size(1)) {
+        spans.push_back({row, from_buffer_col, to_buffer_col});
+      } else {
+        spans.push_back({row, from_buffer_col, map_size(1)});
+        spans.push_back({row, 0, to_buffer_col - map_size(1)});
+      }
     }
   }
+  return spans;
 }
 
-bool PolygonIterator::operator!=(const PolygonIterator & other) const
-{
-  return current_line_ != other.current_line_ || current_col_ != other.current_col_;
-}
-
-const grid_map::Index & PolygonIterator::operator*() const { return current_index_; }
-
-void PolygonIterator::goToNextLine()
-{
-  ++current_line_;
-  while (current_line_ < intersections_per_line_.size() &&
-         intersections_per_line_[current_line_].size() < 2)
-    ++current_line_;
-  if (!isPastEnd()) intersection_iter_ = intersections_per_line_[current_line_].cbegin();
-}
-
-void PolygonIterator::calculateColumnIndexes()
+PolygonIterator::PolygonIterator(
+  const grid_map::GridMap & grid_map, const grid_map::Polygon & polygon)
+: spans_(calculateSpans(grid_map, polygon))
 {
-  const auto dist_from_origin = map_origin_y_ - *intersection_iter_ + map_resolution_;
-  current_col_ =
-    std::clamp(static_cast<int>(dist_from_origin / map_resolution_), 0, map_size_(1) - 1);
-  ++intersection_iter_;
-  const auto dist_to_origin = map_origin_y_ - *intersection_iter_;
-  current_to_col_ =
-    std::clamp(static_cast<int>(dist_to_origin / map_resolution_), 0, map_size_(1) - 1);
-  // Case where intersections do not encompass the center of a cell: iterate again
-  if (current_to_col_ < current_col_) {
-    operator++();
+  // Initialize iterator to the first (row,column) inside the Polygon
+  if (!isPastEnd()) {
+    current_index_(0) = spans_.front().row;
+    current_index_(1) = spans_.front().from_col;
   }
 }
 
-void PolygonIterator::calculateIndex()
+bool PolygonIterator::operator!=(const PolygonIterator & other) const
 {
-  current_index_(0) = map_start_idx_(0) + row_of_first_line_ + static_cast<int>(current_line_);
-  grid_map::wrapIndexToRange(current_index_(0), map_size_(0));
-  current_index_(1) = map_start_idx_(1) + current_col_;
-  grid_map::wrapIndexToRange(current_index_(1), map_size_(1));
+  return current_span_ != other.current_span_ || current_index_(1) != other.current_index_(1);
 }
 
+const grid_map::Index & PolygonIterator::operator*() const { return current_index_; }
+
 PolygonIterator & PolygonIterator::operator++()
 {
-  ++current_col_;
-  if (current_col_ > current_to_col_) {
-    ++intersection_iter_;
-    if (
-      intersection_iter_ == intersections_per_line_[current_line_].cend() ||
-      std::next(intersection_iter_) == intersections_per_line_[current_line_].cend()) {
-      goToNextLine();
-    }
+  ++current_index_(1);
+  if (current_index_(1) >= spans_[current_span_].to_col) {
+    ++current_span_;
     if (!isPastEnd()) {
-      calculateColumnIndexes();
+      current_index_(0) = spans_[current_span_].row;
+      current_index_(1) = spans_[current_span_].from_col;
     }
   }
-  if (!isPastEnd()) {
-    calculateIndex();
-  }
   return *this;
 }
 
-[[nodiscard]] bool PolygonIterator::isPastEnd() const
-{
-  return current_line_ >= intersections_per_line_.size();
-}
+[[nodiscard]] bool PolygonIterator::isPastEnd() const { return current_span_ >= spans_.size(); }
+
+[[nodiscard]] const std::vector<Span> & PolygonIterator::getSpans() const { return spans_; }
 }  // namespace grid_map_utils
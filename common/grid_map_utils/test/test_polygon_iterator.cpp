@@ -278,3 +278,37 @@ TEST(PolygonIterator, SelfCrossingPolygon)
   }
   EXPECT_FALSE(diff);
 }
+
+TEST(PolygonIterator, Spans)
+{
+  GridMap map({"layer"});
+  map.setGeometry(Length(8.0, 5.0), 1.0, Position(0.0, 0.0));  // bufferSize(8, 5)
+  map.move(Position(2.0, 2.0));
+
+  Polygon polygon;
+  polygon.addVertex(Position(6.1, 4.6));
+  polygon.addVertex(Position(0.9, 4.6));
+  polygon.addVertex(Position(0.9, -0.6));
+  polygon.addVertex(Position(6.1, -0.6));
+  grid_map_utils::PolygonIterator iterator(map, polygon);
+
+  // the range of columns crossing the end of the buffer is split
+  const auto & spans = iterator.getSpans();
+  ASSERT_FALSE(spans.empty());
+  for (size_t i = 0; i + 1 < spans.size(); i += 2) {
+    EXPECT_EQ(spans[i].row, spans[i + 1].row);
+    EXPECT_EQ(spans[i].to_col, map.getSize()(1));
+    EXPECT_EQ(spans[i + 1].from_col, 0);
+  }
+
+  // the spans are the cells iterated on, in the same order
+  for (const auto & span : spans) {
+    for (int col = span.from_col; col < span.to_col; ++col) {
+      ASSERT_FALSE(iterator.isPastEnd());
+      EXPECT_EQ((*iterator)(0), span.row);
+      EXPECT_EQ((*iterator)(1), col);
+      ++iterator;
+    }
+  }
+  EXPECT_TRUE(iterator.isPastEnd());
+}
@@ -19,6 +19,7 @@
 #include "tier4_autoware_utils/geometry/geometry.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iostream>
 #include <numeric>
@@ -86,8 +87,29 @@ public:
   //            return value will be dx/dt(t) vector
   std::vector<double> getSplineInterpolatedDiffValues(const std::vector<double> & query_keys) const;
 
+  //!< @brief get 2nd differential values of spline interpolation on designated sampling points.
+  //!< @details return value will be d^2x/dt^2(t) vector
+  std::vector<double> getSplineInterpolatedQuadDiffValues(
+    const std::vector<double> & query_keys) const;
+
+  //!< @brief get values, 1st and 2nd differential values at once on designated sampling points.
+  //!< @details The segments of the sorted query_keys are found in one pass, and the return value
+  //            will be {x(t), dx/dt(t), d^2x/dt^2(t)} vectors
+  std::array<std::vector<double>, 3> getSplineInterpolatedValuesAndDiffs(
+    const std::vector<double> & query_keys) const;
+
+  //!< @brief get value and 1st differential value of spline interpolation on one sampling point.
+  //!< @details The segment of query_key is found by binary search, instead of the linear search
+  //            from the first segment of the functions for the vectors
+  double getSplineInterpolatedValue(const double query_key) const;
+  double getSplineInterpolatedDiffValue(const double query_key) const;
+
 private:
+  // index of the segment of query_key, throws as interpolation_utils::validateKeys()
+  size_t findSegmentIndex(const double query_key) const;
+
   std::vector<double> base_keys_;
+  bool is_base_keys_increasing_{false};
   interpolation::MultiSplineCoef multi_spline_coef_;
 };
 
@@ -14,6 +14,11 @@
 
 #include "interpolation/spline_interpolation.hpp"
 
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace
@@ -216,6 +221,7 @@ void SplineInterpolation::calcSplineCoefficients(
   }
 
   base_keys_ = base_keys;
+  is_base_keys_increasing_ = interpolation_utils::isIncreasing(base_keys_);
 }
 
 std::vector<double> SplineInterpolation::getSplineInterpolatedValues(
@@ -266,3 +272,93 @@ std::vector<double> SplineInterpolation::getSplineInterpolatedDiffValues(
 
   return res;
 }
+
+std::vector<double> SplineInterpolation::getSplineInterpolatedQuadDiffValues(
+  const std::vector<double> & query_keys) const
+{
+  // throw exceptions for invalid arguments
+  interpolation_utils::validateKeys(base_keys_, query_keys);
+
+  const auto & a = multi_spline_coef_.a;
+  const auto & b = multi_spline_coef_.b;
+
+  std::vector<double> res;
+  size_t j = 0;
+  for (const auto & query_key : query_keys) {
+    while (base_keys_.at(j + 1) < query_key) {
+      ++j;
+    }
+
+    const double ds = query_key - base_keys_.at(j);
+    res.push_back(2.0 * b.at(j) + 6.0 * a.at(j) * ds);
+  }
+
+  return res;
+}
+
+std::array<std::vector<double>, 3> SplineInterpolation::getSplineInterpolatedValuesAndDiffs(
+  const std::vector<double> & query_keys) const
+{
+  // throw exceptions for invalid arguments
+  interpolation_utils::validateKeys(base_keys_, query_keys);
+
+  const auto & a = multi_spline_coef_.a;
+  const auto & b = multi_spline_coef_.b;
+  const auto & c = multi_spline_coef_.c;
+  const auto & d = multi_spline_coef_.d;
+
+  std::array<std::vector<double>, 3> res;
+  for (auto & values : res) {
+    values.reserve(query_keys.size());
+  }
+  size_t j = 0;
+  for (const auto & query_key : query_keys) {
+    while (base_keys_.at(j + 1) < query_key) {
+      ++j;
+    }
+
+    const double ds = query_key - base_keys_.at(j);
+    res.at(0).push_back(d.at(j) + (c.at(j) + (b.at(j) + a.at(j) * ds) * ds) * ds);
+    res.at(1).push_back(c.at(j) + (2.0 * b.at(j) + 3.0 * a.at(j) * ds) * ds);
+    res.at(2).push_back(2.0 * b.at(j) + 6.0 * a.at(j) * ds);
+  }
+
+  return res;
+}
+
+double SplineInterpolation::getSplineInterpolatedValue(const double query_key) const
+{
+  const size_t j = findSegmentIndex(query_key);
+
+  const auto & m = multi_spline_coef_;
+  const double ds = query_key - base_keys_.at(j);
+  return m.d.at(j) + (m.c.at(j) + (m.b.at(j) + m.a.at(j) * ds) * ds) * ds;
+}
+
+double SplineInterpolation::getSplineInterpolatedDiffValue(const double query_key) const
+{
+  const size_t j = findSegmentIndex(query_key);
+
+  const auto & m = multi_spline_coef_;
+  const double ds = query_key - base_keys_.at(j);
+  return m.c.at(j) + (2.0 * m.b.at(j) + 3.0 * m.a.at(j) * ds) * ds;
+}
+
+size_t SplineInterpolation::findSegmentIndex(const double query_key) const
+{
+  // the base keys are validated once on calcSplineCoefficients()
+  if (base_keys_.size() < 2) {
+    throw std::invalid_argument(
+      "The size of points is less than 2. base_keys.size() = " + std::to_string(base_keys_.size()));
+  }
+  if (!is_base_keys_increasing_) {
+    throw std::invalid_argument("Either base_keys or query_keys is not sorted.");
+  }
+  if (query_key < base_keys_.front() || base_keys_.back() < query_key) {
+    throw std::invalid_argument("query_keys is out of base_keys");
+  }
+
+  // the first segment whose end is not before query_key, as the linear search
+  const auto itr = std::lower_bound(base_keys_.begin() + 1, base_keys_.end(), query_key);
+  return static_cast<size_t>(std::distance(base_keys_.begin(), itr)) - 1;
+}
@@ -103,8 +103,8 @@ geometry_msgs::msg::Point SplineInterpolationPoints2d::getSplineInterpolatedPoin
     whole_s = base_s_vec_.back();
   }
 
-  const double x = slerp_x_.getSplineInterpolatedValues({whole_s}).at(0);
-  const double y = slerp_y_.getSplineInterpolatedValues({whole_s}).at(0);
+  const double x = slerp_x_.getSplineInterpolatedValue(whole_s);
+  const double y = slerp_y_.getSplineInterpolatedValue(whole_s);
 
   geometry_msgs::msg::Point geom_point;
   geom_point.x = x;
@@ -126,8 +126,8 @@ double SplineInterpolationPoints2d::getSplineInterpolatedYaw(const size_t idx, c
     whole_s = base_s_vec_.back();
   }
 
-  const double diff_x = slerp_x_.getSplineInterpolatedDiffValues({whole_s}).at(0);
-  const double diff_y = slerp_y_.getSplineInterpolatedDiffValues({whole_s}).at(0);
+  const double diff_x = slerp_x_.getSplineInterpolatedDiffValue(whole_s);
+  const double diff_y = slerp_y_.getSplineInterpolatedDiffValue(whole_s);
 
   return std::atan2(diff_y, diff_x);
 }
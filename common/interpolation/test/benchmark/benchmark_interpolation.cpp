@@ -0,0 +1,118 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "interpolation/linear_interpolation.hpp"
+#include "interpolation/spline_interpolation.hpp"
+#include "interpolation/spline_interpolation_points_2d.hpp"
+#include "interpolation/zero_order_hold.hpp"
+#include "tier4_autoware_utils/geometry/geometry.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+struct Samples
+{
+  std::vector<double> base_keys;
+  std::vector<double> base_values;
+  std::vector<double> query_keys;
+};
+
+// base keys at intervals of 1 and twice as many query keys, as a path is usually resampled
+Samples generateSamples(const size_t num_points)
+{
+  Samples samples;
+  for (size_t i = 0; i < num_points; ++i) {
+    samples.base_keys.push_back(static_cast<double>(i));
+    samples.base_values.push_back(std::sin(i * 0.1));
+  }
+  for (size_t i = 0; i < 2 * (num_points - 1); ++i) {
+    samples.query_keys.push_back(i * 0.5);
+  }
+  return samples;
+}
+
+void BM_lerp(benchmark::State & state)
+{
+  const auto s = generateSamples(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(interpolation::lerp(s.base_keys, s.base_values, s.query_keys));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_zeroOrderHold(benchmark::State & state)
+{
+  const auto s = generateSamples(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      interpolation::zero_order_hold(s.base_keys, s.base_values, s.query_keys));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_slerp(benchmark::State & state)
+{
+  const auto s = generateSamples(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(interpolation::slerp(s.base_keys, s.base_values, s.query_keys));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_slerpByAkima(benchmark::State & state)
+{
+  const auto s = generateSamples(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      interpolation::slerpByAkima(s.base_keys, s.base_values, s.query_keys));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+// the coefficients once, and the values with their derivatives many times, as the planners do
+void BM_splineInterpolatedValuesAndDiffs(benchmark::State & state)
+{
+  const auto s = generateSamples(state.range(0));
+  SplineInterpolation spline;
+  spline.calcSplineCoefficients(s.base_keys, s.base_values);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(spline.getSplineInterpolatedValuesAndDiffs(s.query_keys));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_slerpYawFromPoints(benchmark::State & state)
+{
+  std::vector<geometry_msgs::msg::Point> points;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    points.push_back(tier4_autoware_utils::createPoint(i, std::sin(i * 0.1), 0.0));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(interpolation::slerpYawFromPoints(points));
+  }
+  state.SetComplexityN(state.range(0));
+}
+}  // namespace
+
+// from a short path to a long route-length trajectory
+BENCHMARK(BM_lerp)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_zeroOrderHold)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_slerp)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_slerpByAkima)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_splineInterpolatedValuesAndDiffs)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_slerpYawFromPoints)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
@@ -310,6 +310,49 @@ TEST(spline_interpolation, SplineInterpolation)
   }
 }
 
+TEST(spline_interpolation, SplineInterpolationValuesAndDiffs)
+{
+  SplineInterpolation s;
+
+  const std::vector<double> base_keys{-1.5, 1.0, 5.0, 10.0, 15.0, 20.0};
+  const std::vector<double> base_values{-1.2, 0.5, 1.0, 1.2, 2.0, 1.0};
+  const std::vector<double> query_keys{-1.5, 0.0, 1.0, 8.0, 18.0, 20.0};
+
+  s.calcSplineCoefficients(base_keys, base_values);
+  const auto values = s.getSplineInterpolatedValues(query_keys);
+  const auto diff_values = s.getSplineInterpolatedDiffValues(query_keys);
+  const auto quad_diff_values = s.getSplineInterpolatedQuadDiffValues(query_keys);
+  const auto values_and_diffs = s.getSplineInterpolatedValuesAndDiffs(query_keys);
+
+  constexpr double ds = 1e-4;
+  for (size_t i = 0; i < query_keys.size(); ++i) {
+    const double key = query_keys.at(i);
+    EXPECT_NEAR(values_and_diffs.at(0).at(i), values.at(i), epsilon);
+    EXPECT_NEAR(values_and_diffs.at(1).at(i), diff_values.at(i), epsilon);
+    EXPECT_NEAR(values_and_diffs.at(2).at(i), quad_diff_values.at(i), epsilon);
+
+    // one sampling point
+    EXPECT_NEAR(s.getSplineInterpolatedValue(key), values.at(i), epsilon);
+    EXPECT_NEAR(s.getSplineInterpolatedDiffValue(key), diff_values.at(i), epsilon);
+
+    // 2nd differential value by the numerical differential inside the base keys
+    const double prev_key = std::max(key - ds, base_keys.front());
+    const double next_key = std::min(key + ds, base_keys.back());
+    const double numerical_quad_diff =
+      (s.getSplineInterpolatedDiffValue(next_key) - s.getSplineInterpolatedDiffValue(prev_key)) /
+      (next_key - prev_key);
+    EXPECT_NEAR(quad_diff_values.at(i), numerical_quad_diff, 1e-2);
+  }
+
+  // natural spline
+  EXPECT_NEAR(quad_diff_values.front(), 0.0, epsilon);
+  EXPECT_NEAR(quad_diff_values.back(), 0.0, epsilon);
+
+  // out of base keys
+  EXPECT_THROW(s.getSplineInterpolatedValue(-2.0), std::invalid_argument);
+  EXPECT_THROW(s.getSplineInterpolatedDiffValue(21.0), std::invalid_argument);
+}
+
 TEST(spline_interpolation, SplineInterpolationPoints2d)
 {
   using tier4_autoware_utils::createPoint;
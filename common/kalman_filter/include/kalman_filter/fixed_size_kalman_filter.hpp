@@ -0,0 +1,144 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KALMAN_FILTER__FIXED_SIZE_KALMAN_FILTER_HPP_
+#define KALMAN_FILTER__FIXED_SIZE_KALMAN_FILTER_HPP_
+
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/LU>
+
+/**
+ * @file fixed_size_kalman_filter.hpp
+ * @brief kalman filter on a state of fixed dimension
+ *
+ * Same filter as KalmanFilter with the state and covariance of compile time dimensions, so that
+ * the filter and its predictions and updates allocate nothing. The measurements may have any
+ * dimension up to MaxDimY, which is chosen on each update, and are kept on the stack as well.
+ */
+template <int DimX, int MaxDimY = DimX>
+class FixedSizeKalmanFilter
+{
+public:
+  static constexpr int dim_x = DimX;
+  static constexpr int max_dim_y = MaxDimY;
+
+  using StateVector = Eigen::Matrix<double, DimX, 1>;
+  using StateMatrix = Eigen::Matrix<double, DimX, DimX>;
+  using MeasurementVector = Eigen::Matrix<double, Eigen::Dynamic, 1, 0, MaxDimY, 1>;
+  using MeasurementMatrix = Eigen::Matrix<double, Eigen::Dynamic, DimX, 0, MaxDimY, DimX>;
+  using MeasurementCovariance =
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, MaxDimY, MaxDimY>;
+
+  /**
+   * @brief initialization of kalman filter
+   * @param x initial state
+   * @param P0 initial covariance of estimated state
+   */
+  void init(const StateVector & x, const StateMatrix & P0)
+  {
+    x_ = x;
+    P_ = P0;
+  }
+
+  /**
+   * @brief get current kalman filter state
+   * @param x kalman filter state
+   */
+  void getX(StateVector & x) const { x = x_; }
+
+  /**
+   * @brief get current kalman filter covariance
+   * @param P kalman filter covariance
+   */
+  void getP(StateMatrix & P) const { P = P_; }
+
+  /**
+   * @brief get component of current kalman filter state
+   * @param i index of kalman filter state
+   * @return value of i's component of the kalman filter state x[i]
+   */
+  double getXelement(const unsigned int i) const { return x_(i); }
+
+  /**
+   * @brief calculate kalman filter covariance with prediction model with x, A, Q matrix. This is
+   * mainly for EKF with variable matrix.
+   * @param x_next predicted state
+   * @param A coefficient matrix of x for process model
+   * @param Q covariance matrix for process model
+   * @return bool to check matrix operations are being performed properly
+   */
+  bool predict(const StateVector & x_next, const StateMatrix & A, const StateMatrix & Q)
+  {
+    x_ = x_next;
+    const StateMatrix AP = A * P_;
+    P_.noalias() = AP * A.transpose();
+    P_ += Q;
+    return true;
+  }
+
+  /**
+   * @brief calculate kalman filter state by measurement model with y_pred, C and R matrix. This is
+   * mainly for EKF with variable matrix.
+   * @param y measured values
+   * @param y_pred output values expected from measurement model
+   * @param C coefficient matrix of x for measurement model
+   * @param R covariance matrix for measurement model
+   * @return bool to check matrix operations are being performed properly
+   */
+  bool update(
+    const MeasurementVector & y, const MeasurementVector & y_pred, const MeasurementMatrix & C,
+    const MeasurementCovariance & R)
+  {
+    if (
+      R.rows() != R.cols() || R.rows() != C.rows() || y.rows() != y_pred.rows() ||
+      y.rows() != C.rows()) {
+      return false;
+    }
+
+    using Gain = Eigen::Matrix<double, DimX, Eigen::Dynamic, 0, DimX, MaxDimY>;
+    const Gain PCT = P_ * C.transpose();
+    const MeasurementCovariance S = R + C * PCT;
+    const Gain K = PCT * S.inverse();
+
+    if (!K.allFinite()) {
+      return false;
+    }
+
+    x_.noalias() += K * (y - y_pred);
+    // P = P - K * (C * P) where C * P = PCT', P being symmetric
+    P_.noalias() -= K * PCT.transpose();
+    return true;
+  }
+
+  /**
+   * @brief calculate kalman filter state by measurement model with C and R matrix. This is mainly
+   * for EKF with variable matrix.
+   * @param y measured values
+   * @param C coefficient matrix of x for measurement model
+   * @param R covariance matrix for measurement model
+   * @return bool to check matrix operations are being performed properly
+   */
+  bool update(
+    const MeasurementVector & y, const MeasurementMatrix & C, const MeasurementCovariance & R)
+  {
+    const MeasurementVector y_pred = C * x_;
+    return update(y, y_pred, C, R);
+  }
+
+private:
+  StateVector x_{StateVector::Zero()};  //!< @brief current estimated state
+  StateMatrix P_{StateMatrix::Zero()};  //!< @brief covariance of estimated state
+};
+
+#endif  // KALMAN_FILTER__FIXED_SIZE_KALMAN_FILTER_HPP_
@@ -0,0 +1,184 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef KALMAN_FILTER__FIXED_SIZE_TIME_DELAY_KALMAN_FILTER_HPP_
+#define KALMAN_FILTER__FIXED_SIZE_TIME_DELAY_KALMAN_FILTER_HPP_
+
+#include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/LU>
+
+#include <algorithm>
+#include <iostream>
+
+/**
+ * @file fixed_size_time_delay_kalman_filter.hpp
+ * @brief kalman filter with delayed measurement, on a state of fixed dimension
+ *
+ * Same filter as TimeDelayKalmanFilter, but the latest state and the measurements have compile
+ * time dimensions and the extended state is allocated once in init(). The delayed states are kept
+ * in a ring buffer of blocks, so that a prediction writes the new latest state over the oldest one
+ * instead of shifting the whole extended state, and only the row and column blocks of the latest
+ * state are computed. An update only reads the column block of the delayed state it is measured
+ * against, which leaves a rank dim_y correction of the extended covariance.
+ */
+template <int DimX>
+class FixedSizeTimeDelayKalmanFilter
+{
+public:
+  static constexpr int dim_x = DimX;
+
+  using StateVector = Eigen::Matrix<double, DimX, 1>;
+  using StateMatrix = Eigen::Matrix<double, DimX, DimX>;
+
+  /**
+   * @brief initialization of kalman filter
+   * @param x initial state
+   * @param P0 initial covariance of estimated state
+   * @param max_delay_step Maximum number of delay steps, which determines the dimension of the
+   * extended kalman filter
+   */
+  void init(const StateVector & x, const StateMatrix & P0, const int max_delay_step)
+  {
+    max_delay_step_ = std::max(max_delay_step, 1);
+    const int dim_x_ex = DimX * max_delay_step_;
+    latest_ = 0;
+
+    x_.resize(dim_x_ex);
+    P_.setZero(dim_x_ex, dim_x_ex);
+    PCT_.resize(dim_x_ex, DimX);
+    K_.resize(dim_x_ex, DimX);
+    for (int i = 0; i < max_delay_step_; ++i) {
+      x_.template segment<DimX>(i * DimX) = x;
+      P_.template block<DimX, DimX>(i * DimX, i * DimX) = P0;
+    }
+  }
+
+  /**
+   * @brief get latest time estimated state
+   * @param x latest time estimated state
+   */
+  void getLatestX(StateVector & x) const { x = x_.template segment<DimX>(latest_ * DimX); }
+
+  /**
+   * @brief get latest time estimation covariance
+   * @param P latest time estimation covariance
+   */
+  void getLatestP(StateMatrix & P) const
+  {
+    P = P_.template block<DimX, DimX>(latest_ * DimX, latest_ * DimX);
+  }
+
+  /**
+   * @brief get i-th element of the extended state, delay_step * dim_x + j being the j-th element
+   * of the state delay_step steps ago
+   */
+  double getXelement(const unsigned int i) const
+  {
+    return x_(getSlot(static_cast<int>(i) / DimX) * DimX + static_cast<int>(i) % DimX);
+  }
+
+  /**
+   * @brief calculate kalman filter covariance by precision model with time delay. This is mainly
+   * for EKF of nonlinear process model.
+   * @param x_next predicted state by prediction model
+   * @param A coefficient matrix of x for process model
+   * @param Q covariance matrix for process model
+   */
+  bool predictWithDelay(const StateVector & x_next, const StateMatrix & A, const StateMatrix & Q)
+  {
+    /*
+     * The covariance of the time delay model becomes, as in TimeDelayKalmanFilter,
+     *
+     *     [A*P11*A'*+Q  A*P11  A*P12]
+     * P = [     P11*A'    P11    P12]
+     *     [     P21*A'    P21    P22]
+     *
+     * where the blocks Pij of the delayed states do not change. The new latest state takes the
+     * slot of the oldest one, which gets dropped.
+     */
+    const int prev = latest_;
+    latest_ = getSlot(max_delay_step_ - 1);
+    const int row = latest_ * DimX;
+
+    const StateMatrix P11 = P_.template block<DimX, DimX>(prev * DimX, prev * DimX);
+    for (int j = 0; j < max_delay_step_; ++j) {
+      if (j == latest_) {
+        continue;
+      }
+      P_.template block<DimX, DimX>(row, j * DimX).noalias() =
+        A * P_.template block<DimX, DimX>(prev * DimX, j * DimX);
+      P_.template block<DimX, DimX>(j * DimX, row) =
+        P_.template block<DimX, DimX>(row, j * DimX).transpose();
+    }
+    P_.template block<DimX, DimX>(row, row).noalias() = A * P11 * A.transpose() + Q;
+
+    x_.template segment<DimX>(row) = x_next;
+    return true;
+  }
+
+  /**
+   * @brief calculate kalman filter covariance by measurement model with time delay. This is mainly
+   * for EKF of nonlinear process model.
+   * @param y measured values
+   * @param C coefficient matrix of x for measurement model
+   * @param R covariance matrix for measurement model
+   * @param delay_step measurement delay
+   */
+  template <int DimY>
+  bool updateWithDelay(
+    const Eigen::Matrix<double, DimY, 1> & y, const Eigen::Matrix<double, DimY, DimX> & C,
+    const Eigen::Matrix<double, DimY, DimY> & R, const int delay_step)
+  {
+    static_assert(DimY <= DimX, "the measurement dimension must not exceed the state dimension");
+    if (delay_step >= max_delay_step_) {
+      std::cerr << "delay step is larger than max_delay_step. ignore update." << std::endl;
+      return false;
+    }
+
+    /* the measurement matrix of the extended state is only non zero on the delayed state */
+    const int col = getSlot(delay_step) * DimX;
+    auto PCT = PCT_.template leftCols<DimY>();
+    auto K = K_.template leftCols<DimY>();
+    PCT.noalias() = P_.template middleCols<DimX>(col).lazyProduct(C.transpose());
+    const Eigen::Matrix<double, DimY, DimY> S =
+      R + C * PCT.template middleRows<DimX>(col).eval();
+    K.noalias() = PCT.lazyProduct(S.inverse());
+
+    if (!K.allFinite()) {
+      return false;
+    }
+
+    const Eigen::Matrix<double, DimY, 1> y_pred = C * x_.template segment<DimX>(col);
+    x_.noalias() += K.lazyProduct(y - y_pred);
+    // P = P - K * (C * P) where C * P = PCT', P being symmetric
+    P_.noalias() -= K.lazyProduct(PCT.transpose());
+    return true;
+  }
+
+private:
+  // slot of the state delay_step steps ago in the ring buffer of the extended state
+  int getSlot(const int delay_step) const { return (latest_ + delay_step) % max_delay_step_; }
+
+  int max_delay_step_{1};  //!< @brief maximum number of delay steps
+  int latest_{0};          //!< @brief slot of the latest state
+
+  Eigen::VectorXd x_;  //!< @brief extended state, in ring buffer order
+  Eigen::MatrixXd P_;  //!< @brief covariance of the extended state, in ring buffer order
+
+  // work buffers of the update, of dim_x_ex rows
+  Eigen::Matrix<double, Eigen::Dynamic, DimX> PCT_;
+  Eigen::Matrix<double, Eigen::Dynamic, DimX> K_;
+};
+
+#endif  // KALMAN_FILTER__FIXED_SIZE_TIME_DELAY_KALMAN_FILTER_HPP_
@@ -20,6 +20,7 @@
 #include "motion_utils/trajectory/path_with_lane_id.hpp"
 #include "motion_utils/trajectory/tmp_conversion.hpp"
 #include "motion_utils/trajectory/trajectory.hpp"
+#include "motion_utils/trajectory/trajectory_view.hpp"
 #include "motion_utils/vehicle/vehicle_state_checker.hpp"
 
 #endif  // MOTION_UTILS__MOTION_UTILS_HPP_
@@ -56,6 +56,25 @@ std::vector<geometry_msgs::msg::Pose> resamplePath(
   const std::vector<double> & resampled_arclength, const bool use_lerp_for_xy = false,
   const bool use_lerp_for_z = true);
 
+/**
+ * @brief A resampling function for a path(poses) into output_points, as resamplePath() above. The
+ * capacity of output_points is reused, and all of the positions are interpolated in one pass over
+ * resampled_arclength.
+ * @param input_path input path(poses) to resample
+ * @param resampled_arclength arclength that contains length of each resampling points from initial
+ * point
+ * @param output_points resampled path(poses), or the input path(poses) if it is wrong
+ * @param use_lerp_for_xy If true, it uses linear interpolation to resample position x and
+ * y. Otherwise, it uses spline interpolation
+ * @param use_lerp_for_z If true, it uses linear interpolation to resample position z.
+ * Otherwise, it uses spline interpolation
+ */
+void resamplePath(
+  const std::vector<geometry_msgs::msg::Pose> & points,
+  const std::vector<double> & resampled_arclength,
+  std::vector<geometry_msgs::msg::Pose> & output_points, const bool use_lerp_for_xy = false,
+  const bool use_lerp_for_z = true);
+
 /**
  * @brief A resampling function for a path with lane id. Note that in a default setting, position xy
  * are resampled by spline interpolation, position z are resampled by linear interpolation,
@@ -126,6 +145,27 @@ autoware_auto_planning_msgs::msg::Path resamplePath(
   const std::vector<double> & resampled_arclength, const bool use_lerp_for_xy = false,
   const bool use_lerp_for_z = true, const bool use_zero_order_hold_for_v = true);
 
+/**
+ * @brief A resampling function for a path into output_path, as resamplePath() above. The capacity
+ * of the points of output_path is reused, and all of the fields are interpolated in one pass over
+ * resampled_arclength.
+ * @param input_path input path to resample
+ * @param resampled_arclength arclength that contains length of each resampling points from initial
+ * point
+ * @param output_path resampled path, or the input path if it is wrong
+ * @param use_lerp_for_xy If true, it uses linear interpolation to resample position x and
+ * y. Otherwise, it uses spline interpolation
+ * @param use_lerp_for_z If true, it uses linear interpolation to resample position z.
+ * Otherwise, it uses spline interpolation
+ * @param use_zero_order_hold_for_v If true, it uses zero_order_hold to resample
+ * longitudinal and lateral velocity. Otherwise, it uses linear interpolation
+ */
+void resamplePath(
+  const autoware_auto_planning_msgs::msg::Path & input_path,
+  const std::vector<double> & resampled_arclength,
+  autoware_auto_planning_msgs::msg::Path & output_path, const bool use_lerp_for_xy = false,
+  const bool use_lerp_for_z = true, const bool use_zero_order_hold_for_v = true);
+
 /**
  * @brief A resampling function for a trajectory. Note that in a default setting, position xy are
  * resampled by spline interpolation, position z are resampled by linear interpolation, twist
@@ -149,6 +189,28 @@ autoware_auto_planning_msgs::msg::Trajectory resampleTrajectory(
   const std::vector<double> & resampled_arclength, const bool use_lerp_for_xy = false,
   const bool use_lerp_for_z = true, const bool use_zero_order_hold_for_twist = true);
 
+/**
+ * @brief A resampling function for a trajectory into output_trajectory, as resampleTrajectory()
+ * above. The capacity of the points of output_trajectory is reused, and all of the fields are
+ * interpolated in one pass over resampled_arclength.
+ * @param input_trajectory input trajectory to resample
+ * @param resampled_arclength arclength that contains length of each resampling points from initial
+ * point
+ * @param output_trajectory resampled trajectory, or the input trajectory if it is wrong
+ * @param use_lerp_for_xy If true, it uses linear interpolation to resample position x and
+ * y. Otherwise, it uses spline interpolation
+ * @param use_lerp_for_z If true, it uses linear interpolation to resample position z.
+ * Otherwise, it uses spline interpolation
+ * @param use_zero_order_hold_for_twist If true, it uses zero_order_hold to resample
+ * longitudinal, lateral velocity and acceleration. Otherwise, it uses linear interpolation
+ */
+void resampleTrajectory(
+  const autoware_auto_planning_msgs::msg::Trajectory & input_trajectory,
+  const std::vector<double> & resampled_arclength,
+  autoware_auto_planning_msgs::msg::Trajectory & output_trajectory,
+  const bool use_lerp_for_xy = false, const bool use_lerp_for_z = true,
+  const bool use_zero_order_hold_for_twist = true);
+
 /**
  * @brief A resampling function for a trajectory. This function resamples closest stop point,
  * terminal point and points by resample interval. Note that in a default setting, position xy are
@@ -209,6 +209,57 @@ boost::optional<size_t> findNearestIndex(
   return is_nearest_found ? boost::optional<size_t>(min_idx) : boost::none;
 }
 
+/**
+ * @brief find nearest point index to point, searching around hint_idx
+ *        From hint_idx, the search moves along the points in both directions while they do not
+ *        get farther, and returns the nearest of them. It is the index of findNearestIndex()
+ *        unless the points come back near the point after going away from it, so that the hint
+ *        should be near the answer, e.g. the nearest index of the previous cycle.
+ * @param points points of trajectory
+ * @param point point to which to find nearest index
+ * @param hint_idx index to start the search from, clamped to the last index
+ * @return nearest index
+ */
+template <class T>
+size_t findNearestIndexWithHint(
+  const T & points, const geometry_msgs::msg::Point & point, const size_t hint_idx)
+{
+  validateNonEmpty(points);
+
+  const size_t start_idx = std::min(hint_idx, points.size() - 1);
+  double min_dist = tier4_autoware_utils::calcSquaredDistance2d(points.at(start_idx), point);
+  size_t min_idx = start_idx;
+
+  // backward, where the same distance is taken to return the first nearest index
+  double prev_dist = min_dist;
+  for (size_t i = start_idx; i > 0; --i) {
+    const auto dist = tier4_autoware_utils::calcSquaredDistance2d(points.at(i - 1), point);
+    if (prev_dist < dist) {
+      break;
+    }
+    prev_dist = dist;
+    if (dist <= min_dist) {
+      min_dist = dist;
+      min_idx = i - 1;
+    }
+  }
+
+  // forward
+  prev_dist = tier4_autoware_utils::calcSquaredDistance2d(points.at(start_idx), point);
+  for (size_t i = start_idx + 1; i < points.size(); ++i) {
+    const auto dist = tier4_autoware_utils::calcSquaredDistance2d(points.at(i), point);
+    if (prev_dist < dist) {
+      break;
+    }
+    prev_dist = dist;
+    if (dist < min_dist) {
+      min_dist = dist;
+      min_idx = i;
+    }
+  }
+  return min_idx;
+}
+
 /**
  * @brief calculate longitudinal offset (length along trajectory from seg_idx point to nearest point
  * to p_target on trajectory) If seg_idx point is after that nearest point, length is negative
@@ -329,6 +380,36 @@ boost::optional<size_t> findNearestSegmentIndex(
   return *nearest_idx;
 }
 
+/**
+ * @brief find nearest segment index to point, searching around hint_idx
+ *        The nearest index is searched as findNearestIndexWithHint()
+ * @param points points of trajectory
+ * @param point point to which to find nearest segment index
+ * @param hint_idx index to start the search from, e.g. the segment index of the previous cycle
+ * @return nearest index
+ */
+template <class T>
+size_t findNearestSegmentIndexWithHint(
+  const T & points, const geometry_msgs::msg::Point & point, const size_t hint_idx)
+{
+  const size_t nearest_idx = findNearestIndexWithHint(points, point, hint_idx);
+
+  if (nearest_idx == 0) {
+    return 0;
+  }
+  if (nearest_idx == points.size() - 1) {
+    return points.size() - 2;
+  }
+
+  const double signed_length = calcLongitudinalOffsetToSegment(points, nearest_idx, point);
+
+  if (signed_length <= 0) {
+    return nearest_idx - 1;
+  }
+
+  return nearest_idx;
+}
+
 /**
  * @brief calculate lateral offset from p_target (length from p_target to trajectory)
  *        If seg_idx point is after that nearest point, length is negative
@@ -1159,10 +1240,14 @@ size_t findFirstNearestIndexWithSoftConstraints(
     for (size_t i = 0; i < points.size(); ++i) {
       const auto squared_dist =
         tier4_autoware_utils::calcSquaredDistance2d(points.at(i), pose.position);
-      const auto yaw =
-        tier4_autoware_utils::calcYawDeviation(tier4_autoware_utils::getPose(points.at(i)), pose);
-
-      if (squared_dist_threshold < squared_dist || yaw_threshold < std::abs(yaw)) {
+      // the yaw deviation is only calculated for the points within the dist threshold
+      const auto is_over_yaw_threshold = [&]() {
+        const auto yaw = tier4_autoware_utils::calcYawDeviation(
+          tier4_autoware_utils::getPose(points.at(i)), pose);
+        return yaw_threshold < std::abs(yaw);
+      };
+
+      if (squared_dist_threshold < squared_dist || is_over_yaw_threshold()) {
         if (is_within_constraints) {
           break;
         } else {
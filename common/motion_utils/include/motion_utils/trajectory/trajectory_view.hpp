@@ -0,0 +1,225 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MOTION_UTILS__TRAJECTORY__TRAJECTORY_VIEW_HPP_
+#define MOTION_UTILS__TRAJECTORY__TRAJECTORY_VIEW_HPP_
+
+#include "motion_utils/trajectory/trajectory.hpp"
+#include "tier4_autoware_utils/geometry/batch_geometry.hpp"
+#include "tier4_autoware_utils/geometry/geometry.hpp"
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace motion_utils
+{
+/**
+ * @brief points of trajectory (or path) with the arc length of each point from the front point
+ *        The arc lengths are calculated once, so that the queries below are answered with a
+ *        binary search instead of summing the segment lengths on each call. The positions are
+ *        kept as arrays for the batch nearest search. The points are referred to, and have to
+ *        outlive the view without being modified.
+ */
+template <class T>
+class TrajectoryView
+{
+public:
+  explicit TrajectoryView(const T & points)
+  : points_(points), positions_(tier4_autoware_utils::toPointArray2d(points))
+  {
+    validateNonEmpty(points_);
+
+    arc_lengths_.reserve(points_.size());
+    arc_lengths_.push_back(0.0);
+    for (size_t i = 1; i < points_.size(); ++i) {
+      arc_lengths_.push_back(
+        arc_lengths_.back() +
+        tier4_autoware_utils::calcDistance2d(points_.at(i - 1), points_.at(i)));
+    }
+  }
+
+  const T & points() const { return points_; }
+
+  /**
+   * @brief arc length from the front point to the point of idx
+   */
+  double getArcLength(const size_t idx) const { return arc_lengths_.at(idx); }
+
+  /**
+   * @brief arc length from the front point to the back point, as calcArcLength()
+   */
+  double calcArcLength() const { return arc_lengths_.back(); }
+
+  /**
+   * @brief calcSignedArcLength from index to index
+   */
+  double calcSignedArcLength(const size_t src_idx, const size_t dst_idx) const
+  {
+    return arc_lengths_.at(dst_idx) - arc_lengths_.at(src_idx);
+  }
+
+  /**
+   * @brief arc length from the front point to the projection of point on the segment of seg_idx
+   * @param seg_idx segment index of point, e.g. from findNearestSegmentIndex()
+   */
+  double calcArcLength(const size_t seg_idx, const geometry_msgs::msg::Point & point) const
+  {
+    if (points_.size() < 2 || seg_idx >= points_.size() - 1) {
+      throw std::out_of_range("Segment index is invalid.");
+    }
+
+    const auto p_front = tier4_autoware_utils::getPoint(points_.at(seg_idx));
+    const auto p_back = tier4_autoware_utils::getPoint(points_.at(seg_idx + 1));
+    const double segment_length = arc_lengths_.at(seg_idx + 1) - arc_lengths_.at(seg_idx);
+    if (segment_length < 1e-6) {
+      return arc_lengths_.at(seg_idx);
+    }
+
+    const double offset =
+      ((p_back.x - p_front.x) * (point.x - p_front.x) +
+       (p_back.y - p_front.y) * (point.y - p_front.y)) /
+      segment_length;
+    return arc_lengths_.at(seg_idx) + offset;
+  }
+
+  /**
+   * @brief findNearestIndex() of the point, by the batch distances of the positions
+   */
+  size_t findNearestIndex(const geometry_msgs::msg::Point & point) const
+  {
+    return tier4_autoware_utils::findNearestIndex(positions_, point);
+  }
+
+  /**
+   * @brief index of the segment whose arc lengths contain arc_length, clamped to the segments
+   */
+  size_t findSegmentIndex(const double arc_length) const
+  {
+    if (points_.size() < 2) {
+      return 0;
+    }
+
+    const auto itr = std::lower_bound(arc_lengths_.begin() + 1, arc_lengths_.end(), arc_length);
+    if (itr == arc_lengths_.end()) {
+      return points_.size() - 2;
+    }
+    return static_cast<size_t>(std::distance(arc_lengths_.begin(), itr)) - 1;
+  }
+
+  /**
+   * @brief calculate the point offset from source point along the trajectory (or path), as
+   *        calcLongitudinalOffsetPoint()
+   * @param src_idx index of source point
+   * @param offset length of offset from source point
+   * @return offset point
+   */
+  boost::optional<geometry_msgs::msg::Point> calcLongitudinalOffsetPoint(
+    const size_t src_idx, const double offset) const
+  {
+    const auto interpolated = findInterpolatedSegment(src_idx, offset);
+    if (!interpolated) {
+      return {};
+    }
+
+    const auto & p_from = points_.at(interpolated->first);
+    if (interpolated->first + 1 == points_.size()) {
+      return tier4_autoware_utils::getPoint(p_from);
+    }
+    return tier4_autoware_utils::calcInterpolatedPoint(
+      p_from, points_.at(interpolated->first + 1), interpolated->second);
+  }
+
+  /**
+   * @brief calculate the pose offset from source point along the trajectory (or path), as
+   *        calcLongitudinalOffsetPose()
+   * @param src_idx index of source point
+   * @param offset length of offset from source point
+   * @param set_orientation_from_position_direction set orientation by spherical interpolation if
+   * false
+   * @return offset pose
+   */
+  boost::optional<geometry_msgs::msg::Pose> calcLongitudinalOffsetPose(
+    const size_t src_idx, const double offset,
+    const bool set_orientation_from_position_direction = true) const
+  {
+    const auto interpolated = findInterpolatedSegment(src_idx, offset);
+    if (!interpolated) {
+      return {};
+    }
+
+    const auto & p_from = points_.at(interpolated->first);
+    if (interpolated->first + 1 == points_.size()) {
+      return tier4_autoware_utils::getPose(p_from);
+    }
+    return tier4_autoware_utils::calcInterpolatedPose(
+      p_from, points_.at(interpolated->first + 1), interpolated->second,
+      set_orientation_from_position_direction);
+  }
+
+private:
+  // segment index and ratio in it of the arc length offset from src_idx, or the index of the
+  // back point with a zero ratio when it is the source point itself
+  boost::optional<std::pair<size_t, double>> findInterpolatedSegment(
+    const size_t src_idx, const double offset) const
+  {
+    if (points_.size() - 1 < src_idx) {
+      std::cerr << "Invalid source index" << std::endl;
+      return {};
+    }
+
+    if (points_.size() == 1) {
+      return {};
+    }
+
+    if (src_idx + 1 == points_.size() && offset == 0.0) {
+      return std::make_pair(src_idx, 0.0);
+    }
+
+    const double target_arc_length = arc_lengths_.at(src_idx) + offset;
+    size_t seg_idx = 0;
+    if (offset < 0.0) {
+      // the last point before the target
+      const auto itr = std::upper_bound(
+        arc_lengths_.begin(), arc_lengths_.begin() + src_idx, target_arc_length);
+      if (itr == arc_lengths_.begin()) {
+        return {};
+      }
+      seg_idx = static_cast<size_t>(std::distance(arc_lengths_.begin(), itr)) - 1;
+    } else {
+      // the first point after the target
+      const auto itr = std::lower_bound(
+        arc_lengths_.begin() + src_idx + 1, arc_lengths_.end(), target_arc_length);
+      if (itr == arc_lengths_.end()) {
+        return {};
+      }
+      seg_idx = static_cast<size_t>(std::distance(arc_lengths_.begin(), itr)) - 1;
+    }
+
+    const double segment_length = arc_lengths_.at(seg_idx + 1) - arc_lengths_.at(seg_idx);
+    return std::make_pair(
+      seg_idx, (target_arc_length - arc_lengths_.at(seg_idx)) / segment_length);
+  }
+
+  const T & points_;
+  tier4_autoware_utils::PointArray2d positions_;
+  std::vector<double> arc_lengths_;
+};
+}  // namespace motion_utils
+
+#endif  // MOTION_UTILS__TRAJECTORY__TRAJECTORY_VIEW_HPP_
@@ -19,11 +19,179 @@
 constexpr double CLOSE_S_THRESHOLD = 1e-6;
 namespace motion_utils
 {
+namespace
+{
+// arc length of the input points from the front one, skipping the points overlapping the previous
+// one. input_indices are the indices of the points which are not skipped.
+template <class T>
+void calcInputArclength(
+  const T & points, std::vector<double> & input_arclength, std::vector<size_t> & input_indices)
+{
+  input_arclength.clear();
+  input_indices.clear();
+  input_arclength.reserve(points.size());
+  input_indices.reserve(points.size());
+
+  input_arclength.push_back(0.0);
+  input_indices.push_back(0);
+  for (size_t i = 1; i < points.size(); ++i) {
+    const double ds = tier4_autoware_utils::calcDistance2d(points.at(i - 1), points.at(i));
+    if (ds < CLOSE_S_THRESHOLD) {
+      continue;
+    }
+    input_arclength.push_back(ds + input_arclength.back());
+    input_indices.push_back(i);
+  }
+}
+
+// segment of linear interpolation and key of zero order hold at each query key, searched as
+// interpolation::lerp() and interpolation::zero_order_hold() once for all of the fields. The query
+// keys have to be updated in the increasing order.
+class InterpolationCursor
+{
+public:
+  explicit InterpolationCursor(const std::vector<double> & base_keys) : base_keys_(base_keys) {}
+
+  void update(const double query_key)
+  {
+    while (base_keys_.at(lerp_idx_ + 1) < query_key) {
+      ++lerp_idx_;
+    }
+    ratio_ = (query_key - base_keys_.at(lerp_idx_)) /
+             (base_keys_.at(lerp_idx_ + 1) - base_keys_.at(lerp_idx_));
+
+    constexpr double overlap_threshold = 1e-3;
+    if (base_keys_.back() - overlap_threshold < query_key) {
+      zoh_idx_ = base_keys_.size() - 1;
+      return;
+    }
+    // the keys after the first one beyond query_key do not hold it either
+    for (size_t j = zoh_idx_;
+         j < base_keys_.size() - 1 && base_keys_.at(j) - overlap_threshold < query_key; ++j) {
+      if (query_key < base_keys_.at(j + 1)) {
+        zoh_idx_ = j;
+      }
+    }
+  }
+
+  size_t getLerpIndex() const { return lerp_idx_; }
+  size_t getZeroOrderHoldIndex() const { return zoh_idx_; }
+  double lerp(const double src_val, const double dst_val) const
+  {
+    return interpolation::lerp(src_val, dst_val, ratio_);
+  }
+
+private:
+  const std::vector<double> & base_keys_;
+  size_t lerp_idx_{0};
+  size_t zoh_idx_{0};
+  double ratio_{0.0};
+};
+
+// position at each query key, the xy and z of which are interpolated linearly or by spline as
+// interpolation::lerp() and interpolation::slerp()
+class PositionInterpolator
+{
+public:
+  template <class T>
+  PositionInterpolator(
+    const T & points, const std::vector<double> & input_arclength,
+    const std::vector<size_t> & input_indices, const bool use_lerp_for_xy,
+    const bool use_lerp_for_z)
+  : use_lerp_for_xy_(use_lerp_for_xy), use_lerp_for_z_(use_lerp_for_z)
+  {
+    if (use_lerp_for_xy && use_lerp_for_z) {
+      return;
+    }
+
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+    x.reserve(input_indices.size());
+    y.reserve(input_indices.size());
+    z.reserve(input_indices.size());
+    for (const size_t idx : input_indices) {
+      const auto point = tier4_autoware_utils::getPoint(points.at(idx));
+      x.push_back(point.x);
+      y.push_back(point.y);
+      z.push_back(point.z);
+    }
+
+    if (!use_lerp_for_xy) {
+      spline_x_.calcSplineCoefficients(input_arclength, x);
+      spline_y_.calcSplineCoefficients(input_arclength, y);
+    }
+    if (!use_lerp_for_z) {
+      spline_z_.calcSplineCoefficients(input_arclength, z);
+    }
+  }
+
+  // src_point and dst_point are the input points of the segment of the cursor
+  template <class T>
+  geometry_msgs::msg::Point interpolate(
+    const double query_key, const InterpolationCursor & cursor, const T & src_point,
+    const T & dst_point) const
+  {
+    const auto src = tier4_autoware_utils::getPoint(src_point);
+    const auto dst = tier4_autoware_utils::getPoint(dst_point);
+
+    geometry_msgs::msg::Point point;
+    point.x = use_lerp_for_xy_ ? cursor.lerp(src.x, dst.x)
+                               : spline_x_.getSplineInterpolatedValue(query_key);
+    point.y = use_lerp_for_xy_ ? cursor.lerp(src.y, dst.y)
+                               : spline_y_.getSplineInterpolatedValue(query_key);
+    point.z =
+      use_lerp_for_z_ ? cursor.lerp(src.z, dst.z) : spline_z_.getSplineInterpolatedValue(query_key);
+    return point;
+  }
+
+private:
+  bool use_lerp_for_xy_;
+  bool use_lerp_for_z_;
+  SplineInterpolation spline_x_;
+  SplineInterpolation spline_y_;
+  SplineInterpolation spline_z_;
+};
+
+// orientation of the resampled points by a forward difference method, as resamplePath()
+template <class T>
+void insertResampledOrientation(
+  const T & input_points, const bool is_driving_forward,
+  const std::vector<double> & resampled_arclength, T & resampled_points)
+{
+  motion_utils::insertOrientation(resampled_points, is_driving_forward);
+
+  // Initial orientation is depend on the initial value of the resampled_arclength
+  // when backward driving
+  if (!is_driving_forward && resampled_arclength.front() < 1e-3) {
+    tier4_autoware_utils::setOrientation(
+      tier4_autoware_utils::getPose(input_points.at(0)).orientation, resampled_points.at(0));
+  }
+}
+}  // namespace
+
 std::vector<geometry_msgs::msg::Pose> resamplePath(
   const std::vector<geometry_msgs::msg::Pose> & points,
   const std::vector<double> & resampled_arclength, const bool use_lerp_for_xy,
   const bool use_lerp_for_z)
 {
+  std::vector<geometry_msgs::msg::Pose> resampled_points;
+  resamplePath(points, resampled_arclength, resampled_points, use_lerp_for_xy, use_lerp_for_z);
+  return resampled_points;
+}
+
+void resamplePath(
+  const std::vector<geometry_msgs::msg::Pose> & points,
+  const std::vector<double> & resampled_arclength,
+  std::vector<geometry_msgs::msg::Pose> & output_points, const bool use_lerp_for_xy,
+  const bool use_lerp_for_z)
+{
+  if (&points == &output_points) {
+    const auto input_points = points;
+    resamplePath(input_points, resampled_arclength, output_points, use_lerp_for_xy, use_lerp_for_z);
+    return;
+  }
+
   // Check vector size and if out_arclength have the end point of the path
   const double input_path_len = motion_utils::calcArcLength(points);
   if (
@@ -32,71 +200,35 @@ std::vector<geometry_msgs::msg::Pose> resamplePath(
     std::cerr
       << "[motion_utils]: input points size, input points length or resampled arclength is wrong"
       << std::endl;
-    return points;
+    output_points = points;
+    return;
   }
 
   // Input Path Information
   std::vector<double> input_arclength;
-  std::vector<double> x;
-  std::vector<double> y;
-  std::vector<double> z;
-  input_arclength.reserve(points.size());
-  x.reserve(points.size());
-  y.reserve(points.size());
-  z.reserve(points.size());
-
-  input_arclength.push_back(0.0);
-  x.push_back(points.front().position.x);
-  y.push_back(points.front().position.y);
-  z.push_back(points.front().position.z);
-  for (size_t i = 1; i < points.size(); ++i) {
-    const auto & prev_pt = points.at(i - 1);
-    const auto & curr_pt = points.at(i);
-    const double ds = tier4_autoware_utils::calcDistance2d(prev_pt.position, curr_pt.position);
-    if (ds < CLOSE_S_THRESHOLD) {
-      continue;
-    }
-    input_arclength.push_back(ds + input_arclength.at(i - 1));
-    x.push_back(curr_pt.position.x);
-    y.push_back(curr_pt.position.y);
-    z.push_back(curr_pt.position.z);
-  }
+  std::vector<size_t> input_indices;
+  calcInputArclength(points, input_arclength, input_indices);
+  interpolation_utils::validateKeys(input_arclength, resampled_arclength);
 
   // Interpolate
-  const auto lerp = [&](const auto & input) {
-    return interpolation::lerp(input_arclength, input, resampled_arclength);
-  };
-  const auto slerp = [&](const auto & input) {
-    return interpolation::slerp(input_arclength, input, resampled_arclength);
-  };
-
-  const auto interpolated_x = use_lerp_for_xy ? lerp(x) : slerp(x);
-  const auto interpolated_y = use_lerp_for_xy ? lerp(y) : slerp(y);
-  const auto interpolated_z = use_lerp_for_z ? lerp(z) : slerp(z);
-
-  std::vector<geometry_msgs::msg::Pose> resampled_points;
-  resampled_points.resize(interpolated_x.size());
-
-  // Insert Position, Velocity and Heading Rate
-  for (size_t i = 0; i < resampled_points.size(); ++i) {
-    geometry_msgs::msg::Pose pose;
-    pose.position.x = interpolated_x.at(i);
-    pose.position.y = interpolated_y.at(i);
-    pose.position.z = interpolated_z.at(i);
-    resampled_points.at(i) = pose;
+  const PositionInterpolator position_interpolator(
+    points, input_arclength, input_indices, use_lerp_for_xy, use_lerp_for_z);
+  InterpolationCursor cursor(input_arclength);
+
+  output_points.resize(resampled_arclength.size());
+  for (size_t i = 0; i < output_points.size(); ++i) {
+    const double query_key = resampled_arclength.at(i);
+    cursor.update(query_key);
+    const auto & src_point = points.at(input_indices.at(cursor.getLerpIndex()));
+    const auto & dst_point = points.at(input_indices.at(cursor.getLerpIndex() + 1));
+
+    output_points.at(i).position =
+      position_interpolator.interpolate(query_key, cursor, src_point, dst_point);
   }
 
   const bool is_driving_forward =
     tier4_autoware_utils::isDrivingForward(points.at(0), points.at(1));
-  motion_utils::insertOrientation(resampled_points, is_driving_forward);
-
-  // Initial orientation is depend on the initial value of the resampled_arclength
-  // when backward driving
-  if (!is_driving_forward && resampled_arclength.front() < 1e-3) {
-    resampled_points.at(0).orientation = points.at(0).orientation;
-  }
-
-  return resampled_points;
+  insertResampledOrientation(points, is_driving_forward, resampled_arclength, output_points);
 }
 
 autoware_auto_planning_msgs::msg::PathWithLaneId resamplePath(
@@ -281,6 +413,27 @@ autoware_auto_planning_msgs::msg::Path resamplePath(
   const std::vector<double> & resampled_arclength, const bool use_lerp_for_xy,
   const bool use_lerp_for_z, const bool use_zero_order_hold_for_v)
 {
+  autoware_auto_planning_msgs::msg::Path resampled_path;
+  resamplePath(
+    input_path, resampled_arclength, resampled_path, use_lerp_for_xy, use_lerp_for_z,
+    use_zero_order_hold_for_v);
+  return resampled_path;
+}
+
+void resamplePath(
+  const autoware_auto_planning_msgs::msg::Path & input_path,
+  const std::vector<double> & resampled_arclength,
+  autoware_auto_planning_msgs::msg::Path & output_path, const bool use_lerp_for_xy,
+  const bool use_lerp_for_z, const bool use_zero_order_hold_for_v)
+{
+  if (&input_path == &output_path) {
+    const auto path = input_path;
+    resamplePath(
+      path, resampled_arclength, output_path, use_lerp_for_xy, use_lerp_for_z,
+      use_zero_order_hold_for_v);
+    return;
+  }
+
   // Check vector size and if out_arclength have the end point of the path
   const double input_path_len = motion_utils::calcArcLength(input_path.points);
   if (
@@ -289,75 +442,52 @@ autoware_auto_planning_msgs::msg::Path resamplePath(
     std::cerr
       << "[motion_utils]: input path size, input path length or resampled arclength is wrong"
       << std::endl;
-    return input_path;
+    output_path = input_path;
+    return;
   }
 
   // Input Path Information
+  const auto & points = input_path.points;
   std::vector<double> input_arclength;
-  std::vector<geometry_msgs::msg::Pose> input_pose;
-  std::vector<double> v_lon;
-  std::vector<double> v_lat;
-  std::vector<double> heading_rate;
-  input_arclength.reserve(input_path.points.size());
-  input_pose.reserve(input_path.points.size());
-  v_lon.reserve(input_path.points.size());
-  v_lat.reserve(input_path.points.size());
-  heading_rate.reserve(input_path.points.size());
-
-  input_arclength.push_back(0.0);
-  input_pose.push_back(input_path.points.front().pose);
-  v_lon.push_back(input_path.points.front().longitudinal_velocity_mps);
-  v_lat.push_back(input_path.points.front().lateral_velocity_mps);
-  heading_rate.push_back(input_path.points.front().heading_rate_rps);
-  for (size_t i = 1; i < input_path.points.size(); ++i) {
-    const auto & prev_pt = input_path.points.at(i - 1);
-    const auto & curr_pt = input_path.points.at(i);
-    const double ds =
-      tier4_autoware_utils::calcDistance2d(prev_pt.pose.position, curr_pt.pose.position);
-    if (ds < CLOSE_S_THRESHOLD) {
-      continue;
-    }
-    input_arclength.push_back(ds + input_arclength.at(i - 1));
-    input_pose.push_back(curr_pt.pose);
-    v_lon.push_back(curr_pt.longitudinal_velocity_mps);
-    v_lat.push_back(curr_pt.lateral_velocity_mps);
-    heading_rate.push_back(curr_pt.heading_rate_rps);
-  }
+  std::vector<size_t> input_indices;
+  calcInputArclength(points, input_arclength, input_indices);
+  interpolation_utils::validateKeys(input_arclength, resampled_arclength);
 
   // Interpolate
-  const auto lerp = [&](const auto & input) {
-    return interpolation::lerp(input_arclength, input, resampled_arclength);
-  };
-  const auto zoh = [&](const auto & input) {
-    return interpolation::zero_order_hold(input_arclength, input, resampled_arclength);
-  };
-
-  const auto interpolated_pose =
-    resamplePath(input_pose, resampled_arclength, use_lerp_for_xy, use_lerp_for_z);
-  const auto interpolated_v_lon = use_zero_order_hold_for_v ? zoh(v_lon) : lerp(v_lon);
-  const auto interpolated_v_lat = use_zero_order_hold_for_v ? zoh(v_lat) : lerp(v_lat);
-  const auto interpolated_heading_rate = lerp(heading_rate);
-
-  if (interpolated_pose.size() != resampled_arclength.size()) {
-    std::cerr << "[motion_utils]: Resampled pose size is different from resampled arclength"
-              << std::endl;
-    return input_path;
+  const PositionInterpolator position_interpolator(
+    points, input_arclength, input_indices, use_lerp_for_xy, use_lerp_for_z);
+  InterpolationCursor cursor(input_arclength);
+
+  output_path.header = input_path.header;
+  output_path.drivable_area = input_path.drivable_area;
+  output_path.points.resize(resampled_arclength.size());
+  for (size_t i = 0; i < output_path.points.size(); ++i) {
+    const double query_key = resampled_arclength.at(i);
+    cursor.update(query_key);
+    const auto & src_point = points.at(input_indices.at(cursor.getLerpIndex()));
+    const auto & dst_point = points.at(input_indices.at(cursor.getLerpIndex() + 1));
+    const auto & zoh_point = points.at(input_indices.at(cursor.getZeroOrderHoldIndex()));
+    const auto interpolate_v = [&](const double src_v, const double dst_v, const double zoh_v) {
+      return use_zero_order_hold_for_v ? zoh_v : cursor.lerp(src_v, dst_v);
+    };
+
+    auto & path_point = output_path.points.at(i);
+    path_point.pose.position =
+      position_interpolator.interpolate(query_key, cursor, src_point, dst_point);
+    path_point.longitudinal_velocity_mps = interpolate_v(
+      src_point.longitudinal_velocity_mps, dst_point.longitudinal_velocity_mps,
+      zoh_point.longitudinal_velocity_mps);
+    path_point.lateral_velocity_mps = interpolate_v(
+      src_point.lateral_velocity_mps, dst_point.lateral_velocity_mps,
+      zoh_point.lateral_velocity_mps);
+    path_point.heading_rate_rps =
+      cursor.lerp(src_point.heading_rate_rps, dst_point.heading_rate_rps);
+    path_point.is_final = false;
   }
 
-  autoware_auto_planning_msgs::msg::Path resampled_path;
-  resampled_path.header = input_path.header;
-  resampled_path.drivable_area = input_path.drivable_area;
-  resampled_path.points.resize(interpolated_pose.size());
-  for (size_t i = 0; i < resampled_path.points.size(); ++i) {
-    autoware_auto_planning_msgs::msg::PathPoint path_point;
-    path_point.pose = interpolated_pose.at(i);
-    path_point.longitudinal_velocity_mps = interpolated_v_lon.at(i);
-    path_point.lateral_velocity_mps = interpolated_v_lat.at(i);
-    path_point.heading_rate_rps = interpolated_heading_rate.at(i);
-    resampled_path.points.at(i) = path_point;
-  }
-
-  return resampled_path;
+  const bool is_driving_forward =
+    tier4_autoware_utils::isDrivingForward(points.at(0), points.at(input_indices.at(1)));
+  insertResampledOrientation(points, is_driving_forward, resampled_arclength, output_path.points);
 }
 
 autoware_auto_planning_msgs::msg::Trajectory resampleTrajectory(
@@ -365,6 +495,27 @@ autoware_auto_planning_msgs::msg::Trajectory resampleTrajectory(
   const std::vector<double> & resampled_arclength, const bool use_lerp_for_xy,
   const bool use_lerp_for_z, const bool use_zero_order_hold_for_twist)
 {
+  autoware_auto_planning_msgs::msg::Trajectory resampled_trajectory;
+  resampleTrajectory(
+    input_trajectory, resampled_arclength, resampled_trajectory, use_lerp_for_xy, use_lerp_for_z,
+    use_zero_order_hold_for_twist);
+  return resampled_trajectory;
+}
+
+void resampleTrajectory(
+  const autoware_auto_planning_msgs::msg::Trajectory & input_trajectory,
+  const std::vector<double> & resampled_arclength,
+  autoware_auto_planning_msgs::msg::Trajectory & output_trajectory, const bool use_lerp_for_xy,
+  const bool use_lerp_for_z, const bool use_zero_order_hold_for_twist)
+{
+  if (&input_trajectory == &output_trajectory) {
+    const auto trajectory = input_trajectory;
+    resampleTrajectory(
+      trajectory, resampled_arclength, output_trajectory, use_lerp_for_xy, use_lerp_for_z,
+      use_zero_order_hold_for_twist);
+    return;
+  }
+
   // Check vector size and if out_arclength have the end point of the trajectory
   const double input_trajectory_len = motion_utils::calcArcLength(input_trajectory.points);
   if (
@@ -373,100 +524,60 @@ autoware_auto_planning_msgs::msg::Trajectory resampleTrajectory(
     std::cerr << "[motion_utils]: input trajectory size, input trajectory length or resampled "
                  "arclength is wrong"
               << std::endl;
-    return input_trajectory;
+    output_trajectory = input_trajectory;
+    return;
   }
 
   // Input Trajectory Information
+  const auto & points = input_trajectory.points;
   std::vector<double> input_arclength;
-  std::vector<geometry_msgs::msg::Pose> input_pose;
-  std::vector<double> v_lon;
-  std::vector<double> v_lat;
-  std::vector<double> heading_rate;
-  std::vector<double> acceleration;
-  std::vector<double> front_wheel_angle;
-  std::vector<double> rear_wheel_angle;
-  std::vector<double> time_from_start;
-  input_arclength.reserve(input_trajectory.points.size());
-  input_pose.reserve(input_trajectory.points.size());
-  v_lon.reserve(input_trajectory.points.size());
-  v_lat.reserve(input_trajectory.points.size());
-  heading_rate.reserve(input_trajectory.points.size());
-  acceleration.reserve(input_trajectory.points.size());
-  front_wheel_angle.reserve(input_trajectory.points.size());
-  rear_wheel_angle.reserve(input_trajectory.points.size());
-  time_from_start.reserve(input_trajectory.points.size());
-
-  input_arclength.push_back(0.0);
-  input_pose.push_back(input_trajectory.points.front().pose);
-  v_lon.push_back(input_trajectory.points.front().longitudinal_velocity_mps);
-  v_lat.push_back(input_trajectory.points.front().lateral_velocity_mps);
-  heading_rate.push_back(input_trajectory.points.front().heading_rate_rps);
-  acceleration.push_back(input_trajectory.points.front().acceleration_mps2);
-  front_wheel_angle.push_back(input_trajectory.points.front().front_wheel_angle_rad);
-  rear_wheel_angle.push_back(input_trajectory.points.front().rear_wheel_angle_rad);
-  time_from_start.push_back(
-    rclcpp::Duration(input_trajectory.points.front().time_from_start).seconds());
-  for (size_t i = 1; i < input_trajectory.points.size(); ++i) {
-    const auto & prev_pt = input_trajectory.points.at(i - 1);
-    const auto & curr_pt = input_trajectory.points.at(i);
-    const double ds =
-      tier4_autoware_utils::calcDistance2d(prev_pt.pose.position, curr_pt.pose.position);
-    if (ds < CLOSE_S_THRESHOLD) {
-      continue;
-    }
-    input_arclength.push_back(ds + input_arclength.at(i - 1));
-    input_pose.push_back(curr_pt.pose);
-    v_lon.push_back(curr_pt.longitudinal_velocity_mps);
-    v_lat.push_back(curr_pt.lateral_velocity_mps);
-    heading_rate.push_back(curr_pt.heading_rate_rps);
-    acceleration.push_back(curr_pt.acceleration_mps2);
-    front_wheel_angle.push_back(curr_pt.front_wheel_angle_rad);
-    rear_wheel_angle.push_back(curr_pt.rear_wheel_angle_rad);
-    time_from_start.push_back(rclcpp::Duration(curr_pt.time_from_start).seconds());
-  }
+  std::vector<size_t> input_indices;
+  calcInputArclength(points, input_arclength, input_indices);
+  interpolation_utils::validateKeys(input_arclength, resampled_arclength);
 
   // Interpolate
-  const auto lerp = [&](const auto & input) {
-    return interpolation::lerp(input_arclength, input, resampled_arclength);
-  };
-  const auto zoh = [&](const auto & input) {
-    return interpolation::zero_order_hold(input_arclength, input, resampled_arclength);
-  };
-
-  const auto interpolated_pose =
-    resamplePath(input_pose, resampled_arclength, use_lerp_for_xy, use_lerp_for_z);
-  const auto interpolated_v_lon = use_zero_order_hold_for_twist ? zoh(v_lon) : lerp(v_lon);
-  const auto interpolated_v_lat = use_zero_order_hold_for_twist ? zoh(v_lat) : lerp(v_lat);
-  const auto interpolated_heading_rate = lerp(heading_rate);
-  const auto interpolated_acceleration =
-    use_zero_order_hold_for_twist ? zoh(acceleration) : lerp(acceleration);
-  const auto interpolated_front_wheel_angle = lerp(front_wheel_angle);
-  const auto interpolated_rear_wheel_angle = lerp(rear_wheel_angle);
-  const auto interpolated_time_from_start = lerp(time_from_start);
-
-  if (interpolated_pose.size() != resampled_arclength.size()) {
-    std::cerr << "[motion_utils]: Resampled pose size is different from resampled arclength"
-              << std::endl;
-    return input_trajectory;
+  const PositionInterpolator position_interpolator(
+    points, input_arclength, input_indices, use_lerp_for_xy, use_lerp_for_z);
+  InterpolationCursor cursor(input_arclength);
+
+  output_trajectory.header = input_trajectory.header;
+  output_trajectory.points.resize(resampled_arclength.size());
+  for (size_t i = 0; i < output_trajectory.points.size(); ++i) {
+    const double query_key = resampled_arclength.at(i);
+    cursor.update(query_key);
+    const auto & src_point = points.at(input_indices.at(cursor.getLerpIndex()));
+    const auto & dst_point = points.at(input_indices.at(cursor.getLerpIndex() + 1));
+    const auto & zoh_point = points.at(input_indices.at(cursor.getZeroOrderHoldIndex()));
+    const auto interpolate_twist = [&](const double src_v, const double dst_v, const double zoh_v) {
+      return use_zero_order_hold_for_twist ? zoh_v : cursor.lerp(src_v, dst_v);
+    };
+
+    auto & traj_point = output_trajectory.points.at(i);
+    traj_point.pose.position =
+      position_interpolator.interpolate(query_key, cursor, src_point, dst_point);
+    traj_point.longitudinal_velocity_mps = interpolate_twist(
+      src_point.longitudinal_velocity_mps, dst_point.longitudinal_velocity_mps,
+      zoh_point.longitudinal_velocity_mps);
+    traj_point.lateral_velocity_mps = interpolate_twist(
+      src_point.lateral_velocity_mps, dst_point.lateral_velocity_mps,
+      zoh_point.lateral_velocity_mps);
+    traj_point.heading_rate_rps =
+      cursor.lerp(src_point.heading_rate_rps, dst_point.heading_rate_rps);
+    traj_point.acceleration_mps2 = interpolate_twist(
+      src_point.acceleration_mps2, dst_point.acceleration_mps2, zoh_point.acceleration_mps2);
+    traj_point.front_wheel_angle_rad =
+      cursor.lerp(src_point.front_wheel_angle_rad, dst_point.front_wheel_angle_rad);
+    traj_point.rear_wheel_angle_rad =
+      cursor.lerp(src_point.rear_wheel_angle_rad, dst_point.rear_wheel_angle_rad);
+    traj_point.time_from_start = rclcpp::Duration::from_seconds(cursor.lerp(
+      rclcpp::Duration(src_point.time_from_start).seconds(),
+      rclcpp::Duration(dst_point.time_from_start).seconds()));
   }
 
-  autoware_auto_planning_msgs::msg::Trajectory resampled_trajectory;
-  resampled_trajectory.header = input_trajectory.header;
-  resampled_trajectory.points.resize(interpolated_pose.size());
-  for (size_t i = 0; i < resampled_trajectory.points.size(); ++i) {
-    autoware_auto_planning_msgs::msg::TrajectoryPoint traj_point;
-    traj_point.pose = interpolated_pose.at(i);
-    traj_point.longitudinal_velocity_mps = interpolated_v_lon.at(i);
-    traj_point.lateral_velocity_mps = interpolated_v_lat.at(i);
-    traj_point.heading_rate_rps = interpolated_heading_rate.at(i);
-    traj_point.acceleration_mps2 = interpolated_acceleration.at(i);
-    traj_point.front_wheel_angle_rad = interpolated_front_wheel_angle.at(i);
-    traj_point.rear_wheel_angle_rad = interpolated_rear_wheel_angle.at(i);
-    traj_point.time_from_start = rclcpp::Duration::from_seconds(interpolated_time_from_start.at(i));
-    resampled_trajectory.points.at(i) = traj_point;
-  }
-
-  return resampled_trajectory;
+  const bool is_driving_forward =
+    tier4_autoware_utils::isDrivingForward(points.at(0), points.at(input_indices.at(1)));
+  insertResampledOrientation(
+    points, is_driving_forward, resampled_arclength, output_trajectory.points);
 }
 
 autoware_auto_planning_msgs::msg::Trajectory resampleTrajectory(
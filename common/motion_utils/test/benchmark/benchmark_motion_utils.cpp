@@ -0,0 +1,144 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "motion_utils/resample/resample.hpp"
+#include "motion_utils/trajectory/trajectory.hpp"
+#include "tier4_autoware_utils/geometry/geometry.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+using autoware_auto_planning_msgs::msg::Trajectory;
+using autoware_auto_planning_msgs::msg::TrajectoryPoint;
+using tier4_autoware_utils::createPoint;
+using tier4_autoware_utils::createQuaternionFromYaw;
+
+constexpr double point_interval = 1.0;
+
+// a gently curved trajectory, so that the nearest searches do not hit a degenerate case
+Trajectory generateTrajectory(const size_t num_points)
+{
+  constexpr double delta_theta = 0.001;
+
+  Trajectory traj;
+  traj.points.reserve(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = i * delta_theta;
+    TrajectoryPoint p;
+    p.pose.position =
+      createPoint(i * point_interval * std::cos(theta), i * point_interval * std::sin(theta), 0.0);
+    p.pose.orientation = createQuaternionFromYaw(theta);
+    p.longitudinal_velocity_mps = 10.0;
+    traj.points.push_back(p);
+  }
+  return traj;
+}
+
+// the pose of the middle point shifted aside, as the ego pose usually is
+geometry_msgs::msg::Pose getQueryPose(const Trajectory & traj)
+{
+  auto pose = traj.points.at(traj.points.size() / 2).pose;
+  pose.position.y += 0.5;
+  return pose;
+}
+
+void BM_findNearestIndexFromPoint(benchmark::State & state)
+{
+  const auto traj = generateTrajectory(state.range(0));
+  const auto point = getQueryPose(traj).position;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(motion_utils::findNearestIndex(traj.points, point));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_findNearestIndexFromPose(benchmark::State & state)
+{
+  const auto traj = generateTrajectory(state.range(0));
+  const auto pose = getQueryPose(traj);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(motion_utils::findNearestIndex(traj.points, pose, 3.0, M_PI_4));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_findNearestIndexWithHint(benchmark::State & state)
+{
+  const auto traj = generateTrajectory(state.range(0));
+  const auto point = getQueryPose(traj).position;
+  const size_t hint_idx = traj.points.size() / 2 - 1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(motion_utils::findNearestIndexWithHint(traj.points, point, hint_idx));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_calcSignedArcLengthFromIndex(benchmark::State & state)
+{
+  const auto traj = generateTrajectory(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+      motion_utils::calcSignedArcLength(traj.points, 0, traj.points.size() - 1));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_calcSignedArcLengthFromPoint(benchmark::State & state)
+{
+  const auto traj = generateTrajectory(state.range(0));
+  const auto src_point = getQueryPose(traj).position;
+  const auto dst_point = traj.points.back().pose.position;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(motion_utils::calcSignedArcLength(traj.points, src_point, dst_point));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_resampleTrajectory(benchmark::State & state)
+{
+  const auto traj = generateTrajectory(state.range(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(motion_utils::resampleTrajectory(traj, point_interval / 2.0));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_resampleTrajectoryIntoOutput(benchmark::State & state)
+{
+  const auto traj = generateTrajectory(state.range(0));
+  std::vector<double> resampled_arclength;
+  for (double s = 0.0; s < (traj.points.size() - 1) * point_interval; s += point_interval / 2.0) {
+    resampled_arclength.push_back(s);
+  }
+  Trajectory output;
+  for (auto _ : state) {
+    motion_utils::resampleTrajectory(traj, resampled_arclength, output);
+    benchmark::DoNotOptimize(output.points.data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+}  // namespace
+
+// from a short path to a long route-length trajectory
+BENCHMARK(BM_findNearestIndexFromPoint)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_findNearestIndexFromPose)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_findNearestIndexWithHint)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_calcSignedArcLengthFromIndex)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_calcSignedArcLengthFromPoint)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_resampleTrajectory)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_resampleTrajectoryIntoOutput)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
@@ -3139,3 +3139,126 @@ TEST(resample_trajectory, resample_trajectory_by_same_interval)
     }
   }
 }
+
+TEST(resample_trajectory, resample_trajectory_into_output)
+{
+  using motion_utils::resampleTrajectory;
+
+  autoware_auto_planning_msgs::msg::Trajectory traj;
+  traj.points.resize(10);
+  for (size_t i = 0; i < 10; ++i) {
+    traj.points.at(i) = generateTestTrajectoryPoint(
+      i * 1.0, 0.1 * i * i, 0.0, 0.0, i * 1.0, i * 0.5, i * 0.1, i * 0.05);
+    traj.points.at(i).front_wheel_angle_rad = i * 0.01;
+    traj.points.at(i).rear_wheel_angle_rad = i * 0.02;
+    traj.points.at(i).time_from_start = rclcpp::Duration::from_seconds(i * 0.5);
+  }
+  const std::vector<double> resampled_arclength = {0.0, 1.2, 1.5, 5.3, 7.5, 9.0};
+
+  const auto expect_same_trajectory = [](const auto & traj1, const auto & traj2) {
+    ASSERT_EQ(traj1.points.size(), traj2.points.size());
+    for (size_t i = 0; i < traj1.points.size(); ++i) {
+      const auto & p1 = traj1.points.at(i);
+      const auto & p2 = traj2.points.at(i);
+      EXPECT_NEAR(p1.pose.position.x, p2.pose.position.x, epsilon);
+      EXPECT_NEAR(p1.pose.position.y, p2.pose.position.y, epsilon);
+      EXPECT_NEAR(p1.pose.position.z, p2.pose.position.z, epsilon);
+      EXPECT_NEAR(p1.pose.orientation.z, p2.pose.orientation.z, epsilon);
+      EXPECT_NEAR(p1.pose.orientation.w, p2.pose.orientation.w, epsilon);
+      EXPECT_NEAR(p1.longitudinal_velocity_mps, p2.longitudinal_velocity_mps, epsilon);
+      EXPECT_NEAR(p1.lateral_velocity_mps, p2.lateral_velocity_mps, epsilon);
+      EXPECT_NEAR(p1.heading_rate_rps, p2.heading_rate_rps, epsilon);
+      EXPECT_NEAR(p1.acceleration_mps2, p2.acceleration_mps2, epsilon);
+      EXPECT_NEAR(p1.front_wheel_angle_rad, p2.front_wheel_angle_rad, epsilon);
+      EXPECT_NEAR(p1.rear_wheel_angle_rad, p2.rear_wheel_angle_rad, epsilon);
+      EXPECT_NEAR(
+        rclcpp::Duration(p1.time_from_start).seconds(),
+        rclcpp::Duration(p2.time_from_start).seconds(), epsilon);
+    }
+  };
+
+  // Output with the points of the previous cycle
+  for (const bool use_lerp_for_xy : {false, true}) {
+    for (const bool use_zero_order_hold_for_twist : {false, true}) {
+      const auto resampled_traj = resampleTrajectory(
+        traj, resampled_arclength, use_lerp_for_xy, true, use_zero_order_hold_for_twist);
+
+      auto output_traj = traj;
+      resampleTrajectory(
+        traj, resampled_arclength, output_traj, use_lerp_for_xy, true,
+        use_zero_order_hold_for_twist);
+      expect_same_trajectory(resampled_traj, output_traj);
+
+      // Resample again into the same output
+      resampleTrajectory(
+        traj, resampled_arclength, output_traj, use_lerp_for_xy, true,
+        use_zero_order_hold_for_twist);
+      expect_same_trajectory(resampled_traj, output_traj);
+    }
+  }
+
+  // Output is the input
+  {
+    const auto resampled_traj = resampleTrajectory(traj, resampled_arclength);
+
+    auto output_traj = traj;
+    resampleTrajectory(output_traj, resampled_arclength, output_traj);
+    expect_same_trajectory(resampled_traj, output_traj);
+  }
+
+  // Invalid resampled arclength
+  {
+    auto output_traj = generateTestTrajectory<Trajectory>(3, 1.0);
+    resampleTrajectory(traj, std::vector<double>{0.0, 10.0}, output_traj);
+    expect_same_trajectory(traj, output_traj);
+  }
+}
+
+TEST(resample_path, resample_path_into_output)
+{
+  using motion_utils::resamplePath;
+
+  autoware_auto_planning_msgs::msg::Path path;
+  path.points.resize(10);
+  for (size_t i = 0; i < 10; ++i) {
+    path.points.at(i) =
+      generateTestPathPoint(i * 1.0, 0.1 * i * i, 0.0, 0.0, i * 1.0, i * 0.5, i * 0.1);
+    path.points.at(i).is_final = true;
+  }
+  const std::vector<double> resampled_arclength = {0.0, 1.2, 1.5, 5.3, 7.5, 9.0};
+
+  const auto resampled_path = resamplePath(path, resampled_arclength);
+
+  auto output_path = path;
+  resamplePath(path, resampled_arclength, output_path);
+  ASSERT_EQ(resampled_path.points.size(), output_path.points.size());
+  for (size_t i = 0; i < resampled_path.points.size(); ++i) {
+    const auto & p1 = resampled_path.points.at(i);
+    const auto & p2 = output_path.points.at(i);
+    EXPECT_NEAR(p1.pose.position.x, p2.pose.position.x, epsilon);
+    EXPECT_NEAR(p1.pose.position.y, p2.pose.position.y, epsilon);
+    EXPECT_NEAR(p1.pose.orientation.z, p2.pose.orientation.z, epsilon);
+    EXPECT_NEAR(p1.pose.orientation.w, p2.pose.orientation.w, epsilon);
+    EXPECT_NEAR(p1.longitudinal_velocity_mps, p2.longitudinal_velocity_mps, epsilon);
+    EXPECT_NEAR(p1.lateral_velocity_mps, p2.lateral_velocity_mps, epsilon);
+    EXPECT_NEAR(p1.heading_rate_rps, p2.heading_rate_rps, epsilon);
+    EXPECT_EQ(p2.is_final, false);
+  }
+
+  // Poses
+  std::vector<geometry_msgs::msg::Pose> poses;
+  for (const auto & p : path.points) {
+    poses.push_back(p.pose);
+  }
+  const auto resampled_poses = resamplePath(poses, resampled_arclength);
+
+  auto output_poses = poses;
+  resamplePath(poses, resampled_arclength, output_poses);
+  ASSERT_EQ(resampled_poses.size(), output_poses.size());
+  for (size_t i = 0; i < resampled_poses.size(); ++i) {
+    EXPECT_NEAR(resampled_poses.at(i).position.x, output_poses.at(i).position.x, epsilon);
+    EXPECT_NEAR(resampled_poses.at(i).position.y, output_poses.at(i).position.y, epsilon);
+    EXPECT_NEAR(resampled_poses.at(i).orientation.z, output_poses.at(i).orientation.z, epsilon);
+    EXPECT_NEAR(resampled_poses.at(i).orientation.w, output_poses.at(i).orientation.w, epsilon);
+  }
+}
@@ -398,6 +398,58 @@ TEST(trajectory, findNearestSegmentIndex)
   EXPECT_EQ(findNearestSegmentIndex(sparse_points, createPoint(9.0, 1.0, 0.0)), 0U);
 }
 
+TEST(trajectory, findNearestIndexWithHint)
+{
+  using motion_utils::findNearestIndex;
+  using motion_utils::findNearestIndexWithHint;
+
+  const auto traj = generateTestTrajectory<Trajectory>(10, 1.0);
+
+  // Empty
+  EXPECT_THROW(
+    findNearestIndexWithHint(Trajectory{}.points, geometry_msgs::msg::Point{}, 0),
+    std::invalid_argument);
+
+  // Forward and backward from the hint
+  EXPECT_EQ(findNearestIndexWithHint(traj.points, createPoint(4.0, 0.0, 0.0), 0), 4U);
+  EXPECT_EQ(findNearestIndexWithHint(traj.points, createPoint(4.0, 0.0, 0.0), 9), 4U);
+
+  // Boundary conditions
+  EXPECT_EQ(findNearestIndexWithHint(traj.points, createPoint(0.5, 0.0, 0.0), 9), 0U);
+  EXPECT_EQ(findNearestIndexWithHint(traj.points, createPoint(0.51, 0.0, 0.0), 0), 1U);
+
+  // Hint after end point
+  EXPECT_EQ(findNearestIndexWithHint(traj.points, createPoint(100.0, -3.0, 0.0), 100), 9U);
+
+  // Same as findNearestIndex from any hint
+  const auto curved_traj = generateTestTrajectory<Trajectory>(10, 1.0, 0.0, 0.0, 0.1);
+  for (const auto & point :
+       {createPoint(5.1, 3.4, 0.0), createPoint(-4.0, 5.0, 0.0), createPoint(2.4, 1.3, 0.0)}) {
+    for (size_t hint_idx = 0; hint_idx < curved_traj.points.size(); ++hint_idx) {
+      EXPECT_EQ(
+        findNearestIndexWithHint(curved_traj.points, point, hint_idx),
+        findNearestIndex(curved_traj.points, point));
+    }
+  }
+}
+
+TEST(trajectory, findNearestSegmentIndexWithHint)
+{
+  using motion_utils::findNearestSegmentIndexWithHint;
+
+  const auto traj = generateTestTrajectory<Trajectory>(10, 1.0);
+
+  // Start point
+  EXPECT_EQ(findNearestSegmentIndexWithHint(traj.points, createPoint(0.0, 0.0, 0.0), 5), 0U);
+
+  // End point
+  EXPECT_EQ(findNearestSegmentIndexWithHint(traj.points, createPoint(9.0, 0.0, 0.0), 5), 8U);
+
+  // Random cases
+  EXPECT_EQ(findNearestSegmentIndexWithHint(traj.points, createPoint(2.4, 1.0, 0.0), 8), 2U);
+  EXPECT_EQ(findNearestSegmentIndexWithHint(traj.points, createPoint(4.0, 0.0, 0.0), 0), 3U);
+}
+
 TEST(trajectory, calcLongitudinalOffsetToSegment_StraightTrajectory)
 {
   using motion_utils::calcLongitudinalOffsetToSegment;
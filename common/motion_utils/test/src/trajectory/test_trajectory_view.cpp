@@ -0,0 +1,127 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "motion_utils/trajectory/trajectory.hpp"
+#include "motion_utils/trajectory/trajectory_view.hpp"
+#include "tier4_autoware_utils/geometry/geometry.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+using autoware_auto_planning_msgs::msg::Trajectory;
+using TrajectoryPointArray = std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint>;
+using tier4_autoware_utils::createPoint;
+using tier4_autoware_utils::createQuaternionFromYaw;
+
+constexpr double epsilon = 1e-6;
+
+Trajectory generateTestTrajectory(
+  const size_t num_points, const double point_interval, const double delta_theta = 0.0)
+{
+  Trajectory traj;
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = i * delta_theta;
+    autoware_auto_planning_msgs::msg::TrajectoryPoint p;
+    p.pose.position = createPoint(
+      i * point_interval * std::cos(theta), i * point_interval * std::sin(theta), 0.0);
+    p.pose.orientation = createQuaternionFromYaw(theta);
+    traj.points.push_back(p);
+  }
+  return traj;
+}
+}  // namespace
+
+TEST(trajectory_view, calcSignedArcLength)
+{
+  using motion_utils::TrajectoryView;
+
+  const auto traj = generateTestTrajectory(10, 1.0, 0.1);
+  const TrajectoryView<TrajectoryPointArray> view(traj.points);
+
+  EXPECT_NEAR(view.calcArcLength(), motion_utils::calcArcLength(traj.points), epsilon);
+  for (size_t src_idx = 0; src_idx < traj.points.size(); ++src_idx) {
+    for (size_t dst_idx = 0; dst_idx < traj.points.size(); ++dst_idx) {
+      EXPECT_NEAR(
+        view.calcSignedArcLength(src_idx, dst_idx),
+        motion_utils::calcSignedArcLength(traj.points, src_idx, dst_idx), epsilon);
+    }
+  }
+
+  // Projection on the segment
+  const auto straight_traj = generateTestTrajectory(10, 1.0);
+  const TrajectoryView<TrajectoryPointArray> straight_view(straight_traj.points);
+  EXPECT_NEAR(straight_view.calcArcLength(3, createPoint(3.4, 1.0, 0.0)), 3.4, epsilon);
+  EXPECT_NEAR(straight_view.calcArcLength(0, createPoint(-1.0, 0.0, 0.0)), -1.0, epsilon);
+  EXPECT_THROW(straight_view.calcArcLength(9, createPoint(0.0, 0.0, 0.0)), std::out_of_range);
+
+  // Segment of arc length
+  EXPECT_EQ(straight_view.findSegmentIndex(-1.0), 0U);
+  EXPECT_EQ(straight_view.findSegmentIndex(0.5), 0U);
+  EXPECT_EQ(straight_view.findSegmentIndex(3.5), 3U);
+  EXPECT_EQ(straight_view.findSegmentIndex(100.0), 8U);
+}
+
+TEST(trajectory_view, calcLongitudinalOffsetPointAndPose)
+{
+  using motion_utils::TrajectoryView;
+
+  const auto traj = generateTestTrajectory(10, 1.0, 0.1);
+  const TrajectoryView<TrajectoryPointArray> view(traj.points);
+
+  // Invalid source index
+  EXPECT_FALSE(view.calcLongitudinalOffsetPoint(10, 0.0));
+
+  // Same as the functions on the points
+  for (size_t src_idx = 0; src_idx < traj.points.size(); ++src_idx) {
+    for (const double offset : {-100.0, -5.3, -1.0, 0.0, 0.7, 2.0, 4.9, 100.0}) {
+      const auto expected_point =
+        motion_utils::calcLongitudinalOffsetPoint(traj.points, src_idx, offset);
+      const auto point = view.calcLongitudinalOffsetPoint(src_idx, offset);
+      ASSERT_EQ(static_cast<bool>(point), static_cast<bool>(expected_point));
+      if (expected_point) {
+        EXPECT_NEAR(point->x, expected_point->x, epsilon);
+        EXPECT_NEAR(point->y, expected_point->y, epsilon);
+      }
+
+      const auto expected_pose =
+        motion_utils::calcLongitudinalOffsetPose(traj.points, src_idx, offset);
+      const auto pose = view.calcLongitudinalOffsetPose(src_idx, offset);
+      ASSERT_EQ(static_cast<bool>(pose), static_cast<bool>(expected_pose));
+      if (expected_pose) {
+        EXPECT_NEAR(pose->position.x, expected_pose->position.x, epsilon);
+        EXPECT_NEAR(pose->position.y, expected_pose->position.y, epsilon);
+        EXPECT_NEAR(pose->orientation.z, expected_pose->orientation.z, epsilon);
+        EXPECT_NEAR(pose->orientation.w, expected_pose->orientation.w, epsilon);
+      }
+    }
+  }
+}
+
+TEST(trajectory_view, findNearestIndex)
+{
+  using motion_utils::TrajectoryView;
+
+  const auto traj = generateTestTrajectory(100, 1.0, 0.05);
+  const TrajectoryView<TrajectoryPointArray> view(traj.points);
+
+  for (const auto & point :
+       {createPoint(-3.0, 0.0, 0.0), createPoint(10.2, 3.0, 0.0), createPoint(0.0, 50.0, 0.0),
+        createPoint(1000.0, 1000.0, 0.0)}) {
+    EXPECT_EQ(view.findNearestIndex(point), motion_utils::findNearestIndex(traj.points, point));
+  }
+}
@@ -55,6 +55,9 @@ private:
   bool8_t m_work_initialized = false;
   // Exitflag
   int64_t m_exitflag;
+  // Sparsity patterns of P and A of the current work, without their values
+  CSC_Matrix m_P_sparsity;
+  CSC_Matrix m_A_sparsity;
 
   // Runs the solver on the stored problem.
   std::tuple<std::vector<float64_t>, std::vector<float64_t>, int64_t, int64_t, int64_t> solve();
@@ -151,6 +154,24 @@ public:
   void updateL(const std::vector<double> & l_new);
   void updateU(const std::vector<double> & u_new);
   void updateBounds(const std::vector<double> & l_new, const std::vector<double> & u_new);
+
+  /// \brief Check if the given matrices have the sparsity pattern of the current problem.
+  /// \param P_csc (n,n) upper trapezoidal matrix defining relations between parameters.
+  /// \param A_csc (m,n) matrix defining parameter constraints.
+  bool8_t isSameSparsity(const CSC_Matrix & P_csc, const CSC_Matrix & A_csc) const;
+  /// \brief Updates the values of the current problem, or sets up a new one as initializeProblem().
+  /// \details When P and A have the sparsity pattern of the current problem, only their values are
+  /// \details updated, which keeps the symbolic factorization and the solution for the warm start.
+  /// \return The exit flag of the update or of the setup (Healthy condition: 0).
+  int64_t updateProblem(
+    const CSC_Matrix & P_csc, const CSC_Matrix & A_csc, const std::vector<float64_t> & q,
+    const std::vector<float64_t> & l, const std::vector<float64_t> & u);
+  /// \brief Updates the non-zero values of P or A, in the order of the current sparsity pattern.
+  /// \details Throws std::invalid_argument if their number does not match the pattern.
+  void updatePValues(const std::vector<float64_t> & P_vals);
+  void updateAValues(const std::vector<float64_t> & A_vals);
+  /// \brief Sets the primal and dual variables the next optimization starts from.
+  void setWarmStart(const std::vector<float64_t> & primal, const std::vector<float64_t> & dual);
   void updateEpsAbs(const double eps_abs);
   void updateEpsRel(const double eps_rel);
   void updateMaxIter(const int iter);
@@ -158,6 +179,7 @@ public:
   void updateRhoInterval(const int rho_interval);
   void updateRho(const double rho);
   void updateAlpha(const double alpha);
+  void updateWarmStart(const bool8_t warm_start);
 
   /// \brief Get the number of iteration taken to solve the problem
   inline int64_t getTakenIter() const { return static_cast<int64_t>(m_latest_work_info.iter); }
@@ -175,6 +197,14 @@ public:
   }
   /// \brief Get the runtime of the latest problem solved
   inline float64_t getRunTime() const { return m_latest_work_info.run_time; }
+  /// \brief Get the setup time, if the latest problem solved was set up before
+  inline float64_t getSetupTime() const { return m_latest_work_info.setup_time; }
+  /// \brief Get the update time, if the latest problem solved was updated before
+  inline float64_t getUpdateTime() const { return m_latest_work_info.update_time; }
+  /// \brief Get the solve time of the latest problem solved, without the polish
+  inline float64_t getSolveTime() const { return m_latest_work_info.solve_time; }
+  /// \brief Get the polish time of the latest problem solved
+  inline float64_t getPolishTime() const { return m_latest_work_info.polish_time; }
   /// \brief Get the objective value the latest problem solved
   inline float64_t getObjVal() const { return m_latest_work_info.obj_val; }
   /// \brief Returns flag asserting interface condition (Healthy condition: 0).
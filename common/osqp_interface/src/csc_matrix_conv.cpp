@@ -68,6 +68,24 @@ CSC_Matrix calCSCMatrix(const Eigen::MatrixXd & mat)
   return csc_matrix;
 }
 
+CSC_Matrix calCSCMatrix(const Eigen::SparseMatrix<c_float> & mat)
+{
+  Eigen::SparseMatrix<c_float> compressed_mat = mat;
+  compressed_mat.makeCompressed();
+
+  const Eigen::Index elem = compressed_mat.nonZeros();
+  const Eigen::Index cols = compressed_mat.cols();
+
+  CSC_Matrix csc_matrix;
+  csc_matrix.m_vals.assign(compressed_mat.valuePtr(), compressed_mat.valuePtr() + elem);
+  csc_matrix.m_row_idxs.assign(
+    compressed_mat.innerIndexPtr(), compressed_mat.innerIndexPtr() + elem);
+  csc_matrix.m_col_idxs.assign(
+    compressed_mat.outerIndexPtr(), compressed_mat.outerIndexPtr() + cols + 1);
+
+  return csc_matrix;
+}
+
 CSC_Matrix calCSCMatrixTrapezoidal(const Eigen::MatrixXd & mat)
 {
   const size_t elem = static_cast<size_t>(mat.nonZeros());
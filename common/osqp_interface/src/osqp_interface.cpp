@@ -21,8 +21,10 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace autoware
@@ -149,6 +151,73 @@ void OSQPInterface::updateBounds(
   osqp_update_bounds(m_work.get(), l_dyn, u_dyn);
 }
 
+bool8_t OSQPInterface::isSameSparsity(const CSC_Matrix & P_csc, const CSC_Matrix & A_csc) const
+{
+  return m_work_initialized && P_csc.m_row_idxs == m_P_sparsity.m_row_idxs &&
+         P_csc.m_col_idxs == m_P_sparsity.m_col_idxs &&
+         A_csc.m_row_idxs == m_A_sparsity.m_row_idxs &&
+         A_csc.m_col_idxs == m_A_sparsity.m_col_idxs;
+}
+
+int64_t OSQPInterface::updateProblem(
+  const CSC_Matrix & P_csc, const CSC_Matrix & A_csc, const std::vector<float64_t> & q,
+  const std::vector<float64_t> & l, const std::vector<float64_t> & u)
+{
+  if (
+    !isSameSparsity(P_csc, A_csc) || static_cast<int64_t>(q.size()) != m_param_n ||
+    static_cast<int64_t>(l.size()) != m_data->m || static_cast<int64_t>(u.size()) != m_data->m) {
+    return initializeProblem(P_csc, A_csc, q, l, u);
+  }
+
+  // P and A are updated at once, so that the KKT matrix is only factorized once
+  m_exitflag = osqp_update_P_A(
+    m_work.get(), P_csc.m_vals.data(), OSQP_NULL, static_cast<c_int>(P_csc.m_vals.size()),
+    A_csc.m_vals.data(), OSQP_NULL, static_cast<c_int>(A_csc.m_vals.size()));
+  if (m_exitflag == 0) {
+    m_exitflag = osqp_update_lin_cost(m_work.get(), q.data());
+  }
+  if (m_exitflag == 0) {
+    m_exitflag = osqp_update_bounds(m_work.get(), l.data(), u.data());
+  }
+  return m_exitflag;
+}
+
+void OSQPInterface::updatePValues(const std::vector<float64_t> & P_vals)
+{
+  if (P_vals.size() != m_P_sparsity.m_row_idxs.size()) {
+    std::stringstream ss;
+    ss << "P_vals.size() and the number of non-zeros of P are not the same. P_vals.size() = "
+       << P_vals.size() << ", non-zeros = " << m_P_sparsity.m_row_idxs.size();
+    throw std::invalid_argument(ss.str());
+  }
+  osqp_update_P(m_work.get(), P_vals.data(), OSQP_NULL, static_cast<c_int>(P_vals.size()));
+}
+
+void OSQPInterface::updateAValues(const std::vector<float64_t> & A_vals)
+{
+  if (A_vals.size() != m_A_sparsity.m_row_idxs.size()) {
+    std::stringstream ss;
+    ss << "A_vals.size() and the number of non-zeros of A are not the same. A_vals.size() = "
+       << A_vals.size() << ", non-zeros = " << m_A_sparsity.m_row_idxs.size();
+    throw std::invalid_argument(ss.str());
+  }
+  osqp_update_A(m_work.get(), A_vals.data(), OSQP_NULL, static_cast<c_int>(A_vals.size()));
+}
+
+void OSQPInterface::setWarmStart(
+  const std::vector<float64_t> & primal, const std::vector<float64_t> & dual)
+{
+  if (
+    !m_work_initialized || static_cast<int64_t>(primal.size()) != m_param_n ||
+    static_cast<int64_t>(dual.size()) != m_data->m) {
+    std::stringstream ss;
+    ss << "primal.size() and dual.size() do not match the current problem. primal.size() = "
+       << primal.size() << ", dual.size() = " << dual.size();
+    throw std::invalid_argument(ss.str());
+  }
+  osqp_warm_start(m_work.get(), primal.data(), dual.data());
+}
+
 void OSQPInterface::updateEpsAbs(const double eps_abs)
 {
   m_settings->eps_abs = eps_abs;  // for default setting
@@ -202,6 +271,14 @@ void OSQPInterface::updateAlpha(const double alpha)
   }
 }
 
+void OSQPInterface::updateWarmStart(const bool8_t warm_start)
+{
+  m_settings->warm_start = warm_start;  // for default setting
+  if (m_work_initialized) {
+    osqp_update_warm_start(m_work.get(), warm_start);  // for current work
+  }
+}
+
 int64_t OSQPInterface::initializeProblem(
   const Eigen::MatrixXd & P, const Eigen::MatrixXd & A, const std::vector<float64_t> & q,
   const std::vector<float64_t> & l, const std::vector<float64_t> & u)
@@ -277,6 +354,11 @@ int64_t OSQPInterface::initializeProblem(
   m_work.reset(workspace);
   m_work_initialized = true;
 
+  m_P_sparsity.m_row_idxs = std::move(P_csc.m_row_idxs);
+  m_P_sparsity.m_col_idxs = std::move(P_csc.m_col_idxs);
+  m_A_sparsity.m_row_idxs = std::move(A_csc.m_row_idxs);
+  m_A_sparsity.m_col_idxs = std::move(A_csc.m_col_idxs);
+
   return m_exitflag;
 }
 
@@ -163,6 +163,34 @@ TEST(TestCscMatrixConv, Trapezoidal)
     EXPECT_EQ(e.what(), std::string("Matrix must be square (n, n)"));
   }
 }
+TEST(TestCscMatrixConv, Sparse)
+{
+  using autoware::common::osqp::calCSCMatrix;
+  using autoware::common::osqp::CSC_Matrix;
+
+  // the explicit zero at (1, 0) is kept in the sparsity pattern
+  Eigen::SparseMatrix<c_float> rect(2, 3);
+  const std::vector<Eigen::Triplet<c_float>> triplets = {
+    {0, 0, 1.0}, {1, 0, 0.0}, {1, 2, 3.0}, {0, 2, 2.0}};
+  rect.setFromTriplets(triplets.begin(), triplets.end());
+
+  const CSC_Matrix rect_m = calCSCMatrix(rect);
+  ASSERT_EQ(rect_m.m_vals.size(), size_t(4));
+  EXPECT_EQ(rect_m.m_vals[0], 1.0);
+  EXPECT_EQ(rect_m.m_vals[1], 0.0);
+  EXPECT_EQ(rect_m.m_vals[2], 2.0);
+  EXPECT_EQ(rect_m.m_vals[3], 3.0);
+  ASSERT_EQ(rect_m.m_row_idxs.size(), size_t(4));
+  EXPECT_EQ(rect_m.m_row_idxs[0], c_int(0));
+  EXPECT_EQ(rect_m.m_row_idxs[1], c_int(1));
+  EXPECT_EQ(rect_m.m_row_idxs[2], c_int(0));
+  EXPECT_EQ(rect_m.m_row_idxs[3], c_int(1));
+  ASSERT_EQ(rect_m.m_col_idxs.size(), size_t(4));  // nb of columns + 1
+  EXPECT_EQ(rect_m.m_col_idxs[0], c_int(0));
+  EXPECT_EQ(rect_m.m_col_idxs[1], c_int(2));
+  EXPECT_EQ(rect_m.m_col_idxs[2], c_int(2));
+  EXPECT_EQ(rect_m.m_col_idxs[3], c_int(4));
+}
 TEST(TestCscMatrixConv, Print)
 {
   using autoware::common::osqp::calCSCMatrix;
@@ -16,6 +16,7 @@
 #include "gtest/gtest.h"
 #include "osqp_interface/osqp_interface.hpp"
 
+#include <stdexcept>
 #include <tuple>
 #include <vector>
 
@@ -132,4 +133,73 @@ TEST(TestOsqpInterface, BasicQp)
     check_result(result);
   }
 }
+
+TEST(TestOsqpInterface, UpdateProblem)
+{
+  using autoware::common::osqp::calCSCMatrix;
+  using autoware::common::osqp::calCSCMatrixTrapezoidal;
+  using autoware::common::osqp::CSC_Matrix;
+
+  auto check_primal =
+    [](const std::tuple<std::vector<float64_t>, std::vector<float64_t>, int, int, int> & result) {
+      EXPECT_EQ(std::get<3>(result), 1);  // solution succeeded
+
+      static const auto ep = 1.0e-8;
+
+      const auto prime_val = std::get<0>(result);
+      ASSERT_EQ(prime_val.size(), size_t(2));
+      EXPECT_NEAR(prime_val[0], 0.3, ep);
+      EXPECT_NEAR(prime_val[1], 0.7, ep);
+    };
+
+  const Eigen::MatrixXd P = (Eigen::MatrixXd(2, 2) << 4, 1, 1, 2).finished();
+  const Eigen::MatrixXd A = (Eigen::MatrixXd(4, 2) << 1, 1, 1, 0, 0, 1, 0, 1).finished();
+  const std::vector<float64_t> q = {1.0, 1.0};
+  const std::vector<float64_t> l = {1.0, 0.0, 0.0, -autoware::common::osqp::INF};
+  const std::vector<float64_t> u = {1.0, 0.7, 0.7, autoware::common::osqp::INF};
+  const CSC_Matrix P_csc = calCSCMatrixTrapezoidal(P);
+  const CSC_Matrix A_csc = calCSCMatrix(A);
+
+  {
+    // Initial problem with the same sparsity, whose values are updated
+    const Eigen::MatrixXd P_ini = (Eigen::MatrixXd(2, 2) << 1, 0.5, 0.5, 1).finished();
+    const Eigen::MatrixXd A_ini = (Eigen::MatrixXd(4, 2) << 2, 2, 2, 0, 0, 2, 0, 2).finished();
+    const std::vector<float64_t> q_ini(2, 0.0);
+    const std::vector<float64_t> l_ini(4, -1.0);
+    const std::vector<float64_t> u_ini(4, 1.0);
+    autoware::common::osqp::OSQPInterface osqp(
+      calCSCMatrixTrapezoidal(P_ini), calCSCMatrix(A_ini), q_ini, l_ini, u_ini, 1e-6);
+    osqp.optimize();
+
+    EXPECT_TRUE(osqp.isSameSparsity(P_csc, A_csc));
+    EXPECT_EQ(osqp.updateProblem(P_csc, A_csc, q, l, u), 0);
+    check_primal(osqp.optimize());
+
+    // The values can also be given without the pattern
+    osqp.updatePValues(P_csc.m_vals);
+    osqp.updateAValues(A_csc.m_vals);
+    check_primal(osqp.optimize());
+    EXPECT_THROW(osqp.updatePValues(std::vector<float64_t>(2, 1.0)), std::invalid_argument);
+    EXPECT_THROW(osqp.updateAValues(std::vector<float64_t>(4, 1.0)), std::invalid_argument);
+
+    // Warm start from the solution
+    osqp.setWarmStart({0.3, 0.7}, {-2.9, 0.0, 0.2, 0.0});
+    check_primal(osqp.optimize());
+    EXPECT_THROW(osqp.setWarmStart({0.3}, {-2.9}), std::invalid_argument);
+  }
+
+  {
+    // Initial problem with another sparsity, which is set up again
+    autoware::common::osqp::OSQPInterface osqp(
+      calCSCMatrixTrapezoidal(Eigen::MatrixXd::Zero(2, 2)),
+      calCSCMatrix(Eigen::MatrixXd::Zero(4, 2)), std::vector<float64_t>(2, 0.0),
+      std::vector<float64_t>(4, 0.0), std::vector<float64_t>(4, 0.0), 1e-6);
+    osqp.optimize();
+
+    EXPECT_FALSE(osqp.isSameSparsity(P_csc, A_csc));
+    EXPECT_EQ(osqp.updateProblem(P_csc, A_csc, q, l, u), 0);
+    EXPECT_TRUE(osqp.isSameSparsity(P_csc, A_csc));
+    check_primal(osqp.optimize());
+  }
+}
 }  // namespace
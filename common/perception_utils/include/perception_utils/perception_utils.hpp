@@ -23,6 +23,9 @@
 #include "autoware_auto_perception_msgs/msg/tracked_objects.hpp"
 #include "geometry_msgs/msg/transform.hpp"
 
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
 #include <boost/geometry.hpp>
 
 #include <tf2_ros/buffer.h>
@@ -152,35 +155,83 @@ inline double get2dRecall(const T1 source_object, const T2 target_object)
   return recall;
 }
 
+/**
+ * @brief transform the objects in place from their frame to the target frame by one transform
+ *        The shapes are relative to the object poses, so only the poses are transformed, and
+ *        their covariances if transform_covariance.
+ */
 template <class T>
-bool transformObjects(
-  const T & input_msg, const std::string & target_frame_id, const tf2_ros::Buffer & tf_buffer,
-  T & output_msg)
+void transformObjects(
+  const Eigen::Isometry3d & target2objects_world, const std::string & target_frame_id, T & msg,
+  const bool transform_covariance = false)
 {
-  output_msg = input_msg;
-
-  // transform to world coordinate
-  if (input_msg.header.frame_id != target_frame_id) {
-    output_msg.header.frame_id = target_frame_id;
-    tf2::Transform tf_target2objects_world;
-    tf2::Transform tf_target2objects;
-    tf2::Transform tf_objects_world2objects;
-    {
-      const auto ros_target2objects_world =
-        getTransform(tf_buffer, input_msg.header.frame_id, target_frame_id, input_msg.header.stamp);
-      if (!ros_target2objects_world) {
-        return false;
+  msg.header.frame_id = target_frame_id;
+  const Eigen::Matrix3d rotation = target2objects_world.linear();
+  const Eigen::Vector3d translation = target2objects_world.translation();
+  const Eigen::Quaterniond rotation_quaternion(rotation);
+  for (auto & object : msg.objects) {
+    auto & pose_with_covariance = object.kinematics.pose_with_covariance;
+    auto & position = pose_with_covariance.pose.position;
+    auto & orientation = pose_with_covariance.pose.orientation;
+
+    const Eigen::Vector3d target_position =
+      rotation * Eigen::Vector3d(position.x, position.y, position.z) + translation;
+    const Eigen::Quaterniond target_orientation =
+      rotation_quaternion *
+      Eigen::Quaterniond(orientation.w, orientation.x, orientation.y, orientation.z);
+    position.x = target_position.x();
+    position.y = target_position.y();
+    position.z = target_position.z();
+    orientation.x = target_orientation.x();
+    orientation.y = target_orientation.y();
+    orientation.z = target_orientation.z();
+    orientation.w = target_orientation.w();
+
+    if (transform_covariance) {
+      // rotate each of the position and orientation blocks, as tf2_geometry_msgs does
+      Eigen::Map<Eigen::Matrix<double, 6, 6, Eigen::RowMajor>> covariance(
+        pose_with_covariance.covariance.data());
+      for (int i = 0; i < 6; i += 3) {
+        for (int j = 0; j < 6; j += 3) {
+          covariance.block<3, 3>(i, j) =
+            rotation * covariance.block<3, 3>(i, j) * rotation.transpose();
+        }
       }
-      tf2::fromMsg(*ros_target2objects_world, tf_target2objects_world);
     }
-    for (auto & object : output_msg.objects) {
-      tf2::fromMsg(object.kinematics.pose_with_covariance.pose, tf_objects_world2objects);
-      tf_target2objects = tf_target2objects_world * tf_objects_world2objects;
-      tf2::toMsg(tf_target2objects, object.kinematics.pose_with_covariance.pose);
-      // TODO(yukkysaito) transform covariance
+  }
+}
+
+/**
+ * @brief transform the objects in place to the target frame, looking up the transform once
+ */
+template <class T>
+bool transformObjects(
+  T & msg, const std::string & target_frame_id, const tf2_ros::Buffer & tf_buffer,
+  const bool transform_covariance = false)
+{
+  // transform to world coordinate
+  if (msg.header.frame_id != target_frame_id) {
+    const auto ros_target2objects_world =
+      getTransform(tf_buffer, msg.header.frame_id, target_frame_id, msg.header.stamp);
+    if (!ros_target2objects_world) {
+      return false;
     }
+    const auto & t = ros_target2objects_world->translation;
+    const auto & q = ros_target2objects_world->rotation;
+    const Eigen::Isometry3d target2objects_world =
+      Eigen::Translation3d(t.x, t.y, t.z) * Eigen::Quaterniond(q.w, q.x, q.y, q.z).normalized();
+    transformObjects(target2objects_world, target_frame_id, msg, transform_covariance);
   }
   return true;
 }
+
+template <class T>
+bool transformObjects(
+  const T & input_msg, const std::string & target_frame_id, const tf2_ros::Buffer & tf_buffer,
+  T & output_msg)
+{
+  output_msg = input_msg;
+  return transformObjects(output_msg, target_frame_id, tf_buffer);
+}
 }  // namespace perception_utils
 #endif  // PERCEPTION_UTILS__PERCEPTION_UTILS_HPP_
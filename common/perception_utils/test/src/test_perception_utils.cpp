@@ -15,8 +15,12 @@
 #include "perception_utils/perception_utils.hpp"
 #include "tier4_autoware_utils/geometry/geometry.hpp"
 
+#include <rclcpp/clock.hpp>
+
 #include <gtest/gtest.h>
 
+#include <memory>
+
 using tier4_autoware_utils::Point2d;
 using tier4_autoware_utils::Point3d;
 
@@ -506,3 +510,69 @@ TEST(perception_utils, test_get2dRecall)
     EXPECT_DOUBLE_EQ(reversed_recall, quart_circle * 4);
   }
 }
+
+TEST(perception_utils, test_transformObjects)
+{
+  using perception_utils::transformObjects;
+
+  autoware_auto_perception_msgs::msg::DetectedObjects objects;
+  objects.header.frame_id = "base_link";
+  {
+    autoware_auto_perception_msgs::msg::DetectedObject object;
+    object.kinematics.pose_with_covariance.pose = createPose(1.0, 0.0, 0.0);
+    object.kinematics.pose_with_covariance.covariance[0] = 4.0;
+    object.kinematics.pose_with_covariance.covariance[7] = 1.0;
+    objects.objects.push_back(object);
+  }
+
+  const Eigen::Isometry3d map2base_link =
+    Eigen::Translation3d(10.0, 20.0, 0.0) * Eigen::AngleAxisd(M_PI_2, Eigen::Vector3d::UnitZ());
+
+  {  // with covariance
+    auto transformed_objects = objects;
+    transformObjects(map2base_link, "map", transformed_objects, true);
+    EXPECT_EQ(transformed_objects.header.frame_id, "map");
+
+    const auto & pose_with_covariance =
+      transformed_objects.objects.front().kinematics.pose_with_covariance;
+    EXPECT_NEAR(pose_with_covariance.pose.position.x, 10.0, epsilon);
+    EXPECT_NEAR(pose_with_covariance.pose.position.y, 21.0, epsilon);
+    EXPECT_NEAR(tier4_autoware_utils::getRPY(pose_with_covariance.pose).z, M_PI_2, epsilon);
+    EXPECT_NEAR(pose_with_covariance.covariance[0], 1.0, epsilon);
+    EXPECT_NEAR(pose_with_covariance.covariance[7], 4.0, epsilon);
+  }
+
+  {  // without covariance
+    auto transformed_objects = objects;
+    transformObjects(map2base_link, "map", transformed_objects);
+
+    const auto & pose_with_covariance =
+      transformed_objects.objects.front().kinematics.pose_with_covariance;
+    EXPECT_NEAR(pose_with_covariance.pose.position.y, 21.0, epsilon);
+    EXPECT_DOUBLE_EQ(pose_with_covariance.covariance[0], 4.0);
+    EXPECT_DOUBLE_EQ(pose_with_covariance.covariance[7], 1.0);
+  }
+
+  {  // with tf buffer
+    tf2_ros::Buffer tf_buffer(std::make_shared<rclcpp::Clock>(RCL_ROS_TIME));
+    geometry_msgs::msg::TransformStamped transform;
+    transform.header.frame_id = "map";
+    transform.child_frame_id = "base_link";
+    transform.transform.translation.x = 10.0;
+    transform.transform.translation.y = 20.0;
+    transform.transform.rotation = tier4_autoware_utils::createQuaternionFromYaw(M_PI_2);
+    tf_buffer.setTransform(transform, "test", true);
+
+    autoware_auto_perception_msgs::msg::DetectedObjects transformed_objects;
+    EXPECT_TRUE(transformObjects(objects, "map", tf_buffer, transformed_objects));
+    EXPECT_EQ(transformed_objects.header.frame_id, "map");
+
+    const auto & pose_with_covariance =
+      transformed_objects.objects.front().kinematics.pose_with_covariance;
+    EXPECT_NEAR(pose_with_covariance.pose.position.x, 10.0, epsilon);
+    EXPECT_NEAR(pose_with_covariance.pose.position.y, 21.0, epsilon);
+    EXPECT_NEAR(tier4_autoware_utils::getRPY(pose_with_covariance.pose).z, M_PI_2, epsilon);
+
+    EXPECT_FALSE(transformObjects(objects, "odom", tf_buffer, transformed_objects));
+  }
+}
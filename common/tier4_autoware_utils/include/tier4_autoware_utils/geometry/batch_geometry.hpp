@@ -0,0 +1,95 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_AUTOWARE_UTILS__GEOMETRY__BATCH_GEOMETRY_HPP_
+#define TIER4_AUTOWARE_UTILS__GEOMETRY__BATCH_GEOMETRY_HPP_
+
+#include "tier4_autoware_utils/geometry/geometry.hpp"
+
+#include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace tier4_autoware_utils
+{
+/**
+ * @brief x and y of points as structure of arrays, for the batch functions below which are
+ * vectorized with AVX2+FMA or NEON when the target supports them. Their results may differ from
+ * the ones of the per-point functions by rounding.
+ */
+struct PointArray2d
+{
+  std::vector<double> x;
+  std::vector<double> y;
+
+  size_t size() const { return x.size(); }
+  bool empty() const { return x.empty(); }
+  void resize(const size_t size)
+  {
+    x.resize(size);
+    y.resize(size);
+  }
+};
+
+template <class T>
+PointArray2d toPointArray2d(const T & points)
+{
+  PointArray2d point_array;
+  point_array.resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto p = getPoint(points.at(i));
+    point_array.x.at(i) = p.x;
+    point_array.y.at(i) = p.y;
+  }
+  return point_array;
+}
+
+/**
+ * @brief calcSquaredDistance2d from the point to each of the points
+ */
+void calcSquaredDistance2d(
+  const geometry_msgs::msg::Point & point, const PointArray2d & points,
+  std::vector<double> & squared_distances);
+
+/**
+ * @brief calcDistance2d from the point to each of the points
+ */
+void calcDistance2d(
+  const geometry_msgs::msg::Point & point, const PointArray2d & points,
+  std::vector<double> & distances);
+
+/**
+ * @brief calcAzimuthAngle from the point to each of the points
+ */
+void calcAzimuthAngle(
+  const geometry_msgs::msg::Point & point_from, const PointArray2d & points,
+  std::vector<double> & angles);
+
+/**
+ * @brief index of the nearest of the points to the point in 2d, the first one of ties
+ * @throws std::invalid_argument if the points are empty
+ */
+size_t findNearestIndex(const PointArray2d & points, const geometry_msgs::msg::Point & point);
+
+/**
+ * @brief transform the points from the frame of the pose in 2d, by its position and yaw
+ */
+void transformPoints2d(
+  const geometry_msgs::msg::Pose & pose, const PointArray2d & points,
+  PointArray2d & transformed_points);
+}  // namespace tier4_autoware_utils
+
+#endif  // TIER4_AUTOWARE_UTILS__GEOMETRY__BATCH_GEOMETRY_HPP_
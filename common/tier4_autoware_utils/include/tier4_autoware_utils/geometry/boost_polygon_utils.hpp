@@ -28,6 +28,14 @@
 
 namespace tier4_autoware_utils
 {
+/**
+ * @brief Polygon with its axis-aligned bounding box, which is tested before the polygon
+ */
+struct BoxedPolygon2d
+{
+  Polygon2d polygon;
+  Box2d box;
+};
 
 bool isClockwise(const Polygon2d & polygon);
 Polygon2d inverseClockwise(const Polygon2d & polygon);
@@ -37,6 +45,19 @@ Polygon2d toPolygon2d(
   const geometry_msgs::msg::Pose & pose, const autoware_auto_perception_msgs::msg::Shape & shape);
 double getArea(const autoware_auto_perception_msgs::msg::Shape & shape);
 
+/**
+ * @brief Close and orient the polygon as Polygon2d, and compute its bounding box
+ */
+BoxedPolygon2d toBoxedPolygon2d(const Polygon2d & polygon);
+/**
+ * @brief boost::geometry::within of the point in the polygon, the box of which is tested first
+ */
+bool within(const Point2d & point, const BoxedPolygon2d & polygon);
+/**
+ * @brief boost::geometry::intersects of the polygons, the boxes of which are tested first
+ */
+bool intersects(const BoxedPolygon2d & polygon1, const BoxedPolygon2d & polygon2);
+
 }  // namespace tier4_autoware_utils
 
 #endif  // TIER4_AUTOWARE_UTILS__GEOMETRY__BOOST_POLYGON_UTILS_HPP_
@@ -0,0 +1,243 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_AUTOWARE_UTILS__GEOMETRY__POLAR_GRID_HPP_
+#define TIER4_AUTOWARE_UTILS__GEOMETRY__POLAR_GRID_HPP_
+
+#include "tier4_autoware_utils/math/constants.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace tier4_autoware_utils
+{
+/**
+ * \brief Bins points by azimuth and range around an origin. The points are ordered by cell with
+ * a stable counting sort, the cells of an angle bin being contiguous and ordered by range, and
+ * the result is kept as arrays of indices, ranges and angles. The buffers are reused from one
+ * call to the next, so binning a cloud of a known size does not allocate.
+ */
+class PolarGrid
+{
+public:
+  /**
+   * \param angle_min the angle bins cover [angle_min, angle_min + 2 pi) [rad]
+   * \param angle_bin_size [rad]
+   * \param angle_bin_num number of angle bins, the last one taking the rest of the circle
+   * \param range_bin_size [m], unused with a single range bin
+   * \param range_bin_num number of range bins, the last one taking all the farther points
+   */
+  void initialize(
+    const float angle_min, const float angle_bin_size, const size_t angle_bin_num,
+    const float range_bin_size = 0.0f, const size_t range_bin_num = 1U)
+  {
+    angle_min_ = angle_min;
+    angle_bin_size_ = angle_bin_size;
+    angle_bin_num_ = std::max(angle_bin_num, size_t{1});
+    range_bin_size_ = range_bin_size;
+    range_bin_num_ = std::max(range_bin_num, size_t{1});
+  }
+
+  /**
+   * \brief Bin point_num points, get_xy(i) returning the x and y of the i-th point. The angle of
+   * a point is atan2(y, x).
+   */
+  template <class GetXY>
+  void bin(const size_t point_num, const GetXY & get_xy)
+  {
+    binPolar(point_num, [&get_xy](const size_t i) {
+      const std::pair<float, float> xy = get_xy(i);
+      return std::make_pair(std::hypot(xy.first, xy.second), std::atan2(xy.second, xy.first));
+    });
+  }
+
+  /**
+   * \brief Bin point_num points, get_range_angle(i) returning the range [m] and the angle [rad] of
+   * the i-th point, for points whose polar coordinates are known already, such as from the
+   * azimuth measured by a lidar. The angle is wrapped by one turn into the angle bins.
+   */
+  template <class GetRangeAngle>
+  void binPolar(const size_t point_num, const GetRangeAngle & get_range_angle)
+  {
+    const float angle_max = angle_min_ + static_cast<float>(2.0 * pi);
+    const size_t cell_num = angle_bin_num_ * range_bin_num_;
+    point_cells_.resize(point_num);
+    point_ranges_.resize(point_num);
+    point_angles_.resize(point_num);
+    cell_offsets_.assign(cell_num + 1, 0U);
+    for (size_t i = 0; i < point_num; ++i) {
+      const std::pair<float, float> range_angle = get_range_angle(i);
+      const float range = range_angle.first;
+      float angle = range_angle.second;
+      if (angle < angle_min_) {
+        angle += static_cast<float>(2.0 * pi);
+      } else if (angle >= angle_max) {
+        angle -= static_cast<float>(2.0 * pi);
+      }
+      const auto angle_bin = std::min(
+        static_cast<size_t>(std::max((angle - angle_min_) / angle_bin_size_, 0.0f)),
+        angle_bin_num_ - 1);
+      const auto range_bin =
+        range_bin_num_ == 1U
+          ? size_t{0}
+          : std::min(static_cast<size_t>(range / range_bin_size_), range_bin_num_ - 1);
+      const size_t cell = angle_bin * range_bin_num_ + range_bin;
+      point_cells_[i] = cell;
+      point_ranges_[i] = range;
+      point_angles_[i] = angle;
+      ++cell_offsets_[cell + 1];
+    }
+    std::partial_sum(cell_offsets_.begin(), cell_offsets_.end(), cell_offsets_.begin());
+
+    indices_.resize(point_num);
+    ranges_.resize(point_num);
+    angles_.resize(point_num);
+    sort_buffer_.resize(point_num);
+    next_offsets_.assign(cell_offsets_.begin(), cell_offsets_.end() - 1);
+    for (size_t i = 0; i < point_num; ++i) {
+      const size_t k = next_offsets_[point_cells_[i]]++;
+      indices_[k] = i;
+      ranges_[k] = point_ranges_[i];
+      angles_[k] = point_angles_[i];
+    }
+  }
+
+  /**
+   * \brief Sort the points of the angle bin by range. The range bins stay valid, and the angle
+   * bins are independent of each other, so that they can be sorted in parallel.
+   */
+  void sortByRange(const size_t angle_bin)
+  {
+    sortSpanByRange(angleBinBegin(angle_bin), angleBinEnd(angle_bin));
+  }
+  void sortByRange()
+  {
+    for (size_t i = 0; i < angle_bin_num_; ++i) {
+      sortByRange(i);
+    }
+  }
+
+  /**
+   * \brief Sort the points of the angle bin by range within each of its range bins, which sorts
+   * the whole angle bin as its range bins are in order of range. With range bins holding a few
+   * points each, the points are sorted by insertion in linear time.
+   */
+  void sortCellsByRange(const size_t angle_bin)
+  {
+    for (size_t range_bin = 0; range_bin < range_bin_num_; ++range_bin) {
+      const size_t begin = cellBegin(angle_bin, range_bin);
+      const size_t end = cellEnd(angle_bin, range_bin);
+      if (end - begin > max_insertion_sort_size) {
+        sortSpanByRange(begin, end);
+        continue;
+      }
+      for (size_t k = begin + 1; k < end; ++k) {
+        const float range = ranges_[k];
+        const float angle = angles_[k];
+        const size_t index = indices_[k];
+        size_t l = k;
+        for (; l > begin && ranges_[l - 1] > range; --l) {
+          ranges_[l] = ranges_[l - 1];
+          angles_[l] = angles_[l - 1];
+          indices_[l] = indices_[l - 1];
+        }
+        ranges_[l] = range;
+        angles_[l] = angle;
+        indices_[l] = index;
+      }
+    }
+  }
+
+  size_t size() const { return indices_.size(); }
+  size_t angleBinNum() const { return angle_bin_num_; }
+  size_t rangeBinNum() const { return range_bin_num_; }
+
+  // the binned points are [angleBinBegin(i), angleBinEnd(i)) for the angle bin i, and
+  // [cellBegin(i, j), cellEnd(i, j)) for its range bin j
+  size_t angleBinBegin(const size_t angle_bin) const
+  {
+    return cell_offsets_[angle_bin * range_bin_num_];
+  }
+  size_t angleBinEnd(const size_t angle_bin) const
+  {
+    return cell_offsets_[(angle_bin + 1) * range_bin_num_];
+  }
+  size_t cellBegin(const size_t angle_bin, const size_t range_bin) const
+  {
+    return cell_offsets_[angle_bin * range_bin_num_ + range_bin];
+  }
+  size_t cellEnd(const size_t angle_bin, const size_t range_bin) const
+  {
+    return cell_offsets_[angle_bin * range_bin_num_ + range_bin + 1];
+  }
+
+  // k-th binned point: its index in the input, its range [m] and angle [rad]
+  size_t index(const size_t k) const { return indices_[k]; }
+  float range(const size_t k) const { return ranges_[k]; }
+  float angle(const size_t k) const { return angles_[k]; }
+
+  // cell of the i-th input point, angle_bin * rangeBinNum() + range_bin
+  size_t pointCell(const size_t i) const { return point_cells_[i]; }
+
+private:
+  struct SortEntry
+  {
+    float range;
+    float angle;
+    size_t index;
+  };
+
+  static constexpr size_t max_insertion_sort_size = 32U;
+
+  void sortSpanByRange(const size_t begin, const size_t end)
+  {
+    for (size_t k = begin; k < end; ++k) {
+      sort_buffer_[k] = SortEntry{ranges_[k], angles_[k], indices_[k]};
+    }
+    std::sort(
+      sort_buffer_.begin() + begin, sort_buffer_.begin() + end,
+      [](const SortEntry & a, const SortEntry & b) { return a.range < b.range; });
+    for (size_t k = begin; k < end; ++k) {
+      ranges_[k] = sort_buffer_[k].range;
+      angles_[k] = sort_buffer_[k].angle;
+      indices_[k] = sort_buffer_[k].index;
+    }
+  }
+
+  float angle_min_{0.0f};
+  float angle_bin_size_{1.0f};
+  size_t angle_bin_num_{1U};
+  float range_bin_size_{0.0f};
+  size_t range_bin_num_{1U};
+
+  std::vector<size_t> cell_offsets_;
+  std::vector<size_t> indices_;
+  std::vector<float> ranges_;
+  std::vector<float> angles_;
+
+  // input order
+  std::vector<size_t> point_cells_;
+  std::vector<float> point_ranges_;
+  std::vector<float> point_angles_;
+
+  std::vector<size_t> next_offsets_;
+  std::vector<SortEntry> sort_buffer_;
+};
+}  // namespace tier4_autoware_utils
+
+#endif  // TIER4_AUTOWARE_UTILS__GEOMETRY__POLAR_GRID_HPP_
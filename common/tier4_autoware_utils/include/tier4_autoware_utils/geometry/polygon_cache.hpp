@@ -0,0 +1,54 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_AUTOWARE_UTILS__GEOMETRY__POLYGON_CACHE_HPP_
+#define TIER4_AUTOWARE_UTILS__GEOMETRY__POLYGON_CACHE_HPP_
+
+#include "tier4_autoware_utils/geometry/boost_polygon_utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace tier4_autoware_utils
+{
+/**
+ * @brief Polygons with their bounding boxes by id, e.g. of the lanelets and areas of a map, built
+ * once when the map is loaded instead of converting the primitives on every query
+ */
+class PolygonCache
+{
+public:
+  using Id = int64_t;
+
+  void add(const Id id, const Polygon2d & polygon) { polygons_[id] = toBoxedPolygon2d(polygon); }
+
+  /**
+   * @return the polygon of id, or nullptr if it is not added
+   */
+  const BoxedPolygon2d * find(const Id id) const
+  {
+    const auto itr = polygons_.find(id);
+    return itr == polygons_.end() ? nullptr : &itr->second;
+  }
+
+  size_t size() const { return polygons_.size(); }
+  void clear() { polygons_.clear(); }
+
+private:
+  std::unordered_map<Id, BoxedPolygon2d> polygons_;
+};
+}  // namespace tier4_autoware_utils
+
+#endif  // TIER4_AUTOWARE_UTILS__GEOMETRY__POLYGON_CACHE_HPP_
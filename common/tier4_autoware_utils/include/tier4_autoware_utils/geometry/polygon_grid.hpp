@@ -0,0 +1,65 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_AUTOWARE_UTILS__GEOMETRY__POLYGON_GRID_HPP_
+#define TIER4_AUTOWARE_UTILS__GEOMETRY__POLYGON_GRID_HPP_
+
+#include "tier4_autoware_utils/geometry/boost_polygon_utils.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace tier4_autoware_utils
+{
+/**
+ * @brief Union of polygons rasterized in the cells of a grid, e.g. of the lanelets of a route,
+ * built once instead of testing a point against each polygon. A cell which is in a polygon without
+ * any of its edges is inside, and for the other cells only the polygons with an edge in the cell
+ * are tested, so that the result is the same as within() of any of the polygons.
+ */
+class PolygonGrid
+{
+public:
+  PolygonGrid(const std::vector<BoxedPolygon2d> & polygons, const double resolution);
+
+  /**
+   * @brief whether the point is within() any of the polygons
+   */
+  bool withinAny(const Point2d & point) const;
+
+  double getResolution() const { return resolution_; }
+  size_t getCellNum() const { return cells_.size(); }
+
+private:
+  struct Cell
+  {
+    bool is_inside{false};
+    std::vector<uint32_t> edge_polygon_indices{};  // polygons with an edge in the cell
+  };
+
+  uint64_t getKey(const int64_t ix, const int64_t iy) const;
+  int64_t toIndex(const double v) const;
+
+  void addEdges(const uint32_t polygon_idx, const Point2d & p1, const Point2d & p2);
+  void fillInside(const uint32_t polygon_idx);
+
+  std::vector<BoxedPolygon2d> polygons_;
+  double resolution_;
+  std::unordered_map<uint64_t, Cell> cells_;
+};
+}  // namespace tier4_autoware_utils
+
+#endif  // TIER4_AUTOWARE_UTILS__GEOMETRY__POLYGON_GRID_HPP_
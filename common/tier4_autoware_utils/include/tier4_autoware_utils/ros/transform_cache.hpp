@@ -0,0 +1,220 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_AUTOWARE_UTILS__ROS__TRANSFORM_CACHE_HPP_
+#define TIER4_AUTOWARE_UTILS__ROS__TRANSFORM_CACHE_HPP_
+
+#include "tier4_autoware_utils/system/latest_value_mailbox.hpp"
+
+#include <rclcpp/time.hpp>
+
+#include <geometry_msgs/msg/transform_stamped.hpp>
+
+#include <tf2/LinearMath/Quaternion.h>
+#include <tf2/LinearMath/Vector3.h>
+#include <tf2_ros/buffer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tier4_autoware_utils
+{
+/**
+ * @brief transforms between frames linked only by static transforms, such as the sensor
+ *        extrinsics, resolved with the buffer once and then served without locking it
+ *        A pair of frames is resolved on its first request. The buffer returns a zero stamp for a
+ *        chain of static transforms, so a pair linked by a dynamic transform is remembered as
+ *        such and returns nullptr, for the caller to fall back to a time stamped lookup. Entries
+ *        are written once and published with a release store, so a lookup only scans them.
+ */
+class StaticTransformCache
+{
+public:
+  explicit StaticTransformCache(const tf2_ros::Buffer & tf_buffer, const size_t capacity = 16)
+  : tf_buffer_(tf_buffer), entries_(capacity)
+  {
+  }
+  StaticTransformCache(const StaticTransformCache &) = delete;
+  StaticTransformCache & operator=(const StaticTransformCache &) = delete;
+
+  /**
+   * @brief transform from the source frame to the target frame, or nullptr if they are not
+   *        available yet or not linked only by static transforms
+   */
+  geometry_msgs::msg::TransformStamped::ConstSharedPtr getTransform(
+    const std::string & target_frame, const std::string & source_frame)
+  {
+    const size_t num_entries = std::min(next_entry_.load(std::memory_order_acquire), capacity());
+    for (size_t i = 0; i < num_entries; ++i) {
+      const auto & entry = entries_[i];
+      if (
+        entry.is_ready.load(std::memory_order_acquire) && entry.target_frame == target_frame &&
+        entry.source_frame == source_frame) {
+        return entry.transform;
+      }
+    }
+
+    geometry_msgs::msg::TransformStamped transform;
+    try {
+      transform = tf_buffer_.lookupTransform(target_frame, source_frame, tf2::TimePointZero);
+    } catch (tf2::TransformException &) {
+      // not published yet, so resolved again on the next request
+      return {};
+    }
+
+    const bool is_static =
+      transform.header.stamp.sec == 0 && transform.header.stamp.nanosec == 0;
+    const auto transform_ptr =
+      is_static ? std::make_shared<const geometry_msgs::msg::TransformStamped>(transform)
+                : geometry_msgs::msg::TransformStamped::ConstSharedPtr{};
+
+    // two threads may resolve the same pair at once, which only costs an entry
+    const size_t index = next_entry_.fetch_add(1, std::memory_order_acq_rel);
+    if (index < capacity()) {
+      auto & entry = entries_[index];
+      entry.target_frame = target_frame;
+      entry.source_frame = source_frame;
+      entry.transform = transform_ptr;
+      entry.is_ready.store(true, std::memory_order_release);
+    }
+    return transform_ptr;
+  }
+
+  size_t capacity() const { return entries_.size(); }
+
+private:
+  struct Entry
+  {
+    std::string target_frame;
+    std::string source_frame;
+    geometry_msgs::msg::TransformStamped::ConstSharedPtr transform;
+    std::atomic<bool> is_ready{false};
+  };
+
+  const tf2_ros::Buffer & tf_buffer_;
+  std::vector<Entry> entries_;
+  std::atomic<size_t> next_entry_{0};
+};
+
+/**
+ * @brief latest samples of one dynamic transform, such as map to base_link, written by one thread
+ *        and interpolated by others without a lock
+ *        Each slot is a LatestValueMailbox, so a slot overwritten while it is read is retried,
+ *        and a pair of slots no longer bracketing the requested time is reported as a miss.
+ */
+class TransformRingBuffer
+{
+public:
+  explicit TransformRingBuffer(const size_t capacity = 100)
+  : slots_(std::max<size_t>(capacity, 2))
+  {
+  }
+  TransformRingBuffer(const TransformRingBuffer &) = delete;
+  TransformRingBuffer & operator=(const TransformRingBuffer &) = delete;
+
+  /**
+   * @brief add a sample, older than none of the samples already added
+   */
+  void push(const geometry_msgs::msg::TransformStamped & transform)
+  {
+    const auto & t = transform.transform.translation;
+    const auto & q = transform.transform.rotation;
+    const Sample sample{
+      rclcpp::Time(transform.header.stamp).nanoseconds(), t.x, t.y, t.z, q.x, q.y, q.z, q.w};
+
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    slots_[head % slots_.size()].write(sample);
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief transform at the time interpolated between the samples around it, or false if the
+   *        time is out of the range of the samples
+   */
+  bool lookup(const rclcpp::Time & time, geometry_msgs::msg::Transform & transform) const
+  {
+    const int64_t stamp_ns = time.nanoseconds();
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    if (head == 0) {
+      return false;
+    }
+
+    Sample newer = slots_[(head - 1) % slots_.size()].read();
+    if (stamp_ns > newer.stamp_ns) {
+      return false;
+    }
+    if (newer.stamp_ns == stamp_ns) {
+      toTransform(newer, newer, 0.0, transform);
+      return true;
+    }
+    const uint64_t num_samples = std::min<uint64_t>(head, slots_.size());
+    for (uint64_t i = 2; i <= num_samples; ++i) {
+      const Sample older = slots_[(head - i) % slots_.size()].read();
+      if (older.stamp_ns > newer.stamp_ns) {
+        // overwritten by a newer sample while being read
+        return false;
+      }
+      if (older.stamp_ns <= stamp_ns && stamp_ns <= newer.stamp_ns) {
+        const int64_t duration_ns = newer.stamp_ns - older.stamp_ns;
+        const double ratio =
+          duration_ns == 0 ? 0.0 : static_cast<double>(stamp_ns - older.stamp_ns) / duration_ns;
+        toTransform(older, newer, ratio, transform);
+        return true;
+      }
+      newer = older;
+    }
+    return false;
+  }
+
+  size_t capacity() const { return slots_.size(); }
+
+private:
+  struct Sample
+  {
+    int64_t stamp_ns;
+    double tx, ty, tz;
+    double qx, qy, qz, qw;
+  };
+
+  static void toTransform(
+    const Sample & older, const Sample & newer, const double ratio,
+    geometry_msgs::msg::Transform & transform)
+  {
+    const tf2::Vector3 translation = tf2::lerp(
+      tf2::Vector3(older.tx, older.ty, older.tz), tf2::Vector3(newer.tx, newer.ty, newer.tz),
+      ratio);
+    const tf2::Quaternion rotation = tf2::slerp(
+      tf2::Quaternion(older.qx, older.qy, older.qz, older.qw),
+      tf2::Quaternion(newer.qx, newer.qy, newer.qz, newer.qw), ratio);
+
+    transform.translation.x = translation.x();
+    transform.translation.y = translation.y();
+    transform.translation.z = translation.z();
+    transform.rotation.x = rotation.x();
+    transform.rotation.y = rotation.y();
+    transform.rotation.z = rotation.z();
+    transform.rotation.w = rotation.w();
+  }
+
+  std::vector<LatestValueMailbox<Sample>> slots_;
+  std::atomic<uint64_t> head_{0};
+};
+}  // namespace tier4_autoware_utils
+
+#endif  // TIER4_AUTOWARE_UTILS__ROS__TRANSFORM_CACHE_HPP_
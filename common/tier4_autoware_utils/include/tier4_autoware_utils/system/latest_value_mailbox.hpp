@@ -0,0 +1,98 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_AUTOWARE_UTILS__SYSTEM__LATEST_VALUE_MAILBOX_HPP_
+#define TIER4_AUTOWARE_UTILS__SYSTEM__LATEST_VALUE_MAILBOX_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace tier4_autoware_utils
+{
+/**
+ * @brief latest value written by one thread and read by another without a lock (seqlock)
+ *        The value is kept as atomic words, and the sequence is odd while it is written. A read
+ *        is retried until it sees the same even sequence before and after copying the words, so
+ *        neither side waits on a mutex held by the other. Writes are serialized by the sequence.
+ */
+template <class T>
+class LatestValueMailbox
+{
+  static_assert(
+    std::is_trivially_copyable<T>::value, "LatestValueMailbox requires a trivially copyable type");
+
+public:
+  LatestValueMailbox() = default;
+  explicit LatestValueMailbox(const T & value) { write(value); }
+  LatestValueMailbox(const LatestValueMailbox &) = delete;
+  LatestValueMailbox & operator=(const LatestValueMailbox &) = delete;
+
+  void write(const T & value)
+  {
+    std::array<uint64_t, num_words> words{};
+    std::memcpy(words.data(), &value, sizeof(T));
+
+    uint64_t seq = sequence_.load(std::memory_order_relaxed);
+    while (seq % 2 == 1 || !sequence_.compare_exchange_weak(
+                             seq, seq + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+      seq = sequence_.load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (size_t i = 0; i < num_words; ++i) {
+      words_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(seq + 2, std::memory_order_release);
+  }
+
+  /**
+   * @brief the latest value, or the default constructed one if nothing has been written
+   */
+  T read() const
+  {
+    std::array<uint64_t, num_words> words{};
+    uint64_t seq_begin = 0;
+    uint64_t seq_end = 0;
+    do {
+      seq_begin = sequence_.load(std::memory_order_acquire);
+      for (size_t i = 0; i < num_words; ++i) {
+        words[i] = words_[i].load(std::memory_order_relaxed);
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      seq_end = sequence_.load(std::memory_order_relaxed);
+    } while (seq_begin % 2 == 1 || seq_begin != seq_end);
+
+    if (seq_begin == 0) {
+      return T{};
+    }
+    T value;
+    std::memcpy(static_cast<void *>(&value), words.data(), sizeof(T));
+    return value;
+  }
+
+  bool hasValue() const { return sequence_.load(std::memory_order_acquire) != 0; }
+
+private:
+  static constexpr size_t num_words = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  std::atomic<uint64_t> sequence_{0};
+  std::array<std::atomic<uint64_t>, num_words> words_{};
+};
+}  // namespace tier4_autoware_utils
+
+#endif  // TIER4_AUTOWARE_UTILS__SYSTEM__LATEST_VALUE_MAILBOX_HPP_
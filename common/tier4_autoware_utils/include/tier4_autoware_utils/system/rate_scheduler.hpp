@@ -0,0 +1,86 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_AUTOWARE_UTILS__SYSTEM__RATE_SCHEDULER_HPP_
+#define TIER4_AUTOWARE_UTILS__SYSTEM__RATE_SCHEDULER_HPP_
+
+#include <algorithm>
+#include <cmath>
+
+namespace tier4_autoware_utils
+{
+/**
+ * @brief rate of a periodic process chosen within [min_rate, max_rate] after each cycle
+ *        The complexity of the scene, from 0 to 1, asks for a rate from min_rate to max_rate,
+ *        which is lowered so that the processing time takes at most target_load_ratio of the
+ *        period. The processing time is filtered to rise at once and decay slowly, so that a
+ *        single fast cycle does not raise the rate back into an overrun. The rate changes only
+ *        by more than hysteresis_ratio of the current one, not to reschedule on every cycle.
+ */
+class RateScheduler
+{
+public:
+  RateScheduler(
+    const double min_rate, const double max_rate, const double target_load_ratio = 0.8,
+    const double hysteresis_ratio = 0.1, const double decay_ratio = 0.1)
+  : min_rate_(min_rate),
+    max_rate_(std::max(min_rate, max_rate)),
+    target_load_ratio_(target_load_ratio),
+    hysteresis_ratio_(hysteresis_ratio),
+    decay_ratio_(decay_ratio),
+    rate_(max_rate_)
+  {
+  }
+
+  /**
+   * @brief update the rate from the processing time [s] of the last cycle and the complexity
+   * @return whether the rate changed
+   */
+  bool update(const double processing_time, const double complexity)
+  {
+    filtered_processing_time_ = std::max(
+      processing_time,
+      filtered_processing_time_ + decay_ratio_ * (processing_time - filtered_processing_time_));
+
+    const double demanded_rate =
+      min_rate_ + std::clamp(complexity, 0.0, 1.0) * (max_rate_ - min_rate_);
+    const double sustainable_rate = filtered_processing_time_ > 0.0
+                                      ? target_load_ratio_ / filtered_processing_time_
+                                      : max_rate_;
+    const double rate = std::clamp(std::min(demanded_rate, sustainable_rate), min_rate_, max_rate_);
+
+    // reaching a bound is not held back by the hysteresis
+    const bool is_bound = rate == min_rate_ || rate == max_rate_;
+    if (rate == rate_ || (!is_bound && std::abs(rate - rate_) <= hysteresis_ratio_ * rate_)) {
+      return false;
+    }
+    rate_ = rate;
+    return true;
+  }
+
+  double getRate() const { return rate_; }
+
+private:
+  double min_rate_;
+  double max_rate_;
+  double target_load_ratio_;
+  double hysteresis_ratio_;
+  double decay_ratio_;
+
+  double rate_;
+  double filtered_processing_time_{0.0};
+};
+}  // namespace tier4_autoware_utils
+
+#endif  // TIER4_AUTOWARE_UTILS__SYSTEM__RATE_SCHEDULER_HPP_
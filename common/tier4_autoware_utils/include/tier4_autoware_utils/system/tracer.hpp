@@ -0,0 +1,132 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TIER4_AUTOWARE_UTILS__SYSTEM__TRACER_HPP_
+#define TIER4_AUTOWARE_UTILS__SYSTEM__TRACER_HPP_
+
+#include <builtin_interfaces/msg/time.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace tier4_autoware_utils
+{
+/**
+ * @brief span recorded by TraceSpan, with the times of the steady clock
+ */
+struct TraceEvent
+{
+  const char * name{nullptr};
+  uint64_t correlation_id{0};
+  int64_t start_ns{0};
+  int64_t end_ns{0};
+  uint32_t depth{0};
+  uint32_t thread_id{0};
+};
+
+/**
+ * @brief id correlating the spans of the processing of a message across nodes, from its stamp
+ */
+inline uint64_t toCorrelationId(const builtin_interfaces::msg::Time & stamp)
+{
+  return static_cast<uint64_t>(stamp.sec) * 1000000000ULL + stamp.nanosec;
+}
+
+/**
+ * @brief Records the spans of all threads of the process. Each thread records into a ring buffer
+ * of its own without any lock, the oldest events being overwritten when it is full, and the
+ * events are collected from all the buffers by any thread. Nothing is recorded until the tracer
+ * is enabled.
+ */
+class Tracer
+{
+public:
+  static Tracer & getInstance();
+
+  void setEnabled(const bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+  bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief capacity of the buffers of the threads which record their first event afterward
+   */
+  void setBufferCapacity(const size_t capacity);
+
+  /**
+   * @brief record the event into the buffer of the calling thread, whose id is set
+   */
+  void record(TraceEvent event);
+
+  /**
+   * @brief events of all threads recorded since the last collection, ordered by start time
+   */
+  std::vector<TraceEvent> collect();
+
+  /**
+   * @brief write the events as a Chrome trace (chrome://tracing, Perfetto) JSON array
+   */
+  static void writeChromeTrace(std::ostream & os, const std::vector<TraceEvent> & events);
+
+  /**
+   * @brief total time [ms] of the events by name, e.g. for ProcessingTimePublisher
+   */
+  static std::map<std::string, double> toProcessingTimeMap(const std::vector<TraceEvent> & events);
+
+private:
+  class ThreadBuffer;
+
+  Tracer() = default;
+  ThreadBuffer & getThreadBuffer();
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<size_t> buffer_capacity_{4096};
+  std::mutex mutex_;  // of the list of the buffers and of the collection, not of the recording
+  // kept after their thread exits, so that its last events are still collected
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+/**
+ * @brief Records a span of the name from its construction to its destruction. The spans nested
+ * in one thread take the correlation id of the enclosing span unless they are given one. The
+ * name has to outlive the tracer, e.g. a string literal.
+ */
+class TraceSpan
+{
+public:
+  explicit TraceSpan(const char * name, const uint64_t correlation_id = 0);
+  TraceSpan(const char * name, const builtin_interfaces::msg::Time & stamp)
+  : TraceSpan(name, toCorrelationId(stamp))
+  {
+  }
+  ~TraceSpan();
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan & operator=(const TraceSpan &) = delete;
+
+private:
+  bool is_enabled_;
+  const char * name_;
+  uint64_t correlation_id_{0};
+  uint64_t parent_correlation_id_{0};
+  int64_t start_ns_{0};
+  uint32_t depth_{0};
+};
+}  // namespace tier4_autoware_utils
+
+#endif  // TIER4_AUTOWARE_UTILS__SYSTEM__TRACER_HPP_
@@ -15,10 +15,14 @@
 #ifndef TIER4_AUTOWARE_UTILS__TIER4_AUTOWARE_UTILS_HPP_
 #define TIER4_AUTOWARE_UTILS__TIER4_AUTOWARE_UTILS_HPP_
 
+#include "tier4_autoware_utils/geometry/batch_geometry.hpp"
 #include "tier4_autoware_utils/geometry/boost_geometry.hpp"
 #include "tier4_autoware_utils/geometry/boost_polygon_utils.hpp"
 #include "tier4_autoware_utils/geometry/geometry.hpp"
 #include "tier4_autoware_utils/geometry/path_with_lane_id_geometry.hpp"
+#include "tier4_autoware_utils/geometry/polar_grid.hpp"
+#include "tier4_autoware_utils/geometry/polygon_cache.hpp"
+#include "tier4_autoware_utils/geometry/polygon_grid.hpp"
 #include "tier4_autoware_utils/geometry/pose_deviation.hpp"
 #include "tier4_autoware_utils/math/constants.hpp"
 #include "tier4_autoware_utils/math/normalization.hpp"
@@ -29,9 +33,13 @@
 #include "tier4_autoware_utils/ros/marker_helper.hpp"
 #include "tier4_autoware_utils/ros/processing_time_publisher.hpp"
 #include "tier4_autoware_utils/ros/self_pose_listener.hpp"
+#include "tier4_autoware_utils/ros/transform_cache.hpp"
 #include "tier4_autoware_utils/ros/transform_listener.hpp"
 #include "tier4_autoware_utils/ros/update_param.hpp"
 #include "tier4_autoware_utils/ros/wait_for_param.hpp"
+#include "tier4_autoware_utils/system/latest_value_mailbox.hpp"
+#include "tier4_autoware_utils/system/rate_scheduler.hpp"
 #include "tier4_autoware_utils/system/stop_watch.hpp"
+#include "tier4_autoware_utils/system/tracer.hpp"
 
 #endif  // TIER4_AUTOWARE_UTILS__TIER4_AUTOWARE_UTILS_HPP_
@@ -0,0 +1,185 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/geometry/batch_geometry.hpp"
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+constexpr size_t nearest_block_size = 64;
+
+/**
+ * @brief squared distances from (px, py) to the num points of x and y
+ */
+void calcSquaredDistances(
+  const double px, const double py, const double * x, const double * y, const size_t num,
+  double * squared_distances)
+{
+  size_t i = 0;
+#if defined(__AVX2__) && defined(__FMA__)
+  const __m256d vpx = _mm256_set1_pd(px);
+  const __m256d vpy = _mm256_set1_pd(py);
+  for (; i + 4 <= num; i += 4) {
+    const __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), vpx);
+    const __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), vpy);
+    _mm256_storeu_pd(squared_distances + i, _mm256_fmadd_pd(dx, dx, _mm256_mul_pd(dy, dy)));
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const float64x2_t vpx = vdupq_n_f64(px);
+  const float64x2_t vpy = vdupq_n_f64(py);
+  for (; i + 2 <= num; i += 2) {
+    const float64x2_t dx = vsubq_f64(vld1q_f64(x + i), vpx);
+    const float64x2_t dy = vsubq_f64(vld1q_f64(y + i), vpy);
+    vst1q_f64(squared_distances + i, vfmaq_f64(vmulq_f64(dy, dy), dx, dx));
+  }
+#endif
+  for (; i < num; ++i) {
+    const double dx = x[i] - px;
+    const double dy = y[i] - py;
+    squared_distances[i] = dx * dx + dy * dy;
+  }
+}
+
+void calcSqrt(double * values, const size_t num)
+{
+  size_t i = 0;
+#if defined(__AVX2__) && defined(__FMA__)
+  for (; i + 4 <= num; i += 4) {
+    _mm256_storeu_pd(values + i, _mm256_sqrt_pd(_mm256_loadu_pd(values + i)));
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  for (; i + 2 <= num; i += 2) {
+    vst1q_f64(values + i, vsqrtq_f64(vld1q_f64(values + i)));
+  }
+#endif
+  for (; i < num; ++i) {
+    values[i] = std::sqrt(values[i]);
+  }
+}
+
+/**
+ * @brief (c x - s y + tx, s x + c y + ty) of the num points of x and y
+ */
+void transformPoints(
+  const double c, const double s, const double tx, const double ty, const double * x,
+  const double * y, const size_t num, double * out_x, double * out_y)
+{
+  size_t i = 0;
+#if defined(__AVX2__) && defined(__FMA__)
+  const __m256d vc = _mm256_set1_pd(c);
+  const __m256d vs = _mm256_set1_pd(s);
+  const __m256d vtx = _mm256_set1_pd(tx);
+  const __m256d vty = _mm256_set1_pd(ty);
+  for (; i + 4 <= num; i += 4) {
+    const __m256d px = _mm256_loadu_pd(x + i);
+    const __m256d py = _mm256_loadu_pd(y + i);
+    _mm256_storeu_pd(out_x + i, _mm256_fmadd_pd(vc, px, _mm256_fnmadd_pd(vs, py, vtx)));
+    _mm256_storeu_pd(out_y + i, _mm256_fmadd_pd(vs, px, _mm256_fmadd_pd(vc, py, vty)));
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const float64x2_t vtx = vdupq_n_f64(tx);
+  const float64x2_t vty = vdupq_n_f64(ty);
+  for (; i + 2 <= num; i += 2) {
+    const float64x2_t px = vld1q_f64(x + i);
+    const float64x2_t py = vld1q_f64(y + i);
+    vst1q_f64(out_x + i, vfmaq_n_f64(vfmsq_n_f64(vtx, py, s), px, c));
+    vst1q_f64(out_y + i, vfmaq_n_f64(vfmaq_n_f64(vty, py, c), px, s));
+  }
+#endif
+  for (; i < num; ++i) {
+    const double px = x[i];
+    const double py = y[i];
+    out_x[i] = c * px - s * py + tx;
+    out_y[i] = s * px + c * py + ty;
+  }
+}
+}  // namespace
+
+namespace tier4_autoware_utils
+{
+void calcSquaredDistance2d(
+  const geometry_msgs::msg::Point & point, const PointArray2d & points,
+  std::vector<double> & squared_distances)
+{
+  squared_distances.resize(points.size());
+  calcSquaredDistances(
+    point.x, point.y, points.x.data(), points.y.data(), points.size(), squared_distances.data());
+}
+
+void calcDistance2d(
+  const geometry_msgs::msg::Point & point, const PointArray2d & points,
+  std::vector<double> & distances)
+{
+  calcSquaredDistance2d(point, points, distances);
+  calcSqrt(distances.data(), distances.size());
+}
+
+void calcAzimuthAngle(
+  const geometry_msgs::msg::Point & point_from, const PointArray2d & points,
+  std::vector<double> & angles)
+{
+  // atan2 is not vectorized, but the loop is kept so that the callers stay batched
+  angles.resize(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    angles[i] = std::atan2(points.y[i] - point_from.y, points.x[i] - point_from.x);
+  }
+}
+
+size_t findNearestIndex(const PointArray2d & points, const geometry_msgs::msg::Point & point)
+{
+  if (points.empty()) {
+    throw std::invalid_argument("Points are empty.");
+  }
+
+  // the distances of a block at a time, so that no buffer is allocated
+  double squared_distances[nearest_block_size];
+  double min_squared_dist = std::numeric_limits<double>::max();
+  size_t min_idx = 0;
+  for (size_t offset = 0; offset < points.size(); offset += nearest_block_size) {
+    const size_t num = std::min(nearest_block_size, points.size() - offset);
+    calcSquaredDistances(
+      point.x, point.y, points.x.data() + offset, points.y.data() + offset, num,
+      squared_distances);
+    for (size_t i = 0; i < num; ++i) {
+      if (squared_distances[i] < min_squared_dist) {
+        min_squared_dist = squared_distances[i];
+        min_idx = offset + i;
+      }
+    }
+  }
+  return min_idx;
+}
+
+void transformPoints2d(
+  const geometry_msgs::msg::Pose & pose, const PointArray2d & points,
+  PointArray2d & transformed_points)
+{
+  const double yaw = tf2::getYaw(pose.orientation);
+  transformed_points.resize(points.size());
+  transformPoints(
+    std::cos(yaw), std::sin(yaw), pose.position.x, pose.position.y, points.x.data(),
+    points.y.data(), points.size(), transformed_points.x.data(), transformed_points.y.data());
+}
+}  // namespace tier4_autoware_utils
@@ -179,4 +179,29 @@ double getArea(const autoware_auto_perception_msgs::msg::Shape & shape)
 
   throw std::logic_error("The shape type is not supported in tier4_autoware_utils.");
 }
+
+BoxedPolygon2d toBoxedPolygon2d(const Polygon2d & polygon)
+{
+  BoxedPolygon2d boxed_polygon;
+  boxed_polygon.polygon = polygon;
+  bg::correct(boxed_polygon.polygon);
+  bg::envelope(boxed_polygon.polygon, boxed_polygon.box);
+  return boxed_polygon;
+}
+
+bool within(const Point2d & point, const BoxedPolygon2d & polygon)
+{
+  if (!bg::covered_by(point, polygon.box)) {
+    return false;
+  }
+  return bg::within(point, polygon.polygon);
+}
+
+bool intersects(const BoxedPolygon2d & polygon1, const BoxedPolygon2d & polygon2)
+{
+  if (bg::disjoint(polygon1.box, polygon2.box)) {
+    return false;
+  }
+  return bg::intersects(polygon1.polygon, polygon2.polygon);
+}
 }  // namespace tier4_autoware_utils
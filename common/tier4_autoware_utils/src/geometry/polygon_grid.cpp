@@ -0,0 +1,160 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/geometry/polygon_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+// margin of the cells of an edge, so that a cell touched by an edge is not inside
+constexpr double edge_margin = 1e-6;
+
+template <class F>
+void forEachEdge(const tier4_autoware_utils::Polygon2d & polygon, const F & f)
+{
+  const auto for_ring = [&](const tier4_autoware_utils::LinearRing2d & ring) {
+    // the rings are closed by toBoxedPolygon2d()
+    for (size_t i = 0; i + 1 < ring.size(); ++i) {
+      f(ring.at(i), ring.at(i + 1));
+    }
+  };
+
+  for_ring(polygon.outer());
+  for (const auto & inner : polygon.inners()) {
+    for_ring(inner);
+  }
+}
+}  // namespace
+
+namespace tier4_autoware_utils
+{
+PolygonGrid::PolygonGrid(const std::vector<BoxedPolygon2d> & polygons, const double resolution)
+: polygons_(polygons), resolution_(resolution)
+{
+  if (resolution_ <= 0.0) {
+    throw std::invalid_argument("The resolution of PolygonGrid must be positive.");
+  }
+
+  for (uint32_t i = 0; i < polygons_.size(); ++i) {
+    forEachEdge(polygons_.at(i).polygon, [&](const Point2d & p1, const Point2d & p2) {
+      addEdges(i, p1, p2);
+    });
+    fillInside(i);
+  }
+}
+
+bool PolygonGrid::withinAny(const Point2d & point) const
+{
+  const auto itr = cells_.find(getKey(toIndex(point.x()), toIndex(point.y())));
+  if (itr == cells_.end()) {
+    return false;
+  }
+
+  const auto & cell = itr->second;
+  if (cell.is_inside) {
+    return true;
+  }
+
+  for (const auto polygon_idx : cell.edge_polygon_indices) {
+    if (within(point, polygons_.at(polygon_idx))) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+uint64_t PolygonGrid::getKey(const int64_t ix, const int64_t iy) const
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(ix)) << 32) |
+         static_cast<uint64_t>(static_cast<uint32_t>(iy));
+}
+
+int64_t PolygonGrid::toIndex(const double v) const
+{
+  return static_cast<int64_t>(std::floor(v / resolution_));
+}
+
+void PolygonGrid::addEdges(const uint32_t polygon_idx, const Point2d & p1, const Point2d & p2)
+{
+  const auto add = [&](const int64_t ix, const int64_t iy) {
+    auto & indices = cells_[getKey(ix, iy)].edge_polygon_indices;
+    // the edges of a polygon are added in a row
+    if (indices.empty() || indices.back() != polygon_idx) {
+      indices.push_back(polygon_idx);
+    }
+  };
+
+  const double min_x = std::min(p1.x(), p2.x());
+  const double max_x = std::max(p1.x(), p2.x());
+  const double dx = p2.x() - p1.x();
+  const double dy = p2.y() - p1.y();
+
+  // the range of y of the edge in each column of the cells
+  for (int64_t ix = toIndex(min_x - edge_margin); ix <= toIndex(max_x + edge_margin); ++ix) {
+    const double x_begin = std::max(min_x, static_cast<double>(ix) * resolution_ - edge_margin);
+    const double x_end = std::min(max_x, static_cast<double>(ix + 1) * resolution_ + edge_margin);
+
+    double y_begin = std::min(p1.y(), p2.y());
+    double y_end = std::max(p1.y(), p2.y());
+    if (dx != 0.0) {
+      const double y1 = p1.y() + dy * (x_begin - p1.x()) / dx;
+      const double y2 = p1.y() + dy * (x_end - p1.x()) / dx;
+      y_begin = std::max(y_begin, std::min(y1, y2));
+      y_end = std::min(y_end, std::max(y1, y2));
+    }
+
+    for (int64_t iy = toIndex(y_begin - edge_margin); iy <= toIndex(y_end + edge_margin); ++iy) {
+      add(ix, iy);
+    }
+  }
+}
+
+void PolygonGrid::fillInside(const uint32_t polygon_idx)
+{
+  const auto & boxed_polygon = polygons_.at(polygon_idx);
+  const auto & box = boxed_polygon.box;
+
+  std::vector<double> crossings;
+  for (int64_t iy = toIndex(box.min_corner().y()); iy <= toIndex(box.max_corner().y()); ++iy) {
+    // crossings of the edges with the line through the centers of the cells of the row
+    const double y = (static_cast<double>(iy) + 0.5) * resolution_;
+    crossings.clear();
+    forEachEdge(boxed_polygon.polygon, [&](const Point2d & p1, const Point2d & p2) {
+      if ((p1.y() <= y) != (p2.y() <= y)) {
+        crossings.push_back(p1.x() + (p2.x() - p1.x()) * (y - p1.y()) / (p2.y() - p1.y()));
+      }
+    });
+    std::sort(crossings.begin(), crossings.end());
+
+    // a cell without an edge is inside if its center is
+    for (size_t i = 0; i + 1 < crossings.size(); i += 2) {
+      const int64_t ix_begin = static_cast<int64_t>(std::ceil(crossings.at(i) / resolution_ - 0.5));
+      const int64_t ix_end =
+        static_cast<int64_t>(std::floor(crossings.at(i + 1) / resolution_ - 0.5));
+      for (int64_t ix = ix_begin; ix <= ix_end; ++ix) {
+        auto & cell = cells_[getKey(ix, iy)];
+        const auto & indices = cell.edge_polygon_indices;
+        if (indices.empty() || indices.back() != polygon_idx) {
+          cell.is_inside = true;
+        }
+      }
+    }
+  }
+}
+}  // namespace tier4_autoware_utils
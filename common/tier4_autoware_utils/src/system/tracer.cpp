@@ -0,0 +1,218 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/system/tracer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+int64_t nowNanoseconds()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+// microseconds of the trace format, without losing the nanoseconds of the steady clock
+std::string toMicroseconds(const int64_t ns)
+{
+  return std::to_string(ns / 1000) + "." + std::to_string(ns % 1000 + 1000).substr(1);
+}
+
+// state of the spans of the thread
+thread_local uint32_t current_depth = 0;
+thread_local uint64_t current_correlation_id = 0;
+}  // namespace
+
+namespace tier4_autoware_utils
+{
+/**
+ * @brief Ring buffer written by one thread and read by the collecting one. Each slot has a
+ * sequence number, odd while it is written, so that the collection skips the slots overwritten
+ * while they are read.
+ */
+class Tracer::ThreadBuffer
+{
+public:
+  ThreadBuffer(const size_t capacity, const uint32_t thread_id)
+  : slots_(std::max(capacity, size_t{1})), thread_id_(thread_id)
+  {
+  }
+
+  void push(const TraceEvent & event)
+  {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    auto & slot = slots_[head % slots_.size()];
+    slot.sequence.store(2 * head + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(event.name, std::memory_order_relaxed);
+    slot.correlation_id.store(event.correlation_id, std::memory_order_relaxed);
+    slot.start_ns.store(event.start_ns, std::memory_order_relaxed);
+    slot.end_ns.store(event.end_ns, std::memory_order_relaxed);
+    slot.depth.store(event.depth, std::memory_order_relaxed);
+    slot.sequence.store(2 * head + 2, std::memory_order_release);
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  // the events pushed since the last call, except the ones overwritten before they are read
+  void pop(std::vector<TraceEvent> & events)
+  {
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t tail = std::max(tail_, head > slots_.size() ? head - slots_.size() : 0);
+    for (; tail < head; ++tail) {
+      const auto & slot = slots_[tail % slots_.size()];
+      const uint64_t sequence = 2 * tail + 2;
+      if (slot.sequence.load(std::memory_order_acquire) != sequence) {
+        continue;
+      }
+      TraceEvent event;
+      event.name = slot.name.load(std::memory_order_relaxed);
+      event.correlation_id = slot.correlation_id.load(std::memory_order_relaxed);
+      event.start_ns = slot.start_ns.load(std::memory_order_relaxed);
+      event.end_ns = slot.end_ns.load(std::memory_order_relaxed);
+      event.depth = slot.depth.load(std::memory_order_relaxed);
+      event.thread_id = thread_id_;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (slot.sequence.load(std::memory_order_relaxed) == sequence) {
+        events.push_back(event);
+      }
+    }
+    tail_ = head;
+  }
+
+  uint32_t getThreadId() const { return thread_id_; }
+
+private:
+  struct Slot
+  {
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<const char *> name{nullptr};
+    std::atomic<uint64_t> correlation_id{0};
+    std::atomic<int64_t> start_ns{0};
+    std::atomic<int64_t> end_ns{0};
+    std::atomic<uint32_t> depth{0};
+  };
+
+  std::vector<Slot> slots_;
+  std::atomic<uint64_t> head_{0};  // number of the pushed events
+  uint64_t tail_{0};               // number of the popped or skipped events, of the reader
+  const uint32_t thread_id_;
+};
+
+Tracer & Tracer::getInstance()
+{
+  static Tracer tracer;
+  return tracer;
+}
+
+void Tracer::setBufferCapacity(const size_t capacity)
+{
+  buffer_capacity_.store(capacity, std::memory_order_relaxed);
+}
+
+Tracer::ThreadBuffer & Tracer::getThreadBuffer()
+{
+  thread_local std::shared_ptr<ThreadBuffer> buffer = [this]() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffers_.push_back(std::make_shared<ThreadBuffer>(
+      buffer_capacity_.load(std::memory_order_relaxed), static_cast<uint32_t>(buffers_.size())));
+    return buffers_.back();
+  }();
+  return *buffer;
+}
+
+void Tracer::record(TraceEvent event)
+{
+  auto & buffer = getThreadBuffer();
+  event.thread_id = buffer.getThreadId();
+  buffer.push(event);
+}
+
+std::vector<TraceEvent> Tracer::collect()
+{
+  std::vector<TraceEvent> events;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto & buffer : buffers_) {
+      buffer->pop(events);
+    }
+  }
+  std::stable_sort(events.begin(), events.end(), [](const auto & a, const auto & b) {
+    return a.start_ns < b.start_ns;
+  });
+  return events;
+}
+
+void Tracer::writeChromeTrace(std::ostream & os, const std::vector<TraceEvent> & events)
+{
+  os << "[";
+  for (size_t i = 0; i < events.size(); ++i) {
+    const auto & event = events.at(i);
+    os << (i == 0 ? "\n" : ",\n") << R"({"name":")" << event.name
+       << R"(","cat":"autoware","ph":"X","pid":0,"tid":)" << event.thread_id
+       << R"(,"ts":)" << toMicroseconds(event.start_ns) << R"(,"dur":)"
+       << toMicroseconds(event.end_ns - event.start_ns)
+       << R"(,"args":{"correlation_id":")" << event.correlation_id
+       << R"(","depth":)" << event.depth << "}}";
+  }
+  os << "\n]\n";
+}
+
+std::map<std::string, double> Tracer::toProcessingTimeMap(const std::vector<TraceEvent> & events)
+{
+  std::map<std::string, double> processing_time_map;
+  for (const auto & event : events) {
+    processing_time_map[event.name] += static_cast<double>(event.end_ns - event.start_ns) * 1e-6;
+  }
+  return processing_time_map;
+}
+
+TraceSpan::TraceSpan(const char * name, const uint64_t correlation_id)
+: is_enabled_(Tracer::getInstance().isEnabled()), name_(name)
+{
+  if (!is_enabled_) {
+    return;
+  }
+
+  parent_correlation_id_ = current_correlation_id;
+  correlation_id_ = correlation_id != 0 ? correlation_id : current_correlation_id;
+  current_correlation_id = correlation_id_;
+  depth_ = current_depth++;
+  start_ns_ = nowNanoseconds();
+}
+
+TraceSpan::~TraceSpan()
+{
+  if (!is_enabled_) {
+    return;
+  }
+
+  TraceEvent event;
+  event.name = name_;
+  event.correlation_id = correlation_id_;
+  event.start_ns = start_ns_;
+  event.end_ns = nowNanoseconds();
+  event.depth = depth_;
+  Tracer::getInstance().record(event);
+
+  --current_depth;
+  current_correlation_id = parent_correlation_id_;
+}
+}  // namespace tier4_autoware_utils
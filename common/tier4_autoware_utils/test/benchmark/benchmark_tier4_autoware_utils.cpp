@@ -0,0 +1,164 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/geometry/batch_geometry.hpp"
+#include "tier4_autoware_utils/geometry/geometry.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+using tier4_autoware_utils::createPoint;
+using tier4_autoware_utils::createQuaternionFromYaw;
+
+// poses along a gently curved path at intervals of 1
+std::vector<geometry_msgs::msg::Pose> generatePoses(const size_t num_points)
+{
+  constexpr double delta_theta = 0.001;
+
+  std::vector<geometry_msgs::msg::Pose> poses(num_points);
+  for (size_t i = 0; i < num_points; ++i) {
+    const double theta = i * delta_theta;
+    poses.at(i).position = createPoint(i * std::cos(theta), i * std::sin(theta), 0.0);
+    poses.at(i).orientation = createQuaternionFromYaw(theta);
+  }
+  return poses;
+}
+
+geometry_msgs::msg::Pose getQueryPose(const std::vector<geometry_msgs::msg::Pose> & poses)
+{
+  auto pose = poses.at(poses.size() / 2);
+  pose.position.y += 0.5;
+  return pose;
+}
+
+void BM_calcDistance2d(benchmark::State & state)
+{
+  const auto poses = generatePoses(state.range(0));
+  const auto point = getQueryPose(poses).position;
+  std::vector<double> distances(poses.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < poses.size(); ++i) {
+      distances[i] = tier4_autoware_utils::calcDistance2d(point, poses[i]);
+    }
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_calcDistance2dBatch(benchmark::State & state)
+{
+  const auto poses = generatePoses(state.range(0));
+  const auto points = tier4_autoware_utils::toPointArray2d(poses);
+  const auto point = getQueryPose(poses).position;
+  std::vector<double> distances;
+  for (auto _ : state) {
+    tier4_autoware_utils::calcDistance2d(point, points, distances);
+    benchmark::DoNotOptimize(distances.data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_findNearestIndexBatch(benchmark::State & state)
+{
+  const auto poses = generatePoses(state.range(0));
+  const auto points = tier4_autoware_utils::toPointArray2d(poses);
+  const auto point = getQueryPose(poses).position;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tier4_autoware_utils::findNearestIndex(points, point));
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_transformPoint(benchmark::State & state)
+{
+  const auto poses = generatePoses(state.range(0));
+  const auto pose = getQueryPose(poses);
+  std::vector<geometry_msgs::msg::Point> transformed_points(poses.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < poses.size(); ++i) {
+      transformed_points[i] = tier4_autoware_utils::transformPoint(poses[i].position, pose);
+    }
+    benchmark::DoNotOptimize(transformed_points.data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_transformPoints2dBatch(benchmark::State & state)
+{
+  const auto poses = generatePoses(state.range(0));
+  const auto pose = getQueryPose(poses);
+  const auto points = tier4_autoware_utils::toPointArray2d(poses);
+  tier4_autoware_utils::PointArray2d transformed_points;
+  for (auto _ : state) {
+    tier4_autoware_utils::transformPoints2d(pose, points, transformed_points);
+    benchmark::DoNotOptimize(transformed_points.x.data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_calcCurvature(benchmark::State & state)
+{
+  const auto poses = generatePoses(state.range(0));
+  std::vector<double> curvatures(poses.size() - 2);
+  for (auto _ : state) {
+    for (size_t i = 1; i + 1 < poses.size(); ++i) {
+      curvatures[i - 1] = tier4_autoware_utils::calcCurvature(
+        poses[i - 1].position, poses[i].position, poses[i + 1].position);
+    }
+    benchmark::DoNotOptimize(curvatures.data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_calcOffsetPose(benchmark::State & state)
+{
+  const auto poses = generatePoses(state.range(0));
+  std::vector<geometry_msgs::msg::Pose> offset_poses(poses.size());
+  for (auto _ : state) {
+    for (size_t i = 0; i < poses.size(); ++i) {
+      offset_poses[i] = tier4_autoware_utils::calcOffsetPose(poses[i], 1.0, 0.5, 0.0);
+    }
+    benchmark::DoNotOptimize(offset_poses.data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+
+void BM_calcInterpolatedPose(benchmark::State & state)
+{
+  const auto poses = generatePoses(state.range(0));
+  std::vector<geometry_msgs::msg::Pose> interpolated_poses(poses.size() - 1);
+  for (auto _ : state) {
+    for (size_t i = 0; i + 1 < poses.size(); ++i) {
+      interpolated_poses[i] =
+        tier4_autoware_utils::calcInterpolatedPose(poses[i], poses[i + 1], 0.5);
+    }
+    benchmark::DoNotOptimize(interpolated_poses.data());
+  }
+  state.SetComplexityN(state.range(0));
+}
+}  // namespace
+
+// from a short path to a long route-length trajectory
+BENCHMARK(BM_calcDistance2d)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_calcDistance2dBatch)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_findNearestIndexBatch)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_transformPoint)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_transformPoints2dBatch)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_calcCurvature)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_calcOffsetPose)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
+BENCHMARK(BM_calcInterpolatedPose)->RangeMultiplier(10)->Range(10, 10000)->Complexity();
@@ -0,0 +1,113 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/geometry/batch_geometry.hpp"
+#include "tier4_autoware_utils/geometry/geometry.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+using tier4_autoware_utils::createPoint;
+using tier4_autoware_utils::PointArray2d;
+
+constexpr double epsilon = 1e-9;
+
+// points on a spiral, whose number is not a multiple of the SIMD width
+std::vector<geometry_msgs::msg::Point> createTestPoints(const size_t num)
+{
+  std::vector<geometry_msgs::msg::Point> points;
+  for (size_t i = 0; i < num; ++i) {
+    const double r = 0.5 * static_cast<double>(i);
+    const double theta = 0.3 * static_cast<double>(i);
+    points.push_back(createPoint(r * std::cos(theta), r * std::sin(theta), 0.0));
+  }
+  return points;
+}
+}  // namespace
+
+TEST(batch_geometry, calcDistance2d)
+{
+  const auto points = createTestPoints(103);
+  const auto point_array = tier4_autoware_utils::toPointArray2d(points);
+  const auto p = createPoint(1.5, -2.0, 3.0);
+
+  std::vector<double> squared_distances;
+  tier4_autoware_utils::calcSquaredDistance2d(p, point_array, squared_distances);
+  std::vector<double> distances;
+  tier4_autoware_utils::calcDistance2d(p, point_array, distances);
+  std::vector<double> angles;
+  tier4_autoware_utils::calcAzimuthAngle(p, point_array, angles);
+
+  ASSERT_EQ(squared_distances.size(), points.size());
+  ASSERT_EQ(distances.size(), points.size());
+  ASSERT_EQ(angles.size(), points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_NEAR(
+      squared_distances.at(i), tier4_autoware_utils::calcSquaredDistance2d(p, points.at(i)),
+      epsilon);
+    EXPECT_NEAR(distances.at(i), tier4_autoware_utils::calcDistance2d(p, points.at(i)), epsilon);
+    EXPECT_NEAR(angles.at(i), tier4_autoware_utils::calcAzimuthAngle(p, points.at(i)), epsilon);
+  }
+
+  // Empty
+  tier4_autoware_utils::calcDistance2d(p, PointArray2d{}, distances);
+  EXPECT_TRUE(distances.empty());
+}
+
+TEST(batch_geometry, findNearestIndex)
+{
+  using tier4_autoware_utils::findNearestIndex;
+
+  const auto points = createTestPoints(203);
+  const auto point_array = tier4_autoware_utils::toPointArray2d(points);
+
+  EXPECT_THROW(findNearestIndex(PointArray2d{}, createPoint(0.0, 0.0, 0.0)), std::invalid_argument);
+  EXPECT_EQ(findNearestIndex(point_array, createPoint(0.0, 0.0, 0.0)), 0U);
+  for (const size_t idx : {1U, 63U, 64U, 65U, 150U, 202U}) {
+    const auto p = points.at(idx);
+    EXPECT_EQ(findNearestIndex(point_array, createPoint(p.x + 0.01, p.y - 0.01, 0.0)), idx);
+  }
+
+  // The first of ties
+  PointArray2d tie_points;
+  tie_points.x = {1.0, 0.0, -1.0, 0.0, 1.0};
+  tie_points.y = {0.0, 1.0, 0.0, -1.0, 0.0};
+  EXPECT_EQ(findNearestIndex(tie_points, createPoint(0.0, 0.0, 0.0)), 0U);
+}
+
+TEST(batch_geometry, transformPoints2d)
+{
+  const auto points = createTestPoints(11);
+  const auto point_array = tier4_autoware_utils::toPointArray2d(points);
+
+  geometry_msgs::msg::Pose pose;
+  pose.position = createPoint(3.0, -4.0, 1.0);
+  pose.orientation = tier4_autoware_utils::createQuaternionFromYaw(0.7);
+
+  PointArray2d transformed_points;
+  tier4_autoware_utils::transformPoints2d(pose, point_array, transformed_points);
+
+  ASSERT_EQ(transformed_points.size(), points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto expected =
+      tier4_autoware_utils::calcOffsetPose(pose, points.at(i).x, points.at(i).y, 0.0);
+    EXPECT_NEAR(transformed_points.x.at(i), expected.position.x, epsilon);
+    EXPECT_NEAR(transformed_points.y.at(i), expected.position.y, epsilon);
+  }
+}
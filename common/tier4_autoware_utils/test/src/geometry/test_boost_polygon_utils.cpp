@@ -259,3 +259,52 @@ TEST(boost_geometry, boost_getArea)
     EXPECT_DOUBLE_EQ(anti_clock_wise_area, x * y);
   }
 }
+
+TEST(boost_geometry, boost_toBoxedPolygon2d)
+{
+  using tier4_autoware_utils::toBoxedPolygon2d;
+
+  // anti clock wise and open
+  const Polygon2d polygon{{{0.0, 0.0}, {2.0, 0.0}, {2.0, 1.0}, {0.0, 1.0}}};
+  const auto boxed_polygon = toBoxedPolygon2d(polygon);
+
+  EXPECT_EQ(boxed_polygon.polygon.outer().size(), 5U);
+  EXPECT_TRUE(tier4_autoware_utils::isClockwise(boxed_polygon.polygon));
+  EXPECT_DOUBLE_EQ(boxed_polygon.box.min_corner().x(), 0.0);
+  EXPECT_DOUBLE_EQ(boxed_polygon.box.min_corner().y(), 0.0);
+  EXPECT_DOUBLE_EQ(boxed_polygon.box.max_corner().x(), 2.0);
+  EXPECT_DOUBLE_EQ(boxed_polygon.box.max_corner().y(), 1.0);
+}
+
+TEST(boost_geometry, boost_withinBoxedPolygon2d)
+{
+  using tier4_autoware_utils::Point2d;
+  using tier4_autoware_utils::toBoxedPolygon2d;
+  using tier4_autoware_utils::within;
+
+  // triangle, whose box contains the points out of it as well
+  const auto polygon = toBoxedPolygon2d(Polygon2d{{{0.0, 0.0}, {2.0, 0.0}, {0.0, 2.0}}});
+
+  EXPECT_TRUE(within(Point2d(0.5, 0.5), polygon));
+  EXPECT_FALSE(within(Point2d(1.5, 1.5), polygon));
+  EXPECT_FALSE(within(Point2d(3.0, 0.5), polygon));
+  EXPECT_FALSE(within(Point2d(-1.0, -1.0), polygon));
+}
+
+TEST(boost_geometry, boost_intersectsBoxedPolygon2d)
+{
+  using tier4_autoware_utils::intersects;
+  using tier4_autoware_utils::toBoxedPolygon2d;
+
+  const auto polygon = toBoxedPolygon2d(Polygon2d{{{0.0, 0.0}, {2.0, 0.0}, {0.0, 2.0}}});
+
+  // overlapping
+  EXPECT_TRUE(intersects(
+    polygon, toBoxedPolygon2d(Polygon2d{{{0.5, 0.5}, {3.0, 0.5}, {3.0, 3.0}, {0.5, 3.0}}})));
+  // the boxes overlap but the polygons do not
+  EXPECT_FALSE(intersects(
+    polygon, toBoxedPolygon2d(Polygon2d{{{1.5, 1.5}, {3.0, 1.5}, {3.0, 3.0}, {1.5, 3.0}}})));
+  // the boxes do not overlap
+  EXPECT_FALSE(intersects(
+    polygon, toBoxedPolygon2d(Polygon2d{{{3.0, 3.0}, {4.0, 3.0}, {4.0, 4.0}, {3.0, 4.0}}})));
+}
@@ -0,0 +1,104 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/geometry/polar_grid.hpp"
+#include "tier4_autoware_utils/math/unit_conversion.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+TEST(geometry, polar_grid)
+{
+  using tier4_autoware_utils::deg2rad;
+  using tier4_autoware_utils::PolarGrid;
+
+  // 4 angle bins of 90 degrees from -180 degrees, 2 range bins of 5 m
+  const std::vector<std::pair<float, float>> points = {
+    {3.0f, 1.0f}, {1.0f, 0.5f}, {-1.0f, -1.0f}, {20.0f, 0.0f}, {-0.5f, 2.0f}, {-1.0f, 0.0f}};
+  const auto get_xy = [&points](const size_t i) { return points.at(i); };
+
+  PolarGrid grid;
+  grid.initialize(-deg2rad(180.0), deg2rad(90.0), 4U, 5.0f, 2U);
+  grid.bin(points.size(), get_xy);
+
+  ASSERT_EQ(grid.size(), points.size());
+  EXPECT_EQ(grid.angleBinNum(), 4U);
+  EXPECT_EQ(grid.rangeBinNum(), 2U);
+
+  // (-1, 0) is at 180 degrees, which wraps around to the first bin
+  EXPECT_EQ(grid.angleBinBegin(0), 0U);
+  EXPECT_EQ(grid.angleBinEnd(0), 2U);
+  EXPECT_EQ(grid.index(0), 2U);
+  EXPECT_EQ(grid.index(1), 5U);
+  EXPECT_FLOAT_EQ(grid.angle(1), -static_cast<float>(deg2rad(180.0)));
+  EXPECT_EQ(grid.angleBinBegin(1), grid.angleBinEnd(1));
+
+  // the counting sort keeps the input order in a cell
+  EXPECT_EQ(grid.cellBegin(2, 0), 2U);
+  EXPECT_EQ(grid.cellEnd(2, 0), 4U);
+  EXPECT_EQ(grid.index(2), 0U);
+  EXPECT_EQ(grid.index(3), 1U);
+  EXPECT_EQ(grid.cellEnd(2, 1), 5U);
+  EXPECT_EQ(grid.index(4), 3U);
+  EXPECT_FLOAT_EQ(grid.range(4), 20.0f);
+  EXPECT_EQ(grid.pointCell(3), 2U * 2U + 1U);
+
+  EXPECT_EQ(grid.angleBinBegin(3), 5U);
+  EXPECT_EQ(grid.angleBinEnd(3), 6U);
+  EXPECT_EQ(grid.index(5), 4U);
+
+  grid.sortByRange();
+  EXPECT_EQ(grid.index(2), 1U);
+  EXPECT_EQ(grid.index(3), 0U);
+  EXPECT_EQ(grid.index(4), 3U);
+  EXPECT_FLOAT_EQ(grid.range(2), std::hypot(1.0f, 0.5f));
+}
+
+TEST(geometry, polar_grid_sort_cells)
+{
+  using tier4_autoware_utils::deg2rad;
+  using tier4_autoware_utils::PolarGrid;
+
+  // polar coordinates given as they are, with angles out of [0, 2 pi) wrapped by one turn
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> range_distribution(0.0f, 50.0f);
+  std::uniform_real_distribution<float> angle_distribution(-3.0f, 9.0f);
+  std::vector<std::pair<float, float>> points(2000);
+  for (auto & point : points) {
+    point = {range_distribution(engine), angle_distribution(engine)};
+  }
+
+  PolarGrid grid;
+  grid.initialize(0.0f, deg2rad(10.0), 36U, 0.5f, 80U);
+  grid.binPolar(points.size(), [&points](const size_t i) { return points.at(i); });
+  ASSERT_EQ(grid.size(), points.size());
+
+  for (size_t i = 0; i < grid.angleBinNum(); ++i) {
+    grid.sortCellsByRange(i);
+    for (size_t k = grid.angleBinBegin(i); k < grid.angleBinEnd(i); ++k) {
+      const auto & point = points.at(grid.index(k));
+      EXPECT_FLOAT_EQ(grid.range(k), point.first);
+      EXPECT_GE(grid.angle(k), static_cast<float>(deg2rad(10.0) * i) - 1e-5f);
+      EXPECT_LT(grid.angle(k), static_cast<float>(deg2rad(10.0) * (i + 1)) + 1e-5f);
+      if (k > grid.angleBinBegin(i)) {
+        EXPECT_LE(grid.range(k - 1), grid.range(k));
+      }
+    }
+  }
+}
@@ -0,0 +1,46 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/geometry/polygon_cache.hpp"
+
+#include <gtest/gtest.h>
+
+using tier4_autoware_utils::Polygon2d;
+using tier4_autoware_utils::PolygonCache;
+
+TEST(polygon_cache, find)
+{
+  PolygonCache cache;
+  EXPECT_EQ(cache.find(1), nullptr);
+
+  cache.add(1, Polygon2d{{{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}}});
+  cache.add(2, Polygon2d{{{2.0, 0.0}, {4.0, 0.0}, {4.0, 1.0}, {2.0, 1.0}}});
+  EXPECT_EQ(cache.size(), 2U);
+  EXPECT_EQ(cache.find(3), nullptr);
+
+  const auto polygon = cache.find(2);
+  ASSERT_NE(polygon, nullptr);
+  EXPECT_DOUBLE_EQ(polygon->box.min_corner().x(), 2.0);
+  EXPECT_DOUBLE_EQ(polygon->box.max_corner().x(), 4.0);
+  EXPECT_TRUE(tier4_autoware_utils::within(tier4_autoware_utils::Point2d(3.0, 0.5), *polygon));
+
+  // replaced
+  cache.add(2, Polygon2d{{{5.0, 0.0}, {6.0, 0.0}, {6.0, 1.0}, {5.0, 1.0}}});
+  EXPECT_EQ(cache.size(), 2U);
+  EXPECT_DOUBLE_EQ(cache.find(2)->box.min_corner().x(), 5.0);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0U);
+  EXPECT_EQ(cache.find(1), nullptr);
+}
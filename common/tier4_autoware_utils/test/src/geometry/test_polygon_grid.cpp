@@ -0,0 +1,62 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/geometry/polygon_grid.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using tier4_autoware_utils::BoxedPolygon2d;
+using tier4_autoware_utils::Point2d;
+using tier4_autoware_utils::Polygon2d;
+using tier4_autoware_utils::PolygonGrid;
+using tier4_autoware_utils::toBoxedPolygon2d;
+
+TEST(polygon_grid, withinAny)
+{
+  std::vector<BoxedPolygon2d> polygons;
+  polygons.push_back(
+    toBoxedPolygon2d(Polygon2d{{{0.0, 0.0}, {10.0, 0.0}, {10.0, 3.0}, {0.0, 3.0}}}));
+  polygons.push_back(toBoxedPolygon2d(Polygon2d{{{10.0, 0.0}, {15.0, 5.0}, {12.0, 8.0}}}));
+  // with a hole
+  Polygon2d polygon{{{-10.0, -10.0}, {-10.0, -2.0}, {-2.0, -2.0}, {-2.0, -10.0}}};
+  polygon.inners().push_back({{-8.0, -8.0}, {-4.0, -8.0}, {-4.0, -4.0}, {-8.0, -4.0}});
+  polygons.push_back(toBoxedPolygon2d(polygon));
+
+  for (const double resolution : {0.3, 1.0, 4.0}) {
+    const PolygonGrid grid(polygons, resolution);
+
+    // the same as within() of any polygon, including the points on the edges and the cells
+    for (double x = -12.0; x <= 17.0; x += 0.1) {
+      for (double y = -12.0; y <= 10.0; y += 0.1) {
+        const Point2d point(x, y);
+        bool is_within = false;
+        for (const auto & p : polygons) {
+          is_within |= tier4_autoware_utils::within(point, p);
+        }
+        EXPECT_EQ(grid.withinAny(point), is_within) << x << ", " << y;
+      }
+    }
+
+    EXPECT_TRUE(grid.withinAny(Point2d(5.0, 1.5)));
+    EXPECT_FALSE(grid.withinAny(Point2d(5.0, 3.0)));
+    EXPECT_FALSE(grid.withinAny(Point2d(-6.0, -6.0)));
+    EXPECT_TRUE(grid.withinAny(Point2d(-9.0, -9.0)));
+    EXPECT_FALSE(grid.withinAny(Point2d(100.0, 100.0)));
+  }
+
+  EXPECT_THROW(PolygonGrid(polygons, 0.0), std::invalid_argument);
+}
@@ -0,0 +1,93 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/ros/transform_cache.hpp"
+
+#include <rclcpp/clock.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+
+using tier4_autoware_utils::StaticTransformCache;
+using tier4_autoware_utils::TransformRingBuffer;
+
+namespace
+{
+geometry_msgs::msg::TransformStamped createTransform(
+  const std::string & parent_frame, const std::string & child_frame, const int64_t stamp_ns,
+  const double x, const double yaw)
+{
+  geometry_msgs::msg::TransformStamped transform;
+  transform.header.stamp = rclcpp::Time(stamp_ns);
+  transform.header.frame_id = parent_frame;
+  transform.child_frame_id = child_frame;
+  transform.transform.translation.x = x;
+  transform.transform.rotation.z = std::sin(yaw / 2.0);
+  transform.transform.rotation.w = std::cos(yaw / 2.0);
+  return transform;
+}
+}  // namespace
+
+TEST(ros, StaticTransformCache)
+{
+  tf2_ros::Buffer tf_buffer(std::make_shared<rclcpp::Clock>(RCL_ROS_TIME));
+  StaticTransformCache cache(tf_buffer);
+
+  // not published yet
+  EXPECT_EQ(cache.getTransform("base_link", "lidar"), nullptr);
+
+  tf_buffer.setTransform(createTransform("base_link", "lidar", 0, 1.5, 0.0), "test", true);
+  tf_buffer.setTransform(createTransform("map", "base_link", 1000, 10.0, 0.0), "test", false);
+
+  const auto transform = cache.getTransform("base_link", "lidar");
+  ASSERT_NE(transform, nullptr);
+  EXPECT_DOUBLE_EQ(transform->transform.translation.x, 1.5);
+
+  // served from the cache even after the buffer changes
+  tf_buffer.setTransform(createTransform("base_link", "lidar", 0, 2.5, 0.0), "test", true);
+  EXPECT_EQ(cache.getTransform("base_link", "lidar"), transform);
+
+  // linked by a dynamic transform
+  EXPECT_EQ(cache.getTransform("map", "lidar"), nullptr);
+  EXPECT_EQ(cache.getTransform("map", "lidar"), nullptr);
+}
+
+TEST(ros, TransformRingBuffer)
+{
+  TransformRingBuffer ring_buffer(4);
+  geometry_msgs::msg::Transform transform;
+
+  EXPECT_FALSE(ring_buffer.lookup(rclcpp::Time(0), transform));
+
+  for (int64_t i = 0; i < 6; ++i) {
+    ring_buffer.push(createTransform("map", "base_link", i * 100, i * 1.0, i * 0.1));
+  }
+
+  // the oldest samples are overwritten
+  EXPECT_FALSE(ring_buffer.lookup(rclcpp::Time(100), transform));
+  EXPECT_FALSE(ring_buffer.lookup(rclcpp::Time(600), transform));
+
+  ASSERT_TRUE(ring_buffer.lookup(rclcpp::Time(500), transform));
+  EXPECT_DOUBLE_EQ(transform.translation.x, 5.0);
+
+  ASSERT_TRUE(ring_buffer.lookup(rclcpp::Time(200), transform));
+  EXPECT_DOUBLE_EQ(transform.translation.x, 2.0);
+
+  ASSERT_TRUE(ring_buffer.lookup(rclcpp::Time(325), transform));
+  EXPECT_NEAR(transform.translation.x, 3.25, 1e-9);
+  EXPECT_NEAR(2.0 * std::atan2(transform.rotation.z, transform.rotation.w), 0.325, 1e-9);
+}
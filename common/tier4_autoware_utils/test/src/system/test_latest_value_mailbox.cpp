@@ -0,0 +1,75 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/system/latest_value_mailbox.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+using tier4_autoware_utils::LatestValueMailbox;
+
+namespace
+{
+struct Value
+{
+  int32_t a{0};
+  double b{0.0};
+  uint8_t c{0};
+};
+}  // namespace
+
+TEST(system, LatestValueMailbox_read_write)
+{
+  LatestValueMailbox<Value> mailbox;
+  EXPECT_FALSE(mailbox.hasValue());
+  EXPECT_EQ(mailbox.read().a, 0);
+
+  mailbox.write(Value{1, 2.0, 3});
+  EXPECT_TRUE(mailbox.hasValue());
+  const auto value = mailbox.read();
+  EXPECT_EQ(value.a, 1);
+  EXPECT_DOUBLE_EQ(value.b, 2.0);
+  EXPECT_EQ(value.c, 3U);
+
+  LatestValueMailbox<Value> initialized(Value{4, 5.0, 6});
+  EXPECT_TRUE(initialized.hasValue());
+  EXPECT_EQ(initialized.read().a, 4);
+}
+
+TEST(system, LatestValueMailbox_concurrent)
+{
+  // a consistent value has all the members from the same write
+  LatestValueMailbox<Value> mailbox(Value{0, 0.0, 0});
+  std::atomic<bool> is_running{true};
+  std::thread writer([&]() {
+    for (int32_t i = 1; i <= 100000; ++i) {
+      mailbox.write(Value{i, static_cast<double>(i), static_cast<uint8_t>(i % 256)});
+    }
+    is_running = false;
+  });
+
+  int32_t prev = 0;
+  while (is_running) {
+    const auto value = mailbox.read();
+    ASSERT_EQ(static_cast<double>(value.a), value.b);
+    ASSERT_EQ(static_cast<uint8_t>(value.a % 256), value.c);
+    ASSERT_GE(value.a, prev);
+    prev = value.a;
+  }
+  writer.join();
+  EXPECT_EQ(mailbox.read().a, 100000);
+}
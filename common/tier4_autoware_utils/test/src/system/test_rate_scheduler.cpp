@@ -0,0 +1,64 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/system/rate_scheduler.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(system, RateScheduler_complexity)
+{
+  using tier4_autoware_utils::RateScheduler;
+
+  RateScheduler scheduler(5.0, 10.0);
+  EXPECT_DOUBLE_EQ(scheduler.getRate(), 10.0);
+
+  // an empty scene is planned at the lowest rate
+  EXPECT_TRUE(scheduler.update(0.01, 0.0));
+  EXPECT_DOUBLE_EQ(scheduler.getRate(), 5.0);
+
+  // a small change is held back by the hysteresis
+  EXPECT_FALSE(scheduler.update(0.01, 0.05));
+  EXPECT_DOUBLE_EQ(scheduler.getRate(), 5.0);
+
+  EXPECT_TRUE(scheduler.update(0.01, 0.5));
+  EXPECT_DOUBLE_EQ(scheduler.getRate(), 7.5);
+
+  EXPECT_TRUE(scheduler.update(0.01, 1.0));
+  EXPECT_DOUBLE_EQ(scheduler.getRate(), 10.0);
+
+  // out of [0, 1]
+  EXPECT_FALSE(scheduler.update(0.01, 2.0));
+  EXPECT_DOUBLE_EQ(scheduler.getRate(), 10.0);
+}
+
+TEST(system, RateScheduler_load)
+{
+  using tier4_autoware_utils::RateScheduler;
+
+  RateScheduler scheduler(5.0, 10.0, 0.8, 0.1, 0.5);
+
+  // a cycle taking all the period lowers the rate at once
+  EXPECT_TRUE(scheduler.update(0.1, 1.0));
+  EXPECT_DOUBLE_EQ(scheduler.getRate(), 8.0);
+
+  // not below the lowest rate even if it overruns
+  EXPECT_TRUE(scheduler.update(0.5, 1.0));
+  EXPECT_DOUBLE_EQ(scheduler.getRate(), 5.0);
+
+  // the processing time decays slowly after a fast cycle
+  EXPECT_FALSE(scheduler.update(0.01, 1.0));
+  EXPECT_DOUBLE_EQ(scheduler.getRate(), 5.0);
+  EXPECT_TRUE(scheduler.update(0.01, 1.0));
+  EXPECT_NEAR(scheduler.getRate(), 0.8 / 0.1325, 1e-9);
+}
@@ -0,0 +1,106 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tier4_autoware_utils/system/tracer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using tier4_autoware_utils::TraceSpan;
+using tier4_autoware_utils::Tracer;
+
+TEST(system, Tracer_span)
+{
+  auto & tracer = Tracer::getInstance();
+  tracer.collect();
+
+  // disabled
+  {
+    TraceSpan span("disabled");
+  }
+  EXPECT_TRUE(tracer.collect().empty());
+
+  tracer.setEnabled(true);
+  builtin_interfaces::msg::Time stamp;
+  stamp.sec = 1;
+  stamp.nanosec = 2;
+  {
+    TraceSpan outer("outer", stamp);
+    {
+      TraceSpan inner("inner");
+    }
+    TraceSpan other("other", 3);
+  }
+  tracer.setEnabled(false);
+
+  const auto events = tracer.collect();
+  ASSERT_EQ(events.size(), 3U);
+  EXPECT_STREQ(events.at(0).name, "outer");
+  EXPECT_EQ(events.at(0).correlation_id, 1000000002U);
+  EXPECT_EQ(events.at(0).depth, 0U);
+  EXPECT_STREQ(events.at(1).name, "inner");
+  EXPECT_EQ(events.at(1).correlation_id, 1000000002U);
+  EXPECT_EQ(events.at(1).depth, 1U);
+  EXPECT_STREQ(events.at(2).name, "other");
+  EXPECT_EQ(events.at(2).correlation_id, 3U);
+  EXPECT_EQ(events.at(2).depth, 1U);
+  EXPECT_LE(events.at(0).start_ns, events.at(1).start_ns);
+  EXPECT_LE(events.at(1).end_ns, events.at(0).end_ns);
+
+  // collected once
+  EXPECT_TRUE(tracer.collect().empty());
+
+  const auto processing_time_map = Tracer::toProcessingTimeMap(events);
+  EXPECT_EQ(processing_time_map.size(), 3U);
+  EXPECT_GE(processing_time_map.at("outer"), processing_time_map.at("inner"));
+
+  std::ostringstream os;
+  Tracer::writeChromeTrace(os, events);
+  EXPECT_EQ(os.str().front(), '[');
+  EXPECT_NE(os.str().find(R"("name":"inner")"), std::string::npos);
+  EXPECT_NE(os.str().find(R"("correlation_id":"1000000002")"), std::string::npos);
+}
+
+TEST(system, Tracer_threads)
+{
+  auto & tracer = Tracer::getInstance();
+  tracer.collect();
+  tracer.setBufferCapacity(16);
+  tracer.setEnabled(true);
+
+  // the buffer of each thread keeps its latest events
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([]() {
+      for (int j = 0; j < 100; ++j) {
+        TraceSpan span("thread");
+      }
+    });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  tracer.setEnabled(false);
+  tracer.setBufferCapacity(4096);
+
+  const auto events = tracer.collect();
+  EXPECT_EQ(events.size(), 4U * 16U);
+  for (size_t i = 1; i < events.size(); ++i) {
+    EXPECT_LE(events.at(i - 1).start_ns, events.at(i).start_ns);
+  }
+}
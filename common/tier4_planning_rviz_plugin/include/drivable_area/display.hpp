@@ -162,9 +162,23 @@ protected:  // NOLINT for Qt
     int number_swatches);
   static size_t getEffectiveDimension(
     size_t map_dimension, size_t swatch_dimension, size_t position);
-  void updateSwatches() const;
+  /** @brief Region of the map covered by a swatch, in pixels. */
+  struct SwatchRegion
+  {
+    size_t x;
+    size_t y;
+    size_t width;
+    size_t height;
+  };
+
+  /** @brief Whether the pixels of the region differ from the ones uploaded last. */
+  [[nodiscard]] bool isSwatchChanged(const SwatchRegion & region) const;
+  /** @brief Upload the pixels of the swatches which are changed since the last upload. */
+  void updateSwatches();
 
   std::vector<std::shared_ptr<Swatch>> swatches_;
+  std::vector<SwatchRegion> swatch_regions_;
+  std::vector<int8_t> uploaded_map_data_;
   std::vector<Ogre::TexturePtr> palette_textures_;
   std::vector<bool> color_scheme_transparency_;
   bool loaded_;
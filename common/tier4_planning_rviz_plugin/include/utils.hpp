@@ -19,12 +19,31 @@
 #include <tier4_autoware_utils/geometry/path_with_lane_id_geometry.hpp>
 #include <tier4_autoware_utils/math/normalization.hpp>
 
+#include <OgreManualObject.h>
 #include <tf2/utils.h>
 
+#include <string>
+
 namespace rviz_plugins
 {
+/**
+ * @brief begin the section of manual_object for a new message. The section built for the previous
+ * message is updated instead of being cleared, so that its vertex buffer is reused while the new
+ * vertices fit in it.
+ */
+inline void beginManualObject(
+  Ogre::ManualObject * manual_object, const std::string & material_name,
+  const Ogre::RenderOperation::OperationType operation_type)
+{
+  if (manual_object->getNumSections() > 0) {
+    manual_object->beginUpdate(0);
+  } else {
+    manual_object->begin(material_name, operation_type);
+  }
+}
+
 template <class T>
-bool isDrivingForward(const T points_with_twist, size_t target_idx)
+bool isDrivingForward(const T & points_with_twist, size_t target_idx)
 {
   constexpr double epsilon = 1e-6;
 
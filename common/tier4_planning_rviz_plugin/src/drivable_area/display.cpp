@@ -294,6 +294,8 @@ void AutowareDrivableAreaDisplay::clear()
   }
 
   swatches_.clear();
+  swatch_regions_.clear();
+  uploaded_map_data_.clear();
   height_ = 0;
   width_ = 0;
   resolution_ = 0.0f;
@@ -374,11 +376,28 @@ void AutowareDrivableAreaDisplay::createSwatches()
   // pieces, however more than 8 swatches is probably unnecessary due to memory limitations
   const size_t maximum_number_swatch_splittings = 4;
 
+  // Split the map into swatches of up to max_swatch_cell_num pixels from the start, for only the
+  // swatches whose pixels are changed to be uploaded again. A swatch is not made narrower than
+  // min_swatch_dimension, which also keeps the number of swatches a power of 2 in each direction.
+  const size_t max_swatch_cell_num = 512 * 512;
+  const size_t min_swatch_dimension = 256;
+  while (swatch_width * swatch_height > max_swatch_cell_num) {
+    if (swatch_width > swatch_height && swatch_width / 2 >= min_swatch_dimension) {
+      swatch_width /= 2;
+    } else if (swatch_height / 2 >= min_swatch_dimension) {
+      swatch_height /= 2;
+    } else {
+      break;
+    }
+    number_swatches *= 2;
+  }
+
   for (size_t i = 0; i < maximum_number_swatch_splittings; ++i) {
     RVIZ_COMMON_LOG_INFO_STREAM(
       "Trying to create a map of size " << width << " x " << height << " using " << number_swatches
                                         << " swatches");
     swatches_.clear();
+    swatch_regions_.clear();
     try {
       tryCreateSwatches(width, height, resolution, swatch_width, swatch_height, number_swatches);
       updateDrawUnder();
@@ -395,6 +414,7 @@ void AutowareDrivableAreaDisplay::createSwatches()
                 << "failed. "
                    "This map is too large to be displayed by RViz.");
   swatches_.clear();
+  swatch_regions_.clear();
 }
 
 void AutowareDrivableAreaDisplay::doubleSwatchNumber(
@@ -425,6 +445,7 @@ void AutowareDrivableAreaDisplay::tryCreateSwatches(
     swatches_.push_back(std::make_shared<Swatch>(
       scene_manager_, scene_node_, x, y, effective_width, effective_height, resolution,
       draw_under_property_->getValue().toBool()));
+    swatch_regions_.push_back({x, y, effective_width, effective_height});
 
     swatches_[i]->updateData(current_map_);
 
@@ -527,15 +548,41 @@ void AutowareDrivableAreaDisplay::resetSwatchesIfNecessary(
 {
   if (width != width_ || height != height_ || resolution_ != resolution) {
     createSwatches();
+    uploaded_map_data_.clear();
     width_ = width;
     height_ = height;
     resolution_ = resolution;
   }
 }
 
-void AutowareDrivableAreaDisplay::updateSwatches() const
+bool AutowareDrivableAreaDisplay::isSwatchChanged(const SwatchRegion & region) const
 {
-  for (const auto & swatch : swatches_) {
+  if (uploaded_map_data_.size() != current_map_.data.size()) {
+    return true;
+  }
+
+  const size_t map_width = current_map_.info.width;
+  for (size_t y = region.y; y < region.y + region.height; ++y) {
+    const size_t row_begin = y * map_width + region.x;
+    if (!std::equal(
+          current_map_.data.begin() + row_begin,
+          current_map_.data.begin() + row_begin + region.width,
+          uploaded_map_data_.begin() + row_begin)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void AutowareDrivableAreaDisplay::updateSwatches()
+{
+  for (size_t i = 0; i < swatches_.size(); ++i) {
+    // the texture of the swatch is kept as long as its pixels are the same
+    if (!isSwatchChanged(swatch_regions_.at(i))) {
+      continue;
+    }
+
+    const auto & swatch = swatches_.at(i);
     swatch->updateData(current_map_);
 
     Ogre::Pass * pass = swatch->getTechniquePass();
@@ -551,6 +598,7 @@ void AutowareDrivableAreaDisplay::updateSwatches() const
     swatch->setVisible(true);
     swatch->resetOldTexture();
   }
+  uploaded_map_data_ = current_map_.data;
 }
 
 void AutowareDrivableAreaDisplay::updatePalette()
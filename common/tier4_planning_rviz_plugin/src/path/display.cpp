@@ -152,9 +152,6 @@ void AutowarePathDisplay::processMessage(
   scene_node_->setPosition(position);
   scene_node_->setOrientation(orientation);
 
-  path_manual_object_->clear();
-  velocity_manual_object_->clear();
-
   Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
     "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
   material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
@@ -163,9 +160,10 @@ void AutowarePathDisplay::processMessage(
   if (!msg_ptr->points.empty()) {
     path_manual_object_->estimateVertexCount(msg_ptr->points.size() * 2);
     velocity_manual_object_->estimateVertexCount(msg_ptr->points.size());
-    path_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_TRIANGLE_STRIP);
-    // path_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_TRIANGLE_STRIP);
-    velocity_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_STRIP);
+    beginManualObject(
+      path_manual_object_, "BaseWhiteNoLighting", Ogre::RenderOperation::OT_TRIANGLE_STRIP);
+    beginManualObject(
+      velocity_manual_object_, "BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_STRIP);
 
     for (size_t point_idx = 0; point_idx < msg_ptr->points.size(); point_idx++) {
       const auto & path_point = msg_ptr->points.at(point_idx);
@@ -239,6 +237,9 @@ void AutowarePathDisplay::processMessage(
 
     path_manual_object_->end();
     velocity_manual_object_->end();
+  } else {
+    path_manual_object_->clear();
+    velocity_manual_object_->clear();
   }
   last_msg_ptr_ = msg_ptr;
 }
@@ -18,6 +18,7 @@
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Geometry>
 #include <path_footprint/display.hpp>
+#include <utils.hpp>
 
 namespace rviz_plugins
 {
@@ -114,8 +115,6 @@ void AutowarePathFootprintDisplay::processMessage(
   scene_node_->setPosition(position);
   scene_node_->setOrientation(orientation);
 
-  path_footprint_manual_object_->clear();
-
   Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
     "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
   material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
@@ -123,8 +122,8 @@ void AutowarePathFootprintDisplay::processMessage(
 
   if (!msg_ptr->points.empty()) {
     path_footprint_manual_object_->estimateVertexCount(msg_ptr->points.size() * 4 * 2);
-    path_footprint_manual_object_->begin(
-      "BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_LIST);
+    beginManualObject(
+      path_footprint_manual_object_, "BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_LIST);
 
     for (size_t point_idx = 0; point_idx < msg_ptr->points.size(); point_idx++) {
       const auto & path_point = msg_ptr->points.at(point_idx);
@@ -173,6 +172,8 @@ void AutowarePathFootprintDisplay::processMessage(
     }
 
     path_footprint_manual_object_->end();
+  } else {
+    path_footprint_manual_object_->clear();
   }
   last_msg_ptr_ = msg_ptr;
 }
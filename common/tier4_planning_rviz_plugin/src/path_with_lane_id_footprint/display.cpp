@@ -18,6 +18,7 @@
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Geometry>
 #include <path_with_lane_id_footprint/display.hpp>
+#include <utils.hpp>
 
 namespace rviz_plugins
 {
@@ -147,8 +148,6 @@ void AutowarePathWithLaneIdFootprintDisplay::processMessage(
   scene_node_->setPosition(position);
   scene_node_->setOrientation(orientation);
 
-  path_footprint_manual_object_->clear();
-
   Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
     "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
   material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
@@ -156,8 +155,8 @@ void AutowarePathWithLaneIdFootprintDisplay::processMessage(
 
   if (!msg_ptr->points.empty()) {
     path_footprint_manual_object_->estimateVertexCount(msg_ptr->points.size() * 4 * 2);
-    path_footprint_manual_object_->begin(
-      "BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_LIST);
+    beginManualObject(
+      path_footprint_manual_object_, "BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_LIST);
 
     allocateLaneIdObjects(msg_ptr->points.size());
 
@@ -232,6 +231,8 @@ void AutowarePathWithLaneIdFootprintDisplay::processMessage(
     }
 
     path_footprint_manual_object_->end();
+  } else {
+    path_footprint_manual_object_->clear();
   }
   last_msg_ptr_ = msg_ptr;
 }
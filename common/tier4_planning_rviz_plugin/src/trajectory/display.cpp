@@ -170,9 +170,6 @@ void AutowareTrajectoryDisplay::processMessage(
   scene_node_->setPosition(position);
   scene_node_->setOrientation(orientation);
 
-  path_manual_object_->clear();
-  velocity_manual_object_->clear();
-
   Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
     "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
   material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
@@ -181,8 +178,10 @@ void AutowareTrajectoryDisplay::processMessage(
   if (!msg_ptr->points.empty()) {
     path_manual_object_->estimateVertexCount(msg_ptr->points.size() * 2);
     velocity_manual_object_->estimateVertexCount(msg_ptr->points.size());
-    path_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_TRIANGLE_STRIP);
-    velocity_manual_object_->begin("BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_STRIP);
+    beginManualObject(
+      path_manual_object_, "BaseWhiteNoLighting", Ogre::RenderOperation::OT_TRIANGLE_STRIP);
+    beginManualObject(
+      velocity_manual_object_, "BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_STRIP);
 
     if (msg_ptr->points.size() > velocity_texts_.size()) {
       for (size_t i = velocity_texts_.size(); i < msg_ptr->points.size(); i++) {
@@ -301,6 +300,9 @@ void AutowareTrajectoryDisplay::processMessage(
 
     path_manual_object_->end();
     velocity_manual_object_->end();
+  } else {
+    path_manual_object_->clear();
+    velocity_manual_object_->clear();
   }
   last_msg_ptr_ = msg_ptr;
 }
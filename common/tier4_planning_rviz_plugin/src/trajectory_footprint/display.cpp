@@ -18,6 +18,7 @@
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Geometry>
 #include <trajectory_footprint/display.hpp>
+#include <utils.hpp>
 
 #include <tf2/utils.h>
 
@@ -141,9 +142,6 @@ void AutowareTrajectoryFootprintDisplay::processMessage(
   scene_node_->setPosition(position);
   scene_node_->setOrientation(orientation);
 
-  trajectory_footprint_manual_object_->clear();
-  trajectory_point_manual_object_->clear();
-
   Ogre::MaterialPtr material = Ogre::MaterialManager::getSingleton().getByName(
     "BaseWhiteNoLighting", Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
   material->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
@@ -151,12 +149,14 @@ void AutowareTrajectoryFootprintDisplay::processMessage(
 
   if (!msg_ptr->points.empty()) {
     trajectory_footprint_manual_object_->estimateVertexCount(msg_ptr->points.size() * 4 * 2);
-    trajectory_footprint_manual_object_->begin(
-      "BaseWhiteNoLighting", Ogre::RenderOperation::OT_LINE_LIST);
+    beginManualObject(
+      trajectory_footprint_manual_object_, "BaseWhiteNoLighting",
+      Ogre::RenderOperation::OT_LINE_LIST);
 
     trajectory_point_manual_object_->estimateVertexCount(msg_ptr->points.size() * 3 * 8);
-    trajectory_point_manual_object_->begin(
-      "BaseWhiteNoLighting", Ogre::RenderOperation::OT_TRIANGLE_LIST);
+    beginManualObject(
+      trajectory_point_manual_object_, "BaseWhiteNoLighting",
+      Ogre::RenderOperation::OT_TRIANGLE_LIST);
 
     for (size_t point_idx = 0; point_idx < msg_ptr->points.size(); point_idx++) {
       const auto & path_point = msg_ptr->points.at(point_idx);
@@ -238,6 +238,9 @@ void AutowareTrajectoryFootprintDisplay::processMessage(
 
     trajectory_footprint_manual_object_->end();
     trajectory_point_manual_object_->end();
+  } else {
+    trajectory_footprint_manual_object_->clear();
+    trajectory_point_manual_object_->clear();
   }
   last_msg_ptr_ = msg_ptr;
 }
@@ -20,9 +20,16 @@
 #include <tvm_vendor/tvm/runtime/packed_func.h>
 #include <tvm_vendor/tvm/runtime/registry.h>
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -50,7 +57,7 @@ public:
     handle_ = std::make_shared<TVMArrayHandle>(x);
   }
 
-  TVMArrayHandle getArray() const { return *handle_.get(); }
+  TVMArrayHandle getArray() const { return handle_ ? *handle_ : nullptr; }
 
 private:
   std::shared_ptr<TVMArrayHandle> handle_{nullptr, [](TVMArrayHandle ptr) {
@@ -62,6 +69,38 @@ private:
 
 using TVMArrayContainerVector = std::vector<TVMArrayContainer>;
 
+/**
+ * @brief Copy the data of arrays into other arrays. The destination arrays are allocated only if
+ * their number, shapes or data types differ from the source arrays, so that they can be recycled.
+ *
+ * @param src The arrays to copy.
+ * @param dst The arrays to copy into.
+ */
+inline void copyTVMArrays(const TVMArrayContainerVector & src, TVMArrayContainerVector & dst)
+{
+  const auto is_same_layout = [](const DLTensor * lhs, const DLTensor * rhs) {
+    return lhs->ndim == rhs->ndim &&
+           std::equal(lhs->shape, lhs->shape + lhs->ndim, rhs->shape) &&
+           lhs->dtype.code == rhs->dtype.code && lhs->dtype.bits == rhs->dtype.bits &&
+           lhs->dtype.lanes == rhs->dtype.lanes;
+  };
+
+  dst.resize(src.size());
+  for (size_t index = 0; index < src.size(); ++index) {
+    const TVMArrayHandle src_array = src[index].getArray();
+    if (src_array == nullptr) {
+      throw std::runtime_error("source variable is null");
+    }
+    if (dst[index].getArray() == nullptr || !is_same_layout(src_array, dst[index].getArray())) {
+      dst[index] = TVMArrayContainer(
+        std::vector<int64_t>(src_array->shape, src_array->shape + src_array->ndim),
+        static_cast<DLDataTypeCode>(src_array->dtype.code), src_array->dtype.bits,
+        src_array->dtype.lanes, src_array->device.device_type, src_array->device.device_id);
+    }
+    TVMArrayCopyFromTo(src_array, dst[index].getArray(), nullptr);
+  }
+}
+
 /**
  * @class PipelineStage
  * @brief Base class for all types of pipeline stages.
@@ -171,6 +210,260 @@ private:
   PostProcessorType post_processor_{};
 };
 
+/**
+ * @class BoundedQueue
+ * @brief Thread safe FIFO queue with a fixed capacity, which blocks producers while it is full and
+ * consumers while it is empty, until it is closed.
+ *
+ * @tparam T The datatype of the elements.
+ */
+template <class T>
+class BoundedQueue
+{
+public:
+  explicit BoundedQueue(const size_t capacity) : capacity_(capacity)
+  {
+    if (capacity_ == 0) {
+      throw std::invalid_argument("queue capacity must be positive");
+    }
+  }
+
+  /**
+   * @brief Push an element, waiting while the queue is full.
+   *
+   * @param element The element to push.
+   * @return false if the queue is closed, in which case the element is dropped.
+   */
+  bool push(T element)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this] { return is_closed_ || queue_.size() < capacity_; });
+    if (is_closed_) {
+      return false;
+    }
+    queue_.push_back(std::move(element));
+    not_empty_.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Pop the oldest element, waiting while the queue is empty.
+   *
+   * @param element The popped element.
+   * @return false if the queue is closed and empty.
+   */
+  bool pop(T & element)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return is_closed_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return false;
+    }
+    element = std::move(queue_.front());
+    queue_.pop_front();
+    not_full_.notify_one();
+    return true;
+  }
+
+  /**
+   * @brief Close the queue. Remaining elements can still be popped, but no element can be pushed.
+   */
+  void close()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_closed_ = true;
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+private:
+  const size_t capacity_;
+  std::deque<T> queue_;
+  bool is_closed_{false};
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+};
+
+/**
+ * @class PipelinedPipeline
+ * @brief Inference Pipeline whose 3 stages run on their own threads, so that the pre-processing and
+ * post-processing of consecutive inputs overlap with the inference. The stages are connected by
+ * bounded queues of preallocated arrays, into which the output of a stage is copied, since stages
+ * reuse their output arrays. The arrays are recycled once the next stage is done with them.
+ */
+template <class PreProcessorType, class InferenceEngineType, class PostProcessorType>
+class PipelinedPipeline
+{
+  using InputType = decltype(std::declval<PreProcessorType>().input_type_indicator_);
+  using OutputType = decltype(std::declval<PostProcessorType>().output_type_indicator_);
+
+public:
+  using Callback = std::function<void(const OutputType &)>;
+
+  /**
+   * @brief Construct a new PipelinedPipeline object and start its stage threads
+   *
+   * @param pre_processor a PreProcessor object
+   * @param inference_engine a InferenceEngine object
+   * @param post_processor a PostProcessor object
+   * @param callback function called with each output, in the order of the inputs, from the
+   * post-processing thread
+   * @param queue_size maximum number of inputs waiting between two stages
+   */
+  PipelinedPipeline(
+    PreProcessorType pre_processor, InferenceEngineType inference_engine,
+    PostProcessorType post_processor, Callback callback, const size_t queue_size = 1)
+  : pre_processor_(pre_processor),
+    inference_engine_(inference_engine),
+    post_processor_(post_processor),
+    callback_(std::move(callback)),
+    inputs_(queue_size),
+    input_tensors_(queue_size),
+    output_tensors_(queue_size),
+    free_input_tensors_(queue_size + 1),
+    free_output_tensors_(queue_size + 1)
+  {
+    // each stage may hold an array while the queue after it is full
+    for (size_t i = 0; i < queue_size + 1; ++i) {
+      free_input_tensors_.push(TVMArrayContainerVector{});
+      free_output_tensors_.push(TVMArrayContainerVector{});
+    }
+
+    // a stage returns false when the pipeline is stopped by an error
+    pre_processor_thread_ = std::thread([this] {
+      runStage(inputs_, [this](const InputType & input) {
+        TVMArrayContainerVector input_tensor;
+        if (!free_input_tensors_.pop(input_tensor)) {
+          return false;
+        }
+        copyTVMArrays(pre_processor_.schedule(input), input_tensor);
+        return input_tensors_.push(std::move(input_tensor));
+      });
+      input_tensors_.close();
+    });
+    inference_engine_thread_ = std::thread([this] {
+      runStage(input_tensors_, [this](TVMArrayContainerVector & input_tensor) {
+        TVMArrayContainerVector output_tensor;
+        if (!free_output_tensors_.pop(output_tensor)) {
+          return false;
+        }
+        copyTVMArrays(inference_engine_.schedule(input_tensor), output_tensor);
+        free_input_tensors_.push(std::move(input_tensor));
+        return output_tensors_.push(std::move(output_tensor));
+      });
+      output_tensors_.close();
+    });
+    post_processor_thread_ = std::thread([this] {
+      runStage(output_tensors_, [this](TVMArrayContainerVector & output_tensor) {
+        const auto output = post_processor_.schedule(output_tensor);
+        free_output_tensors_.push(std::move(output_tensor));
+        callback_(output);
+        return true;
+      });
+    });
+  }
+
+  PipelinedPipeline(const PipelinedPipeline &) = delete;
+  PipelinedPipeline & operator=(const PipelinedPipeline &) = delete;
+
+  ~PipelinedPipeline()
+  {
+    try {
+      stop();
+    } catch (...) {
+      // the error of a stage can only be reported by an explicit stop()
+    }
+  }
+
+  /**
+   * @brief push data into the pipeline. Return asynchronously in the callback.
+   *
+   * Wait while the pre-processor is busy and the queue of its inputs is full.
+   *
+   * @param input The data to push into the pipeline
+   * @throw std::runtime_error if the pipeline is stopped, or the error of a stage which stopped it
+   */
+  void schedule(const InputType & input)
+  {
+    if (!inputs_.push(input)) {
+      rethrowStageError();
+      throw std::runtime_error("pipeline is stopped");
+    }
+  }
+
+  /**
+   * @brief stop the pipeline once the pushed data have been processed, and join the stage threads.
+   * Must not be called from the callback.
+   *
+   * @throw the first error thrown by a stage, if any
+   */
+  void stop()
+  {
+    inputs_.close();
+    for (auto * thread :
+         {&pre_processor_thread_, &inference_engine_thread_, &post_processor_thread_}) {
+      if (thread->joinable()) {
+        thread->join();
+      }
+    }
+    rethrowStageError();
+  }
+
+private:
+  /**
+   * @brief run a stage on the elements of its input queue until it is closed and empty. An error of
+   * the stage stops the whole pipeline.
+   */
+  template <class QueueInputType, class StageFunction>
+  void runStage(BoundedQueue<QueueInputType> & input_queue, StageFunction && stage)
+  {
+    QueueInputType input;
+    try {
+      while (input_queue.pop(input) && stage(input)) {
+      }
+    } catch (...) {
+      {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+      }
+      for (auto * queue : {&input_tensors_, &output_tensors_, &free_input_tensors_,
+                           &free_output_tensors_}) {
+        queue->close();
+      }
+      inputs_.close();
+    }
+  }
+
+  void rethrowStageError()
+  {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+  }
+
+  PreProcessorType pre_processor_;
+  InferenceEngineType inference_engine_;
+  PostProcessorType post_processor_;
+  Callback callback_;
+
+  BoundedQueue<InputType> inputs_;
+  BoundedQueue<TVMArrayContainerVector> input_tensors_;
+  BoundedQueue<TVMArrayContainerVector> output_tensors_;
+  BoundedQueue<TVMArrayContainerVector> free_input_tensors_;
+  BoundedQueue<TVMArrayContainerVector> free_output_tensors_;
+
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+
+  std::thread pre_processor_thread_;
+  std::thread inference_engine_thread_;
+  std::thread post_processor_thread_;
+};
+
 // Each node should be specificed with a string name and a shape
 using NetworkNode = std::pair<std::string, std::vector<int64_t>>;
 typedef struct
@@ -232,6 +232,27 @@ private:
   std::vector<std::pair<float, float>> anchors{};
 };
 
+void checkOutput(const std::vector<float> & output)
+{
+  // Define reference vector containing expected values, expressed as hexadecimal integers
+  std::vector<int32_t> int_output{0x3eb64594, 0x3f435656, 0x3ece1600, 0x3e99d381,
+                                  0x3f1cd6bc, 0x3f14f4dd, 0x3ed8065f, 0x3ee9f4fa,
+                                  0x3ec1b5e8, 0x3f4e7c6c, 0x3f136af1};
+
+  std::vector<float> expected_output(int_output.size());
+
+  // A memcpy means that the floats in expected_output have a well-defined binary value
+  for (size_t i = 0; i < int_output.size(); i++) {
+    memcpy(&expected_output[i], &int_output[i], sizeof(expected_output[i]));
+  }
+
+  // Test: check if the generated output is equal to the reference
+  EXPECT_EQ(expected_output.size(), output.size()) << "Unexpected output size";
+  for (size_t i = 0; i < output.size(); ++i) {
+    EXPECT_NEAR(expected_output[i], output[i], 0.0001) << "at index: " << i;
+  }
+}
+
 TEST(PipelineExamples, SimplePipeline)
 {
   // Instantiate the pipeline
@@ -248,22 +269,37 @@ TEST(PipelineExamples, SimplePipeline)
   // Push data input the pipeline and get the output
   auto output = pipeline.schedule(IMAGE_FILENAME);
 
-  // Define reference vector containing expected values, expressed as hexadecimal integers
-  std::vector<int32_t> int_output{0x3eb64594, 0x3f435656, 0x3ece1600, 0x3e99d381,
-                                  0x3f1cd6bc, 0x3f14f4dd, 0x3ed8065f, 0x3ee9f4fa,
-                                  0x3ec1b5e8, 0x3f4e7c6c, 0x3f136af1};
+  checkOutput(output);
+}
 
-  std::vector<float> expected_output(int_output.size());
+TEST(PipelineExamples, PipelinedPipeline)
+{
+  // Instantiate the pipeline
+  using PrePT = PreProcessorYoloV2Tiny;
+  using IET = tvm_utility::pipeline::InferenceEngineTVM;
+  using PostPT = PostProcessorYoloV2Tiny;
 
-  // A memcpy means that the floats in expected_output have a well-defined binary value
-  for (size_t i = 0; i < int_output.size(); i++) {
-    memcpy(&expected_output[i], &int_output[i], sizeof(expected_output[i]));
+  PrePT PreP{config};
+  IET IE{config};
+  PostPT PostP{config};
+
+  std::vector<std::vector<float>> outputs{};
+  tvm_utility::pipeline::PipelinedPipeline<PrePT, IET, PostPT> pipeline(
+    PreP, IE, PostP, [&outputs](const std::vector<float> & output) { outputs.push_back(output); },
+    2);
+
+  // Push several times the same data into the pipeline, so that the stages overlap
+  const size_t input_num = 4;
+  for (size_t i = 0; i < input_num; ++i) {
+    pipeline.schedule(IMAGE_FILENAME);
   }
+  pipeline.stop();
+  EXPECT_THROW(pipeline.schedule(IMAGE_FILENAME), std::runtime_error);
 
-  // Test: check if the generated output is equal to the reference
-  EXPECT_EQ(expected_output.size(), output.size()) << "Unexpected output size";
-  for (size_t i = 0; i < output.size(); ++i) {
-    EXPECT_NEAR(expected_output[i], output[i], 0.0001) << "at index: " << i;
+  // Test: check if each generated output is equal to the reference
+  ASSERT_EQ(input_num, outputs.size()) << "Unexpected number of outputs";
+  for (const auto & output : outputs) {
+    checkOutput(output);
   }
 }
 
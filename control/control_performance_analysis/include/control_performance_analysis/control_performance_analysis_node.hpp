@@ -18,6 +18,8 @@
 #include "control_performance_analysis/control_performance_analysis_core.hpp"
 #include "control_performance_analysis/msg/driving_monitor_stamped.hpp"
 #include "control_performance_analysis/msg/error_stamped.hpp"
+#include "control_performance_analysis/msg/statistics_array_stamped.hpp"
+#include "control_performance_analysis/streaming_statistics.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 #include <signal_processing/lowpass_filter_1d.hpp>
@@ -31,8 +33,11 @@
 
 #include <boost/optional.hpp>
 
+#include <map>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace control_performance_analysis
 {
@@ -41,6 +46,7 @@ using autoware_auto_planning_msgs::msg::Trajectory;
 using autoware_auto_vehicle_msgs::msg::SteeringReport;
 using control_performance_analysis::msg::DrivingMonitorStamped;
 using control_performance_analysis::msg::ErrorStamped;
+using control_performance_analysis::msg::StatisticsArrayStamped;
 using geometry_msgs::msg::PoseStamped;
 using nav_msgs::msg::Odometry;
 
@@ -64,6 +70,9 @@ private:
   rclcpp::Publisher<ErrorStamped>::SharedPtr pub_error_msg_;  // publish error message
   rclcpp::Publisher<DrivingMonitorStamped>::SharedPtr
     pub_driving_msg_;  // publish driving status message
+  rclcpp::Publisher<StatisticsArrayStamped>::SharedPtr
+    pub_statistics_msg_;  // publish statistics of the error and driving status
+  rclcpp::TimerBase::SharedPtr timer_statistics_;
 
   // Node Methods
   bool isDataReady() const;  // check if data arrive
@@ -74,12 +83,21 @@ private:
   void onControlRaw(const AckermannControlCommand::ConstSharedPtr control_msg);
   void onVecSteeringMeasured(const SteeringReport::ConstSharedPtr meas_steer_msg);
   void onVelocity(const Odometry::ConstSharedPtr msg);
+  void onStatisticsTimer();
+
+  // Statistics
+  void addStatistics(const std::string & name, const double t, const double value);
 
   // Parameters
   Params param_{};  // wheelbase, control period and feedback coefficients.
   // State holder
   std_msgs::msg::Header last_control_cmd_;
   double d_control_cmd_{0};
+  bool enable_statistics_{true};
+  std::vector<double> statistics_windows_{};
+  double statistics_publish_period_{1.0};
+  // statistics of each window for each value of the error and driving status
+  std::map<std::string, std::vector<StreamingStatistics>> statistics_;
 
   // Subscriber Parameters
   Trajectory::ConstSharedPtr current_trajectory_ptr_;  // ConstPtr to local traj.
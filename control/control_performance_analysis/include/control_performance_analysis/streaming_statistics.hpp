@@ -0,0 +1,82 @@
+// Copyright 2022 Tier IV, Inc., Leo Drive Teknoloji A.Ş.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONTROL_PERFORMANCE_ANALYSIS__STREAMING_STATISTICS_HPP_
+#define CONTROL_PERFORMANCE_ANALYSIS__STREAMING_STATISTICS_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace control_performance_analysis
+{
+struct StatisticsSummary
+{
+  size_t count{0};
+  double mean{0.0};
+  double standard_deviation{0.0};
+  double min{0.0};
+  double max{0.0};
+  double p50{0.0};
+  double p95{0.0};
+  double p99{0.0};
+};
+
+/**
+ * @brief Statistics of the values of the last window_length seconds with a fixed memory.
+ * The window is split into pane_num panes, each of which keeps the moments of its values and a
+ * sketch of them in logarithmic buckets of |value|, so that the percentiles are within
+ * relative_accuracy of the values. The window slides by a pane.
+ */
+class StreamingStatistics
+{
+public:
+  explicit StreamingStatistics(
+    const double window_length, const size_t pane_num = 10, const double relative_accuracy = 0.01);
+
+  double getWindowLength() const { return window_length_; }
+
+  void add(const double t, const double value);
+
+  StatisticsSummary getSummary(const double t) const;
+
+private:
+  struct Pane
+  {
+    int64_t index{0};
+    size_t count{0};
+    double mean{0.0};
+    double m2{0.0};  // sum of the squared differences from the mean
+    double min{0.0};
+    double max{0.0};
+    size_t zero_count{0};
+    std::vector<uint32_t> positive_counts;
+    std::vector<uint32_t> negative_counts;
+  };
+
+  int64_t toPaneIndex(const double t) const;
+  size_t toBucketIndex(const double abs_value) const;
+  double toBucketValue(const size_t bucket_idx) const;
+  static void resetPane(Pane & pane, const int64_t index);
+
+  double window_length_;
+  double pane_length_;
+  double gamma_;
+  double log_gamma_;
+  int bucket_offset_;
+  std::vector<Pane> panes_;
+};
+}  // namespace control_performance_analysis
+
+#endif  // CONTROL_PERFORMANCE_ANALYSIS__STREAMING_STATISTICS_HPP_
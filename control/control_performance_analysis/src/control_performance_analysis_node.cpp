@@ -19,8 +19,11 @@
 
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace
 {
@@ -28,6 +31,39 @@ using autoware_auto_control_msgs::msg::AckermannControlCommand;
 using control_performance_analysis::msg::DrivingMonitorStamped;
 using control_performance_analysis::msg::ErrorStamped;
 
+std::vector<std::pair<std::string, double>> getStatisticsValues(const ErrorStamped & msg)
+{
+  const auto & e = msg.error;
+  return {
+    {"lateral_error", e.lateral_error},
+    {"lateral_error_velocity", e.lateral_error_velocity},
+    {"lateral_error_acceleration", e.lateral_error_acceleration},
+    {"longitudinal_error", e.longitudinal_error},
+    {"longitudinal_error_velocity", e.longitudinal_error_velocity},
+    {"longitudinal_error_acceleration", e.longitudinal_error_acceleration},
+    {"heading_error", e.heading_error},
+    {"heading_error_velocity", e.heading_error_velocity},
+    {"control_effort_energy", e.control_effort_energy},
+    {"error_energy", e.error_energy},
+    {"value_approximation", e.value_approximation},
+    {"curvature_estimate", e.curvature_estimate},
+    {"curvature_estimate_pp", e.curvature_estimate_pp},
+    {"vehicle_velocity_error", e.vehicle_velocity_error},
+    {"tracking_curvature_discontinuity_ability", e.tracking_curvature_discontinuity_ability},
+  };
+}
+
+std::vector<std::pair<std::string, double>> getStatisticsValues(const DrivingMonitorStamped & msg)
+{
+  return {
+    {"longitudinal_acceleration", msg.longitudinal_acceleration.data},
+    {"longitudinal_jerk", msg.longitudinal_jerk.data},
+    {"lateral_acceleration", msg.lateral_acceleration.data},
+    {"lateral_jerk", msg.lateral_jerk.data},
+    {"desired_steering_angle", msg.desired_steering_angle.data},
+    {"controller_processing_time", msg.controller_processing_time.data},
+  };
+}
 }  // namespace
 
 namespace control_performance_analysis
@@ -53,6 +89,18 @@ ControlPerformanceAnalysisNode::ControlPerformanceAnalysisNode(
   param_.acceptable_max_yaw_difference_rad_ =
     declare_parameter("acceptable_max_yaw_difference_rad", 1.0472);
   param_.lpf_gain_ = declare_parameter("low_pass_filter_gain", 0.8);
+  enable_statistics_ = declare_parameter("enable_statistics", true);
+  statistics_windows_ =
+    declare_parameter("statistics_windows", std::vector<double>{1.0, 10.0, 60.0});
+  statistics_publish_period_ = declare_parameter("statistics_publish_period", 1.0);
+  if (
+    statistics_publish_period_ <= 0.0 ||
+    std::any_of(statistics_windows_.cbegin(), statistics_windows_.cend(), [](const auto w) {
+      return w <= 0.0;
+    })) {
+    RCLCPP_ERROR(get_logger(), "statistics windows and publish period must be positive.");
+    enable_statistics_ = false;
+  }
 
   // Prepare error computation class with the wheelbase parameter.
   control_performance_core_ptr_ = std::make_unique<ControlPerformanceAnalysisCore>(param_);
@@ -77,6 +125,15 @@ ControlPerformanceAnalysisNode::ControlPerformanceAnalysisNode(
 
   pub_driving_msg_ = create_publisher<DrivingMonitorStamped>("~/output/driving_status_stamped", 1);
 
+  if (enable_statistics_) {
+    pub_statistics_msg_ =
+      create_publisher<StatisticsArrayStamped>("~/output/statistics_array_stamped", 1);
+    const auto period_ns = rclcpp::Rate(1.0 / statistics_publish_period_).period();
+    timer_statistics_ = rclcpp::create_timer(
+      this, get_clock(), period_ns,
+      std::bind(&ControlPerformanceAnalysisNode::onStatisticsTimer, this));
+  }
+
   // Wait for first self pose
   self_pose_listener_.waitForFirstPose();
 }
@@ -164,8 +221,13 @@ void ControlPerformanceAnalysisNode::onVelocity(const Odometry::ConstSharedPtr m
   }
 
   // Compute control performance values.
+  const double t = rclcpp::Time(msg->header.stamp).seconds();
   if (control_performance_core_ptr_->calculateErrorVars()) {
     pub_error_msg_->publish(control_performance_core_ptr_->error_vars);
+    for (const auto & [name, value] :
+         getStatisticsValues(control_performance_core_ptr_->error_vars)) {
+      addStatistics(name, t, value);
+    }
   } else {
     RCLCPP_ERROR(get_logger(), "Cannot compute error vars ...");
   }
@@ -175,6 +237,10 @@ void ControlPerformanceAnalysisNode::onVelocity(const Odometry::ConstSharedPtr m
     control_performance_core_ptr_->driving_status_vars.controller_processing_time.data =
       d_control_cmd_;
     pub_driving_msg_->publish(control_performance_core_ptr_->driving_status_vars);
+    for (const auto & [name, value] :
+         getStatisticsValues(control_performance_core_ptr_->driving_status_vars)) {
+      addStatistics(name, t, value);
+    }
   } else {
     RCLCPP_ERROR(get_logger(), "Cannot compute driving vars ...");
   }
@@ -185,6 +251,52 @@ void ControlPerformanceAnalysisNode::onVelocity(const Odometry::ConstSharedPtr m
   current_pose_ = self_pose_listener_.getCurrentPose();
 }
 
+void ControlPerformanceAnalysisNode::onStatisticsTimer()
+{
+  const auto now = this->now();
+
+  StatisticsArrayStamped msg;
+  msg.header.stamp = now;
+  for (const auto & [name, window_statistics] : statistics_) {
+    for (const auto & statistics : window_statistics) {
+      const auto summary = statistics.getSummary(now.seconds());
+      control_performance_analysis::msg::Statistics s;
+      s.name = name;
+      s.window_length = statistics.getWindowLength();
+      s.count = summary.count;
+      s.mean = summary.mean;
+      s.standard_deviation = summary.standard_deviation;
+      s.min = summary.min;
+      s.max = summary.max;
+      s.p50 = summary.p50;
+      s.p95 = summary.p95;
+      s.p99 = summary.p99;
+      msg.statistics.push_back(s);
+    }
+  }
+  pub_statistics_msg_->publish(msg);
+}
+
+void ControlPerformanceAnalysisNode::addStatistics(
+  const std::string & name, const double t, const double value)
+{
+  if (!enable_statistics_) {
+    return;
+  }
+
+  auto itr = statistics_.find(name);
+  if (itr == statistics_.end()) {
+    std::vector<StreamingStatistics> window_statistics;
+    for (const auto window : statistics_windows_) {
+      window_statistics.emplace_back(window);
+    }
+    itr = statistics_.emplace(name, std::move(window_statistics)).first;
+  }
+  for (auto & statistics : itr->second) {
+    statistics.add(t, value);
+  }
+}
+
 bool ControlPerformanceAnalysisNode::isDataReady() const
 {
   rclcpp::Clock clock{RCL_ROS_TIME};
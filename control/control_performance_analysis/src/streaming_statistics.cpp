@@ -0,0 +1,195 @@
+// Copyright 2022 Tier IV, Inc., Leo Drive Teknoloji A.Ş.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "control_performance_analysis/streaming_statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+// |values| out of the range are counted in the zero bucket or the last bucket
+constexpr double min_abs_value = 1e-6;
+constexpr double max_abs_value = 1e6;
+}  // namespace
+
+namespace control_performance_analysis
+{
+StreamingStatistics::StreamingStatistics(
+  const double window_length, const size_t pane_num, const double relative_accuracy)
+: window_length_(window_length)
+{
+  if (window_length <= 0.0 || pane_num == 0) {
+    throw std::invalid_argument("window length and number of panes must be positive");
+  }
+  if (relative_accuracy <= 0.0 || relative_accuracy >= 1.0) {
+    throw std::invalid_argument("relative accuracy must be in (0, 1)");
+  }
+
+  pane_length_ = window_length / static_cast<double>(pane_num);
+  gamma_ = (1.0 + relative_accuracy) / (1.0 - relative_accuracy);
+  log_gamma_ = std::log(gamma_);
+  bucket_offset_ = static_cast<int>(std::ceil(std::log(min_abs_value) / log_gamma_));
+  const auto bucket_num =
+    static_cast<size_t>(std::ceil(std::log(max_abs_value) / log_gamma_) - bucket_offset_) + 1;
+
+  panes_.resize(pane_num);
+  for (auto & pane : panes_) {
+    pane.positive_counts.resize(bucket_num);
+    pane.negative_counts.resize(bucket_num);
+    resetPane(pane, std::numeric_limits<int64_t>::min());
+  }
+}
+
+void StreamingStatistics::add(const double t, const double value)
+{
+  if (!std::isfinite(value)) {
+    return;
+  }
+
+  const auto pane_idx = toPaneIndex(t);
+  const auto pane_num = static_cast<int64_t>(panes_.size());
+  auto & pane = panes_.at(static_cast<size_t>(((pane_idx % pane_num) + pane_num) % pane_num));
+  if (pane.index != pane_idx) {
+    if (pane.index > pane_idx) {
+      return;  // older than the window
+    }
+    resetPane(pane, pane_idx);
+  }
+
+  // Welford's update of the moments
+  ++pane.count;
+  const double delta = value - pane.mean;
+  pane.mean += delta / static_cast<double>(pane.count);
+  pane.m2 += delta * (value - pane.mean);
+  pane.min = pane.count == 1 ? value : std::min(pane.min, value);
+  pane.max = pane.count == 1 ? value : std::max(pane.max, value);
+
+  const double abs_value = std::abs(value);
+  if (abs_value < min_abs_value) {
+    ++pane.zero_count;
+  } else if (value > 0.0) {
+    ++pane.positive_counts.at(toBucketIndex(abs_value));
+  } else {
+    ++pane.negative_counts.at(toBucketIndex(abs_value));
+  }
+}
+
+StatisticsSummary StreamingStatistics::getSummary(const double t) const
+{
+  const auto pane_idx = toPaneIndex(t);
+  const auto pane_num = static_cast<int64_t>(panes_.size());
+  const auto bucket_num = panes_.front().positive_counts.size();
+
+  // merge the panes of the window
+  StatisticsSummary summary;
+  double m2 = 0.0;
+  size_t zero_count = 0;
+  std::vector<size_t> positive_counts(bucket_num, 0);
+  std::vector<size_t> negative_counts(bucket_num, 0);
+  for (const auto & pane : panes_) {
+    if (pane.count == 0 || pane.index > pane_idx || pane.index <= pane_idx - pane_num) {
+      continue;
+    }
+
+    // parallel update of the moments by Chan et al.
+    const auto count = summary.count + pane.count;
+    const double delta = pane.mean - summary.mean;
+    m2 += pane.m2 + delta * delta * static_cast<double>(summary.count) *
+                      static_cast<double>(pane.count) / static_cast<double>(count);
+    summary.mean += delta * static_cast<double>(pane.count) / static_cast<double>(count);
+    summary.min = summary.count == 0 ? pane.min : std::min(summary.min, pane.min);
+    summary.max = summary.count == 0 ? pane.max : std::max(summary.max, pane.max);
+    summary.count = count;
+
+    zero_count += pane.zero_count;
+    for (size_t i = 0; i < bucket_num; ++i) {
+      positive_counts.at(i) += pane.positive_counts.at(i);
+      negative_counts.at(i) += pane.negative_counts.at(i);
+    }
+  }
+
+  if (summary.count == 0) {
+    return summary;
+  }
+  summary.standard_deviation = std::sqrt(m2 / static_cast<double>(summary.count));
+
+  // the value of the bucket of the rank, from the most negative one to the most positive one
+  const auto calcPercentile = [&](const double ratio) {
+    const auto rank = static_cast<size_t>(ratio * static_cast<double>(summary.count - 1));
+    double value = 0.0;
+    size_t accumulated_count = 0;
+    bool is_found = false;
+    for (size_t i = bucket_num; i > 0 && !is_found; --i) {
+      accumulated_count += negative_counts.at(i - 1);
+      if (rank < accumulated_count) {
+        value = -toBucketValue(i - 1);
+        is_found = true;
+      }
+    }
+    accumulated_count += zero_count;
+    if (!is_found && rank < accumulated_count) {
+      value = 0.0;
+      is_found = true;
+    }
+    for (size_t i = 0; i < bucket_num && !is_found; ++i) {
+      accumulated_count += positive_counts.at(i);
+      if (rank < accumulated_count) {
+        value = toBucketValue(i);
+        is_found = true;
+      }
+    }
+    return std::clamp(value, summary.min, summary.max);
+  };
+  summary.p50 = calcPercentile(0.50);
+  summary.p95 = calcPercentile(0.95);
+  summary.p99 = calcPercentile(0.99);
+
+  return summary;
+}
+
+int64_t StreamingStatistics::toPaneIndex(const double t) const
+{
+  return static_cast<int64_t>(std::floor(t / pane_length_));
+}
+
+size_t StreamingStatistics::toBucketIndex(const double abs_value) const
+{
+  const auto idx = static_cast<int>(std::ceil(std::log(abs_value) / log_gamma_)) - bucket_offset_;
+  const auto bucket_num = static_cast<int>(panes_.front().positive_counts.size());
+  return static_cast<size_t>(std::clamp(idx, 0, bucket_num - 1));
+}
+
+double StreamingStatistics::toBucketValue(const size_t bucket_idx) const
+{
+  // the value whose relative errors to the both ends of the bucket are the same
+  const auto exponent = static_cast<int>(bucket_idx) + bucket_offset_;
+  return 2.0 * std::pow(gamma_, exponent) / (gamma_ + 1.0);
+}
+
+void StreamingStatistics::resetPane(Pane & pane, const int64_t index)
+{
+  pane.index = index;
+  pane.count = 0;
+  pane.mean = 0.0;
+  pane.m2 = 0.0;
+  pane.min = 0.0;
+  pane.max = 0.0;
+  pane.zero_count = 0;
+  std::fill(pane.positive_counts.begin(), pane.positive_counts.end(), 0);
+  std::fill(pane.negative_counts.begin(), pane.negative_counts.end(), 0);
+}
+}  // namespace control_performance_analysis
@@ -17,6 +17,8 @@
 
 #include <rosidl_runtime_cpp/message_initialization.hpp>
 #include <tier4_autoware_utils/geometry/boost_geometry.hpp>
+#include <tier4_autoware_utils/geometry/polygon_cache.hpp>
+#include <tier4_autoware_utils/geometry/polygon_grid.hpp>
 #include <tier4_autoware_utils/geometry/pose_deviation.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
@@ -45,6 +47,7 @@ using autoware_auto_planning_msgs::msg::HADMapRoute;
 using autoware_auto_planning_msgs::msg::PathWithLaneId;
 using autoware_auto_planning_msgs::msg::Trajectory;
 using autoware_auto_planning_msgs::msg::TrajectoryPoint;
+using tier4_autoware_utils::BoxedPolygon2d;
 using tier4_autoware_utils::LinearRing2d;
 using tier4_autoware_utils::PoseDeviation;
 using TrajectoryPoints = std::vector<TrajectoryPoint>;
@@ -70,6 +73,10 @@ struct Input
   lanelet::LaneletMapPtr lanelet_map{};
   HADMapRoute::ConstSharedPtr route{};
   lanelet::ConstLanelets route_lanelets{};
+  // polygons of the lanelets of lanelet_map by id, used instead of the lanelets if set
+  std::shared_ptr<const tier4_autoware_utils::PolygonCache> lanelet_polygon_cache{};
+  // union of the polygons of route_lanelets, used for the footprints with the polygon cache if set
+  std::shared_ptr<const tier4_autoware_utils::PolygonGrid> route_lanelet_grid{};
   Trajectory::ConstSharedPtr reference_trajectory{};
   Trajectory::ConstSharedPtr predicted_trajectory{};
 };
@@ -134,6 +141,21 @@ private:
 
   static bool isOutOfLane(
     const lanelet::ConstLanelets & candidate_lanelets, const LinearRing2d & vehicle_footprint);
+
+  static bool willLeaveLane(
+    const std::vector<const BoxedPolygon2d *> & candidate_polygons,
+    const std::vector<LinearRing2d> & vehicle_footprints);
+
+  static bool isOutOfLane(
+    const std::vector<const BoxedPolygon2d *> & candidate_polygons,
+    const LinearRing2d & vehicle_footprint);
+
+  static bool willLeaveLane(
+    const tier4_autoware_utils::PolygonGrid & lanelet_grid,
+    const std::vector<LinearRing2d> & vehicle_footprints);
+
+  static bool isOutOfLane(
+    const tier4_autoware_utils::PolygonGrid & lanelet_grid, const LinearRing2d & vehicle_footprint);
 };
 }  // namespace lane_departure_checker
 
@@ -47,6 +47,7 @@ struct NodeParam
 {
   double update_rate;
   bool visualize_lanelet;
+  double route_lanelet_grid_resolution;
 };
 
 class LaneDepartureCheckerNode : public rclcpp::Node
@@ -67,12 +68,14 @@ private:
   geometry_msgs::msg::PoseStamped::ConstSharedPtr current_pose_;
   nav_msgs::msg::Odometry::ConstSharedPtr current_odom_;
   lanelet::LaneletMapPtr lanelet_map_;
+  std::shared_ptr<tier4_autoware_utils::PolygonCache> lanelet_polygon_cache_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_;
   lanelet::routing::RoutingGraphPtr routing_graph_;
   HADMapRoute::ConstSharedPtr route_;
   geometry_msgs::msg::PoseWithCovarianceStamped::ConstSharedPtr cov_;
   HADMapRoute::ConstSharedPtr last_route_;
   lanelet::ConstLanelets route_lanelets_;
+  std::shared_ptr<const tier4_autoware_utils::PolygonGrid> route_lanelet_grid_;
   Trajectory::ConstSharedPtr reference_trajectory_;
   Trajectory::ConstSharedPtr predicted_trajectory_;
 
@@ -30,6 +30,7 @@
 #include <algorithm>
 #include <vector>
 
+using tier4_autoware_utils::BoxedPolygon2d;
 using tier4_autoware_utils::LinearRing2d;
 using tier4_autoware_utils::MultiPoint2d;
 using tier4_autoware_utils::Point2d;
@@ -57,6 +58,18 @@ bool isInAnyLane(const lanelet::ConstLanelets & candidate_lanelets, const Point2
   return false;
 }
 
+bool isInAnyLane(
+  const std::vector<const BoxedPolygon2d *> & candidate_polygons, const Point2d & point)
+{
+  for (const auto & polygon : candidate_polygons) {
+    if (tier4_autoware_utils::within(point, *polygon)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 LinearRing2d createHullFromFootprints(const std::vector<LinearRing2d> & footprints)
 {
   MultiPoint2d combined;
@@ -89,6 +102,46 @@ lanelet::ConstLanelets getCandidateLanelets(
 
   return candidate_lanelets;
 }
+
+// polygons of the lanelets in the same order, or empty if any of them is not in the cache
+std::vector<const BoxedPolygon2d *> findLaneletPolygons(
+  const tier4_autoware_utils::PolygonCache & cache, const lanelet::ConstLanelets & lanelets)
+{
+  std::vector<const BoxedPolygon2d *> polygons;
+  polygons.reserve(lanelets.size());
+  for (const auto & lanelet : lanelets) {
+    const auto polygon = cache.find(lanelet.id());
+    if (!polygon) {
+      return {};
+    }
+    polygons.push_back(polygon);
+  }
+
+  return polygons;
+}
+
+lanelet::ConstLanelets getCandidateLanelets(
+  const lanelet::ConstLanelets & route_lanelets,
+  const std::vector<const BoxedPolygon2d *> & route_polygons,
+  const std::vector<LinearRing2d> & vehicle_footprints,
+  std::vector<const BoxedPolygon2d *> & candidate_polygons)
+{
+  lanelet::ConstLanelets candidate_lanelets;
+  candidate_polygons.clear();
+
+  // Find lanes within the convex hull of footprints, testing the bounding boxes first
+  tier4_autoware_utils::Polygon2d footprint_hull;
+  footprint_hull.outer() = createHullFromFootprints(vehicle_footprints);
+  const auto boxed_footprint_hull = tier4_autoware_utils::toBoxedPolygon2d(footprint_hull);
+  for (size_t i = 0; i < route_lanelets.size(); ++i) {
+    if (tier4_autoware_utils::intersects(*route_polygons.at(i), boxed_footprint_hull)) {
+      candidate_lanelets.push_back(route_lanelets.at(i));
+      candidate_polygons.push_back(route_polygons.at(i));
+    }
+  }
+
+  return candidate_lanelets;
+}
 }  // namespace
 
 namespace lane_departure_checker
@@ -123,13 +176,43 @@ Output LaneDepartureChecker::update(const Input & input)
   output.vehicle_passing_areas = createVehiclePassingAreas(output.vehicle_footprints);
   output.processing_time_map["createVehiclePassingAreas"] = stop_watch.toc(true);
 
-  output.candidate_lanelets = getCandidateLanelets(input.route_lanelets, output.vehicle_footprints);
+  const auto route_polygons =
+    input.lanelet_polygon_cache
+      ? findLaneletPolygons(*input.lanelet_polygon_cache, input.route_lanelets)
+      : std::vector<const BoxedPolygon2d *>{};
+  const bool use_polygon_cache =
+    !input.route_lanelets.empty() && route_polygons.size() == input.route_lanelets.size();
+
+  std::vector<const BoxedPolygon2d *> candidate_polygons;
+  output.candidate_lanelets =
+    use_polygon_cache ? getCandidateLanelets(
+                          input.route_lanelets, route_polygons, output.vehicle_footprints,
+                          candidate_polygons)
+                      : getCandidateLanelets(input.route_lanelets, output.vehicle_footprints);
   output.processing_time_map["getCandidateLanelets"] = stop_watch.toc(true);
 
-  output.will_leave_lane = willLeaveLane(output.candidate_lanelets, output.vehicle_footprints);
+  // A point in a route lanelet is in a candidate lanelet, since the candidates are all the route
+  // lanelets whose bounding boxes intersect the one of the footprints
+  if (use_polygon_cache && input.route_lanelet_grid) {
+    output.will_leave_lane = willLeaveLane(*input.route_lanelet_grid, output.vehicle_footprints);
+    output.processing_time_map["willLeaveLane"] = stop_watch.toc(true);
+
+    output.is_out_of_lane =
+      isOutOfLane(*input.route_lanelet_grid, output.vehicle_footprints.front());
+    output.processing_time_map["isOutOfLane"] = stop_watch.toc(true);
+
+    return output;
+  }
+
+  output.will_leave_lane = use_polygon_cache
+                             ? willLeaveLane(candidate_polygons, output.vehicle_footprints)
+                             : willLeaveLane(output.candidate_lanelets, output.vehicle_footprints);
   output.processing_time_map["willLeaveLane"] = stop_watch.toc(true);
 
-  output.is_out_of_lane = isOutOfLane(output.candidate_lanelets, output.vehicle_footprints.front());
+  output.is_out_of_lane =
+    use_polygon_cache
+      ? isOutOfLane(candidate_polygons, output.vehicle_footprints.front())
+      : isOutOfLane(output.candidate_lanelets, output.vehicle_footprints.front());
   output.processing_time_map["isOutOfLane"] = stop_watch.toc(true);
 
   return output;
@@ -289,4 +372,55 @@ bool LaneDepartureChecker::isOutOfLane(
 
   return false;
 }
+
+bool LaneDepartureChecker::willLeaveLane(
+  const std::vector<const BoxedPolygon2d *> & candidate_polygons,
+  const std::vector<LinearRing2d> & vehicle_footprints)
+{
+  for (const auto & vehicle_footprint : vehicle_footprints) {
+    if (isOutOfLane(candidate_polygons, vehicle_footprint)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool LaneDepartureChecker::isOutOfLane(
+  const std::vector<const BoxedPolygon2d *> & candidate_polygons,
+  const LinearRing2d & vehicle_footprint)
+{
+  for (const auto & point : vehicle_footprint) {
+    if (!isInAnyLane(candidate_polygons, point)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool LaneDepartureChecker::willLeaveLane(
+  const tier4_autoware_utils::PolygonGrid & lanelet_grid,
+  const std::vector<LinearRing2d> & vehicle_footprints)
+{
+  for (const auto & vehicle_footprint : vehicle_footprints) {
+    if (isOutOfLane(lanelet_grid, vehicle_footprint)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool LaneDepartureChecker::isOutOfLane(
+  const tier4_autoware_utils::PolygonGrid & lanelet_grid, const LinearRing2d & vehicle_footprint)
+{
+  for (const auto & point : vehicle_footprint) {
+    if (!lanelet_grid.withinAny(point)) {
+      return true;
+    }
+  }
+
+  return false;
+}
 }  // namespace lane_departure_checker
@@ -26,6 +26,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -104,6 +105,30 @@ lanelet::ConstLanelets getRouteLanelets(
   return route_lanelets;
 }
 
+// grid of the polygons of the route lanelets, or nullptr if any of them is not in the cache
+std::shared_ptr<const tier4_autoware_utils::PolygonGrid> createRouteLaneletGrid(
+  const tier4_autoware_utils::PolygonCache & lanelet_polygon_cache,
+  const lanelet::ConstLanelets & route_lanelets, const double resolution)
+{
+  std::vector<tier4_autoware_utils::BoxedPolygon2d> polygons;
+  std::unordered_set<lanelet::Id> lanelet_ids;
+  for (const auto & lanelet : route_lanelets) {
+    if (!lanelet_ids.insert(lanelet.id()).second) {
+      continue;
+    }
+    const auto polygon = lanelet_polygon_cache.find(lanelet.id());
+    if (!polygon) {
+      return nullptr;
+    }
+    polygons.push_back(*polygon);
+  }
+
+  if (polygons.empty()) {
+    return nullptr;
+  }
+  return std::make_shared<const tier4_autoware_utils::PolygonGrid>(polygons, resolution);
+}
+
 template <typename T>
 void update_param(
   const std::vector<rclcpp::Parameter> & parameters, const std::string & name, T & value)
@@ -128,6 +153,8 @@ LaneDepartureCheckerNode::LaneDepartureCheckerNode(const rclcpp::NodeOptions & o
   // Node Parameter
   node_param_.update_rate = declare_parameter("update_rate", 10.0);
   node_param_.visualize_lanelet = declare_parameter("visualize_lanelet", false);
+  node_param_.route_lanelet_grid_resolution =
+    declare_parameter("route_lanelet_grid_resolution", 1.0);
 
   // Core Parameter
 
@@ -197,6 +224,15 @@ void LaneDepartureCheckerNode::onLaneletMapBin(const HADMapBin::ConstSharedPtr m
 {
   lanelet_map_ = std::make_shared<lanelet::LaneletMap>();
   lanelet::utils::conversion::fromBinMsg(*msg, lanelet_map_, &traffic_rules_, &routing_graph_);
+
+  lanelet_polygon_cache_ = std::make_shared<tier4_autoware_utils::PolygonCache>();
+  for (const auto & lanelet : lanelet_map_->laneletLayer) {
+    tier4_autoware_utils::Polygon2d polygon;
+    for (const auto & p : lanelet.polygon2d().basicPolygon()) {
+      polygon.outer().emplace_back(p.x(), p.y());
+    }
+    lanelet_polygon_cache_->add(lanelet.id(), polygon);
+  }
 }
 
 void LaneDepartureCheckerNode::onRoute(const HADMapRoute::ConstSharedPtr msg) { route_ = msg; }
@@ -304,6 +340,8 @@ void LaneDepartureCheckerNode::onTimer()
   // In order to wait for both of map and route will be ready, write this not in callback but here
   if (last_route_ != route_ && !route_->segments.empty()) {
     route_lanelets_ = getRouteLanelets(lanelet_map_, routing_graph_, route_, vehicle_length_m_);
+    route_lanelet_grid_ = createRouteLaneletGrid(
+      *lanelet_polygon_cache_, route_lanelets_, node_param_.route_lanelet_grid_resolution);
     last_route_ = route_;
   }
   processing_time_map["Node: getRouteLanelets"] = stop_watch.toc(true);
@@ -311,8 +349,10 @@ void LaneDepartureCheckerNode::onTimer()
   input_.current_odom = current_odom_;
   input_.current_pose = current_pose_;
   input_.lanelet_map = lanelet_map_;
+  input_.lanelet_polygon_cache = lanelet_polygon_cache_;
   input_.route = route_;
   input_.route_lanelets = route_lanelets_;
+  input_.route_lanelet_grid = route_lanelet_grid_;
   input_.reference_trajectory = reference_trajectory_;
   input_.predicted_trajectory = predicted_trajectory_;
   processing_time_map["Node: setInputData"] = stop_watch.toc(true);
@@ -15,6 +15,8 @@
 #ifndef OBSTACLE_COLLISION_CHECKER__OBSTACLE_COLLISION_CHECKER_HPP_
 #define OBSTACLE_COLLISION_CHECKER__OBSTACLE_COLLISION_CHECKER_HPP_
 
+#include "obstacle_collision_checker/util/obstacle_point_grid.hpp"
+
 #include <tier4_autoware_utils/geometry/boost_geometry.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
@@ -77,6 +79,12 @@ private:
   Param param_;
   vehicle_info_util::VehicleInfo vehicle_info_;
 
+  // obstacle pointcloud of the last message, transformed and indexed once for the cycles until
+  // the next message or transform
+  sensor_msgs::msg::PointCloud2::ConstSharedPtr obstacle_pointcloud_msg_;
+  geometry_msgs::msg::Transform obstacle_transform_;
+  ObstaclePointGrid obstacle_point_grid_;
+
   //! This function assumes the input trajectory is sampled dense enough
   static autoware_auto_planning_msgs::msg::Trajectory resampleTrajectory(
     const autoware_auto_planning_msgs::msg::Trajectory & trajectory, const double interval);
@@ -94,12 +102,15 @@ private:
   static LinearRing2d createHullFromFootprints(
     const LinearRing2d & area1, const LinearRing2d & area2);
 
+  //! Only the obstacle points within search_radius from the trajectory points are checked
   static bool willCollide(
-    const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
+    const ObstaclePointGrid & obstacle_point_grid,
+    const autoware_auto_planning_msgs::msg::Trajectory & trajectory, const double search_radius,
     const std::vector<LinearRing2d> & vehicle_footprints);
 
   static bool hasCollision(
-    const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
+    const ObstaclePointGrid & obstacle_point_grid,
+    const autoware_auto_planning_msgs::msg::Trajectory & trajectory, const double search_radius,
     const LinearRing2d & vehicle_footprint);
 };
 }  // namespace obstacle_collision_checker
@@ -0,0 +1,98 @@
+// Copyright 2022 Tier IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OBSTACLE_COLLISION_CHECKER__UTIL__OBSTACLE_POINT_GRID_HPP_
+#define OBSTACLE_COLLISION_CHECKER__UTIL__OBSTACLE_POINT_GRID_HPP_
+
+#include <tier4_autoware_utils/geometry/boost_geometry.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace obstacle_collision_checker
+{
+/**
+ * @brief Obstacle points bucketed by the cells of a square grid on the xy plane, so that a
+ * footprint only looks at the points in the cells its bounding box overlaps.
+ */
+class ObstaclePointGrid
+{
+public:
+  using Point2d = tier4_autoware_utils::Point2d;
+  using Box2d = tier4_autoware_utils::Box2d;
+
+  ObstaclePointGrid() = default;
+
+  template <class PointCloud>
+  ObstaclePointGrid(const PointCloud & pointcloud, const double resolution)
+  : resolution_(resolution)
+  {
+    for (const auto & point : pointcloud) {
+      const Point2d p{point.x, point.y};
+      cells_[toKey(toIndex(p.x()), toIndex(p.y()))].push_back(p);
+    }
+  }
+
+  /**
+   * @brief Call f on every point in the cells overlapped by the box, until f returns true
+   * @return whether f returned true
+   */
+  template <class F>
+  bool anyOfPointsInBox(const Box2d & box, const F & f) const
+  {
+    if (cells_.empty()) {
+      return false;
+    }
+
+    const auto min_x_idx = toIndex(box.min_corner().x());
+    const auto max_x_idx = toIndex(box.max_corner().x());
+    const auto min_y_idx = toIndex(box.min_corner().y());
+    const auto max_y_idx = toIndex(box.max_corner().y());
+    for (auto x_idx = min_x_idx; x_idx <= max_x_idx; ++x_idx) {
+      for (auto y_idx = min_y_idx; y_idx <= max_y_idx; ++y_idx) {
+        const auto itr = cells_.find(toKey(x_idx, y_idx));
+        if (itr == cells_.end()) {
+          continue;
+        }
+        for (const auto & p : itr->second) {
+          if (f(p)) {
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  }
+
+  size_t getCellNum() const { return cells_.size(); }
+
+private:
+  int32_t toIndex(const double v) const
+  {
+    return static_cast<int32_t>(std::floor(v / resolution_));
+  }
+
+  static int64_t toKey(const int32_t x_idx, const int32_t y_idx)
+  {
+    return (static_cast<int64_t>(x_idx) << 32) | static_cast<uint32_t>(y_idx);
+  }
+
+  double resolution_{1.0};
+  std::unordered_map<int64_t, std::vector<Point2d>> cells_;
+};
+}  // namespace obstacle_collision_checker
+
+#endif  // OBSTACLE_COLLISION_CHECKER__UTIL__OBSTACLE_POINT_GRID_HPP_
@@ -54,22 +54,18 @@ pcl::PointCloud<pcl::PointXYZ> getTransformedPointCloud(
   return transformed_pointcloud;
 }
 
-pcl::PointCloud<pcl::PointXYZ> filterPointCloudByTrajectory(
-  const pcl::PointCloud<pcl::PointXYZ> & pointcloud,
-  const autoware_auto_planning_msgs::msg::Trajectory & trajectory, const double radius)
+bool isNearTrajectory(
+  const double x, const double y, const autoware_auto_planning_msgs::msg::Trajectory & trajectory,
+  const double radius)
 {
-  pcl::PointCloud<pcl::PointXYZ> filtered_pointcloud;
-  for (const auto & point : pointcloud.points) {
-    for (const auto & trajectory_point : trajectory.points) {
-      const double dx = trajectory_point.pose.position.x - point.x;
-      const double dy = trajectory_point.pose.position.y - point.y;
-      if (std::hypot(dx, dy) < radius) {
-        filtered_pointcloud.points.push_back(point);
-        break;
-      }
+  for (const auto & trajectory_point : trajectory.points) {
+    const double dx = trajectory_point.pose.position.x - x;
+    const double dy = trajectory_point.pose.position.y - y;
+    if (std::hypot(dx, dy) < radius) {
+      return true;
     }
   }
-  return filtered_pointcloud;
+  return false;
 }
 
 double calcBrakingDistance(
@@ -80,6 +76,10 @@ double calcBrakingDistance(
   return idling_distance + braking_distance;
 }
 
+// size of the cells the obstacle points are bucketed by, which only changes the number of the
+// points looked at for each footprint and not the result
+constexpr double obstacle_grid_resolution = 1.0;
+
 }  // namespace
 
 namespace obstacle_collision_checker
@@ -104,11 +104,17 @@ Output ObstacleCollisionChecker::update(const Input & input)
     resampleTrajectory(*input.predicted_trajectory, param_.resample_interval), braking_distance);
   output.processing_time_map["resampleTrajectory"] = stop_watch.toc(true);
 
-  // resample pointcloud
-  const auto obstacle_pointcloud =
-    getTransformedPointCloud(*input.obstacle_pointcloud, input.obstacle_transform->transform);
-  const auto filtered_obstacle_pointcloud = filterPointCloudByTrajectory(
-    obstacle_pointcloud, output.resampled_trajectory, param_.search_radius);
+  // transform and index pointcloud, once per message as the transform is looked up at its stamp
+  if (
+    input.obstacle_pointcloud != obstacle_pointcloud_msg_ ||
+    input.obstacle_transform->transform != obstacle_transform_) {
+    obstacle_pointcloud_msg_ = input.obstacle_pointcloud;
+    obstacle_transform_ = input.obstacle_transform->transform;
+    obstacle_point_grid_ = ObstaclePointGrid(
+      getTransformedPointCloud(*obstacle_pointcloud_msg_, obstacle_transform_),
+      obstacle_grid_resolution);
+  }
+  output.processing_time_map["updateObstaclePointGrid"] = stop_watch.toc(true);
 
   output.vehicle_footprints =
     createVehicleFootprints(output.resampled_trajectory, param_, vehicle_info_);
@@ -117,7 +123,9 @@ Output ObstacleCollisionChecker::update(const Input & input)
   output.vehicle_passing_areas = createVehiclePassingAreas(output.vehicle_footprints);
   output.processing_time_map["createVehiclePassingAreas"] = stop_watch.toc(true);
 
-  output.will_collide = willCollide(filtered_obstacle_pointcloud, output.vehicle_passing_areas);
+  output.will_collide = willCollide(
+    obstacle_point_grid_, output.resampled_trajectory, param_.search_radius,
+    output.vehicle_passing_areas);
   output.processing_time_map["willCollide"] = stop_watch.toc(true);
 
   return output;
@@ -236,11 +244,12 @@ LinearRing2d ObstacleCollisionChecker::createHullFromFootprints(
 }
 
 bool ObstacleCollisionChecker::willCollide(
-  const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
+  const ObstaclePointGrid & obstacle_point_grid,
+  const autoware_auto_planning_msgs::msg::Trajectory & trajectory, const double search_radius,
   const std::vector<LinearRing2d> & vehicle_footprints)
 {
   for (const auto & vehicle_footprint : vehicle_footprints) {
-    if (hasCollision(obstacle_pointcloud, vehicle_footprint)) {
+    if (hasCollision(obstacle_point_grid, trajectory, search_radius, vehicle_footprint)) {
       RCLCPP_WARN(
         rclcpp::get_logger("obstacle_collision_checker"), "ObstacleCollisionChecker::willCollide");
       return true;
@@ -251,19 +260,23 @@ bool ObstacleCollisionChecker::willCollide(
 }
 
 bool ObstacleCollisionChecker::hasCollision(
-  const pcl::PointCloud<pcl::PointXYZ> & obstacle_pointcloud,
+  const ObstaclePointGrid & obstacle_point_grid,
+  const autoware_auto_planning_msgs::msg::Trajectory & trajectory, const double search_radius,
   const LinearRing2d & vehicle_footprint)
 {
-  for (const auto & point : obstacle_pointcloud) {
-    if (boost::geometry::within(
-          tier4_autoware_utils::Point2d{point.x, point.y}, vehicle_footprint)) {
+  const auto envelope = boost::geometry::return_envelope<tier4_autoware_utils::Box2d>(
+    vehicle_footprint);
+  return obstacle_point_grid.anyOfPointsInBox(
+    envelope, [&](const tier4_autoware_utils::Point2d & point) {
+      if (
+        !boost::geometry::within(point, vehicle_footprint) ||
+        !isNearTrajectory(point.x(), point.y(), trajectory, search_radius)) {
+        return false;
+      }
       RCLCPP_WARN(
         rclcpp::get_logger("obstacle_collision_checker"),
-        "[ObstacleCollisionChecker] Collide to Point x: %f y: %f", point.x, point.y);
+        "[ObstacleCollisionChecker] Collide to Point x: %f y: %f", point.x(), point.y());
       return true;
-    }
-  }
-
-  return false;
+    });
 }
 }  // namespace obstacle_collision_checker
@@ -15,7 +15,9 @@
 #include "../src/obstacle_collision_checker_node/obstacle_collision_checker.cpp"  // NOLINT
 #include "gtest/gtest.h"
 
-TEST(test_obstacle_collision_checker, filterPointCloudByTrajectory)
+#include <random>
+
+TEST(test_obstacle_collision_checker, isNearTrajectory)
 {
   pcl::PointCloud<pcl::PointXYZ> pcl;
   autoware_auto_planning_msgs::msg::Trajectory trajectory;
@@ -29,18 +31,55 @@ TEST(test_obstacle_collision_checker, filterPointCloudByTrajectory)
     trajectory.points.push_back(traj_point);
     pcl.push_back(pcl_point);
   }
-  // radius < 1: all points are filtered
+  // radius < 1: no point is near
   for (auto radius = 0.0; radius <= 0.99; radius += 0.1) {
-    const auto filtered_pcl = filterPointCloudByTrajectory(pcl, trajectory, radius);
-    EXPECT_EQ(filtered_pcl.size(), 0ul);
+    for (const auto & p : pcl) {
+      EXPECT_FALSE(isNearTrajectory(p.x, p.y, trajectory, radius));
+    }
   }
-  // radius >= 1.0: all points are kept
+  // radius >= 1.0: all points are near
   for (auto radius = 1.0; radius < 10.0; radius += 0.1) {
-    const auto filtered_pcl = filterPointCloudByTrajectory(pcl, trajectory, radius);
-    ASSERT_EQ(pcl.size(), filtered_pcl.size());
-    for (size_t i = 0; i < pcl.size(); ++i) {
-      EXPECT_EQ(pcl[i].x, filtered_pcl[i].x);
-      EXPECT_EQ(pcl[i].y, filtered_pcl[i].y);
+    for (const auto & p : pcl) {
+      EXPECT_TRUE(isNearTrajectory(p.x, p.y, trajectory, radius));
+    }
+  }
+}
+
+TEST(test_obstacle_collision_checker, ObstaclePointGrid)
+{
+  using obstacle_collision_checker::ObstaclePointGrid;
+  using tier4_autoware_utils::Box2d;
+  using tier4_autoware_utils::Point2d;
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> dist(-20.0, 20.0);
+
+  pcl::PointCloud<pcl::PointXYZ> pcl;
+  for (size_t i = 0; i < 1000; ++i) {
+    pcl.push_back(pcl::PointXYZ(dist(engine), dist(engine), 0.0));
+  }
+
+  EXPECT_FALSE(ObstaclePointGrid().anyOfPointsInBox(
+    Box2d{{-1.0, -1.0}, {1.0, 1.0}}, [](const Point2d &) { return true; }));
+
+  for (const double resolution : {0.3, 1.0, 7.0}) {
+    const ObstaclePointGrid grid(pcl, resolution);
+    for (size_t i = 0; i < 100; ++i) {
+      const double x = dist(engine);
+      const double y = dist(engine);
+      const Box2d box{{x, y}, {x + 3.0, y + 2.0}};
+
+      // all the points in the box are visited
+      size_t num_in_box = 0;
+      grid.anyOfPointsInBox(box, [&](const Point2d & p) {
+        num_in_box += boost::geometry::covered_by(p, box) ? 1 : 0;
+        return false;
+      });
+      size_t expected_num_in_box = 0;
+      for (const auto & p : pcl) {
+        expected_num_in_box += boost::geometry::covered_by(Point2d{p.x, p.y}, box) ? 1 : 0;
+      }
+      EXPECT_EQ(num_in_box, expected_num_in_box);
     }
   }
 }
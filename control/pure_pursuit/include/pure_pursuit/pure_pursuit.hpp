@@ -47,7 +47,10 @@ namespace pure_pursuit
 class PurePursuit
 {
 public:
-  PurePursuit() : lookahead_distance_(0.0), clst_thr_dist_(3.0), clst_thr_ang_(M_PI / 4) {}
+  PurePursuit()
+  : lookahead_distance_(0.0), clst_thr_dist_(3.0), clst_thr_ang_(M_PI / 4), prev_clst_idx_(-1)
+  {
+  }
   ~PurePursuit() = default;
 
   rclcpp::Logger logger = rclcpp::get_logger("pure_pursuit");
@@ -78,6 +81,9 @@ private:
   std::shared_ptr<std::vector<geometry_msgs::msg::Pose>> curr_wps_ptr_;
   std::shared_ptr<geometry_msgs::msg::Pose> curr_pose_ptr_;
 
+  // closest waypoint index of the previous cycle to search the closest waypoint from
+  int32_t prev_clst_idx_;
+
   // functions
   int32_t findNextPointIdx(int32_t search_start_idx);
   std::pair<bool, geometry_msgs::msg::Point> lerpNextTarget(int32_t next_wp_idx);
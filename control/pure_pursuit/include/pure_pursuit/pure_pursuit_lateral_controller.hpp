@@ -83,6 +83,7 @@ private:
   tier4_autoware_utils::SelfPoseListener self_pose_listener_;
 
   autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr trajectory_;
+  std::vector<geometry_msgs::msg::Pose> trajectory_poses_;
   nav_msgs::msg::Odometry::ConstSharedPtr current_odometry_;
   autoware_auto_vehicle_msgs::msg::SteeringReport::ConstSharedPtr current_steering_;
 
@@ -119,7 +120,10 @@ private:
   std::unique_ptr<PurePursuit> pure_pursuit_;
 
   boost::optional<double> calcTargetCurvature();
-  boost::optional<autoware_auto_planning_msgs::msg::TrajectoryPoint> calcTargetPoint() const;
+  boost::optional<autoware_auto_planning_msgs::msg::TrajectoryPoint> calcTargetPoint();
+
+  // closest point index of the previous cycle to search the closest point from
+  int32_t closest_idx_{-1};
 
   // Debug
   mutable DebugData debug_data_;
@@ -70,6 +70,12 @@ std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
   const std::vector<geometry_msgs::msg::Pose> & poses,
   const geometry_msgs::msg::Pose & current_pose, const double th_dist = 3.0,
   const double th_yaw = M_PI_2);
+// search locally around the closest point index of the previous cycle at first, and over all the
+// poses only if the nearest point there doesn't satisfy the thresholds
+std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
+  const std::vector<geometry_msgs::msg::Pose> & poses,
+  const geometry_msgs::msg::Pose & current_pose, const double th_dist, const double th_yaw,
+  const int32_t prev_idx);
 
 int8_t getLaneDirection(const std::vector<geometry_msgs::msg::Pose> & poses, double th_dist = 0.5);
 bool isDirectionForward(
@@ -103,6 +103,11 @@ bool PurePursuitLateralController::isDataReady()
 
 void PurePursuitLateralController::setInputData(InputData const & input_data)
 {
+  // Extract the poses only from a new trajectory
+  if (input_data.current_trajectory_ptr && input_data.current_trajectory_ptr != trajectory_) {
+    trajectory_poses_ = planning_utils::extractPoses(*input_data.current_trajectory_ptr);
+    pure_pursuit_->setWaypoints(trajectory_poses_);
+  }
   trajectory_ = input_data.current_trajectory_ptr;
   current_odometry_ = input_data.current_odometry_ptr;
   current_steering_ = input_data.current_steering_ptr;
@@ -183,7 +188,6 @@ boost::optional<double> PurePursuitLateralController::calcTargetCurvature()
 
   // Set PurePursuit data
   pure_pursuit_->setCurrentPose(current_pose_->pose);
-  pure_pursuit_->setWaypoints(planning_utils::extractPoses(*trajectory_));
   pure_pursuit_->setLookaheadDistance(lookahead_distance);
 
   // Run PurePursuit
@@ -201,10 +205,11 @@ boost::optional<double> PurePursuitLateralController::calcTargetCurvature()
 }
 
 boost::optional<autoware_auto_planning_msgs::msg::TrajectoryPoint>
-PurePursuitLateralController::calcTargetPoint() const
+PurePursuitLateralController::calcTargetPoint()
 {
   const auto closest_idx_result = planning_utils::findClosestIdxWithDistAngThr(
-    planning_utils::extractPoses(*trajectory_), current_pose_->pose, 3.0, M_PI_4);
+    trajectory_poses_, current_pose_->pose, 3.0, M_PI_4, closest_idx_);
+  closest_idx_ = closest_idx_result.second;
 
   if (!closest_idx_result.first) {
     RCLCPP_ERROR(node_->get_logger(), "cannot find closest waypoint");
@@ -128,6 +128,8 @@ void PurePursuitNode::onTrajectory(
   const autoware_auto_planning_msgs::msg::Trajectory::ConstSharedPtr msg)
 {
   trajectory_ = msg;
+  trajectory_poses_ = planning_utils::extractPoses(*trajectory_);
+  pure_pursuit_->setWaypoints(trajectory_poses_);
 }
 
 void PurePursuitNode::onTimer()
@@ -195,7 +197,6 @@ boost::optional<double> PurePursuitNode::calcTargetCurvature()
 
   // Set PurePursuit data
   pure_pursuit_->setCurrentPose(current_pose_->pose);
-  pure_pursuit_->setWaypoints(planning_utils::extractPoses(*trajectory_));
   pure_pursuit_->setLookaheadDistance(lookahead_distance);
 
   // Run PurePursuit
@@ -213,10 +214,11 @@ boost::optional<double> PurePursuitNode::calcTargetCurvature()
 }
 
 boost::optional<autoware_auto_planning_msgs::msg::TrajectoryPoint>
-PurePursuitNode::calcTargetPoint() const
+PurePursuitNode::calcTargetPoint()
 {
   const auto closest_idx_result = planning_utils::findClosestIdxWithDistAngThr(
-    planning_utils::extractPoses(*trajectory_), current_pose_->pose, 3.0, M_PI_4);
+    trajectory_poses_, current_pose_->pose, 3.0, M_PI_4, closest_idx_);
+  closest_idx_ = closest_idx_result.second;
 
   if (!closest_idx_result.first) {
     RCLCPP_ERROR(get_logger(), "cannot find closest waypoint");
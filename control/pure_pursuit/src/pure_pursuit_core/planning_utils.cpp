@@ -105,13 +105,13 @@ std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
   double dist_squared_min = std::numeric_limits<double>::max();
   int32_t idx_min = -1;
 
+  const double yaw_pose = tf2::getYaw(current_pose.orientation);
   for (size_t i = 0; i < poses.size(); ++i) {
     const double ds = calcDistSquared2D(poses.at(i).position, current_pose.position);
     if (ds > th_dist * th_dist) {
       continue;
     }
 
-    const double yaw_pose = tf2::getYaw(current_pose.orientation);
     const double yaw_ps = tf2::getYaw(poses.at(i).orientation);
     const double yaw_diff = normalizeEulerAngle(yaw_pose - yaw_ps);
     if (fabs(yaw_diff) > th_yaw) {
@@ -127,6 +127,36 @@ std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
   return (idx_min >= 0) ? std::make_pair(true, idx_min) : std::make_pair(false, idx_min);
 }
 
+std::pair<bool, int32_t> findClosestIdxWithDistAngThr(
+  const std::vector<geometry_msgs::msg::Pose> & poses,
+  const geometry_msgs::msg::Pose & current_pose, double th_dist, double th_yaw, int32_t prev_idx)
+{
+  if (prev_idx < 0 || static_cast<size_t>(prev_idx) >= poses.size()) {
+    return findClosestIdxWithDistAngThr(poses, current_pose, th_dist, th_yaw);
+  }
+
+  // descend the distance from the previous closest point, which moves forward by as many points
+  // as the ego passes, so the search costs O(1) amortized per cycle
+  const auto calc_dist_squared = [&](const size_t i) {
+    return calcDistSquared2D(poses.at(i).position, current_pose.position);
+  };
+  size_t idx = prev_idx;
+  double ds = calc_dist_squared(idx);
+  while (idx + 1 < poses.size() && calc_dist_squared(idx + 1) < ds) {
+    ds = calc_dist_squared(++idx);
+  }
+  while (idx > 0 && calc_dist_squared(idx - 1) < ds) {
+    ds = calc_dist_squared(--idx);
+  }
+
+  const double yaw_diff = normalizeEulerAngle(
+    tf2::getYaw(current_pose.orientation) - tf2::getYaw(poses.at(idx).orientation));
+  if (ds > th_dist * th_dist || fabs(yaw_diff) > th_yaw) {
+    return findClosestIdxWithDistAngThr(poses, current_pose, th_dist, th_yaw);
+  }
+  return std::make_pair(true, static_cast<int32_t>(idx));
+}
+
 int8_t getLaneDirection(const std::vector<geometry_msgs::msg::Pose> & poses, double th_dist)
 {
   if (poses.size() < 2) {
@@ -56,7 +56,8 @@ std::pair<bool, double> PurePursuit::run()
   }
 
   auto clst_pair = planning_utils::findClosestIdxWithDistAngThr(
-    *curr_wps_ptr_, *curr_pose_ptr_, clst_thr_dist_, clst_thr_ang_);
+    *curr_wps_ptr_, *curr_pose_ptr_, clst_thr_dist_, clst_thr_ang_, prev_clst_idx_);
+  prev_clst_idx_ = clst_pair.second;
 
   if (!clst_pair.first) {
     RCLCPP_WARN(
@@ -155,6 +156,7 @@ int32_t PurePursuit::findNextPointIdx(int32_t search_start_idx)
   }
 
   // look for the next waypoint.
+  const auto gld = planning_utils::getLaneDirection(*curr_wps_ptr_, 0.05);
   for (int32_t i = search_start_idx; i < (int32_t)curr_wps_ptr_->size(); i++) {
     // if search waypoint is the last
     if (i == ((int32_t)curr_wps_ptr_->size() - 1)) {
@@ -162,7 +164,6 @@ int32_t PurePursuit::findNextPointIdx(int32_t search_start_idx)
     }
 
     // if waypoint direction is forward
-    const auto gld = planning_utils::getLaneDirection(*curr_wps_ptr_, 0.05);
     if (gld == 0) {
       // if waypoint is not in front of ego, skip
       auto ret = planning_utils::transformToRelativeCoordinate2D(
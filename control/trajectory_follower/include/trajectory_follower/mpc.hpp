@@ -183,12 +183,17 @@ private:
   std::vector<autoware_auto_control_msgs::msg::AckermannLateralCommand> m_ctrl_cmd_vec;
   //!< @brief minimum prediction distance
   float64_t m_min_prediction_length = 5.0;
+  //!< @brief points of the reference trajectory, for the nearest index search
+  std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint> m_ref_traj_points;
+  //!< @brief yaw of the reference trajectory converted to be monotonic, with the end point added
+  //!< by applyVelocityDynamicsFilter(), for the resampling by time
+  std::vector<float64_t> m_ref_traj_monotonic_yaw;
 
   /**
    * @brief get variables for mpc calculation
    */
   bool8_t getData(
-    const trajectory_follower::MPCTrajectory & traj,
+    const trajectory_follower::MPCTrajectory & traj, const size_t nearest_idx,
     const autoware_auto_vehicle_msgs::msg::SteeringReport & current_steer,
     const geometry_msgs::msg::Pose & current_pose, MPCData * data);
   /**
@@ -249,15 +254,15 @@ private:
    * @brief apply velocity dynamics filter with v0 from closest index
    */
   trajectory_follower::MPCTrajectory applyVelocityDynamicsFilter(
-    const trajectory_follower::MPCTrajectory & trajectory,
-    const geometry_msgs::msg::Pose & current_pose, const float64_t v0) const;
+    const trajectory_follower::MPCTrajectory & trajectory, const size_t nearest_idx,
+    const float64_t v0) const;
   /**
    * @brief get prediction delta time of mpc.
    * If trajectory length is shorter than min_prediction length, adjust delta time.
    */
   float64_t getPredictionDeletaTime(
     const float64_t start_time, const trajectory_follower::MPCTrajectory & input,
-    const geometry_msgs::msg::Pose & current_pose) const;
+    const size_t nearest_idx) const;
   /**
    * @brief add weights related to lateral_jerk, steering_rate, steering_acc into R
    */
@@ -118,6 +118,18 @@ TRAJECTORY_FOLLOWER_PUBLIC bool8_t resampleMPCTrajectoryByDistance(
 TRAJECTORY_FOLLOWER_PUBLIC bool8_t linearInterpMPCTrajectory(
   const std::vector<float64_t> & in_index, const MPCTrajectory & in_traj,
   const std::vector<float64_t> & out_index, MPCTrajectory * out_traj);
+/**
+ * @brief linearly interpolate the given trajectory at the desired relative times, as
+ * linearInterpMPCTrajectory() with its relative times as indexing, but with the yaw already
+ * converted to be monotonic and by a single search from the point before the front time
+ * @param [in] in_traj MPCTrajectory to interpolate
+ * @param [in] in_monotonic_yaw yaw of in_traj converted by convertEulerAngleToMonotonic()
+ * @param [in] out_time desired interpolated relative times, monotonically increasing
+ * @param [out] out_traj resulting interpolated MPCTrajectory
+ */
+TRAJECTORY_FOLLOWER_PUBLIC bool8_t linearInterpMPCTrajectoryByTime(
+  const MPCTrajectory & in_traj, const std::vector<float64_t> & in_monotonic_yaw,
+  const std::vector<float64_t> & out_time, MPCTrajectory * out_traj);
 /**
  * @brief fill the relative_time field of the given MPCTrajectory
  * @param [in] traj MPCTrajectory for which to fill in the relative_time
@@ -178,6 +190,19 @@ TRAJECTORY_FOLLOWER_PUBLIC bool8_t calcNearestPoseInterp(
   geometry_msgs::msg::Pose * nearest_pose, size_t * nearest_index, float64_t * nearest_time,
   const double max_dist, const double max_yaw, const rclcpp::Logger & logger,
   rclcpp::Clock & clock);
+/**
+ * @brief calculate nearest pose on MPCTrajectory with linear interpolation around the nearest
+ * index already found
+ * @param [in] traj reference trajectory
+ * @param [in] self_pose object pose
+ * @param [in] nearest_index path index of nearest pose
+ * @param [out] nearest_pose nearest pose on path
+ * @param [out] nearest_time time of nearest pose on trajectory
+ * @return false when nearest pose couldn't find for some reasons
+ */
+TRAJECTORY_FOLLOWER_PUBLIC bool8_t calcNearestPoseInterp(
+  const MPCTrajectory & traj, const geometry_msgs::msg::Pose & self_pose,
+  const size_t nearest_index, geometry_msgs::msg::Pose * nearest_pose, float64_t * nearest_time);
 // /**
 //  * @brief calculate distance to stopped point
 //  */
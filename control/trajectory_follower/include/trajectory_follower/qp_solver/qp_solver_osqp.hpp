@@ -38,8 +38,10 @@ class TRAJECTORY_FOLLOWER_PUBLIC QPSolverOSQP : public QPSolverInterface
 public:
   /**
    * @brief constructor
+   * @param [in] enable_warm_start keep the workspace of the previous problem, whose values are
+   *             updated when the problem has the same size, and start from its solution
    */
-  explicit QPSolverOSQP(const rclcpp::Logger & logger);
+  explicit QPSolverOSQP(const rclcpp::Logger & logger, const bool8_t enable_warm_start = false);
 
   /**
    * @brief destructor
@@ -66,6 +68,7 @@ public:
 private:
   autoware::common::osqp::OSQPInterface osqpsolver_;
   rclcpp::Logger logger_;
+  bool8_t enable_warm_start_;
 };
 }  // namespace trajectory_follower
 }  // namespace control
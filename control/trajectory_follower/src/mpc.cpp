@@ -45,12 +45,20 @@ bool8_t MPC::calculateMPC(
   autoware_auto_planning_msgs::msg::Trajectory & predicted_traj,
   autoware_auto_system_msgs::msg::Float32MultiArrayDiagnostic & diagnostic)
 {
+  /* search the nearest index once, as the trajectory filtered below only differs from the
+   * reference one in the velocities and in the end point, which is added again */
+  size_t nearest_idx = 0;
+  if (!m_ref_traj_points.empty()) {
+    nearest_idx = motion_utils::findFirstNearestIndexWithSoftConstraints(
+      m_ref_traj_points, current_pose, ego_nearest_dist_threshold, ego_nearest_yaw_threshold);
+  }
+
   /* recalculate velocity from ego-velocity with dynamics */
   trajectory_follower::MPCTrajectory reference_trajectory =
-    applyVelocityDynamicsFilter(m_ref_traj, current_pose, current_velocity);
+    applyVelocityDynamicsFilter(m_ref_traj, nearest_idx, current_velocity);
 
   MPCData mpc_data;
-  if (!getData(reference_trajectory, current_steer, current_pose, &mpc_data)) {
+  if (!getData(reference_trajectory, nearest_idx, current_steer, current_pose, &mpc_data)) {
     RCLCPP_WARN_THROTTLE(m_logger, *m_clock, 1000 /*ms*/, "fail to get Data.");
     return false;
   }
@@ -70,7 +78,7 @@ bool8_t MPC::calculateMPC(
   trajectory_follower::MPCTrajectory mpc_resampled_ref_traj;
   const float64_t mpc_start_time = mpc_data.nearest_time + m_param.input_delay;
   const float64_t prediction_dt =
-    getPredictionDeletaTime(mpc_start_time, reference_trajectory, current_pose);
+    getPredictionDeletaTime(mpc_start_time, reference_trajectory, nearest_idx);
   if (!resampleMPCTrajectoryByTime(
         mpc_start_time, prediction_dt, reference_trajectory, &mpc_resampled_ref_traj)) {
     RCLCPP_WARN_THROTTLE(m_logger, *m_clock, 1000 /*ms*/, "trajectory resampling failed.");
@@ -248,6 +256,17 @@ void MPC::setReferenceTrajectory(
   }
 
   m_ref_traj = mpc_traj_smoothed;
+
+  /* prepare the reference for the queries of each control cycle */
+  {
+    autoware_auto_planning_msgs::msg::Trajectory autoware_traj;
+    trajectory_follower::MPCUtils::convertToAutowareTrajectory(m_ref_traj, autoware_traj);
+    m_ref_traj_points = std::move(autoware_traj.points);
+
+    m_ref_traj_monotonic_yaw = m_ref_traj.yaw;
+    m_ref_traj_monotonic_yaw.push_back(m_ref_traj.yaw.back());
+    trajectory_follower::MPCUtils::convertEulerAngleToMonotonic(&m_ref_traj_monotonic_yaw);
+  }
 }
 
 void MPC::resetPrevResult(const autoware_auto_vehicle_msgs::msg::SteeringReport & current_steer)
@@ -257,15 +276,13 @@ void MPC::resetPrevResult(const autoware_auto_vehicle_msgs::msg::SteeringReport
 }
 
 bool8_t MPC::getData(
-  const trajectory_follower::MPCTrajectory & traj,
+  const trajectory_follower::MPCTrajectory & traj, const size_t nearest_idx,
   const autoware_auto_vehicle_msgs::msg::SteeringReport & current_steer,
   const geometry_msgs::msg::Pose & current_pose, MPCData * data)
 {
   static constexpr auto duration = 5000 /*ms*/;
-  size_t nearest_idx;
   if (!trajectory_follower::MPCUtils::calcNearestPoseInterp(
-        traj, current_pose, &(data->nearest_pose), &(nearest_idx), &(data->nearest_time),
-        ego_nearest_dist_threshold, ego_nearest_yaw_threshold, m_logger, *m_clock)) {
+        traj, current_pose, nearest_idx, &(data->nearest_pose), &(data->nearest_time))) {
     // reset previous MPC result
     // Note: When a large deviation from the trajectory occurs, the optimization stops and
     // the vehicle will return to the path by re-planning the trajectory or external operation.
@@ -408,8 +425,14 @@ bool8_t MPC::resampleMPCTrajectoryByTime(
   for (float64_t i = 0; i < static_cast<float64_t>(m_param.prediction_horizon); ++i) {
     mpc_time_v.push_back(ts + i * prediction_dt);
   }
-  if (!trajectory_follower::MPCUtils::linearInterpMPCTrajectory(
-        input.relative_time, input, mpc_time_v, output)) {
+  // the yaw is converted once for the trajectories filtered from the reference one
+  const bool8_t is_interpolated =
+    input.size() == m_ref_traj_monotonic_yaw.size()
+      ? trajectory_follower::MPCUtils::linearInterpMPCTrajectoryByTime(
+          input, m_ref_traj_monotonic_yaw, mpc_time_v, output)
+      : trajectory_follower::MPCUtils::linearInterpMPCTrajectory(
+          input.relative_time, input, mpc_time_v, output);
+  if (!is_interpolated) {
     RCLCPP_WARN_SKIPFIRST_THROTTLE(
       m_logger, *m_clock, 1000 /*ms*/,
       "calculateMPC: mpc resample error. stop mpc calculation. check code!");
@@ -487,19 +510,13 @@ bool8_t MPC::updateStateForDelayCompensation(
 }
 
 trajectory_follower::MPCTrajectory MPC::applyVelocityDynamicsFilter(
-  const trajectory_follower::MPCTrajectory & input, const geometry_msgs::msg::Pose & current_pose,
+  const trajectory_follower::MPCTrajectory & input, const size_t nearest_idx,
   const float64_t v0) const
 {
-  autoware_auto_planning_msgs::msg::Trajectory autoware_traj;
-  autoware::motion::control::trajectory_follower::MPCUtils::convertToAutowareTrajectory(
-    input, autoware_traj);
-  if (autoware_traj.points.empty()) {
+  if (input.empty()) {
     return input;
   }
 
-  const size_t nearest_idx = motion_utils::findFirstNearestIndexWithSoftConstraints(
-    autoware_traj.points, current_pose, ego_nearest_dist_threshold, ego_nearest_yaw_threshold);
-
   const float64_t acc_lim = m_param.acceleration_limit;
   const float64_t tau = m_param.velocity_time_constant;
 
@@ -594,13 +611,14 @@ MPCMatrix MPC::generateMPCMatrix(
       m.Bex.block(0, 0, DIM_X, DIM_U) = Bd;
       m.Wex.block(0, 0, DIM_X, 1) = Wd;
     } else {
-      m.Aex.block(idx_x_i, 0, DIM_X, DIM_X) = Ad * m.Aex.block(idx_x_i_prev, 0, DIM_X, DIM_X);
-      for (int64_t j = 0; j < i; ++j) {
-        int64_t idx_u_j = j * DIM_U;
-        m.Bex.block(idx_x_i, idx_u_j, DIM_X, DIM_U) =
-          Ad * m.Bex.block(idx_x_i_prev, idx_u_j, DIM_X, DIM_U);
-      }
-      m.Wex.block(idx_x_i, 0, DIM_X, 1) = Ad * m.Wex.block(idx_x_i_prev, 0, DIM_X, 1) + Wd;
+      // the blocks of the step are propagated from the previous step, as Bex is block lower
+      // triangular. The blocks do not overlap, so that they are multiplied without a temporary.
+      m.Aex.block(idx_x_i, 0, DIM_X, DIM_X).noalias() =
+        Ad * m.Aex.block(idx_x_i_prev, 0, DIM_X, DIM_X);
+      m.Bex.block(idx_x_i, 0, DIM_X, idx_u_i).noalias() =
+        Ad * m.Bex.block(idx_x_i_prev, 0, DIM_X, idx_u_i);
+      m.Wex.block(idx_x_i, 0, DIM_X, 1).noalias() = Ad * m.Wex.block(idx_x_i_prev, 0, DIM_X, 1);
+      m.Wex.block(idx_x_i, 0, DIM_X, 1) += Wd;
     }
     m.Bex.block(idx_x_i, idx_u_i, DIM_X, DIM_U) = Bd;
     m.Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X) = Cd;
@@ -665,18 +683,44 @@ bool8_t MPC::executeOptimization(
     return false;
   }
 
-  const int64_t DIM_U_N = m_param.prediction_horizon * m_vehicle_model_ptr->getDimU();
+  const int64_t N = m_param.prediction_horizon;
+  const int64_t DIM_X = m_vehicle_model_ptr->getDimX();
+  const int64_t DIM_U = m_vehicle_model_ptr->getDimU();
+  const int64_t DIM_Y = m_vehicle_model_ptr->getDimY();
+  const int64_t DIM_U_N = N * DIM_U;
 
   // cost function: 1/2 * Uex' * H * Uex + f' * Uex,  H = B' * C' * Q * C * B + R
-  const MatrixXd CB = m.Cex * m.Bex;
-  const MatrixXd QCB = m.Qex * CB;
-  // MatrixXd H = CB.transpose() * QCB + m.R1ex + m.R2ex; // This calculation is heavy. looking for
-  // a good way.  //NOLINT
+  // Cex and Qex are block diagonal and Bex is block lower triangular, so that CB = Cex * Bex and
+  // QCB = Qex * CB are computed by the blocks of each step up to its input, and C * (A * x0 + W)
+  // by the states of each step.
+  MatrixXd CB = MatrixXd::Zero(DIM_Y * N, DIM_U_N);
+  MatrixXd QCB = MatrixXd::Zero(DIM_Y * N, DIM_U_N);
+  VectorXd CAW(DIM_Y * N);
+  const VectorXd AW = m.Aex * x0 + m.Wex;
+  for (int64_t i = 0; i < N; ++i) {
+    const int64_t idx_x_i = i * DIM_X;
+    const int64_t idx_y_i = i * DIM_Y;
+    const int64_t num_u = (i + 1) * DIM_U;
+    const auto C_i = m.Cex.block(idx_y_i, idx_x_i, DIM_Y, DIM_X);
+    const auto Q_i = m.Qex.block(idx_y_i, idx_y_i, DIM_Y, DIM_Y);
+    CB.block(idx_y_i, 0, DIM_Y, num_u).noalias() = C_i * m.Bex.block(idx_x_i, 0, DIM_X, num_u);
+    QCB.block(idx_y_i, 0, DIM_Y, num_u).noalias() = Q_i * CB.block(idx_y_i, 0, DIM_Y, num_u);
+    CAW.segment(idx_y_i, DIM_Y).noalias() = C_i * AW.segment(idx_x_i, DIM_X);
+  }
+
+  // the upper blocks (j, k), j <= k, of CB' * QCB are summed over the steps from k, where the
+  // blocks of QCB in the column k are not zero
   MatrixXd H = MatrixXd::Zero(DIM_U_N, DIM_U_N);
-  H.triangularView<Eigen::Upper>() = CB.transpose() * QCB;
+  for (int64_t k = 0; k < N; ++k) {
+    const int64_t idx_y_k = k * DIM_Y;
+    const int64_t num_y = (N - k) * DIM_Y;
+    H.block(0, k * DIM_U, (k + 1) * DIM_U, DIM_U).noalias() =
+      CB.block(idx_y_k, 0, num_y, (k + 1) * DIM_U).transpose() *
+      QCB.block(idx_y_k, k * DIM_U, num_y, DIM_U);
+  }
   H.triangularView<Eigen::Upper>() += m.R1ex + m.R2ex;
   H.triangularView<Eigen::Lower>() = H.transpose();
-  MatrixXd f = (m.Cex * (m.Aex * x0 + m.Wex)).transpose() * QCB - m.Uref_ex.transpose() * m.R1ex;
+  MatrixXd f = CAW.transpose() * QCB - m.Uref_ex.transpose() * m.R1ex;
   addSteerWeightF(prediction_dt, &f);
 
   MatrixXd A = MatrixXd::Identity(DIM_U_N, DIM_U_N);
@@ -785,14 +829,9 @@ void MPC::addSteerWeightF(const float64_t prediction_dt, Eigen::MatrixXd * f_ptr
 
 float64_t MPC::getPredictionDeletaTime(
   const float64_t start_time, const trajectory_follower::MPCTrajectory & input,
-  const geometry_msgs::msg::Pose & current_pose) const
+  const size_t nearest_idx) const
 {
   // Calculate the time min_prediction_length ahead from current_pose
-  autoware_auto_planning_msgs::msg::Trajectory autoware_traj;
-  autoware::motion::control::trajectory_follower::MPCUtils::convertToAutowareTrajectory(
-    input, autoware_traj);
-  const size_t nearest_idx = motion_utils::findFirstNearestIndexWithSoftConstraints(
-    autoware_traj.points, current_pose, ego_nearest_dist_threshold, ego_nearest_yaw_threshold);
   float64_t sum_dist = 0;
   const float64_t target_time = [&]() {
     const float64_t t_ext =
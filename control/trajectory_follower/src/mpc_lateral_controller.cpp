@@ -119,7 +119,10 @@ MpcLateralController::MpcLateralController(rclcpp::Node & node) : node_{&node}
   if (qp_solver_type == "unconstraint_fast") {
     qpsolver_ptr = std::make_shared<trajectory_follower::QPSolverEigenLeastSquareLLT>();
   } else if (qp_solver_type == "osqp") {
-    qpsolver_ptr = std::make_shared<trajectory_follower::QPSolverOSQP>(node_->get_logger());
+    const bool8_t enable_warm_start =
+      node_->declare_parameter<bool8_t>("qp_solver_enable_warm_start");
+    qpsolver_ptr =
+      std::make_shared<trajectory_follower::QPSolverOSQP>(node_->get_logger(), enable_warm_start);
   } else {
     RCLCPP_ERROR(node_->get_logger(), "qp_solver_type is undefined");
   }
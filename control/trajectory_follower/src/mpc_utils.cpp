@@ -150,6 +150,62 @@ bool8_t linearInterpMPCTrajectory(
   return true;
 }
 
+bool8_t linearInterpMPCTrajectoryByTime(
+  const MPCTrajectory & in_traj, const std::vector<float64_t> & in_monotonic_yaw,
+  const std::vector<float64_t> & out_time, MPCTrajectory * out_traj)
+{
+  if (!out_traj) {
+    return false;
+  }
+
+  if (in_traj.empty()) {
+    *out_traj = in_traj;
+    return true;
+  }
+
+  const auto & in_time = in_traj.relative_time;
+  if (
+    out_time.empty() || in_monotonic_yaw.size() != in_time.size() ||
+    !std::is_sorted(in_time.begin(), in_time.end()) ||
+    !std::is_sorted(out_time.begin(), out_time.end()) || out_time.front() < in_time.front() ||
+    in_time.back() < out_time.back()) {
+    std::cerr << "linearInterpMPCTrajectoryByTime error!" << std::endl;
+    return false;
+  }
+
+  // the points are searched as linearInterpolate() does from the front point, whose equal time
+  // is only taken as is for the current point of the search
+  const auto front_itr = std::lower_bound(in_time.begin(), in_time.end(), out_time.front());
+  size_t i = static_cast<size_t>(
+    std::max(std::distance(in_time.begin(), front_itr) - 1, std::ptrdiff_t{0}));
+
+  out_traj->clear();
+  for (const float64_t t : out_time) {
+    if (in_time.at(i) == t) {
+      out_traj->push_back(
+        in_traj.x.at(i), in_traj.y.at(i), in_traj.z.at(i), in_monotonic_yaw.at(i),
+        in_traj.vx.at(i), in_traj.k.at(i), in_traj.smooth_k.at(i), in_time.at(i));
+      continue;
+    }
+    while (in_time.at(i) < t) {
+      ++i;
+    }
+
+    const float64_t dist_base_idx = in_time.at(i) - in_time.at(i - 1);
+    const float64_t dist_to_forward = in_time.at(i) - t;
+    const float64_t dist_to_backward = t - in_time.at(i - 1);
+    const auto interpolate = [&](const std::vector<float64_t> & values) {
+      return (dist_to_backward * values.at(i) + dist_to_forward * values.at(i - 1)) /
+             dist_base_idx;
+    };
+    out_traj->push_back(
+      interpolate(in_traj.x), interpolate(in_traj.y), interpolate(in_traj.z),
+      interpolate(in_monotonic_yaw), interpolate(in_traj.vx), interpolate(in_traj.k),
+      interpolate(in_traj.smooth_k), interpolate(in_time));
+  }
+  return true;
+}
+
 void calcTrajectoryYawFromXY(MPCTrajectory * traj, const bool is_forward_shift)
 {
   if (traj->yaw.size() < 3) {  // at least 3 points are required to calculate yaw
@@ -317,13 +373,24 @@ bool8_t calcNearestPoseInterp(
 
   *nearest_index = motion_utils::findFirstNearestIndexWithSoftConstraints(
     autoware_traj.points, self_pose, max_dist, max_yaw);
+  return calcNearestPoseInterp(traj, self_pose, *nearest_index, nearest_pose, nearest_time);
+}
+
+bool8_t calcNearestPoseInterp(
+  const MPCTrajectory & traj, const geometry_msgs::msg::Pose & self_pose,
+  const size_t nearest_index, geometry_msgs::msg::Pose * nearest_pose, float64_t * nearest_time)
+{
+  if (nearest_index >= traj.size() || !nearest_pose || !nearest_time) {
+    return false;
+  }
+
   const size_t traj_size = traj.size();
 
   if (traj.size() == 1) {
-    nearest_pose->position.x = traj.x[*nearest_index];
-    nearest_pose->position.y = traj.y[*nearest_index];
-    nearest_pose->orientation = getQuaternionFromYaw(traj.yaw[*nearest_index]);
-    *nearest_time = traj.relative_time[*nearest_index];
+    nearest_pose->position.x = traj.x[nearest_index];
+    nearest_pose->position.y = traj.y[nearest_index];
+    nearest_pose->orientation = getQuaternionFromYaw(traj.yaw[nearest_index]);
+    *nearest_time = traj.relative_time[nearest_index];
     return true;
   }
 
@@ -336,40 +403,40 @@ bool8_t calcNearestPoseInterp(
 
   /* get second nearest index = next to nearest_index */
   const size_t next = static_cast<size_t>(
-    std::min(static_cast<int64_t>(*nearest_index) + 1, static_cast<int64_t>(traj_size) - 1));
+    std::min(static_cast<int64_t>(nearest_index) + 1, static_cast<int64_t>(traj_size) - 1));
   const size_t prev =
-    static_cast<size_t>(std::max(static_cast<int64_t>(*nearest_index) - 1, int64_t(0)));
+    static_cast<size_t>(std::max(static_cast<int64_t>(nearest_index) - 1, int64_t(0)));
   const float64_t dist_to_next = calcSquaredDist(self_pose, traj, next);
   const float64_t dist_to_prev = calcSquaredDist(self_pose, traj, prev);
   const size_t second_nearest_index = (dist_to_next < dist_to_prev) ? next : prev;
 
-  const float64_t a_sq = calcSquaredDist(self_pose, traj, *nearest_index);
+  const float64_t a_sq = calcSquaredDist(self_pose, traj, nearest_index);
   const float64_t b_sq = calcSquaredDist(self_pose, traj, second_nearest_index);
-  const float64_t dx3 = traj.x[*nearest_index] - traj.x[second_nearest_index];
-  const float64_t dy3 = traj.y[*nearest_index] - traj.y[second_nearest_index];
+  const float64_t dx3 = traj.x[nearest_index] - traj.x[second_nearest_index];
+  const float64_t dy3 = traj.y[nearest_index] - traj.y[second_nearest_index];
   const float64_t c_sq = dx3 * dx3 + dy3 * dy3;
 
   /* if distance between two points are too close */
   if (c_sq < 1.0E-5) {
-    nearest_pose->position.x = traj.x[*nearest_index];
-    nearest_pose->position.y = traj.y[*nearest_index];
-    nearest_pose->orientation = getQuaternionFromYaw(traj.yaw[*nearest_index]);
-    *nearest_time = traj.relative_time[*nearest_index];
+    nearest_pose->position.x = traj.x[nearest_index];
+    nearest_pose->position.y = traj.y[nearest_index];
+    nearest_pose->orientation = getQuaternionFromYaw(traj.yaw[nearest_index]);
+    *nearest_time = traj.relative_time[nearest_index];
     return true;
   }
 
   /* linear interpolation */
   const float64_t alpha = std::max(std::min(0.5 * (c_sq - a_sq + b_sq) / c_sq, 1.0), 0.0);
   nearest_pose->position.x =
-    alpha * traj.x[*nearest_index] + (1 - alpha) * traj.x[second_nearest_index];
+    alpha * traj.x[nearest_index] + (1 - alpha) * traj.x[second_nearest_index];
   nearest_pose->position.y =
-    alpha * traj.y[*nearest_index] + (1 - alpha) * traj.y[second_nearest_index];
+    alpha * traj.y[nearest_index] + (1 - alpha) * traj.y[second_nearest_index];
   const float64_t tmp_yaw_err = autoware::common::helper_functions::wrap_angle(
-    traj.yaw[*nearest_index] - traj.yaw[second_nearest_index]);
+    traj.yaw[nearest_index] - traj.yaw[second_nearest_index]);
   const float64_t nearest_yaw = autoware::common::helper_functions::wrap_angle(
     traj.yaw[second_nearest_index] + alpha * tmp_yaw_err);
   nearest_pose->orientation = getQuaternionFromYaw(nearest_yaw);
-  *nearest_time = alpha * traj.relative_time[*nearest_index] +
+  *nearest_time = alpha * traj.relative_time[nearest_index] +
                   (1 - alpha) * traj.relative_time[second_nearest_index];
   return true;
 }
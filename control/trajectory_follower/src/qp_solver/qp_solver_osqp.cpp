@@ -15,6 +15,7 @@
 #include "trajectory_follower/qp_solver/qp_solver_osqp.hpp"
 
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace autoware
@@ -25,7 +26,35 @@ namespace control
 {
 namespace trajectory_follower
 {
-QPSolverOSQP::QPSolverOSQP(const rclcpp::Logger & logger) : logger_{logger} {}
+namespace
+{
+// upper triangular part of the square matrix with its zeros, so that the sparsity pattern only
+// depends on the size of the matrix
+autoware::common::osqp::CSC_Matrix calcUpperTriangularCSCMatrix(const Eigen::MatrixXd & mat)
+{
+  const Eigen::Index cols = mat.cols();
+
+  autoware::common::osqp::CSC_Matrix csc_matrix;
+  csc_matrix.m_vals.reserve(static_cast<size_t>(cols * (cols + 1) / 2));
+  csc_matrix.m_row_idxs.reserve(static_cast<size_t>(cols * (cols + 1) / 2));
+  csc_matrix.m_col_idxs.reserve(static_cast<size_t>(cols + 1));
+
+  csc_matrix.m_col_idxs.push_back(0);
+  for (Eigen::Index j = 0; j < cols; ++j) {
+    for (Eigen::Index i = 0; i <= j; ++i) {
+      csc_matrix.m_vals.push_back(mat(i, j));
+      csc_matrix.m_row_idxs.push_back(static_cast<c_int>(i));
+    }
+    csc_matrix.m_col_idxs.push_back(static_cast<c_int>(csc_matrix.m_vals.size()));
+  }
+  return csc_matrix;
+}
+}  // namespace
+
+QPSolverOSQP::QPSolverOSQP(const rclcpp::Logger & logger, const bool8_t enable_warm_start)
+: logger_{logger}, enable_warm_start_{enable_warm_start}
+{
+}
 bool8_t QPSolverOSQP::solve(
   const Eigen::MatrixXd & h_mat, const Eigen::MatrixXd & f_vec, const Eigen::MatrixXd & a,
   const Eigen::VectorXd & lb, const Eigen::VectorXd & ub, const Eigen::VectorXd & lb_a,
@@ -56,7 +85,17 @@ bool8_t QPSolverOSQP::solve(
   osqpA << Identity, a;
 
   /* execute optimization */
-  auto result = osqpsolver_.optimize(h_mat, osqpA, f, lower_bound, upper_bound);
+  std::tuple<std::vector<float64_t>, std::vector<float64_t>, int64_t, int64_t, int64_t> result;
+  if (enable_warm_start_) {
+    // the workspace is set up again only when the sparsity pattern of the problem changes,
+    // otherwise OSQP keeps the previous solution and starts from it
+    osqpsolver_.updateProblem(
+      calcUpperTriangularCSCMatrix(h_mat), autoware::common::osqp::calCSCMatrix(osqpA), f,
+      lower_bound, upper_bound);
+    result = osqpsolver_.optimize();
+  } else {
+    result = osqpsolver_.optimize(h_mat, osqpA, f, lower_bound, upper_bound);
+  }
 
   std::vector<float64_t> U_osqp = std::get<0>(result);
   u = Eigen::Map<Eigen::Matrix<float64_t, Eigen::Dynamic, 1>>(
@@ -312,6 +312,38 @@ TEST_F(MPCTest, OsqpCalculateRightTurn)
   EXPECT_LT(ctrl_cmd.steering_tire_rotation_rate, 0.0f);
 }
 
+TEST_F(MPCTest, OsqpWarmStartCalculateRightTurn)
+{
+  trajectory_follower::MPC mpc;
+  initializeMPC(mpc);
+  mpc.setReferenceTrajectory(
+    dummy_right_turn_trajectory, traj_resample_dist, enable_path_smoothing,
+    path_filter_moving_ave_num, curvature_smoothing_num_traj, curvature_smoothing_num_ref_steer,
+    pose_zero_ptr);
+
+  const std::string vehicle_model_type = "kinematics";
+  std::shared_ptr<trajectory_follower::VehicleModelInterface> vehicle_model_ptr =
+    std::make_shared<trajectory_follower::KinematicsBicycleModel>(
+      wheelbase, steer_limit, steer_tau);
+  mpc.setVehicleModel(vehicle_model_ptr, vehicle_model_type);
+  ASSERT_TRUE(mpc.hasVehicleModel());
+
+  std::shared_ptr<trajectory_follower::QPSolverInterface> qpsolver_ptr =
+    std::make_shared<trajectory_follower::QPSolverOSQP>(logger, true);
+  mpc.setQPSolver(qpsolver_ptr);
+  ASSERT_TRUE(mpc.hasQPSolver());
+
+  // Calculate MPC, the second time with the workspace of the first one
+  AckermannLateralCommand ctrl_cmd;
+  Trajectory pred_traj;
+  Float32MultiArrayDiagnostic diag;
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_TRUE(
+      mpc.calculateMPC(neutral_steer, default_velocity, pose_zero, ctrl_cmd, pred_traj, diag));
+    EXPECT_LT(ctrl_cmd.steering_tire_angle, 0.0f);
+  }
+}
+
 TEST_F(MPCTest, KinematicsNoDelayCalculate)
 {
   trajectory_follower::MPC mpc;
@@ -88,4 +88,42 @@ TEST(TestMPC, CalcStopDistance)
   EXPECT_EQ(MPCUtils::calcStopDistance(trajectory_msg, 6), 0.0);
   EXPECT_EQ(MPCUtils::calcStopDistance(trajectory_msg, 7), -1.0);
 }
+
+TEST(TestMPC, LinearInterpMPCTrajectoryByTime)
+{
+  using autoware::motion::control::trajectory_follower::MPCTrajectory;
+
+  MPCTrajectory traj;
+  for (size_t i = 0; i < 10; ++i) {
+    const double t = 0.3 * static_cast<double>(i);
+    // the yaw wraps around between the points 4 and 5
+    const double yaw = i < 5 ? 2.8 + 0.1 * static_cast<double>(i) : -3.0 + 0.1 * (i - 5.0);
+    traj.push_back(1.0 * i, 0.5 * i, 0.0, yaw, 2.0, 0.01 * i, 0.02 * i, t);
+  }
+  std::vector<double> monotonic_yaw = traj.yaw;
+  MPCUtils::convertEulerAngleToMonotonic(&monotonic_yaw);
+
+  // the times include one of the points of the trajectory
+  const std::vector<double> out_time = {0.45, 0.6, 1.0, 1.35, 2.7};
+  MPCTrajectory expected;
+  ASSERT_TRUE(
+    MPCUtils::linearInterpMPCTrajectory(traj.relative_time, traj, out_time, &expected));
+  MPCTrajectory result;
+  ASSERT_TRUE(
+    MPCUtils::linearInterpMPCTrajectoryByTime(traj, monotonic_yaw, out_time, &result));
+
+  ASSERT_EQ(result.size(), expected.size());
+  for (size_t i = 0; i < result.size(); ++i) {
+    EXPECT_EQ(result.x[i], expected.x[i]);
+    EXPECT_EQ(result.y[i], expected.y[i]);
+    EXPECT_EQ(result.yaw[i], expected.yaw[i]);
+    EXPECT_EQ(result.vx[i], expected.vx[i]);
+    EXPECT_EQ(result.k[i], expected.k[i]);
+    EXPECT_EQ(result.smooth_k[i], expected.smooth_k[i]);
+    EXPECT_EQ(result.relative_time[i], expected.relative_time[i]);
+  }
+
+  // the times out of the trajectory
+  EXPECT_FALSE(MPCUtils::linearInterpMPCTrajectoryByTime(traj, monotonic_yaw, {3.0}, &result));
+}
 }  // namespace
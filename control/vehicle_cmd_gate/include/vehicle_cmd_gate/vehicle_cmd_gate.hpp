@@ -20,6 +20,7 @@
 #include <diagnostic_updater/diagnostic_updater.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <std_srvs/srv/trigger.hpp>
+#include <tier4_autoware_utils/system/latest_value_mailbox.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
 #include <autoware_auto_control_msgs/msg/ackermann_control_command.hpp>
@@ -29,6 +30,7 @@
 #include <autoware_auto_vehicle_msgs/msg/hazard_lights_command.hpp>
 #include <autoware_auto_vehicle_msgs/msg/steering_report.hpp>
 #include <autoware_auto_vehicle_msgs/msg/turn_indicators_command.hpp>
+#include <builtin_interfaces/msg/time.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 #include <tier4_control_msgs/msg/gate_mode.hpp>
 #include <tier4_debug_msgs/msg/bool_stamped.hpp>
@@ -39,7 +41,9 @@
 #include <tier4_system_msgs/msg/operation_mode.hpp>
 #include <tier4_vehicle_msgs/msg/vehicle_emergency_stamped.hpp>
 
+#include <atomic>
 #include <memory>
+#include <thread>
 
 namespace vehicle_cmd_gate
 {
@@ -63,6 +67,9 @@ using nav_msgs::msg::Odometry;
 using EngageMsg = autoware_auto_vehicle_msgs::msg::Engage;
 using EngageSrv = tier4_external_api_msgs::srv::Engage;
 
+template <class T>
+using Mailbox = tier4_autoware_utils::LatestValueMailbox<T>;
+
 struct Commands
 {
   AckermannControlCommand control;
@@ -75,12 +82,44 @@ struct Commands
   }
 };
 
+// latest commands of a source, written by the input callbacks and read by the gate
+struct CommandMailboxes
+{
+  Mailbox<AckermannControlCommand> control;
+  Mailbox<TurnIndicatorsCommand> turn_indicator;
+  Mailbox<HazardLightsCommand> hazard_light;
+  Mailbox<GearCommand> gear;
+  explicit CommandMailboxes(const uint8_t & default_gear = GearCommand::PARK)
+  : gear(Commands(default_gear).gear)
+  {
+  }
+  Commands read() const
+  {
+    Commands commands;
+    commands.control = control.read();
+    commands.turn_indicator = turn_indicator.read();
+    commands.hazard_light = hazard_light.read();
+    commands.gear = gear.read();
+    return commands;
+  }
+};
+
 class VehicleCmdGate : public rclcpp::Node
 {
 public:
   explicit VehicleCmdGate(const rclcpp::NodeOptions & node_options);
+  ~VehicleCmdGate() override;
 
 private:
+  // The control commands and the timers are run in the gate group, and the other inputs only
+  // write the mailboxes below. The group is spun by a thread of its own when
+  // use_dedicated_gate_thread is set, and by the executor of the node otherwise.
+  rclcpp::CallbackGroup::SharedPtr gate_callback_group_;
+  rclcpp::executors::SingleThreadedExecutor::SharedPtr gate_executor_;
+  std::thread gate_thread_;
+  std::atomic<bool> is_gate_thread_stopped_{false};
+  void spinGateThread(const int priority);
+
   // Publisher
   rclcpp::Publisher<VehicleEmergencyStamped>::SharedPtr vehicle_cmd_emergency_pub_;
   rclcpp::Publisher<AckermannControlCommand>::SharedPtr control_cmd_pub_;
@@ -103,25 +142,25 @@ private:
   void onExternalEmergencyStopHeartbeat(Heartbeat::ConstSharedPtr msg);
   void onSteering(SteeringReport::ConstSharedPtr msg);
 
-  bool is_engaged_;
-  bool is_system_emergency_ = false;
-  bool is_external_emergency_stop_ = false;
-  double current_steer_ = 0;
-  GateMode current_gate_mode_;
+  std::atomic<bool> is_engaged_;
+  std::atomic<bool> is_system_emergency_{false};
+  std::atomic<bool> is_external_emergency_stop_{false};
+  std::atomic<double> current_steer_{0.0};
+  Mailbox<GateMode> current_gate_mode_;
 
   // Heartbeat
-  std::shared_ptr<rclcpp::Time> emergency_state_heartbeat_received_time_;
+  Mailbox<builtin_interfaces::msg::Time> emergency_state_heartbeat_received_time_;
   bool is_emergency_state_heartbeat_timeout_ = false;
-  std::shared_ptr<rclcpp::Time> external_emergency_stop_heartbeat_received_time_;
-  bool is_external_emergency_stop_heartbeat_timeout_ = false;
+  Mailbox<builtin_interfaces::msg::Time> external_emergency_stop_heartbeat_received_time_;
+  std::atomic<bool> is_external_emergency_stop_heartbeat_timeout_{false};
   bool isHeartbeatTimeout(
-    const std::shared_ptr<rclcpp::Time> & heartbeat_received_time, const double timeout);
+    const Mailbox<builtin_interfaces::msg::Time> & heartbeat_received_time, const double timeout);
 
   // Check initialization
   bool isDataReady();
 
   // Subscriber for auto
-  Commands auto_commands_;
+  CommandMailboxes auto_commands_;
   rclcpp::Subscription<AckermannControlCommand>::SharedPtr auto_control_cmd_sub_;
   rclcpp::Subscription<TurnIndicatorsCommand>::SharedPtr auto_turn_indicator_cmd_sub_;
   rclcpp::Subscription<HazardLightsCommand>::SharedPtr auto_hazard_light_cmd_sub_;
@@ -132,7 +171,7 @@ private:
   void onAutoShiftCmd(GearCommand::ConstSharedPtr msg);
 
   // Subscription for external
-  Commands remote_commands_;
+  CommandMailboxes remote_commands_;
   rclcpp::Subscription<AckermannControlCommand>::SharedPtr remote_control_cmd_sub_;
   rclcpp::Subscription<TurnIndicatorsCommand>::SharedPtr remote_turn_indicator_cmd_sub_;
   rclcpp::Subscription<HazardLightsCommand>::SharedPtr remote_hazard_light_cmd_sub_;
@@ -143,7 +182,7 @@ private:
   void onRemoteShiftCmd(GearCommand::ConstSharedPtr msg);
 
   // Subscription for emergency
-  Commands emergency_commands_;
+  CommandMailboxes emergency_commands_;
   rclcpp::Subscription<AckermannControlCommand>::SharedPtr emergency_control_cmd_sub_;
   rclcpp::Subscription<HazardLightsCommand>::SharedPtr emergency_hazard_light_cmd_sub_;
   rclcpp::Subscription<GearCommand>::SharedPtr emergency_gear_cmd_sub_;
@@ -213,7 +252,7 @@ private:
   AckermannControlCommand filterControlCommand(const AckermannControlCommand & msg);
 
   // filtering on transition
-  OperationMode current_operation_mode_;
+  Mailbox<OperationMode> current_operation_mode_;
   VehicleCmdFilter filter_on_transition_;
 
   // Start request service
@@ -225,7 +264,8 @@ private:
 
   public:
     StartRequest(
-      rclcpp::Node * node, bool use_start_request, double stopped_state_entry_duration_time);
+      rclcpp::Node * node, bool use_start_request, double stopped_state_entry_duration_time,
+      rclcpp::CallbackGroup::SharedPtr callback_group);
     bool isAccepted();
     void publishStartAccepted();
     void checkStopped(const ControlCommandStamped & control);
@@ -236,7 +276,7 @@ private:
     bool is_start_requesting_;
     bool is_start_accepted_;
     bool is_start_cancelled_;
-    Odometry current_twist_;
+    std::atomic<double> current_velocity_{0.0};
 
     std::shared_ptr<rclcpp::Time> last_running_time_;
     double stopped_state_entry_duration_time_;
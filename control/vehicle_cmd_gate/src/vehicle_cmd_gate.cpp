@@ -17,7 +17,11 @@
 #include <rclcpp/logging.hpp>
 #include <tier4_api_utils/tier4_api_utils.hpp>
 
+#include <pthread.h>
+#include <sched.h>
+
 #include <chrono>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <string>
@@ -51,6 +55,14 @@ VehicleCmdGate::VehicleCmdGate(const rclcpp::NodeOptions & node_options)
   rclcpp::QoS durable_qos{1};
   durable_qos.transient_local();
 
+  // Callback group of the gate
+  const auto use_dedicated_gate_thread = declare_parameter("use_dedicated_gate_thread", false);
+  const auto gate_thread_priority = declare_parameter("gate_thread_priority", 0);
+  gate_callback_group_ = create_callback_group(
+    rclcpp::CallbackGroupType::MutuallyExclusive, !use_dedicated_gate_thread);
+  rclcpp::SubscriptionOptions gate_options;
+  gate_options.callback_group = gate_callback_group_;
+
   // Publisher
   vehicle_cmd_emergency_pub_ =
     this->create_publisher<VehicleEmergencyStamped>("output/vehicle_cmd_emergency", durable_qos);
@@ -82,12 +94,13 @@ VehicleCmdGate::VehicleCmdGate(const rclcpp::NodeOptions & node_options)
     "input/steering", 1, std::bind(&VehicleCmdGate::onSteering, this, _1));
   operation_mode_sub_ = this->create_subscription<tier4_system_msgs::msg::OperationMode>(
     "input/operation_mode", 1, [this](const tier4_system_msgs::msg::OperationMode::SharedPtr msg) {
-      current_operation_mode_ = *msg;
+      current_operation_mode_.write(*msg);
     });
 
   // Subscriber for auto
   auto_control_cmd_sub_ = this->create_subscription<AckermannControlCommand>(
-    "input/auto/control_cmd", 1, std::bind(&VehicleCmdGate::onAutoCtrlCmd, this, _1));
+    "input/auto/control_cmd", 1, std::bind(&VehicleCmdGate::onAutoCtrlCmd, this, _1),
+    gate_options);
 
   auto_turn_indicator_cmd_sub_ = this->create_subscription<TurnIndicatorsCommand>(
     "input/auto/turn_indicators_cmd", 1,
@@ -101,7 +114,8 @@ VehicleCmdGate::VehicleCmdGate(const rclcpp::NodeOptions & node_options)
 
   // Subscriber for external
   remote_control_cmd_sub_ = this->create_subscription<AckermannControlCommand>(
-    "input/external/control_cmd", 1, std::bind(&VehicleCmdGate::onRemoteCtrlCmd, this, _1));
+    "input/external/control_cmd", 1, std::bind(&VehicleCmdGate::onRemoteCtrlCmd, this, _1),
+    gate_options);
 
   remote_turn_indicator_cmd_sub_ = this->create_subscription<TurnIndicatorsCommand>(
     "input/external/turn_indicators_cmd", 1,
@@ -116,7 +130,8 @@ VehicleCmdGate::VehicleCmdGate(const rclcpp::NodeOptions & node_options)
 
   // Subscriber for emergency
   emergency_control_cmd_sub_ = this->create_subscription<AckermannControlCommand>(
-    "input/emergency/control_cmd", 1, std::bind(&VehicleCmdGate::onEmergencyCtrlCmd, this, _1));
+    "input/emergency/control_cmd", 1, std::bind(&VehicleCmdGate::onEmergencyCtrlCmd, this, _1),
+    gate_options);
 
   emergency_hazard_light_cmd_sub_ = this->create_subscription<HazardLightsCommand>(
     "input/emergency/hazard_lights_cmd", 1,
@@ -163,7 +178,11 @@ VehicleCmdGate::VehicleCmdGate(const rclcpp::NodeOptions & node_options)
   }
 
   // Set default value
-  current_gate_mode_.data = GateMode::AUTO;
+  {
+    GateMode gate_mode;
+    gate_mode.data = GateMode::AUTO;
+    current_gate_mode_.write(gate_mode);
+  }
 
   // Service
   srv_engage_ = create_service<tier4_external_api_msgs::srv::Engage>(
@@ -189,30 +208,68 @@ VehicleCmdGate::VehicleCmdGate(const rclcpp::NodeOptions & node_options)
   const auto use_start_request = declare_parameter("use_start_request", false);
   const auto stopped_state_entry_duration_time =
     declare_parameter("stopped_state_entry_duration_time", 0.1);
-  start_request_ =
-    std::make_unique<StartRequest>(this, use_start_request, stopped_state_entry_duration_time);
+  start_request_ = std::make_unique<StartRequest>(
+    this, use_start_request, stopped_state_entry_duration_time, gate_callback_group_);
 
   // Timer
   const auto period_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
     std::chrono::duration<double>(update_period_));
-  timer_ =
-    rclcpp::create_timer(this, get_clock(), period_ns, std::bind(&VehicleCmdGate::onTimer, this));
+  timer_ = rclcpp::create_timer(
+    this, get_clock(), period_ns, std::bind(&VehicleCmdGate::onTimer, this), gate_callback_group_);
   timer_pub_status_ = rclcpp::create_timer(
-    this, get_clock(), period_ns, std::bind(&VehicleCmdGate::publishStatus, this));
+    this, get_clock(), period_ns, std::bind(&VehicleCmdGate::publishStatus, this),
+    gate_callback_group_);
+
+  // Gate thread
+  if (use_dedicated_gate_thread) {
+    gate_executor_ = std::make_shared<rclcpp::executors::SingleThreadedExecutor>();
+    gate_executor_->add_callback_group(gate_callback_group_, get_node_base_interface());
+    gate_thread_ = std::thread(&VehicleCmdGate::spinGateThread, this, gate_thread_priority);
+  }
+}
+
+VehicleCmdGate::~VehicleCmdGate()
+{
+  if (gate_thread_.joinable()) {
+    is_gate_thread_stopped_ = true;
+    gate_executor_->cancel();
+    gate_thread_.join();
+  }
+}
+
+void VehicleCmdGate::spinGateThread(const int priority)
+{
+  if (0 < priority) {
+    sched_param param{};
+    param.sched_priority = priority;
+    const int ret = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (ret != 0) {
+      RCLCPP_WARN(
+        get_logger(), "failed to set the priority of the gate thread to %d: %s", priority,
+        std::strerror(ret));
+    }
+  }
+
+  // spin_once with a timeout, since a cancel before spinning is not kept by the executor
+  while (rclcpp::ok() && !is_gate_thread_stopped_) {
+    gate_executor_->spin_once(std::chrono::milliseconds(100));
+  }
 }
 
 bool VehicleCmdGate::isHeartbeatTimeout(
-  const std::shared_ptr<rclcpp::Time> & heartbeat_received_time, const double timeout)
+  const Mailbox<builtin_interfaces::msg::Time> & heartbeat_received_time, const double timeout)
 {
   if (timeout == 0.0) {
     return false;
   }
 
-  if (!heartbeat_received_time) {
+  if (!heartbeat_received_time.hasValue()) {
     return true;
   }
 
-  const auto time_from_heartbeat = this->now() - *heartbeat_received_time;
+  const auto now = this->now();
+  const auto time_from_heartbeat =
+    now - rclcpp::Time(heartbeat_received_time.read(), now.get_clock_type());
 
   return time_from_heartbeat.seconds() > timeout;
 }
@@ -221,7 +278,7 @@ bool VehicleCmdGate::isDataReady()
 {
   // emergency state must be received before running
   if (use_emergency_handling_) {
-    if (!emergency_state_heartbeat_received_time_) {
+    if (!emergency_state_heartbeat_received_time_.hasValue()) {
       RCLCPP_WARN(get_logger(), "emergency_state_heartbeat_received_time_ is false");
       return false;
     }
@@ -233,66 +290,69 @@ bool VehicleCmdGate::isDataReady()
 // for auto
 void VehicleCmdGate::onAutoCtrlCmd(AckermannControlCommand::ConstSharedPtr msg)
 {
-  auto_commands_.control = *msg;
+  auto_commands_.control.write(*msg);
 
-  if (current_gate_mode_.data == GateMode::AUTO) {
-    publishControlCommands(auto_commands_);
+  if (current_gate_mode_.read().data == GateMode::AUTO) {
+    publishControlCommands(auto_commands_.read());
   }
 }
 
 void VehicleCmdGate::onAutoTurnIndicatorsCmd(TurnIndicatorsCommand::ConstSharedPtr msg)
 {
-  auto_commands_.turn_indicator = *msg;
+  auto_commands_.turn_indicator.write(*msg);
 }
 
 void VehicleCmdGate::onAutoHazardLightsCmd(HazardLightsCommand::ConstSharedPtr msg)
 {
-  auto_commands_.hazard_light = *msg;
+  auto_commands_.hazard_light.write(*msg);
 }
 
-void VehicleCmdGate::onAutoShiftCmd(GearCommand::ConstSharedPtr msg) { auto_commands_.gear = *msg; }
+void VehicleCmdGate::onAutoShiftCmd(GearCommand::ConstSharedPtr msg)
+{
+  auto_commands_.gear.write(*msg);
+}
 
 // for remote
 void VehicleCmdGate::onRemoteCtrlCmd(AckermannControlCommand::ConstSharedPtr msg)
 {
-  remote_commands_.control = *msg;
+  remote_commands_.control.write(*msg);
 
-  if (current_gate_mode_.data == GateMode::EXTERNAL) {
-    publishControlCommands(remote_commands_);
+  if (current_gate_mode_.read().data == GateMode::EXTERNAL) {
+    publishControlCommands(remote_commands_.read());
   }
 }
 
 void VehicleCmdGate::onRemoteTurnIndicatorsCmd(TurnIndicatorsCommand::ConstSharedPtr msg)
 {
-  remote_commands_.turn_indicator = *msg;
+  remote_commands_.turn_indicator.write(*msg);
 }
 
 void VehicleCmdGate::onRemoteHazardLightsCmd(HazardLightsCommand::ConstSharedPtr msg)
 {
-  remote_commands_.hazard_light = *msg;
+  remote_commands_.hazard_light.write(*msg);
 }
 
 void VehicleCmdGate::onRemoteShiftCmd(GearCommand::ConstSharedPtr msg)
 {
-  remote_commands_.gear = *msg;
+  remote_commands_.gear.write(*msg);
 }
 
 // for emergency
 void VehicleCmdGate::onEmergencyCtrlCmd(AckermannControlCommand::ConstSharedPtr msg)
 {
-  emergency_commands_.control = *msg;
+  emergency_commands_.control.write(*msg);
 
   if (use_emergency_handling_ && is_system_emergency_) {
-    publishControlCommands(emergency_commands_);
+    publishControlCommands(emergency_commands_.read());
   }
 }
 void VehicleCmdGate::onEmergencyHazardLightsCmd(HazardLightsCommand::ConstSharedPtr msg)
 {
-  emergency_commands_.hazard_light = *msg;
+  emergency_commands_.hazard_light.write(*msg);
 }
 void VehicleCmdGate::onEmergencyShiftCmd(GearCommand::ConstSharedPtr msg)
 {
-  emergency_commands_.gear = *msg;
+  emergency_commands_.gear.write(*msg);
 }
 
 void VehicleCmdGate::onTimer()
@@ -345,25 +405,26 @@ void VehicleCmdGate::onTimer()
   TurnIndicatorsCommand turn_indicator;
   HazardLightsCommand hazard_light;
   GearCommand gear;
+  const auto current_gate_mode = current_gate_mode_.read();
   if (use_emergency_handling_ && is_system_emergency_) {
-    turn_indicator = emergency_commands_.turn_indicator;
-    hazard_light = emergency_commands_.hazard_light;
-    gear = emergency_commands_.gear;
+    turn_indicator = emergency_commands_.turn_indicator.read();
+    hazard_light = emergency_commands_.hazard_light.read();
+    gear = emergency_commands_.gear.read();
   } else {
-    if (current_gate_mode_.data == GateMode::AUTO) {
-      turn_indicator = auto_commands_.turn_indicator;
-      hazard_light = auto_commands_.hazard_light;
-      gear = auto_commands_.gear;
+    if (current_gate_mode.data == GateMode::AUTO) {
+      turn_indicator = auto_commands_.turn_indicator.read();
+      hazard_light = auto_commands_.hazard_light.read();
+      gear = auto_commands_.gear.read();
 
       // Don't send turn signal when autoware is not engaged
       if (!is_engaged_) {
         turn_indicator.command = TurnIndicatorsCommand::NO_COMMAND;
         hazard_light.command = HazardLightsCommand::NO_COMMAND;
       }
-    } else if (current_gate_mode_.data == GateMode::EXTERNAL) {
-      turn_indicator = remote_commands_.turn_indicator;
-      hazard_light = remote_commands_.hazard_light;
-      gear = remote_commands_.gear;
+    } else if (current_gate_mode.data == GateMode::EXTERNAL) {
+      turn_indicator = remote_commands_.turn_indicator.read();
+      hazard_light = remote_commands_.hazard_light.read();
+      gear = remote_commands_.gear.read();
     } else {
       throw std::runtime_error("invalid mode");
     }
@@ -407,8 +468,8 @@ void VehicleCmdGate::publishControlCommands(const Commands & commands)
   if (use_emergency_handling_ && is_system_emergency_) {
     RCLCPP_WARN_THROTTLE(
       get_logger(), *get_clock(), std::chrono::milliseconds(1000).count(), "Emergency!");
-    filtered_commands.control = emergency_commands_.control;
-    filtered_commands.gear = emergency_commands_.gear;  // tmp
+    filtered_commands.control = emergency_commands_.control.read();
+    filtered_commands.gear = emergency_commands_.gear.read();  // tmp
   }
 
   // Check start after applying all gates except engage
@@ -497,10 +558,10 @@ void VehicleCmdGate::publishStatus()
   external_emergency.stamp = stamp;
   external_emergency.emergency = is_external_emergency_stop_;
 
-  gate_mode_pub_->publish(current_gate_mode_);
+  gate_mode_pub_->publish(current_gate_mode_.read());
   engage_pub_->publish(autoware_engage);
   pub_external_emergency_->publish(external_emergency);
-  operation_mode_pub_->publish(current_operation_mode_);
+  operation_mode_pub_->publish(current_operation_mode_.read());
 }
 
 AckermannControlCommand VehicleCmdGate::filterControlCommand(const AckermannControlCommand & in)
@@ -508,7 +569,7 @@ AckermannControlCommand VehicleCmdGate::filterControlCommand(const AckermannCont
   AckermannControlCommand out = in;
   const double dt = getDt();
 
-  const auto mode = current_operation_mode_.mode;
+  const auto mode = current_operation_mode_.read().mode;
 
   // Apply transition_filter when transiting from MANUAL to AUTO.
   if (mode == OperationMode::TRANSITION_TO_AUTO) {
@@ -561,24 +622,24 @@ void VehicleCmdGate::onEmergencyState(EmergencyState::ConstSharedPtr msg)
   is_system_emergency_ = (msg->state == EmergencyState::MRM_OPERATING) ||
                          (msg->state == EmergencyState::MRM_SUCCEEDED) ||
                          (msg->state == EmergencyState::MRM_FAILED);
-  emergency_state_heartbeat_received_time_ = std::make_shared<rclcpp::Time>(this->now());
+  emergency_state_heartbeat_received_time_.write(this->now());
 }
 
 void VehicleCmdGate::onExternalEmergencyStopHeartbeat(
   [[maybe_unused]] Heartbeat::ConstSharedPtr msg)
 {
-  external_emergency_stop_heartbeat_received_time_ = std::make_shared<rclcpp::Time>(this->now());
+  external_emergency_stop_heartbeat_received_time_.write(this->now());
 }
 
 void VehicleCmdGate::onGateMode(GateMode::ConstSharedPtr msg)
 {
-  const auto prev_gate_mode = current_gate_mode_;
-  current_gate_mode_ = *msg;
+  const auto prev_gate_mode = current_gate_mode_.read();
+  current_gate_mode_.write(*msg);
 
-  if (current_gate_mode_.data != prev_gate_mode.data) {
+  if (msg->data != prev_gate_mode.data) {
     RCLCPP_INFO(
       get_logger(), "GateMode changed: %s -> %s", getGateModeName(prev_gate_mode.data),
-      getGateModeName(current_gate_mode_.data));
+      getGateModeName(msg->data));
   }
 }
 
@@ -684,7 +745,8 @@ void VehicleCmdGate::checkExternalEmergencyStop(diagnostic_updater::DiagnosticSt
 }
 
 VehicleCmdGate::StartRequest::StartRequest(
-  rclcpp::Node * node, bool use_start_request, double stopped_state_entry_duration_time)
+  rclcpp::Node * node, bool use_start_request, double stopped_state_entry_duration_time,
+  rclcpp::CallbackGroup::SharedPtr callback_group)
 {
   using std::placeholders::_1;
 
@@ -698,8 +760,9 @@ VehicleCmdGate::StartRequest::StartRequest(
     return;
   }
 
-  request_start_cli_ =
-    node_->create_client<std_srvs::srv::Trigger>("/api/autoware/set/start_request");
+  // the response is handled with the commands which request the start
+  request_start_cli_ = node_->create_client<std_srvs::srv::Trigger>(
+    "/api/autoware/set/start_request", rmw_qos_profile_services_default, callback_group);
   request_start_pub_ = node_->create_publisher<tier4_debug_msgs::msg::BoolStamped>(
     "/api/autoware/get/start_accepted", rclcpp::QoS(1));
   current_twist_sub_ = node_->create_subscription<Odometry>(
@@ -712,7 +775,7 @@ VehicleCmdGate::StartRequest::StartRequest(
 
 void VehicleCmdGate::StartRequest::onCurrentTwist(Odometry::ConstSharedPtr msg)
 {
-  current_twist_ = *msg;
+  current_velocity_ = msg->twist.twist.linear.x;
 }
 
 bool VehicleCmdGate::StartRequest::isAccepted()
@@ -740,7 +803,7 @@ void VehicleCmdGate::StartRequest::checkStopped(const ControlCommandStamped & co
 
   if (is_start_accepted_) {
     const auto control_velocity = std::abs(control.longitudinal.speed);
-    const auto current_velocity = std::abs(current_twist_.twist.twist.linear.x);
+    const auto current_velocity = std::abs(current_velocity_.load());
 
     if (eps < current_velocity) {
       last_running_time_ = std::make_shared<rclcpp::Time>(node_->now());
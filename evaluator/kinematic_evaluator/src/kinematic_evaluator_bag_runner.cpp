@@ -0,0 +1,155 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "kinematic_evaluator/kinematic_evaluator_node.hpp"
+#include "kinematic_evaluator/metrics_calculator.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp/serialization.hpp>
+#include <rosbag2_cpp/reader.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+using kinematic_diagnostics::KinematicEvaluatorNode;
+using kinematic_diagnostics::Metric;
+using kinematic_diagnostics::MetricsCalculator;
+using kinematic_diagnostics::Stat;
+using nav_msgs::msg::Odometry;
+
+// name of the bag directory or file without its extension
+std::string getBagName(std::string bag_path)
+{
+  while (bag_path.size() > 1 && bag_path.back() == '/') {
+    bag_path.pop_back();
+  }
+  const auto name = bag_path.substr(bag_path.find_last_of('/') + 1);
+  return name.substr(0, name.find_last_of('.'));
+}
+
+/**
+ * @brief evaluate the odometry of the bag as the node does, and write the same results as the
+ * output file of the node with the recording time of the messages
+ * @return number of evaluated messages
+ */
+size_t evaluateBag(
+  const std::string & bag_path, const std::string & output_path, const std::string & odom_topic,
+  const std::vector<Metric> & metrics)
+{
+  rosbag2_cpp::Reader reader;
+  reader.open(bag_path);
+  rosbag2_storage::StorageFilter filter;
+  filter.topics = {odom_topic};
+  reader.set_filter(filter);
+
+  MetricsCalculator metrics_calculator;
+  std::unordered_map<Metric, Stat<double>> metric_stats;
+  for (const Metric metric : metrics) {
+    metric_stats[metric] = Stat<double>();
+  }
+
+  rclcpp::Serialization<Odometry> serialization;
+  rclcpp::Time first_stamp;
+  rclcpp::Time last_stamp;
+  size_t odom_num = 0;
+  while (reader.has_next()) {
+    const auto bag_message = reader.read_next();
+    if (bag_message->topic_name != odom_topic) {
+      continue;
+    }
+    const rclcpp::SerializedMessage serialized_message(*bag_message->serialized_data);
+    Odometry odom;
+    serialization.deserialize_message(&serialized_message, &odom);
+
+    for (const Metric metric : metrics) {
+      metric_stats[metric] = metrics_calculator.updateStat(metric, odom, metric_stats[metric]);
+    }
+    last_stamp = rclcpp::Time(bag_message->time_stamp);
+    if (odom_num == 0) {
+      first_stamp = last_stamp;
+    }
+    ++odom_num;
+  }
+
+  if (odom_num > 0) {
+    std::ofstream output_file(output_path);
+    KinematicEvaluatorNode::writeResults(
+      output_file, metrics, first_stamp, last_stamp, metric_stats);
+  }
+  return odom_num;
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+
+  auto node = rclcpp::Node::make_shared("kinematic_evaluator_bag_runner");
+  const auto logger = node->get_logger();
+
+  const auto bag_paths = node->declare_parameter<std::vector<std::string>>("bag_paths");
+  const auto output_directory = node->declare_parameter<std::string>("output_directory", ".");
+  const auto jobs = node->declare_parameter<int>("jobs", 0);
+  const auto odom_topic =
+    node->declare_parameter<std::string>("input.twist", "/localization/kinematic_state");
+  std::vector<Metric> metrics;
+  for (const std::string & selected_metric :
+       node->declare_parameter<std::vector<std::string>>("selected_metrics")) {
+    metrics.push_back(kinematic_diagnostics::str_to_metric.at(selected_metric));
+  }
+
+  // the bags are independent, so each worker evaluates whole bags as fast as it reads them
+  const size_t worker_num = std::min(
+    bag_paths.size(),
+    static_cast<size_t>(jobs > 0 ? jobs : std::max(1u, std::thread::hardware_concurrency())));
+  std::atomic<size_t> next_bag_idx{0};
+  std::atomic<bool> has_failed{false};
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < worker_num; ++i) {
+    workers.emplace_back([&]() {
+      for (size_t idx = next_bag_idx++; idx < bag_paths.size(); idx = next_bag_idx++) {
+        const auto & bag_path = bag_paths.at(idx);
+        const auto output_path = output_directory + "/" + getBagName(bag_path) + ".results";
+        try {
+          const size_t odom_num = evaluateBag(bag_path, output_path, odom_topic, metrics);
+          if (odom_num == 0) {
+            RCLCPP_WARN_STREAM(logger, "No " << odom_topic << " in " << bag_path);
+            continue;
+          }
+          RCLCPP_INFO_STREAM(
+            logger,
+            "Evaluated " << odom_num << " messages of " << bag_path << " to " << output_path);
+        } catch (const std::exception & e) {
+          RCLCPP_ERROR_STREAM(logger, "Failed to evaluate " << bag_path << ": " << e.what());
+          has_failed = true;
+        }
+      }
+    });
+  }
+  for (auto & worker : workers) {
+    worker.join();
+  }
+
+  rclcpp::shutdown();
+
+  return has_failed ? EXIT_FAILURE : 0;
+}
@@ -17,6 +17,7 @@
 #include "boost/lexical_cast.hpp"
 
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -55,33 +56,38 @@ KinematicEvaluatorNode::~KinematicEvaluatorNode()
 {
   if (!output_file_str_.empty()) {
     std::ofstream f(output_file_str_);
-    f << std::left << std::fixed;
-    // header
-    f << "#Data collected over: " << stamps_.back().seconds() - stamps_[0].seconds() << " seconds."
-      << std::endl;
-    f << std::setw(24) << "#Stamp [ns]";
-
-    for (Metric metric : metrics_) {
-      f << std::setw(30) << metric_descriptions.at(metric);
-    }
-    f << std::endl;
-    f << std::setw(24) << "#";
-    for (Metric metric : metrics_) {
-      (void)metric;
-      f << std::setw(9) << "min" << std::setw(9) << "max" << std::setw(12) << "mean";
-    }
-    f << std::endl;
-    // data
-    f << std::setw(24) << stamps_.back().nanoseconds();
-    for (Metric metric : metrics_) {
-      const auto & stat = metric_stats_[static_cast<size_t>(metric)].back();
-      f << stat;
-      f << std::setw(4) << "";
-    }
+    writeResults(f, metrics_, stamps_.front(), stamps_.back(), metrics_dict_);
     f.close();
   }
 }
 
+void KinematicEvaluatorNode::writeResults(
+  std::ostream & os, const std::vector<Metric> & metrics, const rclcpp::Time & first_stamp,
+  const rclcpp::Time & last_stamp, const std::unordered_map<Metric, Stat<double>> & metric_stats)
+{
+  os << std::left << std::fixed;
+  // header
+  os << "#Data collected over: " << last_stamp.seconds() - first_stamp.seconds() << " seconds."
+     << std::endl;
+  os << std::setw(24) << "#Stamp [ns]";
+  for (Metric metric : metrics) {
+    os << std::setw(30) << metric_descriptions.at(metric);
+  }
+  os << std::endl;
+  os << std::setw(24) << "#";
+  for (Metric metric : metrics) {
+    (void)metric;
+    os << std::setw(9) << "min" << std::setw(9) << "max" << std::setw(12) << "mean";
+  }
+  os << std::endl;
+  // data
+  os << std::setw(24) << last_stamp.nanoseconds();
+  for (Metric metric : metrics) {
+    os << metric_stats.at(metric);
+    os << std::setw(4) << "";
+  }
+}
+
 DiagnosticStatus KinematicEvaluatorNode::generateDiagnosticStatus(
   const Metric & metric, const Stat<double> & metric_stat) const
 {
@@ -108,7 +114,6 @@ void KinematicEvaluatorNode::onOdom(const nav_msgs::msg::Odometry::SharedPtr msg
 
   for (Metric metric : metrics_) {
     metrics_dict_[metric] = metrics_calculator_.updateStat(metric, *msg, metrics_dict_[metric]);
-    metric_stats_[static_cast<size_t>(metric)].push_back(metrics_dict_[metric]);
     stamps_.push_back(metrics_msg.header.stamp);
     if (metrics_dict_[metric].count() > 0) {
       metrics_msg.status.push_back(generateDiagnosticStatus(metric, metrics_dict_[metric]));
@@ -31,6 +31,7 @@
 #include <message_filters/synchronizer.h>
 
 #include <deque>
+#include <iostream>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -72,6 +73,14 @@ public:
   DiagnosticStatus generateDiagnosticStatus(
     const Metric & metric, const Stat<double> & metric_stat) const;
 
+  /**
+   * @brief write the statistics of the metrics collected from first_stamp to last_stamp in the
+   * format of the output file
+   */
+  static void writeResults(
+    std::ostream & os, const std::vector<Metric> & metrics, const rclcpp::Time & first_stamp,
+    const rclcpp::Time & last_stamp, const std::unordered_map<Metric, Stat<double>> & metric_stats);
+
 private:
   // ROS
   message_filters::Subscriber<Odometry> odom_sub_;
@@ -93,7 +102,6 @@ private:
   // Metrics
   std::vector<Metric> metrics_;
   std::deque<rclcpp::Time> stamps_;
-  std::array<std::deque<Stat<double>>, static_cast<size_t>(Metric::SIZE)> metric_stats_;
   std::unordered_map<Metric, Stat<double>> metrics_dict_;
 };
 }  // namespace localization_diagnostics
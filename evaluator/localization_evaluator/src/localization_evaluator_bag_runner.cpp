@@ -0,0 +1,219 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "localization_evaluator/localization_evaluator_node.hpp"
+#include "localization_evaluator/metrics_calculator.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp/serialization.hpp>
+#include <rosbag2_cpp/reader.hpp>
+
+#include <boost/optional.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+using geometry_msgs::msg::PoseWithCovarianceStamped;
+using localization_diagnostics::LocalizationEvaluatorNode;
+using localization_diagnostics::Metric;
+using localization_diagnostics::MetricsCalculator;
+using localization_diagnostics::Stat;
+using nav_msgs::msg::Odometry;
+
+struct BagRunnerParam
+{
+  std::string odom_topic;
+  std::string ref_topic;
+  std::vector<Metric> metrics;
+};
+
+// name of the bag directory or file without its extension
+std::string getBagName(std::string bag_path)
+{
+  while (bag_path.size() > 1 && bag_path.back() == '/') {
+    bag_path.pop_back();
+  }
+  const auto name = bag_path.substr(bag_path.find_last_of('/') + 1);
+  return name.substr(0, name.find_last_of('.'));
+}
+
+template <class T>
+T deserialize(const rosbag2_storage::SerializedBagMessage & bag_message)
+{
+  rclcpp::Serialization<T> serialization;
+  const rclcpp::SerializedMessage serialized_message(*bag_message.serialized_data);
+  T message;
+  serialization.deserialize_message(&serialized_message, &message);
+  return message;
+}
+
+/**
+ * @brief evaluate the localization of the bag as the node does, and write the same results as the
+ * output file of the node with the recording time of the messages. Instead of the approximate time
+ * synchronizer of the node, each reference pose is paired with the odometry nearest to it in time,
+ * among the last one before it and the first one after it.
+ * @return number of evaluated pairs
+ */
+size_t evaluateBag(
+  const std::string & bag_path, const std::string & output_path, const BagRunnerParam & param)
+{
+  rosbag2_cpp::Reader reader;
+  reader.open(bag_path);
+  rosbag2_storage::StorageFilter filter;
+  filter.topics = {param.odom_topic, param.ref_topic};
+  reader.set_filter(filter);
+
+  MetricsCalculator metrics_calculator;
+  std::unordered_map<Metric, Stat<double>> metric_stats;
+  for (const Metric metric : param.metrics) {
+    metric_stats[metric] = Stat<double>();
+  }
+
+  rclcpp::Time first_stamp;
+  rclcpp::Time last_stamp;
+  size_t pair_num = 0;
+  const auto is_zero = [](const geometry_msgs::msg::Point & p) {
+    return p.x == 0 && p.y == 0 && p.z == 0;
+  };
+  const auto evaluate = [&](
+                          const Odometry & odom, const PoseWithCovarianceStamped & pose_ref,
+                          const rclcpp::Time & stamp) {
+    const auto & p_lc = odom.pose.pose.position;
+    const auto & p_gt = pose_ref.pose.pose.position;
+    if (is_zero(p_lc) || is_zero(p_gt)) {
+      return;
+    }
+    for (const Metric metric : param.metrics) {
+      metric_stats[metric] =
+        metrics_calculator.updateStat(metric_stats[metric], metric, p_lc, p_gt);
+    }
+    last_stamp = stamp;
+    if (pair_num == 0) {
+      first_stamp = stamp;
+    }
+    ++pair_num;
+  };
+
+  boost::optional<Odometry> prev_odom;
+  std::deque<PoseWithCovarianceStamped> pending_refs;
+  rclcpp::Time stamp;
+  while (reader.has_next()) {
+    const auto bag_message = reader.read_next();
+    stamp = rclcpp::Time(bag_message->time_stamp);
+    if (bag_message->topic_name == param.odom_topic) {
+      const auto odom = deserialize<Odometry>(*bag_message);
+      const rclcpp::Time odom_stamp(odom.header.stamp);
+      while (!pending_refs.empty()) {
+        const rclcpp::Time ref_stamp(pending_refs.front().header.stamp);
+        if (ref_stamp > odom_stamp) {
+          break;
+        }
+        const bool is_prev_nearer =
+          prev_odom && ref_stamp - rclcpp::Time(prev_odom->header.stamp) < odom_stamp - ref_stamp;
+        evaluate(is_prev_nearer ? *prev_odom : odom, pending_refs.front(), stamp);
+        pending_refs.pop_front();
+      }
+      prev_odom = odom;
+    } else if (bag_message->topic_name == param.ref_topic) {
+      const auto pose_ref = deserialize<PoseWithCovarianceStamped>(*bag_message);
+      const rclcpp::Time ref_stamp(pose_ref.header.stamp);
+      if (prev_odom && ref_stamp <= rclcpp::Time(prev_odom->header.stamp)) {
+        // older than the last odometry, which is the nearest one received
+        evaluate(*prev_odom, pose_ref, stamp);
+      } else {
+        pending_refs.push_back(pose_ref);
+      }
+    }
+  }
+  if (prev_odom) {
+    for (const auto & pose_ref : pending_refs) {
+      evaluate(*prev_odom, pose_ref, stamp);
+    }
+  }
+
+  if (pair_num > 0) {
+    std::ofstream output_file(output_path);
+    LocalizationEvaluatorNode::writeResults(
+      output_file, param.metrics, first_stamp, last_stamp, metric_stats);
+  }
+  return pair_num;
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+
+  auto node = rclcpp::Node::make_shared("localization_evaluator_bag_runner");
+  const auto logger = node->get_logger();
+
+  const auto bag_paths = node->declare_parameter<std::vector<std::string>>("bag_paths");
+  const auto output_directory = node->declare_parameter<std::string>("output_directory", ".");
+  const auto jobs = node->declare_parameter<int>("jobs", 0);
+
+  BagRunnerParam param;
+  param.odom_topic =
+    node->declare_parameter<std::string>("input.localization", "/localization/kinematic_state");
+  param.ref_topic = node->declare_parameter<std::string>(
+    "input.localization_ref", "/geometry_msgs/PoseWithCovarianceStampedGt");
+  for (const std::string & selected_metric :
+       node->declare_parameter<std::vector<std::string>>("selected_metrics")) {
+    param.metrics.push_back(localization_diagnostics::str_to_metric.at(selected_metric));
+  }
+
+  // the bags are independent, so each worker evaluates whole bags as fast as it reads them
+  const size_t worker_num = std::min(
+    bag_paths.size(),
+    static_cast<size_t>(jobs > 0 ? jobs : std::max(1u, std::thread::hardware_concurrency())));
+  std::atomic<size_t> next_bag_idx{0};
+  std::atomic<bool> has_failed{false};
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < worker_num; ++i) {
+    workers.emplace_back([&]() {
+      for (size_t idx = next_bag_idx++; idx < bag_paths.size(); idx = next_bag_idx++) {
+        const auto & bag_path = bag_paths.at(idx);
+        const auto output_path = output_directory + "/" + getBagName(bag_path) + ".results";
+        try {
+          const size_t pair_num = evaluateBag(bag_path, output_path, param);
+          if (pair_num == 0) {
+            RCLCPP_WARN_STREAM(logger, "No valid localization in " << bag_path);
+            continue;
+          }
+          RCLCPP_INFO_STREAM(
+            logger,
+            "Evaluated " << pair_num << " poses of " << bag_path << " to " << output_path);
+        } catch (const std::exception & e) {
+          RCLCPP_ERROR_STREAM(logger, "Failed to evaluate " << bag_path << ": " << e.what());
+          has_failed = true;
+        }
+      }
+    });
+  }
+  for (auto & worker : workers) {
+    worker.join();
+  }
+
+  rclcpp::shutdown();
+
+  return has_failed ? EXIT_FAILURE : 0;
+}
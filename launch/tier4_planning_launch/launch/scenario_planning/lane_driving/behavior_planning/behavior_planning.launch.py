@@ -389,6 +389,7 @@ def launch_setup(context, *args, **kwargs):
         namespace="",
         package="rclcpp_components",
         executable=LaunchConfiguration("container_executable"),
+        parameters=[{"thread_num": LaunchConfiguration("container_thread_num")}],
         composable_node_descriptions=[
             behavior_path_planner_component,
             behavior_velocity_planner_component,
@@ -481,6 +482,9 @@ def generate_launch_description():
     # component
     add_launch_arg("use_intra_process", "false", "use ROS2 component container communication")
     add_launch_arg("use_multithread", "false", "use multithread")
+    add_launch_arg(
+        "container_thread_num", "0", "number of threads of the multithread container (0: all cores)"
+    )
 
     # for points filter of run out module
     add_launch_arg("use_pointcloud_container", "true")
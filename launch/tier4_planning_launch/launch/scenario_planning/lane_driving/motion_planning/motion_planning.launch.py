@@ -230,6 +230,7 @@ def launch_setup(context, *args, **kwargs):
         namespace="",
         package="rclcpp_components",
         executable=LaunchConfiguration("container_executable"),
+        parameters=[{"thread_num": LaunchConfiguration("container_thread_num")}],
         composable_node_descriptions=[
             obstacle_avoidance_planner_component,
         ],
@@ -306,6 +307,9 @@ def generate_launch_description():
 
     add_launch_arg("use_intra_process", "false", "use ROS2 component container communication")
     add_launch_arg("use_multithread", "false", "use multithread")
+    add_launch_arg(
+        "container_thread_num", "0", "number of threads of the multithread container (0: all cores)"
+    )
 
     set_container_executable = SetLaunchConfiguration(
         "container_executable",
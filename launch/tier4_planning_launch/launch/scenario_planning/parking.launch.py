@@ -87,6 +87,7 @@ def launch_setup(context, *args, **kwargs):
                         "minimum_lidar_height_thres": -2.2,
                         "expand_polygon_size": 1.0,
                         "size_of_expansion_kernel": 9,
+                        "use_object_footprint_cache": False,
                     },
                     vehicle_info_param,
                 ],
@@ -15,8 +15,8 @@
 #ifndef EKF_LOCALIZER__EKF_LOCALIZER_HPP_
 #define EKF_LOCALIZER__EKF_LOCALIZER_HPP_
 
+#include <kalman_filter/fixed_size_time_delay_kalman_filter.hpp>
 #include <kalman_filter/kalman_filter.hpp>
-#include <kalman_filter/time_delay_kalman_filter.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <tier4_autoware_utils/geometry/geometry.hpp>
 #include <tier4_autoware_utils/system/stop_watch.hpp>
@@ -150,8 +150,12 @@ private:
   rclcpp::TimerBase::SharedPtr timer_tf_;
   //!< @brief tf broadcaster
   std::shared_ptr<tf2_ros::TransformBroadcaster> tf_br_;
+  //!< @brief  dimension of EKF state: x, y, yaw, yaw_bias, vx, wz
+  static constexpr int dim_x_ = 6;
+  using Vector6d = Eigen::Matrix<double, dim_x_, 1>;
+  using Matrix6d = Eigen::Matrix<double, dim_x_, dim_x_>;
   //!< @brief  extended kalman filter instance.
-  TimeDelayKalmanFilter ekf_;
+  FixedSizeTimeDelayKalmanFilter<dim_x_> ekf_;
   Simple1DFilter z_filter_;
   Simple1DFilter roll_filter_;
   Simple1DFilter pitch_filter_;
@@ -163,9 +167,10 @@ private:
   double tf_rate_;                   //!< @brief  tf publish rate
   bool enable_yaw_bias_estimation_;  //!< @brief for LiDAR mount error.
                                      //!< if true,publish /estimate_yaw_bias
+  //!< @brief  update and publish on each measurement instead of waiting for the next prediction
+  bool enable_event_driven_update_;
   std::string pose_frame_id_;
 
-  int dim_x_;              //!< @brief  dimension of EKF state
   int extend_state_step_;  //!< @brief  for time delay compensation
   int dim_x_ex_;  //!< @brief  dimension of extended EKF state (dim_x_ * extended_state_step)
 
@@ -263,14 +268,29 @@ private:
   /**
    * @brief compute EKF update with pose measurement
    * @param pose measurement value
+   * @param t_curr time of the latest state, from which the delay step is counted
    */
-  void measurementUpdatePose(const geometry_msgs::msg::PoseWithCovarianceStamped & pose);
+  void measurementUpdatePose(
+    const geometry_msgs::msg::PoseWithCovarianceStamped & pose, const rclcpp::Time & t_curr);
 
   /**
    * @brief compute EKF update with pose measurement
    * @param twist measurement value
+   * @param t_curr time of the latest state, from which the delay step is counted
    */
-  void measurementUpdateTwist(const geometry_msgs::msg::TwistWithCovarianceStamped & twist);
+  void measurementUpdateTwist(
+    const geometry_msgs::msg::TwistWithCovarianceStamped & twist, const rclcpp::Time & t_curr);
+
+  /**
+   * @brief time of the latest state for a measurement stamped at stamp in the event driven mode.
+   * A measurement more recent than the last prediction is applied to the latest state.
+   */
+  rclcpp::Time getEventUpdateTime(const builtin_interfaces::msg::Time & stamp) const;
+
+  /**
+   * @brief set and publish the current EKF estimation result right after an event driven update
+   */
+  void publishEventUpdateResult();
 
   /**
    * @brief check whether a measurement value falls within the mahalanobis distance threshold
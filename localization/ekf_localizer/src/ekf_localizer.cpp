@@ -34,13 +34,14 @@
 using std::placeholders::_1;
 
 EKFLocalizer::EKFLocalizer(const std::string & node_name, const rclcpp::NodeOptions & node_options)
-: rclcpp::Node(node_name, node_options), dim_x_(6 /* x, y, yaw, yaw_bias, vx, wz */)
+: rclcpp::Node(node_name, node_options)
 {
   show_debug_info_ = declare_parameter("show_debug_info", false);
   ekf_rate_ = declare_parameter("predict_frequency", 50.0);
   ekf_dt_ = 1.0 / std::max(ekf_rate_, 0.1);
   tf_rate_ = declare_parameter("tf_rate", 10.0);
   enable_yaw_bias_estimation_ = declare_parameter("enable_yaw_bias_estimation", true);
+  enable_event_driven_update_ = declare_parameter("enable_event_driven_update", false);
   extend_state_step_ = declare_parameter("extend_state_step", 50);
   pose_frame_id_ = declare_parameter("pose_frame_id", std::string("map"));
 
@@ -164,7 +165,7 @@ void EKFLocalizer::timerCallback()
     for (int i = 0; i < pose_info_queue_size; ++i) {
       PoseInfo pose_info = current_pose_info_queue_.front();
       current_pose_info_queue_.pop();
-      measurementUpdatePose(*pose_info.pose);
+      measurementUpdatePose(*pose_info.pose, this->now());
       ++pose_info.counter;
       if (pose_info.counter < pose_info.smoothing_steps) {
         current_pose_info_queue_.push(pose_info);
@@ -183,7 +184,7 @@ void EKFLocalizer::timerCallback()
     for (int i = 0; i < twist_info_queue_size; ++i) {
       TwistInfo twist_info = current_twist_info_queue_.front();
       current_twist_info_queue_.pop();
-      measurementUpdateTwist(*twist_info.twist);
+      measurementUpdateTwist(*twist_info.twist, this->now());
       ++twist_info.counter;
       if (twist_info.counter < twist_info.smoothing_steps) {
         current_twist_info_queue_.push(twist_info);
@@ -203,7 +204,7 @@ void EKFLocalizer::timerCallback()
 void EKFLocalizer::showCurrentX()
 {
   if (show_debug_info_) {
-    Eigen::MatrixXd X(dim_x_, 1);
+    Vector6d X;
     ekf_.getLatestX(X);
     DEBUG_PRINT_MAT(X.transpose());
   }
@@ -306,8 +307,8 @@ void EKFLocalizer::callbackInitialPose(
       initialpose->header.frame_id.c_str());
   }
 
-  Eigen::MatrixXd X(dim_x_, 1);
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(dim_x_, dim_x_);
+  Vector6d X;
+  Matrix6d P = Matrix6d::Zero();
 
   // TODO(mitsudome-r) need mutex
 
@@ -346,9 +347,20 @@ void EKFLocalizer::callbackPoseWithCovariance(
   geometry_msgs::msg::PoseWithCovarianceStamped::SharedPtr msg)
 {
   PoseInfo pose_info = {msg, 0, pose_smoothing_steps_};
-  current_pose_info_queue_.push(pose_info);
-
   updateSimple1DFilters(*msg);
+
+  if (enable_event_driven_update_ && is_initialized_ && last_predict_time_) {
+    /* the first smoothing step is done right away, the others on the next predictions */
+    measurementUpdatePose(*msg, getEventUpdateTime(msg->header.stamp));
+    ++pose_info.counter;
+    if (pose_info.counter < pose_info.smoothing_steps) {
+      current_pose_info_queue_.push(pose_info);
+    }
+    publishEventUpdateResult();
+    return;
+  }
+
+  current_pose_info_queue_.push(pose_info);
 }
 
 /*
@@ -358,16 +370,46 @@ void EKFLocalizer::callbackTwistWithCovariance(
   geometry_msgs::msg::TwistWithCovarianceStamped::SharedPtr msg)
 {
   TwistInfo twist_info = {msg, 0, twist_smoothing_steps_};
+
+  if (enable_event_driven_update_ && is_initialized_ && last_predict_time_) {
+    /* the first smoothing step is done right away, the others on the next predictions */
+    measurementUpdateTwist(*msg, getEventUpdateTime(msg->header.stamp));
+    ++twist_info.counter;
+    if (twist_info.counter < twist_info.smoothing_steps) {
+      current_twist_info_queue_.push(twist_info);
+    }
+    publishEventUpdateResult();
+    return;
+  }
+
   current_twist_info_queue_.push(twist_info);
 }
 
+/*
+ * getEventUpdateTime
+ */
+rclcpp::Time EKFLocalizer::getEventUpdateTime(const builtin_interfaces::msg::Time & stamp) const
+{
+  const rclcpp::Time t_measurement(stamp, last_predict_time_->get_clock_type());
+  return std::max(*last_predict_time_, t_measurement);
+}
+
+/*
+ * publishEventUpdateResult
+ */
+void EKFLocalizer::publishEventUpdateResult()
+{
+  setCurrentResult();
+  publishEstimateResult();
+}
+
 /*
  * initEKF
  */
 void EKFLocalizer::initEKF()
 {
-  Eigen::MatrixXd X = Eigen::MatrixXd::Zero(dim_x_, 1);
-  Eigen::MatrixXd P = Eigen::MatrixXd::Identity(dim_x_, dim_x_) * 1.0E15;  // for x & y
+  Vector6d X = Vector6d::Zero();
+  Matrix6d P = Matrix6d::Identity() * 1.0E15;  // for x & y
   P(IDX::YAW, IDX::YAW) = 50.0;                                            // for yaw
   if (enable_yaw_bias_estimation_) {
     P(IDX::YAWB, IDX::YAWB) = 50.0;  // for yaw bias
@@ -405,12 +447,12 @@ void EKFLocalizer::predictKinematicsModel()
    *     [ 0, 0,                 0,                 0,             0,  1]
    */
 
-  Eigen::MatrixXd X_curr(dim_x_, 1);  // current state
-  Eigen::MatrixXd X_next(dim_x_, 1);  // predicted state
+  Vector6d X_curr;  // current state
+  Vector6d X_next;  // predicted state
   ekf_.getLatestX(X_curr);
   DEBUG_PRINT_MAT(X_curr.transpose());
 
-  Eigen::MatrixXd P_curr;
+  Matrix6d P_curr;
   ekf_.getLatestP(P_curr);
 
   const double yaw = X_curr(IDX::YAW);
@@ -430,7 +472,7 @@ void EKFLocalizer::predictKinematicsModel()
   X_next(IDX::YAW) = std::atan2(std::sin(X_next(IDX::YAW)), std::cos(X_next(IDX::YAW)));
 
   /* Set A matrix for latest state */
-  Eigen::MatrixXd A = Eigen::MatrixXd::Identity(dim_x_, dim_x_);
+  Matrix6d A = Matrix6d::Identity();
   A(IDX::X, IDX::YAW) = -vx * sin(yaw + yaw_bias) * dt;
   A(IDX::X, IDX::YAWB) = -vx * sin(yaw + yaw_bias) * dt;
   A(IDX::X, IDX::VX) = cos(yaw + yaw_bias) * dt;
@@ -439,7 +481,7 @@ void EKFLocalizer::predictKinematicsModel()
   A(IDX::Y, IDX::VX) = sin(yaw + yaw_bias) * dt;
   A(IDX::YAW, IDX::WZ) = dt;
 
-  Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(dim_x_, dim_x_);
+  Matrix6d Q = Matrix6d::Zero();
 
   Q(IDX::X, IDX::X) = 0.0;
   Q(IDX::Y, IDX::Y) = 0.0;
@@ -451,7 +493,7 @@ void EKFLocalizer::predictKinematicsModel()
   ekf_.predictWithDelay(X_next, A, Q);
 
   // debug
-  Eigen::MatrixXd X_result(dim_x_, 1);
+  Vector6d X_result;
   ekf_.getLatestX(X_result);
   DEBUG_PRINT_MAT(X_result.transpose());
   DEBUG_PRINT_MAT((X_result - X_curr).transpose());
@@ -460,7 +502,8 @@ void EKFLocalizer::predictKinematicsModel()
 /*
  * measurementUpdatePose
  */
-void EKFLocalizer::measurementUpdatePose(const geometry_msgs::msg::PoseWithCovarianceStamped & pose)
+void EKFLocalizer::measurementUpdatePose(
+  const geometry_msgs::msg::PoseWithCovarianceStamped & pose, const rclcpp::Time & t_curr)
 {
   if (pose.header.frame_id != pose_frame_id_) {
     RCLCPP_WARN_THROTTLE(
@@ -468,12 +511,11 @@ void EKFLocalizer::measurementUpdatePose(const geometry_msgs::msg::PoseWithCovar
       "pose frame_id is %s, but pose_frame is set as %s. They must be same.",
       pose.header.frame_id.c_str(), pose_frame_id_.c_str());
   }
-  Eigen::MatrixXd X_curr(dim_x_, 1);  // current state
+  Vector6d X_curr;  // current state
   ekf_.getLatestX(X_curr);
   DEBUG_PRINT_MAT(X_curr.transpose());
 
   constexpr int dim_y = 3;  // pos_x, pos_y, yaw, depending on Pose output
-  const rclcpp::Time t_curr = this->now();
 
   /* Calculate delay step */
   double delay_time = (t_curr - pose.header.stamp).seconds() + pose_additional_delay_;
@@ -501,7 +543,7 @@ void EKFLocalizer::measurementUpdatePose(const geometry_msgs::msg::PoseWithCovar
   yaw = yaw_error + ekf_yaw;
 
   /* Set measurement matrix */
-  Eigen::MatrixXd y(dim_y, 1);
+  Eigen::Matrix<double, dim_y, 1> y;
   y << pose.pose.pose.position.x, pose.pose.pose.position.y, yaw;
 
   if (isnan(y.array()).any() || isinf(y.array()).any()) {
@@ -515,7 +557,8 @@ void EKFLocalizer::measurementUpdatePose(const geometry_msgs::msg::PoseWithCovar
   Eigen::MatrixXd y_ekf(dim_y, 1);
   y_ekf << ekf_.getXelement(delay_step * dim_x_ + IDX::X),
     ekf_.getXelement(delay_step * dim_x_ + IDX::Y), ekf_yaw;
-  Eigen::MatrixXd P_curr, P_y;
+  Matrix6d P_curr;
+  Eigen::MatrixXd P_y;
   ekf_.getLatestP(P_curr);
   P_y = P_curr.block(0, 0, dim_y, dim_y);
   if (!mahalanobisGate(pose_gate_dist_, y_ekf, y, P_y)) {
@@ -531,13 +574,13 @@ void EKFLocalizer::measurementUpdatePose(const geometry_msgs::msg::PoseWithCovar
   DEBUG_PRINT_MAT((y - y_ekf).transpose());
 
   /* Set measurement matrix */
-  Eigen::MatrixXd C = Eigen::MatrixXd::Zero(dim_y, dim_x_);
+  Eigen::Matrix<double, dim_y, dim_x_> C = Eigen::Matrix<double, dim_y, dim_x_>::Zero();
   C(0, IDX::X) = 1.0;    // for pos x
   C(1, IDX::Y) = 1.0;    // for pos y
   C(2, IDX::YAW) = 1.0;  // for yaw
 
   /* Set measurement noise covariance */
-  Eigen::MatrixXd R = Eigen::MatrixXd::Zero(dim_y, dim_y);
+  Eigen::Matrix<double, dim_y, dim_y> R = Eigen::Matrix<double, dim_y, dim_y>::Zero();
   std::array<double, 36ul> current_pose_covariance = pose.pose.covariance;
   R(0, 0) = current_pose_covariance.at(0);   // x - x
   R(0, 1) = current_pose_covariance.at(1);   // x - y
@@ -556,7 +599,7 @@ void EKFLocalizer::measurementUpdatePose(const geometry_msgs::msg::PoseWithCovar
   ekf_.updateWithDelay(y, C, R, delay_step);
 
   // debug
-  Eigen::MatrixXd X_result(dim_x_, 1);
+  Vector6d X_result;
   ekf_.getLatestX(X_result);
   DEBUG_PRINT_MAT(X_result.transpose());
   DEBUG_PRINT_MAT((X_result - X_curr).transpose());
@@ -566,7 +609,7 @@ void EKFLocalizer::measurementUpdatePose(const geometry_msgs::msg::PoseWithCovar
  * measurementUpdateTwist
  */
 void EKFLocalizer::measurementUpdateTwist(
-  const geometry_msgs::msg::TwistWithCovarianceStamped & twist)
+  const geometry_msgs::msg::TwistWithCovarianceStamped & twist, const rclcpp::Time & t_curr)
 {
   if (twist.header.frame_id != "base_link") {
     RCLCPP_WARN_THROTTLE(
@@ -574,12 +617,11 @@ void EKFLocalizer::measurementUpdateTwist(
       "twist frame_id must be base_link");
   }
 
-  Eigen::MatrixXd X_curr(dim_x_, 1);  // current state
+  Vector6d X_curr;  // current state
   ekf_.getLatestX(X_curr);
   DEBUG_PRINT_MAT(X_curr.transpose());
 
   constexpr int dim_y = 2;  // vx, wz
-  const rclcpp::Time t_curr = this->now();
 
   /* Calculate delay step */
   double delay_time = (t_curr - twist.header.stamp).seconds() + twist_additional_delay_;
@@ -601,7 +643,7 @@ void EKFLocalizer::measurementUpdateTwist(
   DEBUG_INFO(get_logger(), "delay_time: %f [s]", delay_time);
 
   /* Set measurement matrix */
-  Eigen::MatrixXd y(dim_y, 1);
+  Eigen::Matrix<double, dim_y, 1> y;
   y << twist.twist.twist.linear.x, twist.twist.twist.angular.z;
 
   if (isnan(y.array()).any() || isinf(y.array()).any()) {
@@ -615,7 +657,8 @@ void EKFLocalizer::measurementUpdateTwist(
   Eigen::MatrixXd y_ekf(dim_y, 1);
   y_ekf << ekf_.getXelement(delay_step * dim_x_ + IDX::VX),
     ekf_.getXelement(delay_step * dim_x_ + IDX::WZ);
-  Eigen::MatrixXd P_curr, P_y;
+  Matrix6d P_curr;
+  Eigen::MatrixXd P_y;
   ekf_.getLatestP(P_curr);
   P_y = P_curr.block(4, 4, dim_y, dim_y);
   if (!mahalanobisGate(twist_gate_dist_, y_ekf, y, P_y)) {
@@ -631,12 +674,12 @@ void EKFLocalizer::measurementUpdateTwist(
   DEBUG_PRINT_MAT((y - y_ekf).transpose());
 
   /* Set measurement matrix */
-  Eigen::MatrixXd C = Eigen::MatrixXd::Zero(dim_y, dim_x_);
+  Eigen::Matrix<double, dim_y, dim_x_> C = Eigen::Matrix<double, dim_y, dim_x_>::Zero();
   C(0, IDX::VX) = 1.0;  // for vx
   C(1, IDX::WZ) = 1.0;  // for wz
 
   /* Set measurement noise covariance */
-  Eigen::MatrixXd R = Eigen::MatrixXd::Zero(dim_y, dim_y);
+  Eigen::Matrix<double, dim_y, dim_y> R = Eigen::Matrix<double, dim_y, dim_y>::Zero();
   std::array<double, 36ul> current_twist_covariance = twist.twist.covariance;
   R(0, 0) = current_twist_covariance.at(0);   // vx - vx
   R(0, 1) = current_twist_covariance.at(5);   // vx - wz
@@ -650,7 +693,7 @@ void EKFLocalizer::measurementUpdateTwist(
   ekf_.updateWithDelay(y, C, R, delay_step);
 
   // debug
-  Eigen::MatrixXd X_result(dim_x_, 1);
+  Vector6d X_result;
   ekf_.getLatestX(X_result);
   DEBUG_PRINT_MAT(X_result.transpose());
   DEBUG_PRINT_MAT((X_result - X_curr).transpose());
@@ -680,8 +723,8 @@ bool EKFLocalizer::mahalanobisGate(
 void EKFLocalizer::publishEstimateResult()
 {
   rclcpp::Time current_time = this->now();
-  Eigen::MatrixXd X(dim_x_, 1);
-  Eigen::MatrixXd P(dim_x_, dim_x_);
+  Vector6d X;
+  Matrix6d P;
   ekf_.getLatestX(X);
   ekf_.getLatestP(P);
 
@@ -22,6 +22,13 @@
 
 #include <vector>
 
+// scores of the input source placed at a pose in the target
+struct NDTScores
+{
+  double transformation_probability;
+  double nearest_voxel_transformation_likelihood;
+};
+
 template <class PointSource, class PointTarget>
 class NormalDistributionsTransformBase
 {
@@ -64,6 +71,13 @@ public:
     const pcl::PointCloud<PointSource> & trans_cloud) const = 0;
   virtual double calculateNearestVoxelTransformationLikelihood(
     const pcl::PointCloud<PointSource> & trans_cloud) const = 0;
+
+  /**
+   * \brief Score the input source at each of the poses without aligning it. The metrics of a pose
+   * share its transformed cloud, and the implementations scoring them in one pass do so.
+   */
+  virtual std::vector<NDTScores> evaluatePoses(
+    const std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>> & poses) const;
 };
 
 #include "ndt/impl/base.hpp"
@@ -0,0 +1,63 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NDT__CUDA_HPP_
+#define NDT__CUDA_HPP_
+
+#include "ndt/cuda/voxel_derivatives.hpp"
+#include "ndt/voxel_hash.hpp"
+
+#include <memory>
+#include <vector>
+
+/**
+ * \brief NormalDistributionsTransformVoxelHash with the point derivatives computed on the GPU.
+ * The voxels are built on the host and uploaded once per map, the source points once per scan,
+ * and each evaluation of the optimization only moves the transformation and the block sums. The
+ * Newton steps, the line search and the final scores stay on the host, so the results match the
+ * CPU implementation up to the summation order.
+ */
+template <class PointSource, class PointTarget>
+class NormalDistributionsTransformCUDA
+: public NormalDistributionsTransformVoxelHash<PointSource, PointTarget>
+{
+public:
+  NormalDistributionsTransformCUDA();
+  ~NormalDistributionsTransformCUDA() = default;
+
+  void setInputTarget(const pcl::shared_ptr<pcl::PointCloud<PointTarget>> & map_ptr) override;
+  void setInputSource(const pcl::shared_ptr<pcl::PointCloud<PointSource>> & scan_ptr) override;
+  void setResolution(float res) override;
+
+protected:
+  using Base = NormalDistributionsTransformVoxelHash<PointSource, PointTarget>;
+  using Vector6d = typename Base::Vector6d;
+  using Matrix6d = typename Base::Matrix6d;
+
+  double computePointDerivatives(
+    const Vector6d & p, const pcl::PointCloud<PointSource> & trans_cloud, Vector6d & score_gradient,
+    Matrix6d & hessian, const bool compute_hessian, size_t & neighbor_num) const override;
+
+private:
+  void uploadVoxels();
+
+  std::unique_ptr<ndt_cuda::VoxelDerivatives> device_;
+  std::vector<float> source_xyz_;
+};
+
+// the implementation is only compiled in the library, next to the device code
+extern template class NormalDistributionsTransformCUDA<pcl::PointXYZ, pcl::PointXYZ>;
+extern template class NormalDistributionsTransformCUDA<pcl::PointXYZI, pcl::PointXYZI>;
+
+#endif  // NDT__CUDA_HPP_
@@ -0,0 +1,70 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NDT__CUDA__VOXEL_DERIVATIVES_HPP_
+#define NDT__CUDA__VOXEL_DERIVATIVES_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ndt_cuda
+{
+struct DerivativesResult
+{
+  double score;
+  double score_gradient[6];
+  double hessian[36];  // column major
+  std::size_t neighbor_num;
+};
+
+/** \brief Device side of NormalDistributionsTransformCUDA. The voxels of the host hash table and
+ * the source points stay resident in device memory, only the transformation goes up and the
+ * per block partial sums come back for each evaluation. The device buffers are grow-only.
+ */
+class VoxelDerivatives
+{
+public:
+  VoxelDerivatives();
+  ~VoxelDerivatives();
+
+  /** \brief Upload the voxel storage of NormalDistributionsTransformVoxelHash, the key packing
+   * and hashing being the same on the device. */
+  void setVoxels(
+    const std::vector<float> & means, const std::vector<float> & inverse_covariances,
+    const std::vector<int64_t> & table_keys, const std::vector<int> & table_voxel_indices,
+    const float resolution);
+
+  /** \brief Upload point_num source points as packed x, y, z. */
+  void setSource(const float * xyz, const std::size_t point_num);
+
+  /** \brief Score and derivatives of the source points transformed by transformation, over the
+   * voxel they fall in and its 6 face neighbors.
+   * \param transformation 4x4 column major
+   * \param angle_jacobian 8x3 column major, eq. 6.19 [Magnusson 2009]
+   * \param angle_hessian 15x3 column major, eq. 6.21 [Magnusson 2009], unused without hessian
+   */
+  void compute(
+    const float * transformation, const double * angle_jacobian, const double * angle_hessian,
+    const double gauss_d1, const double gauss_d2, const bool compute_hessian,
+    DerivativesResult & result) const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace ndt_cuda
+
+#endif  // NDT__CUDA__VOXEL_DERIVATIVES_HPP_
@@ -17,9 +17,32 @@
 
 #include "ndt/base.hpp"
 
+#include <pcl/common/transforms.h>
+
+#include <vector>
+
 template <class PointSource, class PointTarget>
 NormalDistributionsTransformBase<PointSource, PointTarget>::NormalDistributionsTransformBase()
 {
 }
 
+template <class PointSource, class PointTarget>
+std::vector<NDTScores> NormalDistributionsTransformBase<PointSource, PointTarget>::evaluatePoses(
+  const std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>> & poses) const
+{
+  std::vector<NDTScores> scores(poses.size(), NDTScores{0.0, 0.0});
+  const auto source = getInputSource();
+  if (!source || !getInputTarget()) {
+    return scores;
+  }
+  pcl::PointCloud<PointSource> trans_cloud;
+  for (size_t i = 0; i < poses.size(); ++i) {
+    pcl::transformPointCloud(*source, trans_cloud, poses[i]);
+    scores[i].transformation_probability = calculateTransformationProbability(trans_cloud);
+    scores[i].nearest_voxel_transformation_likelihood =
+      calculateNearestVoxelTransformationLikelihood(trans_cloud);
+  }
+  return scores;
+}
+
 #endif  // NDT__IMPL__BASE_HPP_
@@ -0,0 +1,90 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NDT__IMPL__CUDA_HPP_
+#define NDT__IMPL__CUDA_HPP_
+
+#include "ndt/cuda.hpp"
+#include "ndt/impl/voxel_hash.hpp"
+
+#include <memory>
+#include <vector>
+
+template <class PointSource, class PointTarget>
+NormalDistributionsTransformCUDA<PointSource, PointTarget>::NormalDistributionsTransformCUDA()
+: device_(std::make_unique<ndt_cuda::VoxelDerivatives>())
+{
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformCUDA<PointSource, PointTarget>::setInputTarget(
+  const pcl::shared_ptr<pcl::PointCloud<PointTarget>> & map_ptr)
+{
+  Base::setInputTarget(map_ptr);
+  uploadVoxels();
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformCUDA<PointSource, PointTarget>::setInputSource(
+  const pcl::shared_ptr<pcl::PointCloud<PointSource>> & scan_ptr)
+{
+  Base::setInputSource(scan_ptr);
+  source_xyz_.resize(3 * scan_ptr->points.size());
+  for (size_t i = 0; i < scan_ptr->points.size(); ++i) {
+    source_xyz_[3 * i] = scan_ptr->points[i].x;
+    source_xyz_[3 * i + 1] = scan_ptr->points[i].y;
+    source_xyz_[3 * i + 2] = scan_ptr->points[i].z;
+  }
+  device_->setSource(source_xyz_.data(), scan_ptr->points.size());
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformCUDA<PointSource, PointTarget>::setResolution(float res)
+{
+  const bool is_changed = res != this->resolution_;
+  Base::setResolution(res);
+  if (is_changed && this->target_) {
+    uploadVoxels();
+  }
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformCUDA<PointSource, PointTarget>::computePointDerivatives(
+  const Vector6d & p, const pcl::PointCloud<PointSource> & /*trans_cloud*/,
+  Vector6d & score_gradient, Matrix6d & hessian, const bool compute_hessian,
+  size_t & neighbor_num) const
+{
+  // the device transforms the source points itself, with the same transformation as trans_cloud
+  const auto angle_derivatives = this->computeAngleDerivatives(p, compute_hessian);
+  const Eigen::Matrix4f transformation = ndt_voxel_hash::toMatrix(p);
+  ndt_cuda::DerivativesResult result;
+  device_->compute(
+    transformation.data(), angle_derivatives.jacobian.data(), angle_derivatives.hessian.data(),
+    this->gauss_d1_, this->gauss_d2_, compute_hessian, result);
+
+  score_gradient = Eigen::Map<const Vector6d>(result.score_gradient);
+  hessian = Eigen::Map<const Matrix6d>(result.hessian);
+  neighbor_num = result.neighbor_num;
+  return result.score;
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformCUDA<PointSource, PointTarget>::uploadVoxels()
+{
+  device_->setVoxels(
+    this->voxel_means_, this->voxel_inverse_covariances_, this->table_keys_,
+    this->table_voxel_indices_, this->resolution_);
+}
+
+#endif  // NDT__IMPL__CUDA_HPP_
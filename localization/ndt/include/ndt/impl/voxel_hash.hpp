@@ -0,0 +1,999 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NDT__IMPL__VOXEL_HASH_HPP_
+#define NDT__IMPL__VOXEL_HASH_HPP_
+
+#include "ndt/voxel_hash.hpp"
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/SVD>
+
+#include <pcl/common/transforms.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace ndt_voxel_hash
+{
+// the voxel coordinates take 21 bits each in a key, which covers +-2^20 voxels around the origin
+constexpr int64_t key_offset = int64_t{1} << 20;
+constexpr int64_t key_mask = (int64_t{1} << 21) - 1;
+constexpr int64_t empty_key = -1;
+
+inline int64_t packKey(const int64_t ix, const int64_t iy, const int64_t iz)
+{
+  return (((ix + key_offset) & key_mask) << 42) | (((iy + key_offset) & key_mask) << 21) |
+         ((iz + key_offset) & key_mask);
+}
+
+inline size_t hashKey(const int64_t key)
+{
+  return static_cast<size_t>((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> 32);
+}
+
+// the gaussian fitting parameters, eq. 6.8 [Magnusson 2009]
+inline void computeGaussParameters(
+  const double outlier_ratio, const double resolution, double & gauss_d1, double & gauss_d2)
+{
+  const double gauss_c1 = 10.0 * (1.0 - outlier_ratio);
+  const double gauss_c2 = outlier_ratio / std::pow(resolution, 3);
+  const double gauss_d3 = -std::log(gauss_c2);
+  gauss_d1 = -std::log(gauss_c1 + gauss_c2) - gauss_d3;
+  gauss_d2 =
+    -2.0 * std::log((-std::log(gauss_c1 * std::exp(-0.5) + gauss_c2) - gauss_d3) / gauss_d1);
+}
+
+inline Eigen::Matrix4f toMatrix(const Eigen::Matrix<double, 6, 1> & p)
+{
+  return (Eigen::Translation<float, 3>(
+            static_cast<float>(p(0)), static_cast<float>(p(1)), static_cast<float>(p(2))) *
+          Eigen::AngleAxis<float>(static_cast<float>(p(3)), Eigen::Vector3f::UnitX()) *
+          Eigen::AngleAxis<float>(static_cast<float>(p(4)), Eigen::Vector3f::UnitY()) *
+          Eigen::AngleAxis<float>(static_cast<float>(p(5)), Eigen::Vector3f::UnitZ()))
+    .matrix();
+}
+
+// line search helpers [More, Thuente 1994], as in pcl::NormalDistributionsTransform
+inline double auxiliaryFunctionPsiMT(
+  const double a, const double f_a, const double f_0, const double g_0, const double mu)
+{
+  return f_a - f_0 - mu * g_0 * a;
+}
+
+inline double auxiliaryFunctionDPsiMT(const double g_a, const double g_0, const double mu)
+{
+  return g_a - mu * g_0;
+}
+
+inline bool updateIntervalMT(
+  double & a_l, double & f_l, double & g_l, double & a_u, double & f_u, double & g_u,
+  const double a_t, const double f_t, const double g_t)
+{
+  // Case U1 in Update Algorithm and Case a in Modified Update Algorithm
+  if (f_t > f_l) {
+    a_u = a_t;
+    f_u = f_t;
+    g_u = g_t;
+    return false;
+  }
+  // Case U2 in Update Algorithm and Case b in Modified Update Algorithm
+  if (g_t * (a_l - a_t) > 0) {
+    a_l = a_t;
+    f_l = f_t;
+    g_l = g_t;
+    return false;
+  }
+  // Case U3 in Update Algorithm and Case c in Modified Update Algorithm
+  if (g_t * (a_l - a_t) < 0) {
+    a_u = a_l;
+    f_u = f_l;
+    g_u = g_l;
+
+    a_l = a_t;
+    f_l = f_t;
+    g_l = g_t;
+    return false;
+  }
+  // Interval Converged
+  return true;
+}
+
+inline double trialValueSelectionMT(
+  const double a_l, const double f_l, const double g_l, const double a_u, const double f_u,
+  const double g_u, const double a_t, const double f_t, const double g_t)
+{
+  // Case 1 in Trial Value Selection
+  if (f_t > f_l) {
+    // minimizer of the cubic that interpolates f_l, f_t, g_l and g_t, eq. 2.4.52 [Sun, Yuan 2006]
+    const double z = 3 * (f_t - f_l) / (a_t - a_l) - g_t - g_l;
+    const double w = std::sqrt(z * z - g_t * g_l);
+    const double a_c = a_l + (a_t - a_l) * (w - g_l - z) / (g_t - g_l + 2 * w);
+    // minimizer of the quadratic that interpolates f_l, f_t and g_l, eq. 2.4.2 [Sun, Yuan 2006]
+    const double a_q = a_l - 0.5 * (a_l - a_t) * g_l / (g_l - (f_l - f_t) / (a_l - a_t));
+    return std::fabs(a_c - a_l) < std::fabs(a_q - a_l) ? a_c : 0.5 * (a_q + a_c);
+  }
+  // Case 2 in Trial Value Selection
+  if (g_t * g_l < 0) {
+    const double z = 3 * (f_t - f_l) / (a_t - a_l) - g_t - g_l;
+    const double w = std::sqrt(z * z - g_t * g_l);
+    const double a_c = a_l + (a_t - a_l) * (w - g_l - z) / (g_t - g_l + 2 * w);
+    // minimizer of the quadratic that interpolates f_l, g_l and g_t, eq. 2.4.5 [Sun, Yuan 2006]
+    const double a_s = a_l - (a_l - a_t) / (g_l - g_t) * g_l;
+    return std::fabs(a_c - a_t) >= std::fabs(a_s - a_t) ? a_c : a_s;
+  }
+  // Case 3 in Trial Value Selection
+  if (std::fabs(g_t) <= std::fabs(g_l)) {
+    const double z = 3 * (f_t - f_l) / (a_t - a_l) - g_t - g_l;
+    const double w = std::sqrt(z * z - g_t * g_l);
+    const double a_c = a_l + (a_t - a_l) * (w - g_l - z) / (g_t - g_l + 2 * w);
+    const double a_s = a_l - (a_l - a_t) / (g_l - g_t) * g_l;
+    const double a_t_next = std::fabs(a_c - a_t) < std::fabs(a_s - a_t) ? a_c : a_s;
+    if (a_t > a_l) {
+      return std::min(a_t + 0.66 * (a_u - a_t), a_t_next);
+    }
+    return std::max(a_t + 0.66 * (a_u - a_t), a_t_next);
+  }
+  // Case 4 in Trial Value Selection, minimizer of the cubic that interpolates f_u, f_t, g_u and g_t
+  const double z = 3 * (f_t - f_u) / (a_t - a_u) - g_t - g_u;
+  const double w = std::sqrt(z * z - g_t * g_u);
+  return a_u + (a_t - a_u) * (w - g_u - z) / (g_t - g_u + 2 * w);
+}
+}  // namespace ndt_voxel_hash
+
+template <class PointSource, class PointTarget>
+NormalDistributionsTransformVoxelHash<
+  PointSource, PointTarget>::NormalDistributionsTransformVoxelHash()
+: resolution_(1.0f),
+  voxel_num_(0),
+  table_mask_(0),
+  step_size_(0.1),
+  transformation_epsilon_(0.1),
+  max_iterations_(35),
+  outlier_ratio_(0.55),
+  min_points_per_voxel_(6),
+#ifdef _OPENMP
+  num_threads_(omp_get_max_threads()),
+#else
+  num_threads_(1),
+#endif
+  nr_iterations_(0),
+  converged_(false),
+  final_transformation_(Eigen::Matrix4f::Identity()),
+  hessian_(Matrix6d::Zero()),
+  trans_probability_(0.0),
+  nearest_voxel_transformation_likelihood_(0.0),
+  regularization_enabled_(false),
+  regularization_scale_factor_(0.0f),
+  regularization_position_(Eigen::Vector2d::Zero())
+{
+  ndt_voxel_hash::computeGaussParameters(outlier_ratio_, resolution_, gauss_d1_, gauss_d2_);
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::align(
+  pcl::PointCloud<PointSource> & output, const Eigen::Matrix4f & guess)
+{
+  nr_iterations_ = 0;
+  converged_ = false;
+  final_transformation_ = guess;
+  transformation_array_.clear();
+  if (!input_ || input_->points.empty() || voxel_num_ == 0) {
+    output.clear();
+    return;
+  }
+
+  pcl::transformPointCloud(*input_, output, guess);
+
+  // the initial guess as a 6 element transformation vector
+  Eigen::Transform<float, 3, Eigen::Affine, Eigen::ColMajor> eig_transformation;
+  eig_transformation.matrix() = guess;
+  const Eigen::Vector3f init_translation = eig_transformation.translation();
+  const Eigen::Vector3f init_rotation = eig_transformation.rotation().eulerAngles(0, 1, 2);
+  Vector6d p;
+  p << init_translation(0), init_translation(1), init_translation(2), init_rotation(0),
+    init_rotation(1), init_rotation(2);
+
+  Vector6d score_gradient;
+  Matrix6d hessian;
+  // the derivatives of the next steps are computed in the step length determination
+  double score = computeDerivatives(p, output, score_gradient, hessian, true);
+
+  transformation_array_.push_back(final_transformation_);
+  while (!converged_) {
+    // decent direction with the newton method, line 23 in Algorithm 2 [Magnusson 2009]
+    Eigen::JacobiSVD<Matrix6d> sv(hessian, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    // negative for maximization as opposed to minimization
+    Vector6d delta_p = sv.solve(-score_gradient);
+
+    double delta_p_norm = delta_p.norm();
+    if (delta_p_norm == 0 || std::isnan(delta_p_norm)) {
+      converged_ = !std::isnan(delta_p_norm);
+      break;
+    }
+
+    delta_p.normalize();
+    delta_p_norm = computeStepLengthMT(
+      p, delta_p, delta_p_norm, step_size_, transformation_epsilon_ / 2, score, score_gradient,
+      hessian, output);
+    delta_p *= delta_p_norm;
+    p = p + delta_p;
+
+    transformation_array_.push_back(final_transformation_);
+
+    if (
+      nr_iterations_ > max_iterations_ ||
+      (nr_iterations_ && std::fabs(delta_p_norm) < transformation_epsilon_)) {
+      converged_ = true;
+    }
+    nr_iterations_++;
+  }
+
+  // the relative differences within each scan registration are accurate but the normalization
+  // constants need to be modified for it to be globally accurate
+  trans_probability_ = score / static_cast<double>(input_->points.size());
+  nearest_voxel_transformation_likelihood_ = calculateNearestVoxelTransformationLikelihood(output);
+  hessian_ = hessian;
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setInputTarget(
+  const pcl::shared_ptr<pcl::PointCloud<PointTarget>> & map_ptr)
+{
+  target_ = map_ptr;
+  buildVoxels();
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setInputSource(
+  const pcl::shared_ptr<pcl::PointCloud<PointSource>> & scan_ptr)
+{
+  input_ = scan_ptr;
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setMaximumIterations(
+  int max_iter)
+{
+  max_iterations_ = max_iter;
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setResolution(float res)
+{
+  if (resolution_ == res) {
+    return;
+  }
+  resolution_ = res;
+  ndt_voxel_hash::computeGaussParameters(outlier_ratio_, resolution_, gauss_d1_, gauss_d2_);
+  if (target_) {
+    buildVoxels();
+  }
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setStepSize(double step_size)
+{
+  step_size_ = step_size;
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setTransformationEpsilon(
+  double trans_eps)
+{
+  transformation_epsilon_ = trans_eps;
+}
+
+template <class PointSource, class PointTarget>
+int NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getMaximumIterations()
+{
+  return max_iterations_;
+}
+
+template <class PointSource, class PointTarget>
+int NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getFinalNumIteration() const
+{
+  return nr_iterations_;
+}
+
+template <class PointSource, class PointTarget>
+float NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getResolution() const
+{
+  return resolution_;
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getStepSize() const
+{
+  return step_size_;
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getTransformationEpsilon()
+{
+  return transformation_epsilon_;
+}
+
+template <class PointSource, class PointTarget>
+double
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getTransformationProbability()
+  const
+{
+  return trans_probability_;
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformVoxelHash<
+  PointSource, PointTarget>::getNearestVoxelTransformationLikelihood() const
+{
+  return nearest_voxel_transformation_likelihood_;
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getFitnessScore()
+{
+  // mean squared distance of the points to the closest mean of the voxels they are scored against
+  if (!input_ || input_->points.empty()) {
+    return std::numeric_limits<double>::max();
+  }
+  pcl::PointCloud<PointSource> trans_cloud;
+  pcl::transformPointCloud(*input_, trans_cloud, final_transformation_);
+  double fitness_score = 0.0;
+  int nr = 0;
+  for (const auto & point : trans_cloud.points) {
+    int voxel_indices[7];
+    const int neighbor_num = findNeighborVoxels(point.x, point.y, point.z, voxel_indices);
+    double min_distance = std::numeric_limits<double>::max();
+    for (int k = 0; k < neighbor_num; ++k) {
+      const float * mean = &voxel_means_[3 * voxel_indices[k]];
+      const double dx = point.x - mean[0];
+      const double dy = point.y - mean[1];
+      const double dz = point.z - mean[2];
+      min_distance = std::min(min_distance, dx * dx + dy * dy + dz * dz);
+    }
+    if (neighbor_num > 0) {
+      fitness_score += min_distance;
+      ++nr;
+    }
+  }
+  return nr > 0 ? fitness_score / nr : std::numeric_limits<double>::max();
+}
+
+template <class PointSource, class PointTarget>
+pcl::shared_ptr<const pcl::PointCloud<PointTarget>>
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getInputTarget() const
+{
+  return target_;
+}
+
+template <class PointSource, class PointTarget>
+pcl::shared_ptr<const pcl::PointCloud<PointSource>>
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getInputSource() const
+{
+  return input_;
+}
+
+template <class PointSource, class PointTarget>
+Eigen::Matrix4f
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getFinalTransformation() const
+{
+  return final_transformation_;
+}
+
+template <class PointSource, class PointTarget>
+std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>>
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getFinalTransformationArray() const
+{
+  return transformation_array_;
+}
+
+template <class PointSource, class PointTarget>
+Eigen::Matrix<double, 6, 6>
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getHessian() const
+{
+  return hessian_;
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setRegularizationScaleFactor(
+  const float regularization_scale_factor)
+{
+  regularization_scale_factor_ = regularization_scale_factor;
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setRegularizationPose(
+  const Eigen::Matrix4f & regularization_pose)
+{
+  regularization_enabled_ = true;
+  regularization_position_ = regularization_pose.block<2, 1>(0, 3).cast<double>();
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::unsetRegularizationPose()
+{
+  regularization_enabled_ = false;
+}
+
+template <class PointSource, class PointTarget>
+pcl::shared_ptr<pcl::search::KdTree<PointTarget>>
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getSearchMethodTarget() const
+{
+  return nullptr;
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::
+  calculateTransformationProbability(const pcl::PointCloud<PointSource> & trans_cloud) const
+{
+  const auto get_point = [&trans_cloud](const size_t i) {
+    const auto & point = trans_cloud.points[i];
+    return Eigen::Vector3f(point.x, point.y, point.z);
+  };
+  return computeScores(trans_cloud.points.size(), get_point).transformation_probability;
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::
+  calculateNearestVoxelTransformationLikelihood(
+    const pcl::PointCloud<PointSource> & trans_cloud) const
+{
+  const auto get_point = [&trans_cloud](const size_t i) {
+    const auto & point = trans_cloud.points[i];
+    return Eigen::Vector3f(point.x, point.y, point.z);
+  };
+  return computeScores(trans_cloud.points.size(), get_point)
+    .nearest_voxel_transformation_likelihood;
+}
+
+template <class PointSource, class PointTarget>
+std::vector<NDTScores>
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::evaluatePoses(
+  const std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>> & poses) const
+{
+  std::vector<NDTScores> scores(poses.size(), NDTScores{0.0, 0.0});
+  if (!input_) {
+    return scores;
+  }
+  for (size_t k = 0; k < poses.size(); ++k) {
+    const Eigen::Matrix3f rotation = poses[k].topLeftCorner<3, 3>();
+    const Eigen::Vector3f translation = poses[k].topRightCorner<3, 1>();
+    const auto get_point = [this, &rotation, &translation](const size_t i) {
+      const auto & point = input_->points[i];
+      return Eigen::Vector3f(rotation * Eigen::Vector3f(point.x, point.y, point.z) + translation);
+    };
+    scores[k] = computeScores(input_->points.size(), get_point);
+  }
+  return scores;
+}
+
+template <class PointSource, class PointTarget>
+template <class GetPoint>
+NDTScores NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::computeScores(
+  const size_t point_num, const GetPoint & get_point) const
+{
+  double score = 0.0;
+  double nearest_voxel_score_sum = 0.0;
+  int found_neighborhood_voxel_num = 0;
+  const auto n = static_cast<int>(point_num);
+#pragma omp parallel for num_threads(num_threads_) schedule(guided, 8) \
+  reduction(+ : score, nearest_voxel_score_sum, found_neighborhood_voxel_num)
+  for (int i = 0; i < n; ++i) {
+    const Eigen::Vector3f point = get_point(i);
+    int voxel_indices[7];
+    const int neighbor_num = findNeighborVoxels(point.x(), point.y(), point.z(), voxel_indices);
+    double nearest_voxel_score = 0.0;
+    for (int k = 0; k < neighbor_num; ++k) {
+      const float * mean = &voxel_means_[3 * voxel_indices[k]];
+      const float * c = &voxel_inverse_covariances_[6 * voxel_indices[k]];
+      const Eigen::Vector3d d(point.x() - mean[0], point.y() - mean[1], point.z() - mean[2]);
+      const double q = d(0) * (c[0] * d(0) + 2.0 * (c[1] * d(1) + c[2] * d(2))) +
+                       d(1) * (c[3] * d(1) + 2.0 * c[4] * d(2)) + d(2) * c[5] * d(2);
+      const double score_inc = -gauss_d1_ * std::exp(-gauss_d2_ * q / 2.0);
+      score += score_inc;
+      nearest_voxel_score = std::max(nearest_voxel_score, score_inc);
+    }
+    if (neighbor_num > 0) {
+      nearest_voxel_score_sum += nearest_voxel_score;
+      ++found_neighborhood_voxel_num;
+    }
+  }
+
+  NDTScores scores{0.0, 0.0};
+  if (n > 0) {
+    scores.transformation_probability = score / static_cast<double>(n);
+  }
+  if (found_neighborhood_voxel_num > 0) {
+    scores.nearest_voxel_transformation_likelihood =
+      nearest_voxel_score_sum / static_cast<double>(found_neighborhood_voxel_num);
+  }
+  return scores;
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::setNumThreads(int n)
+{
+  num_threads_ = std::max(n, 1);
+}
+
+template <class PointSource, class PointTarget>
+int NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getNumThreads() const
+{
+  return num_threads_;
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::buildVoxels()
+{
+  struct VoxelSum
+  {
+    int n;
+    Eigen::Vector3d sum;
+    Eigen::Matrix3d sum_xx;
+  };
+
+  std::unordered_map<int64_t, size_t> voxel_sum_indices;
+  std::vector<int64_t> keys;
+  std::vector<VoxelSum, Eigen::aligned_allocator<VoxelSum>> sums;
+  for (const auto & point : target_->points) {
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+      continue;
+    }
+    const int64_t key = getVoxelKey(point.x, point.y, point.z);
+    const auto result = voxel_sum_indices.emplace(key, sums.size());
+    if (result.second) {
+      keys.push_back(key);
+      sums.push_back(VoxelSum{0, Eigen::Vector3d::Zero(), Eigen::Matrix3d::Zero()});
+    }
+    auto & voxel_sum = sums[result.first->second];
+    const Eigen::Vector3d x(point.x, point.y, point.z);
+    ++voxel_sum.n;
+    voxel_sum.sum += x;
+    voxel_sum.sum_xx += x * x.transpose();
+  }
+
+  // covariances of the voxels with enough points, flattening the near singular ones, eq. 6.11
+  // [Magnusson 2009]
+  const auto sum_num = static_cast<int>(sums.size());
+  std::vector<float> means(3 * sums.size());
+  std::vector<float> inverse_covariances(6 * sums.size());
+  std::vector<char> is_valid(sums.size(), 0);
+#pragma omp parallel for num_threads(num_threads_) schedule(guided, 64)
+  for (int i = 0; i < sum_num; ++i) {
+    const auto & voxel_sum = sums[i];
+    if (voxel_sum.n < min_points_per_voxel_) {
+      continue;
+    }
+    const Eigen::Vector3d mean = voxel_sum.sum / voxel_sum.n;
+    Eigen::Matrix3d covariance =
+      (voxel_sum.sum_xx - voxel_sum.n * mean * mean.transpose()) / (voxel_sum.n - 1);
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> eigen_solver(covariance);
+    Eigen::Vector3d eigen_values = eigen_solver.eigenvalues();
+    if (eigen_values(0) < 0 || eigen_values(1) < 0 || eigen_values(2) <= 0) {
+      continue;
+    }
+    const double min_covariance_eigen_value = 0.01 * eigen_values(2);
+    if (eigen_values(0) < min_covariance_eigen_value) {
+      eigen_values(0) = min_covariance_eigen_value;
+      eigen_values(1) = std::max(eigen_values(1), min_covariance_eigen_value);
+      const Eigen::Matrix3d & eigen_vectors = eigen_solver.eigenvectors();
+      covariance = eigen_vectors * eigen_values.asDiagonal() * eigen_vectors.transpose();
+    }
+    const Eigen::Matrix3d inverse_covariance = covariance.inverse();
+    if (!inverse_covariance.allFinite()) {
+      continue;
+    }
+    for (int k = 0; k < 3; ++k) {
+      means[3 * i + k] = static_cast<float>(mean(k));
+    }
+    inverse_covariances[6 * i + 0] = static_cast<float>(inverse_covariance(0, 0));
+    inverse_covariances[6 * i + 1] = static_cast<float>(inverse_covariance(0, 1));
+    inverse_covariances[6 * i + 2] = static_cast<float>(inverse_covariance(0, 2));
+    inverse_covariances[6 * i + 3] = static_cast<float>(inverse_covariance(1, 1));
+    inverse_covariances[6 * i + 4] = static_cast<float>(inverse_covariance(1, 2));
+    inverse_covariances[6 * i + 5] = static_cast<float>(inverse_covariance(2, 2));
+    is_valid[i] = 1;
+  }
+
+  voxel_num_ = static_cast<size_t>(std::count(is_valid.begin(), is_valid.end(), 1));
+  voxel_means_.clear();
+  voxel_inverse_covariances_.clear();
+  voxel_means_.reserve(3 * voxel_num_);
+  voxel_inverse_covariances_.reserve(6 * voxel_num_);
+
+  size_t table_size = 16;
+  while (table_size < 2 * voxel_num_) {
+    table_size *= 2;
+  }
+  table_mask_ = table_size - 1;
+  table_keys_.assign(table_size, ndt_voxel_hash::empty_key);
+  table_voxel_indices_.assign(table_size, -1);
+
+  int voxel_index = 0;
+  for (size_t i = 0; i < sums.size(); ++i) {
+    if (!is_valid[i]) {
+      continue;
+    }
+    voxel_means_.insert(voxel_means_.end(), means.begin() + 3 * i, means.begin() + 3 * i + 3);
+    voxel_inverse_covariances_.insert(
+      voxel_inverse_covariances_.end(), inverse_covariances.begin() + 6 * i,
+      inverse_covariances.begin() + 6 * i + 6);
+    size_t slot = ndt_voxel_hash::hashKey(keys[i]) & table_mask_;
+    while (table_keys_[slot] != ndt_voxel_hash::empty_key) {
+      slot = (slot + 1) & table_mask_;
+    }
+    table_keys_[slot] = keys[i];
+    table_voxel_indices_[slot] = voxel_index++;
+  }
+}
+
+template <class PointSource, class PointTarget>
+int64_t NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::getVoxelKey(
+  const float x, const float y, const float z) const
+{
+  const float inverse_resolution = 1.0f / resolution_;
+  return ndt_voxel_hash::packKey(
+    static_cast<int64_t>(std::floor(x * inverse_resolution)),
+    static_cast<int64_t>(std::floor(y * inverse_resolution)),
+    static_cast<int64_t>(std::floor(z * inverse_resolution)));
+}
+
+template <class PointSource, class PointTarget>
+int NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::findVoxel(
+  const int64_t key) const
+{
+  size_t slot = ndt_voxel_hash::hashKey(key) & table_mask_;
+  while (true) {
+    const int64_t table_key = table_keys_[slot];
+    if (table_key == key) {
+      return table_voxel_indices_[slot];
+    }
+    if (table_key == ndt_voxel_hash::empty_key) {
+      return -1;
+    }
+    slot = (slot + 1) & table_mask_;
+  }
+}
+
+template <class PointSource, class PointTarget>
+int NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::findNeighborVoxels(
+  const float x, const float y, const float z, int * voxel_indices) const
+{
+  if (voxel_num_ == 0 || !std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z)) {
+    return 0;
+  }
+  const float inverse_resolution = 1.0f / resolution_;
+  const auto ix = static_cast<int64_t>(std::floor(x * inverse_resolution));
+  const auto iy = static_cast<int64_t>(std::floor(y * inverse_resolution));
+  const auto iz = static_cast<int64_t>(std::floor(z * inverse_resolution));
+  const int64_t keys[7] = {
+    ndt_voxel_hash::packKey(ix, iy, iz),     ndt_voxel_hash::packKey(ix + 1, iy, iz),
+    ndt_voxel_hash::packKey(ix - 1, iy, iz), ndt_voxel_hash::packKey(ix, iy + 1, iz),
+    ndt_voxel_hash::packKey(ix, iy - 1, iz), ndt_voxel_hash::packKey(ix, iy, iz + 1),
+    ndt_voxel_hash::packKey(ix, iy, iz - 1)};
+  int neighbor_num = 0;
+  for (const int64_t key : keys) {
+    const int voxel_index = findVoxel(key);
+    if (voxel_index >= 0) {
+      voxel_indices[neighbor_num++] = voxel_index;
+    }
+  }
+  return neighbor_num;
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::computeDerivatives(
+  const Vector6d & p, const pcl::PointCloud<PointSource> & trans_cloud, Vector6d & score_gradient,
+  Matrix6d & hessian, const bool compute_hessian) const
+{
+  size_t neighbor_num = 0;
+  double score = computePointDerivatives(
+    p, trans_cloud, score_gradient, hessian, compute_hessian, neighbor_num);
+
+  // longitudinal distance to the regularization pose, as in ndt_omp
+  if (regularization_enabled_) {
+    const double dx = regularization_position_(0) - p(0);
+    const double dy = regularization_position_(1) - p(1);
+    const double sin_yaw = std::sin(p(5));
+    const double cos_yaw = std::cos(p(5));
+    const double longitudinal_distance = dy * sin_yaw + dx * cos_yaw;
+    const double weight = regularization_scale_factor_ * static_cast<double>(neighbor_num);
+
+    score += -weight * longitudinal_distance * longitudinal_distance;
+    score_gradient(0) += weight * 2.0 * cos_yaw * longitudinal_distance;
+    score_gradient(1) += weight * 2.0 * sin_yaw * longitudinal_distance;
+    hessian(0, 0) += -weight * 2.0 * cos_yaw * cos_yaw;
+    hessian(0, 1) += -weight * 2.0 * cos_yaw * sin_yaw;
+    hessian(1, 1) += -weight * 2.0 * sin_yaw * sin_yaw;
+    hessian(1, 0) = hessian(0, 1);
+  }
+  return score;
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::computePointDerivatives(
+  const Vector6d & p, const pcl::PointCloud<PointSource> & trans_cloud, Vector6d & score_gradient,
+  Matrix6d & hessian, const bool compute_hessian, size_t & neighbor_num) const
+{
+  const AngleDerivatives angle_derivatives = computeAngleDerivatives(p, compute_hessian);
+
+  // one accumulator per thread, summed afterwards
+  const int num_threads = num_threads_;
+  std::vector<double> scores(num_threads, 0.0);
+  std::vector<Vector6d, Eigen::aligned_allocator<Vector6d>> score_gradients(
+    num_threads, Vector6d::Zero());
+  std::vector<Matrix6d, Eigen::aligned_allocator<Matrix6d>> hessians(
+    num_threads, Matrix6d::Zero());
+  std::vector<size_t> neighbor_nums(num_threads, 0);
+
+  const auto point_num = static_cast<int>(input_->points.size());
+#pragma omp parallel for num_threads(num_threads) schedule(guided, 8)
+  for (int i = 0; i < point_num; ++i) {
+#ifdef _OPENMP
+    const int thread_id = omp_get_thread_num();
+#else
+    const int thread_id = 0;
+#endif
+    const auto & trans_point = trans_cloud.points[i];
+    int voxel_indices[7];
+    const int point_neighbor_num =
+      findNeighborVoxels(trans_point.x, trans_point.y, trans_point.z, voxel_indices);
+    if (point_neighbor_num == 0) {
+      continue;
+    }
+    neighbor_nums[thread_id] += point_neighbor_num;
+
+    // point jacobian and hessian, eq. 6.18 and 6.20 [Magnusson 2009], only the rotation part of
+    // the jacobian is not the identity
+    const auto & point = input_->points[i];
+    const Eigen::Vector3d x(point.x, point.y, point.z);
+    const Eigen::Matrix<double, 8, 1> jx = angle_derivatives.jacobian * x;
+    Eigen::Matrix3d jacobian_rotation;
+    jacobian_rotation << 0.0, jx(2), jx(5), jx(0), jx(3), jx(6), jx(1), jx(4), jx(7);
+    Eigen::Matrix<double, 15, 1> hx = Eigen::Matrix<double, 15, 1>::Zero();
+    if (compute_hessian) {
+      hx = angle_derivatives.hessian * x;
+    }
+
+    double & score = scores[thread_id];
+    Vector6d & point_score_gradient = score_gradients[thread_id];
+    Matrix6d & point_hessian = hessians[thread_id];
+    for (int k = 0; k < point_neighbor_num; ++k) {
+      const float * mean = &voxel_means_[3 * voxel_indices[k]];
+      const float * c = &voxel_inverse_covariances_[6 * voxel_indices[k]];
+      const Eigen::Vector3d d(
+        trans_point.x - mean[0], trans_point.y - mean[1], trans_point.z - mean[2]);
+      Eigen::Matrix3d inverse_covariance;
+      inverse_covariance << c[0], c[1], c[2], c[1], c[3], c[4], c[2], c[4], c[5];
+      const Eigen::Vector3d cd = inverse_covariance * d;
+
+      // score and derivatives of the point, eq. 6.9, 6.12 and 6.13 [Magnusson 2009]
+      const double e_x_cov_x = std::exp(-gauss_d2_ * d.dot(cd) / 2.0);
+      score += -gauss_d1_ * e_x_cov_x;
+      const double e_d2 = gauss_d2_ * e_x_cov_x;
+      if (e_d2 > 1 || e_d2 < 0 || e_d2 != e_d2) {
+        continue;
+      }
+      const double factor = gauss_d1_ * e_d2;
+
+      Vector6d g;
+      g.head<3>() = cd;
+      g.tail<3>() = jacobian_rotation.transpose() * cd;
+      point_score_gradient += factor * g;
+
+      if (compute_hessian) {
+        Eigen::Matrix<double, 3, 6> jacobian;
+        jacobian << Eigen::Matrix3d::Identity(), jacobian_rotation;
+        Matrix6d h = -gauss_d2_ * g * g.transpose() +
+                     jacobian.transpose() * inverse_covariance * jacobian;
+        const double h33 = cd(1) * hx(0) + cd(2) * hx(1);
+        const double h34 = cd(1) * hx(2) + cd(2) * hx(3);
+        const double h35 = cd(1) * hx(4) + cd(2) * hx(5);
+        const double h44 = cd(0) * hx(6) + cd(1) * hx(7) + cd(2) * hx(8);
+        const double h45 = cd(0) * hx(9) + cd(1) * hx(10) + cd(2) * hx(11);
+        const double h55 = cd(0) * hx(12) + cd(1) * hx(13) + cd(2) * hx(14);
+        h(3, 3) += h33;
+        h(3, 4) += h34;
+        h(4, 3) += h34;
+        h(3, 5) += h35;
+        h(5, 3) += h35;
+        h(4, 4) += h44;
+        h(4, 5) += h45;
+        h(5, 4) += h45;
+        h(5, 5) += h55;
+        point_hessian += factor * h;
+      }
+    }
+  }
+
+  double score = 0.0;
+  score_gradient.setZero();
+  hessian.setZero();
+  neighbor_num = 0;
+  for (int thread_id = 0; thread_id < num_threads; ++thread_id) {
+    score += scores[thread_id];
+    score_gradient += score_gradients[thread_id];
+    hessian += hessians[thread_id];
+    neighbor_num += neighbor_nums[thread_id];
+  }
+  return score;
+}
+
+template <class PointSource, class PointTarget>
+double NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::computeStepLengthMT(
+  const Vector6d & x, Vector6d & step_dir, double step_init, double step_max, double step_min,
+  double & score, Vector6d & score_gradient, Matrix6d & hessian,
+  pcl::PointCloud<PointSource> & trans_cloud)
+{
+  using ndt_voxel_hash::auxiliaryFunctionDPsiMT;
+  using ndt_voxel_hash::auxiliaryFunctionPsiMT;
+
+  // phi(0) and phi'(0), eq. 1.3 [More, Thuente 1994]
+  const double phi_0 = -score;
+  double d_phi_0 = -(score_gradient.dot(step_dir));
+
+  if (d_phi_0 >= 0) {
+    // not a decent direction
+    if (d_phi_0 == 0) {
+      return 0;
+    }
+    // reverse step direction and calculate optimal step
+    d_phi_0 *= -1;
+    step_dir *= -1;
+  }
+
+  const int max_step_iterations = 10;
+  int step_iterations = 0;
+
+  // sufficient decrease and curvature condition constants, eq. 1.1 and 1.2 [More, Thuente 1994]
+  const double mu = 1.e-4;
+  const double nu = 0.9;
+
+  // initial endpoints of the interval I, with the auxiliary function psi until I is determined to
+  // be a closed interval, eq. 2.1 [More, Thuente 1994]
+  double a_l = 0, a_u = 0;
+  double f_l = auxiliaryFunctionPsiMT(a_l, phi_0, phi_0, d_phi_0, mu);
+  double g_l = auxiliaryFunctionDPsiMT(d_phi_0, d_phi_0, mu);
+  double f_u = auxiliaryFunctionPsiMT(a_u, phi_0, phi_0, d_phi_0, mu);
+  double g_u = auxiliaryFunctionDPsiMT(d_phi_0, d_phi_0, mu);
+
+  // the step length calculation is skipped when step_min == step_max
+  bool interval_converged = (step_max - step_min) > 0, open_interval = true;
+
+  double a_t = std::max(std::min(step_init, step_max), step_min);
+  Vector6d x_t = x + step_dir * a_t;
+  updateTransformation(x_t, trans_cloud);
+
+  // the hessian is computed with the first trial, which most step calculations end with
+  score = computeDerivatives(x_t, trans_cloud, score_gradient, hessian, true);
+
+  double phi_t = -score;
+  double d_phi_t = -(score_gradient.dot(step_dir));
+  double psi_t = auxiliaryFunctionPsiMT(a_t, phi_t, phi_0, d_phi_0, mu);
+  double d_psi_t = auxiliaryFunctionDPsiMT(d_phi_t, d_phi_0, mu);
+
+  // iterate until the interval converges or a value satisfies the sufficient decrease and the
+  // curvature condition, eq. 1.1 and 1.2 [More, Thuente 1994]
+  while (!interval_converged && step_iterations < max_step_iterations &&
+         !(psi_t <= 0 && d_phi_t <= -nu * d_phi_0)) {
+    if (open_interval) {
+      a_t =
+        ndt_voxel_hash::trialValueSelectionMT(a_l, f_l, g_l, a_u, f_u, g_u, a_t, psi_t, d_psi_t);
+    } else {
+      a_t =
+        ndt_voxel_hash::trialValueSelectionMT(a_l, f_l, g_l, a_u, f_u, g_u, a_t, phi_t, d_phi_t);
+    }
+    a_t = std::max(std::min(a_t, step_max), step_min);
+
+    x_t = x + step_dir * a_t;
+    updateTransformation(x_t, trans_cloud);
+    score = computeDerivatives(x_t, trans_cloud, score_gradient, hessian, false);
+
+    phi_t = -score;
+    d_phi_t = -(score_gradient.dot(step_dir));
+    psi_t = auxiliaryFunctionPsiMT(a_t, phi_t, phi_0, d_phi_0, mu);
+    d_psi_t = auxiliaryFunctionDPsiMT(d_phi_t, d_phi_0, mu);
+
+    // check if I is now a closed interval
+    if (open_interval && (psi_t <= 0 && d_psi_t >= 0)) {
+      open_interval = false;
+
+      // converts f and g from psi to phi
+      f_l = f_l + phi_0 - mu * d_phi_0 * a_l;
+      g_l = g_l + mu * d_phi_0;
+      f_u = f_u + phi_0 - mu * d_phi_0 * a_u;
+      g_u = g_u + mu * d_phi_0;
+    }
+
+    if (open_interval) {
+      interval_converged =
+        ndt_voxel_hash::updateIntervalMT(a_l, f_l, g_l, a_u, f_u, g_u, a_t, psi_t, d_psi_t);
+    } else {
+      interval_converged =
+        ndt_voxel_hash::updateIntervalMT(a_l, f_l, g_l, a_u, f_u, g_u, a_t, phi_t, d_phi_t);
+    }
+
+    step_iterations++;
+  }
+
+  // the hessian of the trial that was kept is needed for the next newton step
+  if (step_iterations) {
+    Vector6d unused_score_gradient;
+    computeDerivatives(x_t, trans_cloud, unused_score_gradient, hessian, true);
+  }
+
+  return a_t;
+}
+
+template <class PointSource, class PointTarget>
+void NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::updateTransformation(
+  const Vector6d & p, pcl::PointCloud<PointSource> & trans_cloud)
+{
+  final_transformation_ = ndt_voxel_hash::toMatrix(p);
+  pcl::transformPointCloud(*input_, trans_cloud, final_transformation_);
+}
+
+template <class PointSource, class PointTarget>
+typename NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::AngleDerivatives
+NormalDistributionsTransformVoxelHash<PointSource, PointTarget>::computeAngleDerivatives(
+  const Vector6d & p, const bool compute_hessian)
+{
+  // simplified math for near 0 angles
+  const auto cos_sin = [](const double angle, double & c, double & s) {
+    if (std::fabs(angle) < 10e-5) {
+      c = 1.0;
+      s = 0.0;
+    } else {
+      c = std::cos(angle);
+      s = std::sin(angle);
+    }
+  };
+  double cx, sx, cy, sy, cz, sz;
+  cos_sin(p(3), cx, sx);
+  cos_sin(p(4), cy, sy);
+  cos_sin(p(5), cz, sz);
+
+  // eq. 6.19 [Magnusson 2009]
+  AngleDerivatives derivatives;
+  derivatives.jacobian << (-sx * sz + cx * sy * cz), (-sx * cz - cx * sy * sz), (-cx * cy),
+    (cx * sz + sx * sy * cz), (cx * cz - sx * sy * sz), (-sx * cy), (-sy * cz), sy * sz, cy,
+    sx * cy * cz, (-sx * cy * sz), sx * sy, (-cx * cy * cz), cx * cy * sz, (-cx * sy),
+    (-cy * sz), (-cy * cz), 0, (cx * cz - sx * sy * sz), (-cx * sz - sx * sy * cz), 0,
+    (sx * cz + cx * sy * sz), (cx * sy * cz - sx * sz), 0;
+
+  if (compute_hessian) {
+    // eq. 6.21 [Magnusson 2009]
+    derivatives.hessian << (-cx * sz - sx * sy * cz), (-cx * cz + sx * sy * sz), sx * cy,
+      (-sx * sz + cx * sy * cz), (-cx * sy * sz - sx * cz), (-cx * cy), (cx * cy * cz),
+      (-cx * cy * sz), (cx * sy), (sx * cy * cz), (-sx * cy * sz), (sx * sy),
+      (-sx * cz - cx * sy * sz), (sx * sz - cx * sy * cz), 0, (cx * cz - sx * sy * sz),
+      (-sx * sy * cz - cx * sz), 0, (-cy * cz), (cy * sz), (sy), (-sx * sy * cz), (sx * sy * sz),
+      (sx * cy), (cx * sy * cz), (-cx * sy * sz), (-cx * cy), (sy * sz), (sy * cz), 0,
+      (-sx * cy * sz), (-sx * cy * cz), 0, (cx * cy * sz), (cx * cy * cz), 0, (-cy * cz),
+      (cy * sz), 0, (-cx * sz - sx * sy * cz), (-cx * cz + sx * sy * sz), 0,
+      (-sx * sz + cx * sy * cz), (-cx * sy * sz - sx * cz), 0;
+  } else {
+    derivatives.hessian.setZero();
+  }
+  return derivatives;
+}
+
+#endif  // NDT__IMPL__VOXEL_HASH_HPP_
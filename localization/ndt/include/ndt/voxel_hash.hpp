@@ -0,0 +1,172 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef NDT__VOXEL_HASH_HPP_
+#define NDT__VOXEL_HASH_HPP_
+
+#include "ndt/base.hpp"
+
+#include <pcl/common/io.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl/point_types.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief NDT of [Magnusson 2009] on its own voxel grid. The target voxels only keep their mean and
+ * inverse covariance, stored as contiguous arrays indexed through an open addressing hash table of
+ * the voxel coordinates. A point is scored against the voxel it falls in and its 6 face neighbors,
+ * as the DIRECT7 search of ndt_omp, and the derivatives are accumulated with fixed size Eigen
+ * kernels over the points, in parallel when built with OpenMP.
+ */
+template <class PointSource, class PointTarget>
+class NormalDistributionsTransformVoxelHash
+: public NormalDistributionsTransformBase<PointSource, PointTarget>
+{
+public:
+  NormalDistributionsTransformVoxelHash();
+  virtual ~NormalDistributionsTransformVoxelHash() = default;
+
+  void align(pcl::PointCloud<PointSource> & output, const Eigen::Matrix4f & guess) override;
+  void setInputTarget(const pcl::shared_ptr<pcl::PointCloud<PointTarget>> & map_ptr) override;
+  void setInputSource(const pcl::shared_ptr<pcl::PointCloud<PointSource>> & scan_ptr) override;
+
+  void setMaximumIterations(int max_iter) override;
+  void setResolution(float res) override;
+  void setStepSize(double step_size) override;
+  void setTransformationEpsilon(double trans_eps) override;
+
+  int getMaximumIterations() override;
+  int getFinalNumIteration() const override;
+  float getResolution() const override;
+  double getStepSize() const override;
+  double getTransformationEpsilon() override;
+  double getTransformationProbability() const override;
+  double getNearestVoxelTransformationLikelihood() const override;
+  double getFitnessScore() override;
+  pcl::shared_ptr<const pcl::PointCloud<PointTarget>> getInputTarget() const override;
+  pcl::shared_ptr<const pcl::PointCloud<PointSource>> getInputSource() const override;
+  Eigen::Matrix4f getFinalTransformation() const override;
+  std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>>
+  getFinalTransformationArray() const override;
+
+  Eigen::Matrix<double, 6, 6> getHessian() const override;
+  void setRegularizationScaleFactor(const float regularization_scale_factor) override;
+  void setRegularizationPose(const Eigen::Matrix4f & regularization_pose) override;
+  void unsetRegularizationPose() override;
+
+  // there is no KdTree on the target, returns nullptr
+  pcl::shared_ptr<pcl::search::KdTree<PointTarget>> getSearchMethodTarget() const override;
+
+  double calculateTransformationProbability(
+    const pcl::PointCloud<PointSource> & trans_cloud) const override;
+  double calculateNearestVoxelTransformationLikelihood(
+    const pcl::PointCloud<PointSource> & trans_cloud) const override;
+  // both metrics in one pass, the points being transformed on the fly
+  std::vector<NDTScores> evaluatePoses(
+    const std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>> & poses)
+    const override;
+
+  void setNumThreads(int n);
+  int getNumThreads() const;
+
+  size_t getVoxelNum() const { return voxel_num_; }
+
+protected:
+  using Vector6d = Eigen::Matrix<double, 6, 1>;
+  using Matrix6d = Eigen::Matrix<double, 6, 6>;
+
+  // partial derivatives of the rotation of a point by the euler angles, eq. 6.19 and 6.21
+  struct AngleDerivatives
+  {
+    Eigen::Matrix<double, 8, 3> jacobian;
+    Eigen::Matrix<double, 15, 3> hessian;
+  };
+
+  static AngleDerivatives computeAngleDerivatives(const Vector6d & p, const bool compute_hessian);
+
+  // sum of the score and derivatives of the points of trans_cloud, input_ transformed by p, over
+  // their neighbor voxels, neighbor_num being the number of point and voxel pairs
+  virtual double computePointDerivatives(
+    const Vector6d & p, const pcl::PointCloud<PointSource> & trans_cloud, Vector6d & score_gradient,
+    Matrix6d & hessian, const bool compute_hessian, size_t & neighbor_num) const;
+
+  pcl::shared_ptr<pcl::PointCloud<PointTarget>> target_;
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> input_;
+
+  float resolution_;
+
+  double gauss_d1_;
+  double gauss_d2_;
+
+  // voxels: means are x, y, z and inverse covariances xx, xy, xz, yy, yz, zz, per voxel
+  size_t voxel_num_;
+  std::vector<float> voxel_means_;
+  std::vector<float> voxel_inverse_covariances_;
+  // open addressing table of the voxel keys, with a power of two capacity
+  std::vector<int64_t> table_keys_;
+  std::vector<int> table_voxel_indices_;
+  size_t table_mask_;
+
+private:
+  void buildVoxels();
+  int64_t getVoxelKey(const float x, const float y, const float z) const;
+  int findVoxel(const int64_t key) const;
+
+  // the voxels that a point in the map frame is scored against, returns their number
+  int findNeighborVoxels(const float x, const float y, const float z, int * voxel_indices) const;
+
+  // transformation probability and nearest voxel likelihood of the points get_point(i) in the map
+  // frame, for i in [0, point_num)
+  template <class GetPoint>
+  NDTScores computeScores(const size_t point_num, const GetPoint & get_point) const;
+
+  double computeDerivatives(
+    const Vector6d & p, const pcl::PointCloud<PointSource> & trans_cloud, Vector6d & score_gradient,
+    Matrix6d & hessian, const bool compute_hessian) const;
+  double computeStepLengthMT(
+    const Vector6d & x, Vector6d & step_dir, double step_init, double step_max, double step_min,
+    double & score, Vector6d & score_gradient, Matrix6d & hessian,
+    pcl::PointCloud<PointSource> & trans_cloud);
+  void updateTransformation(const Vector6d & p, pcl::PointCloud<PointSource> & trans_cloud);
+
+  double step_size_;
+  double transformation_epsilon_;
+  int max_iterations_;
+  double outlier_ratio_;
+  int min_points_per_voxel_;
+  int num_threads_;
+
+  int nr_iterations_;
+  bool converged_;
+  Eigen::Matrix4f final_transformation_;
+  std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>> transformation_array_;
+  Matrix6d hessian_;
+  double trans_probability_;
+  double nearest_voxel_transformation_likelihood_;
+
+  bool regularization_enabled_;
+  float regularization_scale_factor_;
+  Eigen::Vector2d regularization_position_;
+
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+// the implementation is only compiled in the library, where it gets the OpenMP flags
+extern template class NormalDistributionsTransformVoxelHash<pcl::PointXYZ, pcl::PointXYZ>;
+extern template class NormalDistributionsTransformVoxelHash<pcl::PointXYZI, pcl::PointXYZI>;
+
+#endif  // NDT__VOXEL_HASH_HPP_
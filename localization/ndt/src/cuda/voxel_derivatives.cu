@@ -0,0 +1,355 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ndt/cuda/voxel_derivatives.hpp"
+
+#include <cuda_runtime_api.h>
+#include <thrust/device_vector.h>
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#define CHECK_CUDA_ERROR(e) (ndt_cuda::checkError(e, __FILE__, __LINE__))
+
+namespace ndt_cuda
+{
+namespace
+{
+inline void checkError(const ::cudaError_t e, const char * f, int n)
+{
+  if (e != ::cudaSuccess) {
+    std::stringstream s;
+    s << ::cudaGetErrorName(e) << " (" << e << ")@" << f << "#L" << n << ": "
+      << ::cudaGetErrorString(e);
+    throw std::runtime_error{s.str()};
+  }
+}
+
+constexpr unsigned int threads_per_block = 256U;
+constexpr unsigned int warp_size = 32U;
+
+inline unsigned int numBlocks(const std::size_t n)
+{
+  return static_cast<unsigned int>((n + threads_per_block - 1U) / threads_per_block);
+}
+
+// grow-only device buffer, contents are not preserved
+template <typename T>
+T * reserve(thrust::device_vector<T> & buffer, const std::size_t size)
+{
+  if (buffer.size() < size) {
+    buffer.clear();
+    buffer.resize(size);
+  }
+  return thrust::raw_pointer_cast(buffer.data());
+}
+
+// score, gradient, upper triangle of the hessian and number of point and voxel pairs
+constexpr int sum_size = 1 + 6 + 21 + 1;
+
+// same packing and hashing as ndt_voxel_hash
+constexpr int64_t key_offset = int64_t{1} << 20;
+constexpr int64_t key_mask = (int64_t{1} << 21) - 1;
+constexpr int64_t empty_key = -1;
+
+struct Affine
+{
+  float m[12];  // row major 3x4
+};
+
+struct AngleDerivatives
+{
+  double jacobian[24];  // column major 8x3
+  double hessian[45];   // column major 15x3
+};
+
+struct VoxelGrid
+{
+  const float * means;
+  const float * inverse_covariances;
+  const int64_t * table_keys;
+  const int * table_voxel_indices;
+  uint64_t table_mask;
+  float inverse_resolution;
+};
+
+__device__ inline int64_t packKey(const int64_t ix, const int64_t iy, const int64_t iz)
+{
+  return (((ix + key_offset) & key_mask) << 42) | (((iy + key_offset) & key_mask) << 21) |
+         ((iz + key_offset) & key_mask);
+}
+
+__device__ inline int findVoxel(const VoxelGrid & grid, const int64_t key)
+{
+  uint64_t slot = ((static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ULL) >> 32) & grid.table_mask;
+  while (true) {
+    const int64_t table_key = grid.table_keys[slot];
+    if (table_key == key) {
+      return grid.table_voxel_indices[slot];
+    }
+    if (table_key == empty_key) {
+      return -1;
+    }
+    slot = (slot + 1) & grid.table_mask;
+  }
+}
+
+// sums of the block in block_sum, every thread of the block has to call it
+__device__ inline void reduceBlock(const double (&sums)[sum_size], double * block_sum)
+{
+  __shared__ double warp_sums[threads_per_block / warp_size][sum_size];
+  const unsigned int lane = threadIdx.x % warp_size;
+  const unsigned int warp = threadIdx.x / warp_size;
+  for (int k = 0; k < sum_size; ++k) {
+    double value = sums[k];
+    for (unsigned int offset = warp_size / 2; offset > 0; offset /= 2) {
+      value += __shfl_down_sync(0xffffffff, value, offset);
+    }
+    if (lane == 0) {
+      warp_sums[warp][k] = value;
+    }
+  }
+  __syncthreads();
+  if (threadIdx.x < sum_size) {
+    double value = 0.0;
+    for (unsigned int w = 0; w < threads_per_block / warp_size; ++w) {
+      value += warp_sums[w][threadIdx.x];
+    }
+    block_sum[threadIdx.x] = value;
+  }
+}
+
+// same terms as NormalDistributionsTransformVoxelHash::computePointDerivatives, eq. 6.12 and 6.13
+// [Magnusson 2009], one point per thread
+__global__ void derivativesKernel(
+  const float * source, const std::size_t point_num, const Affine transformation,
+  const AngleDerivatives angle, const VoxelGrid grid, const double gauss_d1,
+  const double gauss_d2, const bool compute_hessian, double * block_sums)
+{
+  double sums[sum_size];
+  for (int k = 0; k < sum_size; ++k) {
+    sums[k] = 0.0;
+  }
+
+  const std::size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < point_num) {
+    const double x[3] = {source[3 * i], source[3 * i + 1], source[3 * i + 2]};
+    const float * m = transformation.m;
+    float trans_point[3];
+    for (int r = 0; r < 3; ++r) {
+      trans_point[r] = m[4 * r] * source[3 * i] + m[4 * r + 1] * source[3 * i + 1] +
+                       m[4 * r + 2] * source[3 * i + 2] + m[4 * r + 3];
+    }
+    const bool is_finite =
+      isfinite(trans_point[0]) && isfinite(trans_point[1]) && isfinite(trans_point[2]);
+
+    // rotation part of the point jacobian and the point hessian, eq. 6.18 and 6.20
+    double jx[8];
+    for (int r = 0; r < 8; ++r) {
+      jx[r] =
+        angle.jacobian[r] * x[0] + angle.jacobian[8 + r] * x[1] + angle.jacobian[16 + r] * x[2];
+    }
+    const double jacobian_rotation[3][3] = {
+      {0.0, jx[2], jx[5]}, {jx[0], jx[3], jx[6]}, {jx[1], jx[4], jx[7]}};
+    double hx[15];
+    for (int r = 0; r < 15; ++r) {
+      hx[r] = compute_hessian ? angle.hessian[r] * x[0] + angle.hessian[15 + r] * x[1] +
+                                  angle.hessian[30 + r] * x[2]
+                              : 0.0;
+    }
+
+    const int64_t ix = static_cast<int64_t>(floorf(trans_point[0] * grid.inverse_resolution));
+    const int64_t iy = static_cast<int64_t>(floorf(trans_point[1] * grid.inverse_resolution));
+    const int64_t iz = static_cast<int64_t>(floorf(trans_point[2] * grid.inverse_resolution));
+    const int64_t keys[7] = {packKey(ix, iy, iz),     packKey(ix + 1, iy, iz),
+                             packKey(ix - 1, iy, iz), packKey(ix, iy + 1, iz),
+                             packKey(ix, iy - 1, iz), packKey(ix, iy, iz + 1),
+                             packKey(ix, iy, iz - 1)};
+    for (int n = 0; n < 7 && is_finite; ++n) {
+      const int v = findVoxel(grid, keys[n]);
+      if (v < 0) {
+        continue;
+      }
+      sums[sum_size - 1] += 1.0;
+
+      const float * mean = grid.means + 3 * v;
+      const float * ic = grid.inverse_covariances + 6 * v;
+      const double c[3][3] = {{ic[0], ic[1], ic[2]}, {ic[1], ic[3], ic[4]}, {ic[2], ic[4], ic[5]}};
+      const double d[3] = {
+        trans_point[0] - mean[0], trans_point[1] - mean[1], trans_point[2] - mean[2]};
+      double cd[3];
+      for (int r = 0; r < 3; ++r) {
+        cd[r] = c[r][0] * d[0] + c[r][1] * d[1] + c[r][2] * d[2];
+      }
+
+      const double e_x_cov_x = exp(-gauss_d2 * (d[0] * cd[0] + d[1] * cd[1] + d[2] * cd[2]) / 2.0);
+      sums[0] += -gauss_d1 * e_x_cov_x;
+      const double e_d2 = gauss_d2 * e_x_cov_x;
+      if (e_d2 > 1 || e_d2 < 0 || e_d2 != e_d2) {
+        continue;
+      }
+      const double factor = gauss_d1 * e_d2;
+
+      double g[6] = {cd[0], cd[1], cd[2], 0.0, 0.0, 0.0};
+      for (int k = 0; k < 3; ++k) {
+        g[3 + k] = jacobian_rotation[0][k] * cd[0] + jacobian_rotation[1][k] * cd[1] +
+                   jacobian_rotation[2][k] * cd[2];
+      }
+      for (int k = 0; k < 6; ++k) {
+        sums[1 + k] += factor * g[k];
+      }
+
+      if (!compute_hessian) {
+        continue;
+      }
+      // point jacobian column k, the identity for the translation
+      const auto jacobian = [&jacobian_rotation](const int r, const int k) {
+        return k < 3 ? (r == k ? 1.0 : 0.0) : jacobian_rotation[r][k - 3];
+      };
+      const double h33 = cd[1] * hx[0] + cd[2] * hx[1];
+      const double h34 = cd[1] * hx[2] + cd[2] * hx[3];
+      const double h35 = cd[1] * hx[4] + cd[2] * hx[5];
+      const double h44 = cd[0] * hx[6] + cd[1] * hx[7] + cd[2] * hx[8];
+      const double h45 = cd[0] * hx[9] + cd[1] * hx[10] + cd[2] * hx[11];
+      const double h55 = cd[0] * hx[12] + cd[1] * hx[13] + cd[2] * hx[14];
+      const double second_order[3][3] = {{h33, h34, h35}, {h34, h44, h45}, {h35, h45, h55}};
+      int h = 0;
+      for (int a = 0; a < 6; ++a) {
+        double cj[3];
+        for (int r = 0; r < 3; ++r) {
+          cj[r] = c[r][0] * jacobian(0, a) + c[r][1] * jacobian(1, a) + c[r][2] * jacobian(2, a);
+        }
+        for (int b = a; b < 6; ++b, ++h) {
+          double value = -gauss_d2 * g[a] * g[b] + jacobian(0, b) * cj[0] +
+                         jacobian(1, b) * cj[1] + jacobian(2, b) * cj[2];
+          if (a >= 3) {
+            value += second_order[a - 3][b - 3];
+          }
+          sums[7 + h] += factor * value;
+        }
+      }
+    }
+  }
+
+  reduceBlock(sums, block_sums + blockIdx.x * sum_size);
+}
+}  // namespace
+
+struct VoxelDerivatives::Impl
+{
+  thrust::device_vector<float> means;
+  thrust::device_vector<float> inverse_covariances;
+  thrust::device_vector<int64_t> table_keys;
+  thrust::device_vector<int> table_voxel_indices;
+  uint64_t table_mask{0U};
+  float resolution{1.0f};
+
+  thrust::device_vector<float> source;
+  std::size_t point_num{0U};
+
+  thrust::device_vector<double> block_sums;
+  std::vector<double> host_block_sums;
+};
+
+VoxelDerivatives::VoxelDerivatives() : impl_(std::make_unique<Impl>()) {}
+
+VoxelDerivatives::~VoxelDerivatives() = default;
+
+void VoxelDerivatives::setVoxels(
+  const std::vector<float> & means, const std::vector<float> & inverse_covariances,
+  const std::vector<int64_t> & table_keys, const std::vector<int> & table_voxel_indices,
+  const float resolution)
+{
+  CHECK_CUDA_ERROR(::cudaMemcpy(
+    reserve(impl_->means, means.size()), means.data(), means.size() * sizeof(float),
+    ::cudaMemcpyHostToDevice));
+  CHECK_CUDA_ERROR(::cudaMemcpy(
+    reserve(impl_->inverse_covariances, inverse_covariances.size()), inverse_covariances.data(),
+    inverse_covariances.size() * sizeof(float), ::cudaMemcpyHostToDevice));
+  CHECK_CUDA_ERROR(::cudaMemcpy(
+    reserve(impl_->table_keys, table_keys.size()), table_keys.data(),
+    table_keys.size() * sizeof(int64_t), ::cudaMemcpyHostToDevice));
+  CHECK_CUDA_ERROR(::cudaMemcpy(
+    reserve(impl_->table_voxel_indices, table_voxel_indices.size()), table_voxel_indices.data(),
+    table_voxel_indices.size() * sizeof(int), ::cudaMemcpyHostToDevice));
+  impl_->table_mask = table_keys.empty() ? 0U : table_keys.size() - 1U;
+  impl_->resolution = resolution;
+}
+
+void VoxelDerivatives::setSource(const float * xyz, const std::size_t point_num)
+{
+  impl_->point_num = point_num;
+  CHECK_CUDA_ERROR(::cudaMemcpy(
+    reserve(impl_->source, 3 * point_num), xyz, 3 * point_num * sizeof(float),
+    ::cudaMemcpyHostToDevice));
+}
+
+void VoxelDerivatives::compute(
+  const float * transformation, const double * angle_jacobian, const double * angle_hessian,
+  const double gauss_d1, const double gauss_d2, const bool compute_hessian,
+  DerivativesResult & result) const
+{
+  result = DerivativesResult{};
+  if (impl_->point_num == 0U || impl_->table_keys.empty()) {
+    return;
+  }
+
+  Affine affine;
+  for (int r = 0; r < 3; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      affine.m[4 * r + c] = transformation[4 * c + r];
+    }
+  }
+  AngleDerivatives angle;
+  std::copy(angle_jacobian, angle_jacobian + 24, angle.jacobian);
+  std::copy(angle_hessian, angle_hessian + 45, angle.hessian);
+  const VoxelGrid grid{
+    thrust::raw_pointer_cast(impl_->means.data()),
+    thrust::raw_pointer_cast(impl_->inverse_covariances.data()),
+    thrust::raw_pointer_cast(impl_->table_keys.data()),
+    thrust::raw_pointer_cast(impl_->table_voxel_indices.data()), impl_->table_mask,
+    1.0f / impl_->resolution};
+
+  const unsigned int block_num = numBlocks(impl_->point_num);
+  double * block_sums = reserve(impl_->block_sums, block_num * sum_size);
+  derivativesKernel<<<block_num, threads_per_block>>>(
+    thrust::raw_pointer_cast(impl_->source.data()), impl_->point_num, affine, angle, grid,
+    gauss_d1, gauss_d2, compute_hessian, block_sums);
+  CHECK_CUDA_ERROR(::cudaGetLastError());
+
+  // the block sums are few, they are added on the host
+  impl_->host_block_sums.resize(block_num * sum_size);
+  CHECK_CUDA_ERROR(::cudaMemcpy(
+    impl_->host_block_sums.data(), block_sums, block_num * sum_size * sizeof(double),
+    ::cudaMemcpyDeviceToHost));
+  double sums[sum_size] = {};
+  for (unsigned int b = 0; b < block_num; ++b) {
+    for (int k = 0; k < sum_size; ++k) {
+      sums[k] += impl_->host_block_sums[b * sum_size + k];
+    }
+  }
+
+  result.score = sums[0];
+  std::copy(sums + 1, sums + 7, result.score_gradient);
+  int h = 0;
+  for (int a = 0; a < 6; ++a) {
+    for (int b = a; b < 6; ++b, ++h) {
+      result.hessian[6 * a + b] = sums[7 + h];
+      result.hessian[6 * b + a] = sums[7 + h];
+    }
+  }
+  result.neighbor_num = static_cast<std::size_t>(sums[sum_size - 1]);
+}
+}  // namespace ndt_cuda
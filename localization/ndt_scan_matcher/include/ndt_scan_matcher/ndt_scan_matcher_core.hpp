@@ -17,11 +17,16 @@
 
 #define FMT_HEADER_ONLY
 
+#include "ndt_scan_matcher/map_tile_loader.hpp"
 #include "ndt_scan_matcher/particle.hpp"
 
 #include <ndt/omp.hpp>
 #include <ndt/pcl_generic.hpp>
 #include <ndt/pcl_modified.hpp>
+#include <ndt/voxel_hash.hpp>
+#ifdef NDT_CUDA_AVAILABLE
+#include <ndt/cuda.hpp>
+#endif
 #include <rclcpp/rclcpp.hpp>
 
 #include <diagnostic_msgs/msg/diagnostic_array.hpp>
@@ -54,6 +59,7 @@
 #endif
 
 #include <array>
+#include <condition_variable>
 #include <deque>
 #include <map>
 #include <memory>
@@ -62,12 +68,24 @@
 #include <thread>
 #include <vector>
 
-enum class NDTImplementType { PCL_GENERIC = 0, PCL_MODIFIED = 1, OMP = 2 };
+enum class NDTImplementType {
+  PCL_GENERIC = 0,
+  PCL_MODIFIED = 1,
+  OMP = 2,
+  VOXEL_HASH = 3,
+  CUDA = 4
+};
 enum class ConvergedParamType {
   TRANSFORM_PROBABILITY = 0,
   NEAREST_VOXEL_TRANSFORMATION_LIKELIHOOD = 1
 };
 
+// the CUDA implementation derives from the voxel hash one and shares its parameters
+inline bool isVoxelHashType(const NDTImplementType & ndt_mode)
+{
+  return ndt_mode == NDTImplementType::VOXEL_HASH || ndt_mode == NDTImplementType::CUDA;
+}
+
 template <typename PointSource, typename PointTarget>
 std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> getNDT(
   const NDTImplementType & ndt_mode)
@@ -85,6 +103,18 @@ std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> getN
     ndt_ptr.reset(new NormalDistributionsTransformOMP<PointSource, PointTarget>);
     return ndt_ptr;
   }
+  if (ndt_mode == NDTImplementType::VOXEL_HASH) {
+    ndt_ptr.reset(new NormalDistributionsTransformVoxelHash<PointSource, PointTarget>);
+    return ndt_ptr;
+  }
+  if (ndt_mode == NDTImplementType::CUDA) {
+#ifdef NDT_CUDA_AVAILABLE
+    ndt_ptr.reset(new NormalDistributionsTransformCUDA<PointSource, PointTarget>);
+    return ndt_ptr;
+#else
+    throw std::runtime_error("NDT type 4 (CUDA) needs the ndt package to be built with CUDA");
+#endif
+  }
 
   const std::string s = fmt::format("Unknown NDT type {}", static_cast<int>(ndt_mode));
   throw std::runtime_error(s);
@@ -105,6 +135,7 @@ class NDTScanMatcher : public rclcpp::Node
 
 public:
   NDTScanMatcher();
+  ~NDTScanMatcher();
 
 private:
   void serviceNDTAlign(
@@ -113,6 +144,11 @@ private:
 
   void callbackMapPoints(sensor_msgs::msg::PointCloud2::ConstSharedPtr pointcloud2_msg_ptr);
   void callbackSensorPoints(sensor_msgs::msg::PointCloud2::ConstSharedPtr pointcloud2_msg_ptr);
+  void runMapUpdate();
+  void setPendingMap(
+    const sensor_msgs::msg::PointCloud2::ConstSharedPtr & map_points_msg_ptr,
+    const pcl::shared_ptr<pcl::PointCloud<PointTarget>> & map_points_ptr);
+  void updateMap(const pcl::shared_ptr<pcl::PointCloud<PointTarget>> & map_points_ptr);
   void callbackInitialPose(
     geometry_msgs::msg::PoseWithCovarianceStamped::ConstSharedPtr pose_conv_msg_ptr);
   void callbackRegularizationPose(
@@ -129,6 +165,8 @@ private:
   bool getTransform(
     const std::string & target_frame, const std::string & source_frame,
     const geometry_msgs::msg::TransformStamped::SharedPtr & transform_stamped_ptr);
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> getPointBuffer(
+    const pcl::shared_ptr<pcl::PointCloud<PointSource>> & buffer) const;
 
   bool validateTimeStampDifference(
     const rclcpp::Time & target_time, const rclcpp::Time & reference_time,
@@ -178,6 +216,9 @@ private:
 
   NDTImplementType ndt_implement_type_;
   std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>> ndt_ptr_;
+  // the other instances on the same map for the initial pose estimation threads
+  std::vector<std::shared_ptr<NormalDistributionsTransformBase<PointSource, PointTarget>>>
+    ndt_worker_ptrs_;
 
   Eigen::Matrix4f base_to_sensor_matrix_;
   std::string base_frame_;
@@ -189,17 +230,40 @@ private:
   double converged_param_nearest_voxel_transformation_likelihood_;
 
   int initial_estimate_particles_num_;
+  int initial_estimate_num_threads_;
+  double initial_estimate_score_threshold_;
   double initial_pose_timeout_sec_;
   double initial_pose_distance_tolerance_m_;
   float inversion_vector_threshold_;
   float oscillation_threshold_;
   std::array<double, 36> output_pose_covariance_;
 
+  // the sensor point buffers are kept from one scan to the next when reuse_point_buffers is set,
+  // so that their capacity is only allocated once. sensor_points_baselinkTF_ptr_ is always the
+  // input source of ndt_ptr_, to be carried over on a map update
+  bool reuse_point_buffers_;
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_sensorTF_ptr_;
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_baselinkTF_ptr_;
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> aligned_points_ptr_;
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_mapTF_ptr_;
+
   std::deque<geometry_msgs::msg::PoseWithCovarianceStamped::ConstSharedPtr>
     initial_pose_msg_ptr_array_;
   std::mutex ndt_map_mtx_;
   std::mutex initial_pose_array_mtx_;
 
+  // the map target of a new NDT instance is built on this thread, then swapped with ndt_ptr_. The
+  // pending map is either a pointcloud_map message or a window of the map tiles
+  std::thread map_update_thread_;
+  std::mutex map_update_mtx_;
+  std::condition_variable map_update_condition_;
+  sensor_msgs::msg::PointCloud2::ConstSharedPtr pending_map_points_msg_ptr_;
+  pcl::shared_ptr<pcl::PointCloud<PointTarget>> pending_map_points_ptr_;
+  bool stop_map_update_;
+
+  // replaces the pointcloud_map subscription when use_dynamic_map_loading is set
+  std::unique_ptr<MapTileLoader> map_tile_loader_;
+
   OMPParams omp_params_;
 
   std::thread diagnostic_thread_;
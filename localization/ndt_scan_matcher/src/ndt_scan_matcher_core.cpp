@@ -31,9 +31,11 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <functional>
 #include <iomanip>
+#include <numeric>
 #include <thread>
 
 tier4_debug_msgs::msg::Float32Stamped makeFloat32Stamped(
@@ -63,6 +65,13 @@ geometry_msgs::msg::TransformStamped identityTransformStamped(
   return transform;
 }
 
+template <class PublisherT>
+bool hasSubscriber(const PublisherT & publisher)
+{
+  return publisher->get_subscription_count() > 0 ||
+         publisher->get_intra_process_subscription_count() > 0;
+}
+
 double norm(const geometry_msgs::msg::Point & p1, const geometry_msgs::msg::Point & p2)
 {
   return std::sqrt(
@@ -109,10 +118,18 @@ NDTScanMatcher::NDTScanMatcher()
   converged_param_transform_probability_(4.5),
   converged_param_nearest_voxel_transformation_likelihood_(2.3),
   initial_estimate_particles_num_(100),
+  initial_estimate_num_threads_(1),
+  initial_estimate_score_threshold_(0.0),
   initial_pose_timeout_sec_(1.0),
   initial_pose_distance_tolerance_m_(10.0),
   inversion_vector_threshold_(-0.9),
   oscillation_threshold_(10),
+  reuse_point_buffers_(false),
+  sensor_points_sensorTF_ptr_(new pcl::PointCloud<PointSource>),
+  sensor_points_baselinkTF_ptr_(new pcl::PointCloud<PointSource>),
+  aligned_points_ptr_(new pcl::PointCloud<PointSource>),
+  sensor_points_mapTF_ptr_(new pcl::PointCloud<PointSource>),
+  stop_map_update_(false),
   regularization_enabled_(declare_parameter("regularization_enabled", false)),
   regularization_scale_factor_(declare_parameter("regularization_scale_factor", 0.01))
 {
@@ -146,7 +163,16 @@ NDTScanMatcher::NDTScanMatcher()
     ndt_ptr_ = ndt_omp_ptr;
   }
 
+  if (isVoxelHashType(ndt_implement_type_)) {
+    using T = NormalDistributionsTransformVoxelHash<PointSource, PointTarget>;
+
+    omp_params_.num_threads = this->declare_parameter("omp_num_threads", omp_params_.num_threads);
+    omp_params_.num_threads = std::max(omp_params_.num_threads, 1);
+    std::dynamic_pointer_cast<T>(ndt_ptr_)->setNumThreads(omp_params_.num_threads);
+  }
+
   int points_queue_size = this->declare_parameter("input_sensor_points_queue_size", 0);
+  reuse_point_buffers_ = this->declare_parameter("reuse_point_buffers", reuse_point_buffers_);
   points_queue_size = std::max(points_queue_size, 0);
   RCLCPP_INFO(get_logger(), "points_queue_size: %d", points_queue_size);
 
@@ -178,11 +204,12 @@ NDTScanMatcher::NDTScanMatcher()
   converged_param_type_ = static_cast<ConvergedParamType>(converged_param_type_tmp);
   if (
     ndt_implement_type_ != NDTImplementType::OMP &&
+    !isVoxelHashType(ndt_implement_type_) &&
     converged_param_type_ == ConvergedParamType::NEAREST_VOXEL_TRANSFORMATION_LIKELIHOOD) {
     RCLCPP_ERROR(
       get_logger(),
       "ConvergedParamType::NEAREST_VOXEL_TRANSFORMATION_LIKELIHOOD is only available when "
-      "NDTImplementType::OMP is selected.");
+      "NDTImplementType::OMP, NDTImplementType::VOXEL_HASH or NDTImplementType::CUDA is selected.");
     return;
   }
 
@@ -194,6 +221,10 @@ NDTScanMatcher::NDTScanMatcher()
 
   initial_estimate_particles_num_ =
     this->declare_parameter("initial_estimate_particles_num", initial_estimate_particles_num_);
+  initial_estimate_num_threads_ = std::max(
+    this->declare_parameter("initial_estimate_num_threads", initial_estimate_num_threads_), 1);
+  initial_estimate_score_threshold_ = this->declare_parameter(
+    "initial_estimate_score_threshold", initial_estimate_score_threshold_);
 
   initial_pose_timeout_sec_ =
     this->declare_parameter("initial_pose_timeout_sec", initial_pose_timeout_sec_);
@@ -224,9 +255,15 @@ NDTScanMatcher::NDTScanMatcher()
     "ekf_pose_with_covariance", 100,
     std::bind(&NDTScanMatcher::callbackInitialPose, this, std::placeholders::_1),
     initial_pose_sub_opt);
-  map_points_sub_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
-    "pointcloud_map", rclcpp::QoS{1}.transient_local(),
-    std::bind(&NDTScanMatcher::callbackMapPoints, this, std::placeholders::_1), main_sub_opt);
+  map_tile_loader_ =
+    MapTileLoader::create(this, [this](const MapTileLoader::PointCloudPtr & map_points_ptr) {
+      setPendingMap(nullptr, map_points_ptr);
+    });
+  if (!map_tile_loader_) {
+    map_points_sub_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
+      "pointcloud_map", rclcpp::QoS{1}.transient_local(),
+      std::bind(&NDTScanMatcher::callbackMapPoints, this, std::placeholders::_1), main_sub_opt);
+  }
   sensor_points_sub_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
     "points_raw", rclcpp::SensorDataQoS().keep_last(points_queue_size),
     std::bind(&NDTScanMatcher::callbackSensorPoints, this, std::placeholders::_1), main_sub_opt);
@@ -275,6 +312,19 @@ NDTScanMatcher::NDTScanMatcher()
 
   diagnostic_thread_ = std::thread(&NDTScanMatcher::timerDiagnostic, this);
   diagnostic_thread_.detach();
+
+  map_update_thread_ = std::thread(&NDTScanMatcher::runMapUpdate, this);
+}
+
+NDTScanMatcher::~NDTScanMatcher()
+{
+  map_tile_loader_.reset();
+  {
+    std::lock_guard<std::mutex> lock(map_update_mtx_);
+    stop_map_update_ = true;
+  }
+  map_update_condition_.notify_one();
+  map_update_thread_.join();
 }
 
 void NDTScanMatcher::timerDiagnostic()
@@ -339,6 +389,14 @@ void NDTScanMatcher::serviceNDTAlign(
   // transform pose_frame to map_frame
   const auto mapTF_initial_pose_msg = transform(req->pose_with_covariance, *TF_pose_to_map_ptr);
 
+  if (map_tile_loader_) {
+    map_tile_loader_->updatePosition(
+      mapTF_initial_pose_msg.pose.pose.position.x, mapTF_initial_pose_msg.pose.pose.position.y);
+  }
+
+  // mutex Map
+  std::lock_guard<std::mutex> lock(ndt_map_mtx_);
+
   if (ndt_ptr_->getInputTarget() == nullptr) {
     res->success = false;
     res->seq = req->seq;
@@ -353,9 +411,6 @@ void NDTScanMatcher::serviceNDTAlign(
     return;
   }
 
-  // mutex Map
-  std::lock_guard<std::mutex> lock(ndt_map_mtx_);
-
   key_value_stdmap_["state"] = "Aligning";
   res->pose_with_covariance = alignUsingMonteCarlo(ndt_ptr_, mapTF_initial_pose_msg);
   key_value_stdmap_["state"] = "Sleeping";
@@ -393,6 +448,12 @@ void NDTScanMatcher::callbackInitialPose(
     *mapTF_initial_pose_msg_ptr = transform(*initial_pose_msg_ptr, *TF_pose_to_map_ptr);
     initial_pose_msg_ptr_array_.push_back(mapTF_initial_pose_msg_ptr);
   }
+
+  // the map tiles follow the ekf pose, which also gives the first position before any alignment
+  if (map_tile_loader_) {
+    const auto & position = initial_pose_msg_ptr_array_.back()->pose.pose.position;
+    map_tile_loader_->updatePosition(position.x, position.y);
+  }
 }
 
 void NDTScanMatcher::callbackRegularizationPose(
@@ -404,42 +465,110 @@ void NDTScanMatcher::callbackRegularizationPose(
 void NDTScanMatcher::callbackMapPoints(
   sensor_msgs::msg::PointCloud2::ConstSharedPtr map_points_msg_ptr)
 {
+  setPendingMap(map_points_msg_ptr, nullptr);
+}
+
+void NDTScanMatcher::setPendingMap(
+  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & map_points_msg_ptr,
+  const pcl::shared_ptr<pcl::PointCloud<PointTarget>> & map_points_ptr)
+{
+  // only the latest map is built, the scan matching keeps running on the current one meanwhile
+  {
+    std::lock_guard<std::mutex> lock(map_update_mtx_);
+    pending_map_points_msg_ptr_ = map_points_msg_ptr;
+    pending_map_points_ptr_ = map_points_ptr;
+  }
+  map_update_condition_.notify_one();
+}
+
+void NDTScanMatcher::runMapUpdate()
+{
+  while (true) {
+    sensor_msgs::msg::PointCloud2::ConstSharedPtr map_points_msg_ptr;
+    pcl::shared_ptr<pcl::PointCloud<PointTarget>> map_points_ptr;
+    {
+      std::unique_lock<std::mutex> lock(map_update_mtx_);
+      map_update_condition_.wait(lock, [this] {
+        return stop_map_update_ || pending_map_points_msg_ptr_ != nullptr ||
+               pending_map_points_ptr_ != nullptr;
+      });
+      if (stop_map_update_) {
+        return;
+      }
+      map_points_msg_ptr = std::move(pending_map_points_msg_ptr_);
+      map_points_ptr = std::move(pending_map_points_ptr_);
+      pending_map_points_msg_ptr_ = nullptr;
+      pending_map_points_ptr_ = nullptr;
+    }
+    if (map_points_msg_ptr) {
+      map_points_ptr.reset(new pcl::PointCloud<PointTarget>);
+      pcl::fromROSMsg(*map_points_msg_ptr, *map_points_ptr);
+    }
+    updateMap(map_points_ptr);
+  }
+}
+
+void NDTScanMatcher::updateMap(const pcl::shared_ptr<pcl::PointCloud<PointTarget>> & map_points_ptr)
+{
+  ndt_map_mtx_.lock();
   const auto trans_epsilon = ndt_ptr_->getTransformationEpsilon();
   const auto step_size = ndt_ptr_->getStepSize();
   const auto resolution = ndt_ptr_->getResolution();
   const auto max_iterations = ndt_ptr_->getMaximumIterations();
+  ndt_map_mtx_.unlock();
 
+  // a new instance is always made, the current one being still in use by the scan matching
   using NDTBase = NormalDistributionsTransformBase<PointSource, PointTarget>;
-  std::shared_ptr<NDTBase> new_ndt_ptr = getNDT<PointSource, PointTarget>(ndt_implement_type_);
+  const auto create_ndt = [&](const int omp_num_threads) {
+    std::shared_ptr<NDTBase> new_ndt_ptr = getNDT<PointSource, PointTarget>(ndt_implement_type_);
 
-  if (ndt_implement_type_ == NDTImplementType::OMP) {
-    using T = NormalDistributionsTransformOMP<PointSource, PointTarget>;
+    if (ndt_implement_type_ == NDTImplementType::OMP) {
+      using T = NormalDistributionsTransformOMP<PointSource, PointTarget>;
 
-    // FIXME(IshitaTakeshi) Not sure if this is safe
-    std::shared_ptr<T> ndt_omp_ptr = std::dynamic_pointer_cast<T>(ndt_ptr_);
-    ndt_omp_ptr->setNeighborhoodSearchMethod(omp_params_.search_method);
-    ndt_omp_ptr->setNumThreads(omp_params_.num_threads);
-    new_ndt_ptr = ndt_omp_ptr;
-  }
+      std::shared_ptr<T> ndt_omp_ptr = std::dynamic_pointer_cast<T>(new_ndt_ptr);
+      ndt_omp_ptr->setNeighborhoodSearchMethod(omp_params_.search_method);
+      ndt_omp_ptr->setNumThreads(omp_num_threads);
+    }
+    if (isVoxelHashType(ndt_implement_type_)) {
+      using T = NormalDistributionsTransformVoxelHash<PointSource, PointTarget>;
+      std::dynamic_pointer_cast<T>(new_ndt_ptr)->setNumThreads(omp_num_threads);
+    }
 
-  new_ndt_ptr->setTransformationEpsilon(trans_epsilon);
-  new_ndt_ptr->setStepSize(step_size);
-  new_ndt_ptr->setResolution(resolution);
-  new_ndt_ptr->setMaximumIterations(max_iterations);
-  new_ndt_ptr->setRegularizationScaleFactor(regularization_scale_factor_);
+    new_ndt_ptr->setTransformationEpsilon(trans_epsilon);
+    new_ndt_ptr->setStepSize(step_size);
+    new_ndt_ptr->setResolution(resolution);
+    new_ndt_ptr->setMaximumIterations(max_iterations);
+    new_ndt_ptr->setRegularizationScaleFactor(regularization_scale_factor_);
 
-  pcl::shared_ptr<pcl::PointCloud<PointTarget>> map_points_ptr(new pcl::PointCloud<PointTarget>);
-  pcl::fromROSMsg(*map_points_msg_ptr, *map_points_ptr);
-  new_ndt_ptr->setInputTarget(map_points_ptr);
-  // create Thread
-  // detach
+    new_ndt_ptr->setInputTarget(map_points_ptr);
+    return new_ndt_ptr;
+  };
+
+  std::shared_ptr<NDTBase> new_ndt_ptr = create_ndt(omp_params_.num_threads);
   auto output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
   new_ndt_ptr->align(*output_cloud, Eigen::Matrix4f::Identity());
 
-  // swap
+  // the instances of the other initial pose estimation threads share the map points, but the NDT
+  // implementations each build their own voxel grid
+  std::vector<std::shared_ptr<NDTBase>> new_ndt_worker_ptrs;
+  const int worker_omp_num_threads =
+    std::max(omp_params_.num_threads / initial_estimate_num_threads_, 1);
+  for (int i = 1; i < initial_estimate_num_threads_; ++i) {
+    new_ndt_worker_ptrs.push_back(create_ndt(worker_omp_num_threads));
+  }
+
+  // swap, the last scan is kept so that the alignment service can still run on the new map
   ndt_map_mtx_.lock();
-  ndt_ptr_ = new_ndt_ptr;
+  if (ndt_ptr_->getInputSource() != nullptr) {
+    new_ndt_ptr->setInputSource(sensor_points_baselinkTF_ptr_);
+  }
+  ndt_ptr_.swap(new_ndt_ptr);
+  ndt_worker_ptrs_.swap(new_ndt_worker_ptrs);
   ndt_map_mtx_.unlock();
+
+  // the previous map is freed here rather than under the lock
+  new_ndt_ptr.reset();
+  new_ndt_worker_ptrs.clear();
 }
 
 void NDTScanMatcher::callbackSensorPoints(
@@ -452,19 +581,18 @@ void NDTScanMatcher::callbackSensorPoints(
   const std::string & sensor_frame = sensor_points_sensorTF_msg_ptr->header.frame_id;
   const rclcpp::Time sensor_ros_time = sensor_points_sensorTF_msg_ptr->header.stamp;
 
-  boost::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_sensorTF_ptr(
-    new pcl::PointCloud<PointSource>);
+  const auto sensor_points_sensorTF_ptr = getPointBuffer(sensor_points_sensorTF_ptr_);
   pcl::fromROSMsg(*sensor_points_sensorTF_msg_ptr, *sensor_points_sensorTF_ptr);
   // get TF base to sensor
   auto TF_base_to_sensor_ptr = std::make_shared<geometry_msgs::msg::TransformStamped>();
   getTransform(base_frame_, sensor_frame, TF_base_to_sensor_ptr);
   const Eigen::Affine3d base_to_sensor_affine = tf2::transformToEigen(*TF_base_to_sensor_ptr);
   const Eigen::Matrix4f base_to_sensor_matrix = base_to_sensor_affine.matrix().cast<float>();
-  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_baselinkTF_ptr(
-    new pcl::PointCloud<PointSource>);
+  const auto sensor_points_baselinkTF_ptr = getPointBuffer(sensor_points_baselinkTF_ptr_);
   pcl::transformPointCloud(
     *sensor_points_sensorTF_ptr, *sensor_points_baselinkTF_ptr, base_to_sensor_matrix);
   ndt_ptr_->setInputSource(sensor_points_baselinkTF_ptr);
+  sensor_points_baselinkTF_ptr_ = sensor_points_baselinkTF_ptr;
 
   // start of critical section for initial_pose_msg_ptr_array_
   std::unique_lock<std::mutex> initial_pose_array_lock(initial_pose_array_mtx_);
@@ -499,7 +627,9 @@ void NDTScanMatcher::callbackSensorPoints(
   }
 
   // If regularization is enabled and available, set pose to NDT for regularization
-  if (regularization_enabled_ && (ndt_implement_type_ == NDTImplementType::OMP)) {
+  if (
+    regularization_enabled_ &&
+    (ndt_implement_type_ == NDTImplementType::OMP || isVoxelHashType(ndt_implement_type_))) {
     ndt_ptr_->unsetRegularizationPose();
     std::optional<Eigen::Matrix4f> pose_opt = interpolateRegularizationPose(sensor_ros_time);
     if (pose_opt.has_value()) {
@@ -526,7 +656,7 @@ void NDTScanMatcher::callbackSensorPoints(
   const Eigen::Affine3d initial_pose_affine = fromRosPoseToEigen(initial_pose_cov_msg.pose.pose);
   const Eigen::Matrix4f initial_pose_matrix = initial_pose_affine.matrix().cast<float>();
 
-  auto output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
+  const auto output_cloud = getPointBuffer(aligned_points_ptr_);
   key_value_stdmap_["state"] = "Aligning";
   ndt_ptr_->align(*output_cloud, initial_pose_matrix);
   key_value_stdmap_["state"] = "Sleeping";
@@ -539,6 +669,7 @@ void NDTScanMatcher::callbackSensorPoints(
   const std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>>
     result_pose_matrix_array = ndt_ptr_->getFinalTransformationArray();
   std::vector<geometry_msgs::msg::Pose> result_pose_msg_array;
+  result_pose_msg_array.reserve(result_pose_matrix_array.size());
   for (const auto & pose_matrix : result_pose_matrix_array) {
     Eigen::Affine3d pose_affine;
     pose_affine.matrix() = pose_matrix.cast<double>();
@@ -638,41 +769,48 @@ void NDTScanMatcher::callbackSensorPoints(
 
   publishTF(ndt_base_frame_, result_pose_stamped_msg);
 
-  auto sensor_points_mapTF_ptr = std::make_shared<pcl::PointCloud<PointSource>>();
-  pcl::transformPointCloud(
-    *sensor_points_baselinkTF_ptr, *sensor_points_mapTF_ptr, result_pose_matrix);
-  sensor_msgs::msg::PointCloud2 sensor_points_mapTF_msg;
-  pcl::toROSMsg(*sensor_points_mapTF_ptr, sensor_points_mapTF_msg);
-  sensor_points_mapTF_msg.header.stamp = sensor_ros_time;
-  sensor_points_mapTF_msg.header.frame_id = map_frame_;
-  sensor_aligned_pose_pub_->publish(sensor_points_mapTF_msg);
+  // the debug cloud and markers are only made for their subscribers
+  if (hasSubscriber(sensor_aligned_pose_pub_)) {
+    const auto sensor_points_mapTF_ptr = getPointBuffer(sensor_points_mapTF_ptr_);
+    pcl::transformPointCloud(
+      *sensor_points_baselinkTF_ptr, *sensor_points_mapTF_ptr, result_pose_matrix);
+    sensor_msgs::msg::PointCloud2 sensor_points_mapTF_msg;
+    pcl::toROSMsg(*sensor_points_mapTF_ptr, sensor_points_mapTF_msg);
+    sensor_points_mapTF_msg.header.stamp = sensor_ros_time;
+    sensor_points_mapTF_msg.header.frame_id = map_frame_;
+    sensor_aligned_pose_pub_->publish(sensor_points_mapTF_msg);
+  }
 
   initial_pose_with_covariance_pub_->publish(initial_pose_cov_msg);
 
-  visualization_msgs::msg::MarkerArray marker_array;
-  visualization_msgs::msg::Marker marker;
-  marker.header.stamp = sensor_ros_time;
-  marker.header.frame_id = map_frame_;
-  marker.type = visualization_msgs::msg::Marker::ARROW;
-  marker.action = visualization_msgs::msg::Marker::ADD;
-  marker.scale = tier4_autoware_utils::createMarkerScale(0.3, 0.1, 0.1);
-  int i = 0;
-  marker.ns = "result_pose_matrix_array";
-  marker.action = visualization_msgs::msg::Marker::ADD;
-  for (const auto & pose_msg : result_pose_msg_array) {
-    marker.id = i++;
-    marker.pose = pose_msg;
-    marker.color = ExchangeColorCrc((1.0 * i) / 15.0);
-    marker_array.markers.push_back(marker);
-  }
-  // TODO(Tier IV): delete old marker
-  for (; i < ndt_ptr_->getMaximumIterations() + 2;) {
-    marker.id = i++;
-    marker.pose = geometry_msgs::msg::Pose();
-    marker.color = ExchangeColorCrc(0);
-    marker_array.markers.push_back(marker);
-  }
-  ndt_marker_pub_->publish(marker_array);
+  if (hasSubscriber(ndt_marker_pub_)) {
+    visualization_msgs::msg::MarkerArray marker_array;
+    marker_array.markers.reserve(std::max(
+      static_cast<int>(result_pose_msg_array.size()), ndt_ptr_->getMaximumIterations() + 2));
+    visualization_msgs::msg::Marker marker;
+    marker.header.stamp = sensor_ros_time;
+    marker.header.frame_id = map_frame_;
+    marker.type = visualization_msgs::msg::Marker::ARROW;
+    marker.action = visualization_msgs::msg::Marker::ADD;
+    marker.scale = tier4_autoware_utils::createMarkerScale(0.3, 0.1, 0.1);
+    int i = 0;
+    marker.ns = "result_pose_matrix_array";
+    marker.action = visualization_msgs::msg::Marker::ADD;
+    for (const auto & pose_msg : result_pose_msg_array) {
+      marker.id = i++;
+      marker.pose = pose_msg;
+      marker.color = ExchangeColorCrc((1.0 * i) / 15.0);
+      marker_array.markers.push_back(marker);
+    }
+    // TODO(Tier IV): delete old marker
+    for (; i < ndt_ptr_->getMaximumIterations() + 2;) {
+      marker.id = i++;
+      marker.pose = geometry_msgs::msg::Pose();
+      marker.color = ExchangeColorCrc(0);
+      marker_array.markers.push_back(marker);
+    }
+    ndt_marker_pub_->publish(marker_array);
+  }
 
   exe_time_pub_->publish(makeFloat32Stamped(sensor_ros_time, exe_time));
 
@@ -722,40 +860,96 @@ geometry_msgs::msg::PoseWithCovarianceStamped NDTScanMatcher::alignUsingMonteCar
   const auto initial_poses =
     createRandomPoseArray(initial_pose_with_cov, initial_estimate_particles_num_);
 
-  std::vector<Particle> particle_array;
-  auto output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
-
-  for (unsigned int i = 0; i < initial_poses.size(); i++) {
-    const auto & initial_pose = initial_poses[i];
-
-    const Eigen::Affine3d initial_pose_affine = fromRosPoseToEigen(initial_pose);
-    const Eigen::Matrix4f initial_pose_matrix = initial_pose_affine.matrix().cast<float>();
-
-    ndt_ptr->align(*output_cloud, initial_pose_matrix);
-
-    const Eigen::Matrix4f result_pose_matrix = ndt_ptr->getFinalTransformation();
-    Eigen::Affine3d result_pose_affine;
-    result_pose_affine.matrix() = result_pose_matrix.cast<double>();
-    const geometry_msgs::msg::Pose result_pose = tf2::toMsg(result_pose_affine);
+  // with the early stop, the particles scoring best where they start are aligned first
+  std::vector<size_t> particle_order(initial_poses.size());
+  std::iota(particle_order.begin(), particle_order.end(), 0U);
+  if (initial_estimate_score_threshold_ > 0.0) {
+    std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>> initial_pose_matrices;
+    initial_pose_matrices.reserve(initial_poses.size());
+    for (const auto & initial_pose : initial_poses) {
+      initial_pose_matrices.push_back(fromRosPoseToEigen(initial_pose).matrix().cast<float>());
+    }
+    const auto initial_scores = ndt_ptr->evaluatePoses(initial_pose_matrices);
+    std::stable_sort(
+      particle_order.begin(), particle_order.end(),
+      [&initial_scores](const size_t a, const size_t b) {
+        return initial_scores[a].transformation_probability >
+               initial_scores[b].transformation_probability;
+      });
+  }
 
-    const auto transform_probability = ndt_ptr->getTransformationProbability();
-    const auto num_iteration = ndt_ptr->getFinalNumIteration();
+  std::vector<Particle> particle_array;
+  particle_array.reserve(initial_poses.size());
+  std::mutex particle_array_mtx;
+  std::atomic<size_t> next_particle_index{0};
+  std::atomic<bool> is_score_reached{false};
 
-    Particle particle(initial_pose, result_pose, transform_probability, num_iteration);
-    particle_array.push_back(particle);
-    const auto marker_array = makeDebugMarkers(
-      this->now(), map_frame_, tier4_autoware_utils::createMarkerScale(0.3, 0.1, 0.1), particle, i);
-    ndt_monte_carlo_initial_pose_marker_pub_->publish(marker_array);
+  using NDTBase = NormalDistributionsTransformBase<PointSource, PointTarget>;
+  using PointSourceCloudPtr = pcl::shared_ptr<pcl::PointCloud<PointSource>>;
+  const auto align_particles = [&](
+                                 const std::shared_ptr<NDTBase> & particle_ndt_ptr,
+                                 const PointSourceCloudPtr & output_cloud,
+                                 const PointSourceCloudPtr & sensor_points_mapTF_ptr) {
+    for (size_t k = next_particle_index++; k < initial_poses.size() && !is_score_reached;
+         k = next_particle_index++) {
+      const size_t i = particle_order[k];
+      const auto & initial_pose = initial_poses[i];
+
+      const Eigen::Affine3d initial_pose_affine = fromRosPoseToEigen(initial_pose);
+      const Eigen::Matrix4f initial_pose_matrix = initial_pose_affine.matrix().cast<float>();
+
+      particle_ndt_ptr->align(*output_cloud, initial_pose_matrix);
+
+      const Eigen::Matrix4f result_pose_matrix = particle_ndt_ptr->getFinalTransformation();
+      Eigen::Affine3d result_pose_affine;
+      result_pose_affine.matrix() = result_pose_matrix.cast<double>();
+      const geometry_msgs::msg::Pose result_pose = tf2::toMsg(result_pose_affine);
+
+      const auto transform_probability = particle_ndt_ptr->getTransformationProbability();
+      const auto num_iteration = particle_ndt_ptr->getFinalNumIteration();
+
+      // the remaining particles are skipped once one of them is good enough
+      if (
+        initial_estimate_score_threshold_ > 0.0 &&
+        transform_probability >= initial_estimate_score_threshold_) {
+        is_score_reached = true;
+      }
 
-    auto sensor_points_mapTF_ptr = std::make_shared<pcl::PointCloud<PointSource>>();
-    const auto sensor_points_baselinkTF_ptr = ndt_ptr->getInputSource();
-    pcl::transformPointCloud(
-      *sensor_points_baselinkTF_ptr, *sensor_points_mapTF_ptr, result_pose_matrix);
-    sensor_msgs::msg::PointCloud2 sensor_points_mapTF_msg;
-    pcl::toROSMsg(*sensor_points_mapTF_ptr, sensor_points_mapTF_msg);
-    sensor_points_mapTF_msg.header.stamp = initial_pose_with_cov.header.stamp;
-    sensor_points_mapTF_msg.header.frame_id = map_frame_;
-    sensor_aligned_pose_pub_->publish(sensor_points_mapTF_msg);
+      Particle particle(initial_pose, result_pose, transform_probability, num_iteration);
+      {
+        std::lock_guard<std::mutex> lock(particle_array_mtx);
+        particle_array.push_back(particle);
+      }
+      const auto marker_array = makeDebugMarkers(
+        this->now(), map_frame_, tier4_autoware_utils::createMarkerScale(0.3, 0.1, 0.1), particle,
+        i);
+      ndt_monte_carlo_initial_pose_marker_pub_->publish(marker_array);
+
+      if (hasSubscriber(sensor_aligned_pose_pub_)) {
+        const auto sensor_points_baselinkTF_ptr = particle_ndt_ptr->getInputSource();
+        pcl::transformPointCloud(
+          *sensor_points_baselinkTF_ptr, *sensor_points_mapTF_ptr, result_pose_matrix);
+        sensor_msgs::msg::PointCloud2 sensor_points_mapTF_msg;
+        pcl::toROSMsg(*sensor_points_mapTF_ptr, sensor_points_mapTF_msg);
+        sensor_points_mapTF_msg.header.stamp = initial_pose_with_cov.header.stamp;
+        sensor_points_mapTF_msg.header.frame_id = map_frame_;
+        sensor_aligned_pose_pub_->publish(sensor_points_mapTF_msg);
+      }
+    }
+  };
+
+  // ndt_ptr takes the particles on this thread, the instances built with it on the others
+  std::vector<std::thread> threads;
+  for (const auto & ndt_worker_ptr : ndt_worker_ptrs_) {
+    ndt_worker_ptr->setInputSource(sensor_points_baselinkTF_ptr_);
+    threads.emplace_back(
+      align_particles, ndt_worker_ptr, pcl::make_shared<pcl::PointCloud<PointSource>>(),
+      pcl::make_shared<pcl::PointCloud<PointSource>>());
+  }
+  align_particles(
+    ndt_ptr, getPointBuffer(aligned_points_ptr_), getPointBuffer(sensor_points_mapTF_ptr_));
+  for (auto & thread : threads) {
+    thread.join();
   }
 
   auto best_particle_ptr = std::max_element(
@@ -777,6 +971,16 @@ void NDTScanMatcher::publishTF(
   tf2_broadcaster_.sendTransform(tier4_autoware_utils::pose2transform(pose_msg, child_frame_id));
 }
 
+pcl::shared_ptr<pcl::PointCloud<PointSource>> NDTScanMatcher::getPointBuffer(
+  const pcl::shared_ptr<pcl::PointCloud<PointSource>> & buffer) const
+{
+  // the points are overwritten in place, the buffer keeping the capacity of the previous scans
+  if (reuse_point_buffers_) {
+    return buffer;
+  }
+  return pcl::make_shared<pcl::PointCloud<PointSource>>();
+}
+
 bool NDTScanMatcher::getTransform(
   const std::string & target_frame, const std::string & source_frame,
   const geometry_msgs::msg::TransformStamped::SharedPtr & transform_stamped_ptr)
@@ -31,10 +31,13 @@
 #ifndef MAP_LOADER__POINTCLOUD_MAP_LOADER_NODE_HPP_
 #define MAP_LOADER__POINTCLOUD_MAP_LOADER_NODE_HPP_
 
+#include "map_loader/pointcloud_map_tile_server.hpp"
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -45,8 +48,13 @@ public:
 
 private:
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr pub_pointcloud_map_;
+  std::unique_ptr<PointCloudMapTileServer> tile_server_;
+  bool enable_whole_load_;
 
   sensor_msgs::msg::PointCloud2 loadPCDFiles(const std::vector<std::string> & pcd_paths);
+  // append the points of the map tiles files to whole_pcd
+  void loadTilesFiles(
+    const std::vector<std::string> & tiles_paths, sensor_msgs::msg::PointCloud2 & whole_pcd);
 };
 
 #endif  // MAP_LOADER__POINTCLOUD_MAP_LOADER_NODE_HPP_
@@ -0,0 +1,84 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MAP_LOADER__POINTCLOUD_MAP_TILE_SERVER_HPP_
+#define MAP_LOADER__POINTCLOUD_MAP_TILE_SERVER_HPP_
+
+#include "map_loader/pointcloud_map_tiles.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <autoware_map_msgs/msg/area_info.hpp>
+#include <autoware_map_msgs/msg/point_cloud_map_cell_with_id.hpp>
+#include <autoware_map_msgs/srv/get_differential_point_cloud_map.hpp>
+#include <autoware_map_msgs/srv/get_partial_point_cloud_map.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Serves the tiles of the pointcloud map which intersect an area, so that the clients only
+ * hold their surroundings instead of the whole map. Only the extent of the tiles is kept, their
+ * points being read from the pcd file or the mapped map tiles file of the tile on every request.
+ */
+class PointCloudMapTileServer
+{
+public:
+  PointCloudMapTileServer(
+    rclcpp::Node * node, const bool enable_partial_load, const bool enable_differential_load);
+
+  /** \brief Add the tile of a pcd file loaded as pcd, identified by its path. */
+  void addPcdTile(const std::string & path, const sensor_msgs::msg::PointCloud2 & pcd);
+  /** \brief Add the tiles of a map tiles file, identified by its path and their index. */
+  void addTilesFile(const std::string & path, std::shared_ptr<const PointCloudMapTiles> tiles);
+
+  std::size_t tileNum() const { return tiles_.size(); }
+
+private:
+  using GetPartialPointCloudMap = autoware_map_msgs::srv::GetPartialPointCloudMap;
+  using GetDifferentialPointCloudMap = autoware_map_msgs::srv::GetDifferentialPointCloudMap;
+
+  struct Tile
+  {
+    std::string id;
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+    std::string pcd_path;                             // empty for the tiles of a map tiles file
+    std::shared_ptr<const PointCloudMapTiles> tiles;  // nullptr for a pcd file
+    std::size_t tile_index;
+  };
+
+  static bool isInArea(const Tile & tile, const autoware_map_msgs::msg::AreaInfo & area);
+  bool loadTile(const Tile & tile, autoware_map_msgs::msg::PointCloudMapCellWithID & cell) const;
+
+  void onGetPartialPointCloudMap(
+    const GetPartialPointCloudMap::Request::SharedPtr req,
+    GetPartialPointCloudMap::Response::SharedPtr res) const;
+  void onGetDifferentialPointCloudMap(
+    const GetDifferentialPointCloudMap::Request::SharedPtr req,
+    GetDifferentialPointCloudMap::Response::SharedPtr res) const;
+
+  rclcpp::Logger logger_;
+  rclcpp::Clock::SharedPtr clock_;
+  std::vector<Tile> tiles_;
+
+  rclcpp::Service<GetPartialPointCloudMap>::SharedPtr srv_partial_;
+  rclcpp::Service<GetDifferentialPointCloudMap>::SharedPtr srv_differential_;
+};
+
+#endif  // MAP_LOADER__POINTCLOUD_MAP_TILE_SERVER_HPP_
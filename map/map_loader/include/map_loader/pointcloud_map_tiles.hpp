@@ -0,0 +1,122 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MAP_LOADER__POINTCLOUD_MAP_TILES_HPP_
+#define MAP_LOADER__POINTCLOUD_MAP_TILES_HPP_
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct PointCloudMapTilesHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t point_step;
+  uint32_t field_num;
+  uint64_t tile_num;
+  uint64_t point_num;
+  uint64_t data_offset;  // offset of the points from the beginning of the file, page aligned
+  char frame_id[64];
+};
+static_assert(sizeof(PointCloudMapTilesHeader) == 104, "PointCloudMapTilesHeader layout changed");
+
+/** \brief sensor_msgs/PointField of the points of the tiles. */
+struct PointCloudMapTilesField
+{
+  char name[32];
+  uint32_t offset;
+  uint32_t count;
+  uint8_t datatype;
+  uint8_t reserved[7];
+};
+static_assert(sizeof(PointCloudMapTilesField) == 48, "PointCloudMapTilesField layout changed");
+
+/** \brief Extent in xy of a tile, its points being [point_begin, point_begin + point_num). */
+struct PointCloudMapTile
+{
+  float min_x;
+  float min_y;
+  float max_x;
+  float max_y;
+  uint64_t point_begin;
+  uint64_t point_num;
+};
+static_assert(sizeof(PointCloudMapTile) == 32, "PointCloudMapTile layout changed");
+
+/**
+ * \brief Pointcloud map stored as tiles of raw PointCloud2 points, after an index of the tiles.
+ * The file is built once from the pcd files of the map and memory-mapped read-only by the loader,
+ * so that opening it does not parse anything. The points of all the tiles are contiguous, the
+ * whole map being copied out in one go, and a single tile can be read through the index.
+ */
+class PointCloudMapTiles
+{
+public:
+  static constexpr uint32_t magic = 0x53544350;  // "PCTS"
+  static constexpr uint32_t version = 1U;
+
+  PointCloudMapTiles() = default;
+  ~PointCloudMapTiles();
+  PointCloudMapTiles(const PointCloudMapTiles &) = delete;
+  PointCloudMapTiles & operator=(const PointCloudMapTiles &) = delete;
+
+  /** \brief Whether the path has the extension of the map tiles files. */
+  static bool isTilesFile(const std::string & path);
+
+  /** \brief Start building a new map, the tiles can be read or saved after adding them. */
+  void initialize(const std::string & frame_id);
+  /**
+   * \brief Add a tile with the points of cloud. Returns false if cloud has no float x and y, or
+   * if its fields differ from the ones of the first tile.
+   */
+  bool addTile(const sensor_msgs::msg::PointCloud2 & cloud);
+
+  bool save(const std::string & path) const;
+  /** \brief Map a file written by save(). Returns false if it can not be read or is invalid. */
+  bool load(const std::string & path);
+
+  /** \brief Set cloud to the points of the i-th tile. */
+  void getTile(const std::size_t i, sensor_msgs::msg::PointCloud2 & cloud) const;
+  /** \brief Set cloud to the points of all the tiles. */
+  void getMap(sensor_msgs::msg::PointCloud2 & cloud) const;
+
+  bool empty() const { return header_.tile_num == 0U; }
+  std::size_t tileNum() const { return header_.tile_num; }
+  std::size_t pointNum() const { return header_.point_num; }
+  const PointCloudMapTile & tile(const std::size_t i) const { return tiles_[i]; }
+  std::string frameId() const { return header_.frame_id; }
+
+private:
+  void unmap();
+  void clear();
+  void getPoints(
+    const uint64_t point_begin, const uint64_t point_num,
+    sensor_msgs::msg::PointCloud2 & cloud) const;
+
+  PointCloudMapTilesHeader header_{};
+  std::vector<sensor_msgs::msg::PointField> fields_;
+  const PointCloudMapTile * tiles_{nullptr};
+  const uint8_t * points_{nullptr};
+  void * mapped_{nullptr};
+  std::size_t mapped_size_{0U};
+
+  std::vector<PointCloudMapTile> owned_tiles_;
+  std::vector<uint8_t> owned_points_;
+};
+
+#endif  // MAP_LOADER__POINTCLOUD_MAP_TILES_HPP_
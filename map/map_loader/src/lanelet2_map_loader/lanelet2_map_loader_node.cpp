@@ -44,53 +44,185 @@
 #include <lanelet2_io/Io.h>
 #include <lanelet2_projection/UTM.h>
 
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <string>
+#include <vector>
+
+namespace
+{
+struct Lanelet2MapCacheHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t key;
+  uint64_t format_version_size;
+  uint64_t map_version_size;
+  uint64_t data_size;
+};
+static_assert(sizeof(Lanelet2MapCacheHeader) == 40, "Lanelet2MapCacheHeader layout changed");
+
+constexpr uint32_t cache_magic = 0x434d4c4c;  // "LLMC"
+constexpr uint32_t cache_version = 1U;
+
+// 64 bit FNV-1a
+uint64_t hashBytes(const char * data, const std::size_t size, uint64_t hash = 0xcbf29ce484222325U)
+{
+  for (std::size_t i = 0; i < size; ++i) {
+    hash = (hash ^ static_cast<uint8_t>(data[i])) * 0x100000001b3U;
+  }
+  return hash;
+}
+
+// key of the map loaded from the osm file with the given settings, 0 if the file can not be read
+uint64_t getCacheKey(const std::string & lanelet2_filename, const std::string & settings)
+{
+  std::ifstream ifs(lanelet2_filename, std::ios::binary);
+  if (!ifs) {
+    return 0U;
+  }
+  uint64_t hash = hashBytes(settings.data(), settings.size());
+  std::vector<char> buffer(1 << 16);
+  while (ifs.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || ifs.gcount() > 0) {
+    hash = hashBytes(buffer.data(), static_cast<std::size_t>(ifs.gcount()), hash);
+  }
+  return hash;
+}
+
+bool readCache(
+  const std::string & cache_path, const uint64_t key,
+  autoware_auto_mapping_msgs::msg::HADMapBin & map_bin_msg)
+{
+  std::ifstream ifs(cache_path, std::ios::binary);
+  Lanelet2MapCacheHeader header{};
+  if (!ifs.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    return false;
+  }
+  if (header.magic != cache_magic || header.version != cache_version || header.key != key) {
+    return false;
+  }
+
+  ifs.seekg(0, std::ios::end);
+  const auto size = static_cast<uint64_t>(ifs.tellg());
+  if (size != sizeof(header) + header.format_version_size + header.map_version_size +
+                header.data_size) {
+    return false;
+  }
+  ifs.seekg(sizeof(header));
+  map_bin_msg.format_version.resize(header.format_version_size);
+  map_bin_msg.map_version.resize(header.map_version_size);
+  map_bin_msg.data.resize(header.data_size);
+  ifs.read(
+    &map_bin_msg.format_version[0], static_cast<std::streamsize>(header.format_version_size));
+  ifs.read(&map_bin_msg.map_version[0], static_cast<std::streamsize>(header.map_version_size));
+  ifs.read(
+    reinterpret_cast<char *>(map_bin_msg.data.data()),
+    static_cast<std::streamsize>(header.data_size));
+  return ifs.good();
+}
+
+bool writeCache(
+  const std::string & cache_path, const uint64_t key,
+  const autoware_auto_mapping_msgs::msg::HADMapBin & map_bin_msg)
+{
+  Lanelet2MapCacheHeader header{};
+  header.magic = cache_magic;
+  header.version = cache_version;
+  header.key = key;
+  header.format_version_size = map_bin_msg.format_version.size();
+  header.map_version_size = map_bin_msg.map_version.size();
+  header.data_size = map_bin_msg.data.size();
+
+  // written aside and renamed, so that a loader never reads a partial cache
+  const std::string tmp_path = cache_path + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    ofs.write(
+      map_bin_msg.format_version.data(),
+      static_cast<std::streamsize>(map_bin_msg.format_version.size()));
+    ofs.write(
+      map_bin_msg.map_version.data(), static_cast<std::streamsize>(map_bin_msg.map_version.size()));
+    ofs.write(
+      reinterpret_cast<const char *>(map_bin_msg.data.data()),
+      static_cast<std::streamsize>(map_bin_msg.data.size()));
+    if (!ofs.good()) {
+      return false;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, cache_path, ec);
+  return !ec;
+}
+}  // namespace
 
 Lanelet2MapLoaderNode::Lanelet2MapLoaderNode(const rclcpp::NodeOptions & options)
 : Node("lanelet2_map_loader", options)
 {
   const auto lanelet2_filename = declare_parameter("lanelet2_map_path", "");
   const auto lanelet2_map_projector_type = declare_parameter("lanelet2_map_projector_type", "MGRS");
-  lanelet::ErrorMessages errors{};
-  lanelet::LaneletMapPtr map;
-  if (lanelet2_map_projector_type == "MGRS") {
-    lanelet::projection::MGRSProjector projector{};
-    map = lanelet::load(lanelet2_filename, projector, &errors);
-  } else if (lanelet2_map_projector_type == "UTM") {
-    double map_origin_lat = this->declare_parameter("latitude", 0.0);
-    double map_origin_lon = this->declare_parameter("longitude", 0.0);
-    lanelet::GPSPoint position{map_origin_lat, map_origin_lon};
-    lanelet::Origin origin{position};
-    lanelet::projection::UtmProjector projector{origin};
-    map = lanelet::load(lanelet2_filename, projector, &errors);
-  } else {
-    RCLCPP_ERROR(this->get_logger(), "lanelet2_map_projector_type is not supported");
-  }
+  const auto center_line_resolution = this->declare_parameter("center_line_resolution", 5.0);
+  const auto lanelet2_map_cache_path = declare_parameter("lanelet2_map_cache_path", "");
 
-  for (const auto & error : errors) {
-    RCLCPP_ERROR_STREAM(this->get_logger(), error);
-  }
-  if (!errors.empty()) {
-    return;
+  // everything the published map depends on, besides the osm file and the version of the cache
+  std::string settings = lanelet2_map_projector_type + " " + std::to_string(center_line_resolution);
+  double map_origin_lat = 0.0;
+  double map_origin_lon = 0.0;
+  if (lanelet2_map_projector_type == "UTM") {
+    map_origin_lat = this->declare_parameter("latitude", 0.0);
+    map_origin_lon = this->declare_parameter("longitude", 0.0);
+    settings += " " + std::to_string(map_origin_lat) + " " + std::to_string(map_origin_lon);
   }
 
-  const auto center_line_resolution = this->declare_parameter("center_line_resolution", 5.0);
-  lanelet::utils::overwriteLaneletsCenterline(map, center_line_resolution, false);
+  autoware_auto_mapping_msgs::msg::HADMapBin map_bin_msg;
+  const uint64_t cache_key =
+    lanelet2_map_cache_path.empty() ? 0U : getCacheKey(lanelet2_filename, settings);
+  if (cache_key != 0U && readCache(lanelet2_map_cache_path, cache_key, map_bin_msg)) {
+    RCLCPP_INFO_STREAM(get_logger(), "loaded lanelet2 map from cache " << lanelet2_map_cache_path);
+  } else {
+    lanelet::ErrorMessages errors{};
+    lanelet::LaneletMapPtr map;
+    if (lanelet2_map_projector_type == "MGRS") {
+      lanelet::projection::MGRSProjector projector{};
+      map = lanelet::load(lanelet2_filename, projector, &errors);
+    } else if (lanelet2_map_projector_type == "UTM") {
+      lanelet::GPSPoint position{map_origin_lat, map_origin_lon};
+      lanelet::Origin origin{position};
+      lanelet::projection::UtmProjector projector{origin};
+      map = lanelet::load(lanelet2_filename, projector, &errors);
+    } else {
+      RCLCPP_ERROR(this->get_logger(), "lanelet2_map_projector_type is not supported");
+    }
+
+    for (const auto & error : errors) {
+      RCLCPP_ERROR_STREAM(this->get_logger(), error);
+    }
+    if (!errors.empty()) {
+      return;
+    }
+
+    lanelet::utils::overwriteLaneletsCenterline(map, center_line_resolution, false);
+
+    std::string format_version{}, map_version{};
+    lanelet::io_handlers::AutowareOsmParser::parseVersions(
+      lanelet2_filename, &format_version, &map_version);
 
-  std::string format_version{}, map_version{};
-  lanelet::io_handlers::AutowareOsmParser::parseVersions(
-    lanelet2_filename, &format_version, &map_version);
+    map_bin_msg.format_version = format_version;
+    map_bin_msg.map_version = map_version;
+    lanelet::utils::conversion::toBinMsg(map, &map_bin_msg);
+
+    if (cache_key != 0U && !writeCache(lanelet2_map_cache_path, cache_key, map_bin_msg)) {
+      RCLCPP_WARN_STREAM(
+        get_logger(), "failed to write lanelet2 map cache " << lanelet2_map_cache_path);
+    }
+  }
 
   pub_map_bin_ = this->create_publisher<autoware_auto_mapping_msgs::msg::HADMapBin>(
     "output/lanelet2_map", rclcpp::QoS{1}.transient_local());
 
-  autoware_auto_mapping_msgs::msg::HADMapBin map_bin_msg;
   map_bin_msg.header.stamp = this->now();
   map_bin_msg.header.frame_id = "map";
-  map_bin_msg.format_version = format_version;
-  map_bin_msg.map_version = map_version;
-  lanelet::utils::conversion::toBinMsg(map, &map_bin_msg);
-
   pub_map_bin_->publish(map_bin_msg);
 }
 
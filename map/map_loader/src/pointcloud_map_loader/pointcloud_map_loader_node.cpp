@@ -30,11 +30,15 @@
 
 #include "map_loader/pointcloud_map_loader_node.hpp"
 
+#include "map_loader/pointcloud_map_tile_server.hpp"
+#include "map_loader/pointcloud_map_tiles.hpp"
+
 #include <glob.h>
 #include <pcl/io/pcd_io.h>
 #include <pcl_conversions/pcl_conversions.h>
 
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -68,8 +72,16 @@ PointCloudMapLoaderNode::PointCloudMapLoaderNode(const rclcpp::NodeOptions & opt
 
   const auto pcd_paths_or_directory =
     declare_parameter("pcd_paths_or_directory", std::vector<std::string>({}));
+  enable_whole_load_ = declare_parameter("enable_whole_load", true);
+  const bool enable_partial_load = declare_parameter("enable_partial_load", false);
+  const bool enable_differential_load = declare_parameter("enable_differential_load", false);
+  if (enable_partial_load || enable_differential_load) {
+    tile_server_ = std::make_unique<PointCloudMapTileServer>(
+      this, enable_partial_load, enable_differential_load);
+  }
 
   std::vector<std::string> pcd_paths{};
+  std::vector<std::string> tiles_paths{};
 
   for (const auto & p : pcd_paths_or_directory) {
     if (!fs::exists(p)) {
@@ -80,6 +92,10 @@ PointCloudMapLoaderNode::PointCloudMapLoaderNode(const rclcpp::NodeOptions & opt
       pcd_paths.push_back(p);
     }
 
+    if (PointCloudMapTiles::isTilesFile(p)) {
+      tiles_paths.push_back(p);
+    }
+
     if (fs::is_directory(p)) {
       for (const auto & file : fs::directory_iterator(p)) {
         const auto filename = file.path().string();
@@ -90,10 +106,20 @@ PointCloudMapLoaderNode::PointCloudMapLoaderNode(const rclcpp::NodeOptions & opt
     }
   }
 
-  const auto pcd = loadPCDFiles(pcd_paths);
+  auto pcd = loadPCDFiles(pcd_paths);
+  loadTilesFiles(tiles_paths, pcd);
+
+  if (tile_server_) {
+    RCLCPP_INFO(get_logger(), "Serving %zu map tiles", tile_server_->tileNum());
+  }
+  if (!enable_whole_load_) {
+    return;
+  }
 
   if (pcd.width == 0) {
-    RCLCPP_ERROR(get_logger(), "No PCD was loaded: pcd_paths.size() = %zu", pcd_paths.size());
+    RCLCPP_ERROR(
+      get_logger(), "No PCD was loaded: pcd_paths.size() = %zu, tiles_paths.size() = %zu",
+      pcd_paths.size(), tiles_paths.size());
     return;
   }
 
@@ -109,6 +135,13 @@ sensor_msgs::msg::PointCloud2 PointCloudMapLoaderNode::loadPCDFiles(
   for (const auto & path : pcd_paths) {
     if (pcl::io::loadPCDFile(path, partial_pcd) == -1) {
       RCLCPP_ERROR_STREAM(get_logger(), "PCD load failed: " << path);
+    } else if (tile_server_) {
+      // only the extent of the tile is kept, its points are read again on request
+      tile_server_->addPcdTile(path, partial_pcd);
+    }
+
+    if (!enable_whole_load_) {
+      continue;
     }
 
     if (whole_pcd.width == 0) {
@@ -126,5 +159,39 @@ sensor_msgs::msg::PointCloud2 PointCloudMapLoaderNode::loadPCDFiles(
   return whole_pcd;
 }
 
+void PointCloudMapLoaderNode::loadTilesFiles(
+  const std::vector<std::string> & tiles_paths, sensor_msgs::msg::PointCloud2 & whole_pcd)
+{
+  sensor_msgs::msg::PointCloud2 partial_pcd;
+  for (const auto & path : tiles_paths) {
+    auto tiles = std::make_shared<PointCloudMapTiles>();
+    if (!tiles->load(path)) {
+      RCLCPP_ERROR_STREAM(get_logger(), "Map tiles load failed: " << path);
+      continue;
+    }
+
+    // the tile server keeps the file mapped
+    if (tile_server_) {
+      tile_server_->addTilesFile(path, tiles);
+    }
+
+    if (!enable_whole_load_) {
+      continue;
+    }
+
+    if (whole_pcd.width == 0) {
+      tiles->getMap(whole_pcd);
+    } else {
+      tiles->getMap(partial_pcd);
+      whole_pcd.width += partial_pcd.width;
+      whole_pcd.row_step += partial_pcd.row_step;
+      whole_pcd.data.reserve(whole_pcd.data.size() + partial_pcd.data.size());
+      whole_pcd.data.insert(whole_pcd.data.end(), partial_pcd.data.begin(), partial_pcd.data.end());
+    }
+  }
+
+  whole_pcd.header.frame_id = "map";
+}
+
 #include <rclcpp_components/register_node_macro.hpp>
 RCLCPP_COMPONENTS_REGISTER_NODE(PointCloudMapLoaderNode)
@@ -0,0 +1,157 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "map_loader/pointcloud_map_tile_server.hpp"
+
+#include <pcl/io/pcd_io.h>
+#include <pcl_conversions/pcl_conversions.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+using std::placeholders::_1;
+using std::placeholders::_2;
+
+PointCloudMapTileServer::PointCloudMapTileServer(
+  rclcpp::Node * node, const bool enable_partial_load, const bool enable_differential_load)
+: logger_(node->get_logger()), clock_(node->get_clock())
+{
+  if (enable_partial_load) {
+    srv_partial_ = node->create_service<GetPartialPointCloudMap>(
+      "service/get_partial_pcd_map",
+      std::bind(&PointCloudMapTileServer::onGetPartialPointCloudMap, this, _1, _2));
+  }
+  if (enable_differential_load) {
+    srv_differential_ = node->create_service<GetDifferentialPointCloudMap>(
+      "service/get_differential_pcd_map",
+      std::bind(&PointCloudMapTileServer::onGetDifferentialPointCloudMap, this, _1, _2));
+  }
+}
+
+void PointCloudMapTileServer::addPcdTile(
+  const std::string & path, const sensor_msgs::msg::PointCloud2 & pcd)
+{
+  if (pcd.width * pcd.height == 0U) {
+    return;
+  }
+  Tile tile{};
+  tile.id = path;
+  tile.min_x = std::numeric_limits<float>::max();
+  tile.min_y = std::numeric_limits<float>::max();
+  tile.max_x = std::numeric_limits<float>::lowest();
+  tile.max_y = std::numeric_limits<float>::lowest();
+  tile.pcd_path = path;
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(pcd, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(pcd, "y");
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y) {
+    if (std::isfinite(*iter_x) && std::isfinite(*iter_y)) {
+      tile.min_x = std::min(tile.min_x, *iter_x);
+      tile.min_y = std::min(tile.min_y, *iter_y);
+      tile.max_x = std::max(tile.max_x, *iter_x);
+      tile.max_y = std::max(tile.max_y, *iter_y);
+    }
+  }
+  tiles_.push_back(tile);
+}
+
+void PointCloudMapTileServer::addTilesFile(
+  const std::string & path, std::shared_ptr<const PointCloudMapTiles> tiles)
+{
+  for (std::size_t i = 0; i < tiles->tileNum(); ++i) {
+    const auto & t = tiles->tile(i);
+    tiles_.push_back(
+      Tile{path + "/" + std::to_string(i), t.min_x, t.min_y, t.max_x, t.max_y, "", tiles, i});
+  }
+}
+
+bool PointCloudMapTileServer::isInArea(
+  const Tile & tile, const autoware_map_msgs::msg::AreaInfo & area)
+{
+  const double dx = std::max({0.0f, tile.min_x - area.center_x, area.center_x - tile.max_x});
+  const double dy = std::max({0.0f, tile.min_y - area.center_y, area.center_y - tile.max_y});
+  return std::hypot(dx, dy) <= area.radius;
+}
+
+bool PointCloudMapTileServer::loadTile(
+  const Tile & tile, autoware_map_msgs::msg::PointCloudMapCellWithID & cell) const
+{
+  if (tile.tiles) {
+    tile.tiles->getTile(tile.tile_index, cell.pointcloud);
+  } else if (pcl::io::loadPCDFile(tile.pcd_path, cell.pointcloud) == -1) {
+    RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << tile.pcd_path);
+    return false;
+  }
+  cell.pointcloud.header.frame_id = "map";
+  cell.cell_id = tile.id;
+  cell.min_x = tile.min_x;
+  cell.min_y = tile.min_y;
+  cell.max_x = tile.max_x;
+  cell.max_y = tile.max_y;
+  return true;
+}
+
+void PointCloudMapTileServer::onGetPartialPointCloudMap(
+  const GetPartialPointCloudMap::Request::SharedPtr req,
+  GetPartialPointCloudMap::Response::SharedPtr res) const
+{
+  for (const auto & tile : tiles_) {
+    if (!isInArea(tile, req->area)) {
+      continue;
+    }
+    autoware_map_msgs::msg::PointCloudMapCellWithID cell;
+    if (loadTile(tile, cell)) {
+      res->new_pointcloud_with_ids.push_back(std::move(cell));
+    }
+  }
+  res->header.frame_id = "map";
+  res->header.stamp = clock_->now();
+  RCLCPP_INFO(
+    logger_, "Sent %zu of %zu map tiles", res->new_pointcloud_with_ids.size(), tiles_.size());
+}
+
+void PointCloudMapTileServer::onGetDifferentialPointCloudMap(
+  const GetDifferentialPointCloudMap::Request::SharedPtr req,
+  GetDifferentialPointCloudMap::Response::SharedPtr res) const
+{
+  std::unordered_set<std::string> cached_ids(req->cached_ids.begin(), req->cached_ids.end());
+  std::unordered_set<std::string> kept_ids;
+  for (const auto & tile : tiles_) {
+    if (!isInArea(tile, req->area)) {
+      continue;
+    }
+    if (cached_ids.count(tile.id) != 0U) {
+      kept_ids.insert(tile.id);
+      continue;
+    }
+    autoware_map_msgs::msg::PointCloudMapCellWithID cell;
+    if (loadTile(tile, cell)) {
+      res->new_pointcloud_with_ids.push_back(std::move(cell));
+    }
+  }
+  for (const auto & id : req->cached_ids) {
+    if (kept_ids.count(id) == 0U) {
+      res->ids_to_remove.push_back(id);
+    }
+  }
+  res->header.frame_id = "map";
+  res->header.stamp = clock_->now();
+  RCLCPP_INFO(
+    logger_, "Sent %zu new map tiles, %zu to remove, %zu kept", res->new_pointcloud_with_ids.size(),
+    res->ids_to_remove.size(), kept_ids.size());
+}
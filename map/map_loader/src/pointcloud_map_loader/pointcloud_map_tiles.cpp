@@ -0,0 +1,282 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "map_loader/pointcloud_map_tiles.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace
+{
+constexpr uint64_t page_size = 4096U;
+
+uint64_t getDataOffset(const uint64_t field_num, const uint64_t tile_num)
+{
+  const uint64_t index_size = sizeof(PointCloudMapTilesHeader) +
+                              field_num * sizeof(PointCloudMapTilesField) +
+                              tile_num * sizeof(PointCloudMapTile);
+  return (index_size + page_size - 1U) / page_size * page_size;
+}
+
+const sensor_msgs::msg::PointField * findField(
+  const std::vector<sensor_msgs::msg::PointField> & fields, const std::string & name)
+{
+  const auto it = std::find_if(fields.begin(), fields.end(), [&name](const auto & field) {
+    return field.name == name;
+  });
+  return it == fields.end() ? nullptr : &*it;
+}
+
+bool isFloatField(const sensor_msgs::msg::PointField * field)
+{
+  return field != nullptr && field->datatype == sensor_msgs::msg::PointField::FLOAT32 &&
+         field->count == 1U;
+}
+
+bool hasSameLayout(
+  const sensor_msgs::msg::PointCloud2 & cloud,
+  const std::vector<sensor_msgs::msg::PointField> & fields, const uint32_t point_step)
+{
+  if (cloud.point_step != point_step || cloud.fields.size() != fields.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < fields.size(); ++i) {
+    const auto & a = cloud.fields[i];
+    const auto & b = fields[i];
+    if (
+      a.name != b.name || a.offset != b.offset || a.datatype != b.datatype || a.count != b.count) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+PointCloudMapTiles::~PointCloudMapTiles() { unmap(); }
+
+bool PointCloudMapTiles::isTilesFile(const std::string & path)
+{
+  if (std::filesystem::is_directory(path)) {
+    return false;
+  }
+  return std::filesystem::path(path).extension() == ".pcdtiles";
+}
+
+void PointCloudMapTiles::unmap()
+{
+  if (mapped_) {
+    munmap(mapped_, mapped_size_);
+    mapped_ = nullptr;
+    mapped_size_ = 0U;
+  }
+  tiles_ = nullptr;
+  points_ = nullptr;
+}
+
+void PointCloudMapTiles::clear()
+{
+  unmap();
+  header_ = PointCloudMapTilesHeader{};
+  fields_.clear();
+  owned_tiles_.clear();
+  owned_points_.clear();
+}
+
+void PointCloudMapTiles::initialize(const std::string & frame_id)
+{
+  clear();
+  header_.magic = magic;
+  header_.version = version;
+  std::strncpy(header_.frame_id, frame_id.c_str(), sizeof(header_.frame_id) - 1);
+}
+
+bool PointCloudMapTiles::addTile(const sensor_msgs::msg::PointCloud2 & cloud)
+{
+  if (empty()) {
+    if (
+      cloud.point_step == 0U || cloud.is_bigendian || !isFloatField(findField(cloud.fields, "x")) ||
+      !isFloatField(findField(cloud.fields, "y"))) {
+      return false;
+    }
+    fields_ = cloud.fields;
+    header_.point_step = cloud.point_step;
+    header_.field_num = static_cast<uint32_t>(fields_.size());
+  } else if (!hasSameLayout(cloud, fields_, header_.point_step)) {
+    return false;
+  }
+
+  const uint32_t point_step = header_.point_step;
+  const uint64_t point_num = static_cast<uint64_t>(cloud.width) * cloud.height;
+  const uint32_t x_offset = findField(fields_, "x")->offset;
+  const uint32_t y_offset = findField(fields_, "y")->offset;
+
+  PointCloudMapTile tile{};
+  tile.min_x = std::numeric_limits<float>::max();
+  tile.min_y = std::numeric_limits<float>::max();
+  tile.max_x = std::numeric_limits<float>::lowest();
+  tile.max_y = std::numeric_limits<float>::lowest();
+  tile.point_begin = header_.point_num;
+  tile.point_num = point_num;
+
+  // the rows of an organized cloud may be padded, so the points are copied one by one
+  owned_points_.reserve(owned_points_.size() + point_num * point_step);
+  for (uint32_t row = 0; row < cloud.height; ++row) {
+    for (uint32_t col = 0; col < cloud.width; ++col) {
+      const uint8_t * point = &cloud.data[row * cloud.row_step + col * point_step];
+      float x, y;
+      std::memcpy(&x, point + x_offset, sizeof(float));
+      std::memcpy(&y, point + y_offset, sizeof(float));
+      if (std::isfinite(x) && std::isfinite(y)) {
+        tile.min_x = std::min(tile.min_x, x);
+        tile.min_y = std::min(tile.min_y, y);
+        tile.max_x = std::max(tile.max_x, x);
+        tile.max_y = std::max(tile.max_y, y);
+      }
+      owned_points_.insert(owned_points_.end(), point, point + point_step);
+    }
+  }
+
+  owned_tiles_.push_back(tile);
+  header_.tile_num = owned_tiles_.size();
+  header_.point_num += point_num;
+  header_.data_offset = getDataOffset(header_.field_num, header_.tile_num);
+  tiles_ = owned_tiles_.data();
+  points_ = owned_points_.data();
+  return true;
+}
+
+bool PointCloudMapTiles::save(const std::string & path) const
+{
+  if (empty()) {
+    return false;
+  }
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+  ofs.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+  for (const auto & field : fields_) {
+    PointCloudMapTilesField entry{};
+    std::strncpy(entry.name, field.name.c_str(), sizeof(entry.name) - 1);
+    entry.offset = field.offset;
+    entry.count = field.count;
+    entry.datatype = field.datatype;
+    ofs.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+  }
+  ofs.write(
+    reinterpret_cast<const char *>(tiles_),
+    static_cast<std::streamsize>(header_.tile_num * sizeof(PointCloudMapTile)));
+
+  const uint64_t index_end = sizeof(header_) + header_.field_num * sizeof(PointCloudMapTilesField) +
+                             header_.tile_num * sizeof(PointCloudMapTile);
+  const std::vector<char> padding(header_.data_offset - index_end, 0);
+  ofs.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+  ofs.write(
+    reinterpret_cast<const char *>(points_),
+    static_cast<std::streamsize>(header_.point_num * header_.point_step));
+  return ofs.good();
+}
+
+bool PointCloudMapTiles::load(const std::string & path)
+{
+  clear();
+
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(header_)) {
+    close(fd);
+    return false;
+  }
+  const auto size = static_cast<std::size_t>(st.st_size);
+  void * ptr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    return false;
+  }
+
+  const auto * bytes = static_cast<const uint8_t *>(ptr);
+  const auto & header = *static_cast<const PointCloudMapTilesHeader *>(ptr);
+  const bool is_valid =
+    header.magic == magic && header.version == version && header.point_step != 0U &&
+    header.field_num < page_size && header.tile_num < size / sizeof(PointCloudMapTile) &&
+    header.data_offset == getDataOffset(header.field_num, header.tile_num) &&
+    header.point_num <= (size - std::min<uint64_t>(size, header.data_offset)) / header.point_step;
+  if (!is_valid) {
+    munmap(ptr, size);
+    return false;
+  }
+
+  const auto * fields = reinterpret_cast<const PointCloudMapTilesField *>(bytes + sizeof(header));
+  const auto * tiles = reinterpret_cast<const PointCloudMapTile *>(fields + header.field_num);
+  for (uint64_t i = 0; i < header.tile_num; ++i) {
+    if (tiles[i].point_begin + tiles[i].point_num > header.point_num) {
+      munmap(ptr, size);
+      return false;
+    }
+  }
+
+  header_ = header;
+  header_.frame_id[sizeof(header_.frame_id) - 1] = '\0';
+  for (uint32_t i = 0; i < header.field_num; ++i) {
+    sensor_msgs::msg::PointField field;
+    field.name = std::string(fields[i].name, strnlen(fields[i].name, sizeof(fields[i].name)));
+    field.offset = fields[i].offset;
+    field.count = fields[i].count;
+    field.datatype = fields[i].datatype;
+    fields_.push_back(field);
+  }
+  mapped_ = ptr;
+  mapped_size_ = size;
+  tiles_ = tiles;
+  points_ = bytes + header.data_offset;
+  return true;
+}
+
+void PointCloudMapTiles::getPoints(
+  const uint64_t point_begin, const uint64_t point_num, sensor_msgs::msg::PointCloud2 & cloud) const
+{
+  cloud.header.frame_id = header_.frame_id;
+  cloud.height = 1U;
+  cloud.width = static_cast<uint32_t>(point_num);
+  cloud.fields = fields_;
+  cloud.is_bigendian = false;
+  cloud.point_step = header_.point_step;
+  cloud.row_step = static_cast<uint32_t>(point_num * header_.point_step);
+  cloud.is_dense = false;
+  const uint8_t * begin = points_ + point_begin * header_.point_step;
+  cloud.data.assign(begin, begin + point_num * header_.point_step);
+}
+
+void PointCloudMapTiles::getTile(const std::size_t i, sensor_msgs::msg::PointCloud2 & cloud) const
+{
+  getPoints(tiles_[i].point_begin, tiles_[i].point_num, cloud);
+}
+
+void PointCloudMapTiles::getMap(sensor_msgs::msg::PointCloud2 & cloud) const
+{
+  if (mapped_) {
+    // the whole map is read once, front to back
+    madvise(mapped_, mapped_size_, MADV_SEQUENTIAL);
+  }
+  getPoints(0U, header_.point_num, cloud);
+}
@@ -0,0 +1,100 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "map_loader/pointcloud_map_tiles.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <pcl/io/pcd_io.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+bool isPcdFile(const std::string & p)
+{
+  if (fs::is_directory(p)) {
+    return false;
+  }
+  const std::string ext = fs::path(p).extension();
+  return ext == ".pcd" || ext == ".PCD";
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+
+  auto node = rclcpp::Node::make_shared("pointcloud_map_tiles_builder");
+
+  const auto pcd_paths_or_directory =
+    node->declare_parameter<std::vector<std::string>>("pcd_paths_or_directory");
+  const auto output_path = node->declare_parameter<std::string>("output_path");
+  const auto frame_id = node->declare_parameter<std::string>("frame_id", "map");
+
+  std::vector<std::string> pcd_paths{};
+  for (const auto & p : pcd_paths_or_directory) {
+    if (isPcdFile(p)) {
+      pcd_paths.push_back(p);
+    } else if (fs::is_directory(p)) {
+      std::vector<std::string> directory_paths{};
+      for (const auto & file : fs::directory_iterator(p)) {
+        if (isPcdFile(file.path().string())) {
+          directory_paths.push_back(file.path().string());
+        }
+      }
+      // the order of a directory listing is unspecified, the tiles are sorted by name instead
+      std::sort(directory_paths.begin(), directory_paths.end());
+      pcd_paths.insert(pcd_paths.end(), directory_paths.begin(), directory_paths.end());
+    } else {
+      RCLCPP_ERROR_STREAM(node->get_logger(), "invalid path: " << p);
+    }
+  }
+
+  // every pcd file becomes one tile
+  PointCloudMapTiles tiles;
+  tiles.initialize(frame_id);
+  sensor_msgs::msg::PointCloud2 partial_pcd;
+  for (const auto & path : pcd_paths) {
+    if (pcl::io::loadPCDFile(path, partial_pcd) == -1) {
+      RCLCPP_ERROR_STREAM(node->get_logger(), "PCD load failed: " << path);
+      continue;
+    }
+    if (!tiles.addTile(partial_pcd)) {
+      RCLCPP_ERROR_STREAM(
+        node->get_logger(), "PCD fields differ from the first tile or lack float x, y: " << path);
+      continue;
+    }
+    std::cout << "Loaded " << partial_pcd.width * partial_pcd.height << " points from " << path
+              << std::endl;
+  }
+
+  if (!tiles.save(output_path)) {
+    RCLCPP_ERROR_STREAM(node->get_logger(), "Couldn't write file: " << output_path);
+    return EXIT_FAILURE;
+  }
+  std::cout << "Saved " << tiles.tileNum() << " tiles of " << tiles.pointNum() << " points to "
+            << output_path << std::endl;
+
+  rclcpp::shutdown();
+
+  return 0;
+}
@@ -17,22 +17,20 @@
 #include <rclcpp/rclcpp.hpp>
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 
-#include <pcl/point_cloud.h>
-#include <pcl/point_types.h>
-#include <pcl_conversions/pcl_conversions.h>
 #include <tf2/LinearMath/Quaternion.h>
 #include <tf2_ros/static_transform_broadcaster.h>
 
 #include <memory>
 #include <string>
+#include <vector>
 
 constexpr size_t N_SAMPLES = 20;
 
 class PcdMapTFGeneratorNode : public rclcpp::Node
 {
 public:
-  using PointCloud = pcl::PointCloud<pcl::PointXYZ>;
   explicit PcdMapTFGeneratorNode(const rclcpp::NodeOptions & options)
   : Node("pcd_map_tf_generator", options)
   {
@@ -59,15 +57,23 @@ private:
     // 3939 is just the author's favorite number
     srand(3939);
 
-    PointCloud clouds;
-    pcl::fromROSMsg<pcl::PointXYZ>(*clouds_ros, clouds);
+    const size_t point_num = static_cast<size_t>(clouds_ros->width) * clouds_ros->height;
+    if (point_num == 0) {
+      RCLCPP_WARN(get_logger(), "pointcloud map is empty, viewer frame is not broadcast");
+      return;
+    }
 
-    const std::vector<size_t> indices = UniformRandom(clouds.size(), N_SAMPLES);
+    // only the sampled points are read, the map is not converted
+    sensor_msgs::PointCloud2ConstIterator<float> iter_x(*clouds_ros, "x");
+    sensor_msgs::PointCloud2ConstIterator<float> iter_y(*clouds_ros, "y");
+    sensor_msgs::PointCloud2ConstIterator<float> iter_z(*clouds_ros, "z");
+    const std::vector<size_t> indices = UniformRandom(point_num, N_SAMPLES);
     double coordinate[3] = {0, 0, 0};
     for (const auto i : indices) {
-      coordinate[0] += clouds.points[i].x;
-      coordinate[1] += clouds.points[i].y;
-      coordinate[2] += clouds.points[i].z;
+      const int offset = static_cast<int>(i);
+      coordinate[0] += *(iter_x + offset);
+      coordinate[1] += *(iter_y + offset);
+      coordinate[2] += *(iter_z + offset);
     }
     coordinate[0] = coordinate[0] / indices.size();
     coordinate[1] = coordinate[1] / indices.size();
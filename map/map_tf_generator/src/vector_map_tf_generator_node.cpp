@@ -47,30 +47,25 @@ private:
   rclcpp::Subscription<autoware_auto_mapping_msgs::msg::HADMapBin>::SharedPtr sub_;
 
   std::shared_ptr<tf2_ros::StaticTransformBroadcaster> static_broadcaster_;
-  std::shared_ptr<lanelet::LaneletMap> lanelet_map_ptr_;
 
   void onVectorMap(const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg)
   {
-    lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
-    lanelet::utils::conversion::fromBinMsg(*msg, lanelet_map_ptr_);
-    std::vector<double> points_x;
-    std::vector<double> points_y;
-    std::vector<double> points_z;
+    // the map is only needed here, it is released once the viewer frame is computed
+    auto lanelet_map_ptr = std::make_shared<lanelet::LaneletMap>();
+    lanelet::utils::conversion::fromBinMsg(*msg, lanelet_map_ptr);
 
-    for (const lanelet::Point3d & point : lanelet_map_ptr_->pointLayer) {
-      const double point_x = point.x();
-      const double point_y = point.y();
-      const double point_z = point.z();
-      points_x.push_back(point_x);
-      points_y.push_back(point_y);
-      points_z.push_back(point_z);
+    double sum_x = 0.0;
+    double sum_y = 0.0;
+    double sum_z = 0.0;
+    for (const lanelet::Point3d & point : lanelet_map_ptr->pointLayer) {
+      sum_x += point.x();
+      sum_y += point.y();
+      sum_z += point.z();
     }
-    const double coordinate_x =
-      std::accumulate(points_x.begin(), points_x.end(), 0.0) / points_x.size();
-    const double coordinate_y =
-      std::accumulate(points_y.begin(), points_y.end(), 0.0) / points_y.size();
-    const double coordinate_z =
-      std::accumulate(points_z.begin(), points_z.end(), 0.0) / points_z.size();
+    const double point_num = static_cast<double>(lanelet_map_ptr->pointLayer.size());
+    const double coordinate_x = sum_x / point_num;
+    const double coordinate_y = sum_y / point_num;
+    const double coordinate_z = sum_z / point_num;
 
     geometry_msgs::msg::TransformStamped static_transformStamped;
     static_transformStamped.header.stamp = this->now();
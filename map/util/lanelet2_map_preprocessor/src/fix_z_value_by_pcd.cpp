@@ -20,11 +20,16 @@
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_io/Io.h>
 #include <pcl/io/pcd_io.h>
-#include <pcl/kdtree/kdtree_flann.h>
 #include <pcl/point_types.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <limits>
+#include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 bool loadLaneletMap(
@@ -56,86 +61,125 @@ bool loadPCDMap(const std::string & pcd_map_path, pcl::PointCloud<pcl::PointXYZ>
   return true;
 }
 
-double getMinHeightAroundPoint(
-  const pcl::PointCloud<pcl::PointXYZ>::Ptr & pcd_map_ptr,
-  const pcl::KdTreeFLANN<pcl::PointXYZ> & kdtree, const pcl::PointXYZ & search_pt,
-  const double search_radius3d, const double search_radius2d)
+/**
+ * \brief Points of the pcd map in a 2D grid of cells of search_radius2d, sorted by cell, so that a
+ * lanelet point is only compared to the points of the 3x3 cells around it.
+ */
+class PointGrid
 {
-  std::vector<int> pointIdxRadiusSearch;
-  std::vector<float> pointRadiusSquaredDistance;
-  if (
-    kdtree.radiusSearch(
-      search_pt, search_radius3d, pointIdxRadiusSearch, pointRadiusSquaredDistance) <= 0) {
-    std::cout << "no points found within 3d radius " << search_radius3d << std::endl;
-    return search_pt.z;
-  }
-
-  double min_height = std::numeric_limits<double>::max();
-  bool found = false;
+public:
+  PointGrid(const pcl::PointCloud<pcl::PointXYZ> & cloud, const double cell_size)
+  : cell_size_(cell_size)
+  {
+    std::vector<std::pair<int64_t, std::size_t>> key_indices;
+    key_indices.reserve(cloud.size());
+    for (std::size_t i = 0; i < cloud.size(); ++i) {
+      key_indices.emplace_back(getKey(cloud.points[i].x, cloud.points[i].y), i);
+    }
+    std::sort(key_indices.begin(), key_indices.end());
 
-  for (std::size_t i = 0; i < pointIdxRadiusSearch.size(); i++) {
-    std::size_t pt_idx = pointIdxRadiusSearch.at(i);
-    const auto pt = pcd_map_ptr->points.at(pt_idx);
-    if (pt.z > min_height) {
-      continue;
+    keys_.reserve(key_indices.size());
+    points_.reserve(key_indices.size());
+    for (const auto & key_index : key_indices) {
+      keys_.push_back(key_index.first);
+      points_.push_back(cloud.points[key_index.second]);
     }
-    double distance2d = std::hypot(pt.x - search_pt.x, pt.y - search_pt.y);
-    if (distance2d < search_radius2d) {
-      found = true;
-      min_height = pt.z;
+  }
+
+  // lowest z of the points within search_radius2d in 2D and search_radius3d in 3D of search_pt
+  bool getMinHeight(
+    const pcl::PointXYZ & search_pt, const double search_radius3d, const double search_radius2d,
+    double & min_height) const
+  {
+    const int64_t x = cellIndex(search_pt.x);
+    const int64_t y = cellIndex(search_pt.y);
+    bool found = false;
+    min_height = std::numeric_limits<double>::max();
+    for (int64_t ix = x - 1; ix <= x + 1; ++ix) {
+      for (int64_t iy = y - 1; iy <= y + 1; ++iy) {
+        const auto range = std::equal_range(keys_.begin(), keys_.end(), toKey(ix, iy));
+        for (auto it = range.first; it != range.second; ++it) {
+          const auto & pt = points_[it - keys_.begin()];
+          const double dx = pt.x - search_pt.x;
+          const double dy = pt.y - search_pt.y;
+          const double dz = pt.z - search_pt.z;
+          if (
+            pt.z < min_height && std::hypot(dx, dy) < search_radius2d &&
+            dx * dx + dy * dy + dz * dz < search_radius3d * search_radius3d) {
+            found = true;
+            min_height = pt.z;
+          }
+        }
+      }
     }
+    return found;
   }
-  if (!found) {
-    min_height = search_pt.z;
+
+private:
+  int64_t cellIndex(const double v) const
+  {
+    return static_cast<int64_t>(std::floor(v / cell_size_));
+  }
+  static int64_t toKey(const int64_t ix, const int64_t iy)
+  {
+    return ix * (int64_t{1} << 32) + (iy & 0xffffffff);
+  }
+  int64_t getKey(const double x, const double y) const
+  {
+    return toKey(cellIndex(x), cellIndex(y));
   }
-  return min_height;
-}
 
-bool exists(std::unordered_set<lanelet::Id> & set, lanelet::Id element)
-{
-  return std::find(set.begin(), set.end(), element) != set.end();
-}
+  double cell_size_;
+  std::vector<int64_t> keys_;
+  std::vector<pcl::PointXYZ> points_;
+};
 
 void adjustHeight(
-  const pcl::PointCloud<pcl::PointXYZ>::Ptr & pcd_map_ptr, lanelet::LaneletMapPtr & lanelet_map_ptr)
+  const pcl::PointCloud<pcl::PointXYZ>::Ptr & pcd_map_ptr, lanelet::LaneletMapPtr & lanelet_map_ptr,
+  const int num_threads)
 {
-  std::unordered_set<lanelet::Id> done;
   double search_radius2d = 0.5;
   double search_radius3d = 10;
 
-  pcl::KdTreeFLANN<pcl::PointXYZ> kdtree;
-  kdtree.setInputCloud(pcd_map_ptr);
-
+  // the bound points of all the lanelets, each once
+  std::unordered_set<lanelet::Id> done;
+  std::vector<lanelet::Point3d> points;
   for (lanelet::Lanelet & llt : lanelet_map_ptr->laneletLayer) {
     for (lanelet::Point3d & pt : llt.leftBound()) {
-      if (exists(done, pt.id())) {
-        continue;
+      if (done.insert(pt.id()).second) {
+        points.push_back(pt);
       }
-      pcl::PointXYZ pcl_pt;
-      pcl_pt.x = pt.x();
-      pcl_pt.y = pt.y();
-      pcl_pt.z = pt.z();
-      double min_height =
-        getMinHeightAroundPoint(pcd_map_ptr, kdtree, pcl_pt, search_radius3d, search_radius2d);
-      std::cout << "moving from " << pt.z() << " to " << min_height << std::endl;
-      pt.z() = min_height;
-      done.insert(pt.id());
     }
     for (lanelet::Point3d & pt : llt.rightBound()) {
-      if (exists(done, pt.id())) {
-        continue;
+      if (done.insert(pt.id()).second) {
+        points.push_back(pt);
       }
-      pcl::PointXYZ pcl_pt;
-      pcl_pt.x = pt.x();
-      pcl_pt.y = pt.y();
-      pcl_pt.z = pt.z();
-      double min_height =
-        getMinHeightAroundPoint(pcd_map_ptr, kdtree, pcl_pt, search_radius3d, search_radius2d);
-      std::cout << "moving from " << pt.z() << " to " << min_height << std::endl;
-      pt.z() = min_height;
-      done.insert(pt.id());
     }
   }
+
+  const PointGrid grid(*pcd_map_ptr, search_radius2d);
+  std::vector<double> min_heights(points.size());
+  std::vector<char> found(points.size());
+
+  // the heights only depend on the pcd map, they are computed in parallel and applied after
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 256)
+  for (int i = 0; i < static_cast<int>(points.size()); ++i) {
+    pcl::PointXYZ pcl_pt;
+    pcl_pt.x = points[i].x();
+    pcl_pt.y = points[i].y();
+    pcl_pt.z = points[i].z();
+    found[i] = grid.getMinHeight(pcl_pt, search_radius3d, search_radius2d, min_heights[i]);
+  }
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    auto & pt = points[i];
+    if (!found[i]) {
+      std::cout << "no points found within 2d radius " << search_radius2d << std::endl;
+      min_heights[i] = pt.z();
+    }
+    std::cout << "moving from " << pt.z() << " to " << min_heights[i] << std::endl;
+    pt.z() = min_heights[i];
+  }
 }
 
 int main(int argc, char * argv[])
@@ -147,6 +191,7 @@ int main(int argc, char * argv[])
   const auto llt_map_path = node->declare_parameter<std::string>("llt_map_path");
   const auto pcd_map_path = node->declare_parameter<std::string>("pcd_map_path");
   const auto llt_output_path = node->declare_parameter<std::string>("llt_output_path");
+  const auto num_threads = node->declare_parameter<int>("num_threads", 1);
 
   lanelet::LaneletMapPtr llt_map_ptr(new lanelet::LaneletMap);
   lanelet::projection::MGRSProjector projector;
@@ -160,7 +205,7 @@ int main(int argc, char * argv[])
     return EXIT_FAILURE;
   }
 
-  adjustHeight(pcd_map_ptr, llt_map_ptr);
+  adjustHeight(pcd_map_ptr, llt_map_ptr, num_threads);
   lanelet::write(llt_output_path, *llt_map_ptr, projector);
 
   rclcpp::shutdown();
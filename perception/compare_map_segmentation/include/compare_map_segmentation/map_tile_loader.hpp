@@ -0,0 +1,106 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMPARE_MAP_SEGMENTATION__MAP_TILE_LOADER_HPP_
+#define COMPARE_MAP_SEGMENTATION__MAP_TILE_LOADER_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <nav_msgs/msg/odometry.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace compare_map_segmentation
+{
+/**
+ * \brief Keeps the pointcloud map tiles around the ego position loaded. The tiles are pcd files,
+ * loaded and evicted on a background thread which hands every new window of the map to the
+ * callback, so that the filters never hold more than the surroundings of the vehicle.
+ */
+class MapTileLoader
+{
+public:
+  using PointCloudConstPtr = pcl::PointCloud<pcl::PointXYZ>::ConstPtr;
+  using MapCallback = std::function<void(const PointCloudConstPtr &)>;
+
+  /**
+   * \param pcd_paths_or_directory pcd files, or directories of pcd files, as for
+   *     pointcloud_map_loader
+   * \param load_radius tiles closer than this to the ego position in xy are loaded [m]
+   * \param update_distance the window is only updated after the ego moved this much [m]
+   * \param frame_id frame_id of the map
+   * \param callback called on the background thread with the points of the loaded tiles
+   */
+  MapTileLoader(
+    const std::vector<std::string> & pcd_paths_or_directory, const double load_radius,
+    const double update_distance, const std::string & frame_id, const rclcpp::Logger & logger,
+    MapCallback callback);
+  ~MapTileLoader();
+  MapTileLoader(const MapTileLoader &) = delete;
+  MapTileLoader & operator=(const MapTileLoader &) = delete;
+
+  /**
+   * \brief Declare the dynamic map loading parameters of the node. If use_dynamic_map_loading is
+   * set, returns a loader following the kinematic_state topic, and nullptr otherwise.
+   */
+  static std::unique_ptr<MapTileLoader> create(rclcpp::Node * node, MapCallback callback);
+
+  /** \brief Set the ego position in the map frame, does not block. */
+  void updatePosition(const double x, const double y);
+
+private:
+  struct Tile
+  {
+    std::string path;
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+    PointCloudConstPtr points;  // nullptr while not loaded
+  };
+
+  void run();
+  void indexTiles();
+  bool updateTiles(const double x, const double y);
+  PointCloudConstPtr loadTile(const std::string & path) const;
+
+  std::vector<std::string> pcd_paths_;
+  const double load_radius_;
+  const double update_distance_;
+  const std::string frame_id_;
+  const rclcpp::Logger logger_;
+  const MapCallback callback_;
+  std::vector<Tile> tiles_;  // only accessed by the background thread
+  rclcpp::Subscription<nav_msgs::msg::Odometry>::SharedPtr sub_kinematic_state_;
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool has_position_{false};
+  bool stop_{false};
+  double x_{0.0};
+  double y_{0.0};
+  std::thread thread_;
+};
+}  // namespace compare_map_segmentation
+
+#endif  // COMPARE_MAP_SEGMENTATION__MAP_TILE_LOADER_HPP_
@@ -15,11 +15,14 @@
 #ifndef COMPARE_MAP_SEGMENTATION__VOXEL_DISTANCE_BASED_COMPARE_MAP_FILTER_NODELET_HPP_  // NOLINT
 #define COMPARE_MAP_SEGMENTATION__VOXEL_DISTANCE_BASED_COMPARE_MAP_FILTER_NODELET_HPP_  // NOLINT
 
+#include "compare_map_segmentation/voxel_occupancy_map.hpp"
+#include "compare_map_segmentation/map_tile_loader.hpp"
 #include "pointcloud_preprocessor/filter.hpp"
 
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/search/pcl_search.h>
 
+#include <memory>
 #include <vector>
 
 namespace compare_map_segmentation
@@ -31,6 +34,7 @@ protected:
     const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output);
 
   void input_target_callback(const PointCloud2ConstPtr map);
+  void setMap(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & map_pcl_ptr);
 
 private:
   // pcl::SegmentDifferences<pcl::PointXYZ> impl_;
@@ -41,6 +45,11 @@ private:
   pcl::search::Search<pcl::PointXYZ>::Ptr tree_;
   pcl::VoxelGrid<pcl::PointXYZ> voxel_grid_;
   bool set_map_in_voxel_grid_;
+  /** \brief Prebuilt map loaded from voxel_occupancy_map_path, replaces the map topic if set */
+  std::unique_ptr<VoxelOccupancyMap> voxel_occupancy_map_;
+
+  /** \brief Keep the points which have no point of voxel_occupancy_map_ within the threshold */
+  void filterByVoxelOccupancyMap(const PointCloud2ConstPtr & input, PointCloud2 & output);
 
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
@@ -48,6 +57,10 @@ private:
   /** \brief Parameter service callback */
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
+  /** \brief Map tiles around the ego, replaces the map topic if set. Destroyed first, so that
+   * its thread is stopped before the map it updates */
+  std::unique_ptr<MapTileLoader> map_tile_loader_;
+
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
   explicit VoxelDistanceBasedCompareMapFilterComponent(const rclcpp::NodeOptions & options);
@@ -0,0 +1,96 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef COMPARE_MAP_SEGMENTATION__VOXEL_OCCUPANCY_MAP_HPP_
+#define COMPARE_MAP_SEGMENTATION__VOXEL_OCCUPANCY_MAP_HPP_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace compare_map_segmentation
+{
+struct VoxelOccupancyMapHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  double leaf_size;
+  uint64_t capacity;  // number of blocks of the hash table, a power of 2
+  uint64_t block_num;
+  char frame_id[64];
+};
+static_assert(sizeof(VoxelOccupancyMapHeader) == 96, "VoxelOccupancyMapHeader layout changed");
+
+/** \brief Occupancy of 8x8x8 voxels, bit (y * 8 + z) of bits[x] being voxel (x, y, z). */
+struct VoxelOccupancyBlock
+{
+  uint64_t key;
+  uint64_t bits[8];
+};
+static_assert(sizeof(VoxelOccupancyBlock) == 72, "VoxelOccupancyBlock layout changed");
+
+/**
+ * \brief Voxel occupancy of a pointcloud map as an open-addressing hash table of bitset blocks.
+ * The table is built once, saved to a file, and memory-mapped read-only by the filters, so that
+ * loading takes no time and every query is O(1) whatever the map size.
+ */
+class VoxelOccupancyMap
+{
+public:
+  static constexpr uint32_t magic = 0x4d434f56;  // "VOCM"
+  static constexpr uint32_t version = 1U;
+
+  VoxelOccupancyMap() = default;
+  ~VoxelOccupancyMap();
+  VoxelOccupancyMap(const VoxelOccupancyMap &) = delete;
+  VoxelOccupancyMap & operator=(const VoxelOccupancyMap &) = delete;
+
+  /** \brief Start building a new map, the map can be queried after finalize(). */
+  void initialize(const double leaf_size, const std::string & frame_id);
+  void addPoints(const pcl::PointCloud<pcl::PointXYZ> & points);
+  void finalize();
+
+  bool save(const std::string & path) const;
+  /** \brief Map a file written by save(). Returns false if it can not be read or is invalid. */
+  bool load(const std::string & path);
+
+  /** \brief Whether an occupied voxel may contain a point within distance of the given point. */
+  bool hasPointWithin(const pcl::PointXYZ & point, const double distance) const;
+  bool isOccupied(const int64_t x, const int64_t y, const int64_t z) const;
+
+  bool empty() const { return blocks_ == nullptr; }
+  double leafSize() const { return header_.leaf_size; }
+  std::string frameId() const { return header_.frame_id; }
+  std::size_t blockNum() const { return header_.block_num; }
+
+private:
+  void unmap();
+
+  VoxelOccupancyMapHeader header_{};
+  const VoxelOccupancyBlock * blocks_{nullptr};
+  void * mapped_{nullptr};
+  std::size_t mapped_size_{0U};
+
+  std::vector<VoxelOccupancyBlock> owned_blocks_;
+  std::unordered_map<uint64_t, std::array<uint64_t, 8>> building_blocks_;
+};
+}  // namespace compare_map_segmentation
+
+#endif  // COMPARE_MAP_SEGMENTATION__VOXEL_OCCUPANCY_MAP_HPP_
@@ -31,9 +31,13 @@ DistanceBasedCompareMapFilterComponent::DistanceBasedCompareMapFilterComponent(
   distance_threshold_ = static_cast<double>(declare_parameter("distance_threshold", 0.3));
 
   using std::placeholders::_1;
-  sub_map_ = this->create_subscription<PointCloud2>(
-    "map", rclcpp::QoS{1}.transient_local(),
-    std::bind(&DistanceBasedCompareMapFilterComponent::input_target_callback, this, _1));
+  map_tile_loader_ = MapTileLoader::create(
+    this, [this](const MapTileLoader::PointCloudConstPtr & map) { setMap(map); });
+  if (!map_tile_loader_) {
+    sub_map_ = this->create_subscription<PointCloud2>(
+      "map", rclcpp::QoS{1}.transient_local(),
+      std::bind(&DistanceBasedCompareMapFilterComponent::input_target_callback, this, _1));
+  }
 
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&DistanceBasedCompareMapFilterComponent::paramCallback, this, _1));
@@ -63,19 +67,25 @@ void DistanceBasedCompareMapFilterComponent::input_target_callback(const PointCl
 {
   pcl::PointCloud<pcl::PointXYZ> map_pcl;
   pcl::fromROSMsg<pcl::PointXYZ>(*map, map_pcl);
-  const auto map_pcl_ptr = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_pcl);
+  setMap(pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_pcl));
+}
+
+void DistanceBasedCompareMapFilterComponent::setMap(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & map_pcl_ptr)
+{
+  // the tree is built before locking, so that the filter keeps running on the previous map
+  pcl::search::Search<pcl::PointXYZ>::Ptr tree;
+  if (map_pcl_ptr->isOrganized()) {
+    tree.reset(new pcl::search::OrganizedNeighbor<pcl::PointXYZ>());
+  } else {
+    tree.reset(new pcl::search::KdTree<pcl::PointXYZ>(false));
+  }
+  tree->setInputCloud(map_pcl_ptr);
 
   std::scoped_lock lock(mutex_);
   map_ptr_ = map_pcl_ptr;
   tf_input_frame_ = map_ptr_->header.frame_id;
-  if (!tree_) {
-    if (map_ptr_->isOrganized()) {
-      tree_.reset(new pcl::search::OrganizedNeighbor<pcl::PointXYZ>());
-    } else {
-      tree_.reset(new pcl::search::KdTree<pcl::PointXYZ>(false));
-    }
-  }
-  tree_->setInputCloud(map_ptr_);
+  tree_ = tree;
 }
 
 rcl_interfaces::msg::SetParametersResult DistanceBasedCompareMapFilterComponent::paramCallback(
@@ -0,0 +1,216 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "compare_map_segmentation/map_tile_loader.hpp"
+
+#include <rclcpp/logging.hpp>
+
+#include <pcl/io/pcd_io.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+bool isPcdFile(const std::string & p)
+{
+  if (fs::is_directory(p)) {
+    return false;
+  }
+  const std::string ext = fs::path(p).extension();
+  return ext == ".pcd" || ext == ".PCD";
+}
+}  // namespace
+
+namespace compare_map_segmentation
+{
+MapTileLoader::MapTileLoader(
+  const std::vector<std::string> & pcd_paths_or_directory, const double load_radius,
+  const double update_distance, const std::string & frame_id, const rclcpp::Logger & logger,
+  MapCallback callback)
+: load_radius_(load_radius),
+  update_distance_(update_distance),
+  frame_id_(frame_id),
+  logger_(logger),
+  callback_(std::move(callback))
+{
+  for (const auto & p : pcd_paths_or_directory) {
+    if (isPcdFile(p)) {
+      pcd_paths_.push_back(p);
+    } else if (fs::is_directory(p)) {
+      for (const auto & file : fs::directory_iterator(p)) {
+        if (isPcdFile(file.path().string())) {
+          pcd_paths_.push_back(file.path().string());
+        }
+      }
+    } else {
+      RCLCPP_ERROR_STREAM(logger_, "invalid path: " << p);
+    }
+  }
+  thread_ = std::thread(&MapTileLoader::run, this);
+}
+
+std::unique_ptr<MapTileLoader> MapTileLoader::create(rclcpp::Node * node, MapCallback callback)
+{
+  if (!node->declare_parameter("use_dynamic_map_loading", false)) {
+    return nullptr;
+  }
+  const auto map_paths = node->declare_parameter("map_paths", std::vector<std::string>({}));
+  const double map_load_radius = node->declare_parameter("map_load_radius", 150.0);
+  const double map_update_distance = node->declare_parameter("map_update_distance", 10.0);
+
+  auto loader = std::make_unique<MapTileLoader>(
+    map_paths, map_load_radius, map_update_distance, "map", node->get_logger(),
+    std::move(callback));
+  auto * loader_ptr = loader.get();
+  loader->sub_kinematic_state_ = node->create_subscription<nav_msgs::msg::Odometry>(
+    "kinematic_state", rclcpp::QoS{1},
+    [loader_ptr](const nav_msgs::msg::Odometry::ConstSharedPtr msg) {
+      loader_ptr->updatePosition(msg->pose.pose.position.x, msg->pose.pose.position.y);
+    });
+  return loader;
+}
+
+MapTileLoader::~MapTileLoader()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_one();
+  thread_.join();
+}
+
+void MapTileLoader::updatePosition(const double x, const double y)
+{
+  {
+    std::scoped_lock lock(mutex_);
+    x_ = x;
+    y_ = y;
+    has_position_ = true;
+  }
+  condition_.notify_one();
+}
+
+void MapTileLoader::run()
+{
+  indexTiles();
+
+  bool is_first_update = true;
+  double last_x = 0.0;
+  double last_y = 0.0;
+  while (true) {
+    double x, y;
+    {
+      std::unique_lock lock(mutex_);
+      condition_.wait(lock, [this] { return stop_ || has_position_; });
+      if (stop_) {
+        return;
+      }
+      has_position_ = false;
+      x = x_;
+      y = y_;
+    }
+    if (!is_first_update && std::hypot(x - last_x, y - last_y) < update_distance_) {
+      continue;
+    }
+    is_first_update = false;
+    last_x = x;
+    last_y = y;
+    if (!updateTiles(x, y)) {
+      continue;
+    }
+
+    auto map = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
+    size_t point_num = 0;
+    for (const auto & tile : tiles_) {
+      point_num += tile.points ? tile.points->points.size() : 0U;
+    }
+    map->points.reserve(point_num);
+    for (const auto & tile : tiles_) {
+      if (tile.points) {
+        map->points.insert(
+          map->points.end(), tile.points->points.begin(), tile.points->points.end());
+      }
+    }
+    map->width = map->points.size();
+    map->height = 1;
+    map->header.frame_id = frame_id_;
+    callback_(map);
+  }
+}
+
+void MapTileLoader::indexTiles()
+{
+  // the extent of every tile is read once, only the tiles in range are kept afterwards
+  for (const auto & path : pcd_paths_) {
+    {
+      std::scoped_lock lock(mutex_);
+      if (stop_) {
+        return;
+      }
+    }
+    const auto points = loadTile(path);
+    if (!points || points->points.empty()) {
+      continue;
+    }
+    Tile tile{
+      path, std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+      std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), nullptr};
+    for (const auto & point : points->points) {
+      tile.min_x = std::min(tile.min_x, point.x);
+      tile.min_y = std::min(tile.min_y, point.y);
+      tile.max_x = std::max(tile.max_x, point.x);
+      tile.max_y = std::max(tile.max_y, point.y);
+    }
+    tiles_.push_back(tile);
+  }
+  RCLCPP_INFO(logger_, "Indexed %zu map tiles", tiles_.size());
+}
+
+bool MapTileLoader::updateTiles(const double x, const double y)
+{
+  bool is_updated = false;
+  for (auto & tile : tiles_) {
+    const double dx = std::max({0.0, tile.min_x - x, x - tile.max_x});
+    const double dy = std::max({0.0, tile.min_y - y, y - tile.max_y});
+    const bool is_in_range = std::hypot(dx, dy) <= load_radius_;
+    if (is_in_range && !tile.points) {
+      tile.points = loadTile(tile.path);
+      is_updated |= static_cast<bool>(tile.points);
+    } else if (!is_in_range && tile.points) {
+      tile.points.reset();
+      is_updated = true;
+    }
+  }
+  return is_updated;
+}
+
+MapTileLoader::PointCloudConstPtr MapTileLoader::loadTile(const std::string & path) const
+{
+  auto points = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
+  if (pcl::io::loadPCDFile<pcl::PointXYZ>(path, *points) == -1) {
+    RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
+    return nullptr;
+  }
+  return points;
+}
+}  // namespace compare_map_segmentation
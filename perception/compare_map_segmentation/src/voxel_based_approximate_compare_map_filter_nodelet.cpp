@@ -44,9 +44,13 @@ VoxelBasedApproximateCompareMapFilterComponent::VoxelBasedApproximateCompareMapF
   set_map_in_voxel_grid_ = false;
 
   using std::placeholders::_1;
-  sub_map_ = this->create_subscription<PointCloud2>(
-    "map", rclcpp::QoS{1}.transient_local(),
-    std::bind(&VoxelBasedApproximateCompareMapFilterComponent::input_target_callback, this, _1));
+  map_tile_loader_ = MapTileLoader::create(
+    this, [this](const MapTileLoader::PointCloudConstPtr & map) { setMap(map); });
+  if (!map_tile_loader_) {
+    sub_map_ = this->create_subscription<PointCloud2>(
+      "map", rclcpp::QoS{1}.transient_local(),
+      std::bind(&VoxelBasedApproximateCompareMapFilterComponent::input_target_callback, this, _1));
+  }
 
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&VoxelBasedApproximateCompareMapFilterComponent::paramCallback, this, _1));
@@ -81,11 +85,15 @@ void VoxelBasedApproximateCompareMapFilterComponent::filter(
 void VoxelBasedApproximateCompareMapFilterComponent::input_target_callback(
   const PointCloud2ConstPtr map)
 {
-  stop_watch_ptr_->toc("processing_time", true);
   pcl::PointCloud<pcl::PointXYZ> map_pcl;
   pcl::fromROSMsg<pcl::PointXYZ>(*map, map_pcl);
-  const auto map_pcl_ptr = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_pcl);
+  setMap(pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_pcl));
+}
 
+void VoxelBasedApproximateCompareMapFilterComponent::setMap(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & map_pcl_ptr)
+{
+  stop_watch_ptr_->toc("processing_time", true);
   std::scoped_lock lock(mutex_);
   set_map_in_voxel_grid_ = true;
   tf_input_frame_ = map_pcl_ptr->header.frame_id;
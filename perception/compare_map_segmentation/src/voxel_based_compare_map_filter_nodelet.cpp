@@ -18,6 +18,8 @@
 #include <pcl/search/kdtree.h>
 #include <pcl/segmentation/segment_differences.h>
 
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace compare_map_segmentation
@@ -43,9 +45,28 @@ VoxelBasedCompareMapFilterComponent::VoxelBasedCompareMapFilterComponent(
   set_map_in_voxel_grid_ = false;
 
   using std::placeholders::_1;
-  sub_map_ = this->create_subscription<PointCloud2>(
-    "map", rclcpp::QoS{1}.transient_local(),
-    std::bind(&VoxelBasedCompareMapFilterComponent::input_target_callback, this, _1));
+  const auto voxel_occupancy_map_path =
+    static_cast<std::string>(declare_parameter("voxel_occupancy_map_path", ""));
+  if (!voxel_occupancy_map_path.empty()) {
+    voxel_occupancy_map_ = std::make_unique<VoxelOccupancyMap>();
+    if (voxel_occupancy_map_->load(voxel_occupancy_map_path)) {
+      tf_input_frame_ = voxel_occupancy_map_->frameId();
+    } else {
+      RCLCPP_ERROR_STREAM(
+        get_logger(), "Couldn't load the voxel occupancy map " << voxel_occupancy_map_path
+                                                               << ", subscribing the map topic");
+      voxel_occupancy_map_.reset();
+    }
+  }
+  if (!voxel_occupancy_map_) {
+    map_tile_loader_ = MapTileLoader::create(
+      this, [this](const MapTileLoader::PointCloudConstPtr & map) { setMap(map); });
+  }
+  if (!voxel_occupancy_map_ && !map_tile_loader_) {
+    sub_map_ = this->create_subscription<PointCloud2>(
+      "map", rclcpp::QoS{1}.transient_local(),
+      std::bind(&VoxelBasedCompareMapFilterComponent::input_target_callback, this, _1));
+  }
 
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&VoxelBasedCompareMapFilterComponent::paramCallback, this, _1));
@@ -56,6 +77,10 @@ void VoxelBasedCompareMapFilterComponent::filter(
   PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
+  if (voxel_occupancy_map_) {
+    filterByVoxelOccupancyMap(input, output);
+    return;
+  }
   if (voxel_map_ptr_ == NULL) {
     output = *input;
     return;
@@ -245,13 +270,33 @@ bool VoxelBasedCompareMapFilterComponent::is_in_voxel(
   return false;
 }
 
+void VoxelBasedCompareMapFilterComponent::filterByVoxelOccupancyMap(
+  const PointCloud2ConstPtr & input, PointCloud2 & output)
+{
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_input(new pcl::PointCloud<pcl::PointXYZ>);
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
+  pcl::fromROSMsg(*input, *pcl_input);
+  pcl_output->points.reserve(pcl_input->points.size());
+  for (const auto & point : pcl_input->points) {
+    if (!voxel_occupancy_map_->hasPointWithin(point, distance_threshold_)) {
+      pcl_output->points.push_back(point);
+    }
+  }
+  pcl::toROSMsg(*pcl_output, output);
+  output.header = input->header;
+}
+
 void VoxelBasedCompareMapFilterComponent::input_target_callback(const PointCloud2ConstPtr map)
 {
-  stop_watch_ptr_->toc("processing_time", true);
   pcl::PointCloud<pcl::PointXYZ> map_pcl;
   pcl::fromROSMsg<pcl::PointXYZ>(*map, map_pcl);
-  const auto map_pcl_ptr = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_pcl);
+  setMap(pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_pcl));
+}
 
+void VoxelBasedCompareMapFilterComponent::setMap(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & map_pcl_ptr)
+{
+  stop_watch_ptr_->toc("processing_time", true);
   std::scoped_lock lock(mutex_);
   set_map_in_voxel_grid_ = true;
   tf_input_frame_ = map_pcl_ptr->header.frame_id;
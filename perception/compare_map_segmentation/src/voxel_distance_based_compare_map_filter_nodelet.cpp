@@ -18,6 +18,8 @@
 #include <pcl/search/kdtree.h>
 #include <pcl/segmentation/segment_differences.h>
 
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace compare_map_segmentation
@@ -30,10 +32,31 @@ VoxelDistanceBasedCompareMapFilterComponent::VoxelDistanceBasedCompareMapFilterC
 {
   distance_threshold_ = static_cast<double>(declare_parameter("distance_threshold", 0.3));
 
+  set_map_in_voxel_grid_ = false;
+
   using std::placeholders::_1;
-  sub_map_ = this->create_subscription<PointCloud2>(
-    "map", rclcpp::QoS{1}.transient_local(),
-    std::bind(&VoxelDistanceBasedCompareMapFilterComponent::input_target_callback, this, _1));
+  const auto voxel_occupancy_map_path =
+    static_cast<std::string>(declare_parameter("voxel_occupancy_map_path", ""));
+  if (!voxel_occupancy_map_path.empty()) {
+    voxel_occupancy_map_ = std::make_unique<VoxelOccupancyMap>();
+    if (voxel_occupancy_map_->load(voxel_occupancy_map_path)) {
+      tf_input_frame_ = voxel_occupancy_map_->frameId();
+    } else {
+      RCLCPP_ERROR_STREAM(
+        get_logger(), "Couldn't load the voxel occupancy map " << voxel_occupancy_map_path
+                                                               << ", subscribing the map topic");
+      voxel_occupancy_map_.reset();
+    }
+  }
+  if (!voxel_occupancy_map_) {
+    map_tile_loader_ = MapTileLoader::create(
+      this, [this](const MapTileLoader::PointCloudConstPtr & map) { setMap(map); });
+  }
+  if (!voxel_occupancy_map_ && !map_tile_loader_) {
+    sub_map_ = this->create_subscription<PointCloud2>(
+      "map", rclcpp::QoS{1}.transient_local(),
+      std::bind(&VoxelDistanceBasedCompareMapFilterComponent::input_target_callback, this, _1));
+  }
 
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&VoxelDistanceBasedCompareMapFilterComponent::paramCallback, this, _1));
@@ -44,6 +67,10 @@ void VoxelDistanceBasedCompareMapFilterComponent::filter(
   PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
+  if (voxel_occupancy_map_) {
+    filterByVoxelOccupancyMap(input, output);
+    return;
+  }
   if (voxel_map_ptr_ == NULL || map_ptr_ == NULL || tree_ == NULL) {
     output = *input;
     return;
@@ -69,12 +96,41 @@ void VoxelDistanceBasedCompareMapFilterComponent::filter(
   output.header = input->header;
 }
 
+void VoxelDistanceBasedCompareMapFilterComponent::filterByVoxelOccupancyMap(
+  const PointCloud2ConstPtr & input, PointCloud2 & output)
+{
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_input(new pcl::PointCloud<pcl::PointXYZ>);
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
+  pcl::fromROSMsg(*input, *pcl_input);
+  pcl_output->points.reserve(pcl_input->points.size());
+  for (const auto & point : pcl_input->points) {
+    if (!voxel_occupancy_map_->hasPointWithin(point, distance_threshold_)) {
+      pcl_output->points.push_back(point);
+    }
+  }
+  pcl::toROSMsg(*pcl_output, output);
+  output.header = input->header;
+}
+
 void VoxelDistanceBasedCompareMapFilterComponent::input_target_callback(
   const PointCloud2ConstPtr map)
 {
   pcl::PointCloud<pcl::PointXYZ> map_pcl;
   pcl::fromROSMsg<pcl::PointXYZ>(*map, map_pcl);
-  const auto map_pcl_ptr = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_pcl);
+  setMap(pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(map_pcl));
+}
+
+void VoxelDistanceBasedCompareMapFilterComponent::setMap(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & map_pcl_ptr)
+{
+  // the tree is built before locking, so that the filter keeps running on the previous map
+  pcl::search::Search<pcl::PointXYZ>::Ptr tree;
+  if (map_pcl_ptr->isOrganized()) {
+    tree.reset(new pcl::search::OrganizedNeighbor<pcl::PointXYZ>());
+  } else {
+    tree.reset(new pcl::search::KdTree<pcl::PointXYZ>(false));
+  }
+  tree->setInputCloud(map_pcl_ptr);
 
   std::scoped_lock lock(mutex_);
   tf_input_frame_ = map_pcl_ptr->header.frame_id;
@@ -86,14 +142,7 @@ void VoxelDistanceBasedCompareMapFilterComponent::input_target_callback(
   voxel_grid_.filter(*voxel_map_ptr_);
   // kdtree
   map_ptr_ = map_pcl_ptr;
-  if (!tree_) {
-    if (map_ptr_->isOrganized()) {
-      tree_.reset(new pcl::search::OrganizedNeighbor<pcl::PointXYZ>());
-    } else {
-      tree_.reset(new pcl::search::KdTree<pcl::PointXYZ>(false));
-    }
-  }
-  tree_->setInputCloud(map_ptr_);
+  tree_ = tree;
 }
 
 rcl_interfaces::msg::SetParametersResult VoxelDistanceBasedCompareMapFilterComponent::paramCallback(
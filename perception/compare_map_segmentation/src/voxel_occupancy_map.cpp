@@ -0,0 +1,224 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "compare_map_segmentation/voxel_occupancy_map.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+namespace compare_map_segmentation
+{
+namespace
+{
+constexpr uint64_t empty_key = ~uint64_t{0};
+// block coordinates are packed in 21 bits each, i.e. +-2^20 blocks of 8 voxels
+constexpr int64_t key_offset = int64_t{1} << 20;
+constexpr uint64_t key_mask = (uint64_t{1} << 21) - 1;
+
+uint64_t packKey(const int64_t block_x, const int64_t block_y, const int64_t block_z)
+{
+  return ((static_cast<uint64_t>(block_x + key_offset) & key_mask) << 42) |
+         ((static_cast<uint64_t>(block_y + key_offset) & key_mask) << 21) |
+         (static_cast<uint64_t>(block_z + key_offset) & key_mask);
+}
+
+uint64_t hashKey(const uint64_t key) { return (key ^ (key >> 29)) * 0x9e3779b97f4a7c15ULL; }
+
+int64_t voxelCoordinate(const float value, const double leaf_size)
+{
+  return static_cast<int64_t>(std::floor(value / leaf_size));
+}
+}  // namespace
+
+VoxelOccupancyMap::~VoxelOccupancyMap() { unmap(); }
+
+void VoxelOccupancyMap::unmap()
+{
+  if (mapped_) {
+    munmap(mapped_, mapped_size_);
+    mapped_ = nullptr;
+    mapped_size_ = 0U;
+  }
+  blocks_ = nullptr;
+}
+
+void VoxelOccupancyMap::initialize(const double leaf_size, const std::string & frame_id)
+{
+  unmap();
+  owned_blocks_.clear();
+  building_blocks_.clear();
+  header_ = VoxelOccupancyMapHeader{};
+  header_.magic = magic;
+  header_.version = version;
+  header_.leaf_size = leaf_size;
+  std::strncpy(header_.frame_id, frame_id.c_str(), sizeof(header_.frame_id) - 1);
+}
+
+void VoxelOccupancyMap::addPoints(const pcl::PointCloud<pcl::PointXYZ> & points)
+{
+  for (const auto & point : points.points) {
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+      continue;
+    }
+    const int64_t x = voxelCoordinate(point.x, header_.leaf_size);
+    const int64_t y = voxelCoordinate(point.y, header_.leaf_size);
+    const int64_t z = voxelCoordinate(point.z, header_.leaf_size);
+    // the arithmetic shift rounds the negative coordinates down as well
+    auto & bits = building_blocks_[packKey(x >> 3, y >> 3, z >> 3)];
+    bits[x & 7] |= uint64_t{1} << (((y & 7) << 3) | (z & 7));
+  }
+}
+
+void VoxelOccupancyMap::finalize()
+{
+  // at most half full, so that probe sequences stay short
+  uint64_t capacity = 1U;
+  while (capacity < 2U * building_blocks_.size()) {
+    capacity <<= 1U;
+  }
+  VoxelOccupancyBlock empty_block{};
+  empty_block.key = empty_key;
+  owned_blocks_.assign(capacity, empty_block);
+
+  const uint64_t mask = capacity - 1U;
+  for (const auto & [key, bits] : building_blocks_) {
+    uint64_t index = hashKey(key) & mask;
+    while (owned_blocks_[index].key != empty_key) {
+      index = (index + 1U) & mask;
+    }
+    owned_blocks_[index].key = key;
+    std::copy(bits.begin(), bits.end(), owned_blocks_[index].bits);
+  }
+  header_.capacity = capacity;
+  header_.block_num = building_blocks_.size();
+  building_blocks_.clear();
+  blocks_ = owned_blocks_.data();
+}
+
+bool VoxelOccupancyMap::save(const std::string & path) const
+{
+  if (empty()) {
+    return false;
+  }
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+  ofs.write(reinterpret_cast<const char *>(&header_), sizeof(header_));
+  ofs.write(
+    reinterpret_cast<const char *>(blocks_),
+    static_cast<std::streamsize>(header_.capacity * sizeof(VoxelOccupancyBlock)));
+  return ofs.good();
+}
+
+bool VoxelOccupancyMap::load(const std::string & path)
+{
+  unmap();
+  owned_blocks_.clear();
+  building_blocks_.clear();
+
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(header_)) {
+    close(fd);
+    return false;
+  }
+  const auto size = static_cast<std::size_t>(st.st_size);
+  void * ptr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    return false;
+  }
+
+  const auto & header = *static_cast<const VoxelOccupancyMapHeader *>(ptr);
+  const bool is_power_of_2 =
+    header.capacity != 0U && (header.capacity & (header.capacity - 1U)) == 0U;
+  if (
+    header.magic != magic || header.version != version || header.leaf_size <= 0.0 ||
+    !is_power_of_2 || size != sizeof(header) + header.capacity * sizeof(VoxelOccupancyBlock)) {
+    munmap(ptr, size);
+    return false;
+  }
+  header_ = header;
+  header_.frame_id[sizeof(header_.frame_id) - 1] = '\0';
+  mapped_ = ptr;
+  mapped_size_ = size;
+  blocks_ =
+    reinterpret_cast<const VoxelOccupancyBlock *>(static_cast<uint8_t *>(ptr) + sizeof(header));
+  // the filters query the whole map at random
+  madvise(mapped_, mapped_size_, MADV_RANDOM);
+  return true;
+}
+
+bool VoxelOccupancyMap::isOccupied(const int64_t x, const int64_t y, const int64_t z) const
+{
+  const uint64_t key = packKey(x >> 3, y >> 3, z >> 3);
+  const uint64_t mask = header_.capacity - 1U;
+  for (uint64_t index = hashKey(key) & mask; blocks_[index].key != empty_key;
+       index = (index + 1U) & mask) {
+    if (blocks_[index].key == key) {
+      return (blocks_[index].bits[x & 7] >> (((y & 7) << 3) | (z & 7))) & 1U;
+    }
+  }
+  return false;
+}
+
+bool VoxelOccupancyMap::hasPointWithin(const pcl::PointXYZ & point, const double distance) const
+{
+  if (empty()) {
+    return false;
+  }
+  const double leaf_size = header_.leaf_size;
+  const int64_t x = voxelCoordinate(point.x, leaf_size);
+  const int64_t y = voxelCoordinate(point.y, leaf_size);
+  const int64_t z = voxelCoordinate(point.z, leaf_size);
+  // most of the map points fall into an occupied voxel themselves
+  if (isOccupied(x, y, z)) {
+    return true;
+  }
+
+  // distance from the point to the nearest face of the voxel v along one axis
+  const auto axis_distance = [leaf_size](const float value, const int64_t v) {
+    return std::max({0.0, v * leaf_size - value, value - (v + 1) * leaf_size});
+  };
+  const double sqr_distance = distance * distance;
+  const auto range = static_cast<int64_t>(std::ceil(distance / leaf_size));
+  for (int64_t vx = x - range; vx <= x + range; ++vx) {
+    const double dx = axis_distance(point.x, vx);
+    if (dx * dx > sqr_distance) {
+      continue;
+    }
+    for (int64_t vy = y - range; vy <= y + range; ++vy) {
+      const double dy = axis_distance(point.y, vy);
+      if (dx * dx + dy * dy > sqr_distance) {
+        continue;
+      }
+      for (int64_t vz = z - range; vz <= z + range; ++vz) {
+        const double dz = axis_distance(point.z, vz);
+        if (dx * dx + dy * dy + dz * dz <= sqr_distance && isOccupied(vx, vy, vz)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+}  // namespace compare_map_segmentation
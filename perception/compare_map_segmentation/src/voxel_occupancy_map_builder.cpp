@@ -0,0 +1,91 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "compare_map_segmentation/voxel_occupancy_map.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <pcl/io/pcd_io.h>
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+bool isPcdFile(const std::string & p)
+{
+  if (fs::is_directory(p)) {
+    return false;
+  }
+  const std::string ext = fs::path(p).extension();
+  return ext == ".pcd" || ext == ".PCD";
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+
+  auto node = rclcpp::Node::make_shared("voxel_occupancy_map_builder");
+
+  const auto pcd_paths_or_directory =
+    node->declare_parameter<std::vector<std::string>>("pcd_paths_or_directory");
+  const auto output_path = node->declare_parameter<std::string>("output_path");
+  const auto leaf_size = node->declare_parameter<double>("leaf_size", 0.15);
+  const auto frame_id = node->declare_parameter<std::string>("frame_id", "map");
+
+  std::vector<std::string> pcd_paths{};
+  for (const auto & p : pcd_paths_or_directory) {
+    if (isPcdFile(p)) {
+      pcd_paths.push_back(p);
+    } else if (fs::is_directory(p)) {
+      for (const auto & file : fs::directory_iterator(p)) {
+        if (isPcdFile(file.path().string())) {
+          pcd_paths.push_back(file.path().string());
+        }
+      }
+    } else {
+      RCLCPP_ERROR_STREAM(node->get_logger(), "invalid path: " << p);
+    }
+  }
+
+  // the files are read one by one, so the whole map never has to fit in memory
+  compare_map_segmentation::VoxelOccupancyMap voxel_occupancy_map;
+  voxel_occupancy_map.initialize(leaf_size, frame_id);
+  pcl::PointCloud<pcl::PointXYZ> partial_pcd;
+  for (const auto & path : pcd_paths) {
+    if (pcl::io::loadPCDFile<pcl::PointXYZ>(path, partial_pcd) == -1) {
+      RCLCPP_ERROR_STREAM(node->get_logger(), "PCD load failed: " << path);
+      continue;
+    }
+    voxel_occupancy_map.addPoints(partial_pcd);
+    std::cout << "Loaded " << partial_pcd.points.size() << " points from " << path << std::endl;
+  }
+  voxel_occupancy_map.finalize();
+
+  if (!voxel_occupancy_map.save(output_path)) {
+    RCLCPP_ERROR_STREAM(node->get_logger(), "Couldn't write file: " << output_path);
+    return EXIT_FAILURE;
+  }
+  std::cout << "Saved " << voxel_occupancy_map.blockNum() << " voxel blocks to " << output_path
+            << std::endl;
+
+  rclcpp::shutdown();
+
+  return 0;
+}
@@ -35,7 +35,9 @@
 #include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace traffic_light
@@ -51,6 +53,24 @@ using tier4_autoware_utils::StopWatch;
 using tier4_debug_msgs::msg::Float64Stamped;
 using TrafficLightIdMap = std::unordered_map<lanelet::Id, TrafficSignal>;
 
+// vehicle lanelet with a traffic light conflicting with a crosswalk
+struct ConflictingVehicleLane
+{
+  lanelet::Id traffic_light_reg_elem_id;
+  std::vector<lanelet::Id> traffic_light_ids;
+  std::string turn_direction;
+};
+
+// what the estimation of a crosswalk signal refers to in the map, resolved once for the map
+struct CrosswalkSignalRelation
+{
+  std::vector<ConflictingVehicleLane> vehicle_lanes;
+  // pairs of the vehicle_lanes with different turn directions merging into the same lanelet
+  std::vector<std::pair<size_t, size_t>> merging_lane_pairs;
+  lanelet::Id related_traffic_light_id;
+  std::vector<lanelet::Id> crosswalk_traffic_light_ids;
+};
+
 class CrosswalkTrafficLightEstimatorNode : public rclcpp::Node
 {
 public:
@@ -66,25 +86,33 @@ private:
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
   lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
   std::shared_ptr<const lanelet::routing::RoutingGraphContainer> overall_graphs_ptr_;
+  HADMapRoute::ConstSharedPtr route_ptr_;
 
-  lanelet::ConstLanelets conflicting_crosswalks_;
+  // the relations of the crosswalks met so far on the map, and the ones conflicting with the route
+  std::vector<CrosswalkSignalRelation> crosswalk_relations_;
+  std::unordered_map<lanelet::Id, size_t> crosswalk_relation_indices_;
+  std::vector<size_t> conflicting_crosswalks_;
 
   void onMap(const HADMapBin::ConstSharedPtr msg);
   void onRoute(const HADMapRoute::ConstSharedPtr msg);
   void onTrafficLightArray(const TrafficSignalArray::ConstSharedPtr msg);
 
+  size_t getCrosswalkRelationIndex(const lanelet::ConstLanelet & crosswalk);
+  CrosswalkSignalRelation calcCrosswalkSignalRelation(
+    const lanelet::ConstLanelet & crosswalk) const;
+
   void updateLastDetectedSignal(const TrafficLightIdMap & traffic_signals);
   void setCrosswalkTrafficSignal(
-    const lanelet::ConstLanelet & crosswalk, const uint8_t color, TrafficSignalArray & msg) const;
+    const CrosswalkSignalRelation & relation, const uint8_t color, TrafficSignalArray & msg) const;
 
-  lanelet::ConstLanelets getGreenLanelets(
-    const lanelet::ConstLanelets & lanelets, const TrafficLightIdMap & traffic_light_id_map) const;
+  std::vector<bool> getGreenLanes(
+    const CrosswalkSignalRelation & relation, const TrafficLightIdMap & traffic_light_id_map) const;
 
   uint8_t estimateCrosswalkTrafficSignal(
-    const lanelet::ConstLanelet & crosswalk, const lanelet::ConstLanelets & green_lanelets) const;
+    const CrosswalkSignalRelation & relation, const std::vector<bool> & is_green_lane) const;
 
   boost::optional<uint8_t> getHighestConfidenceTrafficSignal(
-    const lanelet::ConstLineStringsOrPolygons3d & traffic_lights,
+    const std::vector<lanelet::Id> & traffic_light_ids,
     const TrafficLightIdMap & traffic_light_id_map) const;
 
   // Node param
@@ -15,8 +15,10 @@
 
 #include <lanelet2_extension/utility/message_conversion.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -43,36 +45,17 @@ bool hasMergeLane(
   return false;
 }
 
-bool hasMergeLane(
-  const lanelet::ConstLanelets & lanelets,
-  const lanelet::routing::RoutingGraphPtr & routing_graph_ptr)
+std::vector<lanelet::Id> getTrafficLightIds(
+  const lanelet::ConstLineStringsOrPolygons3d & traffic_lights)
 {
-  for (size_t i = 0; i < lanelets.size(); ++i) {
-    for (size_t j = i + 1; j < lanelets.size(); ++j) {
-      const auto lanelet_1 = lanelets.at(i);
-      const auto lanelet_2 = lanelets.at(j);
-
-      if (lanelet_1.id() == lanelet_2.id()) {
-        continue;
-      }
-
-      const std::string turn_direction_1 = lanelet_1.attributeOr("turn_direction", "none");
-      const std::string turn_direction_2 = lanelet_2.attributeOr("turn_direction", "none");
-      if (turn_direction_1 == turn_direction_2) {
-        continue;
-      }
-
-      if (!hasMergeLane(lanelet_1, lanelet_2, routing_graph_ptr)) {
-        continue;
-      }
-
-      return true;
+  std::vector<lanelet::Id> traffic_light_ids;
+  for (const auto & traffic_light : traffic_lights) {
+    if (traffic_light.isLineString()) {
+      traffic_light_ids.push_back(static_cast<lanelet::ConstLineString3d>(traffic_light).id());
     }
   }
-
-  return false;
+  return traffic_light_ids;
 }
-
 }  // namespace
 
 CrosswalkTrafficLightEstimatorNode::CrosswalkTrafficLightEstimatorNode(
@@ -115,11 +98,21 @@ void CrosswalkTrafficLightEstimatorNode::onMap(const HADMapBin::ConstSharedPtr m
   lanelet::routing::RoutingGraphContainer overall_graphs({vehicle_graph, pedestrian_graph});
   overall_graphs_ptr_ =
     std::make_shared<const lanelet::routing::RoutingGraphContainer>(overall_graphs);
+  crosswalk_relations_.clear();
+  crosswalk_relation_indices_.clear();
   RCLCPP_INFO(get_logger(), "[CrosswalkTrafficLightEstimatorNode]: Map is loaded");
+
+  // the crosswalks of the route are resolved again on the new map
+  if (route_ptr_) {
+    onRoute(route_ptr_);
+  }
 }
 
 void CrosswalkTrafficLightEstimatorNode::onRoute(const HADMapRoute::ConstSharedPtr msg)
 {
+  route_ptr_ = msg;
+  conflicting_crosswalks_.clear();
+
   if (lanelet_map_ptr_ == nullptr) {
     RCLCPP_WARN(get_logger(), "cannot set traffic light in route because don't receive map");
     return;
@@ -137,16 +130,80 @@ void CrosswalkTrafficLightEstimatorNode::onRoute(const HADMapRoute::ConstSharedP
     }
   }
 
-  conflicting_crosswalks_.clear();
-
   for (const auto & route_lanelet : route_lanelets) {
     constexpr int PEDESTRIAN_GRAPH_ID = 1;
     const auto conflict_lls =
       overall_graphs_ptr_->conflictingInGraph(route_lanelet, PEDESTRIAN_GRAPH_ID);
     for (const auto & lanelet : conflict_lls) {
-      conflicting_crosswalks_.push_back(lanelet);
+      conflicting_crosswalks_.push_back(getCrosswalkRelationIndex(lanelet));
+    }
+  }
+}
+
+size_t CrosswalkTrafficLightEstimatorNode::getCrosswalkRelationIndex(
+  const lanelet::ConstLanelet & crosswalk)
+{
+  // the relations only depend on the map, so that a crosswalk is resolved once whatever the route
+  const auto itr = crosswalk_relation_indices_.find(crosswalk.id());
+  if (itr != crosswalk_relation_indices_.end()) {
+    return itr->second;
+  }
+
+  crosswalk_relations_.push_back(calcCrosswalkSignalRelation(crosswalk));
+  crosswalk_relation_indices_.emplace(crosswalk.id(), crosswalk_relations_.size() - 1);
+  return crosswalk_relations_.size() - 1;
+}
+
+CrosswalkSignalRelation CrosswalkTrafficLightEstimatorNode::calcCrosswalkSignalRelation(
+  const lanelet::ConstLanelet & crosswalk) const
+{
+  CrosswalkSignalRelation relation;
+
+  constexpr int VEHICLE_GRAPH_ID = 0;
+  const auto conflict_lls = overall_graphs_ptr_->conflictingInGraph(crosswalk, VEHICLE_GRAPH_ID);
+  lanelet::ConstLanelets vehicle_lanelets;
+  for (const auto & lanelet : conflict_lls) {
+    const auto tl_reg_elems = lanelet.regulatoryElementsAs<const lanelet::TrafficLight>();
+    if (tl_reg_elems.empty()) {
+      continue;
+    }
+
+    ConflictingVehicleLane vehicle_lane;
+    vehicle_lane.traffic_light_reg_elem_id = tl_reg_elems.front()->id();
+    vehicle_lane.traffic_light_ids = getTrafficLightIds(tl_reg_elems.front()->trafficLights());
+    vehicle_lane.turn_direction = lanelet.attributeOr("turn_direction", "none");
+    relation.vehicle_lanes.push_back(vehicle_lane);
+    vehicle_lanelets.push_back(lanelet);
+  }
+
+  const auto & vehicle_lanes = relation.vehicle_lanes;
+  for (size_t i = 0; i < vehicle_lanelets.size(); ++i) {
+    for (size_t j = i + 1; j < vehicle_lanelets.size(); ++j) {
+      if (vehicle_lanelets.at(i).id() == vehicle_lanelets.at(j).id()) {
+        continue;
+      }
+
+      if (vehicle_lanes.at(i).turn_direction == vehicle_lanes.at(j).turn_direction) {
+        continue;
+      }
+
+      if (hasMergeLane(vehicle_lanelets.at(i), vehicle_lanelets.at(j), routing_graph_ptr_)) {
+        relation.merging_lane_pairs.emplace_back(i, j);
+      }
     }
   }
+
+  const std::string related_tl_id = crosswalk.attributeOr("related_traffic_light", "none");
+  relation.related_traffic_light_id = std::atoi(related_tl_id.c_str());
+
+  for (const auto & tl_reg_elem : crosswalk.regulatoryElementsAs<const lanelet::TrafficLight>()) {
+    for (const auto & traffic_light : tl_reg_elem->trafficLights()) {
+      relation.crosswalk_traffic_light_ids.push_back(
+        static_cast<lanelet::ConstLineString3d>(traffic_light).id());
+    }
+  }
+
+  return relation;
 }
 
 void CrosswalkTrafficLightEstimatorNode::onTrafficLightArray(
@@ -162,13 +219,12 @@ void CrosswalkTrafficLightEstimatorNode::onTrafficLightArray(
     traffic_light_id_map[traffic_signal.map_primitive_id] = traffic_signal;
   }
 
-  for (const auto & crosswalk : conflicting_crosswalks_) {
-    constexpr int VEHICLE_GRAPH_ID = 0;
-    const auto conflict_lls = overall_graphs_ptr_->conflictingInGraph(crosswalk, VEHICLE_GRAPH_ID);
-    const auto green_lanelets = getGreenLanelets(conflict_lls, traffic_light_id_map);
+  for (const auto & crosswalk_relation_index : conflicting_crosswalks_) {
+    const auto & relation = crosswalk_relations_.at(crosswalk_relation_index);
+    const auto is_green_lane = getGreenLanes(relation, traffic_light_id_map);
 
-    const auto crosswalk_tl_color = estimateCrosswalkTrafficSignal(crosswalk, green_lanelets);
-    setCrosswalkTrafficSignal(crosswalk, crosswalk_tl_color, output);
+    const auto crosswalk_tl_color = estimateCrosswalkTrafficSignal(relation, is_green_lane);
+    setCrosswalkTrafficSignal(relation, crosswalk_tl_color, output);
   }
 
   updateLastDetectedSignal(traffic_light_id_map);
@@ -213,41 +269,26 @@ void CrosswalkTrafficLightEstimatorNode::updateLastDetectedSignal(
 }
 
 void CrosswalkTrafficLightEstimatorNode::setCrosswalkTrafficSignal(
-  const lanelet::ConstLanelet & crosswalk, const uint8_t color, TrafficSignalArray & msg) const
+  const CrosswalkSignalRelation & relation, const uint8_t color, TrafficSignalArray & msg) const
 {
-  const auto tl_reg_elems = crosswalk.regulatoryElementsAs<const lanelet::TrafficLight>();
-
-  for (const auto & tl_reg_elem : tl_reg_elems) {
-    const auto crosswalk_traffic_lights = tl_reg_elem->trafficLights();
-
-    for (const auto & traffic_light : crosswalk_traffic_lights) {
-      const auto ll_traffic_light = static_cast<lanelet::ConstLineString3d>(traffic_light);
-
-      TrafficSignal output_traffic_signal;
-      TrafficLight output_traffic_light;
-      output_traffic_light.color = color;
-      output_traffic_light.confidence = 1.0;
-      output_traffic_signal.lights.push_back(output_traffic_light);
-      output_traffic_signal.map_primitive_id = ll_traffic_light.id();
-      msg.signals.push_back(output_traffic_signal);
-    }
+  for (const auto & traffic_light_id : relation.crosswalk_traffic_light_ids) {
+    TrafficSignal output_traffic_signal;
+    TrafficLight output_traffic_light;
+    output_traffic_light.color = color;
+    output_traffic_light.confidence = 1.0;
+    output_traffic_signal.lights.push_back(output_traffic_light);
+    output_traffic_signal.map_primitive_id = traffic_light_id;
+    msg.signals.push_back(output_traffic_signal);
   }
 }
 
-lanelet::ConstLanelets CrosswalkTrafficLightEstimatorNode::getGreenLanelets(
-  const lanelet::ConstLanelets & lanelets, const TrafficLightIdMap & traffic_light_id_map) const
+std::vector<bool> CrosswalkTrafficLightEstimatorNode::getGreenLanes(
+  const CrosswalkSignalRelation & relation, const TrafficLightIdMap & traffic_light_id_map) const
 {
-  lanelet::ConstLanelets green_lanelets{};
-
-  for (const auto & lanelet : lanelets) {
-    const auto tl_reg_elems = lanelet.regulatoryElementsAs<const lanelet::TrafficLight>();
-
-    if (tl_reg_elems.empty()) {
-      continue;
-    }
+  std::vector<bool> is_green_lane(relation.vehicle_lanes.size(), false);
 
-    const auto tl_reg_elem = tl_reg_elems.front();
-    const auto traffic_lights_for_vehicle = tl_reg_elem->trafficLights();
+  for (size_t i = 0; i < relation.vehicle_lanes.size(); ++i) {
+    const auto & traffic_lights_for_vehicle = relation.vehicle_lanes.at(i).traffic_light_ids;
 
     const auto current_detected_signal =
       getHighestConfidenceTrafficSignal(traffic_lights_for_vehicle, traffic_light_id_map);
@@ -273,24 +314,27 @@ lanelet::ConstLanelets CrosswalkTrafficLightEstimatorNode::getGreenLanelets(
       continue;
     }
 
-    green_lanelets.push_back(lanelet);
+    is_green_lane.at(i) = true;
   }
 
-  return green_lanelets;
+  return is_green_lane;
 }
 
 uint8_t CrosswalkTrafficLightEstimatorNode::estimateCrosswalkTrafficSignal(
-  const lanelet::ConstLanelet & crosswalk, const lanelet::ConstLanelets & green_lanelets) const
+  const CrosswalkSignalRelation & relation, const std::vector<bool> & is_green_lane) const
 {
   bool has_left_green_lane = false;
   bool has_right_green_lane = false;
   bool has_straight_green_lane = false;
   bool has_related_green_tl = false;
 
-  const std::string related_tl_id = crosswalk.attributeOr("related_traffic_light", "none");
+  for (size_t i = 0; i < relation.vehicle_lanes.size(); ++i) {
+    if (!is_green_lane.at(i)) {
+      continue;
+    }
 
-  for (const auto & lanelet : green_lanelets) {
-    const std::string turn_direction = lanelet.attributeOr("turn_direction", "none");
+    const auto & vehicle_lane = relation.vehicle_lanes.at(i);
+    const auto & turn_direction = vehicle_lane.turn_direction;
 
     if (turn_direction == "left") {
       has_left_green_lane = true;
@@ -300,8 +344,7 @@ uint8_t CrosswalkTrafficLightEstimatorNode::estimateCrosswalkTrafficSignal(
       has_straight_green_lane = true;
     }
 
-    const auto tl_reg_elems = lanelet.regulatoryElementsAs<const lanelet::TrafficLight>();
-    if (tl_reg_elems.front()->id() == std::atoi(related_tl_id.c_str())) {
+    if (vehicle_lane.traffic_light_reg_elem_id == relation.related_traffic_light_id) {
       has_related_green_tl = true;
     }
   }
@@ -310,29 +353,29 @@ uint8_t CrosswalkTrafficLightEstimatorNode::estimateCrosswalkTrafficSignal(
     return TrafficLight::RED;
   }
 
-  const auto has_merge_lane = hasMergeLane(green_lanelets, routing_graph_ptr_);
+  const auto has_merge_lane = std::any_of(
+    relation.merging_lane_pairs.begin(), relation.merging_lane_pairs.end(),
+    [&is_green_lane](const auto & pair) {
+      return is_green_lane.at(pair.first) && is_green_lane.at(pair.second);
+    });
   return !has_merge_lane && has_left_green_lane && has_right_green_lane ? TrafficLight::RED
                                                                         : TrafficLight::UNKNOWN;
 }
 
 boost::optional<uint8_t> CrosswalkTrafficLightEstimatorNode::getHighestConfidenceTrafficSignal(
-  const lanelet::ConstLineStringsOrPolygons3d & traffic_lights,
+  const std::vector<lanelet::Id> & traffic_light_ids,
   const TrafficLightIdMap & traffic_light_id_map) const
 {
   boost::optional<uint8_t> ret{boost::none};
 
   double highest_confidence = 0.0;
-  for (const auto & traffic_light : traffic_lights) {
-    if (!traffic_light.isLineString()) {
-      continue;
-    }
-
-    const int id = static_cast<lanelet::ConstLineString3d>(traffic_light).id();
-    if (traffic_light_id_map.count(id) == 0) {
+  for (const auto & id : traffic_light_ids) {
+    const auto itr = traffic_light_id_map.find(id);
+    if (itr == traffic_light_id_map.end()) {
       continue;
     }
 
-    const auto & lights = traffic_light_id_map.at(id).lights;
+    const auto & lights = itr->second.lights;
     if (lights.empty()) {
       continue;
     }
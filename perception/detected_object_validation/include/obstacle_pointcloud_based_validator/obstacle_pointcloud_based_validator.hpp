@@ -16,6 +16,7 @@
 #define OBSTACLE_POINTCLOUD_BASED_VALIDATOR__OBSTACLE_POINTCLOUD_BASED_VALIDATOR_HPP_
 
 #include "obstacle_pointcloud_based_validator/debugger.hpp"
+#include "obstacle_pointcloud_based_validator/pointcloud_grid.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -53,6 +54,7 @@ private:
   typedef message_filters::Synchronizer<SyncPolicy> Sync;
   Sync sync_;
   size_t min_pointcloud_num_;
+  int num_threads_;
 
   std::shared_ptr<Debugger> debugger_;
 
@@ -62,7 +64,9 @@ private:
     const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_obstacle_pointcloud);
   std::optional<size_t> getPointCloudNumWithinPolygon(
     const autoware_auto_perception_msgs::msg::DetectedObject & object,
-    const pcl::PointCloud<pcl::PointXY>::Ptr pointcloud);
+    const PointCloudGrid & pointcloud_grid,
+    pcl::PointCloud<pcl::PointXY>::Ptr * neighbor_pointcloud,
+    pcl::PointCloud<pcl::PointXYZ>::Ptr * pointcloud_within_polygon);
   void toPolygon2d(
     const autoware_auto_perception_msgs::msg::DetectedObject & object,
     const pcl::PointCloud<pcl::PointXY>::Ptr & polygon);
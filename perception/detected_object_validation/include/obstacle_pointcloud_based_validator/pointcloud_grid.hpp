@@ -0,0 +1,147 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OBSTACLE_POINTCLOUD_BASED_VALIDATOR__POINTCLOUD_GRID_HPP_
+#define OBSTACLE_POINTCLOUD_BASED_VALIDATOR__POINTCLOUD_GRID_HPP_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace obstacle_pointcloud_based_validator
+{
+/**
+ * @brief the points of a cloud sorted by the cell of a 2D grid over their extent
+ *        Built once per cloud with a counting sort, so the points around an object are gathered
+ *        from the cells its bounding box overlaps, and read by any number of threads.
+ */
+class PointCloudGrid
+{
+public:
+  PointCloudGrid(const pcl::PointCloud<pcl::PointXY> & pointcloud, const float cell_size)
+  {
+    float min_x = std::numeric_limits<float>::max();
+    float min_y = std::numeric_limits<float>::max();
+    float max_x = std::numeric_limits<float>::lowest();
+    float max_y = std::numeric_limits<float>::lowest();
+    size_t num_points = 0;
+    for (const auto & point : pointcloud) {
+      if (!isFinite(point)) {
+        continue;
+      }
+      ++num_points;
+      min_x = std::min(min_x, point.x);
+      min_y = std::min(min_y, point.y);
+      max_x = std::max(max_x, point.x);
+      max_y = std::max(max_y, point.y);
+    }
+    if (num_points == 0) {
+      return;
+    }
+
+    // the cells are enlarged for an unusually wide cloud, to keep the grid as small as the cloud
+    const float extent = std::max(max_x - min_x, max_y - min_y);
+    cell_size_ = std::max(cell_size, extent / max_cell_num_per_axis);
+    origin_x_ = min_x;
+    origin_y_ = min_y;
+    width_ = static_cast<int>((max_x - min_x) / cell_size_) + 1;
+    height_ = static_cast<int>((max_y - min_y) / cell_size_) + 1;
+
+    std::vector<uint32_t> cell_indices(pointcloud.size());
+    cell_begin_.assign(static_cast<size_t>(width_) * height_ + 1, 0);
+    for (size_t i = 0; i < pointcloud.size(); ++i) {
+      const auto & point = pointcloud[i];
+      if (isFinite(point)) {
+        cell_indices[i] = toCellIndex(toCellX(point.x), toCellY(point.y));
+        ++cell_begin_[cell_indices[i] + 1];
+      }
+    }
+    for (size_t i = 1; i < cell_begin_.size(); ++i) {
+      cell_begin_[i] += cell_begin_[i - 1];
+    }
+    std::vector<uint32_t> cell_end(cell_begin_.begin(), cell_begin_.end() - 1);
+    points_.resize(num_points);
+    for (size_t i = 0; i < pointcloud.size(); ++i) {
+      if (isFinite(pointcloud[i])) {
+        points_[cell_end[cell_indices[i]]++] = pointcloud[i];
+      }
+    }
+  }
+
+  /**
+   * @brief call the function for the points of the cells overlapping the box until it returns false
+   */
+  template <class Function>
+  void forEachPointInBox(
+    const float min_x, const float min_y, const float max_x, const float max_y,
+    Function && function) const
+  {
+    if (points_.empty()) {
+      return;
+    }
+    const int begin_x = std::max(toCellX(min_x), 0);
+    const int begin_y = std::max(toCellY(min_y), 0);
+    const int end_x = std::min(toCellX(max_x), width_ - 1);
+    const int end_y = std::min(toCellY(max_y), height_ - 1);
+    if (begin_x > end_x || begin_y > end_y) {
+      return;
+    }
+    for (int y = begin_y; y <= end_y; ++y) {
+      // the cells of a row are contiguous
+      const uint32_t begin = cell_begin_[toCellIndex(begin_x, y)];
+      const uint32_t end = cell_begin_[toCellIndex(end_x, y) + 1];
+      for (uint32_t i = begin; i < end; ++i) {
+        if (!function(points_[i])) {
+          return;
+        }
+      }
+    }
+  }
+
+private:
+  static constexpr float max_cell_num_per_axis = 1024.0f;
+
+  static bool isFinite(const pcl::PointXY & point)
+  {
+    return std::isfinite(point.x) && std::isfinite(point.y);
+  }
+  int toCellX(const float x) const
+  {
+    return static_cast<int>(std::floor((x - origin_x_) / cell_size_));
+  }
+  int toCellY(const float y) const
+  {
+    return static_cast<int>(std::floor((y - origin_y_) / cell_size_));
+  }
+  uint32_t toCellIndex(const int x, const int y) const
+  {
+    return static_cast<uint32_t>(y) * static_cast<uint32_t>(width_) + static_cast<uint32_t>(x);
+  }
+
+  float cell_size_{1.0f};
+  float origin_x_{0.0f};
+  float origin_y_{0.0f};
+  int width_{0};
+  int height_{0};
+  std::vector<uint32_t> cell_begin_;
+  std::vector<pcl::PointXY> points_;
+};
+}  // namespace obstacle_pointcloud_based_validator
+
+#endif  // OBSTACLE_POINTCLOUD_BASED_VALIDATOR__POINTCLOUD_GRID_HPP_
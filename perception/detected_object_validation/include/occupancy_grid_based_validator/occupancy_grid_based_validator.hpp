@@ -29,6 +29,9 @@
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <optional>
+#include <vector>
+
 namespace occupancy_grid_based_validator
 {
 class OccupancyGridBasedValidator : public rclcpp::Node
@@ -56,12 +59,16 @@ private:
     const nav_msgs::msg::OccupancyGrid::ConstSharedPtr & input_occ_grid);
 
   cv::Mat fromOccupancyGrid(const nav_msgs::msg::OccupancyGrid & occupancy_grid);
-  std::optional<cv::Mat> getMask(
-    const nav_msgs::msg::OccupancyGrid & occupancy_grid,
+  std::optional<float> getMeanWithinMask(
+    const nav_msgs::msg::OccupancyGrid & occupancy_grid, const cv::Mat & occ_grid,
+    const cv::Mat & occ_grid_integral,
     const autoware_auto_perception_msgs::msg::DetectedObject & object);
   std::optional<cv::Mat> getMask(
     const nav_msgs::msg::OccupancyGrid & occupancy_grid,
     const autoware_auto_perception_msgs::msg::DetectedObject & object, cv::Mat mask);
+  std::optional<std::vector<cv::Point>> toPixelVertices(
+    const nav_msgs::msg::OccupancyGrid & occupancy_grid,
+    const autoware_auto_perception_msgs::msg::DetectedObject & object);
   void toPolygon2d(
     const autoware_auto_perception_msgs::msg::DetectedObject & object,
     std::vector<cv::Point2f> & vertices);
@@ -17,10 +17,6 @@
 #include <perception_utils/perception_utils.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
-#include <pcl/filters/crop_hull.h>
-#include <pcl/kdtree/kdtree_flann.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/search/pcl_search.h>
 #include <pcl_conversions/pcl_conversions.h>
 
 #ifdef ROS_DISTRO_GALACTIC
@@ -33,6 +29,10 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
+#include <algorithm>
+#include <optional>
+#include <vector>
+
 namespace
 {
 inline pcl::PointXY toPCL(const double x, const double y)
@@ -43,27 +43,29 @@ inline pcl::PointXY toPCL(const double x, const double y)
   return pcl_point;
 }
 
-inline pcl::PointXY toPCL(const geometry_msgs::msg::Point & point)
-{
-  return toPCL(point.x, point.y);
-}
-
 inline pcl::PointXYZ toXYZ(const pcl::PointXY & point)
 {
   return pcl::PointXYZ(point.x, point.y, 0.0);
 }
 
-inline pcl::PointCloud<pcl::PointXYZ>::Ptr toXYZ(
-  const pcl::PointCloud<pcl::PointXY>::Ptr & pointcloud)
+// crossing number test, as pcl::CropHull does in 2D
+bool isWithinPolygon(const pcl::PointXY & point, const pcl::PointCloud<pcl::PointXY> & polygon)
 {
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_xyz(new pcl::PointCloud<pcl::PointXYZ>);
-  pointcloud_xyz->reserve(pointcloud->size());
-  for (const auto & point : *pointcloud) {
-    pointcloud_xyz->push_back(toXYZ(point));
+  bool is_within = false;
+  for (size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const auto & p0 = polygon[i];
+    const auto & p1 = polygon[j];
+    if (
+      (p0.y > point.y) != (p1.y > point.y) &&
+      point.x < (p1.x - p0.x) * (point.y - p0.y) / (p1.y - p0.y) + p0.x) {
+      is_within = !is_within;
+    }
   }
-  return pointcloud_xyz;
+  return is_within;
 }
 
+// cells about the size of a car, for the points of an object to span a few of them
+constexpr float pointcloud_grid_cell_size = 2.0f;
 }  // namespace
 
 namespace obstacle_pointcloud_based_validator
@@ -90,6 +92,7 @@ ObstaclePointCloudBasedValidator::ObstaclePointCloudBasedValidator(
     "~/output/objects", rclcpp::QoS{1});
 
   min_pointcloud_num_ = declare_parameter<int>("min_pointcloud_num", 10);
+  num_threads_ = std::max(static_cast<int>(declare_parameter<int>("num_threads", 1)), 1);
 
   const bool enable_debugger = declare_parameter<bool>("enable_debugger", false);
   if (enable_debugger) debugger_ = std::make_shared<Debugger>(this);
@@ -121,34 +124,36 @@ void ObstaclePointCloudBasedValidator::onObjectsAndObstaclePointCloud(
     return;
   }
 
-  // Create Kd-tree to search neighbor pointcloud to reduce cost.
-  pcl::search::Search<pcl::PointXY>::Ptr kdtree =
-    pcl::make_shared<pcl::search::KdTree<pcl::PointXY>>(false);
-  kdtree->setInputCloud(obstacle_pointcloud);
+  // Index the pointcloud in a grid once, so the objects only visit the cells around them.
+  const PointCloudGrid pointcloud_grid(*obstacle_pointcloud, pointcloud_grid_cell_size);
 
-  for (size_t i = 0; i < transformed_objects.objects.size(); ++i) {
-    const auto & transformed_object = transformed_objects.objects.at(i);
-    const auto & object = input_objects->objects.at(i);
-    const auto search_radius = getMaxRadius(transformed_object);
-    if (!search_radius) {
-      output.objects.push_back(object);
-      continue;
-    }
+  const size_t num_objects = transformed_objects.objects.size();
+  std::vector<std::optional<size_t>> pointcloud_nums(num_objects);
+  std::vector<pcl::PointCloud<pcl::PointXY>::Ptr> neighbor_pointclouds;
+  std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> pointclouds_within_polygon;
+  if (debugger_) {
+    neighbor_pointclouds.resize(num_objects);
+    pointclouds_within_polygon.resize(num_objects);
+  }
+
+  // The objects are independent, and the debug points are kept per object to be added in order.
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+  for (size_t i = 0; i < num_objects; ++i) {
+    pointcloud_nums.at(i) = getPointCloudNumWithinPolygon(
+      transformed_objects.objects.at(i), pointcloud_grid,
+      debugger_ ? &neighbor_pointclouds.at(i) : nullptr,
+      debugger_ ? &pointclouds_within_polygon.at(i) : nullptr);
+  }
 
-    // Search neighbor pointcloud to reduce cost.
-    pcl::PointCloud<pcl::PointXY>::Ptr neighbor_pointcloud(new pcl::PointCloud<pcl::PointXY>);
-    std::vector<int> indices;
-    std::vector<float> distances;
-    kdtree->radiusSearch(
-      toPCL(transformed_object.kinematics.pose_with_covariance.pose.position),
-      search_radius.value(), indices, distances);
-    for (const auto & index : indices) {
-      neighbor_pointcloud->push_back(obstacle_pointcloud->at(index));
+  for (size_t i = 0; i < num_objects; ++i) {
+    const auto & object = input_objects->objects.at(i);
+    if (debugger_ && neighbor_pointclouds.at(i)) {
+      debugger_->addNeighborPointcloud(neighbor_pointclouds.at(i));
+      debugger_->addPointcloudWithinPolygon(pointclouds_within_polygon.at(i));
     }
-    if (debugger_) debugger_->addNeighborPointcloud(neighbor_pointcloud);
 
     // Filter object that have few pointcloud in them.
-    const auto num = getPointCloudNumWithinPolygon(transformed_object, neighbor_pointcloud);
+    const auto & num = pointcloud_nums.at(i);
     if (num) {
       if (min_pointcloud_num_ <= num.value())
         output.objects.push_back(object);
@@ -169,29 +174,52 @@ void ObstaclePointCloudBasedValidator::onObjectsAndObstaclePointCloud(
 
 std::optional<size_t> ObstaclePointCloudBasedValidator::getPointCloudNumWithinPolygon(
   const autoware_auto_perception_msgs::msg::DetectedObject & object,
-  const pcl::PointCloud<pcl::PointXY>::Ptr pointcloud)
+  const PointCloudGrid & pointcloud_grid,
+  pcl::PointCloud<pcl::PointXY>::Ptr * neighbor_pointcloud,
+  pcl::PointCloud<pcl::PointXYZ>::Ptr * pointcloud_within_polygon)
 {
-  pcl::PointCloud<pcl::PointXY>::Ptr polygon(new pcl::PointCloud<pcl::PointXY>);
-  pcl::PointCloud<pcl::PointXYZ>::Ptr cropped_pointcloud(new pcl::PointCloud<pcl::PointXYZ>);
-  std::vector<pcl::Vertices> vertices_array;
-  pcl::Vertices vertices;
+  if (!getMaxRadius(object)) return std::nullopt;
 
+  pcl::PointCloud<pcl::PointXY>::Ptr polygon(new pcl::PointCloud<pcl::PointXY>);
   toPolygon2d(object, polygon);
   if (polygon->empty()) return std::nullopt;
 
-  for (size_t i = 0; i < polygon->size(); ++i) vertices.vertices.push_back(i);
-  vertices_array.push_back(vertices);
+  // Cull the points by the bounding box of the footprint before the polygon test.
+  float min_x = polygon->front().x;
+  float min_y = polygon->front().y;
+  float max_x = polygon->front().x;
+  float max_y = polygon->front().y;
+  for (const auto & vertex : *polygon) {
+    min_x = std::min(min_x, vertex.x);
+    min_y = std::min(min_y, vertex.y);
+    max_x = std::max(max_x, vertex.x);
+    max_y = std::max(max_y, vertex.y);
+  }
 
-  pcl::CropHull<pcl::PointXYZ> cropper;  // don't be implemented PointXY by PCL
-  cropper.setInputCloud(toXYZ(pointcloud));
-  cropper.setDim(2);
-  cropper.setHullIndices(vertices_array);
-  cropper.setHullCloud(toXYZ(polygon));
-  cropper.setCropOutside(true);
-  cropper.filter(*cropped_pointcloud);
+  if (neighbor_pointcloud) {
+    *neighbor_pointcloud = pcl::make_shared<pcl::PointCloud<pcl::PointXY>>();
+    *pointcloud_within_polygon = pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
+  }
 
-  if (debugger_) debugger_->addPointcloudWithinPolygon(cropped_pointcloud);
-  return cropped_pointcloud->size();
+  // The count only decides against the threshold, so it stops there unless debugging.
+  size_t num = 0;
+  pointcloud_grid.forEachPointInBox(
+    min_x, min_y, max_x, max_y, [&](const pcl::PointXY & point) {
+      if (point.x < min_x || max_x < point.x || point.y < min_y || max_y < point.y) {
+        return true;
+      }
+      if (neighbor_pointcloud) (*neighbor_pointcloud)->push_back(point);
+      if (!isWithinPolygon(point, *polygon)) {
+        return true;
+      }
+      ++num;
+      if (neighbor_pointcloud) {
+        (*pointcloud_within_polygon)->push_back(toXYZ(point));
+        return true;
+      }
+      return num < min_pointcloud_num_;
+    });
+  return num;
 }
 
 void ObstaclePointCloudBasedValidator::toPolygon2d(
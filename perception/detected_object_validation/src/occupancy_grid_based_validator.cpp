@@ -19,6 +19,9 @@
 
 #include <boost/optional.hpp>
 
+#include <algorithm>
+#include <vector>
+
 #ifdef ROS_DISTRO_GALACTIC
 #include <tf2_geometry_msgs/tf2_geometry_msgs.h>
 #else
@@ -68,6 +71,8 @@ void OccupancyGridBasedValidator::onObjectsAndOccGrid(
 
   // Convert ros data type to cv::Mat
   cv::Mat occ_grid = fromOccupancyGrid(*input_occ_grid);
+  cv::Mat occ_grid_integral;
+  cv::integral(occ_grid, occ_grid_integral, CV_64F);
 
   // Get vehicle mask image and calculate mean within mask.
   for (size_t i = 0; i < transformed_objects.objects.size(); ++i) {
@@ -77,8 +82,9 @@ void OccupancyGridBasedValidator::onObjectsAndOccGrid(
     const bool is_vehicle = Label::CAR == label || Label::TRUCK == label || Label::BUS == label ||
                             Label::TRAILER == label;
     if (is_vehicle) {
-      auto mask = getMask(*input_occ_grid, transformed_object);
-      const float mean = mask ? cv::mean(occ_grid, mask.value())[0] * 0.01 : 1.0;
+      const auto mean_within_mask =
+        getMeanWithinMask(*input_occ_grid, occ_grid, occ_grid_integral, transformed_object);
+      const float mean = mean_within_mask ? mean_within_mask.value() * 0.01 : 1.0;
       if (mean_threshold_ < mean) output.objects.push_back(object);
     } else {
       output.objects.push_back(object);
@@ -90,20 +96,71 @@ void OccupancyGridBasedValidator::onObjectsAndOccGrid(
   if (enable_debug_) showDebugImage(*input_occ_grid, transformed_objects, occ_grid);
 }
 
-std::optional<cv::Mat> OccupancyGridBasedValidator::getMask(
-  const nav_msgs::msg::OccupancyGrid & occupancy_grid,
+std::optional<float> OccupancyGridBasedValidator::getMeanWithinMask(
+  const nav_msgs::msg::OccupancyGrid & occupancy_grid, const cv::Mat & occ_grid,
+  const cv::Mat & occ_grid_integral,
   const autoware_auto_perception_msgs::msg::DetectedObject & object)
 {
-  cv::Mat mask = cv::Mat::zeros(occupancy_grid.info.height, occupancy_grid.info.width, CV_8UC1);
-  return getMask(occupancy_grid, object, mask);
+  const auto pixel_vertices = toPixelVertices(occupancy_grid, object);
+  if (!pixel_vertices) return std::nullopt;
+
+  // The polygon is filled with its boundary, so it covers its whole bounding rect when its
+  // vertices are the corners of the rect, and then the sum is read from the integral image.
+  const cv::Rect rect = cv::boundingRect(pixel_vertices.value());
+  const int right = rect.x + rect.width - 1;
+  const int bottom = rect.y + rect.height - 1;
+  int corner_flags = 0;
+  bool is_vertex_on_corners = true;
+  for (const auto & vertex : pixel_vertices.value()) {
+    const bool is_left = vertex.x == rect.x;
+    const bool is_right = vertex.x == right;
+    const bool is_top = vertex.y == rect.y;
+    const bool is_bottom = vertex.y == bottom;
+    is_vertex_on_corners &= (is_left || is_right) && (is_top || is_bottom);
+    corner_flags |= (is_left && is_top) << 0 | (is_right && is_top) << 1 |
+                    (is_right && is_bottom) << 2 | (is_left && is_bottom) << 3;
+  }
+  if (is_vertex_on_corners && corner_flags == 0b1111) {
+    const auto & integral = occ_grid_integral;
+    const int x0 = rect.x;
+    const int y0 = rect.y;
+    const int x1 = rect.x + rect.width;
+    const int y1 = rect.y + rect.height;
+    const double sum = integral.at<double>(y1, x1) - integral.at<double>(y0, x1) -
+                       integral.at<double>(y1, x0) + integral.at<double>(y0, x0);
+    return sum / rect.area();
+  }
+
+  // Otherwise the mask only spans the bounding rect, with the polygon moved into it.
+  std::vector<cv::Point> roi_vertices;
+  roi_vertices.reserve(pixel_vertices->size());
+  for (const auto & vertex : pixel_vertices.value()) {
+    roi_vertices.push_back(vertex - rect.tl());
+  }
+  cv::Mat roi_mask = cv::Mat::zeros(rect.size(), CV_8UC1);
+  cv::fillConvexPoly(roi_mask, roi_vertices, cv::Scalar(255));
+  return cv::mean(occ_grid(rect), roi_mask)[0];
 }
 
 std::optional<cv::Mat> OccupancyGridBasedValidator::getMask(
   const nav_msgs::msg::OccupancyGrid & occupancy_grid,
   const autoware_auto_perception_msgs::msg::DetectedObject & object, cv::Mat mask)
+{
+  const auto pixel_vertices = toPixelVertices(occupancy_grid, object);
+  if (!pixel_vertices) return std::nullopt;
+
+  cv::fillConvexPoly(mask, pixel_vertices.value(), cv::Scalar(255));
+  return mask;
+}
+
+std::optional<std::vector<cv::Point>> OccupancyGridBasedValidator::toPixelVertices(
+  const nav_msgs::msg::OccupancyGrid & occupancy_grid,
+  const autoware_auto_perception_msgs::msg::DetectedObject & object)
 {
   const auto & resolution = occupancy_grid.info.resolution;
   const auto & origin = occupancy_grid.info.origin;
+  const auto & width = occupancy_grid.info.width;
+  const auto & height = occupancy_grid.info.height;
   std::vector<cv::Point2f> vertices;
   std::vector<cv::Point> pixel_vertices;
   toPolygon2d(object, vertices);
@@ -112,7 +169,7 @@ std::optional<cv::Mat> OccupancyGridBasedValidator::getMask(
   for (const auto & vertex : vertices) {
     const float px = (vertex.x - origin.position.x) / resolution;
     const float py = (vertex.y - origin.position.y) / resolution;
-    const bool is_point_within_image = (0 <= px && px < mask.cols && 0 <= py && py < mask.rows);
+    const bool is_point_within_image = (0 <= px && px < width && 0 <= py && py < height);
 
     if (!is_point_within_image) is_polygon_within_image = false;
 
@@ -120,8 +177,7 @@ std::optional<cv::Mat> OccupancyGridBasedValidator::getMask(
   }
 
   if (is_polygon_within_image && !pixel_vertices.empty()) {
-    cv::fillConvexPoly(mask, pixel_vertices, cv::Scalar(255));
-    return mask;
+    return pixel_vertices;
   } else {
     return std::nullopt;
   }
@@ -181,6 +237,8 @@ void OccupancyGridBasedValidator::showDebugImage(
   cv::namedWindow("passed_objects_image", cv::WINDOW_NORMAL);
   cv::Mat removed_objects_image = occ_grid.clone();
   cv::Mat passed_objects_image = occ_grid.clone();
+  cv::Mat occ_grid_integral;
+  cv::integral(occ_grid, occ_grid_integral, CV_64F);
 
   // Get vehicle mask image and calculate mean within mask.
   for (size_t i = 0; i < objects.objects.size(); ++i) {
@@ -189,8 +247,9 @@ void OccupancyGridBasedValidator::showDebugImage(
     const bool is_vehicle = Label::CAR == label || Label::TRUCK == label || Label::BUS == label ||
                             Label::TRAILER == label;
     if (is_vehicle) {
-      auto mask = getMask(ros_occ_grid, object);
-      const float mean = mask ? cv::mean(occ_grid, mask.value())[0] * 0.01 : 1.0;
+      const auto mean_within_mask =
+        getMeanWithinMask(ros_occ_grid, occ_grid, occ_grid_integral, object);
+      const float mean = mean_within_mask ? mean_within_mask.value() * 0.01 : 1.0;
       if (mean_threshold_ < mean) {
         auto mask = getMask(ros_occ_grid, object, passed_objects_image);
         if (mask) passed_objects_image = mask.value();
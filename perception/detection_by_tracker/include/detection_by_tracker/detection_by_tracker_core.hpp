@@ -60,6 +60,28 @@ public:
     const rclcpp::Time & time, autoware_auto_perception_msgs::msg::TrackedObjects & output);
 };
 
+// A grid of the footprint bounding boxes of the clusters, so that a tracker only checks the
+// clusters which may overlap it
+class ClusterGrid
+{
+public:
+  ClusterGrid(
+    const tier4_perception_msgs::msg::DetectedObjectsWithFeature & clusters,
+    const double cell_size);
+
+  // the indices of the clusters whose bounding box intersects box, in ascending order
+  void query(const tier4_autoware_utils::Box2d & box, std::vector<std::size_t> & indices) const;
+
+private:
+  double cell_size_;
+  double min_x_{0.0};
+  double min_y_{0.0};
+  int width_{0};
+  int height_{0};
+  std::vector<tier4_autoware_utils::Box2d> boxes_;
+  std::vector<std::vector<std::size_t>> cells_;
+};
+
 class DetectionByTracker : public rclcpp::Node
 {
 public:
@@ -87,6 +109,7 @@ private:
   void divideUnderSegmentedObjects(
     const autoware_auto_perception_msgs::msg::DetectedObjects & tracked_objects,
     const tier4_perception_msgs::msg::DetectedObjectsWithFeature & in_objects,
+    const ClusterGrid & cluster_grid,
     autoware_auto_perception_msgs::msg::DetectedObjects & out_no_found_tracked_objects,
     tier4_perception_msgs::msg::DetectedObjectsWithFeature & out_objects);
 
@@ -98,6 +121,7 @@ private:
   void mergeOverSegmentedObjects(
     const autoware_auto_perception_msgs::msg::DetectedObjects & tracked_objects,
     const tier4_perception_msgs::msg::DetectedObjectsWithFeature & in_objects,
+    const ClusterGrid & cluster_grid,
     autoware_auto_perception_msgs::msg::DetectedObjects & out_no_found_tracked_objects,
     tier4_perception_msgs::msg::DetectedObjectsWithFeature & out_objects);
 };
@@ -16,7 +16,9 @@
 
 #include "perception_utils/perception_utils.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <memory>
 #include <optional>
 #include <string>
@@ -53,6 +55,13 @@ autoware_auto_perception_msgs::msg::Shape extendShape(
   return output;
 }
 
+template <class T>
+tier4_autoware_utils::Box2d getFootprintBox(const T & object)
+{
+  return boost::geometry::return_envelope<tier4_autoware_utils::Box2d>(
+    tier4_autoware_utils::toPolygon2d(object.kinematics.pose_with_covariance.pose, object.shape));
+}
+
 boost::optional<ReferenceYawInfo> getReferenceYawInfo(const uint8_t label, const float yaw)
 {
   const bool is_vehicle =
@@ -129,6 +138,76 @@ bool TrackerHandler::estimateTrackedObjects(
   return true;
 }
 
+ClusterGrid::ClusterGrid(
+  const tier4_perception_msgs::msg::DetectedObjectsWithFeature & clusters, const double cell_size)
+: cell_size_(cell_size)
+{
+  boxes_.reserve(clusters.feature_objects.size());
+  for (const auto & cluster : clusters.feature_objects) {
+    boxes_.push_back(getFootprintBox(cluster.object));
+  }
+  if (boxes_.empty()) {
+    return;
+  }
+  auto bounds = boxes_.front();
+  for (const auto & box : boxes_) {
+    boost::geometry::expand(bounds, box);
+  }
+  min_x_ = bounds.min_corner().x();
+  min_y_ = bounds.min_corner().y();
+  width_ = static_cast<int>((bounds.max_corner().x() - min_x_) / cell_size_) + 1;
+  height_ = static_cast<int>((bounds.max_corner().y() - min_y_) / cell_size_) + 1;
+  cells_.resize(static_cast<std::size_t>(width_) * height_);
+
+  // a cluster is registered in every cell its bounding box overlaps
+  for (std::size_t i = 0; i < boxes_.size(); ++i) {
+    const auto & box = boxes_.at(i);
+    const int min_cell_x = static_cast<int>((box.min_corner().x() - min_x_) / cell_size_);
+    const int min_cell_y = static_cast<int>((box.min_corner().y() - min_y_) / cell_size_);
+    const int max_cell_x = static_cast<int>((box.max_corner().x() - min_x_) / cell_size_);
+    const int max_cell_y = static_cast<int>((box.max_corner().y() - min_y_) / cell_size_);
+    for (int cell_y = min_cell_y; cell_y <= max_cell_y; ++cell_y) {
+      for (int cell_x = min_cell_x; cell_x <= max_cell_x; ++cell_x) {
+        cells_.at(cell_y * width_ + cell_x).push_back(i);
+      }
+    }
+  }
+}
+
+void ClusterGrid::query(
+  const tier4_autoware_utils::Box2d & box, std::vector<std::size_t> & indices) const
+{
+  indices.clear();
+  if (cells_.empty()) {
+    return;
+  }
+  const auto to_cell = [this](const double value, const double min, const int size) {
+    return std::clamp(static_cast<int>(std::floor((value - min) / cell_size_)), 0, size - 1);
+  };
+  if (
+    box.max_corner().x() < min_x_ || box.max_corner().y() < min_y_ ||
+    min_x_ + width_ * cell_size_ < box.min_corner().x() ||
+    min_y_ + height_ * cell_size_ < box.min_corner().y()) {
+    return;
+  }
+  const int min_cell_x = to_cell(box.min_corner().x(), min_x_, width_);
+  const int min_cell_y = to_cell(box.min_corner().y(), min_y_, height_);
+  const int max_cell_x = to_cell(box.max_corner().x(), min_x_, width_);
+  const int max_cell_y = to_cell(box.max_corner().y(), min_y_, height_);
+  for (int cell_y = min_cell_y; cell_y <= max_cell_y; ++cell_y) {
+    for (int cell_x = min_cell_x; cell_x <= max_cell_x; ++cell_x) {
+      for (const auto i : cells_.at(cell_y * width_ + cell_x)) {
+        if (boost::geometry::intersects(boxes_.at(i), box)) {
+          indices.push_back(i);
+        }
+      }
+    }
+  }
+  // the clusters in several cells are found several times, and are checked in the input order
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+}
+
 DetectionByTracker::DetectionByTracker(const rclcpp::NodeOptions & node_options)
 : rclcpp::Node("detection_by_tracker", node_options),
   tf_buffer_(this->get_clock()),
@@ -178,17 +257,23 @@ void DetectionByTracker::onObjects(
   debugger_->publishInitialObjects(*input_msg);
   debugger_->publishTrackedObjects(tracked_objects);
 
+  // the clusters not overlapping a tracker are neither merged nor divided for it
+  constexpr double cluster_grid_cell_size = 2.0;
+  const ClusterGrid cluster_grid(*input_msg, cluster_grid_cell_size);
+
   // merge over segmented objects
   tier4_perception_msgs::msg::DetectedObjectsWithFeature merged_objects;
   autoware_auto_perception_msgs::msg::DetectedObjects no_found_tracked_objects;
-  mergeOverSegmentedObjects(tracked_objects, *input_msg, no_found_tracked_objects, merged_objects);
+  mergeOverSegmentedObjects(
+    tracked_objects, *input_msg, cluster_grid, no_found_tracked_objects, merged_objects);
   debugger_->publishMergedObjects(merged_objects);
 
   // divide under segmented objects
   tier4_perception_msgs::msg::DetectedObjectsWithFeature divided_objects;
   autoware_auto_perception_msgs::msg::DetectedObjects temp_no_found_tracked_objects;
   divideUnderSegmentedObjects(
-    no_found_tracked_objects, *input_msg, temp_no_found_tracked_objects, divided_objects);
+    no_found_tracked_objects, *input_msg, cluster_grid, temp_no_found_tracked_objects,
+    divided_objects);
   debugger_->publishDividedObjects(divided_objects);
 
   // merge under/over segmented objects to build output objects
@@ -205,6 +290,7 @@ void DetectionByTracker::onObjects(
 void DetectionByTracker::divideUnderSegmentedObjects(
   const autoware_auto_perception_msgs::msg::DetectedObjects & tracked_objects,
   const tier4_perception_msgs::msg::DetectedObjectsWithFeature & in_cluster_objects,
+  const ClusterGrid & cluster_grid,
   autoware_auto_perception_msgs::msg::DetectedObjects & out_no_found_tracked_objects,
   tier4_perception_msgs::msg::DetectedObjectsWithFeature & out_objects)
 {
@@ -216,6 +302,7 @@ void DetectionByTracker::divideUnderSegmentedObjects(
   out_objects.header = in_cluster_objects.header;
   out_no_found_tracked_objects.header = tracked_objects.header;
 
+  std::vector<std::size_t> cluster_indices;
   for (const auto & tracked_object : tracked_objects.objects) {
     const auto & label = tracked_object.classification.front().label;
     if (ignore_unknown_tracker_ && (label == Label::UNKNOWN)) continue;
@@ -224,7 +311,10 @@ void DetectionByTracker::divideUnderSegmentedObjects(
       highest_score_divided_object = std::nullopt;
     float highest_score = 0.0;
 
-    for (const auto & initial_object : in_cluster_objects.feature_objects) {
+    // the recall of a cluster not overlapping the tracker is 0
+    cluster_grid.query(getFootprintBox(tracked_object), cluster_indices);
+    for (const auto cluster_i : cluster_indices) {
+      const auto & initial_object = in_cluster_objects.feature_objects.at(cluster_i);
       // search near object
       const float distance = tier4_autoware_utils::calcDistance2d(
         tracked_object.kinematics.pose_with_covariance.pose,
@@ -340,6 +430,7 @@ float DetectionByTracker::optimizeUnderSegmentedObject(
 void DetectionByTracker::mergeOverSegmentedObjects(
   const autoware_auto_perception_msgs::msg::DetectedObjects & tracked_objects,
   const tier4_perception_msgs::msg::DetectedObjectsWithFeature & in_cluster_objects,
+  const ClusterGrid & cluster_grid,
   autoware_auto_perception_msgs::msg::DetectedObjects & out_no_found_tracked_objects,
   tier4_perception_msgs::msg::DetectedObjectsWithFeature & out_objects)
 {
@@ -348,6 +439,7 @@ void DetectionByTracker::mergeOverSegmentedObjects(
   out_objects.header = in_cluster_objects.header;
   out_no_found_tracked_objects.header = tracked_objects.header;
 
+  std::vector<std::size_t> cluster_indices;
   for (const auto & tracked_object : tracked_objects.objects) {
     const auto & label = tracked_object.classification.front().label;
     if (ignore_unknown_tracker_ && (label == Label::UNKNOWN)) continue;
@@ -356,8 +448,11 @@ void DetectionByTracker::mergeOverSegmentedObjects(
     autoware_auto_perception_msgs::msg::DetectedObject extended_tracked_object = tracked_object;
     extended_tracked_object.shape = extendShape(tracked_object.shape, /*scale*/ 1.1);
 
+    // the precision of a cluster not overlapping the extended tracker is 0
     pcl::PointCloud<pcl::PointXYZ> pcl_merged_cluster;
-    for (const auto & initial_object : in_cluster_objects.feature_objects) {
+    cluster_grid.query(getFootprintBox(extended_tracked_object), cluster_indices);
+    for (const auto cluster_i : cluster_indices) {
+      const auto & initial_object = in_cluster_objects.feature_objects.at(cluster_i);
       const float distance = tier4_autoware_utils::calcDistance2d(
         tracked_object.kinematics.pose_with_covariance.pose,
         initial_object.object.kinematics.pose_with_covariance.pose);
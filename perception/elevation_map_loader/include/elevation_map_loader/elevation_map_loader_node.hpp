@@ -31,6 +31,7 @@
 #include <pcl/pcl_base.h>
 #include <pcl/point_types.h>
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <string>
@@ -74,6 +75,11 @@ private:
   void createElevationMap();
   void setVerbosityLevelToDebugIfFlagSet();
   void createElevationMapFromPointcloud();
+  void createTiledElevationMap(const pcl::PointCloud<pcl::PointXYZ>::Ptr & input_cloud);
+  grid_map::GridMap createElevationMapTile(
+    const pcl::PointCloud<pcl::PointXYZ>::Ptr & tile_cloud,
+    const grid_map::Position & tile_center) const;
+  std::uint64_t getTileConfigHash() const;
   tier4_autoware_utils::LinearRing2d getConvexHull(
     const pcl::PointCloud<pcl::PointXYZ>::Ptr & input_cloud);
   lanelet::ConstLanelets getIntersectedLanelets(
@@ -84,7 +90,7 @@ private:
     const pcl::PointCloud<pcl::PointXYZ>::Ptr & cloud);
   bool checkPointWithinLanelets(
     const pcl::PointXYZ & point, const lanelet::ConstLanelets & joint_lanelets);
-  void inpaintElevationMap(const float radius);
+  void inpaintElevationMap(grid_map::GridMap & elevation_map, const float radius) const;
   pcl::PointCloud<pcl::PointXYZ>::Ptr createPointcloudFromElevationMap();
   void saveElevationMap();
   float calculateDistancePointFromPlane(
@@ -94,9 +100,13 @@ private:
   std::string layer_name_;
   std::string map_frame_;
   std::string elevation_map_directory_;
+  std::string param_file_path_;
   bool use_inpaint_;
   float inpaint_radius_;
   bool use_elevation_map_cloud_publisher_;
+  bool use_tiled_elevation_map_;
+  double elevation_map_tile_size_;
+  double elevation_map_tile_margin_;
   pcl::shared_ptr<grid_map::GridMapPclLoader> grid_map_pcl_loader_;
 
   DataManager data_manager_;
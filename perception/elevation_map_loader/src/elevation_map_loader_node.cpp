@@ -34,8 +34,14 @@
 #include <pcl_conversions/pcl_conversions.h>
 #include <sensor_msgs/msg/point_cloud2.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -45,17 +51,58 @@
 #include <Eigen/Core>
 #include <Eigen/Geometry>
 
+namespace
+{
+std::uint64_t mixHash(std::uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+std::uint64_t hashString(const std::string & str)
+{
+  // FNV-1a, stable from one run to the next unlike std::hash
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const char c : str) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+std::uint64_t hashPoint(const pcl::PointXYZ & point)
+{
+  std::uint32_t x, y, z;
+  std::memcpy(&x, &point.x, sizeof(x));
+  std::memcpy(&y, &point.y, sizeof(y));
+  std::memcpy(&z, &point.z, sizeof(z));
+  return mixHash((static_cast<std::uint64_t>(x) << 32 | y) ^ mixHash(z));
+}
+
+std::uint64_t getTileKey(const std::int64_t tile_x, const std::int64_t tile_y)
+{
+  return (static_cast<std::uint64_t>(tile_x) << 32) ^
+         (static_cast<std::uint64_t>(tile_y) & 0xffffffff);
+}
+}  // namespace
+
 ElevationMapLoaderNode::ElevationMapLoaderNode(const rclcpp::NodeOptions & options)
 : Node("elevation_map_loader", options)
 {
   layer_name_ = this->declare_parameter("map_layer_name", std::string("elevation"));
-  std::string param_file_path = this->declare_parameter("param_file_path", "path_default");
+  param_file_path_ = this->declare_parameter("param_file_path", "path_default");
   map_frame_ = this->declare_parameter("map_frame", "map");
   use_inpaint_ = this->declare_parameter("use_inpaint", true);
   inpaint_radius_ = this->declare_parameter("inpaint_radius", 0.3);
   use_elevation_map_cloud_publisher_ =
     this->declare_parameter("use_elevation_map_cloud_publisher", false);
   elevation_map_directory_ = this->declare_parameter("elevation_map_directory", "path_default");
+  use_tiled_elevation_map_ = this->declare_parameter("use_tiled_elevation_map", false);
+  elevation_map_tile_size_ = this->declare_parameter("elevation_map_tile_size", 100.0);
+  elevation_map_tile_margin_ = this->declare_parameter("elevation_map_tile_margin", 5.0);
   const bool use_lane_filter = this->declare_parameter("use_lane_filter", false);
   data_manager_.use_lane_filter_ = use_lane_filter;
 
@@ -69,7 +116,7 @@ ElevationMapLoaderNode::ElevationMapLoaderNode(const rclcpp::NodeOptions & optio
   auto grid_map_logger = rclcpp::get_logger("grid_map_logger");
   grid_map_logger.set_level(rclcpp::Logger::Level::Error);
   grid_map_pcl_loader_ = pcl::make_shared<grid_map::GridMapPclLoader>(grid_map_logger);
-  grid_map_pcl_loader_->loadParameters(param_file_path);
+  grid_map_pcl_loader_->loadParameters(param_file_path_);
 
   rclcpp::QoS durable_qos{1};
   durable_qos.transient_local();
@@ -159,24 +206,220 @@ void ElevationMapLoaderNode::onVectorMap(
 
 void ElevationMapLoaderNode::createElevationMap()
 {
+  pcl::PointCloud<pcl::PointXYZ>::Ptr input_cloud = data_manager_.map_pcl_ptr_;
   if (lane_filter_.use_lane_filter_) {
     const auto convex_hull = getConvexHull(data_manager_.map_pcl_ptr_);
     lanelet::ConstLanelets intersected_lanelets =
       getIntersectedLanelets(convex_hull, lane_filter_.road_lanelets_);
-    pcl::PointCloud<pcl::PointXYZ>::Ptr lane_filtered_map_pcl_ptr =
-      getLaneFilteredPointCloud(intersected_lanelets, data_manager_.map_pcl_ptr_);
-    grid_map_pcl_loader_->setInputCloud(lane_filtered_map_pcl_ptr);
-  } else {
-    grid_map_pcl_loader_->setInputCloud(data_manager_.map_pcl_ptr_);
+    input_cloud = getLaneFilteredPointCloud(intersected_lanelets, data_manager_.map_pcl_ptr_);
   }
+  if (use_tiled_elevation_map_) {
+    createTiledElevationMap(input_cloud);
+    saveElevationMap();
+    return;
+  }
+  grid_map_pcl_loader_->setInputCloud(input_cloud);
   createElevationMapFromPointcloud();
   elevation_map_ = grid_map_pcl_loader_->getGridMap();
   if (use_inpaint_) {
-    inpaintElevationMap(inpaint_radius_);
+    inpaintElevationMap(elevation_map_, inpaint_radius_);
   }
   saveElevationMap();
 }
 
+void ElevationMapLoaderNode::createTiledElevationMap(
+  const pcl::PointCloud<pcl::PointXYZ>::Ptr & input_cloud)
+{
+  const auto start = std::chrono::high_resolution_clock::now();
+  const double tile_size = elevation_map_tile_size_;
+  const double margin = elevation_map_tile_margin_;
+
+  // every tile gets the points of its extent and of its margin, so that the tiles can be
+  // generated and inpainted independently without seams
+  struct Tile
+  {
+    std::int64_t x;
+    std::int64_t y;
+    pcl::PointCloud<pcl::PointXYZ>::Ptr cloud;
+    size_t core_point_num;
+    std::uint64_t point_hash;
+    std::filesystem::path path;
+    grid_map::GridMap map;
+  };
+  std::vector<Tile> tiles;
+  std::unordered_map<std::uint64_t, size_t> tile_indices;
+  for (const auto & point : input_cloud->points) {
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+      continue;
+    }
+    const auto core_x = static_cast<std::int64_t>(std::floor(point.x / tile_size));
+    const auto core_y = static_cast<std::int64_t>(std::floor(point.y / tile_size));
+    const auto min_x = static_cast<std::int64_t>(std::floor((point.x - margin) / tile_size));
+    const auto max_x = static_cast<std::int64_t>(std::floor((point.x + margin) / tile_size));
+    const auto min_y = static_cast<std::int64_t>(std::floor((point.y - margin) / tile_size));
+    const auto max_y = static_cast<std::int64_t>(std::floor((point.y + margin) / tile_size));
+    for (std::int64_t x = min_x; x <= max_x; ++x) {
+      for (std::int64_t y = min_y; y <= max_y; ++y) {
+        const auto itr = tile_indices.emplace(getTileKey(x, y), tiles.size()).first;
+        if (itr->second == tiles.size()) {
+          tiles.push_back(
+            Tile{x, y, pcl::make_shared<pcl::PointCloud<pcl::PointXYZ>>(), 0U, 0U, {}, {}});
+        }
+        auto & tile = tiles.at(itr->second);
+        tile.cloud->points.push_back(point);
+        tile.point_hash += hashPoint(point);
+        tile.core_point_num += x == core_x && y == core_y ? 1U : 0U;
+      }
+    }
+  }
+
+  // a tile is stored as <x>_<y>_<hash of its points and of the parameters>, so that only the
+  // tiles whose points changed are generated again
+  const std::filesystem::path tile_directory =
+    std::filesystem::path(elevation_map_directory_) / "tiles";
+  std::filesystem::create_directories(tile_directory);
+  const std::uint64_t config_hash = getTileConfigHash();
+  std::vector<size_t> generated_tile_indices;
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    auto & tile = tiles.at(i);
+    if (tile.core_point_num == 0U) {
+      continue;
+    }
+    tile.cloud->width = tile.cloud->points.size();
+    tile.cloud->height = 1;
+    const std::uint64_t hash =
+      mixHash(config_hash + tile.point_hash) ^ mixHash(tile.cloud->points.size());
+    std::stringstream name;
+    name << tile.x << "_" << tile.y << "_" << std::hex << std::setw(16) << std::setfill('0')
+         << hash;
+    tile.path = tile_directory / name.str();
+    if (
+      !std::filesystem::exists(tile.path) ||
+      !grid_map::GridMapRosConverter::loadFromBag(tile.path.string(), "elevation_map", tile.map)) {
+      generated_tile_indices.push_back(i);
+    }
+  }
+
+#pragma omp parallel for schedule(dynamic)
+  for (size_t i = 0; i < generated_tile_indices.size(); ++i) {
+    auto & tile = tiles.at(generated_tile_indices.at(i));
+    const grid_map::Position tile_center((tile.x + 0.5) * tile_size, (tile.y + 0.5) * tile_size);
+    tile.map = createElevationMapTile(tile.cloud, tile_center);
+  }
+
+  for (const size_t i : generated_tile_indices) {
+    const auto & tile = tiles.at(i);
+    // the tiles generated from the former points at this position are replaced
+    const std::string prefix = std::to_string(tile.x) + "_" + std::to_string(tile.y) + "_";
+    for (const auto & entry : std::filesystem::directory_iterator(tile_directory)) {
+      const std::string entry_name = entry.path().filename().string();
+      if (entry_name.rfind(prefix, 0) == 0 && entry.path() != tile.path) {
+        std::filesystem::remove_all(entry.path());
+      }
+    }
+    grid_map::GridMapRosConverter::saveToBag(tile.map, tile.path.string(), "elevation_map");
+  }
+
+  tiles.erase(
+    std::remove_if(
+      tiles.begin(), tiles.end(),
+      [](const Tile & tile) { return tile.core_point_num == 0U || tile.map.getLayers().empty(); }),
+    tiles.end());
+  tile_indices.clear();
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    tile_indices.emplace(getTileKey(tiles.at(i).x, tiles.at(i).y), i);
+  }
+  elevation_map_ = grid_map::GridMap({layer_name_});
+  if (tiles.empty()) {
+    RCLCPP_WARN(this->get_logger(), "No point to create the elevation map from");
+    return;
+  }
+
+  // assemble the tiles, whose cells are on the same lattice
+  std::int64_t min_x = tiles.front().x;
+  std::int64_t max_x = tiles.front().x;
+  std::int64_t min_y = tiles.front().y;
+  std::int64_t max_y = tiles.front().y;
+  for (const auto & tile : tiles) {
+    min_x = std::min(min_x, tile.x);
+    max_x = std::max(max_x, tile.x);
+    min_y = std::min(min_y, tile.y);
+    max_y = std::max(max_y, tile.y);
+  }
+  elevation_map_.setGeometry(
+    grid_map::Length((max_x - min_x + 1) * tile_size, (max_y - min_y + 1) * tile_size),
+    tiles.front().map.getResolution(),
+    grid_map::Position(
+      (min_x + max_x + 1) * tile_size / 2.0, (min_y + max_y + 1) * tile_size / 2.0));
+  auto & elevation = elevation_map_.get(layer_name_);
+  for (grid_map::GridMapIterator iterator(elevation_map_); !iterator.isPastEnd(); ++iterator) {
+    grid_map::Position position;
+    elevation_map_.getPosition(*iterator, position);
+    const auto itr = tile_indices.find(getTileKey(
+      static_cast<std::int64_t>(std::floor(position.x() / tile_size)),
+      static_cast<std::int64_t>(std::floor(position.y() / tile_size))));
+    if (itr == tile_indices.end()) {
+      continue;
+    }
+    const auto & tile_map = tiles.at(itr->second).map;
+    if (tile_map.isInside(position)) {
+      elevation((*iterator)(0), (*iterator)(1)) = tile_map.atPosition(layer_name_, position);
+    }
+  }
+
+  RCLCPP_INFO(
+    this->get_logger(), "Generated %zu of %zu elevation map tiles", generated_tile_indices.size(),
+    tiles.size());
+  grid_map::grid_map_pcl::printTimeElapsedToRosInfoStream(
+    start, "Finish creating tiled elevation map. Total time: ", this->get_logger());
+}
+
+grid_map::GridMap ElevationMapLoaderNode::createElevationMapTile(
+  const pcl::PointCloud<pcl::PointXYZ>::Ptr & tile_cloud,
+  const grid_map::Position & tile_center) const
+{
+  // a loader per tile, as the tiles are generated in parallel
+  auto grid_map_logger = rclcpp::get_logger("grid_map_logger");
+  grid_map_logger.set_level(rclcpp::Logger::Level::Error);
+  auto grid_map_pcl_loader = pcl::make_shared<grid_map::GridMapPclLoader>(grid_map_logger);
+  grid_map_pcl_loader->loadParameters(param_file_path_);
+  grid_map_pcl_loader->setInputCloud(tile_cloud);
+  grid_map_pcl_loader->preProcessInputCloud();
+  grid_map_pcl_loader->initializeGridMapGeometryFromInputCloud();
+  grid_map_pcl_loader->addLayerFromInputCloud(layer_name_);
+  const grid_map::GridMap & source_map = grid_map_pcl_loader->getGridMap();
+
+  // the loader fits the grid to the points, it is resampled on a lattice common to all tiles
+  const double length = elevation_map_tile_size_ + 2.0 * elevation_map_tile_margin_;
+  grid_map::GridMap tile_map({layer_name_});
+  tile_map.setGeometry(grid_map::Length(length, length), source_map.getResolution(), tile_center);
+  for (grid_map::GridMapIterator iterator(tile_map); !iterator.isPastEnd(); ++iterator) {
+    grid_map::Position position;
+    tile_map.getPosition(*iterator, position);
+    if (source_map.isInside(position)) {
+      tile_map.at(layer_name_, *iterator) = source_map.atPosition(layer_name_, position);
+    }
+  }
+  if (use_inpaint_) {
+    inpaintElevationMap(tile_map, inpaint_radius_);
+  }
+
+  bool is_success = false;
+  return tile_map.getSubmap(
+    tile_center, grid_map::Length(elevation_map_tile_size_, elevation_map_tile_size_),
+    is_success);
+}
+
+std::uint64_t ElevationMapLoaderNode::getTileConfigHash() const
+{
+  // the tiles depend on the GridMap parameters as well as on the points
+  std::ifstream param_file(param_file_path_);
+  std::stringstream config;
+  config << param_file.rdbuf() << layer_name_ << use_inpaint_ << inpaint_radius_
+         << elevation_map_tile_size_ << elevation_map_tile_margin_;
+  return hashString(config.str());
+}
+
 void ElevationMapLoaderNode::createElevationMapFromPointcloud()
 {
   const auto start = std::chrono::high_resolution_clock::now();
@@ -187,35 +430,36 @@ void ElevationMapLoaderNode::createElevationMapFromPointcloud()
     start, "Finish creating elevation map. Total time: ", this->get_logger());
 }
 
-void ElevationMapLoaderNode::inpaintElevationMap(const float radius)
+void ElevationMapLoaderNode::inpaintElevationMap(
+  grid_map::GridMap & elevation_map, const float radius) const
 {
   // Convert elevation layer to OpenCV image to fill in holes.
   // Get the inpaint mask (nonzero pixels indicate where values need to be filled in).
-  elevation_map_.add("inpaint_mask", 0.0);
+  elevation_map.add("inpaint_mask", 0.0);
 
-  elevation_map_.setBasicLayers(std::vector<std::string>());
-  for (grid_map::GridMapIterator iterator(elevation_map_); !iterator.isPastEnd(); ++iterator) {
-    if (!elevation_map_.isValid(*iterator, layer_name_)) {
-      elevation_map_.at("inpaint_mask", *iterator) = 1.0;
+  elevation_map.setBasicLayers(std::vector<std::string>());
+  for (grid_map::GridMapIterator iterator(elevation_map); !iterator.isPastEnd(); ++iterator) {
+    if (!elevation_map.isValid(*iterator, layer_name_)) {
+      elevation_map.at("inpaint_mask", *iterator) = 1.0;
     }
   }
   cv::Mat original_image;
   cv::Mat mask;
   cv::Mat filled_image;
-  const float min_value = elevation_map_.get(layer_name_).minCoeffOfFinites();
-  const float max_value = elevation_map_.get(layer_name_).maxCoeffOfFinites();
+  const float min_value = elevation_map.get(layer_name_).minCoeffOfFinites();
+  const float max_value = elevation_map.get(layer_name_).maxCoeffOfFinites();
 
   grid_map::GridMapCvConverter::toImage<unsigned char, 3>(
-    elevation_map_, layer_name_, CV_8UC3, min_value, max_value, original_image);
+    elevation_map, layer_name_, CV_8UC3, min_value, max_value, original_image);
   grid_map::GridMapCvConverter::toImage<unsigned char, 1>(
-    elevation_map_, "inpaint_mask", CV_8UC1, mask);
+    elevation_map, "inpaint_mask", CV_8UC1, mask);
 
-  const float radius_in_pixels = radius / elevation_map_.getResolution();
+  const float radius_in_pixels = radius / elevation_map.getResolution();
   cv::inpaint(original_image, mask, filled_image, radius_in_pixels, cv::INPAINT_NS);
 
   grid_map::GridMapCvConverter::addLayerFromImage<unsigned char, 3>(
-    filled_image, layer_name_, elevation_map_, min_value, max_value);
-  elevation_map_.erase("inpaint_mask");
+    filled_image, layer_name_, elevation_map, min_value, max_value);
+  elevation_map.erase("inpaint_mask");
 }
 
 tier4_autoware_utils::LinearRing2d ElevationMapLoaderNode::getConvexHull(
@@ -0,0 +1,58 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace euclidean_cluster
+{
+namespace cuda
+{
+struct VoxelGridClusteringParams
+{
+  float voxel_leaf_size;
+  float tolerance;
+  int min_points_number_per_voxel;
+};
+
+/** \brief Device side of VoxelGridBasedEuclideanCluster: the points are put into a hash of 2d
+ * voxels, and the voxels whose centroids are closer than the tolerance are connected by a
+ * lock-free union-find, one thread per voxel. Device buffers are reused across frames.
+ */
+class VoxelGridClustering
+{
+public:
+  VoxelGridClustering();
+  ~VoxelGridClustering();
+
+  /** \brief Label the points with the root voxel of their cluster.
+   * \param points x, y, z and a padding float per point, as pcl::PointXYZ
+   * \param point_roots root voxel of the cluster of each point, -1 for a point in no cluster
+   * \param point_root_voxel_nums number of voxels of the cluster of each point
+   * \return the number of voxel slots, which the roots are smaller than
+   */
+  std::size_t cluster(
+    const float * points, const std::size_t num_points, const VoxelGridClusteringParams & params,
+    std::vector<int32_t> & point_roots, std::vector<int32_t> & point_root_voxel_nums);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace cuda
+}  // namespace euclidean_cluster
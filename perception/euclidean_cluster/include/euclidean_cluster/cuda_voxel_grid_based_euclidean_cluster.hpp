@@ -0,0 +1,59 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "euclidean_cluster/cuda/voxel_grid_clustering.hpp"
+#include "euclidean_cluster/euclidean_cluster_interface.hpp"
+#include "euclidean_cluster/utils.hpp"
+
+#include <pcl/point_types.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace euclidean_cluster
+{
+/** \brief VoxelGridBasedEuclideanCluster with the voxel hash and the union-find on the GPU.
+ * The clusters are made of the same points and are output in the same order.
+ */
+class CudaVoxelGridBasedEuclideanCluster : public EuclideanClusterInterface
+{
+public:
+  CudaVoxelGridBasedEuclideanCluster();
+  CudaVoxelGridBasedEuclideanCluster(bool use_height, int min_cluster_size, int max_cluster_size);
+  CudaVoxelGridBasedEuclideanCluster(
+    bool use_height, int min_cluster_size, int max_cluster_size, float tolerance,
+    float voxel_leaf_size, int min_points_number_per_voxel);
+  bool cluster(
+    const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
+    std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters) override;
+  void setVoxelLeafSize(float voxel_leaf_size) { params_.voxel_leaf_size = voxel_leaf_size; }
+  void setTolerance(float tolerance) { params_.tolerance = tolerance; }
+  void setMinPointsNumberPerVoxel(int min_points_number_per_voxel)
+  {
+    params_.min_points_number_per_voxel = min_points_number_per_voxel;
+  }
+
+private:
+  cuda::VoxelGridClustering clustering_;
+  cuda::VoxelGridClusteringParams params_{0.0f, 0.0f, 0};
+
+  // reused across frames
+  std::vector<int32_t> point_roots_;
+  std::vector<int32_t> point_root_voxel_nums_;
+  std::vector<int> root_clusters_;
+};
+
+}  // namespace euclidean_cluster
@@ -17,9 +17,9 @@
 #include "euclidean_cluster/euclidean_cluster_interface.hpp"
 #include "euclidean_cluster/utils.hpp"
 
-#include <pcl/filters/voxel_grid.h>
 #include <pcl/point_types.h>
 
+#include <cstdint>
 #include <vector>
 
 namespace euclidean_cluster
@@ -43,7 +43,23 @@ public:
   }
 
 private:
-  pcl::VoxelGrid<pcl::PointXYZ> voxel_grid_;
+  /** \brief Returns the voxel at the grid coordinates, -1 if there is no point in it */
+  int findVoxel(const int32_t x, const int32_t y) const;
+  int insertVoxel(const int32_t x, const int32_t y);
+
+  // voxel hash, open addressing with linear probing, reused across frames
+  std::vector<uint64_t> voxel_hash_keys_;
+  std::vector<int> voxel_hash_values_;
+  uint64_t voxel_hash_mask_ = 0;
+  // voxels, the voxels span the whole height as the clustering is done on the xy plane
+  std::vector<int32_t> voxel_grid_x_;
+  std::vector<int32_t> voxel_grid_y_;
+  std::vector<int> voxel_point_nums_;
+  std::vector<double> voxel_sums_x_;
+  std::vector<double> voxel_sums_y_;
+  std::vector<int> point_voxels_;
+  std::vector<int> point_labels_;
+
   float tolerance_;
   float voxel_leaf_size_;
   int min_points_number_per_voxel_;
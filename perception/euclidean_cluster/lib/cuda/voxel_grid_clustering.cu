@@ -0,0 +1,352 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "euclidean_cluster/cuda/voxel_grid_clustering.hpp"
+
+#include <cuda_runtime_api.h>
+#include <thrust/device_vector.h>
+#include <thrust/execution_policy.h>
+#include <thrust/fill.h>
+#include <thrust/sequence.h>
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#define CHECK_CUDA_ERROR(e) (euclidean_cluster::cuda::checkError(e, __FILE__, __LINE__))
+
+namespace euclidean_cluster
+{
+namespace cuda
+{
+namespace
+{
+inline void checkError(const ::cudaError_t e, const char * f, int n)
+{
+  if (e != ::cudaSuccess) {
+    std::stringstream s;
+    s << ::cudaGetErrorName(e) << " (" << e << ")@" << f << "#L" << n << ": "
+      << ::cudaGetErrorString(e);
+    throw std::runtime_error{s.str()};
+  }
+}
+
+constexpr unsigned int threads_per_block = 256U;
+
+inline unsigned int numBlocks(const std::size_t n)
+{
+  return static_cast<unsigned int>((n + threads_per_block - 1U) / threads_per_block);
+}
+
+// grow-only device buffer, contents are not preserved
+template <typename T>
+T * reserve(thrust::device_vector<T> & buffer, const std::size_t size)
+{
+  if (buffer.size() < size) {
+    buffer.clear();
+    buffer.resize(size);
+  }
+  return thrust::raw_pointer_cast(buffer.data());
+}
+
+// same packing and hash as VoxelGridBasedEuclideanCluster, the grid coordinates of the empty key
+// are out of the range of the voxels
+__host__ __device__ inline uint64_t packGridCoordinates(const int32_t x, const int32_t y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+constexpr int32_t invalid_grid_coordinate = INT32_MIN;
+constexpr uint64_t empty_key =
+  (static_cast<uint64_t>(static_cast<uint32_t>(invalid_grid_coordinate)) << 32) |
+  static_cast<uint32_t>(invalid_grid_coordinate);
+
+__device__ inline uint64_t hashGridKey(const uint64_t key)
+{
+  return (key ^ (key >> 31)) * 0x9e3779b97f4a7c15ULL;
+}
+
+__device__ inline bool toGridCoordinate(
+  const float value, const float voxel_leaf_size, int32_t & coordinate)
+{
+  const float scaled = floorf(value / voxel_leaf_size);
+  if (!(fabsf(scaled) < 2147483648.0f) || scaled == static_cast<float>(invalid_grid_coordinate)) {
+    return false;
+  }
+  coordinate = static_cast<int32_t>(scaled);
+  return true;
+}
+
+__device__ inline bool isClusterVoxel(const int point_num, const int min_points_number_per_voxel)
+{
+  return point_num > 0 && point_num >= min_points_number_per_voxel;
+}
+
+struct VoxelHash
+{
+  unsigned long long * keys;  // NOLINT: the type of atomicCAS
+  uint64_t mask;
+
+  __device__ int find(const uint64_t key) const
+  {
+    for (uint64_t slot = hashGridKey(key) & mask;; slot = (slot + 1) & mask) {
+      const uint64_t slot_key = keys[slot];
+      if (slot_key == key) {
+        return static_cast<int>(slot);
+      }
+      if (slot_key == empty_key) {
+        return -1;
+      }
+    }
+  }
+
+  __device__ int insert(const uint64_t key) const
+  {
+    for (uint64_t slot = hashGridKey(key) & mask;; slot = (slot + 1) & mask) {
+      const uint64_t previous = atomicCAS(&keys[slot], empty_key, key);
+      if (previous == empty_key || previous == key) {
+        return static_cast<int>(slot);
+      }
+    }
+  }
+};
+
+// lock-free union-find, the roots are always linked under the smaller slot as on the host
+__device__ inline uint32_t findRoot(uint32_t * parents, uint32_t v)
+{
+  while (true) {
+    const uint32_t parent = *reinterpret_cast<volatile uint32_t *>(&parents[v]);
+    if (parent == v) {
+      return v;
+    }
+    const uint32_t grandparent = *reinterpret_cast<volatile uint32_t *>(&parents[parent]);
+    if (parent != grandparent) {  // path halving
+      atomicCAS(&parents[v], parent, grandparent);
+    }
+    v = grandparent;
+  }
+}
+
+__device__ inline void unite(uint32_t * parents, uint32_t a, uint32_t b)
+{
+  while (true) {
+    a = findRoot(parents, a);
+    b = findRoot(parents, b);
+    if (a == b) {
+      return;
+    }
+    if (a < b) {
+      const uint32_t swap = a;
+      a = b;
+      b = swap;
+    }
+    if (atomicCAS(&parents[a], a, b) == a) {
+      return;
+    }
+  }
+}
+
+// the sums are taken from the corner of the voxel, to keep the float precision of the centroids
+__global__ void insertPointsKernel(
+  const float4 * points, const std::size_t num_points, const float voxel_leaf_size,
+  const VoxelHash hash, int * point_slots, int * voxel_point_nums, float * voxel_sums_x,
+  float * voxel_sums_y)
+{
+  const std::size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= num_points) {
+    return;
+  }
+  const float4 point = points[i];
+  int32_t x;
+  int32_t y;
+  if (
+    !isfinite(point.x) || !isfinite(point.y) || !isfinite(point.z) ||
+    !toGridCoordinate(point.x, voxel_leaf_size, x) ||
+    !toGridCoordinate(point.y, voxel_leaf_size, y)) {
+    point_slots[i] = -1;
+    return;
+  }
+  const int slot = hash.insert(packGridCoordinates(x, y));
+  point_slots[i] = slot;
+  atomicAdd(&voxel_point_nums[slot], 1);
+  atomicAdd(&voxel_sums_x[slot], point.x - static_cast<float>(x) * voxel_leaf_size);
+  atomicAdd(&voxel_sums_y[slot], point.y - static_cast<float>(y) * voxel_leaf_size);
+}
+
+__global__ void computeCentroidsKernel(
+  const VoxelHash hash, const std::size_t num_slots, const float voxel_leaf_size,
+  const int * voxel_point_nums, float * voxel_sums_x, float * voxel_sums_y)
+{
+  const std::size_t slot = blockIdx.x * blockDim.x + threadIdx.x;
+  if (slot >= num_slots || voxel_point_nums[slot] == 0) {
+    return;
+  }
+  const uint64_t key = hash.keys[slot];
+  const auto x = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+  const auto y = static_cast<int32_t>(static_cast<uint32_t>(key));
+  voxel_sums_x[slot] =
+    static_cast<float>(x) * voxel_leaf_size + voxel_sums_x[slot] / voxel_point_nums[slot];
+  voxel_sums_y[slot] =
+    static_cast<float>(y) * voxel_leaf_size + voxel_sums_y[slot] / voxel_point_nums[slot];
+}
+
+__global__ void connectVoxelsKernel(
+  const VoxelHash hash, const std::size_t num_slots, const VoxelGridClusteringParams params,
+  const int range, const int * voxel_point_nums, const float * centroids_x,
+  const float * centroids_y, uint32_t * parents)
+{
+  const std::size_t slot = blockIdx.x * blockDim.x + threadIdx.x;
+  if (
+    slot >= num_slots ||
+    !isClusterVoxel(voxel_point_nums[slot], params.min_points_number_per_voxel)) {
+    return;
+  }
+  const uint64_t key = hash.keys[slot];
+  const auto x = static_cast<int32_t>(static_cast<uint32_t>(key >> 32));
+  const auto y = static_cast<int32_t>(static_cast<uint32_t>(key));
+  const float sqr_tolerance = params.tolerance * params.tolerance;
+
+  // every pair of voxels is checked once, from the voxel with the lower grid coordinates
+  for (int dx = 0; dx <= range; ++dx) {
+    for (int dy = dx == 0 ? 1 : -range; dy <= range; ++dy) {
+      const int u = hash.find(packGridCoordinates(x + dx, y + dy));
+      if (u < 0 || !isClusterVoxel(voxel_point_nums[u], params.min_points_number_per_voxel)) {
+        continue;
+      }
+      const float diff_x = centroids_x[u] - centroids_x[slot];
+      const float diff_y = centroids_y[u] - centroids_y[slot];
+      if (diff_x * diff_x + diff_y * diff_y < sqr_tolerance) {
+        unite(parents, static_cast<uint32_t>(u), static_cast<uint32_t>(slot));
+      }
+    }
+  }
+}
+
+__global__ void countClusterVoxelsKernel(
+  const std::size_t num_slots, const int * voxel_point_nums, const int min_points_number_per_voxel,
+  uint32_t * parents, int * root_voxel_nums)
+{
+  const std::size_t slot = blockIdx.x * blockDim.x + threadIdx.x;
+  if (slot >= num_slots || !isClusterVoxel(voxel_point_nums[slot], min_points_number_per_voxel)) {
+    return;
+  }
+  atomicAdd(&root_voxel_nums[findRoot(parents, static_cast<uint32_t>(slot))], 1);
+}
+
+__global__ void labelPointsKernel(
+  const std::size_t num_points, const int * point_slots, const int * voxel_point_nums,
+  const int min_points_number_per_voxel, uint32_t * parents, const int * root_voxel_nums,
+  int32_t * point_roots, int32_t * point_root_voxel_nums)
+{
+  const std::size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= num_points) {
+    return;
+  }
+  const int slot = point_slots[i];
+  if (slot < 0 || !isClusterVoxel(voxel_point_nums[slot], min_points_number_per_voxel)) {
+    point_roots[i] = -1;
+    point_root_voxel_nums[i] = 0;
+    return;
+  }
+  const uint32_t root = findRoot(parents, static_cast<uint32_t>(slot));
+  point_roots[i] = static_cast<int32_t>(root);
+  point_root_voxel_nums[i] = root_voxel_nums[root];
+}
+}  // namespace
+
+struct VoxelGridClustering::Impl
+{
+  thrust::device_vector<float4> points;
+  thrust::device_vector<int> point_slots;
+  thrust::device_vector<unsigned long long> keys;  // NOLINT: the type of atomicCAS
+  thrust::device_vector<int> voxel_point_nums;
+  thrust::device_vector<float> voxel_sums_x;
+  thrust::device_vector<float> voxel_sums_y;
+  thrust::device_vector<uint32_t> parents;
+  thrust::device_vector<int> root_voxel_nums;
+  thrust::device_vector<int32_t> point_roots;
+  thrust::device_vector<int32_t> point_root_voxel_nums;
+};
+
+VoxelGridClustering::VoxelGridClustering() : impl_(std::make_unique<Impl>()) {}
+
+VoxelGridClustering::~VoxelGridClustering() = default;
+
+std::size_t VoxelGridClustering::cluster(
+  const float * points, const std::size_t num_points, const VoxelGridClusteringParams & params,
+  std::vector<int32_t> & point_roots, std::vector<int32_t> & point_root_voxel_nums)
+{
+  point_roots.resize(num_points);
+  point_root_voxel_nums.resize(num_points);
+  if (num_points == 0) {
+    return 0;
+  }
+
+  // same capacity as the host hash, at most half full
+  std::size_t num_slots = 1;
+  while (num_slots < 2 * num_points) {
+    num_slots <<= 1;
+  }
+
+  auto * points_ptr = reserve(impl_->points, num_points);
+  CHECK_CUDA_ERROR(::cudaMemcpy(
+    points_ptr, points, num_points * sizeof(float4), ::cudaMemcpyHostToDevice));
+  auto * point_slots = reserve(impl_->point_slots, num_points);
+  VoxelHash hash{reserve(impl_->keys, num_slots), num_slots - 1};
+  auto * voxel_point_nums = reserve(impl_->voxel_point_nums, num_slots);
+  auto * voxel_sums_x = reserve(impl_->voxel_sums_x, num_slots);
+  auto * voxel_sums_y = reserve(impl_->voxel_sums_y, num_slots);
+  auto * parents = reserve(impl_->parents, num_slots);
+  auto * root_voxel_nums = reserve(impl_->root_voxel_nums, num_slots);
+  auto * point_roots_ptr = reserve(impl_->point_roots, num_points);
+  auto * point_root_voxel_nums_ptr = reserve(impl_->point_root_voxel_nums, num_points);
+
+  thrust::fill(thrust::device, hash.keys, hash.keys + num_slots, empty_key);
+  CHECK_CUDA_ERROR(::cudaMemset(voxel_point_nums, 0, num_slots * sizeof(int)));
+  CHECK_CUDA_ERROR(::cudaMemset(voxel_sums_x, 0, num_slots * sizeof(float)));
+  CHECK_CUDA_ERROR(::cudaMemset(voxel_sums_y, 0, num_slots * sizeof(float)));
+  CHECK_CUDA_ERROR(::cudaMemset(root_voxel_nums, 0, num_slots * sizeof(int)));
+  thrust::sequence(thrust::device, parents, parents + num_slots);
+
+  insertPointsKernel<<<numBlocks(num_points), threads_per_block>>>(
+    points_ptr, num_points, params.voxel_leaf_size, hash, point_slots, voxel_point_nums,
+    voxel_sums_x, voxel_sums_y);
+  CHECK_CUDA_ERROR(::cudaGetLastError());
+
+  computeCentroidsKernel<<<numBlocks(num_slots), threads_per_block>>>(
+    hash, num_slots, params.voxel_leaf_size, voxel_point_nums, voxel_sums_x, voxel_sums_y);
+  CHECK_CUDA_ERROR(::cudaGetLastError());
+
+  const int range = static_cast<int>(std::ceil(params.tolerance / params.voxel_leaf_size));
+  connectVoxelsKernel<<<numBlocks(num_slots), threads_per_block>>>(
+    hash, num_slots, params, range, voxel_point_nums, voxel_sums_x, voxel_sums_y, parents);
+  CHECK_CUDA_ERROR(::cudaGetLastError());
+
+  countClusterVoxelsKernel<<<numBlocks(num_slots), threads_per_block>>>(
+    num_slots, voxel_point_nums, params.min_points_number_per_voxel, parents, root_voxel_nums);
+  CHECK_CUDA_ERROR(::cudaGetLastError());
+
+  labelPointsKernel<<<numBlocks(num_points), threads_per_block>>>(
+    num_points, point_slots, voxel_point_nums, params.min_points_number_per_voxel, parents,
+    root_voxel_nums, point_roots_ptr, point_root_voxel_nums_ptr);
+  CHECK_CUDA_ERROR(::cudaGetLastError());
+
+  CHECK_CUDA_ERROR(::cudaMemcpy(
+    point_roots.data(), point_roots_ptr, num_points * sizeof(int32_t), ::cudaMemcpyDeviceToHost));
+  CHECK_CUDA_ERROR(::cudaMemcpy(
+    point_root_voxel_nums.data(), point_root_voxel_nums_ptr, num_points * sizeof(int32_t),
+    ::cudaMemcpyDeviceToHost));
+  return num_slots;
+}
+}  // namespace cuda
+}  // namespace euclidean_cluster
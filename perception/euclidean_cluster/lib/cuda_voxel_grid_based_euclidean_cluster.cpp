@@ -0,0 +1,89 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "euclidean_cluster/cuda_voxel_grid_based_euclidean_cluster.hpp"
+
+#include <vector>
+
+namespace euclidean_cluster
+{
+static_assert(
+  sizeof(pcl::PointXYZ) == 4 * sizeof(float), "the points are uploaded as float4 as they are");
+
+CudaVoxelGridBasedEuclideanCluster::CudaVoxelGridBasedEuclideanCluster() {}
+
+CudaVoxelGridBasedEuclideanCluster::CudaVoxelGridBasedEuclideanCluster(
+  bool use_height, int min_cluster_size, int max_cluster_size)
+: EuclideanClusterInterface(use_height, min_cluster_size, max_cluster_size)
+{
+}
+
+CudaVoxelGridBasedEuclideanCluster::CudaVoxelGridBasedEuclideanCluster(
+  bool use_height, int min_cluster_size, int max_cluster_size, float tolerance,
+  float voxel_leaf_size, int min_points_number_per_voxel)
+: EuclideanClusterInterface(use_height, min_cluster_size, max_cluster_size),
+  params_{voxel_leaf_size, tolerance, min_points_number_per_voxel}
+{
+}
+
+bool CudaVoxelGridBasedEuclideanCluster::cluster(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters)
+{
+  // TODO(Saito) implement use_height is false version
+
+  const auto point_num = pointcloud->points.size();
+  const auto slot_num = clustering_.cluster(
+    reinterpret_cast<const float *>(pointcloud->points.data()), point_num, params_, point_roots_,
+    point_root_voxel_nums_);
+
+  // the clusters are numbered in the order of their first point, like the clusters numbered in
+  // the order of their root voxel on the host
+  root_clusters_.assign(slot_num, -1);
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> temporary_clusters;  // no check about cluster size
+  std::vector<int> cluster_voxel_nums;
+  for (size_t i = 0; i < point_num; ++i) {
+    const int root = point_roots_[i];
+    if (root < 0) {
+      continue;
+    }
+    if (root_clusters_[root] < 0) {
+      root_clusters_[root] = static_cast<int>(temporary_clusters.size());
+      temporary_clusters.emplace_back();
+      cluster_voxel_nums.push_back(point_root_voxel_nums_[i]);
+    }
+    temporary_clusters[root_clusters_[root]].points.push_back(pointcloud->points[i]);
+  }
+
+  // build output and check cluster size, the number of voxels is bounded like the number of
+  // centroids in pcl::EuclideanClusterExtraction
+  {
+    for (size_t cluster_idx = 0; cluster_idx < temporary_clusters.size(); ++cluster_idx) {
+      const auto & cluster = temporary_clusters[cluster_idx];
+      if (!(min_cluster_size_ <= static_cast<int>(cluster.points.size()) &&
+            static_cast<int>(cluster.points.size()) <= max_cluster_size_ &&
+            cluster_voxel_nums[cluster_idx] <= max_cluster_size_)) {
+        continue;
+      }
+      clusters.push_back(cluster);
+      clusters.back().width = cluster.points.size();
+      clusters.back().height = 1;
+      clusters.back().is_dense = false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace euclidean_cluster
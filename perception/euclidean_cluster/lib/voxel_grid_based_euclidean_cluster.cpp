@@ -14,13 +14,58 @@
 
 #include "euclidean_cluster/voxel_grid_based_euclidean_cluster.hpp"
 
-#include <pcl/kdtree/kdtree.h>
-#include <pcl/segmentation/extract_clusters.h>
-
-#include <unordered_map>
+#include <atomic>
+#include <cmath>
+#include <utility>
+#include <vector>
 
 namespace euclidean_cluster
 {
+namespace
+{
+uint64_t packGridCoordinates(const int32_t x, const int32_t y)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
+
+uint64_t hashGridKey(const uint64_t key) { return (key ^ (key >> 31)) * 0x9e3779b97f4a7c15ULL; }
+
+// lock-free union-find, the roots are always linked under the smaller index so that the
+// components and their roots do not depend on the order of the unions
+uint32_t find(std::vector<std::atomic<uint32_t>> & parents, uint32_t v)
+{
+  while (true) {
+    uint32_t parent = parents[v].load(std::memory_order_relaxed);
+    if (parent == v) {
+      return v;
+    }
+    const uint32_t grandparent = parents[parent].load(std::memory_order_relaxed);
+    if (parent != grandparent) {  // path halving
+      parents[v].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+    }
+    v = grandparent;
+  }
+}
+
+void unite(std::vector<std::atomic<uint32_t>> & parents, uint32_t a, uint32_t b)
+{
+  while (true) {
+    a = find(parents, a);
+    b = find(parents, b);
+    if (a == b) {
+      return;
+    }
+    if (a < b) {
+      std::swap(a, b);
+    }
+    uint32_t expected = a;
+    if (parents[a].compare_exchange_strong(expected, b)) {
+      return;
+    }
+  }
+}
+}  // namespace
+
 VoxelGridBasedEuclideanCluster::VoxelGridBasedEuclideanCluster() {}
 
 VoxelGridBasedEuclideanCluster::VoxelGridBasedEuclideanCluster(
@@ -45,63 +90,119 @@ bool VoxelGridBasedEuclideanCluster::cluster(
 {
   // TODO(Saito) implement use_height is false version
 
-  // create voxel
-  pcl::PointCloud<pcl::PointXYZ>::Ptr voxel_map_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  voxel_grid_.setLeafSize(voxel_leaf_size_, voxel_leaf_size_, 100000.0);
-  voxel_grid_.setMinimumPointsNumberPerVoxel(min_points_number_per_voxel_);
-  voxel_grid_.setInputCloud(pointcloud);
-  voxel_grid_.setSaveLeafLayout(true);
-  voxel_grid_.filter(*voxel_map_ptr);
-
-  // voxel is pressed 2d
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_2d_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  for (const auto & point : voxel_map_ptr->points) {
-    pcl::PointXYZ point2d;
-    point2d.x = point.x;
-    point2d.y = point.y;
-    point2d.z = 0.0;
-    pointcloud_2d_ptr->push_back(point2d);
+  // create voxel hash, voxel is pressed 2d
+  const int point_num = static_cast<int>(pointcloud->points.size());
+  uint64_t capacity = 1;
+  while (capacity < 2 * pointcloud->points.size()) {
+    capacity <<= 1;
+  }
+  voxel_hash_keys_.resize(capacity);
+  voxel_hash_values_.assign(capacity, -1);
+  voxel_hash_mask_ = capacity - 1;
+  voxel_grid_x_.clear();
+  voxel_grid_y_.clear();
+  voxel_point_nums_.clear();
+  voxel_sums_x_.clear();
+  voxel_sums_y_.clear();
+  point_voxels_.resize(point_num);
+  for (int i = 0; i < point_num; ++i) {
+    const auto & point = pointcloud->points[i];
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+      point_voxels_[i] = -1;
+      continue;
+    }
+    const int voxel = insertVoxel(
+      static_cast<int32_t>(std::floor(point.x / voxel_leaf_size_)),
+      static_cast<int32_t>(std::floor(point.y / voxel_leaf_size_)));
+    ++voxel_point_nums_[voxel];
+    voxel_sums_x_[voxel] += point.x;
+    voxel_sums_y_[voxel] += point.y;
+    point_voxels_[i] = voxel;
+  }
+
+  // centroids of the voxels which have enough points
+  const int voxel_num = static_cast<int>(voxel_point_nums_.size());
+  for (int v = 0; v < voxel_num; ++v) {
+    if (voxel_point_nums_[v] < min_points_number_per_voxel_) {
+      voxel_point_nums_[v] = 0;
+      continue;
+    }
+    voxel_sums_x_[v] /= voxel_point_nums_[v];
+    voxel_sums_y_[v] /= voxel_point_nums_[v];
   }
+  const auto & centroids_x = voxel_sums_x_;
+  const auto & centroids_y = voxel_sums_y_;
 
-  // create tree
-  pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
-  tree->setInputCloud(pointcloud_2d_ptr);
-
-  // clustering
-  std::vector<pcl::PointIndices> cluster_indices;
-  pcl::EuclideanClusterExtraction<pcl::PointXYZ> pcl_euclidean_cluster;
-  pcl_euclidean_cluster.setClusterTolerance(tolerance_);
-  pcl_euclidean_cluster.setMinClusterSize(1);
-  pcl_euclidean_cluster.setMaxClusterSize(max_cluster_size_);
-  pcl_euclidean_cluster.setSearchMethod(tree);
-  pcl_euclidean_cluster.setInputCloud(pointcloud_2d_ptr);
-  pcl_euclidean_cluster.extract(cluster_indices);
-
-  // create map to search cluster index from voxel grid index
-  std::unordered_map</* voxel grid index */ int, /* cluster index */ int> map;
-  for (size_t cluster_idx = 0; cluster_idx < cluster_indices.size(); ++cluster_idx) {
-    const auto & cluster = cluster_indices.at(cluster_idx);
-    for (const auto & point_idx : cluster.indices) {
-      map[point_idx] = cluster_idx;
+  // clustering, connect the voxels whose centroids are closer than the tolerance
+  std::vector<std::atomic<uint32_t>> parents(voxel_num);
+  for (int v = 0; v < voxel_num; ++v) {
+    parents[v].store(v, std::memory_order_relaxed);
+  }
+  const int range = static_cast<int>(std::ceil(tolerance_ / voxel_leaf_size_));
+  const double sqr_tolerance = static_cast<double>(tolerance_) * tolerance_;
+#pragma omp parallel for schedule(dynamic, 256)
+  for (int v = 0; v < voxel_num; ++v) {
+    if (voxel_point_nums_[v] == 0) {
+      continue;
     }
+    // every pair of voxels is checked once, from the voxel with the lower grid coordinates
+    for (int dx = 0; dx <= range; ++dx) {
+      for (int dy = dx == 0 ? 1 : -range; dy <= range; ++dy) {
+        const int u = findVoxel(voxel_grid_x_[v] + dx, voxel_grid_y_[v] + dy);
+        if (u < 0 || voxel_point_nums_[u] == 0) {
+          continue;
+        }
+        const double diff_x = centroids_x[u] - centroids_x[v];
+        const double diff_y = centroids_y[u] - centroids_y[v];
+        if (diff_x * diff_x + diff_y * diff_y < sqr_tolerance) {
+          unite(parents, u, v);
+        }
+      }
+    }
+  }
+
+  // cluster index of every root voxel, in the order of the voxels
+  std::vector<int> voxel_clusters(voxel_num, -1);
+  std::vector<int> cluster_voxel_nums;
+  for (int v = 0; v < voxel_num; ++v) {
+    if (voxel_point_nums_[v] != 0 && find(parents, v) == static_cast<uint32_t>(v)) {
+      voxel_clusters[v] = static_cast<int>(cluster_voxel_nums.size());
+      cluster_voxel_nums.push_back(0);
+    }
+  }
+  for (int v = 0; v < voxel_num; ++v) {
+    if (voxel_point_nums_[v] != 0) {
+      ++cluster_voxel_nums[voxel_clusters[find(parents, v)]];
+    }
+  }
+
+  // label the input points with the cluster of their voxel
+  point_labels_.resize(point_num);
+#pragma omp parallel for
+  for (int i = 0; i < point_num; ++i) {
+    const int voxel = point_voxels_[i];
+    point_labels_[i] = (voxel < 0 || voxel_point_nums_[voxel] == 0)
+                         ? -1
+                         : voxel_clusters[find(parents, voxel)];
   }
 
-  // create vector of point cloud cluster. vector index is voxel grid index.
+  // create vector of point cloud cluster. vector index is cluster index.
   std::vector<pcl::PointCloud<pcl::PointXYZ>> temporary_clusters;  // no check about cluster size
-  temporary_clusters.resize(cluster_indices.size());
-  for (const auto & point : pointcloud->points) {
-    const int index =
-      voxel_grid_.getCentroidIndexAt(voxel_grid_.getGridCoordinates(point.x, point.y, point.z));
-    if (map.find(index) != map.end()) {
-      temporary_clusters.at(map[index]).points.push_back(point);
+  temporary_clusters.resize(cluster_voxel_nums.size());
+  for (int i = 0; i < point_num; ++i) {
+    if (point_labels_[i] >= 0) {
+      temporary_clusters[point_labels_[i]].points.push_back(pointcloud->points[i]);
     }
   }
 
-  // build output and check cluster size
+  // build output and check cluster size, the number of voxels is bounded like the number of
+  // centroids in pcl::EuclideanClusterExtraction
   {
-    for (const auto & cluster : temporary_clusters) {
+    for (size_t cluster_idx = 0; cluster_idx < temporary_clusters.size(); ++cluster_idx) {
+      const auto & cluster = temporary_clusters[cluster_idx];
       if (!(min_cluster_size_ <= static_cast<int>(cluster.points.size()) &&
-            static_cast<int>(cluster.points.size()) <= max_cluster_size_)) {
+            static_cast<int>(cluster.points.size()) <= max_cluster_size_ &&
+            cluster_voxel_nums[cluster_idx] <= max_cluster_size_)) {
         continue;
       }
       clusters.push_back(cluster);
@@ -114,4 +215,36 @@ bool VoxelGridBasedEuclideanCluster::cluster(
   return true;
 }
 
+int VoxelGridBasedEuclideanCluster::findVoxel(const int32_t x, const int32_t y) const
+{
+  const uint64_t key = packGridCoordinates(x, y);
+  for (uint64_t index = hashGridKey(key) & voxel_hash_mask_; voxel_hash_values_[index] >= 0;
+       index = (index + 1) & voxel_hash_mask_) {
+    if (voxel_hash_keys_[index] == key) {
+      return voxel_hash_values_[index];
+    }
+  }
+  return -1;
+}
+
+int VoxelGridBasedEuclideanCluster::insertVoxel(const int32_t x, const int32_t y)
+{
+  const uint64_t key = packGridCoordinates(x, y);
+  uint64_t index = hashGridKey(key) & voxel_hash_mask_;
+  for (; voxel_hash_values_[index] >= 0; index = (index + 1) & voxel_hash_mask_) {
+    if (voxel_hash_keys_[index] == key) {
+      return voxel_hash_values_[index];
+    }
+  }
+  const int voxel = static_cast<int>(voxel_point_nums_.size());
+  voxel_hash_keys_[index] = key;
+  voxel_hash_values_[index] = voxel;
+  voxel_grid_x_.push_back(x);
+  voxel_grid_y_.push_back(y);
+  voxel_point_nums_.push_back(0);
+  voxel_sums_x_.push_back(0.0);
+  voxel_sums_y_.push_back(0.0);
+  return voxel;
+}
+
 }  // namespace euclidean_cluster
@@ -16,6 +16,10 @@
 
 #include "euclidean_cluster/voxel_grid_based_euclidean_cluster.hpp"
 
+#ifdef EUCLIDEAN_CLUSTER_USE_CUDA
+#include "euclidean_cluster/cuda_voxel_grid_based_euclidean_cluster.hpp"
+#endif
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <geometry_msgs/msg/pose_stamped.hpp>
@@ -38,7 +42,7 @@ private:
   rclcpp::Publisher<tier4_perception_msgs::msg::DetectedObjectsWithFeature>::SharedPtr cluster_pub_;
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr debug_pub_;
 
-  std::shared_ptr<VoxelGridBasedEuclideanCluster> cluster_;
+  std::shared_ptr<EuclideanClusterInterface> cluster_;
 };
 
 }  // namespace euclidean_cluster
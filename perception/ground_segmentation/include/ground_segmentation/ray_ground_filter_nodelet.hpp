@@ -70,6 +70,7 @@
 
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
+#include <tier4_autoware_utils/geometry/polar_grid.hpp>
 
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/linestring.hpp>
@@ -105,6 +106,8 @@ class RayGroundFilterComponent : public pointcloud_preprocessor::Filter
   };
   typedef std::vector<PointXYZRTColor> PointCloudXYZRTColor;
 
+  enum class PointLabel : uint8_t { UNKNOWN = 0, GROUND, NON_GROUND };
+
 protected:
   void filter(
     const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output) override;
@@ -120,7 +123,15 @@ private:
   double
     reclass_distance_threshold_;  // distance between points at which re classification will occur
 
+  bool use_azimuth_field_;  // take the angles from the azimuth field instead of x and y
+  double range_bin_size_;   // size of the range bins of the counting sort, 0 to disable
+  int num_threads_;
+
   size_t radial_dividers_num_;
+  tier4_autoware_utils::PolarGrid polar_grid_;  // reused across frames
+  std::vector<float> point_angles_;             // [rad] from the azimuth field, in input order
+  std::vector<std::vector<PointLabel>> point_labels_;  // per radial division, reused
+  static constexpr float max_range_bin_num = 1024.0f;
 
   size_t grid_width_;
   size_t grid_height_;
@@ -190,6 +201,13 @@ private:
     pcl::PointCloud<PointType_>::Ptr out_only_indices_cloud_ptr,
     pcl::PointCloud<PointType_>::Ptr out_removed_indices_cloud_ptr);
 
+  /*!
+   * Reads the angles of the points from the azimuth field of the input
+   * @param input Input PointCloud, with a float azimuth field in hundredths of a degree
+   * @retval false the input has no such field
+   */
+  bool readPointAngles(const PointCloud2 & input);
+
   boost::optional<float> calcPointVehicleIntersection(const Point & point);
 
   void setVehicleFootprint(
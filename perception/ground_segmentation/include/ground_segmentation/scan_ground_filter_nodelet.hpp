@@ -17,6 +17,7 @@
 
 #include "pointcloud_preprocessor/filter.hpp"
 
+#include <tier4_autoware_utils/geometry/polar_grid.hpp>
 #include <vehicle_info_util/vehicle_info.hpp>
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
@@ -34,6 +35,8 @@
 
 #include <tf2_ros/transform_listener.h>
 
+#include <algorithm>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -105,6 +108,32 @@ private:
     float getAverageRadius() { return radius_avg; }
   };
 
+  // elevation statistics of one cell of the polar grid
+  struct GridCell
+  {
+    float min_height;
+    float height_sum;
+    uint32_t point_num;
+    float ground_height;  // ground level the points of the cell are compared against
+
+    void initialize()
+    {
+      min_height = std::numeric_limits<float>::max();
+      height_sum = 0.0f;
+      point_num = 0;
+      ground_height = 0.0f;
+    }
+
+    void addPoint(const float height)
+    {
+      min_height = std::min(min_height, height);
+      height_sum += height;
+      ++point_num;
+    }
+
+    float getAverageHeight() const { return height_sum / point_num; }
+  };
+
   void filter(
     const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output) override;
 
@@ -121,8 +150,23 @@ private:
     split_height_distance_;                 // useful for close points
   bool use_virtual_ground_point_;
   size_t radial_dividers_num_;
+  int num_threads_;
   VehicleInfo vehicle_info_;
 
+  // the points binned by radial division, and by radial bin in the grid mode, reused across frames
+  tier4_autoware_utils::PolarGrid polar_grid_;
+  // points of all the radial divisions, division i being
+  // [polar_grid_.angleBinBegin(i), polar_grid_.angleBinEnd(i))
+  PointCloudRefVector radial_ordered_points_;
+
+  // polar grid of the grid mode, cell (radial_div, radial_bin) being
+  // grid_cells_[radial_div * grid_radial_bins_num_ + radial_bin], reused across frames
+  bool grid_mode_;
+  double grid_radial_size_;  // length of a cell along the radial direction [m]
+  double grid_max_radius_;   // farther points fall into the last radial bin [m]
+  size_t grid_radial_bins_num_;
+  std::vector<GridCell> grid_cells_;
+
   /*!
    * Output transformed PointCloud from in_cloud_ptr->header.frame_id to in_target_frame
    * @param[in] in_target_frame Coordinate system to perform transform
@@ -133,14 +177,18 @@ private:
    */
 
   /*!
-   * Convert pcl::PointCloud to sorted PointCloudRefVector
+   * Bin pcl::PointCloud into polar_grid_ by radial division and radial bin
+   * @param[in] in_cloud Input Point Cloud
+   * @param[in] radial_bins_num Number of radial bins of grid_radial_size_ in a division
+   */
+  void binPointcloud(const pcl::PointCloud<pcl::PointXYZ> & in_cloud, const size_t radial_bins_num);
+
+  /*!
+   * Convert pcl::PointCloud to radial_ordered_points_, counting-sorted by radial division and
+   * sorted by radius inside each division
    * @param[in] in_cloud Input Point Cloud to be organized in radial segments
-   * @param[out] out_radial_ordered_points_manager Vector of Points Clouds,
-   *     each element will contain the points ordered
    */
-  void convertPointcloud(
-    const pcl::PointCloud<pcl::PointXYZ>::Ptr in_cloud,
-    std::vector<PointCloudRefVector> & out_radial_ordered_points_manager);
+  void convertPointcloud(const pcl::PointCloud<pcl::PointXYZ>::Ptr in_cloud);
 
   /*!
    * Output ground center of front wheels as the virtual ground point
@@ -149,15 +197,36 @@ private:
   void calcVirtualGroundOrigin(pcl::PointXYZ & point);
 
   /*!
-   * Classifies Points in the PointCloud as Ground and Not Ground
-   * @param in_radial_ordered_clouds Vector of an Ordered PointsCloud
-   *     ordered by radial distance from the origin
+   * Classifies Points in the PointCloud as Ground and Not Ground.
+   * The radial divisions are independent, and are classified in parallel with num_threads_.
+   * @param out_no_ground_indices Returns the indices of the points
+   *     classified as not ground in the original PointCloud
+   */
+  void classifyPointCloud(pcl::PointIndices & out_no_ground_indices);
+
+  /*!
+   * Label the points of one radial division, ordered by radial distance from the origin
+   * @param begin First point of the division in radial_ordered_points_
+   * @param end Past the last point of the division in radial_ordered_points_
+   */
+  void classifyRadialDivision(const size_t begin, const size_t end);
+
+  /*!
+   * Classifies Points in the PointCloud as Ground and Not Ground against the ground level of
+   * their cell in the polar grid, in O(N + number of cells)
+   * @param in_cloud Input Point Cloud
    * @param out_no_ground_indices Returns the indices of the points
    *     classified as not ground in the original PointCloud
    */
-  void classifyPointCloud(
-    std::vector<PointCloudRefVector> & in_radial_ordered_clouds,
-    pcl::PointIndices & out_no_ground_indices);
+  void classifyPointCloudInGrid(
+    const pcl::PointCloud<pcl::PointXYZ>::Ptr in_cloud, pcl::PointIndices & out_no_ground_indices);
+
+  /*!
+   * Estimates the ground level of the cells of one radial division, from the inner to the outer
+   * cells, using the minimum height of the neighboring cells of the adjacent radial divisions
+   * @param radial_div Index of the radial division
+   */
+  void estimateGridGroundHeight(const size_t radial_div);
 
   /*!
    * Returns the resulting complementary PointCloud, one with the points kept
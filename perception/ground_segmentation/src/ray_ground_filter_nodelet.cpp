@@ -31,12 +31,20 @@
 
 #include "ground_segmentation/ray_ground_filter_nodelet.hpp"
 
+#include <tier4_autoware_utils/math/unit_conversion.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ground_segmentation
 {
 using pointcloud_preprocessor::get_param;
+using tier4_autoware_utils::deg2rad;
+using tier4_autoware_utils::rad2deg;
 
 RayGroundFilterComponent::RayGroundFilterComponent(const rclcpp::NodeOptions & options)
 : Filter("RayGroundFilter", options)
@@ -64,6 +72,9 @@ RayGroundFilterComponent::RayGroundFilterComponent(const rclcpp::NodeOptions & o
     min_height_threshold_ = declare_parameter("min_height_threshold", 0.15);
     concentric_divider_distance_ = declare_parameter("concentric_divider_distance", 0.0);
     reclass_distance_threshold_ = declare_parameter("reclass_distance_threshold", 0.1);
+    use_azimuth_field_ = declare_parameter("use_azimuth_field", false);
+    range_bin_size_ = declare_parameter("range_bin_size", 0.0);
+    num_threads_ = std::max(static_cast<int>(declare_parameter("num_threads", 1)), 1);
   }
 
   using std::placeholders::_1;
@@ -76,52 +87,76 @@ void RayGroundFilterComponent::ConvertXYZIToRTZColor(
   std::vector<pcl::PointIndices> & out_radial_divided_indices,
   std::vector<PointCloudXYZRTColor> & out_radial_ordered_clouds)
 {
+  // the points are counting sorted by range bins too, if enabled, to be sorted by insertion
+  float range_bin_size = 0.0f;
+  size_t range_bin_num = 1U;
+  if (range_bin_size_ > 0.0) {
+    float max_squared_radius = 0.0f;
+    for (const auto & point : in_cloud->points) {
+      max_squared_radius = std::max(max_squared_radius, point.x * point.x + point.y * point.y);
+    }
+    const float max_radius = std::sqrt(max_squared_radius);
+    // the bins are enlarged for an unusually wide cloud, to keep the grid small
+    range_bin_size = std::max(static_cast<float>(range_bin_size_), max_radius / max_range_bin_num);
+    range_bin_num = static_cast<size_t>(max_radius / range_bin_size) + 1U;
+  }
+  polar_grid_.initialize(
+    0.0f, deg2rad(radial_divider_angle_), radial_dividers_num_, range_bin_size, range_bin_num);
+  if (point_angles_.size() == in_cloud->points.size()) {
+    polar_grid_.binPolar(in_cloud->points.size(), [this, &in_cloud](const size_t i) {
+      const auto & point = in_cloud->points[i];
+      return std::make_pair(std::sqrt(point.x * point.x + point.y * point.y), point_angles_[i]);
+    });
+  } else {
+    polar_grid_.bin(in_cloud->points.size(), [&in_cloud](const size_t i) {
+      return std::make_pair(in_cloud->points[i].x, in_cloud->points[i].y);
+    });
+  }
+
   out_organized_points.resize(in_cloud->points.size());
   out_radial_divided_indices.clear();
   out_radial_divided_indices.resize(radial_dividers_num_);
+  out_radial_ordered_clouds.clear();
   out_radial_ordered_clouds.resize(radial_dividers_num_);
 
-  for (size_t i = 0; i < in_cloud->points.size(); i++) {
-    PointXYZRTColor new_point;
-    auto radius = static_cast<float>(sqrt(
-      in_cloud->points[i].x * in_cloud->points[i].x +
-      in_cloud->points[i].y * in_cloud->points[i].y));
-    auto theta =
-      static_cast<float>(atan2(in_cloud->points[i].y, in_cloud->points[i].x)) * 180 / M_PI;
-    if (theta < 0) {
-      theta += 360;
+  // the radial divisions only touch their own points, so they are ordered in parallel
+  const int radial_dividers_num = static_cast<int>(radial_dividers_num_);
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+  for (int radial_div = 0; radial_div < radial_dividers_num; radial_div++) {
+    const size_t begin = polar_grid_.angleBinBegin(radial_div);
+    const size_t end = polar_grid_.angleBinEnd(radial_div);
+
+    // radial divisions, in input order
+    out_radial_divided_indices[radial_div].indices.reserve(end - begin);
+    for (size_t k = begin; k < end; k++) {
+      const size_t i = polar_grid_.index(k);
+      PointXYZRTColor new_point;
+      new_point.point.x = in_cloud->points[i].x;
+      new_point.point.y = in_cloud->points[i].y;
+      new_point.point.z = in_cloud->points[i].z;
+      // new_point.ring = in_cloud->points[i].ring;
+      new_point.radius = polar_grid_.range(k);
+      new_point.theta = static_cast<float>(rad2deg(polar_grid_.angle(k)));
+      new_point.radial_div = radial_div;
+      new_point.red = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[0]);
+      new_point.green = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[1]);
+      new_point.blue = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[2]);
+      new_point.original_index = i;
+
+      out_organized_points[i] = new_point;
+      out_radial_divided_indices[radial_div].indices.push_back(i);
+    }
+
+    // order radial points on each division
+    if (range_bin_num > 1U) {
+      polar_grid_.sortCellsByRange(radial_div);
+    } else {
+      polar_grid_.sortByRange(radial_div);
     }
-    if (theta >= 360) {
-      theta -= 360;
+    out_radial_ordered_clouds[radial_div].reserve(end - begin);
+    for (size_t k = begin; k < end; k++) {
+      out_radial_ordered_clouds[radial_div].push_back(out_organized_points[polar_grid_.index(k)]);
     }
-    auto radial_div = static_cast<size_t>(floor(theta / radial_divider_angle_));
-
-    new_point.point.x = in_cloud->points[i].x;
-    new_point.point.y = in_cloud->points[i].y;
-    new_point.point.z = in_cloud->points[i].z;
-    // new_point.ring = in_cloud->points[i].ring;
-    new_point.radius = radius;
-    new_point.theta = theta;
-    new_point.radial_div = radial_div;
-    new_point.red = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[0]);
-    new_point.green = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[1]);
-    new_point.blue = static_cast<size_t>(colors_[new_point.radial_div % color_num_].val[2]);
-    new_point.original_index = i;
-
-    out_organized_points[i] = new_point;
-
-    // radial divisions
-    out_radial_divided_indices[radial_div].indices.push_back(i);
-
-    out_radial_ordered_clouds[radial_div].push_back(new_point);
-  }  // end for
-
-  // order radial points on each division
-#pragma omp for
-  for (size_t i = 0; i < radial_dividers_num_; i++) {
-    std::sort(
-      out_radial_ordered_clouds[i].begin(), out_radial_ordered_clouds[i].end(),
-      [](const PointXYZRTColor & a, const PointXYZRTColor & b) { return a.radius < b.radius; });
   }
 }
 
@@ -155,10 +190,13 @@ void RayGroundFilterComponent::ClassifyPointCloud(
 {
   out_ground_indices.indices.clear();
   out_no_ground_indices.indices.clear();
-#pragma omp for
-  for (size_t i = 0; i < in_radial_ordered_clouds.size();
-       i++)  // sweep through each radial division
+  point_labels_.resize(in_radial_ordered_clouds.size());
+  const int radial_dividers_num = static_cast<int>(in_radial_ordered_clouds.size());
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+  for (int i = 0; i < radial_dividers_num; i++)  // sweep through each radial division
   {
+    auto & labels = point_labels_[i];
+    labels.assign(in_radial_ordered_clouds[i].size(), PointLabel::UNKNOWN);
     float prev_radius = 0.f;
     float prev_height = 0.f;
     bool prev_ground = false;
@@ -231,10 +269,10 @@ void RayGroundFilterComponent::ClassifyPointCloud(
       }  // end larger than concentric_divider
 
       if (current_ground) {
-        out_ground_indices.indices.push_back(in_radial_ordered_clouds[i][j].original_index);
+        labels[j] = PointLabel::GROUND;
         prev_ground = true;
       } else {
-        out_no_ground_indices.indices.push_back(in_radial_ordered_clouds[i][j].original_index);
+        labels[j] = PointLabel::NON_GROUND;
         prev_ground = false;
       }
 
@@ -242,6 +280,45 @@ void RayGroundFilterComponent::ClassifyPointCloud(
       prev_height = in_radial_ordered_clouds[i][j].point.z;
     }
   }
+
+  // same order as a sequential sweep through the radial divisions
+  for (size_t i = 0; i < in_radial_ordered_clouds.size(); i++) {
+    for (size_t j = 0; j < in_radial_ordered_clouds[i].size(); j++) {
+      if (point_labels_[i][j] == PointLabel::GROUND) {
+        out_ground_indices.indices.push_back(in_radial_ordered_clouds[i][j].original_index);
+      } else if (point_labels_[i][j] == PointLabel::NON_GROUND) {
+        out_no_ground_indices.indices.push_back(in_radial_ordered_clouds[i][j].original_index);
+      }
+    }
+  }
+}
+
+bool RayGroundFilterComponent::readPointAngles(const PointCloud2 & input)
+{
+  const auto field = std::find_if(
+    input.fields.begin(), input.fields.end(),
+    [](const sensor_msgs::msg::PointField & field) { return field.name == "azimuth"; });
+  if (
+    field == input.fields.end() || field->datatype != sensor_msgs::msg::PointField::FLOAT32 ||
+    input.data.size() < static_cast<size_t>(input.row_step) * input.height) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 5000,
+      "The input has no float azimuth field. Computing the angles from x and y.");
+    return false;
+  }
+
+  // the azimuth is in hundredths of a degree, as published by the lidar drivers
+  point_angles_.resize(static_cast<size_t>(input.width) * input.height);
+  for (size_t row = 0; row < input.height; ++row) {
+    for (size_t column = 0; column < input.width; ++column) {
+      float azimuth;
+      std::memcpy(
+        &azimuth, &input.data[row * input.row_step + column * input.point_step + field->offset],
+        sizeof(float));
+      point_angles_[row * input.width + column] = static_cast<float>(deg2rad(azimuth * 0.01));
+    }
+  }
+  return true;
 }
 
 // [ROS2-port]: removed
@@ -288,6 +365,11 @@ void RayGroundFilterComponent::filter(
 
   radial_dividers_num_ = ceil(360 / radial_divider_angle_);
 
+  // the angles are taken from the azimuth measured by the sensor, if enabled and available
+  if (!use_azimuth_field_ || !readPointAngles(*input)) {
+    point_angles_.clear();
+  }
+
   ConvertXYZIToRTZColor(
     current_sensor_cloud_ptr, organized_points, radial_division_indices, radial_ordered_clouds);
 
@@ -356,6 +438,16 @@ rcl_interfaces::msg::SetParametersResult RayGroundFilterComponent::paramCallback
   if (get_param(p, "use_vehicle_footprint", use_vehicle_footprint_)) {
     RCLCPP_DEBUG(get_logger(), "Setting use_vehicle_footprint to: %d.", use_vehicle_footprint_);
   }
+  if (get_param(p, "use_azimuth_field", use_azimuth_field_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting use_azimuth_field to: %d.", use_azimuth_field_);
+  }
+  if (get_param(p, "range_bin_size", range_bin_size_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting range_bin_size to: %f.", range_bin_size_);
+  }
+  if (get_param(p, "num_threads", num_threads_)) {
+    num_threads_ = std::max(num_threads_, 1);
+    RCLCPP_DEBUG(get_logger(), "Setting num_threads to: %d.", num_threads_);
+  }
 
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
@@ -15,12 +15,13 @@
 #include "ground_segmentation/scan_ground_filter_nodelet.hpp"
 
 #include <tier4_autoware_utils/geometry/geometry.hpp>
-#include <tier4_autoware_utils/math/normalization.hpp>
 #include <tier4_autoware_utils/math/unit_conversion.hpp>
 #include <vehicle_info_util/vehicle_info_util.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ground_segmentation
@@ -28,8 +29,6 @@ namespace ground_segmentation
 using pointcloud_preprocessor::get_param;
 using tier4_autoware_utils::calcDistance3d;
 using tier4_autoware_utils::deg2rad;
-using tier4_autoware_utils::normalizeDegree;
-using tier4_autoware_utils::normalizeRadian;
 using vehicle_info_util::VehicleInfoUtil;
 
 ScanGroundFilterComponent::ScanGroundFilterComponent(const rclcpp::NodeOptions & options)
@@ -43,7 +42,13 @@ ScanGroundFilterComponent::ScanGroundFilterComponent(const rclcpp::NodeOptions &
     split_points_distance_tolerance_ = declare_parameter("split_points_distance_tolerance", 0.2);
     split_height_distance_ = declare_parameter("split_height_distance", 0.2);
     use_virtual_ground_point_ = declare_parameter("use_virtual_ground_point", true);
+    num_threads_ = std::max(static_cast<int>(declare_parameter("num_threads", 1)), 1);
     radial_dividers_num_ = std::ceil(2.0 * M_PI / radial_divider_angle_rad_);
+    grid_mode_ = declare_parameter("grid_mode", false);
+    grid_radial_size_ = declare_parameter("grid_radial_size", 0.5);
+    grid_max_radius_ = declare_parameter("grid_max_radius", 100.0);
+    grid_radial_bins_num_ =
+      std::max(static_cast<size_t>(std::ceil(grid_max_radius_ / grid_radial_size_)), size_t{1});
     vehicle_info_ = VehicleInfoUtil(*this).getVehicleInfo();
   }
 
@@ -52,35 +57,35 @@ ScanGroundFilterComponent::ScanGroundFilterComponent(const rclcpp::NodeOptions &
     std::bind(&ScanGroundFilterComponent::onParameter, this, _1));
 }
 
-void ScanGroundFilterComponent::convertPointcloud(
-  const pcl::PointCloud<pcl::PointXYZ>::Ptr in_cloud,
-  std::vector<PointCloudRefVector> & out_radial_ordered_points)
+void ScanGroundFilterComponent::binPointcloud(
+  const pcl::PointCloud<pcl::PointXYZ> & in_cloud, const size_t radial_bins_num)
 {
-  out_radial_ordered_points.resize(radial_dividers_num_);
-  PointRef current_point;
+  // theta is measured from the y axis, which is the angle of (y, x)
+  polar_grid_.initialize(
+    0.0f, radial_divider_angle_rad_, radial_dividers_num_, grid_radial_size_, radial_bins_num);
+  polar_grid_.bin(in_cloud.points.size(), [&in_cloud](const size_t i) {
+    return std::make_pair(in_cloud.points[i].y, in_cloud.points[i].x);
+  });
+}
 
-  for (size_t i = 0; i < in_cloud->points.size(); ++i) {
-    auto radius{static_cast<float>(std::hypot(in_cloud->points[i].x, in_cloud->points[i].y))};
-    auto theta{normalizeRadian(std::atan2(in_cloud->points[i].x, in_cloud->points[i].y), 0.0)};
-    auto radial_div{
-      static_cast<size_t>(std::floor(normalizeDegree(theta / radial_divider_angle_rad_, 0.0)))};
-
-    current_point.radius = radius;
-    current_point.theta = theta;
-    current_point.radial_div = radial_div;
-    current_point.point_state = PointLabel::INIT;
-    current_point.orig_index = i;
-    current_point.orig_point = &in_cloud->points[i];
-
-    // radial divisions
-    out_radial_ordered_points[radial_div].emplace_back(current_point);
-  }
+void ScanGroundFilterComponent::convertPointcloud(
+  const pcl::PointCloud<pcl::PointXYZ>::Ptr in_cloud)
+{
+  // radial divisions: stable counting sort, so each division keeps the input order
+  binPointcloud(*in_cloud, 1U);
 
   // sort by distance
-  for (size_t i = 0; i < radial_dividers_num_; ++i) {
-    std::sort(
-      out_radial_ordered_points[i].begin(), out_radial_ordered_points[i].end(),
-      [](const PointRef & a, const PointRef & b) { return a.radius < b.radius; });
+  radial_ordered_points_.resize(in_cloud->points.size());
+  const int radial_dividers_num = static_cast<int>(radial_dividers_num_);
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+  for (int i = 0; i < radial_dividers_num; ++i) {
+    polar_grid_.sortByRange(i);
+    for (size_t k = polar_grid_.angleBinBegin(i); k < polar_grid_.angleBinEnd(i); ++k) {
+      const size_t orig_index = polar_grid_.index(k);
+      radial_ordered_points_[k] = PointRef{
+        polar_grid_.range(k), polar_grid_.angle(k), static_cast<size_t>(i), PointLabel::INIT,
+        orig_index, &in_cloud->points[orig_index]};
+    }
   }
 }
 
@@ -91,117 +96,218 @@ void ScanGroundFilterComponent::calcVirtualGroundOrigin(pcl::PointXYZ & point)
   point.z = 0;
 }
 
-void ScanGroundFilterComponent::classifyPointCloud(
-  std::vector<PointCloudRefVector> & in_radial_ordered_clouds,
-  pcl::PointIndices & out_no_ground_indices)
+void ScanGroundFilterComponent::classifyPointCloud(pcl::PointIndices & out_no_ground_indices)
 {
   out_no_ground_indices.indices.clear();
 
+  // point classification algorithm
+  // sweep through each radial division, they are independent of each other
+  const int radial_dividers_num = static_cast<int>(radial_dividers_num_);
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+  for (int i = 0; i < radial_dividers_num; i++) {
+    classifyRadialDivision(polar_grid_.angleBinBegin(i), polar_grid_.angleBinEnd(i));
+  }
+
+  // same order as a sequential sweep through the radial divisions
+  for (const auto & p : radial_ordered_points_) {
+    if (p.point_state == PointLabel::NON_GROUND) {
+      out_no_ground_indices.indices.push_back(p.orig_index);
+    }
+  }
+}
+
+void ScanGroundFilterComponent::classifyRadialDivision(const size_t begin, const size_t end)
+{
   const pcl::PointXYZ init_ground_point(0, 0, 0);
   pcl::PointXYZ virtual_ground_point(0, 0, 0);
   calcVirtualGroundOrigin(virtual_ground_point);
 
-  // point classification algorithm
-  // sweep through each radial division
-  for (size_t i = 0; i < in_radial_ordered_clouds.size(); i++) {
-    float prev_gnd_radius = 0.0f;
-    float prev_gnd_slope = 0.0f;
-    float points_distance = 0.0f;
-    PointsCentroid ground_cluster, non_ground_cluster;
-    float local_slope = 0.0f;
-    PointLabel prev_point_label = PointLabel::INIT;
-    pcl::PointXYZ prev_gnd_point(0, 0, 0);
-    // loop through each point in the radial div
-    for (size_t j = 0; j < in_radial_ordered_clouds[i].size(); j++) {
-      const float global_slope_max_angle = global_slope_max_angle_rad_;
-      const float local_slope_max_angle = local_slope_max_angle_rad_;
-      auto * p = &in_radial_ordered_clouds[i][j];
-      auto * p_prev = &in_radial_ordered_clouds[i][j - 1];
-
-      if (j == 0) {
-        bool is_front_side = (p->orig_point->x > virtual_ground_point.x);
-        if (use_virtual_ground_point_ && is_front_side) {
-          prev_gnd_point = virtual_ground_point;
-        } else {
-          prev_gnd_point = init_ground_point;
-        }
-        prev_gnd_radius = std::hypot(prev_gnd_point.x, prev_gnd_point.y);
-        prev_gnd_slope = 0.0f;
-        ground_cluster.initialize();
-        non_ground_cluster.initialize();
-        points_distance = calcDistance3d(*p->orig_point, prev_gnd_point);
+  float prev_gnd_radius = 0.0f;
+  float prev_gnd_slope = 0.0f;
+  float points_distance = 0.0f;
+  PointsCentroid ground_cluster, non_ground_cluster;
+  float local_slope = 0.0f;
+  PointLabel prev_point_label = PointLabel::INIT;
+  pcl::PointXYZ prev_gnd_point(0, 0, 0);
+  // loop through each point in the radial div
+  for (size_t j = begin; j < end; j++) {
+    const float global_slope_max_angle = global_slope_max_angle_rad_;
+    const float local_slope_max_angle = local_slope_max_angle_rad_;
+    auto * p = &radial_ordered_points_[j];
+
+    if (j == begin) {
+      bool is_front_side = (p->orig_point->x > virtual_ground_point.x);
+      if (use_virtual_ground_point_ && is_front_side) {
+        prev_gnd_point = virtual_ground_point;
       } else {
-        points_distance = calcDistance3d(*p->orig_point, *p_prev->orig_point);
+        prev_gnd_point = init_ground_point;
       }
+      prev_gnd_radius = std::hypot(prev_gnd_point.x, prev_gnd_point.y);
+      prev_gnd_slope = 0.0f;
+      ground_cluster.initialize();
+      non_ground_cluster.initialize();
+      points_distance = calcDistance3d(*p->orig_point, prev_gnd_point);
+    } else {
+      points_distance = calcDistance3d(*p->orig_point, *radial_ordered_points_[j - 1].orig_point);
+    }
 
-      float radius_distance_from_gnd = p->radius - prev_gnd_radius;
-      float height_from_gnd = p->orig_point->z - prev_gnd_point.z;
-      float height_from_obj = p->orig_point->z - non_ground_cluster.getAverageHeight();
-      bool calculate_slope = false;
-      bool is_point_close_to_prev =
-        (points_distance <
-         (p->radius * radial_divider_angle_rad_ + split_points_distance_tolerance_));
-
-      float global_slope = std::atan2(p->orig_point->z, p->radius);
-      // check points which is far enough from previous point
-      if (global_slope > global_slope_max_angle) {
+    float radius_distance_from_gnd = p->radius - prev_gnd_radius;
+    float height_from_gnd = p->orig_point->z - prev_gnd_point.z;
+    float height_from_obj = p->orig_point->z - non_ground_cluster.getAverageHeight();
+    bool calculate_slope = false;
+    bool is_point_close_to_prev =
+      (points_distance <
+       (p->radius * radial_divider_angle_rad_ + split_points_distance_tolerance_));
+
+    float global_slope = std::atan2(p->orig_point->z, p->radius);
+    // check points which is far enough from previous point
+    if (global_slope > global_slope_max_angle) {
+      p->point_state = PointLabel::NON_GROUND;
+      calculate_slope = false;
+    } else if (
+      (prev_point_label == PointLabel::NON_GROUND) &&
+      (std::abs(height_from_obj) >= split_height_distance_)) {
+      calculate_slope = true;
+    } else if (is_point_close_to_prev && std::abs(height_from_gnd) < split_height_distance_) {
+      // close to the previous point, set point follow label
+      p->point_state = PointLabel::POINT_FOLLOW;
+      calculate_slope = false;
+    } else {
+      calculate_slope = true;
+    }
+    if (is_point_close_to_prev) {
+      height_from_gnd = p->orig_point->z - ground_cluster.getAverageHeight();
+      radius_distance_from_gnd = p->radius - ground_cluster.getAverageRadius();
+    }
+    if (calculate_slope) {
+      // far from the previous point
+      local_slope = std::atan2(height_from_gnd, radius_distance_from_gnd);
+      if (local_slope - prev_gnd_slope > local_slope_max_angle) {
+        // the point is outside of the local slope threshold
         p->point_state = PointLabel::NON_GROUND;
-        calculate_slope = false;
-      } else if (
-        (prev_point_label == PointLabel::NON_GROUND) &&
-        (std::abs(height_from_obj) >= split_height_distance_)) {
-        calculate_slope = true;
-      } else if (is_point_close_to_prev && std::abs(height_from_gnd) < split_height_distance_) {
-        // close to the previous point, set point follow label
-        p->point_state = PointLabel::POINT_FOLLOW;
-        calculate_slope = false;
       } else {
-        calculate_slope = true;
-      }
-      if (is_point_close_to_prev) {
-        height_from_gnd = p->orig_point->z - ground_cluster.getAverageHeight();
-        radius_distance_from_gnd = p->radius - ground_cluster.getAverageRadius();
-      }
-      if (calculate_slope) {
-        // far from the previous point
-        local_slope = std::atan2(height_from_gnd, radius_distance_from_gnd);
-        if (local_slope - prev_gnd_slope > local_slope_max_angle) {
-          // the point is outside of the local slope threshold
-          p->point_state = PointLabel::NON_GROUND;
-        } else {
-          p->point_state = PointLabel::GROUND;
-        }
-      }
-
-      if (p->point_state == PointLabel::GROUND) {
-        ground_cluster.initialize();
-        non_ground_cluster.initialize();
-      }
-      if (p->point_state == PointLabel::NON_GROUND) {
-        out_no_ground_indices.indices.push_back(p->orig_index);
-      } else if (  // NOLINT
-        (prev_point_label == PointLabel::NON_GROUND) &&
-        (p->point_state == PointLabel::POINT_FOLLOW)) {
-        p->point_state = PointLabel::NON_GROUND;
-        out_no_ground_indices.indices.push_back(p->orig_index);
-      } else if (  // NOLINT
-        (prev_point_label == PointLabel::GROUND) && (p->point_state == PointLabel::POINT_FOLLOW)) {
         p->point_state = PointLabel::GROUND;
-      } else {
       }
+    }
+
+    if (p->point_state == PointLabel::GROUND) {
+      ground_cluster.initialize();
+      non_ground_cluster.initialize();
+    }
+    // the non ground points are collected by classifyPointCloud from the final labels
+    if (
+      (prev_point_label == PointLabel::NON_GROUND) &&
+      (p->point_state == PointLabel::POINT_FOLLOW)) {
+      p->point_state = PointLabel::NON_GROUND;
+    } else if (  // NOLINT
+      (prev_point_label == PointLabel::GROUND) && (p->point_state == PointLabel::POINT_FOLLOW)) {
+      p->point_state = PointLabel::GROUND;
+    }
+
+    // update the ground state
+    prev_point_label = p->point_state;
+    if (p->point_state == PointLabel::GROUND) {
+      prev_gnd_radius = p->radius;
+      prev_gnd_point = pcl::PointXYZ(p->orig_point->x, p->orig_point->y, p->orig_point->z);
+      ground_cluster.addPoint(p->radius, p->orig_point->z);
+      prev_gnd_slope = ground_cluster.getAverageSlope();
+    }
+    // update the non ground state
+    if (p->point_state == PointLabel::NON_GROUND) {
+      non_ground_cluster.addPoint(p->radius, p->orig_point->z);
+    }
+  }
+}
+
+void ScanGroundFilterComponent::classifyPointCloudInGrid(
+  const pcl::PointCloud<pcl::PointXYZ>::Ptr in_cloud, pcl::PointIndices & out_no_ground_indices)
+{
+  out_no_ground_indices.indices.clear();
+
+  grid_cells_.resize(radial_dividers_num_ * grid_radial_bins_num_);
+  for (auto & cell : grid_cells_) {
+    cell.initialize();
+  }
+  binPointcloud(*in_cloud, grid_radial_bins_num_);
+
+  // elevation statistics of the cells
+  for (size_t i = 0; i < in_cloud->points.size(); ++i) {
+    grid_cells_[polar_grid_.pointCell(i)].addPoint(in_cloud->points[i].z);
+  }
+
+  // ground level of the cells, the radial divisions only read each other's statistics
+  const int radial_dividers_num = static_cast<int>(radial_dividers_num_);
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+  for (int i = 0; i < radial_dividers_num; i++) {
+    estimateGridGroundHeight(i);
+  }
+
+  // point classification against the ground level of its cell
+  for (size_t i = 0; i < in_cloud->points.size(); ++i) {
+    const auto & point = in_cloud->points[i];
+    const auto & cell = grid_cells_[polar_grid_.pointCell(i)];
+    const float global_slope = std::atan2(point.z, std::hypot(point.x, point.y));
+    if (
+      global_slope > global_slope_max_angle_rad_ ||
+      point.z - cell.ground_height >= split_height_distance_) {
+      out_no_ground_indices.indices.push_back(i);
+    }
+  }
+}
+
+void ScanGroundFilterComponent::estimateGridGroundHeight(const size_t radial_div)
+{
+  pcl::PointXYZ virtual_ground_point(0, 0, 0);
+  calcVirtualGroundOrigin(virtual_ground_point);
+
+  // theta is measured from the y axis, so the front side is where sin(theta) is positive
+  const double theta = (radial_div + 0.5) * radial_divider_angle_rad_;
+  const bool is_front_side = std::sin(theta) > 0.0;
+  float prev_gnd_radius = 0.0f;
+  float prev_gnd_height = 0.0f;
+  float prev_gnd_slope = 0.0f;
+  if (use_virtual_ground_point_ && is_front_side) {
+    prev_gnd_radius = std::hypot(virtual_ground_point.x, virtual_ground_point.y);
+    prev_gnd_height = virtual_ground_point.z;
+  }
+
+  const size_t left_div = (radial_div + radial_dividers_num_ - 1) % radial_dividers_num_;
+  const size_t right_div = (radial_div + 1) % radial_dividers_num_;
+  // sweep from the inner to the outer cells
+  for (size_t radial_bin = 0; radial_bin < grid_radial_bins_num_; ++radial_bin) {
+    auto & cell = grid_cells_[radial_div * grid_radial_bins_num_ + radial_bin];
+    if (cell.point_num == 0) {
+      continue;
+    }
+    const float cell_radius = (radial_bin + 0.5f) * grid_radial_size_;
+
+    // lowest point around the cell, so that a cell covered by an object is judged by the ground
+    // seen by its neighbors (empty cells keep the max float as their min height)
+    const float min_height = std::min(
+      {cell.min_height, grid_cells_[left_div * grid_radial_bins_num_ + radial_bin].min_height,
+       grid_cells_[right_div * grid_radial_bins_num_ + radial_bin].min_height});
+
+    const float global_slope = std::atan2(min_height, cell_radius);
+    // cells inside the virtual ground point are only checked by the global slope
+    const float local_slope =
+      cell_radius > prev_gnd_radius
+        ? std::atan2(min_height - prev_gnd_height, cell_radius - prev_gnd_radius)
+        : prev_gnd_slope;
+    if (
+      global_slope <= global_slope_max_angle_rad_ &&
+      local_slope - prev_gnd_slope <= local_slope_max_angle_rad_) {
+      // flat cells are leveled at their average height, the others at their lowest point
+      const float average_height = cell.getAverageHeight();
+      cell.ground_height =
+        average_height - min_height < split_height_distance_ ? average_height : min_height;
 
       // update the ground state
-      prev_point_label = p->point_state;
-      if (p->point_state == PointLabel::GROUND) {
-        prev_gnd_radius = p->radius;
-        prev_gnd_point = pcl::PointXYZ(p->orig_point->x, p->orig_point->y, p->orig_point->z);
-        ground_cluster.addPoint(p->radius, p->orig_point->z);
-        prev_gnd_slope = ground_cluster.getAverageSlope();
-      }
-      // update the non ground state
-      if (p->point_state == PointLabel::NON_GROUND) {
-        non_ground_cluster.addPoint(p->radius, p->orig_point->z);
-      }
+      prev_gnd_radius = cell_radius;
+      prev_gnd_height = cell.ground_height;
+      prev_gnd_slope = std::atan2(prev_gnd_height, prev_gnd_radius);
+    } else {
+      // no ground in the cell, the ground continues from the last ground cell
+      cell.ground_height = prev_gnd_height;
     }
   }
 }
@@ -222,15 +328,16 @@ void ScanGroundFilterComponent::filter(
   pcl::PointCloud<pcl::PointXYZ>::Ptr current_sensor_cloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(*input, *current_sensor_cloud_ptr);
 
-  std::vector<PointCloudRefVector> radial_ordered_points;
-
-  convertPointcloud(current_sensor_cloud_ptr, radial_ordered_points);
-
   pcl::PointIndices no_ground_indices;
   pcl::PointCloud<pcl::PointXYZ>::Ptr no_ground_cloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
   no_ground_cloud_ptr->points.reserve(current_sensor_cloud_ptr->points.size());
 
-  classifyPointCloud(radial_ordered_points, no_ground_indices);
+  if (grid_mode_) {
+    classifyPointCloudInGrid(current_sensor_cloud_ptr, no_ground_indices);
+  } else {
+    convertPointcloud(current_sensor_cloud_ptr);
+    classifyPointCloud(no_ground_indices);
+  }
 
   extractObjectPoints(current_sensor_cloud_ptr, no_ground_indices, no_ground_cloud_ptr);
 
@@ -277,6 +384,21 @@ rcl_interfaces::msg::SetParametersResult ScanGroundFilterComponent::onParameter(
       get_logger(),
       "Setting use_virtual_ground_point to: " << std::boolalpha << use_virtual_ground_point_);
   }
+  if (get_param(p, "grid_mode", grid_mode_)) {
+    RCLCPP_DEBUG_STREAM(get_logger(), "Setting grid_mode to: " << std::boolalpha << grid_mode_);
+  }
+  const bool grid_radial_size_updated = get_param(p, "grid_radial_size", grid_radial_size_);
+  const bool grid_max_radius_updated = get_param(p, "grid_max_radius", grid_max_radius_);
+  if (grid_radial_size_updated || grid_max_radius_updated) {
+    grid_radial_bins_num_ =
+      std::max(static_cast<size_t>(std::ceil(grid_max_radius_ / grid_radial_size_)), size_t{1});
+    RCLCPP_DEBUG(get_logger(), "Setting grid_radial_size to: %f.", grid_radial_size_);
+    RCLCPP_DEBUG(get_logger(), "Setting grid_max_radius to: %f.", grid_max_radius_);
+  }
+  if (get_param(p, "num_threads", num_threads_)) {
+    num_threads_ = std::max(num_threads_, 1);
+    RCLCPP_DEBUG(get_logger(), "Setting num_threads to: %d.", num_threads_);
+  }
 
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
@@ -286,6 +408,3 @@ rcl_interfaces::msg::SetParametersResult ScanGroundFilterComponent::onParameter(
 }
 
 }  // namespace ground_segmentation
-
-#include <rclcpp_components/register_node_macro.hpp>
-RCLCPP_COMPONENTS_REGISTER_NODE(ground_segmentation::ScanGroundFilterComponent)
@@ -15,9 +15,12 @@
 #ifndef HEATMAP_VISUALIZER__HEATMAP_VISUALIZER_NODE_HPP_
 #define HEATMAP_VISUALIZER__HEATMAP_VISUALIZER_NODE_HPP_
 
+#include "heatmap_visualizer/utils.hpp"
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_auto_perception_msgs/msg/detected_objects.hpp>
+#include <map_msgs/msg/occupancy_grid_update.hpp>
 #include <nav_msgs/msg/occupancy_grid.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
@@ -53,10 +56,13 @@ private:
 
   // Publishers
   std::map<uint8_t, rclcpp::Publisher<nav_msgs::msg::OccupancyGrid>::SharedPtr> heatmap_pubs_;
+  std::map<uint8_t, rclcpp::Publisher<map_msgs::msg::OccupancyGridUpdate>::SharedPtr>
+    heatmap_update_pubs_;
 
   std::map<uint8_t, nav_msgs::msg::OccupancyGrid> heatmaps_;
 
   uint32_t frame_count_;
+  uint32_t publish_count_;
 
   // ROS params
   uint32_t total_frame_;
@@ -69,11 +75,13 @@ private:
   std::vector<std::string> class_names_{"CAR",     "TRUCK",     "BUS",       "TRAILER",
                                         "BICYCLE", "MOTORBIKE", "PEDESTRIAN"};
   bool rename_car_to_truck_and_bus_;
+  bool publish_heatmap_updates_;
+  uint32_t full_heatmap_interval_;
 
   // Number of width and height cells
   uint32_t width_;
   uint32_t height_;
-  std::map<uint8_t, std::vector<float>> data_buffers_;
+  std::map<uint8_t, HeatmapBuffer> data_buffers_;
 };  // class HeatmapVisualizerNode
 
 }  // namespace heatmap_visualizer
@@ -19,6 +19,7 @@
 #include <autoware_auto_perception_msgs/msg/detected_objects.hpp>
 #include <autoware_auto_perception_msgs/msg/object_classification.hpp>
 #include <geometry_msgs/msg/pose.hpp>
+#include <map_msgs/msg/occupancy_grid_update.hpp>
 #include <nav_msgs/msg/occupancy_grid.hpp>
 
 #ifdef ROS_DISTRO_GALACTIC
@@ -27,6 +28,7 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -45,6 +47,16 @@ struct IndexXYT
   int theta;
 };  // struct IndexXYT
 
+/**
+ * @brief Buffer of heatmap values with the indices of its nonzero cells
+ *
+ */
+struct HeatmapBuffer
+{
+  std::vector<float> data;
+  std::vector<uint32_t> nonzero_cells;
+};  // struct HeatmapBuffer
+
 /**
  * @brief
  *
@@ -76,17 +88,20 @@ IndexXYT pose2index(
  */
 void setHeatmapToBuffer(
   const autoware_auto_perception_msgs::msg::DetectedObject & obj,
-  const nav_msgs::msg::OccupancyGrid & heatmap, std::vector<float> * data_buffer,
+  const nav_msgs::msg::OccupancyGrid & heatmap, HeatmapBuffer * data_buffer,
   const bool use_confidence);
 
 /**
- * @brief Set the Heatmap To Occupancy Grid object
+ * @brief Set the Heatmap To Occupancy Grid object, visiting only the nonzero cells of the buffer
  *
  * @param data_buffer
  * @param heatmap
+ * @param update the smallest area of the heatmap containing the changed cells, which is empty if
+ *        no cell is changed
  */
 void setHeatmapToOccupancyGrid(
-  const std::vector<float> & data_buffer, nav_msgs::msg::OccupancyGrid * heatmap);
+  const HeatmapBuffer & data_buffer, nav_msgs::msg::OccupancyGrid * heatmap,
+  map_msgs::msg::OccupancyGridUpdate * update);
 
 /**
  * @brief Get the Semantic Type object
@@ -24,7 +24,7 @@
 namespace heatmap_visualizer
 {
 HeatmapVisualizerNode::HeatmapVisualizerNode(const rclcpp::NodeOptions & node_options)
-: Node("heatmap_visualizer", node_options), frame_count_(0)
+: Node("heatmap_visualizer", node_options), frame_count_(0), publish_count_(0)
 {
   total_frame_ = declare_parameter("frame_count", 50);
   map_frame_ = declare_parameter("map_frame", "base_link");
@@ -33,6 +33,9 @@ HeatmapVisualizerNode::HeatmapVisualizerNode(const rclcpp::NodeOptions & node_op
   use_confidence_ = declare_parameter("use_confidence", false);
   class_names_ = declare_parameter("class_names", class_names_);
   rename_car_to_truck_and_bus_ = declare_parameter("rename_car_to_truck_and_bus", false);
+  publish_heatmap_updates_ = declare_parameter("publish_heatmap_updates", false);
+  full_heatmap_interval_ =
+    std::max(static_cast<int>(declare_parameter("full_heatmap_interval", 10)), 1);
 
   width_ = static_cast<uint32_t>(map_length_ / map_resolution_);
   height_ = static_cast<uint32_t>(map_length_ / map_resolution_);
@@ -51,8 +54,8 @@ HeatmapVisualizerNode::HeatmapVisualizerNode(const rclcpp::NodeOptions & node_op
     heatmap.info.origin.position.y = -map_length_ / 2;
     heatmap.data.resize(width_ * height_, 0);
 
-    std::vector<float> buffer;
-    buffer.resize(width_ * height_, 0);
+    HeatmapBuffer buffer;
+    buffer.data.resize(width_ * height_, 0);
 
     uint8_t label = getSemanticType(key);
     bool is_car_like_vehicle = isCarLikeVehicleLabel(label);
@@ -63,12 +66,22 @@ HeatmapVisualizerNode::HeatmapVisualizerNode(const rclcpp::NodeOptions & node_op
 
       heatmap_pubs_.insert(std::make_pair(
         car_label, create_publisher<nav_msgs::msg::OccupancyGrid>("~/output/heatmap/CAR", 10.0)));
+      if (publish_heatmap_updates_) {
+        heatmap_update_pubs_.insert(std::make_pair(
+          car_label, create_publisher<map_msgs::msg::OccupancyGridUpdate>(
+                       "~/output/heatmap/CAR_updates", 10.0)));
+      }
     } else {
       heatmaps_.insert(std::make_pair(label, heatmap));
       data_buffers_.insert(std::make_pair(label, buffer));
 
       heatmap_pubs_.insert(std::make_pair(
         label, create_publisher<nav_msgs::msg::OccupancyGrid>("~/output/heatmap/" + key, 10.0)));
+      if (publish_heatmap_updates_) {
+        heatmap_update_pubs_.insert(std::make_pair(
+          label, create_publisher<map_msgs::msg::OccupancyGridUpdate>(
+                   "~/output/heatmap/" + key + "_updates", 10.0)));
+      }
     }
   }
 }
@@ -81,17 +94,26 @@ void HeatmapVisualizerNode::detectedObjectsCallback(
     uint8_t label = obj.classification[0].label;
     bool is_car_like_vehicle = isCarLikeVehicleLabel(label);
     if ((!rename_car_to_truck_and_bus_) && (is_car_like_vehicle)) {
-      label = getSemanticType("CAR");
+      label = Label::CAR;
     }
     // Set value to data buffer
     setHeatmapToBuffer(obj, heatmaps_.at(label), &data_buffers_.at(label), use_confidence_);
   }
   // Publish messages if frame_count_ == total_frame_
   if (frame_count_ == total_frame_) {
+    // Publish only the changed areas between the full heatmaps if publish_heatmap_updates_
+    const bool publish_full_heatmap =
+      !publish_heatmap_updates_ || publish_count_ % full_heatmap_interval_ == 0;
+    map_msgs::msg::OccupancyGridUpdate update;
     for (auto & map : heatmaps_) {
-      setHeatmapToOccupancyGrid(data_buffers_.at(map.first), &map.second);
-      heatmap_pubs_.at(map.first)->publish(map.second);
+      setHeatmapToOccupancyGrid(data_buffers_.at(map.first), &map.second, &update);
+      if (publish_full_heatmap) {
+        heatmap_pubs_.at(map.first)->publish(map.second);
+      } else if (!update.data.empty()) {
+        heatmap_update_pubs_.at(map.first)->publish(update);
+      }
     }
+    publish_count_ += 1;
     // Reset frame count
     frame_count_ = 0;
   }
@@ -19,7 +19,9 @@
 
 #include <tf2/utils.h>
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <numeric>
 
 namespace heatmap_visualizer
@@ -45,7 +47,7 @@ IndexXYT pose2index(
 
 void setHeatmapToBuffer(
   const autoware_auto_perception_msgs::msg::DetectedObject & obj,
-  const nav_msgs::msg::OccupancyGrid & heatmap, std::vector<float> * data_buffer,
+  const nav_msgs::msg::OccupancyGrid & heatmap, HeatmapBuffer * data_buffer,
   const bool use_confidence)
 {
   int theta_size = 48;
@@ -63,26 +65,72 @@ void setHeatmapToBuffer(
   }
 
   try {
-    data_buffer->at(indexY * mapWidth + indexX) += score;
+    const int index = indexY * mapWidth + indexX;
+    float & value = data_buffer->data.at(index);
+    if (value == 0.0 && score != 0.0) {
+      data_buffer->nonzero_cells.push_back(index);
+    }
+    value += score;
   } catch (const std::out_of_range & e) {
     RCLCPP_ERROR(rclcpp::get_logger("setHeatmapToBuffer"), e.what());
   }
 }
 
 void setHeatmapToOccupancyGrid(
-  const std::vector<float> & data_buffer, nav_msgs::msg::OccupancyGrid * heatmap)
+  const HeatmapBuffer & data_buffer, nav_msgs::msg::OccupancyGrid * heatmap,
+  map_msgs::msg::OccupancyGridUpdate * update)
 {
-  float max_value = *std::max_element(data_buffer.begin(), data_buffer.end());
-  float min_value = *std::min_element(data_buffer.begin(), data_buffer.end());
-  if (max_value == min_value) {
+  update->header = heatmap->header;
+  update->x = 0;
+  update->y = 0;
+  update->width = 0;
+  update->height = 0;
+  update->data.clear();
+
+  // the cells out of the nonzero cells are zero
+  const bool has_zero_cell = data_buffer.nonzero_cells.size() < data_buffer.data.size();
+  float max_value = has_zero_cell ? 0.0 : std::numeric_limits<float>::lowest();
+  float min_value = has_zero_cell ? 0.0 : std::numeric_limits<float>::max();
+  for (const uint32_t i : data_buffer.nonzero_cells) {
+    max_value = std::max(max_value, data_buffer.data[i]);
+    min_value = std::min(min_value, data_buffer.data[i]);
+  }
+  if (data_buffer.nonzero_cells.empty() || max_value == min_value) {
+    return;
+  }
+
+  // The scores aren't negative, so the minimum is zero while there is a zero cell, and the zero
+  // cells keep the zero they are initialized with.
+  const uint32_t width = heatmap->info.width;
+  uint32_t min_x = width;
+  uint32_t min_y = heatmap->info.height;
+  uint32_t max_x = 0;
+  uint32_t max_y = 0;
+  for (const uint32_t i : data_buffer.nonzero_cells) {
+    const auto value = static_cast<int8_t>(
+      static_cast<uint8_t>(100 * (data_buffer.data[i] - min_value) / (max_value - min_value)));
+    if (heatmap->data[i] == value) {
+      continue;
+    }
+    heatmap->data[i] = value;
+    min_x = std::min(min_x, i % width);
+    min_y = std::min(min_y, i / width);
+    max_x = std::max(max_x, i % width);
+    max_y = std::max(max_y, i / width);
+  }
+  if (min_x > max_x) {
     return;
   }
 
-  for (size_t i = 0; i < heatmap->data.size(); ++i) {
-    heatmap->data[i] =
-      static_cast<uint8_t>(100 * (data_buffer[i] - min_value) / (max_value - min_value));
+  update->x = min_x;
+  update->y = min_y;
+  update->width = max_x - min_x + 1;
+  update->height = max_y - min_y + 1;
+  update->data.resize(update->width * update->height);
+  for (uint32_t y = 0; y < update->height; ++y) {
+    const auto row = heatmap->data.begin() + (min_y + y) * width + min_x;
+    std::copy(row, row + update->width, update->data.begin() + y * update->width);
   }
-  return;
 }
 
 uint8_t getSemanticType(const std::string & class_name)
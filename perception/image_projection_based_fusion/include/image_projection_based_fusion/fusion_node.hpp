@@ -23,15 +23,12 @@
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 #include <tier4_perception_msgs/msg/detected_objects_with_feature.hpp>
 
-#include <message_filters/pass_through.h>
-#include <message_filters/subscriber.h>
-#include <message_filters/sync_policies/approximate_time.h>
-#include <message_filters/synchronizer.h>
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -53,16 +50,10 @@ protected:
     const sensor_msgs::msg::CameraInfo::ConstSharedPtr input_camera_info_msg,
     const std::size_t camera_id);
 
-  void fusionCallback(
-    typename Msg::ConstSharedPtr input_msg,
-    DetectedObjectsWithFeature::ConstSharedPtr input_roi0_msg,
-    DetectedObjectsWithFeature::ConstSharedPtr input_roi1_msg,
-    DetectedObjectsWithFeature::ConstSharedPtr input_roi2_msg,
-    DetectedObjectsWithFeature::ConstSharedPtr input_roi3_msg,
-    DetectedObjectsWithFeature::ConstSharedPtr input_roi4_msg,
-    DetectedObjectsWithFeature::ConstSharedPtr input_roi5_msg,
-    DetectedObjectsWithFeature::ConstSharedPtr input_roi6_msg,
-    DetectedObjectsWithFeature::ConstSharedPtr input_roi7_msg);
+  void subCallback(const typename Msg::ConstSharedPtr input_msg);
+  void roiCallback(
+    const DetectedObjectsWithFeature::ConstSharedPtr input_roi_msg, const std::size_t roi_i);
+  void timeoutCallback();
 
   virtual void preprocess(Msg & output_msg);
 
@@ -76,6 +67,10 @@ protected:
 
   void publish(const Msg & output_msg);
 
+  void fuseCachedMsg(const std::size_t roi_i, const DetectedObjectsWithFeature & input_roi_msg);
+  bool isMatched(const rclcpp::Time & stamp, const DetectedObjectsWithFeature & roi_msg) const;
+  void publishCachedMsg();
+
   std::size_t rois_number_{1};
   tf2_ros::Buffer tf_buffer_;
   tf2_ros::TransformListener tf_listener_;
@@ -85,19 +80,20 @@ protected:
   std::vector<rclcpp::Subscription<sensor_msgs::msg::CameraInfo>::SharedPtr> camera_info_subs_;
 
   // fusion
-  typename message_filters::Subscriber<Msg> sub_;
-  message_filters::PassThrough<DetectedObjectsWithFeature> passthrough_;
-  std::vector<std::shared_ptr<message_filters::Subscriber<DetectedObjectsWithFeature>>> rois_subs_;
-  inline void dummyCallback(DetectedObjectsWithFeature::ConstSharedPtr input)
-  {
-    passthrough_.add(input);
-  }
-  using SyncPolicy = message_filters::sync_policies::ApproximateTime<
-    Msg, DetectedObjectsWithFeature, DetectedObjectsWithFeature, DetectedObjectsWithFeature,
-    DetectedObjectsWithFeature, DetectedObjectsWithFeature, DetectedObjectsWithFeature,
-    DetectedObjectsWithFeature, DetectedObjectsWithFeature>;
-  using Sync = message_filters::Synchronizer<SyncPolicy>;
-  typename std::shared_ptr<Sync> sync_ptr_;
+  typename rclcpp::Subscription<Msg>::SharedPtr sub_;
+  std::vector<rclcpp::Subscription<DetectedObjectsWithFeature>::SharedPtr> rois_subs_;
+
+  // the input being fused, each camera fused into it as soon as its rois arrive, and published
+  // once every camera is fused or timeout_ms after the input arrived
+  std::mutex mutex_;
+  typename Msg::ConstSharedPtr cached_msg_;
+  Msg cached_output_msg_;
+  std::vector<bool> is_fused_;
+  // rois arrived before the input they belong to, by stamp
+  std::vector<std::map<int64_t, DetectedObjectsWithFeature::ConstSharedPtr>> cached_roi_msgs_;
+  rclcpp::TimerBase::SharedPtr timer_;
+  double timeout_ms_;
+  double match_threshold_ms_;
 
   // output
   typename rclcpp::Publisher<Msg>::SharedPtr pub_ptr_;
@@ -54,6 +54,7 @@ protected:
   std::vector<double> pointcloud_range;
   bool rename_car_to_truck_and_bus_{false};
   bool has_twist_{false};
+  bool use_gpu_painting_{false};
 
   std::unique_ptr<image_projection_based_fusion::PointPaintingTRT> detector_ptr_{nullptr};
 
@@ -15,11 +15,15 @@
 #ifndef IMAGE_PROJECTION_BASED_FUSION__POINTPAINTING_FUSION__POINTPAINTING_TRT_HPP_
 #define IMAGE_PROJECTION_BASED_FUSION__POINTPAINTING_FUSION__POINTPAINTING_TRT_HPP_
 
+#include <image_projection_based_fusion/pointpainting_fusion/preprocess_kernel.hpp>
 #include <image_projection_based_fusion/pointpainting_fusion/voxel_generator.hpp>
 #include <lidar_centerpoint/centerpoint_trt.hpp>
 
+#include <cstdint>
+#include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace image_projection_based_fusion
 {
@@ -31,16 +35,63 @@ public:
   explicit PointPaintingTRT(
     const centerpoint::NetworkParam & encoder_param, const centerpoint::NetworkParam & head_param,
     const centerpoint::DensificationParam & densification_param,
-    const centerpoint::CenterPointConfig & config);
+    const centerpoint::CenterPointConfig & config, const bool use_gpu_painting = false);
 
   ~PointPaintingTRT();
 
+  // with use_gpu_painting, the point cloud is painted on the device between setPointCloud() and
+  // detect(), the point cloud given to detect() only providing the header
+
+  // upload the points within the x and y range as the current frame, returns the number of points
+  std::size_t setPointCloud(const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg);
+
+  // paint the current frame with the rois of a camera, affine_to_camera transforming the points to
+  // the camera optical frame and projection being the projection matrix of the camera
+  void paintPointCloud(
+    const centerpoint::Affine3x4 & affine_to_camera, const centerpoint::Affine3x4 & projection,
+    const std::vector<PaintRoi> & rois);
+
+  // download the painted current frame, with the fields x, y, z, CAR, PEDESTRIAN and BICYCLE
+  void downloadPaintedPointCloud(sensor_msgs::msg::PointCloud2 & painted_pointcloud_msg);
+
 protected:
   bool preprocess(
-    const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg,
-    const tf2_ros::Buffer & tf_buffer) override;
+    const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer,
+    const std::size_t batch_index) override;
 
   std::unique_ptr<image_projection_based_fusion::VoxelGenerator> vg_ptr_pp_{nullptr};
+  // the painted point cloud is voxelized on the host
+  std::vector<float> voxels_;
+  std::vector<int> coordinates_;
+  std::vector<float> num_points_per_voxel_;
+
+  // the painted point cloud is voxelized on the device with use_gpu_painting
+  struct Sweep
+  {
+    cuda::unique_ptr<float[]> points_d{nullptr};
+    std::size_t capacity{0};
+    std::size_t num_points{0};
+  };
+
+  bool preprocessOnDevice();
+
+  bool use_gpu_painting_{false};
+  std::size_t pointcloud_cache_size_{1};
+  std::list<Sweep> sweeps_;  // from the current frame to the oldest past frame, not transformed
+  std::size_t grid_size_{0};
+  std::size_t data_capacity_{0};
+  cuda::unique_ptr<std::uint8_t[]> data_d_{nullptr};
+  std::size_t point_mask_capacity_{0};
+  cuda::unique_ptr<int[]> point_mask_d_{nullptr};
+  cuda::unique_ptr<int[]> point_idx_d_{nullptr};
+  std::size_t points_capacity_{0};
+  cuda::unique_ptr<float[]> points_d_{nullptr};  // the frames gathered, with past frames only
+  cuda::unique_ptr<int[]> point_cells_d_{nullptr};
+  cuda::unique_ptr<int[]> cell_mask_d_{nullptr};
+  cuda::unique_ptr<int[]> cell_voxel_idx_d_{nullptr};
+  cuda::unique_ptr<unsigned int[]> voxel_point_counts_d_{nullptr};
+  std::size_t rois_capacity_{0};
+  cuda::unique_ptr<PaintRoi[]> rois_d_{nullptr};
 };
 }  // namespace image_projection_based_fusion
 
@@ -15,11 +15,62 @@
 #ifndef IMAGE_PROJECTION_BASED_FUSION__POINTPAINTING_FUSION__PREPROCESS_KERNEL_HPP_
 #define IMAGE_PROJECTION_BASED_FUSION__POINTPAINTING_FUSION__PREPROCESS_KERNEL_HPP_
 
+#include <lidar_centerpoint/preprocess/preprocess_kernel.hpp>
+
 #include <cuda.h>
 #include <cuda_runtime_api.h>
 
+#include <cstdint>
+
 namespace image_projection_based_fusion
 {
+// the painted points: x, y, z and a channel per painted class
+constexpr std::size_t PAINTED_POINT_FEATURE_SIZE = 6;
+
+// a roi of a camera, painting the points projected into it with a class channel from 0 to 2
+struct PaintRoi
+{
+  float min_x;
+  float min_y;
+  float max_x;
+  float max_y;
+  int channel;
+};
+
+// extract the points strictly within the x and y range from the raw data of a point cloud, keeping
+// their order, with their class channels zeroed; point_mask and point_idx are scratch buffers of
+// num_points and the extracted points are counted by reading them back
+cudaError_t extractPoints_launch(
+  const std::uint8_t * data, const std::size_t num_points, const std::size_t point_step,
+  const std::size_t x_offset, const std::size_t y_offset, const std::size_t z_offset,
+  const float range_min_x, const float range_min_y, const float range_max_x,
+  const float range_max_y, int * point_mask, int * point_idx, float * points,
+  cudaStream_t stream);
+
+// paint the points whose projection with the camera is inside a roi of the camera
+cudaError_t paintPoints_launch(
+  float * points, const std::size_t num_points, const centerpoint::Affine3x4 & affine_to_camera,
+  const centerpoint::Affine3x4 & projection, const PaintRoi * rois, const std::size_t num_rois,
+  cudaStream_t stream);
+
+// compute the grid cell of each painted point, -1 if out of range, and mark the occupied cells
+cudaError_t generatePointCells_launch(
+  const float * points, const std::size_t num_points, const float range_min_x,
+  const float range_min_y, const float range_min_z, const float recip_voxel_size_x,
+  const float recip_voxel_size_y, const float recip_voxel_size_z, const int grid_size_x,
+  const int grid_size_y, const int grid_size_z, int * point_cells, int * cell_mask,
+  cudaStream_t stream);
+
+// gather the painted points into the voxels of the occupied cells, cell_voxel_idx being the voxel
+// index of every cell, voxel_point_counts being zero-initialized
+cudaError_t generateVoxels_launch(
+  const float * points, const int * point_cells, const std::size_t num_points,
+  const int * cell_mask, const std::size_t grid_size_x, const std::size_t grid_size_y,
+  const std::size_t grid_size_z, const std::size_t max_voxel_size,
+  const std::size_t max_point_in_voxel_size, int * cell_voxel_idx,
+  unsigned int * voxel_point_counts, float * voxel_features, int * coords,
+  float * voxel_num_points, cudaStream_t stream);
+
 cudaError_t generateFeatures_launch(
   const float * voxel_features, const float * voxel_num_points, const int * coords,
   const std::size_t num_voxels, const std::size_t max_voxel_size, const float voxel_size_x,
@@ -17,7 +17,11 @@
 
 #include "image_projection_based_fusion/fusion_node.hpp"
 
+#include <Eigen/Core>
+
+#include <array>
 #include <memory>
+#include <vector>
 
 namespace image_projection_based_fusion
 {
@@ -42,6 +46,10 @@ protected:
   bool use_iou_{false};
   bool use_cluster_semantic_type_{false};
   float iou_threshold_{0.0f};
+  bool use_cluster_hull_{false};
+
+  // corners of the bounding box of each cluster in the cluster frame, computed once per input
+  std::vector<std::array<Eigen::Vector3f, 8>> cluster_corners_;
 
   bool out_of_scope(const DetectedObjectWithFeature & obj);
 };
@@ -32,6 +32,10 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
 #include <typeinfo>
 namespace image_projection_based_fusion
 {
@@ -53,8 +57,13 @@ FusionNode<Msg, ObjType>::FusionNode(
     rois_number_ = 8;
   }
 
+  timeout_ms_ = declare_parameter("timeout_ms", 70.0);
+  match_threshold_ms_ = declare_parameter("match_threshold_ms", 50.0);
+
   // subscribers
-  sub_.subscribe(this, "input", rclcpp::QoS(1).get_rmw_qos_profile());
+  std::function<void(const typename Msg::ConstSharedPtr msg)> sub_callback =
+    std::bind(&FusionNode::subCallback, this, std::placeholders::_1);
+  sub_ = this->create_subscription<Msg>("input", rclcpp::QoS(1), sub_callback);
 
   camera_info_subs_.resize(rois_number_);
   for (std::size_t roi_i = 0; roi_i < rois_number_; ++roi_i) {
@@ -66,63 +75,18 @@ FusionNode<Msg, ObjType>::FusionNode(
 
   rois_subs_.resize(rois_number_);
   for (std::size_t roi_i = 0; roi_i < rois_number_; ++roi_i) {
-    rois_subs_.at(roi_i) =
-      std::make_shared<message_filters::Subscriber<DetectedObjectsWithFeature>>(
-        this, "input/rois" + std::to_string(roi_i), rclcpp::QoS{1}.get_rmw_qos_profile());
-  }
-
-  // add dummy callback to enable passthrough filter
-  rois_subs_.at(0)->registerCallback(
-    std::bind(&FusionNode::dummyCallback, this, std::placeholders::_1));
-  switch (rois_number_) {
-    case 1:
-      sync_ptr_ = std::make_shared<Sync>(
-        SyncPolicy(10), sub_, *rois_subs_.at(0), passthrough_, passthrough_, passthrough_,
-        passthrough_, passthrough_, passthrough_, passthrough_);
-      break;
-    case 2:
-      sync_ptr_ = std::make_shared<Sync>(
-        SyncPolicy(10), sub_, *rois_subs_.at(0), *rois_subs_.at(1), passthrough_, passthrough_,
-        passthrough_, passthrough_, passthrough_, passthrough_);
-      break;
-    case 3:
-      sync_ptr_ = std::make_shared<Sync>(
-        SyncPolicy(10), sub_, *rois_subs_.at(0), *rois_subs_.at(1), *rois_subs_.at(2), passthrough_,
-        passthrough_, passthrough_, passthrough_, passthrough_);
-      break;
-    case 4:
-      sync_ptr_ = std::make_shared<Sync>(
-        SyncPolicy(10), sub_, *rois_subs_.at(0), *rois_subs_.at(1), *rois_subs_.at(2),
-        *rois_subs_.at(3), passthrough_, passthrough_, passthrough_, passthrough_);
-      break;
-    case 5:
-      sync_ptr_ = std::make_shared<Sync>(
-        SyncPolicy(10), sub_, *rois_subs_.at(0), *rois_subs_.at(1), *rois_subs_.at(2),
-        *rois_subs_.at(3), *rois_subs_.at(4), passthrough_, passthrough_, passthrough_);
-      break;
-    case 6:
-      sync_ptr_ = std::make_shared<Sync>(
-        SyncPolicy(10), sub_, *rois_subs_.at(0), *rois_subs_.at(1), *rois_subs_.at(2),
-        *rois_subs_.at(3), *rois_subs_.at(4), *rois_subs_.at(5), passthrough_, passthrough_);
-      break;
-    case 7:
-      sync_ptr_ = std::make_shared<Sync>(
-        SyncPolicy(10), sub_, *rois_subs_.at(0), *rois_subs_.at(1), *rois_subs_.at(2),
-        *rois_subs_.at(3), *rois_subs_.at(4), *rois_subs_.at(5), *rois_subs_.at(6), passthrough_);
-      break;
-    case 8:
-      sync_ptr_ = std::make_shared<Sync>(
-        SyncPolicy(10), sub_, *rois_subs_.at(0), *rois_subs_.at(1), *rois_subs_.at(2),
-        *rois_subs_.at(3), *rois_subs_.at(4), *rois_subs_.at(5), *rois_subs_.at(6),
-        *rois_subs_.at(7));
-    default:
-      return;
+    std::function<void(const DetectedObjectsWithFeature::ConstSharedPtr msg)> roi_callback =
+      std::bind(&FusionNode::roiCallback, this, std::placeholders::_1, roi_i);
+    rois_subs_.at(roi_i) = this->create_subscription<DetectedObjectsWithFeature>(
+      "input/rois" + std::to_string(roi_i), rclcpp::QoS{1}, roi_callback);
   }
+  is_fused_.resize(rois_number_, false);
+  cached_roi_msgs_.resize(rois_number_);
 
-  sync_ptr_->registerCallback(std::bind(
-    &FusionNode::fusionCallback, this, std::placeholders::_1, std::placeholders::_2,
-    std::placeholders::_3, std::placeholders::_4, std::placeholders::_5, std::placeholders::_6,
-    std::placeholders::_7, std::placeholders::_8, std::placeholders::_9));
+  const auto timeout = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::duration<double, std::milli>(timeout_ms_));
+  timer_ = this->create_wall_timer(timeout, std::bind(&FusionNode::timeoutCallback, this));
+  timer_->cancel();
 
   // publisher
   pub_ptr_ = this->create_publisher<Msg>("output", rclcpp::QoS{1});
@@ -157,67 +121,112 @@ void FusionNode<Msg, Obj>::preprocess(Msg & ouput_msg __attribute__((unused)))
 }
 
 template <class Msg, class Obj>
-void FusionNode<Msg, Obj>::fusionCallback(
-  typename Msg::ConstSharedPtr input_msg, DetectedObjectsWithFeature::ConstSharedPtr input_roi0_msg,
-  DetectedObjectsWithFeature::ConstSharedPtr input_roi1_msg,
-  DetectedObjectsWithFeature::ConstSharedPtr input_roi2_msg,
-  DetectedObjectsWithFeature::ConstSharedPtr input_roi3_msg,
-  DetectedObjectsWithFeature::ConstSharedPtr input_roi4_msg,
-  DetectedObjectsWithFeature::ConstSharedPtr input_roi5_msg,
-  DetectedObjectsWithFeature::ConstSharedPtr input_roi6_msg,
-  DetectedObjectsWithFeature::ConstSharedPtr input_roi7_msg)
+void FusionNode<Msg, Obj>::subCallback(const typename Msg::ConstSharedPtr input_msg)
 {
-  Msg output_msg = *input_msg;
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (cached_msg_) {
+    // a camera missed the previous input altogether
+    timer_->cancel();
+    publishCachedMsg();
+  }
 
-  preprocess(output_msg);
+  cached_msg_ = input_msg;
+  cached_output_msg_ = *input_msg;
+  preprocess(cached_output_msg_);
+  std::fill(is_fused_.begin(), is_fused_.end(), false);
 
-  for (std::size_t image_id = 0; image_id < rois_subs_.size(); ++image_id) {
-    DetectedObjectsWithFeature::ConstSharedPtr input_roi_msg;
-    switch (image_id) {
-      case 0:
-        input_roi_msg = input_roi0_msg;
-        break;
-      case 1:
-        input_roi_msg = input_roi1_msg;
-        break;
-      case 2:
-        input_roi_msg = input_roi2_msg;
-        break;
-      case 3:
-        input_roi_msg = input_roi3_msg;
-        break;
-      case 4:
-        input_roi_msg = input_roi4_msg;
-        break;
-      case 5:
-        input_roi_msg = input_roi5_msg;
-        break;
-      case 6:
-        input_roi_msg = input_roi6_msg;
-        break;
-      case 7:
-        input_roi_msg = input_roi7_msg;
+  const rclcpp::Time stamp(input_msg->header.stamp);
+  for (std::size_t roi_i = 0; roi_i < rois_number_; ++roi_i) {
+    auto & cached_roi_msgs = cached_roi_msgs_.at(roi_i);
+    auto matched = cached_roi_msgs.end();
+    for (auto it = cached_roi_msgs.begin(); it != cached_roi_msgs.end(); ++it) {
+      if (isMatched(stamp, *it->second)) {
+        matched = it;
         break;
-      default:
-        RCLCPP_ERROR(this->get_logger(), "invalid image id. id is %zu", image_id);
-        return;
+      }
     }
-
-    if (camera_info_map_.find(image_id) == camera_info_map_.end()) {
-      RCLCPP_WARN(this->get_logger(), "no camera info. id is %zu", image_id);
+    if (matched == cached_roi_msgs.end()) {
       continue;
     }
-    if (debugger_) {
-      debugger_->clear();
+    fuseCachedMsg(roi_i, *matched->second);
+    // the older rois will not match any later input
+    cached_roi_msgs.erase(cached_roi_msgs.begin(), std::next(matched));
+  }
+
+  if (std::all_of(is_fused_.begin(), is_fused_.end(), [](const bool b) { return b; })) {
+    publishCachedMsg();
+  } else {
+    timer_->reset();
+  }
+}
+
+template <class Msg, class Obj>
+void FusionNode<Msg, Obj>::roiCallback(
+  const DetectedObjectsWithFeature::ConstSharedPtr input_roi_msg, const std::size_t roi_i)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (
+    cached_msg_ && !is_fused_.at(roi_i) &&
+    isMatched(rclcpp::Time(cached_msg_->header.stamp), *input_roi_msg)) {
+    fuseCachedMsg(roi_i, *input_roi_msg);
+    if (std::all_of(is_fused_.begin(), is_fused_.end(), [](const bool b) { return b; })) {
+      timer_->cancel();
+      publishCachedMsg();
     }
+    return;
+  }
+
+  // the rois may come before the input they belong to, as many as the old synchronizer queue
+  auto & cached_roi_msgs = cached_roi_msgs_.at(roi_i);
+  cached_roi_msgs[rclcpp::Time(input_roi_msg->header.stamp).nanoseconds()] = input_roi_msg;
+  constexpr std::size_t max_cached_roi_msgs = 10;
+  while (cached_roi_msgs.size() > max_cached_roi_msgs) {
+    cached_roi_msgs.erase(cached_roi_msgs.begin());
+  }
+}
+
+template <class Msg, class Obj>
+void FusionNode<Msg, Obj>::timeoutCallback()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  timer_->cancel();
+  if (cached_msg_) {
+    publishCachedMsg();
+  }
+}
+
+template <class Msg, class Obj>
+bool FusionNode<Msg, Obj>::isMatched(
+  const rclcpp::Time & stamp, const DetectedObjectsWithFeature & roi_msg) const
+{
+  const double diff_ms = std::abs((stamp - rclcpp::Time(roi_msg.header.stamp)).seconds()) * 1e3;
+  return diff_ms < match_threshold_ms_;
+}
 
-    fuseOnSingleImage(
-      *input_msg, image_id, *input_roi_msg, camera_info_map_.at(image_id), output_msg);
+template <class Msg, class Obj>
+void FusionNode<Msg, Obj>::fuseCachedMsg(
+  const std::size_t roi_i, const DetectedObjectsWithFeature & input_roi_msg)
+{
+  // a camera without camera info is not waited for
+  is_fused_.at(roi_i) = true;
+  if (camera_info_map_.find(roi_i) == camera_info_map_.end()) {
+    RCLCPP_WARN(this->get_logger(), "no camera info. id is %zu", roi_i);
+    return;
+  }
+  if (debugger_) {
+    debugger_->clear();
   }
 
-  postprocess(output_msg);
+  fuseOnSingleImage(
+    *cached_msg_, roi_i, input_roi_msg, camera_info_map_.at(roi_i), cached_output_msg_);
+}
 
-  publish(output_msg);
+template <class Msg, class Obj>
+void FusionNode<Msg, Obj>::publishCachedMsg()
+{
+  postprocess(cached_output_msg_);
+  publish(cached_output_msg_);
+  cached_msg_.reset();
 }
 
 template <class Msg, class Obj>
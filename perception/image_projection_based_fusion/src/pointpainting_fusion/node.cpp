@@ -23,6 +23,29 @@
 #include <tier4_autoware_utils/geometry/geometry.hpp>
 #include <tier4_autoware_utils/math/constants.hpp>
 
+namespace
+{
+// the class channel painted by a roi of the label, -1 if the roi does not paint
+int getPaintChannel(const uint8_t label)
+{
+  using autoware_auto_perception_msgs::msg::ObjectClassification;
+  switch (label) {
+    case ObjectClassification::CAR:
+    case ObjectClassification::TRUCK:
+    case ObjectClassification::TRAILER:
+    case ObjectClassification::BUS:
+      return 0;
+    case ObjectClassification::PEDESTRIAN:
+      return 1;
+    case ObjectClassification::BICYCLE:
+    case ObjectClassification::MOTORCYCLE:
+      return 2;
+    default:
+      return -1;
+  }
+}
+}  // namespace
+
 namespace image_projection_based_fusion
 {
 
@@ -47,6 +70,7 @@ PointpaintingFusionNode::PointpaintingFusionNode(const rclcpp::NodeOptions & opt
   class_names_ = this->declare_parameter<std::vector<std::string>>("class_names");
   rename_car_to_truck_and_bus_ = this->declare_parameter("rename_car_to_truck_and_bus", false);
   has_twist_ = this->declare_parameter("has_twist", false);
+  use_gpu_painting_ = this->declare_parameter("use_gpu_painting", true);
   const std::size_t point_feature_size =
     static_cast<std::size_t>(this->declare_parameter<std::int64_t>("point_feature_size"));
   const std::size_t max_voxel_size =
@@ -64,19 +88,32 @@ PointpaintingFusionNode::PointpaintingFusionNode(const rclcpp::NodeOptions & opt
     densification_world_frame_id, densification_num_past_frames);
   centerpoint::CenterPointConfig config(
     class_names_.size(), point_feature_size, max_voxel_size, pointcloud_range, voxel_size,
-    downsample_factor, encoder_in_feature_size, score_threshold, circle_nms_dist_threshold);
+    downsample_factor, encoder_in_feature_size, score_threshold, circle_nms_dist_threshold,
+    /*batch_size=*/1);
 
   // create detector
   detector_ptr_ = std::make_unique<image_projection_based_fusion::PointPaintingTRT>(
-    encoder_param, head_param, densification_param, config);
+    encoder_param, head_param, densification_param, config, use_gpu_painting_);
 
   // sub and pub
-  sub_.subscribe(this, "~/input/pointcloud", rmw_qos_profile_sensor_data);
+  std::function<void(const sensor_msgs::msg::PointCloud2::ConstSharedPtr msg)> sub_callback =
+    std::bind(&PointpaintingFusionNode::subCallback, this, std::placeholders::_1);
+  sub_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
+    "~/input/pointcloud", rclcpp::SensorDataQoS().keep_last(1), sub_callback);
   obj_pub_ptr_ = this->create_publisher<DetectedObjects>("~/output/objects", rclcpp::QoS{1});
 }
 
 void PointpaintingFusionNode::preprocess(sensor_msgs::msg::PointCloud2 & painted_pointcloud_msg)
 {
+  if (use_gpu_painting_) {
+    // the points are painted on the device, the message only keeps the header until postprocess
+    detector_ptr_->setPointCloud(painted_pointcloud_msg);
+    painted_pointcloud_msg.data.clear();
+    painted_pointcloud_msg.width = 0;
+    painted_pointcloud_msg.row_step = 0;
+    return;
+  }
+
   sensor_msgs::msg::PointCloud2 tmp;
   tmp = painted_pointcloud_msg;
 
@@ -150,6 +187,39 @@ void PointpaintingFusionNode::fuseOnSingleImage(
     camera_info.p.at(7), camera_info.p.at(8), camera_info.p.at(9), camera_info.p.at(10),
     camera_info.p.at(11);
 
+  if (use_gpu_painting_) {
+    const Eigen::Matrix4d affine = transformToEigen(transform_stamped.transform).matrix();
+    centerpoint::Affine3x4 affine_to_camera, projection;
+    for (int ri = 0; ri < 3; ri++) {
+      for (int ci = 0; ci < 4; ci++) {
+        affine_to_camera.m[ri * 4 + ci] = static_cast<float>(affine(ri, ci));
+        projection.m[ri * 4 + ci] = static_cast<float>(camera_projection(ri, ci));
+      }
+    }
+    std::vector<PaintRoi> paint_rois;
+    paint_rois.reserve(input_roi_msg.feature_objects.size());
+    for (const auto & feature_object : input_roi_msg.feature_objects) {
+      const auto & roi = feature_object.feature.roi;
+      debug_image_rois.push_back(roi);
+      const int channel = getPaintChannel(feature_object.object.classification.front().label);
+      if (channel < 0) {
+        continue;
+      }
+      paint_rois.push_back(PaintRoi{
+        static_cast<float>(roi.x_offset), static_cast<float>(roi.y_offset),
+        static_cast<float>(roi.x_offset + roi.width), static_cast<float>(roi.y_offset + roi.height),
+        channel});
+    }
+    detector_ptr_->paintPointCloud(affine_to_camera, projection, paint_rois);
+
+    // the painted points stay on the device, only the rois are drawn
+    if (debugger_) {
+      debugger_->image_rois_ = debug_image_rois;
+      debugger_->publishImage(image_id, input_roi_msg.header.stamp);
+    }
+    return;
+  }
+
   // transform
   sensor_msgs::msg::PointCloud2 transformed_pointcloud;
   tf2::doTransform(painted_pointcloud_msg, transformed_pointcloud, transform_stamped);
@@ -226,6 +296,9 @@ void PointpaintingFusionNode::postprocess(sensor_msgs::msg::PointCloud2 & painte
 {
   std::vector<centerpoint::Box3D> det_boxes3d;
   bool is_success = detector_ptr_->detect(painted_pointcloud_msg, tf_buffer_, det_boxes3d);
+  if (use_gpu_painting_ && pub_ptr_->get_subscription_count() > 0) {
+    detector_ptr_->downloadPaintedPointCloud(painted_pointcloud_msg);
+  }
   if (!is_success) {
     return;
   }
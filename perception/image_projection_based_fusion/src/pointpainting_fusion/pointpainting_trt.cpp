@@ -19,6 +19,10 @@
 #include <lidar_centerpoint/network/scatter_kernel.hpp>
 #include <tier4_autoware_utils/math/constants.hpp>
 
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -29,40 +33,249 @@ namespace image_projection_based_fusion
 PointPaintingTRT::PointPaintingTRT(
   const centerpoint::NetworkParam & encoder_param, const centerpoint::NetworkParam & head_param,
   const centerpoint::DensificationParam & densification_param,
-  const centerpoint::CenterPointConfig & config)
-: centerpoint::CenterPointTRT(encoder_param, head_param, densification_param, config)
+  const centerpoint::CenterPointConfig & config, const bool use_gpu_painting)
+: centerpoint::CenterPointTRT(encoder_param, head_param, densification_param, config),
+  use_gpu_painting_(use_gpu_painting),
+  pointcloud_cache_size_(densification_param.pointcloud_cache_size())
 {
+  if (use_gpu_painting_) {
+    grid_size_ = config_.grid_size_z_ * config_.grid_size_y_ * config_.grid_size_x_;
+    cell_mask_d_ = cuda::make_unique<int[]>(grid_size_);
+    cell_voxel_idx_d_ = cuda::make_unique<int[]>(grid_size_);
+    voxel_point_counts_d_ = cuda::make_unique<unsigned int[]>(config_.max_voxel_size_);
+    return;
+  }
   vg_ptr_pp_ =
     std::make_unique<image_projection_based_fusion::VoxelGenerator>(densification_param, config_);
+  voxels_.resize(
+    config_.max_voxel_size_ * config_.max_point_in_voxel_size_ * config_.point_feature_size_);
+  coordinates_.resize(config_.max_voxel_size_ * config_.point_dim_size_);
+  num_points_per_voxel_.resize(config_.max_voxel_size_);
 }
 
 bool PointPaintingTRT::preprocess(
-  const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer)
+  const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer,
+  const std::size_t batch_index)
 {
+  // the painted point cloud is inferred alone, i.e. batch_index is always 0
+  if (use_gpu_painting_) {
+    return preprocessOnDevice();
+  }
   bool is_success = vg_ptr_pp_->enqueuePointCloud(input_pointcloud_msg, tf_buffer);
   if (!is_success) {
     return false;
   }
-  num_voxels_ = vg_ptr_pp_->pointsToVoxels(voxels_, coordinates_, num_points_per_voxel_);
-  if (num_voxels_ == 0) {
+  std::fill(voxels_.begin(), voxels_.end(), 0);
+  std::fill(coordinates_.begin(), coordinates_.end(), -1);
+  std::fill(num_points_per_voxel_.begin(), num_points_per_voxel_.end(), 0);
+  const auto num_voxels = vg_ptr_pp_->pointsToVoxels(voxels_, coordinates_, num_points_per_voxel_);
+  if (num_voxels == 0) {
     return false;
   }
+  num_voxels_[batch_index] = num_voxels;
   const auto voxels_size =
-    num_voxels_ * config_.max_point_in_voxel_size_ * config_.point_feature_size_;
-  const auto coordinates_size = num_voxels_ * config_.point_dim_size_;
+    num_voxels * config_.max_point_in_voxel_size_ * config_.point_feature_size_;
+  const auto coordinates_size = num_voxels * config_.point_dim_size_;
   // memcpy from host to device (not copy empty voxels)
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    voxels_d_.get(), voxels_.data(), voxels_size * sizeof(float), cudaMemcpyHostToDevice));
+    voxels_d_.get(), voxels_.data(), voxels_size * sizeof(float), cudaMemcpyHostToDevice, stream_));
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
     coordinates_d_.get(), coordinates_.data(), coordinates_size * sizeof(int),
-    cudaMemcpyHostToDevice));
+    cudaMemcpyHostToDevice, stream_));
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    num_points_per_voxel_d_.get(), num_points_per_voxel_.data(), num_voxels * sizeof(float),
+    cudaMemcpyHostToDevice, stream_));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(stream_));
+
+  CHECK_CUDA_ERROR(image_projection_based_fusion::generateFeatures_launch(
+    voxels_d_.get(), num_points_per_voxel_d_.get(), coordinates_d_.get(), num_voxels,
+    config_.max_voxel_size_, config_.voxel_size_x_, config_.voxel_size_y_, config_.voxel_size_z_,
+    config_.range_min_x_, config_.range_min_y_, config_.range_min_z_, encoder_in_features_d_.get(),
+    stream_));
+
+  return true;
+}
+
+std::size_t PointPaintingTRT::setPointCloud(
+  const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg)
+{
+  // the kernels read x, y and z from the raw data of the point cloud
+  int x_offset = -1, y_offset = -1, z_offset = -1;
+  for (const auto & field : input_pointcloud_msg.fields) {
+    if (field.datatype != sensor_msgs::msg::PointField::FLOAT32) {
+      continue;
+    }
+    if (field.name == "x") {
+      x_offset = static_cast<int>(field.offset);
+    } else if (field.name == "y") {
+      y_offset = static_cast<int>(field.offset);
+    } else if (field.name == "z") {
+      z_offset = static_cast<int>(field.offset);
+    }
+  }
+  const std::size_t num_points = input_pointcloud_msg.width * input_pointcloud_msg.height;
+  const std::size_t data_size = num_points * input_pointcloud_msg.point_step;
+
+  // the buffer of the oldest frame is reused once the cache is full
+  if (sweeps_.size() >= pointcloud_cache_size_) {
+    sweeps_.splice(sweeps_.begin(), sweeps_, std::prev(sweeps_.end()));
+  } else {
+    sweeps_.emplace_front();
+  }
+  auto & sweep = sweeps_.front();
+  sweep.num_points = 0;
+  if (
+    x_offset < 0 || y_offset < 0 || z_offset < 0 ||
+    input_pointcloud_msg.row_step != input_pointcloud_msg.width * input_pointcloud_msg.point_step ||
+    input_pointcloud_msg.data.size() < data_size) {
+    RCLCPP_WARN_STREAM(
+      rclcpp::get_logger("image_projection_based_fusion"),
+      "The point cloud must be dense with float32 x, y and z fields.");
+    return 0;
+  }
+  if (num_points == 0) {
+    return 0;
+  }
+
+  if (data_capacity_ < data_size) {
+    data_d_ = cuda::make_unique<std::uint8_t[]>(data_size);
+    data_capacity_ = data_size;
+  }
+  if (point_mask_capacity_ < num_points) {
+    point_mask_d_ = cuda::make_unique<int[]>(num_points);
+    point_idx_d_ = cuda::make_unique<int[]>(num_points);
+    point_mask_capacity_ = num_points;
+  }
+  if (sweep.capacity < num_points) {
+    sweep.points_d = cuda::make_unique<float[]>(num_points * PAINTED_POINT_FEATURE_SIZE);
+    sweep.capacity = num_points;
+  }
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    data_d_.get(), input_pointcloud_msg.data.data(), data_size, cudaMemcpyHostToDevice, stream_));
+  CHECK_CUDA_ERROR(extractPoints_launch(
+    data_d_.get(), num_points, input_pointcloud_msg.point_step, x_offset, y_offset, z_offset,
+    config_.range_min_x_, config_.range_min_y_, config_.range_max_x_, config_.range_max_y_,
+    point_mask_d_.get(), point_idx_d_.get(), sweep.points_d.get(), stream_));
+
+  // the number of points kept is the index after the last point
+  int last_point_idx = 0, last_point_mask = 0;
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    num_points_per_voxel_d_.get(), num_points_per_voxel_.data(), num_voxels_ * sizeof(float),
-    cudaMemcpyHostToDevice));
+    &last_point_idx, point_idx_d_.get() + num_points - 1, sizeof(int), cudaMemcpyDeviceToHost,
+    stream_));
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    &last_point_mask, point_mask_d_.get() + num_points - 1, sizeof(int), cudaMemcpyDeviceToHost,
+    stream_));
   CHECK_CUDA_ERROR(cudaStreamSynchronize(stream_));
+  sweep.num_points = static_cast<std::size_t>(last_point_idx + last_point_mask);
+
+  return sweep.num_points;
+}
+
+void PointPaintingTRT::paintPointCloud(
+  const centerpoint::Affine3x4 & affine_to_camera, const centerpoint::Affine3x4 & projection,
+  const std::vector<PaintRoi> & rois)
+{
+  if (sweeps_.empty() || sweeps_.front().num_points == 0 || rois.empty()) {
+    return;
+  }
+  if (rois_capacity_ < rois.size()) {
+    rois_d_ = cuda::make_unique<PaintRoi[]>(rois.size());
+    rois_capacity_ = rois.size();
+  }
+  // the previous paint has been enqueued on the same stream, so the table can be overwritten
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    rois_d_.get(), rois.data(), rois.size() * sizeof(PaintRoi), cudaMemcpyHostToDevice, stream_));
+  const auto & sweep = sweeps_.front();
+  CHECK_CUDA_ERROR(paintPoints_launch(
+    sweep.points_d.get(), sweep.num_points, affine_to_camera, projection, rois_d_.get(),
+    rois.size(), stream_));
+}
+
+void PointPaintingTRT::downloadPaintedPointCloud(
+  sensor_msgs::msg::PointCloud2 & painted_pointcloud_msg)
+{
+  const std::size_t num_points = sweeps_.empty() ? 0 : sweeps_.front().num_points;
+  sensor_msgs::PointCloud2Modifier pcd_modifier(painted_pointcloud_msg);
+  pcd_modifier.setPointCloud2Fields(
+    PAINTED_POINT_FEATURE_SIZE, "x", 1, sensor_msgs::msg::PointField::FLOAT32, "y", 1,
+    sensor_msgs::msg::PointField::FLOAT32, "z", 1, sensor_msgs::msg::PointField::FLOAT32, "CAR", 1,
+    sensor_msgs::msg::PointField::FLOAT32, "PEDESTRIAN", 1, sensor_msgs::msg::PointField::FLOAT32,
+    "BICYCLE", 1, sensor_msgs::msg::PointField::FLOAT32);
+  painted_pointcloud_msg.height = 1;
+  pcd_modifier.resize(num_points);
+  if (num_points == 0) {
+    return;
+  }
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    painted_pointcloud_msg.data.data(), sweeps_.front().points_d.get(),
+    num_points * PAINTED_POINT_FEATURE_SIZE * sizeof(float), cudaMemcpyDeviceToHost, stream_));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(stream_));
+}
+
+bool PointPaintingTRT::preprocessOnDevice()
+{
+  std::size_t num_points = 0;
+  for (const auto & sweep : sweeps_) {
+    num_points += sweep.num_points;
+  }
+  if (num_points == 0) {
+    return false;
+  }
+  if (points_capacity_ < num_points) {
+    point_cells_d_ = cuda::make_unique<int[]>(num_points);
+    if (pointcloud_cache_size_ > 1) {
+      points_d_ = cuda::make_unique<float[]>(num_points * PAINTED_POINT_FEATURE_SIZE);
+    }
+    points_capacity_ = num_points;
+  }
+  CHECK_CUDA_ERROR(cudaMemsetAsync(cell_mask_d_.get(), 0, grid_size_ * sizeof(int), stream_));
+  CHECK_CUDA_ERROR(cudaMemsetAsync(
+    voxel_point_counts_d_.get(), 0, config_.max_voxel_size_ * sizeof(unsigned int), stream_));
+
+  // the past frames are painted already and, as on the host, not transformed, so that they are
+  // only gathered behind the current frame
+  const float * points_d = sweeps_.front().points_d.get();
+  if (sweeps_.size() > 1) {
+    std::size_t point_offset = 0;
+    for (const auto & sweep : sweeps_) {
+      CHECK_CUDA_ERROR(cudaMemcpyAsync(
+        points_d_.get() + point_offset * PAINTED_POINT_FEATURE_SIZE, sweep.points_d.get(),
+        sweep.num_points * PAINTED_POINT_FEATURE_SIZE * sizeof(float), cudaMemcpyDeviceToDevice,
+        stream_));
+      point_offset += sweep.num_points;
+    }
+    points_d = points_d_.get();
+  }
+
+  CHECK_CUDA_ERROR(generatePointCells_launch(
+    points_d, num_points, config_.range_min_x_, config_.range_min_y_, config_.range_min_z_,
+    1.0f / config_.voxel_size_x_, 1.0f / config_.voxel_size_y_, 1.0f / config_.voxel_size_z_,
+    config_.grid_size_x_, config_.grid_size_y_, config_.grid_size_z_, point_cells_d_.get(),
+    cell_mask_d_.get(), stream_));
+  CHECK_CUDA_ERROR(generateVoxels_launch(
+    points_d, point_cells_d_.get(), num_points, cell_mask_d_.get(), config_.grid_size_x_,
+    config_.grid_size_y_, config_.grid_size_z_, config_.max_voxel_size_,
+    config_.max_point_in_voxel_size_, cell_voxel_idx_d_.get(), voxel_point_counts_d_.get(),
+    voxels_d_.get(), coordinates_d_.get(), num_points_per_voxel_d_.get(), stream_));
+
+  // the number of voxels is the number of occupied cells, up to max_voxel_size
+  int last_voxel_idx = 0, last_cell_mask = 0;
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    &last_voxel_idx, cell_voxel_idx_d_.get() + grid_size_ - 1, sizeof(int),
+    cudaMemcpyDeviceToHost, stream_));
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    &last_cell_mask, cell_mask_d_.get() + grid_size_ - 1, sizeof(int), cudaMemcpyDeviceToHost,
+    stream_));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(stream_));
+  const auto num_voxels = std::min(
+    static_cast<std::size_t>(last_voxel_idx + last_cell_mask), config_.max_voxel_size_);
+  if (num_voxels == 0) {
+    return false;
+  }
+  num_voxels_[0] = num_voxels;
 
   CHECK_CUDA_ERROR(image_projection_based_fusion::generateFeatures_launch(
-    voxels_d_.get(), num_points_per_voxel_d_.get(), coordinates_d_.get(), num_voxels_,
+    voxels_d_.get(), num_points_per_voxel_d_.get(), coordinates_d_.get(), num_voxels,
     config_.max_voxel_size_, config_.voxel_size_x_, config_.voxel_size_y_, config_.voxel_size_z_,
     config_.range_min_x_, config_.range_min_y_, config_.range_min_z_, encoder_in_features_d_.get(),
     stream_));
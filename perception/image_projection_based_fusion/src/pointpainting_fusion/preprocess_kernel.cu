@@ -30,6 +30,9 @@
 
 #include "image_projection_based_fusion/pointpainting_fusion/preprocess_kernel.hpp"
 
+#include <thrust/execution_policy.h>
+#include <thrust/scan.h>
+
 #include <stdexcept>
 // #include <lidar_centerpoint/utils.hpp>
 
@@ -38,6 +41,7 @@ namespace
 const std::size_t MAX_POINT_IN_VOXEL_SIZE = 32;  // the same as max_point_in_voxel_size_ in config
 const std::size_t WARPS_PER_BLOCK = 4;
 const std::size_t ENCODER_IN_FEATURE_SIZE = 11;  // same as encoder_in_feature_size_ in config.hpp
+const std::size_t POINTS_PER_BLOCK = 256;
 
 std::size_t divup(const std::size_t a, const std::size_t b)
 {
@@ -180,4 +184,237 @@ cudaError_t generateFeatures_launch(
   return cudaGetLastError();
 }
 
+__global__ void maskPoints_kernel(
+  const std::uint8_t * data, const std::size_t num_points, const std::size_t point_step,
+  const std::size_t x_offset, const std::size_t y_offset, const float range_min_x,
+  const float range_min_y, const float range_max_x, const float range_max_y, int * point_mask)
+{
+  const auto point_i = blockIdx.x * POINTS_PER_BLOCK + threadIdx.x;
+  if (point_i >= num_points) {
+    return;
+  }
+  const std::uint8_t * point = data + point_i * point_step;
+  const float x = *reinterpret_cast<const float *>(point + x_offset);
+  const float y = *reinterpret_cast<const float *>(point + y_offset);
+  point_mask[point_i] = range_min_x < x && x < range_max_x && range_min_y < y && y < range_max_y;
+}
+
+__global__ void scatterPoints_kernel(
+  const std::uint8_t * data, const std::size_t num_points, const std::size_t point_step,
+  const std::size_t x_offset, const std::size_t y_offset, const std::size_t z_offset,
+  const int * point_mask, const int * point_idx, float * points)
+{
+  const auto point_i = blockIdx.x * POINTS_PER_BLOCK + threadIdx.x;
+  if (point_i >= num_points || point_mask[point_i] == 0) {
+    return;
+  }
+  const std::uint8_t * point = data + point_i * point_step;
+  float * painted_point = points + point_idx[point_i] * PAINTED_POINT_FEATURE_SIZE;
+  painted_point[0] = *reinterpret_cast<const float *>(point + x_offset);
+  painted_point[1] = *reinterpret_cast<const float *>(point + y_offset);
+  painted_point[2] = *reinterpret_cast<const float *>(point + z_offset);
+  painted_point[3] = 0.0f;
+  painted_point[4] = 0.0f;
+  painted_point[5] = 0.0f;
+}
+
+cudaError_t extractPoints_launch(
+  const std::uint8_t * data, const std::size_t num_points, const std::size_t point_step,
+  const std::size_t x_offset, const std::size_t y_offset, const std::size_t z_offset,
+  const float range_min_x, const float range_min_y, const float range_max_x,
+  const float range_max_y, int * point_mask, int * point_idx, float * points,
+  cudaStream_t stream)
+{
+  if (num_points == 0) {
+    return cudaGetLastError();
+  }
+  dim3 blocks(divup(num_points, POINTS_PER_BLOCK));
+  dim3 threads(POINTS_PER_BLOCK);
+  maskPoints_kernel<<<blocks, threads, 0, stream>>>(
+    data, num_points, point_step, x_offset, y_offset, range_min_x, range_min_y, range_max_x,
+    range_max_y, point_mask);
+  thrust::exclusive_scan(
+    thrust::cuda::par.on(stream), point_mask, point_mask + num_points, point_idx);
+  scatterPoints_kernel<<<blocks, threads, 0, stream>>>(
+    data, num_points, point_step, x_offset, y_offset, z_offset, point_mask, point_idx, points);
+
+  return cudaGetLastError();
+}
+
+__global__ void paintPoints_kernel(
+  float * points, const std::size_t num_points, const centerpoint::Affine3x4 affine,
+  const centerpoint::Affine3x4 projection, const PaintRoi * rois, const std::size_t num_rois)
+{
+  const auto point_i = blockIdx.x * POINTS_PER_BLOCK + threadIdx.x;
+  if (point_i >= num_points) {
+    return;
+  }
+  float * point = points + point_i * PAINTED_POINT_FEATURE_SIZE;
+  const float * m = affine.m;
+  const float x = m[0] * point[0] + m[1] * point[1] + m[2] * point[2] + m[3];
+  const float y = m[4] * point[0] + m[5] * point[1] + m[6] * point[2] + m[7];
+  const float z = m[8] * point[0] + m[9] * point[1] + m[10] * point[2] + m[11];
+  if (z <= 0.0f) {
+    return;
+  }
+  const float * p = projection.m;
+  const float w = p[8] * x + p[9] * y + p[10] * z + p[11];
+  const float u = (p[0] * x + p[1] * y + p[2] * z + p[3]) / w;
+  const float v = (p[4] * x + p[5] * y + p[6] * z + p[7]) / w;
+
+  for (std::size_t roi_i = 0; roi_i < num_rois; ++roi_i) {
+    const PaintRoi & roi = rois[roi_i];
+    if (roi.min_x <= u && u <= roi.max_x && roi.min_y <= v && v <= roi.max_y) {
+      point[3 + roi.channel] = 1.0f;
+    }
+  }
+}
+
+cudaError_t paintPoints_launch(
+  float * points, const std::size_t num_points, const centerpoint::Affine3x4 & affine_to_camera,
+  const centerpoint::Affine3x4 & projection, const PaintRoi * rois, const std::size_t num_rois,
+  cudaStream_t stream)
+{
+  if (num_points == 0 || num_rois == 0) {
+    return cudaGetLastError();
+  }
+  dim3 blocks(divup(num_points, POINTS_PER_BLOCK));
+  dim3 threads(POINTS_PER_BLOCK);
+  paintPoints_kernel<<<blocks, threads, 0, stream>>>(
+    points, num_points, affine_to_camera, projection, rois, num_rois);
+
+  return cudaGetLastError();
+}
+
+__global__ void generatePointCells_kernel(
+  const float * points, const std::size_t num_points, const float range_min_x,
+  const float range_min_y, const float range_min_z, const float recip_voxel_size_x,
+  const float recip_voxel_size_y, const float recip_voxel_size_z, const int grid_size_x,
+  const int grid_size_y, const int grid_size_z, int * point_cells, int * cell_mask)
+{
+  const auto point_i = blockIdx.x * POINTS_PER_BLOCK + threadIdx.x;
+  if (point_i >= num_points) {
+    return;
+  }
+  const float * point = points + point_i * PAINTED_POINT_FEATURE_SIZE;
+  // truncated toward zero as in the host voxel generator
+  const int cell_x = static_cast<int>((point[0] - range_min_x) * recip_voxel_size_x);
+  const int cell_y = static_cast<int>((point[1] - range_min_y) * recip_voxel_size_y);
+  const int cell_z = static_cast<int>((point[2] - range_min_z) * recip_voxel_size_z);
+  if (
+    cell_x < 0 || cell_x >= grid_size_x || cell_y < 0 || cell_y >= grid_size_y || cell_z < 0 ||
+    cell_z >= grid_size_z) {
+    point_cells[point_i] = -1;
+    return;
+  }
+  const int cell = (cell_z * grid_size_y + cell_y) * grid_size_x + cell_x;
+  point_cells[point_i] = cell;
+  cell_mask[cell] = 1;
+}
+
+cudaError_t generatePointCells_launch(
+  const float * points, const std::size_t num_points, const float range_min_x,
+  const float range_min_y, const float range_min_z, const float recip_voxel_size_x,
+  const float recip_voxel_size_y, const float recip_voxel_size_z, const int grid_size_x,
+  const int grid_size_y, const int grid_size_z, int * point_cells, int * cell_mask,
+  cudaStream_t stream)
+{
+  if (num_points == 0) {
+    return cudaGetLastError();
+  }
+  dim3 blocks(divup(num_points, POINTS_PER_BLOCK));
+  dim3 threads(POINTS_PER_BLOCK);
+  generatePointCells_kernel<<<blocks, threads, 0, stream>>>(
+    points, num_points, range_min_x, range_min_y, range_min_z, recip_voxel_size_x,
+    recip_voxel_size_y, recip_voxel_size_z, grid_size_x, grid_size_y, grid_size_z, point_cells,
+    cell_mask);
+
+  return cudaGetLastError();
+}
+
+__global__ void gatherVoxelPoints_kernel(
+  const float * points, const int * point_cells, const std::size_t num_points,
+  const int * cell_voxel_idx, const std::size_t max_voxel_size,
+  const std::size_t max_point_in_voxel_size, unsigned int * voxel_point_counts,
+  float * voxel_features)
+{
+  // voxel_features: (max_voxel_size, max_point_in_voxel_size, PAINTED_POINT_FEATURE_SIZE)
+  const auto point_i = blockIdx.x * POINTS_PER_BLOCK + threadIdx.x;
+  if (point_i >= num_points) {
+    return;
+  }
+  const int cell = point_cells[point_i];
+  if (cell < 0) {
+    return;
+  }
+  const int voxel_i = cell_voxel_idx[cell];
+  if (static_cast<std::size_t>(voxel_i) >= max_voxel_size) {
+    return;
+  }
+  // the points beyond max_point_in_voxel_size are dropped, in no particular order
+  const unsigned int slot = atomicAdd(&voxel_point_counts[voxel_i], 1U);
+  if (slot >= max_point_in_voxel_size) {
+    return;
+  }
+  const float * point = points + point_i * PAINTED_POINT_FEATURE_SIZE;
+  float * voxel_point =
+    voxel_features + (voxel_i * max_point_in_voxel_size + slot) * PAINTED_POINT_FEATURE_SIZE;
+  for (std::size_t fi = 0; fi < PAINTED_POINT_FEATURE_SIZE; ++fi) {
+    voxel_point[fi] = point[fi];
+  }
+}
+
+__global__ void generateVoxelCoords_kernel(
+  const int * cell_mask, const int * cell_voxel_idx, const std::size_t grid_size_x,
+  const std::size_t grid_size_y, const std::size_t grid_size, const std::size_t max_voxel_size,
+  const std::size_t max_point_in_voxel_size, const unsigned int * voxel_point_counts,
+  int * coords, float * voxel_num_points)
+{
+  // coords: (max_voxel_size, 3), zyx
+  const auto cell = blockIdx.x * POINTS_PER_BLOCK + threadIdx.x;
+  if (cell >= grid_size || cell_mask[cell] == 0) {
+    return;
+  }
+  const int voxel_i = cell_voxel_idx[cell];
+  if (static_cast<std::size_t>(voxel_i) >= max_voxel_size) {
+    return;
+  }
+
+  coords[voxel_i * 3 + 0] = cell / (grid_size_y * grid_size_x);
+  coords[voxel_i * 3 + 1] = (cell / grid_size_x) % grid_size_y;
+  coords[voxel_i * 3 + 2] = cell % grid_size_x;
+  voxel_num_points[voxel_i] =
+    min(voxel_point_counts[voxel_i], static_cast<unsigned int>(max_point_in_voxel_size));
+}
+
+cudaError_t generateVoxels_launch(
+  const float * points, const int * point_cells, const std::size_t num_points,
+  const int * cell_mask, const std::size_t grid_size_x, const std::size_t grid_size_y,
+  const std::size_t grid_size_z, const std::size_t max_voxel_size,
+  const std::size_t max_point_in_voxel_size, int * cell_voxel_idx,
+  unsigned int * voxel_point_counts, float * voxel_features, int * coords,
+  float * voxel_num_points, cudaStream_t stream)
+{
+  // the occupied cells are numbered in the order of the grid
+  const std::size_t grid_size = grid_size_z * grid_size_y * grid_size_x;
+  thrust::exclusive_scan(
+    thrust::cuda::par.on(stream), cell_mask, cell_mask + grid_size, cell_voxel_idx);
+
+  if (num_points > 0) {
+    dim3 blocks(divup(num_points, POINTS_PER_BLOCK));
+    dim3 threads(POINTS_PER_BLOCK);
+    gatherVoxelPoints_kernel<<<blocks, threads, 0, stream>>>(
+      points, point_cells, num_points, cell_voxel_idx, max_voxel_size, max_point_in_voxel_size,
+      voxel_point_counts, voxel_features);
+  }
+
+  dim3 blocks(divup(grid_size, POINTS_PER_BLOCK));
+  dim3 threads(POINTS_PER_BLOCK);
+  generateVoxelCoords_kernel<<<blocks, threads, 0, stream>>>(
+    cell_mask, cell_voxel_idx, grid_size_x, grid_size_y, grid_size, max_voxel_size,
+    max_point_in_voxel_size, voxel_point_counts, coords, voxel_num_points);
+
+  return cudaGetLastError();
+}
+
 }  // namespace image_projection_based_fusion
@@ -28,6 +28,35 @@
 #include <tf2_sensor_msgs/tf2_sensor_msgs.hpp>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace
+{
+std::array<Eigen::Vector3f, 8> calcBoundingCorners(const sensor_msgs::msg::PointCloud2 & cluster)
+{
+  Eigen::Vector3f min_point = Eigen::Vector3f::Constant(std::numeric_limits<float>::max());
+  Eigen::Vector3f max_point = Eigen::Vector3f::Constant(std::numeric_limits<float>::lowest());
+  for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(cluster, "x"), iter_y(cluster, "y"),
+       iter_z(cluster, "z");
+       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    const Eigen::Vector3f point(*iter_x, *iter_y, *iter_z);
+    min_point = min_point.cwiseMin(point);
+    max_point = max_point.cwiseMax(point);
+  }
+  std::array<Eigen::Vector3f, 8> corners;
+  for (std::size_t i = 0; i < corners.size(); ++i) {
+    corners.at(i) = Eigen::Vector3f(
+      (i & 1U) ? max_point.x() : min_point.x(), (i & 2U) ? max_point.y() : min_point.y(),
+      (i & 4U) ? max_point.z() : min_point.z());
+  }
+  return corners;
+}
+}  // namespace
+
 namespace image_projection_based_fusion
 {
 
@@ -39,6 +68,7 @@ RoiClusterFusionNode::RoiClusterFusionNode(const rclcpp::NodeOptions & options)
   use_iou_ = declare_parameter("use_iou", false);
   use_cluster_semantic_type_ = declare_parameter("use_cluster_semantic_type", false);
   iou_threshold_ = declare_parameter("iou_threshold", 0.1);
+  use_cluster_hull_ = declare_parameter("use_cluster_hull", false);
 }
 
 void RoiClusterFusionNode::preprocess(DetectedObjectsWithFeature & output_cluster_msg)
@@ -51,6 +81,13 @@ void RoiClusterFusionNode::preprocess(DetectedObjectsWithFeature & output_cluste
       feature_object.object.existence_probability = 0.0;
     }
   }
+
+  // the clusters are bounded once for all the cameras
+  cluster_corners_.clear();
+  cluster_corners_.reserve(output_cluster_msg.feature_objects.size());
+  for (const auto & feature_object : output_cluster_msg.feature_objects) {
+    cluster_corners_.push_back(calcBoundingCorners(feature_object.feature.cluster));
+  }
 }
 
 void RoiClusterFusionNode::fuseOnSingleImage(
@@ -79,6 +116,21 @@ void RoiClusterFusionNode::fuseOnSingleImage(
     transform_stamped = transform_stamped_optional.value();
   }
 
+  // the same float transform as tf2::doTransform, without copying the clusters
+  const auto & translation = transform_stamped.transform.translation;
+  const auto & rotation = transform_stamped.transform.rotation;
+  const Eigen::Transform<float, 3, Eigen::Affine> transform =
+    Eigen::Translation3f(translation.x, translation.y, translation.z) *
+    Eigen::Quaternionf(rotation.w, rotation.x, rotation.y, rotation.z);
+  const auto project = [&projection](const Eigen::Vector3f & point) {
+    const Eigen::Vector4d projected_point =
+      projection * Eigen::Vector4d(point.x(), point.y(), point.z(), 1.0);
+    return Eigen::Vector2d(
+      projected_point.x() / projected_point.z(), projected_point.y() / projected_point.z());
+  };
+  const auto width = static_cast<int>(camera_info.width);
+  const auto height = static_cast<int>(camera_info.height);
+
   std::map<std::size_t, RegionOfInterest> m_cluster_roi;
   for (std::size_t i = 0; i < input_cluster_msg.feature_objects.size(); ++i) {
     if (input_cluster_msg.feature_objects.at(i).feature.cluster.data.empty()) {
@@ -90,44 +142,73 @@ void RoiClusterFusionNode::fuseOnSingleImage(
       continue;
     }
 
-    sensor_msgs::msg::PointCloud2 transformed_cluster;
-    tf2::doTransform(
-      input_cluster_msg.feature_objects.at(i).feature.cluster, transformed_cluster,
-      transform_stamped);
-
-    int min_x(camera_info.width), min_y(camera_info.height), max_x(0), max_y(0);
-    std::vector<Eigen::Vector2d> projected_points;
-    projected_points.reserve(transformed_cluster.data.size());
-    for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(transformed_cluster, "x"),
-         iter_y(transformed_cluster, "y"), iter_z(transformed_cluster, "z");
-         iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
-      if (*iter_z <= 0.0) {
+    // the points project within the projection of the corners of their box, so a cluster whose
+    // corners are all behind the camera or project all to one side out of the image is not seen
+    int num_corners_in_front = 0;
+    Eigen::Vector2d min_corner = Eigen::Vector2d::Constant(std::numeric_limits<double>::max());
+    Eigen::Vector2d max_corner = Eigen::Vector2d::Constant(std::numeric_limits<double>::lowest());
+    std::vector<Eigen::Vector2d> projected_corners;
+    for (const auto & corner : cluster_corners_.at(i)) {
+      const Eigen::Vector3f transformed_corner = transform * corner;
+      if (transformed_corner.z() <= 0.0) {
         continue;
       }
-
-      Eigen::Vector4d projected_point =
-        projection * Eigen::Vector4d(*iter_x, *iter_y, *iter_z, 1.0);
-      Eigen::Vector2d normalized_projected_point = Eigen::Vector2d(
-        projected_point.x() / projected_point.z(), projected_point.y() / projected_point.z());
-      if (
-        0 <= static_cast<int>(normalized_projected_point.x()) &&
-        static_cast<int>(normalized_projected_point.x()) <=
-          static_cast<int>(camera_info.width) - 1 &&
-        0 <= static_cast<int>(normalized_projected_point.y()) &&
-        static_cast<int>(normalized_projected_point.y()) <=
-          static_cast<int>(camera_info.height) - 1) {
-        min_x = std::min(static_cast<int>(normalized_projected_point.x()), min_x);
-        min_y = std::min(static_cast<int>(normalized_projected_point.y()), min_y);
-        max_x = std::max(static_cast<int>(normalized_projected_point.x()), max_x);
-        max_y = std::max(static_cast<int>(normalized_projected_point.y()), max_y);
-        projected_points.push_back(normalized_projected_point);
-        debug_image_points.push_back(normalized_projected_point);
-      }
+      ++num_corners_in_front;
+      const auto projected_corner = project(transformed_corner);
+      min_corner = min_corner.cwiseMin(projected_corner);
+      max_corner = max_corner.cwiseMax(projected_corner);
+      projected_corners.push_back(projected_corner);
     }
-    if (projected_points.empty()) {
+    if (num_corners_in_front == 0) {
+      continue;
+    }
+    const bool is_all_in_front = num_corners_in_front == 8;
+    if (
+      is_all_in_front && (max_corner.x() <= -1.0 || width <= min_corner.x() ||
+                          max_corner.y() <= -1.0 || height <= min_corner.y())) {
       continue;
     }
 
+    int min_x(width), min_y(height), max_x(0), max_y(0);
+    if (use_cluster_hull_ && is_all_in_front) {
+      // the roi of the corners, the points only projected if the box crosses the image plane
+      min_x = std::max(static_cast<int>(min_corner.x()), 0);
+      min_y = std::max(static_cast<int>(min_corner.y()), 0);
+      max_x = std::min(static_cast<int>(max_corner.x()), width - 1);
+      max_y = std::min(static_cast<int>(max_corner.y()), height - 1);
+      debug_image_points.insert(
+        debug_image_points.end(), projected_corners.begin(), projected_corners.end());
+    } else {
+      const auto & cluster = input_cluster_msg.feature_objects.at(i).feature.cluster;
+      bool has_projected_point = false;
+      for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(cluster, "x"),
+           iter_y(cluster, "y"), iter_z(cluster, "z");
+           iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+        const Eigen::Vector3f transformed_point =
+          transform * Eigen::Vector3f(*iter_x, *iter_y, *iter_z);
+        if (transformed_point.z() <= 0.0) {
+          continue;
+        }
+
+        const auto normalized_projected_point = project(transformed_point);
+        if (
+          0 <= static_cast<int>(normalized_projected_point.x()) &&
+          static_cast<int>(normalized_projected_point.x()) <= width - 1 &&
+          0 <= static_cast<int>(normalized_projected_point.y()) &&
+          static_cast<int>(normalized_projected_point.y()) <= height - 1) {
+          min_x = std::min(static_cast<int>(normalized_projected_point.x()), min_x);
+          min_y = std::min(static_cast<int>(normalized_projected_point.y()), min_y);
+          max_x = std::max(static_cast<int>(normalized_projected_point.x()), max_x);
+          max_y = std::max(static_cast<int>(normalized_projected_point.y()), max_y);
+          has_projected_point = true;
+          debug_image_points.push_back(normalized_projected_point);
+        }
+      }
+      if (!has_projected_point) {
+        continue;
+      }
+    }
+
     sensor_msgs::msg::RegionOfInterest roi;
     // roi.do_rectify = m_camera_info_.at(id).do_rectify;
     roi.x_offset = min_x;
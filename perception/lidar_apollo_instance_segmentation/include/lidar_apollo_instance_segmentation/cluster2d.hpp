@@ -46,6 +46,8 @@
 #ifndef LIDAR_APOLLO_INSTANCE_SEGMENTATION__CLUSTER2D_HPP_
 #define LIDAR_APOLLO_INSTANCE_SEGMENTATION__CLUSTER2D_HPP_
 
+#include "cluster2d_kernel.hpp"
+#include "cuda_utils.hpp"
 #include "disjoint_set.hpp"
 #include "util.hpp"
 
@@ -57,6 +59,7 @@
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -98,6 +101,14 @@ public:
     const pcl::PointCloud<pcl::PointXYZI>::Ptr & pc_ptr, const pcl::PointIndices & valid_indices,
     float objectness_thresh, bool use_all_grids_for_clustering);
 
+  // same as cluster(), the inferred data staying on the device. Only the obstacle ids of the grids
+  // and the sums of the values of each obstacle are copied back, instead of filter() and classify()
+  // reading the whole network output
+  void clusterOnDevice(
+    const float * inferred_data_d, const pcl::PointCloud<pcl::PointXYZI>::Ptr & pc_ptr,
+    const pcl::PointIndices & valid_indices, float objectness_thresh,
+    bool use_all_grids_for_clustering, cudaStream_t stream);
+
   void filter(const std::shared_ptr<float> & inferred_data);
   void classify(const std::shared_ptr<float> & inferred_data);
 
@@ -124,6 +135,17 @@ private:
   pcl::PointCloud<pcl::PointXYZI>::Ptr pc_ptr_;
   const std::vector<int> * valid_indices_in_pc_ = nullptr;
 
+  // device buffers of clusterOnDevice()
+  std::vector<cuda::unique_ptr<int[]>> grid_buffers_d_;
+  Cluster2DBuffers buffers_d_;
+  cuda::unique_ptr<int[]> id_img_d_;
+  cuda::unique_ptr<int> num_obstacles_d_;
+  std::vector<std::uint8_t> occupancy_;
+  cuda::unique_ptr<std::uint8_t[]> occupancy_d_;
+  std::vector<float> obstacle_stats_;
+  std::size_t obstacle_stats_capacity_ = 0;
+  cuda::unique_ptr<float[]> obstacle_stats_d_;
+
   struct Node
   {
     Node * center_node;
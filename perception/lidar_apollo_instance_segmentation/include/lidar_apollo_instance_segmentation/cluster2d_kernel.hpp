@@ -0,0 +1,55 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIDAR_APOLLO_INSTANCE_SEGMENTATION__CLUSTER2D_KERNEL_HPP_
+#define LIDAR_APOLLO_INSTANCE_SEGMENTATION__CLUSTER2D_KERNEL_HPP_
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+
+// number of values accumulated per obstacle: grid count, confidence, height, heading x and y and
+// the probabilities of the 5 classes
+constexpr int OBSTACLE_STAT_SIZE = 10;
+
+// device work buffers of the clustering, each of rows * cols elements
+struct Cluster2DBuffers
+{
+  int * center_grid;  // grid pointed by the instance offset of each grid
+  int * jump_grid;    // grid reached by following the center grids 2^k times
+  int * jump_grid_tmp;
+  int * parent;  // union-find forest of the grids
+  int * is_object;
+  int * is_center;
+  int * first_grid;      // smallest object grid of each root
+  int * obstacle_index;  // exclusive scan of the first object grids
+};
+
+// label the object grids as Cluster2D::cluster does: each object grid follows the instance offsets
+// to a cycle of center grids, and the adjacent center grids are merged. The obstacles are numbered
+// in the order of their first grid. id_img is -1 for non-object grids. occupancy may be nullptr
+// to use all grids for clustering
+cudaError_t clusterGrids_launch(
+  const float * category_data, const float * instance_x_data, const float * instance_y_data,
+  const std::uint8_t * occupancy, const int rows, const int cols, const float scale,
+  const float objectness_thresh, const Cluster2DBuffers & buffers, int * id_img,
+  int * num_obstacles, cudaStream_t stream);
+
+// sum the OBSTACLE_STAT_SIZE values of the grids of each obstacle into the zero-initialized
+// obstacle_stats
+cudaError_t accumulateObstacles_launch(
+  const float * inferred_data, const int * id_img, const int size, float * obstacle_stats,
+  cudaStream_t stream);
+
+#endif  // LIDAR_APOLLO_INSTANCE_SEGMENTATION__CLUSTER2D_KERNEL_HPP_
@@ -51,6 +51,7 @@ private:
   std::shared_ptr<Cluster2D> cluster2d_;
   std::shared_ptr<FeatureGenerator> feature_generator_;
   float score_threshold_;
+  bool use_gpu_pipeline_;
 
   tf2_ros::Buffer tf_buffer_;
   tf2_ros::TransformListener tf_listener_;
@@ -14,12 +14,15 @@
 
 #pragma once
 
+#include "lidar_apollo_instance_segmentation/cuda_utils.hpp"
+#include "lidar_apollo_instance_segmentation/feature_generator_kernel.hpp"
 #include "lidar_apollo_instance_segmentation/feature_map.hpp"
 #include "util.hpp"
 
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 
+#include <cstddef>
 #include <memory>
 
 class FeatureGenerator
@@ -31,6 +34,14 @@ private:
   bool use_constant_feature_;
   std::shared_ptr<FeatureMapInterface> map_ptr_;
 
+  // device buffers of generateOnDevice()
+  FeatureChannels channels_;
+  std::size_t points_capacity_;
+  cuda::unique_ptr<float[]> points_d_;
+  cuda::unique_ptr<unsigned long long[]> top_keys_d_;  // NOLINT
+
+  int getChannel(const float * channel_data) const;
+
 public:
   FeatureGenerator(
     const int width, const int height, const int range, const bool use_intensity_feature,
@@ -39,4 +50,11 @@ public:
 
   std::shared_ptr<FeatureMapInterface> generate(
     const pcl::PointCloud<pcl::PointXYZI>::Ptr & pc_ptr);
+
+  // copy the constant channels to the feature map on the device, once before generateOnDevice()
+  void initializeOnDevice(float * feature_map_d, cudaStream_t stream);
+  // same as generate(), but the points are uploaded and the map is computed in feature_map_d
+  void generateOnDevice(
+    const pcl::PointCloud<pcl::PointXYZI>::Ptr & pc_ptr, float * feature_map_d,
+    cudaStream_t stream);
 };
@@ -0,0 +1,43 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIDAR_APOLLO_INSTANCE_SEGMENTATION__FEATURE_GENERATOR_KERNEL_HPP_
+#define LIDAR_APOLLO_INSTANCE_SEGMENTATION__FEATURE_GENERATOR_KERNEL_HPP_
+
+#include <cuda_runtime_api.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// channel index of each feature computed from the points, -1 if the map doesn't have it
+struct FeatureChannels
+{
+  int max_height;
+  int mean_height;
+  int count;
+  int top_intensity;
+  int mean_intensity;
+  int nonempty;
+};
+
+// compute the point features of the map in place, the constant channels being left untouched.
+// points are read with a stride of point_stride floats, x, y and z being the first three and the
+// intensity at intensity_offset. top_keys is a work buffer of width * height elements
+cudaError_t generateFeatures_launch(
+  const float * points, const std::size_t num_points, const std::size_t point_stride,
+  const std::size_t intensity_offset, const int width, const int height, const float range,
+  const float min_height, const float max_height, const FeatureChannels & channels,
+  unsigned long long * top_keys, float * feature_map, cudaStream_t stream);  // NOLINT
+
+#endif  // LIDAR_APOLLO_INSTANCE_SEGMENTATION__FEATURE_GENERATOR_KERNEL_HPP_
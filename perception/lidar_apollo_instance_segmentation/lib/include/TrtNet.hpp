@@ -84,6 +84,16 @@ public:
 
   void doInference(const void * inputData, void * outputData);
 
+  // run the network on the input already in getInputBuffer(), the output being left in
+  // getOutputBuffer(). Both are on the device, and the inference is enqueued on getStream()
+  void doInferenceOnDevice();
+
+  inline void * getInputBuffer() { return mTrtCudaBuffer[0]; }
+
+  inline const void * getOutputBuffer() { return mTrtCudaBuffer[mTrtInputCount]; }
+
+  inline cudaStream_t getStream() { return mTrtCudaStream; }
+
   inline size_t getInputSize()
   {
     return std::accumulate(
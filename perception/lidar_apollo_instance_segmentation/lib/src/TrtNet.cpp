@@ -149,4 +149,12 @@ void trtNet::doInference(const void * inputData, void * outputData)
       outputData, mTrtCudaBuffer[bindingIdx], size, cudaMemcpyDeviceToHost, mTrtCudaStream));
   }
 }
+
+void trtNet::doInferenceOnDevice()
+{
+  static const int batchSize = 1;
+  assert(mTrtInputCount == 1);
+
+  mTrtContext->enqueue(batchSize, mTrtCudaBuffer.data(), mTrtCudaStream, nullptr);
+}
 }  // namespace Tn
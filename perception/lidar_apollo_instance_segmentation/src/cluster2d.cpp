@@ -76,6 +76,21 @@ Cluster2D::Cluster2D(const int rows, const int cols, const float range)
   id_img_.assign(siz_, -1);
   pc_ptr_.reset();
   valid_indices_in_pc_ = nullptr;
+
+  for (int i = 0; i < 8; ++i) {
+    grid_buffers_d_.push_back(cuda::make_unique<int[]>(siz_));
+  }
+  buffers_d_.center_grid = grid_buffers_d_[0].get();
+  buffers_d_.jump_grid = grid_buffers_d_[1].get();
+  buffers_d_.jump_grid_tmp = grid_buffers_d_[2].get();
+  buffers_d_.parent = grid_buffers_d_[3].get();
+  buffers_d_.is_object = grid_buffers_d_[4].get();
+  buffers_d_.is_center = grid_buffers_d_[5].get();
+  buffers_d_.first_grid = grid_buffers_d_[6].get();
+  buffers_d_.obstacle_index = grid_buffers_d_[7].get();
+  id_img_d_ = cuda::make_unique<int[]>(siz_);
+  num_obstacles_d_ = cuda::make_unique<int>();
+  occupancy_d_ = cuda::make_unique<std::uint8_t[]>(siz_);
 }
 
 void Cluster2D::traverse(Node * x)
@@ -197,6 +212,97 @@ void Cluster2D::cluster(
   classify(inferred_data);
 }
 
+void Cluster2D::clusterOnDevice(
+  const float * inferred_data_d, const pcl::PointCloud<pcl::PointXYZI>::Ptr & pc_ptr,
+  const pcl::PointIndices & valid_indices, float objectness_thresh,
+  bool use_all_grids_for_clustering, cudaStream_t stream)
+{
+  pc_ptr_ = pc_ptr;
+
+  valid_indices_in_pc_ = &(valid_indices.indices);
+  point2grid_.assign(valid_indices_in_pc_->size(), -1);
+  if (!use_all_grids_for_clustering) {
+    occupancy_.assign(siz_, 0);
+  }
+
+  for (size_t i = 0; i < valid_indices_in_pc_->size(); ++i) {
+    int point_id = valid_indices_in_pc_->at(i);
+    const auto & point = pc_ptr_->points[point_id];
+    // * the coordinates of x and y have been exchanged in feature generation
+    // step,
+    // so we swap them back here.
+    int pos_x = F2I(point.y, range_, inv_res_x_);  // col
+    int pos_y = F2I(point.x, range_, inv_res_y_);  // row
+    if (IsValidRowCol(pos_y, pos_x)) {
+      point2grid_[i] = RowCol2Grid(pos_y, pos_x);
+      if (!use_all_grids_for_clustering) {
+        occupancy_[point2grid_[i]] = 1;
+      }
+    }
+  }
+  if (!use_all_grids_for_clustering) {
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      occupancy_d_.get(), occupancy_.data(), siz_ * sizeof(std::uint8_t), cudaMemcpyHostToDevice,
+      stream));
+  }
+
+  int num_obstacles = 0;
+  CHECK_CUDA_ERROR(clusterGrids_launch(
+    inferred_data_d, inferred_data_d + siz_, inferred_data_d + siz_ * 2,
+    use_all_grids_for_clustering ? nullptr : occupancy_d_.get(), rows_, cols_, scale_,
+    objectness_thresh, buffers_d_, id_img_d_.get(), num_obstacles_d_.get(), stream));
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    &num_obstacles, num_obstacles_d_.get(), sizeof(int), cudaMemcpyDeviceToHost, stream));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(stream));
+
+  const std::size_t stats_size = static_cast<std::size_t>(num_obstacles) * OBSTACLE_STAT_SIZE;
+  if (obstacle_stats_capacity_ < stats_size) {
+    obstacle_stats_capacity_ = stats_size;
+    obstacle_stats_d_ = cuda::make_unique<float[]>(obstacle_stats_capacity_);
+  }
+  obstacle_stats_.resize(stats_size);
+  id_img_.resize(siz_);
+  if (stats_size > 0) {
+    CHECK_CUDA_ERROR(
+      cudaMemsetAsync(obstacle_stats_d_.get(), 0, stats_size * sizeof(float), stream));
+    CHECK_CUDA_ERROR(accumulateObstacles_launch(
+      inferred_data_d, id_img_d_.get(), siz_, obstacle_stats_d_.get(), stream));
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      obstacle_stats_.data(), obstacle_stats_d_.get(), stats_size * sizeof(float),
+      cudaMemcpyDeviceToHost, stream));
+  }
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    id_img_.data(), id_img_d_.get(), siz_ * sizeof(int), cudaMemcpyDeviceToHost, stream));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(stream));
+
+  obstacles_.clear();
+  obstacles_.resize(num_obstacles);
+  for (int grid = 0; grid < siz_; ++grid) {
+    if (id_img_[grid] >= 0) {
+      obstacles_[id_img_[grid]].grids.push_back(grid);
+    }
+  }
+
+  // the same as filter() and classify()
+  const int num_classes = 5;
+  for (int obstacle_id = 0; obstacle_id < num_obstacles; ++obstacle_id) {
+    Obstacle * obs = &obstacles_[obstacle_id];
+    const float * stats = &obstacle_stats_[obstacle_id * OBSTACLE_STAT_SIZE];
+    const float grid_num = stats[0];
+    obs->score = stats[1] / grid_num;
+    obs->height = stats[2] / grid_num;
+    obs->heading = std::atan2(stats[4], stats[3]) * 0.5;
+    int meta_type_id = 0;
+    for (int k = 0; k < num_classes; k++) {
+      obs->meta_type_probs[k] = stats[5 + k] / grid_num;
+      if (obs->meta_type_probs[k] > obs->meta_type_probs[meta_type_id]) {
+        meta_type_id = k;
+      }
+    }
+    obs->meta_type = static_cast<MetaType>(meta_type_id);
+  }
+}
+
 void Cluster2D::filter(const std::shared_ptr<float> & inferred_data)
 {
   const float * confidence_pt_data = inferred_data.get() + siz_ * 3;
@@ -0,0 +1,218 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lidar_apollo_instance_segmentation/cluster2d_kernel.hpp"
+
+#include <thrust/execution_policy.h>
+#include <thrust/scan.h>
+
+#include <climits>
+#include <utility>
+
+namespace
+{
+const int THREADS_PER_BLOCK = 256;
+
+// parent is read through volatile since other threads hook the roots concurrently
+__device__ int findRoot(const int * parent, int x)
+{
+  const volatile int * volatile_parent = parent;
+  int p = volatile_parent[x];
+  while (p != x) {
+    x = p;
+    p = volatile_parent[x];
+  }
+  return x;
+}
+
+// hook the larger root to the smaller one, so that no cycle can be made
+__device__ void unite(int * parent, int x, int y)
+{
+  while (true) {
+    x = findRoot(parent, x);
+    y = findRoot(parent, y);
+    if (x == y) {
+      return;
+    }
+    if (x < y) {
+      const int tmp = x;
+      x = y;
+      y = tmp;
+    }
+    if (atomicCAS(parent + x, x, y) == x) {
+      return;
+    }
+  }
+}
+}  // namespace
+
+__global__ void initGrids_kernel(
+  const float * category_data, const float * instance_x_data, const float * instance_y_data,
+  const std::uint8_t * occupancy, const int rows, const int cols, const float scale,
+  const float objectness_thresh, Cluster2DBuffers buffers, int * id_img)
+{
+  const int grid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (grid >= rows * cols) return;
+
+  const int row = grid / cols;
+  const int col = grid % cols;
+  int center_row = roundf(row + instance_x_data[grid] * scale);
+  int center_col = roundf(col + instance_y_data[grid] * scale);
+  center_row = min(max(center_row, 0), rows - 1);
+  center_col = min(max(center_col, 0), cols - 1);
+  const int center_grid = center_row * cols + center_col;
+
+  buffers.center_grid[grid] = center_grid;
+  buffers.jump_grid[grid] = center_grid;
+  buffers.parent[grid] = grid;
+  buffers.is_object[grid] =
+    (occupancy == nullptr || occupancy[grid] > 0) && category_data[grid] >= objectness_thresh;
+  buffers.is_center[grid] = 0;
+  buffers.first_grid[grid] = INT_MAX;
+  id_img[grid] = -1;
+}
+
+__global__ void jumpGrids_kernel(const int size, const int * jump_grid, int * jump_grid_next)
+{
+  const int grid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (grid >= size) return;
+
+  jump_grid_next[grid] = jump_grid[jump_grid[grid]];
+}
+
+__global__ void markCenters_kernel(const int size, Cluster2DBuffers buffers)
+{
+  const int grid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (grid >= size || !buffers.is_object[grid]) return;
+
+  // after size steps at least, the jump grid is on the cycle the object grid leads to
+  const int cycle_grid = buffers.jump_grid[grid];
+  if (atomicExch(buffers.is_center + cycle_grid, 1) == 0) {
+    for (int g = buffers.center_grid[cycle_grid]; g != cycle_grid; g = buffers.center_grid[g]) {
+      buffers.is_center[g] = 1;
+      unite(buffers.parent, g, cycle_grid);
+    }
+  }
+  unite(buffers.parent, grid, cycle_grid);
+}
+
+__global__ void uniteCenters_kernel(const int rows, const int cols, Cluster2DBuffers buffers)
+{
+  const int grid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (grid >= rows * cols || !buffers.is_center[grid]) return;
+
+  const int row = grid / cols;
+  const int col = grid % cols;
+  if (col + 1 < cols && buffers.is_center[grid + 1]) {
+    unite(buffers.parent, grid, grid + 1);
+  }
+  if (row + 1 < rows && buffers.is_center[grid + cols]) {
+    unite(buffers.parent, grid, grid + cols);
+  }
+}
+
+__global__ void findFirstGrids_kernel(const int size, Cluster2DBuffers buffers)
+{
+  const int grid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (grid >= size || !buffers.is_object[grid]) return;
+
+  atomicMin(buffers.first_grid + findRoot(buffers.parent, grid), grid);
+}
+
+__global__ void flagFirstGrids_kernel(const int size, Cluster2DBuffers buffers)
+{
+  const int grid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (grid >= size) return;
+
+  buffers.obstacle_index[grid] =
+    buffers.is_object[grid] && buffers.first_grid[findRoot(buffers.parent, grid)] == grid;
+}
+
+__global__ void labelGrids_kernel(
+  const int size, Cluster2DBuffers buffers, int * id_img, int * num_obstacles)
+{
+  const int grid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (grid >= size) return;
+
+  const bool is_object = buffers.is_object[grid];
+  const int first_grid = is_object ? buffers.first_grid[findRoot(buffers.parent, grid)] : -1;
+  if (is_object) {
+    id_img[grid] = buffers.obstacle_index[first_grid];
+  }
+  if (grid == size - 1) {
+    *num_obstacles = buffers.obstacle_index[grid] + (first_grid == grid ? 1 : 0);
+  }
+}
+
+__global__ void accumulateObstacles_kernel(
+  const float * inferred_data, const int * id_img, const int size, float * obstacle_stats)
+{
+  const int grid = blockIdx.x * blockDim.x + threadIdx.x;
+  if (grid >= size || id_img[grid] < 0) return;
+
+  float * stats = obstacle_stats + id_img[grid] * OBSTACLE_STAT_SIZE;
+  atomicAdd(stats + 0, 1.0f);
+  atomicAdd(stats + 1, inferred_data[size * 3 + grid]);   // confidence
+  atomicAdd(stats + 2, inferred_data[size * 11 + grid]);  // height
+  atomicAdd(stats + 3, inferred_data[size * 9 + grid]);   // heading x
+  atomicAdd(stats + 4, inferred_data[size * 10 + grid]);  // heading y
+  for (int k = 0; k < 5; ++k) {
+    atomicAdd(stats + 5 + k, inferred_data[size * (4 + k) + grid]);  // class probabilities
+  }
+}
+
+cudaError_t clusterGrids_launch(
+  const float * category_data, const float * instance_x_data, const float * instance_y_data,
+  const std::uint8_t * occupancy, const int rows, const int cols, const float scale,
+  const float objectness_thresh, const Cluster2DBuffers & buffers, int * id_img,
+  int * num_obstacles, cudaStream_t stream)
+{
+  const int size = rows * cols;
+  const dim3 blocks((size + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK);
+  initGrids_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    category_data, instance_x_data, instance_y_data, occupancy, rows, cols, scale,
+    objectness_thresh, buffers, id_img);
+
+  // pointer jumping, the paths to the cycles have less than size grids
+  Cluster2DBuffers jumped_buffers = buffers;
+  int * jump_grid_next = buffers.jump_grid_tmp;
+  for (int steps = 1; steps < size; steps *= 2) {
+    jumpGrids_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      size, jumped_buffers.jump_grid, jump_grid_next);
+    std::swap(jumped_buffers.jump_grid, jump_grid_next);
+  }
+
+  markCenters_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(size, jumped_buffers);
+  uniteCenters_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(rows, cols, buffers);
+  findFirstGrids_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(size, buffers);
+  flagFirstGrids_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(size, buffers);
+  thrust::exclusive_scan(
+    thrust::cuda::par.on(stream), buffers.obstacle_index, buffers.obstacle_index + size,
+    buffers.obstacle_index);
+  labelGrids_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    size, buffers, id_img, num_obstacles);
+
+  return cudaGetLastError();
+}
+
+cudaError_t accumulateObstacles_launch(
+  const float * inferred_data, const int * id_img, const int size, float * obstacle_stats,
+  cudaStream_t stream)
+{
+  const dim3 blocks((size + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK);
+  accumulateObstacles_kernel<<<blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    inferred_data, id_img, size, obstacle_stats);
+
+  return cudaGetLastError();
+}
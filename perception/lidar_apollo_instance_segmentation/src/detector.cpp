@@ -39,6 +39,7 @@ LidarApolloInstanceSegmentation::LidarApolloInstanceSegmentation(rclcpp::Node *
   use_constant_feature = node_->declare_parameter("use_constant_feature", true);
   target_frame_ = node_->declare_parameter("target_frame", "base_link");
   z_offset_ = node_->declare_parameter<float>("z_offset", -2.0);
+  use_gpu_pipeline_ = node_->declare_parameter("use_gpu_pipeline", true);
 
   // load weight file
   std::ifstream fs(engine_file);
@@ -92,6 +93,10 @@ LidarApolloInstanceSegmentation::LidarApolloInstanceSegmentation(rclcpp::Node *
   // feature map generator: pre process
   feature_generator_ = std::make_shared<FeatureGenerator>(
     width, height, range, use_intensity_feature, use_constant_feature);
+  if (use_gpu_pipeline_) {
+    feature_generator_->initializeOnDevice(
+      static_cast<float *>(net_ptr_->getInputBuffer()), net_ptr_->getStream());
+  }
 
   // cluster: post process
   cluster2d_ = std::make_shared<Cluster2D>(width, height, range);
@@ -147,22 +152,35 @@ bool LidarApolloInstanceSegmentation::detectDynamicObjects(
   pcl::PointCloud<pcl::PointXYZI>::Ptr pcl_pointcloud_raw_ptr(new pcl::PointCloud<pcl::PointXYZI>);
   pcl::fromROSMsg(transformed_cloud, *pcl_pointcloud_raw_ptr);
 
-  // generate feature map
-  std::shared_ptr<FeatureMapInterface> feature_map_ptr =
-    feature_generator_->generate(pcl_pointcloud_raw_ptr);
-
-  // inference
-  std::shared_ptr<float> inferred_data(new float[net_ptr_->getOutputSize() / sizeof(float)]);
-  net_ptr_->doInference(feature_map_ptr->map_data.data(), inferred_data.get());
-
-  // post process
   const float objectness_thresh = 0.5;
   pcl::PointIndices valid_idx;
   valid_idx.indices.resize(pcl_pointcloud_raw_ptr->size());
   std::iota(valid_idx.indices.begin(), valid_idx.indices.end(), 0);
-  cluster2d_->cluster(
-    inferred_data, pcl_pointcloud_raw_ptr, valid_idx, objectness_thresh,
-    true /*use all grids for clustering*/);
+  if (use_gpu_pipeline_) {
+    // the feature map is generated in the input of the network, and its output is clustered on
+    // the device
+    feature_generator_->generateOnDevice(
+      pcl_pointcloud_raw_ptr, static_cast<float *>(net_ptr_->getInputBuffer()),
+      net_ptr_->getStream());
+    net_ptr_->doInferenceOnDevice();
+    cluster2d_->clusterOnDevice(
+      static_cast<const float *>(net_ptr_->getOutputBuffer()), pcl_pointcloud_raw_ptr, valid_idx,
+      objectness_thresh, true /*use all grids for clustering*/, net_ptr_->getStream());
+  } else {
+    // generate feature map
+    std::shared_ptr<FeatureMapInterface> feature_map_ptr =
+      feature_generator_->generate(pcl_pointcloud_raw_ptr);
+
+    // inference
+    std::shared_ptr<float> inferred_data(new float[net_ptr_->getOutputSize() / sizeof(float)]);
+    net_ptr_->doInference(feature_map_ptr->map_data.data(), inferred_data.get());
+
+    // post process
+    cluster2d_->cluster(
+      inferred_data, pcl_pointcloud_raw_ptr, valid_idx, objectness_thresh,
+      true /*use all grids for clustering*/);
+  }
+
   const float height_thresh = 0.5;
   const int min_pts_num = 3;
   cluster2d_->getObjects(
@@ -16,6 +16,8 @@
 
 #include "lidar_apollo_instance_segmentation/log_table.hpp"
 
+#include <cstddef>
+
 namespace
 {
 inline float normalizeIntensity(float intensity) { return intensity / 255.0f; }
@@ -40,6 +42,23 @@ FeatureGenerator::FeatureGenerator(
     map_ptr_ = std::make_shared<FeatureMap>(width, height, range);
   }
   map_ptr_->initializeMap(map_ptr_->map_data);
+
+  channels_.max_height = getChannel(map_ptr_->max_height_data);
+  channels_.mean_height = getChannel(map_ptr_->mean_height_data);
+  channels_.count = getChannel(map_ptr_->count_data);
+  channels_.top_intensity = getChannel(map_ptr_->top_intensity_data);
+  channels_.mean_intensity = getChannel(map_ptr_->mean_intensity_data);
+  channels_.nonempty = getChannel(map_ptr_->nonempty_data);
+  points_capacity_ = 0;
+  top_keys_d_ = cuda::make_unique<unsigned long long[]>(width * height);  // NOLINT
+}
+
+int FeatureGenerator::getChannel(const float * channel_data) const
+{
+  if (channel_data == nullptr) {
+    return -1;
+  }
+  return (channel_data - map_ptr_->map_data.data()) / (map_ptr_->width * map_ptr_->height);
 }
 
 std::shared_ptr<FeatureMapInterface> FeatureGenerator::generate(
@@ -93,3 +112,34 @@ std::shared_ptr<FeatureMapInterface> FeatureGenerator::generate(
   }
   return map_ptr_;
 }
+
+void FeatureGenerator::initializeOnDevice(float * feature_map_d, cudaStream_t stream)
+{
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    feature_map_d, map_ptr_->map_data.data(), map_ptr_->map_data.size() * sizeof(float),
+    cudaMemcpyHostToDevice, stream));
+}
+
+void FeatureGenerator::generateOnDevice(
+  const pcl::PointCloud<pcl::PointXYZI>::Ptr & pc_ptr, float * feature_map_d, cudaStream_t stream)
+{
+  constexpr std::size_t point_stride = sizeof(pcl::PointXYZI) / sizeof(float);
+  constexpr std::size_t intensity_offset = offsetof(pcl::PointXYZI, intensity) / sizeof(float);
+
+  // the points are uploaded as they are, the kernels reading them with their stride
+  const std::size_t num_points = pc_ptr->points.size();
+  if (points_capacity_ < num_points) {
+    points_capacity_ = num_points;
+    points_d_ = cuda::make_unique<float[]>(points_capacity_ * point_stride);
+  }
+  if (num_points > 0) {
+    CHECK_CUDA_ERROR(cudaMemcpyAsync(
+      points_d_.get(), pc_ptr->points.data(), num_points * sizeof(pcl::PointXYZI),
+      cudaMemcpyHostToDevice, stream));
+  }
+
+  CHECK_CUDA_ERROR(generateFeatures_launch(
+    points_d_.get(), num_points, point_stride, intensity_offset, map_ptr_->width,
+    map_ptr_->height, map_ptr_->range, min_height_, max_height_, channels_, top_keys_d_.get(),
+    feature_map_d, stream));
+}
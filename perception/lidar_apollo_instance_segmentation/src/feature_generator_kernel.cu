@@ -0,0 +1,142 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lidar_apollo_instance_segmentation/feature_generator_kernel.hpp"
+
+namespace
+{
+const std::size_t THREADS_PER_BLOCK = 256;
+
+// key of a point such that the highest point of a grid has the largest key, and the first one
+// of the cloud among points of the same height, as on the CPU
+__device__ unsigned long long makeTopKey(const float z, const std::size_t point_idx)  // NOLINT
+{
+  const unsigned int bits = __float_as_uint(z);
+  const unsigned int ordered_bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+  return (static_cast<unsigned long long>(ordered_bits) << 32) |  // NOLINT
+         (0xffffffffu - static_cast<unsigned int>(point_idx));
+}
+
+__device__ std::size_t topKeyToPointIndex(const unsigned long long key)  // NOLINT
+{
+  return 0xffffffffu - static_cast<unsigned int>(key & 0xffffffffu);
+}
+
+__device__ float * channelData(float * feature_map, const int channel, const int size)
+{
+  return channel < 0 ? nullptr : feature_map + channel * size;
+}
+}  // namespace
+
+__global__ void resetFeatures_kernel(
+  const int size, const FeatureChannels channels, unsigned long long * top_keys,  // NOLINT
+  float * feature_map)
+{
+  const int idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= size) return;
+
+  top_keys[idx] = 0;
+  channelData(feature_map, channels.max_height, size)[idx] = 0.0f;
+  channelData(feature_map, channels.mean_height, size)[idx] = 0.0f;
+  channelData(feature_map, channels.count, size)[idx] = 0.0f;
+  channelData(feature_map, channels.nonempty, size)[idx] = 0.0f;
+  if (channels.top_intensity >= 0) {
+    channelData(feature_map, channels.top_intensity, size)[idx] = 0.0f;
+  }
+  if (channels.mean_intensity >= 0) {
+    channelData(feature_map, channels.mean_intensity, size)[idx] = 0.0f;
+  }
+}
+
+__global__ void accumulatePoints_kernel(
+  const float * points, const std::size_t num_points, const std::size_t point_stride,
+  const std::size_t intensity_offset, const int width, const int height, const float range,
+  const float min_height, const float max_height, const FeatureChannels channels,
+  unsigned long long * top_keys, float * feature_map)  // NOLINT
+{
+  const std::size_t point_idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (point_idx >= num_points) return;
+
+  const float * point = points + point_idx * point_stride;
+  const float z = point[2];
+  if (z <= min_height || max_height <= z) return;
+
+  const float inv_res_x = 0.5f * width / range;
+  const float inv_res_y = 0.5f * height / range;
+  const int pos_x = floorf((range - point[1]) * inv_res_x);  // x on grid
+  const int pos_y = floorf((range - point[0]) * inv_res_y);  // y on grid
+  if (pos_x < 0 || width <= pos_x || pos_y < 0 || height <= pos_y) return;
+
+  const int size = width * height;
+  const int idx = pos_y * width + pos_x;
+  atomicMax(top_keys + idx, makeTopKey(z, point_idx));
+  atomicAdd(channelData(feature_map, channels.mean_height, size) + idx, z);
+  if (channels.mean_intensity >= 0) {
+    atomicAdd(
+      channelData(feature_map, channels.mean_intensity, size) + idx,
+      point[intensity_offset] / 255.0f);
+  }
+  atomicAdd(channelData(feature_map, channels.count, size) + idx, 1.0f);
+}
+
+__global__ void finalizeFeatures_kernel(
+  const float * points, const std::size_t point_stride, const std::size_t intensity_offset,
+  const int size, const FeatureChannels channels,
+  const unsigned long long * top_keys, float * feature_map)  // NOLINT
+{
+  const int idx = blockIdx.x * blockDim.x + threadIdx.x;
+  if (idx >= size) return;
+
+  float * count_data = channelData(feature_map, channels.count, size);
+  const float count = count_data[idx];
+  if (count > 0.0f) {
+    const float * top_point = points + topKeyToPointIndex(top_keys[idx]) * point_stride;
+    channelData(feature_map, channels.max_height, size)[idx] = top_point[2];
+    channelData(feature_map, channels.mean_height, size)[idx] /= count;
+    if (channels.top_intensity >= 0) {
+      channelData(feature_map, channels.top_intensity, size)[idx] =
+        top_point[intensity_offset] / 255.0f;
+    }
+    if (channels.mean_intensity >= 0) {
+      channelData(feature_map, channels.mean_intensity, size)[idx] /= count;
+    }
+    channelData(feature_map, channels.nonempty, size)[idx] = 1.0f;
+  }
+  // the counts are integers, for which calcApproximateLog is log1p
+  count_data[idx] = log1pf(count);
+}
+
+cudaError_t generateFeatures_launch(
+  const float * points, const std::size_t num_points, const std::size_t point_stride,
+  const std::size_t intensity_offset, const int width, const int height, const float range,
+  const float min_height, const float max_height, const FeatureChannels & channels,
+  unsigned long long * top_keys, float * feature_map, cudaStream_t stream)  // NOLINT
+{
+  const int size = width * height;
+  const dim3 grid_blocks((size + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK);
+  resetFeatures_kernel<<<grid_blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    size, channels, top_keys, feature_map);
+
+  if (num_points > 0) {
+    const dim3 point_blocks((num_points + THREADS_PER_BLOCK - 1) / THREADS_PER_BLOCK);
+    accumulatePoints_kernel<<<point_blocks, THREADS_PER_BLOCK, 0, stream>>>(
+      points, num_points, point_stride, intensity_offset, width, height, range, min_height,
+      max_height, channels, top_keys, feature_map);
+  }
+
+  finalizeFeatures_kernel<<<grid_blocks, THREADS_PER_BLOCK, 0, stream>>>(
+    points, point_stride, intensity_offset, size, channels, top_keys, feature_map);
+
+  return cudaGetLastError();
+}
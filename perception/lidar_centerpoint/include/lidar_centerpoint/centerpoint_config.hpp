@@ -27,7 +27,8 @@ public:
     const std::size_t class_size, const float point_feature_size, const std::size_t max_voxel_size,
     const std::vector<double> & point_cloud_range, const std::vector<double> & voxel_size,
     const std::size_t downsample_factor, const std::size_t encoder_in_feature_size,
-    const float score_threshold, const float circle_nms_dist_threshold)
+    const float score_threshold, const float circle_nms_dist_threshold,
+    const std::size_t batch_size)
   {
     class_size_ = class_size;
     point_feature_size_ = point_feature_size;
@@ -48,6 +49,10 @@ public:
     downsample_factor_ = downsample_factor;
     encoder_in_feature_size_ = encoder_in_feature_size;
 
+    if (batch_size > 0) {
+      batch_size_ = batch_size;
+    }
+
     if (score_threshold > 0 && score_threshold < 1) {
       score_threshold_ = score_threshold;
     }
@@ -83,7 +88,7 @@ public:
   float voxel_size_z_{8.0f};
 
   // network params
-  const std::size_t batch_size_{1};
+  std::size_t batch_size_{1};  // the number of point clouds inferred at once
   std::size_t downsample_factor_{2};
   std::size_t encoder_in_feature_size_{9};
   const std::size_t encoder_out_feature_size_{32};
@@ -25,6 +25,7 @@
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 
+#include <array>
 #include <memory>
 #include <string>
 #include <utility>
@@ -57,7 +58,8 @@ class CenterPointTRT
 public:
   explicit CenterPointTRT(
     const NetworkParam & encoder_param, const NetworkParam & head_param,
-    const DensificationParam & densification_param, const CenterPointConfig & config);
+    const DensificationParam & densification_param, const CenterPointConfig & config,
+    const bool use_pipelining = false, const bool use_cuda_graph = false);
 
   ~CenterPointTRT();
 
@@ -65,31 +67,55 @@ public:
     const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer,
     std::vector<Box3D> & det_boxes3d);
 
+  // infer the point clouds of batch_size lidars at once, det_boxes3d[i] being the boxes detected
+  // in input_pointcloud_msgs[i]
+  bool detect(
+    const std::vector<sensor_msgs::msg::PointCloud2::ConstSharedPtr> & input_pointcloud_msgs,
+    const tf2_ros::Buffer & tf_buffer, std::vector<std::vector<Box3D>> & det_boxes3d);
+
+  // with use_pipelining, preprocess the point clouds while the previous ones are inferred, and
+  // return the boxes of the previous ones with their headers, i.e. with a latency of one frame
+  bool detectPipelined(
+    const std::vector<sensor_msgs::msg::PointCloud2::ConstSharedPtr> & input_pointcloud_msgs,
+    const tf2_ros::Buffer & tf_buffer, std::vector<std_msgs::msg::Header> & det_headers,
+    std::vector<std::vector<Box3D>> & det_boxes3d);
+
 protected:
   void initPtr();
 
+  void resetBuffers();
+
   virtual bool preprocess(
-    const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer);
+    const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer,
+    const std::size_t batch_index);
 
   void inference();
 
-  void postProcess(std::vector<Box3D> & det_boxes3d);
+  void enqueueInference();
+
+  void postProcess(const std::size_t batch_index, std::vector<Box3D> & det_boxes3d);
 
-  std::unique_ptr<VoxelGeneratorTemplate> vg_ptr_{nullptr};
+  // a voxel generator per lidar, each keeping the past frames of its own lidar
+  std::vector<std::unique_ptr<VoxelGeneratorCUDA>> vg_ptrs_;
   std::unique_ptr<VoxelEncoderTRT> encoder_trt_ptr_{nullptr};
   std::unique_ptr<HeadTRT> head_trt_ptr_{nullptr};
   std::unique_ptr<PostProcessCUDA> post_proc_ptr_{nullptr};
   cudaStream_t stream_{nullptr};
+  cudaStream_t preprocess_stream_{nullptr};  // the same as stream_ unless use_pipelining
+  cudaEvent_t preprocess_event_{nullptr};
 
   bool verbose_{false};
+  bool use_pipelining_{false};
+  bool use_cuda_graph_{false};
+  std::size_t buffer_index_{0};  // the set of buffers in use, 0 or 1 with use_pipelining
+  std::array<cudaGraphExec_t, 2> graph_execs_{};
+  bool has_inferred_frame_{false};
+  std::vector<std_msgs::msg::Header> inferred_headers_;
   std::size_t class_size_{0};
   CenterPointConfig config_;
-  std::size_t num_voxels_{0};
+  std::vector<std::size_t> num_voxels_;
   std::size_t encoder_in_feature_size_{0};
   std::size_t spatial_features_size_{0};
-  std::vector<float> voxels_;
-  std::vector<int> coordinates_;
-  std::vector<float> num_points_per_voxel_;
   cuda::unique_ptr<float[]> voxels_d_{nullptr};
   cuda::unique_ptr<int[]> coordinates_d_{nullptr};
   cuda::unique_ptr<float[]> num_points_per_voxel_d_{nullptr};
@@ -102,6 +128,11 @@ protected:
   cuda::unique_ptr<float[]> head_out_dim_d_{nullptr};
   cuda::unique_ptr<float[]> head_out_rot_d_{nullptr};
   cuda::unique_ptr<float[]> head_out_vel_d_{nullptr};
+  // with use_pipelining, the next frame is preprocessed to these while the current one is inferred
+  cuda::unique_ptr<float[]> voxels_back_d_{nullptr};
+  cuda::unique_ptr<int[]> coordinates_back_d_{nullptr};
+  cuda::unique_ptr<float[]> num_points_per_voxel_back_d_{nullptr};
+  cuda::unique_ptr<float[]> encoder_in_features_back_d_{nullptr};
 };
 
 }  // namespace centerpoint
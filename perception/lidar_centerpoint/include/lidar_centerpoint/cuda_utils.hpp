@@ -89,6 +89,25 @@ cuda::unique_ptr<T> make_unique()
   return cuda::unique_ptr<T>{p};
 }
 
+struct host_deleter
+{
+  void operator()(void * p) const { CHECK_CUDA_ERROR(::cudaFreeHost(p)); }
+};
+
+// page-locked host memory, which the asynchronous copies don't have to stage
+template <typename T>
+using host_unique_ptr = std::unique_ptr<T, host_deleter>;
+
+template <typename T>
+typename std::enable_if<std::is_array<T>::value, cuda::host_unique_ptr<T>>::type make_host_unique(
+  const std::size_t n)
+{
+  using U = typename std::remove_extent<T>::type;
+  U * p;
+  CHECK_CUDA_ERROR(::cudaMallocHost(reinterpret_cast<void **>(&p), sizeof(U) * n));
+  return cuda::host_unique_ptr<T>{p};
+}
+
 constexpr size_t CUDA_ALIGN = 256;
 
 template <typename T>
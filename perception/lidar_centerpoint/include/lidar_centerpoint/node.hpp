@@ -39,18 +39,24 @@ public:
   explicit LidarCenterPointNode(const rclcpp::NodeOptions & node_options);
 
 private:
-  void pointCloudCallback(const sensor_msgs::msg::PointCloud2::ConstSharedPtr input_pointcloud_msg);
+  void pointCloudCallback(
+    const sensor_msgs::msg::PointCloud2::ConstSharedPtr input_pointcloud_msg,
+    const std::size_t batch_index);
 
   tf2_ros::Buffer tf_buffer_;
   tf2_ros::TransformListener tf_listener_{tf_buffer_};
 
-  rclcpp::Subscription<sensor_msgs::msg::PointCloud2>::SharedPtr pointcloud_sub_;
-  rclcpp::Publisher<autoware_auto_perception_msgs::msg::DetectedObjects>::SharedPtr objects_pub_;
+  // an input and an output per lidar of the batch
+  std::vector<rclcpp::Subscription<sensor_msgs::msg::PointCloud2>::SharedPtr> pointcloud_subs_;
+  std::vector<rclcpp::Publisher<autoware_auto_perception_msgs::msg::DetectedObjects>::SharedPtr>
+    objects_pubs_;
+  std::vector<sensor_msgs::msg::PointCloud2::ConstSharedPtr> pointcloud_msgs_;
 
   float score_threshold_{0.0};
   std::vector<std::string> class_names_;
   bool rename_car_to_truck_and_bus_{false};
   bool has_twist_{false};
+  bool use_pipelining_{false};
 
   std::unique_ptr<CenterPointTRT> detector_ptr_{nullptr};
 
@@ -31,11 +31,17 @@ class PostProcessCUDA
 public:
   explicit PostProcessCUDA(const CenterPointConfig & config);
 
-  cudaError_t generateDetectedBoxes3D_launch(
+  // decode the outputs of the head for a point cloud of the batch to a box per grid cell, without
+  // any synchronization so that it can be captured into a CUDA graph
+  cudaError_t generateBoxes3D_launch(
     const float * out_heatmap, const float * out_offset, const float * out_z, const float * out_dim,
-    const float * out_rot, const float * out_vel, std::vector<Box3D> & det_boxes3d,
+    const float * out_rot, const float * out_vel, const std::size_t batch_index,
     cudaStream_t stream);
 
+  // select the boxes of a point cloud of the batch by score and circle NMS
+  cudaError_t selectDetectedBoxes3D(
+    const std::size_t batch_index, std::vector<Box3D> & det_boxes3d, cudaStream_t stream);
+
 private:
   CenterPointConfig config_;
   thrust::device_vector<Box3D> boxes3d_d_;
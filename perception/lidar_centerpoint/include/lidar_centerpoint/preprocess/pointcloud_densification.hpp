@@ -23,12 +23,19 @@
 #include <tf2_sensor_msgs/tf2_sensor_msgs.hpp>
 #endif
 
+#include <boost/optional.hpp>
+
 #include <list>
 #include <string>
 #include <utility>
 
 namespace centerpoint
 {
+// the transform from the world frame to the frame of the point cloud at its stamp
+boost::optional<Eigen::Affine3f> lookupAffineWorldToCurrent(
+  const tf2_ros::Buffer & tf_buffer, const std_msgs::msg::Header & header,
+  const std::string & world_frame_id);
+
 class DensificationParam
 {
 public:
@@ -18,8 +18,36 @@
 #include <cuda.h>
 #include <cuda_runtime_api.h>
 
+#include <cstdint>
+
 namespace centerpoint
 {
+// row-major 3x4 matrix of an affine transform, passed to the kernels by value
+struct Affine3x4
+{
+  float m[12];
+};
+
+// transform the points of a past frame, read from the raw data of the point cloud, to the current
+// frame and compute the grid cell of each point
+cudaError_t generateSweepPoints_launch(
+  const std::uint8_t * data, const std::size_t num_points, const std::size_t point_step,
+  const std::size_t x_offset, const std::size_t y_offset, const std::size_t z_offset,
+  const Affine3x4 & affine_past2current, const float time_lag, const float range_min_x,
+  const float range_min_y, const float range_min_z, const float voxel_size_x,
+  const float voxel_size_y, const float voxel_size_z, const int grid_size_x, const int grid_size_y,
+  const int grid_size_z, float * points, int * point_cells, int * cell_mask, cudaStream_t stream);
+
+// gather the points into the voxels of the occupied cells, cell_voxel_idx being the voxel index of
+// every cell, voxel_point_counts and cell_mask being zero-initialized
+cudaError_t generateVoxels_launch(
+  const float * points, const int * point_cells, const std::size_t num_points,
+  const int * cell_mask, const std::size_t grid_size_x, const std::size_t grid_size_y,
+  const std::size_t grid_size_z, const std::size_t max_voxel_size,
+  const std::size_t max_point_in_voxel_size, int * cell_voxel_idx,
+  unsigned int * voxel_point_counts, float * voxel_features, int * coords,
+  float * voxel_num_points, cudaStream_t stream);
+
 cudaError_t generateFeatures_launch(
   const float * voxel_features, const float * voxel_num_points, const int * coords,
   const std::size_t num_voxels, const std::size_t max_voxel_size, const float voxel_size_x,
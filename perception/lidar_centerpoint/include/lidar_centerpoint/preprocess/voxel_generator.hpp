@@ -16,10 +16,13 @@
 #define LIDAR_CENTERPOINT__PREPROCESS__VOXEL_GENERATOR_HPP_
 
 #include <lidar_centerpoint/centerpoint_config.hpp>
+#include <lidar_centerpoint/cuda_utils.hpp>
 #include <lidar_centerpoint/preprocess/pointcloud_densification.hpp>
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
+#include <cstdint>
+#include <list>
 #include <memory>
 #include <vector>
 
@@ -57,6 +60,55 @@ public:
     std::vector<float> & num_points_per_voxel) override;
 };
 
+// Voxelize the current and the past frames on the device. The past frames are kept on the device
+// as well, so that only the raw points of the current frame are uploaded.
+class VoxelGeneratorCUDA
+{
+public:
+  explicit VoxelGeneratorCUDA(const DensificationParam & param, const CenterPointConfig & config);
+
+  bool enqueuePointCloud(
+    const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer,
+    cudaStream_t stream);
+
+  // voxels_d (float): (max_voxel_size * max_point_in_voxel_size * point_feature_size)
+  // coordinates_d (int): (max_voxel_size * point_dim_size)
+  // num_points_per_voxel_d (float): (max_voxel_size)
+  std::size_t pointsToVoxels(
+    float * voxels_d, int * coordinates_d, float * num_points_per_voxel_d, cudaStream_t stream);
+
+private:
+  struct Sweep
+  {
+    cuda::unique_ptr<std::uint8_t[]> data_d{nullptr};
+    std::size_t data_capacity{0};
+    std::size_t num_points{0};
+    std::size_t point_step{0};
+    std::size_t x_offset{0};
+    std::size_t y_offset{0};
+    std::size_t z_offset{0};
+    double timestamp{0.0};
+    Eigen::Affine3f affine_past2world;
+  };
+
+  DensificationParam param_;
+  CenterPointConfig config_;
+  std::size_t grid_size_{0};
+  double current_timestamp_{0.0};
+  Eigen::Affine3f affine_world2current_;
+  std::list<Sweep> sweeps_;  // from the current frame to the oldest past frame
+  // the point cloud is staged in page-locked memory to be uploaded asynchronously
+  cuda::host_unique_ptr<std::uint8_t[]> data_h_{nullptr};
+  std::size_t data_h_capacity_{0};
+
+  std::size_t points_capacity_{0};
+  cuda::unique_ptr<float[]> points_d_{nullptr};
+  cuda::unique_ptr<int[]> point_cells_d_{nullptr};
+  cuda::unique_ptr<int[]> cell_mask_d_{nullptr};
+  cuda::unique_ptr<int[]> cell_voxel_idx_d_{nullptr};
+  cuda::unique_ptr<unsigned int[]> voxel_point_counts_d_{nullptr};
+};
+
 }  // namespace centerpoint
 
 #endif  // LIDAR_CENTERPOINT__PREPROCESS__VOXEL_GENERATOR_HPP_
@@ -19,29 +19,35 @@
 #include <lidar_centerpoint/preprocess/preprocess_kernel.hpp>
 #include <tier4_autoware_utils/math/constants.hpp>
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace centerpoint
 {
 CenterPointTRT::CenterPointTRT(
   const NetworkParam & encoder_param, const NetworkParam & head_param,
-  const DensificationParam & densification_param, const CenterPointConfig & config)
-: config_(config)
+  const DensificationParam & densification_param, const CenterPointConfig & config,
+  const bool use_pipelining, const bool use_cuda_graph)
+: use_pipelining_(use_pipelining), use_cuda_graph_(use_cuda_graph), config_(config)
 {
-  vg_ptr_ = std::make_unique<VoxelGenerator>(densification_param, config_);
+  for (std::size_t bi = 0; bi < config_.batch_size_; bi++) {
+    vg_ptrs_.emplace_back(std::make_unique<VoxelGeneratorCUDA>(densification_param, config_));
+  }
   post_proc_ptr_ = std::make_unique<PostProcessCUDA>(config_);
 
   // encoder
   encoder_trt_ptr_ = std::make_unique<VoxelEncoderTRT>(config_, verbose_);
   encoder_trt_ptr_->init(
     encoder_param.onnx_path(), encoder_param.engine_path(), encoder_param.trt_precision());
-  encoder_trt_ptr_->context_->setBindingDimensions(
-    0,
-    nvinfer1::Dims3(
-      config_.max_voxel_size_, config_.max_point_in_voxel_size_, config_.encoder_in_feature_size_));
+  const bool is_encoder_dims_valid = encoder_trt_ptr_->context_->setBindingDimensions(
+    0, nvinfer1::Dims3(
+         config_.batch_size_ * config_.max_voxel_size_, config_.max_point_in_voxel_size_,
+         config_.encoder_in_feature_size_));
 
   // head
   std::vector<std::size_t> out_channel_sizes = {
@@ -49,18 +55,45 @@ CenterPointTRT::CenterPointTRT(
     config_.head_out_dim_size_, config_.head_out_rot_size_,    config_.head_out_vel_size_};
   head_trt_ptr_ = std::make_unique<HeadTRT>(out_channel_sizes, config_, verbose_);
   head_trt_ptr_->init(head_param.onnx_path(), head_param.engine_path(), head_param.trt_precision());
-  head_trt_ptr_->context_->setBindingDimensions(
+  const bool is_head_dims_valid = head_trt_ptr_->context_->setBindingDimensions(
     0, nvinfer1::Dims4(
          config_.batch_size_, config_.encoder_out_feature_size_, config_.grid_size_y_,
          config_.grid_size_x_));
 
+  // the engines are built for a batch size, a cached engine of another batch size is rejected
+  if (!is_encoder_dims_valid || !is_head_dims_valid) {
+    throw std::runtime_error(
+      "The engines don't support batch_size " + std::to_string(config_.batch_size_) +
+      ". Remove the engine files to rebuild them.");
+  }
+
   initPtr();
 
   cudaStreamCreate(&stream_);
+  if (use_pipelining_) {
+    // non-blocking, so that the thrust calls of the postprocess on the default stream don't wait
+    // for the preprocess of the next frame
+    cudaStreamCreateWithFlags(&preprocess_stream_, cudaStreamNonBlocking);
+    cudaEventCreateWithFlags(&preprocess_event_, cudaEventDisableTiming);
+  } else {
+    preprocess_stream_ = stream_;
+  }
 }
 
 CenterPointTRT::~CenterPointTRT()
 {
+  for (auto & graph_exec : graph_execs_) {
+    if (graph_exec) {
+      cudaGraphExecDestroy(graph_exec);
+    }
+  }
+  if (preprocess_stream_ && preprocess_stream_ != stream_) {
+    cudaStreamSynchronize(preprocess_stream_);
+    cudaStreamDestroy(preprocess_stream_);
+  }
+  if (preprocess_event_) {
+    cudaEventDestroy(preprocess_event_);
+  }
   if (stream_) {
     cudaStreamSynchronize(stream_);
     cudaStreamDestroy(stream_);
@@ -72,22 +105,22 @@ void CenterPointTRT::initPtr()
   const auto voxels_size =
     config_.max_voxel_size_ * config_.max_point_in_voxel_size_ * config_.point_feature_size_;
   const auto coordinates_size = config_.max_voxel_size_ * config_.point_dim_size_;
+  const auto batch_max_voxel_size = config_.batch_size_ * config_.max_voxel_size_;
   encoder_in_feature_size_ =
-    config_.max_voxel_size_ * config_.max_point_in_voxel_size_ * config_.encoder_in_feature_size_;
-  const auto pillar_features_size = config_.max_voxel_size_ * config_.encoder_out_feature_size_;
-  spatial_features_size_ =
-    config_.grid_size_x_ * config_.grid_size_y_ * config_.encoder_out_feature_size_;
-  const auto grid_xy_size = config_.down_grid_size_x_ * config_.down_grid_size_y_;
+    batch_max_voxel_size * config_.max_point_in_voxel_size_ * config_.encoder_in_feature_size_;
+  const auto pillar_features_size = batch_max_voxel_size * config_.encoder_out_feature_size_;
+  spatial_features_size_ = config_.batch_size_ * config_.grid_size_x_ * config_.grid_size_y_ *
+                           config_.encoder_out_feature_size_;
+  const auto grid_xy_size =
+    config_.batch_size_ * config_.down_grid_size_x_ * config_.down_grid_size_y_;
 
   // host
-  voxels_.resize(voxels_size);
-  coordinates_.resize(coordinates_size);
-  num_points_per_voxel_.resize(config_.max_voxel_size_);
+  num_voxels_.resize(config_.batch_size_, 0);
 
   // device
-  voxels_d_ = cuda::make_unique<float[]>(voxels_size);
-  coordinates_d_ = cuda::make_unique<int[]>(coordinates_size);
-  num_points_per_voxel_d_ = cuda::make_unique<float[]>(config_.max_voxel_size_);
+  voxels_d_ = cuda::make_unique<float[]>(config_.batch_size_ * voxels_size);
+  coordinates_d_ = cuda::make_unique<int[]>(config_.batch_size_ * coordinates_size);
+  num_points_per_voxel_d_ = cuda::make_unique<float[]>(batch_max_voxel_size);
   encoder_in_features_d_ = cuda::make_unique<float[]>(encoder_in_feature_size_);
   pillar_features_d_ = cuda::make_unique<float[]>(pillar_features_size);
   spatial_features_d_ = cuda::make_unique<float[]>(spatial_features_size_);
@@ -97,21 +130,59 @@ void CenterPointTRT::initPtr()
   head_out_dim_d_ = cuda::make_unique<float[]>(grid_xy_size * config_.head_out_dim_size_);
   head_out_rot_d_ = cuda::make_unique<float[]>(grid_xy_size * config_.head_out_rot_size_);
   head_out_vel_d_ = cuda::make_unique<float[]>(grid_xy_size * config_.head_out_vel_size_);
+  if (use_pipelining_) {
+    voxels_back_d_ = cuda::make_unique<float[]>(config_.batch_size_ * voxels_size);
+    coordinates_back_d_ = cuda::make_unique<int[]>(config_.batch_size_ * coordinates_size);
+    num_points_per_voxel_back_d_ = cuda::make_unique<float[]>(batch_max_voxel_size);
+    encoder_in_features_back_d_ = cuda::make_unique<float[]>(encoder_in_feature_size_);
+  }
 }
 
 bool CenterPointTRT::detect(
   const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer,
   std::vector<Box3D> & det_boxes3d)
 {
-  std::fill(voxels_.begin(), voxels_.end(), 0);
-  std::fill(coordinates_.begin(), coordinates_.end(), -1);
-  std::fill(num_points_per_voxel_.begin(), num_points_per_voxel_.end(), 0);
-  CHECK_CUDA_ERROR(cudaMemsetAsync(
-    encoder_in_features_d_.get(), 0, encoder_in_feature_size_ * sizeof(float), stream_));
-  CHECK_CUDA_ERROR(
-    cudaMemsetAsync(spatial_features_d_.get(), 0, spatial_features_size_ * sizeof(float), stream_));
+  if (config_.batch_size_ != 1) {
+    throw std::runtime_error("A point cloud per lidar is required when batch_size > 1.");
+  }
+
+  resetBuffers();
+
+  if (!preprocess(input_pointcloud_msg, tf_buffer, 0)) {
+    RCLCPP_WARN_STREAM(
+      rclcpp::get_logger("lidar_centerpoint"), "Fail to preprocess and skip to detect.");
+    return false;
+  }
 
-  if (!preprocess(input_pointcloud_msg, tf_buffer)) {
+  inference();
+
+  postProcess(0, det_boxes3d);
+
+  return true;
+}
+
+bool CenterPointTRT::detect(
+  const std::vector<sensor_msgs::msg::PointCloud2::ConstSharedPtr> & input_pointcloud_msgs,
+  const tf2_ros::Buffer & tf_buffer, std::vector<std::vector<Box3D>> & det_boxes3d)
+{
+  if (input_pointcloud_msgs.size() != config_.batch_size_) {
+    throw std::runtime_error("The number of point clouds is different from batch_size.");
+  }
+
+  resetBuffers();
+
+  // a lidar whose point cloud can't be preprocessed is left empty in the batch
+  bool is_any_success = false;
+  for (std::size_t bi = 0; bi < config_.batch_size_; bi++) {
+    if (preprocess(*input_pointcloud_msgs[bi], tf_buffer, bi)) {
+      is_any_success = true;
+    } else {
+      RCLCPP_WARN_STREAM(
+        rclcpp::get_logger("lidar_centerpoint"),
+        "Fail to preprocess the point cloud " << bi << " of the batch.");
+    }
+  }
+  if (!is_any_success) {
     RCLCPP_WARN_STREAM(
       rclcpp::get_logger("lidar_centerpoint"), "Fail to preprocess and skip to detect.");
     return false;
@@ -119,42 +190,123 @@ bool CenterPointTRT::detect(
 
   inference();
 
-  postProcess(det_boxes3d);
+  det_boxes3d.assign(config_.batch_size_, std::vector<Box3D>{});
+  for (std::size_t bi = 0; bi < config_.batch_size_; bi++) {
+    if (num_voxels_[bi] > 0) {
+      postProcess(bi, det_boxes3d[bi]);
+    }
+  }
 
   return true;
 }
 
+bool CenterPointTRT::detectPipelined(
+  const std::vector<sensor_msgs::msg::PointCloud2::ConstSharedPtr> & input_pointcloud_msgs,
+  const tf2_ros::Buffer & tf_buffer, std::vector<std_msgs::msg::Header> & det_headers,
+  std::vector<std::vector<Box3D>> & det_boxes3d)
+{
+  if (!use_pipelining_) {
+    throw std::runtime_error("detectPipelined requires use_pipelining.");
+  }
+  if (input_pointcloud_msgs.size() != config_.batch_size_) {
+    throw std::runtime_error("The number of point clouds is different from batch_size.");
+  }
+
+  // the previous frame may still be inferred on stream_ from the other buffers
+  std::swap(voxels_d_, voxels_back_d_);
+  std::swap(coordinates_d_, coordinates_back_d_);
+  std::swap(num_points_per_voxel_d_, num_points_per_voxel_back_d_);
+  std::swap(encoder_in_features_d_, encoder_in_features_back_d_);
+  buffer_index_ = 1 - buffer_index_;
+  const auto inferred_num_voxels = num_voxels_;
+
+  resetBuffers();
+
+  bool is_any_success = false;
+  for (std::size_t bi = 0; bi < config_.batch_size_; bi++) {
+    if (preprocess(*input_pointcloud_msgs[bi], tf_buffer, bi)) {
+      is_any_success = true;
+    } else {
+      RCLCPP_WARN_STREAM(
+        rclcpp::get_logger("lidar_centerpoint"),
+        "Fail to preprocess the point cloud " << bi << " of the batch.");
+    }
+  }
+
+  // the head outputs of the previous frame are consumed before the current frame is enqueued
+  const bool has_det_boxes3d = has_inferred_frame_;
+  det_headers.clear();
+  det_boxes3d.clear();
+  if (has_inferred_frame_) {
+    det_headers = inferred_headers_;
+    det_boxes3d.assign(config_.batch_size_, std::vector<Box3D>{});
+    for (std::size_t bi = 0; bi < config_.batch_size_; bi++) {
+      if (inferred_num_voxels[bi] > 0) {
+        postProcess(bi, det_boxes3d[bi]);
+      }
+    }
+    has_inferred_frame_ = false;
+  }
+
+  if (is_any_success) {
+    inference();
+    inferred_headers_.clear();
+    for (const auto & input_pointcloud_msg : input_pointcloud_msgs) {
+      inferred_headers_.push_back(input_pointcloud_msg->header);
+    }
+    has_inferred_frame_ = true;
+  } else {
+    RCLCPP_WARN_STREAM(
+      rclcpp::get_logger("lidar_centerpoint"), "Fail to preprocess and skip to detect.");
+  }
+
+  return has_det_boxes3d;
+}
+
+void CenterPointTRT::resetBuffers()
+{
+  std::fill(num_voxels_.begin(), num_voxels_.end(), 0);
+  CHECK_CUDA_ERROR(cudaMemsetAsync(
+    encoder_in_features_d_.get(), 0, encoder_in_feature_size_ * sizeof(float),
+    preprocess_stream_));
+  // the empty voxels have the coordinates of -1, so that every voxel can be scattered
+  CHECK_CUDA_ERROR(cudaMemsetAsync(
+    coordinates_d_.get(), 0xff,
+    config_.batch_size_ * config_.max_voxel_size_ * config_.point_dim_size_ * sizeof(int),
+    preprocess_stream_));
+}
+
 bool CenterPointTRT::preprocess(
-  const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer)
+  const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer,
+  const std::size_t batch_index)
 {
-  bool is_success = vg_ptr_->enqueuePointCloud(input_pointcloud_msg, tf_buffer);
+  bool is_success = vg_ptrs_[batch_index]->enqueuePointCloud(
+    input_pointcloud_msg, tf_buffer, preprocess_stream_);
   if (!is_success) {
     return false;
   }
-  num_voxels_ = vg_ptr_->pointsToVoxels(voxels_, coordinates_, num_points_per_voxel_);
-  if (num_voxels_ == 0) {
+
+  // the voxels of each point cloud occupy a block of max_voxel_size voxels in the device buffers
+  const auto voxel_offset = batch_index * config_.max_voxel_size_;
+  float * voxels_d =
+    voxels_d_.get() + voxel_offset * config_.max_point_in_voxel_size_ * config_.point_feature_size_;
+  int * coordinates_d = coordinates_d_.get() + voxel_offset * config_.point_dim_size_;
+  float * num_points_per_voxel_d = num_points_per_voxel_d_.get() + voxel_offset;
+  float * encoder_in_features_d =
+    encoder_in_features_d_.get() +
+    voxel_offset * config_.max_point_in_voxel_size_ * config_.encoder_in_feature_size_;
+
+  const auto num_voxels = vg_ptrs_[batch_index]->pointsToVoxels(
+    voxels_d, coordinates_d, num_points_per_voxel_d, preprocess_stream_);
+  if (num_voxels == 0) {
     return false;
   }
-
-  const auto voxels_size =
-    num_voxels_ * config_.max_point_in_voxel_size_ * config_.point_feature_size_;
-  const auto coordinates_size = num_voxels_ * config_.point_dim_size_;
-  // memcpy from host to device (not copy empty voxels)
-  CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    voxels_d_.get(), voxels_.data(), voxels_size * sizeof(float), cudaMemcpyHostToDevice));
-  CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    coordinates_d_.get(), coordinates_.data(), coordinates_size * sizeof(int),
-    cudaMemcpyHostToDevice));
-  CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    num_points_per_voxel_d_.get(), num_points_per_voxel_.data(), num_voxels_ * sizeof(float),
-    cudaMemcpyHostToDevice));
-  CHECK_CUDA_ERROR(cudaStreamSynchronize(stream_));
+  num_voxels_[batch_index] = num_voxels;
 
   CHECK_CUDA_ERROR(generateFeatures_launch(
-    voxels_d_.get(), num_points_per_voxel_d_.get(), coordinates_d_.get(), num_voxels_,
-    config_.max_voxel_size_, config_.voxel_size_x_, config_.voxel_size_y_, config_.voxel_size_z_,
-    config_.range_min_x_, config_.range_min_y_, config_.range_min_z_, encoder_in_features_d_.get(),
-    stream_));
+    voxels_d, num_points_per_voxel_d, coordinates_d, num_voxels, config_.max_voxel_size_,
+    config_.voxel_size_x_, config_.voxel_size_y_, config_.voxel_size_z_, config_.range_min_x_,
+    config_.range_min_y_, config_.range_min_z_, encoder_in_features_d, preprocess_stream_));
 
   return true;
 }
@@ -165,15 +317,65 @@ void CenterPointTRT::inference()
     throw std::runtime_error("Failed to create tensorrt context.");
   }
 
+  if (preprocess_stream_ != stream_) {
+    CHECK_CUDA_ERROR(cudaEventRecord(preprocess_event_, preprocess_stream_));
+    CHECK_CUDA_ERROR(cudaStreamWaitEvent(stream_, preprocess_event_, 0));
+  }
+
+  if (!use_cuda_graph_) {
+    enqueueInference();
+    return;
+  }
+
+  // a graph per set of buffers, the buffers being swapped with use_pipelining
+  auto & graph_exec = graph_execs_[buffer_index_];
+  if (graph_exec) {
+    CHECK_CUDA_ERROR(cudaGraphLaunch(graph_exec, stream_));
+    return;
+  }
+
+  // the first enqueue of TensorRT can't be captured, so the first frame is launched as usual and
+  // the same sequence is captured afterwards without being executed
+  enqueueInference();
+  cudaGraph_t graph{nullptr};
+  CHECK_CUDA_ERROR(cudaStreamBeginCapture(stream_, cudaStreamCaptureModeThreadLocal));
+  enqueueInference();
+  bool is_captured = cudaStreamEndCapture(stream_, &graph) == cudaSuccess &&
+                     cudaGraphInstantiateWithFlags(&graph_exec, graph, 0) == cudaSuccess;
+  if (graph) {
+    cudaGraphDestroy(graph);
+  }
+  if (!is_captured) {
+    cudaGetLastError();
+    graph_exec = nullptr;
+    use_cuda_graph_ = false;
+    RCLCPP_WARN_STREAM(
+      rclcpp::get_logger("lidar_centerpoint"),
+      "Fail to capture the inference into a CUDA graph, launch it without the graph.");
+  }
+}
+
+void CenterPointTRT::enqueueInference()
+{
+  // every launch has a fixed shape, the empty voxels being skipped by their coordinates
+  CHECK_CUDA_ERROR(
+    cudaMemsetAsync(spatial_features_d_.get(), 0, spatial_features_size_ * sizeof(float), stream_));
+
   // pillar encoder network
   std::vector<void *> encoder_buffers{encoder_in_features_d_.get(), pillar_features_d_.get()};
   encoder_trt_ptr_->context_->enqueueV2(encoder_buffers.data(), stream_, nullptr);
 
-  // scatter
-  CHECK_CUDA_ERROR(scatterFeatures_launch(
-    pillar_features_d_.get(), coordinates_d_.get(), num_voxels_, config_.max_voxel_size_,
-    config_.encoder_out_feature_size_, config_.grid_size_x_, config_.grid_size_y_,
-    spatial_features_d_.get(), stream_));
+  // scatter the pillars of each point cloud to its own spatial features
+  const auto spatial_features_size =
+    config_.grid_size_x_ * config_.grid_size_y_ * config_.encoder_out_feature_size_;
+  for (std::size_t bi = 0; bi < config_.batch_size_; bi++) {
+    const auto voxel_offset = bi * config_.max_voxel_size_;
+    CHECK_CUDA_ERROR(scatterFeatures_launch(
+      pillar_features_d_.get() + voxel_offset * config_.encoder_out_feature_size_,
+      coordinates_d_.get() + voxel_offset * config_.point_dim_size_, config_.max_voxel_size_,
+      config_.max_voxel_size_, config_.encoder_out_feature_size_, config_.grid_size_x_,
+      config_.grid_size_y_, spatial_features_d_.get() + bi * spatial_features_size, stream_));
+  }
 
   // head network
   std::vector<void *> head_buffers = {spatial_features_d_.get(), head_out_heatmap_d_.get(),
@@ -181,13 +383,25 @@ void CenterPointTRT::inference()
                                       head_out_dim_d_.get(),     head_out_rot_d_.get(),
                                       head_out_vel_d_.get()};
   head_trt_ptr_->context_->enqueueV2(head_buffers.data(), stream_, nullptr);
+
+  // decode the boxes, the outputs of the head being of shape
+  // (batch_size, channel_size, down_grid_size_y, down_grid_size_x)
+  const auto grid_xy_size = config_.down_grid_size_x_ * config_.down_grid_size_y_;
+  for (std::size_t bi = 0; bi < config_.batch_size_; bi++) {
+    const auto offset = bi * grid_xy_size;
+    CHECK_CUDA_ERROR(post_proc_ptr_->generateBoxes3D_launch(
+      head_out_heatmap_d_.get() + offset * config_.class_size_,
+      head_out_offset_d_.get() + offset * config_.head_out_offset_size_,
+      head_out_z_d_.get() + offset * config_.head_out_z_size_,
+      head_out_dim_d_.get() + offset * config_.head_out_dim_size_,
+      head_out_rot_d_.get() + offset * config_.head_out_rot_size_,
+      head_out_vel_d_.get() + offset * config_.head_out_vel_size_, bi, stream_));
+  }
 }
 
-void CenterPointTRT::postProcess(std::vector<Box3D> & det_boxes3d)
+void CenterPointTRT::postProcess(const std::size_t batch_index, std::vector<Box3D> & det_boxes3d)
 {
-  CHECK_CUDA_ERROR(post_proc_ptr_->generateDetectedBoxes3D_launch(
-    head_out_heatmap_d_.get(), head_out_offset_d_.get(), head_out_z_d_.get(), head_out_dim_d_.get(),
-    head_out_rot_d_.get(), head_out_vel_d_.get(), det_boxes3d, stream_));
+  CHECK_CUDA_ERROR(post_proc_ptr_->selectDetectedBoxes3D(batch_index, det_boxes3d, stream_));
   if (det_boxes3d.size() == 0) {
     RCLCPP_WARN_STREAM(rclcpp::get_logger("lidar_centerpoint"), "No detected boxes.");
   }
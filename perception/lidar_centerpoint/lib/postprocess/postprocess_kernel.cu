@@ -107,14 +107,15 @@ __global__ void generateBoxes3D_kernel(
 PostProcessCUDA::PostProcessCUDA(const CenterPointConfig & config) : config_(config)
 {
   const auto num_raw_boxes3d = config.down_grid_size_y_ * config.down_grid_size_x_;
-  boxes3d_d_ = thrust::device_vector<Box3D>(num_raw_boxes3d);
+  boxes3d_d_ = thrust::device_vector<Box3D>(config.batch_size_ * num_raw_boxes3d);
 }
 
-cudaError_t PostProcessCUDA::generateDetectedBoxes3D_launch(
+cudaError_t PostProcessCUDA::generateBoxes3D_launch(
   const float * out_heatmap, const float * out_offset, const float * out_z, const float * out_dim,
-  const float * out_rot, const float * out_vel, std::vector<Box3D> & det_boxes3d,
+  const float * out_rot, const float * out_vel, const std::size_t batch_index,
   cudaStream_t stream)
 {
+  const auto num_raw_boxes3d = config_.down_grid_size_y_ * config_.down_grid_size_x_;
   dim3 blocks(
     divup(config_.down_grid_size_y_, THREADS_PER_BLOCK),
     divup(config_.down_grid_size_x_, THREADS_PER_BLOCK));
@@ -123,18 +124,27 @@ cudaError_t PostProcessCUDA::generateDetectedBoxes3D_launch(
     out_heatmap, out_offset, out_z, out_dim, out_rot, out_vel, config_.voxel_size_x_,
     config_.voxel_size_y_, config_.range_min_x_, config_.range_min_y_, config_.down_grid_size_x_,
     config_.down_grid_size_y_, config_.downsample_factor_, config_.class_size_,
-    thrust::raw_pointer_cast(boxes3d_d_.data()));
+    thrust::raw_pointer_cast(boxes3d_d_.data()) + batch_index * num_raw_boxes3d);
+
+  return cudaGetLastError();
+}
+
+cudaError_t PostProcessCUDA::selectDetectedBoxes3D(
+  const std::size_t batch_index, std::vector<Box3D> & det_boxes3d, cudaStream_t stream)
+{
+  const auto num_raw_boxes3d = config_.down_grid_size_y_ * config_.down_grid_size_x_;
+  const auto boxes3d_begin = boxes3d_d_.begin() + batch_index * num_raw_boxes3d;
+  const auto boxes3d_end = boxes3d_begin + num_raw_boxes3d;
 
   // suppress by socre
   const auto num_det_boxes3d = thrust::count_if(
-    thrust::device, boxes3d_d_.begin(), boxes3d_d_.end(),
-    is_score_greater(config_.score_threshold_));
+    thrust::device, boxes3d_begin, boxes3d_end, is_score_greater(config_.score_threshold_));
   if (num_det_boxes3d == 0) {
     return cudaGetLastError();
   }
   thrust::device_vector<Box3D> det_boxes3d_d(num_det_boxes3d);
   thrust::copy_if(
-    thrust::device, boxes3d_d_.begin(), boxes3d_d_.end(), det_boxes3d_d.begin(),
+    thrust::device, boxes3d_begin, boxes3d_end, det_boxes3d_d.begin(),
     is_score_greater(config_.score_threshold_));
 
   // sort by score
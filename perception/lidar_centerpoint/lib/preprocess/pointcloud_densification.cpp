@@ -56,6 +56,18 @@ Eigen::Affine3f transformToEigen(const geometry_msgs::msg::Transform & t)
 
 namespace centerpoint
 {
+boost::optional<Eigen::Affine3f> lookupAffineWorldToCurrent(
+  const tf2_ros::Buffer & tf_buffer, const std_msgs::msg::Header & header,
+  const std::string & world_frame_id)
+{
+  auto transform_world2current =
+    getTransform(tf_buffer, header.frame_id, world_frame_id, header.stamp);
+  if (!transform_world2current) {
+    return boost::none;
+  }
+  return transformToEigen(transform_world2current.get());
+}
+
 PointCloudDensification::PointCloudDensification(const DensificationParam & param) : param_(param)
 {
 }
@@ -63,16 +75,13 @@ PointCloudDensification::PointCloudDensification(const DensificationParam & para
 bool PointCloudDensification::enqueuePointCloud(
   const sensor_msgs::msg::PointCloud2 & pointcloud_msg, const tf2_ros::Buffer & tf_buffer)
 {
-  const auto header = pointcloud_msg.header;
-
-  auto transform_world2current =
-    getTransform(tf_buffer, header.frame_id, param_.world_frame_id(), header.stamp);
-  if (!transform_world2current) {
+  auto affine_world2current =
+    lookupAffineWorldToCurrent(tf_buffer, pointcloud_msg.header, param_.world_frame_id());
+  if (!affine_world2current) {
     return false;
   }
-  auto affine_world2current = transformToEigen(transform_world2current.get());
 
-  enqueue(pointcloud_msg, affine_world2current);
+  enqueue(pointcloud_msg, affine_world2current.get());
   dequeue();
 
   return true;
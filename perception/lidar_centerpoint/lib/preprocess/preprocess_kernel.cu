@@ -32,9 +32,13 @@
 
 #include <lidar_centerpoint/utils.hpp>
 
+#include <thrust/execution_policy.h>
+#include <thrust/scan.h>
+
 namespace
 {
 const std::size_t MAX_POINT_IN_VOXEL_SIZE = 32;  // the same as max_point_in_voxel_size_ in config
+const std::size_t POINTS_PER_BLOCK = 256;
 const std::size_t WARPS_PER_BLOCK = 4;
 const std::size_t ENCODER_IN_FEATURE_SIZE = 9;  // the same as encoder_in_feature_size_ in config
 }  // namespace
@@ -156,4 +160,149 @@ cudaError_t generateFeatures_launch(
   return cudaGetLastError();
 }
 
+__global__ void generateSweepPoints_kernel(
+  const std::uint8_t * data, const std::size_t num_points, const std::size_t point_step,
+  const std::size_t x_offset, const std::size_t y_offset, const std::size_t z_offset,
+  const Affine3x4 affine, const float time_lag, const float range_min_x, const float range_min_y,
+  const float range_min_z, const float voxel_size_x, const float voxel_size_y,
+  const float voxel_size_z, const int grid_size_x, const int grid_size_y, const int grid_size_z,
+  float4 * points, int * point_cells, int * cell_mask)
+{
+  // data: raw data of the point cloud, x, y and z being float32
+  // points: (num_points, 4), x, y, z and time_lag in the current frame
+  // point_cells: (num_points), -1 if out of range
+  const auto point_i = blockIdx.x * POINTS_PER_BLOCK + threadIdx.x;
+  if (point_i >= num_points) {
+    return;
+  }
+
+  const std::uint8_t * point = data + point_i * point_step;
+  const float x_past = *reinterpret_cast<const float *>(point + x_offset);
+  const float y_past = *reinterpret_cast<const float *>(point + y_offset);
+  const float z_past = *reinterpret_cast<const float *>(point + z_offset);
+  const float * m = affine.m;
+  const float x = m[0] * x_past + m[1] * y_past + m[2] * z_past + m[3];
+  const float y = m[4] * x_past + m[5] * y_past + m[6] * z_past + m[7];
+  const float z = m[8] * x_past + m[9] * y_past + m[10] * z_past + m[11];
+  points[point_i] = make_float4(x, y, z, time_lag);
+
+  // truncated toward zero as in the host voxel generator
+  const int cell_x = static_cast<int>((x - range_min_x) / voxel_size_x);
+  const int cell_y = static_cast<int>((y - range_min_y) / voxel_size_y);
+  const int cell_z = static_cast<int>((z - range_min_z) / voxel_size_z);
+  if (
+    cell_x < 0 || cell_x >= grid_size_x || cell_y < 0 || cell_y >= grid_size_y || cell_z < 0 ||
+    cell_z >= grid_size_z) {
+    point_cells[point_i] = -1;
+    return;
+  }
+
+  const int cell = (cell_z * grid_size_y + cell_y) * grid_size_x + cell_x;
+  point_cells[point_i] = cell;
+  cell_mask[cell] = 1;
+}
+
+cudaError_t generateSweepPoints_launch(
+  const std::uint8_t * data, const std::size_t num_points, const std::size_t point_step,
+  const std::size_t x_offset, const std::size_t y_offset, const std::size_t z_offset,
+  const Affine3x4 & affine_past2current, const float time_lag, const float range_min_x,
+  const float range_min_y, const float range_min_z, const float voxel_size_x,
+  const float voxel_size_y, const float voxel_size_z, const int grid_size_x, const int grid_size_y,
+  const int grid_size_z, float * points, int * point_cells, int * cell_mask, cudaStream_t stream)
+{
+  if (num_points == 0) {
+    return cudaGetLastError();
+  }
+  dim3 blocks(divup(num_points, POINTS_PER_BLOCK));
+  dim3 threads(POINTS_PER_BLOCK);
+  generateSweepPoints_kernel<<<blocks, threads, 0, stream>>>(
+    data, num_points, point_step, x_offset, y_offset, z_offset, affine_past2current, time_lag,
+    range_min_x, range_min_y, range_min_z, voxel_size_x, voxel_size_y, voxel_size_z, grid_size_x,
+    grid_size_y, grid_size_z, reinterpret_cast<float4 *>(points), point_cells, cell_mask);
+
+  return cudaGetLastError();
+}
+
+__global__ void gatherVoxelPoints_kernel(
+  const float4 * points, const int * point_cells, const std::size_t num_points,
+  const int * cell_voxel_idx, const std::size_t max_voxel_size,
+  const std::size_t max_point_in_voxel_size, unsigned int * voxel_point_counts,
+  float4 * voxel_features)
+{
+  // voxel_features: (max_voxel_size, max_point_in_voxel_size, 4)
+  const auto point_i = blockIdx.x * POINTS_PER_BLOCK + threadIdx.x;
+  if (point_i >= num_points) {
+    return;
+  }
+
+  const int cell = point_cells[point_i];
+  if (cell < 0) {
+    return;
+  }
+  const int voxel_i = cell_voxel_idx[cell];
+  if (static_cast<std::size_t>(voxel_i) >= max_voxel_size) {
+    return;
+  }
+  // the points beyond max_point_in_voxel_size are dropped, in no particular order
+  const unsigned int slot = atomicAdd(&voxel_point_counts[voxel_i], 1U);
+  if (slot >= max_point_in_voxel_size) {
+    return;
+  }
+  voxel_features[voxel_i * max_point_in_voxel_size + slot] = points[point_i];
+}
+
+__global__ void generateVoxelCoords_kernel(
+  const int * cell_mask, const int * cell_voxel_idx, const std::size_t grid_size_x,
+  const std::size_t grid_size_y, const std::size_t grid_size, const std::size_t max_voxel_size,
+  const std::size_t max_point_in_voxel_size, const unsigned int * voxel_point_counts,
+  int * coords, float * voxel_num_points)
+{
+  // coords: (max_voxel_size, 3), zyx
+  const auto cell = blockIdx.x * POINTS_PER_BLOCK + threadIdx.x;
+  if (cell >= grid_size || cell_mask[cell] == 0) {
+    return;
+  }
+  const int voxel_i = cell_voxel_idx[cell];
+  if (static_cast<std::size_t>(voxel_i) >= max_voxel_size) {
+    return;
+  }
+
+  coords[voxel_i * 3 + 0] = cell / (grid_size_y * grid_size_x);
+  coords[voxel_i * 3 + 1] = (cell / grid_size_x) % grid_size_y;
+  coords[voxel_i * 3 + 2] = cell % grid_size_x;
+  voxel_num_points[voxel_i] =
+    min(voxel_point_counts[voxel_i], static_cast<unsigned int>(max_point_in_voxel_size));
+}
+
+cudaError_t generateVoxels_launch(
+  const float * points, const int * point_cells, const std::size_t num_points,
+  const int * cell_mask, const std::size_t grid_size_x, const std::size_t grid_size_y,
+  const std::size_t grid_size_z, const std::size_t max_voxel_size,
+  const std::size_t max_point_in_voxel_size, int * cell_voxel_idx,
+  unsigned int * voxel_point_counts, float * voxel_features, int * coords,
+  float * voxel_num_points, cudaStream_t stream)
+{
+  // the occupied cells are numbered in the order of the grid
+  const std::size_t grid_size = grid_size_z * grid_size_y * grid_size_x;
+  thrust::exclusive_scan(
+    thrust::cuda::par.on(stream), cell_mask, cell_mask + grid_size, cell_voxel_idx);
+
+  if (num_points > 0) {
+    dim3 blocks(divup(num_points, POINTS_PER_BLOCK));
+    dim3 threads(POINTS_PER_BLOCK);
+    gatherVoxelPoints_kernel<<<blocks, threads, 0, stream>>>(
+      reinterpret_cast<const float4 *>(points), point_cells, num_points, cell_voxel_idx,
+      max_voxel_size, max_point_in_voxel_size, voxel_point_counts,
+      reinterpret_cast<float4 *>(voxel_features));
+  }
+
+  dim3 blocks(divup(grid_size, POINTS_PER_BLOCK));
+  dim3 threads(POINTS_PER_BLOCK);
+  generateVoxelCoords_kernel<<<blocks, threads, 0, stream>>>(
+    cell_mask, cell_voxel_idx, grid_size_x, grid_size_y, grid_size, max_voxel_size,
+    max_point_in_voxel_size, voxel_point_counts, coords, voxel_num_points);
+
+  return cudaGetLastError();
+}
+
 }  // namespace centerpoint
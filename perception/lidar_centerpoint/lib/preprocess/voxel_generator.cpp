@@ -14,8 +14,14 @@
 
 #include "lidar_centerpoint/preprocess/voxel_generator.hpp"
 
+#include <lidar_centerpoint/preprocess/preprocess_kernel.hpp>
+
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
 namespace centerpoint
 {
 VoxelGeneratorTemplate::VoxelGeneratorTemplate(
@@ -127,4 +133,140 @@ std::size_t VoxelGenerator::pointsToVoxels(
   return voxel_cnt;
 }
 
+VoxelGeneratorCUDA::VoxelGeneratorCUDA(
+  const DensificationParam & param, const CenterPointConfig & config)
+: param_(param), config_(config)
+{
+  grid_size_ = config_.grid_size_z_ * config_.grid_size_y_ * config_.grid_size_x_;
+  cell_mask_d_ = cuda::make_unique<int[]>(grid_size_);
+  cell_voxel_idx_d_ = cuda::make_unique<int[]>(grid_size_);
+  voxel_point_counts_d_ = cuda::make_unique<unsigned int[]>(config_.max_voxel_size_);
+}
+
+bool VoxelGeneratorCUDA::enqueuePointCloud(
+  const sensor_msgs::msg::PointCloud2 & input_pointcloud_msg, const tf2_ros::Buffer & tf_buffer,
+  cudaStream_t stream)
+{
+  const auto affine_world2current = lookupAffineWorldToCurrent(
+    tf_buffer, input_pointcloud_msg.header, param_.world_frame_id());
+  if (!affine_world2current) {
+    return false;
+  }
+
+  // the kernels read x, y and z from the raw data of the point cloud
+  int x_offset = -1, y_offset = -1, z_offset = -1;
+  for (const auto & field : input_pointcloud_msg.fields) {
+    if (field.datatype != sensor_msgs::msg::PointField::FLOAT32) {
+      continue;
+    }
+    if (field.name == "x") {
+      x_offset = static_cast<int>(field.offset);
+    } else if (field.name == "y") {
+      y_offset = static_cast<int>(field.offset);
+    } else if (field.name == "z") {
+      z_offset = static_cast<int>(field.offset);
+    }
+  }
+  const std::size_t num_points = input_pointcloud_msg.width * input_pointcloud_msg.height;
+  const std::size_t data_size = num_points * input_pointcloud_msg.point_step;
+  if (
+    x_offset < 0 || y_offset < 0 || z_offset < 0 ||
+    input_pointcloud_msg.row_step != input_pointcloud_msg.width * input_pointcloud_msg.point_step ||
+    input_pointcloud_msg.data.size() < data_size) {
+    RCLCPP_WARN_STREAM(
+      rclcpp::get_logger("lidar_centerpoint"),
+      "The point cloud must be dense with float32 x, y and z fields.");
+    return false;
+  }
+
+  // the buffer of the oldest frame is reused once the cache is full
+  if (sweeps_.size() >= param_.pointcloud_cache_size()) {
+    sweeps_.splice(sweeps_.begin(), sweeps_, std::prev(sweeps_.end()));
+  } else {
+    sweeps_.emplace_front();
+  }
+  auto & sweep = sweeps_.front();
+  if (sweep.data_capacity < data_size) {
+    sweep.data_d = cuda::make_unique<std::uint8_t[]>(data_size);
+    sweep.data_capacity = data_size;
+  }
+  // the previous upload is complete, pointsToVoxels having synchronized the stream
+  if (data_h_capacity_ < data_size) {
+    data_h_ = cuda::make_host_unique<std::uint8_t[]>(data_size);
+    data_h_capacity_ = data_size;
+  }
+  std::memcpy(data_h_.get(), input_pointcloud_msg.data.data(), data_size);
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    sweep.data_d.get(), data_h_.get(), data_size, cudaMemcpyHostToDevice, stream));
+  sweep.num_points = num_points;
+  sweep.point_step = input_pointcloud_msg.point_step;
+  sweep.x_offset = x_offset;
+  sweep.y_offset = y_offset;
+  sweep.z_offset = z_offset;
+  sweep.timestamp = rclcpp::Time(input_pointcloud_msg.header.stamp).seconds();
+  sweep.affine_past2world = affine_world2current->inverse();
+
+  current_timestamp_ = sweep.timestamp;
+  affine_world2current_ = affine_world2current.get();
+
+  return true;
+}
+
+std::size_t VoxelGeneratorCUDA::pointsToVoxels(
+  float * voxels_d, int * coordinates_d, float * num_points_per_voxel_d, cudaStream_t stream)
+{
+  std::size_t num_points = 0;
+  for (const auto & sweep : sweeps_) {
+    num_points += sweep.num_points;
+  }
+  if (num_points > points_capacity_) {
+    points_d_ = cuda::make_unique<float[]>(num_points * config_.point_feature_size_);
+    point_cells_d_ = cuda::make_unique<int[]>(num_points);
+    points_capacity_ = num_points;
+  }
+  CHECK_CUDA_ERROR(cudaMemsetAsync(cell_mask_d_.get(), 0, grid_size_ * sizeof(int), stream));
+  CHECK_CUDA_ERROR(cudaMemsetAsync(
+    voxel_point_counts_d_.get(), 0, config_.max_voxel_size_ * sizeof(unsigned int), stream));
+
+  // transform every frame to the current frame
+  std::size_t point_offset = 0;
+  for (const auto & sweep : sweeps_) {
+    const Eigen::Matrix4f matrix = (affine_world2current_ * sweep.affine_past2world).matrix();
+    Affine3x4 affine_past2current;
+    for (int ri = 0; ri < 3; ri++) {
+      for (int ci = 0; ci < 4; ci++) {
+        affine_past2current.m[ri * 4 + ci] = matrix(ri, ci);
+      }
+    }
+    const float time_lag = static_cast<float>(current_timestamp_ - sweep.timestamp);
+    CHECK_CUDA_ERROR(generateSweepPoints_launch(
+      sweep.data_d.get(), sweep.num_points, sweep.point_step, sweep.x_offset, sweep.y_offset,
+      sweep.z_offset, affine_past2current, time_lag, config_.range_min_x_, config_.range_min_y_,
+      config_.range_min_z_, config_.voxel_size_x_, config_.voxel_size_y_, config_.voxel_size_z_,
+      config_.grid_size_x_, config_.grid_size_y_, config_.grid_size_z_,
+      points_d_.get() + point_offset * config_.point_feature_size_,
+      point_cells_d_.get() + point_offset, cell_mask_d_.get(), stream));
+    point_offset += sweep.num_points;
+  }
+
+  CHECK_CUDA_ERROR(generateVoxels_launch(
+    points_d_.get(), point_cells_d_.get(), num_points, cell_mask_d_.get(), config_.grid_size_x_,
+    config_.grid_size_y_, config_.grid_size_z_, config_.max_voxel_size_,
+    config_.max_point_in_voxel_size_, cell_voxel_idx_d_.get(), voxel_point_counts_d_.get(),
+    voxels_d, coordinates_d, num_points_per_voxel_d, stream));
+
+  // the number of voxels is the number of occupied cells, up to max_voxel_size
+  int last_voxel_idx = 0, last_cell_mask = 0;
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    &last_voxel_idx, cell_voxel_idx_d_.get() + grid_size_ - 1, sizeof(int), cudaMemcpyDeviceToHost,
+    stream));
+  CHECK_CUDA_ERROR(cudaMemcpyAsync(
+    &last_cell_mask, cell_mask_d_.get() + grid_size_ - 1, sizeof(int), cudaMemcpyDeviceToHost,
+    stream));
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(stream));
+
+  return std::min(
+    static_cast<std::size_t>(last_voxel_idx + last_cell_mask), config_.max_voxel_size_);
+}
+
 }  // namespace centerpoint
@@ -26,6 +26,7 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -62,6 +63,10 @@ LidarCenterPointNode::LidarCenterPointNode(const rclcpp::NodeOptions & node_opti
     static_cast<std::size_t>(this->declare_parameter<std::int64_t>("downsample_factor"));
   const std::size_t encoder_in_feature_size =
     static_cast<std::size_t>(this->declare_parameter<std::int64_t>("encoder_in_feature_size"));
+  const bool use_pipelining = this->declare_parameter("use_pipelining", false);
+  const bool use_cuda_graph = this->declare_parameter("use_cuda_graph", false);
+  const std::size_t batch_size =
+    static_cast<std::size_t>(std::max<std::int64_t>(1, this->declare_parameter("batch_size", 1)));
 
   NetworkParam encoder_param(encoder_onnx_path, encoder_engine_path, trt_precision);
   NetworkParam head_param(head_onnx_path, head_engine_path, trt_precision);
@@ -80,15 +85,25 @@ LidarCenterPointNode::LidarCenterPointNode(const rclcpp::NodeOptions & node_opti
   }
   CenterPointConfig config(
     class_names_.size(), point_feature_size, max_voxel_size, point_cloud_range, voxel_size,
-    downsample_factor, encoder_in_feature_size, score_threshold, circle_nms_dist_threshold);
-  detector_ptr_ =
-    std::make_unique<CenterPointTRT>(encoder_param, head_param, densification_param, config);
-
-  pointcloud_sub_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
-    "~/input/pointcloud", rclcpp::SensorDataQoS{}.keep_last(1),
-    std::bind(&LidarCenterPointNode::pointCloudCallback, this, std::placeholders::_1));
-  objects_pub_ = this->create_publisher<autoware_auto_perception_msgs::msg::DetectedObjects>(
-    "~/output/objects", rclcpp::QoS{1});
+    downsample_factor, encoder_in_feature_size, score_threshold, circle_nms_dist_threshold,
+    batch_size);
+  use_pipelining_ = use_pipelining;
+  detector_ptr_ = std::make_unique<CenterPointTRT>(
+    encoder_param, head_param, densification_param, config, use_pipelining, use_cuda_graph);
+
+  // the topics of the i-th lidar are suffixed with _i when several lidars are batched
+  for (std::size_t bi = 0; bi < batch_size; bi++) {
+    const std::string suffix = batch_size > 1 ? "_" + std::to_string(bi) : "";
+    pointcloud_subs_.push_back(this->create_subscription<sensor_msgs::msg::PointCloud2>(
+      "~/input/pointcloud" + suffix, rclcpp::SensorDataQoS{}.keep_last(1),
+      [this, bi](const sensor_msgs::msg::PointCloud2::ConstSharedPtr msg) {
+        pointCloudCallback(msg, bi);
+      }));
+    objects_pubs_.push_back(
+      this->create_publisher<autoware_auto_perception_msgs::msg::DetectedObjects>(
+        "~/output/objects" + suffix, rclcpp::QoS{1}));
+  }
+  pointcloud_msgs_.resize(batch_size);
 
   // initialize debug tool
   {
@@ -102,34 +117,63 @@ LidarCenterPointNode::LidarCenterPointNode(const rclcpp::NodeOptions & node_opti
 }
 
 void LidarCenterPointNode::pointCloudCallback(
-  const sensor_msgs::msg::PointCloud2::ConstSharedPtr input_pointcloud_msg)
+  const sensor_msgs::msg::PointCloud2::ConstSharedPtr input_pointcloud_msg,
+  const std::size_t batch_index)
 {
-  const auto objects_sub_count =
-    objects_pub_->get_subscription_count() + objects_pub_->get_intra_process_subscription_count();
-  if (objects_sub_count < 1) {
+  std::vector<std::size_t> objects_sub_counts;
+  for (const auto & objects_pub : objects_pubs_) {
+    objects_sub_counts.push_back(
+      objects_pub->get_subscription_count() + objects_pub->get_intra_process_subscription_count());
+  }
+  if (std::all_of(objects_sub_counts.begin(), objects_sub_counts.end(), [](const auto count) {
+        return count < 1;
+      })) {
     return;
   }
 
+  // wait for a point cloud of every lidar, keeping the latest one of each
+  pointcloud_msgs_[batch_index] = input_pointcloud_msg;
+  if (std::any_of(pointcloud_msgs_.begin(), pointcloud_msgs_.end(), [](const auto & msg) {
+        return msg == nullptr;
+      })) {
+    return;
+  }
+  const auto pointcloud_msgs = pointcloud_msgs_;
+  std::fill(pointcloud_msgs_.begin(), pointcloud_msgs_.end(), nullptr);
+
   if (stop_watch_ptr_) {
     stop_watch_ptr_->toc("processing_time", true);
   }
 
-  std::vector<Box3D> det_boxes3d;
-  bool is_success = detector_ptr_->detect(*input_pointcloud_msg, tf_buffer_, det_boxes3d);
+  // the pipelined detector returns the objects of the previous point clouds
+  std::vector<std_msgs::msg::Header> det_headers;
+  std::vector<std::vector<Box3D>> det_boxes3d;
+  bool is_success = false;
+  if (use_pipelining_) {
+    is_success =
+      detector_ptr_->detectPipelined(pointcloud_msgs, tf_buffer_, det_headers, det_boxes3d);
+  } else {
+    is_success = detector_ptr_->detect(pointcloud_msgs, tf_buffer_, det_boxes3d);
+    for (const auto & pointcloud_msg : pointcloud_msgs) {
+      det_headers.push_back(pointcloud_msg->header);
+    }
+  }
   if (!is_success) {
     return;
   }
 
-  autoware_auto_perception_msgs::msg::DetectedObjects output_msg;
-  output_msg.header = input_pointcloud_msg->header;
-  for (const auto & box3d : det_boxes3d) {
-    autoware_auto_perception_msgs::msg::DetectedObject obj;
-    box3DToDetectedObject(box3d, class_names_, rename_car_to_truck_and_bus_, has_twist_, obj);
-    output_msg.objects.emplace_back(obj);
-  }
-
-  if (objects_sub_count > 0) {
-    objects_pub_->publish(output_msg);
+  for (std::size_t bi = 0; bi < det_boxes3d.size(); bi++) {
+    if (objects_sub_counts[bi] < 1) {
+      continue;
+    }
+    autoware_auto_perception_msgs::msg::DetectedObjects output_msg;
+    output_msg.header = det_headers[bi];
+    for (const auto & box3d : det_boxes3d[bi]) {
+      autoware_auto_perception_msgs::msg::DetectedObject obj;
+      box3DToDetectedObject(box3d, class_names_, rename_car_to_truck_and_bus_, has_twist_, obj);
+      output_msg.objects.emplace_back(obj);
+    }
+    objects_pubs_[bi]->publish(output_msg);
   }
 
   // add processing time for debug
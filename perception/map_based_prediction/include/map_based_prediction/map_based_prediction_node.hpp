@@ -22,6 +22,7 @@
 #include <lanelet2_extension/utility/utilities.hpp>
 #include <motion_utils/motion_utils.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <route_handler/centerline_cache.hpp>
 #include <tier4_autoware_utils/ros/transform_listener.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
@@ -49,16 +50,6 @@
 
 namespace map_based_prediction
 {
-struct ObjectData
-{
-  std_msgs::msg::Header header;
-  lanelet::ConstLanelets current_lanelets;
-  lanelet::ConstLanelets future_possible_lanelets;
-  geometry_msgs::msg::Pose pose;
-  geometry_msgs::msg::Twist twist;
-  double time_delay;
-};
-
 enum class Maneuver {
   LANE_FOLLOW = 0,
   LEFT_LANE_CHANGE = 1,
@@ -71,6 +62,34 @@ struct LaneletData
   float probability;
 };
 
+using LaneletsData = std::vector<LaneletData>;
+
+struct LaneletPathsData
+{
+  lanelet::routing::LaneletPaths left_paths;
+  lanelet::routing::LaneletPaths right_paths;
+  lanelet::routing::LaneletPaths center_paths;
+};
+
+// Lanelets of an object and the paths from them, reused while the object stays inside them
+struct LaneletsCache
+{
+  LaneletsData lanelets_data;
+  std::vector<LaneletPathsData> paths_data;  // for each of lanelets_data
+  double max_search_dist;
+};
+
+struct ObjectData
+{
+  std_msgs::msg::Header header;
+  lanelet::ConstLanelets current_lanelets;
+  lanelet::ConstLanelets future_possible_lanelets;
+  geometry_msgs::msg::Pose pose;
+  geometry_msgs::msg::Twist twist;
+  double time_delay;
+  std::shared_ptr<const LaneletsCache> lanelets_cache;
+};
+
 struct PredictedRefPath
 {
   float probability;
@@ -78,7 +97,23 @@ struct PredictedRefPath
   Maneuver maneuver;
 };
 
-using LaneletsData = std::vector<LaneletData>;
+// Object whose paths are generated once the map queries are done
+struct PathGenerationTask
+{
+  enum class Type {
+    NONE,  // the paths are already generated
+    NON_VEHICLE,
+    OFF_LANE_VEHICLE,
+    LOW_SPEED_VEHICLE,
+    ON_LANE_VEHICLE,
+  };
+
+  Type type;
+  TrackedObject object;
+  std::vector<PredictedRefPath> ref_paths;  // for ON_LANE_VEHICLE
+  PredictedObject predicted_object;
+};
+
 using ManeuverProbability = std::unordered_map<Maneuver, float>;
 using autoware_auto_mapping_msgs::msg::HADMapBin;
 using autoware_auto_perception_msgs::msg::ObjectClassification;
@@ -120,6 +155,9 @@ private:
   // Crosswalk Entry Points
   lanelet::ConstLanelets crosswalks_;
 
+  // Resampled centerlines of the road lanelets
+  route_handler::CenterlineCache centerline_cache_;
+
   // Parameters
   bool enable_delay_compensation_;
   double prediction_time_horizon_;
@@ -137,6 +175,7 @@ private:
   double diff_dist_threshold_to_left_bound_;
   double diff_dist_threshold_to_right_bound_;
   double reference_path_resolution_;
+  int num_threads_;
 
   // Stop watch
   StopWatch<std::chrono::milliseconds> stop_watch_;
@@ -151,10 +190,13 @@ private:
   PredictedObject convertToPredictedObject(const TrackedObject & tracked_object);
 
   PredictedObject getPredictedObjectAsCrosswalkUser(const TrackedObject & object);
+  bool generatePredictedPaths(PathGenerationTask & task) const;
 
   void removeOldObjectsHistory(const double current_time);
 
-  LaneletsData getCurrentLanelets(const TrackedObject & object);
+  std::shared_ptr<const LaneletsCache> getLaneletsCache(const TrackedObject & object) const;
+  LaneletsData getCurrentLanelets(
+    const TrackedObject & object, const std::shared_ptr<const LaneletsCache> & lanelets_cache);
   bool checkCloseLaneletCondition(
     const std::pair<double, lanelet::Lanelet> & lanelet, const TrackedObject & object,
     const lanelet::BasicPoint2d & search_point);
@@ -168,7 +210,7 @@ private:
 
   std::vector<PredictedRefPath> getPredictedReferencePath(
     const TrackedObject & object, const LaneletsData & current_lanelets_data,
-    const double object_detected_time);
+    const double object_detected_time, const std::shared_ptr<const LaneletsCache> & lanelets_cache);
   Maneuver predictObjectManeuver(
     const TrackedObject & object, const LaneletData & current_lanelet,
     const double object_detected_time);
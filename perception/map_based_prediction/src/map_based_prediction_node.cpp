@@ -15,6 +15,7 @@
 #include "map_based_prediction/map_based_prediction_node.hpp"
 
 #include <interpolation/linear_interpolation.hpp>
+#include <route_handler/lanelet_map_cache.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
 #include <autoware_auto_perception_msgs/msg/detected_objects.hpp>
@@ -272,6 +273,7 @@ MapBasedPredictionNode::MapBasedPredictionNode(const rclcpp::NodeOptions & node_
   diff_dist_threshold_to_right_bound_ =
     declare_parameter("diff_dist_threshold_to_right_bound", -0.29);
   reference_path_resolution_ = declare_parameter("reference_path_resolution", 0.5);
+  num_threads_ = std::max(static_cast<int>(declare_parameter("num_threads", 1)), 1);
 
   path_generator_ = std::make_shared<PathGenerator>(
     prediction_time_horizon_, prediction_sampling_time_interval_,
@@ -315,9 +317,8 @@ PredictedObject MapBasedPredictionNode::convertToPredictedObject(
 void MapBasedPredictionNode::mapCallback(const HADMapBin::ConstSharedPtr msg)
 {
   RCLCPP_INFO(get_logger(), "[Map Based Prediction]: Start loading lanelet");
-  lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
-  lanelet::utils::conversion::fromBinMsg(
-    *msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
+  lanelet_map_ptr_ = route_handler::LaneletMapCache::getLaneletMap(
+    *msg, &traffic_rules_ptr_, &routing_graph_ptr_);
   RCLCPP_INFO(get_logger(), "[Map Based Prediction]: Map is loaded");
 
   const auto all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
@@ -325,6 +326,9 @@ void MapBasedPredictionNode::mapCallback(const HADMapBin::ConstSharedPtr msg)
   const auto walkways = lanelet::utils::query::walkwayLanelets(all_lanelets);
   crosswalks_.insert(crosswalks_.end(), crosswalks.begin(), crosswalks.end());
   crosswalks_.insert(crosswalks_.end(), walkways.begin(), walkways.end());
+
+  const auto road_lanelets = lanelet::utils::query::roadLanelets(all_lanelets);
+  centerline_cache_ = route_handler::CenterlineCache(road_lanelets, reference_path_resolution_);
 }
 
 void MapBasedPredictionNode::objectsCallback(const TrackedObjects::ConstSharedPtr in_objects)
@@ -363,8 +367,10 @@ void MapBasedPredictionNode::objectsCallback(const TrackedObjects::ConstSharedPt
   // result debug
   visualization_msgs::msg::MarkerArray debug_markers;
 
+  // The map and the objects history are only accessed here, the paths are generated afterwards
+  std::vector<PathGenerationTask> tasks;
+  tasks.reserve(in_objects->objects.size());
   for (const auto & object : in_objects->objects) {
-    std::string object_id = toHexString(object.object_id);
     TrackedObject transformed_object = object;
 
     // transform object frame if it's based on map frame
@@ -378,10 +384,11 @@ void MapBasedPredictionNode::objectsCallback(const TrackedObjects::ConstSharedPt
 
     const auto & label = transformed_object.classification.front().label;
 
+    PathGenerationTask task;
     // For crosswalk user
     if (label == ObjectClassification::PEDESTRIAN || label == ObjectClassification::BICYCLE) {
-      const auto predicted_object = getPredictedObjectAsCrosswalkUser(transformed_object);
-      output.objects.push_back(predicted_object);
+      task.type = PathGenerationTask::Type::NONE;
+      task.predicted_object = getPredictedObjectAsCrosswalkUser(transformed_object);
       // For road user
     } else if (
       label == ObjectClassification::CAR || label == ObjectClassification::BUS ||
@@ -390,118 +397,123 @@ void MapBasedPredictionNode::objectsCallback(const TrackedObjects::ConstSharedPt
       // Update object yaw and velocity
       updateObjectData(transformed_object);
 
-      // Get Closest Lanelet
-      const auto current_lanelets = getCurrentLanelets(transformed_object);
+      // Get Closest Lanelet, the previous ones are reused while the object stays inside them
+      const auto lanelets_cache = getLaneletsCache(transformed_object);
+      const auto current_lanelets = getCurrentLanelets(transformed_object, lanelets_cache);
 
       // Update Objects History
       updateObjectsHistory(output.header, transformed_object, current_lanelets);
 
-      // For off lane obstacles
       if (current_lanelets.empty()) {
-        PredictedPath predicted_path =
-          path_generator_->generatePathForOffLaneVehicle(transformed_object);
-        predicted_path.confidence = 1.0;
-        if (predicted_path.path.empty()) {
-          continue;
-        }
-
-        auto predicted_object = convertToPredictedObject(transformed_object);
-        predicted_object.kinematics.predicted_paths.push_back(predicted_path);
-        output.objects.push_back(predicted_object);
-        continue;
-      }
-
-      // For too-slow vehicle
-      if (
+        // For off lane obstacles
+        task.type = PathGenerationTask::Type::OFF_LANE_VEHICLE;
+      } else if (
         std::fabs(transformed_object.kinematics.twist_with_covariance.twist.linear.x) <
         min_velocity_for_map_based_prediction_) {
-        PredictedPath predicted_path =
-          path_generator_->generatePathForLowSpeedVehicle(transformed_object);
-        predicted_path.confidence = 1.0;
-        if (predicted_path.path.empty()) {
-          continue;
+        // For too-slow vehicle
+        task.type = PathGenerationTask::Type::LOW_SPEED_VEHICLE;
+      } else {
+        // Get Predicted Reference Path for Each Maneuver and current lanelets
+        // return: <probability, paths>
+        task.ref_paths = getPredictedReferencePath(
+          transformed_object, current_lanelets, objects_detected_time, lanelets_cache);
+
+        if (task.ref_paths.empty()) {
+          // If predicted reference path is empty, assume this object is out of the lane
+          task.type = PathGenerationTask::Type::LOW_SPEED_VEHICLE;
+        } else {
+          task.type = PathGenerationTask::Type::ON_LANE_VEHICLE;
+
+          // Get Debug Marker for On Lane Vehicles
+          const auto max_prob_path = std::max_element(
+            task.ref_paths.begin(), task.ref_paths.end(),
+            [](const PredictedRefPath & a, const PredictedRefPath & b) {
+              return a.probability < b.probability;
+            });
+          const auto debug_marker =
+            getDebugMarker(object, max_prob_path->maneuver, debug_markers.markers.size());
+          debug_markers.markers.push_back(debug_marker);
         }
-
-        auto predicted_object = convertToPredictedObject(transformed_object);
-        predicted_object.kinematics.predicted_paths.push_back(predicted_path);
-        output.objects.push_back(predicted_object);
-        continue;
       }
+      // For unknown object
+    } else {
+      task.type = PathGenerationTask::Type::NON_VEHICLE;
+    }
+    task.object = transformed_object;
+    if (task.type != PathGenerationTask::Type::NONE) {
+      task.predicted_object = convertToPredictedObject(transformed_object);
+    }
+    tasks.push_back(task);
+  }
 
-      // Get Predicted Reference Path for Each Maneuver and current lanelets
-      // return: <probability, paths>
-      const auto ref_paths =
-        getPredictedReferencePath(transformed_object, current_lanelets, objects_detected_time);
+  // The objects are independent of each other
+  std::vector<char> is_valid(tasks.size(), false);
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    is_valid.at(i) = generatePredictedPaths(tasks.at(i));
+  }
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    if (is_valid.at(i)) {
+      output.objects.push_back(tasks.at(i).predicted_object);
+    }
+  }
 
-      // If predicted reference path is empty, assume this object is out of the lane
-      if (ref_paths.empty()) {
-        PredictedPath predicted_path =
-          path_generator_->generatePathForLowSpeedVehicle(transformed_object);
-        predicted_path.confidence = 1.0;
-        if (predicted_path.path.empty()) {
-          continue;
-        }
+  // Publish Results
+  pub_objects_->publish(output);
+  pub_debug_markers_->publish(debug_markers);
+}
 
-        auto predicted_object = convertToPredictedObject(transformed_object);
-        predicted_object.kinematics.predicted_paths.push_back(predicted_path);
-        output.objects.push_back(predicted_object);
-        continue;
+bool MapBasedPredictionNode::generatePredictedPaths(PathGenerationTask & task) const
+{
+  const auto & object = task.object;
+  auto & predicted_paths = task.predicted_object.kinematics.predicted_paths;
+  switch (task.type) {
+    case PathGenerationTask::Type::NONE:
+      return true;
+    case PathGenerationTask::Type::NON_VEHICLE: {
+      PredictedPath predicted_path = path_generator_->generatePathForNonVehicleObject(object);
+      predicted_path.confidence = 1.0;
+      predicted_paths.push_back(predicted_path);
+      return true;
+    }
+    case PathGenerationTask::Type::OFF_LANE_VEHICLE:
+    case PathGenerationTask::Type::LOW_SPEED_VEHICLE: {
+      PredictedPath predicted_path =
+        task.type == PathGenerationTask::Type::OFF_LANE_VEHICLE
+          ? path_generator_->generatePathForOffLaneVehicle(object)
+          : path_generator_->generatePathForLowSpeedVehicle(object);
+      predicted_path.confidence = 1.0;
+      if (predicted_path.path.empty()) {
+        return false;
       }
-
-      // Get Debug Marker for On Lane Vehicles
-      const auto max_prob_path = std::max_element(
-        ref_paths.begin(), ref_paths.end(),
-        [](const PredictedRefPath & a, const PredictedRefPath & b) {
-          return a.probability < b.probability;
-        });
-      const auto debug_marker =
-        getDebugMarker(object, max_prob_path->maneuver, debug_markers.markers.size());
-      debug_markers.markers.push_back(debug_marker);
-
+      predicted_paths.push_back(predicted_path);
+      return true;
+    }
+    case PathGenerationTask::Type::ON_LANE_VEHICLE: {
       // Generate Predicted Path
-      std::vector<PredictedPath> predicted_paths;
-      for (const auto & ref_path : ref_paths) {
+      for (const auto & ref_path : task.ref_paths) {
         PredictedPath predicted_path =
-          path_generator_->generatePathForOnLaneVehicle(transformed_object, ref_path.path);
+          path_generator_->generatePathForOnLaneVehicle(object, ref_path.path);
         predicted_path.confidence = ref_path.probability;
 
         predicted_paths.push_back(predicted_path);
       }
 
       // Normalize Path Confidence and output the predicted object
-      {
-        float sum_confidence = 0.0;
-        for (const auto & predicted_path : predicted_paths) {
-          sum_confidence += predicted_path.confidence;
-        }
-        const float min_sum_confidence_value = 1e-3;
-        sum_confidence = std::max(sum_confidence, min_sum_confidence_value);
-
-        for (auto & predicted_path : predicted_paths) {
-          predicted_path.confidence = predicted_path.confidence / sum_confidence;
-        }
-
-        auto predicted_object = convertToPredictedObject(transformed_object);
-        for (const auto & predicted_path : predicted_paths) {
-          predicted_object.kinematics.predicted_paths.push_back(predicted_path);
-        }
-        output.objects.push_back(predicted_object);
+      float sum_confidence = 0.0;
+      for (const auto & predicted_path : predicted_paths) {
+        sum_confidence += predicted_path.confidence;
       }
-      // For unknown object
-    } else {
-      auto predicted_object = convertToPredictedObject(transformed_object);
-      PredictedPath predicted_path =
-        path_generator_->generatePathForNonVehicleObject(transformed_object);
-      predicted_path.confidence = 1.0;
+      const float min_sum_confidence_value = 1e-3;
+      sum_confidence = std::max(sum_confidence, min_sum_confidence_value);
 
-      predicted_object.kinematics.predicted_paths.push_back(predicted_path);
-      output.objects.push_back(predicted_object);
+      for (auto & predicted_path : predicted_paths) {
+        predicted_path.confidence = predicted_path.confidence / sum_confidence;
+      }
+      return true;
     }
   }
-
-  // Publish Results
-  pub_objects_->publish(output);
-  pub_debug_markers_->publish(debug_markers);
+  return false;
 }
 
 PredictedObject MapBasedPredictionNode::getPredictedObjectAsCrosswalkUser(
@@ -695,8 +707,45 @@ void MapBasedPredictionNode::removeOldObjectsHistory(const double current_time)
   }
 }
 
-LaneletsData MapBasedPredictionNode::getCurrentLanelets(const TrackedObject & object)
+std::shared_ptr<const LaneletsCache> MapBasedPredictionNode::getLaneletsCache(
+  const TrackedObject & object) const
+{
+  const auto itr = objects_history_.find(toHexString(object.object_id));
+  if (itr == objects_history_.end() || itr->second.empty() || !itr->second.back().lanelets_cache) {
+    return nullptr;
+  }
+  const auto & lanelets_cache = itr->second.back().lanelets_cache;
+
+  // The paths have to cover the prediction horizon at the current velocity
+  const double obj_vel = std::fabs(object.kinematics.twist_with_covariance.twist.linear.x);
+  if (lanelets_cache->max_search_dist < prediction_time_horizon_ * obj_vel) {
+    return nullptr;
+  }
+
+  // The cache is invalidated as soon as the object crosses a boundary of its lanelets
+  const lanelet::BasicPoint2d search_point(
+    object.kinematics.pose_with_covariance.pose.position.x,
+    object.kinematics.pose_with_covariance.pose.position.y);
+  for (const auto & lanelet_data : lanelets_cache->lanelets_data) {
+    if (!lanelet::geometry::inside(lanelet_data.lanelet, search_point)) {
+      return nullptr;
+    }
+  }
+  return lanelets_cache;
+}
+
+LaneletsData MapBasedPredictionNode::getCurrentLanelets(
+  const TrackedObject & object, const std::shared_ptr<const LaneletsCache> & lanelets_cache)
 {
+  // Only the likelihood of the cached lanelets changes
+  if (lanelets_cache) {
+    LaneletsData closest_lanelets = lanelets_cache->lanelets_data;
+    for (auto & closest_lanelet : closest_lanelets) {
+      closest_lanelet.probability = calculateLocalLikelihood(closest_lanelet.lanelet, object);
+    }
+    return closest_lanelets;
+  }
+
   // obstacle point
   lanelet::BasicPoint2d search_point(
     object.kinematics.pose_with_covariance.pose.position.x,
@@ -845,46 +894,64 @@ void MapBasedPredictionNode::updateObjectsHistory(
 
 std::vector<PredictedRefPath> MapBasedPredictionNode::getPredictedReferencePath(
   const TrackedObject & object, const LaneletsData & current_lanelets_data,
-  const double object_detected_time)
+  const double object_detected_time, const std::shared_ptr<const LaneletsCache> & lanelets_cache)
 {
   const double delta_horizon = 1.0;
   const double obj_vel = std::fabs(object.kinematics.twist_with_covariance.twist.linear.x);
 
-  std::vector<PredictedRefPath> all_ref_paths;
-  for (const auto & current_lanelet_data : current_lanelets_data) {
-    // Step1. Get the path
-    // Step1.1 Get the left lanelet
-    lanelet::routing::LaneletPaths left_paths;
-    auto opt_left = routing_graph_ptr_->left(current_lanelet_data.lanelet);
-    if (!!opt_left) {
-      for (double horizon = prediction_time_horizon_; horizon > 0; horizon -= delta_horizon) {
-        const double search_dist = horizon * obj_vel + 10.0;
-        lanelet::routing::LaneletPaths tmp_paths =
-          routing_graph_ptr_->possiblePaths(*opt_left, search_dist, 0, false);
-        addValidPath(tmp_paths, left_paths);
+  // Step1. Get the paths, or reuse the ones of the cached lanelets
+  std::shared_ptr<const LaneletsCache> paths_cache = lanelets_cache;
+  if (!paths_cache) {
+    auto new_cache = std::make_shared<LaneletsCache>();
+    new_cache->lanelets_data = current_lanelets_data;
+    new_cache->max_search_dist = prediction_time_horizon_ * obj_vel + 10.0;
+    for (const auto & current_lanelet_data : current_lanelets_data) {
+      LaneletPathsData paths_data;
+      // Step1.1 Get the left lanelet
+      auto opt_left = routing_graph_ptr_->left(current_lanelet_data.lanelet);
+      if (!!opt_left) {
+        for (double horizon = prediction_time_horizon_; horizon > 0; horizon -= delta_horizon) {
+          const double search_dist = horizon * obj_vel + 10.0;
+          lanelet::routing::LaneletPaths tmp_paths =
+            routing_graph_ptr_->possiblePaths(*opt_left, search_dist, 0, false);
+          addValidPath(tmp_paths, paths_data.left_paths);
+        }
+      }
+
+      // Step1.2 Get the right lanelet
+      auto opt_right = routing_graph_ptr_->right(current_lanelet_data.lanelet);
+      if (!!opt_right) {
+        for (double horizon = prediction_time_horizon_; horizon > 0; horizon -= delta_horizon) {
+          const double search_dist = horizon * obj_vel + 10.0;
+          lanelet::routing::LaneletPaths tmp_paths =
+            routing_graph_ptr_->possiblePaths(*opt_right, search_dist, 0, false);
+          addValidPath(tmp_paths, paths_data.right_paths);
+        }
       }
-    }
 
-    // Step1.2 Get the right lanelet
-    lanelet::routing::LaneletPaths right_paths;
-    auto opt_right = routing_graph_ptr_->right(current_lanelet_data.lanelet);
-    if (!!opt_right) {
+      // Step1.3 Get the centerline
       for (double horizon = prediction_time_horizon_; horizon > 0; horizon -= delta_horizon) {
         const double search_dist = horizon * obj_vel + 10.0;
         lanelet::routing::LaneletPaths tmp_paths =
-          routing_graph_ptr_->possiblePaths(*opt_right, search_dist, 0, false);
-        addValidPath(tmp_paths, right_paths);
+          routing_graph_ptr_->possiblePaths(current_lanelet_data.lanelet, search_dist, 0, false);
+        addValidPath(tmp_paths, paths_data.center_paths);
       }
+      new_cache->paths_data.push_back(paths_data);
     }
+    paths_cache = new_cache;
+  }
+  // Kept in the latest object history until the object leaves the lanelets
+  const std::string object_id = toHexString(object.object_id);
+  if (objects_history_.count(object_id) != 0) {
+    objects_history_.at(object_id).back().lanelets_cache = paths_cache;
+  }
 
-    // Step1.3 Get the centerline
-    lanelet::routing::LaneletPaths center_paths;
-    for (double horizon = prediction_time_horizon_; horizon > 0; horizon -= delta_horizon) {
-      const double search_dist = horizon * obj_vel + 10.0;
-      lanelet::routing::LaneletPaths tmp_paths =
-        routing_graph_ptr_->possiblePaths(current_lanelet_data.lanelet, search_dist, 0, false);
-      addValidPath(tmp_paths, center_paths);
-    }
+  std::vector<PredictedRefPath> all_ref_paths;
+  for (size_t i = 0; i < current_lanelets_data.size(); ++i) {
+    const auto & current_lanelet_data = current_lanelets_data.at(i);
+    const auto & left_paths = paths_cache->paths_data.at(i).left_paths;
+    const auto & right_paths = paths_cache->paths_data.at(i).right_paths;
+    const auto & center_paths = paths_cache->paths_data.at(i).center_paths;
 
     // Skip calculations if all paths are empty
     if (left_paths.empty() && right_paths.empty() && center_paths.empty()) {
@@ -1213,25 +1280,24 @@ std::vector<PosePath> MapBasedPredictionNode::convertPathType(
     if (!path.empty()) {
       lanelet::ConstLanelets prev_lanelets = routing_graph_ptr_->previous(path.front());
       if (!prev_lanelets.empty()) {
-        lanelet::ConstLanelet prev_lanelet = prev_lanelets.front();
-        for (const auto & lanelet_p : prev_lanelet.centerline()) {
+        const auto prev_centerline = centerline_cache_.getCenterline(prev_lanelets.front());
+        for (size_t i = 0; i < prev_centerline->points.size(); ++i) {
           geometry_msgs::msg::Pose current_p;
-          current_p.position =
-            tier4_autoware_utils::createPoint(lanelet_p.x(), lanelet_p.y(), lanelet_p.z());
-          const double lane_yaw = lanelet::utils::getLaneletAngle(prev_lanelet, current_p.position);
-          current_p.orientation = tier4_autoware_utils::createQuaternionFromYaw(lane_yaw);
+          current_p.position = prev_centerline->points.at(i);
+          current_p.orientation =
+            tier4_autoware_utils::createQuaternionFromYaw(prev_centerline->yaws.at(i));
           converted_path.push_back(current_p);
         }
       }
     }
 
     for (const auto & lanelet : path) {
-      for (const auto & lanelet_p : lanelet.centerline()) {
+      const auto centerline = centerline_cache_.getCenterline(lanelet);
+      for (size_t i = 0; i < centerline->points.size(); ++i) {
         geometry_msgs::msg::Pose current_p;
-        current_p.position =
-          tier4_autoware_utils::createPoint(lanelet_p.x(), lanelet_p.y(), lanelet_p.z());
-        const double lane_yaw = lanelet::utils::getLaneletAngle(lanelet, current_p.position);
-        current_p.orientation = tier4_autoware_utils::createQuaternionFromYaw(lane_yaw);
+        current_p.position = centerline->points.at(i);
+        current_p.orientation =
+          tier4_autoware_utils::createQuaternionFromYaw(centerline->yaws.at(i));
 
         // Prevent from inserting same points
         if (!converted_path.empty()) {
@@ -19,7 +19,6 @@
 #ifndef MULTI_OBJECT_TRACKER__DATA_ASSOCIATION__DATA_ASSOCIATION_HPP_
 #define MULTI_OBJECT_TRACKER__DATA_ASSOCIATION__DATA_ASSOCIATION_HPP_
 
-#include <list>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -43,6 +42,7 @@ private:
   Eigen::MatrixXd max_rad_matrix_;
   Eigen::MatrixXd min_iou_matrix_;
   const double score_threshold_;
+  double gate_cell_size_;
   std::unique_ptr<gnn_solver::GnnSolverInterface> gnn_solver_ptr_;
 
 public:
@@ -56,7 +56,7 @@ public:
     std::unordered_map<int, int> & reverse_assignment);
   Eigen::MatrixXd calcScoreMatrix(
     const autoware_auto_perception_msgs::msg::DetectedObjects & measurements,
-    const std::list<std::shared_ptr<Tracker>> & trackers);
+    const std::vector<std::shared_ptr<Tracker>> & trackers);
   virtual ~DataAssociation() {}
 };
 
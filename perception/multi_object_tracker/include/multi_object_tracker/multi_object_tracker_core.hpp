@@ -41,7 +41,6 @@
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
-#include <list>
 #include <map>
 #include <memory>
 #include <string>
@@ -69,14 +68,14 @@ private:
   void onTimer();
 
   std::string world_frame_id_;  // tracking frame
-  std::list<std::shared_ptr<Tracker>> list_tracker_;
+  std::vector<std::shared_ptr<Tracker>> list_tracker_;
   std::unique_ptr<DataAssociation> data_association_;
 
   void checkTrackerLifeCycle(
-    std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time,
+    std::vector<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time,
     const geometry_msgs::msg::Transform & self_transform);
   void sanitizeTracker(
-    std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time);
+    std::vector<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time);
   std::shared_ptr<Tracker> createNewTracker(
     const autoware_auto_perception_msgs::msg::DetectedObject & object,
     const rclcpp::Time & time) const;
@@ -21,7 +21,7 @@
 
 #include "tracker_base.hpp"
 
-#include <kalman_filter/kalman_filter.hpp>
+#include <kalman_filter/fixed_size_kalman_filter.hpp>
 
 class NormalVehicleTracker : public Tracker
 {
@@ -30,7 +30,8 @@ private:
   rclcpp::Logger logger_;
 
 private:
-  KalmanFilter ekf_;
+  using EKF = FixedSizeKalmanFilter<5, 4>;
+  EKF ekf_;
   rclcpp::Time last_update_time_;
   enum IDX {
     X = 0,
@@ -41,7 +42,6 @@ private:
   };
   struct EkfParams
   {
-    char dim_x = 5;
     float q_cov_x;
     float q_cov_y;
     float q_cov_yaw;
@@ -77,7 +77,7 @@ public:
     const rclcpp::Time & time, const autoware_auto_perception_msgs::msg::DetectedObject & object);
 
   bool predict(const rclcpp::Time & time) override;
-  bool predict(const double dt, KalmanFilter & ekf) const;
+  bool predict(const double dt, EKF & ekf) const;
   bool measure(
     const autoware_auto_perception_msgs::msg::DetectedObject & object,
     const rclcpp::Time & time) override;
@@ -19,7 +19,8 @@
 #include "perception_utils/perception_utils.hpp"
 
 #include <algorithm>
-#include <list>
+#include <cmath>
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -27,16 +28,12 @@
 namespace
 {
 double getMahalanobisDistance(
-  const geometry_msgs::msg::Point & measurement, const geometry_msgs::msg::Point & tracker,
-  const Eigen::Matrix2d & covariance)
+  const geometry_msgs::msg::Point & measurement, const double tracker_x, const double tracker_y,
+  const Eigen::Matrix2d & covariance_inverse)
 {
-  Eigen::Vector2d measurement_point;
-  measurement_point << measurement.x, measurement.y;
-  Eigen::Vector2d tracker_point;
-  tracker_point << tracker.x, tracker.y;
-  Eigen::MatrixXd mahalanobis_squared = (measurement_point - tracker_point).transpose() *
-                                        covariance.inverse() * (measurement_point - tracker_point);
-  return std::sqrt(mahalanobis_squared(0));
+  Eigen::Vector2d diff;
+  diff << measurement.x - tracker_x, measurement.y - tracker_y;
+  return std::sqrt(diff.dot(covariance_inverse * diff));
 }
 
 Eigen::Matrix2d getXYCovariance(const geometry_msgs::msg::PoseWithCovariance & pose_covariance)
@@ -48,12 +45,9 @@ Eigen::Matrix2d getXYCovariance(const geometry_msgs::msg::PoseWithCovariance & p
 }
 
 double getFormedYawAngle(
-  const geometry_msgs::msg::Quaternion & measurement_quat,
-  const geometry_msgs::msg::Quaternion & tracker_quat, const bool distinguish_front_or_back = true)
+  const double measurement_yaw, const double tracker_yaw,
+  const bool distinguish_front_or_back = true)
 {
-  const double measurement_yaw =
-    tier4_autoware_utils::normalizeRadian(tf2::getYaw(measurement_quat));
-  const double tracker_yaw = tier4_autoware_utils::normalizeRadian(tf2::getYaw(tracker_quat));
   const double angle_range = distinguish_front_or_back ? M_PI : M_PI_2;
   const double angle_step = distinguish_front_or_back ? 2.0 * M_PI : M_PI;
   // Fixed measurement_yaw to be in the range of +-90 or 180 degrees of X_t(IDX::YAW)
@@ -66,6 +60,43 @@ double getFormedYawAngle(
   }
   return std::fabs(measurement_fixed_yaw - tracker_yaw);
 }
+
+// tracker states at the measurement time, predicted once per cycle
+struct TrackerStates
+{
+  std::vector<autoware_auto_perception_msgs::msg::TrackedObject> objects;
+  std::vector<std::uint8_t> labels;
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<double> yaw;
+  std::vector<Eigen::Matrix2d, Eigen::aligned_allocator<Eigen::Matrix2d>> covariance_inverse;
+};
+
+TrackerStates getTrackerStates(
+  const std::vector<std::shared_ptr<Tracker>> & trackers, const rclcpp::Time & time)
+{
+  TrackerStates states;
+  states.objects.resize(trackers.size());
+  states.labels.resize(trackers.size());
+  states.x.resize(trackers.size());
+  states.y.resize(trackers.size());
+  states.yaw.resize(trackers.size());
+  states.covariance_inverse.resize(trackers.size());
+#pragma omp parallel for
+  for (size_t tracker_idx = 0; tracker_idx < trackers.size(); ++tracker_idx) {
+    auto & object = states.objects.at(tracker_idx);
+    trackers.at(tracker_idx)->getTrackedObject(time, object);
+    const auto & pose_with_covariance = object.kinematics.pose_with_covariance;
+    states.labels.at(tracker_idx) = trackers.at(tracker_idx)->getHighestProbLabel();
+    states.x.at(tracker_idx) = pose_with_covariance.pose.position.x;
+    states.y.at(tracker_idx) = pose_with_covariance.pose.position.y;
+    states.yaw.at(tracker_idx) =
+      tier4_autoware_utils::normalizeRadian(tf2::getYaw(pose_with_covariance.pose.orientation));
+    states.covariance_inverse.at(tracker_idx) = getXYCovariance(pose_with_covariance).inverse();
+  }
+  return states;
+}
+
 }  // namespace
 
 DataAssociation::DataAssociation(
@@ -111,6 +142,10 @@ DataAssociation::DataAssociation(
     min_iou_matrix_ = min_iou_matrix_tmp.transpose();
   }
 
+  // the measurements are gated in a grid of the largest max_dist
+  gate_cell_size_ = max_dist_matrix_.size() > 0 ? max_dist_matrix_.maxCoeff() : 0.0;
+  if (gate_cell_size_ <= 0.0) gate_cell_size_ = 1.0;
+
   gnn_solver_ptr_ = std::make_unique<gnn_solver::MuSSP>();
 }
 
@@ -118,106 +153,107 @@ void DataAssociation::assign(
   const Eigen::MatrixXd & src, std::unordered_map<int, int> & direct_assignment,
   std::unordered_map<int, int> & reverse_assignment)
 {
-  std::vector<std::vector<double>> score(src.rows());
+  // Only the pairs above the threshold enter the graph, so every assignment is kept
+  gnn_solver::SparseScore score;
+  score.cols = src.cols();
   for (int row = 0; row < src.rows(); ++row) {
-    score.at(row).resize(src.cols());
     for (int col = 0; col < src.cols(); ++col) {
-      score.at(row).at(col) = src(row, col);
+      if (score_threshold_ <= src(row, col)) {
+        score.addEntry(col, src(row, col));
+      }
     }
+    score.finishRow();
   }
   // Solve
   gnn_solver_ptr_->maximizeLinearAssignment(score, &direct_assignment, &reverse_assignment);
-
-  for (auto itr = direct_assignment.begin(); itr != direct_assignment.end();) {
-    if (src(itr->first, itr->second) < score_threshold_) {
-      itr = direct_assignment.erase(itr);
-      continue;
-    } else {
-      ++itr;
-    }
-  }
-  for (auto itr = reverse_assignment.begin(); itr != reverse_assignment.end();) {
-    if (src(itr->second, itr->first) < score_threshold_) {
-      itr = reverse_assignment.erase(itr);
-      continue;
-    } else {
-      ++itr;
-    }
-  }
 }
 
 Eigen::MatrixXd DataAssociation::calcScoreMatrix(
   const autoware_auto_perception_msgs::msg::DetectedObjects & measurements,
-  const std::list<std::shared_ptr<Tracker>> & trackers)
+  const std::vector<std::shared_ptr<Tracker>> & trackers)
 {
   Eigen::MatrixXd score_matrix =
     Eigen::MatrixXd::Zero(trackers.size(), measurements.objects.size());
-  size_t tracker_idx = 0;
-  for (auto tracker_itr = trackers.begin(); tracker_itr != trackers.end();
-       ++tracker_itr, ++tracker_idx) {
-    const std::uint8_t tracker_label = (*tracker_itr)->getHighestProbLabel();
+  if (trackers.empty() || measurements.objects.empty()) {
+    return score_matrix;
+  }
 
-    for (size_t measurement_idx = 0; measurement_idx < measurements.objects.size();
-         ++measurement_idx) {
+  const TrackerStates trackers_states = getTrackerStates(trackers, measurements.header.stamp);
+  std::vector<std::uint8_t> measurement_labels;
+  std::vector<double> measurement_areas;
+  std::vector<double> measurement_yaws;
+  measurement_labels.reserve(measurements.objects.size());
+  measurement_areas.reserve(measurements.objects.size());
+  measurement_yaws.reserve(measurements.objects.size());
+  for (const auto & measurement_object : measurements.objects) {
+    measurement_labels.push_back(
+      perception_utils::getHighestProbLabel(measurement_object.classification));
+    measurement_areas.push_back(tier4_autoware_utils::getArea(measurement_object.shape));
+    measurement_yaws.push_back(tier4_autoware_utils::normalizeRadian(
+      tf2::getYaw(measurement_object.kinematics.pose_with_covariance.pose.orientation)));
+  }
+  // pairs farther than max_dist get no score, only the neighboring cells are scored
+  utils::XYGrid measurement_grid(gate_cell_size_);
+  for (size_t measurement_idx = 0; measurement_idx < measurements.objects.size();
+       ++measurement_idx) {
+    const auto & position =
+      measurements.objects.at(measurement_idx).kinematics.pose_with_covariance.pose.position;
+    measurement_grid.add(position.x, position.y, measurement_idx);
+  }
+
+  for (size_t tracker_idx = 0; tracker_idx < trackers.size(); ++tracker_idx) {
+    const std::uint8_t tracker_label = trackers_states.labels.at(tracker_idx);
+    const double tracker_x = trackers_states.x.at(tracker_idx);
+    const double tracker_y = trackers_states.y.at(tracker_idx);
+
+    measurement_grid.forEachNeighbor(tracker_x, tracker_y, [&](const size_t measurement_idx) {
       const autoware_auto_perception_msgs::msg::DetectedObject & measurement_object =
         measurements.objects.at(measurement_idx);
-      const std::uint8_t measurement_label =
-        perception_utils::getHighestProbLabel(measurement_object.classification);
-
-      double score = 0.0;
-      if (can_assign_matrix_(tracker_label, measurement_label)) {
-        autoware_auto_perception_msgs::msg::TrackedObject tracked_object;
-        (*tracker_itr)->getTrackedObject(measurements.header.stamp, tracked_object);
-
-        const double max_dist = max_dist_matrix_(tracker_label, measurement_label);
-        const double dist = tier4_autoware_utils::calcDistance2d(
-          measurement_object.kinematics.pose_with_covariance.pose.position,
-          tracked_object.kinematics.pose_with_covariance.pose.position);
-
-        bool passed_gate = true;
-        // dist gate
-        if (passed_gate) {
-          if (max_dist < dist) passed_gate = false;
-        }
-        // area gate
-        if (passed_gate) {
-          const double max_area = max_area_matrix_(tracker_label, measurement_label);
-          const double min_area = min_area_matrix_(tracker_label, measurement_label);
-          const double area = tier4_autoware_utils::getArea(measurement_object.shape);
-          if (area < min_area || max_area < area) passed_gate = false;
-        }
-        // angle gate
-        if (passed_gate) {
-          const double max_rad = max_rad_matrix_(tracker_label, measurement_label);
-          const double angle = getFormedYawAngle(
-            measurement_object.kinematics.pose_with_covariance.pose.orientation,
-            tracked_object.kinematics.pose_with_covariance.pose.orientation, false);
-          if (std::fabs(max_rad) < M_PI && std::fabs(max_rad) < std::fabs(angle))
-            passed_gate = false;
-        }
-        // mahalanobis dist gate
-        if (passed_gate) {
-          const double mahalanobis_dist = getMahalanobisDistance(
-            measurement_object.kinematics.pose_with_covariance.pose.position,
-            tracked_object.kinematics.pose_with_covariance.pose.position,
-            getXYCovariance(tracked_object.kinematics.pose_with_covariance));
-          if (2.448 /*95%*/ <= mahalanobis_dist) passed_gate = false;
-        }
-        // 2d iou gate
-        if (passed_gate) {
-          const double min_iou = min_iou_matrix_(tracker_label, measurement_label);
-          const double iou = perception_utils::get2dIoU(measurement_object, tracked_object);
-          if (iou < min_iou) passed_gate = false;
-        }
-
-        // all gate is passed
-        if (passed_gate) {
-          score = (max_dist - std::min(dist, max_dist)) / max_dist;
-          if (score < score_threshold_) score = 0.0;
-        }
+      const std::uint8_t measurement_label = measurement_labels.at(measurement_idx);
+      if (!can_assign_matrix_(tracker_label, measurement_label)) return;
+
+      const auto & measurement_position =
+        measurement_object.kinematics.pose_with_covariance.pose.position;
+      const double max_dist = max_dist_matrix_(tracker_label, measurement_label);
+      const double dist =
+        std::hypot(measurement_position.x - tracker_x, measurement_position.y - tracker_y);
+
+      // dist gate
+      if (max_dist < dist) return;
+      // area gate
+      {
+        const double max_area = max_area_matrix_(tracker_label, measurement_label);
+        const double min_area = min_area_matrix_(tracker_label, measurement_label);
+        const double area = measurement_areas.at(measurement_idx);
+        if (area < min_area || max_area < area) return;
+      }
+      // angle gate
+      {
+        const double max_rad = max_rad_matrix_(tracker_label, measurement_label);
+        const double angle = getFormedYawAngle(
+          measurement_yaws.at(measurement_idx), trackers_states.yaw.at(tracker_idx), false);
+        if (std::fabs(max_rad) < M_PI && std::fabs(max_rad) < std::fabs(angle)) return;
+      }
+      // mahalanobis dist gate
+      {
+        const double mahalanobis_dist = getMahalanobisDistance(
+          measurement_position, tracker_x, tracker_y,
+          trackers_states.covariance_inverse.at(tracker_idx));
+        if (2.448 /*95%*/ <= mahalanobis_dist) return;
       }
+      // 2d iou gate
+      {
+        const double min_iou = min_iou_matrix_(tracker_label, measurement_label);
+        const double iou =
+          perception_utils::get2dIoU(measurement_object, trackers_states.objects.at(tracker_idx));
+        if (iou < min_iou) return;
+      }
+
+      // all gate is passed
+      double score = (max_dist - std::min(dist, max_dist)) / max_dist;
+      if (score < score_threshold_) score = 0.0;
       score_matrix(tracker_idx, measurement_idx) = score;
-    }
+    });
   }
 
   return score_matrix;
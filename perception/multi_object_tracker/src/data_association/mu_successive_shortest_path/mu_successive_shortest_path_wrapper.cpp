@@ -16,12 +16,15 @@
 
 #include <mussp/mussp.h>
 
+#include <algorithm>
 #include <array>
+#include <numeric>
 #include <cassert>
 #include <fstream>
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace gnn_solver
@@ -38,4 +41,77 @@ void MuSSP::maximizeLinearAssignment(
   // Solve DA by muSSP
   solve_muSSP(cost, direct_assignment, reverse_assignment);
 }
+
+void MuSSP::maximizeLinearAssignment(
+  const SparseScore & score, std::unordered_map<int, int> * direct_assignment,
+  std::unordered_map<int, int> * reverse_assignment)
+{
+  // Terminate if the graph is empty
+  if (score.rows == 0 || score.cols == 0 || score.values.empty()) {
+    return;
+  }
+
+  // The assignment is independent between the connected components of the bipartite graph of the
+  // entries, nodes [0, rows) being the rows and [rows, rows + cols) the columns.
+  std::vector<int> parents(score.rows + score.cols);
+  std::iota(parents.begin(), parents.end(), 0);
+  const auto find_root = [&parents](int node) {
+    while (parents.at(node) != node) {
+      parents.at(node) = parents.at(parents.at(node));
+      node = parents.at(node);
+    }
+    return node;
+  };
+  for (int row = 0; row < score.rows; ++row) {
+    for (int i = score.row_offsets.at(row); i < score.row_offsets.at(row + 1); ++i) {
+      const int root_row = find_root(row);
+      const int root_col = find_root(score.rows + score.col_indices.at(i));
+      if (root_row != root_col) {
+        parents.at(std::max(root_row, root_col)) = std::min(root_row, root_col);
+      }
+    }
+  }
+
+  // Rows and columns of every component, indexed by the root
+  std::unordered_map<int, std::pair<std::vector<int>, std::vector<int>>> components;
+  for (int row = 0; row < score.rows; ++row) {
+    if (score.row_offsets.at(row) != score.row_offsets.at(row + 1)) {
+      components[find_root(row)].first.push_back(row);
+    }
+  }
+  for (int col = 0; col < score.cols; ++col) {
+    const int root = find_root(score.rows + col);
+    const auto itr = components.find(root);
+    if (itr != components.end()) {
+      itr->second.second.push_back(col);
+    }
+  }
+
+  // Solve DA by muSSP on the dense score of every component
+  std::vector<int> local_cols(score.cols);
+  for (const auto & [root, component] : components) {
+    const auto & [rows, cols] = component;
+    if (rows.size() == 1 && cols.size() == 1) {
+      (*direct_assignment)[rows.front()] = cols.front();
+      (*reverse_assignment)[cols.front()] = rows.front();
+      continue;
+    }
+    for (size_t local_col = 0; local_col < cols.size(); ++local_col) {
+      local_cols.at(cols.at(local_col)) = local_col;
+    }
+    std::vector<std::vector<double>> cost(rows.size(), std::vector<double>(cols.size(), 0.0));
+    for (size_t local_row = 0; local_row < rows.size(); ++local_row) {
+      const int row = rows.at(local_row);
+      for (int i = score.row_offsets.at(row); i < score.row_offsets.at(row + 1); ++i) {
+        cost.at(local_row).at(local_cols.at(score.col_indices.at(i))) = score.values.at(i);
+      }
+    }
+    std::unordered_map<int, int> local_direct_assignment, local_reverse_assignment;
+    solve_muSSP(cost, &local_direct_assignment, &local_reverse_assignment);
+    for (const auto & [local_row, local_col] : local_direct_assignment) {
+      (*direct_assignment)[rows.at(local_row)] = cols.at(local_col);
+      (*reverse_assignment)[cols.at(local_col)] = rows.at(local_row);
+    }
+  }
+}
 }  // namespace gnn_solver
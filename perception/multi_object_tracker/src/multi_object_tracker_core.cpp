@@ -19,8 +19,7 @@
 #include <tf2_ros/create_timer_interface.h>
 #include <tf2_ros/create_timer_ros.h>
 
-#include <iterator>
-#include <list>
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -201,8 +200,9 @@ void MultiObjectTracker::onMeasurement(
   }
   /* tracker prediction */
   rclcpp::Time measurement_time = input_objects_msg->header.stamp;
-  for (auto itr = list_tracker_.begin(); itr != list_tracker_.end(); ++itr) {
-    (*itr)->predict(measurement_time);
+#pragma omp parallel for
+  for (size_t i = 0; i < list_tracker_.size(); ++i) {
+    list_tracker_.at(i)->predict(measurement_time);
   }
 
   /* global nearest neighbor */
@@ -212,16 +212,14 @@ void MultiObjectTracker::onMeasurement(
   data_association_->assign(score_matrix, direct_assignment, reverse_assignment);
 
   /* tracker measurement update */
-  int tracker_idx = 0;
-  for (auto tracker_itr = list_tracker_.begin(); tracker_itr != list_tracker_.end();
-       ++tracker_itr, ++tracker_idx) {
+  for (size_t tracker_idx = 0; tracker_idx < list_tracker_.size(); ++tracker_idx) {
+    const auto & tracker = list_tracker_.at(tracker_idx);
     if (direct_assignment.find(tracker_idx) != direct_assignment.end()) {  // found
-      (*(tracker_itr))
-        ->updateWithMeasurement(
-          transformed_objects.objects.at(direct_assignment.find(tracker_idx)->second),
-          measurement_time);
+      tracker->updateWithMeasurement(
+        transformed_objects.objects.at(direct_assignment.find(tracker_idx)->second),
+        measurement_time);
     } else {  // not found
-      (*(tracker_itr))->updateWithoutMeasurement();
+      tracker->updateWithoutMeasurement();
     }
   }
 
@@ -291,49 +289,72 @@ void MultiObjectTracker::onTimer()
 }
 
 void MultiObjectTracker::checkTrackerLifeCycle(
-  std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time,
+  std::vector<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time,
   const geometry_msgs::msg::Transform & self_transform)
 {
   /* params */
   constexpr float max_elapsed_time = 1.0;
 
   /* delete tracker */
-  for (auto itr = list_tracker.begin(); itr != list_tracker.end(); ++itr) {
-    const bool is_old = max_elapsed_time < (*itr)->getElapsedTimeFromLastUpdate(time);
-    const bool is_specific_alive_pattern = isSpecificAlivePattern(*itr, time, self_transform);
-    if (is_old && !is_specific_alive_pattern) {
-      auto erase_itr = itr;
-      --itr;
-      list_tracker.erase(erase_itr);
-    }
-  }
+  const auto should_delete = [&](const std::shared_ptr<Tracker> & tracker) {
+    const bool is_old = max_elapsed_time < tracker->getElapsedTimeFromLastUpdate(time);
+    return is_old && !isSpecificAlivePattern(tracker, time, self_transform);
+  };
+  list_tracker.erase(
+    std::remove_if(list_tracker.begin(), list_tracker.end(), should_delete), list_tracker.end());
 }
 
 void MultiObjectTracker::sanitizeTracker(
-  std::list<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time)
+  std::vector<std::shared_ptr<Tracker>> & list_tracker, const rclcpp::Time & time)
 {
   constexpr float min_iou = 0.1;
   constexpr float min_iou_for_unknown_object = 0.001;
   constexpr double distance_threshold = 5.0;
+
+  std::vector<autoware_auto_perception_msgs::msg::TrackedObject> objects(list_tracker.size());
+#pragma omp parallel for
+  for (size_t i = 0; i < list_tracker.size(); ++i) {
+    list_tracker.at(i)->getTrackedObject(time, objects.at(i));
+  }
+  // only the trackers in the neighboring cells can be within distance_threshold
+  utils::XYGrid grid(distance_threshold);
+  for (size_t i = 0; i < objects.size(); ++i) {
+    const auto & position = getPose(objects.at(i)).position;
+    grid.add(position.x, position.y, i);
+  }
+
   /* delete collision tracker */
-  for (auto itr1 = list_tracker.begin(); itr1 != list_tracker.end(); ++itr1) {
-    autoware_auto_perception_msgs::msg::TrackedObject object1;
-    (*itr1)->getTrackedObject(time, object1);
-    for (auto itr2 = std::next(itr1); itr2 != list_tracker.end(); ++itr2) {
-      autoware_auto_perception_msgs::msg::TrackedObject object2;
-      (*itr2)->getTrackedObject(time, object2);
-      const double distance = std::hypot(
-        object1.kinematics.pose_with_covariance.pose.position.x -
-          object2.kinematics.pose_with_covariance.pose.position.x,
-        object1.kinematics.pose_with_covariance.pose.position.y -
-          object2.kinematics.pose_with_covariance.pose.position.y);
+  std::vector<bool> is_deleted(list_tracker.size(), false);
+  std::vector<size_t> neighbors;
+  for (size_t i1 = 0; i1 < list_tracker.size(); ++i1) {
+    if (is_deleted.at(i1)) {
+      continue;
+    }
+    const auto & object1 = objects.at(i1);
+    const auto & position1 = getPose(object1).position;
+    // the pairs are visited in the order of the trackers
+    neighbors.clear();
+    grid.forEachNeighbor(position1.x, position1.y, [&](const size_t i2) {
+      if (i1 < i2) neighbors.push_back(i2);
+    });
+    std::sort(neighbors.begin(), neighbors.end());
+
+    const auto & tracker1 = list_tracker.at(i1);
+    for (const size_t i2 : neighbors) {
+      if (is_deleted.at(i2)) {
+        continue;
+      }
+      const auto & object2 = objects.at(i2);
+      const auto & position2 = getPose(object2).position;
+      const double distance = std::hypot(position1.x - position2.x, position1.y - position2.y);
       if (distance_threshold < distance) {
         continue;
       }
 
+      const auto & tracker2 = list_tracker.at(i2);
       const auto iou = perception_utils::get2dIoU(object1, object2);
-      const auto & label1 = (*itr1)->getHighestProbLabel();
-      const auto & label2 = (*itr2)->getHighestProbLabel();
+      const auto & label1 = tracker1->getHighestProbLabel();
+      const auto & label2 = tracker2->getHighestProbLabel();
       bool should_delete_tracker1 = false;
       bool should_delete_tracker2 = false;
 
@@ -342,7 +363,7 @@ void MultiObjectTracker::sanitizeTracker(
       if (label1 == Label::UNKNOWN || label2 == Label::UNKNOWN) {
         if (min_iou_for_unknown_object < iou) {
           if (label1 == Label::UNKNOWN && label2 == Label::UNKNOWN) {
-            if ((*itr1)->getTotalMeasurementCount() < (*itr2)->getTotalMeasurementCount()) {
+            if (tracker1->getTotalMeasurementCount() < tracker2->getTotalMeasurementCount()) {
               should_delete_tracker1 = true;
             } else {
               should_delete_tracker2 = true;
@@ -355,7 +376,7 @@ void MultiObjectTracker::sanitizeTracker(
         }
       } else {  // If neither is UNKNOWN, delete the one with lower IOU.
         if (min_iou < iou) {
-          if ((*itr1)->getTotalMeasurementCount() < (*itr2)->getTotalMeasurementCount()) {
+          if (tracker1->getTotalMeasurementCount() < tracker2->getTotalMeasurementCount()) {
             should_delete_tracker1 = true;
           } else {
             should_delete_tracker2 = true;
@@ -364,15 +385,21 @@ void MultiObjectTracker::sanitizeTracker(
       }
 
       if (should_delete_tracker1) {
-        itr1 = list_tracker.erase(itr1);
-        --itr1;
+        is_deleted.at(i1) = true;
         break;
       } else if (should_delete_tracker2) {
-        itr2 = list_tracker.erase(itr2);
-        --itr2;
+        is_deleted.at(i2) = true;
       }
     }
   }
+
+  size_t tracker_num = 0;
+  for (size_t i = 0; i < list_tracker.size(); ++i) {
+    if (!is_deleted.at(i)) {
+      list_tracker.at(tracker_num++) = std::move(list_tracker.at(i));
+    }
+  }
+  list_tracker.resize(tracker_num);
 }
 
 inline bool MultiObjectTracker::shouldTrackerPublish(
@@ -396,12 +423,12 @@ void MultiObjectTracker::publish(const rclcpp::Time & time) const
   autoware_auto_perception_msgs::msg::TrackedObjects output_msg;
   output_msg.header.frame_id = world_frame_id_;
   output_msg.header.stamp = time;
-  for (auto itr = list_tracker_.begin(); itr != list_tracker_.end(); ++itr) {
-    if (!shouldTrackerPublish(*itr)) {
+  for (const auto & tracker : list_tracker_) {
+    if (!shouldTrackerPublish(tracker)) {
       continue;
     }
     autoware_auto_perception_msgs::msg::TrackedObject object;
-    (*itr)->getTrackedObject(time, object);
+    tracker->getTrackedObject(time, object);
     output_msg.objects.push_back(object);
   }
 
@@ -80,7 +80,7 @@ PedestrianTracker::PedestrianTracker(
   max_wz_ = tier4_autoware_utils::deg2rad(30);   // [rad/s]
 
   // initialize X matrix
-  Eigen::MatrixXd X(ekf_params_.dim_x, 1);
+  EKF::StateVector X;
   X(IDX::X) = object.kinematics.pose_with_covariance.pose.position.x;
   X(IDX::Y) = object.kinematics.pose_with_covariance.pose.position.y;
   X(IDX::YAW) = tf2::getYaw(object.kinematics.pose_with_covariance.pose.orientation);
@@ -93,7 +93,7 @@ PedestrianTracker::PedestrianTracker(
   }
 
   // initialize P matrix
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(ekf_params_.dim_x, ekf_params_.dim_x);
+  EKF::StateMatrix P = EKF::StateMatrix::Zero();
   if (!object.kinematics.has_position_covariance) {
     const double cos_yaw = std::cos(X(IDX::YAW));
     const double sin_yaw = std::sin(X(IDX::YAW));
@@ -149,7 +149,7 @@ bool PedestrianTracker::predict(const rclcpp::Time & time)
   return ret;
 }
 
-bool PedestrianTracker::predict(const double dt, KalmanFilter & ekf) const
+bool PedestrianTracker::predict(const double dt, EKF & ekf) const
 {
   /*  == Nonlinear model ==
    *
@@ -171,14 +171,14 @@ bool PedestrianTracker::predict(const double dt, KalmanFilter & ekf) const
    */
 
   // X t
-  Eigen::MatrixXd X_t(ekf_params_.dim_x, 1);  // predicted state
+  EKF::StateVector X_t;  // predicted state
   ekf.getX(X_t);
   const double cos_yaw = std::cos(X_t(IDX::YAW));
   const double sin_yaw = std::sin(X_t(IDX::YAW));
   const double sin_2yaw = std::sin(2.0f * X_t(IDX::YAW));
 
   // X t+1
-  Eigen::MatrixXd X_next_t(ekf_params_.dim_x, 1);                // predicted state
+  EKF::StateVector X_next_t;                                     // predicted state
   X_next_t(IDX::X) = X_t(IDX::X) + X_t(IDX::VX) * cos_yaw * dt;  // dx = v * cos(yaw)
   X_next_t(IDX::Y) = X_t(IDX::Y) + X_t(IDX::VX) * sin_yaw * dt;  // dy = v * sin(yaw)
   X_next_t(IDX::YAW) = X_t(IDX::YAW) + (X_t(IDX::WZ)) * dt;      // dyaw = omega
@@ -186,7 +186,7 @@ bool PedestrianTracker::predict(const double dt, KalmanFilter & ekf) const
   X_next_t(IDX::WZ) = X_t(IDX::WZ);
 
   // A
-  Eigen::MatrixXd A = Eigen::MatrixXd::Identity(ekf_params_.dim_x, ekf_params_.dim_x);
+  EKF::StateMatrix A = EKF::StateMatrix::Identity();
   A(IDX::X, IDX::YAW) = -X_t(IDX::VX) * sin_yaw * dt;
   A(IDX::X, IDX::VX) = cos_yaw * dt;
   A(IDX::Y, IDX::YAW) = X_t(IDX::VX) * cos_yaw * dt;
@@ -194,7 +194,7 @@ bool PedestrianTracker::predict(const double dt, KalmanFilter & ekf) const
   A(IDX::YAW, IDX::WZ) = dt;
 
   // Q
-  Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(ekf_params_.dim_x, ekf_params_.dim_x);
+  EKF::StateMatrix Q = EKF::StateMatrix::Zero();
   // Rotate the covariance matrix according to the vehicle yaw
   // because q_cov_x and y are in the vehicle coordinate system.
   Q(IDX::X, IDX::X) =
@@ -206,8 +206,6 @@ bool PedestrianTracker::predict(const double dt, KalmanFilter & ekf) const
   Q(IDX::YAW, IDX::YAW) = ekf_params_.q_cov_yaw * dt * dt;
   Q(IDX::VX, IDX::VX) = ekf_params_.q_cov_vx * dt * dt;
   Q(IDX::WZ, IDX::WZ) = ekf_params_.q_cov_wz * dt * dt;
-  Eigen::MatrixXd B = Eigen::MatrixXd::Zero(ekf_params_.dim_x, ekf_params_.dim_x);
-  Eigen::MatrixXd u = Eigen::MatrixXd::Zero(ekf_params_.dim_x, 1);
 
   if (!ekf.predict(X_next_t, A, Q)) {
     RCLCPP_WARN(logger_, "Cannot predict");
@@ -223,7 +221,7 @@ bool PedestrianTracker::measureWithPose(
   // double measurement_yaw =
   //   tier4_autoware_utils::normalizeRadian(tf2::getYaw(object.state.pose_covariance.pose.orientation));
   // {
-  //   Eigen::MatrixXd X_t(ekf_params_.dim_x, 1);
+  //   EKF::StateVector X_t;
   //   ekf_.getX(X_t);
   //   while (M_PI_2 <= X_t(IDX::YAW) - measurement_yaw) {
   //     measurement_yaw = measurement_yaw + M_PI;
@@ -238,18 +236,18 @@ bool PedestrianTracker::measureWithPose(
   // }
 
   /* Set measurement matrix */
-  Eigen::MatrixXd Y(dim_y, 1);
+  EKF::MeasurementVector Y(dim_y);
   Y << object.kinematics.pose_with_covariance.pose.position.x,
     object.kinematics.pose_with_covariance.pose.position.y;
 
   /* Set measurement matrix */
-  Eigen::MatrixXd C = Eigen::MatrixXd::Zero(dim_y, ekf_params_.dim_x);
+  EKF::MeasurementMatrix C = EKF::MeasurementMatrix::Zero(dim_y, EKF::dim_x);
   C(0, IDX::X) = 1.0;  // for pos x
   C(1, IDX::Y) = 1.0;  // for pos y
   // C(2, IDX::YAW) = 1.0;  // for yaw
 
   /* Set measurement noise covariance */
-  Eigen::MatrixXd R = Eigen::MatrixXd::Zero(dim_y, dim_y);
+  EKF::MeasurementCovariance R = EKF::MeasurementCovariance::Zero(dim_y, dim_y);
   if (!object.kinematics.has_position_covariance) {
     R(0, 0) = ekf_params_.r_cov_x;  // x - x
     R(0, 1) = 0.0;                  // x - y
@@ -273,8 +271,8 @@ bool PedestrianTracker::measureWithPose(
 
   // normalize yaw and limit vx, wz
   {
-    Eigen::MatrixXd X_t(ekf_params_.dim_x, 1);
-    Eigen::MatrixXd P_t(ekf_params_.dim_x, ekf_params_.dim_x);
+    EKF::StateVector X_t;
+    EKF::StateMatrix P_t;
     ekf_.getX(X_t);
     ekf_.getP(P_t);
     X_t(IDX::YAW) = tier4_autoware_utils::normalizeRadian(X_t(IDX::YAW));
@@ -341,13 +339,13 @@ bool PedestrianTracker::getTrackedObject(
   object.classification = getClassification();
 
   // predict kinematics
-  KalmanFilter tmp_ekf_for_no_update = ekf_;
+  EKF tmp_ekf_for_no_update = ekf_;
   const double dt = (time - last_update_time_).seconds();
   if (0.001 /*1msec*/ < dt) {
     predict(dt, tmp_ekf_for_no_update);
   }
-  Eigen::MatrixXd X_t(ekf_params_.dim_x, 1);                // predicted state
-  Eigen::MatrixXd P(ekf_params_.dim_x, ekf_params_.dim_x);  // predicted state
+  EKF::StateVector X_t;  // predicted state
+  EKF::StateMatrix P;    // predicted state
   tmp_ekf_for_no_update.getX(X_t);
   tmp_ekf_for_no_update.getP(P);
 
@@ -66,7 +66,7 @@ UnknownTracker::UnknownTracker(
   max_vy_ = tier4_autoware_utils::kmph2mps(60);  // [m/s]
 
   // initialize X matrix
-  Eigen::MatrixXd X(ekf_params_.dim_x, 1);
+  EKF::StateVector X;
   X(IDX::X) = object.kinematics.pose_with_covariance.pose.position.x;
   X(IDX::Y) = object.kinematics.pose_with_covariance.pose.position.y;
   if (object.kinematics.has_twist) {
@@ -78,7 +78,7 @@ UnknownTracker::UnknownTracker(
   }
 
   // initialize P matrix
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(ekf_params_.dim_x, ekf_params_.dim_x);
+  EKF::StateMatrix P = EKF::StateMatrix::Zero();
   if (!object.kinematics.has_position_covariance) {
     // Rotate the covariance matrix according to the vehicle yaw
     // because p0_cov_x and y are in the vehicle coordinate system.
@@ -117,7 +117,7 @@ bool UnknownTracker::predict(const rclcpp::Time & time)
   return ret;
 }
 
-bool UnknownTracker::predict(const double dt, KalmanFilter & ekf) const
+bool UnknownTracker::predict(const double dt, EKF & ekf) const
 {
   /*  == Nonlinear model ==
    *
@@ -137,23 +137,23 @@ bool UnknownTracker::predict(const double dt, KalmanFilter & ekf) const
    */
 
   // X t
-  Eigen::MatrixXd X_t(ekf_params_.dim_x, 1);  // predicted state
+  EKF::StateVector X_t;  // predicted state
   ekf.getX(X_t);
 
   // X t+1
-  Eigen::MatrixXd X_next_t(ekf_params_.dim_x, 1);  // predicted state
+  EKF::StateVector X_next_t;  // predicted state
   X_next_t(IDX::X) = X_t(IDX::X) + X_t(IDX::VX) * dt;
   X_next_t(IDX::Y) = X_t(IDX::Y) + X_t(IDX::VY) * dt;
   X_next_t(IDX::VX) = X_t(IDX::VX);
   X_next_t(IDX::VY) = X_t(IDX::VY);
 
   // A
-  Eigen::MatrixXd A = Eigen::MatrixXd::Identity(ekf_params_.dim_x, ekf_params_.dim_x);
+  EKF::StateMatrix A = EKF::StateMatrix::Identity();
   A(IDX::X, IDX::VX) = dt;
   A(IDX::Y, IDX::VY) = dt;
 
   // Q
-  Eigen::MatrixXd Q = Eigen::MatrixXd::Zero(ekf_params_.dim_x, ekf_params_.dim_x);
+  EKF::StateMatrix Q = EKF::StateMatrix::Zero();
   // Rotate the covariance matrix according to the vehicle yaw
   // because q_cov_x and y are in the vehicle coordinate system.
   Q(IDX::X, IDX::X) = ekf_params_.q_cov_x * dt * dt;
@@ -162,8 +162,6 @@ bool UnknownTracker::predict(const double dt, KalmanFilter & ekf) const
   Q(IDX::Y, IDX::X) = Q(IDX::X, IDX::Y);
   Q(IDX::VX, IDX::VX) = ekf_params_.q_cov_vx * dt * dt;
   Q(IDX::VY, IDX::VY) = ekf_params_.q_cov_vy * dt * dt;
-  Eigen::MatrixXd B = Eigen::MatrixXd::Zero(ekf_params_.dim_x, ekf_params_.dim_x);
-  Eigen::MatrixXd u = Eigen::MatrixXd::Zero(ekf_params_.dim_x, 1);
 
   if (!ekf.predict(X_next_t, A, Q)) {
     RCLCPP_WARN(logger_, "Pedestrian : Cannot predict");
@@ -178,17 +176,17 @@ bool UnknownTracker::measureWithPose(
   constexpr int dim_y = 2;  // pos x, pos y depending on Pose output
 
   /* Set measurement matrix */
-  Eigen::MatrixXd Y(dim_y, 1);
+  EKF::MeasurementVector Y(dim_y);
   Y << object.kinematics.pose_with_covariance.pose.position.x,
     object.kinematics.pose_with_covariance.pose.position.y;
 
   /* Set measurement matrix */
-  Eigen::MatrixXd C = Eigen::MatrixXd::Zero(dim_y, ekf_params_.dim_x);
+  EKF::MeasurementMatrix C = EKF::MeasurementMatrix::Zero(dim_y, EKF::dim_x);
   C(0, IDX::X) = 1.0;  // for pos x
   C(1, IDX::Y) = 1.0;  // for pos y
 
   /* Set measurement noise covariance */
-  Eigen::MatrixXd R = Eigen::MatrixXd::Zero(dim_y, dim_y);
+  EKF::MeasurementCovariance R = EKF::MeasurementCovariance::Zero(dim_y, dim_y);
   if (!object.kinematics.has_position_covariance) {
     R(0, 0) = ekf_params_.r_cov_x;  // x - x
     R(0, 1) = 0.0;                  // x - y
@@ -206,8 +204,8 @@ bool UnknownTracker::measureWithPose(
 
   // limit vx, vy
   {
-    Eigen::MatrixXd X_t(ekf_params_.dim_x, 1);
-    Eigen::MatrixXd P_t(ekf_params_.dim_x, ekf_params_.dim_x);
+    EKF::StateVector X_t;
+    EKF::StateMatrix P_t;
     ekf_.getX(X_t);
     ekf_.getP(P_t);
     if (!(-max_vx_ <= X_t(IDX::VX) && X_t(IDX::VX) <= max_vx_)) {
@@ -251,13 +249,13 @@ bool UnknownTracker::getTrackedObject(
   object.classification = getClassification();
 
   // predict kinematics
-  KalmanFilter tmp_ekf_for_no_update = ekf_;
+  EKF tmp_ekf_for_no_update = ekf_;
   const double dt = (time - last_update_time_).seconds();
   if (0.001 /*1msec*/ < dt) {
     predict(dt, tmp_ekf_for_no_update);
   }
-  Eigen::MatrixXd X_t(ekf_params_.dim_x, 1);                // predicted state
-  Eigen::MatrixXd P(ekf_params_.dim_x, ekf_params_.dim_x);  // predicted state
+  EKF::StateVector X_t;  // predicted state
+  EKF::StateMatrix P;    // predicted state
   tmp_ekf_for_no_update.getX(X_t);
   tmp_ekf_for_no_update.getP(P);
 
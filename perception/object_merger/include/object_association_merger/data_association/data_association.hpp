@@ -40,6 +40,7 @@ private:
   Eigen::MatrixXd max_rad_matrix_;
   Eigen::MatrixXd min_iou_matrix_;
   const double score_threshold_;
+  double gate_cell_size_;
   std::unique_ptr<gnn_solver::GnnSolverInterface> gnn_solver_ptr_;
 
 public:
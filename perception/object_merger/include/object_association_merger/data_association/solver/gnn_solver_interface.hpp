@@ -20,6 +20,28 @@
 
 namespace gnn_solver
 {
+// score matrix in compressed sparse row format, the missing entries can not be assigned
+struct SparseScore
+{
+  int rows{0};
+  int cols{0};
+  // the entries of row r are [row_offsets[r], row_offsets[r + 1])
+  std::vector<int> row_offsets{0};
+  std::vector<int> col_indices;
+  std::vector<double> values;
+
+  void addEntry(const int col, const double value)
+  {
+    col_indices.push_back(col);
+    values.push_back(value);
+  }
+  void finishRow()
+  {
+    row_offsets.push_back(static_cast<int>(col_indices.size()));
+    ++rows;
+  }
+};
+
 class GnnSolverInterface
 {
 public:
@@ -29,6 +51,9 @@ public:
   virtual void maximizeLinearAssignment(
     const std::vector<std::vector<double>> & cost, std::unordered_map<int, int> * direct_assignment,
     std::unordered_map<int, int> * reverse_assignment) = 0;
+  virtual void maximizeLinearAssignment(
+    const SparseScore & score, std::unordered_map<int, int> * direct_assignment,
+    std::unordered_map<int, int> * reverse_assignment) = 0;
 };
 }  // namespace gnn_solver
 
@@ -27,7 +27,9 @@
 #include <geometry_msgs/msg/vector3.hpp>
 
 #include <cmath>
+#include <cstdint>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 namespace utils
@@ -70,6 +72,48 @@ enum MSG_COV_IDX {
   YAW_PITCH = 34,
   YAW_YAW = 35
 };
+
+// 2d grid of indices, the indices within cell_size of a position being in its 3x3 neighbor cells
+class XYGrid
+{
+public:
+  explicit XYGrid(const double cell_size) : inverse_cell_size_(1.0 / cell_size) {}
+
+  void add(const double x, const double y, const size_t index)
+  {
+    cells_[getKey(getCell(x), getCell(y))].push_back(index);
+  }
+
+  // call f for every index in the 3x3 cells around (x, y)
+  template <class F>
+  void forEachNeighbor(const double x, const double y, F f) const
+  {
+    const int64_t cell_x = getCell(x);
+    const int64_t cell_y = getCell(y);
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        const auto itr = cells_.find(getKey(cell_x + dx, cell_y + dy));
+        if (itr == cells_.end()) continue;
+        for (const size_t index : itr->second) {
+          f(index);
+        }
+      }
+    }
+  }
+
+private:
+  int64_t getCell(const double value) const
+  {
+    return static_cast<int64_t>(std::floor(value * inverse_cell_size_));
+  }
+  static uint64_t getKey(const int64_t cell_x, const int64_t cell_y)
+  {
+    return (static_cast<uint64_t>(cell_x) << 32) ^ (static_cast<uint64_t>(cell_y) & 0xffffffff);
+  }
+
+  const double inverse_cell_size_;
+  std::unordered_map<uint64_t, std::vector<size_t>> cells_;
+};
 }  // namespace utils
 
 #endif  // OBJECT_ASSOCIATION_MERGER__UTILS__UTILS_HPP_
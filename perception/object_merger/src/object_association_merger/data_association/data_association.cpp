@@ -20,6 +20,7 @@
 #include "tier4_autoware_utils/geometry/geometry.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <unordered_map>
@@ -77,6 +78,10 @@ DataAssociation::DataAssociation(
     min_iou_matrix_ = min_iou_matrix_tmp.transpose();
   }
 
+  // the objects are gated in a grid of the largest max_dist
+  gate_cell_size_ = max_dist_matrix_.size() > 0 ? max_dist_matrix_.maxCoeff() : 0.0;
+  if (gate_cell_size_ <= 0.0) gate_cell_size_ = 1.0;
+
   gnn_solver_ptr_ = std::make_unique<gnn_solver::MuSSP>();
 }
 
@@ -84,32 +89,19 @@ void DataAssociation::assign(
   const Eigen::MatrixXd & src, std::unordered_map<int, int> & direct_assignment,
   std::unordered_map<int, int> & reverse_assignment)
 {
-  std::vector<std::vector<double>> score(src.rows());
+  // Only the pairs above the threshold enter the graph, so every assignment is kept
+  gnn_solver::SparseScore score;
+  score.cols = src.cols();
   for (int row = 0; row < src.rows(); ++row) {
-    score.at(row).resize(src.cols());
     for (int col = 0; col < src.cols(); ++col) {
-      score.at(row).at(col) = src(row, col);
+      if (score_threshold_ <= src(row, col)) {
+        score.addEntry(col, src(row, col));
+      }
     }
+    score.finishRow();
   }
   // Solve
   gnn_solver_ptr_->maximizeLinearAssignment(score, &direct_assignment, &reverse_assignment);
-
-  for (auto itr = direct_assignment.begin(); itr != direct_assignment.end();) {
-    if (src(itr->first, itr->second) < score_threshold_) {
-      itr = direct_assignment.erase(itr);
-      continue;
-    } else {
-      ++itr;
-    }
-  }
-  for (auto itr = reverse_assignment.begin(); itr != reverse_assignment.end();) {
-    if (src(itr->second, itr->first) < score_threshold_) {
-      itr = reverse_assignment.erase(itr);
-      continue;
-    } else {
-      ++itr;
-    }
-  }
 }
 
 Eigen::MatrixXd DataAssociation::calcScoreMatrix(
@@ -118,54 +110,65 @@ Eigen::MatrixXd DataAssociation::calcScoreMatrix(
 {
   Eigen::MatrixXd score_matrix =
     Eigen::MatrixXd::Zero(objects1.objects.size(), objects0.objects.size());
+  if (objects0.objects.empty() || objects1.objects.empty()) {
+    return score_matrix;
+  }
+
+  std::vector<std::uint8_t> objects0_labels;
+  objects0_labels.reserve(objects0.objects.size());
+  for (const auto & object0 : objects0.objects) {
+    objects0_labels.push_back(perception_utils::getHighestProbLabel(object0.classification));
+  }
+  // pairs farther than max_dist get no score, only the neighboring cells are scored
+  utils::XYGrid objects0_grid(gate_cell_size_);
+  for (size_t objects0_idx = 0; objects0_idx < objects0.objects.size(); ++objects0_idx) {
+    const auto & position =
+      objects0.objects.at(objects0_idx).kinematics.pose_with_covariance.pose.position;
+    objects0_grid.add(position.x, position.y, objects0_idx);
+  }
+
+  // every row is written by a single thread
+#pragma omp parallel for
   for (size_t objects1_idx = 0; objects1_idx < objects1.objects.size(); ++objects1_idx) {
     const autoware_auto_perception_msgs::msg::DetectedObject & object1 =
       objects1.objects.at(objects1_idx);
     const std::uint8_t object1_label =
       perception_utils::getHighestProbLabel(object1.classification);
+    const auto & object1_position = object1.kinematics.pose_with_covariance.pose.position;
 
-    for (size_t objects0_idx = 0; objects0_idx < objects0.objects.size(); ++objects0_idx) {
-      const autoware_auto_perception_msgs::msg::DetectedObject & object0 =
-        objects0.objects.at(objects0_idx);
-      const std::uint8_t object0_label =
-        perception_utils::getHighestProbLabel(object0.classification);
+    objects0_grid.forEachNeighbor(
+      object1_position.x, object1_position.y, [&](const size_t objects0_idx) {
+        const autoware_auto_perception_msgs::msg::DetectedObject & object0 =
+          objects0.objects.at(objects0_idx);
+        const std::uint8_t object0_label = objects0_labels.at(objects0_idx);
+        if (!can_assign_matrix_(object1_label, object0_label)) return;
 
-      double score = 0.0;
-      if (can_assign_matrix_(object1_label, object0_label)) {
         const double max_dist = max_dist_matrix_(object1_label, object0_label);
         const double dist = tier4_autoware_utils::calcDistance2d(
-          object0.kinematics.pose_with_covariance.pose.position,
-          object1.kinematics.pose_with_covariance.pose.position);
+          object0.kinematics.pose_with_covariance.pose.position, object1_position);
 
-        bool passed_gate = true;
         // dist gate
-        if (passed_gate) {
-          if (max_dist < dist) passed_gate = false;
-        }
+        if (max_dist < dist) return;
         // angle gate
-        if (passed_gate) {
+        {
           const double max_rad = max_rad_matrix_(object1_label, object0_label);
           const double angle = getFormedYawAngle(
             object0.kinematics.pose_with_covariance.pose.orientation,
             object1.kinematics.pose_with_covariance.pose.orientation, false);
-          if (std::fabs(max_rad) < M_PI && std::fabs(max_rad) < std::fabs(angle))
-            passed_gate = false;
+          if (std::fabs(max_rad) < M_PI && std::fabs(max_rad) < std::fabs(angle)) return;
         }
         // 2d iou gate
-        if (passed_gate) {
+        {
           const double min_iou = min_iou_matrix_(object1_label, object0_label);
           const double iou = perception_utils::get2dIoU(object0, object1);
-          if (iou < min_iou) passed_gate = false;
+          if (iou < min_iou) return;
         }
 
         // all gate is passed
-        if (passed_gate) {
-          score = (max_dist - std::min(dist, max_dist)) / max_dist;
-          if (score < score_threshold_) score = 0.0;
-        }
-      }
-      score_matrix(objects1_idx, objects0_idx) = score;
-    }
+        double score = (max_dist - std::min(dist, max_dist)) / max_dist;
+        if (score < score_threshold_) score = 0.0;
+        score_matrix(objects1_idx, objects0_idx) = score;
+      });
   }
 
   return score_matrix;
@@ -47,10 +47,31 @@ void SSP::maximizeLinearAssignment(
   const std::vector<std::vector<double>> & cost, std::unordered_map<int, int> * direct_assignment,
   std::unordered_map<int, int> * reverse_assignment)
 {
-  // NOTE: Need to set as default arguments
-  bool sparse_cost = true;
-  // bool sparse_cost = false;
+  const double EPS = 1e-5;
 
+  // When there is no agents or no tasks, terminate
+  if (cost.size() == 0 || cost.at(0).size() == 0) {
+    return;
+  }
+
+  // Only the positive costs become edges of the graph
+  SparseScore score;
+  score.cols = cost.at(0).size();
+  for (const auto & row : cost) {
+    for (int task = 0; task < score.cols; ++task) {
+      if (row.at(task) > EPS) {
+        score.addEntry(task, row.at(task));
+      }
+    }
+    score.finishRow();
+  }
+  maximizeLinearAssignment(score, direct_assignment, reverse_assignment);
+}
+
+void SSP::maximizeLinearAssignment(
+  const SparseScore & score, std::unordered_map<int, int> * direct_assignment,
+  std::unordered_map<int, int> * reverse_assignment)
+{
   // Hyperparameters
   // double MAX_COST = 6;
   const double MAX_COST = 10;
@@ -58,46 +79,33 @@ void SSP::maximizeLinearAssignment(
   const double EPS = 1e-5;
 
   // When there is no agents or no tasks, terminate
-  if (cost.size() == 0 || cost.at(0).size() == 0) {
+  if (score.rows == 0 || score.cols == 0) {
     return;
   }
 
-  // Construct a bipartite graph from the cost matrix
-  int n_agents = cost.size();
-  int n_tasks = cost.at(0).size();
+  // Construct a bipartite graph from the sparse cost matrix
+  int n_agents = score.rows;
+  int n_tasks = score.cols;
 
-  int n_dummies;
-  if (sparse_cost) {
-    n_dummies = n_agents;
-  } else {
-    n_dummies = 0;
-  }
+  // The dummy nodes leave the agents without any edge unassigned
+  int n_dummies = n_agents;
 
   int source = 0;
   int sink = n_agents + n_tasks + 1;
   int n_nodes = n_agents + n_tasks + n_dummies + 2;
 
-  // // Print cost matrix
-  // std::cout << std::endl;
-  // for (int agent = 0; agent < n_agents; agent++)
-  // {
-  //   for (int task = 0; task < n_tasks; task++)
-  //   {
-  //     std::cout << cost.at(agent).at(task) << " ";
-  //   }
-  //   std::cout << std::endl;
-  // }
-
-  // std::chrono::system_clock::time_point start_time, end_time;
-  // start_time = std::chrono::system_clock::now();
+  // Number of edges of every task
+  std::vector<int> n_task_edges(n_tasks, 0);
+  for (const int task : score.col_indices) {
+    ++n_task_edges.at(task);
+  }
 
   // Adjacency list of residual graph (index: nodes)
   //     - 0: source node
   //     - {1, ...,  n_agents}: agent nodes
   //     - {n_agents+1, ...,  n_agents+n_tasks}: task nodes
   //     - n_agents+n_tasks+1: sink node
-  //     - {n_agents+n_tasks+2, ..., n_agents+n_tasks+1+n_agents}:
-  //       dummy node (when sparse_cost is true)
+  //     - {n_agents+n_tasks+2, ..., n_agents+n_tasks+1+n_agents}: dummy node
   std::vector<std::vector<ResidualEdge>> adjacency_list(n_nodes);
 
   // Reserve memory
@@ -107,10 +115,10 @@ void SSP::maximizeLinearAssignment(
       adjacency_list.at(v).reserve(n_agents);
     } else if (v <= n_agents) {
       // Agents
-      adjacency_list.at(v).reserve(n_tasks + 1 + 1);
+      adjacency_list.at(v).reserve(score.row_offsets.at(v) - score.row_offsets.at(v - 1) + 1 + 1);
     } else if (v <= n_agents + n_tasks) {
       // Tasks
-      adjacency_list.at(v).reserve(n_agents + 1);
+      adjacency_list.at(v).reserve(n_task_edges.at(v - n_agents - 1) + 1);
     } else if (v == sink) {
       // Sink
       adjacency_list.at(v).reserve(n_tasks + n_dummies);
@@ -131,18 +139,19 @@ void SSP::maximizeLinearAssignment(
 
   // Add edges from agents
   for (int agent = 0; agent < n_agents; ++agent) {
-    for (int task = 0; task < n_tasks; ++task) {
-      if (!sparse_cost || cost.at(agent).at(task) > EPS) {
+    for (int i = score.row_offsets.at(agent); i < score.row_offsets.at(agent + 1); ++i) {
+      const int task = score.col_indices.at(i);
+      const double value = score.values.at(i);
+      if (value > EPS) {
         // From agent to task
         adjacency_list.at(agent + 1).emplace_back(
-          task + n_agents + 1, 1, MAX_COST - cost.at(agent).at(task), 0,
+          task + n_agents + 1, 1, MAX_COST - value, 0,
           adjacency_list.at(task + n_agents + 1).size());
 
         // From task to agent
         adjacency_list.at(task + n_agents + 1)
           .emplace_back(
-            agent + 1, 0, cost.at(agent).at(task) - MAX_COST, 0,
-            adjacency_list.at(agent + 1).size() - 1);
+            agent + 1, 0, value - MAX_COST, 0, adjacency_list.at(agent + 1).size() - 1);
       }
     }
   }
@@ -159,26 +168,24 @@ void SSP::maximizeLinearAssignment(
   }
 
   // Add edges from dummy
-  if (sparse_cost) {
-    for (int agent = 0; agent < n_agents; ++agent) {
-      // From agent to dummy
-      adjacency_list.at(agent + 1).emplace_back(
-        agent + n_agents + n_tasks + 2, 1, MAX_COST, 0,
-        adjacency_list.at(agent + n_agents + n_tasks + 2).size());
-
-      // From dummy to agent
-      adjacency_list.at(agent + n_agents + n_tasks + 2)
-        .emplace_back(agent + 1, 0, -MAX_COST, 0, adjacency_list.at(agent + 1).size() - 1);
-
-      // From dummy to sink
-      adjacency_list.at(agent + n_agents + n_tasks + 2)
-        .emplace_back(sink, 1, 0, 0, adjacency_list.at(sink).size());
-
-      // From sink to dummy
-      adjacency_list.at(sink).emplace_back(
-        agent + n_agents + n_tasks + 2, 0, 0, 0,
-        adjacency_list.at(agent + n_agents + n_tasks + 2).size() - 1);
-    }
+  for (int agent = 0; agent < n_agents; ++agent) {
+    // From agent to dummy
+    adjacency_list.at(agent + 1).emplace_back(
+      agent + n_agents + n_tasks + 2, 1, MAX_COST, 0,
+      adjacency_list.at(agent + n_agents + n_tasks + 2).size());
+
+    // From dummy to agent
+    adjacency_list.at(agent + n_agents + n_tasks + 2)
+      .emplace_back(agent + 1, 0, -MAX_COST, 0, adjacency_list.at(agent + 1).size() - 1);
+
+    // From dummy to sink
+    adjacency_list.at(agent + n_agents + n_tasks + 2)
+      .emplace_back(sink, 1, 0, 0, adjacency_list.at(sink).size());
+
+    // From sink to dummy
+    adjacency_list.at(sink).emplace_back(
+      agent + n_agents + n_tasks + 2, 0, 0, 0,
+      adjacency_list.at(agent + n_agents + n_tasks + 2).size() - 1);
   }
 
   // Maximum flow value
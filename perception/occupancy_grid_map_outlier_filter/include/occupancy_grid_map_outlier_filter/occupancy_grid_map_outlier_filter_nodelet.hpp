@@ -31,13 +31,15 @@
 #include <message_filters/synchronizer.h>
 #include <pcl/filters/extract_indices.h>
 #include <pcl/filters/radius_outlier_removal.h>
-#include <pcl/search/kdtree.h>
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/message_filter.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <Eigen/Core>
+
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace occupancy_grid_map_outlier_filter
 {
@@ -59,11 +61,26 @@ public:
     PclPointCloud & output, PclPointCloud & outlier);
 
 private:
+  // bucket the points into square cells of search_radius, so that the neighbors of a point are in
+  // the 3x3 cells around its own
+  void buildGrid(const std::vector<const PclPointCloud *> & inputs);
+  // the number of points within search_radius of (x, y), counted up to max_count
+  int countNeighbors(const float x, const float y, const int max_count) const;
+  void filterByDensity(
+    const PclPointCloud & input, const Pose & pose, PclPointCloud & output,
+    PclPointCloud & outlier) const;
+
   float search_radius_;
   float min_points_and_distance_ratio_;
   int min_points_;
   int max_points_;
-  pcl::search::Search<pcl::PointXY>::Ptr kd_tree_;
+
+  float grid_min_x_{0.0f};
+  float grid_min_y_{0.0f};
+  int grid_width_{0};
+  int grid_height_{0};
+  std::vector<std::size_t> cell_offsets_;  // the points of cell i are [offsets[i], offsets[i + 1])
+  std::vector<pcl::PointXY> cell_points_;
 };
 
 class OccupancyGridMapOutlierFilterComponent : public rclcpp::Node
@@ -77,7 +94,8 @@ private:
     const PointCloud2::ConstSharedPtr & input_pointcloud);
   void filterByOccupancyGridMap(
     const OccupancyGrid & occupancy_grid_map, const PointCloud2 & pointcloud,
-    PclPointCloud & high_confidence, PclPointCloud & low_confidence);
+    const Eigen::Matrix4f & pointcloud_to_map, PclPointCloud & high_confidence,
+    PclPointCloud & low_confidence);
 
 private:
   class Debugger
@@ -29,30 +29,43 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace
 {
-bool transformPointcloud(
-  const sensor_msgs::msg::PointCloud2 & input, const tf2_ros::Buffer & tf2,
-  const std::string & target_frame, sensor_msgs::msg::PointCloud2 & output)
+boost::optional<Eigen::Matrix4f> lookupTransformMatrix(
+  const std_msgs::msg::Header & header, const tf2_ros::Buffer & tf2,
+  const std::string & target_frame)
 {
   rclcpp::Clock clock{RCL_ROS_TIME};
   geometry_msgs::msg::TransformStamped tf_stamped{};
   try {
     tf_stamped = tf2.lookupTransform(
-      target_frame, input.header.frame_id, input.header.stamp, rclcpp::Duration::from_seconds(0.5));
+      target_frame, header.frame_id, header.stamp, rclcpp::Duration::from_seconds(0.5));
   } catch (const tf2::TransformException & ex) {
     RCLCPP_WARN_THROTTLE(
       rclcpp::get_logger("occupancy_grid_map_outlier_filter"), clock, 5000, "%s", ex.what());
+    return boost::none;
+  }
+  return Eigen::Matrix4f(tf2::transformToEigen(tf_stamped.transform).matrix().cast<float>());
+}
+
+bool transformPointcloud(
+  const sensor_msgs::msg::PointCloud2 & input, const tf2_ros::Buffer & tf2,
+  const std::string & target_frame, sensor_msgs::msg::PointCloud2 & output)
+{
+  const auto tf_matrix = lookupTransformMatrix(input.header, tf2, target_frame);
+  if (!tf_matrix) {
     return false;
   }
   // transform pointcloud
-  Eigen::Matrix4f tf_matrix = tf2::transformToEigen(tf_stamped.transform).matrix().cast<float>();
-  pcl_ros::transformPointCloud(tf_matrix, input, output);
+  pcl_ros::transformPointCloud(*tf_matrix, input, output);
   output.header.stamp = input.header.stamp;
   output.header.frame_id = target_frame;
   return true;
@@ -74,29 +87,6 @@ geometry_msgs::msg::PoseStamped getPoseStamped(
   return tier4_autoware_utils::transform2pose(tf_stamped);
 }
 
-boost::optional<char> getCost(
-  const nav_msgs::msg::OccupancyGrid & map, const double & x, const double & y)
-{
-  const auto & map_position = map.info.origin.position;
-  const auto & map_resolution = map.info.resolution;
-  const double map_height_m = map.info.height /* cell size */ * map_resolution;
-  const double map_width_m = map.info.width /* cell size */ * map_resolution;
-  const double map_min_x = map_position.x;
-  const double map_max_x = map_position.x + map_width_m;
-  const double map_min_y = map_position.y;
-  const double map_max_y = map_position.y + map_height_m;
-
-  if (map_min_x < x && x < map_max_x && map_min_y < y && y < map_max_y) {
-    unsigned int map_cell_x{};
-    unsigned int map_cell_y{};
-    map_cell_x = std::floor((x - map_position.x) / map_resolution);
-    map_cell_y = std::floor((y - map_position.y) / map_resolution);
-    size_t index = map_cell_y * map.info.width + map_cell_x;
-    return map.data.at(index);
-  }
-  return boost::none;
-}
-
 }  // namespace
 
 namespace occupancy_grid_map_outlier_filter
@@ -108,77 +98,129 @@ RadiusSearch2dfilter::RadiusSearch2dfilter(rclcpp::Node & node)
     node.declare_parameter("radius_search_2d_filter.min_points_and_distance_ratio", 400.0f);
   min_points_ = node.declare_parameter("radius_search_2d_filter.min_points", 4);
   max_points_ = node.declare_parameter("radius_search_2d_filter.max_points", 70);
-  kd_tree_ = pcl::make_shared<pcl::search::KdTree<pcl::PointXY>>(false);
 }
 
-void RadiusSearch2dfilter::filter(
-  const PclPointCloud & input, const Pose & pose, PclPointCloud & output, PclPointCloud & outlier)
+void RadiusSearch2dfilter::buildGrid(const std::vector<const PclPointCloud *> & inputs)
 {
-  const auto & xyz_cloud = input;
-  pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
-  xy_cloud->points.resize(xyz_cloud.points.size());
-  for (size_t i = 0; i < xyz_cloud.points.size(); ++i) {
-    xy_cloud->points[i].x = xyz_cloud.points[i].x;
-    xy_cloud->points[i].y = xyz_cloud.points[i].y;
+  float max_x = std::numeric_limits<float>::lowest();
+  float max_y = std::numeric_limits<float>::lowest();
+  grid_min_x_ = std::numeric_limits<float>::max();
+  grid_min_y_ = std::numeric_limits<float>::max();
+  for (const auto * input : inputs) {
+    for (const auto & point : input->points) {
+      if (!std::isfinite(point.x) || !std::isfinite(point.y)) {
+        continue;
+      }
+      grid_min_x_ = std::min(grid_min_x_, point.x);
+      grid_min_y_ = std::min(grid_min_y_, point.y);
+      max_x = std::max(max_x, point.x);
+      max_y = std::max(max_y, point.y);
+    }
   }
-
-  std::vector<int> k_indices(xy_cloud->points.size());
-  std::vector<float> k_dists(xy_cloud->points.size());
-  kd_tree_->setInputCloud(xy_cloud);
-  for (size_t i = 0; i < xy_cloud->points.size(); ++i) {
-    const float distance =
-      std::hypot(xy_cloud->points[i].x - pose.position.x, xy_cloud->points[i].y - pose.position.y);
-    const int min_points_threshold = std::min(
-      std::max(static_cast<int>(min_points_and_distance_ratio_ / distance + 0.5f), min_points_),
-      max_points_);
-    const int points_num =
-      kd_tree_->radiusSearch(i, search_radius_, k_indices, k_dists, min_points_threshold);
-
-    if (min_points_threshold <= points_num) {
-      output.points.push_back(xyz_cloud.points.at(i));
-    } else {
-      outlier.points.push_back(xyz_cloud.points.at(i));
+  if (max_x < grid_min_x_) {
+    grid_width_ = grid_height_ = 0;
+    cell_offsets_.assign(1, 0U);
+    cell_points_.clear();
+    return;
+  }
+  const float recip_cell_size = 1.0f / search_radius_;
+  grid_width_ = static_cast<int>((max_x - grid_min_x_) * recip_cell_size) + 1;
+  grid_height_ = static_cast<int>((max_y - grid_min_y_) * recip_cell_size) + 1;
+
+  // counting sort of the points by cell
+  const auto cell_index = [this, recip_cell_size](const pcl::PointXYZ & point) {
+    const int cell_x = static_cast<int>((point.x - grid_min_x_) * recip_cell_size);
+    const int cell_y = static_cast<int>((point.y - grid_min_y_) * recip_cell_size);
+    return static_cast<std::size_t>(cell_y) * grid_width_ + cell_x;
+  };
+  cell_offsets_.assign(static_cast<std::size_t>(grid_width_) * grid_height_ + 1, 0U);
+  for (const auto * input : inputs) {
+    for (const auto & point : input->points) {
+      if (std::isfinite(point.x) && std::isfinite(point.y)) {
+        ++cell_offsets_[cell_index(point) + 1];
+      }
+    }
+  }
+  std::partial_sum(cell_offsets_.begin(), cell_offsets_.end(), cell_offsets_.begin());
+  cell_points_.resize(cell_offsets_.back());
+  std::vector<std::size_t> cell_ends(cell_offsets_.begin(), std::prev(cell_offsets_.end()));
+  for (const auto * input : inputs) {
+    for (const auto & point : input->points) {
+      if (std::isfinite(point.x) && std::isfinite(point.y)) {
+        auto & cell_point = cell_points_[cell_ends[cell_index(point)]++];
+        cell_point.x = point.x;
+        cell_point.y = point.y;
+      }
     }
   }
 }
 
-void RadiusSearch2dfilter::filter(
-  const PclPointCloud & high_conf_input, const PclPointCloud & low_conf_input, const Pose & pose,
-  PclPointCloud & output, PclPointCloud & outlier)
+int RadiusSearch2dfilter::countNeighbors(const float x, const float y, const int max_count) const
 {
-  const auto & high_conf_xyz_cloud = high_conf_input;
-  const auto & low_conf_xyz_cloud = low_conf_input;
-  pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
-  xy_cloud->points.resize(low_conf_xyz_cloud.points.size() + high_conf_xyz_cloud.points.size());
-  for (size_t i = 0; i < low_conf_xyz_cloud.points.size(); ++i) {
-    xy_cloud->points[i].x = low_conf_xyz_cloud.points[i].x;
-    xy_cloud->points[i].y = low_conf_xyz_cloud.points[i].y;
+  if (!std::isfinite(x) || !std::isfinite(y)) {
+    return 0;
   }
-  for (size_t i = low_conf_xyz_cloud.points.size(); i < xy_cloud->points.size(); ++i) {
-    xy_cloud->points[i].x = high_conf_xyz_cloud.points[i - low_conf_xyz_cloud.points.size()].x;
-    xy_cloud->points[i].y = high_conf_xyz_cloud.points[i - low_conf_xyz_cloud.points.size()].y;
+  const float recip_cell_size = 1.0f / search_radius_;
+  const int cell_x = static_cast<int>((x - grid_min_x_) * recip_cell_size);
+  const int cell_y = static_cast<int>((y - grid_min_y_) * recip_cell_size);
+  const float sqr_radius = search_radius_ * search_radius_;
+  int count = 0;
+  for (int cy = std::max(cell_y - 1, 0); cy <= std::min(cell_y + 1, grid_height_ - 1); ++cy) {
+    const std::size_t row = static_cast<std::size_t>(cy) * grid_width_;
+    const std::size_t begin = cell_offsets_[row + std::max(cell_x - 1, 0)];
+    const std::size_t end = cell_offsets_[row + std::min(cell_x + 1, grid_width_ - 1) + 1];
+    // the cells of a row are contiguous
+    for (std::size_t i = begin; i < end; ++i) {
+      const float dx = cell_points_[i].x - x;
+      const float dy = cell_points_[i].y - y;
+      if (dx * dx + dy * dy < sqr_radius && ++count >= max_count) {
+        return count;
+      }
+    }
   }
+  return count;
+}
 
-  std::vector<int> k_indices(xy_cloud->points.size());
-  std::vector<float> k_dists(xy_cloud->points.size());
-  kd_tree_->setInputCloud(xy_cloud);
-  for (size_t i = 0; i < low_conf_xyz_cloud.points.size(); ++i) {
-    const float distance =
-      std::hypot(xy_cloud->points[i].x - pose.position.x, xy_cloud->points[i].y - pose.position.y);
+void RadiusSearch2dfilter::filterByDensity(
+  const PclPointCloud & input, const Pose & pose, PclPointCloud & output,
+  PclPointCloud & outlier) const
+{
+  std::vector<char> is_inlier(input.points.size());
+#pragma omp parallel for
+  for (size_t i = 0; i < input.points.size(); ++i) {
+    const auto & point = input.points[i];
+    const float distance = std::hypot(point.x - pose.position.x, point.y - pose.position.y);
     const int min_points_threshold = std::min(
       std::max(static_cast<int>(min_points_and_distance_ratio_ / distance + 0.5f), min_points_),
       max_points_);
-    const int points_num =
-      kd_tree_->radiusSearch(i, search_radius_, k_indices, k_dists, min_points_threshold);
+    is_inlier[i] = min_points_threshold <= countNeighbors(point.x, point.y, min_points_threshold);
+  }
 
-    if (min_points_threshold <= points_num) {
-      output.points.push_back(low_conf_xyz_cloud.points.at(i));
+  for (size_t i = 0; i < input.points.size(); ++i) {
+    if (is_inlier[i]) {
+      output.points.push_back(input.points[i]);
     } else {
-      outlier.points.push_back(low_conf_xyz_cloud.points.at(i));
+      outlier.points.push_back(input.points[i]);
     }
   }
 }
 
+void RadiusSearch2dfilter::filter(
+  const PclPointCloud & input, const Pose & pose, PclPointCloud & output, PclPointCloud & outlier)
+{
+  buildGrid({&input});
+  filterByDensity(input, pose, output, outlier);
+}
+
+void RadiusSearch2dfilter::filter(
+  const PclPointCloud & high_conf_input, const PclPointCloud & low_conf_input, const Pose & pose,
+  PclPointCloud & output, PclPointCloud & outlier)
+{
+  // the density of the low confidence points counts the high confidence points as well
+  buildGrid({&low_conf_input, &high_conf_input});
+  filterByDensity(low_conf_input, pose, output, outlier);
+}
+
 OccupancyGridMapOutlierFilterComponent::OccupancyGridMapOutlierFilterComponent(
   const rclcpp::NodeOptions & options)
 : Node("OccupancyGridMapOutlierFilter", options)
@@ -228,15 +270,18 @@ void OccupancyGridMapOutlierFilterComponent::onOccupancyGridMapAndPointCloud2(
   const OccupancyGrid::ConstSharedPtr & input_ogm, const PointCloud2::ConstSharedPtr & input_pc)
 {
   stop_watch_ptr_->toc("processing_time", true);
-  // Transform to occupancy grid map frame
-  PointCloud2 ogm_frame_pc{};
-  if (!transformPointcloud(*input_pc, *tf2_, input_ogm->header.frame_id, ogm_frame_pc)) {
+  // the points are transformed to the occupancy grid map frame while they are classified
+  const auto pc_to_ogm = lookupTransformMatrix(input_pc->header, *tf2_, input_ogm->header.frame_id);
+  if (!pc_to_ogm) {
     return;
   }
+  Header ogm_frame_header = input_pc->header;
+  ogm_frame_header.frame_id = input_ogm->header.frame_id;
   // Occupancy grid map based filter
   PclPointCloud high_confidence_pc{};
   PclPointCloud low_confidence_pc{};
-  filterByOccupancyGridMap(*input_ogm, ogm_frame_pc, high_confidence_pc, low_confidence_pc);
+  filterByOccupancyGridMap(
+    *input_ogm, *input_pc, *pc_to_ogm, high_confidence_pc, low_confidence_pc);
   // Apply Radius search 2d filter for low confidence pointcloud
   PclPointCloud filtered_low_confidence_pc{};
   PclPointCloud outlier_pc{};
@@ -256,7 +301,7 @@ void OccupancyGridMapOutlierFilterComponent::onOccupancyGridMapAndPointCloud2(
     PointCloud2 ogm_frame_filtered_pc{};
     auto base_link_frame_filtered_pc_ptr = std::make_unique<PointCloud2>();
     pcl::toROSMsg(concat_pc, ogm_frame_filtered_pc);
-    ogm_frame_filtered_pc.header = ogm_frame_pc.header;
+    ogm_frame_filtered_pc.header = ogm_frame_header;
     if (!transformPointcloud(
           ogm_frame_filtered_pc, *tf2_, base_link_frame_, *base_link_frame_filtered_pc_ptr)) {
       return;
@@ -265,9 +310,9 @@ void OccupancyGridMapOutlierFilterComponent::onOccupancyGridMapAndPointCloud2(
     pointcloud_pub_->publish(std::move(base_link_frame_filtered_pc_ptr));
   }
   if (debugger_ptr_) {
-    debugger_ptr_->publishHighConfidence(high_confidence_pc, ogm_frame_pc.header);
-    debugger_ptr_->publishLowConfidence(filtered_low_confidence_pc, ogm_frame_pc.header);
-    debugger_ptr_->publishOutlier(outlier_pc, ogm_frame_pc.header);
+    debugger_ptr_->publishHighConfidence(high_confidence_pc, ogm_frame_header);
+    debugger_ptr_->publishLowConfidence(filtered_low_confidence_pc, ogm_frame_header);
+    debugger_ptr_->publishOutlier(outlier_pc, ogm_frame_header);
   }
 
   // add processing time for debug
@@ -283,20 +328,38 @@ void OccupancyGridMapOutlierFilterComponent::onOccupancyGridMapAndPointCloud2(
 
 void OccupancyGridMapOutlierFilterComponent::filterByOccupancyGridMap(
   const OccupancyGrid & occupancy_grid_map, const PointCloud2 & pointcloud,
-  PclPointCloud & high_confidence, PclPointCloud & low_confidence)
+  const Eigen::Matrix4f & pointcloud_to_map, PclPointCloud & high_confidence,
+  PclPointCloud & low_confidence)
 {
+  // the points out of the map are of high confidence
+  const auto & info = occupancy_grid_map.info;
+  const float recip_resolution = 1.0f / info.resolution;
+  const float origin_x = static_cast<float>(info.origin.position.x);
+  const float origin_y = static_cast<float>(info.origin.position.y);
+  const float width = static_cast<float>(info.width);
+  const float height = static_cast<float>(info.height);
+  const Eigen::Matrix3f rotation = pointcloud_to_map.topLeftCorner<3, 3>();
+  const Eigen::Vector3f translation = pointcloud_to_map.topRightCorner<3, 1>();
+
+  high_confidence.points.reserve(pointcloud.width * pointcloud.height);
   for (sensor_msgs::PointCloud2ConstIterator<float> x(pointcloud, "x"), y(pointcloud, "y"),
        z(pointcloud, "z");
        x != x.end(); ++x, ++y, ++z) {
-    const auto cost = getCost(occupancy_grid_map, *x, *y);
-    if (cost) {
-      if (cost_threshold_ < *cost) {
-        high_confidence.push_back(pcl::PointXYZ(*x, *y, *z));
-      } else {
-        low_confidence.push_back(pcl::PointXYZ(*x, *y, *z));
-      }
+    const Eigen::Vector3f point = rotation * Eigen::Vector3f(*x, *y, *z) + translation;
+    const float cell_x = (point.x() - origin_x) * recip_resolution;
+    const float cell_y = (point.y() - origin_y) * recip_resolution;
+    if (!(0.0f < cell_x && cell_x < width && 0.0f < cell_y && cell_y < height)) {
+      high_confidence.push_back(pcl::PointXYZ(point.x(), point.y(), point.z()));
+      continue;
+    }
+    // clamped against the rounding of the last cell
+    const auto cell_index_x = std::min(static_cast<unsigned int>(cell_x), info.width - 1);
+    const auto cell_index_y = std::min(static_cast<unsigned int>(cell_y), info.height - 1);
+    const int8_t cost = occupancy_grid_map.data[cell_index_y * info.width + cell_index_x];
+    if (cost_threshold_ < cost) {
+      high_confidence.push_back(pcl::PointXYZ(point.x(), point.y(), point.z()));
     } else {
-      high_confidence.push_back(pcl::PointXYZ(*x, *y, *z));
+      low_confidence.push_back(pcl::PointXYZ(point.x(), point.y(), point.z()));
     }
   }
 }
@@ -89,10 +89,28 @@ public:
   Output update(const Input & input);
 
 private:
+  // the radar data bucketed by their xy position, rebuilt for every update
+  struct RadarGrid
+  {
+    double cell_size{};
+    double min_x{};
+    double min_y{};
+    int width{0};
+    int height{0};
+    // the radar data of cell i are cell_radars[cell_offsets[i]:cell_offsets[i + 1]]
+    std::vector<std::size_t> cell_offsets{};
+    std::vector<std::size_t> cell_radars{};
+  };
+
   rclcpp::Logger logger_;
   Param param_{};
+  RadarGrid radar_grid_{};
+  void buildRadarGrid(const std::vector<RadarInput> & radars, const double cell_size);
   std::shared_ptr<std::vector<RadarInput>> filterRadarWithinObject(
     const DetectedObject & object, const std::shared_ptr<std::vector<RadarInput>> & radars);
+  // same as filterRadarWithinObject, only for the radar data of radar_grid_ around the object
+  std::shared_ptr<std::vector<RadarInput>> filterRadarWithinObjectInGrid(
+    const DetectedObject & object, const std::vector<RadarInput> & radars);
   // TODO(Satoshi Tanaka): Implement
   // std::vector<DetectedObject> splitObject(
   //   const DetectedObject & object, const std::shared_ptr<std::vector<RadarInput>> & radars);
@@ -18,7 +18,9 @@
 #include <boost/geometry.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -77,10 +79,16 @@ RadarFusionToDetectedObject::Output RadarFusionToDetectedObject::update(
     return output;
   }
 
+  // Bucket the radar data once, so that each object only visits the radar data around it
+  constexpr double radar_grid_cell_size = 2.0;
+  const std::vector<RadarInput> no_radars{};
+  const auto & radars = input.radars ? *input.radars : no_radars;
+  buildRadarGrid(radars, radar_grid_cell_size);
+
   for (auto & object : input.objects->objects) {
     // Link between 3d bounding box and radar data
     std::shared_ptr<std::vector<RadarInput>> radars_within_object =
-      filterRadarWithinObject(object, input.radars);
+      filterRadarWithinObjectInGrid(object, radars);
 
     // TODO(Satoshi Tanaka): Implement
     // Split the object going in a different direction
@@ -165,6 +173,107 @@ RadarFusionToDetectedObject::filterRadarWithinObject(
   return std::make_shared<std::vector<RadarFusionToDetectedObject::RadarInput>>(outputs);
 }
 
+void RadarFusionToDetectedObject::buildRadarGrid(
+  const std::vector<RadarInput> & radars, const double cell_size)
+{
+  radar_grid_.cell_size = cell_size;
+  radar_grid_.width = 0;
+  radar_grid_.height = 0;
+  radar_grid_.cell_offsets.clear();
+  radar_grid_.cell_radars.clear();
+  if (radars.empty()) {
+    return;
+  }
+
+  double min_x = radars.front().pose_with_covariance.pose.position.x;
+  double min_y = radars.front().pose_with_covariance.pose.position.y;
+  double max_x = min_x;
+  double max_y = min_y;
+  for (const auto & radar : radars) {
+    const auto & position = radar.pose_with_covariance.pose.position;
+    min_x = std::min(min_x, position.x);
+    min_y = std::min(min_y, position.y);
+    max_x = std::max(max_x, position.x);
+    max_y = std::max(max_y, position.y);
+  }
+  radar_grid_.min_x = min_x;
+  radar_grid_.min_y = min_y;
+  radar_grid_.width = static_cast<int>((max_x - min_x) / cell_size) + 1;
+  radar_grid_.height = static_cast<int>((max_y - min_y) / cell_size) + 1;
+
+  // counting sort of the radar data by cell, each cell keeping the input order
+  std::vector<std::size_t> radar_cells(radars.size());
+  radar_grid_.cell_offsets.assign(
+    static_cast<std::size_t>(radar_grid_.width) * radar_grid_.height + 1, 0U);
+  for (std::size_t i = 0; i < radars.size(); ++i) {
+    const auto & position = radars.at(i).pose_with_covariance.pose.position;
+    const int cell_x = static_cast<int>((position.x - min_x) / cell_size);
+    const int cell_y = static_cast<int>((position.y - min_y) / cell_size);
+    radar_cells.at(i) = static_cast<std::size_t>(cell_y) * radar_grid_.width + cell_x;
+    ++radar_grid_.cell_offsets.at(radar_cells.at(i) + 1);
+  }
+  std::partial_sum(
+    radar_grid_.cell_offsets.begin(), radar_grid_.cell_offsets.end(),
+    radar_grid_.cell_offsets.begin());
+  std::vector<std::size_t> next_index(
+    radar_grid_.cell_offsets.begin(), std::prev(radar_grid_.cell_offsets.end()));
+  radar_grid_.cell_radars.resize(radars.size());
+  for (std::size_t i = 0; i < radars.size(); ++i) {
+    radar_grid_.cell_radars.at(next_index.at(radar_cells.at(i))++) = i;
+  }
+}
+
+std::shared_ptr<std::vector<RadarFusionToDetectedObject::RadarInput>>
+RadarFusionToDetectedObject::filterRadarWithinObjectInGrid(
+  const DetectedObject & object, const std::vector<RadarInput> & radars)
+{
+  std::vector<RadarInput> outputs{};
+
+  tier4_autoware_utils::Point2d object_size{object.shape.dimensions.x, object.shape.dimensions.y};
+  LinearRing2d object_box = createObject2dWithMargin(object_size, param_.bounding_box_margin);
+  object_box = tier4_autoware_utils::transformVector(
+    object_box, tier4_autoware_utils::pose2transform(object.kinematics.pose_with_covariance.pose));
+
+  const auto & grid = radar_grid_;
+  tier4_autoware_utils::Box2d envelope{};
+  boost::geometry::envelope(object_box, envelope);
+  if (
+    grid.width == 0 || envelope.max_corner().x() < grid.min_x ||
+    envelope.max_corner().y() < grid.min_y ||
+    grid.min_x + grid.width * grid.cell_size < envelope.min_corner().x() ||
+    grid.min_y + grid.height * grid.cell_size < envelope.min_corner().y()) {
+    return std::make_shared<std::vector<RadarFusionToDetectedObject::RadarInput>>(outputs);
+  }
+  const auto to_cell = [&grid](const double value, const double min, const int size) {
+    return std::clamp(static_cast<int>(std::floor((value - min) / grid.cell_size)), 0, size - 1);
+  };
+  const int min_cell_x = to_cell(envelope.min_corner().x(), grid.min_x, grid.width);
+  const int min_cell_y = to_cell(envelope.min_corner().y(), grid.min_y, grid.height);
+  const int max_cell_x = to_cell(envelope.max_corner().x(), grid.min_x, grid.width);
+  const int max_cell_y = to_cell(envelope.max_corner().y(), grid.min_y, grid.height);
+
+  std::vector<std::size_t> indices{};
+  for (int cell_y = min_cell_y; cell_y <= max_cell_y; ++cell_y) {
+    for (int cell_x = min_cell_x; cell_x <= max_cell_x; ++cell_x) {
+      const std::size_t cell = static_cast<std::size_t>(cell_y) * grid.width + cell_x;
+      for (std::size_t k = grid.cell_offsets.at(cell); k < grid.cell_offsets.at(cell + 1); ++k) {
+        const std::size_t i = grid.cell_radars.at(k);
+        const auto & position = radars.at(i).pose_with_covariance.pose.position;
+        if (boost::geometry::within(Point2d{position.x, position.y}, object_box)) {
+          indices.push_back(i);
+        }
+      }
+    }
+  }
+  // the twist estimation depends on the order of the radar data, which is kept as in the input
+  std::sort(indices.begin(), indices.end());
+  outputs.reserve(indices.size());
+  for (const auto i : indices) {
+    outputs.emplace_back(radars.at(i));
+  }
+  return std::make_shared<std::vector<RadarFusionToDetectedObject::RadarInput>>(outputs);
+}
+
 // TODO(Satoshi Tanaka): Implementation
 // std::vector<DetectedObject> RadarFusionToDetectedObject::splitObject(
 //   const DetectedObject & object, const std::vector<RadarInput> & radars)
@@ -23,15 +23,23 @@
 class BoundingBoxShapeModel : public ShapeEstimationModelInterface
 {
 private:
+  // xy of the cluster points and the projections of an angle, as contiguous arrays so that the
+  // per angle reductions vectorize
+  struct PointsBuffer
+  {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> c_1;
+    std::vector<float> c_2;
+  };
+
   bool fitLShape(
     const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle,
     autoware_auto_perception_msgs::msg::Shape & shape_output,
     geometry_msgs::msg::Pose & pose_output);
-  float calcClosenessCriterion(const std::vector<float> & C_1, const std::vector<float> & C_2);
-  float optimize(
-    const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle);
-  float boostOptimize(
-    const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle);
+  float calcClosenessCriterion(const float theta, PointsBuffer & buffer);
+  float optimize(PointsBuffer & buffer, const float min_angle, const float max_angle);
+  float boostOptimize(PointsBuffer & buffer, const float min_angle, const float max_angle);
 
 public:
   BoundingBoxShapeModel();
@@ -26,6 +26,7 @@
 #include <pcl_conversions/pcl_conversions.h>
 
 #include <string>
+#include <vector>
 
 struct ReferenceYawInfo
 {
@@ -51,9 +52,12 @@ private:
   bool use_corrector_;
   bool use_filter_;
   bool use_boost_bbox_optimizer_;
+  int num_threads_;
 
 public:
-  ShapeEstimator(bool use_corrector, bool use_filter, bool use_boost_bbox_optimizer = false);
+  ShapeEstimator(
+    bool use_corrector, bool use_filter, bool use_boost_bbox_optimizer = false,
+    int num_threads = 1);
 
   virtual ~ShapeEstimator() = default;
 
@@ -62,6 +66,15 @@ public:
     const boost::optional<ReferenceYawInfo> & ref_yaw_info,
     autoware_auto_perception_msgs::msg::Shape & shape_output,
     geometry_msgs::msg::Pose & pose_output);
+
+  // estimate all the clusters of a frame, in parallel. The outputs are resized to the number of
+  // clusters and is_estimated tells which of them succeeded
+  virtual void estimateShapesAndPoses(
+    const std::vector<uint8_t> & labels,
+    const std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters,
+    const std::vector<boost::optional<ReferenceYawInfo>> & ref_yaw_infos,
+    std::vector<autoware_auto_perception_msgs::msg::Shape> & shapes_output,
+    std::vector<geometry_msgs::msg::Pose> & poses_output, std::vector<bool> & is_estimated);
 };
 
 #endif  // SHAPE_ESTIMATION__SHAPE_ESTIMATOR_HPP_
@@ -44,6 +44,36 @@
 
 constexpr float epsilon = 0.001;
 
+namespace
+{
+void calcMinMax(const std::vector<float> & values, float & min_value, float & max_value)
+{
+  const float * data = values.data();
+  const size_t size = values.size();
+  min_value = data[0];
+  max_value = data[0];
+#pragma omp simd reduction(min : min_value) reduction(max : max_value)
+  for (size_t i = 0; i < size; ++i) {
+    min_value = std::min(min_value, data[i]);
+    max_value = std::max(max_value, data[i]);
+  }
+}
+
+void project(
+  const std::vector<float> & x, const std::vector<float> & y, const float e_x, const float e_y,
+  std::vector<float> & c)
+{
+  const float * x_data = x.data();
+  const float * y_data = y.data();
+  float * c_data = c.data();
+  const size_t size = x.size();
+#pragma omp simd
+  for (size_t i = 0; i < size; ++i) {
+    c_data[i] = x_data[i] * e_x + y_data[i] * e_y;
+  }
+}
+}  // namespace
+
 BoundingBoxShapeModel::BoundingBoxShapeModel()
 : ref_yaw_info_(boost::none), use_boost_bbox_optimizer_(false)
 {
@@ -74,14 +104,28 @@ bool BoundingBoxShapeModel::fitLShape(
   const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle,
   autoware_auto_perception_msgs::msg::Shape & shape_output, geometry_msgs::msg::Pose & pose_output)
 {
-  // calc min and max z for height
-  float min_z = cluster.empty() ? 0.0 : cluster.at(0).z;
-  float max_z = cluster.empty() ? 0.0 : cluster.at(0).z;
-  for (const auto & point : cluster) {
-    min_z = std::min(point.z, min_z);
-    max_z = std::max(point.z, max_z);
+  if (cluster.empty()) {
+    return false;
   }
 
+  // the points are read from the cloud once, every angle of the search works on the arrays
+  PointsBuffer buffer;
+  const size_t point_num = cluster.size();
+  buffer.x.resize(point_num);
+  buffer.y.resize(point_num);
+  buffer.c_1.resize(point_num);
+  buffer.c_2.resize(point_num);
+  std::vector<float> z(point_num);
+  for (size_t i = 0; i < point_num; ++i) {
+    buffer.x[i] = cluster.points[i].x;
+    buffer.y[i] = cluster.points[i].y;
+    z[i] = cluster.points[i].z;
+  }
+
+  // calc min and max z for height
+  float min_z, max_z;
+  calcMinMax(z, min_z, max_z);
+
   /*
    * Paper : IV2017, Efficient L-Shape Fitting for Vehicle Detection Using Laser Scanners
    * Authors : Xio Zhang, Wenda Xu, Chiyu Dong and John M. Dolan
@@ -90,9 +134,9 @@ bool BoundingBoxShapeModel::fitLShape(
   // Paper : Algo.2 Search-Based Rectangle Fitting
   double theta_star;
   if (use_boost_bbox_optimizer_) {
-    theta_star = boostOptimize(cluster, min_angle, max_angle);
+    theta_star = boostOptimize(buffer, min_angle, max_angle);
   } else {
-    theta_star = optimize(cluster, min_angle, max_angle);
+    theta_star = optimize(buffer, min_angle, max_angle);
   }
 
   const float sin_theta_star = std::sin(theta_star);
@@ -102,18 +146,14 @@ bool BoundingBoxShapeModel::fitLShape(
   Eigen::Vector2f e_2_star;
   e_1_star << cos_theta_star, sin_theta_star;
   e_2_star << -sin_theta_star, cos_theta_star;
-  std::vector<float> C_1_star;  // col.11, Algo.2
-  std::vector<float> C_2_star;  // col.11, Algo.2
-  for (const auto & point : cluster) {
-    C_1_star.push_back(point.x * e_1_star.x() + point.y * e_1_star.y());
-    C_2_star.push_back(point.x * e_2_star.x() + point.y * e_2_star.y());
-  }
+  // col.11, Algo.2
+  project(buffer.x, buffer.y, e_1_star.x(), e_1_star.y(), buffer.c_1);
+  project(buffer.x, buffer.y, e_2_star.x(), e_2_star.y(), buffer.c_2);
 
   // col.12, Algo.2
-  const float min_C_1_star = *std::min_element(C_1_star.begin(), C_1_star.end());
-  const float max_C_1_star = *std::max_element(C_1_star.begin(), C_1_star.end());
-  const float min_C_2_star = *std::min_element(C_2_star.begin(), C_2_star.end());
-  const float max_C_2_star = *std::max_element(C_2_star.begin(), C_2_star.end());
+  float min_C_1_star, max_C_1_star, min_C_2_star, max_C_2_star;
+  calcMinMax(buffer.c_1, min_C_1_star, max_C_1_star);
+  calcMinMax(buffer.c_2, min_C_2_star, max_C_2_star);
 
   const float a_1 = cos_theta_star;
   const float b_1 = sin_theta_star;
@@ -162,57 +202,41 @@ bool BoundingBoxShapeModel::fitLShape(
   return true;
 }
 
-float BoundingBoxShapeModel::calcClosenessCriterion(
-  const std::vector<float> & C_1, const std::vector<float> & C_2)
+float BoundingBoxShapeModel::calcClosenessCriterion(const float theta, PointsBuffer & buffer)
 {
+  // col.3 - col.6, Algo.2
+  project(buffer.x, buffer.y, std::cos(theta), std::sin(theta), buffer.c_1);
+  project(buffer.x, buffer.y, -std::sin(theta), std::cos(theta), buffer.c_2);
+
   // Paper : Algo.4 Closeness Criterion
-  const float min_c_1 = *std::min_element(C_1.begin(), C_1.end());  // col.2, Algo.4
-  const float max_c_1 = *std::max_element(C_1.begin(), C_1.end());  // col.2, Algo.4
-  const float min_c_2 = *std::min_element(C_2.begin(), C_2.end());  // col.3, Algo.4
-  const float max_c_2 = *std::max_element(C_2.begin(), C_2.end());  // col.3, Algo.4
-
-  std::vector<float> D_1;  // col.4, Algo.4
-  for (const auto & c_1_element : C_1) {
-    const float v = std::min(max_c_1 - c_1_element, c_1_element - min_c_1);
-    D_1.push_back(v * v);
-  }
+  float min_c_1, max_c_1, min_c_2, max_c_2;
+  calcMinMax(buffer.c_1, min_c_1, max_c_1);  // col.2, Algo.4
+  calcMinMax(buffer.c_2, min_c_2, max_c_2);  // col.3, Algo.4
 
-  std::vector<float> D_2;  // col.5, Algo.4
-  for (const auto & c_2_element : C_2) {
-    const float v = std::min(max_c_2 - c_2_element, c_2_element - min_c_2);
-    D_2.push_back(v * v);
-  }
   constexpr float d_min = 0.1 * 0.1;
   constexpr float d_max = 0.4 * 0.4;
+  const float * c_1 = buffer.c_1.data();
+  const float * c_2 = buffer.c_2.data();
+  const size_t size = buffer.c_1.size();
   float beta = 0;  // col.6, Algo.4
-  for (size_t i = 0; i < D_1.size(); ++i) {
-    if (d_max < std::min(D_1.at(i), D_2.at(i))) {
-      continue;
-    }
-    const float d = std::max(std::min(D_1.at(i), D_2.at(i)), d_min);
-    beta += 1.0 / d;
+#pragma omp simd reduction(+ : beta)
+  for (size_t i = 0; i < size; ++i) {
+    const float v_1 = std::min(max_c_1 - c_1[i], c_1[i] - min_c_1);  // col.4, Algo.4
+    const float v_2 = std::min(max_c_2 - c_2[i], c_2[i] - min_c_2);  // col.5, Algo.4
+    const float d = std::min(v_1 * v_1, v_2 * v_2);
+    beta += d_max < d ? 0.0f : 1.0f / std::max(d, d_min);
   }
   return beta;
 }
 
 float BoundingBoxShapeModel::optimize(
-  const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle)
+  PointsBuffer & buffer, const float min_angle, const float max_angle)
 {
   std::vector<std::pair<float /*theta*/, float /*q*/>> Q;
   constexpr float angle_resolution = M_PI / 180.0;
   for (float theta = min_angle; theta <= max_angle + epsilon; theta += angle_resolution) {
-    Eigen::Vector2f e_1;
-    e_1 << std::cos(theta), std::sin(theta);  // col.3, Algo.2
-    Eigen::Vector2f e_2;
-    e_2 << -std::sin(theta), std::cos(theta);  // col.4, Algo.2
-    std::vector<float> C_1;                    // col.5, Algo.2
-    std::vector<float> C_2;                    // col.6, Algo.2
-    for (const auto & point : cluster) {
-      C_1.push_back(point.x * e_1.x() + point.y * e_1.y());
-      C_2.push_back(point.x * e_2.x() + point.y * e_2.y());
-    }
-    float q = calcClosenessCriterion(C_1, C_2);  // col.7, Algo.2
-    Q.push_back(std::make_pair(theta, q));       // col.8, Algo.2
+    float q = calcClosenessCriterion(theta, buffer);  // col.7, Algo.2
+    Q.push_back(std::make_pair(theta, q));            // col.8, Algo.2
   }
 
   float theta_star{0.0};  // col.10, Algo.2
@@ -228,22 +252,9 @@ float BoundingBoxShapeModel::optimize(
 }
 
 float BoundingBoxShapeModel::boostOptimize(
-  const pcl::PointCloud<pcl::PointXYZ> & cluster, const float min_angle, const float max_angle)
+  PointsBuffer & buffer, const float min_angle, const float max_angle)
 {
-  auto closeness_func = [&](float theta) {
-    Eigen::Vector2f e_1;
-    e_1 << std::cos(theta), std::sin(theta);  // col.3, Algo.2
-    Eigen::Vector2f e_2;
-    e_2 << -std::sin(theta), std::cos(theta);  // col.4, Algo.2
-    std::vector<float> C_1;                    // col.5, Algo.2
-    std::vector<float> C_2;                    // col.6, Algo.2
-    for (const auto & point : cluster) {
-      C_1.push_back(point.x * e_1.x() + point.y * e_1.y());
-      C_2.push_back(point.x * e_2.x() + point.y * e_2.y());
-    }
-    float q = calcClosenessCriterion(C_1, C_2);
-    return -q;
-  };
+  auto closeness_func = [&](float theta) { return -calcClosenessCriterion(theta, buffer); };
 
   int bits = 6;
   boost::uintmax_t max_iter = 20;
@@ -18,15 +18,19 @@
 #include "shape_estimation/filter/filter.hpp"
 #include "shape_estimation/model/model.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 using Label = autoware_auto_perception_msgs::msg::ObjectClassification;
 
-ShapeEstimator::ShapeEstimator(bool use_corrector, bool use_filter, bool use_boost_bbox_optimizer)
+ShapeEstimator::ShapeEstimator(
+  bool use_corrector, bool use_filter, bool use_boost_bbox_optimizer, int num_threads)
 : use_corrector_(use_corrector),
   use_filter_(use_filter),
-  use_boost_bbox_optimizer_(use_boost_bbox_optimizer)
+  use_boost_bbox_optimizer_(use_boost_bbox_optimizer),
+  num_threads_(std::max(num_threads, 1))
 {
 }
 
@@ -62,6 +66,29 @@ bool ShapeEstimator::estimateShapeAndPose(
   return true;
 }
 
+void ShapeEstimator::estimateShapesAndPoses(
+  const std::vector<uint8_t> & labels,
+  const std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters,
+  const std::vector<boost::optional<ReferenceYawInfo>> & ref_yaw_infos,
+  std::vector<autoware_auto_perception_msgs::msg::Shape> & shapes_output,
+  std::vector<geometry_msgs::msg::Pose> & poses_output, std::vector<bool> & is_estimated)
+{
+  const size_t cluster_num = clusters.size();
+  shapes_output.resize(cluster_num);
+  poses_output.resize(cluster_num);
+  // std::vector<bool> can not be written from several threads
+  std::vector<uint8_t> is_estimated_flags(cluster_num, 0U);
+
+  // the clusters are independent, and the large ones take most of the time
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+  for (size_t i = 0; i < cluster_num; ++i) {
+    is_estimated_flags[i] = estimateShapeAndPose(
+      labels[i], clusters[i], ref_yaw_infos[i], shapes_output[i], poses_output[i]);
+  }
+
+  is_estimated.assign(is_estimated_flags.begin(), is_estimated_flags.end());
+}
+
 bool ShapeEstimator::estimateOriginalShapeAndPose(
   const uint8_t label, const pcl::PointCloud<pcl::PointXYZ> & cluster,
   const boost::optional<ReferenceYawInfo> & ref_yaw_info,
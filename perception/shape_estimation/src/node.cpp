@@ -29,8 +29,11 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 using Label = autoware_auto_perception_msgs::msg::ObjectClassification;
 
@@ -47,8 +50,9 @@ ShapeEstimationNode::ShapeEstimationNode(const rclcpp::NodeOptions & node_option
   use_vehicle_reference_yaw_ = declare_parameter("use_vehicle_reference_yaw", true);
   bool use_boost_bbox_optimizer = declare_parameter("use_boost_bbox_optimizer", false);
   RCLCPP_INFO(this->get_logger(), "using boost shape estimation : %d", use_boost_bbox_optimizer);
-  estimator_ =
-    std::make_unique<ShapeEstimator>(use_corrector, use_filter, use_boost_bbox_optimizer);
+  const int num_threads = std::max(static_cast<int>(declare_parameter("num_threads", 1)), 1);
+  estimator_ = std::make_unique<ShapeEstimator>(
+    use_corrector, use_filter, use_boost_bbox_optimizer, num_threads);
 }
 
 void ShapeEstimationNode::callback(const DetectedObjectsWithFeature::ConstSharedPtr input_msg)
@@ -62,8 +66,18 @@ void ShapeEstimationNode::callback(const DetectedObjectsWithFeature::ConstShared
   DetectedObjectsWithFeature output_msg;
   output_msg.header = input_msg->header;
 
-  // Estimate shape for each object and pack msg
-  for (const auto & feature_object : input_msg->feature_objects) {
+  // Gather the clusters of the frame
+  const size_t object_num = input_msg->feature_objects.size();
+  std::vector<size_t> object_indices;
+  std::vector<uint8_t> labels;
+  std::vector<pcl::PointCloud<pcl::PointXYZ>> clusters;
+  std::vector<boost::optional<ReferenceYawInfo>> ref_yaw_infos;
+  object_indices.reserve(object_num);
+  labels.reserve(object_num);
+  clusters.reserve(object_num);
+  ref_yaw_infos.reserve(object_num);
+  for (size_t i = 0; i < object_num; ++i) {
+    const auto & feature_object = input_msg->feature_objects.at(i);
     const auto & object = feature_object.object;
     const auto & label = object.classification.front().label;
     const auto & feature = feature_object.feature;
@@ -71,34 +85,42 @@ void ShapeEstimationNode::callback(const DetectedObjectsWithFeature::ConstShared
                             Label::TRAILER == label;
 
     // convert ros to pcl
-    pcl::PointCloud<pcl::PointXYZ>::Ptr cluster(new pcl::PointCloud<pcl::PointXYZ>);
-    pcl::fromROSMsg(feature.cluster, *cluster);
+    pcl::PointCloud<pcl::PointXYZ> cluster;
+    pcl::fromROSMsg(feature.cluster, cluster);
 
     // check cluster data
-    if (cluster->empty()) {
+    if (cluster.empty()) {
       continue;
     }
 
-    // estimate shape and pose
-    autoware_auto_perception_msgs::msg::Shape shape;
-    geometry_msgs::msg::Pose pose;
     boost::optional<ReferenceYawInfo> ref_yaw_info = boost::none;
     if (use_vehicle_reference_yaw_ && is_vehicle) {
       ref_yaw_info = ReferenceYawInfo{
         static_cast<float>(tf2::getYaw(object.kinematics.pose_with_covariance.pose.orientation)),
         tier4_autoware_utils::deg2rad(10)};
     }
-    const bool estimated_success =
-      estimator_->estimateShapeAndPose(label, *cluster, ref_yaw_info, shape, pose);
+    object_indices.push_back(i);
+    labels.push_back(label);
+    clusters.push_back(std::move(cluster));
+    ref_yaw_infos.push_back(ref_yaw_info);
+  }
+
+  // Estimate shape and pose of all the clusters at once
+  std::vector<autoware_auto_perception_msgs::msg::Shape> shapes;
+  std::vector<geometry_msgs::msg::Pose> poses;
+  std::vector<bool> is_estimated;
+  estimator_->estimateShapesAndPoses(labels, clusters, ref_yaw_infos, shapes, poses, is_estimated);
 
+  // Pack msg
+  for (size_t i = 0; i < object_indices.size(); ++i) {
     // If the shape estimation fails, ignore it.
-    if (!estimated_success) {
+    if (!is_estimated.at(i)) {
       continue;
     }
 
-    output_msg.feature_objects.push_back(feature_object);
-    output_msg.feature_objects.back().object.shape = shape;
-    output_msg.feature_objects.back().object.kinematics.pose_with_covariance.pose = pose;
+    output_msg.feature_objects.push_back(input_msg->feature_objects.at(object_indices.at(i)));
+    output_msg.feature_objects.back().object.shape = shapes.at(i);
+    output_msg.feature_objects.back().object.kinematics.pose_with_covariance.pose = poses.at(i);
   }
 
   // Publish
@@ -43,16 +43,24 @@ class TensorrtYoloNodelet : public rclcpp::Node
 public:
   explicit TensorrtYoloNodelet(const rclcpp::NodeOptions & options);
   void connectCb();
-  void callback(const sensor_msgs::msg::Image::ConstSharedPtr image_msg);
+  void callback(const sensor_msgs::msg::Image::ConstSharedPtr image_msg, const size_t camera_id);
   bool readLabelFile(const std::string & filepath, std::vector<std::string> * labels);
 
 private:
+  void detect(const std::vector<size_t> & camera_ids);
+
   std::mutex connect_mutex_;
 
-  image_transport::Publisher image_pub_;
-  rclcpp::Publisher<tier4_perception_msgs::msg::DetectedObjectsWithFeature>::SharedPtr objects_pub_;
+  // one of each per camera, all the cameras sharing the engine
+  std::vector<image_transport::Publisher> image_pubs_;
+  std::vector<rclcpp::Publisher<tier4_perception_msgs::msg::DetectedObjectsWithFeature>::SharedPtr>
+    objects_pubs_;
+  std::vector<image_transport::Subscriber> image_subs_;
+  std::vector<std::string> input_topics_;
 
-  image_transport::Subscriber image_sub_;
+  // latest image of each camera not detected yet, nullptr if none
+  std::vector<sensor_msgs::msg::Image::ConstSharedPtr> pending_images_;
+  double batch_time_window_;
 
   rclcpp::TimerBase::SharedPtr timer_;
 
@@ -0,0 +1,31 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PREPROCESS_HPP_
+#define PREPROCESS_HPP_
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+
+namespace yolo
+{
+// Resize an 8-bit BGR image on the device with bilinear interpolation as cv::resize does, and
+// write it to the network input as RGB floats in [0, 1], channel first
+cudaError_t resizeAndNormalize_launch(
+  const uint8_t * src, const int src_w, const int src_h, const int src_step, float * dst,
+  const int dst_w, const int dst_h, cudaStream_t stream);
+}  // namespace yolo
+
+#endif  // PREPROCESS_HPP_
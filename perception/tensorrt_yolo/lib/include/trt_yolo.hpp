@@ -115,6 +115,12 @@ public:
 
   bool detect(const cv::Mat & in_img, float * out_scores, float * out_boxes, float * out_classes);
 
+  // Detect in a batch of at most getMaxBatchSize() images, the outputs of the i-th image starting
+  // at i * getMaxDetections() detections
+  bool detect(
+    const std::vector<cv::Mat> & in_imgs, float * out_scores, float * out_boxes,
+    float * out_classes);
+
   // Get (c, h, w) size of the fixed input
   std::vector<int> getInputDims() const;
 
@@ -138,11 +144,12 @@ private:
   cuda::unique_ptr<float[]> out_scores_d_ = nullptr;
   cuda::unique_ptr<float[]> out_boxes_d_ = nullptr;
   cuda::unique_ptr<float[]> out_classes_d_ = nullptr;
+  // the raw 8-bit images of a batch, grown to the largest batch seen
+  cuda::unique_ptr<uint8_t[]> images_d_ = nullptr;
+  size_t images_d_size_ = 0;
 
   void load(const std::string & path);
   bool prepare();
-  std::vector<float> preprocess(
-    const cv::Mat & in_img, const int c, const int h, const int w) const;
   // Infer using pre-allocated GPU buffers {data, scores, boxes}
   void infer(std::vector<void *> & buffers, const int batch_size);
 };
@@ -38,6 +38,7 @@
 #include <cuda_utils.hpp>
 #include <mish_plugin.hpp>
 #include <nms_plugin.hpp>
+#include <preprocess.hpp>
 #include <trt_yolo.hpp>
 #include <yolo_layer_plugin.hpp>
 
@@ -87,32 +88,6 @@ bool Net::prepare()
   return true;
 }
 
-std::vector<float> Net::preprocess(
-  const cv::Mat & in_img, const int c, const int w, const int h) const
-{
-  cv::Mat rgb;
-  cv::cvtColor(in_img, rgb, cv::COLOR_BGR2RGB);
-
-  cv::resize(rgb, rgb, cv::Size(w, h));
-
-  cv::Mat img_float;
-  rgb.convertTo(img_float, CV_32FC3, 1 / 255.0);
-
-  // HWC TO CHW
-  std::vector<cv::Mat> input_channels(c);
-  cv::split(img_float, input_channels);
-
-  std::vector<float> result(h * w * c);
-  auto data = result.data();
-  int channel_length = h * w;
-  for (int i = 0; i < c; ++i) {
-    memcpy(data, input_channels[i].data, channel_length * sizeof(float));
-    data += channel_length;
-  }
-
-  return result;
-}
-
 Net::Net(const std::string & path, bool verbose)
 {
   Logger logger(verbose);
@@ -229,11 +204,11 @@ Net::Net(
     network->markOutput(*output);
   }
 
-  // create profile
+  // create profile, a batch engine also running the partial batches
   auto profile = builder->createOptimizationProfile();
   profile->setDimensions(
     network->getInput(0)->getName(), nvinfer1::OptProfileSelector::kMIN,
-    nvinfer1::Dims4{max_batch_size, input_channel, input_height, input_width});
+    nvinfer1::Dims4{1, input_channel, input_height, input_width});
   profile->setDimensions(
     network->getInput(0)->getName(), nvinfer1::OptProfileSelector::kOPT,
     nvinfer1::Dims4{max_batch_size, input_channel, input_height, input_width});
@@ -290,25 +265,57 @@ void Net::infer(std::vector<void *> & buffers, const int batch_size)
 
 bool Net::detect(const cv::Mat & in_img, float * out_scores, float * out_boxes, float * out_classes)
 {
+  return detect(std::vector<cv::Mat>{in_img}, out_scores, out_boxes, out_classes);
+}
+
+bool Net::detect(
+  const std::vector<cv::Mat> & in_imgs, float * out_scores, float * out_boxes, float * out_classes)
+{
+  const int batch_size = in_imgs.size();
+  if (batch_size < 1 || getMaxBatchSize() < batch_size) {
+    return false;
+  }
+  // only the 8-bit images are uploaded, resized and normalized on the device
+  size_t images_size = 0;
+  for (const auto & in_img : in_imgs) {
+    if (in_img.type() != CV_8UC3 || in_img.empty()) {
+      return false;
+    }
+    images_size += in_img.total() * in_img.elemSize();
+  }
+  if (images_d_size_ < images_size) {
+    images_d_ = cuda::make_unique<uint8_t[]>(images_size);
+    images_d_size_ = images_size;
+  }
   const auto input_dims = getInputDims();
-  const auto input = preprocess(in_img, input_dims.at(0), input_dims.at(2), input_dims.at(1));
-  CHECK_CUDA_ERROR(
-    cudaMemcpy(input_d_.get(), input.data(), input.size() * sizeof(float), cudaMemcpyHostToDevice));
+  size_t offset = 0;
+  for (int i = 0; i < batch_size; ++i) {
+    const auto & in_img = in_imgs.at(i);
+    const size_t row_size = in_img.cols * in_img.elemSize();
+    CHECK_CUDA_ERROR(cudaMemcpy2DAsync(
+      images_d_.get() + offset, row_size, in_img.data, in_img.step, row_size, in_img.rows,
+      cudaMemcpyHostToDevice, stream_));
+    CHECK_CUDA_ERROR(resizeAndNormalize_launch(
+      images_d_.get() + offset, in_img.cols, in_img.rows, row_size,
+      input_d_.get() + i * getInputSize(), input_dims.at(2), input_dims.at(1), stream_));
+    offset += row_size * in_img.rows;
+  }
   std::vector<void *> buffers = {
     input_d_.get(), out_scores_d_.get(), out_boxes_d_.get(), out_classes_d_.get()};
   try {
-    infer(buffers, 1);
+    infer(buffers, batch_size);
   } catch (const std::runtime_error & e) {
     return false;
   }
+  const auto detections = batch_size * getMaxDetections();
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    out_scores, out_scores_d_.get(), sizeof(float) * getMaxDetections(), cudaMemcpyDeviceToHost,
+    out_scores, out_scores_d_.get(), sizeof(float) * detections, cudaMemcpyDeviceToHost,
     stream_));
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    out_boxes, out_boxes_d_.get(), sizeof(float) * 4 * getMaxDetections(), cudaMemcpyDeviceToHost,
+    out_boxes, out_boxes_d_.get(), sizeof(float) * 4 * detections, cudaMemcpyDeviceToHost,
     stream_));
   CHECK_CUDA_ERROR(cudaMemcpyAsync(
-    out_classes, out_classes_d_.get(), sizeof(float) * getMaxDetections(), cudaMemcpyDeviceToHost,
+    out_classes, out_classes_d_.get(), sizeof(float) * detections, cudaMemcpyDeviceToHost,
     stream_));
   cudaStreamSynchronize(stream_);
   return true;
@@ -66,6 +66,16 @@ TensorrtYoloNodelet::TensorrtYoloNodelet(const rclcpp::NodeOptions & options)
   yolo_config_.detections_per_im = declare_parameter("detections_per_im", 100);
   yolo_config_.use_darknet_layer = declare_parameter("use_darknet_layer", true);
   yolo_config_.ignore_thresh = declare_parameter("ignore_thresh", 0.5);
+  input_topics_ = declare_parameter("input_topics", std::vector<std::string>{});
+  auto output_topics = declare_parameter("output_topics", std::vector<std::string>{});
+  batch_time_window_ = declare_parameter("batch_time_window", 0.05);
+  if (input_topics_.size() != output_topics.size()) {
+    RCLCPP_ERROR(this->get_logger(), "input_topics and output_topics differ in size");
+    output_topics.resize(input_topics_.size());
+  }
+  // without input_topics, a single camera on the default topics
+  const bool is_single_camera = input_topics_.empty();
+  const int batch_size = is_single_camera ? 1 : static_cast<int>(input_topics_.size());
 
   if (!yolo::set_cuda_device(gpu_device_id)) {
     RCLCPP_ERROR(this->get_logger(), "Given GPU not exist or suitable");
@@ -79,20 +89,20 @@ TensorrtYoloNodelet::TensorrtYoloNodelet(const rclcpp::NodeOptions & options)
   if (fs.is_open()) {
     RCLCPP_INFO(this->get_logger(), "Found %s", engine_file.c_str());
     net_ptr_.reset(new yolo::Net(engine_file, false));
-    if (net_ptr_->getMaxBatchSize() != 1) {
+    if (net_ptr_->getMaxBatchSize() != batch_size) {
       RCLCPP_INFO(
-        this->get_logger(), "Max batch size %d should be 1. Rebuild engine from file",
-        net_ptr_->getMaxBatchSize());
-      net_ptr_.reset(
-        new yolo::Net(onnx_file, mode, 1, yolo_config_, calibration_images, calib_cache_file));
+        this->get_logger(), "Max batch size %d should be %d. Rebuild engine from file",
+        net_ptr_->getMaxBatchSize(), batch_size);
+      net_ptr_.reset(new yolo::Net(
+        onnx_file, mode, batch_size, yolo_config_, calibration_images, calib_cache_file));
       net_ptr_->save(engine_file);
     }
   } else {
     RCLCPP_INFO(
       this->get_logger(), "Could not find %s, try making TensorRT engine from onnx",
       engine_file.c_str());
-    net_ptr_.reset(
-      new yolo::Net(onnx_file, mode, 1, yolo_config_, calibration_images, calib_cache_file));
+    net_ptr_.reset(new yolo::Net(
+      onnx_file, mode, batch_size, yolo_config_, calibration_images, calib_cache_file));
     net_ptr_->save(engine_file);
   }
   RCLCPP_INFO(this->get_logger(), "Inference engine prepared.");
@@ -103,9 +113,19 @@ TensorrtYoloNodelet::TensorrtYoloNodelet(const rclcpp::NodeOptions & options)
 
   std::lock_guard<std::mutex> lock(connect_mutex_);
 
-  objects_pub_ = this->create_publisher<tier4_perception_msgs::msg::DetectedObjectsWithFeature>(
-    "out/objects", 1);
-  image_pub_ = image_transport::create_publisher(this, "out/image");
+  if (is_single_camera) {
+    input_topics_.push_back("in/image");
+    output_topics.push_back("out/objects");
+  }
+  for (size_t i = 0; i < input_topics_.size(); ++i) {
+    objects_pubs_.push_back(
+      this->create_publisher<tier4_perception_msgs::msg::DetectedObjectsWithFeature>(
+        output_topics[i], 1));
+    image_pubs_.push_back(image_transport::create_publisher(
+      this, is_single_camera ? "out/image" : output_topics[i] + "/debug/image"));
+  }
+  image_subs_.resize(input_topics_.size());
+  pending_images_.resize(input_topics_.size());
 
   out_scores_ =
     std::make_unique<float[]>(net_ptr_->getMaxBatchSize() * net_ptr_->getMaxDetections());
@@ -119,78 +139,133 @@ void TensorrtYoloNodelet::connectCb()
 {
   using std::placeholders::_1;
   std::lock_guard<std::mutex> lock(connect_mutex_);
-  if (objects_pub_->get_subscription_count() == 0 && image_pub_.getNumSubscribers() == 0) {
-    image_sub_.shutdown();
-  } else if (!image_sub_) {
-    image_sub_ = image_transport::create_subscription(
-      this, "in/image", std::bind(&TensorrtYoloNodelet::callback, this, _1), "raw",
-      rmw_qos_profile_sensor_data);
+  // the cameras are subscribed all together, so that the batches stay full
+  bool is_subscribed = false;
+  for (size_t i = 0; i < input_topics_.size(); ++i) {
+    is_subscribed |=
+      objects_pubs_[i]->get_subscription_count() != 0 || image_pubs_[i].getNumSubscribers() != 0;
+  }
+  for (size_t i = 0; i < input_topics_.size(); ++i) {
+    if (!is_subscribed) {
+      image_subs_[i].shutdown();
+      pending_images_[i].reset();
+    } else if (!image_subs_[i]) {
+      image_subs_[i] = image_transport::create_subscription(
+        this, input_topics_[i], std::bind(&TensorrtYoloNodelet::callback, this, _1, i), "raw",
+        rmw_qos_profile_sensor_data);
+    }
   }
 }
 
-void TensorrtYoloNodelet::callback(const sensor_msgs::msg::Image::ConstSharedPtr in_image_msg)
+void TensorrtYoloNodelet::callback(
+  const sensor_msgs::msg::Image::ConstSharedPtr in_image_msg, const size_t camera_id)
 {
-  using Label = autoware_auto_perception_msgs::msg::ObjectClassification;
+  pending_images_[camera_id] = in_image_msg;
 
-  tier4_perception_msgs::msg::DetectedObjectsWithFeature out_objects;
+  // the batch runs as soon as every camera has an image, or once the oldest image waited for
+  // more than batch_time_window, so that a dropped or late camera only delays the others that much
+  const rclcpp::Time stamp(in_image_msg->header.stamp);
+  bool is_complete = true;
+  bool is_expired = false;
+  std::vector<size_t> camera_ids;
+  for (size_t i = 0; i < pending_images_.size(); ++i) {
+    if (!pending_images_[i]) {
+      is_complete = false;
+      continue;
+    }
+    camera_ids.push_back(i);
+    const rclcpp::Time pending_stamp(pending_images_[i]->header.stamp);
+    is_expired |= (stamp - pending_stamp).seconds() > batch_time_window_;
+  }
+  if (is_complete || is_expired) {
+    detect(camera_ids);
+  }
+}
 
-  cv_bridge::CvImagePtr in_image_ptr;
-  try {
-    in_image_ptr = cv_bridge::toCvCopy(in_image_msg, sensor_msgs::image_encodings::BGR8);
-  } catch (cv_bridge::Exception & e) {
-    RCLCPP_ERROR(this->get_logger(), "cv_bridge exception: %s", e.what());
+void TensorrtYoloNodelet::detect(const std::vector<size_t> & camera_ids)
+{
+  using Label = autoware_auto_perception_msgs::msg::ObjectClassification;
+
+  std::vector<cv_bridge::CvImagePtr> in_image_ptrs;
+  std::vector<sensor_msgs::msg::Image::ConstSharedPtr> in_image_msgs;
+  std::vector<size_t> batch_camera_ids;
+  std::vector<cv::Mat> in_imgs;
+  for (const auto camera_id : camera_ids) {
+    const auto in_image_msg = pending_images_[camera_id];
+    pending_images_[camera_id].reset();
+    cv_bridge::CvImagePtr in_image_ptr;
+    try {
+      in_image_ptr = cv_bridge::toCvCopy(in_image_msg, sensor_msgs::image_encodings::BGR8);
+    } catch (cv_bridge::Exception & e) {
+      RCLCPP_ERROR(this->get_logger(), "cv_bridge exception: %s", e.what());
+      continue;
+    }
+    in_image_ptrs.push_back(in_image_ptr);
+    in_image_msgs.push_back(in_image_msg);
+    batch_camera_ids.push_back(camera_id);
+    in_imgs.push_back(in_image_ptr->image);
+  }
+  if (in_imgs.empty()) {
     return;
   }
-  if (!net_ptr_->detect(
-        in_image_ptr->image, out_scores_.get(), out_boxes_.get(), out_classes_.get())) {
+  if (!net_ptr_->detect(in_imgs, out_scores_.get(), out_boxes_.get(), out_classes_.get())) {
     RCLCPP_WARN(this->get_logger(), "Fail to inference");
     return;
   }
-  const auto width = in_image_ptr->image.cols;
-  const auto height = in_image_ptr->image.rows;
-  for (int i = 0; i < yolo_config_.detections_per_im; ++i) {
-    if (out_scores_[i] < yolo_config_.ignore_thresh) {
-      break;
-    }
-    tier4_perception_msgs::msg::DetectedObjectWithFeature object;
-    object.feature.roi.x_offset = out_boxes_[4 * i] * width;
-    object.feature.roi.y_offset = out_boxes_[4 * i + 1] * height;
-    object.feature.roi.width = out_boxes_[4 * i + 2] * width;
-    object.feature.roi.height = out_boxes_[4 * i + 3] * height;
-    object.object.classification.emplace_back(autoware_auto_perception_msgs::build<Label>()
-                                                .label(Label::UNKNOWN)
-                                                .probability(out_scores_[i]));
-    const auto class_id = static_cast<int>(out_classes_[i]);
-    if (labels_[class_id] == "car") {
-      object.object.classification.front().label = Label::CAR;
-    } else if (labels_[class_id] == "person") {
-      object.object.classification.front().label = Label::PEDESTRIAN;
-    } else if (labels_[class_id] == "bus") {
-      object.object.classification.front().label = Label::BUS;
-    } else if (labels_[class_id] == "truck") {
-      object.object.classification.front().label = Label::TRUCK;
-    } else if (labels_[class_id] == "bicycle") {
-      object.object.classification.front().label = Label::BICYCLE;
-    } else if (labels_[class_id] == "motorbike") {
-      object.object.classification.front().label = Label::MOTORCYCLE;
-    } else {
-      object.object.classification.front().label = Label::UNKNOWN;
+
+  for (size_t b = 0; b < in_imgs.size(); ++b) {
+    tier4_perception_msgs::msg::DetectedObjectsWithFeature out_objects;
+    const auto & in_image_ptr = in_image_ptrs[b];
+    const auto width = in_image_ptr->image.cols;
+    const auto height = in_image_ptr->image.rows;
+    const int offset = static_cast<int>(b) * net_ptr_->getMaxDetections();
+    const auto * scores = out_scores_.get() + offset;
+    const auto * boxes = out_boxes_.get() + 4 * offset;
+    const auto * classes = out_classes_.get() + offset;
+    for (int i = 0; i < yolo_config_.detections_per_im; ++i) {
+      if (scores[i] < yolo_config_.ignore_thresh) {
+        break;
+      }
+      tier4_perception_msgs::msg::DetectedObjectWithFeature object;
+      object.feature.roi.x_offset = boxes[4 * i] * width;
+      object.feature.roi.y_offset = boxes[4 * i + 1] * height;
+      object.feature.roi.width = boxes[4 * i + 2] * width;
+      object.feature.roi.height = boxes[4 * i + 3] * height;
+      object.object.classification.emplace_back(
+        autoware_auto_perception_msgs::build<Label>().label(Label::UNKNOWN).probability(scores[i]));
+      const auto class_id = static_cast<int>(classes[i]);
+      if (labels_[class_id] == "car") {
+        object.object.classification.front().label = Label::CAR;
+      } else if (labels_[class_id] == "person") {
+        object.object.classification.front().label = Label::PEDESTRIAN;
+      } else if (labels_[class_id] == "bus") {
+        object.object.classification.front().label = Label::BUS;
+      } else if (labels_[class_id] == "truck") {
+        object.object.classification.front().label = Label::TRUCK;
+      } else if (labels_[class_id] == "bicycle") {
+        object.object.classification.front().label = Label::BICYCLE;
+      } else if (labels_[class_id] == "motorbike") {
+        object.object.classification.front().label = Label::MOTORCYCLE;
+      } else {
+        object.object.classification.front().label = Label::UNKNOWN;
+      }
+      out_objects.feature_objects.push_back(object);
+      const auto left = std::max(0, static_cast<int>(object.feature.roi.x_offset));
+      const auto top = std::max(0, static_cast<int>(object.feature.roi.y_offset));
+      const auto right =
+        std::min(static_cast<int>(object.feature.roi.x_offset + object.feature.roi.width), width);
+      const auto bottom =
+        std::min(static_cast<int>(object.feature.roi.y_offset + object.feature.roi.height), height);
+      cv::rectangle(
+        in_image_ptr->image, cv::Point(left, top), cv::Point(right, bottom), cv::Scalar(0, 0, 255),
+        3, 8, 0);
     }
-    out_objects.feature_objects.push_back(object);
-    const auto left = std::max(0, static_cast<int>(object.feature.roi.x_offset));
-    const auto top = std::max(0, static_cast<int>(object.feature.roi.y_offset));
-    const auto right =
-      std::min(static_cast<int>(object.feature.roi.x_offset + object.feature.roi.width), width);
-    const auto bottom =
-      std::min(static_cast<int>(object.feature.roi.y_offset + object.feature.roi.height), height);
-    cv::rectangle(
-      in_image_ptr->image, cv::Point(left, top), cv::Point(right, bottom), cv::Scalar(0, 0, 255), 3,
-      8, 0);
-  }
-  image_pub_.publish(in_image_ptr->toImageMsg());
-
-  out_objects.header = in_image_msg->header;
-  objects_pub_->publish(out_objects);
+    const auto camera_id = batch_camera_ids[b];
+    image_pubs_[camera_id].publish(in_image_ptr->toImageMsg());
+
+    out_objects.header = in_image_msgs[b]->header;
+    objects_pubs_[camera_id]->publish(out_objects);
+  }
 }
 
 bool TensorrtYoloNodelet::readLabelFile(
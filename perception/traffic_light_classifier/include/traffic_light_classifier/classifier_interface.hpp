@@ -30,6 +30,20 @@ public:
   virtual bool getTrafficSignal(
     const cv::Mat & input_image,
     autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal) = 0;
+
+  // classify the images of one camera frame at once, one image at a time unless overridden
+  virtual bool getTrafficSignals(
+    const std::vector<cv::Mat> & input_images,
+    std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> & traffic_signals)
+  {
+    traffic_signals.assign(input_images.size(), {});
+    for (size_t i = 0; i < input_images.size(); ++i) {
+      if (!getTrafficSignal(input_images[i], traffic_signals[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
 };
 }  // namespace traffic_light
 
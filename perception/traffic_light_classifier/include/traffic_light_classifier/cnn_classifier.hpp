@@ -21,6 +21,7 @@
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <preprocess.hpp>
 #include <trt_common.hpp>
 
 #include <autoware_auto_perception_msgs/msg/traffic_light.hpp>
@@ -43,9 +44,12 @@ public:
   bool getTrafficSignal(
     const cv::Mat & input_image,
     autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal) override;
+  // the images are classified in batches of up to max_batch_size
+  bool getTrafficSignals(
+    const std::vector<cv::Mat> & input_images,
+    std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> & traffic_signals) override;
 
 private:
-  void preProcess(cv::Mat & image, std::vector<float> & tensor, bool normalize = true);
   bool postProcess(
     std::vector<float> & output_data_host,
     autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal);
@@ -99,6 +103,11 @@ private:
   rclcpp::Node * node_ptr_;
 
   std::shared_ptr<Tn::TrtCommon> trt_;
+  Tn::UniquePtr<float[]> input_data_device_;
+  Tn::UniquePtr<float[]> output_data_device_;
+  // the raw rois of a batch, grown to the largest batch seen
+  Tn::UniquePtr<uint8_t[]> image_data_device_;
+  size_t image_data_device_size_{0};
   image_transport::Publisher image_pub_;
   std::vector<std::string> labels_;
   std::vector<float> mean_{0.242, 0.193, 0.201};
@@ -19,6 +19,7 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -39,52 +40,111 @@ CNNClassifier::CNNClassifier(rclcpp::Node * node_ptr) : node_ptr_(node_ptr)
   input_c_ = node_ptr_->declare_parameter("input_c", 3);
   input_h_ = node_ptr_->declare_parameter("input_h", 224);
   input_w_ = node_ptr_->declare_parameter("input_w", 224);
+  const int max_batch_size = node_ptr_->declare_parameter("max_batch_size", 8);
 
   readLabelfile(label_file_path, labels_);
 
-  trt_ = std::make_shared<Tn::TrtCommon>(model_file_path, precision);
+  trt_ = std::make_shared<Tn::TrtCommon>(model_file_path, precision, max_batch_size);
   trt_->setup();
 }
 
 bool CNNClassifier::getTrafficSignal(
   const cv::Mat & input_image, autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal)
+{
+  std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> traffic_signals;
+  if (!getTrafficSignals({input_image}, traffic_signals)) {
+    return false;
+  }
+  traffic_signal.lights.insert(
+    traffic_signal.lights.end(), traffic_signals.front().lights.begin(),
+    traffic_signals.front().lights.end());
+  return true;
+}
+
+bool CNNClassifier::getTrafficSignals(
+  const std::vector<cv::Mat> & input_images,
+  std::vector<autoware_auto_perception_msgs::msg::TrafficSignal> & traffic_signals)
 {
   if (!trt_->isInitialized()) {
     RCLCPP_WARN(node_ptr_->get_logger(), "failed to init tensorrt");
     return false;
   }
 
-  int num_input = trt_->getNumInput();
-  int num_output = trt_->getNumOutput();
-
-  std::vector<float> input_data_host(num_input);
+  // only the 8-bit rois are uploaded, resized and normalized on the device
+  for (const auto & input_image : input_images) {
+    if (input_image.type() != CV_8UC3 || input_image.empty()) {
+      RCLCPP_WARN(node_ptr_->get_logger(), "input image must be a non-empty rgb8 image");
+      return false;
+    }
+  }
 
-  cv::Mat image = input_image.clone();
-  preProcess(image, input_data_host, true);
+  const int num_input = trt_->getNumInput();
+  const int num_output = trt_->getNumOutput();
+  const int max_batch_size = trt_->getMaxBatchSize();
+  if (!input_data_device_) {
+    input_data_device_ = Tn::make_unique<float[]>(num_input * max_batch_size);
+    output_data_device_ = Tn::make_unique<float[]>(num_output * max_batch_size);
+  }
 
-  auto input_data_device = Tn::make_unique<float[]>(num_input);
-  cudaMemcpy(
-    input_data_device.get(), input_data_host.data(), num_input * sizeof(float),
-    cudaMemcpyHostToDevice);
+  traffic_signals.assign(input_images.size(), {});
+  std::vector<float> output_data_host(num_output * max_batch_size);
+  for (size_t batch_begin = 0; batch_begin < input_images.size(); batch_begin += max_batch_size) {
+    const size_t batch_end =
+      std::min(batch_begin + static_cast<size_t>(max_batch_size), input_images.size());
+    // an engine without a dynamic batch runs on the whole batch, the unused outputs are skipped
+    const int batch_size =
+      trt_->isDynamicBatch() ? static_cast<int>(batch_end - batch_begin) : max_batch_size;
+    if (!trt_->setBatchSize(batch_size)) {
+      RCLCPP_WARN(node_ptr_->get_logger(), "failed to set the batch size to %d", batch_size);
+      return false;
+    }
 
-  auto output_data_device = Tn::make_unique<float[]>(num_output);
+    std::vector<size_t> image_offsets{0U};
+    for (size_t i = batch_begin; i < batch_end; ++i) {
+      const auto & input_image = input_images.at(i);
+      image_offsets.push_back(
+        image_offsets.back() + input_image.cols * input_image.elemSize() * input_image.rows);
+    }
+    if (image_data_device_size_ < image_offsets.back()) {
+      image_data_device_ = Tn::make_unique<uint8_t[]>(image_offsets.back());
+      image_data_device_size_ = image_offsets.back();
+    }
+    for (size_t i = batch_begin; i < batch_end; ++i) {
+      const auto & input_image = input_images.at(i);
+      const size_t row_size = input_image.cols * input_image.elemSize();
+      uint8_t * image_data_device = image_data_device_.get() + image_offsets[i - batch_begin];
+      CHECK_CUDA_ERROR(cudaMemcpy2D(
+        image_data_device, row_size, input_image.data, input_image.step, row_size,
+        input_image.rows, cudaMemcpyHostToDevice));
+      CHECK_CUDA_ERROR(Tn::resizeAndNormalize_launch(
+        image_data_device, input_image.cols, input_image.rows, row_size,
+        input_data_device_.get() + (i - batch_begin) * num_input, input_w_, input_h_,
+        make_float3(mean_[0], mean_[1], mean_[2]), make_float3(std_[0], std_[1], std_[2]),
+        nullptr));
+    }
 
-  // do inference
-  std::vector<void *> bindings = {input_data_device.get(), output_data_device.get()};
+    // do inference
+    std::vector<void *> bindings = {input_data_device_.get(), output_data_device_.get()};
 
-  trt_->context_->executeV2(bindings.data());
+    trt_->context_->executeV2(bindings.data());
 
-  std::vector<float> output_data_host(num_output);
-  cudaMemcpy(
-    output_data_host.data(), output_data_device.get(), num_output * sizeof(float),
-    cudaMemcpyDeviceToHost);
+    cudaMemcpy(
+      output_data_host.data(), output_data_device_.get(),
+      num_output * (batch_end - batch_begin) * sizeof(float), cudaMemcpyDeviceToHost);
 
-  postProcess(output_data_host, traffic_signal);
+    for (size_t i = batch_begin; i < batch_end; ++i) {
+      const auto output_begin = output_data_host.begin() + (i - batch_begin) * num_output;
+      std::vector<float> output_tensor(output_begin, output_begin + num_output);
+      postProcess(output_tensor, traffic_signals.at(i));
+    }
+  }
 
   /* debug */
   if (0 < image_pub_.getNumSubscribers()) {
-    cv::Mat debug_image = input_image.clone();
-    outputDebugImage(debug_image, traffic_signal);
+    for (size_t i = 0; i < input_images.size(); ++i) {
+      cv::Mat debug_image = input_images.at(i).clone();
+      outputDebugImage(debug_image, traffic_signals.at(i));
+    }
   }
 
   return true;
@@ -122,35 +182,6 @@ void CNNClassifier::outputDebugImage(
   image_pub_.publish(debug_image_msg);
 }
 
-void CNNClassifier::preProcess(cv::Mat & image, std::vector<float> & input_tensor, bool normalize)
-{
-  /* normalize */
-  /* ((channel[0] / 255) - mean[0]) / std[0] */
-
-  // cv::cvtColor(image, image, cv::COLOR_BGR2RGB, 3);
-  cv::resize(image, image, cv::Size(input_w_, input_h_));
-
-  const size_t strides_cv[3] = {
-    static_cast<size_t>(input_w_ * input_c_), static_cast<size_t>(input_c_), 1};
-  const size_t strides[3] = {
-    static_cast<size_t>(input_h_ * input_w_), static_cast<size_t>(input_w_), 1};
-
-  for (int i = 0; i < input_h_; i++) {
-    for (int j = 0; j < input_w_; j++) {
-      for (int k = 0; k < input_c_; k++) {
-        const size_t offset_cv = i * strides_cv[0] + j * strides_cv[1] + k * strides_cv[2];
-        const size_t offset = k * strides[0] + i * strides[1] + j * strides[2];
-        if (normalize) {
-          input_tensor[offset] =
-            ((static_cast<float>(image.data[offset_cv]) / 255) - mean_[k]) / std_[k];
-        } else {
-          input_tensor[offset] = static_cast<float>(image.data[offset_cv]);
-        }
-      }
-    }
-  }
-}
-
 bool CNNClassifier::postProcess(
   std::vector<float> & output_tensor,
   autoware_auto_perception_msgs::msg::TrafficSignal & traffic_signal)
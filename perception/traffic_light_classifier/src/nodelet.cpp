@@ -91,18 +91,20 @@ void TrafficLightClassifierNodelet::imageRoiCallback(
 
   autoware_auto_perception_msgs::msg::TrafficSignalArray output_msg;
 
-  for (size_t i = 0; i < input_rois_msg->rois.size(); ++i) {
-    const sensor_msgs::msg::RegionOfInterest & roi = input_rois_msg->rois.at(i).roi;
-    cv::Mat clipped_image(
+  // all the rois of the image are classified at once
+  std::vector<cv::Mat> clipped_images;
+  clipped_images.reserve(input_rois_msg->rois.size());
+  for (const auto & tl_roi : input_rois_msg->rois) {
+    const sensor_msgs::msg::RegionOfInterest & roi = tl_roi.roi;
+    clipped_images.emplace_back(
       cv_ptr->image, cv::Rect(roi.x_offset, roi.y_offset, roi.width, roi.height));
-
-    autoware_auto_perception_msgs::msg::TrafficSignal traffic_signal;
-    traffic_signal.map_primitive_id = input_rois_msg->rois.at(i).id;
-    if (!classifier_ptr_->getTrafficSignal(clipped_image, traffic_signal)) {
-      RCLCPP_ERROR(this->get_logger(), "failed classify image, abort callback");
-      return;
-    }
-    output_msg.signals.push_back(traffic_signal);
+  }
+  if (!classifier_ptr_->getTrafficSignals(clipped_images, output_msg.signals)) {
+    RCLCPP_ERROR(this->get_logger(), "failed classify image, abort callback");
+    return;
+  }
+  for (size_t i = 0; i < input_rois_msg->rois.size(); ++i) {
+    output_msg.signals.at(i).map_primitive_id = input_rois_msg->rois.at(i).id;
   }
 
   output_msg.header = input_image_msg->header;
@@ -0,0 +1,71 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <preprocess.hpp>
+
+namespace Tn
+{
+namespace
+{
+constexpr int THREADS_X = 32;
+constexpr int THREADS_Y = 8;
+}  // namespace
+
+__global__ void resizeAndNormalizeKernel(
+  const uint8_t * src, const int src_w, const int src_h, const int src_step, float * dst,
+  const int dst_w, const int dst_h, const float scale_x, const float scale_y, const float3 mean,
+  const float3 std)
+{
+  const int x = blockIdx.x * blockDim.x + threadIdx.x;
+  const int y = blockIdx.y * blockDim.y + threadIdx.y;
+  if (x >= dst_w || y >= dst_h) {
+    return;
+  }
+
+  // pixel centers aligned as in cv::INTER_LINEAR
+  const float src_x = fmaxf((x + 0.5f) * scale_x - 0.5f, 0.0f);
+  const float src_y = fmaxf((y + 0.5f) * scale_y - 0.5f, 0.0f);
+  const int x0 = min(static_cast<int>(src_x), src_w - 1);
+  const int y0 = min(static_cast<int>(src_y), src_h - 1);
+  const int x1 = min(x0 + 1, src_w - 1);
+  const int y1 = min(y0 + 1, src_h - 1);
+  const float wx = src_x - x0;
+  const float wy = src_y - y0;
+
+  const uint8_t * row0 = src + y0 * src_step;
+  const uint8_t * row1 = src + y1 * src_step;
+  const float means[3] = {mean.x, mean.y, mean.z};
+  const float stds[3] = {std.x, std.y, std.z};
+  const int area = dst_w * dst_h;
+  for (int c = 0; c < 3; ++c) {
+    const float top = row0[x0 * 3 + c] + wx * (row0[x1 * 3 + c] - row0[x0 * 3 + c]);
+    const float bottom = row1[x0 * 3 + c] + wx * (row1[x1 * 3 + c] - row1[x0 * 3 + c]);
+    // rounded to 8 bits as the resized cv::Mat was
+    const float value = rintf(top + wy * (bottom - top));
+    dst[c * area + y * dst_w + x] = (value / 255.0f - means[c]) / stds[c];
+  }
+}
+
+cudaError_t resizeAndNormalize_launch(
+  const uint8_t * src, const int src_w, const int src_h, const int src_step, float * dst,
+  const int dst_w, const int dst_h, const float3 mean, const float3 std, cudaStream_t stream)
+{
+  const dim3 threads(THREADS_X, THREADS_Y);
+  const dim3 blocks((dst_w + THREADS_X - 1) / THREADS_X, (dst_h + THREADS_Y - 1) / THREADS_Y);
+  resizeAndNormalizeKernel<<<blocks, threads, 0, stream>>>(
+    src, src_w, src_h, src_step, dst, dst_w, dst_h, static_cast<float>(src_w) / dst_w,
+    static_cast<float>(src_h) / dst_h, mean, std);
+  return cudaGetLastError();
+}
+}  // namespace Tn
@@ -0,0 +1,31 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PERCEPTION__TRAFFIC_LIGHT_CLASSIFIER__UTILS__PREPROCESS_HPP_
+#define PERCEPTION__TRAFFIC_LIGHT_CLASSIFIER__UTILS__PREPROCESS_HPP_
+
+#include <cuda_runtime_api.h>
+
+#include <cstdint>
+
+namespace Tn
+{
+// Resize an 8-bit 3 channel image on the device with bilinear interpolation as cv::resize does,
+// and write ((channel / 255) - mean) / std to the network input, channel first
+cudaError_t resizeAndNormalize_launch(
+  const uint8_t * src, const int src_w, const int src_h, const int src_step, float * dst,
+  const int dst_w, const int dst_h, const float3 mean, const float3 std, cudaStream_t stream);
+}  // namespace Tn
+
+#endif  // PERCEPTION__TRAFFIC_LIGHT_CLASSIFIER__UTILS__PREPROCESS_HPP_
@@ -37,11 +37,13 @@ void check_error(const ::cudaError_t e, decltype(__FILE__) f, decltype(__LINE__)
   }
 }
 
-TrtCommon::TrtCommon(std::string model_path, std::string precision)
+TrtCommon::TrtCommon(std::string model_path, std::string precision, int max_batch_size)
 : model_file_path_(model_path),
   precision_(precision),
   input_name_("input_0"),
   output_name_("output_0"),
+  max_batch_size_(max_batch_size),
+  is_dynamic_batch_(false),
   is_initialized_(false)
 {
   runtime_ = UniquePtr<nvinfer1::IRuntime>(nvinfer1::createInferRuntime(logger_));
@@ -60,7 +62,18 @@ void TrtCommon::setup()
       cache_engine_path.replace_extension("engine");
       if (fs::exists(cache_engine_path)) {
         loadEngine(cache_engine_path.string());
-      } else {
+      }
+      // the cached engine is rebuilt when its dynamic batch does not match the max batch size
+      const auto is_cache_valid = [this]() {
+        if (!engine_) {
+          return false;
+        }
+        const int index = getInputBindingIndex();
+        return engine_->getBindingDimensions(index).d[0] != -1 ||
+               engine_->getProfileDimensions(index, 0, nvinfer1::OptProfileSelector::kMAX).d[0] ==
+                 max_batch_size_;
+      };
+      if (!is_cache_valid()) {
         logger_.log(nvinfer1::ILogger::Severity::kINFO, "start build engine");
         buildEngineFromOnnx(model_file_path_, cache_engine_path.string());
         logger_.log(nvinfer1::ILogger::Severity::kINFO, "end build engine");
@@ -77,6 +90,14 @@ void TrtCommon::setup()
   context_ = UniquePtr<nvinfer1::IExecutionContext>(engine_->createExecutionContext());
   input_dims_ = engine_->getBindingDimensions(getInputBindingIndex());
   output_dims_ = engine_->getBindingDimensions(getOutputBindingIndex());
+  is_dynamic_batch_ = input_dims_.d[0] == -1;
+  if (is_dynamic_batch_) {
+    max_batch_size_ =
+      engine_->getProfileDimensions(getInputBindingIndex(), 0, nvinfer1::OptProfileSelector::kMAX)
+        .d[0];
+  } else {
+    max_batch_size_ = input_dims_.d[0];
+  }
   is_initialized_ = true;
 }
 
@@ -105,6 +126,19 @@ bool TrtCommon::buildEngineFromOnnx(std::string onnx_file_path, std::string outp
     return false;
   }
 
+  // a dynamic batch runs from 1 to max_batch_size_ images
+  nvinfer1::ITensor * input = network->getInput(0);
+  nvinfer1::Dims input_dims = input->getDimensions();
+  if (input_dims.d[0] == -1) {
+    auto profile = builder->createOptimizationProfile();
+    input_dims.d[0] = 1;
+    profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMIN, input_dims);
+    input_dims.d[0] = max_batch_size_;
+    profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kOPT, input_dims);
+    profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMAX, input_dims);
+    config->addOptimizationProfile(profile);
+  }
+
 #if (NV_TENSORRT_MAJOR * 1000) + (NV_TENSORRT_MINOR * 100) + NV_TENSOR_PATCH >= 8400
   config->setMemoryPoolLimit(nvinfer1::MemoryPoolType::kWORKSPACE, 16 << 20);
 #else
@@ -146,13 +180,30 @@ bool TrtCommon::isInitialized() { return is_initialized_; }
 int TrtCommon::getNumInput()
 {
   return std::accumulate(
-    input_dims_.d, input_dims_.d + input_dims_.nbDims, 1, std::multiplies<int>());
+    input_dims_.d + 1, input_dims_.d + input_dims_.nbDims, 1, std::multiplies<int>());
 }
 
 int TrtCommon::getNumOutput()
 {
   return std::accumulate(
-    output_dims_.d, output_dims_.d + output_dims_.nbDims, 1, std::multiplies<int>());
+    output_dims_.d + 1, output_dims_.d + output_dims_.nbDims, 1, std::multiplies<int>());
+}
+
+bool TrtCommon::isDynamicBatch() { return is_dynamic_batch_; }
+
+int TrtCommon::getMaxBatchSize() { return max_batch_size_; }
+
+bool TrtCommon::setBatchSize(int batch_size)
+{
+  if (!is_dynamic_batch_) {
+    return batch_size == max_batch_size_;
+  }
+  if (batch_size < 1 || max_batch_size_ < batch_size) {
+    return false;
+  }
+  nvinfer1::Dims input_dims = input_dims_;
+  input_dims.d[0] = batch_size;
+  return context_->setBindingDimensions(getInputBindingIndex(), input_dims);
 }
 
 int TrtCommon::getInputBindingIndex() { return engine_->getBindingIndex(input_name_.c_str()); }
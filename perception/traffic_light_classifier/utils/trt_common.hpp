@@ -108,7 +108,7 @@ Tn::UniquePtr<T> make_unique()
 class TrtCommon
 {
 public:
-  TrtCommon(std::string model_path, std::string precision);
+  TrtCommon(std::string model_path, std::string precision, int max_batch_size = 1);
   ~TrtCommon() {}
 
   bool loadEngine(std::string engine_file_path);
@@ -116,8 +116,14 @@ public:
   void setup();
 
   bool isInitialized();
+  // sizes of the input and the output of one image of a batch
   int getNumInput();
   int getNumOutput();
+  // an engine built from an onnx with a dynamic batch runs any batch up to the max batch size,
+  // the other ones always run on max batch size images
+  bool isDynamicBatch();
+  int getMaxBatchSize();
+  bool setBatchSize(int batch_size);
   int getInputBindingIndex();
   int getOutputBindingIndex();
 
@@ -135,6 +141,8 @@ private:
   std::string precision_;
   std::string input_name_;
   std::string output_name_;
+  int max_batch_size_;
+  bool is_dynamic_batch_;
   bool is_initialized_;
 };
 
@@ -81,6 +81,21 @@ private:
     }
   };
 
+  // the traffic lights of a set in id order, bucketed by the xy position of their central point
+  struct TrafficLightGrid
+  {
+    double cell_size{1.0};
+    double min_x{0.0};
+    double min_y{0.0};
+    int width{0};
+    int height{0};
+    std::vector<lanelet::ConstLineString3d> traffic_lights;
+    // the lights of the cell i are cell_traffic_lights[cell_offsets[i], cell_offsets[i + 1]),
+    // as indices into traffic_lights
+    std::vector<size_t> cell_offsets;
+    std::vector<size_t> cell_traffic_lights;
+  };
+
 private:
   rclcpp::Subscription<autoware_auto_mapping_msgs::msg::HADMapBin>::SharedPtr map_sub_;
   rclcpp::Subscription<sensor_msgs::msg::CameraInfo>::SharedPtr camera_info_sub_;
@@ -96,6 +111,13 @@ private:
 
   std::shared_ptr<TrafficLightSet> all_traffic_lights_ptr_;
   std::shared_ptr<TrafficLightSet> route_traffic_lights_ptr_;
+  TrafficLightGrid all_traffic_lights_grid_;
+  TrafficLightGrid route_traffic_lights_grid_;
+
+  // the lights around the last query position, reused while the camera stays close to it
+  const TrafficLightGrid * candidate_grid_{nullptr};
+  geometry_msgs::msg::Point candidate_query_position_;
+  std::vector<lanelet::ConstLineString3d> candidate_traffic_lights_;
 
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::traffic_rules::TrafficRulesPtr traffic_rules_ptr_;
@@ -105,8 +127,12 @@ private:
   void mapCallback(const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr input_msg);
   void cameraInfoCallback(const sensor_msgs::msg::CameraInfo::ConstSharedPtr input_msg);
   void routeCallback(const autoware_auto_planning_msgs::msg::HADMapRoute::ConstSharedPtr input_msg);
+  void buildTrafficLightGrid(const TrafficLightSet & traffic_lights, TrafficLightGrid & grid) const;
+  const std::vector<lanelet::ConstLineString3d> & queryCandidateTrafficLights(
+    const TrafficLightGrid & grid, const geometry_msgs::msg::Point & camera_position);
   void getVisibleTrafficLights(
-    const TrafficLightSet & all_traffic_lights, const geometry_msgs::msg::Pose & camera_pose,
+    const std::vector<lanelet::ConstLineString3d> & all_traffic_lights,
+    const geometry_msgs::msg::Pose & camera_pose,
     const image_geometry::PinholeCameraModel & pinhole_camera_model,
     std::vector<lanelet::ConstLineString3d> & visible_traffic_lights);
   bool isInDistanceRange(
@@ -50,8 +50,12 @@
 #include <tf2/LinearMath/Transform.h>
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <utility>
 #include <vector>
 
 #define EIGEN_MPL2_ONLY
@@ -84,6 +88,12 @@ void roundInImageFrame(
   point.y =
     std::max(std::min(point.y, static_cast<double>(static_cast<int>(camera_info.height) - 1)), 0.0);
 }
+
+constexpr double max_distance_range = 200.0;
+constexpr double traffic_light_grid_cell_size = 50.0;
+// the candidates are queried with this margin, so that they stay valid until the camera moved
+// this much from the query position
+constexpr double candidate_update_distance = 10.0;
 }  // namespace
 
 namespace traffic_light
@@ -155,13 +165,13 @@ void MapBasedDetector::cameraInfoCallback(
   // If get a route, use only traffic lights on the route.
   if (route_traffic_lights_ptr_ != nullptr) {
     getVisibleTrafficLights(
-      *route_traffic_lights_ptr_, camera_pose_stamped.pose, pinhole_camera_model,
-      visible_traffic_lights);
+      queryCandidateTrafficLights(route_traffic_lights_grid_, camera_pose_stamped.pose.position),
+      camera_pose_stamped.pose, pinhole_camera_model, visible_traffic_lights);
     // If don't get a route, use the traffic lights around ego vehicle.
   } else if (all_traffic_lights_ptr_ != nullptr) {
     getVisibleTrafficLights(
-      *all_traffic_lights_ptr_, camera_pose_stamped.pose, pinhole_camera_model,
-      visible_traffic_lights);
+      queryCandidateTrafficLights(all_traffic_lights_grid_, camera_pose_stamped.pose.position),
+      camera_pose_stamped.pose, pinhole_camera_model, visible_traffic_lights);
     // This shouldn't run.
   } else {
     return;
@@ -287,6 +297,8 @@ void MapBasedDetector::mapCallback(
       all_traffic_lights_ptr_->insert(static_cast<lanelet::ConstLineString3d>(lsp));
     }
   }
+  buildTrafficLightGrid(*all_traffic_lights_ptr_, all_traffic_lights_grid_);
+  candidate_grid_ = nullptr;
 }
 
 void MapBasedDetector::routeCallback(
@@ -322,10 +334,108 @@ void MapBasedDetector::routeCallback(
       route_traffic_lights_ptr_->insert(static_cast<lanelet::ConstLineString3d>(lsp));
     }
   }
+  buildTrafficLightGrid(*route_traffic_lights_ptr_, route_traffic_lights_grid_);
+  candidate_grid_ = nullptr;
+}
+
+void MapBasedDetector::buildTrafficLightGrid(
+  const TrafficLightSet & traffic_lights, TrafficLightGrid & grid) const
+{
+  grid = TrafficLightGrid{};
+  grid.cell_size = traffic_light_grid_cell_size;
+  grid.traffic_lights.assign(traffic_lights.begin(), traffic_lights.end());
+  if (grid.traffic_lights.empty()) {
+    return;
+  }
+
+  std::vector<std::pair<double, double>> central_points;
+  central_points.reserve(grid.traffic_lights.size());
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  grid.min_x = std::numeric_limits<double>::max();
+  grid.min_y = std::numeric_limits<double>::max();
+  for (const auto & traffic_light : grid.traffic_lights) {
+    const double x = (traffic_light.back().x() + traffic_light.front().x()) / 2.0;
+    const double y = (traffic_light.back().y() + traffic_light.front().y()) / 2.0;
+    central_points.emplace_back(x, y);
+    grid.min_x = std::min(grid.min_x, x);
+    grid.min_y = std::min(grid.min_y, y);
+    max_x = std::max(max_x, x);
+    max_y = std::max(max_y, y);
+  }
+  grid.width = static_cast<int>(std::floor((max_x - grid.min_x) / grid.cell_size)) + 1;
+  grid.height = static_cast<int>(std::floor((max_y - grid.min_y) / grid.cell_size)) + 1;
+
+  // counting sort of the lights by cell, which keeps them in id order within a cell
+  std::vector<size_t> cells(central_points.size());
+  grid.cell_offsets.assign(static_cast<size_t>(grid.width) * grid.height + 1, 0U);
+  for (size_t i = 0; i < central_points.size(); ++i) {
+    const int cx = std::min(
+      static_cast<int>((central_points[i].first - grid.min_x) / grid.cell_size), grid.width - 1);
+    const int cy = std::min(
+      static_cast<int>((central_points[i].second - grid.min_y) / grid.cell_size), grid.height - 1);
+    cells[i] = static_cast<size_t>(cy) * grid.width + cx;
+    ++grid.cell_offsets[cells[i] + 1];
+  }
+  std::partial_sum(grid.cell_offsets.begin(), grid.cell_offsets.end(), grid.cell_offsets.begin());
+  std::vector<size_t> next_offsets(grid.cell_offsets.begin(), grid.cell_offsets.end() - 1);
+  grid.cell_traffic_lights.resize(central_points.size());
+  for (size_t i = 0; i < central_points.size(); ++i) {
+    grid.cell_traffic_lights[next_offsets[cells[i]]++] = i;
+  }
+}
+
+const std::vector<lanelet::ConstLineString3d> & MapBasedDetector::queryCandidateTrafficLights(
+  const TrafficLightGrid & grid, const geometry_msgs::msg::Point & camera_position)
+{
+  if (
+    candidate_grid_ == &grid &&
+    std::hypot(
+      camera_position.x - candidate_query_position_.x,
+      camera_position.y - candidate_query_position_.y) < candidate_update_distance) {
+    return candidate_traffic_lights_;
+  }
+  candidate_grid_ = &grid;
+  candidate_query_position_ = camera_position;
+  candidate_traffic_lights_.clear();
+  if (grid.traffic_lights.empty()) {
+    return candidate_traffic_lights_;
+  }
+
+  // every light within max_distance_range of a camera closer than candidate_update_distance to
+  // the query position is in the cells overlapping this square
+  const double radius = max_distance_range + candidate_update_distance;
+  const int x_begin = std::max(
+    static_cast<int>(std::floor((camera_position.x - radius - grid.min_x) / grid.cell_size)), 0);
+  const int x_end = std::min(
+    static_cast<int>(std::floor((camera_position.x + radius - grid.min_x) / grid.cell_size)),
+    grid.width - 1);
+  const int y_begin = std::max(
+    static_cast<int>(std::floor((camera_position.y - radius - grid.min_y) / grid.cell_size)), 0);
+  const int y_end = std::min(
+    static_cast<int>(std::floor((camera_position.y + radius - grid.min_y) / grid.cell_size)),
+    grid.height - 1);
+
+  std::vector<size_t> indices;
+  for (int cy = y_begin; cy <= y_end; ++cy) {
+    for (int cx = x_begin; cx <= x_end; ++cx) {
+      const size_t cell = static_cast<size_t>(cy) * grid.width + cx;
+      indices.insert(
+        indices.end(), grid.cell_traffic_lights.begin() + grid.cell_offsets[cell],
+        grid.cell_traffic_lights.begin() + grid.cell_offsets[cell + 1]);
+    }
+  }
+  // visit the lights in id order as without the grid
+  std::sort(indices.begin(), indices.end());
+  candidate_traffic_lights_.reserve(indices.size());
+  for (const size_t i : indices) {
+    candidate_traffic_lights_.push_back(grid.traffic_lights[i]);
+  }
+  return candidate_traffic_lights_;
 }
 
 void MapBasedDetector::getVisibleTrafficLights(
-  const MapBasedDetector::TrafficLightSet & all_traffic_lights,
+  const std::vector<lanelet::ConstLineString3d> & all_traffic_lights,
   const geometry_msgs::msg::Pose & camera_pose,
   const image_geometry::PinholeCameraModel & pinhole_camera_model,
   std::vector<lanelet::ConstLineString3d> & visible_traffic_lights)
@@ -340,7 +450,6 @@ void MapBasedDetector::getVisibleTrafficLights(
     tl_central_point.x = (tl_right_down_point.x() + tl_left_down_point.x()) / 2.0;
     tl_central_point.y = (tl_right_down_point.y() + tl_left_down_point.y()) / 2.0;
     tl_central_point.z = (tl_right_down_point.z() + tl_left_down_point.z() + tl_height) / 2.0;
-    constexpr double max_distance_range = 200.0;
     if (!isInDistanceRange(tl_central_point, camera_pose.position, max_distance_range)) {
       continue;
     }
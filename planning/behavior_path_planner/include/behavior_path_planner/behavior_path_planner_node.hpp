@@ -26,6 +26,7 @@
 #include "behavior_path_planner/turn_signal_decider.hpp"
 
 #include <tier4_autoware_utils/ros/self_pose_listener.hpp>
+#include <tier4_autoware_utils/system/rate_scheduler.hpp>
 
 #include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
 #include <autoware_auto_perception_msgs/msg/predicted_objects.hpp>
@@ -36,6 +37,7 @@
 #include <autoware_auto_vehicle_msgs/msg/turn_indicators_command.hpp>
 #include <nav_msgs/msg/occupancy_grid.hpp>
 #include <nav_msgs/msg/odometry.hpp>
+#include <tier4_debug_msgs/msg/float64_stamped.hpp>
 #include <tier4_planning_msgs/msg/approval.hpp>
 #include <tier4_planning_msgs/msg/avoidance_debug_msg_array.hpp>
 #include <tier4_planning_msgs/msg/path_change_module.hpp>
@@ -61,6 +63,7 @@ using nav_msgs::msg::OccupancyGrid;
 using nav_msgs::msg::Odometry;
 using tier4_planning_msgs::msg::AvoidanceDebugMsgArray;
 using tier4_planning_msgs::msg::PathChangeModule;
+using tier4_debug_msgs::msg::Float64Stamped;
 using tier4_planning_msgs::msg::Scenario;
 using visualization_msgs::msg::MarkerArray;
 
@@ -80,8 +83,13 @@ private:
   rclcpp::Publisher<Path>::SharedPtr path_candidate_publisher_;
   rclcpp::Publisher<TurnIndicatorsCommand>::SharedPtr turn_signal_publisher_;
   rclcpp::Publisher<HazardLightsCommand>::SharedPtr hazard_signal_publisher_;
+  rclcpp::Publisher<Float64Stamped>::SharedPtr planning_rate_publisher_;
   rclcpp::TimerBase::SharedPtr timer_;
 
+  // planning rate adapted to the scene, enabled if not null
+  std::unique_ptr<tier4_autoware_utils::RateScheduler> rate_scheduler_;
+  int object_num_for_max_planning_rate_{};
+
   std::shared_ptr<PlannerData> planner_data_;
   std::shared_ptr<BehaviorTreeManager> bt_manager_;
   tier4_autoware_utils::SelfPoseListener self_pose_listener_{this};
@@ -89,7 +97,7 @@ private:
 
   TurnSignalDecider turn_signal_decider_;
 
-  std::mutex mutex_pd_;  // mutex for planner_data_
+  std::mutex mutex_pd_;  // mutex for planner_data_, held only to update or to copy it
   std::mutex mutex_bt_;  // mutex for bt_manager_
 
   // setup
@@ -118,15 +126,30 @@ private:
    * @brief Modify the path points near the goal to smoothly connect the lanelet and the goal point.
    */
   PathWithLaneId modifyPathForSmoothGoalConnection(
-    const PathWithLaneId & path) const;  // (TODO) move to util
+    const PathWithLaneId & path,
+    const std::shared_ptr<const PlannerData> & planner_data) const;  // (TODO) move to util
 
-  void clipPathLength(PathWithLaneId & path) const;  // (TODO) move to util
+  void clipPathLength(
+    PathWithLaneId & path,
+    const std::shared_ptr<const PlannerData> & planner_data) const;  // (TODO) move to util
 
   /**
    * @brief Execute behavior tree and publish planned data.
    */
   void run();
 
+  /**
+   * @brief (re)start the timer of run() at the given rate and publish the rate
+   */
+  void resetTimer(const double planning_hz);
+
+  /**
+   * @brief adapt the planning rate to the processing time and the complexity of the last cycle
+   */
+  void updatePlanningRate(
+    const double processing_time, const PlannerData & planner_data,
+    const std::vector<std::shared_ptr<SceneModuleStatus>> & statuses);
+
   /**
    * @brief extract path from behavior tree output
    */
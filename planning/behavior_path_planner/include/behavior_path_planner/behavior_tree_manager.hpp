@@ -36,6 +36,7 @@ struct BehaviorTreeManagerParam
   std::string bt_tree_config_path;
   int groot_zmq_publisher_port;
   int groot_zmq_server_port;
+  SceneModuleProfilerParam profiler_param;
 };
 
 class BehaviorTreeManager
@@ -56,6 +57,7 @@ private:
   std::shared_ptr<PlannerData> current_planner_data_;
   std::vector<std::shared_ptr<SceneModuleInterface>> scene_modules_;
   std::vector<std::shared_ptr<SceneModuleStatus>> modules_status_;
+  std::shared_ptr<SceneModuleProfiler> profiler_;
   rclcpp::Logger logger_;
   rclcpp::Clock clock_;
 
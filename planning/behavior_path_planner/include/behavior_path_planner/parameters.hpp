@@ -33,6 +33,7 @@ struct BehaviorPathPlannerParameters
   double drivable_lane_backward_length;
   double drivable_lane_margin;
   double drivable_area_margin;
+  bool use_drivable_area_cache;
 
   double refine_goal_search_radius_range;
   double turn_light_on_threshold_dis_lat;
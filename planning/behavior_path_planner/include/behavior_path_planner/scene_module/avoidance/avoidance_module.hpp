@@ -24,10 +24,12 @@
 #include <autoware_auto_perception_msgs/msg/predicted_object.hpp>
 #include <autoware_auto_planning_msgs/msg/path_with_lane_id.hpp>
 #include <autoware_auto_vehicle_msgs/msg/turn_indicators_command.hpp>
+#include <builtin_interfaces/msg/time.hpp>
 #include <tier4_planning_msgs/msg/avoidance_debug_msg.hpp>
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -247,6 +249,19 @@ private:
 
   bool isTargetObjectType(const PredictedObject & object) const;
 
+  // lanelet of the overhang of the target objects of the previous cycle, by uuid
+  struct ObjectLaneData
+  {
+    Pose overhang_pose;
+    bool is_on_right;
+    bool has_overhang_lanelet;
+    lanelet::ConstLanelet overhang_lanelet;
+    double to_road_shoulder_distance;
+    boost::optional<lanelet::ConstLineString3d> target_line;
+  };
+  mutable std::unordered_map<std::string, ObjectLaneData> object_lane_data_;
+  mutable builtin_interfaces::msg::Time object_lane_data_route_stamp_;
+
   // debug
   mutable DebugData debug_data_;
   void setDebugData(const PathShifter & shifter, const DebugData & debug);
@@ -130,6 +130,11 @@ struct AvoidanceParameters
   // lost_count and the registered object will be removed when the count exceeds this max count.
   double object_last_seen_threshold;
 
+  // reuse the lanelet and the road shoulder distance of the previous cycle for the object whose
+  // overhang moved less than object_data_reuse_distance_threshold.
+  bool enable_object_data_reuse{false};
+  double object_data_reuse_distance_threshold{0.1};
+
   // For velocity planning to avoid acceleration during avoidance.
   // Speeds smaller than this are not inserted.
   double min_avoidance_speed_for_acc_prevention;
@@ -54,6 +54,7 @@ struct LaneChangeParameters
   bool use_predicted_path_outside_lanelet;
   bool use_all_predicted_path;
   bool enable_blocked_by_obstacle;
+  int safety_check_thread_num;
 };
 
 struct LaneChangeStatus
@@ -73,6 +73,7 @@ struct PullOverParameters
   double maximum_deceleration;
   double after_pull_over_straight_distance;
   double before_pull_over_straight_distance;
+  int safety_check_thread_num;
   // parallel parking
   double after_forward_parking_straight_distance;
   double after_backward_parking_straight_distance;
@@ -60,7 +60,8 @@ std::vector<ShiftParkingPath> selectValidPaths(
   const lane_departure_checker::LaneDepartureChecker & lane_departure_checker);
 bool selectSafePath(
   const std::vector<ShiftParkingPath> & paths,
-  const OccupancyGridBasedCollisionDetector & occupancy_grid_map, ShiftParkingPath & selected_path);
+  const OccupancyGridBasedCollisionDetector & occupancy_grid_map, const int thread_num,
+  ShiftParkingPath & selected_path);
 bool isPullOverPathSafe(
   const PathWithLaneId & path, const lanelet::ConstLanelets & current_lanes,
   const lanelet::ConstLanelets & target_lanes,
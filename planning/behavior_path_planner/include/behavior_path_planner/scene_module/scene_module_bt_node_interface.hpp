@@ -16,6 +16,7 @@
 #define BEHAVIOR_PATH_PLANNER__SCENE_MODULE__SCENE_MODULE_BT_NODE_INTERFACE_HPP_
 
 #include "behavior_path_planner/scene_module/scene_module_interface.hpp"
+#include "behavior_path_planner/scene_module/scene_module_profiler.hpp"
 
 #include <behaviortree_cpp_v3/bt_factory.h>
 
@@ -39,11 +40,13 @@ public:
   SceneModuleBTNodeInterface(
     const std::string & name, const BT::NodeConfiguration & config,
     const std::shared_ptr<SceneModuleInterface> & scene_module,
-    const std::shared_ptr<SceneModuleStatus> & module_status);
+    const std::shared_ptr<SceneModuleStatus> & module_status,
+    const std::shared_ptr<SceneModuleProfiler> & profiler);
 
 protected:
   std::shared_ptr<SceneModuleInterface> scene_module_;
   std::shared_ptr<SceneModuleStatus> module_status_;
+  std::shared_ptr<SceneModuleProfiler> profiler_;
 
 public:
   BT::NodeStatus tick() override;
@@ -55,7 +58,8 @@ public:
 
 BT::NodeStatus isExecutionRequested(
   const std::shared_ptr<const SceneModuleInterface> p,
-  const std::shared_ptr<SceneModuleStatus> & status);
+  const std::shared_ptr<SceneModuleStatus> & status,
+  const std::shared_ptr<SceneModuleProfiler> & profiler);
 
 }  // namespace behavior_path_planner
 
@@ -0,0 +1,97 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef BEHAVIOR_PATH_PLANNER__SCENE_MODULE__SCENE_MODULE_PROFILER_HPP_
+#define BEHAVIOR_PATH_PLANNER__SCENE_MODULE__SCENE_MODULE_PROFILER_HPP_
+
+#include <rclcpp/rclcpp.hpp>
+#include <tier4_autoware_utils/ros/processing_time_publisher.hpp>
+
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace behavior_path_planner
+{
+struct SceneModuleProfilerParam
+{
+  bool enable_profiling{false};
+  // number of the latest cycles the percentiles are computed over
+  int window_size{100};
+  // trace event file (chrome://tracing, Perfetto) of every measured phase, disabled when empty
+  std::string trace_file_path{};
+};
+
+/**
+ * @brief Processing time of each phase (isExecutionRequested, plan, planCandidate, updateState)
+ *        of the scene modules run by the behavior tree. The times of the cycle and their rolling
+ *        p50/p99 are published as "<module>/<phase>[/p50|/p99]" on the end of each cycle.
+ */
+class SceneModuleProfiler
+{
+public:
+  class Scope
+  {
+  public:
+    Scope(SceneModuleProfiler * profiler, const std::string & module_name, const char * phase);
+    ~Scope();
+    Scope(const Scope &) = delete;
+    Scope & operator=(const Scope &) = delete;
+
+  private:
+    SceneModuleProfiler * profiler_;
+    std::string module_name_;
+    const char * phase_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  SceneModuleProfiler(rclcpp::Node & node, const SceneModuleProfilerParam & param);
+
+  /**
+   * @brief Measure the phase of the module until the returned scope is destroyed.
+   */
+  Scope measure(const std::string & module_name, const char * phase)
+  {
+    return Scope(param_.enable_profiling ? this : nullptr, module_name, phase);
+  }
+
+  /**
+   * @brief Publish the times of the cycle and start the next one.
+   */
+  void publish();
+
+private:
+  struct PhaseTime
+  {
+    double cycle_time_ms{0.0};
+    bool is_measured{false};
+    std::deque<double> window_ms{};
+  };
+
+  void add(
+    const std::string & module_name, const char * phase,
+    const std::chrono::steady_clock::time_point & start,
+    const std::chrono::steady_clock::time_point & end);
+
+  SceneModuleProfilerParam param_;
+  std::map<std::string, PhaseTime> phase_times_;
+  std::unique_ptr<tier4_autoware_utils::ProcessingTimePublisher> processing_time_publisher_;
+  std::ofstream trace_file_;
+};
+}  // namespace behavior_path_planner
+
+#endif  // BEHAVIOR_PATH_PLANNER__SCENE_MODULE__SCENE_MODULE_PROFILER_HPP_
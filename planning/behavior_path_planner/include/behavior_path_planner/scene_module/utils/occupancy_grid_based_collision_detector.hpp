@@ -125,7 +125,7 @@ protected:
     // NOTE: Accessing by .at() instead makes 1.2 times slower here.
     // Also, boundary check is already done in isOutOfRange before calling this function.
     // So, basically .at() is not necessary.
-    return is_obstacle_table_[index.y][index.x];
+    return is_obstacle_table_[index.y * costmap_.info.width + index.x];
   }
 
   OccupancyGridMapParam param_;
@@ -133,11 +133,16 @@ protected:
   // costmap as occupancy grid
   nav_msgs::msg::OccupancyGrid costmap_;
 
-  // collision indexes cache
+  // transform from the map frame to the costmap frame
+  geometry_msgs::msg::TransformStamped global2local_transform_;
+
+  // collision indexes cache, reused while the parameters and the resolution do not change
   std::vector<std::vector<IndexXY>> coll_indexes_table_;
+  OccupancyGridMapParam coll_indexes_param_{};
+  double coll_indexes_resolution_{0.0};
 
-  // is_obstacle's table
-  std::vector<std::vector<bool>> is_obstacle_table_;
+  // is_obstacle's table, row major as the costmap data
+  std::vector<uint8_t> is_obstacle_table_;
 
   // pose in costmap frame
   geometry_msgs::msg::Pose start_pose_;
@@ -25,6 +25,7 @@
 #include <boost/optional.hpp>
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -52,6 +53,18 @@ struct ShiftedPath
   std::vector<double> shift_length{};
 };
 
+/**
+ * @brief Arc lengths and left normal vectors of the points of a reference path. They are computed
+ *        once in setPath() and shared by the copies of the PathShifter, which generate the shifted
+ *        paths of several shift points on the same reference path.
+ */
+struct ShiftReferenceData
+{
+  std::vector<double> arclength{};
+  std::vector<double> normal_x{};
+  std::vector<double> normal_y{};
+};
+
 enum class SHIFT_TYPE {
   LINEAR = 0,
   SPLINE = 1,
@@ -180,6 +193,10 @@ private:
   // The reference path along which the shift will be performed.
   PathWithLaneId reference_path_;
 
+  // Arc lengths and normals of reference_path_, shared with the copies of this shifter.
+  std::shared_ptr<const ShiftReferenceData> reference_data_{
+    std::make_shared<const ShiftReferenceData>()};
+
   // Shift points used for shifted-path generation.
   ShiftPointArray shift_points_;
 
@@ -227,6 +244,12 @@ private:
 
   void shiftBaseLength(ShiftedPath * point, double offset) const;
 
+  /**
+   * @brief Move the points of the shifted path along the normals of the reference path by the
+   *        shift length accumulated by addLateralOffsetOnIndexPoint().
+   */
+  void applyShiftLength(ShiftedPath * path) const;
+
   void setBaseOffset(const double val)
   {
     RCLCPP_DEBUG(logger_, "base_offset is changed: %f -> %f", base_offset_, val);
@@ -43,9 +43,11 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <atomic>
 #include <limits>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 namespace behavior_path_planner::util
@@ -282,6 +284,51 @@ lanelet::ConstLanelets getCurrentLanes(const std::shared_ptr<const PlannerData>
 lanelet::ConstLanelets getExtendedCurrentLanes(
   const std::shared_ptr<const PlannerData> & planner_data);
 
+// candidate evaluation
+
+/**
+ * @brief Find the first index in [0, size) for which is_found(index) holds, as a sequential search
+ * does, but evaluating the indices on thread_num threads. The indices are taken in increasing
+ * order and the ones after the first found index are not evaluated any more.
+ * @return the first index found, or size if there is none
+ */
+template <class Predicate>
+size_t findFirstIndex(const size_t size, const size_t thread_num, const Predicate & is_found)
+{
+  if (thread_num <= 1 || size <= 1) {
+    for (size_t i = 0; i < size; ++i) {
+      if (is_found(i)) {
+        return i;
+      }
+    }
+    return size;
+  }
+
+  std::atomic<size_t> next_index{0};
+  std::atomic<size_t> found_index{size};
+  const auto search = [&]() {
+    for (size_t i = next_index++; i < found_index.load(); i = next_index++) {
+      if (is_found(i)) {
+        // the indices left to this thread are larger
+        size_t prev_found_index = found_index.load();
+        while (i < prev_found_index && !found_index.compare_exchange_weak(prev_found_index, i)) {
+        }
+        return;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < std::min(thread_num, size); ++i) {
+    threads.emplace_back(search);
+  }
+  search();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  return found_index.load();
+}
+
 }  // namespace behavior_path_planner::util
 
 #endif  // BEHAVIOR_PATH_PLANNER__UTILITIES_HPP_
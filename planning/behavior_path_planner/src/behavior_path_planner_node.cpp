@@ -23,6 +23,7 @@
 
 #include <tier4_planning_msgs/msg/path_change_module_id.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -146,9 +147,55 @@ BehaviorPathPlannerNode::BehaviorPathPlannerNode(const rclcpp::NodeOptions & nod
   // Start timer
   {
     const auto planning_hz = declare_parameter("planning_hz", 10.0);
-    const auto period_ns = rclcpp::Rate(planning_hz).period();
-    timer_ = rclcpp::create_timer(
-      this, get_clock(), period_ns, std::bind(&BehaviorPathPlannerNode::run, this));
+    // the rate goes from min_planning_hz on an empty scene up to planning_hz
+    if (declare_parameter("adaptive_planning_rate.enable", false)) {
+      rate_scheduler_ = std::make_unique<tier4_autoware_utils::RateScheduler>(
+        declare_parameter("adaptive_planning_rate.min_planning_hz", 5.0), planning_hz,
+        declare_parameter("adaptive_planning_rate.target_load_ratio", 0.8));
+      object_num_for_max_planning_rate_ =
+        declare_parameter("adaptive_planning_rate.object_num_for_max_planning_rate", 20);
+    }
+    planning_rate_publisher_ = create_publisher<Float64Stamped>(
+      "~/output/planning_rate", rclcpp::QoS{1}.transient_local());
+    resetTimer(planning_hz);
+  }
+}
+
+void BehaviorPathPlannerNode::resetTimer(const double planning_hz)
+{
+  if (timer_) {
+    timer_->cancel();
+  }
+  const auto period_ns = rclcpp::Rate(planning_hz).period();
+  // the timer stays in the default callback group, which it shares with the subscriptions of the
+  // scene modules (e.g. lateral offset of SideShift) since they update the module states as the
+  // tree runs. the inputs above have their own groups and only swap their messages in.
+  timer_ = rclcpp::create_timer(
+    this, get_clock(), period_ns, std::bind(&BehaviorPathPlannerNode::run, this));
+
+  // the nodes downstream run on the path, so that they follow this rate
+  Float64Stamped planning_rate;
+  planning_rate.stamp = now();
+  planning_rate.data = planning_hz;
+  planning_rate_publisher_->publish(planning_rate);
+}
+
+void BehaviorPathPlannerNode::updatePlanningRate(
+  const double processing_time, const PlannerData & planner_data,
+  const std::vector<std::shared_ptr<SceneModuleStatus>> & statuses)
+{
+  // a maneuver of a module is planned at the full rate, otherwise the rate rises with the objects
+  const bool is_maneuvering =
+    std::any_of(statuses.begin(), statuses.end(), [](const auto & status) {
+      return status->status == BT::NodeStatus::RUNNING && status->module_name != "LaneFollowing";
+    });
+  const double object_num = static_cast<double>(planner_data.dynamic_object->objects.size());
+  const double complexity =
+    is_maneuvering ? 1.0 : object_num / std::max(object_num_for_max_planning_rate_, 1);
+
+  if (rate_scheduler_->update(processing_time, complexity)) {
+    RCLCPP_DEBUG(get_logger(), "planning rate is changed to %f Hz", rate_scheduler_->getRate());
+    resetTimer(rate_scheduler_->getRate());
   }
 }
 
@@ -196,6 +243,7 @@ BehaviorPathPlannerParameters BehaviorPathPlannerNode::getCommonParam()
   p.drivable_lane_backward_length = declare_parameter<double>("drivable_lane_backward_length");
   p.drivable_lane_margin = declare_parameter<double>("drivable_lane_margin");
   p.drivable_area_margin = declare_parameter<double>("drivable_area_margin");
+  p.use_drivable_area_cache = declare_parameter("use_drivable_area_cache", false);
   p.refine_goal_search_radius_range = declare_parameter("refine_goal_search_radius_range", 7.5);
   p.turn_light_on_threshold_dis_lat = declare_parameter("turn_light_on_threshold_dis_lat", 0.3);
   p.turn_light_on_threshold_dis_long = declare_parameter("turn_light_on_threshold_dis_long", 10.0);
@@ -267,6 +315,8 @@ AvoidanceParameters BehaviorPathPlannerNode::getAvoidanceParam()
   p.longitudinal_collision_margin_time = dp("longitudinal_collision_margin_time", 0.0);
 
   p.object_last_seen_threshold = dp("object_last_seen_threshold", 2.0);
+  p.enable_object_data_reuse = dp("enable_object_data_reuse", false);
+  p.object_data_reuse_distance_threshold = dp("object_data_reuse_distance_threshold", 0.1);
 
   p.min_avoidance_speed_for_acc_prevention = dp("min_avoidance_speed_for_acc_prevention", 3.0);
   p.max_avoidance_acceleration = dp("max_avoidance_acceleration", 0.5);
@@ -328,6 +378,7 @@ LaneChangeParameters BehaviorPathPlannerNode::getLaneChangeParam()
     dp("abort_lane_change_angle_thresh", tier4_autoware_utils::deg2rad(10.0));
   p.abort_lane_change_distance_thresh = dp("abort_lane_change_distance_thresh", 0.3);
   p.enable_blocked_by_obstacle = dp("enable_blocked_by_obstacle", false);
+  p.safety_check_thread_num = dp("safety_check_thread_num", 1);
 
   // validation of parameters
   if (p.lane_change_sampling_num < 1) {
@@ -387,6 +438,7 @@ PullOverParameters BehaviorPathPlannerNode::getPullOverParam()
   p.maximum_deceleration = dp("maximum_deceleration", 1.0);
   p.after_pull_over_straight_distance = dp("after_pull_over_straight_distance", 3.0);
   p.before_pull_over_straight_distance = dp("before_pull_over_straight_distance", 3.0);
+  p.safety_check_thread_num = dp("safety_check_thread_num", 1);
   // parallel parking
   p.after_forward_parking_straight_distance = dp("after_forward_parking_straight_distance", 0.5);
   p.after_backward_parking_straight_distance = dp("after_backward_parking_straight_distance", 0.5);
@@ -486,6 +538,10 @@ BehaviorTreeManagerParam BehaviorPathPlannerNode::getBehaviorTreeManagerParam()
   p.bt_tree_config_path = declare_parameter("bt_tree_config_path", "default");
   p.groot_zmq_publisher_port = declare_parameter("groot_zmq_publisher_port", 1666);
   p.groot_zmq_server_port = declare_parameter("groot_zmq_server_port", 1667);
+  p.profiler_param.enable_profiling = declare_parameter("enable_scene_module_profiling", false);
+  p.profiler_param.window_size = declare_parameter("scene_module_profiling_window_size", 100);
+  p.profiler_param.trace_file_path =
+    declare_parameter("scene_module_profiling_trace_file_path", std::string{});
   return p;
 }
 
@@ -531,6 +587,7 @@ void BehaviorPathPlannerNode::run()
   }
 
   RCLCPP_DEBUG(get_logger(), "----- BehaviorPathPlannerNode start -----");
+  tier4_autoware_utils::StopWatch<std::chrono::seconds> stop_watch;
   mutex_bt_.lock();  // for bt_manager_
   mutex_pd_.lock();  // for planner_data_
 
@@ -544,7 +601,12 @@ void BehaviorPathPlannerNode::run()
   // update planner data
   planner_data_->self_pose = self_pose_listener_.getCurrentPose();
 
-  const auto planner_data = planner_data_;
+  // the behavior tree runs on a snapshot of planner_data_, so that the subscriptions are not
+  // blocked during the cycle. the messages are shared by pointer and the route handler is only
+  // updated under mutex_bt_.
+  const auto planner_data = std::make_shared<PlannerData>(*planner_data_);
+  mutex_pd_.unlock();
+
   // run behavior planner
   const auto output = bt_manager_->run(planner_data);
 
@@ -553,16 +615,19 @@ void BehaviorPathPlannerNode::run()
   const auto path_candidate = getPathCandidate(output, planner_data);
 
   // update planner data
-  planner_data_->prev_output_path = path;
-  mutex_pd_.unlock();
+  planner_data->prev_output_path = path;
+  {
+    std::lock_guard<std::mutex> lock(mutex_pd_);
+    planner_data_->prev_output_path = path;
+  }
 
   PathWithLaneId clipped_path;
   if (skipSmoothGoalConnection(bt_manager_->getModulesStatus())) {
     clipped_path = *path;
   } else {
-    clipped_path = modifyPathForSmoothGoalConnection(*path);
+    clipped_path = modifyPathForSmoothGoalConnection(*path, planner_data);
   }
-  clipPathLength(clipped_path);
+  clipPathLength(clipped_path, planner_data);
   if (!clipped_path.points.empty()) {
     path_publisher_->publish(clipped_path);
   } else {
@@ -600,6 +665,10 @@ void BehaviorPathPlannerNode::run()
     debug_drivable_area_lanelets_publisher_->publish(drivable_area_lines);
   }
 
+  if (rate_scheduler_) {
+    updatePlanningRate(stop_watch.toc(), *planner_data, bt_manager_->getModulesStatus());
+  }
+
   mutex_bt_.unlock();
   RCLCPP_DEBUG(get_logger(), "----- behavior path planner end -----\n\n");
 }
@@ -616,7 +685,7 @@ PathWithLaneId::SharedPtr BehaviorPathPlannerNode::getPath(
     get_logger(), "BehaviorTreeManager: output is %s.", bt_output.path ? "FOUND" : "NOT FOUND");
 
   const auto resampled_path =
-    util::resamplePathWithSpline(*path, planner_data_->parameters.path_interval);
+    util::resamplePathWithSpline(*path, planner_data->parameters.path_interval);
   return std::make_shared<PathWithLaneId>(resampled_path);
 }
 
@@ -685,11 +754,15 @@ void BehaviorPathPlannerNode::onForceApproval(const PathChangeModule::ConstShare
 }
 void BehaviorPathPlannerNode::onMap(const HADMapBin::ConstSharedPtr msg)
 {
+  // the route handler is shared with the snapshot of the running cycle
+  std::lock_guard<std::mutex> lock_bt(mutex_bt_);
   std::lock_guard<std::mutex> lock(mutex_pd_);
   planner_data_->route_handler->setMap(*msg);
 }
 void BehaviorPathPlannerNode::onRoute(const HADMapRoute::ConstSharedPtr msg)
 {
+  // the route handler is shared with the snapshot of the running cycle
+  std::lock_guard<std::mutex> lock_bt(mutex_bt_);
   std::lock_guard<std::mutex> lock(mutex_pd_);
   const bool is_first_time = !(planner_data_->route_handler->isHandlerReady());
 
@@ -703,21 +776,22 @@ void BehaviorPathPlannerNode::onRoute(const HADMapRoute::ConstSharedPtr msg)
   }
 }
 
-void BehaviorPathPlannerNode::clipPathLength(PathWithLaneId & path) const
+void BehaviorPathPlannerNode::clipPathLength(
+  PathWithLaneId & path, const std::shared_ptr<const PlannerData> & planner_data) const
 {
-  const auto ego_pose = planner_data_->self_pose->pose;
-  const double forward = planner_data_->parameters.forward_path_length;
-  const double backward = planner_data_->parameters.backward_path_length;
+  const auto ego_pose = planner_data->self_pose->pose;
+  const double forward = planner_data->parameters.forward_path_length;
+  const double backward = planner_data->parameters.backward_path_length;
 
   util::clipPathLength(path, ego_pose, forward, backward);
 }
 
 PathWithLaneId BehaviorPathPlannerNode::modifyPathForSmoothGoalConnection(
-  const PathWithLaneId & path) const
+  const PathWithLaneId & path, const std::shared_ptr<const PlannerData> & planner_data) const
 {
-  const auto goal = planner_data_->route_handler->getGoalPose();
-  const auto is_approved = planner_data_->approval.is_approved.data;
-  auto goal_lane_id = planner_data_->route_handler->getGoalLaneId();
+  const auto goal = planner_data->route_handler->getGoalPose();
+  const auto is_approved = planner_data->approval.is_approved.data;
+  auto goal_lane_id = planner_data->route_handler->getGoalLaneId();
 
   Pose refined_goal{};
   {
@@ -725,11 +799,11 @@ PathWithLaneId BehaviorPathPlannerNode::modifyPathForSmoothGoalConnection(
     lanelet::ConstLanelet pull_over_lane;
     geometry_msgs::msg::Pose pull_over_goal;
     if (
-      is_approved && planner_data_->route_handler->getPullOverTarget(
-                       planner_data_->route_handler->getShoulderLanelets(), &pull_over_lane)) {
-      refined_goal = planner_data_->route_handler->getPullOverGoalPose();
+      is_approved && planner_data->route_handler->getPullOverTarget(
+                       planner_data->route_handler->getShoulderLanelets(), &pull_over_lane)) {
+      refined_goal = planner_data->route_handler->getPullOverGoalPose();
       goal_lane_id = pull_over_lane.id();
-    } else if (planner_data_->route_handler->getGoalLanelet(&goal_lanelet)) {
+    } else if (planner_data->route_handler->getGoalLanelet(&goal_lanelet)) {
       refined_goal = util::refineGoal(goal, goal_lanelet);
     } else {
       refined_goal = goal;
@@ -737,7 +811,7 @@ PathWithLaneId BehaviorPathPlannerNode::modifyPathForSmoothGoalConnection(
   }
 
   auto refined_path = util::refinePathForGoal(
-    planner_data_->parameters.refine_goal_search_radius_range, M_PI * 0.5, path, refined_goal,
+    planner_data->parameters.refine_goal_search_radius_range, M_PI * 0.5, path, refined_goal,
     goal_lane_id);
   refined_path.header.frame_id = "map";
   refined_path.header.stamp = this->now();
@@ -29,6 +29,7 @@ namespace behavior_path_planner
 BehaviorTreeManager::BehaviorTreeManager(
   rclcpp::Node & node, const BehaviorTreeManagerParam & param)
 : bt_manager_param_(param),
+  profiler_(std::make_shared<SceneModuleProfiler>(node, param.profiler_param)),
   logger_(node.get_logger().get_child("behavior_tree_manager")),
   clock_(*node.get_clock())
 {
@@ -54,22 +55,23 @@ void BehaviorTreeManager::registerSceneModule(const std::shared_ptr<SceneModuleI
   const auto status = std::make_shared<SceneModuleStatus>(name);
 
   // simple condition node for "isRequested"
-  bt_factory_.registerSimpleCondition(name + "_Request", [module, status](BT::TreeNode &) {
-    return isExecutionRequested(module, status);
-  });
+  bt_factory_.registerSimpleCondition(
+    name + "_Request", [module, status, profiler = profiler_](BT::TreeNode &) {
+      return isExecutionRequested(module, status, profiler);
+    });
 
   // simple action node for "planCandidate"
-  auto bt_node =
-    std::make_shared<SceneModuleBTNodeInterface>("", BT::NodeConfiguration{}, module, status);
+  auto bt_node = std::make_shared<SceneModuleBTNodeInterface>(
+    "", BT::NodeConfiguration{}, module, status, profiler_);
   bt_factory_.registerSimpleAction(
     name + "_PlanCandidate",
     [bt_node](BT::TreeNode & tree_node) { return bt_node->planCandidate(tree_node); },
     SceneModuleBTNodeInterface::providedPorts());
 
   // register builder with default tick functor for "plan"
-  auto builder = [module, status](
+  auto builder = [module, status, profiler = profiler_](
                    const std::string & _name, const BT::NodeConfiguration & _config) {
-    return std::make_unique<SceneModuleBTNodeInterface>(_name, _config, module, status);
+    return std::make_unique<SceneModuleBTNodeInterface>(_name, _config, module, status, profiler);
   };
   bt_factory_.registerBuilder<SceneModuleBTNodeInterface>(name + "_Plan", builder);
 
@@ -104,6 +106,7 @@ BehaviorModuleOutput BehaviorTreeManager::run(const std::shared_ptr<PlannerData>
     }
     m->publishRTCStatus();
   });
+  profiler_->publish();
   return output;
 }
 
@@ -194,6 +194,14 @@ ObjectDataArray AvoidanceModule::calcAvoidanceTargetObjects(
       ? calcSignedArcLength(path_points, ego_pos, rh->getGoalPose().position)
       : std::numeric_limits<double>::max();
 
+  // the lanelets of the previous cycle are kept only on the same route
+  const auto route_stamp = rh->getRouteHeader().stamp;
+  if (!parameters_.enable_object_data_reuse || route_stamp != object_lane_data_route_stamp_) {
+    object_lane_data_.clear();
+    object_lane_data_route_stamp_ = route_stamp;
+  }
+  std::unordered_map<std::string, ObjectLaneData> object_lane_data;
+
   lanelet::ConstLineStrings3d debug_linestring;
   debug_linestring.clear();
   // for filtered objects
@@ -248,33 +256,58 @@ ObjectDataArray AvoidanceModule::calcAvoidanceTargetObjects(
     object_data.overhang_dist =
       calcOverhangDistance(object_data, object_closest_pose, object_data.overhang_pose.position);
 
-    lanelet::ConstLanelet overhang_lanelet;
-    if (!rh->getClosestLaneletWithinRoute(object_closest_pose, &overhang_lanelet)) {
-      continue;
-    }
-
-    if (overhang_lanelet.id()) {
-      object_data.overhang_lanelet = overhang_lanelet;
-      lanelet::BasicPoint3d overhang_basic_pose(
-        object_data.overhang_pose.position.x, object_data.overhang_pose.position.y,
-        object_data.overhang_pose.position.z);
-      const bool get_left =
-        isOnRight(object_data) && parameters_.enable_avoidance_over_same_direction;
-      const bool get_right =
-        !isOnRight(object_data) && parameters_.enable_avoidance_over_same_direction;
-
-      const auto target_lines = rh->getFurthestLinestring(
-        overhang_lanelet, get_right, get_left,
-        parameters_.enable_avoidance_over_opposite_direction);
+    // the lanelet search is skipped for the object whose overhang stays on the same place
+    const auto uuid = getUuidStr(object_data);
+    const auto prev_lane_data = object_lane_data_.find(uuid);
+    if (
+      prev_lane_data != object_lane_data_.end() &&
+      prev_lane_data->second.is_on_right == isOnRight(object_data) &&
+      calcDistance2d(prev_lane_data->second.overhang_pose, object_data.overhang_pose) <
+        parameters_.object_data_reuse_distance_threshold) {
+      const auto & lane_data = object_lane_data.emplace(uuid, prev_lane_data->second).first->second;
+      if (!lane_data.has_overhang_lanelet) {
+        continue;
+      }
+      if (lane_data.target_line) {
+        object_data.overhang_lanelet = lane_data.overhang_lanelet;
+        object_data.to_road_shoulder_distance = lane_data.to_road_shoulder_distance;
+        debug_linestring.push_back(lane_data.target_line.get());
+      }
+    } else {
+      auto & lane_data = object_lane_data[uuid];
+      lane_data.overhang_pose = object_data.overhang_pose;
+      lane_data.is_on_right = isOnRight(object_data);
+
+      lanelet::ConstLanelet overhang_lanelet;
+      lane_data.has_overhang_lanelet =
+        rh->getClosestLaneletWithinRoute(object_closest_pose, &overhang_lanelet);
+      if (!lane_data.has_overhang_lanelet) {
+        continue;
+      }
 
-      if (isOnRight(object_data)) {
-        object_data.to_road_shoulder_distance =
-          distance2d(to2D(overhang_basic_pose), to2D(target_lines.back().basicLineString()));
-        debug_linestring.push_back(target_lines.back());
-      } else {
+      if (overhang_lanelet.id()) {
+        object_data.overhang_lanelet = overhang_lanelet;
+        lanelet::BasicPoint3d overhang_basic_pose(
+          object_data.overhang_pose.position.x, object_data.overhang_pose.position.y,
+          object_data.overhang_pose.position.z);
+        const bool get_left =
+          isOnRight(object_data) && parameters_.enable_avoidance_over_same_direction;
+        const bool get_right =
+          !isOnRight(object_data) && parameters_.enable_avoidance_over_same_direction;
+
+        const auto target_lines = rh->getFurthestLinestring(
+          overhang_lanelet, get_right, get_left,
+          parameters_.enable_avoidance_over_opposite_direction);
+
+        const auto & target_line =
+          isOnRight(object_data) ? target_lines.back() : target_lines.front();
         object_data.to_road_shoulder_distance =
-          distance2d(to2D(overhang_basic_pose), to2D(target_lines.front().basicLineString()));
-        debug_linestring.push_back(target_lines.front());
+          distance2d(to2D(overhang_basic_pose), to2D(target_line.basicLineString()));
+        debug_linestring.push_back(target_line);
+
+        lane_data.overhang_lanelet = overhang_lanelet;
+        lane_data.to_road_shoulder_distance = object_data.to_road_shoulder_distance;
+        lane_data.target_line = target_line;
       }
     }
 
@@ -297,6 +330,10 @@ ObjectDataArray AvoidanceModule::calcAvoidanceTargetObjects(
     target_objects.push_back(object_data);
   }
 
+  if (parameters_.enable_object_data_reuse) {
+    object_lane_data_ = std::move(object_lane_data);
+  }
+
   // debug
   {
     updateAvoidanceDebugData(avoidance_debug_msg_array);
@@ -275,15 +275,27 @@ bool selectSafePath(
   const Twist & current_twist, const double vehicle_width,
   const LaneChangeParameters & ros_parameters, LaneChangePath * selected_path)
 {
-  for (const auto & path : paths) {
-    if (isLaneChangePathSafe(
-          path.path, current_lanes, target_lanes, dynamic_objects, current_pose, current_twist,
-          vehicle_width, ros_parameters, true, path.acceleration)) {
-      *selected_path = path;
-      return true;
+  if (1 < ros_parameters.safety_check_thread_num) {
+    // lanelets compute their centerline on the first access, do it before sharing them
+    for (const auto & lane : current_lanes) {
+      lane.centerline();
+    }
+    for (const auto & lane : target_lanes) {
+      lane.centerline();
     }
   }
 
+  const auto safe_index = util::findFirstIndex(
+    paths.size(), std::max(ros_parameters.safety_check_thread_num, 1), [&](const size_t i) {
+      return isLaneChangePathSafe(
+        paths.at(i).path, current_lanes, target_lanes, dynamic_objects, current_pose,
+        current_twist, vehicle_width, ros_parameters, true, paths.at(i).acceleration);
+    });
+  if (safe_index < paths.size()) {
+    *selected_path = paths.at(safe_index);
+    return true;
+  }
+
   // set first path for force lane change if no valid path found
   if (!paths.empty()) {
     *selected_path = paths.front();
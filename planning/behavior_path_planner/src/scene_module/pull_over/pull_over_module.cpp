@@ -813,7 +813,8 @@ std::pair<bool, bool> PullOverModule::getSafePath(ShiftParkingPath & safe_path)
     }
     // select safe path
     bool found_safe_path =
-      pull_over_utils::selectSafePath(valid_paths, occupancy_grid_map_, safe_path);
+      pull_over_utils::selectSafePath(
+        valid_paths, occupancy_grid_map_, parameters_.safety_check_thread_num, safe_path);
     safe_path.is_safe = found_safe_path;
     return std::make_pair(true, found_safe_path);
   }
@@ -315,13 +315,16 @@ std::vector<ShiftParkingPath> selectValidPaths(
 
 bool selectSafePath(
   const std::vector<ShiftParkingPath> & paths,
-  const OccupancyGridBasedCollisionDetector & occupancy_grid_map, ShiftParkingPath & selected_path)
+  const OccupancyGridBasedCollisionDetector & occupancy_grid_map, const int thread_num,
+  ShiftParkingPath & selected_path)
 {
-  for (const auto & path : paths) {
-    if (!occupancy_grid_map.hasObstacleOnPath(path.shifted_path.path, false)) {
-      selected_path = path;
-      return true;
-    }
+  const auto safe_index =
+    util::findFirstIndex(paths.size(), std::max(thread_num, 1), [&](const size_t i) {
+      return !occupancy_grid_map.hasObstacleOnPath(paths.at(i).shifted_path.path, false);
+    });
+  if (safe_index < paths.size()) {
+    selected_path = paths.at(safe_index);
+    return true;
   }
 
   // set first path for force pull over if no valid path found
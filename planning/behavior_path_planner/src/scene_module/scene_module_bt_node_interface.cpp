@@ -21,9 +21,13 @@ namespace behavior_path_planner
 {
 BT::NodeStatus isExecutionRequested(
   const std::shared_ptr<const SceneModuleInterface> p,
-  const std::shared_ptr<SceneModuleStatus> & status)
+  const std::shared_ptr<SceneModuleStatus> & status,
+  const std::shared_ptr<SceneModuleProfiler> & profiler)
 {
-  const auto ret = p->isExecutionRequested();
+  const auto ret = [&]() {
+    const auto scope = profiler->measure(p->name(), "isExecutionRequested");
+    return p->isExecutionRequested();
+  }();
   status->is_requested = ret;
   RCLCPP_DEBUG_STREAM(p->getLogger(), "name = " << p->name() << ", result = " << ret);
   return ret ? BT::NodeStatus::SUCCESS : BT::NodeStatus::FAILURE;
@@ -32,8 +36,12 @@ BT::NodeStatus isExecutionRequested(
 SceneModuleBTNodeInterface::SceneModuleBTNodeInterface(
   const std::string & name, const BT::NodeConfiguration & config,
   const std::shared_ptr<SceneModuleInterface> & scene_module,
-  const std::shared_ptr<SceneModuleStatus> & module_status)
-: BT::CoroActionNode(name, config), scene_module_(scene_module), module_status_(module_status)
+  const std::shared_ptr<SceneModuleStatus> & module_status,
+  const std::shared_ptr<SceneModuleProfiler> & profiler)
+: BT::CoroActionNode(name, config),
+  scene_module_(scene_module),
+  module_status_(module_status),
+  profiler_(profiler)
 {
 }
 
@@ -53,6 +61,7 @@ BT::NodeStatus SceneModuleBTNodeInterface::tick()
     try {
       // NOTE: Since BehaviorTreeCpp has an issue to shadow the exception reason thrown
       // in the TreeNode, catch and display it here until the issue is fixed.
+      const auto scope = profiler_->measure(scene_module_->name(), "planCandidate");
       scene_module_->updateData();
       auto res = setOutput<BehaviorModuleOutput>("output", scene_module_->planWaitingApproval());
       if (!res) {
@@ -71,12 +80,18 @@ BT::NodeStatus SceneModuleBTNodeInterface::tick()
     // NOTE: Since BehaviorTreeCpp has an issue to shadow the exception reason thrown
     // in the TreeNode, catch and display it here until the issue is fixed.
     try {
-      auto res = setOutput<BehaviorModuleOutput>("output", scene_module_->run());
+      auto res = [&]() {
+        const auto scope = profiler_->measure(scene_module_->name(), "plan");
+        return setOutput<BehaviorModuleOutput>("output", scene_module_->run());
+      }();
       if (!res) {
         RCLCPP_ERROR_STREAM(scene_module_->getLogger(), "setOutput() failed : " << res.error());
       }
 
-      current_status = scene_module_->updateState();
+      current_status = [&]() {
+        const auto scope = profiler_->measure(scene_module_->name(), "updateState");
+        return scene_module_->updateState();
+      }();
 
       // for data output
       module_status_->status = current_status;
@@ -114,6 +129,7 @@ BT::NodeStatus SceneModuleBTNodeInterface::planCandidate(BT::TreeNode & self)
 {
   RCLCPP_DEBUG_STREAM(
     scene_module_->getLogger(), "bt::planCandidate module name: " << scene_module_->name());
+  const auto scope = profiler_->measure(scene_module_->name(), "planCandidate");
   auto res = self.setOutput<BehaviorModuleOutput>("output", scene_module_->planWaitingApproval());
   if (!res) {
     RCLCPP_ERROR_STREAM(scene_module_->getLogger(), "setOutput() failed : " << res.error());
@@ -0,0 +1,126 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "behavior_path_planner/scene_module/scene_module_profiler.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace
+{
+double calcPercentile(const std::deque<double> & values, const double ratio)
+{
+  std::vector<double> sorted_values(values.begin(), values.end());
+  const auto nth = sorted_values.begin() + static_cast<std::ptrdiff_t>(std::min(
+                                             ratio * static_cast<double>(sorted_values.size()),
+                                             static_cast<double>(sorted_values.size() - 1)));
+  std::nth_element(sorted_values.begin(), nth, sorted_values.end());
+  return *nth;
+}
+
+int64_t toMicroseconds(const std::chrono::steady_clock::duration & duration)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+}  // namespace
+
+namespace behavior_path_planner
+{
+SceneModuleProfiler::Scope::Scope(
+  SceneModuleProfiler * profiler, const std::string & module_name, const char * phase)
+: profiler_(profiler), module_name_(profiler ? module_name : std::string{}), phase_(phase)
+{
+  if (profiler_) {
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+SceneModuleProfiler::Scope::~Scope()
+{
+  if (profiler_) {
+    profiler_->add(module_name_, phase_, start_, std::chrono::steady_clock::now());
+  }
+}
+
+SceneModuleProfiler::SceneModuleProfiler(
+  rclcpp::Node & node, const SceneModuleProfilerParam & param)
+: param_(param)
+{
+  if (!param_.enable_profiling) {
+    return;
+  }
+  param_.window_size = std::max(param_.window_size, 1);
+  processing_time_publisher_ = std::make_unique<tier4_autoware_utils::ProcessingTimePublisher>(
+    &node, "~/debug/scene_module_processing_time_ms");
+
+  if (!param_.trace_file_path.empty()) {
+    trace_file_.open(param_.trace_file_path, std::ios::trunc);
+    if (trace_file_) {
+      // the trace viewers accept the array without the closing bracket
+      trace_file_ << "[\n";
+    } else {
+      RCLCPP_ERROR(
+        node.get_logger(), "failed to open the trace file: %s", param_.trace_file_path.c_str());
+    }
+  }
+}
+
+void SceneModuleProfiler::add(
+  const std::string & module_name, const char * phase,
+  const std::chrono::steady_clock::time_point & start,
+  const std::chrono::steady_clock::time_point & end)
+{
+  auto & phase_time = phase_times_[module_name + "/" + phase];
+  phase_time.cycle_time_ms += std::chrono::duration<double, std::milli>(end - start).count();
+  phase_time.is_measured = true;
+
+  if (trace_file_.is_open()) {
+    trace_file_ << R"({"name":")" << phase << R"(","cat":")" << module_name
+                << R"(","ph":"X","pid":0,"tid":0,"ts":)" << toMicroseconds(start.time_since_epoch())
+                << R"(,"dur":)" << toMicroseconds(end - start) << "},\n";
+  }
+}
+
+void SceneModuleProfiler::publish()
+{
+  if (!param_.enable_profiling) {
+    return;
+  }
+
+  std::map<std::string, double> processing_time_map;
+  for (auto & [name, phase_time] : phase_times_) {
+    if (phase_time.is_measured) {
+      phase_time.window_ms.push_back(phase_time.cycle_time_ms);
+      if (static_cast<int>(phase_time.window_ms.size()) > param_.window_size) {
+        phase_time.window_ms.pop_front();
+      }
+      processing_time_map[name] = phase_time.cycle_time_ms;
+    }
+    if (!phase_time.window_ms.empty()) {
+      processing_time_map[name + "/p50"] = calcPercentile(phase_time.window_ms, 0.5);
+      processing_time_map[name + "/p99"] = calcPercentile(phase_time.window_ms, 0.99);
+    }
+    phase_time.cycle_time_ms = 0.0;
+    phase_time.is_measured = false;
+  }
+  processing_time_publisher_->publish(processing_time_map);
+
+  if (trace_file_.is_open()) {
+    trace_file_.flush();
+  }
+}
+}  // namespace behavior_path_planner
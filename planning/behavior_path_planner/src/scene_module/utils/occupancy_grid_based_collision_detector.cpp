@@ -17,6 +17,8 @@
 #include <tier4_autoware_utils/geometry/geometry.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
+#include <set>
+#include <utility>
 #include <vector>
 
 namespace behavior_path_planner
@@ -87,27 +89,37 @@ void OccupancyGridBasedCollisionDetector::setMap(const nav_msgs::msg::OccupancyG
   const auto width = costmap_.info.width;
 
   // Initialize status
-  std::vector<std::vector<bool>> is_obstacle_table;
-  is_obstacle_table.resize(height);
-  for (uint32_t i = 0; i < height; i++) {
-    is_obstacle_table.at(i).resize(width);
-    for (uint32_t j = 0; j < width; j++) {
-      const int cost = costmap_.data[i * width + j];
-
-      if (cost < 0 || param_.obstacle_threshold <= cost) {
-        is_obstacle_table[i][j] = true;
-      }
+  is_obstacle_table_.assign(static_cast<size_t>(height) * width, 0);
+  for (size_t i = 0; i < is_obstacle_table_.size(); i++) {
+    const int cost = costmap_.data[i];
+    if (cost < 0 || param_.obstacle_threshold <= cost) {
+      is_obstacle_table_[i] = 1;
     }
   }
-  is_obstacle_table_ = is_obstacle_table;
 
-  // construct collision indexes table
+  tf2::Transform tf_origin;
+  tf2::convert(costmap_.info.origin, tf_origin);
+  global2local_transform_.transform = tf2::toMsg(tf_origin.inverse());
+
+  // construct collision indexes table, which only depends on the vehicle shape and the resolution
+  const auto & shape = param_.vehicle_shape;
+  const auto & prev_shape = coll_indexes_param_.vehicle_shape;
+  const bool is_table_valid =
+    !coll_indexes_table_.empty() && coll_indexes_resolution_ == costmap_.info.resolution &&
+    coll_indexes_param_.theta_size == param_.theta_size && prev_shape.length == shape.length &&
+    prev_shape.width == shape.width && prev_shape.base2back == shape.base2back;
+  if (is_table_valid) {
+    return;
+  }
+
   coll_indexes_table_.clear();
   for (int i = 0; i < param_.theta_size; i++) {
     std::vector<IndexXY> indexes_2d;
     computeCollisionIndexes(i, indexes_2d);
     coll_indexes_table_.push_back(indexes_2d);
   }
+  coll_indexes_param_ = param_;
+  coll_indexes_resolution_ = costmap_.info.resolution;
 }
 
 void OccupancyGridBasedCollisionDetector::computeCollisionIndexes(
@@ -150,6 +162,18 @@ void OccupancyGridBasedCollisionDetector::computeCollisionIndexes(
     addIndex2d(front, y);
   }
   addIndex2d(front, left);
+
+  // the points are sampled at the half of the resolution, so most of the cells are added several
+  // times. keep the first one of each cell so that the cells are still checked in the same order.
+  std::set<std::pair<int, int>> added_indexes;
+  std::vector<IndexXY> unique_indexes;
+  unique_indexes.reserve(indexes_2d.size());
+  for (const auto & index : indexes_2d) {
+    if (added_indexes.emplace(index.x, index.y).second) {
+      unique_indexes.push_back(index);
+    }
+  }
+  indexes_2d = unique_indexes;
 }
 
 bool OccupancyGridBasedCollisionDetector::detectCollision(
@@ -176,7 +200,7 @@ bool OccupancyGridBasedCollisionDetector::hasObstacleOnPath(
   const geometry_msgs::msg::PoseArray & path, const bool check_out_of_range) const
 {
   for (const auto & pose : path.poses) {
-    const auto pose_local = global2local(costmap_, pose);
+    const auto pose_local = transformPose(pose, global2local_transform_);
     const auto index = pose2index(costmap_, pose_local, param_.theta_size);
 
     if (detectCollision(index, check_out_of_range)) {
@@ -192,7 +216,7 @@ bool OccupancyGridBasedCollisionDetector::hasObstacleOnPath(
   const bool check_out_of_range) const
 {
   for (const auto & p : path.points) {
-    const auto pose_local = global2local(costmap_, p.point.pose);
+    const auto pose_local = transformPose(p.point.pose, global2local_transform_);
     const auto index = pose2index(costmap_, pose_local, param_.theta_size);
 
     if (detectCollision(index, check_out_of_range)) {
@@ -47,6 +47,17 @@ void PathShifter::setPath(const PathWithLaneId & path)
 {
   reference_path_ = path;
   is_index_aligned_ = false;  // shift_point index has to be updated for new path.
+
+  auto reference_data = std::make_shared<ShiftReferenceData>();
+  reference_data->arclength = util::calcPathArcLengthArray(reference_path_);
+  reference_data->normal_x.reserve(reference_path_.points.size());
+  reference_data->normal_y.reserve(reference_path_.points.size());
+  for (const auto & p : reference_path_.points) {
+    const double yaw = tf2::getYaw(p.point.pose.orientation);
+    reference_data->normal_x.push_back(-std::sin(yaw));
+    reference_data->normal_y.push_back(std::cos(yaw));
+  }
+  reference_data_ = std::move(reference_data);
 }
 void PathShifter::addShiftPoint(const ShiftPoint & point)
 {
@@ -77,6 +88,7 @@ bool PathShifter::generate(
   if (shift_points_.empty()) {
     RCLCPP_DEBUG_STREAM(logger_, "shift_points_ is empty. Return reference with base offset.");
     shiftBaseLength(shifted_path, base_offset_);
+    applyShiftLength(shifted_path);
     return true;
   }
 
@@ -113,6 +125,7 @@ bool PathShifter::generate(
   // Calculate shifted path
   type == SHIFT_TYPE::SPLINE ? applySplineShifter(shifted_path, offset_back)
                              : applyLinearShifter(shifted_path);
+  applyShiftLength(shifted_path);
 
   const bool is_driving_forward = true;
   motion_utils::insertOrientation(shifted_path->path.points, is_driving_forward);
@@ -126,7 +139,7 @@ bool PathShifter::generate(
 
 void PathShifter::applyLinearShifter(ShiftedPath * shifted_path)
 {
-  const auto arclength_arr = util::calcPathArcLengthArray(reference_path_);
+  const auto & arclength_arr = reference_data_->arclength;
 
   shiftBaseLength(shifted_path, base_offset_);
 
@@ -160,7 +173,7 @@ void PathShifter::applyLinearShifter(ShiftedPath * shifted_path)
 
 void PathShifter::applySplineShifter(ShiftedPath * shifted_path, const bool offset_back)
 {
-  const auto arclength_arr = util::calcPathArcLengthArray(reference_path_);
+  const auto & arclength_arr = reference_data_->arclength;
 
   shiftBaseLength(shifted_path, base_offset_);
 
@@ -229,7 +242,7 @@ void PathShifter::applySplineShifter(ShiftedPath * shifted_path, const bool offs
 
 std::vector<double> PathShifter::calcLateralJerk()
 {
-  const auto arclength_arr = util::calcPathArcLengthArray(reference_path_);
+  const auto & arclength_arr = reference_data_->arclength;
 
   constexpr double epsilon = 1.0e-8;  // to avoid 0 division
 
@@ -422,11 +435,6 @@ void PathShifter::addLateralOffsetOnIndexPoint(
     return;
   }
 
-  auto & p = path->path.points.at(index).point.pose;
-  double yaw = tf2::getYaw(p.orientation);
-  p.position.x -= std::sin(yaw) * offset;
-  p.position.y += std::cos(yaw) * offset;
-
   path->shift_length.at(index) += offset;
 }
 
@@ -440,4 +448,21 @@ void PathShifter::shiftBaseLength(ShiftedPath * path, double offset) const
   }
 }
 
+void PathShifter::applyShiftLength(ShiftedPath * path) const
+{
+  // the orientation of the points is not changed by the shift, so that the normals of the
+  // reference path are the ones the shift lengths were accumulated along.
+  const auto & normal_x = reference_data_->normal_x;
+  const auto & normal_y = reference_data_->normal_y;
+  for (size_t i = 0; i < path->path.points.size(); ++i) {
+    const double shift_length = path->shift_length.at(i);
+    if (shift_length == 0.0) {
+      continue;
+    }
+    auto & p = path->path.points.at(i).point.pose.position;
+    p.x += normal_x.at(i) * shift_length;
+    p.y += normal_y.at(i) * shift_length;
+  }
+}
+
 }  // namespace behavior_path_planner
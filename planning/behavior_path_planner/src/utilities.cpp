@@ -20,7 +20,9 @@
 
 #include <algorithm>
 #include <limits>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -240,6 +242,188 @@ std::array<double, 4> getPathScope(
 
   return {min_x.get(), min_y.get(), max_x.get(), max_y.get()};
 }
+
+// draw the lanes on the image of the grid of width x height from grid_origin, see toCVPoint()
+cv::Mat drawDrivableLanes(
+  const lanelet::ConstLanelets & lanes,
+  const std::shared_ptr<route_handler::RouteHandler> & route_handler,
+  const geometry_msgs::msg::PoseStamped & grid_origin, const double width, const double height,
+  const double resolution)
+{
+  constexpr uint8_t free_space = 0;
+  constexpr uint8_t occupied_space = 100;
+  // get transform
+  tf2::Stamped<tf2::Transform> tf_grid2map, tf_map2grid;
+  tf2::fromMsg(grid_origin, tf_grid2map);
+  tf_map2grid.setData(tf_grid2map.inverse());
+  const auto geom_tf_map2grid = tf2::toMsg(tf_map2grid);
+
+  // convert lane polygons into cv type
+  const int width_cell = std::round(width / resolution);
+  const int height_cell = std::round(height / resolution);
+  cv::Mat cv_image(width_cell, height_cell, CV_8UC1, cv::Scalar(occupied_space));
+  for (const auto & lane : lanes) {
+    lanelet::BasicPolygon2d lane_poly = lane.polygon2d().basicPolygon();
+
+    if (lane.hasAttribute("intersection_area")) {
+      const std::string area_id = lane.attributeOr("intersection_area", "none");
+      const auto intersection_area = route_handler->getIntersectionAreaById(atoi(area_id.c_str()));
+      const auto poly = lanelet::utils::to2D(intersection_area).basicPolygon();
+      std::vector<lanelet::BasicPolygon2d> lane_polys{};
+      if (boost::geometry::intersection(poly, lane_poly, lane_polys)) {
+        lane_poly = lane_polys.front();
+      }
+    }
+
+    // create drivable area using opencv
+    std::vector<std::vector<cv::Point>> cv_polygons;
+    std::vector<cv::Point> cv_polygon;
+    for (const auto & p : lane_poly) {
+      const double z = lane.polygon3d().basicPolygon().at(0).z();
+      geometry_msgs::msg::Point geom_pt = tier4_autoware_utils::createPoint(p.x(), p.y(), z);
+      geometry_msgs::msg::Point transformed_geom_pt;
+      tf2::doTransform(geom_pt, transformed_geom_pt, geom_tf_map2grid);
+      cv_polygon.push_back(
+        behavior_path_planner::util::toCVPoint(transformed_geom_pt, width, height, resolution));
+    }
+    if (!cv_polygon.empty()) {
+      cv_polygons.push_back(cv_polygon);
+      // fill in drivable area and copy to occupancy grid
+      cv::fillPoly(cv_image, cv_polygons, cv::Scalar(free_space));
+    }
+  }
+
+  // Closing
+  // NOTE: Because of the discretization error, there may be some discontinuity between two
+  // successive lanelets in the drivable area. This issue is dealt with by the erode/dilate
+  // process.
+  constexpr int num_iter = 1;
+  cv::Mat cv_erode, cv_dilate;
+  cv::erode(cv_image, cv_erode, cv::Mat(), cv::Point(-1, -1), num_iter);
+  cv::dilate(cv_erode, cv_dilate, cv::Mat(), cv::Point(-1, -1), num_iter);
+  return cv_dilate;
+}
+
+// drivable lanes drawn over a larger area than the drivable area, so that the drivable areas of
+// the following cycles are cropped from it as long as they stay inside this area
+struct DrivableLanesImage
+{
+  std::weak_ptr<lanelet::LaneletMap> lanelet_map_ptr;
+  std::vector<lanelet::Id> lane_ids;
+  double resolution;
+  // area the image is valid for, everything out of the image is occupied
+  double min_x;
+  double min_y;
+  double max_x;
+  double max_y;
+  // the grid of the image is clipped to the lanes, its rows go toward -x and its cols toward -y
+  double image_max_x;
+  double image_max_y;
+  cv::Mat image;
+};
+
+DrivableLanesImage createDrivableLanesImage(
+  const lanelet::ConstLanelets & lanes,
+  const std::shared_ptr<route_handler::RouteHandler> & route_handler,
+  const std::vector<lanelet::Id> & lane_ids, const double min_x, const double min_y,
+  const double max_x, const double max_y, const double resolution)
+{
+  DrivableLanesImage lanes_image;
+  lanes_image.lanelet_map_ptr = route_handler->getLaneletMapPtr();
+  lanes_image.lane_ids = lane_ids;
+  lanes_image.resolution = resolution;
+
+  // expand the drivable area by half of its size for the ego to move in
+  const double margin_x = quantize((max_x - min_x) / 2.0, resolution);
+  const double margin_y = quantize((max_y - min_y) / 2.0, resolution);
+  lanes_image.min_x = min_x - margin_x;
+  lanes_image.min_y = min_y - margin_y;
+  lanes_image.max_x = max_x + margin_x;
+  lanes_image.max_y = max_y + margin_y;
+
+  boost::optional<double> lanes_min_x, lanes_min_y, lanes_max_x, lanes_max_y;
+  for (const auto & lane : lanes) {
+    for (const auto & p : lane.polygon2d().basicPolygon()) {
+      updateMinMaxPosition(p, lanes_min_x, lanes_min_y, lanes_max_x, lanes_max_y);
+    }
+  }
+  if (!lanes_min_x) {
+    lanes_image.image_max_x = lanes_image.max_x;
+    lanes_image.image_max_y = lanes_image.max_y;
+    return lanes_image;
+  }
+
+  // keep the image on the cells of the drivable area
+  const double image_min_x =
+    std::max(lanes_image.min_x, std::floor(lanes_min_x.get() / resolution) * resolution);
+  const double image_min_y =
+    std::max(lanes_image.min_y, std::floor(lanes_min_y.get() / resolution) * resolution);
+  lanes_image.image_max_x =
+    std::min(lanes_image.max_x, std::ceil(lanes_max_x.get() / resolution) * resolution);
+  lanes_image.image_max_y =
+    std::min(lanes_image.max_y, std::ceil(lanes_max_y.get() / resolution) * resolution);
+  if (lanes_image.image_max_x <= image_min_x || lanes_image.image_max_y <= image_min_y) {
+    return lanes_image;
+  }
+
+  geometry_msgs::msg::PoseStamped grid_origin;
+  grid_origin.pose.position.x = image_min_x;
+  grid_origin.pose.position.y = image_min_y;
+  lanes_image.image = drawDrivableLanes(
+    lanes, route_handler, grid_origin, lanes_image.image_max_x - image_min_x,
+    lanes_image.image_max_y - image_min_y, resolution);
+  return lanes_image;
+}
+
+// crop the image of the drivable area from the drivable lanes drawn on the previous cycles
+cv::Mat getCachedDrivableLanesImage(
+  const lanelet::ConstLanelets & lanes,
+  const std::shared_ptr<route_handler::RouteHandler> & route_handler, const double min_x,
+  const double min_y, const double max_x, const double max_y, const double resolution)
+{
+  constexpr uint8_t occupied_space = 100;
+  // a few lane sequences are drawn on each cycle, one for each candidate path of the modules
+  constexpr size_t max_cache_size = 8;
+  static std::mutex mutex;
+  static std::list<DrivableLanesImage> cache;
+
+  const auto lanelet_map_ptr = route_handler->getLaneletMapPtr();
+  std::vector<lanelet::Id> lane_ids;
+  lane_ids.reserve(lanes.size());
+  for (const auto & lane : lanes) {
+    lane_ids.push_back(lane.id());
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto itr = std::find_if(cache.begin(), cache.end(), [&](const auto & lanes_image) {
+    return lanes_image.lanelet_map_ptr.lock() == lanelet_map_ptr &&
+           lanes_image.lane_ids == lane_ids && lanes_image.resolution == resolution &&
+           lanes_image.min_x <= min_x && lanes_image.min_y <= min_y &&
+           max_x <= lanes_image.max_x && max_y <= lanes_image.max_y;
+  });
+  if (itr == cache.end()) {
+    cache.push_front(createDrivableLanesImage(
+      lanes, route_handler, lane_ids, min_x, min_y, max_x, max_y, resolution));
+    if (max_cache_size < cache.size()) {
+      cache.pop_back();
+    }
+  } else {
+    cache.splice(cache.begin(), cache, itr);
+  }
+  const auto & lanes_image = cache.front();
+
+  const int width_cell = std::round((max_x - min_x) / resolution);
+  const int height_cell = std::round((max_y - min_y) / resolution);
+  cv::Mat cv_image(width_cell, height_cell, CV_8UC1, cv::Scalar(occupied_space));
+  const int col_offset = std::round((lanes_image.image_max_y - max_y) / resolution);
+  const int row_offset = std::round((lanes_image.image_max_x - max_x) / resolution);
+  const cv::Rect window(col_offset, row_offset, height_cell, width_cell);
+  const auto overlap = window & cv::Rect(0, 0, lanes_image.image.cols, lanes_image.image.rows);
+  if (!overlap.empty()) {
+    lanes_image.image(overlap).copyTo(cv_image(overlap - window.tl()));
+  }
+  return cv_image;
+}
 }  // namespace drivable_area_utils
 
 namespace behavior_path_planner::util
@@ -1142,59 +1326,15 @@ OccupancyGrid generateDrivableArea(
 
   // occupancy_grid.data = image;
   {
-    constexpr uint8_t free_space = 0;
-    constexpr uint8_t occupied_space = 100;
-    // get transform
-    tf2::Stamped<tf2::Transform> tf_grid2map, tf_map2grid;
-    tf2::fromMsg(grid_origin, tf_grid2map);
-    tf_map2grid.setData(tf_grid2map.inverse());
-    const auto geom_tf_map2grid = tf2::toMsg(tf_map2grid);
-
-    // convert lane polygons into cv type
-    cv::Mat cv_image(
-      occupancy_grid.info.width, occupancy_grid.info.height, CV_8UC1, cv::Scalar(occupied_space));
-    for (const auto & lane : drivable_lanes) {
-      lanelet::BasicPolygon2d lane_poly = lane.polygon2d().basicPolygon();
-
-      if (lane.hasAttribute("intersection_area")) {
-        const std::string area_id = lane.attributeOr("intersection_area", "none");
-        const auto intersection_area =
-          route_handler->getIntersectionAreaById(atoi(area_id.c_str()));
-        const auto poly = lanelet::utils::to2D(intersection_area).basicPolygon();
-        std::vector<lanelet::BasicPolygon2d> lane_polys{};
-        if (boost::geometry::intersection(poly, lane_poly, lane_polys)) {
-          lane_poly = lane_polys.front();
-        }
-      }
-
-      // create drivable area using opencv
-      std::vector<std::vector<cv::Point>> cv_polygons;
-      std::vector<cv::Point> cv_polygon;
-      for (const auto & p : lane_poly) {
-        const double z = lane.polygon3d().basicPolygon().at(0).z();
-        Point geom_pt = tier4_autoware_utils::createPoint(p.x(), p.y(), z);
-        Point transformed_geom_pt;
-        tf2::doTransform(geom_pt, transformed_geom_pt, geom_tf_map2grid);
-        cv_polygon.push_back(toCVPoint(transformed_geom_pt, width, height, resolution));
-      }
-      if (!cv_polygon.empty()) {
-        cv_polygons.push_back(cv_polygon);
-        // fill in drivable area and copy to occupancy grid
-        cv::fillPoly(cv_image, cv_polygons, cv::Scalar(free_space));
-      }
-    }
-
-    // Closing
-    // NOTE: Because of the discretization error, there may be some discontinuity between two
-    // successive lanelets in the drivable area. This issue is dealt with by the erode/dilate
-    // process.
-    constexpr int num_iter = 1;
-    cv::Mat cv_erode, cv_dilate;
-    cv::erode(cv_image, cv_erode, cv::Mat(), cv::Point(-1, -1), num_iter);
-    cv::dilate(cv_erode, cv_dilate, cv::Mat(), cv::Point(-1, -1), num_iter);
-
-    // const auto & cv_image_reshaped = cv_dilate.reshape(1, 1);
-    imageToOccupancyGrid(cv_dilate, &occupancy_grid);
+    const auto cv_image =
+      params.use_drivable_area_cache
+        ? drivable_area_utils::getCachedDrivableLanesImage(
+            drivable_lanes, route_handler, min_x, min_y, max_x, max_y, resolution)
+        : drivable_area_utils::drawDrivableLanes(
+            drivable_lanes, route_handler, grid_origin, width, height, resolution);
+
+    // const auto & cv_image_reshaped = cv_image.reshape(1, 1);
+    imageToOccupancyGrid(cv_image, &occupancy_grid);
     occupancy_grid.data[0] = 0;
     // cv_image_reshaped.copyTo(occupancy_grid.data);
   }
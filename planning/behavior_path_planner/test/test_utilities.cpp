@@ -11,11 +11,14 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
+#include "behavior_path_planner/scene_module/utils/path_shifter.hpp"
 #include "input.hpp"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 using behavior_path_planner::PathWithLaneId;
 using behavior_path_planner::Pose;
 using behavior_path_planner::util::FrenetCoordinate3d;
@@ -50,3 +53,57 @@ TEST(BehaviorPathPlanningUtilitiesBehaviorTest, vehiclePoseToFrenetOnDiagonalLin
   EXPECT_NEAR(vehicle_pose_frenet.distance, 0, 1e-2);
   EXPECT_NEAR(vehicle_pose_frenet.length, 0.1414f, 1e-2);
 }
+
+TEST(BehaviorPathPlanningUtilitiesBehaviorTest, findFirstIndexInParallel)
+{
+  using behavior_path_planner::util::findFirstIndex;
+
+  const auto is_found = [](const size_t i) { return i % 7 == 3 && i > 20; };
+  for (const size_t thread_num : {1u, 2u, 4u, 16u}) {
+    EXPECT_EQ(findFirstIndex(100, thread_num, is_found), 24u);
+    EXPECT_EQ(findFirstIndex(20, thread_num, is_found), 20u);
+    EXPECT_EQ(findFirstIndex(0, thread_num, is_found), 0u);
+  }
+}
+
+TEST(BehaviorPathPlanningUtilitiesBehaviorTest, shiftStraightPathAlongNormal)
+{
+  using behavior_path_planner::PathShifter;
+  using behavior_path_planner::ShiftedPath;
+  using behavior_path_planner::ShiftPoint;
+  using behavior_path_planner::SHIFT_TYPE;
+
+  const auto path = behavior_path_planner::generateStraightSamplePathWithLaneId(0.0f, 1.0f, 30u);
+
+  ShiftPoint shift_point;
+  shift_point.start = path.points.at(5).point.pose;
+  shift_point.end = path.points.at(20).point.pose;
+  shift_point.length = 2.0;
+
+  PathShifter path_shifter;
+  path_shifter.setPath(path);
+  path_shifter.addShiftPoint(shift_point);
+
+  // the copy shares the reference path data but not the shift points
+  auto path_shifter_copy = path_shifter;
+  shift_point.start = path.points.at(22).point.pose;
+  shift_point.end = path.points.at(27).point.pose;
+  shift_point.length = -1.0;
+  path_shifter_copy.addShiftPoint(shift_point);
+
+  ShiftedPath shifted_path;
+  ASSERT_TRUE(path_shifter.generate(&shifted_path, true, SHIFT_TYPE::LINEAR));
+  ShiftedPath shifted_path_copy;
+  ASSERT_TRUE(path_shifter_copy.generate(&shifted_path_copy, true, SHIFT_TYPE::LINEAR));
+
+  for (size_t i = 0; i < path.points.size(); ++i) {
+    const double expected = std::clamp((static_cast<double>(i) - 5.0) / 15.0, 0.0, 1.0) * 2.0;
+    EXPECT_NEAR(shifted_path.shift_length.at(i), expected, 1e-6);
+    EXPECT_NEAR(shifted_path.path.points.at(i).point.pose.position.x, static_cast<double>(i), 1e-6);
+    EXPECT_NEAR(shifted_path.path.points.at(i).point.pose.position.y, expected, 1e-6);
+
+    const double expected_copy =
+      expected - std::clamp((static_cast<double>(i) - 22.0) / 5.0, 0.0, 1.0) * 3.0;
+    EXPECT_NEAR(shifted_path_copy.path.points.at(i).point.pose.position.y, expected_copy, 1e-6);
+  }
+}
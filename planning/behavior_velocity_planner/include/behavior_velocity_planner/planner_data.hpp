@@ -16,6 +16,7 @@
 #define BEHAVIOR_VELOCITY_PLANNER__PLANNER_DATA_HPP_
 
 #include "route_handler/route_handler.hpp"
+#include "utilization/predicted_objects_index.hpp"
 
 #include <motion_velocity_smoother/smoother/analytical_jerk_constrained_smoother/analytical_jerk_constrained_smoother.hpp>
 #include <motion_velocity_smoother/smoother/smoother_base.hpp>
@@ -74,6 +75,8 @@ struct PlannerData
   static constexpr double velocity_buffer_time_sec = 10.0;
   std::deque<geometry_msgs::msg::TwistStamped> velocity_buffer;
   autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr predicted_objects;
+  // spatial index of predicted_objects, built once per message for all the modules
+  std::shared_ptr<const PredictedObjectsIndex> predicted_objects_index;
   pcl::PointCloud<pcl::PointXYZ>::ConstPtr no_ground_pointcloud;
   // occupancy grid
   nav_msgs::msg::OccupancyGrid::ConstSharedPtr occupancy_grid;
@@ -92,6 +95,8 @@ struct PlannerData
   std::shared_ptr<motion_velocity_smoother::SmootherBase> velocity_smoother_;
   // route handler
   std::shared_ptr<route_handler::RouteHandler> route_handler_;
+  // lanelets of the input path from the ego, looked up once per cycle for all the modules
+  std::vector<lanelet::ConstLanelet> lanelets_on_path;
   // parameters
   vehicle_info_util::VehicleInfo vehicle_info_;
 
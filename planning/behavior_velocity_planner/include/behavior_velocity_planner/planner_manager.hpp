@@ -42,6 +42,12 @@ public:
   void launchSceneModule(
     const std::shared_ptr<SceneModuleManagerInterface> & scene_module_manager_ptr);
 
+  // plan the scene modules in parallel, they must not depend on the velocity planned by the others
+  void setParallelPlanning(const bool is_parallel_planning)
+  {
+    is_parallel_planning_ = is_parallel_planning;
+  }
+
   autoware_auto_planning_msgs::msg::PathWithLaneId planPathVelocity(
     const std::shared_ptr<const PlannerData> & planner_data,
     const autoware_auto_planning_msgs::msg::PathWithLaneId & input_path_msg);
@@ -49,7 +55,12 @@ public:
   diagnostic_msgs::msg::DiagnosticStatus getStopReasonDiag() const;
 
 private:
+  autoware_auto_planning_msgs::msg::PathWithLaneId planPathVelocityInParallel(
+    const std::shared_ptr<const PlannerData> & planner_data,
+    const autoware_auto_planning_msgs::msg::PathWithLaneId & input_path_msg);
+
   std::vector<std::shared_ptr<SceneModuleManagerInterface>> scene_manager_ptrs_;
+  bool is_parallel_planning_{false};
   diagnostic_msgs::msg::DiagnosticStatus stop_reason_diag_;
 };
 }  // namespace behavior_velocity_planner
@@ -25,6 +25,8 @@
 #include <autoware_auto_planning_msgs/msg/path_with_lane_id.hpp>
 #include <geometry_msgs/msg/point.hpp>
 
+#include <boost/optional.hpp>
+
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_routing/RoutingGraph.h>
 
@@ -39,6 +41,33 @@ namespace behavior_velocity_planner
 // first: time, second: distance
 using TimeDistanceArray = std::vector<std::pair<double, double>>;
 
+/**
+ * @brief lanelets and polygons of the attention areas of an intersection lane. They only depend on
+ * the map, so they are computed once for it and reused over the cycles.
+ */
+struct IntersectionLanelets
+{
+  // map and routing graph the areas are computed on
+  lanelet::LaneletMapConstPtr lanelet_map_ptr;
+  lanelet::routing::RoutingGraphPtr routing_graph_ptr;
+
+  lanelet::ConstLanelets detection_area_lanelets;
+  std::vector<lanelet::ConstLanelets> conflicting_area_lanelets;
+  std::vector<lanelet::ConstLanelets> detection_area_lanelets_with_margin;
+  std::vector<lanelet::CompoundPolygon3d> conflicting_areas;
+  std::vector<lanelet::CompoundPolygon3d> detection_areas;
+  std::vector<lanelet::CompoundPolygon3d> detection_areas_with_margin;
+  std::vector<int> conflicting_area_lanelet_ids;
+  std::vector<int> detection_area_lanelet_ids;
+
+  bool isComputedOn(
+    const lanelet::LaneletMapConstPtr & map_ptr,
+    const lanelet::routing::RoutingGraphPtr & graph_ptr) const
+  {
+    return lanelet_map_ptr == map_ptr && routing_graph_ptr == graph_ptr;
+  }
+};
+
 class IntersectionModule : public SceneModuleInterface
 {
 public:
@@ -150,6 +179,7 @@ private:
   std::string turn_direction_;
   bool has_traffic_light_;
   bool is_go_out_;
+  boost::optional<IntersectionLanelets> intersection_lanelets_;
 
   // Parameter
   PlannerParam planner_param_;
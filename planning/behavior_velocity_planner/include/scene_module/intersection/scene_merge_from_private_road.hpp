@@ -126,6 +126,7 @@ private:
   int64_t lane_id_;
   std::string turn_direction_;
   bool has_traffic_light_;
+  boost::optional<IntersectionLanelets> intersection_lanelets_;
 
   autoware_auto_planning_msgs::msg::PathWithLaneId extractPathNearExitOfPrivateRoad(
     const autoware_auto_planning_msgs::msg::PathWithLaneId & path, const double extend_length);
@@ -54,6 +54,14 @@ bool getObjectiveLanelets(
   std::vector<lanelet::ConstLanelets> * objective_lanelets_with_margin_result,
   const rclcpp::Logger logger);
 
+/**
+ * @brief get the objective lanelets of lane_id and their polygons clipped to detection_area_length
+ */
+IntersectionLanelets getIntersectionLanelets(
+  lanelet::LaneletMapConstPtr lanelet_map_ptr, lanelet::routing::RoutingGraphPtr routing_graph_ptr,
+  const int lane_id, const double detection_area_length, const double right_margin,
+  const double left_margin, const rclcpp::Logger logger);
+
 /**
  * @brief Generate a stop line and insert it into the path. If the stop line is defined in the map,
  * read it from the map; otherwise, generate a stop line at a position where it will not collide.
@@ -87,8 +87,9 @@ inline PolarCoordinates toPolarCoordinates(const Point2d & origin, const Point2d
 
 struct GridParam
 {
-  int free_space_max;  // maximum value of a freespace cell in the occupancy grid
-  int occupied_min;    // minimum value of an occupied cell in the occupancy grid
+  int free_space_max;              // maximum value of a freespace cell in the occupancy grid
+  int occupied_min;                // minimum value of an occupied cell in the occupancy grid
+  bool use_visibility_map{false};  // cast shadows in one radial sweep and lookup clearance
 };
 
 //!< @brief Find all occlusion spots inside the given lanelet
@@ -106,7 +107,15 @@ boost::optional<Polygon2d> generateOccupiedPolygon(
 void generateOccupiedImage(
   const OccupancyGrid & occ_grid, cv::Mat & inout_image,
   const Polygons2d & stuck_vehicle_foot_prints, const Polygons2d & moving_vehicle_foot_prints,
-  const bool use_object_foot_print, const bool use_object_raycast);
+  const bool use_object_foot_print, const bool use_object_raycast, const bool use_radial_sweep);
+//!< @brief fill the shadows of the polygons seen from the origin, widened by delay_angle on each
+//!< side, with one radial sweep over the image instead of one occlusion polygon per polygon
+void generateRaycastShadowImage(
+  const std::vector<std::vector<cv::Point>> & cv_polygons, const cv::Point2d & origin,
+  const double delay_angle, cv::Mat & inout_image);
+//!< @brief add the "clearance" layer, the distance [m] of each cell to the nearest occupied cell,
+//!< so that isCollisionFree only looks up the cells along the line
+void addClearanceLayer(grid_map::GridMap & grid);
 cv::Point toCVPoint(
   const Point & geom_point, const double width_m, const double height_m, const double resolution);
 void imageToOccupancyGrid(const cv::Mat & cv_image, nav_msgs::msg::OccupancyGrid * occupancy_grid);
@@ -20,6 +20,7 @@
 #include <lanelet2_extension/visualization/visualization.hpp>
 #include <motion_utils/trajectory/trajectory.hpp>
 #include <scene_module/occlusion_spot/grid_utils.hpp>
+#include <utilization/predicted_objects_index.hpp>
 #include <utilization/util.hpp>
 
 #include <autoware_auto_perception_msgs/msg/object_classification.hpp>
@@ -214,8 +215,8 @@ void clipPathByLength(
 bool isStuckVehicle(const PredictedObject & obj, const double min_vel);
 bool isMovingVehicle(const PredictedObject & obj, const double min_vel);
 std::vector<PredictedObject> extractVehicles(
-  const PredictedObjects::ConstSharedPtr objects_ptr, const Point ego_position,
-  const double distance);
+  const PredictedObjects::ConstSharedPtr objects_ptr, const PredictedObjectsIndex & objects_index,
+  const Point ego_position, const double distance);
 std::vector<PredictedObject> filterVehiclesByDetectionArea(
   const std::vector<PredictedObject> & objs, const Polygons2d & polys);
 bool isVehicle(const ObjectClassification & obj_class);
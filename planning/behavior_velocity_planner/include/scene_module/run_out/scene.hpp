@@ -79,7 +79,9 @@ private:
 
   std::vector<DynamicObstacle> checkCollisionWithObstacles(
     const std::vector<DynamicObstacle> & dynamic_obstacles,
-    std::vector<geometry_msgs::msg::Point> poly, const float travel_time) const;
+    const std::vector<run_out_utils::ObstacleReach> & obstacle_reaches,
+    const geometry_msgs::msg::Pose & base_pose, std::vector<geometry_msgs::msg::Point> poly,
+    const float travel_time) const;
 
   boost::optional<DynamicObstacle> findNearestCollisionObstacle(
     const PathWithLaneId & path, const geometry_msgs::msg::Pose & base_pose,
@@ -105,6 +105,14 @@ struct PlannerParam
   Smoother smoother;
 };
 
+// circle that contains the obstacle until travel time t, of radius max_velocity_mps * t + extent
+struct ObstacleReach
+{
+  geometry_msgs::msg::Point origin;
+  float max_velocity_mps;
+  float extent;
+};
+
 enum class State {
   GO = 0,
   APPROACH,
@@ -175,6 +183,14 @@ std::uint8_t getHighestProbLabel(const std::vector<ObjectClassification> & class
 std::vector<geometry_msgs::msg::Pose> getHighestConfidencePath(
   const std::vector<PredictedPath> & predicted_paths);
 
+ObstacleReach calcObstacleReach(const DynamicObstacle & obstacle);
+
+// return false if the obstacle can not reach the circle of radius around position within
+// travel_time, so that the collision check with its predicted poses can be skipped
+bool canReach(
+  const ObstacleReach & reach, const geometry_msgs::msg::Point & position, const float radius,
+  const float travel_time);
+
 // apply linear interpolation to position
 geometry_msgs::msg::Pose lerpByPose(
   const geometry_msgs::msg::Pose & p1, const geometry_msgs::msg::Pose & p2, const float t);
@@ -0,0 +1,61 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UTILIZATION__PREDICTED_OBJECTS_INDEX_HPP_
+#define UTILIZATION__PREDICTED_OBJECTS_INDEX_HPP_
+
+#include <utilization/boost_geometry_helper.hpp>
+
+#include <autoware_auto_perception_msgs/msg/predicted_objects.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <utility>
+#include <vector>
+
+namespace behavior_velocity_planner
+{
+using Box2d = boost::geometry::model::box<Point2d>;
+
+/**
+ * @brief Spatial index of the footprints and the predicted path segments of the predicted objects,
+ * built once per message, so that the modules only check the objects near their areas. The
+ * queries return the indices of the candidate objects by bounding box in the order of the
+ * objects, the modules keeping their own checks on them.
+ */
+class PredictedObjectsIndex
+{
+public:
+  PredictedObjectsIndex() = default;
+  explicit PredictedObjectsIndex(
+    const autoware_auto_perception_msgs::msg::PredictedObjects & objects);
+
+  // objects whose footprint or position may be in the area
+  std::vector<size_t> queryFootprints(const Box2d & area) const;
+  std::vector<size_t> queryFootprints(const Polygon2d & area) const;
+  // objects whose footprint, position or predicted paths may be in the area
+  std::vector<size_t> queryPredictedPaths(const Box2d & area) const;
+  std::vector<size_t> queryPredictedPaths(const Polygon2d & area) const;
+
+private:
+  using Value = std::pair<Box2d, size_t>;
+  using RTree = boost::geometry::index::rtree<Value, boost::geometry::index::rstar<16>>;
+
+  RTree footprint_rtree_;
+  RTree predicted_path_rtree_;
+};
+}  // namespace behavior_velocity_planner
+
+#endif  // UTILIZATION__PREDICTED_OBJECTS_INDEX_HPP_
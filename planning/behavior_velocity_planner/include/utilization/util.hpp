@@ -262,31 +262,18 @@ std::vector<int64_t> getSortedLaneIdsFromPath(const PathWithLaneId & path);
 std::vector<int64_t> getSubsequentLaneIdsSetOnPath(
   const PathWithLaneId & path, int64_t base_lane_id);
 
+// lanelets of the lane ids in the path from the nearest one to current_pose, which the node
+// computes once per cycle for all the modules as PlannerData::lanelets_on_path
+std::vector<lanelet::ConstLanelet> getLaneletsOnPath(
+  const PathWithLaneId & path, const lanelet::LaneletMapPtr lanelet_map,
+  const geometry_msgs::msg::Pose & current_pose);
+
 template <class T>
 std::unordered_map<typename std::shared_ptr<const T>, lanelet::ConstLanelet> getRegElemMapOnPath(
-  const PathWithLaneId & path, const lanelet::LaneletMapPtr lanelet_map,
-  const geometry_msgs::msg::Pose & current_pose)
+  const std::vector<lanelet::ConstLanelet> & lanelets_on_path)
 {
   std::unordered_map<typename std::shared_ptr<const T>, lanelet::ConstLanelet> reg_elem_map_on_path;
-
-  // Add current lane id
-  boost::optional<size_t> nearest_segment_idx;
-  const auto nearest_lane_id =
-    getNearestLaneId(path, lanelet_map, current_pose, nearest_segment_idx);
-
-  std::vector<int64_t> unique_lane_ids;
-  if (nearest_lane_id) {
-    // Add subsequent lane_ids from nearest lane_id
-    unique_lane_ids = behavior_velocity_planner::planning_utils::getSubsequentLaneIdsSetOnPath(
-      path, *nearest_lane_id);
-  } else {
-    // Add all lane_ids in path
-    unique_lane_ids = behavior_velocity_planner::planning_utils::getSortedLaneIdsFromPath(path);
-  }
-
-  for (const auto lane_id : unique_lane_ids) {
-    const auto ll = lanelet_map->laneletLayer.get(lane_id);
-
+  for (const auto & ll : lanelets_on_path) {
     for (const auto & reg_elem : ll.regulatoryElementsAs<const T>()) {
       reg_elem_map_on_path.insert(std::make_pair(reg_elem, ll));
     }
@@ -296,24 +283,20 @@ std::unordered_map<typename std::shared_ptr<const T>, lanelet::ConstLanelet> get
 }
 
 template <class T>
-std::set<int64_t> getRegElemIdSetOnPath(
-  const PathWithLaneId & path, const lanelet::LaneletMapPtr lanelet_map,
-  const geometry_msgs::msg::Pose & current_pose)
+std::set<int64_t> getRegElemIdSetOnPath(const std::vector<lanelet::ConstLanelet> & lanelets_on_path)
 {
   std::set<int64_t> reg_elem_id_set;
-  for (const auto & m : getRegElemMapOnPath<const T>(path, lanelet_map, current_pose)) {
+  for (const auto & m : getRegElemMapOnPath<const T>(lanelets_on_path)) {
     reg_elem_id_set.insert(m.first->id());
   }
   return reg_elem_id_set;
 }
 
 template <class T>
-std::set<int64_t> getLaneletIdSetOnPath(
-  const PathWithLaneId & path, const lanelet::LaneletMapPtr lanelet_map,
-  const geometry_msgs::msg::Pose & current_pose)
+std::set<int64_t> getLaneletIdSetOnPath(const std::vector<lanelet::ConstLanelet> & lanelets_on_path)
 {
   std::set<int64_t> id_set;
-  for (const auto & m : getRegElemMapOnPath<const T>(path, lanelet_map, current_pose)) {
+  for (const auto & m : getRegElemMapOnPath<const T>(lanelets_on_path)) {
     id_set.insert(m.second.id());
   }
   return id_set;
@@ -323,13 +306,7 @@ boost::optional<geometry_msgs::msg::Pose> insertDecelPoint(
   const geometry_msgs::msg::Point & stop_point, PathWithLaneId & output,
   const float target_velocity);
 
-std::vector<lanelet::ConstLanelet> getLaneletsOnPath(
-  const PathWithLaneId & path, const lanelet::LaneletMapPtr lanelet_map,
-  const geometry_msgs::msg::Pose & current_pose);
-
-std::set<int64_t> getLaneIdSetOnPath(
-  const PathWithLaneId & path, const lanelet::LaneletMapPtr lanelet_map,
-  const geometry_msgs::msg::Pose & current_pose);
+std::set<int64_t> getLaneIdSetOnPath(const std::vector<lanelet::ConstLanelet> & lanelets_on_path);
 
 bool isOverLine(
   const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
@@ -338,6 +315,15 @@ bool isOverLine(
 
 boost::optional<geometry_msgs::msg::Pose> insertStopPoint(
   const geometry_msgs::msg::Point & stop_point, PathWithLaneId & output);
+
+/**
+ * @brief merge the paths that modules planned independently from base_path, which only inserted
+ * points on it and lowered the velocity. The merged path has the points of all of them in arc
+ * length order, with the minimum velocity over the paths at each point, which is the path the
+ * modules would have planned one after another.
+ */
+PathWithLaneId mergeModifiedPaths(
+  const PathWithLaneId & base_path, const std::vector<PathWithLaneId> & modified_paths);
 }  // namespace planning_utils
 }  // namespace behavior_velocity_planner
 
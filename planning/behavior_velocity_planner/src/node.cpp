@@ -129,10 +129,12 @@ BehaviorVelocityPlannerNode::BehaviorVelocityPlannerNode(const rclcpp::NodeOptio
   sub_external_intersection_states_ =
     this->create_subscription<tier4_api_msgs::msg::IntersectionStatus>(
       "~/input/external_intersection_states", 10,
-      std::bind(&BehaviorVelocityPlannerNode::onExternalIntersectionStates, this, _1));
+      std::bind(&BehaviorVelocityPlannerNode::onExternalIntersectionStates, this, _1),
+      createSubscriptionOptions(this));
   sub_external_velocity_limit_ = this->create_subscription<VelocityLimit>(
     "~/input/external_velocity_limit_mps", rclcpp::QoS{1}.transient_local(),
-    std::bind(&BehaviorVelocityPlannerNode::onExternalVelocityLimit, this, _1));
+    std::bind(&BehaviorVelocityPlannerNode::onExternalVelocityLimit, this, _1),
+    createSubscriptionOptions(this));
   sub_external_traffic_signals_ =
     this->create_subscription<autoware_auto_perception_msgs::msg::TrafficSignalArray>(
       "~/input/external_traffic_signals", 10,
@@ -162,6 +164,7 @@ BehaviorVelocityPlannerNode::BehaviorVelocityPlannerNode(const rclcpp::NodeOptio
   // TODO(yukkysaito): This will become unnecessary when acc output from localization is available.
   planner_data_.accel_lowpass_gain_ = this->declare_parameter("lowpass_gain", 0.5);
   planner_data_.stop_line_extend_length = this->declare_parameter("stop_line_extend_length", 5.0);
+  planner_manager_.setParallelPlanning(this->declare_parameter("is_parallel_planning", false));
 
   // Initialize PlannerManager
   if (this->declare_parameter("launch_crosswalk", true)) {
@@ -258,8 +261,11 @@ void BehaviorVelocityPlannerNode::onOccupancyGrid(
 void BehaviorVelocityPlannerNode::onPredictedObjects(
   const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr msg)
 {
+  const auto index = std::make_shared<const PredictedObjectsIndex>(*msg);
+
   std::lock_guard<std::mutex> lock(mutex_);
   planner_data_.predicted_objects = msg;
+  planner_data_.predicted_objects_index = index;
 }
 
 void BehaviorVelocityPlannerNode::onNoGroundPointCloud(
@@ -331,10 +337,11 @@ void BehaviorVelocityPlannerNode::onParam()
 void BehaviorVelocityPlannerNode::onLaneletMap(
   const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
+  // Load map, which takes long, without blocking onTrigger
+  const auto route_handler = std::make_shared<route_handler::RouteHandler>(*msg);
 
-  // Load map
-  planner_data_.route_handler_ = std::make_shared<route_handler::RouteHandler>(*msg);
+  std::lock_guard<std::mutex> lock(mutex_);
+  planner_data_.route_handler_ = route_handler;
 }
 
 void BehaviorVelocityPlannerNode::onTrafficSignals(
@@ -366,6 +373,7 @@ void BehaviorVelocityPlannerNode::onExternalIntersectionStates(
 
 void BehaviorVelocityPlannerNode::onExternalVelocityLimit(const VelocityLimit::ConstSharedPtr msg)
 {
+  std::lock_guard<std::mutex> lock(mutex_);
   planner_data_.external_velocity_limit = *msg;
 }
 
@@ -409,13 +417,17 @@ void BehaviorVelocityPlannerNode::onTrigger(
   }
 
   // NOTE: planner_data must not be referenced for multithreading
-  const auto planner_data = planner_data_;
+  auto planner_data = planner_data_;
   mutex_.unlock();
 
   if (input_path_msg->points.empty()) {
     return;
   }
 
+  planner_data.lanelets_on_path = planning_utils::getLaneletsOnPath(
+    *input_path_msg, planner_data.route_handler_->getLaneletMapPtr(),
+    planner_data.current_pose.pose);
+
   const autoware_auto_planning_msgs::msg::Path output_path_msg =
     generatePath(input_path_msg, planner_data);
 
@@ -16,8 +16,10 @@
 
 #include <boost/format.hpp>
 
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace behavior_velocity_planner
 {
@@ -59,6 +61,10 @@ autoware_auto_planning_msgs::msg::PathWithLaneId BehaviorVelocityPlannerManager:
   const std::shared_ptr<const PlannerData> & planner_data,
   const autoware_auto_planning_msgs::msg::PathWithLaneId & input_path_msg)
 {
+  if (is_parallel_planning_) {
+    return planPathVelocityInParallel(planner_data, input_path_msg);
+  }
+
   autoware_auto_planning_msgs::msg::PathWithLaneId output_path_msg = input_path_msg;
 
   int first_stop_path_point_index = static_cast<int>(output_path_msg.points.size() - 1);
@@ -83,6 +89,53 @@ autoware_auto_planning_msgs::msg::PathWithLaneId BehaviorVelocityPlannerManager:
   return output_path_msg;
 }
 
+autoware_auto_planning_msgs::msg::PathWithLaneId
+BehaviorVelocityPlannerManager::planPathVelocityInParallel(
+  const std::shared_ptr<const PlannerData> & planner_data,
+  const autoware_auto_planning_msgs::msg::PathWithLaneId & input_path_msg)
+{
+  // each scene manager plans on its own copy of the input path, the copies being merged in the
+  // order the managers were launched so that the result does not depend on the scheduling
+  std::vector<autoware_auto_planning_msgs::msg::PathWithLaneId> planned_paths(
+    scene_manager_ptrs_.size(), input_path_msg);
+  std::vector<std::future<void>> futures;
+  for (size_t i = 0; i < scene_manager_ptrs_.size(); ++i) {
+    futures.push_back(std::async(std::launch::async, [&, i]() {
+      scene_manager_ptrs_.at(i)->updateSceneModuleInstances(planner_data, input_path_msg);
+      scene_manager_ptrs_.at(i)->plan(&planned_paths.at(i));
+    }));
+  }
+  for (auto & future : futures) {
+    future.get();
+  }
+
+  // the stop points of the paths are compared by their arc length, as their indices differ
+  constexpr double epsilon = 1e-3;
+  double first_stop_arc_length =
+    motion_utils::calcSignedArcLength(input_path_msg.points, 0, input_path_msg.points.size() - 1);
+  geometry_msgs::msg::Pose first_stop_pose = input_path_msg.points.back().point.pose;
+  std::string stop_reason_msg("path_end");
+
+  for (size_t i = 0; i < scene_manager_ptrs_.size(); ++i) {
+    const auto stop_idx = scene_manager_ptrs_.at(i)->getFirstStopPathPointIndex();
+    const auto & planned_path = planned_paths.at(i);
+    if (!stop_idx || planned_path.points.empty()) {
+      continue;
+    }
+    const double stop_arc_length = motion_utils::calcSignedArcLength(
+      planned_path.points, 0, static_cast<size_t>(stop_idx.get()));
+    if (stop_arc_length + epsilon < first_stop_arc_length) {
+      first_stop_arc_length = stop_arc_length;
+      first_stop_pose = planned_path.points.at(stop_idx.get()).point.pose;
+      stop_reason_msg = scene_manager_ptrs_.at(i)->getModuleName();
+    }
+  }
+
+  stop_reason_diag_ = makeStopReasonDiag(stop_reason_msg, first_stop_pose);
+
+  return planning_utils::mergeModifiedPaths(input_path_msg, planned_paths);
+}
+
 diagnostic_msgs::msg::DiagnosticStatus BehaviorVelocityPlannerManager::getStopReasonDiag() const
 {
   return stop_reason_diag_;
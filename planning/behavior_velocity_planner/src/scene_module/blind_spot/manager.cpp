@@ -39,11 +39,9 @@ BlindSpotModuleManager::BlindSpotModuleManager(rclcpp::Node & node)
 }
 
 void BlindSpotModuleManager::launchNewModules(
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
+  [[maybe_unused]] const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
 {
-  for (const auto & ll : planning_utils::getLaneletsOnPath(
-         path, planner_data_->route_handler_->getLaneletMapPtr(),
-         planner_data_->current_pose.pose)) {
+  for (const auto & ll : planner_data_->lanelets_on_path) {
     const auto lane_id = ll.id();
     const auto module_id = lane_id;
 
@@ -66,10 +64,9 @@ void BlindSpotModuleManager::launchNewModules(
 
 std::function<bool(const std::shared_ptr<SceneModuleInterface> &)>
 BlindSpotModuleManager::getModuleExpiredFunction(
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
+  [[maybe_unused]] const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
 {
-  const auto lane_id_set = planning_utils::getLaneIdSetOnPath(
-    path, planner_data_->route_handler_->getLaneletMapPtr(), planner_data_->current_pose.pose);
+  const auto lane_id_set = planning_utils::getLaneIdSetOnPath(planner_data_->lanelets_on_path);
 
   return [lane_id_set](const std::shared_ptr<SceneModuleInterface> & scene_module) {
     return lane_id_set.count(scene_module->getModuleId()) == 0;
@@ -355,7 +355,18 @@ bool BlindSpotModule::checkObstacleInBlindSpot(
     debug_data_.detection_area_for_blind_spot = areas_opt.get().detection_area;
     debug_data_.conflict_area_for_blind_spot = areas_opt.get().conflict_area;
 
-    autoware_auto_perception_msgs::msg::PredictedObjects objects = *objects_ptr;
+    // copy only the objects which may be in the detection area
+    Box2d detection_area_box;
+    bg::assign_inverse(detection_area_box);
+    for (const auto & p : areas_opt.get().detection_area) {
+      bg::expand(detection_area_box, Point2d(p.x(), p.y()));
+    }
+    const auto & objects_index = planner_data_->predicted_objects_index;
+    autoware_auto_perception_msgs::msg::PredictedObjects objects;
+    objects.header = objects_ptr->header;
+    for (const auto i : objects_index->queryFootprints(detection_area_box)) {
+      objects.objects.push_back(objects_ptr->objects.at(i));
+    }
     cutPredictPathWithDuration(&objects, planner_param_.max_future_movement_time);
 
     // check objects in blind spot areas
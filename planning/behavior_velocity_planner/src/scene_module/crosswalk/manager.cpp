@@ -23,33 +23,12 @@
 namespace
 {
 std::vector<lanelet::ConstLanelet> getCrosswalksOnPath(
-  const geometry_msgs::msg::Pose & current_pose,
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
-  const lanelet::LaneletMapPtr lanelet_map,
+  const std::vector<lanelet::ConstLanelet> & lanelets_on_path,
   const std::shared_ptr<const lanelet::routing::RoutingGraphContainer> & overall_graphs)
 {
   std::vector<lanelet::ConstLanelet> crosswalks;
 
-  auto nearest_segment_idx = motion_utils::findNearestSegmentIndex(
-    path.points, current_pose, std::numeric_limits<double>::max(), M_PI_2);
-
-  // Add current lane id
-  const auto nearest_lane_id = behavior_velocity_planner::planning_utils::getNearestLaneId(
-    path, lanelet_map, current_pose, nearest_segment_idx);
-
-  std::vector<int64_t> unique_lane_ids;
-  if (nearest_lane_id) {
-    // Add subsequent lane_ids from nearest lane_id
-    unique_lane_ids = behavior_velocity_planner::planning_utils::getSubsequentLaneIdsSetOnPath(
-      path, *nearest_lane_id);
-  } else {
-    // Add all lane_ids in path
-    unique_lane_ids = behavior_velocity_planner::planning_utils::getSortedLaneIdsFromPath(path);
-  }
-
-  for (const auto lane_id : unique_lane_ids) {
-    const auto ll = lanelet_map->laneletLayer.get(lane_id);
-
+  for (const auto & ll : lanelets_on_path) {
     constexpr int PEDESTRIAN_GRAPH_ID = 1;
     const auto conflicting_crosswalks = overall_graphs->conflictingInGraph(ll, PEDESTRIAN_GRAPH_ID);
     for (const auto & crosswalk : conflicting_crosswalks) {
@@ -61,15 +40,12 @@ std::vector<lanelet::ConstLanelet> getCrosswalksOnPath(
 }
 
 std::set<int64_t> getCrosswalkIdSetOnPath(
-  const geometry_msgs::msg::Pose & current_pose,
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
-  const lanelet::LaneletMapPtr lanelet_map,
+  const std::vector<lanelet::ConstLanelet> & lanelets_on_path,
   const std::shared_ptr<const lanelet::routing::RoutingGraphContainer> & overall_graphs)
 {
   std::set<int64_t> crosswalk_id_set;
 
-  for (const auto & crosswalk :
-       getCrosswalksOnPath(current_pose, path, lanelet_map, overall_graphs)) {
+  for (const auto & crosswalk : getCrosswalksOnPath(lanelets_on_path, overall_graphs)) {
     crosswalk_id_set.insert(crosswalk.id());
   }
 
@@ -126,12 +102,11 @@ CrosswalkModuleManager::CrosswalkModuleManager(rclcpp::Node & node)
   cp.look_pedestrian = node.declare_parameter(ns + ".target_object.pedestrian", true);
 }
 
-void CrosswalkModuleManager::launchNewModules(const PathWithLaneId & path)
+void CrosswalkModuleManager::launchNewModules([[maybe_unused]] const PathWithLaneId & path)
 {
   const auto rh = planner_data_->route_handler_;
-  for (const auto & crosswalk : getCrosswalksOnPath(
-         planner_data_->current_pose.pose, path, rh->getLaneletMapPtr(),
-         rh->getOverallGraphPtr())) {
+  for (const auto & crosswalk :
+       getCrosswalksOnPath(planner_data_->lanelets_on_path, rh->getOverallGraphPtr())) {
     const auto module_id = crosswalk.id();
     if (!isModuleRegistered(module_id)) {
       registerModule(std::make_shared<CrosswalkModule>(
@@ -143,11 +118,11 @@ void CrosswalkModuleManager::launchNewModules(const PathWithLaneId & path)
 }
 
 std::function<bool(const std::shared_ptr<SceneModuleInterface> &)>
-CrosswalkModuleManager::getModuleExpiredFunction(const PathWithLaneId & path)
+CrosswalkModuleManager::getModuleExpiredFunction([[maybe_unused]] const PathWithLaneId & path)
 {
   const auto rh = planner_data_->route_handler_;
-  const auto crosswalk_id_set = getCrosswalkIdSetOnPath(
-    planner_data_->current_pose.pose, path, rh->getLaneletMapPtr(), rh->getOverallGraphPtr());
+  const auto crosswalk_id_set =
+    getCrosswalkIdSetOnPath(planner_data_->lanelets_on_path, rh->getOverallGraphPtr());
 
   return [crosswalk_id_set](const std::shared_ptr<SceneModuleInterface> & scene_module) {
     return crosswalk_id_set.count(scene_module->getModuleId()) == 0;
@@ -167,12 +142,11 @@ WalkwayModuleManager::WalkwayModuleManager(rclcpp::Node & node)
 }
 
 void WalkwayModuleManager::launchNewModules(
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
+  [[maybe_unused]] const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
 {
   const auto rh = planner_data_->route_handler_;
-  for (const auto & crosswalk : getCrosswalksOnPath(
-         planner_data_->current_pose.pose, path, rh->getLaneletMapPtr(),
-         rh->getOverallGraphPtr())) {
+  for (const auto & crosswalk :
+       getCrosswalksOnPath(planner_data_->lanelets_on_path, rh->getOverallGraphPtr())) {
     const auto module_id = crosswalk.id();
     if (
       !isModuleRegistered(module_id) &&
@@ -186,11 +160,11 @@ void WalkwayModuleManager::launchNewModules(
 
 std::function<bool(const std::shared_ptr<SceneModuleInterface> &)>
 WalkwayModuleManager::getModuleExpiredFunction(
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
+  [[maybe_unused]] const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
 {
   const auto rh = planner_data_->route_handler_;
-  const auto walkway_id_set = getCrosswalkIdSetOnPath(
-    planner_data_->current_pose.pose, path, rh->getLaneletMapPtr(), rh->getOverallGraphPtr());
+  const auto walkway_id_set =
+    getCrosswalkIdSetOnPath(planner_data_->lanelets_on_path, rh->getOverallGraphPtr());
 
   return [walkway_id_set](const std::shared_ptr<SceneModuleInterface> & scene_module) {
     return walkway_id_set.count(scene_module->getModuleId()) == 0;
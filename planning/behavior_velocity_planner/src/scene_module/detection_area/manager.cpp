@@ -42,12 +42,10 @@ DetectionAreaModuleManager::DetectionAreaModuleManager(rclcpp::Node & node)
 }
 
 void DetectionAreaModuleManager::launchNewModules(
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
+  [[maybe_unused]] const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
 {
   for (const auto & detection_area_with_lane_id :
-       planning_utils::getRegElemMapOnPath<DetectionArea>(
-         path, planner_data_->route_handler_->getLaneletMapPtr(),
-         planner_data_->current_pose.pose)) {
+       planning_utils::getRegElemMapOnPath<DetectionArea>(planner_data_->lanelets_on_path)) {
     // Use lanelet_id to unregister module when the route is changed
     const auto module_id = detection_area_with_lane_id.first->id();
     if (!isModuleRegistered(module_id)) {
@@ -61,10 +59,10 @@ void DetectionAreaModuleManager::launchNewModules(
 
 std::function<bool(const std::shared_ptr<SceneModuleInterface> &)>
 DetectionAreaModuleManager::getModuleExpiredFunction(
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
+  [[maybe_unused]] const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
 {
   const auto detection_area_id_set = planning_utils::getRegElemIdSetOnPath<DetectionArea>(
-    path, planner_data_->route_handler_->getLaneletMapPtr(), planner_data_->current_pose.pose);
+    planner_data_->lanelets_on_path);
 
   return [detection_area_id_set](const std::shared_ptr<SceneModuleInterface> & scene_module) {
     return detection_area_id_set.count(scene_module->getModuleId()) == 0;
@@ -90,27 +90,19 @@ bool IntersectionModule::modifyPathVelocity(
   const auto lanelet_map_ptr = planner_data_->route_handler_->getLaneletMapPtr();
   const auto routing_graph_ptr = planner_data_->route_handler_->getRoutingGraphPtr();
 
-  /* get detection area and conflicting area */
-  lanelet::ConstLanelets detection_area_lanelets;
-  std::vector<lanelet::ConstLanelets> conflicting_area_lanelets;
-  std::vector<lanelet::ConstLanelets> detection_area_lanelets_with_margin;
-
-  util::getObjectiveLanelets(
-    lanelet_map_ptr, routing_graph_ptr, lane_id_, planner_param_.detection_area_length,
-    planner_param_.detection_area_right_margin, planner_param_.detection_area_left_margin,
-    &conflicting_area_lanelets, &detection_area_lanelets, &detection_area_lanelets_with_margin,
-    logger_);
-  std::vector<lanelet::CompoundPolygon3d> conflicting_areas = util::getPolygon3dFromLaneletsVec(
-    conflicting_area_lanelets, planner_param_.detection_area_length);
-  std::vector<lanelet::CompoundPolygon3d> detection_areas =
-    util::getPolygon3dFromLanelets(detection_area_lanelets, planner_param_.detection_area_length);
-  std::vector<lanelet::CompoundPolygon3d> detection_areas_with_margin =
-    util::getPolygon3dFromLaneletsVec(
-      detection_area_lanelets_with_margin, planner_param_.detection_area_length);
-  std::vector<int> conflicting_area_lanelet_ids =
-    util::getLaneletIdsFromLaneletsVec(conflicting_area_lanelets);
-  std::vector<int> detection_area_lanelet_ids =
-    util::getLaneletIdsFromLaneletsVec({detection_area_lanelets});
+  /* get detection area and conflicting area, computed again only when the map is updated */
+  if (
+    !intersection_lanelets_ ||
+    !intersection_lanelets_->isComputedOn(lanelet_map_ptr, routing_graph_ptr)) {
+    intersection_lanelets_ = util::getIntersectionLanelets(
+      lanelet_map_ptr, routing_graph_ptr, lane_id_, planner_param_.detection_area_length,
+      planner_param_.detection_area_right_margin, planner_param_.detection_area_left_margin,
+      logger_);
+  }
+  const auto & conflicting_areas = intersection_lanelets_->conflicting_areas;
+  const auto & detection_areas = intersection_lanelets_->detection_areas;
+  const auto & detection_areas_with_margin = intersection_lanelets_->detection_areas_with_margin;
+  const auto & detection_area_lanelet_ids = intersection_lanelets_->detection_area_lanelet_ids;
 
   if (detection_areas.empty()) {
     RCLCPP_DEBUG(logger_, "no detection area. skip computation.");
@@ -525,7 +517,9 @@ bool IntersectionModule::checkStuckVehicleInIntersection(
 {
   debug_data_.stuck_vehicle_detect_area = toGeomMsg(stuck_vehicle_detect_area);
 
-  for (const auto & object : objects_ptr->objects) {
+  const auto & objects_index = planner_data_->predicted_objects_index;
+  for (const auto i : objects_index->queryFootprints(stuck_vehicle_detect_area)) {
+    const auto & object = objects_ptr->objects.at(i);
     if (!isTargetStuckVehicleType(object)) {
       continue;  // not target vehicle type
     }
@@ -64,18 +64,16 @@ bool MergeFromPrivateRoadModule::modifyPathVelocity(
   const auto lanelet_map_ptr = planner_data_->route_handler_->getLaneletMapPtr();
   const auto routing_graph_ptr = planner_data_->route_handler_->getRoutingGraphPtr();
 
-  /* get detection area */
-  lanelet::ConstLanelets detection_area_lanelets;
-  std::vector<lanelet::ConstLanelets> conflicting_area_lanelets;
-  std::vector<lanelet::ConstLanelets> detection_area_lanelets_with_margin;
-
-  util::getObjectiveLanelets(
-    lanelet_map_ptr, routing_graph_ptr, lane_id_, planner_param_.detection_area_length,
-    planner_param_.detection_area_right_margin, planner_param_.detection_area_left_margin,
-    &conflicting_area_lanelets, &detection_area_lanelets, &detection_area_lanelets_with_margin,
-    logger_);
-  std::vector<lanelet::CompoundPolygon3d> conflicting_areas = util::getPolygon3dFromLaneletsVec(
-    conflicting_area_lanelets, planner_param_.detection_area_length);
+  /* get detection area, computed again only when the map is updated */
+  if (
+    !intersection_lanelets_ ||
+    !intersection_lanelets_->isComputedOn(lanelet_map_ptr, routing_graph_ptr)) {
+    intersection_lanelets_ = util::getIntersectionLanelets(
+      lanelet_map_ptr, routing_graph_ptr, lane_id_, planner_param_.detection_area_length,
+      planner_param_.detection_area_right_margin, planner_param_.detection_area_left_margin,
+      logger_);
+  }
+  const auto & conflicting_areas = intersection_lanelets_->conflicting_areas;
   if (conflicting_areas.empty()) {
     RCLCPP_DEBUG(logger_, "no detection area. skip computation.");
     return true;
@@ -401,6 +401,31 @@ bool getObjectiveLanelets(
   return true;
 }
 
+IntersectionLanelets getIntersectionLanelets(
+  lanelet::LaneletMapConstPtr lanelet_map_ptr, lanelet::routing::RoutingGraphPtr routing_graph_ptr,
+  const int lane_id, const double detection_area_length, const double right_margin,
+  const double left_margin, const rclcpp::Logger logger)
+{
+  IntersectionLanelets lanelets;
+  lanelets.lanelet_map_ptr = lanelet_map_ptr;
+  lanelets.routing_graph_ptr = routing_graph_ptr;
+  getObjectiveLanelets(
+    lanelet_map_ptr, routing_graph_ptr, lane_id, detection_area_length, right_margin, left_margin,
+    &lanelets.conflicting_area_lanelets, &lanelets.detection_area_lanelets,
+    &lanelets.detection_area_lanelets_with_margin, logger);
+  lanelets.conflicting_areas =
+    getPolygon3dFromLaneletsVec(lanelets.conflicting_area_lanelets, detection_area_length);
+  lanelets.detection_areas =
+    getPolygon3dFromLanelets(lanelets.detection_area_lanelets, detection_area_length);
+  lanelets.detection_areas_with_margin = getPolygon3dFromLaneletsVec(
+    lanelets.detection_area_lanelets_with_margin, detection_area_length);
+  lanelets.conflicting_area_lanelet_ids =
+    getLaneletIdsFromLaneletsVec(lanelets.conflicting_area_lanelets);
+  lanelets.detection_area_lanelet_ids =
+    getLaneletIdsFromLaneletsVec({lanelets.detection_area_lanelets});
+  return lanelets;
+}
+
 std::vector<lanelet::CompoundPolygon3d> getPolygon3dFromLaneletsVec(
   const std::vector<lanelet::ConstLanelets> & ll_vec, double clip_length)
 {
@@ -218,8 +218,10 @@ bool NoStoppingAreaModule::checkStuckVehiclesInNoStoppingArea(
   const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr &
     predicted_obj_arr_ptr)
 {
-  // stuck points by predicted objects
-  for (const auto & object : predicted_obj_arr_ptr->objects) {
+  // stuck points by predicted objects near the stuck detect area
+  const auto & objects_index = planner_data_->predicted_objects_index;
+  for (const auto i : objects_index->queryFootprints(poly)) {
+    const auto & object = predicted_obj_arr_ptr->objects.at(i);
     if (!isTargetStuckVehicleType(object)) {
       continue;  // not target vehicle type
     }
@@ -15,6 +15,8 @@
 #include <scene_module/occlusion_spot/grid_utils.hpp>
 
 #include <algorithm>
+#include <deque>
+#include <limits>
 #include <stdexcept>
 #include <vector>
 
@@ -22,6 +24,30 @@ namespace behavior_velocity_planner
 {
 namespace grid_utils
 {
+namespace
+{
+// minimum of the values within radius of each index, the values being on a circle
+std::vector<float> calcCircularWindowMin(const std::vector<float> & values, const int radius)
+{
+  const int n = static_cast<int>(values.size());
+  if (2 * radius + 1 >= n) {
+    return std::vector<float>(n, *std::min_element(values.begin(), values.end()));
+  }
+  std::vector<float> min_values(n);
+  std::deque<int> window;  // indices of increasing values
+  for (int k = -2 * radius; k < n; ++k) {
+    const int in = k + radius;
+    const float value = values[(in + n) % n];
+    while (!window.empty() && values[(window.back() + n) % n] >= value) {
+      window.pop_back();
+    }
+    window.push_back(in);
+    if (window.front() < k - radius) window.pop_front();
+    if (k >= 0) min_values[k] = values[(window.front() + n) % n];
+  }
+  return min_values;
+}
+}  // namespace
 
 Polygon2d pointsToPoly(const Point2d p0, const Point2d p1, const double radius)
 {
@@ -81,6 +107,22 @@ bool isCollisionFree(
   const grid_map::GridMap & grid, const grid_map::Position & p1, const grid_map::Position & p2,
   const double radius)
 {
+  if (grid.exists("clearance")) {
+    // the corridor is free if no occupied cell is within radius of the cells on the line
+    const grid_map::Matrix & clearance = grid["clearance"];
+    try {
+      for (grid_map::LineIterator iterator(grid, p1, p2); !iterator.isPastEnd(); ++iterator) {
+        const grid_map::Index & index = *iterator;
+        if (clearance(index.x(), index.y()) <= radius) {
+          return false;
+        }
+      }
+    } catch (const std::invalid_argument & e) {
+      std::cerr << e.what() << std::endl;
+      return false;
+    }
+    return true;
+  }
   const grid_map::Matrix & grid_data = grid["layer"];
   bool polys = true;
   try {
@@ -223,7 +265,7 @@ Point transformFromMap2Grid(const TransformStamped & geom_tf_map2grid, const Poi
 void generateOccupiedImage(
   const OccupancyGrid & occ_grid, cv::Mat & inout_image,
   const Polygons2d & stuck_vehicle_foot_prints, const Polygons2d & moving_vehicle_foot_prints,
-  const bool use_object_foot_print, const bool use_object_raycast)
+  const bool use_object_foot_print, const bool use_object_raycast, const bool use_radial_sweep)
 {
   const auto & occ = occ_grid;
   OccupancyGrid occupancy_grid;
@@ -269,7 +311,21 @@ void generateOccupiedImage(
   std::vector<std::vector<cv::Point>> cv_polygons;
   std::vector<cv::Point> cv_polygon;
   Polygon2d occupancy_poly = generateOccupancyPolygon(occupancy_grid.info);
-  if (use_object_raycast) {
+  if (use_object_raycast && use_radial_sweep) {
+    for (const auto & foot_print : moving_vehicle_foot_prints) {
+      for (const auto & p : foot_print.outer()) {
+        const Point transformed_geom_pt = transformFromMap2Grid(geom_tf_map2grid, p);
+        cv_polygon.emplace_back(
+          toCVPoint(transformed_geom_pt, width, height, occupancy_grid.info.resolution));
+      }
+      cv_polygons.push_back(cv_polygon);
+      cv_polygon.clear();
+    }
+    // scan origin is the center of the grid, same delay angle as generateOcclusionPolygon
+    const cv::Point2d origin(0.5 * inout_image.cols, 0.5 * inout_image.rows);
+    generateRaycastShadowImage(cv_polygons, origin, M_PI / 6.0, inout_image);
+    cv_polygons.clear();
+  } else if (use_object_raycast) {
     for (const auto & foot_print : moving_vehicle_foot_prints) {
       // calculate occlusion polygon from moving vehicle
       const auto polys = generateOccupiedPolygon(occupancy_poly, foot_print, scan_origin);
@@ -303,6 +359,85 @@ void generateOccupiedImage(
   }
 }
 
+void generateRaycastShadowImage(
+  const std::vector<std::vector<cv::Point>> & cv_polygons, const cv::Point2d & origin,
+  const double delay_angle, cv::Mat & inout_image)
+{
+  if (cv_polygons.empty()) return;
+  cv::Mat polygon_image(inout_image.size(), CV_8UC1, cv::Scalar(0));
+  for (const auto & p : cv_polygons) {
+    cv::fillConvexPoly(polygon_image, p, cv::Scalar(1));
+  }
+
+  // visibility map: range [px] of the nearest polygon cell for each bearing of about one cell at
+  // the border of the image
+  const double max_range = 0.5 * std::hypot(inout_image.cols, inout_image.rows);
+  const int num_bins = std::max(1, static_cast<int>(std::ceil(2.0 * M_PI * max_range)));
+  const double bin_width = 2.0 * M_PI / num_bins;
+  const auto toBin = [&](const double theta) {
+    const int bin = static_cast<int>(std::floor((theta + M_PI) / bin_width));
+    return ((bin % num_bins) + num_bins) % num_bins;
+  };
+  std::vector<float> visible_ranges(num_bins, std::numeric_limits<float>::max());
+  for (int y = 0; y < polygon_image.rows; ++y) {
+    const uint8_t * row = polygon_image.ptr<uint8_t>(y);
+    for (int x = 0; x < polygon_image.cols; ++x) {
+      if (!row[x]) continue;
+      const double dx = x + 0.5 - origin.x;
+      const double dy = y + 0.5 - origin.y;
+      const float range = static_cast<float>(std::hypot(dx, dy));
+      // bearings covered by the cell, all of them if it contains the origin
+      const double half_angle = range > M_SQRT1_2 ? std::asin(M_SQRT1_2 / range) : M_PI;
+      const double theta = std::atan2(dy, dx);
+      const int bin_num = std::min(
+        num_bins, static_cast<int>(std::ceil(2.0 * half_angle / bin_width)) + 1);
+      const int first_bin = toBin(theta - half_angle);
+      for (int i = 0; i < bin_num; ++i) {
+        float & visible_range = visible_ranges[(first_bin + i) % num_bins];
+        visible_range = std::min(visible_range, range);
+      }
+    }
+  }
+  const int delay_bin_num = static_cast<int>(std::ceil(delay_angle / bin_width));
+  visible_ranges = calcCircularWindowMin(visible_ranges, delay_bin_num);
+
+  // shadow every cell behind its visible range
+  constexpr uint8_t occupied_space = occlusion_cost_value::OCCUPIED_IMAGE;
+  for (int y = 0; y < inout_image.rows; ++y) {
+    uint8_t * row = inout_image.ptr<uint8_t>(y);
+    for (int x = 0; x < inout_image.cols; ++x) {
+      const double dx = x + 0.5 - origin.x;
+      const double dy = y + 0.5 - origin.y;
+      const double range = std::hypot(dx, dy);
+      if (range >= visible_ranges[toBin(std::atan2(dy, dx))]) {
+        row[x] = occupied_space;
+      }
+    }
+  }
+}
+
+void addClearanceLayer(grid_map::GridMap & grid)
+{
+  const grid_map::Matrix & grid_data = grid["layer"];
+  const grid_map::Size size = grid.getSize();
+  cv::Mat free_image(size.x(), size.y(), CV_8UC1);
+  for (int i = 0; i < size.x(); ++i) {
+    for (int j = 0; j < size.y(); ++j) {
+      free_image.at<uint8_t>(i, j) = grid_data(i, j) == occlusion_cost_value::OCCUPIED ? 0 : 1;
+    }
+  }
+  cv::Mat clearance_image;
+  cv::distanceTransform(free_image, clearance_image, cv::DIST_L2, cv::DIST_MASK_PRECISE);
+  grid.add("clearance");
+  grid_map::Matrix & clearance = grid["clearance"];
+  const float resolution = static_cast<float>(grid.getResolution());
+  for (int i = 0; i < size.x(); ++i) {
+    for (int j = 0; j < size.y(); ++j) {
+      clearance(i, j) = clearance_image.at<float>(i, j) * resolution;
+    }
+  }
+}
+
 cv::Point toCVPoint(
   const Point & geom_point, const double width_m, const double height_m, const double resolution)
 {
@@ -385,7 +520,7 @@ void denoiseOccupancyGridCV(
   if (use_object_footprints || use_object_ray_casts) {
     generateOccupiedImage(
       occupancy_grid, border_image, stuck_vehicle_foot_prints, moving_vehicle_foot_prints,
-      use_object_footprints, use_object_ray_casts);
+      use_object_footprints, use_object_ray_casts, param.use_visibility_map);
     if (is_show_debug_window) {
       cv::namedWindow("object ray shadow", cv::WINDOW_NORMAL);
       cv::imshow("object ray shadow", border_image);
@@ -411,6 +546,9 @@ void denoiseOccupancyGridCV(
   }
   imageToOccupancyGrid(border_image, &occupancy_grid);
   grid_map::GridMapRosConverter::fromOccupancyGrid(occupancy_grid, "layer", grid_map);
+  if (param.use_visibility_map) {
+    addClearanceLayer(grid_map);
+  }
 }
 }  // namespace grid_utils
 }  // namespace behavior_velocity_planner
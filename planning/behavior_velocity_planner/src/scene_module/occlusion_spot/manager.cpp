@@ -97,6 +97,7 @@ OcclusionSpotModuleManager::OcclusionSpotModuleManager(rclcpp::Node & node)
   // occupancy grid param
   pp.grid.free_space_max = node.declare_parameter(ns + ".grid.free_space_max", 10);
   pp.grid.occupied_min = node.declare_parameter(ns + ".grid.occupied_min", 51);
+  pp.grid.use_visibility_map = node.declare_parameter(ns + ".grid.use_visibility_map", false);
 
   const auto vehicle_info = vehicle_info_util::VehicleInfoUtil(node).getVehicleInfo();
   pp.baselink_to_front = vehicle_info.max_longitudinal_offset_m;
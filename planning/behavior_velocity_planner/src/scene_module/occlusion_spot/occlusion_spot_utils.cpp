@@ -185,11 +185,15 @@ bool isMovingVehicle(const PredictedObject & obj, const double min_vel)
 }
 
 std::vector<PredictedObject> extractVehicles(
-  const PredictedObjects::ConstSharedPtr objects_ptr, const Point ego_position,
-  const double distance)
+  const PredictedObjects::ConstSharedPtr objects_ptr, const PredictedObjectsIndex & objects_index,
+  const Point ego_position, const double distance)
 {
+  const Box2d search_box(
+    Point2d(ego_position.x - distance, ego_position.y - distance),
+    Point2d(ego_position.x + distance, ego_position.y + distance));
   std::vector<PredictedObject> vehicles;
-  for (const auto & obj : objects_ptr->objects) {
+  for (const auto i : objects_index.queryFootprints(search_box)) {
+    const auto & obj = objects_ptr->objects.at(i);
     if (occlusion_spot_utils::isVehicle(obj)) {
       const auto & o = obj.kinematics.initial_pose_with_covariance.pose.position;
       const auto & p = ego_position;
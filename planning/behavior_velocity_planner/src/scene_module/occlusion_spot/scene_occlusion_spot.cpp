@@ -135,8 +135,9 @@ bool OcclusionSpotModule::modifyPathVelocity(
   }
   DEBUG_PRINT(show_time, "extract[ms]: ", stop_watch_.toc("processing_time", true));
   const auto objects_ptr = planner_data_->predicted_objects;
-  const auto vehicles =
-    utils::extractVehicles(objects_ptr, ego_pose.position, param_.detection_area_length);
+  const auto vehicles = utils::extractVehicles(
+    objects_ptr, *planner_data_->predicted_objects_index, ego_pose.position,
+    param_.detection_area_length);
   const std::vector<PredictedObject> filtered_vehicles =
     utils::filterVehiclesByDetectionArea(vehicles, debug_data_.detection_area_polygons);
   DEBUG_PRINT(show_time, "filter obj[ms]: ", stop_watch_.toc("processing_time", true));
@@ -175,6 +175,13 @@ boost::optional<DynamicObstacle> RunOutModule::detectCollision(
     return {};
   }
 
+  // where the obstacles can be until each travel time, to skip the ones far from the vehicle
+  std::vector<run_out_utils::ObstacleReach> obstacle_reaches;
+  obstacle_reaches.reserve(dynamic_obstacles.size());
+  for (const auto & obstacle : dynamic_obstacles) {
+    obstacle_reaches.emplace_back(run_out_utils::calcObstacleReach(obstacle));
+  }
+
   // detect collision with obstacles from the nearest path point to the end
   // ignore the travel time from current pose to nearest path point?
   float travel_time = 0.0;
@@ -206,8 +213,8 @@ boost::optional<DynamicObstacle> RunOutModule::detectCollision(
       debug_ptr_->pushDebugTexts(sstream.str(), p2.pose, /* lateral_offset */ 3.0);
     }
 
-    auto obstacles_collision =
-      checkCollisionWithObstacles(dynamic_obstacles, vehicle_poly, travel_time);
+    auto obstacles_collision = checkCollisionWithObstacles(
+      dynamic_obstacles, obstacle_reaches, p2.pose, vehicle_poly, travel_time);
     if (obstacles_collision.empty()) {
       continue;
     }
@@ -323,13 +330,22 @@ std::vector<geometry_msgs::msg::Point> RunOutModule::createVehiclePolygon(
 
 std::vector<DynamicObstacle> RunOutModule::checkCollisionWithObstacles(
   const std::vector<DynamicObstacle> & dynamic_obstacles,
-  std::vector<geometry_msgs::msg::Point> poly, const float travel_time) const
+  const std::vector<run_out_utils::ObstacleReach> & obstacle_reaches,
+  const geometry_msgs::msg::Pose & base_pose, std::vector<geometry_msgs::msg::Point> poly,
+  const float travel_time) const
 {
   const auto bg_poly_vehicle = run_out_utils::createBoostPolyFromMsg(poly);
 
+  // radius of the circle around base pose that contains the vehicle polygon
+  const auto & vehicle_param = planner_param_.vehicle_param;
+  const float vehicle_radius = std::hypot(
+    std::max(vehicle_param.base_to_front, vehicle_param.base_to_rear), vehicle_param.width / 2.0f);
+
   // check collision for each objects
   std::vector<DynamicObstacle> obstacles_collision;
-  for (const auto & obstacle : dynamic_obstacles) {
+  for (size_t i = 0; i < dynamic_obstacles.size(); ++i) {
+    const auto & obstacle = dynamic_obstacles.at(i);
+
     // get classification that has highest probability
     const auto classification = run_out_utils::getHighestProbLabel(obstacle.classifications);
 
@@ -340,6 +356,12 @@ std::vector<DynamicObstacle> RunOutModule::checkCollisionWithObstacles(
       continue;
     }
 
+    // skip the obstacle which can not reach the vehicle polygon until travel time
+    if (!run_out_utils::canReach(
+          obstacle_reaches.at(i), base_pose.position, vehicle_radius, travel_time)) {
+      continue;
+    }
+
     // calculate predicted obstacle pose for min velocity and max velocity
     const auto predicted_obstacle_pose_min_vel =
       calcPredictedObstaclePose(obstacle.predicted_paths, travel_time, obstacle.min_velocity_mps);
@@ -14,6 +14,10 @@
 
 #include "scene_module/run_out/utils.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace behavior_velocity_planner
 {
 namespace run_out_utils
@@ -226,6 +230,48 @@ std::vector<geometry_msgs::msg::Pose> getHighestConfidencePath(
   return predicted_path;
 }
 
+ObstacleReach calcObstacleReach(const DynamicObstacle & obstacle)
+{
+  ObstacleReach reach;
+  const auto predicted_path = getHighestConfidencePath(obstacle.predicted_paths);
+  if (predicted_path.size() < 2) {
+    // no predicted pose to check collision with
+    reach.max_velocity_mps = 0.0;
+    reach.extent = -std::numeric_limits<float>::max();
+    return reach;
+  }
+
+  // the predicted poses are on the path not farther from its start than velocity * travel time
+  reach.origin = predicted_path.front().position;
+  reach.max_velocity_mps = std::max({obstacle.min_velocity_mps, obstacle.max_velocity_mps, 0.0f});
+
+  // the bounding box of the ranged poses is not farther from them than its half diagonal
+  const auto & dimensions = obstacle.shape.dimensions;
+  switch (obstacle.shape.type) {
+    case Shape::CYLINDER:
+      reach.extent = std::hypot(dimensions.x / 2.0, dimensions.x / 2.0);
+      break;
+    case Shape::BOUNDING_BOX:
+      reach.extent = std::hypot(dimensions.x / 2.0, dimensions.y / 2.0);
+      break;
+    default:
+      reach.extent = std::numeric_limits<float>::max();
+      break;
+  }
+  return reach;
+}
+
+bool canReach(
+  const ObstacleReach & reach, const geometry_msgs::msg::Point & position, const float radius,
+  const float travel_time)
+{
+  if (reach.extent == std::numeric_limits<float>::max()) {
+    return true;
+  }
+  const float dist = tier4_autoware_utils::calcDistance2d(reach.origin, position);
+  return dist <= reach.max_velocity_mps * travel_time + reach.extent + radius;
+}
+
 // apply linear interpolation to position
 geometry_msgs::msg::Pose lerpByPose(
   const geometry_msgs::msg::Pose & p1, const geometry_msgs::msg::Pose & p2, const float t)
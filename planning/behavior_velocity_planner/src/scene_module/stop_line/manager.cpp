@@ -39,13 +39,11 @@ StopLineModuleManager::StopLineModuleManager(rclcpp::Node & node)
 }
 
 std::vector<StopLineWithLaneId> StopLineModuleManager::getStopLinesWithLaneIdOnPath(
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
-  const lanelet::LaneletMapPtr lanelet_map)
+  const std::vector<lanelet::ConstLanelet> & lanelets_on_path)
 {
   std::vector<StopLineWithLaneId> stop_lines_with_lane_id;
 
-  for (const auto & m : planning_utils::getRegElemMapOnPath<TrafficSign>(
-         path, lanelet_map, planner_data_->current_pose.pose)) {
+  for (const auto & m : planning_utils::getRegElemMapOnPath<TrafficSign>(lanelets_on_path)) {
     const auto & traffic_sign_reg_elem = m.first;
     const int64_t lane_id = m.second.id();
     // Is stop sign?
@@ -62,12 +60,11 @@ std::vector<StopLineWithLaneId> StopLineModuleManager::getStopLinesWithLaneIdOnP
 }
 
 std::set<int64_t> StopLineModuleManager::getStopLineIdSetOnPath(
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path,
-  const lanelet::LaneletMapPtr lanelet_map)
+  const std::vector<lanelet::ConstLanelet> & lanelets_on_path)
 {
   std::set<int64_t> stop_line_id_set;
 
-  for (const auto & stop_line_with_lane_id : getStopLinesWithLaneIdOnPath(path, lanelet_map)) {
+  for (const auto & stop_line_with_lane_id : getStopLinesWithLaneIdOnPath(lanelets_on_path)) {
     stop_line_id_set.insert(stop_line_with_lane_id.first.id());
   }
 
@@ -75,10 +72,10 @@ std::set<int64_t> StopLineModuleManager::getStopLineIdSetOnPath(
 }
 
 void StopLineModuleManager::launchNewModules(
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
+  [[maybe_unused]] const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
 {
   for (const auto & stop_line_with_lane_id :
-       getStopLinesWithLaneIdOnPath(path, planner_data_->route_handler_->getLaneletMapPtr())) {
+       getStopLinesWithLaneIdOnPath(planner_data_->lanelets_on_path)) {
     const auto module_id = stop_line_with_lane_id.first.id();
     const auto lane_id = stop_line_with_lane_id.second;
     if (!isModuleRegistered(module_id)) {
@@ -91,10 +88,9 @@ void StopLineModuleManager::launchNewModules(
 
 std::function<bool(const std::shared_ptr<SceneModuleInterface> &)>
 StopLineModuleManager::getModuleExpiredFunction(
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
+  [[maybe_unused]] const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
 {
-  const auto stop_line_id_set =
-    getStopLineIdSetOnPath(path, planner_data_->route_handler_->getLaneletMapPtr());
+  const auto stop_line_id_set = getStopLineIdSetOnPath(planner_data_->lanelets_on_path);
 
   return [stop_line_id_set](const std::shared_ptr<SceneModuleInterface> & scene_module) {
     return stop_line_id_set.count(scene_module->getModuleId()) == 0;
@@ -44,11 +44,10 @@ VirtualTrafficLightModuleManager::VirtualTrafficLightModuleManager(rclcpp::Node
 }
 
 void VirtualTrafficLightModuleManager::launchNewModules(
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
+  [[maybe_unused]] const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
 {
   for (const auto & m : planning_utils::getRegElemMapOnPath<VirtualTrafficLight>(
-         path, planner_data_->route_handler_->getLaneletMapPtr(),
-         planner_data_->current_pose.pose)) {
+         planner_data_->lanelets_on_path)) {
     // Use lanelet_id to unregister module when the route is changed
     const auto module_id = m.second.id();
     if (!isModuleRegistered(module_id)) {
@@ -61,10 +60,10 @@ void VirtualTrafficLightModuleManager::launchNewModules(
 
 std::function<bool(const std::shared_ptr<SceneModuleInterface> &)>
 VirtualTrafficLightModuleManager::getModuleExpiredFunction(
-  const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
+  [[maybe_unused]] const autoware_auto_planning_msgs::msg::PathWithLaneId & path)
 {
   const auto id_set = planning_utils::getLaneletIdSetOnPath<VirtualTrafficLight>(
-    path, planner_data_->route_handler_->getLaneletMapPtr(), planner_data_->current_pose.pose);
+    planner_data_->lanelets_on_path);
 
   return [id_set](const std::shared_ptr<SceneModuleInterface> & scene_module) {
     return id_set.count(scene_module->getModuleId()) == 0;
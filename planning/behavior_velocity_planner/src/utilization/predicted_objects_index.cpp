@@ -0,0 +1,94 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utilization/predicted_objects_index.hpp>
+#include <utilization/util.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace behavior_velocity_planner
+{
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+PredictedObjectsIndex::PredictedObjectsIndex(
+  const autoware_auto_perception_msgs::msg::PredictedObjects & objects)
+{
+  std::vector<Value> footprint_values;
+  std::vector<Value> predicted_path_values;
+  footprint_values.reserve(objects.objects.size());
+  for (size_t i = 0; i < objects.objects.size(); ++i) {
+    const auto & object = objects.objects.at(i);
+    // the footprint of an object may be given without its position
+    Box2d footprint_box;
+    bg::envelope(planning_utils::toFootprintPolygon(object), footprint_box);
+    bg::expand(
+      footprint_box, to_bg2d(object.kinematics.initial_pose_with_covariance.pose.position));
+    footprint_values.emplace_back(footprint_box, i);
+
+    for (const auto & predicted_path : object.kinematics.predicted_paths) {
+      for (size_t j = 1; j < predicted_path.path.size(); ++j) {
+        Box2d segment_box(
+          to_bg2d(predicted_path.path.at(j - 1).position),
+          to_bg2d(predicted_path.path.at(j - 1).position));
+        bg::expand(segment_box, to_bg2d(predicted_path.path.at(j).position));
+        predicted_path_values.emplace_back(segment_box, i);
+      }
+    }
+  }
+  // pack the values at once instead of inserting them one by one
+  footprint_rtree_ = RTree(footprint_values.begin(), footprint_values.end());
+  predicted_path_rtree_ = RTree(predicted_path_values.begin(), predicted_path_values.end());
+}
+
+std::vector<size_t> PredictedObjectsIndex::queryFootprints(const Box2d & area) const
+{
+  std::vector<Value> values;
+  footprint_rtree_.query(bgi::intersects(area), std::back_inserter(values));
+  std::vector<size_t> indices;
+  indices.reserve(values.size());
+  for (const auto & value : values) {
+    indices.push_back(value.second);
+  }
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+std::vector<size_t> PredictedObjectsIndex::queryFootprints(const Polygon2d & area) const
+{
+  return queryFootprints(bg::return_envelope<Box2d>(area));
+}
+
+std::vector<size_t> PredictedObjectsIndex::queryPredictedPaths(const Box2d & area) const
+{
+  std::vector<Value> values;
+  footprint_rtree_.query(bgi::intersects(area), std::back_inserter(values));
+  predicted_path_rtree_.query(bgi::intersects(area), std::back_inserter(values));
+  std::vector<size_t> indices;
+  indices.reserve(values.size());
+  for (const auto & value : values) {
+    indices.push_back(value.second);
+  }
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  return indices;
+}
+
+std::vector<size_t> PredictedObjectsIndex::queryPredictedPaths(const Polygon2d & area) const
+{
+  return queryPredictedPaths(bg::return_envelope<Box2d>(area));
+}
+}  // namespace behavior_velocity_planner
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 namespace behavior_velocity_planner
@@ -571,12 +572,10 @@ std::vector<lanelet::ConstLanelet> getLaneletsOnPath(
   return lanelets;
 }
 
-std::set<int64_t> getLaneIdSetOnPath(
-  const PathWithLaneId & path, const lanelet::LaneletMapPtr lanelet_map,
-  const geometry_msgs::msg::Pose & current_pose)
+std::set<int64_t> getLaneIdSetOnPath(const std::vector<lanelet::ConstLanelet> & lanelets_on_path)
 {
   std::set<int64_t> lane_id_set;
-  for (const auto & lane : getLaneletsOnPath(path, lanelet_map, current_pose)) {
+  for (const auto & lane : lanelets_on_path) {
     lane_id_set.insert(lane.id());
   }
 
@@ -586,13 +585,13 @@ std::set<int64_t> getLaneIdSetOnPath(
 std::vector<int64_t> getSortedLaneIdsFromPath(const PathWithLaneId & path)
 {
   std::vector<int64_t> sorted_lane_ids;
+  std::unordered_set<int64_t> lane_id_set;
   for (const auto & path_points : path.points) {
-    for (const auto lane_id : path_points.lane_ids)
-      if (
-        std::find(sorted_lane_ids.begin(), sorted_lane_ids.end(), lane_id) ==
-        sorted_lane_ids.end()) {
+    for (const auto lane_id : path_points.lane_ids) {
+      if (lane_id_set.insert(lane_id).second) {
         sorted_lane_ids.emplace_back(lane_id);
       }
+    }
   }
   return sorted_lane_ids;
 }
@@ -662,5 +661,71 @@ boost::optional<geometry_msgs::msg::Pose> insertStopPoint(
 
   return tier4_autoware_utils::getPose(output.points.at(insert_idx.get()));
 }
+
+PathWithLaneId mergeModifiedPaths(
+  const PathWithLaneId & base_path, const std::vector<PathWithLaneId> & modified_paths)
+{
+  // points closer than this in arc length are the same point
+  constexpr double epsilon = 1e-3;
+
+  std::vector<const PathWithLaneId *> paths{&base_path};
+  for (const auto & modified_path : modified_paths) {
+    if (!modified_path.points.empty()) {
+      paths.push_back(&modified_path);
+    }
+  }
+
+  // the inserted points are on the segments of base_path, so that the arc length along each path
+  // is the one along base_path
+  struct Candidate
+  {
+    double arc_length;
+    size_t path_idx;
+    size_t point_idx;
+  };
+  std::vector<std::vector<double>> arc_lengths(paths.size());
+  std::vector<Candidate> candidates;
+  for (size_t i = 0; i < paths.size(); ++i) {
+    const auto & points = paths.at(i)->points;
+    arc_lengths.at(i).resize(points.size(), 0.0);
+    for (size_t j = 0; j < points.size(); ++j) {
+      if (j > 0) {
+        arc_lengths.at(i).at(j) =
+          arc_lengths.at(i).at(j - 1) + calcDistance2d(points.at(j - 1), points.at(j));
+      }
+      candidates.push_back(Candidate{arc_lengths.at(i).at(j), i, j});
+    }
+  }
+  // the points of the paths earlier in the vector are kept among the same ones
+  std::stable_sort(
+    candidates.begin(), candidates.end(),
+    [](const Candidate & a, const Candidate & b) { return a.arc_length < b.arc_length; });
+
+  PathWithLaneId merged_path = base_path;
+  merged_path.points.clear();
+  std::vector<size_t> held_point_indices(paths.size(), 0);
+  double prev_arc_length = 0.0;
+  for (const auto & candidate : candidates) {
+    if (!merged_path.points.empty() && candidate.arc_length < prev_arc_length + epsilon) {
+      continue;
+    }
+    prev_arc_length = candidate.arc_length;
+
+    // the velocity of a path at an arc length is the one of its last point before it
+    auto point = paths.at(candidate.path_idx)->points.at(candidate.point_idx);
+    for (size_t i = 0; i < paths.size(); ++i) {
+      auto & held_idx = held_point_indices.at(i);
+      while (held_idx + 1 < arc_lengths.at(i).size() &&
+             arc_lengths.at(i).at(held_idx + 1) < candidate.arc_length + epsilon) {
+        ++held_idx;
+      }
+      point.point.longitudinal_velocity_mps = std::min(
+        point.point.longitudinal_velocity_mps,
+        paths.at(i)->points.at(held_idx).point.longitudinal_velocity_mps);
+    }
+    merged_path.points.push_back(point);
+  }
+  return merged_path;
+}
 }  // namespace planning_utils
 }  // namespace behavior_velocity_planner
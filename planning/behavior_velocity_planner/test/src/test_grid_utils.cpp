@@ -175,3 +175,51 @@ TEST(test, erode_with_custom_kernel)
   // cv::imshow("erode", cv_image);
   // cv::waitKey(5000);
 }
+
+TEST(isCollisionFree, clearanceLookupAsPolygonIterator)
+{
+  using behavior_velocity_planner::grid_utils::addClearanceLayer;
+  using behavior_velocity_planner::grid_utils::isCollisionFree;
+  grid_map::GridMap grid = test::generateGrid(10, 10, 1.0);
+  grid_map::Index occupied_index;
+  ASSERT_TRUE(grid.getIndex(grid_map::Position(5.5, 5.5), occupied_index));
+  grid.at("layer", occupied_index) = OCCUPIED;
+  grid_map::GridMap grid_with_clearance = grid;
+  addClearanceLayer(grid_with_clearance);
+
+  const std::vector<std::pair<grid_map::Position, grid_map::Position>> lines = {
+    {{0.5, 5.5}, {9.5, 5.5}}, {{0.5, 1.5}, {9.5, 1.5}}, {{5.5, 0.5}, {5.5, 9.5}},
+    {{0.5, 0.5}, {9.5, 9.5}}, {{0.5, 8.5}, {9.5, 8.5}}, {{8.5, 0.5}, {8.5, 9.5}}};
+  for (const auto & line : lines) {
+    EXPECT_EQ(
+      isCollisionFree(grid, line.first, line.second, 0.5),
+      isCollisionFree(grid_with_clearance, line.first, line.second, 0.5));
+  }
+  EXPECT_FALSE(isCollisionFree(grid_with_clearance, {0.5, 5.5}, {9.5, 5.5}, 0.5));
+  EXPECT_TRUE(isCollisionFree(grid_with_clearance, {0.5, 1.5}, {9.5, 1.5}, 0.5));
+}
+
+TEST(generateRaycastShadowImage, shadowBehindPolygon)
+{
+  using behavior_velocity_planner::grid_utils::generateRaycastShadowImage;
+  using behavior_velocity_planner::grid_utils::occlusion_cost_value::OCCUPIED_IMAGE;
+  const std::vector<std::vector<cv::Point>> cv_polygons = {
+    {{60, 48}, {64, 48}, {64, 52}, {60, 52}}};
+  const cv::Point2d origin(50.0, 50.0);
+  {
+    cv::Mat image(100, 100, CV_8UC1, cv::Scalar(0));
+    generateRaycastShadowImage(cv_polygons, origin, 0.0, image);
+    EXPECT_EQ(image.at<unsigned char>(50, 62), OCCUPIED_IMAGE);  // polygon
+    EXPECT_EQ(image.at<unsigned char>(50, 80), OCCUPIED_IMAGE);  // behind polygon
+    EXPECT_EQ(image.at<unsigned char>(50, 55), 0);               // in front of polygon
+    EXPECT_EQ(image.at<unsigned char>(50, 40), 0);               // opposite side
+    EXPECT_EQ(image.at<unsigned char>(62, 80), 0);               // beside the shadow
+  }
+  {
+    cv::Mat image(100, 100, CV_8UC1, cv::Scalar(0));
+    generateRaycastShadowImage(cv_polygons, origin, M_PI / 6.0, image);
+    EXPECT_EQ(image.at<unsigned char>(62, 80), OCCUPIED_IMAGE);  // widened by delay angle
+    EXPECT_EQ(image.at<unsigned char>(50, 55), 0);
+    EXPECT_EQ(image.at<unsigned char>(90, 70), 0);
+  }
+}
@@ -17,6 +17,7 @@
 #include "utils.hpp"
 
 #include <utilization/boost_geometry_helper.hpp>
+#include <utilization/predicted_objects_index.hpp>
 #include <utilization/util.hpp>
 
 #include <gtest/gtest.h>
@@ -182,3 +183,64 @@ TEST(specialInterpolation, specialInterpolation)
     EXPECT_DOUBLE_EQ(calcInterpolatedStopDist(px, vx), expected);
   }
 }
+
+TEST(mergeModifiedPaths, sameAsSequentialPlanning)
+{
+  using behavior_velocity_planner::planning_utils::insertStopPoint;
+  using behavior_velocity_planner::planning_utils::mergeModifiedPaths;
+  using behavior_velocity_planner::planning_utils::setVelocityFromIndex;
+  using tier4_autoware_utils::createPoint;
+
+  auto base_path = test::generatePath(0.0, 0.0, 10.0, 0.0, 11);
+  test::addConstantVelocity(base_path, 10.0);
+
+  // a module inserting a stop point and another one slowing down, planned independently
+  auto stop_path = base_path;
+  insertStopPoint(createPoint(5.5, 0.0, 0.0), stop_path);
+  auto slow_down_path = base_path;
+  setVelocityFromIndex(2, 1.0, &slow_down_path);
+
+  auto sequential_path = base_path;
+  insertStopPoint(createPoint(5.5, 0.0, 0.0), sequential_path);
+  setVelocityFromIndex(2, 1.0, &sequential_path);
+
+  const auto merged_path = mergeModifiedPaths(base_path, {stop_path, slow_down_path});
+  ASSERT_EQ(merged_path.points.size(), sequential_path.points.size());
+  for (size_t i = 0; i < merged_path.points.size(); ++i) {
+    const auto & merged_point = merged_path.points.at(i).point;
+    const auto & sequential_point = sequential_path.points.at(i).point;
+    EXPECT_NEAR(merged_point.pose.position.x, sequential_point.pose.position.x, 1e-6);
+    EXPECT_FLOAT_EQ(
+      merged_point.longitudinal_velocity_mps, sequential_point.longitudinal_velocity_mps);
+  }
+}
+
+TEST(predictedObjectsIndex, queryFootprintsAndPredictedPaths)
+{
+  using behavior_velocity_planner::Box2d;
+  using behavior_velocity_planner::Point2d;
+  using behavior_velocity_planner::PredictedObjectsIndex;
+  autoware_auto_perception_msgs::msg::PredictedObjects objects;
+  for (const double x : {0.0, 20.0, 40.0}) {
+    objects.objects.push_back(test::generatePredictedObject(x));
+  }
+  // the last object goes to (40, 30)
+  autoware_auto_perception_msgs::msg::PredictedPath predicted_path;
+  predicted_path.path.push_back(test::generatePose(40.0));
+  predicted_path.path.push_back(test::generatePose(40.0));
+  predicted_path.path.back().position.y = 30.0;
+  objects.objects.back().kinematics.predicted_paths.push_back(predicted_path);
+
+  const PredictedObjectsIndex index(objects);
+  const Box2d around_second_object(Point2d(15.0, -5.0), Point2d(25.0, 5.0));
+  EXPECT_EQ(index.queryFootprints(around_second_object), std::vector<size_t>({1}));
+  EXPECT_EQ(index.queryPredictedPaths(around_second_object), std::vector<size_t>({1}));
+
+  const Box2d on_predicted_path(Point2d(35.0, 25.0), Point2d(45.0, 35.0));
+  EXPECT_TRUE(index.queryFootprints(on_predicted_path).empty());
+  EXPECT_EQ(index.queryPredictedPaths(on_predicted_path), std::vector<size_t>({2}));
+
+  const Box2d around_all_objects(Point2d(-10.0, -10.0), Point2d(50.0, 10.0));
+  EXPECT_EQ(index.queryFootprints(around_all_objects), std::vector<size_t>({0, 1, 2}));
+  EXPECT_EQ(index.queryPredictedPaths(around_all_objects), std::vector<size_t>({0, 1, 2}));
+}
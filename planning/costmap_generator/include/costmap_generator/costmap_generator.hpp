@@ -107,6 +107,7 @@ private:
 
   double expand_polygon_size_;
   int size_of_expansion_kernel_;
+  bool use_object_footprint_cache_;
 
   grid_map::GridMap costmap_;
 
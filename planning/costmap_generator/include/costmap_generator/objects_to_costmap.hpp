@@ -56,6 +56,8 @@
 #include <autoware_auto_perception_msgs/msg/predicted_objects.hpp>
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class ObjectsToCostmap
 {
@@ -67,11 +69,13 @@ public:
   /// \param[in] expand_polygon_size: expand object's costmap polygon
   /// \param[in] size_of_expansion_kernel: kernel size for blurring cost
   /// \param[in] in_objects: subscribed PredictedObjects
+  /// \param[in] use_footprint_cache: reuse the cells of the objects whose polygon only moved
   /// \param[out] calculated cost in grid_map::Matrix format
   grid_map::Matrix makeCostmapFromObjects(
     const grid_map::GridMap & costmap, const double expand_polygon_size,
     const double size_of_expansion_kernel,
-    const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr in_objects);
+    const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr in_objects,
+    const bool use_footprint_cache = false);
 
 private:
   const int NUMBER_OF_POINTS;
@@ -79,6 +83,16 @@ private:
   const std::string OBJECTS_COSTMAP_LAYER_;
   const std::string BLURRED_OBJECTS_COSTMAP_LAYER_;
 
+  // cells of the polygon of an object, relative to the position of the object
+  struct ObjectFootprint
+  {
+    std::vector<grid_map::Position> vertices;
+    double resolution;
+    std::vector<grid_map::Position> cell_offsets;
+  };
+  // footprints of the objects of the previous cycle by uuid
+  std::unordered_map<std::string, ObjectFootprint> footprint_cache_;
+
   /// \brief make 4 rectangle points from centroid position and orientation
   /// \param[in] in_object: subscribed one of PredictedObjects
   /// \param[in] expand_rectangle_size: expanding 4 points
@@ -122,6 +136,21 @@ private:
   void setCostInPolygon(
     const grid_map::Polygon & polygon, const std::string & gridmap_layer_name, const float score,
     grid_map::GridMap & objects_costmap);
+
+  /// \brief set cost in polygon from the cells cached for the object, the cells are computed
+  /// again when the polygon changed other than its position
+  /// \param[in] polygon: polygon of the object
+  /// \param[in] object: the object of the polygon
+  /// \param[in] score: set score as a cost for costmap
+  /// \param[in] objects_costmap: update cost in the objects layers of objects_costmap
+  /// \param[in] cache: cache of the previous cycle, the footprint of the object is moved to it
+  /// \param[out] next_cache: the footprint of the object is stored for the next cycle
+  void setCostInCachedPolygon(
+    const grid_map::Polygon & polygon,
+    const autoware_auto_perception_msgs::msg::PredictedObject & object, const float score,
+    grid_map::GridMap & objects_costmap,
+    std::unordered_map<std::string, ObjectFootprint> & cache,
+    std::unordered_map<std::string, ObjectFootprint> & next_cache);
 };
 
 #endif  // COSTMAP_GENERATOR__OBJECTS_TO_COSTMAP_HPP_
@@ -59,6 +59,7 @@
 #include <tf2_eigen/tf2_eigen.hpp>
 #endif
 
+#include <future>
 #include <memory>
 #include <string>
 #include <utility>
@@ -181,6 +182,8 @@ CostmapGenerator::CostmapGenerator(const rclcpp::NodeOptions & node_options)
   use_parkinglot_ = this->declare_parameter<bool>("use_parkinglot", true);
   expand_polygon_size_ = this->declare_parameter<double>("expand_polygon_size", 1.0);
   size_of_expansion_kernel_ = this->declare_parameter<int>("size_of_expansion_kernel", 9);
+  use_object_footprint_cache_ =
+    this->declare_parameter<bool>("use_object_footprint_cache", false);
 
   // Wait for first tf
   // We want to do this before creating subscriptions
@@ -315,16 +318,35 @@ void CostmapGenerator::onTimer()
   p.y() = tf.transform.translation.y;
   costmap_.setPosition(p);
 
+  // the layers only read costmap_ and are independent of each other, so they are generated in
+  // parallel and written after all of them are done
+  std::future<grid_map::Matrix> primitives_costmap;
   if ((use_wayarea_ || use_parkinglot_) && lanelet_map_) {
-    costmap_[LayerName::primitives] = generatePrimitivesCostmap();
+    primitives_costmap =
+      std::async(std::launch::async, [this]() { return generatePrimitivesCostmap(); });
   }
 
+  std::future<grid_map::Matrix> objects_costmap;
   if (use_objects_ && objects_) {
-    costmap_[LayerName::objects] = generateObjectsCostmap(objects_);
+    objects_costmap =
+      std::async(std::launch::async, [this]() { return generateObjectsCostmap(objects_); });
   }
 
-  if (use_points_ && points_) {
-    costmap_[LayerName::points] = generatePointsCostmap(points_);
+  // the points layer is generated on this thread
+  const bool use_points = use_points_ && points_;
+  grid_map::Matrix points_costmap;
+  if (use_points) {
+    points_costmap = generatePointsCostmap(points_);
+  }
+
+  if (primitives_costmap.valid()) {
+    costmap_[LayerName::primitives] = primitives_costmap.get();
+  }
+  if (objects_costmap.valid()) {
+    costmap_[LayerName::objects] = objects_costmap.get();
+  }
+  if (use_points) {
+    costmap_[LayerName::points] = points_costmap;
   }
 
   costmap_[LayerName::combined] = generateCombinedCostmap();
@@ -417,7 +439,8 @@ grid_map::Matrix CostmapGenerator::generateObjectsCostmap(
     transformObjects(tf_buffer_, in_objects, costmap_frame_, object_frame);
 
   grid_map::Matrix objects_costmap = objects2costmap_.makeCostmapFromObjects(
-    costmap_, expand_polygon_size_, size_of_expansion_kernel_, transformed_objects);
+    costmap_, expand_polygon_size_, size_of_expansion_kernel_, transformed_objects,
+    use_object_footprint_cache_);
 
   return objects_costmap;
 }
@@ -435,21 +458,16 @@ grid_map::Matrix CostmapGenerator::generatePrimitivesCostmap()
 
 grid_map::Matrix CostmapGenerator::generateCombinedCostmap()
 {
-  // assuming combined_costmap is calculated by element wise max operation
-  grid_map::GridMap combined_costmap = costmap_;
-
-  combined_costmap[LayerName::combined].setConstant(grid_min_value_);
-
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::points]);
-
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::primitives]);
+  // assuming combined_costmap is calculated by element wise max operation, on the layers of
+  // costmap_ without copying the whole grid map
+  grid_map::Matrix combined_costmap = costmap_[LayerName::points];
+  combined_costmap.setConstant(grid_min_value_);
 
-  combined_costmap[LayerName::combined] =
-    combined_costmap[LayerName::combined].cwiseMax(combined_costmap[LayerName::objects]);
+  combined_costmap = combined_costmap.cwiseMax(costmap_[LayerName::points]);
+  combined_costmap = combined_costmap.cwiseMax(costmap_[LayerName::primitives]);
+  combined_costmap = combined_costmap.cwiseMax(costmap_[LayerName::objects]);
 
-  return combined_costmap[LayerName::combined];
+  return combined_costmap;
 }
 
 void CostmapGenerator::publishCostmap(const grid_map::GridMap & costmap)
@@ -44,10 +44,15 @@
 
 #include "costmap_generator/objects_to_costmap.hpp"
 
+#include <grid_map_utils/polygon_iterator.hpp>
 #include <tf2/utils.h>
 
+#include <algorithm>
 #include <cmath>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 // Constructor
 ObjectsToCostmap::ObjectsToCostmap()
@@ -146,23 +151,96 @@ void ObjectsToCostmap::setCostInPolygon(
   const grid_map::Polygon & polygon, const std::string & gridmap_layer_name, const float score,
   grid_map::GridMap & objects_costmap)
 {
-  for (grid_map::PolygonIterator itr(objects_costmap, polygon); !itr.isPastEnd(); ++itr) {
-    const float current_score = objects_costmap.at(gridmap_layer_name, *itr);
-    if (score > current_score) {
-      objects_costmap.at(gridmap_layer_name, *itr) = score;
+  // the cells of a span are consecutive in a row of the layer, so that they are raised at once
+  grid_map::Matrix & layer = objects_costmap[gridmap_layer_name];
+  const auto spans = grid_map_utils::PolygonIterator::calculateSpans(objects_costmap, polygon);
+  for (const auto & span : spans) {
+    auto cells = layer.block(span.row, span.from_col, 1, span.to_col - span.from_col);
+    cells = cells.cwiseMax(score);
+  }
+}
+
+void ObjectsToCostmap::setCostInCachedPolygon(
+  const grid_map::Polygon & polygon,
+  const autoware_auto_perception_msgs::msg::PredictedObject & object, const float score,
+  grid_map::GridMap & objects_costmap, std::unordered_map<std::string, ObjectFootprint> & cache,
+  std::unordered_map<std::string, ObjectFootprint> & next_cache)
+{
+  const auto & object_position = object.kinematics.initial_pose_with_covariance.pose.position;
+  const grid_map::Position origin(object_position.x, object_position.y);
+
+  std::vector<grid_map::Position> vertices;
+  for (const auto & vertex : polygon.getVertices()) {
+    vertices.push_back(vertex - origin);
+  }
+
+  const std::string uuid(object.object_id.uuid.begin(), object.object_id.uuid.end());
+  const auto itr = cache.find(uuid);
+  const auto is_same_vertex = [](const grid_map::Position & a, const grid_map::Position & b) {
+    constexpr double epsilon = 1e-6;
+    return (a - b).cwiseAbs().maxCoeff() < epsilon;
+  };
+  const bool is_cache_valid =
+    itr != cache.end() && itr->second.resolution == objects_costmap.getResolution() &&
+    itr->second.vertices.size() == vertices.size() &&
+    std::equal(vertices.begin(), vertices.end(), itr->second.vertices.begin(), is_same_vertex);
+
+  ObjectFootprint footprint;
+  if (is_cache_valid) {
+    footprint = std::move(itr->second);
+  } else {
+    // the cells out of the grid map are not iterated, so that the footprint is cached only when
+    // the whole polygon is in the grid map
+    const bool is_inside = std::all_of(
+      polygon.getVertices().begin(), polygon.getVertices().end(),
+      [&objects_costmap](const grid_map::Position & vertex) {
+        return objects_costmap.isInside(vertex);
+      });
+    if (!is_inside) {
+      setCostInPolygon(polygon, OBJECTS_COSTMAP_LAYER_, score, objects_costmap);
+      setCostInPolygon(polygon, BLURRED_OBJECTS_COSTMAP_LAYER_, score, objects_costmap);
+      return;
     }
+
+    footprint.vertices = vertices;
+    footprint.resolution = objects_costmap.getResolution();
+    for (grid_map_utils::PolygonIterator cell_itr(objects_costmap, polygon); !cell_itr.isPastEnd();
+         ++cell_itr) {
+      grid_map::Position cell_position;
+      objects_costmap.getPosition(*cell_itr, cell_position);
+      footprint.cell_offsets.push_back(cell_position - origin);
+    }
+  }
+
+  // the grid is not rotated, so that the cells moved by the same offset are still adjacent
+  grid_map::Matrix & objects_layer = objects_costmap[OBJECTS_COSTMAP_LAYER_];
+  grid_map::Matrix & blurred_objects_layer = objects_costmap[BLURRED_OBJECTS_COSTMAP_LAYER_];
+  for (const auto & cell_offset : footprint.cell_offsets) {
+    grid_map::Index index;
+    if (!objects_costmap.getIndex(origin + cell_offset, index)) {
+      continue;
+    }
+    objects_layer(index(0), index(1)) = std::max(objects_layer(index(0), index(1)), score);
+    blurred_objects_layer(index(0), index(1)) =
+      std::max(blurred_objects_layer(index(0), index(1)), score);
   }
+
+  next_cache[uuid] = std::move(footprint);
 }
 
 grid_map::Matrix ObjectsToCostmap::makeCostmapFromObjects(
   const grid_map::GridMap & costmap, const double expand_polygon_size,
   const double size_of_expansion_kernel,
-  const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr in_objects)
+  const autoware_auto_perception_msgs::msg::PredictedObjects::ConstSharedPtr in_objects,
+  const bool use_footprint_cache)
 {
   grid_map::GridMap objects_costmap = costmap;
   objects_costmap.add(OBJECTS_COSTMAP_LAYER_, 0);
   objects_costmap.add(BLURRED_OBJECTS_COSTMAP_LAYER_, 0);
 
+  // the footprints of the objects which are not in this cycle are dropped
+  std::unordered_map<std::string, ObjectFootprint> next_footprint_cache;
+
   for (const auto & object : in_objects->objects) {
     grid_map::Polygon polygon;
     if (object.shape.type == autoware_auto_perception_msgs::msg::Shape::POLYGON) {
@@ -177,9 +255,16 @@ grid_map::Matrix ObjectsToCostmap::makeCostmapFromObjects(
       object.classification.begin(), object.classification.end(),
       [](const auto & c1, const auto & c2) { return c1.probability < c2.probability; });
     const double highest_probability = static_cast<double>(highest_probability_label.probability);
+    if (use_footprint_cache) {
+      setCostInCachedPolygon(
+        polygon, object, highest_probability, objects_costmap, footprint_cache_,
+        next_footprint_cache);
+      continue;
+    }
     setCostInPolygon(polygon, OBJECTS_COSTMAP_LAYER_, highest_probability, objects_costmap);
     setCostInPolygon(polygon, BLURRED_OBJECTS_COSTMAP_LAYER_, highest_probability, objects_costmap);
   }
+  footprint_cache_ = std::move(next_footprint_cache);
 
   // Applying mean filter to expanded gridmap
   const grid_map::SlidingWindowIterator::EdgeHandling edge_handling =
@@ -134,3 +134,43 @@ TEST_F(ObjectsToCostMapTest, TestMakeCostmapFromObjects)
     }
   }
 }
+
+TEST_F(ObjectsToCostMapTest, TestMakeCostmapFromObjectsWithFootprintCache)
+{
+  auto objs = std::make_shared<autoware_auto_perception_msgs::msg::PredictedObjects>();
+  autoware_auto_perception_msgs::msg::PredictedObject object;
+
+  object.classification.push_back(autoware_auto_perception_msgs::msg::ObjectClassification{});
+  object.classification.at(0).label = LABEL::CAR;
+  object.classification.at(0).probability = 0.8;
+  object.object_id.uuid.fill(1);
+
+  object.kinematics.initial_pose_with_covariance.pose.position.x = 1;
+  object.kinematics.initial_pose_with_covariance.pose.position.y = 2;
+  object.kinematics.initial_pose_with_covariance.pose.orientation.w = 1;
+
+  object.shape.type = autoware_auto_perception_msgs::msg::Shape::BOUNDING_BOX;
+  object.shape.dimensions.x = 5;
+  object.shape.dimensions.y = 3;
+  object.shape.dimensions.z = 2;
+
+  objs->objects.push_back(object);
+
+  grid_map::GridMap gridmap = construct_gridmap();
+  ObjectsToCostmap cached_objects_to_costmap;
+  ObjectsToCostmap objects_to_costmap;
+
+  const double expand_polygon_size = 0.0;
+  const double size_of_expansion_kernel = 1;
+  const bool use_footprint_cache = true;
+
+  // the cells of the first cycle are reused for the object moved by a cell
+  for (const double x : {1.0, 2.0, 2.0}) {
+    objs->objects.at(0).kinematics.initial_pose_with_covariance.pose.position.x = x;
+    const grid_map::Matrix cached_costmap = cached_objects_to_costmap.makeCostmapFromObjects(
+      gridmap, expand_polygon_size, size_of_expansion_kernel, objs, use_footprint_cache);
+    const grid_map::Matrix costmap = objects_to_costmap.makeCostmapFromObjects(
+      gridmap, expand_polygon_size, size_of_expansion_kernel, objs);
+    EXPECT_TRUE(cached_costmap.isApprox(costmap));
+  }
+}
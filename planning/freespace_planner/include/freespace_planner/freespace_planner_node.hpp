@@ -87,6 +87,8 @@ struct NodeParam
   double vehicle_shape_margin_m;
   bool replan_when_obstacle_found;
   bool replan_when_course_out;
+  bool enable_planning_over_cycles;
+  double planning_time_limit_per_cycle_ms;
 };
 
 class FreespacePlannerNode : public rclcpp::Node
@@ -151,6 +153,8 @@ private:
   void reset();
   bool isPlanRequired();
   void planTrajectory();
+  void resumePlanTrajectory();
+  void setTrajectory(const bool is_plan_found);
   void updateTargetIndex();
   void initializePlanningAlgorithm();
 
@@ -34,6 +34,7 @@
 
 #include <algorithm>
 #include <deque>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -224,6 +225,9 @@ FreespacePlannerNode::FreespacePlannerNode(const rclcpp::NodeOptions & node_opti
     p.vehicle_shape_margin_m = declare_parameter("vehicle_shape_margin_m", 1.0);
     p.replan_when_obstacle_found = declare_parameter("replan_when_obstacle_found", true);
     p.replan_when_course_out = declare_parameter("replan_when_course_out", true);
+    p.enable_planning_over_cycles = declare_parameter("enable_planning_over_cycles", false);
+    p.planning_time_limit_per_cycle_ms =
+      declare_parameter("planning_time_limit_per_cycle_ms", 50.0);
   }
 
   // Planning
@@ -304,6 +308,7 @@ void FreespacePlannerNode::getAstarParam()
   p.only_behind_solutions = declare_parameter("astar.only_behind_solutions", false);
   p.use_back = declare_parameter("astar.use_back", true);
   p.distance_heuristic_weight = declare_parameter("astar.distance_heuristic_weight", 1.0);
+  p.use_obstacle_heuristic = declare_parameter("astar.use_obstacle_heuristic", false);
 }
 
 void FreespacePlannerNode::onRoute(const HADMapRoute::ConstSharedPtr msg)
@@ -431,7 +436,15 @@ void FreespacePlannerNode::onTimer()
   }
 
   initializePlanningAlgorithm();
-  if (isPlanRequired()) {
+  if (algo_->isPlanSuspended()) {
+    // Keep stopping while the planning continues over the cycles
+    const auto stop_trajectory = createStopTrajectory(current_pose_);
+    trajectory_pub_->publish(stop_trajectory);
+    debug_pose_array_pub_->publish(trajectory2PoseArray(stop_trajectory));
+    debug_partial_pose_array_pub_->publish(trajectory2PoseArray(stop_trajectory));
+
+    resumePlanTrajectory();
+  } else if (isPlanRequired()) {
     reset();
 
     // Stop before planning new trajectory
@@ -472,6 +485,9 @@ void FreespacePlannerNode::planTrajectory()
   // Provide robot shape and map for the planner
   algo_->setVehicleShape(extended_vehicle_shape);
   algo_->setMap(*occupancy_grid_);
+  algo_->setSuspendTimeLimit(
+    node_param_.enable_planning_over_cycles ? node_param_.planning_time_limit_per_cycle_ms
+                                            : std::numeric_limits<double>::infinity());
 
   // Calculate poses in costmap frame
   const auto current_pose_in_costmap_frame = transformPose(
@@ -488,7 +504,24 @@ void FreespacePlannerNode::planTrajectory()
 
   RCLCPP_INFO(get_logger(), "Freespace planning: %f [s]", (end - start).seconds());
 
-  if (result) {
+  setTrajectory(result);
+}
+
+void FreespacePlannerNode::resumePlanTrajectory()
+{
+  // the planner keeps the map and the poses of the suspended plan
+  const rclcpp::Time start = get_clock()->now();
+  const bool result = algo_->resumePlan();
+  const rclcpp::Time end = get_clock()->now();
+
+  RCLCPP_INFO(get_logger(), "Freespace planning resumed: %f [s]", (end - start).seconds());
+
+  setTrajectory(result);
+}
+
+void FreespacePlannerNode::setTrajectory(const bool is_plan_found)
+{
+  if (is_plan_found) {
     RCLCPP_INFO(get_logger(), "Found goal!");
     trajectory_ =
       createTrajectory(current_pose_, algo_->getWaypoints(), node_param_.waypoints_velocity);
@@ -497,6 +530,8 @@ void FreespacePlannerNode::planTrajectory()
     target_index_ =
       getNextTargetIndex(trajectory_.points.size(), reversing_indices_, prev_target_index_);
 
+  } else if (algo_->isPlanSuspended()) {
+    RCLCPP_INFO(get_logger(), "Planning is continued on the next cycle");
   } else {
     RCLCPP_INFO(get_logger(), "Can't find goal...");
     reset();
@@ -508,6 +543,9 @@ void FreespacePlannerNode::reset()
   trajectory_ = Trajectory();
   partial_trajectory_ = Trajectory();
   is_completed_ = false;
+  if (algo_) {
+    algo_->abortPlan();
+  }
   std_msgs::msg::Bool is_completed_msg;
   is_completed_msg.data = is_completed_;
   parking_state_pub_->publish(is_completed_msg);
@@ -528,6 +566,11 @@ TransformStamped FreespacePlannerNode::getTransform(
 
 void FreespacePlannerNode::initializePlanningAlgorithm()
 {
+  // keep the planner of the suspended plan to resume it
+  if (algo_ && algo_->isPlanSuspended()) {
+    return;
+  }
+
   if (node_param_.planning_algorithm == "astar") {
     algo_.reset(new AstarSearch(planner_common_param_, astar_param_));
   } else {
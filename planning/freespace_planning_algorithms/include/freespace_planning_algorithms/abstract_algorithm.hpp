@@ -22,6 +22,8 @@
 
 #include <tf2/utils.h>
 
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 namespace freespace_planning_algorithms
@@ -41,6 +43,14 @@ struct IndexXY
   int y;
 };
 
+// cells [x_begin, x_end] of a row of the footprint, relative to the base cell
+struct FootprintRow
+{
+  int y;
+  int x_begin;
+  int x_end;
+};
+
 IndexXYT pose2index(
   const nav_msgs::msg::OccupancyGrid & costmap, const geometry_msgs::msg::Pose & pose_local,
   const int theta_size);
@@ -106,7 +116,14 @@ public:
   virtual void setMap(const nav_msgs::msg::OccupancyGrid & costmap);
   virtual bool makePlan(
     const geometry_msgs::msg::Pose & start_pose, const geometry_msgs::msg::Pose & goal_pose) = 0;
+  // continue the plan suspended on the time limit of the previous makePlan() or resumePlan() call
+  virtual bool resumePlan() = 0;
   virtual bool hasFeasibleSolution() = 0;  // currently used only in testing
+  // time limit of each makePlan() or resumePlan() call, the search is suspended when it is reached
+  // before the time limit of the whole plan [msec]
+  void setSuspendTimeLimit(const double time_limit) { suspend_time_limit_ = time_limit; }
+  bool isPlanSuspended() const { return is_plan_suspended_; }
+  void abortPlan() { is_plan_suspended_ = false; }
   void setVehicleShape(const VehicleShape & vehicle_shape)
   {
     planner_common_param_.vehicle_shape = vehicle_shape;
@@ -133,19 +150,27 @@ protected:
     // NOTE: Accessing by .at() instead makes 1.2 times slower here.
     // Also, boundary check is already done in isOutOfRange before calling this function.
     // So, basically .at() is not necessary.
-    return is_obstacle_table_[index.y][index.x];
+    const uint64_t word = obstacle_bits_[index.y * obstacle_words_per_row_ + (index.x >> 6)];
+    return (word >> (index.x & 63)) & 1;
   }
+  // whether any of the cells [x_begin, x_end] of the row y is obstacle, tested by 64 cells
+  bool hasObstacleInRow(const int y, const int x_begin, const int x_end) const;
 
   PlannerCommonParam planner_common_param_;
+  double suspend_time_limit_{std::numeric_limits<double>::infinity()};
+  bool is_plan_suspended_{false};
 
   // costmap as occupancy grid
   nav_msgs::msg::OccupancyGrid costmap_;
 
   // collision indexes cache
   std::vector<std::vector<IndexXY>> coll_indexes_table_;
+  // collision indexes cache merged into the runs of cells in each row
+  std::vector<std::vector<FootprintRow>> coll_rows_table_;
 
-  // is_obstacle's table
-  std::vector<std::vector<bool>> is_obstacle_table_;
+  // is_obstacle's table, a bit per cell and the rows aligned to the words
+  std::vector<uint64_t> obstacle_bits_;
+  int obstacle_words_per_row_{0};
 
   // pose in costmap frame
   geometry_msgs::msg::Pose start_pose_;
@@ -22,11 +22,14 @@
 #include <std_msgs/msg/header.hpp>
 
 #include <cmath>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <queue>
 #include <string>
 #include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace freespace_planning_algorithms
@@ -41,6 +44,7 @@ struct AstarParam
 
   // search configs
   double distance_heuristic_weight;  // obstacle threshold on grid [0,255]
+  bool use_obstacle_heuristic;       // also estimate the cost by the distance around the obstacles
 };
 
 struct AstarNode
@@ -57,12 +61,13 @@ struct AstarNode
   double cost() const { return gc + hc; }
 };
 
+// node in the open list with its cost when it was pushed, since the cost of the node itself is
+// lowered when a cheaper parent is found
+using OpenNode = std::pair<double, AstarNode *>;
+
 struct NodeComparison
 {
-  bool operator()(const AstarNode * lhs, const AstarNode * rhs)
-  {
-    return lhs->cost() > rhs->cost();
-  }
+  bool operator()(const OpenNode & lhs, const OpenNode & rhs) { return lhs.first > rhs.first; }
 };
 
 struct NodeUpdate
@@ -111,6 +116,7 @@ public:
   bool makePlan(
     const geometry_msgs::msg::Pose & start_pose,
     const geometry_msgs::msg::Pose & goal_pose) override;
+  bool resumePlan() override;
   bool hasFeasibleSolution() override;  // currently used only in testing
 
   const PlannerWaypoints & getWaypoints() const { return waypoints_; }
@@ -122,17 +128,28 @@ private:
   bool setStartNode();
   bool setGoalNode();
   double estimateCost(const geometry_msgs::msg::Pose & pose);
+  void computeObstacleHeuristic();
   bool isGoal(const AstarNode & node);
 
-  AstarNode * getNodeRef(const IndexXYT & index) { return &nodes_[index.y][index.x][index.theta]; }
+  AstarNode * getNodeRef(const IndexXYT & index);
 
   // Algorithm specific param
   AstarParam astar_param_;
 
   // hybrid astar variables
   TransitionTable transition_table_;
-  std::vector<std::vector<std::vector<AstarNode>>> nodes_;
-  std::priority_queue<AstarNode *, std::vector<AstarNode *>, NodeComparison> openlist_;
+  // only the visited nodes are stored. the pool keeps its memory over the plans, and the nodes are
+  // not moved when it grows, so that they can be referred by pointer.
+  std::deque<AstarNode> node_pool_;
+  size_t node_pool_size_{0};
+  std::unordered_map<size_t, AstarNode *> nodes_;  // visited nodes by index of x, y and theta
+  std::priority_queue<OpenNode, std::vector<OpenNode>, NodeComparison> openlist_;
+
+  // shortest distance from each cell to the goal cell through the free cells [m]
+  std::vector<double> obstacle_heuristic_;
+
+  // time spent on the search of the plan over the suspended calls [msec]
+  double search_time_{0.0};
 
   // goal node, which may helpful in testing and debugging
   AstarNode * goal_node_;
@@ -16,6 +16,7 @@
 
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
+#include <algorithm>
 #include <vector>
 
 namespace freespace_planning_algorithms
@@ -94,25 +95,40 @@ void AbstractPlanningAlgorithm::setMap(const nav_msgs::msg::OccupancyGrid & cost
   const auto width = costmap_.info.width;
 
   // Initialize status
-  std::vector<std::vector<bool>> is_obstacle_table;
-  is_obstacle_table.resize(height);
+  obstacle_words_per_row_ = (width + 63) / 64;
+  obstacle_bits_.assign(static_cast<size_t>(height) * obstacle_words_per_row_, 0);
   for (uint32_t i = 0; i < height; i++) {
-    is_obstacle_table.at(i).resize(width);
+    uint64_t * row = &obstacle_bits_[static_cast<size_t>(i) * obstacle_words_per_row_];
     for (uint32_t j = 0; j < width; j++) {
       const int cost = costmap_.data[i * width + j];
 
       if (cost < 0 || planner_common_param_.obstacle_threshold <= cost) {
-        is_obstacle_table[i][j] = true;
+        row[j >> 6] |= uint64_t{1} << (j & 63);
       }
     }
   }
-  is_obstacle_table_ = is_obstacle_table;
 
   // construct collision indexes table
+  coll_indexes_table_.clear();
+  coll_rows_table_.clear();
   for (int i = 0; i < planner_common_param_.theta_size; i++) {
     std::vector<IndexXY> indexes_2d;
     computeCollisionIndexes(i, indexes_2d);
     coll_indexes_table_.push_back(indexes_2d);
+
+    // merge the cells into the runs of consecutive cells in each row
+    std::sort(indexes_2d.begin(), indexes_2d.end(), [](const IndexXY & a, const IndexXY & b) {
+      return a.y != b.y ? a.y < b.y : a.x < b.x;
+    });
+    std::vector<FootprintRow> rows;
+    for (const auto & index : indexes_2d) {
+      if (!rows.empty() && rows.back().y == index.y && index.x <= rows.back().x_end + 1) {
+        rows.back().x_end = std::max(rows.back().x_end, index.x);
+      } else {
+        rows.push_back(FootprintRow{index.y, index.x, index.x});
+      }
+    }
+    coll_rows_table_.push_back(rows);
   }
 }
 
@@ -158,17 +174,44 @@ void AbstractPlanningAlgorithm::computeCollisionIndexes(
   addIndex2d(front, left);
 }
 
+bool AbstractPlanningAlgorithm::hasObstacleInRow(
+  const int y, const int x_begin, const int x_end) const
+{
+  const uint64_t * row = &obstacle_bits_[static_cast<size_t>(y) * obstacle_words_per_row_];
+  const int first_word = x_begin >> 6;
+  const int last_word = x_end >> 6;
+  const uint64_t first_mask = ~uint64_t{0} << (x_begin & 63);
+  const uint64_t last_mask = ~uint64_t{0} >> (63 - (x_end & 63));
+
+  if (first_word == last_word) {
+    return row[first_word] & first_mask & last_mask;
+  }
+  if (row[first_word] & first_mask) {
+    return true;
+  }
+  for (int word = first_word + 1; word < last_word; ++word) {
+    if (row[word]) {
+      return true;
+    }
+  }
+  return row[last_word] & last_mask;
+}
+
 bool AbstractPlanningAlgorithm::detectCollision(const IndexXYT & base_index)
 {
-  const auto & coll_indexes_2d = coll_indexes_table_[base_index.theta];
-  for (const auto & coll_index_2d : coll_indexes_2d) {
-    int idx_theta = 0;  // whatever. Yaw is nothing to do with collision detection between grids.
-    IndexXYT coll_index{coll_index_2d.x, coll_index_2d.y, idx_theta};
-    // must slide to current base position
-    coll_index.x += base_index.x;
-    coll_index.y += base_index.y;
-
-    if (isOutOfRange(coll_index) || isObs(coll_index)) {
+  const int width = costmap_.info.width;
+  const int height = costmap_.info.height;
+
+  // each row of the footprint is slid to current base position
+  for (const auto & coll_row : coll_rows_table_[base_index.theta]) {
+    const int y = base_index.y + coll_row.y;
+    const int x_begin = base_index.x + coll_row.x_begin;
+    const int x_end = base_index.x + coll_row.x_end;
+
+    if (y < 0 || height <= y || x_begin < 0 || width <= x_end) {
+      return true;
+    }
+    if (hasObstacleInRow(y, x_begin, x_end)) {
       return true;
     }
   }
@@ -24,6 +24,9 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <algorithm>
+#include <limits>
+#include <utility>
 #include <vector>
 
 namespace freespace_planning_algorithms
@@ -136,18 +139,6 @@ void AstarSearch::setMap(const nav_msgs::msg::OccupancyGrid & costmap)
   AbstractPlanningAlgorithm::setMap(costmap);
 
   clearNodes();
-
-  const auto height = costmap_.info.height;
-  const auto width = costmap_.info.width;
-
-  // Initialize nodes
-  nodes_.resize(height);
-  for (size_t i = 0; i < height; i++) {
-    nodes_[i].resize(width);
-    for (size_t j = 0; j < width; j++) {
-      nodes_[i][j].resize(planner_common_param_.theta_size);
-    }
-  }
 }
 
 bool AstarSearch::makePlan(
@@ -156,6 +147,14 @@ bool AstarSearch::makePlan(
   start_pose_ = global2local(costmap_, start_pose);
   goal_pose_ = global2local(costmap_, goal_pose);
 
+  clearNodes();
+  is_plan_suspended_ = false;
+  search_time_ = 0.0;
+
+  if (astar_param_.use_obstacle_heuristic) {
+    computeObstacleHeuristic();
+  }
+
   if (!setStartNode()) {
     return false;
   }
@@ -167,12 +166,45 @@ bool AstarSearch::makePlan(
   return search();
 }
 
+bool AstarSearch::resumePlan()
+{
+  if (!is_plan_suspended_) {
+    return false;
+  }
+  is_plan_suspended_ = false;
+
+  return search();
+}
+
 void AstarSearch::clearNodes()
 {
   // clearing openlist is necessary because otherwise remaining elements of openlist
   // point to deleted node.
   nodes_.clear();
-  openlist_ = std::priority_queue<AstarNode *, std::vector<AstarNode *>, NodeComparison>();
+  node_pool_size_ = 0;
+  openlist_ = std::priority_queue<OpenNode, std::vector<OpenNode>, NodeComparison>();
+  goal_node_ = nullptr;
+}
+
+AstarNode * AstarSearch::getNodeRef(const IndexXYT & index)
+{
+  const size_t key =
+    (static_cast<size_t>(index.y) * costmap_.info.width + index.x) *
+      planner_common_param_.theta_size +
+    index.theta;
+  const auto itr = nodes_.find(key);
+  if (itr != nodes_.end()) {
+    return itr->second;
+  }
+
+  if (node_pool_size_ < node_pool_.size()) {
+    node_pool_[node_pool_size_] = AstarNode{};
+  } else {
+    node_pool_.emplace_back();
+  }
+  AstarNode * node = &node_pool_[node_pool_size_++];
+  nodes_.emplace(key, node);
+  return node;
 }
 
 bool AstarSearch::setStartNode()
@@ -195,7 +227,7 @@ bool AstarSearch::setStartNode()
   start_node->parent = nullptr;
 
   // Push start node to openlist
-  openlist_.push(start_node);
+  openlist_.emplace(start_node->cost(), start_node);
 
   return true;
 }
@@ -225,9 +257,65 @@ double AstarSearch::estimateCost(const geometry_msgs::msg::Pose & pose)
     total_cost += tier4_autoware_utils::calcDistance2d(pose, goal_pose_) *
                   astar_param_.distance_heuristic_weight;
   }
+
+  // the distance of the center of the vehicle around the obstacles, which is never shorter than
+  // the distance to the goal
+  if (astar_param_.use_obstacle_heuristic) {
+    const auto index = pose2index(costmap_, pose, planner_common_param_.theta_size);
+    const double obstacle_distance =
+      isOutOfRange(index) ? std::numeric_limits<double>::infinity()
+                          : obstacle_heuristic_[index.y * costmap_.info.width + index.x];
+    total_cost =
+      std::max(total_cost, obstacle_distance * astar_param_.distance_heuristic_weight);
+  }
   return total_cost;
 }
 
+void AstarSearch::computeObstacleHeuristic()
+{
+  const int width = costmap_.info.width;
+  const double resolution = costmap_.info.resolution;
+  obstacle_heuristic_.assign(
+    static_cast<size_t>(width) * costmap_.info.height, std::numeric_limits<double>::infinity());
+
+  const auto goal_index = pose2index(costmap_, goal_pose_, planner_common_param_.theta_size);
+  if (isOutOfRange(goal_index) || isObs(goal_index)) {
+    return;
+  }
+
+  // dijkstra on the 8-connected cells from the goal
+  using CellCost = std::pair<double, int>;
+  std::priority_queue<CellCost, std::vector<CellCost>, std::greater<CellCost>> queue;
+  const int goal_cell = goal_index.y * width + goal_index.x;
+  obstacle_heuristic_[goal_cell] = 0.0;
+  queue.emplace(0.0, goal_cell);
+
+  while (!queue.empty()) {
+    const auto [cost, cell] = queue.top();
+    queue.pop();
+    if (cost > obstacle_heuristic_[cell]) {
+      continue;
+    }
+
+    const int x = cell % width;
+    const int y = cell / width;
+    for (int dy = -1; dy <= 1; ++dy) {
+      for (int dx = -1; dx <= 1; ++dx) {
+        const IndexXYT next_index{x + dx, y + dy, 0};
+        if ((dx == 0 && dy == 0) || isOutOfRange(next_index) || isObs(next_index)) {
+          continue;
+        }
+        const double next_cost = cost + (dx != 0 && dy != 0 ? M_SQRT2 : 1.0) * resolution;
+        const int next_cell = next_index.y * width + next_index.x;
+        if (next_cost < obstacle_heuristic_[next_cell]) {
+          obstacle_heuristic_[next_cell] = next_cost;
+          queue.emplace(next_cost, next_cell);
+        }
+      }
+    }
+  }
+}
+
 bool AstarSearch::search()
 {
   const rclcpp::Time begin = rclcpp::Clock(RCL_ROS_TIME).now();
@@ -237,13 +325,21 @@ bool AstarSearch::search()
     // Check time and terminate if the search reaches the time limit
     const rclcpp::Time now = rclcpp::Clock(RCL_ROS_TIME).now();
     const double msec = (now - begin).seconds() * 1000.0;
-    if (msec > planner_common_param_.time_limit) {
+    if (search_time_ + msec > planner_common_param_.time_limit) {
+      return false;
+    }
+    if (msec > suspend_time_limit_) {
+      search_time_ += msec;
+      is_plan_suspended_ = true;
       return false;
     }
 
-    // Expand minimum cost node
-    AstarNode * current_node = openlist_.top();
+    // Expand minimum cost node. skip the entries which were pushed before the node got cheaper
+    const auto [open_cost, current_node] = openlist_.top();
     openlist_.pop();
+    if (current_node->status == NodeStatus::Closed || open_cost != current_node->cost()) {
+      continue;
+    }
     current_node->status = NodeStatus::Closed;
 
     if (isGoal(*current_node)) {
@@ -284,7 +380,7 @@ bool AstarSearch::search()
         next_node->hc = estimateCost(next_pose);
         next_node->is_back = transition.is_back;
         next_node->parent = current_node;
-        openlist_.push(next_node);
+        openlist_.emplace(next_node->cost(), next_node);
         continue;
       }
     }
@@ -76,7 +76,8 @@ nav_msgs::msg::OccupancyGrid construct_cost_map(
 
 bool test_astar(
   std::array<double, 3> start, std::array<double, 3> goal, std::string file_name,
-  double maximum_turning_radius = 9.0, int turning_radius_size = 1)
+  double maximum_turning_radius = 9.0, int turning_radius_size = 1,
+  bool use_obstacle_heuristic = false, bool suspend_plan = false)
 {
   // set problem configuration
   fpa::VehicleShape shape{5.5, 2.75, 1.5};
@@ -110,16 +111,23 @@ bool test_astar(
   bool only_behind_solutions = false;
   bool use_back = true;
   double distance_heuristic_weight = 1.0;
-  fpa::AstarParam astar_param{only_behind_solutions, use_back, distance_heuristic_weight};
+  fpa::AstarParam astar_param{
+    only_behind_solutions, use_back, distance_heuristic_weight, use_obstacle_heuristic};
 
   auto astar = fpa::AstarSearch(planner_common_param, astar_param);
 
   auto costmap_msg = construct_cost_map(150, 150, 0.2, 10);
   astar.setMap(costmap_msg);
+  if (suspend_plan) {
+    astar.setSuspendTimeLimit(1.0);
+  }
 
   rclcpp::Clock clock{RCL_SYSTEM_TIME};
   const rclcpp::Time begin = clock.now();
   bool success = astar.makePlan(construct_pose_msg(start), construct_pose_msg(goal));
+  while (!success && astar.isPlanSuspended()) {
+    success = astar.resumePlan();
+  }
   const rclcpp::Time now = clock.now();
   const double msec = (now - begin).seconds() * 1000.0;
   if (success) {
@@ -169,6 +177,39 @@ TEST(AstarSearchTestSuite, MultiCurvature)
   }
 }
 
+TEST(AstarSearchTestSuite, ObstacleHeuristic)
+{
+  std::vector<double> goal_xs{8., 12., 16., 26.};
+  double maximum_turning_radius = 9.0;
+  int turning_radius_size = 1;
+  bool use_obstacle_heuristic = true;
+  for (size_t i = 0; i < goal_xs.size(); i++) {
+    std::array<double, 3> start{6., 4., 0.5 * 3.1415};
+    std::array<double, 3> goal{goal_xs[i], 4., 0.5 * 3.1415};
+    std::string file_name = "/tmp/result_obstacle_heuristic" + std::to_string(i) + ".txt";
+    EXPECT_TRUE(test_astar(
+      start, goal, file_name, maximum_turning_radius, turning_radius_size,
+      use_obstacle_heuristic));
+  }
+}
+
+TEST(AstarSearchTestSuite, SuspendedPlan)
+{
+  std::vector<double> goal_xs{8., 12., 16., 26.};
+  double maximum_turning_radius = 9.0;
+  int turning_radius_size = 1;
+  bool use_obstacle_heuristic = false;
+  bool suspend_plan = true;
+  for (size_t i = 0; i < goal_xs.size(); i++) {
+    std::array<double, 3> start{6., 4., 0.5 * 3.1415};
+    std::array<double, 3> goal{goal_xs[i], 4., 0.5 * 3.1415};
+    std::string file_name = "/tmp/result_suspended" + std::to_string(i) + ".txt";
+    EXPECT_TRUE(test_astar(
+      start, goal, file_name, maximum_turning_radius, turning_radius_size, use_obstacle_heuristic,
+      suspend_plan));
+  }
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
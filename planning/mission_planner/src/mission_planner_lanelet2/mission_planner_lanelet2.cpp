@@ -20,6 +20,7 @@
 #include <lanelet2_extension/utility/query.hpp>
 #include <lanelet2_extension/utility/utilities.hpp>
 #include <lanelet2_extension/visualization/visualization.hpp>
+#include <route_handler/lanelet_map_cache.hpp>
 
 #include <lanelet2_core/geometry/Lanelet.h>
 #include <lanelet2_routing/Route.h>
@@ -31,6 +32,7 @@
 #include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
 #endif
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <unordered_set>
@@ -138,6 +140,9 @@ namespace mission_planner
 MissionPlannerLanelet2::MissionPlannerLanelet2(const rclcpp::NodeOptions & node_options)
 : MissionPlanner("mission_planner", node_options), is_graph_ready_(false)
 {
+  route_cache_size_ =
+    static_cast<size_t>(std::max(static_cast<int>(declare_parameter("route_cache_size", 0)), 0));
+
   using std::placeholders::_1;
   map_subscriber_ = create_subscription<autoware_auto_mapping_msgs::msg::HADMapBin>(
     "input/vector_map", rclcpp::QoS{10}.transient_local(),
@@ -148,12 +153,14 @@ void MissionPlannerLanelet2::mapCallback(
   const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg)
 {
   route_handler_.setMap(*msg);
-  lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
-  lanelet::utils::conversion::fromBinMsg(
-    *msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
+  // the same map as the one of route_handler_, which is not deserialized again
+  lanelet_map_ptr_ = route_handler::LaneletMapCache::getLaneletMap(
+    *msg, &traffic_rules_ptr_, &routing_graph_ptr_);
   lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
   road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
   shoulder_lanelets_ = lanelet::utils::query::shoulderLanelets(all_lanelets);
+  route_cache_.clear();
+  route_cache_index_.clear();
   is_graph_ready_ = true;
 }
 
@@ -283,14 +290,10 @@ autoware_auto_planning_msgs::msg::HADMapRoute MissionPlannerLanelet2::planRoute(
   for (std::size_t i = 1; i < checkpoints_.size(); i++) {
     const auto start_checkpoint = checkpoints_.at(i - 1);
     const auto goal_checkpoint = checkpoints_.at(i);
-    lanelet::ConstLanelets path_lanelets;
-    if (!route_handler_.planPathLaneletsBetweenCheckpoints(
-          start_checkpoint.pose, goal_checkpoint.pose, &path_lanelets)) {
+    RouteSections local_route_sections;
+    if (!planRouteSections(start_checkpoint.pose, goal_checkpoint.pose, &local_route_sections)) {
       return route_msg;
     }
-    // create local route sections
-    route_handler_.setRouteLanelets(path_lanelets);
-    const auto local_route_sections = route_handler_.createMapSegments(path_lanelets);
     route_sections = combineConsecutiveRouteSections(route_sections, local_route_sections);
   }
 
@@ -310,6 +313,54 @@ autoware_auto_planning_msgs::msg::HADMapRoute MissionPlannerLanelet2::planRoute(
   return route_msg;
 }
 
+bool MissionPlannerLanelet2::planRouteSections(
+  const geometry_msgs::msg::Pose & start_checkpoint,
+  const geometry_msgs::msg::Pose & goal_checkpoint, RouteSections * route_sections)
+{
+  // The route sections depend only on the closest lanelets to the checkpoints, which are the same
+  // as the ones route_handler_ plans the path between, as both are queried from the same map.
+  RouteSectionKey key;
+  bool is_cacheable = false;
+  if (route_cache_size_ > 0) {
+    lanelet::Lanelet start_lanelet;
+    lanelet::Lanelet goal_lanelet;
+    if (
+      lanelet::utils::query::getClosestLanelet(road_lanelets_, start_checkpoint, &start_lanelet) &&
+      lanelet::utils::query::getClosestLanelet(road_lanelets_, goal_checkpoint, &goal_lanelet)) {
+      key = std::make_pair(start_lanelet.id(), goal_lanelet.id());
+      is_cacheable = true;
+      const auto cached_route = route_cache_index_.find(key);
+      if (cached_route != route_cache_index_.end()) {
+        RCLCPP_DEBUG(
+          get_logger(), "reuse the route sections from lane %ld to lane %ld", key.first,
+          key.second);
+        route_cache_.splice(route_cache_.begin(), route_cache_, cached_route->second);
+        *route_sections = cached_route->second->second;
+        return true;
+      }
+    }
+  }
+
+  lanelet::ConstLanelets path_lanelets;
+  if (!route_handler_.planPathLaneletsBetweenCheckpoints(
+        start_checkpoint, goal_checkpoint, &path_lanelets)) {
+    return false;
+  }
+  // create local route sections
+  route_handler_.setRouteLanelets(path_lanelets);
+  *route_sections = route_handler_.createMapSegments(path_lanelets);
+
+  if (is_cacheable) {
+    route_cache_.emplace_front(key, *route_sections);
+    route_cache_index_[key] = route_cache_.begin();
+    if (route_cache_.size() > route_cache_size_) {
+      route_cache_index_.erase(route_cache_.back().first);
+      route_cache_.pop_back();
+    }
+  }
+  return true;
+}
+
 void MissionPlannerLanelet2::refineGoalHeight(const RouteSections & route_sections)
 {
   const auto goal_lane_id = route_sections.back().preferred_primitive_id;
@@ -15,7 +15,10 @@
 #ifndef MISSION_PLANNER_LANELET2__MISSION_PLANNER_LANELET2_HPP_
 #define MISSION_PLANNER_LANELET2__MISSION_PLANNER_LANELET2_HPP_
 
+#include <list>
+#include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 // ROS
@@ -54,10 +57,21 @@ private:
   lanelet::ConstLanelets shoulder_lanelets_;
   route_handler::RouteHandler route_handler_;
 
+  // route sections between the closest lanelets of two consecutive checkpoints, which are reused
+  // while the map is the same, with the least recently used one dropped beyond route_cache_size_
+  using RouteSectionKey = std::pair<lanelet::Id, lanelet::Id>;
+  size_t route_cache_size_;
+  std::list<std::pair<RouteSectionKey, RouteSections>> route_cache_;
+  std::map<RouteSectionKey, std::list<std::pair<RouteSectionKey, RouteSections>>::iterator>
+    route_cache_index_;
+
   rclcpp::Subscription<autoware_auto_mapping_msgs::msg::HADMapBin>::SharedPtr map_subscriber_;
 
   void mapCallback(const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg);
   bool isGoalValid() const;
+  bool planRouteSections(
+    const geometry_msgs::msg::Pose & start_checkpoint,
+    const geometry_msgs::msg::Pose & goal_checkpoint, RouteSections * route_sections);
   void refineGoalHeight(const RouteSections & route_sections);
 
   // virtual functions
@@ -88,6 +88,9 @@ private:
 
   TrajectoryPoints prev_output_;  // previously published trajectory
 
+  // input of the previous smoothing, to find where the current input diverges from it
+  TrajectoryPoints prev_smoother_input_;
+
   // previous trajectory point closest to ego vehicle
   boost::optional<TrajectoryPoint> prev_closest_point_{};
 
@@ -128,6 +131,10 @@ private:
     double delta_yaw_threshold;           // for closest index calculation
     resampling::ResampleParam post_resample_param;
     AlgorithmType algorithm_type;  // Option : JerkFiltered, Linf, L2
+    // only re-optimize the velocity from some margin before the first change of the input
+    bool enable_incremental_smoothing;
+    double incremental_smoothing_margin;
+    double incremental_smoothing_position_tolerance;
   } node_param_{};
 
   std::shared_ptr<SmootherBase> smoother_;
@@ -160,6 +167,11 @@ private:
 
   void updatePrevValues(const TrajectoryPoints & final_result);
 
+  TrajectoryPoints calcTrajectoryVelocity(const TrajectoryPoints & input);
+
+  bool smoothVelocity(
+    const TrajectoryPoints & input, const size_t input_closest, TrajectoryPoints & traj_smoothed);
+
   // const methods
   bool checkData() const;
 
@@ -167,11 +179,11 @@ private:
 
   AlgorithmType getAlgorithmType(const std::string & algorithm_name) const;
 
-  TrajectoryPoints calcTrajectoryVelocity(const TrajectoryPoints & input) const;
+  size_t findDivergenceIndex(const TrajectoryPoints & input, const size_t input_closest) const;
 
-  bool smoothVelocity(
+  boost::optional<size_t> calcIncrementalFixedIndex(
     const TrajectoryPoints & input, const size_t input_closest,
-    TrajectoryPoints & traj_smoothed) const;
+    const TrajectoryPoints & clipped) const;
 
   std::pair<Motion, InitializeType> calcInitialMotion(
     const TrajectoryPoints & input_traj, const size_t input_closest,
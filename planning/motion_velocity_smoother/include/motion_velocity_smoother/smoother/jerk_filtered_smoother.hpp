@@ -56,6 +56,7 @@ public:
 private:
   Param smoother_param_;
   autoware::common::osqp::OSQPInterface qp_solver_;
+  size_t prev_qp_size_{0};  // number of points of the problem held by qp_solver_, 0 if none
   rclcpp::Logger logger_{rclcpp::get_logger("smoother").get_child("jerk_filtered_smoother")};
 
   TrajectoryPoints forwardJerkFilter(
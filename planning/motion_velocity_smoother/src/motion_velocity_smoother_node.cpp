@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <limits>
 #include <map>
 #include <memory>
@@ -149,6 +150,9 @@ rcl_interfaces::msg::SetParametersResult MotionVelocitySmootherNode::onParameter
     update_param("extract_behind_dist", p.extract_behind_dist);
     update_param("stop_dist_to_prohibit_engage", p.stop_dist_to_prohibit_engage);
     update_param("delta_yaw_threshold", p.delta_yaw_threshold);
+    update_param("incremental_smoothing_margin", p.incremental_smoothing_margin);
+    update_param(
+      "incremental_smoothing_position_tolerance", p.incremental_smoothing_position_tolerance);
   }
 
   {
@@ -222,6 +226,9 @@ rcl_interfaces::msg::SetParametersResult MotionVelocitySmootherNode::onParameter
       throw std::domain_error("[MotionVelocitySmootherNode] invalid algorithm");
   }
 
+  // the previous velocity may not be optimal with the new parameters
+  prev_smoother_input_.clear();
+
   rcl_interfaces::msg::SetParametersResult result{};
   result.successful = true;
   result.reason = "success";
@@ -258,6 +265,10 @@ void MotionVelocitySmootherNode::initCommonParam()
   p.post_resample_param.sparse_min_interval_distance =
     declare_parameter("post_sparse_min_interval_distance", 1.0);
   p.algorithm_type = getAlgorithmType(declare_parameter("algorithm_type", "JerkFiltered"));
+  p.enable_incremental_smoothing = declare_parameter("enable_incremental_smoothing", false);
+  p.incremental_smoothing_margin = declare_parameter("incremental_smoothing_margin", 20.0);
+  p.incremental_smoothing_position_tolerance =
+    declare_parameter("incremental_smoothing_position_tolerance", 0.1);
 }
 
 void MotionVelocitySmootherNode::publishTrajectory(const TrajectoryPoints & trajectory) const
@@ -382,6 +393,7 @@ void MotionVelocitySmootherNode::onCurrentTrajectory(const Trajectory::ConstShar
     node_param_.delta_yaw_threshold, node_param_.post_resample_param, false);
   if (!output_resampled) {
     RCLCPP_WARN(get_logger(), "Failed to get the resampled output trajectory");
+    prev_smoother_input_.clear();  // prev_output_ is not updated with this input
     return;
   }
 
@@ -427,7 +439,7 @@ void MotionVelocitySmootherNode::updateDataForExternalVelocityLimit()
 }
 
 TrajectoryPoints MotionVelocitySmootherNode::calcTrajectoryVelocity(
-  const TrajectoryPoints & traj_input) const
+  const TrajectoryPoints & traj_input)
 {
   TrajectoryPoints output{};  // velocity is optimized by qp solver
 
@@ -484,8 +496,7 @@ TrajectoryPoints MotionVelocitySmootherNode::calcTrajectoryVelocity(
 }
 
 bool MotionVelocitySmootherNode::smoothVelocity(
-  const TrajectoryPoints & input, const size_t input_closest,
-  TrajectoryPoints & traj_smoothed) const
+  const TrajectoryPoints & input, const size_t input_closest, TrajectoryPoints & traj_smoothed)
 {
   // Calculate initial motion for smoothing
   const auto [initial_motion, type] = calcInitialMotion(input, input_closest, prev_output_);
@@ -525,12 +536,43 @@ bool MotionVelocitySmootherNode::smoothVelocity(
   clipped.insert(
     clipped.end(), traj_resampled->begin() + *traj_resampled_closest, traj_resampled->end());
 
+  boost::optional<size_t> fixed_idx{};
+  if (type == InitializeType::NORMAL) {
+    fixed_idx = calcIncrementalFixedIndex(input, input_closest, clipped);
+  }
+
   std::vector<TrajectoryPoints> debug_trajectories;
-  if (!smoother_->apply(
-        initial_motion.vel, initial_motion.acc, clipped, traj_smoothed, debug_trajectories)) {
+  bool is_solved = false;
+  if (fixed_idx) {
+    // Keep the previous velocity until the fixed index, and only optimize the rest from there
+    TrajectoryPoints fixed(clipped.begin(), clipped.begin() + *fixed_idx + 1);
+    for (auto & p : fixed) {
+      const auto prev_p = trajectory_utils::calcInterpolatedTrajectoryPoint(prev_output_, p.pose);
+      p.longitudinal_velocity_mps = prev_p.longitudinal_velocity_mps;
+      p.acceleration_mps2 = prev_p.acceleration_mps2;
+    }
+    const TrajectoryPoints remaining(clipped.begin() + *fixed_idx, clipped.end());
+    is_solved = smoother_->apply(
+      fixed.back().longitudinal_velocity_mps, fixed.back().acceleration_mps2, remaining,
+      traj_smoothed, debug_trajectories);
+    traj_smoothed.insert(traj_smoothed.begin(), fixed.begin(), fixed.end() - 1);
+    RCLCPP_DEBUG(
+      get_logger(), "smoothVelocity : fixed %lu of %lu points", *fixed_idx, clipped.size());
+  } else {
+    is_solved = smoother_->apply(
+      initial_motion.vel, initial_motion.acc, clipped, traj_smoothed, debug_trajectories);
+  }
+  if (!is_solved) {
     RCLCPP_WARN(get_logger(), "Fail to solve optimization.");
   }
 
+  // the next input is compared with this one, unless a full optimization is needed
+  if (node_param_.enable_incremental_smoothing && is_solved) {
+    prev_smoother_input_ = input;
+  } else {
+    prev_smoother_input_.clear();
+  }
+
   // Set 0 velocity after input-stop-point
   overwriteStopPoint(clipped, traj_smoothed);
 
@@ -580,6 +622,103 @@ bool MotionVelocitySmootherNode::smoothVelocity(
   return true;
 }
 
+size_t MotionVelocitySmootherNode::findDivergenceIndex(
+  const TrajectoryPoints & input, const size_t input_closest) const
+{
+  constexpr double velocity_tolerance = 1.0e-3;  // [m/s]
+  const double tolerance = node_param_.incremental_smoothing_position_tolerance;
+  const auto & prev = prev_smoother_input_;
+
+  // the points of the input are followed on the previous input, walking its segments forward
+  size_t seg_idx =
+    motion_utils::findNearestSegmentIndex(prev, input.at(input_closest).pose.position);
+  for (size_t i = input_closest; i < input.size(); ++i) {
+    const auto & p = input.at(i).pose.position;
+    double seg_length{};
+    double longitudinal_offset{};
+    double lateral_offset{};
+    while (true) {
+      const auto & p_front = prev.at(seg_idx).pose.position;
+      const auto & p_back = prev.at(seg_idx + 1).pose.position;
+      const double dx = p_back.x - p_front.x;
+      const double dy = p_back.y - p_front.y;
+      seg_length = std::hypot(dx, dy);
+      if (seg_length > 1.0e-3) {
+        longitudinal_offset = ((p.x - p_front.x) * dx + (p.y - p_front.y) * dy) / seg_length;
+        lateral_offset = (dx * (p.y - p_front.y) - dy * (p.x - p_front.x)) / seg_length;
+        if (longitudinal_offset <= seg_length) {
+          break;
+        }
+      }
+      if (seg_idx + 2 >= prev.size()) {
+        break;
+      }
+      ++seg_idx;
+    }
+
+    // beyond the previous input, or off it
+    if (
+      seg_length <= 1.0e-3 || longitudinal_offset < -tolerance ||
+      longitudinal_offset > seg_length + tolerance || std::fabs(lateral_offset) > tolerance) {
+      return i;
+    }
+
+    // the velocity limit is piecewise constant, so it is bounded by the ones of the segment
+    const double v = input.at(i).longitudinal_velocity_mps;
+    const double v_front = prev.at(seg_idx).longitudinal_velocity_mps;
+    const double v_back = prev.at(seg_idx + 1).longitudinal_velocity_mps;
+    if (
+      v < std::min(v_front, v_back) - velocity_tolerance ||
+      v > std::max(v_front, v_back) + velocity_tolerance) {
+      return i;
+    }
+  }
+  return input.size();
+}
+
+boost::optional<size_t> MotionVelocitySmootherNode::calcIncrementalFixedIndex(
+  const TrajectoryPoints & input, const size_t input_closest,
+  const TrajectoryPoints & clipped) const
+{
+  if (
+    !node_param_.enable_incremental_smoothing || prev_smoother_input_.size() < 2 ||
+    prev_output_.empty() || clipped.size() < 3) {
+    return boost::none;
+  }
+
+  const size_t divergence_idx = findDivergenceIndex(input, input_closest);
+  if (divergence_idx <= input_closest) {
+    return boost::none;
+  }
+  const auto & divergence_pose = input.at(std::min(divergence_idx, input.size() - 1)).pose;
+
+  // The velocity is optimized again from the margin before the divergence, plus the distance
+  // to decelerate from the previous velocity there in case the change requires to stop.
+  const double prev_vel = std::fabs(
+    trajectory_utils::calcInterpolatedTrajectoryPoint(prev_output_, divergence_pose)
+      .longitudinal_velocity_mps);
+  const double decel = std::max(std::fabs(smoother_->getMinDecel()), 0.1);
+  const double divergence_length =
+    motion_utils::calcSignedArcLength(clipped, 0, divergence_pose.position);
+  const double fixed_length = divergence_length - node_param_.incremental_smoothing_margin -
+                              prev_vel * prev_vel / (2.0 * decel);
+
+  // at least 2 points are left to the optimization
+  size_t fixed_idx = 0;
+  double length = 0.0;
+  for (size_t i = 1; i + 1 < clipped.size(); ++i) {
+    length += tier4_autoware_utils::calcDistance2d(clipped.at(i - 1), clipped.at(i));
+    if (length > fixed_length) {
+      break;
+    }
+    fixed_idx = i;
+  }
+  if (fixed_idx == 0) {
+    return boost::none;
+  }
+  return fixed_idx;
+}
+
 void MotionVelocitySmootherNode::insertBehindVelocity(
   const size_t output_closest, const InitializeType type, TrajectoryPoints & output) const
 {
@@ -14,7 +14,6 @@
 
 #include "motion_velocity_smoother/smoother/jerk_filtered_smoother.hpp"
 
-#include "eigen3/Eigen/Core"
 #include "motion_velocity_smoother/trajectory_utils.hpp"
 
 #include <algorithm>
@@ -167,15 +166,35 @@ bool JerkFilteredSmoother::apply(
   const uint32_t IDX_GAMMA0 = 4 * N;
 
   const uint32_t l_variables = 5 * N;
-  const uint32_t l_constraints = 4 * N + 1;
 
-  // the matrix size depends on constraint numbers.
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(l_constraints, l_variables);
+  // rows of the constraints, see below
+  const uint32_t IDX_V_LIMIT0 = 0;          // velocity limit     : 0~N
+  const uint32_t IDX_A_LIMIT0 = N;          // acceleration limit : N~2N
+  const uint32_t IDX_J_LIMIT0 = 2 * N;      // jerk limit         : 2N~3N-1
+  const uint32_t IDX_DYN0 = 3 * N - 1;      // b' = 2a            : 3N-1~4N-2
+  const uint32_t IDX_INITIAL0 = 4 * N - 2;  // initial b and a    : 4N-2~4N
+  const uint32_t l_constraints = 4 * N;
+
+  /*
+   * P (upper triangular) and A are built directly in CSC form. Their sparsity pattern only depends
+   * on N, the entries of zero value being kept, so that the problem of the last cycle can be
+   * updated in place when N does not change.
+   */
+  using autoware::common::osqp::CSC_Matrix;
+  CSC_Matrix P;
+  CSC_Matrix A;
+  P.m_col_idxs.push_back(0);
+  A.m_col_idxs.push_back(0);
+  const auto add_element = [](CSC_Matrix & mat, const uint32_t row, const double val) {
+    mat.m_vals.push_back(val);
+    mat.m_row_idxs.push_back(static_cast<c_int>(row));
+  };
+  const auto close_column = [](CSC_Matrix & mat) {
+    mat.m_col_idxs.push_back(static_cast<c_int>(mat.m_vals.size()));
+  };
 
   std::vector<double> lower_bound(l_constraints, 0.0);
   std::vector<double> upper_bound(l_constraints, 0.0);
-
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(l_variables, l_variables);
   std::vector<double> q(l_variables, 0.0);
 
   /**************************************************************/
@@ -187,14 +206,12 @@ bool JerkFilteredSmoother::apply(
   // jerk: d(ai)/ds * v_ref -> minimize weight * ((a1 - a0) / ds * v_ref)^2 * ds
   constexpr double ZERO_VEL_THR_FOR_DT_CALC = 0.3;
   const double smooth_weight = smoother_param_.jerk_weight;
+  std::vector<double> jerk_cost_arr(N - 1);
   for (size_t i = 0; i < N - 1; ++i) {
     const double ref_vel = v_max_arr.at(i);
     const double interval_dist = std::max(interval_dist_arr.at(i), 0.0001);
     const double w_x_ds_inv = (1.0 / interval_dist) * ref_vel;
-    P(IDX_A0 + i, IDX_A0 + i) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i, IDX_A0 + i + 1) -= smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i + 1, IDX_A0 + i) -= smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
-    P(IDX_A0 + i + 1, IDX_A0 + i + 1) += smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
+    jerk_cost_arr.at(i) = smooth_weight * w_x_ds_inv * w_x_ds_inv * interval_dist;
   }
 
   for (size_t i = 0; i < N; ++i) {
@@ -204,9 +221,31 @@ bool JerkFilteredSmoother::apply(
     if (i < N - 1) {
       q.at(IDX_B0 + i) *= std::max(interval_dist_arr.at(i), 0.0001);
     }
-    P(IDX_DELTA0 + i, IDX_DELTA0 + i) += over_v_weight;  // over velocity cost
-    P(IDX_SIGMA0 + i, IDX_SIGMA0 + i) += over_a_weight;  // over acceleration cost
-    P(IDX_GAMMA0 + i, IDX_GAMMA0 + i) += over_j_weight;  // over jerk cost
+  }
+
+  for (size_t i = 0; i < N; ++i) {  // b: no quadratic cost
+    close_column(P);
+  }
+  for (size_t i = 0; i < N; ++i) {  // a: jerk cost, (a[i+1] - a[i])^2 terms
+    if (i > 0) {
+      add_element(P, IDX_A0 + i - 1, -jerk_cost_arr.at(i - 1));
+    }
+    const double prev_cost = i > 0 ? jerk_cost_arr.at(i - 1) : 0.0;
+    const double next_cost = i < N - 1 ? jerk_cost_arr.at(i) : 0.0;
+    add_element(P, IDX_A0 + i, prev_cost + next_cost);
+    close_column(P);
+  }
+  for (size_t i = 0; i < N; ++i) {
+    add_element(P, IDX_DELTA0 + i, over_v_weight);  // over velocity cost
+    close_column(P);
+  }
+  for (size_t i = 0; i < N; ++i) {
+    add_element(P, IDX_SIGMA0 + i, over_a_weight);  // over acceleration cost
+    close_column(P);
+  }
+  for (size_t i = 0; i < N; ++i) {
+    add_element(P, IDX_GAMMA0 + i, over_j_weight);  // over jerk cost
+    close_column(P);
   }
 
   /**************************************************************/
@@ -223,68 +262,102 @@ bool JerkFilteredSmoother::apply(
   b is almost 0, and is not a big problem.
   */
 
-  size_t constr_idx = 0;
-
   // Soft Constraint Velocity Limit: 0 < b - delta < v_max^2
-  for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_B0 + i) = 1.0;       // b_i
-    A(constr_idx, IDX_DELTA0 + i) = -1.0;  // -delta_i
-    upper_bound[constr_idx] = v_max_arr.at(i) * v_max_arr.at(i);
-    lower_bound[constr_idx] = 0.0;
+  for (size_t i = 0; i < N; ++i) {
+    upper_bound[IDX_V_LIMIT0 + i] = v_max_arr.at(i) * v_max_arr.at(i);
+    lower_bound[IDX_V_LIMIT0 + i] = 0.0;
   }
 
   // Soft Constraint Acceleration Limit: a_min < a - sigma < a_max
-  for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_A0 + i) = 1.0;       // a_i
-    A(constr_idx, IDX_SIGMA0 + i) = -1.0;  // -sigma_i
-
+  for (size_t i = 0; i < N; ++i) {
     constexpr double stop_vel = 1e-3;
     if (v_max_arr.at(i) < stop_vel) {
       // Stop Point
-      upper_bound[constr_idx] = a_stop_decel;
-      lower_bound[constr_idx] = a_stop_decel;
+      upper_bound[IDX_A_LIMIT0 + i] = a_stop_decel;
+      lower_bound[IDX_A_LIMIT0 + i] = a_stop_decel;
     } else {
-      upper_bound[constr_idx] = a_max;
-      lower_bound[constr_idx] = a_min;
+      upper_bound[IDX_A_LIMIT0 + i] = a_max;
+      lower_bound[IDX_A_LIMIT0 + i] = a_min;
     }
   }
 
   // Soft Constraint Jerk Limit: jerk_min < pseudo_jerk[i] * ref_vel[i] - gamma[i] < jerk_max
   // -> jerk_min * ds < (a[i+1] - a[i]) * ref_vel[i] - gamma[i] * ds < jerk_max * ds
-  for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
-    const double ref_vel = std::max(v_max_arr.at(i), ZERO_VEL_THR_FOR_DT_CALC);
+  std::vector<double> jerk_ref_vel_arr(N - 1);
+  for (size_t i = 0; i < N - 1; ++i) {
+    jerk_ref_vel_arr.at(i) = std::max(v_max_arr.at(i), ZERO_VEL_THR_FOR_DT_CALC);
     const double ds = interval_dist_arr.at(i);
-    A(constr_idx, IDX_A0 + i) = -ref_vel;     // -a[i] * ref_vel
-    A(constr_idx, IDX_A0 + i + 1) = ref_vel;  //  a[i+1] * ref_vel
-    A(constr_idx, IDX_GAMMA0 + i) = -ds;      // -gamma[i] * ds
-    upper_bound[constr_idx] = j_max * ds;     //  jerk_max * ds
-    lower_bound[constr_idx] = j_min * ds;     //  jerk_min * ds
+    upper_bound[IDX_J_LIMIT0 + i] = j_max * ds;  //  jerk_max * ds
+    lower_bound[IDX_J_LIMIT0 + i] = j_min * ds;  //  jerk_min * ds
   }
 
-  // b' = 2a ... (b(i+1) - b(i)) / ds = 2a(i)
-  for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
-    A(constr_idx, IDX_B0 + i) = -1.0;                            // b(i)
-    A(constr_idx, IDX_B0 + i + 1) = 1.0;                         // b(i+1)
-    A(constr_idx, IDX_A0 + i) = -2.0 * interval_dist_arr.at(i);  // a(i) * ds
-    upper_bound[constr_idx] = 0.0;
-    lower_bound[constr_idx] = 0.0;
-  }
+  // b' = 2a ... (b(i+1) - b(i)) / ds = 2a(i): the bounds are 0
 
   // initial condition
-  {
-    A(constr_idx, IDX_B0) = 1.0;  // b0
-    upper_bound[constr_idx] = v0 * v0;
-    lower_bound[constr_idx] = v0 * v0;
-    ++constr_idx;
-
-    A(constr_idx, IDX_A0) = 1.0;  // a0
-    upper_bound[constr_idx] = a0;
-    lower_bound[constr_idx] = a0;
-    ++constr_idx;
+  upper_bound[IDX_INITIAL0] = v0 * v0;
+  lower_bound[IDX_INITIAL0] = v0 * v0;
+  upper_bound[IDX_INITIAL0 + 1] = a0;
+  lower_bound[IDX_INITIAL0 + 1] = a0;
+
+  // columns of A, their rows in ascending order. b
+  for (size_t i = 0; i < N; ++i) {
+    add_element(A, IDX_V_LIMIT0 + i, 1.0);  // b_i
+    if (i > 0) {
+      add_element(A, IDX_DYN0 + i - 1, 1.0);  // b(i+1) of the previous constraint
+    }
+    if (i < N - 1) {
+      add_element(A, IDX_DYN0 + i, -1.0);  // b(i)
+    }
+    if (i == 0) {
+      add_element(A, IDX_INITIAL0, 1.0);  // b0
+    }
+    close_column(A);
+  }
+  // a
+  for (size_t i = 0; i < N; ++i) {
+    add_element(A, IDX_A_LIMIT0 + i, 1.0);  // a_i
+    if (i > 0) {
+      add_element(A, IDX_J_LIMIT0 + i - 1, jerk_ref_vel_arr.at(i - 1));  //  a[i+1] * ref_vel
+    }
+    if (i < N - 1) {
+      add_element(A, IDX_J_LIMIT0 + i, -jerk_ref_vel_arr.at(i));     // -a[i] * ref_vel
+      add_element(A, IDX_DYN0 + i, -2.0 * interval_dist_arr.at(i));  // a(i) * ds
+    }
+    if (i == 0) {
+      add_element(A, IDX_INITIAL0 + 1, 1.0);  // a0
+    }
+    close_column(A);
+  }
+  // delta
+  for (size_t i = 0; i < N; ++i) {
+    add_element(A, IDX_V_LIMIT0 + i, -1.0);  // -delta_i
+    close_column(A);
+  }
+  // sigma
+  for (size_t i = 0; i < N; ++i) {
+    add_element(A, IDX_A_LIMIT0 + i, -1.0);  // -sigma_i
+    close_column(A);
+  }
+  // gamma
+  for (size_t i = 0; i < N; ++i) {
+    if (i < N - 1) {
+      add_element(A, IDX_J_LIMIT0 + i, -interval_dist_arr.at(i));  // -gamma[i] * ds
+    }
+    close_column(A);
   }
 
-  // execute optimization
-  const auto result = qp_solver_.optimize(P, A, q, lower_bound, upper_bound);
+  // execute optimization. The problem of the last cycle is updated when it has the same size, the
+  // solver starting from its solution.
+  if (N == prev_qp_size_) {
+    qp_solver_.updateCscP(P);
+    qp_solver_.updateQ(q);
+    qp_solver_.updateCscA(A);
+    qp_solver_.updateBounds(lower_bound, upper_bound);
+  } else {
+    qp_solver_.initializeProblem(P, A, q, lower_bound, upper_bound);
+    prev_qp_size_ = N;
+  }
+  const auto result = qp_solver_.optimize();
   const std::vector<double> optval = std::get<0>(result);
 
   const auto tf1 = std::chrono::system_clock::now();
@@ -306,6 +379,7 @@ bool JerkFilteredSmoother::apply(
   const int status_val = std::get<3>(result);
   if (status_val != 1) {
     RCLCPP_ERROR(logger_, "optimization failed : %s", qp_solver_.getStatusMessage().c_str());
+    prev_qp_size_ = 0;  // not to start the next cycle from the failed solution
   }
 
   if (TMP_SHOW_DEBUG_INFO) {
@@ -209,6 +209,7 @@ struct MPTParam
 {
   bool enable_warm_start;
   bool enable_manual_warm_start;
+  bool reuse_fixed_points_bounds;
   bool steer_limit_constraint;
   bool fix_points_around_ego;
   int num_curvature_sampling_points;
@@ -16,6 +16,7 @@
 #define OBSTACLE_AVOIDANCE_PLANNER__COSTMAP_GENERATOR_HPP_
 
 #include "obstacle_avoidance_planner/common_structs.hpp"
+#include "obstacle_avoidance_planner/incremental_clearance_map.hpp"
 #include "tier4_autoware_utils/system/stop_watch.hpp"
 
 #include "autoware_auto_perception_msgs/msg/predicted_object.hpp"
@@ -33,6 +34,8 @@
 class CostmapGenerator
 {
 public:
+  explicit CostmapGenerator(const bool enable_incremental_clearance_map);
+
   CVMaps getMaps(
     const bool enable_avoidance, const autoware_auto_planning_msgs::msg::Path & path,
     const std::vector<autoware_auto_perception_msgs::msg::PredictedObject> & objects,
@@ -43,12 +46,18 @@ private:
     std::chrono::milliseconds, std::chrono::microseconds, std::chrono::steady_clock>
     stop_watch_;
 
+  bool enable_incremental_clearance_map_;
+  IncrementalClearanceMap road_clearance_map_;
+  IncrementalClearanceMap objects_clearance_map_;
+
   cv::Mat getAreaWithObjects(
     const cv::Mat & drivable_area, const cv::Mat & objects_image,
     std::shared_ptr<DebugData> debug_data_ptr) const;
 
   cv::Mat getClearanceMap(
-    const cv::Mat & drivable_area, std::shared_ptr<DebugData> debug_data_ptr) const;
+    const cv::Mat & drivable_area, const nav_msgs::msg::MapMetaData & map_info,
+    IncrementalClearanceMap & incremental_clearance_map,
+    std::shared_ptr<DebugData> debug_data_ptr) const;
 
   cv::Mat drawObstaclesOnImage(
     const bool enable_avoidance,
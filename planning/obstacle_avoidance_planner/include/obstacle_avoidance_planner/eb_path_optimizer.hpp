@@ -16,6 +16,7 @@
 #define OBSTACLE_AVOIDANCE_PLANNER__EB_PATH_OPTIMIZER_HPP_
 
 #include "eigen3/Eigen/Core"
+#include "eigen3/Eigen/Sparse"
 #include "obstacle_avoidance_planner/common_structs.hpp"
 #include "osqp_interface/osqp_interface.hpp"
 #include "tier4_autoware_utils/system/stop_watch.hpp"
@@ -91,7 +92,8 @@ private:
   const EBParam eb_param_;
   const VehicleParam vehicle_param_;
 
-  Eigen::MatrixXd default_a_matrix_;
+  // values of the constraint matrix in the column major order of its fixed structure
+  std::vector<double> a_values_;
   std::unique_ptr<autoware::common::osqp::OSQPInterface> osqp_solver_ptr_;
 
   double current_ego_vel_;
@@ -100,9 +102,9 @@ private:
     std::chrono::milliseconds, std::chrono::microseconds, std::chrono::steady_clock>
     stop_watch_;
 
-  Eigen::MatrixXd makePMatrix();
+  Eigen::SparseMatrix<double> makePMatrix();
 
-  Eigen::MatrixXd makeAMatrix();
+  Eigen::SparseMatrix<double> makeAMatrix();
 
   Anchor getAnchor(
     const std::vector<geometry_msgs::msg::Point> & interpolated_points, const int interpolated_idx,
@@ -0,0 +1,76 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OBSTACLE_AVOIDANCE_PLANNER__INCREMENTAL_CLEARANCE_MAP_HPP_
+#define OBSTACLE_AVOIDANCE_PLANNER__INCREMENTAL_CLEARANCE_MAP_HPP_
+
+#include "opencv2/core.hpp"
+
+#include "nav_msgs/msg/map_meta_data.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * \brief Clearance map of an image, the euclidean distance in cells from every cell to its nearest
+ * zero cell, kept over the updates. Each cell keeps its nearest zero cell, so that only the cells
+ * around the ones which changed since the previous update are propagated to, with the raise and
+ * lower waves of the dynamic brushfire of [Lau 2010]. The previous distances are moved with the
+ * grid when its origin is shifted by whole cells, otherwise the map is computed again.
+ */
+class IncrementalClearanceMap
+{
+public:
+  /**
+   * \brief Update the map with image of type CV_8UC1 on the grid of map_info. Returns the map of
+   * type CV_32FC1, as cv::distanceTransform() but with exact euclidean distances.
+   */
+  cv::Mat update(const cv::Mat & image, const nav_msgs::msg::MapMetaData & map_info);
+
+private:
+  void initialize(const cv::Mat & image);
+  // move the previous map to the grid of map_info, returns false if it can not be reused
+  bool shift(const cv::Mat & image, const nav_msgs::msg::MapMetaData & map_info);
+  void propagate();
+  void raise(const int idx);
+  void lower(const int idx);
+
+  void push(const int sq_dist, const int idx);
+  std::pair<int, int> pop();
+  void clearQueue();
+
+  void setDistance(const int idx, const int sq_dist, const int zero_idx);
+  void clearCell(const int idx);
+  // calls f(index, row, col) of the 8 neighbors of the cell in the grid
+  template <class F>
+  void forEachNeighbor(const int idx, const F & f) const;
+
+  int rows_{0};
+  int cols_{0};
+  nav_msgs::msg::MapMetaData map_info_;
+
+  std::vector<uint8_t> is_zero_;
+  std::vector<int> sq_dists_;
+  std::vector<int> nearest_zero_indices_;
+  std::vector<uint8_t> is_raised_;
+  cv::Mat clearance_map_;  // continuous, indexed as the cells
+
+  // squared distances and cells to propagate from, bucketed by distance
+  std::vector<std::vector<std::pair<int, int>>> buckets_;
+  size_t queue_size_{0};
+  size_t min_bucket_{0};
+};
+
+#endif  // OBSTACLE_AVOIDANCE_PLANNER__INCREMENTAL_CLEARANCE_MAP_HPP_
@@ -128,6 +128,8 @@ struct ReferencePoint
   //       second is fixing current ego pose when no velocity for planning from ego pose
   boost::optional<Eigen::Vector2d> fix_kinematic_state = boost::none;
   bool plan_from_ego = false;
+  // the point and its bounds are carried over from the previous cycle
+  bool is_prev_point = false;
   Eigen::Vector2d optimized_kinematic_state;
   double optimized_input;
 
@@ -163,13 +165,13 @@ private:
 
   struct ObjectiveMatrix
   {
-    Eigen::MatrixXd hessian;
+    Eigen::SparseMatrix<double> hessian;  // upper triangular
     Eigen::VectorXd gradient;
   };
 
   struct ConstraintMatrix
   {
-    Eigen::MatrixXd linear;
+    Eigen::SparseMatrix<double> linear;
     Eigen::VectorXd lower_bound;
     Eigen::VectorXd upper_bound;
   };
@@ -192,8 +194,9 @@ private:
   geometry_msgs::msg::Pose current_ego_pose_;
   double current_ego_vel_;
 
-  int prev_mat_n = 0;
-  int prev_mat_m = 0;
+  // number of fixed points the QP is padded to, so that its sparsity pattern is kept
+  size_t prev_fixed_points_num_ = 0;
+  std::vector<double> prev_dual_solution_;
 
   mutable tier4_autoware_utils::StopWatch<
     std::chrono::milliseconds, std::chrono::microseconds, std::chrono::steady_clock>
@@ -263,6 +266,10 @@ private:
     const MPTMatrix & mpt_mat, const ValueMatrix & obj_mat,
     const std::vector<ReferencePoint> & ref_points, std::shared_ptr<DebugData> debug_data_ptr);
 
+  Eigen::VectorXd calcShiftedPrevSolution(
+    const std::unique_ptr<Trajectories> & prev_trajs,
+    const std::vector<ReferencePoint> & ref_points, const size_t N_v) const;
+
   std::vector<autoware_auto_planning_msgs::msg::TrajectoryPoint> getMPTPoints(
     std::vector<ReferencePoint> & fixed_ref_points,
     std::vector<ReferencePoint> & non_fixed_ref_points, const Eigen::VectorXd & Uex,
@@ -286,12 +293,12 @@ private:
 
   ObjectiveMatrix getObjectiveMatrix(
     const MPTMatrix & mpt_mat, const ValueMatrix & obj_mat,
-    [[maybe_unused]] const std::vector<ReferencePoint> & ref_points,
+    [[maybe_unused]] const std::vector<ReferencePoint> & ref_points, const size_t N_pad,
     std::shared_ptr<DebugData> debug_data_ptr) const;
 
   ConstraintMatrix getConstraintMatrix(
     const bool enable_avoidance, const MPTMatrix & mpt_mat,
-    const std::vector<ReferencePoint> & ref_points,
+    const std::vector<ReferencePoint> & ref_points, const size_t N_pad, const size_t N_fixed_pad,
     std::shared_ptr<DebugData> debug_data_ptr) const;
 
   size_t findNearestIndexWithSoftYawConstraints(
@@ -160,6 +160,7 @@ private:
   bool enable_pre_smoothing_;
   bool skip_optimization_;
   bool reset_prev_optimization_;
+  bool enable_incremental_clearance_map_;
 
   // vehicle circles info for for mpt constraints
   std::string vehicle_circle_method_;
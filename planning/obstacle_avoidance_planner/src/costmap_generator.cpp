@@ -142,6 +142,11 @@ geometry_msgs::msg::Point getPoint(const cv::Point & p)
 }
 }  // namespace tier4_autoware_utils
 
+CostmapGenerator::CostmapGenerator(const bool enable_incremental_clearance_map)
+: enable_incremental_clearance_map_(enable_incremental_clearance_map)
+{
+}
+
 CVMaps CostmapGenerator::getMaps(
   const bool enable_avoidance, const autoware_auto_planning_msgs::msg::Path & path,
   const std::vector<autoware_auto_perception_msgs::msg::PredictedObject> & objects,
@@ -153,7 +158,8 @@ CVMaps CostmapGenerator::getMaps(
   CVMaps cv_maps;
 
   cv_maps.drivable_area = getDrivableAreaInCV(path.drivable_area, debug_data_ptr);
-  cv_maps.clearance_map = getClearanceMap(cv_maps.drivable_area, debug_data_ptr);
+  cv_maps.clearance_map = getClearanceMap(
+    cv_maps.drivable_area, path.drivable_area.info, road_clearance_map_, debug_data_ptr);
 
   std::vector<autoware_auto_perception_msgs::msg::PredictedObject> debug_avoiding_objects;
   cv::Mat objects_image = drawObstaclesOnImage(
@@ -162,7 +168,8 @@ CVMaps CostmapGenerator::getMaps(
 
   cv_maps.area_with_objects_map =
     getAreaWithObjects(cv_maps.drivable_area, objects_image, debug_data_ptr);
-  cv_maps.only_objects_clearance_map = getClearanceMap(objects_image, debug_data_ptr);
+  cv_maps.only_objects_clearance_map = getClearanceMap(
+    objects_image, path.drivable_area.info, objects_clearance_map_, debug_data_ptr);
   cv_maps.map_info = path.drivable_area.info;
 
   // debug data
@@ -193,12 +200,19 @@ cv::Mat CostmapGenerator::getDrivableAreaInCV(
 }
 
 cv::Mat CostmapGenerator::getClearanceMap(
-  const cv::Mat & drivable_area, std::shared_ptr<DebugData> debug_data_ptr) const
+  const cv::Mat & drivable_area, const nav_msgs::msg::MapMetaData & map_info,
+  IncrementalClearanceMap & incremental_clearance_map,
+  std::shared_ptr<DebugData> debug_data_ptr) const
 {
   stop_watch_.tic(__func__);
 
   cv::Mat clearance_map;
-  cv::distanceTransform(drivable_area, clearance_map, cv::DIST_L2, 5);
+  if (enable_incremental_clearance_map_) {
+    // only the cells around the ones changed since the previous cycle are updated
+    clearance_map = incremental_clearance_map.update(drivable_area, map_info);
+  } else {
+    cv::distanceTransform(drivable_area, clearance_map, cv::DIST_L2, 5);
+  }
 
   debug_data_ptr->msg_stream << "      " << __func__ << ":= " << stop_watch_.toc(__func__)
                              << " [ms]\n";
@@ -34,8 +34,11 @@ EBPathOptimizer::EBPathOptimizer(
   eb_param_(eb_param),
   vehicle_param_(vehicle_param)
 {
-  const Eigen::MatrixXd p = makePMatrix();
-  default_a_matrix_ = makeAMatrix();
+  // P is constant and only the values of A change with the constraints, so that the structure of
+  // the problem is set up once
+  const auto p_csc = autoware::common::osqp::calCSCMatrix(makePMatrix());
+  const auto a_csc = autoware::common::osqp::calCSCMatrix(makeAMatrix());
+  a_values_ = a_csc.m_vals;
 
   const int num_points = eb_param_.num_sampling_points_for_eb;
   const std::vector<double> q(num_points * 2, 0.0);
@@ -43,47 +46,53 @@ EBPathOptimizer::EBPathOptimizer(
   const std::vector<double> upper_bound(num_points * 2, 0.0);
 
   osqp_solver_ptr_ = std::make_unique<autoware::common::osqp::OSQPInterface>(
-    p, default_a_matrix_, q, lower_bound, upper_bound, qp_param_.eps_abs);
+    p_csc, a_csc, q, lower_bound, upper_bound, qp_param_.eps_abs);
   osqp_solver_ptr_->updateEpsRel(qp_param_.eps_rel);
   osqp_solver_ptr_->updateMaxIter(qp_param_.max_iteration);
 }
 
-// make positive semidefinite matrix for objective function
+// make positive semidefinite matrix for objective function, of which only the upper triangle of
+// the band is stored
 // reference: https://ieeexplore.ieee.org/document/7402333
-Eigen::MatrixXd EBPathOptimizer::makePMatrix()
+Eigen::SparseMatrix<double> EBPathOptimizer::makePMatrix()
 {
   const int num_points = eb_param_.num_sampling_points_for_eb;
 
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(num_points * 2, num_points * 2);
+  std::vector<Eigen::Triplet<double>> triplets;
+  triplets.reserve(num_points * 2 * 3);
   for (int r = 0; r < num_points * 2; ++r) {
-    for (int c = 0; c < num_points * 2; ++c) {
-      if (r == c) {
-        P(r, c) = 6.0;
-      } else if (std::abs(c - r) == 1) {
-        P(r, c) = -4.0;
-      } else if (std::abs(c - r) == 2) {
-        P(r, c) = 1.0;
-      } else {
-        P(r, c) = 0.0;
-      }
+    triplets.emplace_back(r, r, 6.0);
+    if (r + 1 < num_points * 2) {
+      triplets.emplace_back(r, r + 1, -4.0);
+    }
+    if (r + 2 < num_points * 2) {
+      triplets.emplace_back(r, r + 2, 1.0);
     }
   }
+
+  Eigen::SparseMatrix<double> P(num_points * 2, num_points * 2);
+  P.setFromTriplets(triplets.begin(), triplets.end());
   return P;
 }
 
-// make default linear constrain matrix
-Eigen::MatrixXd EBPathOptimizer::makeAMatrix()
+// make default linear constrain matrix, whose structure does not change in updateConstrain
+Eigen::SparseMatrix<double> EBPathOptimizer::makeAMatrix()
 {
   const int num_points = eb_param_.num_sampling_points_for_eb;
 
-  Eigen::MatrixXd A = Eigen::MatrixXd::Identity(num_points * 2, num_points * 2);
+  std::vector<Eigen::Triplet<double>> triplets;
+  triplets.reserve(num_points * 2 * 2);
   for (int i = 0; i < num_points * 2; ++i) {
+    triplets.emplace_back(i, i, 1.0);
     if (i < num_points) {
-      A(i, i + num_points) = 1.0;
+      triplets.emplace_back(i, i + num_points, 1.0);
     } else {
-      A(i, i - num_points) = 1.0;
+      triplets.emplace_back(i, i - num_points, 1.0);
     }
   }
+
+  Eigen::SparseMatrix<double> A(num_points * 2, num_points * 2);
+  A.setFromTriplets(triplets.begin(), triplets.end());
   return A;
 }
 
@@ -430,16 +439,16 @@ void EBPathOptimizer::updateConstrain(
 {
   const int num_points = eb_param_.num_sampling_points_for_eb;
 
-  Eigen::MatrixXd A = default_a_matrix_;
+  // column i of A has the rows i and i + num_points, as column i + num_points
   std::vector<double> lower_bound(num_points * 2, 0.0);
   std::vector<double> upper_bound(num_points * 2, 0.0);
   for (int i = 0; i < num_points; ++i) {
     Constrain constrain =
       getConstrainFromConstrainRectangle(interpolated_points[i], rectangle_points[i]);
-    A(i, i) = constrain.top_and_bottom.x_coef;
-    A(i, i + num_points) = constrain.top_and_bottom.y_coef;
-    A(i + num_points, i) = constrain.left_and_right.x_coef;
-    A(i + num_points, i + num_points) = constrain.left_and_right.y_coef;
+    a_values_[i * 2] = constrain.top_and_bottom.x_coef;
+    a_values_[i * 2 + 1] = constrain.left_and_right.x_coef;
+    a_values_[(i + num_points) * 2] = constrain.top_and_bottom.y_coef;
+    a_values_[(i + num_points) * 2 + 1] = constrain.left_and_right.y_coef;
     lower_bound[i] = constrain.top_and_bottom.lower_bound;
     upper_bound[i] = constrain.top_and_bottom.upper_bound;
     lower_bound[i + num_points] = constrain.left_and_right.lower_bound;
@@ -447,7 +456,7 @@ void EBPathOptimizer::updateConstrain(
   }
 
   osqp_solver_ptr_->updateBounds(lower_bound, upper_bound);
-  osqp_solver_ptr_->updateA(A);
+  osqp_solver_ptr_->updateAValues(a_values_);
 }
 
 EBPathOptimizer::Anchor EBPathOptimizer::getAnchor(
@@ -0,0 +1,372 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "obstacle_avoidance_planner/incremental_clearance_map.hpp"
+
+#include "obstacle_avoidance_planner/utils.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+constexpr int no_zero_idx = -1;
+constexpr int max_sq_dist = std::numeric_limits<int>::max();
+
+bool isSameOrientation(
+  const geometry_msgs::msg::Quaternion & a, const geometry_msgs::msg::Quaternion & b)
+{
+  constexpr double epsilon = 1e-6;
+  return std::abs(a.x - b.x) < epsilon && std::abs(a.y - b.y) < epsilon &&
+         std::abs(a.z - b.z) < epsilon && std::abs(a.w - b.w) < epsilon;
+}
+}  // namespace
+
+template <class F>
+void IncrementalClearanceMap::forEachNeighbor(const int idx, const F & f) const
+{
+  const int r = idx / cols_;
+  const int c = idx % cols_;
+  for (int n_r = std::max(r - 1, 0); n_r <= std::min(r + 1, rows_ - 1); ++n_r) {
+    for (int n_c = std::max(c - 1, 0); n_c <= std::min(c + 1, cols_ - 1); ++n_c) {
+      if (n_r != r || n_c != c) {
+        f(n_r * cols_ + n_c, n_r, n_c);
+      }
+    }
+  }
+}
+
+cv::Mat IncrementalClearanceMap::update(
+  const cv::Mat & image, const nav_msgs::msg::MapMetaData & map_info)
+{
+  if (!shift(image, map_info)) {
+    initialize(image);
+  } else {
+    for (int r = 0; r < rows_; ++r) {
+      const uint8_t * image_row = image.ptr<uint8_t>(r);
+      for (int c = 0; c < cols_; ++c) {
+        const int idx = r * cols_ + c;
+        const bool is_zero = image_row[c] == 0;
+        if (is_zero == static_cast<bool>(is_zero_[idx])) {
+          continue;
+        }
+        is_zero_[idx] = is_zero;
+        if (is_zero) {
+          setDistance(idx, 0, idx);
+          push(0, idx);
+        } else {
+          clearCell(idx);
+          is_raised_[idx] = true;
+          push(0, idx);
+        }
+      }
+    }
+    propagate();
+  }
+
+  map_info_ = map_info;
+  return clearance_map_.clone();
+}
+
+void IncrementalClearanceMap::initialize(const cv::Mat & image)
+{
+  rows_ = image.rows;
+  cols_ = image.cols;
+  const int cell_num = rows_ * cols_;
+  is_zero_.assign(cell_num, 0);
+  sq_dists_.assign(cell_num, max_sq_dist);
+  nearest_zero_indices_.assign(cell_num, no_zero_idx);
+  is_raised_.assign(cell_num, 0);
+  clearance_map_.create(rows_, cols_, CV_32FC1);
+  clearQueue();
+
+  for (int r = 0; r < rows_; ++r) {
+    const uint8_t * image_row = image.ptr<uint8_t>(r);
+    for (int c = 0; c < cols_; ++c) {
+      is_zero_[r * cols_ + c] = image_row[c] == 0;
+    }
+  }
+
+  // exact distance transform of [Felzenszwalb 2012], keeping the nearest zero cells.
+  // nearest zero row in each column, swept row by row
+  std::vector<int> nearest_rows(cell_num, -1);
+  std::vector<int> zero_rows(cols_, -1);
+  for (int r = 0; r < rows_; ++r) {
+    for (int c = 0; c < cols_; ++c) {
+      if (is_zero_[r * cols_ + c]) {
+        zero_rows[c] = r;
+      }
+      nearest_rows[r * cols_ + c] = zero_rows[c];
+    }
+  }
+  zero_rows.assign(cols_, -1);
+  for (int r = rows_ - 1; r >= 0; --r) {
+    for (int c = 0; c < cols_; ++c) {
+      if (is_zero_[r * cols_ + c]) {
+        zero_rows[c] = r;
+      }
+      int & nearest_row = nearest_rows[r * cols_ + c];
+      if (zero_rows[c] != -1 && (nearest_row == -1 || zero_rows[c] - r < r - nearest_row)) {
+        nearest_row = zero_rows[c];
+      }
+    }
+  }
+
+  // lower envelope of the parabolas of the columns in each row
+  std::vector<int> v(cols_);
+  std::vector<double> z(cols_ + 1);
+  for (int r = 0; r < rows_; ++r) {
+    const auto f = [&](const int q) {
+      const int dr = r - nearest_rows[r * cols_ + q];
+      return static_cast<double>(dr * dr);
+    };
+
+    int k = -1;
+    for (int q = 0; q < cols_; ++q) {
+      if (nearest_rows[r * cols_ + q] == -1) {
+        continue;
+      }
+      if (k < 0) {
+        k = 0;
+        v[0] = q;
+        z[0] = -std::numeric_limits<double>::infinity();
+        z[1] = std::numeric_limits<double>::infinity();
+        continue;
+      }
+      double s = 0.0;
+      while (true) {
+        s = ((f(q) + q * q) - (f(v[k]) + v[k] * v[k])) / (2.0 * (q - v[k]));
+        if (s > z[k]) {
+          break;
+        }
+        --k;
+      }
+      ++k;
+      v[k] = q;
+      z[k] = s;
+      z[k + 1] = std::numeric_limits<double>::infinity();
+    }
+
+    if (k < 0) {
+      // no zero cell in the grid
+      for (int c = 0; c < cols_; ++c) {
+        clearCell(r * cols_ + c);
+      }
+      continue;
+    }
+    k = 0;
+    for (int c = 0; c < cols_; ++c) {
+      while (z[k + 1] < c) {
+        ++k;
+      }
+      const int q = v[k];
+      const int dc = c - q;
+      const int zero_row = nearest_rows[r * cols_ + q];
+      const int dr = r - zero_row;
+      setDistance(r * cols_ + c, dr * dr + dc * dc, zero_row * cols_ + q);
+    }
+  }
+}
+
+bool IncrementalClearanceMap::shift(
+  const cv::Mat & image, const nav_msgs::msg::MapMetaData & map_info)
+{
+  if (
+    rows_ == 0 || image.rows != rows_ || image.cols != cols_ ||
+    map_info.width != map_info_.width || map_info.height != map_info_.height ||
+    map_info.resolution != map_info_.resolution ||
+    !isSameOrientation(map_info.origin.orientation, map_info_.origin.orientation)) {
+    return false;
+  }
+
+  // cell (r, c) of the grid of map_info is the cell (r + dr, c + dc) of the previous one,
+  // as given by geometry_utils::transformMapToImage()
+  const auto origin_shift =
+    geometry_utils::transformToRelativeCoordinate2D(map_info.origin.position, map_info_.origin);
+  const double exact_dr = -origin_shift.x / map_info.resolution;
+  const double exact_dc = -origin_shift.y / map_info.resolution;
+  const int dr = static_cast<int>(std::round(exact_dr));
+  const int dc = static_cast<int>(std::round(exact_dc));
+  constexpr double epsilon = 1e-3;
+  if (
+    std::abs(exact_dr - dr) > epsilon || std::abs(exact_dc - dc) > epsilon ||
+    std::abs(dr) >= rows_ || std::abs(dc) >= cols_) {
+    return false;
+  }
+  if (dr == 0 && dc == 0) {
+    return true;
+  }
+
+  const int cell_num = rows_ * cols_;
+  std::vector<uint8_t> is_zero(cell_num, 0);
+  std::vector<int> sq_dists(cell_num, max_sq_dist);
+  std::vector<int> nearest_zero_indices(cell_num, no_zero_idx);
+  std::vector<int> raised_indices;
+  std::vector<int> new_indices;
+  for (int r = 0; r < rows_; ++r) {
+    for (int c = 0; c < cols_; ++c) {
+      const int idx = r * cols_ + c;
+      const int prev_r = r + dr;
+      const int prev_c = c + dc;
+      if (prev_r < 0 || rows_ <= prev_r || prev_c < 0 || cols_ <= prev_c) {
+        // compared to the image as a non zero cell, and filled from its neighbors
+        new_indices.push_back(idx);
+        continue;
+      }
+      const int prev_idx = prev_r * cols_ + prev_c;
+      is_zero[idx] = is_zero_[prev_idx];
+      const int prev_zero_idx = nearest_zero_indices_[prev_idx];
+      if (prev_zero_idx == no_zero_idx) {
+        continue;
+      }
+      const int zero_r = prev_zero_idx / cols_ - dr;
+      const int zero_c = prev_zero_idx % cols_ - dc;
+      sq_dists[idx] = sq_dists_[prev_idx];
+      if (zero_r < 0 || rows_ <= zero_r || zero_c < 0 || cols_ <= zero_c) {
+        // its nearest zero cell went out of the grid, which is the same as being removed
+        raised_indices.push_back(idx);
+        continue;
+      }
+      nearest_zero_indices[idx] = zero_r * cols_ + zero_c;
+    }
+  }
+
+  is_zero_ = std::move(is_zero);
+  sq_dists_ = std::move(sq_dists);
+  nearest_zero_indices_ = std::move(nearest_zero_indices);
+  clearQueue();
+
+  cv::Mat clearance_map(rows_, cols_, CV_32FC1);
+  for (int idx = 0; idx < cell_num; ++idx) {
+    const int sq_dist = sq_dists_[idx];
+    clearance_map.ptr<float>()[idx] =
+      sq_dist == max_sq_dist ? std::numeric_limits<float>::max()
+                             : std::sqrt(static_cast<float>(sq_dist));
+  }
+  clearance_map_ = clearance_map;
+
+  for (const int idx : raised_indices) {
+    const int sq_dist = sq_dists_[idx];
+    clearCell(idx);
+    is_raised_[idx] = true;
+    push(sq_dist, idx);
+  }
+  for (const int idx : new_indices) {
+    forEachNeighbor(idx, [&](const int n_idx, const int, const int) {
+      if (nearest_zero_indices_[n_idx] != no_zero_idx) {
+        push(sq_dists_[n_idx], n_idx);
+      }
+    });
+  }
+  return true;
+}
+
+void IncrementalClearanceMap::propagate()
+{
+  while (queue_size_ > 0) {
+    const auto [sq_dist, idx] = pop();
+
+    if (is_raised_[idx]) {
+      raise(idx);
+    } else if (
+      nearest_zero_indices_[idx] != no_zero_idx && is_zero_[nearest_zero_indices_[idx]] &&
+      sq_dist <= sq_dists_[idx]) {
+      lower(idx);
+    }
+  }
+}
+
+void IncrementalClearanceMap::raise(const int idx)
+{
+  forEachNeighbor(idx, [&](const int n_idx, const int, const int) {
+    const int zero_idx = nearest_zero_indices_[n_idx];
+    if (zero_idx == no_zero_idx || is_raised_[n_idx]) {
+      return;
+    }
+    if (is_zero_[zero_idx]) {
+      push(sq_dists_[n_idx], n_idx);
+      return;
+    }
+    const int sq_dist = sq_dists_[n_idx];
+    clearCell(n_idx);
+    is_raised_[n_idx] = true;
+    push(sq_dist, n_idx);
+  });
+  is_raised_[idx] = false;
+}
+
+void IncrementalClearanceMap::lower(const int idx)
+{
+  const int zero_idx = nearest_zero_indices_[idx];
+  const int zero_r = zero_idx / cols_;
+  const int zero_c = zero_idx % cols_;
+  forEachNeighbor(idx, [&](const int n_idx, const int n_r, const int n_c) {
+    if (is_raised_[n_idx]) {
+      return;
+    }
+    const int dr = n_r - zero_r;
+    const int dc = n_c - zero_c;
+    const int sq_dist = dr * dr + dc * dc;
+    if (sq_dist < sq_dists_[n_idx]) {
+      setDistance(n_idx, sq_dist, zero_idx);
+      push(sq_dist, n_idx);
+    }
+  });
+}
+
+void IncrementalClearanceMap::push(const int sq_dist, const int idx)
+{
+  const size_t bucket = static_cast<size_t>(std::sqrt(static_cast<float>(sq_dist)));
+  if (buckets_.size() <= bucket) {
+    buckets_.resize(bucket + 1);
+  }
+  buckets_[bucket].emplace_back(sq_dist, idx);
+  min_bucket_ = std::min(min_bucket_, bucket);
+  ++queue_size_;
+}
+
+std::pair<int, int> IncrementalClearanceMap::pop()
+{
+  while (buckets_[min_bucket_].empty()) {
+    ++min_bucket_;
+  }
+  const auto cell = buckets_[min_bucket_].back();
+  buckets_[min_bucket_].pop_back();
+  --queue_size_;
+  return cell;
+}
+
+void IncrementalClearanceMap::clearQueue()
+{
+  for (auto & bucket : buckets_) {
+    bucket.clear();
+  }
+  queue_size_ = 0;
+  min_bucket_ = 0;
+}
+
+void IncrementalClearanceMap::setDistance(const int idx, const int sq_dist, const int zero_idx)
+{
+  sq_dists_[idx] = sq_dist;
+  nearest_zero_indices_[idx] = zero_idx;
+  clearance_map_.ptr<float>()[idx] = std::sqrt(static_cast<float>(sq_dist));
+}
+
+void IncrementalClearanceMap::clearCell(const int idx)
+{
+  sq_dists_[idx] = max_sq_dist;
+  nearest_zero_indices_[idx] = no_zero_idx;
+  clearance_map_.ptr<float>()[idx] = std::numeric_limits<float>::max();
+}
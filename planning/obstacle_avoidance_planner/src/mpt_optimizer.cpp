@@ -513,6 +513,7 @@ std::vector<ReferencePoint> MPTOptimizer::getFixedReferencePoints(
     ReferencePoint fixed_ref_point;
     fixed_ref_point = prev_ref_point;
     fixed_ref_point.fix_kinematic_state = prev_ref_point.optimized_kinematic_state;
+    fixed_ref_point.is_prev_point = true;
 
     fixed_ref_points.push_back(fixed_ref_point);
   }
@@ -711,81 +712,71 @@ boost::optional<Eigen::VectorXd> MPTOptimizer::executeOptimization(
 
   const size_t N_ref = ref_points.size();
 
-  // get matrix
-  ObjectiveMatrix obj_m = getObjectiveMatrix(mpt_mat, val_mat, ref_points, debug_data_ptr);
-  ConstraintMatrix const_m =
-    getConstraintMatrix(enable_avoidance, mpt_mat, ref_points, debug_data_ptr);
+  // pad the horizon and the fixed points with dummy variables and constraints, so that the
+  // sparsity pattern of the QP does not change over the cycles and the solver is only updated
+  const size_t N_fixed = std::count_if(
+    ref_points.begin(), ref_points.end(),
+    [](const auto & ref_point) { return static_cast<bool>(ref_point.fix_kinematic_state); });
+  const size_t N_pad =
+    mpt_param_.enable_warm_start
+      ? std::max(N_ref, static_cast<size_t>(traj_param_.num_sampling_points) + 1)
+      : N_ref;
+  const size_t N_fixed_pad =
+    mpt_param_.enable_warm_start ? std::max(N_fixed, prev_fixed_points_num_) : N_fixed;
+  prev_fixed_points_num_ = N_fixed_pad;
 
-  // manual warm start
-  Eigen::VectorXd u0 = Eigen::VectorXd::Zero(obj_m.gradient.size());
-
-  if (mpt_param_.enable_manual_warm_start) {
-    const size_t D_x = vehicle_model_ptr_->getDimX();
-
-    if (prev_trajs && prev_trajs->mpt_ref_points.size() > 1) {
-      const size_t seg_idx =
-        motion_utils::findNearestSegmentIndex(prev_trajs->mpt_ref_points, ref_points.front().p);
-      double offset = motion_utils::calcLongitudinalOffsetToSegment(
-        prev_trajs->mpt_ref_points, seg_idx, ref_points.front().p);
-
-      u0(0) = prev_trajs->mpt_ref_points.at(seg_idx).optimized_kinematic_state(0);
-      u0(1) = prev_trajs->mpt_ref_points.at(seg_idx).optimized_kinematic_state(1);
-
-      for (size_t i = 0; i + 1 < N_ref; ++i) {
-        size_t prev_idx = seg_idx + i;
-        const size_t prev_N_ref = prev_trajs->mpt_ref_points.size();
-        if (prev_idx + 2 > prev_N_ref) {
-          prev_idx = static_cast<int>(prev_N_ref) - 2;
-          offset = 0.5;
-        }
+  // get matrix
+  const ObjectiveMatrix obj_m =
+    getObjectiveMatrix(mpt_mat, val_mat, ref_points, N_pad, debug_data_ptr);
+  const ConstraintMatrix const_m = getConstraintMatrix(
+    enable_avoidance, mpt_mat, ref_points, N_pad, N_fixed_pad, debug_data_ptr);
 
-        const double prev_val = prev_trajs->mpt_ref_points.at(prev_idx).optimized_input;
-        const double next_val = prev_trajs->mpt_ref_points.at(prev_idx + 1).optimized_input;
-        u0(D_x + i) = interpolation::lerp(prev_val, next_val, offset);
-      }
-    }
-  }
+  // previous solution shifted to the current reference points, for the warm starts
+  const Eigen::VectorXd shifted_prev_solution =
+    calcShiftedPrevSolution(prev_trajs, ref_points, obj_m.gradient.size());
 
-  const Eigen::MatrixXd & H = obj_m.hessian;
-  const Eigen::MatrixXd & A = const_m.linear;
-  std::vector<double> f;
-  std::vector<double> upper_bound;
-  std::vector<double> lower_bound;
-
-  if (mpt_param_.enable_manual_warm_start) {
-    f = eigenVectorToStdVector(obj_m.gradient + H * u0);
-    Eigen::VectorXd A_times_u0 = A * u0;
-    upper_bound = eigenVectorToStdVector(const_m.upper_bound - A_times_u0);
-    lower_bound = eigenVectorToStdVector(const_m.lower_bound - A_times_u0);
-  } else {
-    f = eigenVectorToStdVector(obj_m.gradient);
-    upper_bound = eigenVectorToStdVector(const_m.upper_bound);
-    lower_bound = eigenVectorToStdVector(const_m.lower_bound);
-  }
+  // manual warm start
+  const Eigen::VectorXd u0 = mpt_param_.enable_manual_warm_start
+                               ? shifted_prev_solution
+                               : Eigen::VectorXd::Zero(obj_m.gradient.size()).eval();
+
+  const Eigen::SparseMatrix<double> & H = obj_m.hessian;
+  const Eigen::SparseMatrix<double> & A = const_m.linear;
+  const Eigen::VectorXd A_times_u0 = A * u0;
+  const std::vector<double> f =
+    eigenVectorToStdVector(obj_m.gradient + H.selfadjointView<Eigen::Upper>() * u0);
+  const std::vector<double> upper_bound =
+    eigenVectorToStdVector(const_m.upper_bound - A_times_u0);
+  const std::vector<double> lower_bound =
+    eigenVectorToStdVector(const_m.lower_bound - A_times_u0);
 
   // initialize or update solver with warm start
   stop_watch_.tic("initOsqp");
-  autoware::common::osqp::CSC_Matrix P_csc = autoware::common::osqp::calCSCMatrixTrapezoidal(H);
-  autoware::common::osqp::CSC_Matrix A_csc = autoware::common::osqp::calCSCMatrix(A);
-  if (mpt_param_.enable_warm_start && prev_mat_n == H.rows() && prev_mat_m == A.rows()) {
+  const autoware::common::osqp::CSC_Matrix P_csc = autoware::common::osqp::calCSCMatrix(H);
+  const autoware::common::osqp::CSC_Matrix A_csc = autoware::common::osqp::calCSCMatrix(A);
+  if (mpt_param_.enable_warm_start && osqp_solver_ptr_) {
     RCLCPP_INFO_EXPRESSION(
-      rclcpp::get_logger("mpt_optimizer"), is_showing_debug_info_, "warm start");
+      rclcpp::get_logger("mpt_optimizer"), is_showing_debug_info_,
+      osqp_solver_ptr_->isSameSparsity(P_csc, A_csc) ? "warm start" : "no warm start");
 
-    osqp_solver_ptr_->updateCscP(P_csc);
-    osqp_solver_ptr_->updateQ(f);
-    osqp_solver_ptr_->updateCscA(A_csc);
-    osqp_solver_ptr_->updateL(lower_bound);
-    osqp_solver_ptr_->updateU(upper_bound);
+    osqp_solver_ptr_->updateProblem(P_csc, A_csc, f, lower_bound, upper_bound);
   } else {
     RCLCPP_INFO_EXPRESSION(
       rclcpp::get_logger("mpt_optimizer"), is_showing_debug_info_, "no warm start");
 
     osqp_solver_ptr_ = std::make_unique<autoware::common::osqp::OSQPInterface>(
-      // obj_m.hessian, const_m.linear, obj_m.gradient, const_m.lower_bound, const_m.upper_bound,
       P_csc, A_csc, f, lower_bound, upper_bound, osqp_epsilon_);
   }
-  prev_mat_n = H.rows();
-  prev_mat_m = A.rows();
+
+  if (mpt_param_.enable_warm_start) {
+    // with the manual warm start, the variables are the offsets from the shifted solution
+    const Eigen::VectorXd primal = shifted_prev_solution - u0;
+    std::vector<double> dual = prev_dual_solution_;
+    if (dual.size() != lower_bound.size()) {
+      dual.assign(lower_bound.size(), 0.0);
+    }
+    osqp_solver_ptr_->setWarmStart(eigenVectorToStdVector(primal), dual);
+  }
 
   debug_data_ptr->msg_stream << "          "
                              << "initOsqp"
@@ -802,8 +793,10 @@ boost::optional<Eigen::VectorXd> MPTOptimizer::executeOptimization(
   const int solution_status = std::get<3>(result);
   if (solution_status != 1) {
     utils::logOSQPSolutionStatus(solution_status, "MPT: ");
+    prev_dual_solution_.clear();
     return boost::none;
   }
+  prev_dual_solution_ = std::get<1>(result);
 
   // print iteration
   const int iteration_status = std::get<4>(result);
@@ -828,9 +821,46 @@ boost::optional<Eigen::VectorXd> MPTOptimizer::executeOptimization(
   return optimized_control_variables_with_offset;
 }
 
+Eigen::VectorXd MPTOptimizer::calcShiftedPrevSolution(
+  const std::unique_ptr<Trajectories> & prev_trajs, const std::vector<ReferencePoint> & ref_points,
+  const size_t N_v) const
+{
+  const size_t D_x = vehicle_model_ptr_->getDimX();
+  const size_t N_ref = ref_points.size();
+
+  // the slack variables and the padded inputs are left to zero
+  Eigen::VectorXd u0 = Eigen::VectorXd::Zero(N_v);
+  if (!prev_trajs || prev_trajs->mpt_ref_points.size() < 2) {
+    return u0;
+  }
+
+  const size_t seg_idx =
+    motion_utils::findNearestSegmentIndex(prev_trajs->mpt_ref_points, ref_points.front().p);
+  double offset = motion_utils::calcLongitudinalOffsetToSegment(
+    prev_trajs->mpt_ref_points, seg_idx, ref_points.front().p);
+
+  u0(0) = prev_trajs->mpt_ref_points.at(seg_idx).optimized_kinematic_state(0);
+  u0(1) = prev_trajs->mpt_ref_points.at(seg_idx).optimized_kinematic_state(1);
+
+  for (size_t i = 0; i + 1 < N_ref; ++i) {
+    size_t prev_idx = seg_idx + i;
+    const size_t prev_N_ref = prev_trajs->mpt_ref_points.size();
+    if (prev_idx + 2 > prev_N_ref) {
+      prev_idx = static_cast<int>(prev_N_ref) - 2;
+      offset = 0.5;
+    }
+
+    const double prev_val = prev_trajs->mpt_ref_points.at(prev_idx).optimized_input;
+    const double next_val = prev_trajs->mpt_ref_points.at(prev_idx + 1).optimized_input;
+    u0(D_x + i) = interpolation::lerp(prev_val, next_val, offset);
+  }
+
+  return u0;
+}
+
 MPTOptimizer::ObjectiveMatrix MPTOptimizer::getObjectiveMatrix(
   const MPTMatrix & mpt_mat, const ValueMatrix & val_mat,
-  [[maybe_unused]] const std::vector<ReferencePoint> & ref_points,
+  [[maybe_unused]] const std::vector<ReferencePoint> & ref_points, const size_t N_pad,
   std::shared_ptr<DebugData> debug_data_ptr) const
 {
   stop_watch_.tic(__func__);
@@ -841,6 +871,7 @@ MPTOptimizer::ObjectiveMatrix MPTOptimizer::getObjectiveMatrix(
 
   const size_t D_xn = D_x * N_ref;
   const size_t D_v = D_x + (N_ref - 1) * D_u;
+  const size_t D_v_pad = D_x + (N_pad - 1) * D_u;
 
   // generate T matrix and vector to shift optimization center
   //   define Z as time-series vector of shifted deviation error
@@ -866,9 +897,7 @@ MPTOptimizer::ObjectiveMatrix MPTOptimizer::getObjectiveMatrix(
   const Eigen::MatrixXd R = val_mat.Rex;
 
   // min J(v) = min (v'Hv + v'f)
-  Eigen::MatrixXd H = Eigen::MatrixXd::Zero(D_v, D_v);
-  H.triangularView<Eigen::Upper>() = B.transpose() * QB + R;
-  H.triangularView<Eigen::Lower>() = H.transpose();
+  const Eigen::MatrixXd H = B.transpose() * QB + R;
 
   // Eigen::VectorXd f = ((sparse_T_mat * mpt_mat.Wex + T_vec).transpose() * QB).transpose();
   Eigen::VectorXd f = (sparse_T_mat * mpt_mat.Wex + T_vec).transpose() * QB;
@@ -893,21 +922,31 @@ MPTOptimizer::ObjectiveMatrix MPTOptimizer::getObjectiveMatrix(
   // number of slack variables for one step
   const size_t N_slack = N_first_slack + N_second_slack;
 
-  // extend H for slack variables
-  Eigen::MatrixXd full_H = Eigen::MatrixXd::Zero(D_v + N_ref * N_slack, D_v + N_ref * N_slack);
-  full_H.block(0, 0, D_v, D_v) = H;
+  // extend H for padded inputs and slack variables, only its upper triangle being set.
+  // The whole upper triangle of the inputs is in the sparsity pattern regardless of N_ref, and a
+  // padded input only has a unit weight on its own, which makes it zero.
+  std::vector<Eigen::Triplet<double>> H_triplet_vec;
+  H_triplet_vec.reserve(D_v_pad * (D_v_pad + 1) / 2);
+  for (size_t c = 0; c < D_v_pad; ++c) {
+    for (size_t r = 0; r <= c; ++r) {
+      const double val = c < D_v ? H(r, c) : (r == c ? 1.0 : 0.0);
+      H_triplet_vec.push_back(Eigen::Triplet<double>(r, c, val));
+    }
+  }
+  Eigen::SparseMatrix<double> full_H(D_v_pad + N_pad * N_slack, D_v_pad + N_pad * N_slack);
+  full_H.setFromTriplets(H_triplet_vec.begin(), H_triplet_vec.end());
 
-  // extend f for slack variables
-  Eigen::VectorXd full_f(D_v + N_ref * N_slack);
+  // extend f for padded inputs and slack variables
+  Eigen::VectorXd full_f = Eigen::VectorXd::Zero(D_v_pad + N_pad * N_slack);
 
   full_f.segment(0, D_v) = f;
   if (N_first_slack > 0) {
-    full_f.segment(D_v, N_ref * N_first_slack) =
-      mpt_param_.soft_avoidance_weight * Eigen::VectorXd::Ones(N_ref * N_first_slack);
+    full_f.segment(D_v_pad, N_pad * N_first_slack) =
+      mpt_param_.soft_avoidance_weight * Eigen::VectorXd::Ones(N_pad * N_first_slack);
   }
   if (N_second_slack > 0) {
-    full_f.segment(D_v + N_ref * N_first_slack, N_ref * N_second_slack) =
-      mpt_param_.soft_second_avoidance_weight * Eigen::VectorXd::Ones(N_ref * N_second_slack);
+    full_f.segment(D_v_pad + N_pad * N_first_slack, N_pad * N_second_slack) =
+      mpt_param_.soft_second_avoidance_weight * Eigen::VectorXd::Ones(N_pad * N_second_slack);
   }
 
   ObjectiveMatrix obj_matrix;
@@ -924,9 +963,11 @@ MPTOptimizer::ObjectiveMatrix MPTOptimizer::getObjectiveMatrix(
 // decision variable
 // x := [u0, ..., uN-1 | z00, ..., z0N-1 | z10, ..., z1N-1 | z20, ..., z2N-1]
 //   \in \mathbb{R}^{N * (N_vehicle_circle + 1)}
+// where N is the padded horizon N_pad. The constraints of the padded points and of the padded
+// fixed points are free, their slack variables being fixed to zero.
 MPTOptimizer::ConstraintMatrix MPTOptimizer::getConstraintMatrix(
   [[maybe_unused]] const bool enable_avoidance, const MPTMatrix & mpt_mat,
-  const std::vector<ReferencePoint> & ref_points,
+  const std::vector<ReferencePoint> & ref_points, const size_t N_pad, const size_t N_fixed_pad,
   [[maybe_unused]] std::shared_ptr<DebugData> debug_data_ptr) const
 {
   stop_watch_.tic(__func__);
@@ -939,6 +980,8 @@ MPTOptimizer::ConstraintMatrix MPTOptimizer::getConstraintMatrix(
 
   const size_t N_u = (N_ref - 1) * D_u;
   const size_t D_v = D_x + N_u;
+  const size_t N_u_pad = (N_pad - 1) * D_u;
+  const size_t D_v_pad = D_x + N_u_pad;
 
   const size_t N_avoid = mpt_param_.vehicle_circle_longitudinal_offsets.size();
 
@@ -959,15 +1002,15 @@ MPTOptimizer::ConstraintMatrix MPTOptimizer::getConstraintMatrix(
     return 0;
   }();
 
-  // number of all slack variables is N_ref * N_slack
+  // number of all slack variables is N_pad * N_slack
   const size_t N_slack = N_first_slack + N_second_slack;
   const size_t N_soft = mpt_param_.two_step_soft_constraint ? 2 : 1;
 
   const size_t A_cols = [&] {
     if (mpt_param_.soft_constraint) {
-      return D_v + N_ref * N_slack;  // initial_state + steer + soft
+      return D_v_pad + N_pad * N_slack;  // initial_state + steer + soft
     }
-    return D_v;  // initial state + steer
+    return D_v_pad;  // initial state + steer
   }();
 
   // calculate indices of fixed points
@@ -982,21 +1025,37 @@ MPTOptimizer::ConstraintMatrix MPTOptimizer::getConstraintMatrix(
   size_t A_rows = 0;
   if (mpt_param_.soft_constraint) {
     // 3 means slack variable constraints to be between lower and upper bounds, and positive.
-    A_rows += 3 * N_ref * N_avoid * N_soft;
+    A_rows += 3 * N_pad * N_avoid * N_soft;
   }
   if (mpt_param_.hard_constraint) {
-    A_rows += N_ref * N_avoid;
+    A_rows += N_pad * N_avoid;
   }
-  A_rows += fixed_points_indices.size() * D_x;
+  A_rows += N_fixed_pad * D_x;
   if (mpt_param_.steer_limit_constraint) {
-    A_rows += N_u;
+    A_rows += N_u_pad;
   }
 
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(A_rows, A_cols);
+  std::vector<Eigen::Triplet<double>> A_triplet_vec;
   Eigen::VectorXd lb = Eigen::VectorXd::Constant(A_rows, -autoware::common::osqp::INF);
   Eigen::VectorXd ub = Eigen::VectorXd::Constant(A_rows, autoware::common::osqp::INF);
   size_t A_rows_end = 0;
 
+  // add sign * CB padded to N_pad rows. The i-th state only depends on the initial state and the
+  // inputs before i, which is the sparsity pattern kept whatever the values.
+  const auto addCBTriplets = [&](const Eigen::MatrixXd & CB, const double sign) {
+    for (size_t i = 0; i < N_pad; ++i) {
+      for (size_t c = 0; c < D_x + i * D_u; ++c) {
+        const double val = (i < N_ref && c < D_v) ? sign * CB(i, c) : 0.0;
+        A_triplet_vec.push_back(Eigen::Triplet<double>(A_rows_end + i, c, val));
+      }
+    }
+  };
+  const auto addIdentityTriplets = [&](const size_t row_offset, const size_t col_offset) {
+    for (size_t i = 0; i < N_pad; ++i) {
+      A_triplet_vec.push_back(Eigen::Triplet<double>(row_offset + i, col_offset + i, 1.0));
+    }
+  };
+
   // CX = C(Bv + w) + C \in R^{N_ref, N_ref * D_x}
   for (size_t l_idx = 0; l_idx < N_avoid; ++l_idx) {
     // create C := [1 | l | O]
@@ -1027,90 +1086,99 @@ MPTOptimizer::ConstraintMatrix MPTOptimizer::getConstraintMatrix(
 
     // soft constraints
     if (mpt_param_.soft_constraint) {
-      size_t A_offset_cols = D_v;
+      size_t A_offset_cols = D_v_pad;
       for (size_t s_idx = 0; s_idx < N_soft; ++s_idx) {
-        const size_t A_blk_rows = 3 * N_ref;
+        const size_t A_blk_rows = 3 * N_pad;
 
         // A := [C * Bex | O | ... | O | I | O | ...
         //      -C * Bex | O | ... | O | I | O | ...
         //          O    | O | ... | O | I | O | ... ]
-        Eigen::MatrixXd A_blk = Eigen::MatrixXd::Zero(A_blk_rows, A_cols);
-        A_blk.block(0, 0, N_ref, D_v) = CB;
-        A_blk.block(N_ref, 0, N_ref, D_v) = -CB;
-
         size_t local_A_offset_cols = A_offset_cols;
         if (!mpt_param_.l_inf_norm) {
-          local_A_offset_cols += N_ref * l_idx;
+          local_A_offset_cols += N_pad * l_idx;
         }
-        A_blk.block(0, local_A_offset_cols, N_ref, N_ref) = Eigen::MatrixXd::Identity(N_ref, N_ref);
-        A_blk.block(N_ref, local_A_offset_cols, N_ref, N_ref) =
-          Eigen::MatrixXd::Identity(N_ref, N_ref);
-        A_blk.block(2 * N_ref, local_A_offset_cols, N_ref, N_ref) =
-          Eigen::MatrixXd::Identity(N_ref, N_ref);
+        addCBTriplets(CB, 1.0);
+        addIdentityTriplets(A_rows_end, local_A_offset_cols);
+        A_rows_end += N_pad;
+        addCBTriplets(CB, -1.0);
+        addIdentityTriplets(A_rows_end, local_A_offset_cols);
+        A_rows_end += N_pad;
+        addIdentityTriplets(A_rows_end, local_A_offset_cols);
+        A_rows_end += N_pad;
 
         // lb := [lower_bound - CW
         //        CW - upper_bound
         //               O        ]
-        Eigen::VectorXd lb_blk = Eigen::VectorXd::Zero(A_blk_rows);
-        lb_blk.segment(0, N_ref) = -CW + part_lb;
-        lb_blk.segment(N_ref, N_ref) = CW - part_ub;
+        const size_t A_blk_begin = A_rows_end - A_blk_rows;
+        lb.segment(A_blk_begin, N_ref) = -CW + part_lb;
+        lb.segment(A_blk_begin + N_pad, N_ref) = CW - part_ub;
+        lb.segment(A_blk_begin + 2 * N_pad, N_pad) = Eigen::VectorXd::Zero(N_pad);
+        // the slack variables of the padded points are fixed to zero
+        ub.segment(A_blk_begin + 2 * N_pad + N_ref, N_pad - N_ref) =
+          Eigen::VectorXd::Zero(N_pad - N_ref);
 
         if (s_idx == 1) {
           // add additional clearance
           const double diff_clearance =
             mpt_param_.soft_second_clearance_from_road - mpt_param_.soft_clearance_from_road;
-          lb_blk.segment(0, N_ref) -= Eigen::MatrixXd::Constant(N_ref, 1, diff_clearance);
-          lb_blk.segment(N_ref, N_ref) -= Eigen::MatrixXd::Constant(N_ref, 1, diff_clearance);
+          lb.segment(A_blk_begin, N_ref) -= Eigen::MatrixXd::Constant(N_ref, 1, diff_clearance);
+          lb.segment(A_blk_begin + N_pad, N_ref) -=
+            Eigen::MatrixXd::Constant(N_ref, 1, diff_clearance);
         }
 
-        A_offset_cols += N_ref * N_first_slack;
-
-        A.block(A_rows_end, 0, A_blk_rows, A_cols) = A_blk;
-        lb.segment(A_rows_end, A_blk_rows) = lb_blk;
-
-        A_rows_end += A_blk_rows;
+        A_offset_cols += N_pad * N_first_slack;
       }
     }
 
     // hard constraints
     if (mpt_param_.hard_constraint) {
-      const size_t A_blk_rows = N_ref;
-
-      Eigen::MatrixXd A_blk = Eigen::MatrixXd::Zero(A_blk_rows, A_cols);
-      A_blk.block(0, 0, N_ref, N_ref) = CB;
-
-      A.block(A_rows_end, 0, A_blk_rows, A_cols) = A_blk;
-      lb.segment(A_rows_end, A_blk_rows) = part_lb - CW;
-      ub.segment(A_rows_end, A_blk_rows) = part_ub - CW;
+      addCBTriplets(CB, 1.0);
+      lb.segment(A_rows_end, N_ref) = part_lb - CW;
+      ub.segment(A_rows_end, N_ref) = part_ub - CW;
 
-      A_rows_end += A_blk_rows;
+      A_rows_end += N_pad;
     }
   }
 
   // fixed points constraint
   // CX = C(B v + w) where C extracts fixed points
-  if (fixed_points_indices.size() > 0) {
-    for (const size_t i : fixed_points_indices) {
-      A.block(A_rows_end, 0, D_x, D_v) = mpt_mat.Bex.block(i * D_x, 0, D_x, D_v);
+  // The rows of a fixed point span all the inputs, since the fixed points change over the cycles.
+  for (size_t k = 0; k < N_fixed_pad; ++k) {
+    const bool is_padded = k >= fixed_points_indices.size();
+    const size_t i = is_padded ? 0 : fixed_points_indices.at(k);
+    for (size_t j = 0; j < D_x; ++j) {
+      for (size_t c = 0; c < D_v_pad; ++c) {
+        const double val = (!is_padded && c < D_v) ? mpt_mat.Bex(i * D_x + j, c) : 0.0;
+        A_triplet_vec.push_back(Eigen::Triplet<double>(A_rows_end + j, c, val));
+      }
+    }
 
+    if (!is_padded) {
       lb.segment(A_rows_end, D_x) =
         ref_points[i].fix_kinematic_state.get() - mpt_mat.Wex.segment(i * D_x, D_x);
       ub.segment(A_rows_end, D_x) =
         ref_points[i].fix_kinematic_state.get() - mpt_mat.Wex.segment(i * D_x, D_x);
-
-      A_rows_end += D_x;
     }
+
+    A_rows_end += D_x;
   }
 
   // steer max limit
   if (mpt_param_.steer_limit_constraint) {
-    A.block(A_rows_end, D_x, N_u, N_u) = Eigen::MatrixXd::Identity(N_u, N_u);
-    lb.segment(A_rows_end, N_u) = Eigen::MatrixXd::Constant(N_u, 1, -mpt_param_.max_steer_rad);
-    ub.segment(A_rows_end, N_u) = Eigen::MatrixXd::Constant(N_u, 1, mpt_param_.max_steer_rad);
+    for (size_t i = 0; i < N_u_pad; ++i) {
+      A_triplet_vec.push_back(Eigen::Triplet<double>(A_rows_end + i, D_x + i, 1.0));
+    }
+    lb.segment(A_rows_end, N_u_pad) =
+      Eigen::MatrixXd::Constant(N_u_pad, 1, -mpt_param_.max_steer_rad);
+    ub.segment(A_rows_end, N_u_pad) =
+      Eigen::MatrixXd::Constant(N_u_pad, 1, mpt_param_.max_steer_rad);
 
-    A_rows_end += N_u;
+    A_rows_end += N_u_pad;
   }
 
+  Eigen::SparseMatrix<double> A(A_rows, A_cols);
+  A.setFromTriplets(A_triplet_vec.begin(), A_triplet_vec.end());
+
   ConstraintMatrix constraint_matrix;
   constraint_matrix.linear = A;
   constraint_matrix.lower_bound = lb;
@@ -1289,6 +1357,17 @@ void MPTOptimizer::calcArcLength(std::vector<ReferencePoint> & ref_points) const
 void MPTOptimizer::calcExtraPoints(
   std::vector<ReferencePoint> & ref_points, const std::unique_ptr<Trajectories> & prev_trajs) const
 {
+  // poses of the reference points and of the previous ones, searched for each point below
+  const auto ref_points_with_yaw =
+    points_utils::convertToPosesWithYawEstimation(points_utils::convertToPoints(ref_points));
+  const auto prev_ref_points_with_yaw = [&]() {
+    if (prev_trajs && !prev_trajs->mpt_ref_points.empty()) {
+      return points_utils::convertToPosesWithYawEstimation(
+        points_utils::convertToPoints(prev_trajs->mpt_ref_points));
+    }
+    return std::vector<geometry_msgs::msg::Pose>{};
+  }();
+
   for (size_t i = 0; i < ref_points.size(); ++i) {
     // alpha
     const double front_wheel_s =
@@ -1328,12 +1407,14 @@ void MPTOptimizer::calcExtraPoints(
     if (prev_trajs && !prev_trajs->mpt_ref_points.empty()) {
       const auto & prev_ref_points = prev_trajs->mpt_ref_points;
 
-      const auto ref_points_with_yaw =
-        points_utils::convertToPosesWithYawEstimation(points_utils::convertToPoints(ref_points));
-      const size_t prev_idx = findNearestIndexWithSoftYawConstraints(
-        points_utils::convertToPoints(prev_ref_points), ref_points_with_yaw.at(i),
+      const auto prev_idx_optional = motion_utils::findNearestIndex(
+        prev_ref_points_with_yaw, ref_points_with_yaw.at(i),
         traj_param_.delta_dist_threshold_for_closest_point,
         traj_param_.delta_yaw_threshold_for_closest_point);
+      const size_t prev_idx = prev_idx_optional ? *prev_idx_optional
+                                                : motion_utils::findNearestIndex(
+                                                    prev_ref_points_with_yaw,
+                                                    ref_points_with_yaw.at(i).position);
       const double dist_to_nearest_prev_ref =
         tier4_autoware_utils::calcDistance2d(prev_ref_points.at(prev_idx), ref_points.at(i));
       if (dist_to_nearest_prev_ref < 1.0 && prev_ref_points.at(prev_idx).near_objects) {
@@ -1368,9 +1449,18 @@ void MPTOptimizer::calcBounds(
 {
   stop_watch_.tic(__func__);
 
+  // the points shifted from the previous cycle keep their bounds, the next ones being continuous
+  const auto is_reusing_bounds = [&](const ReferencePoint & ref_point) {
+    return mpt_param_.reuse_fixed_points_bounds && ref_point.is_prev_point;
+  };
+
   // search bounds candidate for each ref points
   SequentialBoundsCandidates sequential_bounds_candidates;
   for (const auto & ref_point : ref_points) {
+    if (is_reusing_bounds(ref_point)) {
+      sequential_bounds_candidates.push_back(BoundsCandidates{ref_point.bounds});
+      continue;
+    }
     const auto bounds_candidates = getBoundsCandidates(
       enable_avoidance, convertRefPointsToPose(ref_point), maps, debug_data_ptr);
     sequential_bounds_candidates.push_back(bounds_candidates);
@@ -1382,6 +1472,10 @@ void MPTOptimizer::calcBounds(
     // NOTE: back() is the front avoiding circle
     const auto & bounds_candidates = sequential_bounds_candidates.at(i);
 
+    if (is_reusing_bounds(ref_points.at(i))) {
+      continue;
+    }
+
     // extract only continuous bounds;
     if (i == 0) {  // TODO(murooka) use previous bounds, not widest bounds
       const auto target_pos = [&]() {
@@ -296,6 +296,8 @@ ObstacleAvoidancePlanner::ObstacleAvoidancePlanner(const rclcpp::NodeOptions & n
     enable_pre_smoothing_ = declare_parameter<bool>("option.enable_pre_smoothing");
     skip_optimization_ = declare_parameter<bool>("option.skip_optimization");
     reset_prev_optimization_ = declare_parameter<bool>("option.reset_prev_optimization");
+    enable_incremental_clearance_map_ =
+      declare_parameter<bool>("option.enable_incremental_clearance_map");
   }
 
   {  // trajectory parameter
@@ -390,6 +392,8 @@ ObstacleAvoidancePlanner::ObstacleAvoidancePlanner(const rclcpp::NodeOptions & n
     mpt_param_.enable_warm_start = declare_parameter<bool>("mpt.option.enable_warm_start");
     mpt_param_.enable_manual_warm_start =
       declare_parameter<bool>("mpt.option.enable_manual_warm_start");
+    mpt_param_.reuse_fixed_points_bounds =
+      declare_parameter<bool>("mpt.option.reuse_fixed_points_bounds");
     mpt_visualize_sampling_num_ = declare_parameter<int>("mpt.option.visualize_sampling_num");
 
     // common
@@ -555,6 +559,8 @@ rcl_interfaces::msg::SetParametersResult ObstacleAvoidancePlanner::paramCallback
     updateParam<bool>(parameters, "option.enable_pre_smoothing", enable_pre_smoothing_);
     updateParam<bool>(parameters, "option.skip_optimization", skip_optimization_);
     updateParam<bool>(parameters, "option.reset_prev_optimization", reset_prev_optimization_);
+    updateParam<bool>(
+      parameters, "option.enable_incremental_clearance_map", enable_incremental_clearance_map_);
   }
 
   {  // trajectory parameter
@@ -649,6 +655,8 @@ rcl_interfaces::msg::SetParametersResult ObstacleAvoidancePlanner::paramCallback
     updateParam<bool>(parameters, "mpt.option.enable_warm_start", mpt_param_.enable_warm_start);
     updateParam<bool>(
       parameters, "mpt.option.enable_manual_warm_start", mpt_param_.enable_manual_warm_start);
+    updateParam<bool>(
+      parameters, "mpt.option.reuse_fixed_points_bounds", mpt_param_.reuse_fixed_points_bounds);
     updateParam<int>(parameters, "mpt.option.visualize_sampling_num", mpt_visualize_sampling_num_);
 
     // common
@@ -826,7 +834,7 @@ void ObstacleAvoidancePlanner::resetPlanning()
 {
   RCLCPP_WARN(get_logger(), "[ObstacleAvoidancePlanner] Reset planning");
 
-  costmap_generator_ptr_ = std::make_unique<CostmapGenerator>();
+  costmap_generator_ptr_ = std::make_unique<CostmapGenerator>(enable_incremental_clearance_map_);
 
   eb_path_optimizer_ptr_ = std::make_unique<EBPathOptimizer>(
     is_showing_debug_info_, traj_param_, eb_param_, vehicle_param_);
@@ -54,7 +54,7 @@ public:
   VelocityOptimizer(
     const double max_s_weight, const double max_v_weight, const double over_s_safety_weight,
     const double over_s_ideal_weight, const double over_v_weight, const double over_a_weight,
-    const double over_j_weight);
+    const double over_j_weight, const bool enable_warm_start = false);
 
   OptimizationResult optimize(const OptimizationData & data);
 
@@ -67,6 +67,7 @@ private:
   double over_v_weight_;
   double over_a_weight_;
   double over_j_weight_;
+  bool enable_warm_start_;
 
   // QPSolver
   autoware::common::osqp::OSQPInterface qp_solver_;
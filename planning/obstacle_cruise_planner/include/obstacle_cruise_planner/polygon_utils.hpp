@@ -26,6 +26,8 @@
 #include <boost/geometry.hpp>
 #include <boost/optional.hpp>
 
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace polygon_utils
@@ -34,6 +36,28 @@ namespace bg = boost::geometry;
 using tier4_autoware_utils::Point2d;
 using tier4_autoware_utils::Polygon2d;
 
+/**
+ * @brief Indices of the trajectory points bucketed by the cells of a 2d grid, to find the points
+ * near a position of a predicted path without scanning the whole trajectory.
+ */
+class TrajectoryPointGrid
+{
+public:
+  TrajectoryPointGrid(
+    const autoware_auto_planning_msgs::msg::Trajectory & traj, const double cell_size);
+
+  // indices in ascending order of the points in the cells within dist of the position
+  std::vector<size_t> getPointsAround(
+    const geometry_msgs::msg::Point & position, const double dist) const;
+
+private:
+  int64_t toCell(const double coordinate) const;
+  static int64_t toKey(const int64_t cell_x, const int64_t cell_y);
+
+  double cell_size_;
+  std::unordered_map<int64_t, std::vector<size_t>> cells_;
+};
+
 boost::optional<size_t> getFirstCollisionIndex(
   const std::vector<Polygon2d> & traj_polygons, const Polygon2d & obj_polygon,
   const std_msgs::msg::Header & obj_header,
@@ -51,7 +75,8 @@ boost::optional<size_t> willCollideWithSurroundObstacle(
   const autoware_auto_perception_msgs::msg::Shape & shape, const double max_dist,
   const double ego_obstacle_overlap_time_threshold,
   const double max_prediction_time_for_collision_check,
-  std::vector<geometry_msgs::msg::PointStamped> & collision_geom_points);
+  std::vector<geometry_msgs::msg::PointStamped> & collision_geom_points,
+  const TrajectoryPointGrid * traj_point_grid = nullptr);
 
 std::vector<Polygon2d> createOneStepPolygons(
   const autoware_auto_planning_msgs::msg::Trajectory & traj,
@@ -643,6 +643,12 @@ std::vector<TargetObstacle> ObstacleCruisePlannerNode::filterObstacles(
     decimated_traj, vehicle_info_, obstacle_filtering_param_.detection_area_expand_width);
   debug_data.detection_polygons = decimated_traj_polygons;
 
+  // the predicted paths are checked against the trajectory points near each of their poses
+  const double max_dist_to_traj =
+    vehicle_info_.vehicle_width_m + obstacle_filtering_param_.rough_detection_area_expand_width;
+  const polygon_utils::TrajectoryPointGrid decimated_traj_point_grid(
+    decimated_traj, max_dist_to_traj);
+
   std::vector<TargetObstacle> target_obstacles;
   for (const auto & predicted_object : predicted_objects.objects) {
     const auto object_id = toHexString(predicted_object.object_id).substr(0, 4);
@@ -764,10 +770,10 @@ std::vector<TargetObstacle> ObstacleCruisePlannerNode::filterObstacles(
       std::vector<geometry_msgs::msg::PointStamped> future_collision_points;
       const auto collision_traj_poly_idx = polygon_utils::willCollideWithSurroundObstacle(
         decimated_traj, decimated_traj_polygons, predicted_objects.header, resampled_predicted_path,
-        predicted_object.shape,
-        vehicle_info_.vehicle_width_m + obstacle_filtering_param_.rough_detection_area_expand_width,
+        predicted_object.shape, max_dist_to_traj,
         obstacle_filtering_param_.ego_obstacle_overlap_time_threshold,
-        obstacle_filtering_param_.max_prediction_time_for_collision_check, future_collision_points);
+        obstacle_filtering_param_.max_prediction_time_for_collision_check, future_collision_points,
+        &decimated_traj_point_grid);
 
       if (!collision_traj_poly_idx) {
         // Ignore vehicle obstacles outside the trajectory, whose predicted path
@@ -30,6 +30,9 @@
 
 #include <tf2/utils.h>
 
+#include <algorithm>
+#include <iterator>
+
 constexpr double ZERO_VEL_THRESHOLD = 0.01;
 constexpr double CLOSE_S_DIST_THRESHOLD = 1e-3;
 
@@ -95,11 +98,13 @@ OptimizationBasedPlanner::OptimizationBasedPlanner(
     node.declare_parameter<double>("optimization_based_planner.over_a_weight");
   const double over_j_weight =
     node.declare_parameter<double>("optimization_based_planner.over_j_weight");
+  const bool enable_warm_start =
+    node.declare_parameter<bool>("optimization_based_planner.enable_warm_start");
 
   // velocity optimizer
   velocity_optimizer_ptr_ = std::make_shared<VelocityOptimizer>(
     max_s_weight, max_v_weight, over_s_safety_weight, over_s_ideal_weight, over_v_weight,
-    over_a_weight, over_j_weight);
+    over_a_weight, over_j_weight, enable_warm_start);
 
   // publisher
   optimized_sv_pub_ = node.create_publisher<Trajectory>("~/optimized_sv_trajectory", 1);
@@ -619,12 +624,13 @@ boost::optional<SBoundaries> OptimizationBasedPlanner::getSBoundariesForOffTraje
     const double s_upper_bound =
       current_s_obj + (v_obj * v_obj) / (2 * std::fabs(min_object_accel_for_rss));
 
+    // the segment is searched in the sorted time vector instead of scanning it
     size_t object_time_segment_idx = 0;
-    for (size_t i = 0; i < time_vec.size() - 1; ++i) {
-      if (time_vec.at(i) < object_time && object_time < time_vec.at(i + 1)) {
-        object_time_segment_idx = i;
-        break;
-      }
+    const auto next_time_itr = std::upper_bound(time_vec.begin(), time_vec.end(), object_time);
+    if (
+      next_time_itr != time_vec.begin() && next_time_itr != time_vec.end() &&
+      *std::prev(next_time_itr) < object_time) {
+      object_time_segment_idx = std::distance(time_vec.begin(), next_time_itr) - 1;
     }
 
     for (size_t i = 0; i <= object_time_segment_idx + 1; ++i) {
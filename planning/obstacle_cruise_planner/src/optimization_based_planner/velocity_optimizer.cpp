@@ -15,20 +15,22 @@
 #include "obstacle_cruise_planner/optimization_based_planner/velocity_optimizer.hpp"
 
 #include <eigen3/Eigen/Core>
+#include <eigen3/Eigen/SparseCore>
 
 #include <iostream>
 
 VelocityOptimizer::VelocityOptimizer(
   const double max_s_weight, const double max_v_weight, const double over_s_safety_weight,
   const double over_s_ideal_weight, const double over_v_weight, const double over_a_weight,
-  const double over_j_weight)
+  const double over_j_weight, const bool enable_warm_start)
 : max_s_weight_(max_s_weight),
   max_v_weight_(max_v_weight),
   over_s_safety_weight_(over_s_safety_weight),
   over_s_ideal_weight_(over_s_ideal_weight),
   over_v_weight_(over_v_weight),
   over_a_weight_(over_a_weight),
-  over_j_weight_(over_j_weight)
+  over_j_weight_(over_j_weight),
+  enable_warm_start_(enable_warm_start)
 {
   qp_solver_.updateMaxIter(200000);
   qp_solver_.updateRhoInterval(0);  // 0 means automatic
@@ -72,13 +74,14 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
   const int l_variables = 9 * N;
   const int l_constraints = 7 * N + 3 * (N - 1) + 3;
 
-  // the matrix size depends on constraint numbers.
-  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(l_constraints, l_variables);
+  // The matrices are built from triplets, where the terms of the objects are set even when they
+  // are zero, so that the sparsity pattern only depends on N and the QP can be updated in place.
+  std::vector<Eigen::Triplet<double>> A_triplets;
   std::vector<double> lower_bound(l_constraints, 0.0);
   std::vector<double> upper_bound(l_constraints, 0.0);
 
   // Object Variables
-  Eigen::MatrixXd P = Eigen::MatrixXd::Zero(l_variables, l_variables);
+  std::vector<Eigen::Triplet<double>> P_triplets;
   std::vector<double> q(l_variables, 0.0);
 
   // Object Function
@@ -105,24 +108,24 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
     const double dt =
       i < N - 1 ? time_vec.at(i + 1) - time_vec.at(i) : time_vec.at(N - 1) - time_vec.at(N - 2);
     const double max_s = std::max(s_boundary.at(i).max_s, MINIMUM_MAX_S_BOUND);
-    P(IDX_OVER_S_SAFETY0 + i, IDX_OVER_S_SAFETY0 + i) +=
-      over_s_safety_weight_ / (max_s * max_s) * dt;
-    P(IDX_OVER_S_IDEAL0 + i, IDX_OVER_S_IDEAL0 + i) += over_s_ideal_weight_ / (max_s * max_s) * dt;
-    P(IDX_OVER_V0 + i, IDX_OVER_V0 + i) += over_v_weight_ / (v_max * v_max) * dt;
-    P(IDX_OVER_A0 + i, IDX_OVER_A0 + i) += over_a_weight_ / a_range * dt;
-    P(IDX_OVER_J0 + i, IDX_OVER_J0 + i) += over_j_weight_ / j_range * dt;
-
-    if (s_boundary.at(i).is_object) {
-      const double v_coeff = v0 / (2 * std::fabs(a_min)) + t_idling;
-      P(IDX_S0 + i, IDX_S0 + i) += max_s_weight_ / (max_s * max_s) * dt;
-      P(IDX_V0 + i, IDX_V0 + i) += max_s_weight_ / (max_s * max_s) * v_coeff * v_coeff * dt;
-      P(IDX_S0 + i, IDX_V0 + i) += max_s_weight_ / (max_s * max_s) * v_coeff * dt;
-      P(IDX_V0 + i, IDX_S0 + i) += max_s_weight_ / (max_s * max_s) * v_coeff * dt;
-    } else {
-      P(IDX_S0 + i, IDX_S0 + i) += max_s_weight_ / (max_s * max_s) * dt;
-    }
-
-    P(IDX_V0 + i, IDX_V0 + i) += max_v_weight_ / (v_max * v_max) * dt;
+    const double s_weight = max_s_weight_ / (max_s * max_s) * dt;
+    P_triplets.emplace_back(
+      IDX_OVER_S_SAFETY0 + i, IDX_OVER_S_SAFETY0 + i, over_s_safety_weight_ / (max_s * max_s) * dt);
+    P_triplets.emplace_back(
+      IDX_OVER_S_IDEAL0 + i, IDX_OVER_S_IDEAL0 + i, over_s_ideal_weight_ / (max_s * max_s) * dt);
+    P_triplets.emplace_back(
+      IDX_OVER_V0 + i, IDX_OVER_V0 + i, over_v_weight_ / (v_max * v_max) * dt);
+    P_triplets.emplace_back(IDX_OVER_A0 + i, IDX_OVER_A0 + i, over_a_weight_ / a_range * dt);
+    P_triplets.emplace_back(IDX_OVER_J0 + i, IDX_OVER_J0 + i, over_j_weight_ / j_range * dt);
+
+    // only the upper triangular part is given to OSQP
+    const double v_coeff =
+      s_boundary.at(i).is_object ? v0 / (2 * std::fabs(a_min)) + t_idling : 0.0;
+    P_triplets.emplace_back(IDX_S0 + i, IDX_S0 + i, s_weight);
+    P_triplets.emplace_back(IDX_V0 + i, IDX_V0 + i, s_weight * v_coeff * v_coeff);
+    P_triplets.emplace_back(IDX_S0 + i, IDX_V0 + i, s_weight * v_coeff);
+
+    P_triplets.emplace_back(IDX_V0 + i, IDX_V0 + i, max_v_weight_ / (v_max * v_max) * dt);
   }
 
   // Constraint
@@ -131,12 +134,12 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
   // Safety Position Constraint: s_boundary_min < s_i + v_i*t_dangerous + v0*v_i/(2*|a_min|) -
   // over_s_safety_i < s_boundary_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    const double v_coeff = v0 / (2 * std::fabs(a_min)) + t_dangerous;
-    A(constr_idx, IDX_S0 + i) = 1.0;  // s_i
-    if (s_boundary.at(i).is_object) {
-      A(constr_idx, IDX_V0 + i) = v_coeff;  // v_i * (t_dangerous + v0/(2*|a_min|))
-    }
-    A(constr_idx, IDX_OVER_S_SAFETY0 + i) = -1.0;  // over_s_safety_i
+    const double v_coeff =
+      s_boundary.at(i).is_object ? v0 / (2 * std::fabs(a_min)) + t_dangerous : 0.0;
+    A_triplets.emplace_back(constr_idx, IDX_S0 + i, 1.0);  // s_i
+    A_triplets.emplace_back(
+      constr_idx, IDX_V0 + i, v_coeff);  // v_i * (t_dangerous + v0/(2*|a_min|))
+    A_triplets.emplace_back(constr_idx, IDX_OVER_S_SAFETY0 + i, -1.0);  // over_s_safety_i
     upper_bound.at(constr_idx) = s_boundary.at(i).max_s;
     lower_bound.at(constr_idx) = 0.0;
   }
@@ -144,50 +147,49 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
   // Ideal Position Constraint: s_boundary_min < s_i  + v_i * t_idling + v0*v_i/(2*|a_min|) -
   // over_s_ideal_i < s_boundary_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    const double v_coeff = v0 / (2 * std::fabs(a_min)) + t_idling;
-    A(constr_idx, IDX_S0 + i) = 1.0;  // s_i
-    if (s_boundary.at(i).is_object) {
-      A(constr_idx, IDX_V0 + i) = v_coeff;  // v_i * (t_idling + v0/(2*|a_min|))
-    }
-    A(constr_idx, IDX_OVER_S_IDEAL0 + i) = -1.0;  // over_s_ideal_i
+    const double v_coeff =
+      s_boundary.at(i).is_object ? v0 / (2 * std::fabs(a_min)) + t_idling : 0.0;
+    A_triplets.emplace_back(constr_idx, IDX_S0 + i, 1.0);      // s_i
+    A_triplets.emplace_back(constr_idx, IDX_V0 + i, v_coeff);  // v_i * (t_idling + v0/(2*|a_min|))
+    A_triplets.emplace_back(constr_idx, IDX_OVER_S_IDEAL0 + i, -1.0);  // over_s_ideal_i
     upper_bound.at(constr_idx) = s_boundary.at(i).max_s;
     lower_bound.at(constr_idx) = 0.0;
   }
 
   // Soft Velocity Constraint: 0 < v_i - over_v_i < v_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_V0 + i) = 1.0;        // v_i
-    A(constr_idx, IDX_OVER_V0 + i) = -1.0;  // over_v_i
+    A_triplets.emplace_back(constr_idx, IDX_V0 + i, 1.0);        // v_i
+    A_triplets.emplace_back(constr_idx, IDX_OVER_V0 + i, -1.0);  // over_v_i
     upper_bound.at(constr_idx) = i == N - 1 ? 0.0 : v_max;
     lower_bound.at(constr_idx) = 0.0;
   }
 
   // Soft Acceleration Constraint: a_min < a_i - over_a_i < a_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_A0 + i) = 1.0;        // a_i
-    A(constr_idx, IDX_OVER_A0 + i) = -1.0;  // over_a_i
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, 1.0);        // a_i
+    A_triplets.emplace_back(constr_idx, IDX_OVER_A0 + i, -1.0);  // over_a_i
     upper_bound.at(constr_idx) = i == N - 1 ? 0.0 : a_max;
     lower_bound.at(constr_idx) = i == N - 1 ? 0.0 : a_min;
   }
 
   // Hard Acceleration Constraint: limit_a_min < a_i < a_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_A0 + i) = 1.0;  // a_i
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, 1.0);  // a_i
     upper_bound.at(constr_idx) = limit_a_max;
     lower_bound.at(constr_idx) = limit_a_min;
   }
 
   // Soft Jerk Constraint: j_min < j_i - over_j_i < j_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_J0 + i) = 1.0;        // j_i
-    A(constr_idx, IDX_OVER_J0 + i) = -1.0;  // over_j_i
+    A_triplets.emplace_back(constr_idx, IDX_J0 + i, 1.0);        // j_i
+    A_triplets.emplace_back(constr_idx, IDX_OVER_J0 + i, -1.0);  // over_j_i
     upper_bound.at(constr_idx) = i == N - 1 ? 0.0 : j_max;
     lower_bound.at(constr_idx) = i == N - 1 ? 0.0 : j_min;
   }
 
   // Hard Jerk Constraint: limit_j_min < j_i < limit_j_max
   for (size_t i = 0; i < N; ++i, ++constr_idx) {
-    A(constr_idx, IDX_J0 + i) = 1.0;  // j_i
+    A_triplets.emplace_back(constr_idx, IDX_J0 + i, 1.0);  // j_i
     upper_bound.at(constr_idx) = limit_j_max;
     lower_bound.at(constr_idx) = limit_j_min;
   }
@@ -196,11 +198,12 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
   // s_i+1 = s_i + v_i * dt + 0.5 * a_i * dt^2 + 1/6 * j_i * dt^3
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
     const double dt = time_vec.at(i + 1) - time_vec.at(i);
-    A(constr_idx, IDX_S0 + i + 1) = 1.0;                    // s_i+1
-    A(constr_idx, IDX_S0 + i) = -1.0;                       // -s_i
-    A(constr_idx, IDX_V0 + i) = -dt;                        // -v_i*dt
-    A(constr_idx, IDX_A0 + i) = -0.5 * dt * dt;             // -0.5 * a_i * dt^2
-    A(constr_idx, IDX_J0 + i) = -1.0 / 6.0 * dt * dt * dt;  // -1.0/6.0 * j_i * dt^3
+    A_triplets.emplace_back(constr_idx, IDX_S0 + i + 1, 1.0);         // s_i+1
+    A_triplets.emplace_back(constr_idx, IDX_S0 + i, -1.0);            // -s_i
+    A_triplets.emplace_back(constr_idx, IDX_V0 + i, -dt);             // -v_i*dt
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, -0.5 * dt * dt);  // -0.5 * a_i * dt^2
+    A_triplets.emplace_back(
+      constr_idx, IDX_J0 + i, -1.0 / 6.0 * dt * dt * dt);  // -1.0/6.0 * j_i * dt^3
     upper_bound.at(constr_idx) = 0.0;
     lower_bound.at(constr_idx) = 0.0;
   }
@@ -208,10 +211,10 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
   // v_i+1 = v_i + a_i * dt + 0.5 * j_i * dt^2
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
     const double dt = time_vec.at(i + 1) - time_vec.at(i);
-    A(constr_idx, IDX_V0 + i + 1) = 1.0;         // v_i+1
-    A(constr_idx, IDX_V0 + i) = -1.0;            // -v_i
-    A(constr_idx, IDX_A0 + i) = -dt;             // -a_i * dt
-    A(constr_idx, IDX_J0 + i) = -0.5 * dt * dt;  // -0.5 * j_i * dt^2
+    A_triplets.emplace_back(constr_idx, IDX_V0 + i + 1, 1.0);         // v_i+1
+    A_triplets.emplace_back(constr_idx, IDX_V0 + i, -1.0);            // -v_i
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, -dt);             // -a_i * dt
+    A_triplets.emplace_back(constr_idx, IDX_J0 + i, -0.5 * dt * dt);  // -0.5 * j_i * dt^2
     upper_bound.at(constr_idx) = 0.0;
     lower_bound.at(constr_idx) = 0.0;
   }
@@ -219,32 +222,50 @@ VelocityOptimizer::OptimizationResult VelocityOptimizer::optimize(const Optimiza
   // a_i+1 = a_i + j_i * dt
   for (size_t i = 0; i < N - 1; ++i, ++constr_idx) {
     const double dt = time_vec.at(i + 1) - time_vec.at(i);
-    A(constr_idx, IDX_A0 + i + 1) = 1.0;  // a_i+1
-    A(constr_idx, IDX_A0 + i) = -1.0;     // -a_i
-    A(constr_idx, IDX_J0 + i) = -dt;      // -j_i * dt
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i + 1, 1.0);  // a_i+1
+    A_triplets.emplace_back(constr_idx, IDX_A0 + i, -1.0);     // -a_i
+    A_triplets.emplace_back(constr_idx, IDX_J0 + i, -dt);      // -j_i * dt
     upper_bound.at(constr_idx) = 0.0;
     lower_bound.at(constr_idx) = 0.0;
   }
 
   // initial condition
   {
-    A(constr_idx, IDX_S0) = 1.0;  // s0
+    A_triplets.emplace_back(constr_idx, IDX_S0, 1.0);  // s0
     upper_bound[constr_idx] = s0;
     lower_bound[constr_idx] = s0;
     ++constr_idx;
 
-    A(constr_idx, IDX_V0) = 1.0;  // v0
+    A_triplets.emplace_back(constr_idx, IDX_V0, 1.0);  // v0
     upper_bound[constr_idx] = v0;
     lower_bound[constr_idx] = v0;
     ++constr_idx;
 
-    A(constr_idx, IDX_A0) = 1.0;  // a0
+    A_triplets.emplace_back(constr_idx, IDX_A0, 1.0);  // a0
     upper_bound[constr_idx] = a0;
     lower_bound[constr_idx] = a0;
   }
 
+  Eigen::SparseMatrix<double> P(l_variables, l_variables);
+  P.setFromTriplets(P_triplets.begin(), P_triplets.end());
+  Eigen::SparseMatrix<double> A(l_constraints, l_variables);
+  A.setFromTriplets(A_triplets.begin(), A_triplets.end());
+
   // execute optimization
-  const auto result = qp_solver_.optimize(P, A, q, lower_bound, upper_bound);
+  if (enable_warm_start_) {
+    // the QP of the previous cycle is updated, and starts from its solution
+    qp_solver_.updateProblem(
+      autoware::common::osqp::calCSCMatrix(P), autoware::common::osqp::calCSCMatrix(A), q,
+      lower_bound, upper_bound);
+  } else {
+    // the zero terms are removed, as the dense matrices were converted before
+    P.prune([](const auto &, const auto &, const double value) { return value != 0.0; });
+    A.prune([](const auto &, const auto &, const double value) { return value != 0.0; });
+    qp_solver_.initializeProblem(
+      autoware::common::osqp::calCSCMatrix(P), autoware::common::osqp::calCSCMatrix(A), q,
+      lower_bound, upper_bound);
+  }
+  const auto result = qp_solver_.optimize();
   const std::vector<double> optval = std::get<0>(result);
 
   const int status_val = std::get<3>(result);
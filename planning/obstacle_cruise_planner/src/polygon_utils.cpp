@@ -16,6 +16,10 @@
 
 #include "tier4_autoware_utils/geometry/boost_polygon_utils.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
 namespace
 {
 namespace bg = boost::geometry;
@@ -86,6 +90,42 @@ Polygon2d createOneStepPolygon(
 
 namespace polygon_utils
 {
+TrajectoryPointGrid::TrajectoryPointGrid(
+  const autoware_auto_planning_msgs::msg::Trajectory & traj, const double cell_size)
+: cell_size_(std::max(cell_size, 1e-3))
+{
+  for (size_t i = 0; i < traj.points.size(); ++i) {
+    const auto & position = traj.points.at(i).pose.position;
+    cells_[toKey(toCell(position.x), toCell(position.y))].push_back(i);
+  }
+}
+
+std::vector<size_t> TrajectoryPointGrid::getPointsAround(
+  const geometry_msgs::msg::Point & position, const double dist) const
+{
+  std::vector<size_t> indices;
+  for (int64_t x = toCell(position.x - dist); x <= toCell(position.x + dist); ++x) {
+    for (int64_t y = toCell(position.y - dist); y <= toCell(position.y + dist); ++y) {
+      const auto itr = cells_.find(toKey(x, y));
+      if (itr != cells_.end()) {
+        indices.insert(indices.end(), itr->second.begin(), itr->second.end());
+      }
+    }
+  }
+  std::sort(indices.begin(), indices.end());
+  return indices;
+}
+
+int64_t TrajectoryPointGrid::toCell(const double coordinate) const
+{
+  return static_cast<int64_t>(std::floor(coordinate / cell_size_));
+}
+
+int64_t TrajectoryPointGrid::toKey(const int64_t cell_x, const int64_t cell_y)
+{
+  return (cell_x << 32) ^ (cell_y & 0xffffffff);
+}
+
 boost::optional<size_t> getFirstCollisionIndex(
   const std::vector<Polygon2d> & traj_polygons, const Polygon2d & obj_polygon,
   const std_msgs::msg::Header & obj_header,
@@ -149,12 +189,14 @@ boost::optional<size_t> willCollideWithSurroundObstacle(
   const autoware_auto_perception_msgs::msg::Shape & shape, const double max_dist,
   const double ego_obstacle_overlap_time_threshold,
   const double max_prediction_time_for_collision_check,
-  std::vector<geometry_msgs::msg::PointStamped> & collision_geom_points)
+  std::vector<geometry_msgs::msg::PointStamped> & collision_geom_points,
+  const TrajectoryPointGrid * traj_point_grid)
 {
   constexpr double epsilon = 1e-3;
 
   bool is_found = false;
   size_t start_predicted_path_idx = 0;
+  std::vector<size_t> traj_indices;
   for (size_t i = 0; i < predicted_path.path.size(); ++i) {
     const auto & path_point = predicted_path.path.at(i);
     if (
@@ -163,7 +205,16 @@ boost::optional<size_t> willCollideWithSurroundObstacle(
       return {};
     }
 
-    for (size_t j = 0; j < traj.points.size(); ++j) {
+    // the points far from the object are skipped below, so that only the ones near it are visited
+    if (traj_point_grid) {
+      traj_indices = traj_point_grid->getPointsAround(path_point.position, max_dist);
+    } else {
+      traj_indices.resize(traj.points.size());
+      std::iota(traj_indices.begin(), traj_indices.end(), 0);
+    }
+
+    boost::optional<Polygon2d> obj_polygon_opt;
+    for (const size_t j : traj_indices) {
       const auto & traj_point = traj.points.at(j);
       const double approximated_dist =
         tier4_autoware_utils::calcDistance2d(path_point.position, traj_point.pose.position);
@@ -172,7 +223,10 @@ boost::optional<size_t> willCollideWithSurroundObstacle(
       }
 
       const auto & traj_polygon = traj_polygons.at(j);
-      const auto obj_polygon = tier4_autoware_utils::toPolygon2d(path_point, shape);
+      if (!obj_polygon_opt) {
+        obj_polygon_opt = tier4_autoware_utils::toPolygon2d(path_point, shape);
+      }
+      const auto & obj_polygon = obj_polygon_opt.get();
       const double dist = bg::distance(traj_polygon, obj_polygon);
 
       if (dist < epsilon) {
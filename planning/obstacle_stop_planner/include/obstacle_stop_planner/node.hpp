@@ -17,6 +17,7 @@
 
 #include "obstacle_stop_planner/adaptive_cruise_control.hpp"
 #include "obstacle_stop_planner/debug_marker.hpp"
+#include "obstacle_stop_planner/point_grid.hpp"
 
 #include <motion_utils/trajectory/tmp_conversion.hpp>
 #include <motion_utils/trajectory/trajectory.hpp>
@@ -54,6 +55,7 @@
 #include <tf2_ros/buffer.h>
 #include <tf2_ros/transform_listener.h>
 
+#include <array>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -211,6 +213,12 @@ private:
   //   (current_velocity_ptr_, prev_velocity_ptr_)
   std::mutex mutex_;
 
+  // one step polygons keyed by the x, y and yaw of both steps and the expand width, the ones of
+  // the previous cycle are reused for the steps which did not change
+  using OneStepPolygonKey = std::array<double, 7>;
+  std::map<OneStepPolygonKey, std::vector<cv::Point2d>> one_step_polygons_;
+  std::map<OneStepPolygonKey, std::vector<cv::Point2d>> prev_one_step_polygons_;
+
   /*
    * Callback
    */
@@ -224,7 +232,8 @@ private:
   bool withinPolygon(
     const std::vector<cv::Point2d> & cv_polygon, const double radius, const Point2d & prev_point,
     const Point2d & next_point, pcl::PointCloud<pcl::PointXYZ>::Ptr candidate_points_ptr,
-    pcl::PointCloud<pcl::PointXYZ>::Ptr within_points_ptr);
+    pcl::PointCloud<pcl::PointXYZ>::Ptr within_points_ptr,
+    const PointGrid * candidate_grid = nullptr);
 
   bool convexHull(
     const std::vector<cv::Point2d> & pointcloud, std::vector<cv::Point2d> & polygon_points);
@@ -258,6 +267,11 @@ private:
     const geometry_msgs::msg::Pose & next_step_pose, std::vector<cv::Point2d> & polygon,
     const VehicleInfo & vehicle_info, const double expand_width = 0.0);
 
+  const std::vector<cv::Point2d> & getOneStepPolygon(
+    const geometry_msgs::msg::Pose & base_step_pose,
+    const geometry_msgs::msg::Pose & next_step_pose, const VehicleInfo & vehicle_info,
+    const double expand_width);
+
   bool getSelfPose(
     const std_msgs::msg::Header & header, const tf2_ros::Buffer & tf_buffer,
     geometry_msgs::msg::Pose & self_pose);
@@ -0,0 +1,52 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef OBSTACLE_STOP_PLANNER__POINT_GRID_HPP_
+#define OBSTACLE_STOP_PLANNER__POINT_GRID_HPP_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace motion_planning
+{
+/**
+ * @brief Indices of the points bucketed by the cells of a 2d grid, so that the points near a
+ * position are found without scanning all of them.
+ */
+class PointGrid
+{
+public:
+  PointGrid(const pcl::PointCloud<pcl::PointXYZ> & points, const double cell_size);
+
+  /**
+   * @brief Indices in ascending order of the points in the cells within radius of any of the
+   * centers. The distance of each point has to be checked by the caller.
+   */
+  std::vector<size_t> getPointsAround(
+    const std::vector<std::pair<double, double>> & centers, const double radius) const;
+
+private:
+  int64_t toCell(const double coordinate) const;
+  static int64_t toKey(const int64_t cell_x, const int64_t cell_y);
+
+  double cell_size_;
+  std::unordered_map<int64_t, std::vector<size_t>> cells_;
+};
+}  // namespace motion_planning
+
+#endif  // OBSTACLE_STOP_PLANNER__POINT_GRID_HPP_
@@ -16,6 +16,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <utility>
 #include <vector>
@@ -555,11 +556,8 @@ ObstacleStopPlannerNode::ObstacleStopPlannerNode(const rclcpp::NodeOptions & nod
 void ObstacleStopPlannerNode::obstaclePointcloudCallback(
   const sensor_msgs::msg::PointCloud2::ConstSharedPtr input_msg)
 {
-  // mutex for obstacle_ros_pointcloud_ptr_
-  // NOTE: *obstacle_ros_pointcloud_ptr_ is used
-  std::lock_guard<std::mutex> lock(mutex_);
-
-  obstacle_ros_pointcloud_ptr_ = std::make_shared<sensor_msgs::msg::PointCloud2>();
+  // the cloud is filtered without the lock, so that pathCallback is not blocked meanwhile
+  auto obstacle_ros_pointcloud_ptr = std::make_shared<sensor_msgs::msg::PointCloud2>();
   pcl::VoxelGrid<pcl::PointXYZ> filter;
   pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::PointCloud<pcl::PointXYZ>::Ptr no_height_pointcloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
@@ -574,8 +572,13 @@ void ObstacleStopPlannerNode::obstaclePointcloudCallback(
   filter.setInputCloud(no_height_pointcloud_ptr);
   filter.setLeafSize(0.05f, 0.05f, 100000.0f);
   filter.filter(*no_height_filtered_pointcloud_ptr);
-  pcl::toROSMsg(*no_height_filtered_pointcloud_ptr, *obstacle_ros_pointcloud_ptr_);
-  obstacle_ros_pointcloud_ptr_->header = input_msg->header;
+  pcl::toROSMsg(*no_height_filtered_pointcloud_ptr, *obstacle_ros_pointcloud_ptr);
+  obstacle_ros_pointcloud_ptr->header = input_msg->header;
+
+  // mutex for obstacle_ros_pointcloud_ptr_
+  // NOTE: *obstacle_ros_pointcloud_ptr_ is used
+  std::lock_guard<std::mutex> lock(mutex_);
+  obstacle_ros_pointcloud_ptr_ = obstacle_ros_pointcloud_ptr;
 }
 
 void ObstacleStopPlannerNode::pathCallback(const Trajectory::ConstSharedPtr input_msg)
@@ -686,6 +689,15 @@ void ObstacleStopPlannerNode::searchObstacle(
     return;
   }
 
+  // the points around each step are looked up in the grid instead of scanning all the candidates
+  const double search_radius = node_param_.enable_slow_down
+                                 ? slow_down_param_.slow_down_search_radius
+                                 : stop_param.stop_search_radius;
+  const PointGrid candidate_grid(*obstacle_candidate_pointcloud_ptr, search_radius);
+
+  prev_one_step_polygons_.swap(one_step_polygons_);
+  one_step_polygons_.clear();
+
   for (size_t i = 0; i < decimate_trajectory.size() - 1; ++i) {
     // create one step circle center for vehicle
     const auto & p_front = decimate_trajectory.at(i).pose;
@@ -696,18 +708,16 @@ void ObstacleStopPlannerNode::searchObstacle(
     const Point2d next_center_point(next_center_pose.position.x, next_center_pose.position.y);
 
     if (node_param_.enable_slow_down) {
-      std::vector<cv::Point2d> one_step_move_slow_down_range_polygon;
       // create one step polygon for slow_down range
-      createOneStepPolygon(
-        p_front, p_back, one_step_move_slow_down_range_polygon, vehicle_info,
-        slow_down_param_.expand_slow_down_range);
+      const auto & one_step_move_slow_down_range_polygon = getOneStepPolygon(
+        p_front, p_back, vehicle_info, slow_down_param_.expand_slow_down_range);
       debug_ptr_->pushPolygon(
         one_step_move_slow_down_range_polygon, p_front.position.z, PolygonType::SlowDownRange);
 
       planner_data.found_slow_down_points = withinPolygon(
         one_step_move_slow_down_range_polygon, slow_down_param_.slow_down_search_radius,
         prev_center_point, next_center_point, obstacle_candidate_pointcloud_ptr,
-        slow_down_pointcloud_ptr);
+        slow_down_pointcloud_ptr, &candidate_grid);
 
       const auto found_first_slow_down_points =
         planner_data.found_slow_down_points && !planner_data.slow_down_require;
@@ -735,10 +745,9 @@ void ObstacleStopPlannerNode::searchObstacle(
     }
 
     {
-      std::vector<cv::Point2d> one_step_move_vehicle_polygon;
       // create one step polygon for vehicle
-      createOneStepPolygon(
-        p_front, p_back, one_step_move_vehicle_polygon, vehicle_info, stop_param.expand_stop_range);
+      const auto & one_step_move_vehicle_polygon =
+        getOneStepPolygon(p_front, p_back, vehicle_info, stop_param.expand_stop_range);
       debug_ptr_->pushPolygon(
         one_step_move_vehicle_polygon, decimate_trajectory.at(i).pose.position.z,
         PolygonType::Vehicle);
@@ -747,9 +756,11 @@ void ObstacleStopPlannerNode::searchObstacle(
         new pcl::PointCloud<pcl::PointXYZ>);
       collision_pointcloud_ptr->header = obstacle_candidate_pointcloud_ptr->header;
 
+      // the slow down points are gathered over the steps, so that they are not in the grid
       planner_data.found_collision_points = withinPolygon(
         one_step_move_vehicle_polygon, stop_param.stop_search_radius, prev_center_point,
-        next_center_point, slow_down_pointcloud_ptr, collision_pointcloud_ptr);
+        next_center_point, slow_down_pointcloud_ptr, collision_pointcloud_ptr,
+        node_param_.enable_slow_down ? nullptr : &candidate_grid);
 
       if (planner_data.found_collision_points) {
         planner_data.decimate_trajectory_collision_index = i;
@@ -968,7 +979,7 @@ void ObstacleStopPlannerNode::insertVelocity(
 bool ObstacleStopPlannerNode::withinPolygon(
   const std::vector<cv::Point2d> & cv_polygon, const double radius, const Point2d & prev_point,
   const Point2d & next_point, pcl::PointCloud<pcl::PointXYZ>::Ptr candidate_points_ptr,
-  pcl::PointCloud<pcl::PointXYZ>::Ptr within_points_ptr)
+  pcl::PointCloud<pcl::PointXYZ>::Ptr within_points_ptr, const PointGrid * candidate_grid)
 {
   Polygon2d boost_polygon;
   bool find_within_points = false;
@@ -977,7 +988,16 @@ bool ObstacleStopPlannerNode::withinPolygon(
   }
   boost_polygon.outer().push_back(bg::make<Point2d>(cv_polygon.front().x, cv_polygon.front().y));
 
-  for (size_t j = 0; j < candidate_points_ptr->size(); ++j) {
+  std::vector<size_t> candidate_indices;
+  if (candidate_grid) {
+    candidate_indices = candidate_grid->getPointsAround(
+      {{prev_point.x(), prev_point.y()}, {next_point.x(), next_point.y()}}, radius);
+  } else {
+    candidate_indices.resize(candidate_points_ptr->size());
+    std::iota(candidate_indices.begin(), candidate_indices.end(), 0);
+  }
+
+  for (const size_t j : candidate_indices) {
     Point2d point(candidate_points_ptr->at(j).x, candidate_points_ptr->at(j).y);
     if (bg::distance(prev_point, point) < radius || bg::distance(next_point, point) < radius) {
       if (bg::within(point, boost_polygon)) {
@@ -1392,14 +1412,21 @@ bool ObstacleStopPlannerNode::searchPointcloudNearTrajectory(
                                  ? slow_down_param_.slow_down_search_radius
                                  : stop_param.stop_search_radius;
   const double squared_radius = search_radius * search_radius;
+  // each point is taken once, in the order it is first found near the trajectory
+  const PointGrid point_grid(*transformed_points_ptr, search_radius);
+  std::vector<bool> is_taken(transformed_points_ptr->size(), false);
   for (const auto & trajectory_point : trajectory) {
     const auto center_pose = getVehicleCenterFromBase(trajectory_point.pose, vehicle_info);
-    for (const auto & point : transformed_points_ptr->points) {
+    const auto indices = point_grid.getPointsAround(
+      {{center_pose.position.x, center_pose.position.y}}, search_radius);
+    for (const size_t index : indices) {
+      const auto & point = transformed_points_ptr->points.at(index);
       const double x = center_pose.position.x - point.x;
       const double y = center_pose.position.y - point.y;
       const double squared_distance = x * x + y * y;
-      if (squared_distance < squared_radius) {
+      if (!is_taken.at(index) && squared_distance < squared_radius) {
         output_points_ptr->points.push_back(point);
+        is_taken.at(index) = true;
       }
     }
   }
@@ -1451,6 +1478,30 @@ void ObstacleStopPlannerNode::createOneStepPolygon(
   convexHull(one_step_move_vehicle_corner_points, polygon);
 }
 
+const std::vector<cv::Point2d> & ObstacleStopPlannerNode::getOneStepPolygon(
+  const geometry_msgs::msg::Pose & base_step_pose, const geometry_msgs::msg::Pose & next_step_pose,
+  const VehicleInfo & vehicle_info, const double expand_width)
+{
+  const OneStepPolygonKey key{
+    base_step_pose.position.x, base_step_pose.position.y, getRPY(base_step_pose).z,
+    next_step_pose.position.x, next_step_pose.position.y, getRPY(next_step_pose).z,
+    expand_width};
+
+  const auto itr = one_step_polygons_.find(key);
+  if (itr != one_step_polygons_.end()) {
+    return itr->second;
+  }
+
+  auto & polygon = one_step_polygons_[key];
+  const auto prev_itr = prev_one_step_polygons_.find(key);
+  if (prev_itr != prev_one_step_polygons_.end()) {
+    polygon.swap(prev_itr->second);
+  } else {
+    createOneStepPolygon(base_step_pose, next_step_pose, polygon, vehicle_info, expand_width);
+  }
+  return polygon;
+}
+
 bool ObstacleStopPlannerNode::convexHull(
   const std::vector<cv::Point2d> & pointcloud, std::vector<cv::Point2d> & polygon_points)
 {
@@ -0,0 +1,62 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "obstacle_stop_planner/point_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace motion_planning
+{
+PointGrid::PointGrid(const pcl::PointCloud<pcl::PointXYZ> & points, const double cell_size)
+: cell_size_(std::max(cell_size, 1e-3))
+{
+  for (size_t i = 0; i < points.size(); ++i) {
+    cells_[toKey(toCell(points.at(i).x), toCell(points.at(i).y))].push_back(i);
+  }
+}
+
+std::vector<size_t> PointGrid::getPointsAround(
+  const std::vector<std::pair<double, double>> & centers, const double radius) const
+{
+  std::vector<size_t> indices;
+  for (const auto & center : centers) {
+    for (int64_t x = toCell(center.first - radius); x <= toCell(center.first + radius); ++x) {
+      for (int64_t y = toCell(center.second - radius); y <= toCell(center.second + radius); ++y) {
+        const auto itr = cells_.find(toKey(x, y));
+        if (itr != cells_.end()) {
+          indices.insert(indices.end(), itr->second.begin(), itr->second.end());
+        }
+      }
+    }
+  }
+
+  std::sort(indices.begin(), indices.end());
+  indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+  return indices;
+}
+
+int64_t PointGrid::toCell(const double coordinate) const
+{
+  return static_cast<int64_t>(std::floor(coordinate / cell_size_));
+}
+
+int64_t PointGrid::toKey(const int64_t cell_x, const int64_t cell_y)
+{
+  // the cells are within +-2^31 of the origin for any sensible cell size
+  return (cell_x << 32) ^ (cell_y & 0xffffffff);
+}
+}  // namespace motion_planning
@@ -32,6 +32,26 @@ using autoware_auto_planning_msgs::msg::TrajectoryPoint;
 using diagnostic_updater::DiagnosticStatusWrapper;
 using diagnostic_updater::Updater;
 
+/**
+ * @brief results of the checks of a trajectory
+ */
+struct TrajectoryValidation
+{
+  bool is_point_value_valid{true};
+  bool is_interval_valid{true};
+  bool is_curvature_valid{true};
+  bool is_relative_angle_valid{true};
+
+  bool operator==(const TrajectoryValidation & other) const
+  {
+    return is_point_value_valid == other.is_point_value_valid &&
+           is_interval_valid == other.is_interval_valid &&
+           is_curvature_valid == other.is_curvature_valid &&
+           is_relative_angle_valid == other.is_relative_angle_valid;
+  }
+  bool operator!=(const TrajectoryValidation & other) const { return !(*this == other); }
+};
+
 class PlanningErrorMonitorNode : public rclcpp::Node
 {
 public:
@@ -56,8 +76,29 @@ public:
     const Trajectory & traj, const double & curvature_threshold, std::string & error_msg,
     PlanningErrorMonitorDebugNode & debug_marker);
 
+  /**
+   * @brief run all the checks above in a single traversal of the trajectory, which stops at the
+   * first point with an invalid value since the other checks are meaningless from there
+   */
+  static TrajectoryValidation validateTrajectory(
+    const Trajectory & traj, const double interval_threshold, const double curvature_threshold,
+    const double relative_angle_threshold, const double min_dist_threshold,
+    PlanningErrorMonitorDebugNode & debug_marker);
+
 private:
   static bool checkFinite(const TrajectoryPoint & p);
+  // checks of the interval ending at the point of id, of the relative angle and of the curvature
+  // at the point of p1_id, which push the debug markers of the points if they are invalid
+  static bool checkIntervalAt(
+    const Trajectory & traj, const size_t id, const double interval_threshold,
+    PlanningErrorMonitorDebugNode & debug_marker);
+  static bool checkRelativeAngleAt(
+    const Trajectory & traj, const size_t p1_id, const double angle_threshold,
+    const double min_dist_threshold, PlanningErrorMonitorDebugNode & debug_marker);
+  // is_end is set when there are no points far enough from the point of p1_id left
+  static bool checkCurvatureAt(
+    const Trajectory & traj, const size_t p1_id, const double curvature_threshold,
+    PlanningErrorMonitorDebugNode & debug_marker, bool & is_end);
   static size_t getIndexAfterDistance(
     const Trajectory & traj, const size_t curr_id, const double distance);
 
@@ -67,12 +108,15 @@ private:
   Updater updater_{this};
 
   Trajectory::ConstSharedPtr current_trajectory_;
+  // validated once when the trajectory is received instead of on every diagnostics update
+  TrajectoryValidation current_validation_;
 
   // Parameter
   double error_interval_;
   double error_curvature_;
   double error_sharp_angle_;
   double ignore_too_close_points_;
+  bool publish_on_change_only_;
 
   PlanningErrorMonitorDebugNode debug_marker_;
 };
@@ -26,6 +26,22 @@ using diagnostic_msgs::msg::DiagnosticStatus;
 using tier4_autoware_utils::calcCurvature;
 using tier4_autoware_utils::calcDistance2d;
 
+namespace
+{
+constexpr char msg_valid_point_value[] = "This Trajectory doesn't have any invalid values";
+constexpr char msg_invalid_point_value[] = "This trajectory has an infinite value";
+constexpr char msg_valid_interval[] = "Trajectory Interval Length is within the expected range";
+constexpr char msg_invalid_interval[] =
+  "Trajectory Interval Length is longer than the expected range";
+constexpr char msg_valid_curvature[] = "This trajectory's curvature is within the expected range";
+constexpr char msg_invalid_curvature[] =
+  "This Trajectory's curvature has larger value than the expected value";
+constexpr char msg_valid_relative_angle[] =
+  "This trajectory's relative angle is within the expected range";
+constexpr char msg_invalid_relative_angle[] =
+  "This Trajectory's relative angle has larger value than the expected value";
+}  // namespace
+
 PlanningErrorMonitorNode::PlanningErrorMonitorNode(const rclcpp::NodeOptions & node_options)
 : Node("planning_error_monitor", node_options)
 {
@@ -58,17 +74,30 @@ PlanningErrorMonitorNode::PlanningErrorMonitorNode(const rclcpp::NodeOptions & n
   error_curvature_ = declare_parameter("error_curvature", 1.0);
   error_sharp_angle_ = declare_parameter("error_sharp_angle", M_PI_4);
   ignore_too_close_points_ = declare_parameter("ignore_too_close_points", 0.05);
+  publish_on_change_only_ = declare_parameter("publish_on_change_only", false);
 }
 
 void PlanningErrorMonitorNode::onTimer()
 {
-  updater_.force_update();
+  if (!publish_on_change_only_) {
+    updater_.force_update();
+  }
   debug_marker_.publish();
 }
 
 void PlanningErrorMonitorNode::onCurrentTrajectory(const Trajectory::ConstSharedPtr msg)
 {
+  const bool has_trajectory = static_cast<bool>(current_trajectory_);
   current_trajectory_ = msg;
+
+  const auto validation = validateTrajectory(
+    *msg, error_interval_, error_curvature_, error_sharp_angle_, ignore_too_close_points_,
+    debug_marker_);
+  const bool is_changed = !has_trajectory || validation != current_validation_;
+  current_validation_ = validation;
+  if (is_changed) {
+    updater_.force_update();
+  }
 }
 
 void PlanningErrorMonitorNode::onTrajectoryPointValueChecker(DiagnosticStatusWrapper & stat)
@@ -78,11 +107,11 @@ void PlanningErrorMonitorNode::onTrajectoryPointValueChecker(DiagnosticStatusWra
     return;
   }
 
-  std::string error_msg;
-  const auto diag_level = checkTrajectoryPointValue(*current_trajectory_, error_msg)
-                            ? DiagnosticStatus::OK
-                            : DiagnosticStatus::ERROR;
-  stat.summary(diag_level, error_msg);
+  if (current_validation_.is_point_value_valid) {
+    stat.summary(DiagnosticStatus::OK, msg_valid_point_value);
+  } else {
+    stat.summary(DiagnosticStatus::ERROR, msg_invalid_point_value);
+  }
 }
 
 void PlanningErrorMonitorNode::onTrajectoryIntervalChecker(DiagnosticStatusWrapper & stat)
@@ -92,12 +121,11 @@ void PlanningErrorMonitorNode::onTrajectoryIntervalChecker(DiagnosticStatusWrapp
     return;
   }
 
-  std::string error_msg;
-  const auto diag_level =
-    checkTrajectoryInterval(*current_trajectory_, error_interval_, error_msg, debug_marker_)
-      ? DiagnosticStatus::OK
-      : DiagnosticStatus::ERROR;
-  stat.summary(diag_level, error_msg);
+  if (current_validation_.is_interval_valid) {
+    stat.summary(DiagnosticStatus::OK, msg_valid_interval);
+  } else {
+    stat.summary(DiagnosticStatus::ERROR, msg_invalid_interval);
+  }
 }
 
 void PlanningErrorMonitorNode::onTrajectoryCurvatureChecker(DiagnosticStatusWrapper & stat)
@@ -107,12 +135,11 @@ void PlanningErrorMonitorNode::onTrajectoryCurvatureChecker(DiagnosticStatusWrap
     return;
   }
 
-  std::string error_msg;
-  const auto diag_level =
-    checkTrajectoryCurvature(*current_trajectory_, error_curvature_, error_msg, debug_marker_)
-      ? DiagnosticStatus::OK
-      : DiagnosticStatus::ERROR;
-  stat.summary(diag_level, error_msg);
+  if (current_validation_.is_curvature_valid) {
+    stat.summary(DiagnosticStatus::OK, msg_valid_curvature);
+  } else {
+    stat.summary(DiagnosticStatus::ERROR, msg_invalid_curvature);
+  }
 }
 
 void PlanningErrorMonitorNode::onTrajectoryRelativeAngleChecker(DiagnosticStatusWrapper & stat)
@@ -122,22 +149,53 @@ void PlanningErrorMonitorNode::onTrajectoryRelativeAngleChecker(DiagnosticStatus
     return;
   }
 
-  std::string error_msg;
-  const auto diag_level =
-    checkTrajectoryRelativeAngle(
-      *current_trajectory_, error_sharp_angle_, ignore_too_close_points_, error_msg, debug_marker_)
-      ? DiagnosticStatus::OK
-      : DiagnosticStatus::ERROR;
-  stat.summary(diag_level, error_msg);
+  if (current_validation_.is_relative_angle_valid) {
+    stat.summary(DiagnosticStatus::OK, msg_valid_relative_angle);
+  } else {
+    stat.summary(DiagnosticStatus::ERROR, msg_invalid_relative_angle);
+  }
+}
+
+TrajectoryValidation PlanningErrorMonitorNode::validateTrajectory(
+  const Trajectory & traj, const double interval_threshold, const double curvature_threshold,
+  const double relative_angle_threshold, const double min_dist_threshold,
+  PlanningErrorMonitorDebugNode & debug_marker)
+{
+  TrajectoryValidation validation;
+  debug_marker.clearPoseMarker("trajectory_interval");
+  debug_marker.clearPoseMarker("trajectory_curvature");
+  debug_marker.clearPoseMarker("trajectory_relative_angle");
+
+  // each check stops at its first error, as the separate checks do
+  bool is_curvature_end = traj.points.size() < 3;
+  for (size_t i = 0; i < traj.points.size(); ++i) {
+    if (!checkFinite(traj.points.at(i))) {
+      validation.is_point_value_valid = false;
+      break;
+    }
+    if (i >= 1 && validation.is_interval_valid) {
+      validation.is_interval_valid = checkIntervalAt(traj, i, interval_threshold, debug_marker);
+    }
+    if (i >= 2 && validation.is_relative_angle_valid) {
+      validation.is_relative_angle_valid = checkRelativeAngleAt(
+        traj, i - 2, relative_angle_threshold, min_dist_threshold, debug_marker);
+    }
+    if (!is_curvature_end && i + 2 < traj.points.size()) {
+      validation.is_curvature_valid =
+        checkCurvatureAt(traj, i, curvature_threshold, debug_marker, is_curvature_end);
+      is_curvature_end = is_curvature_end || !validation.is_curvature_valid;
+    }
+  }
+  return validation;
 }
 
 bool PlanningErrorMonitorNode::checkTrajectoryPointValue(
   const Trajectory & traj, std::string & error_msg)
 {
-  error_msg = "This Trajectory doesn't have any invalid values";
+  error_msg = msg_valid_point_value;
   for (const auto & p : traj.points) {
     if (!checkFinite(p)) {
-      error_msg = "This trajectory has an infinite value";
+      error_msg = msg_invalid_point_value;
       return false;
     }
   }
@@ -166,26 +224,35 @@ bool PlanningErrorMonitorNode::checkTrajectoryInterval(
   const Trajectory & traj, const double & interval_threshold, std::string & error_msg,
   PlanningErrorMonitorDebugNode & debug_marker)
 {
-  error_msg = "Trajectory Interval Length is within the expected range";
+  error_msg = msg_valid_interval;
   debug_marker.clearPoseMarker("trajectory_interval");
   for (size_t i = 1; i < traj.points.size(); ++i) {
-    double ds = calcDistance2d(traj.points.at(i), traj.points.at(i - 1));
-
-    if (ds > interval_threshold) {
-      error_msg = "Trajectory Interval Length is longer than the expected range";
-      debug_marker.pushPoseMarker(traj.points.at(i - 1).pose, "trajectory_interval");
-      debug_marker.pushPoseMarker(traj.points.at(i).pose, "trajectory_interval");
+    if (!checkIntervalAt(traj, i, interval_threshold, debug_marker)) {
+      error_msg = msg_invalid_interval;
       return false;
     }
   }
   return true;
 }
 
+bool PlanningErrorMonitorNode::checkIntervalAt(
+  const Trajectory & traj, const size_t id, const double interval_threshold,
+  PlanningErrorMonitorDebugNode & debug_marker)
+{
+  const double ds = calcDistance2d(traj.points.at(id), traj.points.at(id - 1));
+  if (ds > interval_threshold) {
+    debug_marker.pushPoseMarker(traj.points.at(id - 1).pose, "trajectory_interval");
+    debug_marker.pushPoseMarker(traj.points.at(id).pose, "trajectory_interval");
+    return false;
+  }
+  return true;
+}
+
 bool PlanningErrorMonitorNode::checkTrajectoryRelativeAngle(
   const Trajectory & traj, const double angle_threshold, const double min_dist_threshold,
   std::string & error_msg, PlanningErrorMonitorDebugNode & debug_marker)
 {
-  error_msg = "This trajectory's relative angle is within the expected range";
+  error_msg = msg_valid_relative_angle;
   debug_marker.clearPoseMarker("trajectory_relative_angle");
 
   // We need at least three points to compute relative angle
@@ -195,54 +262,64 @@ bool PlanningErrorMonitorNode::checkTrajectoryRelativeAngle(
   }
 
   for (size_t p1_id = 0; p1_id <= traj.points.size() - relative_angle_points_num; ++p1_id) {
-    // Get Point1
-    const auto & p1 = traj.points.at(p1_id).pose.position;
+    if (!checkRelativeAngleAt(traj, p1_id, angle_threshold, min_dist_threshold, debug_marker)) {
+      error_msg = msg_invalid_relative_angle;
+      return false;
+    }
+  }
+  return true;
+}
 
-    // Get Point2
-    const auto & p2 = traj.points.at(p1_id + 1).pose.position;
+bool PlanningErrorMonitorNode::checkRelativeAngleAt(
+  const Trajectory & traj, const size_t p1_id, const double angle_threshold,
+  const double min_dist_threshold, PlanningErrorMonitorDebugNode & debug_marker)
+{
+  // Get Point1
+  const auto & p1 = traj.points.at(p1_id).pose.position;
 
-    // Get Point3
-    const auto & p3 = traj.points.at(p1_id + 2).pose.position;
+  // Get Point2
+  const auto & p2 = traj.points.at(p1_id + 1).pose.position;
 
-    // ignore invert driving direction
-    if (
-      traj.points.at(p1_id).longitudinal_velocity_mps < 0 ||
-      traj.points.at(p1_id + 1).longitudinal_velocity_mps < 0 ||
-      traj.points.at(p1_id + 2).longitudinal_velocity_mps < 0) {
-      continue;
-    }
+  // Get Point3
+  const auto & p3 = traj.points.at(p1_id + 2).pose.position;
 
-    // convert to p1 coordinate
-    const double x3 = p3.x - p1.x;
-    const double x2 = p2.x - p1.x;
-    const double y3 = p3.y - p1.y;
-    const double y2 = p2.y - p1.y;
+  // ignore invert driving direction
+  if (
+    traj.points.at(p1_id).longitudinal_velocity_mps < 0 ||
+    traj.points.at(p1_id + 1).longitudinal_velocity_mps < 0 ||
+    traj.points.at(p1_id + 2).longitudinal_velocity_mps < 0) {
+    return true;
+  }
 
-    // skip too close points case
-    if (std::hypot(x3, y3) < min_dist_threshold || std::hypot(x2, y2) < min_dist_threshold) {
-      continue;
-    }
+  // convert to p1 coordinate
+  const double x3 = p3.x - p1.x;
+  const double x2 = p2.x - p1.x;
+  const double y3 = p3.y - p1.y;
+  const double y2 = p2.y - p1.y;
 
-    // calculate relative angle of vector p3 based on p1p2 vector
-    const double th = std::atan2(y2, x2);
-    const double th2 =
-      std::atan2(-x3 * std::sin(th) + y3 * std::cos(th), x3 * std::cos(th) + y3 * std::sin(th));
-    if (std::abs(th2) > angle_threshold) {
-      error_msg = "This Trajectory's relative angle has larger value than the expected value";
-      // std::cout << error_msg << std::endl;
-      debug_marker.pushPoseMarker(traj.points.at(p1_id).pose, "trajectory_relative_angle", 0);
-      debug_marker.pushPoseMarker(traj.points.at(p1_id + 1).pose, "trajectory_relative_angle", 1);
-      debug_marker.pushPoseMarker(traj.points.at(p1_id + 2).pose, "trajectory_relative_angle", 2);
-      return false;
-    }
+  // skip too close points case
+  const double min_squared_dist = min_dist_threshold * min_dist_threshold;
+  if (x3 * x3 + y3 * y3 < min_squared_dist || x2 * x2 + y2 * y2 < min_squared_dist) {
+    return true;
+  }
+
+  // calculate relative angle of vector p3 based on p1p2 vector, from their cross and dot products
+  // instead of rotating p3 by the angle of p1p2
+  const double th2 = std::atan2(x2 * y3 - y2 * x3, x2 * x3 + y2 * y3);
+  if (std::abs(th2) > angle_threshold) {
+    debug_marker.pushPoseMarker(traj.points.at(p1_id).pose, "trajectory_relative_angle", 0);
+    debug_marker.pushPoseMarker(traj.points.at(p1_id + 1).pose, "trajectory_relative_angle", 1);
+    debug_marker.pushPoseMarker(traj.points.at(p1_id + 2).pose, "trajectory_relative_angle", 2);
+    return false;
   }
   return true;
 }
+
 bool PlanningErrorMonitorNode::checkTrajectoryCurvature(
   const Trajectory & traj, const double & curvature_threshold, std::string & error_msg,
   PlanningErrorMonitorDebugNode & debug_marker)
 {
-  error_msg = "This trajectory's curvature is within the expected range";
+  error_msg = msg_valid_curvature;
   debug_marker.clearPoseMarker("trajectory_curvature");
 
   // We need at least three points to compute curvature
@@ -250,40 +327,56 @@ bool PlanningErrorMonitorNode::checkTrajectoryCurvature(
     return true;
   }
 
+  for (size_t p1_id = 0; p1_id < traj.points.size() - 2; ++p1_id) {
+    bool is_end = false;
+    if (!checkCurvatureAt(traj, p1_id, curvature_threshold, debug_marker, is_end)) {
+      error_msg = msg_invalid_curvature;
+      return false;
+    }
+    if (is_end) {
+      break;
+    }
+  }
+  return true;
+}
+
+bool PlanningErrorMonitorNode::checkCurvatureAt(
+  const Trajectory & traj, const size_t p1_id, const double curvature_threshold,
+  PlanningErrorMonitorDebugNode & debug_marker, bool & is_end)
+{
   constexpr double points_distance = 1.0;
   const auto isValidDistance = [points_distance](const auto & p1, const auto & p2) {
     return calcDistance2d(p1, p2) >= points_distance;
   };
 
-  for (size_t p1_id = 0; p1_id < traj.points.size() - 2; ++p1_id) {
-    // Get Point1
-    const auto p1 = traj.points.at(p1_id).pose.position;
+  // Get Point1
+  const auto p1 = traj.points.at(p1_id).pose.position;
 
-    // Get Point2
-    const auto p2_id = getIndexAfterDistance(traj, p1_id, points_distance);
-    const auto p2 = traj.points.at(p2_id).pose.position;
+  // Get Point2
+  const auto p2_id = getIndexAfterDistance(traj, p1_id, points_distance);
+  const auto p2 = traj.points.at(p2_id).pose.position;
 
-    // Get Point3
-    const auto p3_id = getIndexAfterDistance(traj, p2_id, points_distance);
-    const auto p3 = traj.points.at(p3_id).pose.position;
+  // Get Point3
+  const auto p3_id = getIndexAfterDistance(traj, p2_id, points_distance);
+  const auto p3 = traj.points.at(p3_id).pose.position;
 
-    // no need to check for pi, since there is no point with "points_distance" from p1.
-    if (p1_id == p2_id || p1_id == p3_id || p2_id == p3_id) {
-      break;
-    }
-    if (!isValidDistance(p1, p2) || !isValidDistance(p1, p3) || !isValidDistance(p2, p3)) {
-      break;
-    }
+  // no need to check for pi, since there is no point with "points_distance" from p1.
+  if (p1_id == p2_id || p1_id == p3_id || p2_id == p3_id) {
+    is_end = true;
+    return true;
+  }
+  if (!isValidDistance(p1, p2) || !isValidDistance(p1, p3) || !isValidDistance(p2, p3)) {
+    is_end = true;
+    return true;
+  }
 
-    const double curvature = calcCurvature(p1, p2, p3);
+  const double curvature = calcCurvature(p1, p2, p3);
 
-    if (std::fabs(curvature) > curvature_threshold) {
-      error_msg = "This Trajectory's curvature has larger value than the expected value";
-      debug_marker.pushPoseMarker(traj.points.at(p1_id).pose, "trajectory_curvature");
-      debug_marker.pushPoseMarker(traj.points.at(p2_id).pose, "trajectory_curvature");
-      debug_marker.pushPoseMarker(traj.points.at(p3_id).pose, "trajectory_curvature");
-      return false;
-    }
+  if (std::fabs(curvature) > curvature_threshold) {
+    debug_marker.pushPoseMarker(traj.points.at(p1_id).pose, "trajectory_curvature");
+    debug_marker.pushPoseMarker(traj.points.at(p2_id).pose, "trajectory_curvature");
+    debug_marker.pushPoseMarker(traj.points.at(p3_id).pose, "trajectory_curvature");
+    return false;
   }
   return true;
 }
@@ -155,3 +155,45 @@ TEST(PlanningErrorMonitor, TrajectoryRelativeAngleChecker)
       valid_error_msg, "This Trajectory's relative angle has larger value than the expected value");
   }
 }
+
+TEST(PlanningErrorMonitor, FusedTrajectoryValidation)
+{
+  using autoware_auto_planning_msgs::msg::Trajectory;
+  using planning_diagnostics::PlanningErrorMonitorNode;
+  PlanningErrorMonitorDebugNode debug_marker;
+  const double too_close_dist = 0.05;
+  const double too_sharp_turn = M_PI_4;
+
+  Trajectory sharp_turn_traj = generateTrajectory(NOMINAL_INTERVAL);
+  sharp_turn_traj.points[4].pose.position.x = 3;
+  sharp_turn_traj.points[4].pose.position.y = 10;
+
+  // the fused validation gives the same results as the separate checks
+  for (const auto & traj :
+       {generateTrajectory(NOMINAL_INTERVAL), generateTrajectory(ERROR_INTERVAL),
+        generateBadCurvatureTrajectory(), sharp_turn_traj}) {
+    const auto validation = PlanningErrorMonitorNode::validateTrajectory(
+      traj, NOMINAL_INTERVAL, ERROR_CURVATURE, too_sharp_turn, too_close_dist, debug_marker);
+    std::string msg;
+    EXPECT_EQ(
+      validation.is_point_value_valid,
+      PlanningErrorMonitorNode::checkTrajectoryPointValue(traj, msg));
+    EXPECT_EQ(
+      validation.is_interval_valid,
+      PlanningErrorMonitorNode::checkTrajectoryInterval(traj, NOMINAL_INTERVAL, msg, debug_marker));
+    EXPECT_EQ(
+      validation.is_curvature_valid, PlanningErrorMonitorNode::checkTrajectoryCurvature(
+                                       traj, ERROR_CURVATURE, msg, debug_marker));
+    EXPECT_EQ(
+      validation.is_relative_angle_valid,
+      PlanningErrorMonitorNode::checkTrajectoryRelativeAngle(
+        traj, too_sharp_turn, too_close_dist, msg, debug_marker));
+  }
+
+  // the other checks stop at an invalid value
+  const auto nan_validation = PlanningErrorMonitorNode::validateTrajectory(
+    generateNanTrajectory(), NOMINAL_INTERVAL, ERROR_CURVATURE, too_sharp_turn, too_close_dist,
+    debug_marker);
+  EXPECT_FALSE(nan_validation.is_point_value_valid);
+  EXPECT_TRUE(nan_validation.is_interval_valid);
+}
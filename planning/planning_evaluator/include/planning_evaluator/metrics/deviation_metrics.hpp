@@ -20,6 +20,8 @@
 #include "autoware_auto_planning_msgs/msg/trajectory.hpp"
 #include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
 
+#include <vector>
+
 namespace planning_diagnostics
 {
 namespace metrics
@@ -35,6 +37,16 @@ using autoware_auto_planning_msgs::msg::TrajectoryPoint;
  */
 Stat<double> calcLateralDeviation(const Trajectory & ref, const Trajectory & traj);
 
+/**
+ * @brief calculate lateral deviation of the given trajectory from the reference trajectory
+ * @param [in] ref reference trajectory
+ * @param [in] traj input trajectory
+ * @param [in] nearest_indices index in ref of the nearest point of each point of traj
+ * @return calculated statistics
+ */
+Stat<double> calcLateralDeviation(
+  const Trajectory & ref, const Trajectory & traj, const std::vector<size_t> & nearest_indices);
+
 /**
  * @brief calculate yaw deviation of the given trajectory from the reference trajectory
  * @param [in] ref reference trajectory
@@ -43,6 +55,16 @@ Stat<double> calcLateralDeviation(const Trajectory & ref, const Trajectory & tra
  */
 Stat<double> calcYawDeviation(const Trajectory & ref, const Trajectory & traj);
 
+/**
+ * @brief calculate yaw deviation of the given trajectory from the reference trajectory
+ * @param [in] ref reference trajectory
+ * @param [in] traj input trajectory
+ * @param [in] nearest_indices index in ref of the nearest point of each point of traj
+ * @return calculated statistics
+ */
+Stat<double> calcYawDeviation(
+  const Trajectory & ref, const Trajectory & traj, const std::vector<size_t> & nearest_indices);
+
 /**
  * @brief calculate velocity deviation of the given trajectory from the reference trajectory
  * @param [in] ref reference trajectory
@@ -51,6 +73,16 @@ Stat<double> calcYawDeviation(const Trajectory & ref, const Trajectory & traj);
  */
 Stat<double> calcVelocityDeviation(const Trajectory & ref, const Trajectory & traj);
 
+/**
+ * @brief calculate velocity deviation of the given trajectory from the reference trajectory
+ * @param [in] ref reference trajectory
+ * @param [in] traj input trajectory
+ * @param [in] nearest_indices index in ref of the nearest point of each point of traj
+ * @return calculated statistics
+ */
+Stat<double> calcVelocityDeviation(
+  const Trajectory & ref, const Trajectory & traj, const std::vector<size_t> & nearest_indices);
+
 }  // namespace metrics
 }  // namespace planning_diagnostics
 
@@ -20,6 +20,8 @@
 #include "autoware_auto_planning_msgs/msg/trajectory.hpp"
 #include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
 
+#include <vector>
+
 namespace planning_diagnostics
 {
 namespace metrics
@@ -37,6 +39,14 @@ using autoware_auto_planning_msgs::msg::Trajectory;
  */
 size_t getIndexAfterDistance(const Trajectory & traj, const size_t curr_id, const double distance);
 
+/**
+ * @brief find the index of the nearest reference point of each point of the trajectory
+ * @param [in] ref reference trajectory
+ * @param [in] traj input trajectory
+ * @return index in ref of the nearest point of each point of traj, empty if ref is empty
+ */
+std::vector<size_t> findNearestIndices(const Trajectory & ref, const Trajectory & traj);
+
 }  // namespace utils
 }  // namespace metrics
 }  // namespace planning_diagnostics
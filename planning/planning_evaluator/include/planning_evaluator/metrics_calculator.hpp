@@ -24,6 +24,8 @@
 #include "autoware_auto_planning_msgs/msg/trajectory_point.hpp"
 #include "geometry_msgs/msg/pose.hpp"
 
+#include <vector>
+
 namespace planning_diagnostics
 {
 using autoware_auto_perception_msgs::msg::PredictedObjects;
@@ -44,6 +46,16 @@ public:
    */
   Stat<double> calculate(const Metric metric, const Trajectory & traj) const;
 
+  /**
+   * @brief calculate the metrics, sharing the nearest reference indices and the lookahead
+   * trajectories between the metrics which use them
+   * @param [in] metrics Metric enum values
+   * @param [in] traj input trajectory
+   * @return statistics of each of the metrics, in the same order
+   */
+  std::vector<Stat<double>> calculate(
+    const std::vector<Metric> & metrics, const Trajectory & traj) const;
+
   /**
    * @brief set the reference trajectory used to calculate the deviation metrics
    * @param [in] traj input reference trajectory
@@ -16,6 +16,7 @@
 #define PLANNING_EVALUATOR__PLANNING_EVALUATOR_NODE_HPP_
 
 #include "planning_evaluator/metrics_calculator.hpp"
+#include "planning_evaluator/quantile_sketch.hpp"
 #include "planning_evaluator/stat.hpp"
 #include "rclcpp/rclcpp.hpp"
 #include "tf2_ros/buffer.h"
@@ -27,7 +28,8 @@
 #include "diagnostic_msgs/msg/diagnostic_array.hpp"
 
 #include <array>
-#include <deque>
+#include <fstream>
+#include <iostream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -78,6 +80,11 @@ public:
   DiagnosticStatus generateDiagnosticStatus(
     const Metric & metric, const Stat<double> & metric_stat) const;
 
+  /**
+   * @brief write the header of the output file, followed by one row of statistics per trajectory
+   */
+  static void writeOutputHeader(std::ostream & os, const std::vector<Metric> & metrics);
+
 private:
   static bool isFinite(const TrajectoryPoint & p);
 
@@ -92,13 +99,17 @@ private:
   // Parameters
   std::string output_file_str_;
   std::string ego_frame_str_;
+  std::vector<double> quantiles_;
 
   // Calculator
   MetricsCalculator metrics_calculator_;
   // Metrics
   std::vector<Metric> metrics_;
-  std::deque<rclcpp::Time> stamps_;
-  std::array<std::deque<Stat<double>>, static_cast<size_t>(Metric::SIZE)> metric_stats_;
+  // quantiles of the mean of each metric over the trajectories, in the order of quantiles_
+  std::array<std::vector<QuantileSketch<double>>, static_cast<size_t>(Metric::SIZE)>
+    metric_quantiles_;
+  // metrics are written as they are calculated, so that none are kept in memory
+  std::ofstream output_file_;
 };
 }  // namespace planning_diagnostics
 
@@ -0,0 +1,160 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef PLANNING_EVALUATOR__QUANTILE_SKETCH_HPP_
+#define PLANNING_EVALUATOR__QUANTILE_SKETCH_HPP_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace planning_diagnostics
+{
+/**
+ * @brief class to incrementally estimate a quantile with the P-square algorithm (Jain and
+ * Chlamtac, 1985), which keeps 5 markers instead of the values so that its memory is fixed
+ * @typedef T type of the values (default to double)
+ */
+template <typename T = double>
+class QuantileSketch
+{
+public:
+  /**
+   * @brief constructor
+   * @param probability probability of the estimated quantile, in [0, 1]
+   */
+  explicit QuantileSketch(const double probability = 0.5)
+  : probability_(probability),
+    increments_{0.0, probability / 2.0, probability, (1.0 + probability) / 2.0, 1.0}
+  {
+  }
+
+  /**
+   * @brief add a value
+   * @param value value to add
+   */
+  void add(const T & value)
+  {
+    const double x = static_cast<double>(value);
+    if (count_ < marker_num) {
+      heights_[count_] = x;
+      ++count_;
+      if (count_ == marker_num) {
+        std::sort(heights_.begin(), heights_.end());
+        for (size_t i = 0; i < marker_num; ++i) {
+          positions_[i] = static_cast<double>(i + 1);
+          desired_positions_[i] = 1.0 + 4.0 * increments_[i];
+        }
+      }
+      return;
+    }
+    ++count_;
+
+    // cell of the value, extending the extreme markers if it is outside of them
+    size_t k = 0;
+    if (x < heights_[0]) {
+      heights_[0] = x;
+    } else if (x >= heights_[marker_num - 1]) {
+      heights_[marker_num - 1] = x;
+      k = marker_num - 2;
+    } else {
+      while (x >= heights_[k + 1]) {
+        ++k;
+      }
+    }
+    for (size_t i = k + 1; i < marker_num; ++i) {
+      positions_[i] += 1.0;
+    }
+    for (size_t i = 0; i < marker_num; ++i) {
+      desired_positions_[i] += increments_[i];
+    }
+
+    // move the middle markers toward their desired positions
+    for (size_t i = 1; i < marker_num - 1; ++i) {
+      const double d = desired_positions_[i] - positions_[i];
+      if (
+        (d >= 1.0 && positions_[i + 1] - positions_[i] > 1.0) ||
+        (d <= -1.0 && positions_[i - 1] - positions_[i] < -1.0)) {
+        const double sign = d > 0.0 ? 1.0 : -1.0;
+        const double parabolic = calcParabolic(i, sign);
+        if (heights_[i - 1] < parabolic && parabolic < heights_[i + 1]) {
+          heights_[i] = parabolic;
+        } else {
+          const size_t j = sign > 0.0 ? i + 1 : i - 1;
+          heights_[i] += sign * (heights_[j] - heights_[i]) / (positions_[j] - positions_[i]);
+        }
+        positions_[i] += sign;
+      }
+    }
+  }
+
+  /**
+   * @brief get the estimated quantile, which is exact while less than 5 values are added
+   * @return the quantile, or NaN if no value is added
+   */
+  double quantile() const
+  {
+    if (count_ == 0) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (count_ >= marker_num) {
+      return heights_[2];
+    }
+
+    // linear interpolation between the closest ranks
+    std::array<double, marker_num> sorted = heights_;
+    std::sort(sorted.begin(), sorted.begin() + count_);
+    const double rank = probability_ * static_cast<double>(count_ - 1);
+    const size_t lower = static_cast<size_t>(std::floor(rank));
+    const size_t upper = std::min(lower + 1, static_cast<size_t>(count_ - 1));
+    return sorted[lower] + (rank - static_cast<double>(lower)) * (sorted[upper] - sorted[lower]);
+  }
+
+  /**
+   * @brief get the probability of the estimated quantile
+   */
+  double probability() const { return probability_; }
+
+  /**
+   * @brief get the number of values used to estimate the quantile
+   */
+  unsigned int count() const { return count_; }
+
+private:
+  static constexpr size_t marker_num = 5;
+
+  double calcParabolic(const size_t i, const double d) const
+  {
+    const double n_prev = positions_[i - 1];
+    const double n = positions_[i];
+    const double n_next = positions_[i + 1];
+    return heights_[i] +
+           d / (n_next - n_prev) *
+             ((n - n_prev + d) * (heights_[i + 1] - heights_[i]) / (n_next - n) +
+              (n_next - n - d) * (heights_[i] - heights_[i - 1]) / (n - n_prev));
+  }
+
+  double probability_;
+  std::array<double, marker_num> increments_;
+  std::array<double, marker_num> heights_{};
+  std::array<double, marker_num> positions_{};
+  std::array<double, marker_num> desired_positions_{};
+  unsigned int count_ = 0;
+};
+
+}  // namespace planning_diagnostics
+
+#endif  // PLANNING_EVALUATOR__QUANTILE_SKETCH_HPP_
@@ -14,9 +14,11 @@
 
 #include "planning_evaluator/metrics/deviation_metrics.hpp"
 
-#include "motion_utils/trajectory/trajectory.hpp"
+#include "planning_evaluator/metrics/metrics_utils.hpp"
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
+#include <vector>
+
 namespace planning_diagnostics
 {
 namespace metrics
@@ -25,6 +27,12 @@ using autoware_auto_planning_msgs::msg::Trajectory;
 using autoware_auto_planning_msgs::msg::TrajectoryPoint;
 
 Stat<double> calcLateralDeviation(const Trajectory & ref, const Trajectory & traj)
+{
+  return calcLateralDeviation(ref, traj, utils::findNearestIndices(ref, traj));
+}
+
+Stat<double> calcLateralDeviation(
+  const Trajectory & ref, const Trajectory & traj, const std::vector<size_t> & nearest_indices)
 {
   Stat<double> stat;
 
@@ -35,8 +43,9 @@ Stat<double> calcLateralDeviation(const Trajectory & ref, const Trajectory & tra
   /** TODO(Maxime CLEMENT):
    * need more precise calculation, e.g., lateral distance from spline of the reference traj
    */
-  for (TrajectoryPoint p : traj.points) {
-    const size_t nearest_index = motion_utils::findNearestIndex(ref.points, p.pose.position);
+  for (size_t i = 0; i < traj.points.size(); ++i) {
+    const TrajectoryPoint & p = traj.points[i];
+    const size_t nearest_index = nearest_indices.at(i);
     stat.add(
       tier4_autoware_utils::calcLateralDeviation(ref.points[nearest_index].pose, p.pose.position));
   }
@@ -44,6 +53,12 @@ Stat<double> calcLateralDeviation(const Trajectory & ref, const Trajectory & tra
 }
 
 Stat<double> calcYawDeviation(const Trajectory & ref, const Trajectory & traj)
+{
+  return calcYawDeviation(ref, traj, utils::findNearestIndices(ref, traj));
+}
+
+Stat<double> calcYawDeviation(
+  const Trajectory & ref, const Trajectory & traj, const std::vector<size_t> & nearest_indices)
 {
   Stat<double> stat;
 
@@ -54,14 +69,21 @@ Stat<double> calcYawDeviation(const Trajectory & ref, const Trajectory & traj)
   /** TODO(Maxime CLEMENT):
    * need more precise calculation, e.g., yaw distance from spline of the reference traj
    */
-  for (TrajectoryPoint p : traj.points) {
-    const size_t nearest_index = motion_utils::findNearestIndex(ref.points, p.pose.position);
+  for (size_t i = 0; i < traj.points.size(); ++i) {
+    const TrajectoryPoint & p = traj.points[i];
+    const size_t nearest_index = nearest_indices.at(i);
     stat.add(tier4_autoware_utils::calcYawDeviation(ref.points[nearest_index].pose, p.pose));
   }
   return stat;
 }
 
 Stat<double> calcVelocityDeviation(const Trajectory & ref, const Trajectory & traj)
+{
+  return calcVelocityDeviation(ref, traj, utils::findNearestIndices(ref, traj));
+}
+
+Stat<double> calcVelocityDeviation(
+  const Trajectory & ref, const Trajectory & traj, const std::vector<size_t> & nearest_indices)
 {
   Stat<double> stat;
 
@@ -70,8 +92,9 @@ Stat<double> calcVelocityDeviation(const Trajectory & ref, const Trajectory & tr
   }
 
   // TODO(Maxime CLEMENT) need more precise calculation
-  for (TrajectoryPoint p : traj.points) {
-    const size_t nearest_index = motion_utils::findNearestIndex(ref.points, p.pose.position);
+  for (size_t i = 0; i < traj.points.size(); ++i) {
+    const TrajectoryPoint & p = traj.points[i];
+    const size_t nearest_index = nearest_indices.at(i);
     stat.add(p.longitudinal_velocity_mps - ref.points[nearest_index].longitudinal_velocity_mps);
   }
   return stat;
@@ -12,9 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "planning_evaluator/metrics/metrics_utils.hpp"
 #include "planning_evaluator/metrics/trajectory_metrics.hpp"
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
+#include <vector>
+
 namespace planning_diagnostics
 {
 namespace metrics
@@ -43,6 +46,21 @@ size_t getIndexAfterDistance(const Trajectory & traj, const size_t curr_id, cons
   return target_id;
 }
 
+std::vector<size_t> findNearestIndices(const Trajectory & ref, const Trajectory & traj)
+{
+  std::vector<size_t> nearest_indices;
+  if (ref.points.empty()) {
+    return nearest_indices;
+  }
+
+  const auto ref_points = tier4_autoware_utils::toPointArray2d(ref.points);
+  nearest_indices.reserve(traj.points.size());
+  for (const TrajectoryPoint & p : traj.points) {
+    nearest_indices.push_back(tier4_autoware_utils::findNearestIndex(ref_points, p.pose.position));
+  }
+  return nearest_indices;
+}
+
 }  // namespace utils
 }  // namespace metrics
 }  // namespace planning_diagnostics
@@ -16,11 +16,15 @@
 
 #include "motion_utils/motion_utils.hpp"
 #include "planning_evaluator/metrics/deviation_metrics.hpp"
+#include "planning_evaluator/metrics/metrics_utils.hpp"
 #include "planning_evaluator/metrics/obstacle_metrics.hpp"
 #include "planning_evaluator/metrics/stability_metrics.hpp"
 #include "planning_evaluator/metrics/trajectory_metrics.hpp"
 #include "tier4_autoware_utils/tier4_autoware_utils.hpp"
 
+#include <algorithm>
+#include <vector>
+
 namespace planning_diagnostics
 {
 Stat<double> MetricsCalculator::calculate(const Metric metric, const Trajectory & traj) const
@@ -76,6 +80,60 @@ Stat<double> MetricsCalculator::calculate(const Metric metric, const Trajectory
   }
 }
 
+std::vector<Stat<double>> MetricsCalculator::calculate(
+  const std::vector<Metric> & metrics, const Trajectory & traj) const
+{
+  const auto is_selected = [&](const Metric metric) {
+    return std::find(metrics.begin(), metrics.end(), metric) != metrics.end();
+  };
+
+  std::vector<size_t> ref_nearest_indices;
+  if (
+    is_selected(Metric::lateral_deviation) || is_selected(Metric::yaw_deviation) ||
+    is_selected(Metric::velocity_deviation)) {
+    ref_nearest_indices = metrics::utils::findNearestIndices(reference_trajectory_, traj);
+  }
+
+  Trajectory previous_lookahead;
+  Trajectory traj_lookahead;
+  if (is_selected(Metric::stability) || is_selected(Metric::stability_frechet)) {
+    previous_lookahead = getLookaheadTrajectory(
+      previous_trajectory_, parameters.trajectory.lookahead.max_dist_m,
+      parameters.trajectory.lookahead.max_time_s);
+    traj_lookahead = getLookaheadTrajectory(
+      traj, parameters.trajectory.lookahead.max_dist_m, parameters.trajectory.lookahead.max_time_s);
+  }
+
+  std::vector<Stat<double>> stats;
+  stats.reserve(metrics.size());
+  for (const Metric metric : metrics) {
+    switch (metric) {
+      case Metric::lateral_deviation:
+        stats.push_back(
+          metrics::calcLateralDeviation(reference_trajectory_, traj, ref_nearest_indices));
+        break;
+      case Metric::yaw_deviation:
+        stats.push_back(
+          metrics::calcYawDeviation(reference_trajectory_, traj, ref_nearest_indices));
+        break;
+      case Metric::velocity_deviation:
+        stats.push_back(
+          metrics::calcVelocityDeviation(reference_trajectory_, traj, ref_nearest_indices));
+        break;
+      case Metric::stability_frechet:
+        stats.push_back(metrics::calcFrechetDistance(previous_lookahead, traj_lookahead));
+        break;
+      case Metric::stability:
+        stats.push_back(metrics::calcLateralDistance(previous_lookahead, traj_lookahead));
+        break;
+      default:
+        stats.push_back(calculate(metric, traj));
+        break;
+    }
+  }
+  return stats;
+}
+
 void MetricsCalculator::setReferenceTrajectory(const Trajectory & traj)
 {
   reference_trajectory_ = traj;
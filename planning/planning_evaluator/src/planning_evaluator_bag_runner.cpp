@@ -0,0 +1,203 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "planning_evaluator/metrics_calculator.hpp"
+#include "planning_evaluator/planning_evaluator_node.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp/serialization.hpp>
+#include <rosbag2_cpp/reader.hpp>
+
+#include <tf2/buffer_core.h>
+#include <tf2/exceptions.h>
+
+#include <tf2_msgs/msg/tf_message.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using autoware_auto_perception_msgs::msg::PredictedObjects;
+using autoware_auto_planning_msgs::msg::Trajectory;
+using planning_diagnostics::Metric;
+using planning_diagnostics::MetricsCalculator;
+using planning_diagnostics::Parameters;
+using planning_diagnostics::PlanningEvaluatorNode;
+
+struct BagRunnerParam
+{
+  std::string trajectory_topic;
+  std::string reference_trajectory_topic;
+  std::string objects_topic;
+  std::string ego_frame;
+  std::vector<Metric> metrics;
+  Parameters parameters;
+};
+
+// name of the bag directory or file without its extension
+std::string getBagName(std::string bag_path)
+{
+  while (bag_path.size() > 1 && bag_path.back() == '/') {
+    bag_path.pop_back();
+  }
+  const auto name = bag_path.substr(bag_path.find_last_of('/') + 1);
+  return name.substr(0, name.find_last_of('.'));
+}
+
+template <class T>
+T deserialize(const rosbag2_storage::SerializedBagMessage & bag_message)
+{
+  rclcpp::Serialization<T> serialization;
+  const rclcpp::SerializedMessage serialized_message(*bag_message.serialized_data);
+  T message;
+  serialization.deserialize_message(&serialized_message, &message);
+  return message;
+}
+
+/**
+ * @brief evaluate the trajectories of the bag as the node does, with the ego pose from the tf of
+ * the bag, and write the same rows as the output file of the node
+ * @return number of evaluated trajectories
+ */
+size_t evaluateBag(
+  const std::string & bag_path, const std::string & output_path, const BagRunnerParam & param)
+{
+  rosbag2_cpp::Reader reader;
+  reader.open(bag_path);
+  rosbag2_storage::StorageFilter filter;
+  filter.topics = {
+    param.trajectory_topic, param.reference_trajectory_topic, param.objects_topic, "/tf",
+    "/tf_static"};
+  reader.set_filter(filter);
+
+  MetricsCalculator metrics_calculator;
+  metrics_calculator.parameters = param.parameters;
+  tf2::BufferCore tf_buffer;
+
+  std::ofstream output_file(output_path);
+  PlanningEvaluatorNode::writeOutputHeader(output_file, param.metrics);
+
+  size_t trajectory_num = 0;
+  while (reader.has_next()) {
+    const auto bag_message = reader.read_next();
+    const auto & topic = bag_message->topic_name;
+    if (topic == "/tf" || topic == "/tf_static") {
+      const auto tf_message = deserialize<tf2_msgs::msg::TFMessage>(*bag_message);
+      for (const auto & transform : tf_message.transforms) {
+        tf_buffer.setTransform(transform, "bag", topic == "/tf_static");
+      }
+    } else if (topic == param.reference_trajectory_topic) {
+      metrics_calculator.setReferenceTrajectory(deserialize<Trajectory>(*bag_message));
+    } else if (topic == param.objects_topic) {
+      metrics_calculator.setPredictedObjects(deserialize<PredictedObjects>(*bag_message));
+    } else if (topic == param.trajectory_topic) {
+      const auto traj = deserialize<Trajectory>(*bag_message);
+      try {
+        const auto transform =
+          tf_buffer.lookupTransform(traj.header.frame_id, param.ego_frame, tf2::TimePointZero);
+        geometry_msgs::msg::Pose ego_pose;
+        ego_pose.position.x = transform.transform.translation.x;
+        ego_pose.position.y = transform.transform.translation.y;
+        ego_pose.position.z = transform.transform.translation.z;
+        ego_pose.orientation = transform.transform.rotation;
+        metrics_calculator.setEgoPose(ego_pose);
+      } catch (const tf2::TransformException &) {
+        // keep the last ego pose, as the node does
+      }
+
+      const auto metric_stats = metrics_calculator.calculate(param.metrics, traj);
+      output_file << rclcpp::Time(traj.header.stamp).nanoseconds();
+      for (const auto & metric_stat : metric_stats) {
+        output_file << " " << metric_stat;
+      }
+      output_file << "\n";
+      metrics_calculator.setPreviousTrajectory(traj);
+      ++trajectory_num;
+    }
+  }
+  return trajectory_num;
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+
+  auto node = rclcpp::Node::make_shared("planning_evaluator_bag_runner");
+  const auto logger = node->get_logger();
+
+  const auto bag_paths = node->declare_parameter<std::vector<std::string>>("bag_paths");
+  const auto output_directory = node->declare_parameter<std::string>("output_directory", ".");
+  const auto jobs = node->declare_parameter<int>("jobs", 0);
+
+  BagRunnerParam param;
+  param.trajectory_topic = node->declare_parameter<std::string>(
+    "input.trajectory", "/planning/scenario_planning/trajectory");
+  param.reference_trajectory_topic = node->declare_parameter<std::string>(
+    "input.reference_trajectory",
+    "/planning/scenario_planning/lane_driving/motion_planning/obstacle_avoidance_planner/"
+    "trajectory");
+  param.objects_topic = node->declare_parameter<std::string>(
+    "input.objects", "/perception/object_recognition/objects");
+  param.ego_frame = node->declare_parameter<std::string>("ego_frame");
+  param.parameters.trajectory.min_point_dist_m =
+    node->declare_parameter<double>("trajectory.min_point_dist_m");
+  param.parameters.trajectory.lookahead.max_dist_m =
+    node->declare_parameter<double>("trajectory.lookahead.max_dist_m");
+  param.parameters.trajectory.lookahead.max_time_s =
+    node->declare_parameter<double>("trajectory.lookahead.max_time_s");
+  param.parameters.obstacle.dist_thr_m = node->declare_parameter<double>("obstacle.dist_thr_m");
+  for (const std::string & selected_metric :
+       node->declare_parameter<std::vector<std::string>>("selected_metrics")) {
+    param.metrics.push_back(planning_diagnostics::str_to_metric.at(selected_metric));
+  }
+
+  // the bags are independent, so each worker evaluates whole bags as fast as it reads them
+  const size_t worker_num = std::min(
+    bag_paths.size(),
+    static_cast<size_t>(jobs > 0 ? jobs : std::max(1u, std::thread::hardware_concurrency())));
+  std::atomic<size_t> next_bag_idx{0};
+  std::atomic<bool> has_failed{false};
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < worker_num; ++i) {
+    workers.emplace_back([&]() {
+      for (size_t idx = next_bag_idx++; idx < bag_paths.size(); idx = next_bag_idx++) {
+        const auto & bag_path = bag_paths.at(idx);
+        const auto output_path = output_directory + "/" + getBagName(bag_path) + ".results";
+        try {
+          const size_t trajectory_num = evaluateBag(bag_path, output_path, param);
+          RCLCPP_INFO_STREAM(
+            logger, "Evaluated " << trajectory_num << " trajectories of " << bag_path << " to "
+                                 << output_path);
+        } catch (const std::exception & e) {
+          RCLCPP_ERROR_STREAM(logger, "Failed to evaluate " << bag_path << ": " << e.what());
+          has_failed = true;
+        }
+      }
+    });
+  }
+  for (auto & worker : workers) {
+    worker.join();
+  }
+
+  rclcpp::shutdown();
+
+  return has_failed ? EXIT_FAILURE : 0;
+}
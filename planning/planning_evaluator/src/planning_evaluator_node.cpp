@@ -20,6 +20,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -55,6 +56,7 @@ PlanningEvaluatorNode::PlanningEvaluatorNode(const rclcpp::NodeOptions & node_op
 
   output_file_str_ = declare_parameter<std::string>("output_file");
   ego_frame_str_ = declare_parameter<std::string>("ego_frame");
+  quantiles_ = declare_parameter<std::vector<double>>("quantiles", std::vector<double>{});
 
   // List of metrics to calculate and publish
   metrics_pub_ = create_publisher<DiagnosticArray>("~/metrics", 1);
@@ -62,39 +64,39 @@ PlanningEvaluatorNode::PlanningEvaluatorNode(const rclcpp::NodeOptions & node_op
        declare_parameter<std::vector<std::string>>("selected_metrics")) {
     Metric metric = str_to_metric.at(selected_metric);
     metrics_.push_back(metric);
+    for (const double quantile : quantiles_) {
+      metric_quantiles_[static_cast<size_t>(metric)].emplace_back(quantile);
+    }
+  }
+
+  if (!output_file_str_.empty()) {
+    output_file_.open(output_file_str_);
+    writeOutputHeader(output_file_, metrics_);
+  }
+}
+
+void PlanningEvaluatorNode::writeOutputHeader(
+  std::ostream & os, const std::vector<Metric> & metrics)
+{
+  os << std::fixed << std::left;
+  os << "#Stamp(ns)";
+  for (Metric metric : metrics) {
+    os << " " << metric_descriptions.at(metric);
+    os << " . .";  // extra "columns" to align columns headers
+  }
+  os << std::endl;
+  os << "#.";
+  for (Metric metric : metrics) {
+    (void)metric;
+    os << " min max mean";
   }
+  os << std::endl;
 }
 
 PlanningEvaluatorNode::~PlanningEvaluatorNode()
 {
-  if (!output_file_str_.empty()) {
-    // column width is the maximum size we might print + 1 for the space between columns
-    // Write data using format
-    std::ofstream f(output_file_str_);
-    f << std::fixed << std::left;
-    // header
-    f << "#Stamp(ns)";
-    for (Metric metric : metrics_) {
-      f << " " << metric_descriptions.at(metric);
-      f << " . .";  // extra "columns" to align columns headers
-    }
-    f << std::endl;
-    f << "#.";
-    for (Metric metric : metrics_) {
-      (void)metric;
-      f << " min max mean";
-    }
-    f << std::endl;
-    // data
-    for (size_t i = 0; i < stamps_.size(); ++i) {
-      f << stamps_[i].nanoseconds();
-      for (Metric metric : metrics_) {
-        const auto & stat = metric_stats_[static_cast<size_t>(metric)][i];
-        f << " " << stat;
-      }
-      f << std::endl;
-    }
-    f.close();
+  if (output_file_.is_open()) {
+    output_file_.close();
   }
 }
 
@@ -132,25 +134,42 @@ DiagnosticStatus PlanningEvaluatorNode::generateDiagnosticStatus(
   key_value.key = "mean";
   key_value.value = boost::lexical_cast<decltype(key_value.value)>(metric_stat.mean());
   status.values.push_back(key_value);
+  for (const auto & sketch : metric_quantiles_[static_cast<size_t>(metric)]) {
+    std::ostringstream key;
+    key << "mean_p" << sketch.probability() * 100.0;
+    key_value.key = key.str();
+    key_value.value = boost::lexical_cast<decltype(key_value.value)>(sketch.quantile());
+    status.values.push_back(key_value);
+  }
   return status;
 }
 
 void PlanningEvaluatorNode::onTrajectory(const Trajectory::ConstSharedPtr traj_msg)
 {
   auto start = now();
-  stamps_.push_back(traj_msg->header.stamp);
 
   updateCalculatorEgoPose(traj_msg->header.frame_id);
 
   DiagnosticArray metrics_msg;
   metrics_msg.header.stamp = now();
-  for (Metric metric : metrics_) {
-    const Stat metric_stat = metrics_calculator_.calculate(Metric(metric), *traj_msg);
-    metric_stats_[static_cast<size_t>(metric)].push_back(metric_stat);
+  const auto metric_stats = metrics_calculator_.calculate(metrics_, *traj_msg);
+  for (size_t i = 0; i < metrics_.size(); ++i) {
+    const Metric metric = metrics_[i];
+    const Stat<double> & metric_stat = metric_stats[i];
     if (metric_stat.count() > 0) {
+      for (auto & sketch : metric_quantiles_[static_cast<size_t>(metric)]) {
+        sketch.add(static_cast<double>(metric_stat.mean()));
+      }
       metrics_msg.status.push_back(generateDiagnosticStatus(metric, metric_stat));
     }
   }
+  if (output_file_.is_open()) {
+    output_file_ << rclcpp::Time(traj_msg->header.stamp).nanoseconds();
+    for (const auto & metric_stat : metric_stats) {
+      output_file_ << " " << metric_stat;
+    }
+    output_file_ << std::endl;
+  }
   if (!metrics_msg.status.empty()) {
     metrics_pub_->publish(metrics_msg);
   }
@@ -19,6 +19,7 @@
 #include "tf2_ros/transform_broadcaster.h"
 
 #include <planning_evaluator/planning_evaluator_node.hpp>
+#include <planning_evaluator/quantile_sketch.hpp>
 
 #include "autoware_auto_perception_msgs/msg/predicted_objects.hpp"
 #include "autoware_auto_planning_msgs/msg/trajectory.hpp"
@@ -27,6 +28,7 @@
 
 #include "boost/lexical_cast.hpp"
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
@@ -407,3 +409,23 @@ TEST_F(EvalTest, TestObstacleTTC)
   t.points[1].pose.position.x = 1.0;
   EXPECT_DOUBLE_EQ(publishTrajectoryAndGetMetric(t), 2.0);
 }
+
+TEST(QuantileSketchTest, TestQuantile)
+{
+  planning_diagnostics::QuantileSketch<double> median(0.5);
+  EXPECT_TRUE(std::isnan(median.quantile()));
+  // exact while there are less values than markers
+  for (const double v : {4.0, 1.0, 3.0}) {
+    median.add(v);
+  }
+  EXPECT_DOUBLE_EQ(median.quantile(), 3.0);
+
+  planning_diagnostics::QuantileSketch<double> p90(0.9);
+  for (int i = 0; i < 10000; ++i) {
+    median.add(static_cast<double>(i % 100));
+    p90.add(static_cast<double>(i % 100));
+  }
+  EXPECT_EQ(p90.count(), 10000u);
+  EXPECT_NEAR(median.quantile(), 49.5, 1.0);
+  EXPECT_NEAR(p90.quantile(), 89.1, 1.0);
+}
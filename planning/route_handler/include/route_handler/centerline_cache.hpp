@@ -0,0 +1,67 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef ROUTE_HANDLER__CENTERLINE_CACHE_HPP_
+#define ROUTE_HANDLER__CENTERLINE_CACHE_HPP_
+
+#include <geometry_msgs/msg/point.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace route_handler
+{
+struct LaneletCenterline
+{
+  std::vector<geometry_msgs::msg::Point> points;
+  std::vector<double> arc_lengths;  // 2d distance of every point from the front along the line
+  std::vector<double> yaws;         // direction of the centerline at every point
+};
+
+/**
+ * @brief Centerlines of the lanelets resampled at a fixed interval, computed once when the map is
+ * loaded instead of from lanelet::ConstLanelet every cycle
+ */
+class CenterlineCache
+{
+public:
+  CenterlineCache() = default;
+  CenterlineCache(const lanelet::ConstLanelets & lanelets, const double resolution);
+
+  /**
+   * @brief Get the resampled centerline of the lanelet
+   * @param the lanelet of interest
+   * @return the cached centerline, or the centerline resampled now if the lanelet is not cached
+   */
+  std::shared_ptr<const LaneletCenterline> getCenterline(
+    const lanelet::ConstLanelet & lanelet) const;
+  double getResolution() const { return resolution_; }
+  bool empty() const { return centerlines_.empty(); }
+
+  /**
+   * @brief Resample the centerline with points at most resolution apart, both ends included
+   */
+  static LaneletCenterline resampleCenterline(
+    const lanelet::ConstLanelet & lanelet, const double resolution);
+
+private:
+  double resolution_{1.0};
+  std::unordered_map<lanelet::Id, std::shared_ptr<const LaneletCenterline>> centerlines_;
+};
+}  // namespace route_handler
+#endif  // ROUTE_HANDLER__CENTERLINE_CACHE_HPP_
@@ -0,0 +1,78 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROUTE_HANDLER__LANELET_MAP_CACHE_HPP_
+#define ROUTE_HANDLER__LANELET_MAP_CACHE_HPP_
+
+#include <autoware_auto_mapping_msgs/msg/had_map_bin.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_routing/RoutingGraph.h>
+#include <lanelet2_traffic_rules/TrafficRules.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace route_handler
+{
+/**
+ * @brief Lanelet maps deserialized once per process. Every node of a process, e.g. the nodes
+ * composed in one container, which asks for the map of the same HADMapBin gets the same map and
+ * routing graphs, as long as one of them still holds them. The map is identified by a hash of the
+ * message data, and it must only be read once shared.
+ */
+class LaneletMapCache
+{
+public:
+  using HADMapBin = autoware_auto_mapping_msgs::msg::HADMapBin;
+
+  /**
+   * @brief Get the map of map_msg, as lanelet::utils::conversion::fromBinMsg
+   */
+  static lanelet::LaneletMapPtr getLaneletMap(const HADMapBin & map_msg);
+
+  /**
+   * @brief Get the map of map_msg with the traffic rules and the routing graph of the vehicles, as
+   * lanelet::utils::conversion::fromBinMsg
+   */
+  static lanelet::LaneletMapPtr getLaneletMap(
+    const HADMapBin & map_msg, lanelet::traffic_rules::TrafficRulesPtr * traffic_rules,
+    lanelet::routing::RoutingGraphPtr * routing_graph);
+
+  /**
+   * @brief Get the routing graph of the pedestrians on the map of map_msg
+   */
+  static lanelet::routing::RoutingGraphPtr getPedestrianRoutingGraph(const HADMapBin & map_msg);
+
+private:
+  struct Entry
+  {
+    std::size_t hash{0U};
+    std::size_t size{0U};
+    std::weak_ptr<lanelet::LaneletMap> lanelet_map;
+    std::weak_ptr<lanelet::traffic_rules::TrafficRules> traffic_rules;
+    std::weak_ptr<lanelet::routing::RoutingGraph> routing_graph;
+    std::weak_ptr<lanelet::routing::RoutingGraph> pedestrian_routing_graph;
+  };
+
+  // the map of map_msg, deserialized if needed, mutex_ being locked
+  static lanelet::LaneletMapPtr lockLaneletMap(const HADMapBin & map_msg);
+
+  static std::mutex mutex_;
+  static Entry entry_;
+};
+}  // namespace route_handler
+
+#endif  // ROUTE_HANDLER__LANELET_MAP_CACHE_HPP_
@@ -15,6 +15,9 @@
 #ifndef ROUTE_HANDLER__ROUTE_HANDLER_HPP_
 #define ROUTE_HANDLER__ROUTE_HANDLER_HPP_
 
+#include "route_handler/centerline_cache.hpp"
+#include "route_handler/route_lanelet_cache.hpp"
+
 #include <lanelet2_extension/utility/query.hpp>
 #include <motion_utils/motion_utils.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -222,6 +225,15 @@ public:
   int getNumLaneToPreferredLane(const lanelet::ConstLanelet & lanelet) const;
   bool getClosestLaneletWithinRoute(
     const Pose & search_pose, lanelet::ConstLanelet * closest_lanelet) const;
+  /**
+   * @brief Get the route lanelet closest to the pose within the distance, whose direction at the
+   * pose is within the yaw threshold. Of the lanelets at the same distance, e.g. the ones
+   * containing the pose, the one with the smallest yaw difference is taken.
+   * @return true if there is such a lanelet
+   */
+  bool getClosestLaneletWithinRoute(
+    const Pose & search_pose, lanelet::ConstLanelet * closest_lanelet, const double dist_threshold,
+    const double yaw_threshold) const;
   lanelet::ConstLanelet getLaneletsFromId(const lanelet::Id id) const;
   lanelet::ConstLanelets getLaneletsFromIds(const lanelet::Ids ids) const;
   lanelet::ConstLanelets getLaneletSequence(
@@ -257,6 +269,14 @@ public:
     const Pose & current_pose, const LaneChangeDirection & direction) const;
   lanelet::ConstPolygon3d getIntersectionAreaById(const lanelet::Id id) const;
 
+  /**
+   * @brief Get the centerline of the lanelet resampled when the map was set
+   * @param the lanelet of interest
+   * @return points, arc lengths and yaws of the centerline every centerline_resolution_ at most
+   */
+  std::shared_ptr<const LaneletCenterline> getCenterline(
+    const lanelet::ConstLanelet & lanelet) const;
+
 private:
   // MUST
   lanelet::routing::RoutingGraphPtr routing_graph_ptr_;
@@ -271,6 +291,9 @@ private:
   lanelet::ConstLanelets shoulder_lanelets_;
   Pose pull_over_goal_pose_;
   HADMapRoute route_msg_;
+  CenterlineCache centerline_cache_;
+  RouteLaneletCache route_lanelet_cache_;
+  static constexpr double centerline_resolution_{0.5};  // [m]
 
   rclcpp::Logger logger_{rclcpp::get_logger("route_handler")};
 
@@ -280,12 +303,17 @@ private:
 
   // non-const methods
   void setLaneletsFromRouteMsg();
+  // build route_lanelet_cache_ again from the lanelets of the route
+  void updateRouteLaneletCache();
 
   // const methods
   // for routing
   lanelet::ConstLanelets getMainLanelets(const lanelet::ConstLanelets & path_lanelets) const;
 
   // for lanelet
+  double getLaneletLength(const lanelet::ConstLanelet & lanelet) const;
+  lanelet::traffic_rules::SpeedLimitInformation getSpeedLimit(
+    const lanelet::ConstLanelet & lanelet) const;
   bool isInTargetLane(const PoseStamped & pose, const lanelet::ConstLanelets & target) const;
   bool isInPreferredLane(const PoseStamped & pose) const;
   bool isBijectiveConnection(
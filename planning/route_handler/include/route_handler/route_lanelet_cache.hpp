@@ -0,0 +1,168 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROUTE_HANDLER__ROUTE_LANELET_CACHE_HPP_
+#define ROUTE_HANDLER__ROUTE_LANELET_CACHE_HPP_
+
+#include <tier4_autoware_utils/geometry/boost_geometry.hpp>
+
+#include <geometry_msgs/msg/point.hpp>
+
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/optional.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_traffic_rules/TrafficRules.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace route_handler
+{
+/**
+ * @brief Relations of a lanelet of the route, as returned by the queries of RouteHandler
+ */
+struct RouteLaneletRelations
+{
+  boost::optional<lanelet::ConstLanelet> next;                  // getNextLaneletWithinRoute
+  boost::optional<lanelet::ConstLanelet> next_except_start;     // and not a start lanelet
+  lanelet::ConstLanelets previous;                              // getPreviousLaneletsWithinRoute
+  boost::optional<lanelet::ConstLanelet> previous_except_goal;  // and not a goal lanelet
+  lanelet::ConstLanelets neighbors;                             // getNeighborsWithinRoute
+  boost::optional<lanelet::ConstLanelet> right;                 // routable right lanelet
+  boost::optional<lanelet::ConstLanelet> adjacent_right;        // non-routable right lanelet
+  boost::optional<lanelet::ConstLanelet> left;                  // routable left lanelet
+  boost::optional<lanelet::ConstLanelet> adjacent_left;         // non-routable left lanelet
+  int num_lane_to_preferred{0};                                 // getNumLaneToPreferredLane
+  double length{0.0};                                           // 3d length of the centerline
+  lanelet::traffic_rules::SpeedLimitInformation speed_limit;
+};
+
+/**
+ * @brief Lanelets of the route and their relations, computed once when the route or the map is
+ * set instead of from the routing graph and searches over the route lanelets on every query. The
+ * lanelet sequences queried on the route are kept as well until the cache is built again, and the
+ * bounding boxes of the lanelets are indexed for the closest lanelet queries.
+ */
+class RouteLaneletCache
+{
+public:
+  enum class SequenceType { AFTER, UP_TO, LANE };
+
+  RouteLaneletCache() = default;
+  RouteLaneletCache(
+    const lanelet::ConstLanelets & route_lanelets, const lanelet::ConstLanelets & start_lanelets,
+    const lanelet::ConstLanelets & goal_lanelets,
+    const lanelet::ConstLanelets & preferred_lanelets);
+
+  bool isRouteLanelet(const lanelet::ConstLanelet & lanelet) const
+  {
+    return route_ids_.count(lanelet.id()) != 0;
+  }
+  bool isStartLanelet(const lanelet::ConstLanelet & lanelet) const
+  {
+    return start_ids_.count(lanelet.id()) != 0;
+  }
+  bool isGoalLanelet(const lanelet::ConstLanelet & lanelet) const
+  {
+    return goal_ids_.count(lanelet.id()) != 0;
+  }
+  bool isPreferredLanelet(const lanelet::ConstLanelet & lanelet) const
+  {
+    return preferred_ids_.count(lanelet.id()) != 0;
+  }
+
+  /**
+   * @brief Get the relations of the lanelet
+   * @return the relations, or nullptr if they are not set
+   */
+  const RouteLaneletRelations * getRelations(const lanelet::ConstLanelet & lanelet) const;
+  void setRelations(const lanelet::ConstLanelet & lanelet, const RouteLaneletRelations & relations);
+
+  /**
+   * @brief Get the route lanelets which may be the closest to the point, which are the ones whose
+   * distance is within a tolerance of the closest one or less
+   * @return the candidate lanelets in the order of the route lanelets
+   */
+  lanelet::ConstLanelets getClosestLaneletCandidates(const geometry_msgs::msg::Point & point) const;
+
+  /**
+   * @brief Get the route lanelets whose bounding box is within the distance from the point
+   * @return the candidate lanelets in the order of the route lanelets
+   */
+  lanelet::ConstLanelets getLaneletsWithinDistance(
+    const geometry_msgs::msg::Point & point, const double distance) const;
+
+  /**
+   * @brief Get the lanelet sequence of type from the lanelet for the length, computed by
+   * calc_sequence if it is not kept yet
+   */
+  template <class F>
+  lanelet::ConstLanelets getLaneletSequence(
+    const SequenceType type, const lanelet::ConstLanelet & lanelet, const double length,
+    const F & calc_sequence) const
+  {
+    const auto key = std::make_tuple(type, lanelet.id(), length);
+    {
+      std::lock_guard<std::mutex> lock(sequences_->mutex);
+      const auto itr = sequences_->sequences.find(key);
+      if (itr != sequences_->sequences.end()) {
+        return itr->second;
+      }
+    }
+
+    const auto sequence = calc_sequence();
+    std::lock_guard<std::mutex> lock(sequences_->mutex);
+    // the lengths of the queries may differ every cycle, e.g. with the velocity
+    if (sequences_->sequences.size() >= max_sequence_num_) {
+      sequences_->sequences.clear();
+    }
+    sequences_->sequences.emplace(key, sequence);
+    return sequence;
+  }
+
+private:
+  using Box2d = tier4_autoware_utils::Box2d;
+  using RTree =
+    boost::geometry::index::rtree<std::pair<Box2d, size_t>, boost::geometry::index::rstar<16>>;
+
+  lanelet::ConstLanelets getLanelets(std::vector<size_t> indices) const;
+
+  struct Sequences
+  {
+    std::mutex mutex;
+    std::map<std::tuple<SequenceType, lanelet::Id, double>, lanelet::ConstLanelets> sequences;
+  };
+
+  static constexpr size_t max_sequence_num_{1000};
+
+  std::unordered_set<lanelet::Id> route_ids_;
+  std::unordered_set<lanelet::Id> start_ids_;
+  std::unordered_set<lanelet::Id> goal_ids_;
+  std::unordered_set<lanelet::Id> preferred_ids_;
+  std::unordered_map<lanelet::Id, RouteLaneletRelations> relations_;
+  lanelet::ConstLanelets route_lanelets_;
+  RTree rtree_;  // bounding boxes of route_lanelets_ with their indices
+  // shared with the copies of the cache, which are built for the same route
+  std::shared_ptr<Sequences> sequences_{std::make_shared<Sequences>()};
+};
+}  // namespace route_handler
+#endif  // ROUTE_HANDLER__ROUTE_LANELET_CACHE_HPP_
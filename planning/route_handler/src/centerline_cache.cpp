@@ -0,0 +1,103 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "route_handler/centerline_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace route_handler
+{
+CenterlineCache::CenterlineCache(const lanelet::ConstLanelets & lanelets, const double resolution)
+: resolution_(resolution)
+{
+  centerlines_.reserve(lanelets.size());
+  for (const auto & lanelet : lanelets) {
+    centerlines_.emplace(
+      lanelet.id(),
+      std::make_shared<const LaneletCenterline>(resampleCenterline(lanelet, resolution_)));
+  }
+}
+
+std::shared_ptr<const LaneletCenterline> CenterlineCache::getCenterline(
+  const lanelet::ConstLanelet & lanelet) const
+{
+  const auto itr = centerlines_.find(lanelet.id());
+  if (itr != centerlines_.end()) {
+    return itr->second;
+  }
+  return std::make_shared<const LaneletCenterline>(resampleCenterline(lanelet, resolution_));
+}
+
+LaneletCenterline CenterlineCache::resampleCenterline(
+  const lanelet::ConstLanelet & lanelet, const double resolution)
+{
+  LaneletCenterline output;
+  const auto centerline = lanelet.centerline();
+  if (centerline.empty()) {
+    return output;
+  }
+  // a single point centerline has no direction
+  if (centerline.size() == 1) {
+    geometry_msgs::msg::Point p;
+    p.x = centerline.front().x();
+    p.y = centerline.front().y();
+    p.z = centerline.front().z();
+    output.points.push_back(p);
+    output.arc_lengths.push_back(0.0);
+    output.yaws.push_back(0.0);
+    return output;
+  }
+
+  // arc length of the vertices
+  std::vector<double> vertex_arc_lengths(centerline.size(), 0.0);
+  for (size_t i = 1; i < centerline.size(); ++i) {
+    const double dx = centerline[i].x() - centerline[i - 1].x();
+    const double dy = centerline[i].y() - centerline[i - 1].y();
+    vertex_arc_lengths.at(i) = vertex_arc_lengths.at(i - 1) + std::hypot(dx, dy);
+  }
+  const double length = vertex_arc_lengths.back();
+  const size_t num_segments = std::max(1, static_cast<int>(std::ceil(length / resolution)));
+
+  output.points.reserve(num_segments + 1);
+  output.arc_lengths.reserve(num_segments + 1);
+  output.yaws.reserve(num_segments + 1);
+  size_t segment_idx = 0;
+  for (size_t i = 0; i <= num_segments; ++i) {
+    const double s = length * static_cast<double>(i) / static_cast<double>(num_segments);
+    while (segment_idx + 2 < centerline.size() && vertex_arc_lengths.at(segment_idx + 1) < s) {
+      ++segment_idx;
+    }
+    const auto & p0 = centerline[segment_idx];
+    const auto & p1 = centerline[segment_idx + 1];
+    const double segment_length =
+      vertex_arc_lengths.at(segment_idx + 1) - vertex_arc_lengths.at(segment_idx);
+    const double ratio =
+      segment_length < 1e-6
+        ? 0.0
+        : std::clamp((s - vertex_arc_lengths.at(segment_idx)) / segment_length, 0.0, 1.0);
+    geometry_msgs::msg::Point p;
+    p.x = p0.x() + ratio * (p1.x() - p0.x());
+    p.y = p0.y() + ratio * (p1.y() - p0.y());
+    p.z = p0.z() + ratio * (p1.z() - p0.z());
+    output.points.push_back(p);
+    output.arc_lengths.push_back(s);
+    output.yaws.push_back(std::atan2(p1.y() - p0.y(), p1.x() - p0.x()));
+  }
+  return output;
+}
+}  // namespace route_handler
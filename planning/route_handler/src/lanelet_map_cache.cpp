@@ -0,0 +1,93 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "route_handler/lanelet_map_cache.hpp"
+
+#include <lanelet2_extension/utility/message_conversion.hpp>
+
+#include <lanelet2_traffic_rules/TrafficRulesFactory.h>
+
+#include <functional>
+#include <string_view>
+
+namespace route_handler
+{
+std::mutex LaneletMapCache::mutex_;
+LaneletMapCache::Entry LaneletMapCache::entry_;
+
+lanelet::LaneletMapPtr LaneletMapCache::lockLaneletMap(const HADMapBin & map_msg)
+{
+  // hashing the data takes a fraction of the time its deserialization would
+  const std::size_t hash = std::hash<std::string_view>{}(std::string_view(
+    reinterpret_cast<const char *>(map_msg.data.data()), map_msg.data.size()));
+  if (hash == entry_.hash && map_msg.data.size() == entry_.size) {
+    if (auto lanelet_map = entry_.lanelet_map.lock()) {
+      return lanelet_map;
+    }
+  }
+
+  // only one map is cached, the one of the latest message
+  auto lanelet_map = std::make_shared<lanelet::LaneletMap>();
+  lanelet::utils::conversion::fromBinMsg(map_msg, lanelet_map);
+  entry_ = Entry{};
+  entry_.hash = hash;
+  entry_.size = map_msg.data.size();
+  entry_.lanelet_map = lanelet_map;
+  return lanelet_map;
+}
+
+lanelet::LaneletMapPtr LaneletMapCache::getLaneletMap(const HADMapBin & map_msg)
+{
+  std::scoped_lock lock(mutex_);
+  return lockLaneletMap(map_msg);
+}
+
+lanelet::LaneletMapPtr LaneletMapCache::getLaneletMap(
+  const HADMapBin & map_msg, lanelet::traffic_rules::TrafficRulesPtr * traffic_rules,
+  lanelet::routing::RoutingGraphPtr * routing_graph)
+{
+  std::scoped_lock lock(mutex_);
+  auto lanelet_map = lockLaneletMap(map_msg);
+
+  auto rules = entry_.traffic_rules.lock();
+  auto graph = entry_.routing_graph.lock();
+  if (!rules || !graph) {
+    rules = lanelet::traffic_rules::TrafficRulesFactory::create(
+      lanelet::Locations::Germany, lanelet::Participants::Vehicle);
+    graph = lanelet::routing::RoutingGraph::build(*lanelet_map, *rules);
+    entry_.traffic_rules = rules;
+    entry_.routing_graph = graph;
+  }
+  *traffic_rules = rules;
+  *routing_graph = graph;
+  return lanelet_map;
+}
+
+lanelet::routing::RoutingGraphPtr LaneletMapCache::getPedestrianRoutingGraph(
+  const HADMapBin & map_msg)
+{
+  std::scoped_lock lock(mutex_);
+  const auto lanelet_map = lockLaneletMap(map_msg);
+
+  auto graph = entry_.pedestrian_routing_graph.lock();
+  if (!graph) {
+    const lanelet::traffic_rules::TrafficRulesPtr rules =
+      lanelet::traffic_rules::TrafficRulesFactory::create(
+        lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
+    graph = lanelet::routing::RoutingGraph::build(*lanelet_map, *rules);
+    entry_.pedestrian_routing_graph = graph;
+  }
+  return graph;
+}
+}  // namespace route_handler
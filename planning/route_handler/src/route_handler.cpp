@@ -14,6 +14,8 @@
 
 #include "route_handler/route_handler.hpp"
 
+#include "route_handler/lanelet_map_cache.hpp"
+
 #include <lanelet2_extension/utility/message_conversion.hpp>
 #include <lanelet2_extension/utility/query.hpp>
 #include <lanelet2_extension/utility/route_checker.hpp>
@@ -174,18 +176,14 @@ RouteHandler::RouteHandler(const HADMapBin & map_msg) { setMap(map_msg); }
 
 void RouteHandler::setMap(const HADMapBin & map_msg)
 {
-  lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
-  lanelet::utils::conversion::fromBinMsg(
-    map_msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
+  // the map and the graphs are shared with the other users of the map in the process
+  lanelet_map_ptr_ =
+    LaneletMapCache::getLaneletMap(map_msg, &traffic_rules_ptr_, &routing_graph_ptr_);
 
-  const auto traffic_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
-    lanelet::Locations::Germany, lanelet::Participants::Vehicle);
-  const auto pedestrian_rules = lanelet::traffic_rules::TrafficRulesFactory::create(
-    lanelet::Locations::Germany, lanelet::Participants::Pedestrian);
-  lanelet::routing::RoutingGraphConstPtr vehicle_graph =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *traffic_rules);
+  // the vehicle graph of fromBinMsg is built with the same traffic rules
+  lanelet::routing::RoutingGraphConstPtr vehicle_graph = routing_graph_ptr_;
   lanelet::routing::RoutingGraphConstPtr pedestrian_graph =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *pedestrian_rules);
+    LaneletMapCache::getPedestrianRoutingGraph(map_msg);
   lanelet::routing::RoutingGraphContainer overall_graphs({vehicle_graph, pedestrian_graph});
   overall_graphs_ptr_ =
     std::make_shared<const lanelet::routing::RoutingGraphContainer>(overall_graphs);
@@ -193,6 +191,12 @@ void RouteHandler::setMap(const HADMapBin & map_msg)
   road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
   shoulder_lanelets_ = lanelet::utils::query::shoulderLanelets(all_lanelets);
 
+  lanelet::ConstLanelets centerline_lanelets = road_lanelets_;
+  centerline_lanelets.insert(
+    centerline_lanelets.end(), shoulder_lanelets_.begin(), shoulder_lanelets_.end());
+  centerline_cache_ = CenterlineCache(centerline_lanelets, centerline_resolution_);
+  route_lanelet_cache_ = RouteLaneletCache();
+
   is_map_msg_ready_ = true;
   is_handler_ready_ = false;
 
@@ -311,6 +315,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
   for (const auto & id : route_lanelets_id) {
     route_lanelets_.push_back(lanelet_map_ptr_->laneletLayer.get(id));
   }
+  updateRouteLaneletCache();
   is_handler_ready_ = true;
 }
 
@@ -323,6 +328,7 @@ void RouteHandler::setLaneletsFromRouteMsg()
   preferred_lanelets_.clear();
   bool is_route_valid = lanelet::utils::route::isRouteValid(route_msg_, lanelet_map_ptr_);
   if (!is_route_valid) {
+    updateRouteLaneletCache();
     return;
   }
   for (const auto & route_section : route_msg_.segments) {
@@ -349,9 +355,41 @@ void RouteHandler::setLaneletsFromRouteMsg()
       start_lanelets_.push_back(llt);
     }
   }
+  updateRouteLaneletCache();
   is_handler_ready_ = true;
 }
 
+void RouteHandler::updateRouteLaneletCache()
+{
+  route_lanelet_cache_ =
+    RouteLaneletCache(route_lanelets_, start_lanelets_, goal_lanelets_, preferred_lanelets_);
+
+  // the relations are computed by the queries below, which use only the lanelets until then
+  for (const auto & lanelet : route_lanelets_) {
+    RouteLaneletRelations relations;
+    lanelet::ConstLanelet related_lanelet;
+    if (getNextLaneletWithinRoute(lanelet, &related_lanelet)) {
+      relations.next = related_lanelet;
+    }
+    if (getNextLaneletWithinRouteExceptStart(lanelet, &related_lanelet)) {
+      relations.next_except_start = related_lanelet;
+    }
+    getPreviousLaneletsWithinRoute(lanelet, &relations.previous);
+    if (getPreviousLaneletWithinRouteExceptGoal(lanelet, &related_lanelet)) {
+      relations.previous_except_goal = related_lanelet;
+    }
+    relations.neighbors = getNeighborsWithinRoute(lanelet);
+    relations.right = routing_graph_ptr_->right(lanelet);
+    relations.adjacent_right = routing_graph_ptr_->adjacentRight(lanelet);
+    relations.left = routing_graph_ptr_->left(lanelet);
+    relations.adjacent_left = routing_graph_ptr_->adjacentLeft(lanelet);
+    relations.num_lane_to_preferred = getNumLaneToPreferredLane(lanelet);
+    relations.length = getLaneletLength(lanelet);
+    relations.speed_limit = getSpeedLimit(lanelet);
+    route_lanelet_cache_.setRelations(lanelet, relations);
+  }
+}
+
 lanelet::ConstPolygon3d RouteHandler::getIntersectionAreaById(const lanelet::Id id) const
 {
   return lanelet_map_ptr_->polygonLayer.get(id);
@@ -489,73 +527,80 @@ bool RouteHandler::isDeadEndLanelet(const lanelet::ConstLanelet & lanelet) const
 lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
-  lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
-    return lanelet_sequence_forward;
+  if (!route_lanelet_cache_.isRouteLanelet(lanelet)) {
+    return {};
   }
 
-  double length = 0;
-  lanelet::ConstLanelet current_lanelet = lanelet;
-  while (rclcpp::ok() && length < min_length) {
-    lanelet::ConstLanelet next_lanelet;
-    if (!getNextLaneletWithinRoute(current_lanelet, &next_lanelet)) {
-      break;
+  const auto calc_sequence = [&]() {
+    lanelet::ConstLanelets lanelet_sequence_forward;
+    double length = 0;
+    lanelet::ConstLanelet current_lanelet = lanelet;
+    while (rclcpp::ok() && length < min_length) {
+      lanelet::ConstLanelet next_lanelet;
+      if (!getNextLaneletWithinRoute(current_lanelet, &next_lanelet)) {
+        break;
+      }
+      lanelet_sequence_forward.push_back(next_lanelet);
+      current_lanelet = next_lanelet;
+      length += getLaneletLength(next_lanelet);
     }
-    lanelet_sequence_forward.push_back(next_lanelet);
-    current_lanelet = next_lanelet;
-    length += boost::geometry::length(next_lanelet.centerline().basicLineString());
-  }
-
-  return lanelet_sequence_forward;
+    return lanelet_sequence_forward;
+  };
+  return route_lanelet_cache_.getLaneletSequence(
+    RouteLaneletCache::SequenceType::AFTER, lanelet, min_length, calc_sequence);
 }
 
 lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
-  lanelet::ConstLanelets lanelet_sequence_backward;
-  if (!exists(route_lanelets_, lanelet)) {
-    return lanelet_sequence_backward;
+  if (!route_lanelet_cache_.isRouteLanelet(lanelet)) {
+    return {};
   }
 
-  lanelet::ConstLanelet current_lanelet = lanelet;
-  double length = 0;
-  while (rclcpp::ok() && length < min_length) {
-    lanelet::ConstLanelets candidate_lanelets;
-    if (!getPreviousLaneletsWithinRoute(current_lanelet, &candidate_lanelets)) {
-      break;
-    }
-
-    // If lanelet_sequence_backward with input lanelet contains all candidate lanelets,
-    // break the loop.
-    if (std::all_of(
-          candidate_lanelets.begin(), candidate_lanelets.end(),
-          [lanelet_sequence_backward, lanelet](auto & prev_llt) {
-            return std::any_of(
-              lanelet_sequence_backward.begin(), lanelet_sequence_backward.end(),
-              [prev_llt, lanelet](auto & llt) {
-                return (llt.id() == prev_llt.id() || lanelet.id() == prev_llt.id());
-              });
-          })) {
-      break;
-    }
+  const auto calc_sequence = [&]() {
+    lanelet::ConstLanelets lanelet_sequence_backward;
+    lanelet::ConstLanelet current_lanelet = lanelet;
+    double length = 0;
+    while (rclcpp::ok() && length < min_length) {
+      lanelet::ConstLanelets candidate_lanelets;
+      if (!getPreviousLaneletsWithinRoute(current_lanelet, &candidate_lanelets)) {
+        break;
+      }
 
-    for (const auto & prev_lanelet : candidate_lanelets) {
-      if (std::any_of(
-            lanelet_sequence_backward.begin(), lanelet_sequence_backward.end(),
-            [prev_lanelet, lanelet](auto & llt) {
-              return (llt.id() == prev_lanelet.id() || lanelet.id() == prev_lanelet.id());
+      // If lanelet_sequence_backward with input lanelet contains all candidate lanelets,
+      // break the loop.
+      if (std::all_of(
+            candidate_lanelets.begin(), candidate_lanelets.end(),
+            [&lanelet_sequence_backward, &lanelet](auto & prev_llt) {
+              return std::any_of(
+                lanelet_sequence_backward.begin(), lanelet_sequence_backward.end(),
+                [&prev_llt, &lanelet](auto & llt) {
+                  return (llt.id() == prev_llt.id() || lanelet.id() == prev_llt.id());
+                });
             })) {
-        continue;
+        break;
+      }
+
+      for (const auto & prev_lanelet : candidate_lanelets) {
+        if (std::any_of(
+              lanelet_sequence_backward.begin(), lanelet_sequence_backward.end(),
+              [&prev_lanelet, &lanelet](auto & llt) {
+                return (llt.id() == prev_lanelet.id() || lanelet.id() == prev_lanelet.id());
+              })) {
+          continue;
+        }
+        lanelet_sequence_backward.push_back(prev_lanelet);
+        length += getLaneletLength(prev_lanelet);
+        current_lanelet = prev_lanelet;
+        break;
       }
-      lanelet_sequence_backward.push_back(prev_lanelet);
-      length += boost::geometry::length(prev_lanelet.centerline().basicLineString());
-      current_lanelet = prev_lanelet;
-      break;
     }
-  }
 
-  std::reverse(lanelet_sequence_backward.begin(), lanelet_sequence_backward.end());
-  return lanelet_sequence_backward;
+    std::reverse(lanelet_sequence_backward.begin(), lanelet_sequence_backward.end());
+    return lanelet_sequence_backward;
+  };
+  return route_lanelet_cache_.getLaneletSequence(
+    RouteLaneletCache::SequenceType::UP_TO, lanelet, min_length, calc_sequence);
 }
 
 lanelet::ConstLanelets RouteHandler::getLaneletSequence(
@@ -571,7 +616,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequence(
   lanelet::ConstLanelets lanelet_sequence;
   lanelet::ConstLanelets lanelet_sequence_backward;
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!route_lanelet_cache_.isRouteLanelet(lanelet)) {
     return lanelet_sequence;
   }
 
@@ -604,7 +649,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequence(
   lanelet::ConstLanelets lanelet_sequence;
   lanelet::ConstLanelets lanelet_sequence_backward;
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!route_lanelet_cache_.isRouteLanelet(lanelet)) {
     return lanelet_sequence;
   }
 
@@ -768,18 +813,63 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequence(
 bool RouteHandler::getClosestLaneletWithinRoute(
   const Pose & search_pose, lanelet::ConstLanelet * closest_lanelet) const
 {
-  return lanelet::utils::query::getClosestLanelet(route_lanelets_, search_pose, closest_lanelet);
+  // only the candidates can be the closest, so the result is the same as of all route lanelets
+  return lanelet::utils::query::getClosestLanelet(
+    route_lanelet_cache_.getClosestLaneletCandidates(search_pose.position), search_pose,
+    closest_lanelet);
+}
+
+bool RouteHandler::getClosestLaneletWithinRoute(
+  const Pose & search_pose, lanelet::ConstLanelet * closest_lanelet, const double dist_threshold,
+  const double yaw_threshold) const
+{
+  const lanelet::BasicPoint2d search_point(search_pose.position.x, search_pose.position.y);
+  const double pose_yaw = tf2::getYaw(search_pose.orientation);
+
+  bool is_found = false;
+  double min_distance = std::numeric_limits<double>::max();
+  double min_yaw_diff = std::numeric_limits<double>::max();
+  for (const auto & llt :
+       route_lanelet_cache_.getLaneletsWithinDistance(search_pose.position, dist_threshold)) {
+    const double distance = boost::geometry::distance(llt.polygon2d().basicPolygon(), search_point);
+    if (distance > dist_threshold || distance > min_distance) {
+      continue;
+    }
+
+    const double lane_yaw = lanelet::utils::getLaneletAngle(llt, search_pose.position);
+    const double yaw_diff = std::abs(tier4_autoware_utils::normalizeRadian(lane_yaw - pose_yaw));
+    if (yaw_diff > yaw_threshold) {
+      continue;
+    }
+    if (distance == min_distance && yaw_diff >= min_yaw_diff) {
+      continue;
+    }
+
+    min_distance = distance;
+    min_yaw_diff = yaw_diff;
+    *closest_lanelet = llt;
+    is_found = true;
+  }
+  return is_found;
 }
 
 bool RouteHandler::getNextLaneletWithinRoute(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * next_lanelet) const
 {
-  if (exists(goal_lanelets_, lanelet)) {
+  if (const auto relations = route_lanelet_cache_.getRelations(lanelet)) {
+    if (!relations->next) {
+      return false;
+    }
+    *next_lanelet = *relations->next;
+    return true;
+  }
+
+  if (route_lanelet_cache_.isGoalLanelet(lanelet)) {
     return false;
   }
   lanelet::ConstLanelets following_lanelets = routing_graph_ptr_->following(lanelet);
   for (const auto & llt : following_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (route_lanelet_cache_.isRouteLanelet(llt)) {
       *next_lanelet = llt;
       return true;
     }
@@ -795,13 +885,17 @@ lanelet::ConstLanelets RouteHandler::getNextLanelets(const lanelet::ConstLanelet
 bool RouteHandler::getPreviousLaneletsWithinRoute(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelets * prev_lanelets) const
 {
-  if (exists(start_lanelets_, lanelet)) {
+  if (route_lanelet_cache_.isStartLanelet(lanelet)) {
     return false;
   }
+  if (const auto relations = route_lanelet_cache_.getRelations(lanelet)) {
+    *prev_lanelets = relations->previous;
+    return !(prev_lanelets->empty());
+  }
   lanelet::ConstLanelets candidate_lanelets = routing_graph_ptr_->previous(lanelet);
   prev_lanelets->clear();
   for (const auto & llt : candidate_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (route_lanelet_cache_.isRouteLanelet(llt)) {
       prev_lanelets->push_back(llt);
     }
   }
@@ -819,7 +913,7 @@ bool RouteHandler::getRightLaneletWithinRoute(
   auto opt_right_lanelet = routing_graph_ptr_->right(lanelet);
   if (!!opt_right_lanelet) {
     *right_lanelet = opt_right_lanelet.get();
-    return exists(route_lanelets_, *right_lanelet);
+    return route_lanelet_cache_.isRouteLanelet(*right_lanelet);
   } else {
     return false;
   }
@@ -828,12 +922,20 @@ bool RouteHandler::getRightLaneletWithinRoute(
 bool RouteHandler::getNextLaneletWithinRouteExceptStart(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * next_lanelet) const
 {
-  if (exists(goal_lanelets_, lanelet)) {
+  if (const auto relations = route_lanelet_cache_.getRelations(lanelet)) {
+    if (!relations->next_except_start) {
+      return false;
+    }
+    *next_lanelet = *relations->next_except_start;
+    return true;
+  }
+
+  if (route_lanelet_cache_.isGoalLanelet(lanelet)) {
     return false;
   }
   lanelet::ConstLanelets following_lanelets = routing_graph_ptr_->following(lanelet);
   for (const auto & llt : following_lanelets) {
-    if (exists(route_lanelets_, llt) && !exists(start_lanelets_, llt)) {
+    if (route_lanelet_cache_.isRouteLanelet(llt) && !route_lanelet_cache_.isStartLanelet(llt)) {
       *next_lanelet = llt;
       return true;
     }
@@ -844,12 +946,20 @@ bool RouteHandler::getNextLaneletWithinRouteExceptStart(
 bool RouteHandler::getPreviousLaneletWithinRouteExceptGoal(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelet * prev_lanelet) const
 {
-  if (exists(start_lanelets_, lanelet)) {
+  if (const auto relations = route_lanelet_cache_.getRelations(lanelet)) {
+    if (!relations->previous_except_goal) {
+      return false;
+    }
+    *prev_lanelet = *relations->previous_except_goal;
+    return true;
+  }
+
+  if (route_lanelet_cache_.isStartLanelet(lanelet)) {
     return false;
   }
   lanelet::ConstLanelets previous_lanelets = routing_graph_ptr_->previous(lanelet);
   for (const auto & llt : previous_lanelets) {
-    if (exists(route_lanelets_, llt) && !(exists(goal_lanelets_, llt))) {
+    if (route_lanelet_cache_.isRouteLanelet(llt) && !(route_lanelet_cache_.isGoalLanelet(llt))) {
       *prev_lanelet = llt;
       return true;
     }
@@ -892,6 +1002,10 @@ bool RouteHandler::isBijectiveConnection(
 boost::optional<lanelet::ConstLanelet> RouteHandler::getRightLanelet(
   const lanelet::ConstLanelet & lanelet) const
 {
+  if (const auto relations = route_lanelet_cache_.getRelations(lanelet)) {
+    return relations->right ? relations->right : relations->adjacent_right;
+  }
+
   // routable lane
   const auto & right_lane = routing_graph_ptr_->right(lanelet);
   if (right_lane) {
@@ -909,7 +1023,7 @@ bool RouteHandler::getLeftLaneletWithinRoute(
   auto opt_left_lanelet = routing_graph_ptr_->left(lanelet);
   if (!!opt_left_lanelet) {
     *left_lanelet = opt_left_lanelet.get();
-    return exists(route_lanelets_, *left_lanelet);
+    return route_lanelet_cache_.isRouteLanelet(*left_lanelet);
   } else {
     return false;
   }
@@ -918,6 +1032,10 @@ bool RouteHandler::getLeftLaneletWithinRoute(
 boost::optional<lanelet::ConstLanelet> RouteHandler::getLeftLanelet(
   const lanelet::ConstLanelet & lanelet) const
 {
+  if (const auto relations = route_lanelet_cache_.getRelations(lanelet)) {
+    return relations->left ? relations->left : relations->adjacent_left;
+  }
+
   // routable lane
   const auto & left_lane = routing_graph_ptr_->left(lanelet);
   if (left_lane) {
@@ -1105,9 +1223,10 @@ bool RouteHandler::getLaneChangeTarget(
       continue;
     }
 
+    const auto relations = route_lanelet_cache_.getRelations(lanelet);
     if (num < 0) {
-      if (!!routing_graph_ptr_->right(lanelet)) {
-        auto right_lanelet = routing_graph_ptr_->right(lanelet);
+      const auto right_lanelet = relations ? relations->right : routing_graph_ptr_->right(lanelet);
+      if (!!right_lanelet) {
         *target_lanelet = right_lanelet.get();
         return true;
       } else {
@@ -1116,8 +1235,8 @@ bool RouteHandler::getLaneChangeTarget(
     }
 
     if (num > 0) {
-      if (!!routing_graph_ptr_->left(lanelet)) {
-        auto left_lanelet = routing_graph_ptr_->left(lanelet);
+      const auto left_lanelet = relations ? relations->left : routing_graph_ptr_->left(lanelet);
+      if (!!left_lanelet) {
         *target_lanelet = left_lanelet.get();
         return true;
       } else {
@@ -1167,15 +1286,19 @@ lanelet::ConstLanelets RouteHandler::getClosestLaneletSequence(const Pose & pose
 
 int RouteHandler::getNumLaneToPreferredLane(const lanelet::ConstLanelet & lanelet) const
 {
+  if (const auto relations = route_lanelet_cache_.getRelations(lanelet)) {
+    return relations->num_lane_to_preferred;
+  }
+
   int num = 0;
-  if (exists(preferred_lanelets_, lanelet)) {
+  if (route_lanelet_cache_.isPreferredLanelet(lanelet)) {
     return num;
   }
   const auto & right_lanes =
     lanelet::utils::query::getAllNeighborsRight(routing_graph_ptr_, lanelet);
   for (const auto & right : right_lanes) {
     num--;
-    if (exists(preferred_lanelets_, right)) {
+    if (route_lanelet_cache_.isPreferredLanelet(right)) {
       return num;
     }
   }
@@ -1183,7 +1306,7 @@ int RouteHandler::getNumLaneToPreferredLane(const lanelet::ConstLanelet & lanele
   num = 0;
   for (const auto & left : left_lanes) {
     num++;
-    if (exists(preferred_lanelets_, left)) {
+    if (route_lanelet_cache_.isPreferredLanelet(left)) {
       return num;
     }
   }
@@ -1197,7 +1320,24 @@ bool RouteHandler::isInPreferredLane(const PoseStamped & pose) const
   if (!getClosestLaneletWithinRoute(pose.pose, &lanelet)) {
     return false;
   }
-  return exists(preferred_lanelets_, lanelet);
+  return route_lanelet_cache_.isPreferredLanelet(lanelet);
+}
+
+double RouteHandler::getLaneletLength(const lanelet::ConstLanelet & lanelet) const
+{
+  if (const auto relations = route_lanelet_cache_.getRelations(lanelet)) {
+    return relations->length;
+  }
+  return boost::geometry::length(lanelet.centerline().basicLineString());
+}
+
+lanelet::traffic_rules::SpeedLimitInformation RouteHandler::getSpeedLimit(
+  const lanelet::ConstLanelet & lanelet) const
+{
+  if (const auto relations = route_lanelet_cache_.getRelations(lanelet)) {
+    return relations->speed_limit;
+  }
+  return traffic_rules_ptr_->speedLimit(lanelet);
 }
 bool RouteHandler::isInTargetLane(
   const PoseStamped & pose, const lanelet::ConstLanelets & target) const
@@ -1217,7 +1357,7 @@ PathWithLaneId RouteHandler::getCenterLinePath(
   double s = 0;
 
   for (const auto & llt : lanelet_sequence) {
-    lanelet::traffic_rules::SpeedLimitInformation limit = traffic_rules_ptr_->speedLimit(llt);
+    lanelet::traffic_rules::SpeedLimitInformation limit = getSpeedLimit(llt);
     const lanelet::ConstLineString3d centerline = llt.centerline();
 
     const auto addPathPoint = [&reference_path, &limit, &llt](const auto & pt) {
@@ -1290,7 +1430,7 @@ PathWithLaneId RouteHandler::updatePathTwist(const PathWithLaneId & path) const
   for (auto & point : updated_path.points) {
     const auto id = point.lane_ids.at(0);
     const auto llt = lanelet_map_ptr_->laneletLayer.get(id);
-    lanelet::traffic_rules::SpeedLimitInformation limit = traffic_rules_ptr_->speedLimit(llt);
+    lanelet::traffic_rules::SpeedLimitInformation limit = getSpeedLimit(llt);
     point.point.longitudinal_velocity_mps = limit.speedLimit.value();
   }
   return updated_path;
@@ -1306,15 +1446,11 @@ lanelet::ConstLanelets RouteHandler::getLaneChangeTargetLanes(const Pose & pose)
 
   int num = getNumLaneToPreferredLane(lanelet);
   if (num < 0) {
-    auto right_lanelet = (!!routing_graph_ptr_->right(lanelet))
-                           ? routing_graph_ptr_->right(lanelet)
-                           : routing_graph_ptr_->adjacentRight(lanelet);
+    auto right_lanelet = getRightLanelet(lanelet);
     target_lanelets = getLaneletSequence(right_lanelet.get());
   }
   if (num > 0) {
-    auto left_lanelet = (!!routing_graph_ptr_->left(lanelet))
-                          ? routing_graph_ptr_->left(lanelet)
-                          : routing_graph_ptr_->adjacentLeft(lanelet);
+    auto left_lanelet = getLeftLanelet(lanelet);
     target_lanelets = getLaneletSequence(left_lanelet.get());
   }
   return target_lanelets;
@@ -1483,7 +1619,7 @@ lanelet::ConstLanelets RouteHandler::getPreviousLaneletSequence(
   }
 
   auto first_lane = lanelet_sequence.front();
-  if (exists(start_lanelets_, first_lane)) {
+  if (route_lanelet_cache_.isStartLanelet(first_lane)) {
     return previous_lanelet_sequence;
   }
 
@@ -1508,20 +1644,26 @@ lanelet::ConstLanelets RouteHandler::getPreviousLaneletSequence(
 
 lanelet::ConstLanelets RouteHandler::getLaneSequence(const lanelet::ConstLanelet & lanelet) const
 {
-  lanelet::ConstLanelets lane_sequence;
-  lanelet::ConstLanelets lane_sequence_up_to = getLaneSequenceUpTo(lanelet);
-  lanelet::ConstLanelets lane_sequence_after = getLaneSequenceAfter(lanelet);
+  const auto calc_sequence = [&]() {
+    lanelet::ConstLanelets lane_sequence;
+    lanelet::ConstLanelets lane_sequence_up_to = getLaneSequenceUpTo(lanelet);
+    lanelet::ConstLanelets lane_sequence_after = getLaneSequenceAfter(lanelet);
 
-  lane_sequence.insert(lane_sequence.end(), lane_sequence_up_to.begin(), lane_sequence_up_to.end());
-  lane_sequence.insert(lane_sequence.end(), lane_sequence_after.begin(), lane_sequence_after.end());
-  return lane_sequence;
+    lane_sequence.insert(
+      lane_sequence.end(), lane_sequence_up_to.begin(), lane_sequence_up_to.end());
+    lane_sequence.insert(
+      lane_sequence.end(), lane_sequence_after.begin(), lane_sequence_after.end());
+    return lane_sequence;
+  };
+  return route_lanelet_cache_.getLaneletSequence(
+    RouteLaneletCache::SequenceType::LANE, lanelet, 0.0, calc_sequence);
 }
 
 lanelet::ConstLanelets RouteHandler::getLaneSequenceUpTo(
   const lanelet::ConstLanelet & lanelet) const
 {
   lanelet::ConstLanelets lanelet_sequence_backward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!route_lanelet_cache_.isRouteLanelet(lanelet)) {
     return lanelet_sequence_backward;
   }
 
@@ -1576,7 +1718,7 @@ lanelet::ConstLanelets RouteHandler::getLaneSequenceAfter(
   const lanelet::ConstLanelet & lanelet) const
 {
   lanelet::ConstLanelets lane_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!route_lanelet_cache_.isRouteLanelet(lanelet)) {
     return lane_sequence_forward;
   }
   lane_sequence_forward.push_back(lanelet);
@@ -1603,11 +1745,15 @@ lanelet::ConstLanelets RouteHandler::getLaneSequenceAfter(
 lanelet::ConstLanelets RouteHandler::getNeighborsWithinRoute(
   const lanelet::ConstLanelet & lanelet) const
 {
+  if (const auto relations = route_lanelet_cache_.getRelations(lanelet)) {
+    return relations->neighbors;
+  }
+
   lanelet::ConstLanelets neighbor_lanelets =
     lanelet::utils::query::getAllNeighbors(routing_graph_ptr_, lanelet);
   lanelet::ConstLanelets neighbors_within_route;
   for (const auto & llt : neighbor_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (route_lanelet_cache_.isRouteLanelet(llt)) {
       neighbors_within_route.push_back(llt);
     }
   }
@@ -1712,4 +1858,9 @@ lanelet::ConstLanelets RouteHandler::getMainLanelets(
   return main_lanelets;
 }
 
+std::shared_ptr<const LaneletCenterline> RouteHandler::getCenterline(
+  const lanelet::ConstLanelet & lanelet) const
+{
+  return centerline_cache_.getCenterline(lanelet);
+}
 }  // namespace route_handler
@@ -0,0 +1,142 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "route_handler/route_lanelet_cache.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace route_handler
+{
+RouteLaneletCache::RouteLaneletCache(
+  const lanelet::ConstLanelets & route_lanelets, const lanelet::ConstLanelets & start_lanelets,
+  const lanelet::ConstLanelets & goal_lanelets, const lanelet::ConstLanelets & preferred_lanelets)
+{
+  const auto insert_ids = [](const auto & lanelets, auto & ids) {
+    ids.reserve(lanelets.size());
+    for (const auto & lanelet : lanelets) {
+      ids.insert(lanelet.id());
+    }
+  };
+  insert_ids(route_lanelets, route_ids_);
+  insert_ids(start_lanelets, start_ids_);
+  insert_ids(goal_lanelets, goal_ids_);
+  insert_ids(preferred_lanelets, preferred_ids_);
+  relations_.reserve(route_lanelets.size());
+
+  route_lanelets_ = route_lanelets;
+  std::vector<std::pair<Box2d, size_t>> boxes;
+  boxes.reserve(route_lanelets_.size());
+  for (size_t i = 0; i < route_lanelets_.size(); ++i) {
+    const auto polygon = route_lanelets_.at(i).polygon2d().basicPolygon();
+    if (polygon.empty()) {
+      continue;
+    }
+    Box2d box;
+    boost::geometry::assign_inverse(box);
+    for (const auto & p : polygon) {
+      boost::geometry::expand(box, tier4_autoware_utils::Point2d(p.x(), p.y()));
+    }
+    boxes.emplace_back(box, i);
+  }
+  // packed by the range constructor
+  rtree_ = RTree(boxes.begin(), boxes.end());
+}
+
+const RouteLaneletRelations * RouteLaneletCache::getRelations(
+  const lanelet::ConstLanelet & lanelet) const
+{
+  const auto itr = relations_.find(lanelet.id());
+  if (itr == relations_.end()) {
+    return nullptr;
+  }
+  return &itr->second;
+}
+
+void RouteLaneletCache::setRelations(
+  const lanelet::ConstLanelet & lanelet, const RouteLaneletRelations & relations)
+{
+  relations_[lanelet.id()] = relations;
+}
+
+lanelet::ConstLanelets RouteLaneletCache::getClosestLaneletCandidates(
+  const geometry_msgs::msg::Point & point) const
+{
+  if (rtree_.empty()) {
+    return {};
+  }
+
+  // comparable (squared) distance, larger than the tolerance of the ties of the closest lanelets
+  constexpr double tolerance = 1e-6;
+  const tier4_autoware_utils::Point2d search_point(point.x, point.y);
+  const lanelet::BasicPoint2d lanelet_point(point.x, point.y);
+
+  // the boxes are visited from the nearest, and their distances are not more than the ones of the
+  // lanelets
+  double min_distance = std::numeric_limits<double>::max();
+  std::vector<std::pair<size_t, double>> distances;
+  for (auto itr = rtree_.qbegin(boost::geometry::index::nearest(search_point, rtree_.size()));
+       itr != rtree_.qend(); ++itr) {
+    if (min_distance + tolerance < boost::geometry::comparable_distance(search_point, itr->first)) {
+      break;
+    }
+    const double distance = boost::geometry::comparable_distance(
+      route_lanelets_.at(itr->second).polygon2d().basicPolygon(), lanelet_point);
+    distances.emplace_back(itr->second, distance);
+    min_distance = std::min(min_distance, distance);
+  }
+
+  std::vector<size_t> indices;
+  for (const auto & index_distance : distances) {
+    if (index_distance.second <= min_distance + tolerance) {
+      indices.push_back(index_distance.first);
+    }
+  }
+  return getLanelets(indices);
+}
+
+lanelet::ConstLanelets RouteLaneletCache::getLaneletsWithinDistance(
+  const geometry_msgs::msg::Point & point, const double distance) const
+{
+  const tier4_autoware_utils::Point2d search_point(point.x, point.y);
+  const Box2d search_box(
+    tier4_autoware_utils::Point2d(point.x - distance, point.y - distance),
+    tier4_autoware_utils::Point2d(point.x + distance, point.y + distance));
+
+  std::vector<std::pair<Box2d, size_t>> values;
+  rtree_.query(boost::geometry::index::intersects(search_box), std::back_inserter(values));
+
+  std::vector<size_t> indices;
+  for (const auto & value : values) {
+    if (boost::geometry::distance(search_point, value.first) <= distance) {
+      indices.push_back(value.second);
+    }
+  }
+  return getLanelets(indices);
+}
+
+lanelet::ConstLanelets RouteLaneletCache::getLanelets(std::vector<size_t> indices) const
+{
+  std::sort(indices.begin(), indices.end());
+  lanelet::ConstLanelets lanelets;
+  lanelets.reserve(indices.size());
+  for (const size_t idx : indices) {
+    lanelets.push_back(route_lanelets_.at(idx));
+  }
+  return lanelets;
+}
+}  // namespace route_handler
@@ -16,6 +16,7 @@
 
 #include <lanelet2_extension/utility/message_conversion.hpp>
 #include <lanelet2_extension/utility/query.hpp>
+#include <route_handler/lanelet_map_cache.hpp>
 
 #include <lanelet2_core/geometry/BoundingBox.h>
 #include <lanelet2_core/geometry/Lanelet.h>
@@ -210,9 +211,9 @@ void ScenarioSelectorNode::updateCurrentScenario()
 void ScenarioSelectorNode::onMap(
   const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg)
 {
-  lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
-  lanelet::utils::conversion::fromBinMsg(
-    *msg, lanelet_map_ptr_, &traffic_rules_ptr_, &routing_graph_ptr_);
+  // shared with route_handler_, the map is deserialized once
+  lanelet_map_ptr_ = route_handler::LaneletMapCache::getLaneletMap(
+    *msg, &traffic_rules_ptr_, &routing_graph_ptr_);
   route_handler_ = std::make_shared<route_handler::RouteHandler>(*msg);
 }
 
@@ -23,9 +23,7 @@
 #include <boost/geometry/geometries/linestring.hpp>
 #include <boost/geometry/geometries/point_xy.hpp>
 
-#include <pcl/common/transforms.h>
-#include <pcl/point_cloud.h>
-#include <pcl_conversions/pcl_conversions.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 #ifdef ROS_DISTRO_GALACTIC
 #include <tf2_eigen/tf2_eigen.h>
 #else
@@ -33,6 +31,7 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
 #include <functional>
 #include <limits>
 #include <memory>
@@ -138,6 +137,31 @@ Polygon2d createSelfPolygon(const VehicleInfo & vehicle_info)
 
   return ego_polygon;
 }
+
+// The self polygon is a rectangle along the axes of base_link, so the distance to it is calculated
+// in closed form, which is the same as bg::distance including zero inside it.
+double calcDistanceToSelfPolygon(const VehicleInfo & vehicle_info, const double x, const double y)
+{
+  const double dx = std::max(
+    {vehicle_info.min_longitudinal_offset_m - x, 0.0, x - vehicle_info.max_longitudinal_offset_m});
+  const double dy = std::max(
+    {vehicle_info.min_lateral_offset_m - y, 0.0, y - vehicle_info.max_lateral_offset_m});
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+// radius around the object pose which contains the object polygon
+double calcObjectRadius(const Shape & shape)
+{
+  if (shape.type != Shape::POLYGON) {
+    return std::hypot(shape.dimensions.x / 2.0, shape.dimensions.y / 2.0);
+  }
+
+  double radius = 0.0;
+  for (const auto & p : shape.footprint.points) {
+    radius = std::max(radius, std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z));
+  }
+  return radius;
+}
 }  // namespace
 
 SurroundObstacleCheckerNode::SurroundObstacleCheckerNode(const rclcpp::NodeOptions & node_options)
@@ -343,20 +367,20 @@ boost::optional<Obstacle> SurroundObstacleCheckerNode::getNearestObstacleByPoint
     return {};
   }
 
-  Eigen::Affine3f isometry = tf2::transformToEigen(transform_stamped.get().transform).cast<float>();
-  pcl::PointCloud<pcl::PointXYZ> transformed_pointcloud;
-  pcl::fromROSMsg(*pointcloud_ptr_, transformed_pointcloud);
-  pcl::transformPointCloud(transformed_pointcloud, transformed_pointcloud, isometry);
+  const Eigen::Affine3f isometry =
+    tf2::transformToEigen(transform_stamped.get().transform).cast<float>();
 
-  const auto ego_polygon = createSelfPolygon(vehicle_info_);
-
-  for (const auto & p : transformed_pointcloud) {
-    Point2d boost_point(p.x, p.y);
+  // transform the points on the fly, without converting the pointcloud
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(*pointcloud_ptr_, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_y(*pointcloud_ptr_, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_z(*pointcloud_ptr_, "z");
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z) {
+    const Eigen::Vector3f p = isometry * Eigen::Vector3f(*iter_x, *iter_y, *iter_z);
 
-    const auto distance_to_object = bg::distance(ego_polygon, boost_point);
+    const auto distance_to_object = calcDistanceToSelfPolygon(vehicle_info_, p.x(), p.y());
 
     if (distance_to_object < minimum_distance) {
-      nearest_point = createPoint(p.x, p.y, p.z);
+      nearest_point = createPoint(p.x(), p.y(), p.z());
       minimum_distance = distance_to_object;
     }
   }
@@ -378,6 +402,7 @@ boost::optional<Obstacle> SurroundObstacleCheckerNode::getNearestObstacleByDynam
 
   tf2::Transform tf_src2target;
   tf2::fromMsg(transform_stamped.get().transform, tf_src2target);
+  const tf2::Transform tf_target2src = tf_src2target.inverse();
 
   const auto ego_polygon = createSelfPolygon(vehicle_info_);
 
@@ -388,7 +413,16 @@ boost::optional<Obstacle> SurroundObstacleCheckerNode::getNearestObstacleByDynam
     tf2::fromMsg(object_pose, tf_src2object);
 
     geometry_msgs::msg::Pose transformed_object_pose;
-    tf2::toMsg(tf_src2target.inverse() * tf_src2object, transformed_object_pose);
+    tf2::toMsg(tf_target2src * tf_src2object, transformed_object_pose);
+
+    // skip the polygon distance for an object which cannot be nearer than the nearest one
+    const auto distance_lower_bound =
+      calcDistanceToSelfPolygon(
+        vehicle_info_, transformed_object_pose.position.x, transformed_object_pose.position.y) -
+      calcObjectRadius(object.shape);
+    if (distance_lower_bound >= minimum_distance) {
+      continue;
+    }
 
     const auto object_polygon =
       object.shape.type == Shape::POLYGON
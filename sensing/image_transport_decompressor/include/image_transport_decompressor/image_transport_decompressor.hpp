@@ -15,6 +15,10 @@
 #ifndef IMAGE_TRANSPORT_DECOMPRESSOR__IMAGE_TRANSPORT_DECOMPRESSOR_HPP_
 #define IMAGE_TRANSPORT_DECOMPRESSOR__IMAGE_TRANSPORT_DECOMPRESSOR_HPP_
 
+#ifdef NVJPEG_AVAILABLE
+#include "image_transport_decompressor/nvjpeg_decoder.hpp"
+#endif
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <sensor_msgs/msg/compressed_image.hpp>
@@ -38,6 +42,9 @@ private:
   rclcpp::Subscription<sensor_msgs::msg::CompressedImage>::SharedPtr compressed_image_sub_;
   rclcpp::Publisher<sensor_msgs::msg::Image>::SharedPtr raw_image_pub_;
   std::string encoding_;
+#ifdef NVJPEG_AVAILABLE
+  std::unique_ptr<NvJpegDecoder> nvjpeg_decoder_;
+#endif
 };
 
 }  // namespace image_preprocessor
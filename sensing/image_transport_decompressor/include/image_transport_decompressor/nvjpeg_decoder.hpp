@@ -0,0 +1,80 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef IMAGE_TRANSPORT_DECOMPRESSOR__NVJPEG_DECODER_HPP_
+#define IMAGE_TRANSPORT_DECOMPRESSOR__NVJPEG_DECODER_HPP_
+
+#include <opencv2/core/core.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace image_preprocessor
+{
+/**
+ * @brief JPEG decoder on the GPU with nvJPEG. The image is decoded as interleaved BGR into a
+ * device buffer which is kept between the calls and only grows, so that a consumer in the same
+ * process (e.g. a TensorRT input) can read it without going through the host.
+ */
+class NvJpegDecoder
+{
+public:
+  NvJpegDecoder();
+  ~NvJpegDecoder();
+
+  NvJpegDecoder(const NvJpegDecoder &) = delete;
+  NvJpegDecoder & operator=(const NvJpegDecoder &) = delete;
+
+  /**
+   * @brief decode the JPEG data into the device buffer, and wait for the end of the decoding
+   * @return false if the data is not a JPEG image supported by nvJPEG
+   */
+  bool decodeToDevice(const std::vector<uint8_t> & data);
+
+  /**
+   * @brief decode the JPEG data into image as 8 bit BGR, as cv::imdecode() with IMREAD_COLOR
+   * @return false if the data is not a JPEG image supported by nvJPEG
+   */
+  bool decode(const std::vector<uint8_t> & data, cv::Mat & image);
+
+  /**
+   * @brief device pointer to the BGR pixels of the last decoded image, valid until the next call
+   */
+  const uint8_t * deviceImage() const { return device_image_; }
+
+  /**
+   * @brief bytes between the rows of the device image
+   */
+  std::size_t devicePitch() const { return device_pitch_; }
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+
+private:
+  // nvJPEG and CUDA handles, not to expose their headers to the users of the decoder
+  struct Handles;
+  std::unique_ptr<Handles> handles_;
+
+  uint8_t * device_image_ = nullptr;
+  std::size_t device_pitch_ = 0;
+  std::size_t device_capacity_ = 0;
+  int width_ = 0;
+  int height_ = 0;
+};
+
+}  // namespace image_preprocessor
+
+#endif  // IMAGE_TRANSPORT_DECOMPRESSOR__NVJPEG_DECODER_HPP_
@@ -57,6 +57,7 @@
 
 #include <limits>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -67,6 +68,18 @@ ImageTransportDecompressor::ImageTransportDecompressor(const rclcpp::NodeOptions
 : rclcpp::Node("image_transport_decompressor", node_options),
   encoding_(declare_parameter("encoding", "default"))
 {
+  if (declare_parameter("use_gpu_decode", false)) {
+#ifdef NVJPEG_AVAILABLE
+    try {
+      nvjpeg_decoder_ = std::make_unique<NvJpegDecoder>();
+    } catch (const std::runtime_error & e) {
+      RCLCPP_WARN(get_logger(), "Failed to initialize nvJPEG, decode on CPU: %s", e.what());
+    }
+#else
+    RCLCPP_WARN(get_logger(), "Built without nvJPEG, use_gpu_decode is ignored");
+#endif
+  }
+
   compressed_image_sub_ = create_subscription<sensor_msgs::msg::CompressedImage>(
     "~/input/compressed_image", rclcpp::SensorDataQoS(),
     std::bind(&ImageTransportDecompressor::onCompressedImage, this, std::placeholders::_1));
@@ -83,7 +96,22 @@ void ImageTransportDecompressor::onCompressedImage(
 
   // Decode color/mono image
   try {
-    cv_ptr->image = cv::imdecode(cv::Mat(input_compressed_image_msg->data), cv::IMREAD_COLOR);
+    bool is_decoded = false;
+#ifdef NVJPEG_AVAILABLE
+    // the data of the other formats, e.g. png, is left to OpenCV
+    const auto & data = input_compressed_image_msg->data;
+    const bool is_jpeg = data.size() > 1 && data[0] == 0xFF && data[1] == 0xD8;
+    if (nvjpeg_decoder_ && is_jpeg) {
+      try {
+        is_decoded = nvjpeg_decoder_->decode(data, cv_ptr->image);
+      } catch (const std::runtime_error & e) {
+        RCLCPP_ERROR(get_logger(), "%s", e.what());
+      }
+    }
+#endif
+    if (!is_decoded) {
+      cv_ptr->image = cv::imdecode(cv::Mat(input_compressed_image_msg->data), cv::IMREAD_COLOR);
+    }
 
     // Assign image encoding string
     const size_t split_pos = input_compressed_image_msg->format.find(';');
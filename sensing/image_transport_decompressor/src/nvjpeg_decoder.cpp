@@ -0,0 +1,124 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "image_transport_decompressor/nvjpeg_decoder.hpp"
+
+#include <cuda_runtime_api.h>
+#include <nvjpeg.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#define CHECK_CUDA_ERROR(e) (checkError(e, __FILE__, __LINE__))
+#define CHECK_NVJPEG_ERROR(e) (checkError(e, __FILE__, __LINE__))
+
+namespace image_preprocessor
+{
+namespace
+{
+inline void checkError(const ::cudaError_t e, const char * f, int n)
+{
+  if (e != ::cudaSuccess) {
+    std::stringstream s;
+    s << ::cudaGetErrorName(e) << " (" << e << ")@" << f << "#L" << n << ": "
+      << ::cudaGetErrorString(e);
+    throw std::runtime_error{s.str()};
+  }
+}
+
+inline void checkError(const ::nvjpegStatus_t e, const char * f, int n)
+{
+  if (e != ::NVJPEG_STATUS_SUCCESS) {
+    std::stringstream s;
+    s << "nvJPEG error (" << e << ")@" << f << "#L" << n;
+    throw std::runtime_error{s.str()};
+  }
+}
+}  // namespace
+
+struct NvJpegDecoder::Handles
+{
+  nvjpegHandle_t handle = nullptr;
+  nvjpegJpegState_t state = nullptr;
+  cudaStream_t stream = nullptr;
+};
+
+NvJpegDecoder::NvJpegDecoder() : handles_(std::make_unique<Handles>())
+{
+  CHECK_NVJPEG_ERROR(nvjpegCreateSimple(&handles_->handle));
+  CHECK_NVJPEG_ERROR(nvjpegJpegStateCreate(handles_->handle, &handles_->state));
+  CHECK_CUDA_ERROR(cudaStreamCreateWithFlags(&handles_->stream, cudaStreamNonBlocking));
+}
+
+NvJpegDecoder::~NvJpegDecoder()
+{
+  cudaFree(device_image_);
+  cudaStreamDestroy(handles_->stream);
+  nvjpegJpegStateDestroy(handles_->state);
+  nvjpegDestroy(handles_->handle);
+}
+
+bool NvJpegDecoder::decodeToDevice(const std::vector<uint8_t> & data)
+{
+  int component_num = 0;
+  nvjpegChromaSubsampling_t subsampling;
+  int widths[NVJPEG_MAX_COMPONENT];
+  int heights[NVJPEG_MAX_COMPONENT];
+  if (
+    nvjpegGetImageInfo(
+      handles_->handle, data.data(), data.size(), &component_num, &subsampling, widths,
+      heights) != NVJPEG_STATUS_SUCCESS) {
+    return false;
+  }
+
+  width_ = widths[0];
+  height_ = heights[0];
+  device_pitch_ = static_cast<std::size_t>(width_) * 3;
+  const std::size_t size = device_pitch_ * static_cast<std::size_t>(height_);
+  if (size > device_capacity_) {
+    CHECK_CUDA_ERROR(cudaFree(device_image_));
+    device_image_ = nullptr;
+    device_capacity_ = 0;
+    CHECK_CUDA_ERROR(cudaMalloc(reinterpret_cast<void **>(&device_image_), size));
+    device_capacity_ = size;
+  }
+
+  nvjpegImage_t output{};
+  output.channel[0] = device_image_;
+  output.pitch[0] = device_pitch_;
+  if (
+    nvjpegDecode(
+      handles_->handle, handles_->state, data.data(), data.size(), NVJPEG_OUTPUT_BGRI, &output,
+      handles_->stream) != NVJPEG_STATUS_SUCCESS) {
+    return false;
+  }
+  CHECK_CUDA_ERROR(cudaStreamSynchronize(handles_->stream));
+  return true;
+}
+
+bool NvJpegDecoder::decode(const std::vector<uint8_t> & data, cv::Mat & image)
+{
+  if (!decodeToDevice(data)) {
+    return false;
+  }
+
+  image.create(height_, width_, CV_8UC3);
+  CHECK_CUDA_ERROR(cudaMemcpy2D(
+    image.data, image.step, device_image_, device_pitch_, device_pitch_, height_,
+    cudaMemcpyDeviceToHost));
+  return true;
+}
+
+}  // namespace image_preprocessor
@@ -19,6 +19,7 @@
 
 #include <sensor_msgs/msg/point_cloud2.hpp>
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -32,6 +33,7 @@ public:
 private:
   // Parameter
   std::vector<std::int64_t> ignore_tags_;
+  std::array<bool, 256> is_ignored_tag_;
 
   // Subscriber
   rclcpp::Subscription<sensor_msgs::msg::PointCloud2>::SharedPtr sub_pointcloud_;
@@ -14,26 +14,12 @@
 
 #include "livox_tag_filter/livox_tag_filter_node.hpp"
 
-#include <pcl_conversions/pcl_conversions.h>
-
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include <vector>
 
-struct LivoxPoint
-{
-  float x;
-  float y;
-  float z;
-  float intensity;
-  std::uint8_t tag;
-  std::uint8_t line;
-} EIGEN_ALIGN16;
-
-POINT_CLOUD_REGISTER_POINT_STRUCT(
-  LivoxPoint, (float, x, x)(float, y, y)(float, z, z)(float, intensity, intensity)(
-                std::uint8_t, tag, tag)(std::uint8_t, line, line))
-
 namespace livox_tag_filter
 {
 LivoxTagFilterNode::LivoxTagFilterNode(const rclcpp::NodeOptions & node_options)
@@ -41,6 +27,12 @@ LivoxTagFilterNode::LivoxTagFilterNode(const rclcpp::NodeOptions & node_options)
 {
   // Parameter
   ignore_tags_ = this->declare_parameter("ignore_tags", std::vector<std::int64_t>{});
+  is_ignored_tag_.fill(false);
+  for (const auto & ignore_tag : ignore_tags_) {
+    if (0 <= ignore_tag && ignore_tag < static_cast<std::int64_t>(is_ignored_tag_.size())) {
+      is_ignored_tag_.at(ignore_tag) = true;
+    }
+  }
 
   // Subscriber
   using std::placeholders::_1;
@@ -54,32 +46,57 @@ LivoxTagFilterNode::LivoxTagFilterNode(const rclcpp::NodeOptions & node_options)
 
 void LivoxTagFilterNode::onPointCloud(const sensor_msgs::msg::PointCloud2::ConstSharedPtr msg)
 {
-  pcl::PointCloud<LivoxPoint> points;
-  pcl::fromROSMsg(*msg, points);
+  const auto tag_field = std::find_if(msg->fields.begin(), msg->fields.end(), [](const auto & f) {
+    return f.name == "tag" && f.datatype == sensor_msgs::msg::PointField::UINT8;
+  });
+  if (tag_field == msg->fields.end() || tag_field->offset >= msg->point_step) {
+    RCLCPP_ERROR_THROTTLE(
+      this->get_logger(), *this->get_clock(), 5000, "The input has no uint8 field of tag");
+    return;
+  }
+  const std::size_t tag_offset = tag_field->offset;
+  const std::size_t point_step = msg->point_step;
 
-  const auto isIgnored = [&](const LivoxPoint & p) {
-    for (const auto & ignore_tag : ignore_tags_) {
-      if (p.tag == ignore_tag) {
-        return true;
+  // Copy the bytes of the kept points as they are, a run of consecutive kept points at once
+  auto tag_filtered_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
+  tag_filtered_msg_ptr->header = msg->header;
+  tag_filtered_msg_ptr->fields = msg->fields;
+  tag_filtered_msg_ptr->is_bigendian = msg->is_bigendian;
+  tag_filtered_msg_ptr->point_step = msg->point_step;
+  tag_filtered_msg_ptr->is_dense = msg->is_dense;
+  auto & data = tag_filtered_msg_ptr->data;
+  data.resize(static_cast<std::size_t>(msg->width) * msg->height * point_step);
+
+  std::size_t data_size = 0;
+  for (std::size_t row = 0; row < msg->height; ++row) {
+    const std::uint8_t * row_data = msg->data.data() + row * msg->row_step;
+    std::size_t run_begin = 0;
+    std::size_t run_size = 0;
+    for (std::size_t i = 0; i < msg->width; ++i) {
+      const std::uint8_t * point = row_data + i * point_step;
+      if (!is_ignored_tag_[point[tag_offset]]) {
+        if (run_size == 0) {
+          run_begin = i;
+        }
+        ++run_size;
+        continue;
+      }
+      if (run_size > 0) {
+        std::memcpy(&data[data_size], row_data + run_begin * point_step, run_size * point_step);
+        data_size += run_size * point_step;
+        run_size = 0;
       }
     }
-
-    return false;
-  };
-
-  pcl::PointCloud<LivoxPoint> tag_filtered_points;
-  for (const auto & p : points) {
-    if (isIgnored(p)) {
-      continue;
+    if (run_size > 0) {
+      std::memcpy(&data[data_size], row_data + run_begin * point_step, run_size * point_step);
+      data_size += run_size * point_step;
     }
-
-    tag_filtered_points.push_back(p);
   }
+  data.resize(data_size);
 
-  // Publish ROS message
-  auto tag_filtered_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-  pcl::toROSMsg(tag_filtered_points, *tag_filtered_msg_ptr);
-  tag_filtered_msg_ptr->header = msg->header;
+  tag_filtered_msg_ptr->height = 1;
+  tag_filtered_msg_ptr->width = static_cast<std::uint32_t>(data_size / point_step);
+  tag_filtered_msg_ptr->row_step = static_cast<std::uint32_t>(data_size);
 
   pub_pointcloud_->publish(std::move(tag_filtered_msg_ptr));
 }
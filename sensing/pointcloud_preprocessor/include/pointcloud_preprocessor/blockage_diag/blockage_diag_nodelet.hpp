@@ -29,6 +29,7 @@
 
 #include <cv_bridge/cv_bridge.h>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -55,6 +56,11 @@ protected:
 
 private:
   void onBlockageChecker(DiagnosticStatusWrapper & stat);
+
+  /** \brief Fill the no-return bins straight from the input buffer and update the blockage
+   * state from them. The debug images are only built if they are subscribed. */
+  void updateBlockageStreaming(const PointCloud2 & input);
+  void publishBlockageRatios();
   Updater updater_{this};
   uint vertical_bins_;
   std::vector<double> angle_range_deg_;
@@ -69,6 +75,13 @@ private:
   uint sky_blockage_count_ = 0;
   uint blockage_count_threshold_;
   std::string lidar_model_;
+  bool use_streaming_;
+
+  /** \brief Per ring/azimuth bin buffers of the streaming mode, reused across frames. */
+  std::vector<uint8_t> no_return_mask_;
+  std::vector<uint8_t> eroded_mask_;
+  std::vector<uint16_t> depth_bins_;
+  std::vector<uint32_t> mask_integral_;
 
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
@@ -62,7 +62,9 @@
 
 // ROS includes
 #include "autoware_point_types/types.hpp"
+#include "pointcloud_preprocessor/utility/pointcloud_buffer_pool.hpp"
 
+#include <Eigen/Geometry>
 #include <diagnostic_updater/diagnostic_updater.hpp>
 #include <point_cloud_msg_wrapper/point_cloud_msg_wrapper.hpp>
 #include <tier4_autoware_utils/ros/debug_publisher.hpp>
@@ -112,8 +114,8 @@ public:
   virtual ~PointCloudConcatenateDataSynchronizerComponent() {}
 
 private:
-  /** \brief The output PointCloud publisher. */
-  rclcpp::Publisher<PointCloud2>::SharedPtr pub_output_;
+  /** \brief The output PointCloud publisher, giving the published data buffers back to the pool. */
+  rclcpp::Publisher<PointCloud2, PointCloud2PoolAllocator<void>>::SharedPtr pub_output_;
 
   /** \brief The maximum number of messages that we can store in the queue. */
   int maximum_queue_size_ = 3;
@@ -143,22 +145,60 @@ private:
 
   std::deque<geometry_msgs::msg::TwistStamped::ConstSharedPtr> twist_ptr_queue_;
 
-  std::map<std::string, sensor_msgs::msg::PointCloud2::ConstSharedPtr> cloud_stdmap_;
-  std::map<std::string, sensor_msgs::msg::PointCloud2::ConstSharedPtr> cloud_stdmap_tmp_;
+  /** \brief A single XYZI output cloud split into one reserved slice (slot) per input topic.
+   * Each input is transformed straight into its slot as it arrives, so publishing only
+   * compacts the slots and hands the cloud over to the publisher.
+   */
+  struct ConcatArena
+  {
+    PooledPointCloud2Ptr cloud;
+    std::vector<std::size_t> slot_offsets;
+    std::vector<std::size_t> slot_capacities;
+    std::vector<std::size_t> slot_sizes;
+    std::vector<rclcpp::Time> slot_stamps;
+    std::vector<rclcpp::Time> arrival_times;
+    std::vector<bool> received;
+  };
+
+  /** \brief Arrival of a topic after the first arrival of a cycle, learned from the cycles in
+   * which all the topics arrived.
+   */
+  struct ArrivalModel
+  {
+    bool is_initialized = false;
+    double mean_offset_sec = 0.0;
+    double mean_deviation_sec = 0.0;
+  };
+
+  /** \brief Arena of the current cycle, and of the next one for topics received twice. */
+  ConcatArena arena_;
+  ConcatArena next_arena_;
+
+  /** \brief Largest number of points seen so far for each topic, used to size the slots. */
+  std::vector<std::size_t> slot_capacities_;
+  std::map<std::string, std::size_t> topic_index_map_;
   std::mutex mutex_;
 
   std::vector<double> input_offset_;
   std::map<std::string, double> offset_map_;
 
-  void transformPointCloud(const PointCloud2::ConstSharedPtr & in, PointCloud2::SharedPtr & out);
-  void combineClouds(
-    const PointCloud2::ConstSharedPtr & in1, const PointCloud2::ConstSharedPtr & in2,
-    PointCloud2::SharedPtr & out);
+  /** \brief Publish without the topics that are later than they usually are. */
+  bool enable_deadline_publish_ = false;
+  double deadline_margin_sec_ = 0.01;
+  std::vector<ArrivalModel> arrival_models_;
+
+  void resetArena(ConcatArena & arena);
+  void reserveSlot(ConcatArena & arena, const std::size_t topic_index, const std::size_t num_points);
+  void writeToSlot(ConcatArena & arena, const std::size_t topic_index, const PointCloud2 & input);
+  void transformSlotPoints(
+    const Eigen::Affine3f & transform, PointXYZI * points, const std::size_t num_points);
+  void copySlot(const ConcatArena & from, ConcatArena & to, const std::size_t topic_index);
+  bool computeTwistCompensation(
+    const rclcpp::Time & old_stamp, const rclcpp::Time & new_stamp, Eigen::Affine3f & transform);
+  void updateArrivalModels();
+  void setDeadlineTimer();
   void publish();
 
-  void convertToXYZICloud(
-    const sensor_msgs::msg::PointCloud2::SharedPtr & input_ptr,
-    sensor_msgs::msg::PointCloud2::SharedPtr & output_ptr);
   void setPeriod(const int64_t new_period);
   void cloud_callback(
     const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_ptr,
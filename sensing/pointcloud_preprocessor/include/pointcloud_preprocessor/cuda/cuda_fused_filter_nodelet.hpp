@@ -0,0 +1,92 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__CUDA__CUDA_FUSED_FILTER_NODELET_HPP_
+#define POINTCLOUD_PREPROCESSOR__CUDA__CUDA_FUSED_FILTER_NODELET_HPP_
+
+#include "pointcloud_preprocessor/cuda/cuda_pointcloud_pipeline.hpp"
+#include "pointcloud_preprocessor/distortion_corrector/twist_segment_table.hpp"
+#include "pointcloud_preprocessor/filter.hpp"
+
+#include <geometry_msgs/msg/twist_stamped.hpp>
+#include <geometry_msgs/msg/twist_with_covariance_stamped.hpp>
+#include <geometry_msgs/msg/vector3_stamped.hpp>
+#include <sensor_msgs/msg/imu.hpp>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+/** \brief Runs an ordered list of distortion corrector, crop box, ring outlier and voxel grid
+ * downsample stages on the GPU. The cloud is uploaded once, stays in device memory between the
+ * stages and is only copied back to the host for the output.
+ */
+class CudaFusedFilterComponent : public pointcloud_preprocessor::Filter
+{
+protected:
+  void filter(
+    const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output) override;
+
+private:
+  enum class StageType { DistortionCorrector, CropBox, RingOutlier, VoxelGridDownsample };
+
+  struct Stage
+  {
+    std::string name;
+    StageType type;
+    cuda::CropBoxParams crop_box{-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, false};
+    cuda::RingOutlierParams ring_outlier{1.03, 0.1, 4};
+    float voxel_size_x{0.3f};
+    float voxel_size_y{0.3f};
+    float voxel_size_z{0.1f};
+  };
+
+  std::vector<Stage> stages_;
+  cuda::CudaPointCloudPipeline pipeline_;
+
+  // distortion corrector
+  std::string base_link_frame_ = "base_link";
+  std::string time_stamp_field_name_;
+  bool use_imu_;
+  std::deque<geometry_msgs::msg::TwistStamped> twist_queue_;
+  std::deque<geometry_msgs::msg::Vector3Stamped> angular_velocity_queue_;
+  TwistSegmentTable twist_segment_table_;
+  rclcpp::Subscription<geometry_msgs::msg::TwistWithCovarianceStamped>::SharedPtr twist_sub_;
+  rclcpp::Subscription<sensor_msgs::msg::Imu>::SharedPtr imu_sub_;
+
+  /** \brief Parameter service callback result : needed to be hold */
+  OnSetParametersCallbackHandle::SharedPtr set_param_res_;
+
+  /** \brief Parameter service callback */
+  rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
+
+  void onTwistWithCovarianceStamped(
+    const geometry_msgs::msg::TwistWithCovarianceStamped::ConstSharedPtr twist_msg);
+  void onImu(const sensor_msgs::msg::Imu::ConstSharedPtr imu_msg);
+
+  /** \brief Resolve the byte offsets of the fields read by the configured stages. */
+  bool getPointLayout(const PointCloud2 & input, cuda::PointLayout & layout);
+
+  /** \brief Build the pose table of the input and undistort the device copy with it. */
+  bool undistort(const PointCloud2 & input, const cuda::PointLayout & layout);
+
+public:
+  PCL_MAKE_ALIGNED_OPERATOR_NEW
+  explicit CudaFusedFilterComponent(const rclcpp::NodeOptions & options);
+};
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__CUDA__CUDA_FUSED_FILTER_NODELET_HPP_
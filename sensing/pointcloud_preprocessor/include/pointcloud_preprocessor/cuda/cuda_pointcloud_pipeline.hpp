@@ -0,0 +1,101 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__CUDA__CUDA_POINTCLOUD_PIPELINE_HPP_
+#define POINTCLOUD_PREPROCESSOR__CUDA__CUDA_POINTCLOUD_PIPELINE_HPP_
+
+#include "pointcloud_preprocessor/distortion_corrector/twist_segment.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+namespace cuda
+{
+/** \brief Byte offsets of the fields used by the device stages. Unused fields may be left
+ * unset as long as the stage reading them is not run. */
+struct PointLayout
+{
+  uint32_t point_step{0U};
+  uint32_t x_offset{0U};
+  uint32_t y_offset{4U};
+  uint32_t z_offset{8U};
+  uint32_t time_stamp_offset{0U};  // float64
+  uint32_t ring_offset{0U};        // uint16
+  uint32_t azimuth_offset{0U};     // float32
+  uint32_t distance_offset{0U};    // float32
+};
+
+struct CropBoxParams
+{
+  float min_x;
+  float max_x;
+  float min_y;
+  float max_y;
+  float min_z;
+  float max_z;
+  bool negative;
+};
+
+struct RingOutlierParams
+{
+  double distance_ratio;
+  double object_length_threshold;
+  int num_points_threshold;
+};
+
+/** \brief Point cloud kept resident in device memory while filter stages are applied to it.
+ * Device buffers are reused across frames, only the upload and the download cross the bus.
+ * Every stage keeps the input point layout, except the voxel grid downsample which replaces the
+ * cloud by its float32 x, y, z centroids.
+ */
+class CudaPointCloudPipeline
+{
+public:
+  CudaPointCloudPipeline();
+  ~CudaPointCloudPipeline();
+
+  void upload(const uint8_t * data, const std::size_t num_points, const PointLayout & layout);
+
+  /** \brief Undistort time-sorted points with the pose table built on the host.
+   * \param base_link_to_sensor row-major 3x4 transform
+   */
+  void undistort(
+    const std::vector<TwistSegment> & segments, const std::array<float, 12> & base_link_to_sensor);
+
+  void cropBox(const CropBoxParams & params);
+
+  /** \brief Same walk as RingOutlierFilterComponent, the survivors are stored in ring order. */
+  void ringOutlier(const RingOutlierParams & params);
+
+  void voxelGridDownsample(
+    const float voxel_size_x, const float voxel_size_y, const float voxel_size_z);
+
+  std::size_t numPoints() const;
+  const PointLayout & layout() const;
+
+  /** \brief Copy the points to the host, the destination holds numPoints() * point_step bytes. */
+  void download(uint8_t * data) const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+}  // namespace cuda
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__CUDA__CUDA_POINTCLOUD_PIPELINE_HPP_
@@ -15,6 +15,8 @@
 #ifndef POINTCLOUD_PREPROCESSOR__DISTORTION_CORRECTOR__DISTORTION_CORRECTOR_HPP_
 #define POINTCLOUD_PREPROCESSOR__DISTORTION_CORRECTOR__DISTORTION_CORRECTOR_HPP_
 
+#include "pointcloud_preprocessor/distortion_corrector/twist_segment_table.hpp"
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <geometry_msgs/msg/twist_stamped.hpp>
@@ -42,6 +44,8 @@
 #include <deque>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace pointcloud_preprocessor
 {
@@ -64,6 +68,11 @@ private:
 
   bool undistortPointCloud(const tf2::Transform & tf2_base_link_to_sensor, PointCloud2 & points);
 
+  /** @brief Undistort with a pose table built per twist interval, applied to blocks of points in
+   * parallel. Requires the points to be sorted by time stamp. */
+  bool undistortPointCloudWithPoseTable(
+    const tf2::Transform & tf2_base_link_to_sensor, PointCloud2 & points);
+
   rclcpp::Subscription<PointCloud2>::SharedPtr input_points_sub_;
   rclcpp::Subscription<sensor_msgs::msg::Imu>::SharedPtr imu_sub_;
   rclcpp::Subscription<geometry_msgs::msg::TwistWithCovarianceStamped>::SharedPtr twist_sub_;
@@ -81,6 +90,10 @@ private:
   std::string base_link_frame_ = "base_link";
   std::string time_stamp_field_name_;
   bool use_imu_;
+  bool use_pose_table_;
+  int num_threads_;
+  TwistSegmentTable twist_segment_table_;
+  std::vector<std::pair<std::size_t, std::size_t>> point_blocks_;
 };
 
 }  // namespace pointcloud_preprocessor
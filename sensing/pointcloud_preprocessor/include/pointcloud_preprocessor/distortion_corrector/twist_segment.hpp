@@ -0,0 +1,60 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__DISTORTION_CORRECTOR__TWIST_SEGMENT_HPP_
+#define POINTCLOUD_PREPROCESSOR__DISTORTION_CORRECTOR__TWIST_SEGMENT_HPP_
+
+#include <cmath>
+#include <cstddef>
+
+// shared by the host and the CUDA undistortion, so this header must not depend on ROS
+#ifdef __CUDACC__
+#define POINTCLOUD_PREPROCESSOR_HOST_DEVICE __host__ __device__
+#else
+#define POINTCLOUD_PREPROCESSOR_HOST_DEVICE
+#endif
+
+namespace pointcloud_preprocessor
+{
+/** @brief Constant twist over a range of time-sorted points, with the pose at its start. */
+struct TwistSegment
+{
+  std::size_t begin;
+  std::size_t end;
+  double start_time_stamp;
+  float v;
+  float w;
+  float theta;
+  float x;
+  float y;
+};
+
+/** @brief Integrate the constant twist of the segment for dt seconds from its start pose. */
+POINTCLOUD_PREPROCESSOR_HOST_DEVICE inline void poseAt(
+  const TwistSegment & segment, const float dt, float & x, float & y, float & theta)
+{
+  theta = segment.theta + segment.w * dt;
+  x = segment.x;
+  y = segment.y;
+  if (fabsf(segment.w) > 1e-6f) {
+    x += segment.v / segment.w * (sinf(theta) - sinf(segment.theta));
+    y -= segment.v / segment.w * (cosf(theta) - cosf(segment.theta));
+  } else {
+    x += segment.v * dt * cosf(segment.theta);
+    y += segment.v * dt * sinf(segment.theta);
+  }
+}
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__DISTORTION_CORRECTOR__TWIST_SEGMENT_HPP_
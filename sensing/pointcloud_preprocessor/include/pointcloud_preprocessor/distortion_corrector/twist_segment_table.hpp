@@ -0,0 +1,63 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__DISTORTION_CORRECTOR__TWIST_SEGMENT_TABLE_HPP_
+#define POINTCLOUD_PREPROCESSOR__DISTORTION_CORRECTOR__TWIST_SEGMENT_TABLE_HPP_
+
+#include "pointcloud_preprocessor/distortion_corrector/twist_segment.hpp"
+
+#include <geometry_msgs/msg/twist_stamped.hpp>
+#include <geometry_msgs/msg/vector3_stamped.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <deque>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+/** @brief Pose table of a time-sorted point cloud: one constant-twist segment per interval in
+ * which the selected twist/imu sample does not change. Buffers are reused across frames.
+ */
+class TwistSegmentTable
+{
+public:
+  /** @brief Build the table for the points, given the offset of their float64 time stamp. */
+  void build(
+    const sensor_msgs::msg::PointCloud2 & points, const std::size_t time_stamp_offset,
+    const std::deque<geometry_msgs::msg::TwistStamped> & twist_queue,
+    const std::deque<geometry_msgs::msg::Vector3Stamped> & angular_velocity_queue,
+    const bool use_imu);
+
+  const std::vector<TwistSegment> & segments() const { return segments_; }
+
+  /** @brief Whether a segment fell back to zero twist because no twist was close enough. */
+  bool isTwistOutOfRange() const { return twist_out_of_range_; }
+
+  /** @brief Whether a segment ignored the imu because no sample was close enough. */
+  bool isImuOutOfRange() const { return imu_out_of_range_; }
+
+private:
+  void getTwistAt(const double time_stamp, float & v, float & w);
+
+  const std::deque<geometry_msgs::msg::TwistStamped> * twist_queue_{nullptr};
+  const std::deque<geometry_msgs::msg::Vector3Stamped> * angular_velocity_queue_{nullptr};
+  bool use_imu_{false};
+  bool twist_out_of_range_{false};
+  bool imu_out_of_range_{false};
+  std::vector<TwistSegment> segments_;
+  std::vector<double> break_time_stamps_;
+};
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__DISTORTION_CORRECTOR__TWIST_SEGMENT_TABLE_HPP_
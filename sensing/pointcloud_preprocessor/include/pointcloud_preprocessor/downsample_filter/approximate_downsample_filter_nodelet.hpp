@@ -51,11 +51,9 @@
 #ifndef POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__APPROXIMATE_DOWNSAMPLE_FILTER_NODELET_HPP_
 #define POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__APPROXIMATE_DOWNSAMPLE_FILTER_NODELET_HPP_
 
+#include "pointcloud_preprocessor/downsample_filter/voxel_centroid_table.hpp"
 #include "pointcloud_preprocessor/filter.hpp"
 
-#include <tier4_pcl_extensions/voxel_grid_nearest_centroid.hpp>
-
-#include <pcl/filters/voxel_grid.h>
 #include <pcl/search/pcl_search.h>
 
 #include <vector>
@@ -72,9 +70,27 @@ protected:
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
 private:
+  /** \brief The point nearest to the centroid of a voxel among the points seen so far. */
+  struct NearestPoint
+  {
+    float squared_distance;
+    uint32_t index;
+  };
+
   double voxel_size_x_;
   double voxel_size_y_;
   double voxel_size_z_;
+  int num_threads_;
+
+  /** \brief Centroid tables of the points of each thread, and their merge. The voxels of the
+   * tables are kept across frames. */
+  std::vector<VoxelCentroidTable> thread_tables_;
+  std::vector<std::vector<uint32_t>> thread_merged_entries_;
+  std::vector<std::vector<NearestPoint>> thread_nearest_points_;
+  VoxelCentroidTable merged_table_;
+  std::vector<NearestPoint> nearest_points_;
+  /** \brief Voxel of each input point in the table of its thread. */
+  std::vector<uint32_t> point_entries_;
 
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
@@ -0,0 +1,92 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__VOXEL_CENTROID_TABLE_HPP_
+#define POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__VOXEL_CENTROID_TABLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+/** \brief Open-addressing hash table accumulating the centroid of the points in each voxel.
+ * Voxel coordinates are packed into a 64 bit key with 21 bits per axis, so that e.g. 0.1 m leaves
+ * cover +-100 km without overflow. All the buffers are kept across frames, and clearing the table
+ * only bumps a generation counter, so the steady state does not allocate.
+ */
+class VoxelCentroidTable
+{
+public:
+  struct Centroid
+  {
+    float x;
+    float y;
+    float z;
+    uint32_t num_points;
+  };
+
+  /** \brief Set the voxel size. Points are binned by floor(coordinate / voxel size). */
+  void setVoxelSize(const float voxel_size_x, const float voxel_size_y, const float voxel_size_z);
+
+  /** \brief Clear the table and make sure it can hold the given number of voxels. */
+  void reset(const std::size_t expected_num_voxels);
+
+  /** \brief Add a point to the centroid of its voxel.
+   * \return false if the point is not finite or out of the range of the packed key
+   */
+  bool addPoint(const float x, const float y, const float z)
+  {
+    uint32_t entry;
+    return addPoint(x, y, z, entry);
+  }
+
+  /** \brief Add a point to the centroid of its voxel.
+   * \param[out] entry index of the voxel in centroids(), set only if the point is added
+   * \return false if the point is not finite or out of the range of the packed key
+   */
+  bool addPoint(const float x, const float y, const float z, uint32_t & entry);
+
+  /** \brief Add the voxels of another table, e.g. one filled by another thread, which must have
+   * the same voxel size.
+   * \param[out] entries index in centroids() of each voxel of the other table
+   */
+  void merge(const VoxelCentroidTable & other, std::vector<uint32_t> & entries);
+
+  /** \brief Accumulated voxels, in order of first insertion. */
+  const std::vector<Centroid> & centroids() const { return centroids_; }
+
+private:
+  static constexpr uint32_t empty_slot = UINT32_MAX;
+
+  float inverse_voxel_size_x_{1.0f};
+  float inverse_voxel_size_y_{1.0f};
+  float inverse_voxel_size_z_{1.0f};
+
+  std::vector<uint64_t> slot_keys_;
+  std::vector<uint32_t> slot_entries_;
+  std::vector<uint32_t> slot_generations_;
+  uint32_t generation_{0U};
+  std::size_t slot_mask_{0U};
+
+  std::vector<Centroid> centroids_;
+  std::vector<uint64_t> centroid_keys_;
+
+  uint32_t accumulate(const uint64_t key, const Centroid & sum);
+  void rehash(const std::size_t num_slots);
+  void insert(const uint64_t key, const uint32_t entry);
+};
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__VOXEL_CENTROID_TABLE_HPP_
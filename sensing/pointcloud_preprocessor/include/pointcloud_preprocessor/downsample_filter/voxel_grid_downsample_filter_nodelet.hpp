@@ -51,11 +51,9 @@
 #ifndef POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__VOXEL_GRID_DOWNSAMPLE_FILTER_NODELET_HPP_
 #define POINTCLOUD_PREPROCESSOR__DOWNSAMPLE_FILTER__VOXEL_GRID_DOWNSAMPLE_FILTER_NODELET_HPP_
 
+#include "pointcloud_preprocessor/downsample_filter/voxel_centroid_table.hpp"
 #include "pointcloud_preprocessor/filter.hpp"
 
-#include <pcl/filters/voxel_grid.h>
-#include <pcl/search/pcl_search.h>
-
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -71,6 +69,9 @@ private:
   double voxel_size_y_;
   double voxel_size_z_;
 
+  /** \brief Voxel centroids, kept across frames to reuse the buffers */
+  VoxelCentroidTable voxel_centroid_table_;
+
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
 
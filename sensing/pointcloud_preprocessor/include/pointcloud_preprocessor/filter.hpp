@@ -77,8 +77,12 @@
 #include <tf2_ros/create_timer_ros.h>
 #include <tf2_ros/transform_listener.h>
 
+#include "pointcloud_preprocessor/utility/latency_tracer.hpp"
+#include "pointcloud_preprocessor/utility/pointcloud_buffer_pool.hpp"
+
 // Include tier4 autoware utils
 #include <tier4_autoware_utils/ros/debug_publisher.hpp>
+#include <tier4_autoware_utils/ros/transform_cache.hpp>
 #include <tier4_autoware_utils/system/stop_watch.hpp>
 
 namespace pointcloud_preprocessor
@@ -137,8 +141,8 @@ protected:
   /** \brief The input PointCloud2 subscriber. */
   rclcpp::Subscription<PointCloud2>::SharedPtr sub_input_;
 
-  /** \brief The output PointCloud2 publisher. */
-  rclcpp::Publisher<PointCloud2>::SharedPtr pub_output_;
+  /** \brief The output PointCloud2 publisher, giving the published buffers back to the pool. */
+  rclcpp::Publisher<PointCloud2, PointCloud2PoolAllocator<void>>::SharedPtr pub_output_;
 
   /** \brief The message filter subscriber for PointCloud2. */
   message_filters::Subscriber<PointCloud2> sub_input_filter_;
@@ -229,6 +233,8 @@ protected:
 
   std::shared_ptr<tf2_ros::Buffer> tf_buffer_;
   std::shared_ptr<tf2_ros::TransformListener> tf_listener_;
+  /** \brief The sensor extrinsics, looked up without locking the TF buffer. */
+  std::unique_ptr<tier4_autoware_utils::StaticTransformCache> static_tf_cache_;
 
   inline bool isValid(
     const PointCloud2ConstPtr & cloud, const std::string & /*topic_name*/ = "input")
@@ -265,14 +271,28 @@ private:
   rcl_interfaces::msg::SetParametersResult filterParamCallback(
     const std::vector<rclcpp::Parameter> & p);
 
+  /** \brief Stage entry/exit times keyed by header stamp, written if latency_trace is set. */
+  LatencyTracer latency_tracer_;
+
   /** \brief Synchronized input, and indices.*/
   std::shared_ptr<ExactTimeSyncPolicy> sync_input_indices_e_;
   std::shared_ptr<ApproximateTimeSyncPolicy> sync_input_indices_a_;
 
-  /** \brief PointCloud2 + Indices data callback. */
-  void input_indices_callback(const PointCloud2ConstPtr cloud, const PointIndicesConstPtr indices);
+  /** \brief PointCloud2 data callback without indices, owning the cloud. */
+  void input_callback(PointCloud2::UniquePtr cloud);
+
+  /** \brief PointCloud2 + Indices data callback.
+   * \param owned_cloud the same cloud as cloud if it is owned by the caller, to be modified in
+   * place instead of a copy, otherwise nullptr
+   */
+  void input_indices_callback(
+    const PointCloud2ConstPtr cloud, const PointIndicesConstPtr indices,
+    const PointCloud2::SharedPtr & owned_cloud);
 
   void setupTF();
+
+  /** \brief Transform the x/y/z fields of the cloud into the target frame in place. */
+  bool transformPointCloudInplace(const std::string & target_frame, PointCloud2 & cloud);
 };
 }  // namespace pointcloud_preprocessor
 
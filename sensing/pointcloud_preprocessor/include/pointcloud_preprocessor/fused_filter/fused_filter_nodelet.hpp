@@ -0,0 +1,87 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__FUSED_FILTER__FUSED_FILTER_NODELET_HPP_
+#define POINTCLOUD_PREPROCESSOR__FUSED_FILTER__FUSED_FILTER_NODELET_HPP_
+
+#include "pointcloud_preprocessor/downsample_filter/voxel_centroid_table.hpp"
+#include "pointcloud_preprocessor/filter.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+/** \brief Runs an ordered list of crop box, passthrough and voxel grid downsample stages in a
+ * single pass over the input buffer, so that no intermediate cloud is materialized.
+ */
+class FusedFilterComponent : public pointcloud_preprocessor::Filter
+{
+protected:
+  void filter(
+    const PointCloud2ConstPtr & input, const IndicesPtr & indices, PointCloud2 & output) override;
+
+private:
+  enum class StageType { CropBox, PassThrough, VoxelGridDownsample };
+
+  struct Stage
+  {
+    std::string name;
+    StageType type;
+    // crop box
+    float min_x{-1.0f};
+    float max_x{1.0f};
+    float min_y{-1.0f};
+    float max_y{1.0f};
+    float min_z{-1.0f};
+    float max_z{1.0f};
+    // passthrough
+    std::string field_name;
+    uint32_t field_offset{0U};
+    uint8_t field_datatype{0U};
+    double min{0.0};
+    double max{0.0};
+    // crop box and passthrough
+    bool negative{false};
+    // voxel grid downsample
+    float voxel_size_x{0.3f};
+    float voxel_size_y{0.3f};
+    float voxel_size_z{0.1f};
+  };
+
+  std::vector<Stage> stages_;
+
+  /** \brief Point offsets kept by the pointwise stages, reused across frames. */
+  std::vector<std::size_t> kept_offsets_;
+
+  /** \brief Centroids of the terminal voxel grid downsample stage, reused across frames. */
+  VoxelCentroidTable voxel_centroid_table_;
+
+  /** \brief Parameter service callback result : needed to be hold */
+  OnSetParametersCallbackHandle::SharedPtr set_param_res_;
+
+  /** \brief Parameter service callback */
+  rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
+
+  bool isPointKept(
+    const Stage & stage, const uint8_t * point, const float x, const float y, const float z) const;
+
+public:
+  PCL_MAKE_ALIGNED_OPERATOR_NEW
+  explicit FusedFilterComponent(const rclcpp::NodeOptions & options);
+};
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__FUSED_FILTER__FUSED_FILTER_NODELET_HPP_
@@ -15,6 +15,7 @@
 #ifndef POINTCLOUD_PREPROCESSOR__OUTLIER_FILTER__DUAL_RETURN_OUTLIER_FILTER_NODELET_HPP_
 #define POINTCLOUD_PREPROCESSOR__OUTLIER_FILTER__DUAL_RETURN_OUTLIER_FILTER_NODELET_HPP_
 
+#include "autoware_point_types/types.hpp"
 #include "pointcloud_preprocessor/filter.hpp"
 
 #include <diagnostic_updater/diagnostic_updater.hpp>
@@ -30,6 +31,7 @@
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/search/pcl_search.h>
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -61,7 +63,48 @@ protected:
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr noise_cloud_pub_;
 
 private:
+  /** \brief Byte offsets of the points of a ring to keep and to remove as noise */
+  struct RingOutput
+  {
+    std::vector<std::size_t> kept;
+    std::vector<std::size_t> noise;
+    /** \brief Per-ring scratch of the weak first walk, reused across frames */
+    std::vector<std::size_t> temp_segment;
+    std::vector<float> deleted_azimuths;
+  };
+
+  /** \brief Azimuth range of the visibility histogram, resolved once per frame */
+  struct AzimuthRange
+  {
+    uint8_t roi_mode;
+    float min_azimuth;
+    float max_azimuth;
+    uint32_t horizontal_res;
+  };
+
   void onVisibilityChecker(DiagnosticStatusWrapper & stat);
+
+  /** \brief Walk a ring of weak first returns, and write the noise frequency of its azimuth bins
+   * to its row of the frequency table. Only touches the given ring buffers and row, so rings can
+   * be processed concurrently.
+   */
+  void filterWeakFirstRing(
+    const PointCloud2 & input, const std::vector<std::size_t> & ring_indices,
+    const AzimuthRange & azimuth_range, RingOutput & ring_output, uint8_t * frequency_row) const;
+
+  /** \brief Walk a ring of the other returns. Only touches the given ring buffers. */
+  void filterRing(
+    const PointCloud2 & input, const std::vector<std::size_t> & ring_indices,
+    RingOutput & ring_output) const;
+
+  /** \brief Concatenate the given points of the rings, the weak first returns first */
+  void copyPoints(
+    const PointCloud2 & cloud, std::vector<std::size_t> RingOutput::*points,
+    PointCloud2 & output) const;
+
+  /** \brief Check the input has the memory layout of PointXYZIRADRT, to be read in place */
+  bool hasPointLayout(const PointCloud2 & input) const;
+
   Updater updater_{this};
   double visibility_ = -1.0f;
   double weak_first_distance_ratio_;
@@ -82,6 +125,19 @@ private:
   float min_azimuth_deg_;
   float max_azimuth_deg_;
   float max_distance_;
+  int num_threads_;
+
+  /** \brief Fields of PointXYZIRADRT, which are those of the clouds read in place */
+  std::vector<sensor_msgs::msg::PointField> point_fields_;
+
+  /** \brief Ring-major tables of point byte offsets, reused across frames */
+  std::vector<std::vector<std::size_t>> weak_first_ring_indices_;
+  std::vector<std::vector<std::size_t>> ring_indices_;
+  std::vector<RingOutput> weak_first_ring_outputs_;
+  std::vector<RingOutput> ring_outputs_;
+
+  /** \brief Noise frequency of each ring and azimuth bin of the weak first returns */
+  std::vector<uint8_t> frequency_table_;
 
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
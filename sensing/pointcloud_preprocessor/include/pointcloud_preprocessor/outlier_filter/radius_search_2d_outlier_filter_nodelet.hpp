@@ -24,6 +24,7 @@
 #include <pcl/filters/voxel_grid.h>
 #include <pcl/search/pcl_search.h>
 
+#include <cstdint>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -37,17 +38,32 @@ protected:
 private:
   double search_radius_;
   size_t min_neighbors_;
+  bool use_grid_;
 
   // pcl::RadiusOutlierRemoval<pcl::PCLPointCloud2> radius_outlier_removal_;
   pcl::search::Search<pcl::PointXY>::Ptr kd_tree_;
   // pcl::ExtractIndices<pcl::PCLPointCloud2> extract_indices_;
 
+  /** \brief Uniform 2D grid with cells of search_radius_, stored as points bucketed by cell.
+   * The buffers are reused across frames. */
+  std::vector<uint32_t> grid_point_cells_;
+  std::vector<uint32_t> grid_cell_starts_;
+  std::vector<uint32_t> grid_cell_points_;
+
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
 
   /** \brief Parameter service callback */
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
+  void filterByKdTree(
+    const pcl::PointCloud<pcl::PointXYZ> & xyz_cloud, pcl::PointCloud<pcl::PointXYZ> & pcl_output);
+
+  /** \brief Only the 3x3 cells around a point can hold neighbors, and the count of a point stops
+   * as soon as min_neighbors_ is reached. Returns false if the grid would be too large. */
+  bool filterByGrid(
+    const pcl::PointCloud<pcl::PointXYZ> & xyz_cloud, pcl::PointCloud<pcl::PointXYZ> & pcl_output);
+
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
   explicit RadiusSearch2DOutlierFilterComponent(const rclcpp::NodeOptions & options);
@@ -38,6 +38,14 @@ private:
   double distance_ratio_;
   double object_length_threshold_;
   int num_points_threshold_;
+  int num_rings_;
+  int num_threads_;
+
+  /** \brief Ring-major table of point byte offsets, reused across frames to avoid reallocation */
+  std::vector<std::vector<std::size_t>> ring_indices_;
+
+  /** \brief Per-ring byte offsets of the surviving points, merged in ring order */
+  std::vector<std::vector<std::size_t>> ring_outputs_;
 
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
@@ -45,17 +53,24 @@ private:
   /** \brief Parameter service callback */
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
+  /** \brief Walk a single ring and store the offsets of the points to keep.
+   * Only touches the given ring buffers, so rings can be processed concurrently.
+   */
+  void filterRing(
+    const PointCloud2ConstPtr & input, const std::vector<std::size_t> & ring_indices,
+    std::vector<std::size_t> & ring_output) const;
+
   bool isCluster(
-    sensor_msgs::msg::PointCloud2::SharedPtr & input_ptr,
-    const std::vector<std::size_t> & tmp_indices)
+    const PointCloud2ConstPtr & input, const std::size_t front_idx, const std::size_t back_idx,
+    const std::size_t walk_size) const
   {
-    PointXYZI * front_pt = reinterpret_cast<PointXYZI *>(&input_ptr->data[tmp_indices.front()]);
-    PointXYZI * back_pt = reinterpret_cast<PointXYZI *>(&input_ptr->data[tmp_indices.back()]);
+    const auto * front_pt = reinterpret_cast<const PointXYZI *>(&input->data[front_idx]);
+    const auto * back_pt = reinterpret_cast<const PointXYZI *>(&input->data[back_idx]);
 
     const auto x_diff = front_pt->x - back_pt->x;
     const auto y_diff = front_pt->y - back_pt->y;
     const auto z_diff = front_pt->z - back_pt->z;
-    return static_cast<int>(tmp_indices.size()) > num_points_threshold_ ||
+    return static_cast<int>(walk_size) > num_points_threshold_ ||
            (x_diff * x_diff) + (y_diff * y_diff) + (z_diff * z_diff) >=
              object_length_threshold_ * object_length_threshold_;
   }
@@ -17,8 +17,7 @@
 
 #include "pointcloud_preprocessor/filter.hpp"
 
-#include <boost/circular_buffer.hpp>
-
+#include <cstdint>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -36,8 +35,26 @@ protected:
   rcl_interfaces::msg::SetParametersResult paramCallback(const std::vector<rclcpp::Parameter> & p);
 
 private:
+  /** \brief The x/y/z of a cloud in the layout of the output, kept across the frames so that
+   * the buffer is only reallocated while the clouds grow.
+   */
+  struct AccumulatedFrame
+  {
+    rclcpp::Time stamp;
+    std::vector<uint8_t> data;
+    size_t num_points = 0;
+    bool is_dense = true;
+  };
+
+  /** \brief Ring of the latest frames, with the newest at newest_frame_index_. */
+  std::vector<AccumulatedFrame> frames_;
+  size_t newest_frame_index_ = 0;
+  size_t num_frames_ = 0;
+
   double accumulation_time_sec_;
-  boost::circular_buffer<PointCloud2ConstPtr> pointcloud_buffer_;
+
+  void setBufferSize(const size_t buffer_size);
+  bool writeFrame(const PointCloud2 & input, AccumulatedFrame & frame);
 
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
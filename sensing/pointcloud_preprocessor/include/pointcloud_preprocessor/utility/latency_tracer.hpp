@@ -0,0 +1,89 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__UTILITY__LATENCY_TRACER_HPP_
+#define POINTCLOUD_PREPROCESSOR__UTILITY__LATENCY_TRACER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace pointcloud_preprocessor
+{
+/**
+ * @brief One stage execution for one message. The layout is read by
+ * scripts/latency_trace_report.py, keep both in sync.
+ */
+struct LatencyTraceRecord
+{
+  /** @brief write index + 1 once the record is complete, 0 while it is being written */
+  std::atomic<uint64_t> sequence;
+  /** @brief header stamp of the traced message, i.e. the sensor time of the scan */
+  int64_t header_stamp_ns;
+  /** @brief system clock time when the stage received and published the message */
+  int64_t entry_ns;
+  int64_t exit_ns;
+  uint32_t pid;
+  uint32_t reserved;
+  char stage[88];
+};
+static_assert(sizeof(LatencyTraceRecord) == 128, "LatencyTraceRecord layout changed");
+
+struct LatencyTraceHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t capacity;
+  std::atomic<uint64_t> write_index;
+  uint8_t padding[40];
+};
+static_assert(sizeof(LatencyTraceHeader) == 64, "LatencyTraceHeader layout changed");
+
+/**
+ * @brief Writer of a ring buffer of stage records in POSIX shared memory, shared by all the
+ * processes that open the same name. Records are written lock-free, the oldest are overwritten.
+ */
+class LatencyTracer
+{
+public:
+  static constexpr uint32_t magic = 0x4c545243;  // "LTRC"
+  static constexpr uint32_t version = 1U;
+  static constexpr uint64_t capacity = 65536U;
+
+  LatencyTracer() = default;
+  ~LatencyTracer();
+  LatencyTracer(const LatencyTracer &) = delete;
+  LatencyTracer & operator=(const LatencyTracer &) = delete;
+
+  /** @brief Map the shared memory object, creating it if needed. Returns false on failure. */
+  bool open(const std::string & name);
+  bool isOpen() const { return header_ != nullptr; }
+
+  void record(
+    const std::string & stage, const int64_t header_stamp_ns, const int64_t entry_ns,
+    const int64_t exit_ns);
+
+  /** @brief System clock in nanoseconds, comparable to hardware-synchronized header stamps. */
+  static int64_t now();
+
+private:
+  LatencyTraceHeader * header_{nullptr};
+  LatencyTraceRecord * records_{nullptr};
+  std::size_t size_{0U};
+  uint32_t pid_{0U};
+};
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__UTILITY__LATENCY_TRACER_HPP_
@@ -0,0 +1,218 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_PREPROCESSOR__UTILITY__POINTCLOUD_BUFFER_POOL_HPP_
+#define POINTCLOUD_PREPROCESSOR__UTILITY__POINTCLOUD_BUFFER_POOL_HPP_
+
+#include <rclcpp/allocator/allocator_deleter.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace pointcloud_preprocessor
+{
+/**
+ * @brief Process-wide pool of the data buffers of PointCloud2 messages, shared by the components
+ * of a container. The buffers are kept by size class, the class of a buffer being the floor of the
+ * log2 of its capacity, in a few slots per class. Both taking and giving back a buffer only swap it
+ * with a slot claimed by a compare-and-swap, so neither locks nor allocates.
+ */
+class PointCloud2BufferPool
+{
+public:
+  using Buffer = sensor_msgs::msg::PointCloud2::_data_type;
+
+  /** @brief The pool is never destroyed, for the messages released at exit to give it back. */
+  static PointCloud2BufferPool & instance()
+  {
+    static auto * pool = new PointCloud2BufferPool();
+    return *pool;
+  }
+
+  /**
+   * @brief take an empty buffer with a capacity of at least size, reserved if none is pooled
+   */
+  Buffer acquire(const std::size_t size)
+  {
+    Buffer buffer;
+    if (size == 0) {
+      return buffer;
+    }
+
+    const std::size_t size_class = sizeClass(size);
+    for (std::size_t c = size_class; c <= size_class + 1; ++c) {
+      if (c < min_size_class || min_size_class + size_class_num <= c) {
+        continue;
+      }
+      for (auto & slot : slots_[c - min_size_class]) {
+        if (!take(slot, buffer)) {
+          continue;
+        }
+        if (size <= buffer.capacity()) {
+          return buffer;
+        }
+        // too small within the same class, left for a smaller request
+        release(std::move(buffer));
+        buffer = Buffer();
+      }
+    }
+
+    // some headroom for the next messages, whose size usually varies a little
+    buffer.reserve(size + size / 4);
+    return buffer;
+  }
+
+  /**
+   * @brief give a buffer back, which is freed if it is out of the size classes or its class is full
+   */
+  void release(Buffer && buffer)
+  {
+    const std::size_t size_class = sizeClass(buffer.capacity());
+    if (
+      buffer.capacity() == 0 || size_class < min_size_class ||
+      min_size_class + size_class_num <= size_class) {
+      return;
+    }
+
+    buffer.clear();
+    for (auto & slot : slots_[size_class - min_size_class]) {
+      if (put(slot, buffer)) {
+        return;
+      }
+    }
+  }
+
+private:
+  enum SlotState : int { EMPTY, BUSY, FULL };
+
+  struct Slot
+  {
+    std::atomic<int> state{EMPTY};
+    Buffer buffer;
+  };
+
+  // buffers from 64 KiB, the smaller ones being left to the allocator, up to 4 GiB
+  static constexpr std::size_t min_size_class = 16;
+  static constexpr std::size_t size_class_num = 16;
+  static constexpr std::size_t slot_num = 4;
+
+  PointCloud2BufferPool() = default;
+
+  static std::size_t sizeClass(std::size_t size)
+  {
+    std::size_t size_class = 0;
+    while (size >>= 1) {
+      ++size_class;
+    }
+    return size_class;
+  }
+
+  static bool take(Slot & slot, Buffer & buffer)
+  {
+    int expected = FULL;
+    if (!slot.state.compare_exchange_strong(expected, BUSY, std::memory_order_acquire)) {
+      return false;
+    }
+    buffer.swap(slot.buffer);
+    slot.state.store(EMPTY, std::memory_order_release);
+    return true;
+  }
+
+  // an empty slot holds a buffer without capacity, which is left in buffer
+  static bool put(Slot & slot, Buffer & buffer)
+  {
+    int expected = EMPTY;
+    if (!slot.state.compare_exchange_strong(expected, BUSY, std::memory_order_acquire)) {
+      return false;
+    }
+    slot.buffer.swap(buffer);
+    slot.state.store(FULL, std::memory_order_release);
+    return true;
+  }
+
+  std::array<std::array<Slot, slot_num>, size_class_num> slots_;
+};
+
+/**
+ * @brief Allocator giving the data buffer of a PointCloud2 back to PointCloud2BufferPool when the
+ * message is destroyed through it. A publisher created with it destroys the messages published as
+ * UniquePtr through it, i.e. once the last intra-process subscriber releases them.
+ */
+template <class T>
+class PointCloud2PoolAllocator
+{
+public:
+  using value_type = T;
+
+  PointCloud2PoolAllocator() noexcept = default;
+  template <class U>
+  PointCloud2PoolAllocator(const PointCloud2PoolAllocator<U> &) noexcept  // NOLINT
+  {
+  }
+
+  T * allocate(const std::size_t n) { return std::allocator<T>().allocate(n); }
+  void deallocate(T * p, const std::size_t n) { std::allocator<T>().deallocate(p, n); }
+
+  template <class U>
+  void destroy(U * p)
+  {
+    if constexpr (std::is_same_v<U, sensor_msgs::msg::PointCloud2>) {
+      PointCloud2BufferPool::instance().release(std::move(p->data));
+    }
+    p->~U();
+  }
+
+  template <class U>
+  bool operator==(const PointCloud2PoolAllocator<U> &) const noexcept
+  {
+    return true;
+  }
+  template <class U>
+  bool operator!=(const PointCloud2PoolAllocator<U> &) const noexcept
+  {
+    return false;
+  }
+};
+
+using PointCloud2PoolDeleter = rclcpp::allocator::Deleter<
+  PointCloud2PoolAllocator<sensor_msgs::msg::PointCloud2>, sensor_msgs::msg::PointCloud2>;
+/** @brief Message type expected by the publish() of a publisher with PointCloud2PoolAllocator. */
+using PooledPointCloud2Ptr = std::unique_ptr<sensor_msgs::msg::PointCloud2, PointCloud2PoolDeleter>;
+
+/**
+ * @brief make an empty message whose data buffer is taken from PointCloud2BufferPool with a
+ * capacity of at least data_size, e.g. for a PointCloud2Modifier to resize it without allocating
+ */
+inline PooledPointCloud2Ptr makePooledPointCloud2(const std::size_t data_size)
+{
+  using Allocator = PointCloud2PoolAllocator<sensor_msgs::msg::PointCloud2>;
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+  // stateless, referred to by all the deleters
+  static Allocator allocator;
+
+  auto * msg = AllocatorTraits::allocate(allocator, 1);
+  AllocatorTraits::construct(allocator, msg);
+  msg->data = PointCloud2BufferPool::instance().acquire(data_size);
+  return PooledPointCloud2Ptr(msg, PointCloud2PoolDeleter(&allocator));
+}
+
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__UTILITY__POINTCLOUD_BUFFER_POOL_HPP_
@@ -19,6 +19,8 @@
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <sensor_msgs/point_cloud2_iterator.hpp>
 
+#include <Eigen/Geometry>
+
 #include <CGAL/Exact_predicates_inexact_constructions_kernel.h>
 #include <CGAL/Polygon_2_algorithms.h>
 #include <lanelet2_core/geometry/Polygon.h>
@@ -26,6 +28,8 @@
 #include <pcl/point_types.h>
 #include <pcl_conversions/pcl_conversions.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 using K = CGAL::Exact_predicates_inexact_constructions_kernel;
@@ -78,6 +82,23 @@ void remove_polygon_cgal_from_cloud(
 bool point_within_cgal_polys(
   const pcl::PointXYZ & point, const std::vector<PolygonCgal> & polyline_polygons);
 
+/**
+ * @brief apply the transform to x, y and z of the points stored in a raw buffer, in place.
+ * The other fields are left untouched, so any point_step and field layout can be used.
+ * Uses AVX2 or NEON when the target supports it.
+ */
+void transform_points_inplace(
+  const Eigen::Affine3f & transform, uint8_t * data, const std::size_t num_points,
+  const std::size_t point_step, const std::size_t x_offset, const std::size_t y_offset,
+  const std::size_t z_offset);
+
+/**
+ * @brief apply the transform to the float32 x, y and z fields of the cloud, in place
+ * @return false if the cloud does not have float32 x, y and z fields
+ */
+bool transform_pointcloud_inplace(
+  const Eigen::Affine3f & transform, sensor_msgs::msg::PointCloud2 & cloud);
+
 }  // namespace pointcloud_preprocessor::utils
 
 #endif  // POINTCLOUD_PREPROCESSOR__UTILITY__UTILITIES_HPP_
@@ -15,6 +15,8 @@
 #ifndef POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET2_MAP_FILTER_NODELET_HPP_
 #define POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__LANELET2_MAP_FILTER_NODELET_HPP_
 
+#include "pointcloud_preprocessor/vector_map_filter/polygon_raster_mask.hpp"
+
 #include <lanelet2_extension/utility/message_conversion.hpp>
 #include <lanelet2_extension/utility/query.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -64,9 +66,11 @@ private:
 
   lanelet::LaneletMapPtr lanelet_map_ptr_;
   lanelet::ConstLanelets road_lanelets_;
+  PolygonRasterMask road_mask_;
 
   float voxel_size_x_;
   float voxel_size_y_;
+  bool use_raster_mask_;
 
   void pointcloudCallback(const PointCloud2ConstPtr msg);
 
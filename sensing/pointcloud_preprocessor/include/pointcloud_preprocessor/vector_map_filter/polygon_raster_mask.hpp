@@ -0,0 +1,74 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__POLYGON_RASTER_MASK_HPP_
+#define POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__POLYGON_RASTER_MASK_HPP_
+
+#include <lanelet2_core/primitives/Polygon.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+/** \brief 2D polygons rasterized into a square bitmask around a center, so that testing whether a
+ * point is inside any of them is a single lookup. A cell is inside when its center is. The mask
+ * is rasterized again when the center moves by more than a quarter of its size, and the points
+ * out of it are tested against the polygons themselves.
+ */
+class PolygonRasterMask
+{
+public:
+  /** \brief Set the resolution and the side length of the mask, clearing it. */
+  void setGeometry(const double resolution, const double size);
+
+  /** \brief Set the polygons to test the points against, clearing the mask. */
+  void setPolygons(const std::vector<lanelet::BasicPolygon2d> & polygons);
+
+  /** \brief Rasterize the mask around (x, y) unless the current one is still centered near it. */
+  void updateCenter(const double x, const double y);
+
+  /** \brief Whether (x, y) is inside any of the polygons, up to the resolution in the mask. */
+  bool isInside(const double x, const double y) const;
+
+private:
+  struct Polygon
+  {
+    lanelet::BasicPolygon2d points;
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+  };
+
+  void rasterize(const Polygon & polygon);
+  bool isInsidePolygons(const double x, const double y) const;
+
+  double resolution_{0.1};
+  double size_{200.0};
+  std::vector<Polygon> polygons_;
+
+  bool has_mask_{false};
+  double center_x_{0.0};
+  double center_y_{0.0};
+  double origin_x_{0.0};
+  double origin_y_{0.0};
+  int cell_num_{0};  // along each axis
+  std::vector<uint8_t> cells_;  // row major, y being the row
+  std::vector<double> crossings_;  // work buffer of the scanlines
+};
+}  // namespace pointcloud_preprocessor
+
+#endif  // POINTCLOUD_PREPROCESSOR__VECTOR_MAP_FILTER__POLYGON_RASTER_MASK_HPP_
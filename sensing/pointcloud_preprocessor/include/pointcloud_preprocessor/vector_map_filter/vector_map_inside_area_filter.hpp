@@ -17,6 +17,7 @@
 
 #include "pointcloud_preprocessor/filter.hpp"
 #include "pointcloud_preprocessor/utility/utilities.hpp"
+#include "pointcloud_preprocessor/vector_map_filter/polygon_raster_mask.hpp"
 
 #include <lanelet2_extension/utility/message_conversion.hpp>
 #include <lanelet2_extension/utility/query.hpp>
@@ -25,6 +26,7 @@
 #include <lanelet2_core/geometry/Polygon.h>
 
 #include <string>
+#include <vector>
 
 using tier4_autoware_utils::MultiPoint2d;
 
@@ -39,11 +41,13 @@ private:
 
   rclcpp::Subscription<autoware_auto_mapping_msgs::msg::HADMapBin>::SharedPtr map_sub_;
   lanelet::ConstPolygons3d polygon_lanelets_;
+  PolygonRasterMask polygon_mask_;
 
   void mapCallback(const autoware_auto_mapping_msgs::msg::HADMapBin::ConstSharedPtr msg);
 
   // parameter
   std::string polygon_type_;
+  bool use_raster_mask_;
 
 public:
   PCL_MAKE_ALIGNED_OPERATOR_NEW
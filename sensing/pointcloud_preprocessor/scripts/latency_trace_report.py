@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+
+# Copyright 2022 Tier IV, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Reconstructs per-scan latencies from the shared memory ring written by the pointcloud_preprocessor
+# filters with latency_trace:=true, and prints a latency histogram per stage.
+
+import argparse
+from collections import defaultdict
+import mmap
+import os
+import struct
+
+# keep in sync with include/pointcloud_preprocessor/utility/latency_tracer.hpp
+HEADER = struct.Struct("<IIQQ40x")
+RECORD = struct.Struct("<QqqqII88s")
+MAGIC = 0x4C545243
+VERSION = 1
+
+
+def read_records(name):
+    path = os.path.join("/dev/shm", name.lstrip("/"))
+    with open(path, "rb") as f:
+        buf = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    magic, version, capacity, write_index = HEADER.unpack_from(buf, 0)
+    if magic != MAGIC or version != VERSION:
+        raise RuntimeError("{} is not a latency trace buffer of version {}".format(path, VERSION))
+
+    records = []
+    for index in range(max(0, write_index - capacity), write_index):
+        offset = HEADER.size + (index % capacity) * RECORD.size
+        sequence, stamp, entry, exit_, pid, _, stage = RECORD.unpack_from(buf, offset)
+        # skip the records being written or already overwritten
+        if sequence != index + 1:
+            continue
+        records.append((stage.split(b"\0", 1)[0].decode(), stamp, entry, exit_, pid))
+    return records
+
+
+def percentile(sorted_values, ratio):
+    return sorted_values[min(len(sorted_values) - 1, int(ratio * len(sorted_values)))]
+
+
+def print_histogram(title, values_ms, num_bins):
+    values_ms.sort()
+    print(
+        "{}: n={} p50={:.2f} p90={:.2f} p99={:.2f} max={:.2f} [ms]".format(
+            title,
+            len(values_ms),
+            percentile(values_ms, 0.5),
+            percentile(values_ms, 0.9),
+            percentile(values_ms, 0.99),
+            values_ms[-1],
+        )
+    )
+    low, high = values_ms[0], values_ms[-1]
+    width = (high - low) / num_bins if high > low else 1.0
+    counts = [0] * num_bins
+    for v in values_ms:
+        counts[min(num_bins - 1, int((v - low) / width))] += 1
+    for i, count in enumerate(counts):
+        bar = "#" * (50 * count // max(counts))
+        print(
+            "  {:9.2f} - {:9.2f} | {:6d} {}".format(
+                low + i * width, low + (i + 1) * width, count, bar
+            )
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Print per stage latency histograms of a pointcloud_preprocessor trace"
+    )
+    parser.add_argument("--name", default="/pointcloud_preprocessor_latency_trace")
+    parser.add_argument("--bins", type=int, default=10)
+    args = parser.parse_args()
+
+    records = read_records(args.name)
+    if not records:
+        print("no records")
+        return
+
+    processing = defaultdict(list)
+    since_stamp = defaultdict(list)
+    scan_exit = defaultdict(int)
+    for stage, stamp, entry, exit_, _ in records:
+        processing[stage].append((exit_ - entry) * 1e-6)
+        since_stamp[stage].append((exit_ - stamp) * 1e-6)
+        scan_exit[stamp] = max(scan_exit[stamp], exit_)
+
+    for stage in sorted(processing, key=lambda s: sorted(since_stamp[s])[len(since_stamp[s]) // 2]):
+        print_histogram(stage + " processing", processing[stage], args.bins)
+        print_histogram(stage + " since header stamp", since_stamp[stage], args.bins)
+    print_histogram(
+        "end to end", [(exit_ - stamp) * 1e-6 for stamp, exit_ in scan_exit.items()], args.bins
+    )
+
+
+if __name__ == "__main__":
+    main()
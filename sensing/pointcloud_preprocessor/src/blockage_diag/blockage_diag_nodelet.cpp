@@ -19,12 +19,67 @@
 #include <boost/thread/detail/platform_time.hpp>
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 
 namespace pointcloud_preprocessor
 {
 using autoware_point_types::PointXYZIRADRT;
 using diagnostic_msgs::msg::DiagnosticStatus;
 
+namespace
+{
+// integral[(r + 1) * (cols + 1) + c + 1] is the sum of mask[0..r][0..c]
+void computeIntegral(
+  const std::vector<uint8_t> & mask, const uint rows, const uint cols,
+  std::vector<uint32_t> & integral)
+{
+  integral.assign(static_cast<std::size_t>(rows + 1) * (cols + 1), 0U);
+  for (uint r = 0; r < rows; ++r) {
+    uint32_t row_sum = 0U;
+    for (uint c = 0; c < cols; ++c) {
+      row_sum += mask[r * cols + c];
+      integral[(r + 1) * (cols + 1) + c + 1] = integral[r * (cols + 1) + c + 1] + row_sum;
+    }
+  }
+}
+
+// sum of the mask over the window of the given half size around (r, c), clipped to the image
+uint32_t windowSum(
+  const std::vector<uint32_t> & integral, const uint rows, const uint cols, const uint r,
+  const uint c, const uint half_size, uint32_t & area)
+{
+  const uint r0 = r > half_size ? r - half_size : 0U;
+  const uint c0 = c > half_size ? c - half_size : 0U;
+  const uint r1 = std::min(r + half_size + 1, rows);
+  const uint c1 = std::min(c + half_size + 1, cols);
+  area = (r1 - r0) * (c1 - c0);
+  return integral[r1 * (cols + 1) + c1] - integral[r0 * (cols + 1) + c1] -
+         integral[r1 * (cols + 1) + c0] + integral[r0 * (cols + 1) + c0];
+}
+
+// opening with a square element, with the border handling of cv::erode and cv::dilate
+void openMask(
+  std::vector<uint8_t> & mask, std::vector<uint8_t> & eroded, std::vector<uint32_t> & integral,
+  const uint rows, const uint cols, const uint half_size)
+{
+  uint32_t area;
+  computeIntegral(mask, rows, cols, integral);
+  eroded.resize(mask.size());
+  for (uint r = 0; r < rows; ++r) {
+    for (uint c = 0; c < cols; ++c) {
+      eroded[r * cols + c] = windowSum(integral, rows, cols, r, c, half_size, area) == area;
+    }
+  }
+  computeIntegral(eroded, rows, cols, integral);
+  for (uint r = 0; r < rows; ++r) {
+    for (uint c = 0; c < cols; ++c) {
+      mask[r * cols + c] = windowSum(integral, rows, cols, r, c, half_size, area) > 0U;
+    }
+  }
+}
+}  // namespace
+
 BlockageDiagComponent::BlockageDiagComponent(const rclcpp::NodeOptions & options)
 : Filter("BlockageDiag", options)
 {
@@ -38,6 +93,7 @@ BlockageDiagComponent::BlockageDiagComponent(const rclcpp::NodeOptions & options
     lidar_model_ = static_cast<std::string>(declare_parameter("model", "Pandar40P"));
     blockage_count_threshold_ =
       static_cast<uint>(declare_parameter("blockage_count_threshold", 50));
+    use_streaming_ = static_cast<bool>(declare_parameter("use_streaming", false));
   }
 
   updater_.setHardwareID("blockage_diag");
@@ -109,6 +165,13 @@ void BlockageDiagComponent::filter(
   PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
+  if (use_streaming_) {
+    updateBlockageStreaming(*input);
+    publishBlockageRatios();
+    output = *input;
+    return;
+  }
+
   uint horizontal_bins = static_cast<uint>((angle_range_deg_[1] - angle_range_deg_[0]));
   uint vertical_bins = vertical_bins_;
   pcl::PointCloud<PointXYZIRADRT>::Ptr pcl_input(new pcl::PointCloud<PointXYZIRADRT>);
@@ -210,6 +273,120 @@ void BlockageDiagComponent::filter(
     blockage_mask_pub_.publish(blockage_mask_msg);
   }
 
+  publishBlockageRatios();
+
+  pcl::toROSMsg(*pcl_input, output);
+  output.header = input->header;
+}
+
+void BlockageDiagComponent::updateBlockageStreaming(const PointCloud2 & input)
+{
+  const uint horizontal_bins = static_cast<uint>((angle_range_deg_[1] - angle_range_deg_[0]));
+  const uint vertical_bins = vertical_bins_;
+  const bool publish_depth_map = lidar_depth_map_pub_.getNumSubscribers() > 0;
+  const bool publish_blockage_mask = blockage_mask_pub_.getNumSubscribers() > 0;
+
+  // 1 marks a bin without any return
+  no_return_mask_.assign(static_cast<std::size_t>(horizontal_bins) * vertical_bins, 1U);
+  if (publish_depth_map) {
+    depth_bins_.assign(no_return_mask_.size(), 0U);
+  }
+
+  using autoware_point_types::PointIndex;
+  const auto ring_offset = input.fields.at(static_cast<size_t>(PointIndex::Ring)).offset;
+  const auto azimuth_offset = input.fields.at(static_cast<size_t>(PointIndex::Azimuth)).offset;
+  const auto distance_offset = input.fields.at(static_cast<size_t>(PointIndex::Distance)).offset;
+  const bool is_pandar_qt = lidar_model_ == "PandarQT";
+  if (is_pandar_qt || lidar_model_ == "Pandar40P") {
+    for (std::size_t idx = 0U; idx + input.point_step <= input.data.size();
+         idx += input.point_step) {
+      float azimuth;
+      std::memcpy(&azimuth, &input.data[idx + azimuth_offset], sizeof(float));
+      const double azimuth_deg = azimuth / 100.0;
+      if (!(azimuth_deg > angle_range_deg_[0] && azimuth_deg < angle_range_deg_[1])) {
+        continue;
+      }
+      uint16_t ring;
+      std::memcpy(&ring, &input.data[idx + ring_offset], sizeof(uint16_t));
+      if (ring >= vertical_bins) {
+        continue;
+      }
+      const uint row = is_pandar_qt ? vertical_bins - ring - 1 : ring;
+      const uint col = static_cast<uint>(azimuth_deg - angle_range_deg_[0]);
+      if (col >= horizontal_bins) {
+        continue;
+      }
+      no_return_mask_[row * horizontal_bins + col] = 0U;
+      if (publish_depth_map) {
+        float distance;
+        std::memcpy(&distance, &input.data[idx + distance_offset], sizeof(float));
+        depth_bins_[row * horizontal_bins + col] += static_cast<uint16_t>(6250.0 / distance);
+      }
+    }
+  }
+  openMask(
+    no_return_mask_, eroded_mask_, mask_integral_, vertical_bins, horizontal_bins, erode_kernel_);
+
+  // blockage ratio and azimuth extent of the rows [row_begin, row_end)
+  const auto update_blockage = [&](
+                                 const uint row_begin, const uint row_end, float & ratio,
+                                 std::vector<float> & range_deg, uint & count) {
+    uint num_blocked = 0U;
+    uint min_col = std::numeric_limits<uint>::max();
+    uint max_col = 0U;
+    for (uint r = row_begin; r < row_end; ++r) {
+      for (uint c = 0; c < horizontal_bins; ++c) {
+        if (no_return_mask_[r * horizontal_bins + c]) {
+          ++num_blocked;
+          min_col = std::min(min_col, c);
+          max_col = std::max(max_col, c);
+        }
+      }
+    }
+    ratio = static_cast<float>(num_blocked) /
+            static_cast<float>(horizontal_bins * (row_end - row_begin));
+    if (ratio > blockage_ratio_threshold_) {
+      range_deg[0] = static_cast<float>(min_col) + angle_range_deg_[0];
+      range_deg[1] = static_cast<float>(max_col + 1) + angle_range_deg_[0];
+      if (count <= 2 * blockage_count_threshold_) {
+        count += 1;
+      }
+    } else {
+      count = 0;
+    }
+  };
+  update_blockage(
+    horizontal_ring_id_, vertical_bins, ground_blockage_ratio_, ground_blockage_range_deg_,
+    ground_blockage_count_);
+  update_blockage(
+    0U, horizontal_ring_id_, sky_blockage_ratio_, sky_blockage_range_deg_, sky_blockage_count_);
+
+  if (publish_depth_map) {
+    cv::Mat lidar_depth_map(
+      cv::Size(horizontal_bins, vertical_bins), CV_16UC1, depth_bins_.data());
+    cv::Mat lidar_depth_map_8u;
+    lidar_depth_map.convertTo(lidar_depth_map_8u, CV_8UC1, 1.0 / 100.0);
+    cv::Mat lidar_depth_colorized;
+    cv::applyColorMap(lidar_depth_map_8u, lidar_depth_colorized, cv::COLORMAP_JET);
+    sensor_msgs::msg::Image::SharedPtr lidar_depth_msg =
+      cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", lidar_depth_colorized).toImageMsg();
+    lidar_depth_msg->header = input.header;
+    lidar_depth_map_pub_.publish(lidar_depth_msg);
+  }
+  if (publish_blockage_mask) {
+    cv::Mat no_return_mask(
+      cv::Size(horizontal_bins, vertical_bins), CV_8UC1, no_return_mask_.data());
+    cv::Mat blockage_mask_colorized;
+    cv::applyColorMap(no_return_mask * 255, blockage_mask_colorized, cv::COLORMAP_JET);
+    sensor_msgs::msg::Image::SharedPtr blockage_mask_msg =
+      cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", blockage_mask_colorized).toImageMsg();
+    blockage_mask_msg->header = input.header;
+    blockage_mask_pub_.publish(blockage_mask_msg);
+  }
+}
+
+void BlockageDiagComponent::publishBlockageRatios()
+{
   tier4_debug_msgs::msg::Float32Stamped ground_blockage_ratio_msg;
   ground_blockage_ratio_msg.data = ground_blockage_ratio_;
   ground_blockage_ratio_msg.stamp = now();
@@ -219,9 +396,6 @@ void BlockageDiagComponent::filter(
   sky_blockage_ratio_msg.data = sky_blockage_ratio_;
   sky_blockage_ratio_msg.stamp = now();
   sky_blockage_ratio_pub_->publish(sky_blockage_ratio_msg);
-
-  pcl::toROSMsg(*pcl_input, output);
-  output.header = input->header;
 }
 rcl_interfaces::msg::SetParametersResult BlockageDiagComponent::paramCallback(
   const std::vector<rclcpp::Parameter> & p)
@@ -244,6 +418,9 @@ rcl_interfaces::msg::SetParametersResult BlockageDiagComponent::paramCallback(
   if (get_param(p, "model", lidar_model_)) {
     RCLCPP_DEBUG(get_logger(), "Setting new lidar model to: %s. ", lidar_model_.c_str());
   }
+  if (get_param(p, "use_streaming", use_streaming_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new use_streaming to: %d.", use_streaming_);
+  }
   if (get_param(p, "angle_range", angle_range_deg_)) {
     RCLCPP_DEBUG(
       get_logger(), " Setting new angle_range to: [%f , %f].", angle_range_deg_[0],
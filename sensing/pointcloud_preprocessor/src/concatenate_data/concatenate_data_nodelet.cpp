@@ -51,12 +51,20 @@
 
 #include "pointcloud_preprocessor/concatenate_data/concatenate_data_nodelet.hpp"
 
-#include <pcl_ros/transforms.hpp>
+#include "pointcloud_preprocessor/utility/utilities.hpp"
 
-#include <pcl_conversions/pcl_conversions.h>
+#ifdef ROS_DISTRO_GALACTIC
+#include <tf2_eigen/tf2_eigen.h>
+#else
+#include <tf2_eigen/tf2_eigen.hpp>
+#endif
 
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -106,6 +114,10 @@ PointCloudConcatenateDataSynchronizerComponent::PointCloudConcatenateDataSynchro
       RCLCPP_ERROR(get_logger(), "The number of topics does not match the number of offsets.");
       return;
     }
+
+    enable_deadline_publish_ = declare_parameter("enable_deadline_publish", false);
+    deadline_margin_sec_ = declare_parameter("deadline_margin_sec", 0.01);
+    arrival_models_.resize(input_topics_.size());
   }
 
   // Initialize not_subscribed_topic_names_
@@ -130,8 +142,10 @@ PointCloudConcatenateDataSynchronizerComponent::PointCloudConcatenateDataSynchro
 
   // Publishers
   {
+    rclcpp::PublisherOptionsWithAllocator<PointCloud2PoolAllocator<void>> pub_options;
+    pub_options.allocator = std::make_shared<PointCloud2PoolAllocator<void>>();
     pub_output_ = this->create_publisher<PointCloud2>(
-      "output", rclcpp::SensorDataQoS().keep_last(maximum_queue_size_));
+      "output", rclcpp::SensorDataQoS().keep_last(maximum_queue_size_), pub_options);
   }
 
   // Subscribers
@@ -144,11 +158,13 @@ PointCloudConcatenateDataSynchronizerComponent::PointCloudConcatenateDataSynchro
 
     // Subscribe to the filters
     filters_.resize(input_topics_.size());
+    slot_capacities_.assign(input_topics_.size(), 0U);
+    resetArena(arena_);
+    resetArena(next_arena_);
 
     // First input_topics_.size () filters are valid
     for (size_t d = 0; d < input_topics_.size(); ++d) {
-      cloud_stdmap_.insert(std::make_pair(input_topics_[d], nullptr));
-      cloud_stdmap_tmp_ = cloud_stdmap_;
+      topic_index_map_.insert(std::make_pair(input_topics_[d], d));
 
       // CAN'T use auto type here.
       std::function<void(const sensor_msgs::msg::PointCloud2::ConstSharedPtr msg)> cb = std::bind(
@@ -183,35 +199,149 @@ PointCloudConcatenateDataSynchronizerComponent::PointCloudConcatenateDataSynchro
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
-void PointCloudConcatenateDataSynchronizerComponent::transformPointCloud(
-  const PointCloud2::ConstSharedPtr & in, PointCloud2::SharedPtr & out)
+void PointCloudConcatenateDataSynchronizerComponent::resetArena(ConcatArena & arena)
+{
+  const auto num_topics = slot_capacities_.size();
+  arena.slot_sizes.assign(num_topics, 0U);
+  arena.slot_stamps.assign(num_topics, rclcpp::Time());
+  arena.arrival_times.assign(num_topics, rclcpp::Time());
+  arena.received.assign(num_topics, false);
+  if (arena.cloud && arena.slot_capacities == slot_capacities_) {
+    return;
+  }
+
+  // (re)allocate the output cloud with one slot per topic
+  arena.slot_capacities = slot_capacities_;
+  arena.slot_offsets.resize(num_topics);
+  std::size_t total_capacity = 0U;
+  for (std::size_t i = 0; i < num_topics; ++i) {
+    arena.slot_offsets[i] = total_capacity;
+    total_capacity += arena.slot_capacities[i];
+  }
+  arena.cloud = makePooledPointCloud2(total_capacity * sizeof(PointXYZI));
+  PointCloud2Modifier<PointXYZI> modifier{*arena.cloud, output_frame_};
+  modifier.resize(total_capacity);
+}
+
+void PointCloudConcatenateDataSynchronizerComponent::reserveSlot(
+  ConcatArena & arena, const std::size_t topic_index, const std::size_t num_points)
+{
+  if (arena.cloud && num_points <= arena.slot_capacities[topic_index]) {
+    return;
+  }
+  slot_capacities_[topic_index] = std::max(slot_capacities_[topic_index], num_points);
+
+  // relayout the arena, keeping the slots that have already been written in this cycle
+  ConcatArena new_arena;
+  resetArena(new_arena);
+  for (std::size_t i = 0; i < slot_capacities_.size(); ++i) {
+    if (arena.received[i]) {
+      copySlot(arena, new_arena, i);
+    }
+  }
+  arena = std::move(new_arena);
+}
+
+void PointCloudConcatenateDataSynchronizerComponent::writeToSlot(
+  ConcatArena & arena, const std::size_t topic_index, const PointCloud2 & input)
 {
+  arena.received[topic_index] = true;
+  arena.slot_stamps[topic_index] = rclcpp::Time(input.header.stamp);
+  arena.arrival_times[topic_index] = this->now();
+  arena.slot_sizes[topic_index] = 0U;
+
   // Transform the point clouds into the specified output frame
-  if (output_frame_ != in->header.frame_id) {
-    // TODO(YamatoAndo): use TF2
-    if (!pcl_ros::transformPointCloud(output_frame_, *in, *out, *tf2_buffer_)) {
+  Eigen::Affine3f transform = Eigen::Affine3f::Identity();
+  if (output_frame_ != input.header.frame_id) {
+    try {
+      const auto transform_stamped = tf2_buffer_->lookupTransform(
+        output_frame_, input.header.frame_id, input.header.stamp);
+      transform = tf2::transformToEigen(transform_stamped.transform).matrix().cast<float>();
+    } catch (tf2::TransformException & ex) {
       RCLCPP_ERROR(
-        this->get_logger(),
-        "[transformPointCloud] Error converting first input dataset from %s to %s.",
-        in->header.frame_id.c_str(), output_frame_.c_str());
+        this->get_logger(), "[writeToSlot] Error converting input dataset from %s to %s: %s",
+        input.header.frame_id.c_str(), output_frame_.c_str(), ex.what());
       return;
     }
-  } else {
-    out = std::make_shared<PointCloud2>(*in);
   }
+
+  const auto find_offset = [&input](const std::string & name) {
+    const auto it = std::find_if(
+      input.fields.begin(), input.fields.end(), [&name](auto & field) { return field.name == name; });
+    return it == input.fields.end() ? -1 : static_cast<int>(it->offset);
+  };
+  const int x_offset = find_offset("x");
+  const int y_offset = find_offset("y");
+  const int z_offset = find_offset("z");
+  const int intensity_offset = find_offset("intensity");
+  if (x_offset < 0 || y_offset < 0 || z_offset < 0) {
+    RCLCPP_ERROR(
+      this->get_logger(), "[writeToSlot] Input cloud in %s has no x/y/z fields.",
+      input.header.frame_id.c_str());
+    return;
+  }
+
+  const std::size_t num_points = input.width * input.height;
+  if (input.data.size() < num_points * input.point_step) {
+    RCLCPP_ERROR(
+      this->get_logger(), "[writeToSlot] Invalid input cloud in %s (data = %zu, points = %zu).",
+      input.header.frame_id.c_str(), input.data.size(), num_points);
+    return;
+  }
+  reserveSlot(arena, topic_index, num_points);
+
+  // convert to XYZI straight into the reserved slot, then transform it there
+  auto * slot_ptr =
+    reinterpret_cast<PointXYZI *>(arena.cloud->data.data()) + arena.slot_offsets[topic_index];
+  const auto read_float = [&input](const std::size_t point_offset, const int field_offset) {
+    float value;
+    std::memcpy(&value, &input.data[point_offset + field_offset], sizeof(float));
+    return value;
+  };
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const std::size_t point_offset = i * input.point_step;
+    slot_ptr[i].x = read_float(point_offset, x_offset);
+    slot_ptr[i].y = read_float(point_offset, y_offset);
+    slot_ptr[i].z = read_float(point_offset, z_offset);
+    slot_ptr[i].intensity =
+      intensity_offset < 0 ? 0.0f : read_float(point_offset, intensity_offset);
+  }
+  if (!transform.matrix().isIdentity()) {
+    transformSlotPoints(transform, slot_ptr, num_points);
+  }
+  arena.slot_sizes[topic_index] = num_points;
 }
 
-void PointCloudConcatenateDataSynchronizerComponent::combineClouds(
-  const PointCloud2::ConstSharedPtr & in1, const PointCloud2::ConstSharedPtr & in2,
-  PointCloud2::SharedPtr & out)
+void PointCloudConcatenateDataSynchronizerComponent::transformSlotPoints(
+  const Eigen::Affine3f & transform, PointXYZI * points, const std::size_t num_points)
+{
+  utils::transform_points_inplace(
+    transform, reinterpret_cast<uint8_t *>(points), num_points, sizeof(PointXYZI),
+    offsetof(PointXYZI, x), offsetof(PointXYZI, y), offsetof(PointXYZI, z));
+}
+
+void PointCloudConcatenateDataSynchronizerComponent::copySlot(
+  const ConcatArena & from, ConcatArena & to, const std::size_t topic_index)
+{
+  const auto num_points = from.slot_sizes[topic_index];
+  reserveSlot(to, topic_index, num_points);
+  std::memcpy(
+    reinterpret_cast<PointXYZI *>(to.cloud->data.data()) + to.slot_offsets[topic_index],
+    reinterpret_cast<const PointXYZI *>(from.cloud->data.data()) + from.slot_offsets[topic_index],
+    num_points * sizeof(PointXYZI));
+  to.slot_sizes[topic_index] = num_points;
+  to.slot_stamps[topic_index] = from.slot_stamps[topic_index];
+  to.arrival_times[topic_index] = from.arrival_times[topic_index];
+  to.received[topic_index] = true;
+}
+
+bool PointCloudConcatenateDataSynchronizerComponent::computeTwistCompensation(
+  const rclcpp::Time & old_stamp, const rclcpp::Time & new_stamp, Eigen::Affine3f & transform)
 {
   if (twist_ptr_queue_.empty()) {
-    pcl::concatenatePointCloud(*in1, *in2, *out);
-    out->header.stamp = std::min(rclcpp::Time(in1->header.stamp), rclcpp::Time(in2->header.stamp));
-    return;
+    return false;
   }
 
-  const auto old_stamp = std::min(rclcpp::Time(in1->header.stamp), rclcpp::Time(in2->header.stamp));
   auto old_twist_ptr_it = std::lower_bound(
     std::begin(twist_ptr_queue_), std::end(twist_ptr_queue_), old_stamp,
     [](const geometry_msgs::msg::TwistStamped::ConstSharedPtr & x_ptr, const rclcpp::Time & t) {
@@ -220,7 +350,6 @@ void PointCloudConcatenateDataSynchronizerComponent::combineClouds(
   old_twist_ptr_it =
     old_twist_ptr_it == twist_ptr_queue_.end() ? (twist_ptr_queue_.end() - 1) : old_twist_ptr_it;
 
-  const auto new_stamp = std::max(rclcpp::Time(in1->header.stamp), rclcpp::Time(in2->header.stamp));
   auto new_twist_ptr_it = std::lower_bound(
     std::begin(twist_ptr_queue_), std::end(twist_ptr_queue_), new_stamp,
     [](const geometry_msgs::msg::TwistStamped::ConstSharedPtr & x_ptr, const rclcpp::Time & t) {
@@ -257,59 +386,150 @@ void PointCloudConcatenateDataSynchronizerComponent::combineClouds(
   Eigen::AngleAxisf rotation_y(0, Eigen::Vector3f::UnitY());
   Eigen::AngleAxisf rotation_z(yaw, Eigen::Vector3f::UnitZ());
   Eigen::Translation3f translation(x, y, 0);
-  Eigen::Matrix4f rotation_matrix = (translation * rotation_z * rotation_y * rotation_x).matrix();
+  transform = translation * rotation_z * rotation_y * rotation_x;
+  return true;
+}
+
+void PointCloudConcatenateDataSynchronizerComponent::updateArrivalModels()
+{
+  // smoothing of the running mean and mean deviation, to follow a drift within a few seconds
+  constexpr double smoothing_ratio = 0.1;
+
+  const auto cycle_start_time =
+    *std::min_element(arena_.arrival_times.begin(), arena_.arrival_times.end());
+  for (std::size_t i = 0; i < arrival_models_.size(); ++i) {
+    auto & model = arrival_models_[i];
+    const double offset_sec = (arena_.arrival_times[i] - cycle_start_time).seconds();
+    if (!model.is_initialized) {
+      model.is_initialized = true;
+      model.mean_offset_sec = offset_sec;
+      continue;
+    }
+    model.mean_deviation_sec += smoothing_ratio * (std::abs(offset_sec - model.mean_offset_sec) -
+                                                   model.mean_deviation_sec);
+    model.mean_offset_sec += smoothing_ratio * (offset_sec - model.mean_offset_sec);
+  }
+}
+
+void PointCloudConcatenateDataSynchronizerComponent::setDeadlineTimer()
+{
+  // deviations from the mean arrival that are still waited for
+  constexpr double deviation_num = 3.0;
+
+  // the cycle times out after timeout_sec from its first arrival at the latest, and publishes
+  // earlier when all the missing topics are expected to have arrived by then
+  std::optional<rclcpp::Time> cycle_start_time;
+  for (std::size_t i = 0; i < input_topics_.size(); ++i) {
+    if (arena_.received[i] && (!cycle_start_time || arena_.arrival_times[i] < *cycle_start_time)) {
+      cycle_start_time = arena_.arrival_times[i];
+    }
+  }
+  if (!cycle_start_time) {
+    return;
+  }
 
-  // TODO(YamatoAndo): if output_frame_ is not base_link, we must transform
+  double deadline_offset_sec = timeout_sec_;
+  double expected_offset_sec = 0.0;
+  bool is_expected = true;
+  for (std::size_t i = 0; i < input_topics_.size(); ++i) {
+    if (arena_.received[i]) {
+      continue;
+    }
+    const auto & model = arrival_models_[i];
+    if (!model.is_initialized) {
+      is_expected = false;
+      break;
+    }
+    expected_offset_sec = std::max(
+      expected_offset_sec, model.mean_offset_sec + deviation_num * model.mean_deviation_sec);
+  }
+  if (is_expected) {
+    deadline_offset_sec = std::min(deadline_offset_sec, expected_offset_sec + deadline_margin_sec_);
+  }
 
-  if (rclcpp::Time(in1->header.stamp) > rclcpp::Time(in2->header.stamp)) {
-    sensor_msgs::msg::PointCloud2::SharedPtr in1_t(new sensor_msgs::msg::PointCloud2());
-    pcl_ros::transformPointCloud(rotation_matrix, *in1, *in1_t);
-    pcl::concatenatePointCloud(*in1_t, *in2, *out);
-    out->header.stamp = in2->header.stamp;
-  } else {
-    sensor_msgs::msg::PointCloud2::SharedPtr in2_t(new sensor_msgs::msg::PointCloud2());
-    pcl_ros::transformPointCloud(rotation_matrix, *in2, *in2_t);
-    pcl::concatenatePointCloud(*in1, *in2_t, *out);
-    out->header.stamp = in1->header.stamp;
+  constexpr double min_period_sec = 0.001;
+  const double period_sec = std::max(
+    deadline_offset_sec - (this->now() - *cycle_start_time).seconds(), min_period_sec);
+  timer_->cancel();
+  try {
+    setPeriod(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::duration<double>(period_sec))
+                .count());
+  } catch (rclcpp::exceptions::RCLError & ex) {
+    RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), 5000, "%s", ex.what());
   }
+  timer_->reset();
 }
 
 void PointCloudConcatenateDataSynchronizerComponent::publish()
 {
   stop_watch_ptr_->toc("processing_time", true);
-  sensor_msgs::msg::PointCloud2::SharedPtr concat_cloud_ptr_ = nullptr;
   not_subscribed_topic_names_.clear();
 
-  for (const auto & e : cloud_stdmap_) {
-    if (e.second != nullptr) {
-      sensor_msgs::msg::PointCloud2::SharedPtr transformed_cloud_ptr(
-        new sensor_msgs::msg::PointCloud2());
-      transformPointCloud(e.second, transformed_cloud_ptr);
-      if (concat_cloud_ptr_ == nullptr) {
-        concat_cloud_ptr_ = transformed_cloud_ptr;
-      } else {
-        PointCloudConcatenateDataSynchronizerComponent::combineClouds(
-          concat_cloud_ptr_, transformed_cloud_ptr, concat_cloud_ptr_);
-      }
-
-    } else {
-      not_subscribed_topic_names_.insert(e.first);
+  std::optional<rclcpp::Time> oldest_stamp;
+  std::string concatenated_topics;
+  for (std::size_t i = 0; i < input_topics_.size(); ++i) {
+    if (!arena_.received[i]) {
+      not_subscribed_topic_names_.insert(input_topics_[i]);
+      continue;
+    }
+    if (!oldest_stamp || arena_.slot_stamps[i] < *oldest_stamp) {
+      oldest_stamp = arena_.slot_stamps[i];
     }
+    concatenated_topics += (concatenated_topics.empty() ? "" : ",") + input_topics_[i];
+  }
+  if (not_subscribed_topic_names_.empty()) {
+    updateArrivalModels();
   }
 
-  if (concat_cloud_ptr_) {
-    auto output = std::make_unique<sensor_msgs::msg::PointCloud2>(*concat_cloud_ptr_);
-    pub_output_->publish(std::move(output));
+  if (oldest_stamp) {
+    // compensate the ego motion of newer clouds and pack the slots to the front of the arena
+    // TODO(YamatoAndo): if output_frame_ is not base_link, we must transform
+    auto * points = reinterpret_cast<PointXYZI *>(arena_.cloud->data.data());
+    std::size_t num_points = 0U;
+    for (std::size_t i = 0; i < input_topics_.size(); ++i) {
+      if (!arena_.received[i]) {
+        continue;
+      }
+      auto * slot_ptr = points + arena_.slot_offsets[i];
+      const auto slot_size = arena_.slot_sizes[i];
+      Eigen::Affine3f compensation;
+      if (
+        arena_.slot_stamps[i] > *oldest_stamp &&
+        computeTwistCompensation(*oldest_stamp, arena_.slot_stamps[i], compensation)) {
+        transformSlotPoints(compensation, slot_ptr, slot_size);
+      }
+      if (slot_ptr != points + num_points) {
+        std::memmove(points + num_points, slot_ptr, slot_size * sizeof(PointXYZI));
+      }
+      num_points += slot_size;
+    }
+
+    PointCloud2Modifier<PointXYZI> modifier{*arena_.cloud};
+    modifier.resize(num_points);
+    arena_.cloud->header.frame_id = output_frame_;
+    arena_.cloud->header.stamp = *oldest_stamp;
+    pub_output_->publish(std::move(arena_.cloud));
+
+    // which topics a possibly partial cloud consists of, with the stamp of the cloud
+    if (debug_publisher_) {
+      tier4_debug_msgs::msg::StringStamped concatenated_topics_msg;
+      concatenated_topics_msg.stamp = *oldest_stamp;
+      concatenated_topics_msg.data = concatenated_topics;
+      debug_publisher_->publish("debug/concatenated_topics", concatenated_topics_msg);
+    }
   } else {
     RCLCPP_WARN(this->get_logger(), "concat_cloud_ptr_ is nullptr, skipping pointcloud publish.");
   }
 
   updater_.force_update();
 
-  cloud_stdmap_ = cloud_stdmap_tmp_;
-  std::for_each(std::begin(cloud_stdmap_tmp_), std::end(cloud_stdmap_tmp_), [](auto & e) {
-    e.second = nullptr;
-  });
+  // the clouds received twice in this cycle start the next one
+  std::swap(arena_, next_arena_);
+  resetArena(next_arena_);
+  if (enable_deadline_publish_) {
+    setDeadlineTimer();
+  }
   // add processing time for debug
   if (debug_publisher_) {
     const double cyclic_time_ms = stop_watch_ptr_->toc("cyclic_time", true);
@@ -321,45 +541,6 @@ void PointCloudConcatenateDataSynchronizerComponent::publish()
   }
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void PointCloudConcatenateDataSynchronizerComponent::convertToXYZICloud(
-  const sensor_msgs::msg::PointCloud2::SharedPtr & input_ptr,
-  sensor_msgs::msg::PointCloud2::SharedPtr & output_ptr)
-{
-  output_ptr->header = input_ptr->header;
-  PointCloud2Modifier<PointXYZI> output_modifier{*output_ptr, input_ptr->header.frame_id};
-  output_modifier.reserve(input_ptr->width);
-
-  bool has_intensity = std::any_of(
-    input_ptr->fields.begin(), input_ptr->fields.end(),
-    [](auto & field) { return field.name == "intensity"; });
-
-  sensor_msgs::PointCloud2Iterator<float> it_x(*input_ptr, "x");
-  sensor_msgs::PointCloud2Iterator<float> it_y(*input_ptr, "y");
-  sensor_msgs::PointCloud2Iterator<float> it_z(*input_ptr, "z");
-
-  if (has_intensity) {
-    sensor_msgs::PointCloud2Iterator<float> it_i(*input_ptr, "intensity");
-    for (; it_x != it_x.end(); ++it_x, ++it_y, ++it_z, ++it_i) {
-      PointXYZI point;
-      point.x = *it_x;
-      point.y = *it_y;
-      point.z = *it_z;
-      point.intensity = *it_i;
-      output_modifier.push_back(std::move(point));
-    }
-  } else {
-    for (; it_x != it_x.end(); ++it_x, ++it_y, ++it_z) {
-      PointXYZI point;
-      point.x = *it_x;
-      point.y = *it_y;
-      point.z = *it_z;
-      point.intensity = 0.0f;
-      output_modifier.push_back(std::move(point));
-    }
-  }
-}
-
 void PointCloudConcatenateDataSynchronizerComponent::setPeriod(const int64_t new_period)
 {
   if (!timer_) {
@@ -380,19 +561,17 @@ void PointCloudConcatenateDataSynchronizerComponent::cloud_callback(
   const sensor_msgs::msg::PointCloud2::ConstSharedPtr & input_ptr, const std::string & topic_name)
 {
   std::lock_guard<std::mutex> lock(mutex_);
-  auto input = std::make_shared<sensor_msgs::msg::PointCloud2>(*input_ptr);
-  sensor_msgs::msg::PointCloud2::SharedPtr xyzi_input_ptr(new sensor_msgs::msg::PointCloud2());
-  convertToXYZICloud(input, xyzi_input_ptr);
+  const auto topic_index = topic_index_map_.at(topic_name);
 
-  const bool is_already_subscribed_this = (cloud_stdmap_[topic_name] != nullptr);
-  const bool is_already_subscribed_tmp = std::any_of(
-    std::begin(cloud_stdmap_tmp_), std::end(cloud_stdmap_tmp_),
-    [](const auto & e) { return e.second != nullptr; });
+  const bool is_already_subscribed_this = arena_.received[topic_index];
+  const bool is_already_subscribed_tmp =
+    std::any_of(next_arena_.received.begin(), next_arena_.received.end(), [](bool e) { return e; });
 
   if (is_already_subscribed_this) {
-    cloud_stdmap_tmp_[topic_name] = xyzi_input_ptr;
+    writeToSlot(next_arena_, topic_index, *input_ptr);
 
-    if (!is_already_subscribed_tmp) {
+    // the deadline of the current cycle is not extended
+    if (!is_already_subscribed_tmp && !enable_deadline_publish_) {
       auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
         std::chrono::duration<double>(timeout_sec_));
       try {
@@ -403,24 +582,23 @@ void PointCloudConcatenateDataSynchronizerComponent::cloud_callback(
       timer_->reset();
     }
   } else {
-    cloud_stdmap_[topic_name] = xyzi_input_ptr;
+    writeToSlot(arena_, topic_index, *input_ptr);
 
-    const bool is_subscribed_all = std::all_of(
-      std::begin(cloud_stdmap_), std::end(cloud_stdmap_),
-      [](const auto & e) { return e.second != nullptr; });
+    const bool is_subscribed_all =
+      std::all_of(arena_.received.begin(), arena_.received.end(), [](bool e) { return e; });
 
     if (is_subscribed_all) {
-      for (const auto & e : cloud_stdmap_tmp_) {
-        if (e.second != nullptr) {
-          cloud_stdmap_[e.first] = e.second;
+      for (std::size_t i = 0; i < next_arena_.received.size(); ++i) {
+        if (next_arena_.received[i]) {
+          copySlot(next_arena_, arena_, i);
         }
       }
-      std::for_each(std::begin(cloud_stdmap_tmp_), std::end(cloud_stdmap_tmp_), [](auto & e) {
-        e.second = nullptr;
-      });
+      resetArena(next_arena_);
 
       timer_->cancel();
       publish();
+    } else if (enable_deadline_publish_) {
+      setDeadlineTimer();
     } else if (offset_map_.size() > 0) {
       timer_->cancel();
       auto period = std::chrono::duration_cast<std::chrono::nanoseconds>(
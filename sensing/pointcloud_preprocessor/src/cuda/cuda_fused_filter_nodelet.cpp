@@ -0,0 +1,376 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/cuda/cuda_fused_filter_nodelet.hpp"
+
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+
+#include <tf2/LinearMath/Matrix3x3.h>
+#include <tf2/LinearMath/Quaternion.h>
+
+#ifdef ROS_DISTRO_GALACTIC
+#include <tf2_geometry_msgs/tf2_geometry_msgs.h>
+#else
+#include <tf2_geometry_msgs/tf2_geometry_msgs.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+CudaFusedFilterComponent::CudaFusedFilterComponent(const rclcpp::NodeOptions & options)
+: Filter("CudaFusedFilter", options)
+{
+  // initialize debug tool
+  {
+    using tier4_autoware_utils::DebugPublisher;
+    using tier4_autoware_utils::StopWatch;
+    stop_watch_ptr_ = std::make_unique<StopWatch<std::chrono::milliseconds>>();
+    debug_publisher_ = std::make_unique<DebugPublisher>(this, "cuda_fused_filter");
+    stop_watch_ptr_->tic("cyclic_time");
+    stop_watch_ptr_->tic("processing_time");
+  }
+
+  // set initial parameters
+  bool has_distortion_corrector = false;
+  {
+    const auto stage_names = declare_parameter(
+      "stages", std::vector<std::string>{"crop_box", "ring_outlier", "voxel_grid_downsample"});
+    for (const auto & name : stage_names) {
+      Stage stage;
+      stage.name = name;
+      const auto type = declare_parameter(name + ".type", name);
+      if (type == "distortion_corrector") {
+        // the pose table indexes the input points, so no stage may drop points before it
+        if (!stages_.empty()) {
+          throw std::invalid_argument(
+            "distortion_corrector must be the first stage of the cuda fused filter");
+        }
+        stage.type = StageType::DistortionCorrector;
+        has_distortion_corrector = true;
+      } else if (type == "crop_box") {
+        stage.type = StageType::CropBox;
+        auto & p = stage.crop_box;
+        p.min_x = static_cast<float>(declare_parameter(name + ".min_x", -1.0));
+        p.min_y = static_cast<float>(declare_parameter(name + ".min_y", -1.0));
+        p.min_z = static_cast<float>(declare_parameter(name + ".min_z", -1.0));
+        p.max_x = static_cast<float>(declare_parameter(name + ".max_x", 1.0));
+        p.max_y = static_cast<float>(declare_parameter(name + ".max_y", 1.0));
+        p.max_z = static_cast<float>(declare_parameter(name + ".max_z", 1.0));
+        p.negative = static_cast<bool>(declare_parameter(name + ".negative", false));
+      } else if (type == "ring_outlier") {
+        stage.type = StageType::RingOutlier;
+        auto & p = stage.ring_outlier;
+        p.distance_ratio = static_cast<double>(declare_parameter(name + ".distance_ratio", 1.03));
+        p.object_length_threshold =
+          static_cast<double>(declare_parameter(name + ".object_length_threshold", 0.1));
+        p.num_points_threshold =
+          static_cast<int>(declare_parameter(name + ".num_points_threshold", 4));
+      } else if (type == "voxel_grid_downsample") {
+        stage.type = StageType::VoxelGridDownsample;
+        stage.voxel_size_x = static_cast<float>(declare_parameter(name + ".voxel_size_x", 0.3));
+        stage.voxel_size_y = static_cast<float>(declare_parameter(name + ".voxel_size_y", 0.3));
+        stage.voxel_size_z = static_cast<float>(declare_parameter(name + ".voxel_size_z", 0.1));
+      } else {
+        throw std::invalid_argument("Unknown cuda fused filter stage type: " + type);
+      }
+      if (!stages_.empty() && stages_.back().type == StageType::VoxelGridDownsample) {
+        throw std::invalid_argument(
+          "voxel_grid_downsample must be the last stage of the cuda fused filter");
+      }
+      stages_.push_back(stage);
+    }
+    time_stamp_field_name_ = declare_parameter("time_stamp_field_name", "time_stamp");
+    use_imu_ = declare_parameter("use_imu", true);
+  }
+
+  if (has_distortion_corrector) {
+    twist_sub_ = this->create_subscription<geometry_msgs::msg::TwistWithCovarianceStamped>(
+      "~/input/twist", 10,
+      std::bind(
+        &CudaFusedFilterComponent::onTwistWithCovarianceStamped, this, std::placeholders::_1));
+    imu_sub_ = this->create_subscription<sensor_msgs::msg::Imu>(
+      "~/input/imu", 10,
+      std::bind(&CudaFusedFilterComponent::onImu, this, std::placeholders::_1));
+  }
+
+  using std::placeholders::_1;
+  set_param_res_ = this->add_on_set_parameters_callback(
+    std::bind(&CudaFusedFilterComponent::paramCallback, this, _1));
+}
+
+void CudaFusedFilterComponent::onTwistWithCovarianceStamped(
+  const geometry_msgs::msg::TwistWithCovarianceStamped::ConstSharedPtr twist_msg)
+{
+  std::scoped_lock lock(mutex_);
+
+  geometry_msgs::msg::TwistStamped msg;
+  msg.header = twist_msg->header;
+  msg.twist = twist_msg->twist.twist;
+  twist_queue_.push_back(msg);
+
+  while (!twist_queue_.empty()) {
+    // for replay rosbag
+    if (rclcpp::Time(twist_queue_.front().header.stamp) > rclcpp::Time(twist_msg->header.stamp)) {
+      twist_queue_.pop_front();
+    } else if (  // NOLINT
+      rclcpp::Time(twist_queue_.front().header.stamp) <
+      rclcpp::Time(twist_msg->header.stamp) - rclcpp::Duration::from_seconds(1.0)) {
+      twist_queue_.pop_front();
+    }
+    break;
+  }
+}
+
+void CudaFusedFilterComponent::onImu(const sensor_msgs::msg::Imu::ConstSharedPtr imu_msg)
+{
+  if (!use_imu_) {
+    return;
+  }
+
+  geometry_msgs::msg::TransformStamped transform;
+  if (const auto imu_transform =
+        static_tf_cache_->getTransform(base_link_frame_, imu_msg->header.frame_id)) {
+    transform = *imu_transform;
+  } else {
+    try {
+      transform = tf_buffer_->lookupTransform(
+        base_link_frame_, imu_msg->header.frame_id, tf2::TimePointZero);
+    } catch (tf2::TransformException & ex) {
+      RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), 5000, "%s", ex.what());
+      return;
+    }
+  }
+  // only the rotation of the imu mounting applies to the angular velocity
+  transform.transform.translation = geometry_msgs::msg::Vector3();
+
+  geometry_msgs::msg::Vector3Stamped angular_velocity;
+  angular_velocity.vector = imu_msg->angular_velocity;
+  geometry_msgs::msg::Vector3Stamped transformed_angular_velocity;
+  tf2::doTransform(angular_velocity, transformed_angular_velocity, transform);
+  transformed_angular_velocity.header = imu_msg->header;
+
+  std::scoped_lock lock(mutex_);
+  angular_velocity_queue_.push_back(transformed_angular_velocity);
+
+  while (!angular_velocity_queue_.empty()) {
+    // for replay rosbag
+    if (
+      rclcpp::Time(angular_velocity_queue_.front().header.stamp) >
+      rclcpp::Time(imu_msg->header.stamp)) {
+      angular_velocity_queue_.pop_front();
+    } else if (  // NOLINT
+      rclcpp::Time(angular_velocity_queue_.front().header.stamp) <
+      rclcpp::Time(imu_msg->header.stamp) - rclcpp::Duration::from_seconds(1.0)) {
+      angular_velocity_queue_.pop_front();
+    }
+    break;
+  }
+}
+
+bool CudaFusedFilterComponent::getPointLayout(
+  const PointCloud2 & input, cuda::PointLayout & layout)
+{
+  const auto find_offset = [&input](const std::string & name, uint32_t & offset) {
+    const auto field = std::find_if(
+      input.fields.cbegin(), input.fields.cend(),
+      [&name](const sensor_msgs::msg::PointField & f) { return f.name == name; });
+    if (field == input.fields.cend()) {
+      return false;
+    }
+    offset = field->offset;
+    return true;
+  };
+
+  layout.point_step = input.point_step;
+  if (
+    !find_offset("x", layout.x_offset) || !find_offset("y", layout.y_offset) ||
+    !find_offset("z", layout.z_offset)) {
+    RCLCPP_ERROR_THROTTLE(get_logger(), *get_clock(), 5000, "Input has no x, y or z field.");
+    return false;
+  }
+  for (const auto & stage : stages_) {
+    if (
+      stage.type == StageType::DistortionCorrector &&
+      !find_offset(time_stamp_field_name_, layout.time_stamp_offset)) {
+      RCLCPP_ERROR_THROTTLE(
+        get_logger(), *get_clock(), 5000, "Input has no %s field for stage %s.",
+        time_stamp_field_name_.c_str(), stage.name.c_str());
+      return false;
+    }
+    if (
+      stage.type == StageType::RingOutlier &&
+      (!find_offset("ring", layout.ring_offset) || !find_offset("azimuth", layout.azimuth_offset) ||
+       !find_offset("distance", layout.distance_offset))) {
+      RCLCPP_ERROR_THROTTLE(
+        get_logger(), *get_clock(), 5000, "Input has no ring, azimuth or distance field for %s.",
+        stage.name.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CudaFusedFilterComponent::undistort(
+  const PointCloud2 & input, const cuda::PointLayout & layout)
+{
+  if (twist_queue_.empty()) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */, "twist_queue_ is empty.");
+    return false;
+  }
+
+  geometry_msgs::msg::TransformStamped transform;
+  if (const auto sensor_transform =
+        static_tf_cache_->getTransform(input.header.frame_id, base_link_frame_)) {
+    transform = *sensor_transform;
+  } else {
+    try {
+      transform =
+        tf_buffer_->lookupTransform(input.header.frame_id, base_link_frame_, tf2::TimePointZero);
+    } catch (tf2::TransformException & ex) {
+      RCLCPP_WARN_THROTTLE(get_logger(), *get_clock(), 5000, "%s", ex.what());
+      return false;
+    }
+  }
+  const auto & t = transform.transform.translation;
+  const auto & q = transform.transform.rotation;
+  const tf2::Matrix3x3 rotation(tf2::Quaternion(q.x, q.y, q.z, q.w));
+  std::array<float, 12> base_link_to_sensor;
+  for (int r = 0; r < 3; ++r) {
+    for (int c = 0; c < 3; ++c) {
+      base_link_to_sensor[r * 4 + c] = static_cast<float>(rotation[r][c]);
+    }
+  }
+  base_link_to_sensor[3] = static_cast<float>(t.x);
+  base_link_to_sensor[7] = static_cast<float>(t.y);
+  base_link_to_sensor[11] = static_cast<float>(t.z);
+
+  // the table is built from the host copy of the time stamps, only the segments are uploaded
+  twist_segment_table_.build(
+    input, layout.time_stamp_offset, twist_queue_, angular_velocity_queue_, use_imu_);
+  if (twist_segment_table_.isTwistOutOfRange()) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "twist time_stamp is too late. Could not interpolate.");
+  }
+  if (twist_segment_table_.isImuOutOfRange()) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "imu time_stamp is too late. Could not interpolate.");
+  }
+  pipeline_.undistort(twist_segment_table_.segments(), base_link_to_sensor);
+  return true;
+}
+
+void CudaFusedFilterComponent::filter(
+  const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
+  PointCloud2 & output)
+{
+  std::scoped_lock lock(mutex_);
+  stop_watch_ptr_->toc("processing_time", true);
+
+  cuda::PointLayout layout;
+  if (!getPointLayout(*input, layout)) {
+    return;
+  }
+
+  pipeline_.upload(input->data.data(), input->width * input->height, layout);
+  for (const auto & stage : stages_) {
+    switch (stage.type) {
+      case StageType::DistortionCorrector:
+        undistort(*input, layout);
+        break;
+      case StageType::CropBox:
+        pipeline_.cropBox(stage.crop_box);
+        break;
+      case StageType::RingOutlier:
+        pipeline_.ringOutlier(stage.ring_outlier);
+        break;
+      case StageType::VoxelGridDownsample:
+        pipeline_.voxelGridDownsample(stage.voxel_size_x, stage.voxel_size_y, stage.voxel_size_z);
+        break;
+    }
+  }
+
+  const auto num_points = pipeline_.numPoints();
+  if (!stages_.empty() && stages_.back().type == StageType::VoxelGridDownsample) {
+    sensor_msgs::PointCloud2Modifier modifier(output);
+    modifier.setPointCloud2FieldsByString(1, "xyz");
+    modifier.resize(num_points);
+    output.is_dense = true;
+  } else {
+    output.fields = input->fields;
+    output.is_bigendian = input->is_bigendian;
+    output.point_step = input->point_step;
+    output.is_dense = input->is_dense;
+    output.height = 1;
+    output.width = static_cast<uint32_t>(num_points);
+    output.row_step = static_cast<uint32_t>(num_points * output.point_step);
+    output.data.resize(output.row_step);
+  }
+  pipeline_.download(output.data.data());
+  output.header = input->header;
+
+  // add processing time for debug
+  if (debug_publisher_) {
+    const double cyclic_time_ms = stop_watch_ptr_->toc("cyclic_time", true);
+    const double processing_time_ms = stop_watch_ptr_->toc("processing_time", true);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/cyclic_time_ms", cyclic_time_ms);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/processing_time_ms", processing_time_ms);
+  }
+}
+
+rcl_interfaces::msg::SetParametersResult CudaFusedFilterComponent::paramCallback(
+  const std::vector<rclcpp::Parameter> & p)
+{
+  std::scoped_lock lock(mutex_);
+
+  for (auto & stage : stages_) {
+    const auto & name = stage.name;
+    if (stage.type == StageType::CropBox) {
+      get_param(p, name + ".min_x", stage.crop_box.min_x);
+      get_param(p, name + ".min_y", stage.crop_box.min_y);
+      get_param(p, name + ".min_z", stage.crop_box.min_z);
+      get_param(p, name + ".max_x", stage.crop_box.max_x);
+      get_param(p, name + ".max_y", stage.crop_box.max_y);
+      get_param(p, name + ".max_z", stage.crop_box.max_z);
+      get_param(p, name + ".negative", stage.crop_box.negative);
+    } else if (stage.type == StageType::RingOutlier) {
+      get_param(p, name + ".distance_ratio", stage.ring_outlier.distance_ratio);
+      get_param(p, name + ".object_length_threshold", stage.ring_outlier.object_length_threshold);
+      get_param(p, name + ".num_points_threshold", stage.ring_outlier.num_points_threshold);
+    } else if (stage.type == StageType::VoxelGridDownsample) {
+      get_param(p, name + ".voxel_size_x", stage.voxel_size_x);
+      get_param(p, name + ".voxel_size_y", stage.voxel_size_y);
+      get_param(p, name + ".voxel_size_z", stage.voxel_size_z);
+    }
+  }
+
+  rcl_interfaces::msg::SetParametersResult result;
+  result.successful = true;
+  result.reason = "success";
+
+  return result;
+}
+}  // namespace pointcloud_preprocessor
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(pointcloud_preprocessor::CudaFusedFilterComponent)
@@ -0,0 +1,499 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/cuda/cuda_pointcloud_pipeline.hpp"
+
+#include <cuda_runtime_api.h>
+#include <thrust/device_vector.h>
+#include <thrust/execution_policy.h>
+#include <thrust/fill.h>
+#include <thrust/functional.h>
+#include <thrust/reduce.h>
+#include <thrust/scan.h>
+#include <thrust/sort.h>
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#define CHECK_CUDA_ERROR(e) (pointcloud_preprocessor::cuda::checkError(e, __FILE__, __LINE__))
+
+namespace pointcloud_preprocessor
+{
+namespace cuda
+{
+namespace
+{
+inline void checkError(const ::cudaError_t e, const char * f, int n)
+{
+  if (e != ::cudaSuccess) {
+    std::stringstream s;
+    s << ::cudaGetErrorName(e) << " (" << e << ")@" << f << "#L" << n << ": "
+      << ::cudaGetErrorString(e);
+    throw std::runtime_error{s.str()};
+  }
+}
+
+constexpr unsigned int threads_per_block = 256U;
+
+inline unsigned int numBlocks(const std::size_t n)
+{
+  return static_cast<unsigned int>((n + threads_per_block - 1U) / threads_per_block);
+}
+
+// grow-only device buffer, contents are not preserved
+template <typename T>
+T * reserve(thrust::device_vector<T> & buffer, const std::size_t size)
+{
+  if (buffer.size() < size) {
+    buffer.clear();
+    buffer.resize(size);
+  }
+  return thrust::raw_pointer_cast(buffer.data());
+}
+
+// same packing as VoxelCentroidTable
+constexpr int64_t key_axis_bits = 21;
+constexpr int64_t key_axis_offset = int64_t{1} << (key_axis_bits - 1);
+constexpr uint64_t key_axis_mask = (uint64_t{1} << key_axis_bits) - 1U;
+constexpr uint64_t invalid_voxel_key = ~uint64_t{0};
+
+struct Affine
+{
+  float m[12];
+};
+
+Affine inverse(const Affine & t)
+{
+  Affine inv;
+  for (int r = 0; r < 3; ++r) {
+    for (int c = 0; c < 3; ++c) {
+      inv.m[r * 4 + c] = t.m[c * 4 + r];
+    }
+  }
+  for (int r = 0; r < 3; ++r) {
+    inv.m[r * 4 + 3] =
+      -(inv.m[r * 4 + 0] * t.m[3] + inv.m[r * 4 + 1] * t.m[7] + inv.m[r * 4 + 2] * t.m[11]);
+  }
+  return inv;
+}
+
+__device__ inline float3 apply(const Affine & t, const float3 & p)
+{
+  return make_float3(
+    t.m[0] * p.x + t.m[1] * p.y + t.m[2] * p.z + t.m[3],
+    t.m[4] * p.x + t.m[5] * p.y + t.m[6] * p.z + t.m[7],
+    t.m[8] * p.x + t.m[9] * p.y + t.m[10] * p.z + t.m[11]);
+}
+
+template <typename T>
+__device__ inline T load(const uint8_t * data)
+{
+  T value;
+  memcpy(&value, data, sizeof(T));
+  return value;
+}
+
+__device__ inline float3 loadXYZ(const uint8_t * point, const PointLayout & layout)
+{
+  return make_float3(
+    load<float>(point + layout.x_offset), load<float>(point + layout.y_offset),
+    load<float>(point + layout.z_offset));
+}
+
+__device__ inline bool toAxisIndex(
+  const float value, const float inverse_voxel_size, uint64_t & index)
+{
+  const float scaled = floorf(value * inverse_voxel_size);
+  if (!(fabsf(scaled) < static_cast<float>(key_axis_offset))) {
+    return false;
+  }
+  index = static_cast<uint64_t>(static_cast<int64_t>(scaled) + key_axis_offset) & key_axis_mask;
+  return true;
+}
+
+struct Float4Plus
+{
+  __host__ __device__ float4 operator()(const float4 & a, const float4 & b) const
+  {
+    return make_float4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+  }
+};
+
+__global__ void undistortKernel(
+  uint8_t * data, const std::size_t num_points, const PointLayout layout,
+  const TwistSegment * segments, const std::size_t num_segments, const Affine base_link_to_sensor,
+  const Affine base_link_to_sensor_inv)
+{
+  const std::size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= num_points) {
+    return;
+  }
+
+  // the segment is the last one starting at or before the point
+  std::size_t low = 0U;
+  std::size_t high = num_segments;
+  while (low < high) {
+    const std::size_t mid = low + (high - low) / 2;
+    if (segments[mid].begin <= i) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  const TwistSegment & segment = segments[low - 1];
+
+  uint8_t * point = data + i * layout.point_step;
+  const double time_stamp = load<double>(point + layout.time_stamp_offset);
+  float x;
+  float y;
+  float theta;
+  poseAt(segment, static_cast<float>(time_stamp - segment.start_time_stamp), x, y, theta);
+
+  const float3 q = apply(base_link_to_sensor_inv, loadXYZ(point, layout));
+  const float c = cosf(theta);
+  const float s = sinf(theta);
+  const float3 p =
+    apply(base_link_to_sensor, make_float3(c * q.x - s * q.y + x, s * q.x + c * q.y + y, q.z));
+  memcpy(point + layout.x_offset, &p.x, sizeof(float));
+  memcpy(point + layout.y_offset, &p.y, sizeof(float));
+  memcpy(point + layout.z_offset, &p.z, sizeof(float));
+}
+
+__global__ void cropBoxKernel(
+  const uint8_t * data, const std::size_t num_points, const PointLayout layout,
+  const CropBoxParams params, uint32_t * keep)
+{
+  const std::size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= num_points) {
+    return;
+  }
+  const float3 p = loadXYZ(data + i * layout.point_step, layout);
+  if (!params.negative) {
+    keep[i] = params.min_z < p.z && p.z < params.max_z && params.min_y < p.y &&
+              p.y < params.max_y && params.min_x < p.x && p.x < params.max_x;
+  } else {
+    keep[i] = params.min_z > p.z || p.z > params.max_z || params.min_y > p.y ||
+              p.y > params.max_y || params.min_x > p.x || p.x > params.max_x;
+  }
+}
+
+__global__ void ringKeyKernel(
+  const uint8_t * data, const std::size_t num_points, const PointLayout layout,
+  uint32_t * ring_keys, uint32_t * order)
+{
+  const std::size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= num_points) {
+    return;
+  }
+  ring_keys[i] = load<uint16_t>(data + i * layout.point_step + layout.ring_offset);
+  order[i] = static_cast<uint32_t>(i);
+}
+
+__global__ void ringRangeKernel(
+  const uint32_t * sorted_ring_keys, const std::size_t num_points, uint32_t * ring_begins,
+  uint32_t * ring_ends)
+{
+  const std::size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= num_points) {
+    return;
+  }
+  const uint32_t ring = sorted_ring_keys[i];
+  if (i == 0U || sorted_ring_keys[i - 1] != ring) {
+    ring_begins[ring] = static_cast<uint32_t>(i);
+  }
+  if (i == num_points - 1U || sorted_ring_keys[i + 1] != ring) {
+    ring_ends[ring] = static_cast<uint32_t>(i + 1U);
+  }
+}
+
+// one thread per ring, the walk itself is sequential as in RingOutlierFilterComponent::filterRing
+__global__ void ringWalkKernel(
+  const uint8_t * data, const PointLayout layout, const uint32_t * order,
+  const uint32_t * ring_begins, const uint32_t * ring_ends, const std::size_t num_rings,
+  const RingOutlierParams params, uint32_t * keep)
+{
+  const std::size_t ring = blockIdx.x * blockDim.x + threadIdx.x;
+  if (ring >= num_rings) {
+    return;
+  }
+  const uint32_t begin = ring_begins[ring];
+  const uint32_t end = ring_ends[ring];
+  if (end - begin < 2U) {
+    return;
+  }
+
+  const auto point_at = [&](const uint32_t idx) { return data + order[idx] * layout.point_step; };
+  const auto push_walk = [&](const uint32_t walk_begin, const uint32_t walk_end) {
+    const float3 front = loadXYZ(point_at(walk_begin), layout);
+    const float3 back = loadXYZ(point_at(walk_end), layout);
+    const float x_diff = front.x - back.x;
+    const float y_diff = front.y - back.y;
+    const float z_diff = front.z - back.z;
+    if (
+      static_cast<int>(walk_end - walk_begin + 1U) > params.num_points_threshold ||
+      (x_diff * x_diff) + (y_diff * y_diff) + (z_diff * z_diff) >=
+        params.object_length_threshold * params.object_length_threshold) {
+      for (uint32_t idx = walk_begin; idx <= walk_end; ++idx) {
+        keep[idx] = 1U;
+      }
+    }
+  };
+
+  uint32_t walk_begin = begin;
+  for (uint32_t idx = begin; idx < end - 1U; ++idx) {
+    const uint8_t * current_pt = point_at(idx);
+    const uint8_t * next_pt = point_at(idx + 1U);
+    float azimuth_diff = load<float>(next_pt + layout.azimuth_offset) -
+                         load<float>(current_pt + layout.azimuth_offset);
+    azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
+    const float current_pt_distance = load<float>(current_pt + layout.distance_offset);
+    const float next_pt_distance = load<float>(next_pt + layout.distance_offset);
+    if (
+      fmaxf(current_pt_distance, next_pt_distance) <
+        fminf(current_pt_distance, next_pt_distance) * params.distance_ratio &&
+      azimuth_diff < 100.f) {
+      continue;
+    }
+    push_walk(walk_begin, idx);
+    walk_begin = idx + 1U;
+  }
+  if (walk_begin < end - 1U) {
+    push_walk(walk_begin, end - 2U);
+  }
+}
+
+__global__ void voxelKeyKernel(
+  const uint8_t * data, const std::size_t num_points, const PointLayout layout,
+  const float3 inverse_voxel_size, uint64_t * voxel_keys, float4 * voxel_values)
+{
+  const std::size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= num_points) {
+    return;
+  }
+  const float3 p = loadXYZ(data + i * layout.point_step, layout);
+  uint64_t ix;
+  uint64_t iy;
+  uint64_t iz;
+  if (
+    toAxisIndex(p.x, inverse_voxel_size.x, ix) && toAxisIndex(p.y, inverse_voxel_size.y, iy) &&
+    toAxisIndex(p.z, inverse_voxel_size.z, iz)) {
+    voxel_keys[i] = (ix << (2 * key_axis_bits)) | (iy << key_axis_bits) | iz;
+  } else {
+    voxel_keys[i] = invalid_voxel_key;
+  }
+  voxel_values[i] = make_float4(p.x, p.y, p.z, 1.0f);
+}
+
+__global__ void voxelCentroidKernel(
+  const float4 * voxel_sums, const std::size_t num_voxels, uint8_t * data)
+{
+  const std::size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= num_voxels) {
+    return;
+  }
+  const float4 sum = voxel_sums[i];
+  const float centroid[3] = {sum.x / sum.w, sum.y / sum.w, sum.z / sum.w};
+  memcpy(data + i * 3 * sizeof(float), centroid, sizeof(centroid));
+}
+
+__global__ void compactKernel(
+  const uint8_t * src, const std::size_t num_points, const uint32_t point_step,
+  const uint32_t * keep, const uint32_t * positions, const uint32_t * gather, uint8_t * dst)
+{
+  const std::size_t i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= num_points || !keep[i]) {
+    return;
+  }
+  const std::size_t src_idx = gather ? gather[i] : i;
+  memcpy(dst + positions[i] * point_step, src + src_idx * point_step, point_step);
+}
+}  // namespace
+
+struct CudaPointCloudPipeline::Impl
+{
+  PointLayout layout;
+  std::size_t num_points{0U};
+  thrust::device_vector<uint8_t> points;
+  thrust::device_vector<uint8_t> points_tmp;
+  thrust::device_vector<TwistSegment> segments;
+  thrust::device_vector<uint32_t> keep;
+  thrust::device_vector<uint32_t> positions;
+  thrust::device_vector<uint32_t> ring_keys;
+  thrust::device_vector<uint32_t> order;
+  thrust::device_vector<uint32_t> ring_begins;
+  thrust::device_vector<uint32_t> ring_ends;
+  thrust::device_vector<uint64_t> voxel_keys;
+  thrust::device_vector<uint64_t> unique_voxel_keys;
+  thrust::device_vector<float4> voxel_values;
+  thrust::device_vector<float4> voxel_sums;
+
+  uint8_t * pointsPtr() { return thrust::raw_pointer_cast(points.data()); }
+
+  // keep the points flagged in keep[0, num_points), optionally reading point gather[i] for slot i
+  void compact(const uint32_t * gather)
+  {
+    const uint32_t * keep_ptr = thrust::raw_pointer_cast(keep.data());
+    uint32_t * positions_ptr = reserve(positions, num_points);
+    thrust::exclusive_scan(thrust::device, keep_ptr, keep_ptr + num_points, positions_ptr);
+    const std::size_t num_kept = static_cast<uint32_t>(positions[num_points - 1]) +
+                                 static_cast<uint32_t>(keep[num_points - 1]);
+
+    uint8_t * dst = reserve(points_tmp, num_kept * layout.point_step);
+    compactKernel<<<numBlocks(num_points), threads_per_block>>>(
+      pointsPtr(), num_points, layout.point_step, keep_ptr, positions_ptr, gather, dst);
+    CHECK_CUDA_ERROR(::cudaGetLastError());
+    points.swap(points_tmp);
+    num_points = num_kept;
+  }
+};
+
+CudaPointCloudPipeline::CudaPointCloudPipeline() : impl_(std::make_unique<Impl>()) {}
+
+CudaPointCloudPipeline::~CudaPointCloudPipeline() = default;
+
+void CudaPointCloudPipeline::upload(
+  const uint8_t * data, const std::size_t num_points, const PointLayout & layout)
+{
+  impl_->layout = layout;
+  impl_->num_points = num_points;
+  const std::size_t size = num_points * layout.point_step;
+  CHECK_CUDA_ERROR(
+    ::cudaMemcpy(reserve(impl_->points, size), data, size, ::cudaMemcpyHostToDevice));
+}
+
+void CudaPointCloudPipeline::undistort(
+  const std::vector<TwistSegment> & segments, const std::array<float, 12> & base_link_to_sensor)
+{
+  if (impl_->num_points == 0U || segments.empty()) {
+    return;
+  }
+  TwistSegment * segments_ptr = reserve(impl_->segments, segments.size());
+  CHECK_CUDA_ERROR(::cudaMemcpy(
+    segments_ptr, segments.data(), segments.size() * sizeof(TwistSegment),
+    ::cudaMemcpyHostToDevice));
+
+  Affine transform;
+  std::copy(base_link_to_sensor.begin(), base_link_to_sensor.end(), transform.m);
+  undistortKernel<<<numBlocks(impl_->num_points), threads_per_block>>>(
+    impl_->pointsPtr(), impl_->num_points, impl_->layout, segments_ptr, segments.size(), transform,
+    inverse(transform));
+  CHECK_CUDA_ERROR(::cudaGetLastError());
+}
+
+void CudaPointCloudPipeline::cropBox(const CropBoxParams & params)
+{
+  if (impl_->num_points == 0U) {
+    return;
+  }
+  cropBoxKernel<<<numBlocks(impl_->num_points), threads_per_block>>>(
+    impl_->pointsPtr(), impl_->num_points, impl_->layout, params,
+    reserve(impl_->keep, impl_->num_points));
+  CHECK_CUDA_ERROR(::cudaGetLastError());
+  impl_->compact(nullptr);
+}
+
+void CudaPointCloudPipeline::ringOutlier(const RingOutlierParams & params)
+{
+  const std::size_t num_points = impl_->num_points;
+  if (num_points == 0U) {
+    return;
+  }
+
+  // stable sort keeps the scan order inside each ring
+  uint32_t * ring_keys = reserve(impl_->ring_keys, num_points);
+  uint32_t * order = reserve(impl_->order, num_points);
+  ringKeyKernel<<<numBlocks(num_points), threads_per_block>>>(
+    impl_->pointsPtr(), num_points, impl_->layout, ring_keys, order);
+  CHECK_CUDA_ERROR(::cudaGetLastError());
+  thrust::stable_sort_by_key(thrust::device, ring_keys, ring_keys + num_points, order);
+
+  const std::size_t num_rings = static_cast<uint32_t>(impl_->ring_keys[num_points - 1]) + 1U;
+  uint32_t * ring_begins = reserve(impl_->ring_begins, num_rings);
+  uint32_t * ring_ends = reserve(impl_->ring_ends, num_rings);
+  thrust::fill_n(thrust::device, ring_begins, num_rings, 0U);
+  thrust::fill_n(thrust::device, ring_ends, num_rings, 0U);
+  ringRangeKernel<<<numBlocks(num_points), threads_per_block>>>(
+    ring_keys, num_points, ring_begins, ring_ends);
+  CHECK_CUDA_ERROR(::cudaGetLastError());
+
+  uint32_t * keep = reserve(impl_->keep, num_points);
+  thrust::fill_n(thrust::device, keep, num_points, 0U);
+  ringWalkKernel<<<numBlocks(num_rings), threads_per_block>>>(
+    impl_->pointsPtr(), impl_->layout, order, ring_begins, ring_ends, num_rings, params, keep);
+  CHECK_CUDA_ERROR(::cudaGetLastError());
+
+  // keep flags are in ring order, so the survivors are gathered in ring order too
+  impl_->compact(order);
+}
+
+void CudaPointCloudPipeline::voxelGridDownsample(
+  const float voxel_size_x, const float voxel_size_y, const float voxel_size_z)
+{
+  const std::size_t num_points = impl_->num_points;
+  PointLayout layout;
+  layout.point_step = 3 * sizeof(float);
+  if (num_points == 0U) {
+    impl_->layout = layout;
+    return;
+  }
+
+  uint64_t * voxel_keys = reserve(impl_->voxel_keys, num_points);
+  float4 * voxel_values = reserve(impl_->voxel_values, num_points);
+  voxelKeyKernel<<<numBlocks(num_points), threads_per_block>>>(
+    impl_->pointsPtr(), num_points, impl_->layout,
+    make_float3(1.0f / voxel_size_x, 1.0f / voxel_size_y, 1.0f / voxel_size_z), voxel_keys,
+    voxel_values);
+  CHECK_CUDA_ERROR(::cudaGetLastError());
+
+  thrust::sort_by_key(thrust::device, voxel_keys, voxel_keys + num_points, voxel_values);
+  uint64_t * unique_voxel_keys = reserve(impl_->unique_voxel_keys, num_points);
+  float4 * voxel_sums = reserve(impl_->voxel_sums, num_points);
+  const auto ends = thrust::reduce_by_key(
+    thrust::device, voxel_keys, voxel_keys + num_points, voxel_values, unique_voxel_keys,
+    voxel_sums, thrust::equal_to<uint64_t>(), Float4Plus());
+  std::size_t num_voxels = static_cast<std::size_t>(ends.first - unique_voxel_keys);
+  // out of range points are all sorted into the last key
+  if (
+    num_voxels > 0U &&
+    static_cast<uint64_t>(impl_->unique_voxel_keys[num_voxels - 1]) == invalid_voxel_key) {
+    --num_voxels;
+  }
+
+  uint8_t * dst = reserve(impl_->points_tmp, num_voxels * layout.point_step);
+  if (num_voxels > 0U) {
+    voxelCentroidKernel<<<numBlocks(num_voxels), threads_per_block>>>(
+      voxel_sums, num_voxels, dst);
+    CHECK_CUDA_ERROR(::cudaGetLastError());
+  }
+  impl_->points.swap(impl_->points_tmp);
+  impl_->num_points = num_voxels;
+  impl_->layout = layout;
+}
+
+std::size_t CudaPointCloudPipeline::numPoints() const { return impl_->num_points; }
+
+const PointLayout & CudaPointCloudPipeline::layout() const { return impl_->layout; }
+
+void CudaPointCloudPipeline::download(uint8_t * data) const
+{
+  const std::size_t size = impl_->num_points * impl_->layout.point_step;
+  if (size == 0U) {
+    return;
+  }
+  CHECK_CUDA_ERROR(::cudaMemcpy(
+    data, thrust::raw_pointer_cast(impl_->points.data()), size, ::cudaMemcpyDeviceToHost));
+}
+}  // namespace cuda
+}  // namespace pointcloud_preprocessor
@@ -14,9 +14,15 @@
 
 #include "pointcloud_preprocessor/distortion_corrector/distortion_corrector.hpp"
 
+#include <Eigen/Geometry>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <deque>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace pointcloud_preprocessor
 {
@@ -37,6 +43,8 @@ DistortionCorrectorComponent::DistortionCorrectorComponent(const rclcpp::NodeOpt
   // Parameter
   time_stamp_field_name_ = declare_parameter("time_stamp_field_name", "time_stamp");
   use_imu_ = declare_parameter("use_imu", true);
+  use_pose_table_ = declare_parameter("use_pose_table", false);
+  num_threads_ = std::max(static_cast<int>(declare_parameter("num_threads", 1)), 1);
 
   // Publisher
   undistorted_points_pub_ =
@@ -124,7 +132,11 @@ void DistortionCorrectorComponent::onPointCloud(PointCloud2::UniquePtr points_ms
   tf2::Transform tf2_base_link_to_sensor{};
   getTransform(points_msg->header.frame_id, base_link_frame_, &tf2_base_link_to_sensor);
 
-  undistortPointCloud(tf2_base_link_to_sensor, *points_msg);
+  if (use_pose_table_) {
+    undistortPointCloudWithPoseTable(tf2_base_link_to_sensor, *points_msg);
+  } else {
+    undistortPointCloud(tf2_base_link_to_sensor, *points_msg);
+  }
 
   undistorted_points_pub_->publish(std::move(points_msg));
 
@@ -280,6 +292,117 @@ bool DistortionCorrectorComponent::undistortPointCloud(
   return true;
 }
 
+bool DistortionCorrectorComponent::undistortPointCloudWithPoseTable(
+  const tf2::Transform & tf2_base_link_to_sensor, PointCloud2 & points)
+{
+  if (points.data.empty() || twist_queue_.empty()) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "input_pointcloud->points or twist_queue_ is empty.");
+    return false;
+  }
+
+  const auto find_field = [&points](const std::string & name) {
+    return std::find_if(
+      std::cbegin(points.fields), std::cend(points.fields),
+      [&name](const sensor_msgs::msg::PointField & field) { return field.name == name; });
+  };
+  const auto time_stamp_field_it = find_field(time_stamp_field_name_);
+  if (time_stamp_field_it == points.fields.cend()) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "Required field time stamp doesn't exist in the point cloud.");
+    return false;
+  }
+  const auto x_field_it = find_field("x");
+  const auto y_field_it = find_field("y");
+  const auto z_field_it = find_field("z");
+  if (
+    x_field_it == points.fields.cend() || y_field_it == points.fields.cend() ||
+    z_field_it == points.fields.cend()) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */, "Required field x, y or z doesn't exist.");
+    return false;
+  }
+
+  const std::size_t point_step = points.point_step;
+  const std::size_t time_stamp_offset = time_stamp_field_it->offset;
+  const auto time_stamp_at = [&](const std::size_t i) {
+    double time_stamp;
+    std::memcpy(&time_stamp, &points.data[i * point_step + time_stamp_offset], sizeof(double));
+    return time_stamp;
+  };
+  twist_segment_table_.build(
+    points, time_stamp_offset, twist_queue_, angular_velocity_queue_, use_imu_);
+  if (twist_segment_table_.isTwistOutOfRange()) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "twist time_stamp is too late. Could not interpolate.");
+  }
+  if (twist_segment_table_.isImuOutOfRange()) {
+    RCLCPP_WARN_STREAM_THROTTLE(
+      get_logger(), *get_clock(), 10000 /* ms */,
+      "imu time_stamp is too late. Could not interpolate.");
+  }
+  const auto & twist_segments = twist_segment_table_.segments();
+
+  // split the segments into blocks so that a single long segment is also processed in parallel
+  constexpr std::size_t block_size = 4096;
+  point_blocks_.clear();
+  for (std::size_t s = 0; s < twist_segments.size(); ++s) {
+    for (std::size_t begin = twist_segments[s].begin; begin < twist_segments[s].end;
+         begin += block_size) {
+      point_blocks_.emplace_back(s, begin);
+    }
+  }
+
+  const auto & origin = tf2_base_link_to_sensor.getOrigin();
+  const auto & basis = tf2_base_link_to_sensor.getBasis();
+  Eigen::Affine3f base_link_to_sensor = Eigen::Affine3f::Identity();
+  for (int r = 0; r < 3; ++r) {
+    for (int c = 0; c < 3; ++c) {
+      base_link_to_sensor.linear()(r, c) = static_cast<float>(basis[r][c]);
+    }
+  }
+  base_link_to_sensor.translation() = Eigen::Vector3f(
+    static_cast<float>(origin.x()), static_cast<float>(origin.y()),
+    static_cast<float>(origin.z()));
+  const Eigen::Affine3f base_link_to_sensor_inv = base_link_to_sensor.inverse();
+
+  const std::size_t x_offset = x_field_it->offset;
+  const std::size_t y_offset = y_field_it->offset;
+  const std::size_t z_offset = z_field_it->offset;
+  uint8_t * data = points.data.data();
+  const int num_blocks = static_cast<int>(point_blocks_.size());
+#pragma omp parallel for num_threads(num_threads_)
+  for (int b = 0; b < num_blocks; ++b) {
+    const auto & segment = twist_segments[point_blocks_[b].first];
+    const std::size_t begin = point_blocks_[b].second;
+    const std::size_t end = std::min(begin + block_size, segment.end);
+    for (std::size_t i = begin; i < end; ++i) {
+      uint8_t * point = data + i * point_step;
+      Eigen::Vector3f p;
+      std::memcpy(&p.x(), point + x_offset, sizeof(float));
+      std::memcpy(&p.y(), point + y_offset, sizeof(float));
+      std::memcpy(&p.z(), point + z_offset, sizeof(float));
+
+      const float dt = static_cast<float>(time_stamp_at(i) - segment.start_time_stamp);
+      float x_i;
+      float y_i;
+      float theta_i;
+      poseAt(segment, dt, x_i, y_i, theta_i);
+      const Eigen::Affine3f baselinkTF_odom =
+        Eigen::Translation3f(x_i, y_i, 0.0f) * Eigen::AngleAxisf(theta_i, Eigen::Vector3f::UnitZ());
+
+      p = base_link_to_sensor * (baselinkTF_odom * (base_link_to_sensor_inv * p));
+      std::memcpy(point + x_offset, &p.x(), sizeof(float));
+      std::memcpy(point + y_offset, &p.y(), sizeof(float));
+      std::memcpy(point + z_offset, &p.z(), sizeof(float));
+    }
+  }
+  return true;
+}
+
 }  // namespace pointcloud_preprocessor
 
 #include <rclcpp_components/register_node_macro.hpp>
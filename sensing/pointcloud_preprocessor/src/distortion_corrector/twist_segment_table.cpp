@@ -0,0 +1,149 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/distortion_corrector/twist_segment_table.hpp"
+
+#include <rclcpp/time.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace pointcloud_preprocessor
+{
+void TwistSegmentTable::build(
+  const sensor_msgs::msg::PointCloud2 & points, const std::size_t time_stamp_offset,
+  const std::deque<geometry_msgs::msg::TwistStamped> & twist_queue,
+  const std::deque<geometry_msgs::msg::Vector3Stamped> & angular_velocity_queue,
+  const bool use_imu)
+{
+  twist_queue_ = &twist_queue;
+  angular_velocity_queue_ = &angular_velocity_queue;
+  use_imu_ = use_imu;
+  twist_out_of_range_ = false;
+  imu_out_of_range_ = false;
+  segments_.clear();
+
+  const std::size_t num_points = points.width * points.height;
+  if (num_points == 0U || twist_queue.empty()) {
+    return;
+  }
+
+  const std::size_t point_step = points.point_step;
+  const auto time_stamp_at = [&](const std::size_t i) {
+    double time_stamp;
+    std::memcpy(&time_stamp, &points.data[i * point_step + time_stamp_offset], sizeof(double));
+    return time_stamp;
+  };
+  const auto first_index_after = [&](const double time_stamp) {
+    std::size_t low = 0U;
+    std::size_t high = num_points;
+    while (low < high) {
+      const std::size_t mid = low + (high - low) / 2;
+      if (time_stamp_at(mid) > time_stamp) {
+        high = mid;
+      } else {
+        low = mid + 1;
+      }
+    }
+    return low;
+  };
+
+  // the selected twist/imu changes at their stamps and the 0.1 s validity gate at stamp -/+ 0.1
+  break_time_stamps_.clear();
+  const auto add_break_time_stamps = [this](const builtin_interfaces::msg::Time & stamp) {
+    const double t = rclcpp::Time(stamp).seconds();
+    break_time_stamps_.push_back(t - 0.1);
+    break_time_stamps_.push_back(t);
+    break_time_stamps_.push_back(t + 0.1);
+  };
+  for (const auto & twist : twist_queue) {
+    add_break_time_stamps(twist.header.stamp);
+  }
+  if (use_imu) {
+    for (const auto & angular_velocity : angular_velocity_queue) {
+      add_break_time_stamps(angular_velocity.header.stamp);
+    }
+  }
+  std::sort(break_time_stamps_.begin(), break_time_stamps_.end());
+
+  // pose table: the pose at the start of each constant-twist segment
+  const double first_point_time_stamp_sec = time_stamp_at(0);
+  std::size_t segment_begin = 0U;
+  auto break_it = std::upper_bound(
+    break_time_stamps_.begin(), break_time_stamps_.end(), first_point_time_stamp_sec);
+  TwistSegment pose{};
+  while (segment_begin < num_points) {
+    std::size_t segment_end = num_points;
+    for (; break_it != break_time_stamps_.end(); ++break_it) {
+      segment_end = first_index_after(*break_it);
+      if (segment_end > segment_begin) {
+        break;
+      }
+      segment_end = num_points;
+    }
+
+    TwistSegment segment;
+    segment.begin = segment_begin;
+    segment.end = segment_end;
+    segment.start_time_stamp =
+      segment_begin == 0U ? first_point_time_stamp_sec : time_stamp_at(segment_begin - 1);
+    getTwistAt(time_stamp_at(segment_begin), segment.v, segment.w);
+    segment.theta = pose.theta;
+    segment.x = pose.x;
+    segment.y = pose.y;
+    segments_.push_back(segment);
+
+    // integrate the constant twist up to the last point of the segment
+    const float dt = static_cast<float>(time_stamp_at(segment_end - 1) - segment.start_time_stamp);
+    poseAt(segment, dt, pose.x, pose.y, pose.theta);
+    segment_begin = segment_end;
+  }
+}
+
+void TwistSegmentTable::getTwistAt(const double time_stamp, float & v, float & w)
+{
+  // same selection as the sequential walk: the first twist which is not older than the point
+  auto twist_it = std::lower_bound(
+    std::begin(*twist_queue_), std::end(*twist_queue_), time_stamp,
+    [](const geometry_msgs::msg::TwistStamped & x, const double t) {
+      return rclcpp::Time(x.header.stamp).seconds() < t;
+    });
+  twist_it = twist_it == std::end(*twist_queue_) ? std::end(*twist_queue_) - 1 : twist_it;
+
+  v = static_cast<float>(twist_it->twist.linear.x);
+  w = static_cast<float>(twist_it->twist.angular.z);
+  if (std::abs(time_stamp - rclcpp::Time(twist_it->header.stamp).seconds()) > 0.1) {
+    twist_out_of_range_ = true;
+    v = 0.0f;
+    w = 0.0f;
+  }
+
+  if (!use_imu_ || angular_velocity_queue_->empty()) {
+    return;
+  }
+  auto imu_it = std::lower_bound(
+    std::begin(*angular_velocity_queue_), std::end(*angular_velocity_queue_), time_stamp,
+    [](const geometry_msgs::msg::Vector3Stamped & x, const double t) {
+      return rclcpp::Time(x.header.stamp).seconds() < t;
+    });
+  imu_it = imu_it == std::end(*angular_velocity_queue_) ? std::end(*angular_velocity_queue_) - 1
+                                                         : imu_it;
+  if (std::abs(time_stamp - rclcpp::Time(imu_it->header.stamp).seconds()) > 0.1) {
+    imu_out_of_range_ = true;
+  } else {
+    w = static_cast<float>(imu_it->vector.z);
+  }
+}
+}  // namespace pointcloud_preprocessor
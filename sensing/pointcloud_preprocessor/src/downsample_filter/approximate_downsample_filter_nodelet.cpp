@@ -55,6 +55,8 @@
 #include <pcl/search/kdtree.h>
 #include <pcl/segmentation/segment_differences.h>
 
+#include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -67,6 +69,7 @@ ApproximateDownsampleFilterComponent::ApproximateDownsampleFilterComponent(
     voxel_size_x_ = static_cast<double>(declare_parameter("voxel_size_x", 0.3));
     voxel_size_y_ = static_cast<double>(declare_parameter("voxel_size_y", 0.3));
     voxel_size_z_ = static_cast<double>(declare_parameter("voxel_size_z", 0.1));
+    num_threads_ = std::max(static_cast<int>(declare_parameter("num_threads", 1)), 1);
   }
 
   using std::placeholders::_1;
@@ -81,11 +84,80 @@ void ApproximateDownsampleFilterComponent::filter(
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_input(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(*input, *pcl_input);
-  pcl_output->points.reserve(pcl_input->points.size());
-  pcl::VoxelGridNearestCentroid<pcl::PointXYZ> filter;
-  filter.setInputCloud(pcl_input);
-  filter.setLeafSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
-  filter.filter(*pcl_output);
+  const auto & points = pcl_input->points;
+
+  // each thread accumulates the centroids of a contiguous range of points in its own table
+  const auto num_threads = static_cast<size_t>(num_threads_);
+  const size_t points_per_thread = (points.size() + num_threads - 1) / num_threads;
+  thread_tables_.resize(num_threads);
+  thread_merged_entries_.resize(num_threads);
+  thread_nearest_points_.resize(num_threads);
+  point_entries_.resize(points.size());
+  constexpr uint32_t invalid_entry = std::numeric_limits<uint32_t>::max();
+#pragma omp parallel for num_threads(num_threads_)
+  for (size_t t = 0; t < num_threads; ++t) {
+    auto & table = thread_tables_[t];
+    table.setVoxelSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
+    table.reset(points_per_thread);
+    const size_t end = std::min((t + 1) * points_per_thread, points.size());
+    for (size_t i = t * points_per_thread; i < end; ++i) {
+      if (!table.addPoint(points[i].x, points[i].y, points[i].z, point_entries_[i])) {
+        point_entries_[i] = invalid_entry;
+      }
+    }
+  }
+
+  // merging the tables in order keeps the voxels in the order in which they are first seen
+  merged_table_.reset(thread_tables_.front().centroids().size());
+  for (size_t t = 0; t < num_threads; ++t) {
+    merged_table_.merge(thread_tables_[t], thread_merged_entries_[t]);
+  }
+  const auto & centroids = merged_table_.centroids();
+
+  // each thread finds the point nearest to the centroid of each voxel of its table
+#pragma omp parallel for num_threads(num_threads_)
+  for (size_t t = 0; t < num_threads; ++t) {
+    const auto & merged_entries = thread_merged_entries_[t];
+    auto & nearest_points = thread_nearest_points_[t];
+    nearest_points.assign(
+      merged_entries.size(), NearestPoint{std::numeric_limits<float>::max(), 0U});
+    const size_t end = std::min((t + 1) * points_per_thread, points.size());
+    for (size_t i = t * points_per_thread; i < end; ++i) {
+      const uint32_t entry = point_entries_[i];
+      if (entry == invalid_entry) {
+        continue;
+      }
+      const auto & centroid = centroids[merged_entries[entry]];
+      const auto num_points = static_cast<float>(centroid.num_points);
+      const float dx = points[i].x - centroid.x / num_points;
+      const float dy = points[i].y - centroid.y / num_points;
+      const float dz = points[i].z - centroid.z / num_points;
+      const float squared_distance = dx * dx + dy * dy + dz * dz;
+      // the first point wins a tie, as in pcl::VoxelGridNearestCentroid
+      if (squared_distance < nearest_points[entry].squared_distance) {
+        nearest_points[entry] = NearestPoint{squared_distance, static_cast<uint32_t>(i)};
+      }
+    }
+  }
+
+  nearest_points_.assign(centroids.size(), NearestPoint{std::numeric_limits<float>::max(), 0U});
+  for (size_t t = 0; t < num_threads; ++t) {
+    const auto & merged_entries = thread_merged_entries_[t];
+    const auto & nearest_points = thread_nearest_points_[t];
+    for (size_t entry = 0; entry < merged_entries.size(); ++entry) {
+      auto & nearest_point = nearest_points_[merged_entries[entry]];
+      if (nearest_points[entry].squared_distance < nearest_point.squared_distance) {
+        nearest_point = nearest_points[entry];
+      }
+    }
+  }
+
+  pcl_output->points.reserve(nearest_points_.size());
+  for (const auto & nearest_point : nearest_points_) {
+    pcl_output->points.push_back(points[nearest_point.index]);
+  }
+  pcl_output->width = static_cast<uint32_t>(pcl_output->points.size());
+  pcl_output->height = 1;
 
   pcl::toROSMsg(*pcl_output, output);
   output.header = input->header;
@@ -108,6 +180,11 @@ rcl_interfaces::msg::SetParametersResult ApproximateDownsampleFilterComponent::p
     RCLCPP_DEBUG(get_logger(), "Setting new distance threshold to: %f.", voxel_size_z_);
   }
 
+  if (get_param(p, "num_threads", num_threads_)) {
+    num_threads_ = std::max(num_threads_, 1);
+    RCLCPP_DEBUG(get_logger(), "Setting new num_threads to: %d.", num_threads_);
+  }
+
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
   result.reason = "success";
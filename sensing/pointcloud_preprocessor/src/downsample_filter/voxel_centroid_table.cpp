@@ -0,0 +1,167 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/downsample_filter/voxel_centroid_table.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace pointcloud_preprocessor
+{
+namespace
+{
+constexpr int64_t key_axis_bits = 21;
+constexpr int64_t key_axis_offset = int64_t{1} << (key_axis_bits - 1);
+constexpr uint64_t key_axis_mask = (uint64_t{1} << key_axis_bits) - 1U;
+
+// finalizer of splitmix64, spreads the packed coordinates over all bits
+inline uint64_t hashKey(uint64_t key)
+{
+  key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+  return key ^ (key >> 31);
+}
+
+inline bool toAxisIndex(const float value, const float inverse_voxel_size, uint64_t & index)
+{
+  const float scaled = std::floor(value * inverse_voxel_size);
+  if (!(std::abs(scaled) < static_cast<float>(key_axis_offset))) {
+    return false;
+  }
+  index = static_cast<uint64_t>(static_cast<int64_t>(scaled) + key_axis_offset) & key_axis_mask;
+  return true;
+}
+}  // namespace
+
+void VoxelCentroidTable::setVoxelSize(
+  const float voxel_size_x, const float voxel_size_y, const float voxel_size_z)
+{
+  inverse_voxel_size_x_ = 1.0f / voxel_size_x;
+  inverse_voxel_size_y_ = 1.0f / voxel_size_y;
+  inverse_voxel_size_z_ = 1.0f / voxel_size_z;
+}
+
+void VoxelCentroidTable::reset(const std::size_t expected_num_voxels)
+{
+  centroids_.clear();
+  centroids_.reserve(expected_num_voxels);
+  centroid_keys_.clear();
+  centroid_keys_.reserve(expected_num_voxels);
+
+  // keep the load factor under 0.5
+  std::size_t num_slots = std::max<std::size_t>(slot_keys_.size(), 1024U);
+  while (num_slots < 2U * expected_num_voxels) {
+    num_slots *= 2U;
+  }
+  if (num_slots != slot_keys_.size()) {
+    slot_keys_.assign(num_slots, 0U);
+    slot_entries_.assign(num_slots, empty_slot);
+    slot_generations_.assign(num_slots, 0U);
+    slot_mask_ = num_slots - 1U;
+  }
+
+  ++generation_;
+  if (generation_ == 0U) {
+    // wrapped around, the stale generations can not be told apart any more
+    std::fill(slot_generations_.begin(), slot_generations_.end(), 0U);
+    generation_ = 1U;
+  }
+}
+
+bool VoxelCentroidTable::addPoint(const float x, const float y, const float z, uint32_t & entry)
+{
+  uint64_t ix;
+  uint64_t iy;
+  uint64_t iz;
+  if (
+    !toAxisIndex(x, inverse_voxel_size_x_, ix) || !toAxisIndex(y, inverse_voxel_size_y_, iy) ||
+    !toAxisIndex(z, inverse_voxel_size_z_, iz)) {
+    return false;
+  }
+  const uint64_t key = (ix << (2 * key_axis_bits)) | (iy << key_axis_bits) | iz;
+  entry = accumulate(key, Centroid{x, y, z, 1U});
+  return true;
+}
+
+void VoxelCentroidTable::merge(const VoxelCentroidTable & other, std::vector<uint32_t> & entries)
+{
+  entries.resize(other.centroids_.size());
+  for (std::size_t i = 0; i < other.centroids_.size(); ++i) {
+    entries[i] = accumulate(other.centroid_keys_[i], other.centroids_[i]);
+  }
+}
+
+uint32_t VoxelCentroidTable::accumulate(const uint64_t key, const Centroid & sum)
+{
+  if (slot_keys_.empty()) {
+    reset(0U);
+  }
+  for (std::size_t slot = hashKey(key) & slot_mask_;; slot = (slot + 1U) & slot_mask_) {
+    if (slot_generations_[slot] != generation_) {
+      // new voxel
+      const auto entry = static_cast<uint32_t>(centroids_.size());
+      if (2U * (centroids_.size() + 1U) > slot_keys_.size()) {
+        rehash(slot_keys_.size() * 2U);
+        insert(key, entry);
+      } else {
+        slot_keys_[slot] = key;
+        slot_entries_[slot] = entry;
+        slot_generations_[slot] = generation_;
+      }
+      centroids_.push_back(sum);
+      centroid_keys_.push_back(key);
+      return entry;
+    }
+    if (slot_keys_[slot] == key) {
+      auto & centroid = centroids_[slot_entries_[slot]];
+      centroid.x += sum.x;
+      centroid.y += sum.y;
+      centroid.z += sum.z;
+      centroid.num_points += sum.num_points;
+      return slot_entries_[slot];
+    }
+  }
+}
+
+void VoxelCentroidTable::rehash(const std::size_t num_slots)
+{
+  std::vector<uint64_t> old_keys;
+  std::vector<uint32_t> old_entries;
+  std::vector<uint32_t> old_generations;
+  old_keys.swap(slot_keys_);
+  old_entries.swap(slot_entries_);
+  old_generations.swap(slot_generations_);
+
+  slot_keys_.assign(num_slots, 0U);
+  slot_entries_.assign(num_slots, empty_slot);
+  slot_generations_.assign(num_slots, 0U);
+  slot_mask_ = num_slots - 1U;
+  for (std::size_t i = 0; i < old_keys.size(); ++i) {
+    if (old_generations[i] == generation_) {
+      insert(old_keys[i], old_entries[i]);
+    }
+  }
+}
+
+void VoxelCentroidTable::insert(const uint64_t key, const uint32_t entry)
+{
+  std::size_t slot = hashKey(key) & slot_mask_;
+  while (slot_generations_[slot] == generation_) {
+    slot = (slot + 1U) & slot_mask_;
+  }
+  slot_keys_[slot] = key;
+  slot_entries_[slot] = entry;
+  slot_generations_[slot] = generation_;
+}
+}  // namespace pointcloud_preprocessor
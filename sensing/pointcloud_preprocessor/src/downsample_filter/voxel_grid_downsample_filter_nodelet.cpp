@@ -50,9 +50,7 @@
 
 #include "pointcloud_preprocessor/downsample_filter/voxel_grid_downsample_filter_nodelet.hpp"
 
-#include <pcl/kdtree/kdtree_flann.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/segmentation/segment_differences.h>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 
 #include <vector>
 
@@ -78,18 +76,37 @@ void VoxelGridDownsampleFilterComponent::filter(
   const PointCloud2ConstPtr & input, const IndicesPtr & /*indices*/, PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_input(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::fromROSMsg(*input, *pcl_input);
-  pcl_output->points.reserve(pcl_input->points.size());
-  pcl::VoxelGrid<pcl::PointXYZ> filter;
-  filter.setInputCloud(pcl_input);
-  // filter.setSaveLeafLayout(true);
-  filter.setLeafSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
-  filter.filter(*pcl_output);
+  sensor_msgs::PointCloud2ConstIterator<float> it_x(*input, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> it_y(*input, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> it_z(*input, "z");
 
-  pcl::toROSMsg(*pcl_output, output);
+  voxel_centroid_table_.setVoxelSize(voxel_size_x_, voxel_size_y_, voxel_size_z_);
+  voxel_centroid_table_.reset(input->width * input->height);
+  for (; it_x != it_x.end(); ++it_x, ++it_y, ++it_z) {
+    voxel_centroid_table_.addPoint(*it_x, *it_y, *it_z);
+  }
+
+  // emit the centroids as an xyz cloud, with the same layout as pcl::PointXYZ
+  const auto & centroids = voxel_centroid_table_.centroids();
   output.header = input->header;
+  output.height = 1;
+  output.width = static_cast<uint32_t>(centroids.size());
+  output.is_dense = true;
+  sensor_msgs::PointCloud2Modifier modifier(output);
+  modifier.setPointCloud2FieldsByString(1, "xyz");
+  modifier.resize(centroids.size());
+  sensor_msgs::PointCloud2Iterator<float> out_x(output, "x");
+  sensor_msgs::PointCloud2Iterator<float> out_y(output, "y");
+  sensor_msgs::PointCloud2Iterator<float> out_z(output, "z");
+  for (const auto & centroid : centroids) {
+    const float inverse_num_points = 1.0f / static_cast<float>(centroid.num_points);
+    *out_x = centroid.x * inverse_num_points;
+    *out_y = centroid.y * inverse_num_points;
+    *out_z = centroid.z * inverse_num_points;
+    ++out_x;
+    ++out_y;
+    ++out_z;
+  }
 }
 
 rcl_interfaces::msg::SetParametersResult VoxelGridDownsampleFilterComponent::paramCallback(
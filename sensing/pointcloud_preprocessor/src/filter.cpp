@@ -51,7 +51,13 @@
 
 #include "pointcloud_preprocessor/filter.hpp"
 
-#include <pcl_ros/transforms.hpp>
+#include "pointcloud_preprocessor/utility/utilities.hpp"
+
+#ifdef ROS_DISTRO_GALACTIC
+#include <tf2_eigen/tf2_eigen.h>
+#else
+#include <tf2_eigen/tf2_eigen.hpp>
+#endif
 
 #include <pcl/io/io.h>
 
@@ -75,6 +81,14 @@ pointcloud_preprocessor::Filter::Filter(
     use_indices_ = static_cast<bool>(declare_parameter("use_indices", false));
     latched_indices_ = static_cast<bool>(declare_parameter("latched_indices", false));
     approximate_sync_ = static_cast<bool>(declare_parameter("approximate_sync", false));
+    const bool latency_trace = static_cast<bool>(declare_parameter("latency_trace", false));
+    const auto latency_trace_name = static_cast<std::string>(
+      declare_parameter("latency_trace_name", "/pointcloud_preprocessor_latency_trace"));
+    if (latency_trace && !latency_tracer_.open(latency_trace_name)) {
+      RCLCPP_WARN(
+        this->get_logger(), "Could not open the latency trace buffer %s.",
+        latency_trace_name.c_str());
+    }
 
     RCLCPP_INFO_STREAM(
       this->get_logger(),
@@ -88,8 +102,10 @@ pointcloud_preprocessor::Filter::Filter(
 
   // Set publisher
   {
+    rclcpp::PublisherOptionsWithAllocator<PointCloud2PoolAllocator<void>> pub_options;
+    pub_options.allocator = std::make_shared<PointCloud2PoolAllocator<void>>();
     pub_output_ = this->create_publisher<PointCloud2>(
-      "output", rclcpp::SensorDataQoS().keep_last(max_queue_size_));
+      "output", rclcpp::SensorDataQoS().keep_last(max_queue_size_), pub_options);
   }
 
   subscribe();
@@ -109,6 +125,7 @@ void pointcloud_preprocessor::Filter::setupTF()
 {
   tf_buffer_ = std::make_shared<tf2_ros::Buffer>(this->get_clock());
   tf_listener_ = std::make_shared<tf2_ros::TransformListener>(*tf_buffer_);
+  static_tf_cache_ = std::make_unique<tier4_autoware_utils::StaticTransformCache>(*tf_buffer_);
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -125,18 +142,22 @@ void pointcloud_preprocessor::Filter::subscribe()
       sync_input_indices_a_ = std::make_shared<ApproximateTimeSyncPolicy>(max_queue_size_);
       sync_input_indices_a_->connectInput(sub_input_filter_, sub_indices_filter_);
       sync_input_indices_a_->registerCallback(std::bind(
-        &Filter::input_indices_callback, this, std::placeholders::_1, std::placeholders::_2));
+        &Filter::input_indices_callback, this, std::placeholders::_1, std::placeholders::_2,
+        nullptr));
     } else {
       sync_input_indices_e_ = std::make_shared<ExactTimeSyncPolicy>(max_queue_size_);
       sync_input_indices_e_->connectInput(sub_input_filter_, sub_indices_filter_);
       sync_input_indices_e_->registerCallback(std::bind(
-        &Filter::input_indices_callback, this, std::placeholders::_1, std::placeholders::_2));
+        &Filter::input_indices_callback, this, std::placeholders::_1, std::placeholders::_2,
+        nullptr));
     }
   } else {
     // Subscribe in an old fashion to input only (no filters)
+    // The cloud is taken as UniquePtr, so that it is not copied within an intra-process container
+    // if this is its only subscriber, and it is transformed into the input frame in place.
     // CAN'T use auto-type here.
-    std::function<void(const PointCloud2ConstPtr msg)> cb = std::bind(
-      &Filter::input_indices_callback, this, std::placeholders::_1, PointIndicesConstPtr());
+    std::function<void(PointCloud2::UniquePtr msg)> cb =
+      std::bind(&Filter::input_callback, this, std::placeholders::_1);
     sub_input_ = create_subscription<PointCloud2>(
       "input", rclcpp::SensorDataQoS().keep_last(max_queue_size_), cb);
   }
@@ -162,7 +183,8 @@ void pointcloud_preprocessor::Filter::unsubscribe()
 void pointcloud_preprocessor::Filter::computePublish(
   const PointCloud2ConstPtr & input, const IndicesPtr & indices)
 {
-  auto output = std::make_unique<PointCloud2>();
+  // The output is rarely larger than the input, so its buffer is taken from the pool at that size
+  auto output = makePooledPointCloud2(input->data.size());
 
   // Call the virtual method in the child
   filter(input, indices, *output);
@@ -173,14 +195,12 @@ void pointcloud_preprocessor::Filter::computePublish(
       this->get_logger(), "[computePublish] Transforming output dataset from %s to %s.",
       output->header.frame_id.c_str(), tf_output_frame_.c_str());
     // Convert the cloud into the different frame
-    auto cloud_transformed = std::make_unique<PointCloud2>();
-    if (!pcl_ros::transformPointCloud(tf_output_frame_, *output, *cloud_transformed, *tf_buffer_)) {
+    if (!transformPointCloudInplace(tf_output_frame_, *output)) {
       RCLCPP_ERROR(
         this->get_logger(), "[computePublish] Error converting output dataset from %s to %s.",
         output->header.frame_id.c_str(), tf_output_frame_.c_str());
       return;
     }
-    output = std::move(cloud_transformed);
   }
   if (tf_output_frame_.empty() && output->header.frame_id != tf_input_orig_frame_) {
     // no tf_output_frame given, transform the dataset to its original frame
@@ -188,15 +208,12 @@ void pointcloud_preprocessor::Filter::computePublish(
       this->get_logger(), "[computePublish] Transforming output dataset from %s back to %s.",
       output->header.frame_id.c_str(), tf_input_orig_frame_.c_str());
     // Convert the cloud into the different frame
-    auto cloud_transformed = std::make_unique<PointCloud2>();
-    if (!pcl_ros::transformPointCloud(
-          tf_input_orig_frame_, *output, *cloud_transformed, *tf_buffer_)) {
+    if (!transformPointCloudInplace(tf_input_orig_frame_, *output)) {
       RCLCPP_ERROR(
         this->get_logger(), "[computePublish] Error converting output dataset from %s back to %s.",
         output->header.frame_id.c_str(), tf_input_orig_frame_.c_str());
       return;
     }
-    output = std::move(cloud_transformed);
   }
 
   // Copy timestamp to keep it
@@ -207,6 +224,33 @@ void pointcloud_preprocessor::Filter::computePublish(
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////////
+bool pointcloud_preprocessor::Filter::transformPointCloudInplace(
+  const std::string & target_frame, PointCloud2 & cloud)
+{
+  if (cloud.header.frame_id == target_frame) {
+    return true;
+  }
+
+  // the sensor extrinsics are static, so they are looked up at the stamp only when they are not
+  auto transform_stamped = static_tf_cache_->getTransform(target_frame, cloud.header.frame_id);
+  if (!transform_stamped) {
+    try {
+      transform_stamped = std::make_shared<const geometry_msgs::msg::TransformStamped>(
+        tf_buffer_->lookupTransform(target_frame, cloud.header.frame_id, cloud.header.stamp));
+    } catch (tf2::TransformException & ex) {
+      RCLCPP_WARN(this->get_logger(), "%s", ex.what());
+      return false;
+    }
+  }
+  const Eigen::Affine3f transform(
+    tf2::transformToEigen(transform_stamped->transform).matrix().cast<float>());
+  if (!utils::transform_pointcloud_inplace(transform, cloud)) {
+    return false;
+  }
+  cloud.header.frame_id = target_frame;
+  return true;
+}
+
 rcl_interfaces::msg::SetParametersResult pointcloud_preprocessor::Filter::filterParamCallback(
   const std::vector<rclcpp::Parameter> & p)
 {
@@ -226,10 +270,20 @@ rcl_interfaces::msg::SetParametersResult pointcloud_preprocessor::Filter::filter
   return result;
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////
+void pointcloud_preprocessor::Filter::input_callback(PointCloud2::UniquePtr cloud)
+{
+  const PointCloud2::SharedPtr owned_cloud = std::move(cloud);
+  input_indices_callback(owned_cloud, PointIndicesConstPtr(), owned_cloud);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////
 void pointcloud_preprocessor::Filter::input_indices_callback(
-  const PointCloud2ConstPtr cloud, const PointIndicesConstPtr indices)
+  const PointCloud2ConstPtr cloud, const PointIndicesConstPtr indices,
+  const PointCloud2::SharedPtr & owned_cloud)
 {
+  const int64_t entry_ns = latency_tracer_.isOpen() ? LatencyTracer::now() : 0;
+
   // If cloud is given, check if it's valid
   if (!isValid(cloud)) {
     RCLCPP_ERROR(this->get_logger(), "[input_indices_callback] Invalid input!");
@@ -269,26 +323,29 @@ void pointcloud_preprocessor::Filter::input_indices_callback(
       this->get_logger(), "[input_indices_callback] Transforming input dataset from %s to %s.",
       cloud->header.frame_id.c_str(), tf_input_frame_.c_str());
     // Save the original frame ID
-    // Convert the cloud into the different frame
-    PointCloud2 cloud_transformed;
-
-    if (!tf_buffer_->canTransform(
-          tf_input_frame_, cloud->header.frame_id, this->now(),
-          rclcpp::Duration::from_seconds(1.0))) {
+    // Convert the cloud into the different frame, in place if the cloud is owned
+    const auto cloud_transformed =
+      owned_cloud ? owned_cloud : std::make_shared<PointCloud2>(*cloud);
+
+    if (
+      !static_tf_cache_->getTransform(tf_input_frame_, cloud->header.frame_id) &&
+      !tf_buffer_->canTransform(
+        tf_input_frame_, cloud->header.frame_id, this->now(),
+        rclcpp::Duration::from_seconds(1.0))) {
       RCLCPP_ERROR_STREAM(
         this->get_logger(), "[input_indices_callback] timeout tf: " << cloud->header.frame_id
                                                                     << "->" << tf_input_frame_);
       return;
     }
 
-    if (!pcl_ros::transformPointCloud(tf_input_frame_, *cloud, cloud_transformed, *tf_buffer_)) {
+    if (!transformPointCloudInplace(tf_input_frame_, *cloud_transformed)) {
       RCLCPP_ERROR(
         this->get_logger(),
         "[input_indices_callback] Error converting input dataset from %s to %s.",
         cloud->header.frame_id.c_str(), tf_input_frame_.c_str());
       return;
     }
-    cloud_tf = std::make_shared<PointCloud2>(cloud_transformed);
+    cloud_tf = cloud_transformed;
   } else {
     cloud_tf = cloud;
   }
@@ -299,4 +356,10 @@ void pointcloud_preprocessor::Filter::input_indices_callback(
   }
 
   computePublish(cloud_tf, vindices);
+
+  if (latency_tracer_.isOpen()) {
+    latency_tracer_.record(
+      this->get_fully_qualified_name(), rclcpp::Time(cloud->header.stamp).nanoseconds(), entry_ns,
+      LatencyTracer::now());
+  }
 }
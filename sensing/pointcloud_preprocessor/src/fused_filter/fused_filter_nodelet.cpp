@@ -0,0 +1,300 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/fused_filter/fused_filter_nodelet.hpp"
+
+#include <pcl/point_types.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace pointcloud_preprocessor
+{
+namespace
+{
+double readField(const uint8_t * data, const uint8_t datatype)
+{
+  using sensor_msgs::msg::PointField;
+  switch (datatype) {
+    case PointField::INT8:
+      return static_cast<double>(*reinterpret_cast<const int8_t *>(data));
+    case PointField::UINT8:
+      return static_cast<double>(*data);
+    case PointField::INT16: {
+      int16_t v;
+      std::memcpy(&v, data, sizeof(v));
+      return static_cast<double>(v);
+    }
+    case PointField::UINT16: {
+      uint16_t v;
+      std::memcpy(&v, data, sizeof(v));
+      return static_cast<double>(v);
+    }
+    case PointField::INT32: {
+      int32_t v;
+      std::memcpy(&v, data, sizeof(v));
+      return static_cast<double>(v);
+    }
+    case PointField::UINT32: {
+      uint32_t v;
+      std::memcpy(&v, data, sizeof(v));
+      return static_cast<double>(v);
+    }
+    case PointField::FLOAT32: {
+      float v;
+      std::memcpy(&v, data, sizeof(v));
+      return static_cast<double>(v);
+    }
+    case PointField::FLOAT64: {
+      double v;
+      std::memcpy(&v, data, sizeof(v));
+      return v;
+    }
+    default:
+      return 0.0;
+  }
+}
+}  // namespace
+
+FusedFilterComponent::FusedFilterComponent(const rclcpp::NodeOptions & options)
+: Filter("FusedFilter", options)
+{
+  // initialize debug tool
+  {
+    using tier4_autoware_utils::DebugPublisher;
+    using tier4_autoware_utils::StopWatch;
+    stop_watch_ptr_ = std::make_unique<StopWatch<std::chrono::milliseconds>>();
+    debug_publisher_ = std::make_unique<DebugPublisher>(this, "fused_filter");
+    stop_watch_ptr_->tic("cyclic_time");
+    stop_watch_ptr_->tic("processing_time");
+  }
+
+  // set initial parameters
+  {
+    const auto stage_names =
+      declare_parameter("stages", std::vector<std::string>{"crop_box", "voxel_grid_downsample"});
+    for (const auto & name : stage_names) {
+      Stage stage;
+      stage.name = name;
+      const auto type = declare_parameter(name + ".type", name);
+      if (type == "crop_box") {
+        stage.type = StageType::CropBox;
+        stage.min_x = static_cast<float>(declare_parameter(name + ".min_x", -1.0));
+        stage.min_y = static_cast<float>(declare_parameter(name + ".min_y", -1.0));
+        stage.min_z = static_cast<float>(declare_parameter(name + ".min_z", -1.0));
+        stage.max_x = static_cast<float>(declare_parameter(name + ".max_x", 1.0));
+        stage.max_y = static_cast<float>(declare_parameter(name + ".max_y", 1.0));
+        stage.max_z = static_cast<float>(declare_parameter(name + ".max_z", 1.0));
+        stage.negative = static_cast<bool>(declare_parameter(name + ".negative", false));
+      } else if (type == "passthrough") {
+        stage.type = StageType::PassThrough;
+        stage.field_name = declare_parameter(name + ".field_name", std::string("z"));
+        stage.min = static_cast<double>(declare_parameter(name + ".min", -1.0));
+        stage.max = static_cast<double>(declare_parameter(name + ".max", 1.0));
+        stage.negative = static_cast<bool>(declare_parameter(name + ".negative", false));
+      } else if (type == "voxel_grid_downsample") {
+        stage.type = StageType::VoxelGridDownsample;
+        stage.voxel_size_x = static_cast<float>(declare_parameter(name + ".voxel_size_x", 0.3));
+        stage.voxel_size_y = static_cast<float>(declare_parameter(name + ".voxel_size_y", 0.3));
+        stage.voxel_size_z = static_cast<float>(declare_parameter(name + ".voxel_size_z", 0.1));
+      } else {
+        throw std::invalid_argument("Unknown fused filter stage type: " + type);
+      }
+      if (!stages_.empty() && stages_.back().type == StageType::VoxelGridDownsample) {
+        throw std::invalid_argument(
+          "voxel_grid_downsample must be the last stage of the fused filter");
+      }
+      stages_.push_back(stage);
+    }
+  }
+
+  using std::placeholders::_1;
+  set_param_res_ = this->add_on_set_parameters_callback(
+    std::bind(&FusedFilterComponent::paramCallback, this, _1));
+}
+
+bool FusedFilterComponent::isPointKept(
+  const Stage & stage, const uint8_t * point, const float x, const float y, const float z) const
+{
+  if (stage.type == StageType::CropBox) {
+    const bool inside = stage.min_z < z && z < stage.max_z && stage.min_y < y &&
+                        y < stage.max_y && stage.min_x < x && x < stage.max_x;
+    return stage.negative ? !inside : inside;
+  }
+  if (stage.type == StageType::PassThrough) {
+    const double value = readField(point + stage.field_offset, stage.field_datatype);
+    const bool inside = stage.min <= value && value <= stage.max;
+    return stage.negative ? !inside : inside;
+  }
+  return true;
+}
+
+void FusedFilterComponent::filter(
+  const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
+  PointCloud2 & output)
+{
+  std::scoped_lock lock(mutex_);
+  stop_watch_ptr_->toc("processing_time", true);
+
+  const auto find_field = [&input](const std::string & name) {
+    return std::find_if(
+      input->fields.cbegin(), input->fields.cend(),
+      [&name](const sensor_msgs::msg::PointField & field) { return field.name == name; });
+  };
+  const auto x_field = find_field("x");
+  const auto y_field = find_field("y");
+  const auto z_field = find_field("z");
+  if (
+    x_field == input->fields.cend() || y_field == input->fields.cend() ||
+    z_field == input->fields.cend()) {
+    RCLCPP_ERROR_THROTTLE(get_logger(), *get_clock(), 5000, "Input has no x, y or z field.");
+    return;
+  }
+
+  // resolve the passthrough fields, and split off the terminal downsample stage
+  const Stage * downsample_stage = nullptr;
+  std::size_t num_pointwise_stages = stages_.size();
+  for (auto & stage : stages_) {
+    if (stage.type == StageType::PassThrough) {
+      const auto field = find_field(stage.field_name);
+      if (field == input->fields.cend()) {
+        RCLCPP_ERROR_THROTTLE(
+          get_logger(), *get_clock(), 5000, "Input has no %s field for stage %s.",
+          stage.field_name.c_str(), stage.name.c_str());
+        return;
+      }
+      stage.field_offset = field->offset;
+      stage.field_datatype = field->datatype;
+    } else if (stage.type == StageType::VoxelGridDownsample) {
+      downsample_stage = &stage;
+      num_pointwise_stages = stages_.size() - 1;
+    }
+  }
+
+  // single pass: run the pointwise stages on each point and keep only the surviving offsets
+  kept_offsets_.clear();
+  if (downsample_stage) {
+    voxel_centroid_table_.setVoxelSize(
+      downsample_stage->voxel_size_x, downsample_stage->voxel_size_y,
+      downsample_stage->voxel_size_z);
+    voxel_centroid_table_.reset(input->width * input->height);
+  }
+  const std::size_t point_step = input->point_step;
+  const std::size_t num_points = input->width * input->height;
+  const uint8_t * data = input->data.data();
+  for (std::size_t i = 0; i < num_points; ++i) {
+    const uint8_t * point = data + i * point_step;
+    float x;
+    float y;
+    float z;
+    std::memcpy(&x, point + x_field->offset, sizeof(float));
+    std::memcpy(&y, point + y_field->offset, sizeof(float));
+    std::memcpy(&z, point + z_field->offset, sizeof(float));
+
+    bool kept = true;
+    for (std::size_t s = 0; s < num_pointwise_stages && kept; ++s) {
+      kept = isPointKept(stages_[s], point, x, y, z);
+    }
+    if (!kept) {
+      continue;
+    }
+
+    if (downsample_stage) {
+      voxel_centroid_table_.addPoint(x, y, z);
+    } else {
+      kept_offsets_.push_back(i * point_step);
+    }
+  }
+
+  if (downsample_stage) {
+    pcl::PointCloud<pcl::PointXYZ> pcl_output;
+    const auto & centroids = voxel_centroid_table_.centroids();
+    pcl_output.points.reserve(centroids.size());
+    for (const auto & centroid : centroids) {
+      const float inv = 1.0f / static_cast<float>(centroid.num_points);
+      pcl_output.points.emplace_back(centroid.x * inv, centroid.y * inv, centroid.z * inv);
+    }
+    pcl_output.width = pcl_output.points.size();
+    pcl_output.height = 1;
+    pcl::toROSMsg(pcl_output, output);
+    output.header = input->header;
+  } else {
+    output.data.resize(kept_offsets_.size() * point_step);
+    std::size_t j = 0;
+    for (const auto offset : kept_offsets_) {
+      std::memcpy(&output.data[j], &data[offset], point_step);
+      j += point_step;
+    }
+    output.header.frame_id = input->header.frame_id;
+    output.height = 1;
+    output.fields = input->fields;
+    output.is_bigendian = input->is_bigendian;
+    output.point_step = input->point_step;
+    output.is_dense = input->is_dense;
+    output.width = static_cast<uint32_t>(kept_offsets_.size());
+    output.row_step = static_cast<uint32_t>(output.data.size());
+  }
+
+  // add processing time for debug
+  if (debug_publisher_) {
+    const double cyclic_time_ms = stop_watch_ptr_->toc("cyclic_time", true);
+    const double processing_time_ms = stop_watch_ptr_->toc("processing_time", true);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/cyclic_time_ms", cyclic_time_ms);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/processing_time_ms", processing_time_ms);
+  }
+}
+
+rcl_interfaces::msg::SetParametersResult FusedFilterComponent::paramCallback(
+  const std::vector<rclcpp::Parameter> & p)
+{
+  std::scoped_lock lock(mutex_);
+
+  for (auto & stage : stages_) {
+    const auto & name = stage.name;
+    if (stage.type == StageType::CropBox) {
+      get_param(p, name + ".min_x", stage.min_x);
+      get_param(p, name + ".min_y", stage.min_y);
+      get_param(p, name + ".min_z", stage.min_z);
+      get_param(p, name + ".max_x", stage.max_x);
+      get_param(p, name + ".max_y", stage.max_y);
+      get_param(p, name + ".max_z", stage.max_z);
+      get_param(p, name + ".negative", stage.negative);
+    } else if (stage.type == StageType::PassThrough) {
+      get_param(p, name + ".field_name", stage.field_name);
+      get_param(p, name + ".min", stage.min);
+      get_param(p, name + ".max", stage.max);
+      get_param(p, name + ".negative", stage.negative);
+    } else if (stage.type == StageType::VoxelGridDownsample) {
+      get_param(p, name + ".voxel_size_x", stage.voxel_size_x);
+      get_param(p, name + ".voxel_size_y", stage.voxel_size_y);
+      get_param(p, name + ".voxel_size_z", stage.voxel_size_z);
+    }
+  }
+
+  rcl_interfaces::msg::SetParametersResult result;
+  result.successful = true;
+  result.reason = "success";
+
+  return result;
+}
+}  // namespace pointcloud_preprocessor
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(pointcloud_preprocessor::FusedFilterComponent)
@@ -18,12 +18,12 @@
 
 #include <std_msgs/msg/header.hpp>
 
-#include <pcl/kdtree/kdtree_flann.h>
-#include <pcl/search/kdtree.h>
-#include <pcl/segmentation/segment_differences.h>
-
 #include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -61,6 +61,12 @@ DualReturnOutlierFilterComponent::DualReturnOutlierFilterComponent(
       static_cast<float>(declare_parameter("visibility_error_threshold", 0.5));
     visibility_warn_threshold_ =
       static_cast<float>(declare_parameter("visibility_warn_threshold", 0.7));
+    num_threads_ = std::max(static_cast<int>(declare_parameter("num_threads", 1)), 1);
+  }
+  {
+    sensor_msgs::msg::PointCloud2 empty_cloud;
+    pcl::toROSMsg(pcl::PointCloud<PointXYZIRADRT>(), empty_cloud);
+    point_fields_ = empty_cloud.fields;
   }
   updater_.setHardwareID("dual_return_outlier_filter");
   updater_.add(
@@ -111,239 +117,318 @@ void DualReturnOutlierFilterComponent::onVisibilityChecker(DiagnosticStatusWrapp
   stat.summary(level, msg);
 }
 
+bool DualReturnOutlierFilterComponent::hasPointLayout(const PointCloud2 & input) const
+{
+  if (
+    input.point_step != sizeof(PointXYZIRADRT) || input.is_bigendian ||
+    input.fields.size() != point_fields_.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < point_fields_.size(); ++i) {
+    const auto & field = input.fields[i];
+    const auto & point_field = point_fields_[i];
+    if (
+      field.name != point_field.name || field.offset != point_field.offset ||
+      field.datatype != point_field.datatype || field.count != point_field.count) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void DualReturnOutlierFilterComponent::filter(
   const PointCloud2ConstPtr & input, [[maybe_unused]] const IndicesPtr & indices,
   PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
-  pcl::PointCloud<PointXYZIRADRT>::Ptr pcl_input(new pcl::PointCloud<PointXYZIRADRT>);
-  pcl::fromROSMsg(*input, *pcl_input);
+
+  // the points are read in place, and only a cloud with another layout is converted
+  const PointCloud2 * cloud = input.get();
+  PointCloud2 converted_cloud;
+  if (!hasPointLayout(*input)) {
+    pcl::PointCloud<PointXYZIRADRT> pcl_input;
+    pcl::fromROSMsg(*input, pcl_input);
+    pcl::toROSMsg(pcl_input, converted_cloud);
+    cloud = &converted_cloud;
+  }
 
   uint32_t vertical_bins = vertical_bins_;
   uint32_t horizontal_bins = 36;
-  float max_azimuth = 36000.0f;
-  float min_azimuth = 0.0f;
-  switch (roi_mode_map_[roi_mode_]) {
+  AzimuthRange azimuth_range;
+  azimuth_range.roi_mode = roi_mode_map_[roi_mode_];
+  switch (azimuth_range.roi_mode) {
     case 2: {
-      max_azimuth = max_azimuth_deg_ * 100.0;
-      min_azimuth = min_azimuth_deg_ * 100.0;
+      azimuth_range.max_azimuth = max_azimuth_deg_ * 100.0;
+      azimuth_range.min_azimuth = min_azimuth_deg_ * 100.0;
       break;
     }
 
     default: {
-      max_azimuth = 36000.0f;
-      min_azimuth = 0.0f;
+      azimuth_range.max_azimuth = 36000.0f;
+      azimuth_range.min_azimuth = 0.0f;
       break;
     }
   }
+  azimuth_range.horizontal_res = static_cast<uint32_t>(
+    (azimuth_range.max_azimuth - azimuth_range.min_azimuth) / horizontal_bins);
+
+  // bucket point offsets by ring and return type without copying the input
+  weak_first_ring_indices_.resize(vertical_bins);
+  ring_indices_.resize(vertical_bins);
+  weak_first_ring_outputs_.resize(vertical_bins);
+  ring_outputs_.resize(vertical_bins);
+  for (std::size_t ring = 0; ring < vertical_bins; ++ring) {
+    weak_first_ring_indices_[ring].clear();
+    ring_indices_[ring].clear();
+  }
+  for (std::size_t idx = 0U; idx + cloud->point_step <= cloud->data.size();
+       idx += cloud->point_step) {
+    const auto * point = reinterpret_cast<const PointXYZIRADRT *>(&cloud->data[idx]);
+    if (point->ring >= vertical_bins) {
+      RCLCPP_WARN_THROTTLE(
+        get_logger(), *get_clock(), 5000,
+        "Ring id %u exceeds vertical_bins (%u). Skipping the point.", point->ring, vertical_bins);
+      continue;
+    }
+    if (point->return_type == ReturnType::DUAL_WEAK_FIRST) {
+      weak_first_ring_indices_[point->ring].push_back(idx);
+    } else {
+      ring_indices_[point->ring].push_back(idx);
+    }
+  }
 
-  uint32_t horizontal_res = static_cast<uint32_t>((max_azimuth - min_azimuth) / horizontal_bins);
+  // each ring only reads its own indices and writes its own outputs and frequency row
+  frequency_table_.assign(static_cast<std::size_t>(vertical_bins) * horizontal_bins, 0U);
+  const int num_rings = static_cast<int>(vertical_bins);
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+  for (int ring = 0; ring < num_rings; ++ring) {
+    filterWeakFirstRing(
+      *cloud, weak_first_ring_indices_[ring], azimuth_range, weak_first_ring_outputs_[ring],
+      &frequency_table_[static_cast<std::size_t>(ring) * horizontal_bins]);
+    filterRing(*cloud, ring_indices_[ring], ring_outputs_[ring]);
+  }
 
-  pcl::PointCloud<PointXYZIRADRT>::Ptr pcl_output(new pcl::PointCloud<PointXYZIRADRT>);
-  pcl_output->points.reserve(pcl_input->points.size());
+  // Threshold for diagnostics (tunable)
+  const auto num_pixels = std::count_if(
+    frequency_table_.begin(), frequency_table_.end(),
+    [this](const uint8_t frequency) { return frequency >= weak_first_local_noise_threshold_; });
+  float filled =
+    static_cast<float>(num_pixels) / static_cast<float>(vertical_bins * horizontal_bins);
+  visibility_ = 1.0f - filled;
+  // Visualization of histogram, rendered only on demand
+  if (image_pub_.getNumSubscribers() > 0) {
+    const cv::Mat frequency_image(
+      cv::Size(horizontal_bins, vertical_bins), CV_8UC1, frequency_table_.data());
+    cv::Mat frequency_image_colorized;
+    // Multiply bins by four to get pretty colours
+    cv::applyColorMap(frequency_image * 4, frequency_image_colorized, cv::COLORMAP_JET);
+    sensor_msgs::msg::Image::SharedPtr frequency_image_msg =
+      cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", frequency_image_colorized).toImageMsg();
+    frequency_image_msg->header = input->header;
+    // Publish histogram image
+    image_pub_.publish(frequency_image_msg);
+  }
+  tier4_debug_msgs::msg::Float32Stamped visibility_msg;
+  visibility_msg.data = (1.0f - filled);
+  visibility_msg.stamp = now();
+  visibility_pub_->publish(visibility_msg);
 
-  std::vector<pcl::PointCloud<PointXYZIRADRT>> pcl_input_ring_array;
-  std::vector<pcl::PointCloud<PointXYZIRADRT>> weak_first_pcl_input_ring_array;
+  // Publish noise points
+  if (
+    noise_cloud_pub_->get_subscription_count() +
+      noise_cloud_pub_->get_intra_process_subscription_count() >
+    0) {
+    auto noise_output_msg = std::make_unique<sensor_msgs::msg::PointCloud2>();
+    copyPoints(*cloud, &RingOutput::noise, *noise_output_msg);
+    noise_output_msg->header = input->header;
+    noise_cloud_pub_->publish(std::move(noise_output_msg));
+  }
 
-  pcl::PointCloud<PointXYZIRADRT>::Ptr noise_output(new pcl::PointCloud<PointXYZIRADRT>);
-  noise_output->points.reserve(pcl_input->points.size());
-  pcl_input_ring_array.resize(
-    vertical_bins);  // TODO(davidw): this is for Pandar 40 only, make dynamic
-  weak_first_pcl_input_ring_array.resize(vertical_bins);
+  // Publish filtered pointcloud
+  copyPoints(*cloud, &RingOutput::kept, output);
+  output.header = input->header;
+}
 
-  // Split into 36 x 10 degree bins x 40 lines (TODO: change to dynamic)
-  for (const auto & p : pcl_input->points) {
-    if (p.return_type == ReturnType::DUAL_WEAK_FIRST) {
-      weak_first_pcl_input_ring_array.at(p.ring).push_back(p);
-    } else {
-      pcl_input_ring_array.at(p.ring).push_back(p);
+void DualReturnOutlierFilterComponent::copyPoints(
+  const PointCloud2 & cloud, std::vector<std::size_t> RingOutput::*points,
+  PointCloud2 & output) const
+{
+  // the weak first survivors come first, as in the serial implementation
+  std::size_t num_points = 0U;
+  for (const auto * ring_outputs : {&weak_first_ring_outputs_, &ring_outputs_}) {
+    for (const auto & ring_output : *ring_outputs) {
+      num_points += (ring_output.*points).size();
     }
   }
+  output.height = 1;
+  output.width = static_cast<uint32_t>(num_points);
+  output.fields = cloud.fields;
+  output.is_bigendian = false;
+  output.point_step = cloud.point_step;
+  output.row_step = output.point_step * output.width;
+  output.is_dense = true;
+  output.data.resize(static_cast<std::size_t>(output.row_step));
+  auto * output_ptr = output.data.data();
+  for (const auto * ring_outputs : {&weak_first_ring_outputs_, &ring_outputs_}) {
+    for (const auto & ring_output : *ring_outputs) {
+      for (const auto & idx : ring_output.*points) {
+        std::memcpy(output_ptr, &cloud.data[idx], cloud.point_step);
+        output_ptr += cloud.point_step;
+      }
+    }
+  }
+}
 
-  float max_azimuth_diff = max_azimuth_diff_;
-  cv::Mat frequency_image(cv::Size(horizontal_bins, vertical_bins), CV_8UC1, cv::Scalar(0));
-
-  for (const auto & weak_first_single_ring : weak_first_pcl_input_ring_array) {
-    if (weak_first_single_ring.points.size() < 2) {
+void DualReturnOutlierFilterComponent::filterWeakFirstRing(
+  const PointCloud2 & input, const std::vector<std::size_t> & ring_indices,
+  const AzimuthRange & azimuth_range, RingOutput & ring_output, uint8_t * frequency_row) const
+{
+  ring_output.kept.clear();
+  ring_output.noise.clear();
+  if (ring_indices.size() < 2) {
+    return;
+  }
+  const auto point_at = [&input](const std::size_t idx) {
+    return reinterpret_cast<const PointXYZIRADRT *>(&input.data[idx]);
+  };
+  const float min_azimuth = azimuth_range.min_azimuth;
+  const float max_azimuth = azimuth_range.max_azimuth;
+  const uint32_t horizontal_res = azimuth_range.horizontal_res;
+
+  auto & deleted_azimuths = ring_output.deleted_azimuths;
+  auto & temp_segment = ring_output.temp_segment;
+  deleted_azimuths.clear();
+  temp_segment.clear();
+  const auto segment_azimuth = [&](const std::size_t segment_index) {
+    const float azimuth = point_at(temp_segment[segment_index])->azimuth;
+    return azimuth < 0.f ? 0.f : azimuth;
+  };
+
+  bool keep_next = false;
+  for (std::size_t k = 1; k < ring_indices.size() - 1; ++k) {
+    const auto * iter = point_at(ring_indices[k]);
+    const auto * next = point_at(ring_indices[k + 1]);
+    const float min_dist = std::min(iter->distance, next->distance);
+    const float max_dist = std::max(iter->distance, next->distance);
+    float azimuth_diff = next->azimuth - iter->azimuth;
+    azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
+
+    if (max_dist < min_dist * weak_first_distance_ratio_ && azimuth_diff < max_azimuth_diff_) {
+      temp_segment.push_back(ring_indices[k]);
+      keep_next = true;
+    } else if (keep_next) {
+      temp_segment.push_back(ring_indices[k]);
+      keep_next = false;
+      // Analyse segment points here
+    } else {
+      // Log the deleted azimuth for analysis
+      bool is_noise = false;
+      switch (azimuth_range.roi_mode) {
+        case 1:  // base_link xyz-ROI
+        {
+          is_noise = iter->x > x_min_ && iter->x < x_max_ && iter->y > y_min_ &&
+                     iter->y < y_max_ && iter->z > z_min_ && iter->z < z_max_;
+          break;
+        }
+        case 2: {
+          is_noise = iter->azimuth > min_azimuth && iter->azimuth < max_azimuth &&
+                     iter->distance < max_distance_;
+          break;
+        }
+        default: {
+          is_noise = true;
+          break;
+        }
+      }
+      if (is_noise) {
+        deleted_azimuths.push_back(iter->azimuth < 0.f ? 0.f : iter->azimuth);
+        ring_output.noise.push_back(ring_indices[k]);
+      }
+    }
+  }
+  // Analyse last segment points here
+  if (deleted_azimuths.empty()) {
+    return;
+  }
+  const uint32_t horizontal_bins = 36;
+  std::vector<int> noise_frequency(horizontal_bins, 0);
+  std::size_t current_deleted_index = 0;
+  std::size_t current_temp_segment_index = 0;
+  for (uint32_t i = 0; i < noise_frequency.size() - 1; i++) {
+    const uint32_t bin_end =
+      (i + static_cast<uint32_t>(min_azimuth / horizontal_res) + 1) * horizontal_res;
+    while (static_cast<uint32_t>(deleted_azimuths[current_deleted_index]) < bin_end &&
+           current_deleted_index < (deleted_azimuths.size() - 1)) {
+      noise_frequency[i] = noise_frequency[i] + 1;
+      current_deleted_index++;
+    }
+    if (temp_segment.empty()) {
       continue;
     }
-    std::vector<float> deleted_azimuths;
-    std::vector<float> deleted_distances;
-    pcl::PointCloud<PointXYZIRADRT> temp_segment;
-
-    bool keep_next = false;
-    uint ring_id = weak_first_single_ring.points.front().ring;
-    for (auto iter = std::begin(weak_first_single_ring) + 1;
-         iter != std::end(weak_first_single_ring) - 1; ++iter) {
-      const float min_dist = std::min(iter->distance, (iter + 1)->distance);
-      const float max_dist = std::max(iter->distance, (iter + 1)->distance);
-      float azimuth_diff = (iter + 1)->azimuth - iter->azimuth;
-      azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
-
-      if (max_dist < min_dist * weak_first_distance_ratio_ && azimuth_diff < max_azimuth_diff) {
-        temp_segment.points.push_back(*iter);
-        keep_next = true;
-      } else if (keep_next) {
-        temp_segment.points.push_back(*iter);
-        keep_next = false;
-        // Analyse segment points here
+    while (current_temp_segment_index < (temp_segment.size() - 1) &&
+           segment_azimuth(current_temp_segment_index) < bin_end) {
+      const auto * point = point_at(temp_segment[current_temp_segment_index]);
+      if (noise_frequency[i] < weak_first_local_noise_threshold_) {
+        ring_output.kept.push_back(temp_segment[current_temp_segment_index]);
       } else {
-        // Log the deleted azimuth and its distance for analysis
-        switch (roi_mode_map_[roi_mode_]) {
-          case 1:  // base_link xyz-ROI
-          {
-            if (
-              iter->x > x_min_ && iter->x < x_max_ && iter->y > y_min_ && iter->y < y_max_ &&
-              iter->z > z_min_ && iter->z < z_max_) {
-              deleted_azimuths.push_back(iter->azimuth < 0.f ? 0.f : iter->azimuth);
-              deleted_distances.push_back(iter->distance);
-              noise_output->points.push_back(*iter);
-            }
+        bool is_noise = false;
+        switch (azimuth_range.roi_mode) {
+          case 1: {
+            is_noise = point->x < x_max_ && point->x > x_min_ && point->y > y_max_ &&
+                       point->y < y_min_ && point->z < z_max_ && point->z > z_min_;
             break;
           }
           case 2: {
-            if (
-              iter->azimuth > min_azimuth && iter->azimuth < max_azimuth &&
-              iter->distance < max_distance_) {
-              deleted_azimuths.push_back(iter->azimuth < 0.f ? 0.f : iter->azimuth);
-              noise_output->points.push_back(*iter);
-              deleted_distances.push_back(iter->distance);
-            }
+            is_noise = point->azimuth < max_azimuth && point->azimuth > min_azimuth &&
+                       point->distance < max_distance_;
             break;
           }
           default: {
-            deleted_azimuths.push_back(iter->azimuth < 0.f ? 0.f : iter->azimuth);
-            deleted_distances.push_back(iter->distance);
-            noise_output->points.push_back(*iter);
+            is_noise = true;
             break;
           }
         }
-      }
-    }
-    // Analyse last segment points here
-    std::vector<int> noise_frequency(horizontal_bins, 0);
-    uint current_deleted_index = 0;
-    uint current_temp_segment_index = 0;
-    for (uint i = 0; i < noise_frequency.size() - 1; i++) {
-      if (deleted_azimuths.size() == 0) {
-        continue;
-      }
-      while ((uint)deleted_azimuths[current_deleted_index] <
-               ((i + static_cast<uint>(min_azimuth / horizontal_res) + 1) * horizontal_res) &&
-             current_deleted_index < (deleted_azimuths.size() - 1)) {
-        noise_frequency[i] = noise_frequency[i] + 1;
-        current_deleted_index++;
-      }
-      if (temp_segment.points.size() > 0) {
-        while ((temp_segment.points[current_temp_segment_index].azimuth < 0.f
-                  ? 0.f
-                  : temp_segment.points[current_temp_segment_index].azimuth) <
-                 ((i + 1 + static_cast<uint>(min_azimuth / horizontal_res)) * horizontal_res) &&
-               current_temp_segment_index < (temp_segment.points.size() - 1)) {
-          if (noise_frequency[i] < weak_first_local_noise_threshold_) {
-            pcl_output->points.push_back(temp_segment.points[current_temp_segment_index]);
-          } else {
-            switch (roi_mode_map_[roi_mode_]) {
-              case 1: {
-                if (
-                  temp_segment.points[current_temp_segment_index].x < x_max_ &&
-                  temp_segment.points[current_temp_segment_index].x > x_min_ &&
-                  temp_segment.points[current_temp_segment_index].y > y_max_ &&
-                  temp_segment.points[current_temp_segment_index].y < y_min_ &&
-                  temp_segment.points[current_temp_segment_index].z < z_max_ &&
-                  temp_segment.points[current_temp_segment_index].z > z_min_) {
-                  noise_frequency[i] = noise_frequency[i] + 1;
-                  noise_output->points.push_back(temp_segment.points[current_temp_segment_index]);
-                }
-                break;
-              }
-              case 2: {
-                if (
-                  temp_segment.points[current_temp_segment_index].azimuth < max_azimuth &&
-                  temp_segment.points[current_temp_segment_index].azimuth > min_azimuth &&
-                  temp_segment.points[current_temp_segment_index].distance < max_distance_) {
-                  noise_frequency[i] = noise_frequency[i] + 1;
-                  noise_output->points.push_back(temp_segment.points[current_temp_segment_index]);
-                }
-                break;
-              }
-              default: {
-                noise_frequency[i] = noise_frequency[i] + 1;
-                noise_output->points.push_back(temp_segment.points[current_temp_segment_index]);
-                break;
-              }
-            }
-          }
-          current_temp_segment_index++;
-          frequency_image.at<uchar>(ring_id, i) = noise_frequency[i];
+        if (is_noise) {
+          noise_frequency[i] = noise_frequency[i] + 1;
+          ring_output.noise.push_back(temp_segment[current_temp_segment_index]);
         }
       }
+      current_temp_segment_index++;
+      frequency_row[i] = static_cast<uint8_t>(noise_frequency[i]);
     }
   }
+}
 
-  // Ring outlier filter for normal points
-  for (const auto & input_ring : pcl_input_ring_array) {
-    if (input_ring.size() < 2) {
-      continue;
-    }
-    pcl::PointCloud<PointXYZIRADRT> temp_segment;
-    bool keep_next = false;
-    // uint ring_id = input_ring.points.front().ring;
-    for (auto iter = std::begin(input_ring) + 1; iter != std::end(input_ring) - 1; ++iter) {
-      const float min_dist = std::min(iter->distance, (iter + 1)->distance);
-      const float max_dist = std::max(iter->distance, (iter + 1)->distance);
-      float azimuth_diff = (iter + 1)->azimuth - iter->azimuth;
-      azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
-
-      if (max_dist < min_dist * general_distance_ratio_ && azimuth_diff < max_azimuth_diff) {
-        temp_segment.points.push_back(*iter);
-        keep_next = true;
-      } else if (keep_next) {
-        temp_segment.points.push_back(*iter);
-        keep_next = false;
-        // Analyse segment points here
-      } else {
-        // Log the deleted azimuth and its distance for analysis
-        // deleted_azimuths.push_back(iter->azimuth < 0.f ? 0.f : iter->azimuth);
-        // deleted_distances.push_back(iter->distance);
-        noise_output->points.push_back(*iter);
-      }
-    }
-    for (const auto & tmp_p : temp_segment.points) {
-      pcl_output->points.push_back(tmp_p);
-    }
+void DualReturnOutlierFilterComponent::filterRing(
+  const PointCloud2 & input, const std::vector<std::size_t> & ring_indices,
+  RingOutput & ring_output) const
+{
+  ring_output.kept.clear();
+  ring_output.noise.clear();
+  if (ring_indices.size() < 2) {
+    return;
   }
 
-  // Threshold for diagnostics (tunable)
-  cv::Mat binary_image;
-  cv::inRange(frequency_image, weak_first_local_noise_threshold_, 255, binary_image);
-  int num_pixels = cv::countNonZero(binary_image);
-  float filled =
-    static_cast<float>(num_pixels) / static_cast<float>(vertical_bins * horizontal_bins);
-  visibility_ = 1.0f - filled;
-  // Visualization of histogram
-  cv::Mat frequency_image_colorized;
-  // Multiply bins by four to get pretty colours
-  cv::applyColorMap(frequency_image * 4, frequency_image_colorized, cv::COLORMAP_JET);
-  sensor_msgs::msg::Image::SharedPtr frequency_image_msg =
-    cv_bridge::CvImage(std_msgs::msg::Header(), "bgr8", frequency_image_colorized).toImageMsg();
-  frequency_image_msg->header = input->header;
-  // Publish histogram image
-  image_pub_.publish(frequency_image_msg);
-  tier4_debug_msgs::msg::Float32Stamped visibility_msg;
-  visibility_msg.data = (1.0f - filled);
-  visibility_msg.stamp = now();
-  visibility_pub_->publish(visibility_msg);
-
-  // Publish noise points
-  sensor_msgs::msg::PointCloud2 noise_output_msg;
-  pcl::toROSMsg(*noise_output, noise_output_msg);
-  noise_output_msg.header = input->header;
-  noise_cloud_pub_->publish(noise_output_msg);
-
-  // Publish filtered pointcloud
-  pcl::toROSMsg(*pcl_output, output);
-  output.header = input->header;
+  bool keep_next = false;
+  for (std::size_t k = 1; k < ring_indices.size() - 1; ++k) {
+    const auto * iter = reinterpret_cast<const PointXYZIRADRT *>(&input.data[ring_indices[k]]);
+    const auto * next =
+      reinterpret_cast<const PointXYZIRADRT *>(&input.data[ring_indices[k + 1]]);
+    const float min_dist = std::min(iter->distance, next->distance);
+    const float max_dist = std::max(iter->distance, next->distance);
+    float azimuth_diff = next->azimuth - iter->azimuth;
+    azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
+
+    if (max_dist < min_dist * general_distance_ratio_ && azimuth_diff < max_azimuth_diff_) {
+      ring_output.kept.push_back(ring_indices[k]);
+      keep_next = true;
+    } else if (keep_next) {
+      ring_output.kept.push_back(ring_indices[k]);
+      keep_next = false;
+    } else {
+      ring_output.noise.push_back(ring_indices[k]);
+    }
+  }
 }
 
 rcl_interfaces::msg::SetParametersResult DualReturnOutlierFilterComponent::paramCallback(
@@ -370,6 +455,10 @@ rcl_interfaces::msg::SetParametersResult DualReturnOutlierFilterComponent::param
   if (get_param(p, "max_azimuth_diff", max_azimuth_diff_)) {
     RCLCPP_DEBUG(get_logger(), "Setting new max_azimuth_diff to: %f.", max_azimuth_diff_);
   }
+  if (get_param(p, "num_threads", num_threads_)) {
+    num_threads_ = std::max(num_threads_, 1);
+    RCLCPP_DEBUG(get_logger(), "Setting new num_threads to: %d.", num_threads_);
+  }
 
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
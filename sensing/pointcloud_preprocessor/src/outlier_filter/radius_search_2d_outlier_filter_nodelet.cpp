@@ -18,10 +18,19 @@
 #include <pcl/search/kdtree.h>
 #include <pcl/segmentation/segment_differences.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 namespace pointcloud_preprocessor
 {
+namespace
+{
+// keeps the cell array of a sparse cloud with far outliers within a few tens of MB
+constexpr std::size_t max_grid_cells = std::size_t{1} << 22;
+}  // namespace
+
 RadiusSearch2DOutlierFilterComponent::RadiusSearch2DOutlierFilterComponent(
   const rclcpp::NodeOptions & options)
 : Filter("RadiusSearch2DOutlierFilter", options)
@@ -30,6 +39,7 @@ RadiusSearch2DOutlierFilterComponent::RadiusSearch2DOutlierFilterComponent(
   {
     min_neighbors_ = static_cast<size_t>(declare_parameter("min_neighbors", 5));
     search_radius_ = static_cast<double>(declare_parameter("search_radius", 0.2));
+    use_grid_ = static_cast<bool>(declare_parameter("use_grid", false));
   }
 
   kd_tree_ = pcl::make_shared<pcl::search::KdTree<pcl::PointXY>>(false);
@@ -47,25 +57,129 @@ void RadiusSearch2DOutlierFilterComponent::filter(
   pcl::PointCloud<pcl::PointXYZ>::Ptr xyz_cloud(new pcl::PointCloud<pcl::PointXYZ>);
   pcl::fromROSMsg(*input, *xyz_cloud);
 
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
+  if (!use_grid_ || !filterByGrid(*xyz_cloud, *pcl_output)) {
+    filterByKdTree(*xyz_cloud, *pcl_output);
+  }
+  pcl::toROSMsg(*pcl_output, output);
+  output.header = input->header;
+}
+
+void RadiusSearch2DOutlierFilterComponent::filterByKdTree(
+  const pcl::PointCloud<pcl::PointXYZ> & xyz_cloud, pcl::PointCloud<pcl::PointXYZ> & pcl_output)
+{
   pcl::PointCloud<pcl::PointXY>::Ptr xy_cloud(new pcl::PointCloud<pcl::PointXY>);
-  xy_cloud->points.resize(xyz_cloud->points.size());
-  for (size_t i = 0; i < xyz_cloud->points.size(); ++i) {
-    xy_cloud->points[i].x = xyz_cloud->points[i].x;
-    xy_cloud->points[i].y = xyz_cloud->points[i].y;
+  xy_cloud->points.resize(xyz_cloud.points.size());
+  for (size_t i = 0; i < xyz_cloud.points.size(); ++i) {
+    xy_cloud->points[i].x = xyz_cloud.points[i].x;
+    xy_cloud->points[i].y = xyz_cloud.points[i].y;
   }
 
   std::vector<int> k_indices(xy_cloud->points.size());
   std::vector<float> k_sqr_distances(xy_cloud->points.size());
   kd_tree_->setInputCloud(xy_cloud);
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
   for (size_t i = 0; i < xy_cloud->points.size(); ++i) {
     size_t k = kd_tree_->radiusSearch(i, search_radius_, k_indices, k_sqr_distances);
     if (k >= min_neighbors_) {
-      pcl_output->points.push_back(xyz_cloud->points.at(i));
+      pcl_output.points.push_back(xyz_cloud.points.at(i));
     }
   }
-  pcl::toROSMsg(*pcl_output, output);
-  output.header = input->header;
+}
+
+bool RadiusSearch2DOutlierFilterComponent::filterByGrid(
+  const pcl::PointCloud<pcl::PointXYZ> & xyz_cloud, pcl::PointCloud<pcl::PointXYZ> & pcl_output)
+{
+  const auto & points = xyz_cloud.points;
+  float min_x = std::numeric_limits<float>::max();
+  float min_y = std::numeric_limits<float>::max();
+  float max_x = std::numeric_limits<float>::lowest();
+  float max_y = std::numeric_limits<float>::lowest();
+  for (const auto & p : points) {
+    if (std::isfinite(p.x) && std::isfinite(p.y)) {
+      min_x = std::min(min_x, p.x);
+      min_y = std::min(min_y, p.y);
+      max_x = std::max(max_x, p.x);
+      max_y = std::max(max_y, p.y);
+    }
+  }
+  if (min_x > max_x) {
+    return true;
+  }
+
+  const float inverse_cell_size = 1.0f / static_cast<float>(search_radius_);
+  const double num_cells_x = std::floor((max_x - min_x) * inverse_cell_size) + 1.0;
+  const double num_cells_y = std::floor((max_y - min_y) * inverse_cell_size) + 1.0;
+  if (num_cells_x * num_cells_y > static_cast<double>(max_grid_cells)) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 5000,
+      "Grid of %.0f x %.0f cells is too large for search_radius %f, using the kd-tree instead.",
+      num_cells_x, num_cells_y, search_radius_);
+    return false;
+  }
+  const auto width = static_cast<uint32_t>(num_cells_x);
+  const auto height = static_cast<uint32_t>(num_cells_y);
+  const auto cell_of = [&](const float v, const float min_v, const uint32_t size) {
+    return std::min(static_cast<uint32_t>((v - min_v) * inverse_cell_size), size - 1);
+  };
+
+  // counting sort of the point indices by cell, invalid points get no cell
+  const uint32_t invalid_cell = std::numeric_limits<uint32_t>::max();
+  grid_point_cells_.resize(points.size());
+  grid_cell_starts_.assign(static_cast<std::size_t>(width) * height + 1, 0U);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const auto & p = points[i];
+    if (!std::isfinite(p.x) || !std::isfinite(p.y)) {
+      grid_point_cells_[i] = invalid_cell;
+      continue;
+    }
+    grid_point_cells_[i] = cell_of(p.y, min_y, height) * width + cell_of(p.x, min_x, width);
+    ++grid_cell_starts_[grid_point_cells_[i] + 1];
+  }
+  for (std::size_t c = 1; c < grid_cell_starts_.size(); ++c) {
+    grid_cell_starts_[c] += grid_cell_starts_[c - 1];
+  }
+  grid_cell_points_.resize(grid_cell_starts_.back());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    if (grid_point_cells_[i] != invalid_cell) {
+      // the starts are shifted by one cell here, and end up at the cell starts again
+      grid_cell_points_[grid_cell_starts_[grid_point_cells_[i]]++] = static_cast<uint32_t>(i);
+    }
+  }
+  std::rotate(
+    grid_cell_starts_.rbegin(), grid_cell_starts_.rbegin() + 1, grid_cell_starts_.rend());
+  grid_cell_starts_.front() = 0U;
+
+  // as with the kd-tree, the point itself is counted as a neighbor
+  const float sqr_radius = static_cast<float>(search_radius_ * search_radius_);
+  const auto has_enough_neighbors = [&](const pcl::PointXYZ & p, const uint32_t cell) {
+    const uint32_t cx = cell % width;
+    const uint32_t cy = cell / width;
+    std::size_t num_neighbors = 0U;
+    for (uint32_t y = cy > 0 ? cy - 1 : 0; y <= std::min(cy + 1, height - 1); ++y) {
+      for (uint32_t x = cx > 0 ? cx - 1 : 0; x <= std::min(cx + 1, width - 1); ++x) {
+        const uint32_t neighbor_cell = y * width + x;
+        for (uint32_t k = grid_cell_starts_[neighbor_cell];
+             k < grid_cell_starts_[neighbor_cell + 1]; ++k) {
+          const auto & q = points[grid_cell_points_[k]];
+          const float dx = q.x - p.x;
+          const float dy = q.y - p.y;
+          if (dx * dx + dy * dy <= sqr_radius && ++num_neighbors >= min_neighbors_) {
+            return true;
+          }
+        }
+      }
+    }
+    return num_neighbors >= min_neighbors_;
+  };
+
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    if (
+      grid_point_cells_[i] != invalid_cell &&
+      has_enough_neighbors(points[i], grid_point_cells_[i])) {
+      pcl_output.points.push_back(points[i]);
+    }
+  }
+  return true;
 }
 
 rcl_interfaces::msg::SetParametersResult RadiusSearch2DOutlierFilterComponent::paramCallback(
@@ -79,6 +193,9 @@ rcl_interfaces::msg::SetParametersResult RadiusSearch2DOutlierFilterComponent::p
   if (get_param(p, "search_radius", search_radius_)) {
     RCLCPP_DEBUG(get_logger(), "Setting new search radius to: %f.", search_radius_);
   }
+  if (get_param(p, "use_grid", use_grid_)) {
+    RCLCPP_DEBUG(get_logger(), "Setting new use_grid to: %d.", use_grid_);
+  }
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
   result.reason = "success";
@@ -15,7 +15,9 @@
 #include "pointcloud_preprocessor/outlier_filter/ring_outlier_filter_nodelet.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <vector>
+
 namespace pointcloud_preprocessor
 {
 RingOutlierFilterComponent::RingOutlierFilterComponent(const rclcpp::NodeOptions & options)
@@ -37,8 +39,12 @@ RingOutlierFilterComponent::RingOutlierFilterComponent(const rclcpp::NodeOptions
     object_length_threshold_ =
       static_cast<double>(declare_parameter("object_length_threshold", 0.1));
     num_points_threshold_ = static_cast<int>(declare_parameter("num_points_threshold", 4));
+    num_rings_ = static_cast<int>(declare_parameter("num_rings", 128));
+    num_threads_ = std::max(static_cast<int>(declare_parameter("num_threads", 1)), 1);
   }
 
+  ring_indices_.resize(static_cast<std::size_t>(std::max(num_rings_, 1)));
+
   using std::placeholders::_1;
   set_param_res_ = this->add_on_set_parameters_callback(
     std::bind(&RingOutlierFilterComponent::paramCallback, this, _1));
@@ -50,84 +56,111 @@ void RingOutlierFilterComponent::filter(
 {
   std::scoped_lock lock(mutex_);
   stop_watch_ptr_->toc("processing_time", true);
-  std::unordered_map<uint16_t, std::vector<std::size_t>> input_ring_map;
-  input_ring_map.reserve(128);
-  sensor_msgs::msg::PointCloud2::SharedPtr input_ptr =
-    std::make_shared<sensor_msgs::msg::PointCloud2>(*input);
 
+  // bucket point offsets by ring without copying the input; the buckets keep their capacity
+  for (auto & ring_indices : ring_indices_) {
+    ring_indices.clear();
+  }
   const auto ring_offset =
     input->fields.at(static_cast<size_t>(autoware_point_types::PointIndex::Ring)).offset;
-  for (std::size_t idx = 0U; idx < input_ptr->data.size(); idx += input_ptr->point_step) {
-    input_ring_map[*reinterpret_cast<uint16_t *>(&input_ptr->data[idx + ring_offset])].push_back(
-      idx);
+  for (std::size_t idx = 0U; idx < input->data.size(); idx += input->point_step) {
+    const auto ring = *reinterpret_cast<const uint16_t *>(&input->data[idx + ring_offset]);
+    if (ring >= ring_indices_.size()) {
+      RCLCPP_WARN_THROTTLE(
+        get_logger(), *get_clock(), 5000,
+        "Ring id %u exceeds num_rings (%d). Growing the ring index table.", ring, num_rings_);
+      ring_indices_.resize(ring + 1U);
+    }
+    ring_indices_[ring].push_back(idx);
   }
+  ring_outputs_.resize(ring_indices_.size());
 
+  // each ring only reads its own indices and writes its own output chunk
+  const int num_rings = static_cast<int>(ring_indices_.size());
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads_)
+  for (int ring = 0; ring < num_rings; ++ring) {
+    filterRing(input, ring_indices_[ring], ring_outputs_[ring]);
+  }
+
+  // survivors are written straight into the output buffer in ring order
+  std::size_t output_size = 0U;
+  for (const auto & ring_output : ring_outputs_) {
+    output_size += ring_output.size();
+  }
   PointCloud2Modifier<PointXYZI> output_modifier{output, input->header.frame_id};
-  output_modifier.reserve(input->width);
+  output_modifier.resize(output_size);
+  auto * output_ptr = reinterpret_cast<PointXYZI *>(output.data.data());
+  for (const auto & ring_output : ring_outputs_) {
+    for (const auto & idx : ring_output) {
+      std::memcpy(output_ptr++, &input->data[idx], sizeof(PointXYZI));
+    }
+  }
+
+  // add processing time for debug
+  if (debug_publisher_) {
+    const double cyclic_time_ms = stop_watch_ptr_->toc("cyclic_time", true);
+    const double processing_time_ms = stop_watch_ptr_->toc("processing_time", true);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/cyclic_time_ms", cyclic_time_ms);
+    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
+      "debug/processing_time_ms", processing_time_ms);
+  }
+}
 
-  std::vector<std::size_t> tmp_indices;
-  tmp_indices.reserve(input->width);
+void RingOutlierFilterComponent::filterRing(
+  const PointCloud2ConstPtr & input, const std::vector<std::size_t> & ring_indices,
+  std::vector<std::size_t> & ring_output) const
+{
+  ring_output.clear();
+  if (ring_indices.size() < 2) {
+    return;
+  }
 
   const auto azimuth_offset =
     input->fields.at(static_cast<size_t>(autoware_point_types::PointIndex::Azimuth)).offset;
   const auto distance_offset =
     input->fields.at(static_cast<size_t>(autoware_point_types::PointIndex::Distance)).offset;
-  for (const auto & ring_indices : input_ring_map) {
-    if (ring_indices.second.size() < 2) {
-      continue;
-    }
 
-    for (size_t idx = 0U; idx < ring_indices.second.size() - 1; ++idx) {
-      const auto & current_idx = ring_indices.second.at(idx);
-      const auto & next_idx = ring_indices.second.at(idx + 1);
-      tmp_indices.emplace_back(current_idx);
-
-      // if(std::abs(iter->distance - (iter+1)->distance) <= std::sqrt(iter->distance) * 0.08)
-      const auto current_pt_azimuth =
-        *reinterpret_cast<float *>(&input_ptr->data[current_idx + azimuth_offset]);
-      const auto next_pt_azimuth =
-        *reinterpret_cast<float *>(&input_ptr->data[next_idx + azimuth_offset]);
-      float azimuth_diff = next_pt_azimuth - current_pt_azimuth;
-      azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
-
-      const auto current_pt_distance =
-        *reinterpret_cast<float *>(&input_ptr->data[current_idx + distance_offset]);
-      const auto next_pt_distance =
-        *reinterpret_cast<float *>(&input_ptr->data[next_idx + distance_offset]);
-
-      if (
-        std::max(current_pt_distance, next_pt_distance) <
-          std::min(current_pt_distance, next_pt_distance) * distance_ratio_ &&
-        azimuth_diff < 100.f) {
-        continue;
-      }
-      if (isCluster(input_ptr, tmp_indices)) {
-        for (const auto & tmp_idx : tmp_indices) {
-          output_modifier.push_back(
-            std::move(*reinterpret_cast<PointXYZI *>(&input_ptr->data[tmp_idx])));
-        }
-      }
-      tmp_indices.clear();
+  // a walk is the run [walk_begin, walk_end] of consecutive continuous points in the ring
+  const auto push_walk = [&](const std::size_t walk_begin, const std::size_t walk_end) {
+    if (isCluster(
+          input, ring_indices[walk_begin], ring_indices[walk_end], walk_end - walk_begin + 1)) {
+      ring_output.insert(
+        ring_output.end(), ring_indices.begin() + walk_begin,
+        ring_indices.begin() + walk_end + 1);
     }
-    if (tmp_indices.empty()) {
+  };
+
+  std::size_t walk_begin = 0U;
+  for (size_t idx = 0U; idx < ring_indices.size() - 1; ++idx) {
+    const auto & current_idx = ring_indices[idx];
+    const auto & next_idx = ring_indices[idx + 1];
+
+    // if(std::abs(iter->distance - (iter+1)->distance) <= std::sqrt(iter->distance) * 0.08)
+    const auto current_pt_azimuth =
+      *reinterpret_cast<const float *>(&input->data[current_idx + azimuth_offset]);
+    const auto next_pt_azimuth =
+      *reinterpret_cast<const float *>(&input->data[next_idx + azimuth_offset]);
+    float azimuth_diff = next_pt_azimuth - current_pt_azimuth;
+    azimuth_diff = azimuth_diff < 0.f ? azimuth_diff + 36000.f : azimuth_diff;
+
+    const auto current_pt_distance =
+      *reinterpret_cast<const float *>(&input->data[current_idx + distance_offset]);
+    const auto next_pt_distance =
+      *reinterpret_cast<const float *>(&input->data[next_idx + distance_offset]);
+
+    if (
+      std::max(current_pt_distance, next_pt_distance) <
+        std::min(current_pt_distance, next_pt_distance) * distance_ratio_ &&
+      azimuth_diff < 100.f) {
       continue;
     }
-    if (isCluster(input_ptr, tmp_indices)) {
-      for (const auto & tmp_idx : tmp_indices) {
-        output_modifier.push_back(
-          std::move(*reinterpret_cast<PointXYZI *>(&input_ptr->data[tmp_idx])));
-      }
-    }
-    tmp_indices.clear();
+    push_walk(walk_begin, idx);
+    walk_begin = idx + 1;
   }
-  // add processing time for debug
-  if (debug_publisher_) {
-    const double cyclic_time_ms = stop_watch_ptr_->toc("cyclic_time", true);
-    const double processing_time_ms = stop_watch_ptr_->toc("processing_time", true);
-    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
-      "debug/cyclic_time_ms", cyclic_time_ms);
-    debug_publisher_->publish<tier4_debug_msgs::msg::Float64Stamped>(
-      "debug/processing_time_ms", processing_time_ms);
+  // the last point of the ring only closes the final walk, as in the serial implementation
+  if (walk_begin < ring_indices.size() - 1) {
+    push_walk(walk_begin, ring_indices.size() - 2);
   }
 }
 
@@ -146,6 +179,10 @@ rcl_interfaces::msg::SetParametersResult RingOutlierFilterComponent::paramCallba
   if (get_param(p, "num_points_threshold", num_points_threshold_)) {
     RCLCPP_DEBUG(get_logger(), "Setting new num_points_threshold to: %d.", num_points_threshold_);
   }
+  if (get_param(p, "num_threads", num_threads_)) {
+    num_threads_ = std::max(num_threads_, 1);
+    RCLCPP_DEBUG(get_logger(), "Setting new num_threads to: %d.", num_threads_);
+  }
 
   rcl_interfaces::msg::SetParametersResult result;
   result.successful = true;
@@ -14,6 +14,10 @@
 
 #include "pointcloud_preprocessor/pointcloud_accumulator/pointcloud_accumulator_nodelet.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace pointcloud_preprocessor
@@ -24,8 +28,7 @@ PointcloudAccumulatorComponent::PointcloudAccumulatorComponent(const rclcpp::Nod
   // set initial parameters
   {
     accumulation_time_sec_ = static_cast<double>(declare_parameter("accumulation_time_sec", 2.0));
-    pointcloud_buffer_.set_capacity(
-      static_cast<size_t>(declare_parameter("pointcloud_buffer_size", 50)));
+    setBufferSize(static_cast<size_t>(declare_parameter("pointcloud_buffer_size", 50)));
   }
 
   using std::placeholders::_1;
@@ -38,19 +41,104 @@ void PointcloudAccumulatorComponent::filter(
   PointCloud2 & output)
 {
   std::scoped_lock lock(mutex_);
-  pointcloud_buffer_.push_front(input);
-  rclcpp::Time last_time = input->header.stamp;
-  pcl::PointCloud<pcl::PointXYZ> pcl_input;
-  pcl::PointCloud<pcl::PointXYZ> pcl_output;
-  for (size_t i = 0; i < pointcloud_buffer_.size(); i++) {
-    if (accumulation_time_sec_ < (last_time - pointcloud_buffer_.at(i)->header.stamp).seconds()) {
+
+  // convert the cloud once into the slot of the oldest frame
+  const size_t frame_index = (newest_frame_index_ + 1) % frames_.size();
+  if (!writeFrame(*input, frames_.at(frame_index))) {
+    return;
+  }
+  newest_frame_index_ = frame_index;
+  num_frames_ = std::min(num_frames_ + 1, frames_.size());
+
+  // the frames within the accumulation time, newest first
+  const rclcpp::Time last_time = input->header.stamp;
+  size_t num_output_frames = 0;
+  size_t num_output_points = 0;
+  bool is_dense = true;
+  for (; num_output_frames < num_frames_; ++num_output_frames) {
+    const auto & frame =
+      frames_.at((newest_frame_index_ + frames_.size() - num_output_frames) % frames_.size());
+    if (accumulation_time_sec_ < (last_time - frame.stamp).seconds()) {
       break;
     }
-    pcl::fromROSMsg(*pointcloud_buffer_.at(i), pcl_input);
-    pcl_output += pcl_input;
+    num_output_points += frame.num_points;
+    is_dense = is_dense && frame.is_dense;
+  }
+
+  // the same x/y/z layout as pcl::PointXYZ, which the output used to be converted from
+  output.fields.resize(3);
+  const char * field_names[] = {"x", "y", "z"};
+  for (size_t i = 0; i < output.fields.size(); ++i) {
+    output.fields[i].name = field_names[i];
+    output.fields[i].offset = i * sizeof(float);
+    output.fields[i].datatype = sensor_msgs::msg::PointField::FLOAT32;
+    output.fields[i].count = 1;
   }
-  pcl::toROSMsg(pcl_output, output);
   output.header = input->header;
+  output.height = 1;
+  output.width = num_output_points;
+  output.point_step = sizeof(pcl::PointXYZ);
+  output.row_step = output.width * output.point_step;
+  output.is_bigendian = false;
+  output.is_dense = is_dense;
+  output.data.resize(output.row_step);
+
+  auto * output_ptr = output.data.data();
+  for (size_t i = 0; i < num_output_frames; ++i) {
+    const auto & frame = frames_.at((newest_frame_index_ + frames_.size() - i) % frames_.size());
+    const size_t frame_size = frame.num_points * output.point_step;
+    std::memcpy(output_ptr, frame.data.data(), frame_size);
+    output_ptr += frame_size;
+  }
+}
+
+bool PointcloudAccumulatorComponent::writeFrame(
+  const PointCloud2 & input, AccumulatedFrame & frame)
+{
+  const auto find_offset = [&input](const std::string & name) {
+    const auto it = std::find_if(input.fields.begin(), input.fields.end(), [&name](auto & field) {
+      return field.name == name;
+    });
+    return it == input.fields.end() ? -1 : static_cast<int>(it->offset);
+  };
+  const int x_offset = find_offset("x");
+  const int y_offset = find_offset("y");
+  const int z_offset = find_offset("z");
+  if (x_offset < 0 || y_offset < 0 || z_offset < 0) {
+    RCLCPP_ERROR(
+      this->get_logger(), "[writeFrame] Input cloud in %s has no x/y/z fields.",
+      input.header.frame_id.c_str());
+    return false;
+  }
+
+  const size_t num_points = input.width * input.height;
+  constexpr size_t point_step = sizeof(pcl::PointXYZ);
+  frame.stamp = input.header.stamp;
+  frame.num_points = num_points;
+  frame.is_dense = input.is_dense;
+  frame.data.resize(num_points * point_step);
+  for (size_t i = 0; i < num_points; ++i) {
+    const uint8_t * input_point = &input.data[i * input.point_step];
+    uint8_t * frame_point = &frame.data[i * point_step];
+    std::memcpy(frame_point, input_point + x_offset, sizeof(float));
+    std::memcpy(frame_point + sizeof(float), input_point + y_offset, sizeof(float));
+    std::memcpy(frame_point + 2 * sizeof(float), input_point + z_offset, sizeof(float));
+  }
+  return true;
+}
+
+void PointcloudAccumulatorComponent::setBufferSize(const size_t buffer_size)
+{
+  // keep the newest frames that fit in the new ring
+  std::vector<AccumulatedFrame> frames(std::max<size_t>(buffer_size, 1));
+  const size_t num_frames = std::min(num_frames_, frames.size());
+  for (size_t i = 0; i < num_frames; ++i) {
+    frames[num_frames - 1 - i] =
+      std::move(frames_.at((newest_frame_index_ + frames_.size() - i) % frames_.size()));
+  }
+  frames_ = std::move(frames);
+  newest_frame_index_ = num_frames == 0 ? frames_.size() - 1 : num_frames - 1;
+  num_frames_ = num_frames;
 }
 
 rcl_interfaces::msg::SetParametersResult PointcloudAccumulatorComponent::paramCallback(
@@ -63,7 +151,7 @@ rcl_interfaces::msg::SetParametersResult PointcloudAccumulatorComponent::paramCa
   }
   int pointcloud_buffer_size;
   if (get_param(p, "pointcloud_buffer_size", pointcloud_buffer_size)) {
-    pointcloud_buffer_.set_capacity((size_t)pointcloud_buffer_size);
+    setBufferSize(static_cast<size_t>(pointcloud_buffer_size));
     RCLCPP_DEBUG(get_logger(), "Setting new buffer size to: %d.", pointcloud_buffer_size);
   }
 
@@ -0,0 +1,354 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Replays the PointCloud2 frames of a bag through a chain of pointcloud components loaded in this
+// process, one frame at a time as fast as the chain processes them, and reports the latency and the
+// heap allocations of each component per frame.
+
+#include <ament_index_cpp/get_resource.hpp>
+#include <class_loader/class_loader.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <rclcpp/serialization.hpp>
+#include <rclcpp_components/node_factory.hpp>
+#include <rosbag2_cpp/reader.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <tf2_msgs/msg/tf_message.hpp>
+
+#include <tf2_ros/static_transform_broadcaster.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// heap allocations of the thread, which are the ones of the callbacks run by the executor of main
+struct AllocationCounter
+{
+  std::size_t count;
+  std::size_t bytes;
+};
+thread_local AllocationCounter allocation_counter{0, 0};
+
+void * countedMalloc(const std::size_t size)
+{
+  ++allocation_counter.count;
+  allocation_counter.bytes += size;
+  return std::malloc(size == 0 ? 1 : size);
+}
+}  // namespace
+
+// replaced for the whole process, so that the allocations of the loaded components are counted too
+void * operator new(std::size_t size)
+{
+  if (void * ptr = countedMalloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+void * operator new[](std::size_t size) { return ::operator new(size); }
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+  return countedMalloc(size);
+}
+void * operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+  return countedMalloc(size);
+}
+void operator delete(void * ptr) noexcept { std::free(ptr); }
+void operator delete[](void * ptr) noexcept { std::free(ptr); }
+void operator delete(void * ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void * ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+using sensor_msgs::msg::PointCloud2;
+using Clock = std::chrono::steady_clock;
+
+constexpr char topic_prefix[] = "/pointcloud_replay_benchmark";
+
+struct Stage
+{
+  std::string plugin_name;
+  std::string output_topic;
+  // declared before the node, which must be destroyed before its library is unloaded
+  std::shared_ptr<class_loader::ClassLoader> loader;
+  rclcpp_components::NodeInstanceWrapper node;
+  rclcpp::Subscription<PointCloud2>::SharedPtr output_sub;
+
+  // of the frame being processed
+  bool has_output{false};
+  Clock::time_point output_time;
+  AllocationCounter output_allocation{0, 0};
+
+  std::vector<double> latencies_ms;
+  std::vector<double> allocation_counts;
+  std::vector<double> allocation_bytes;
+  std::size_t dropped_frame_num{0};
+};
+
+/**
+ * @brief load the library of the component registered to rclcpp_components as plugin_name, e.g.
+ * "pointcloud_preprocessor::CropBoxFilterComponent", as the component container does
+ */
+std::shared_ptr<rclcpp_components::NodeFactory> createNodeFactory(
+  const std::string & plugin_name, std::shared_ptr<class_loader::ClassLoader> & loader)
+{
+  const std::string package_name = plugin_name.substr(0, plugin_name.find("::"));
+  std::string content;
+  std::string base_path;
+  if (!ament_index_cpp::get_resource("rclcpp_components", package_name, content, &base_path)) {
+    throw std::runtime_error("No components registered by the package " + package_name);
+  }
+
+  std::istringstream lines(content);
+  for (std::string line; std::getline(lines, line);) {
+    const auto separator = line.find(';');
+    if (separator == std::string::npos || line.substr(0, separator) != plugin_name) {
+      continue;
+    }
+    std::string library_path = line.substr(separator + 1);
+    if (library_path.empty() || library_path.front() != '/') {
+      library_path = base_path + "/" + library_path;
+    }
+
+    loader = std::make_shared<class_loader::ClassLoader>(library_path);
+    const std::string factory_name = "rclcpp_components::NodeFactoryTemplate<" + plugin_name + ">";
+    for (const auto & class_name : loader->getAvailableClasses<rclcpp_components::NodeFactory>()) {
+      if (class_name == plugin_name || class_name == factory_name) {
+        return loader->createInstance<rclcpp_components::NodeFactory>(class_name);
+      }
+    }
+  }
+  throw std::runtime_error("No component " + plugin_name + " in the package " + package_name);
+}
+
+double calcPercentile(std::vector<double> values, const double ratio)
+{
+  if (values.empty()) {
+    return 0.0;
+  }
+  std::sort(values.begin(), values.end());
+  const auto index = static_cast<std::size_t>(std::ceil(ratio * values.size()));
+  return values.at(std::min(std::max(index, std::size_t{1}), values.size()) - 1);
+}
+
+double calcMean(const std::vector<double> & values)
+{
+  return values.empty() ? 0.0
+                        : std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  rclcpp::init(argc, argv);
+
+  // the parameters of the components are given by the --params-file of the command line
+  auto node = rclcpp::Node::make_shared(
+    "pointcloud_replay_benchmark", rclcpp::NodeOptions().use_intra_process_comms(true));
+  const auto logger = node->get_logger();
+
+  const auto bag_path = node->declare_parameter<std::string>("bag_path");
+  const auto input_topic = node->declare_parameter<std::string>(
+    "input_topic", "/sensing/lidar/top/pointcloud_raw_ex");
+  const auto plugin_names = node->declare_parameter<std::vector<std::string>>("components");
+  const auto max_frame_num = node->declare_parameter<int>("max_frame_num", 0);
+  const auto warmup_frame_num = node->declare_parameter<int>("warmup_frame_num", 10);
+  const auto repeat_num = node->declare_parameter<int>("repeat_num", 1);
+  const auto timeout = std::chrono::duration_cast<Clock::duration>(
+    std::chrono::duration<double>(node->declare_parameter<double>("timeout_sec", 1.0)));
+  const auto use_intra_process = node->declare_parameter<bool>("use_intra_process", true);
+  const auto output_file = node->declare_parameter<std::string>("output_file", "");
+
+  // read all the frames beforehand, so that the chain is not slowed down by the bag
+  std::vector<PointCloud2> frames;
+  std::vector<geometry_msgs::msg::TransformStamped> static_transforms;
+  {
+    rosbag2_cpp::Reader reader;
+    reader.open(bag_path);
+    rosbag2_storage::StorageFilter filter;
+    filter.topics = {input_topic, "/tf_static"};
+    reader.set_filter(filter);
+
+    rclcpp::Serialization<PointCloud2> pointcloud_serialization;
+    rclcpp::Serialization<tf2_msgs::msg::TFMessage> tf_serialization;
+    while (reader.has_next() &&
+           (max_frame_num <= 0 || frames.size() < static_cast<std::size_t>(max_frame_num))) {
+      const auto bag_message = reader.read_next();
+      const rclcpp::SerializedMessage serialized_message(*bag_message->serialized_data);
+      if (bag_message->topic_name == input_topic) {
+        frames.emplace_back();
+        pointcloud_serialization.deserialize_message(&serialized_message, &frames.back());
+      } else {
+        tf2_msgs::msg::TFMessage tf_message;
+        tf_serialization.deserialize_message(&serialized_message, &tf_message);
+        static_transforms.insert(
+          static_transforms.end(), tf_message.transforms.begin(), tf_message.transforms.end());
+      }
+    }
+  }
+  if (frames.empty()) {
+    RCLCPP_ERROR_STREAM(logger, "No " << input_topic << " in " << bag_path);
+    rclcpp::shutdown();
+    return EXIT_FAILURE;
+  }
+  tf2_ros::StaticTransformBroadcaster static_broadcaster(node);
+  static_broadcaster.sendTransform(static_transforms);
+
+  // chain the components from the input of the benchmark, each of them observed at its output
+  std::vector<Stage> stages(plugin_names.size());
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(node);
+  const std::string benchmark_input_topic = std::string(topic_prefix) + "/input";
+  const PointCloud2 * current_frame = nullptr;
+  try {
+    for (std::size_t i = 0; i < stages.size(); ++i) {
+      auto & stage = stages.at(i);
+      stage.plugin_name = plugin_names.at(i);
+      stage.output_topic = std::string(topic_prefix) + "/stage_" + std::to_string(i) + "/output";
+      const auto & stage_input_topic =
+        i == 0 ? benchmark_input_topic : stages.at(i - 1).output_topic;
+
+      const auto factory = createNodeFactory(stage.plugin_name, stage.loader);
+      stage.node = factory->create_node_instance(
+        rclcpp::NodeOptions()
+          .use_intra_process_comms(use_intra_process)
+          .arguments(
+            {"--ros-args", "-r", "input:=" + stage_input_topic, "-r",
+             "output:=" + stage.output_topic}));
+      executor.add_node(stage.node.get_node_base_interface());
+
+      stage.output_sub = node->create_subscription<PointCloud2>(
+        stage.output_topic, rclcpp::SensorDataQoS(),
+        [&stage, &current_frame](const PointCloud2::ConstSharedPtr msg) {
+          // the late outputs of the previous frames are ignored
+          if (
+            !current_frame || stage.has_output ||
+            msg->header.stamp != current_frame->header.stamp) {
+            return;
+          }
+          stage.has_output = true;
+          stage.output_time = Clock::now();
+          stage.output_allocation = allocation_counter;
+        });
+    }
+  } catch (const std::exception & e) {
+    RCLCPP_ERROR_STREAM(logger, "Failed to load the components: " << e.what());
+    rclcpp::shutdown();
+    return EXIT_FAILURE;
+  }
+  if (stages.empty()) {
+    RCLCPP_ERROR(logger, "No components to benchmark");
+    rclcpp::shutdown();
+    return EXIT_FAILURE;
+  }
+  const auto input_pub =
+    node->create_publisher<PointCloud2>(benchmark_input_topic, rclcpp::SensorDataQoS());
+
+  for (auto & stage : stages) {
+    const std::size_t frame_num = frames.size() * std::max(repeat_num, 1);
+    stage.latencies_ms.reserve(frame_num);
+    stage.allocation_counts.reserve(frame_num);
+    stage.allocation_bytes.reserve(frame_num);
+  }
+
+  // one frame at a time, the next one being published as soon as the chain has processed it
+  std::size_t processed_frame_num = 0;
+  for (int repeat = 0; repeat < std::max(repeat_num, 1) && rclcpp::ok(); ++repeat) {
+    for (const auto & frame : frames) {
+      if (!rclcpp::ok()) {
+        break;
+      }
+      for (auto & stage : stages) {
+        stage.has_output = false;
+      }
+      auto msg = std::make_unique<PointCloud2>(frame);
+      current_frame = &frame;
+
+      const auto input_allocation = allocation_counter;
+      const auto input_time = Clock::now();
+      input_pub->publish(std::move(msg));
+      while (!stages.back().has_output) {
+        const auto remaining_time = timeout - (Clock::now() - input_time);
+        if (remaining_time <= Clock::duration::zero()) {
+          break;
+        }
+        executor.spin_once(remaining_time);
+      }
+      current_frame = nullptr;
+
+      if (static_cast<int>(processed_frame_num++) < warmup_frame_num) {
+        continue;
+      }
+      auto prev_time = input_time;
+      auto prev_allocation = input_allocation;
+      for (auto & stage : stages) {
+        if (!stage.has_output) {
+          ++stage.dropped_frame_num;
+          break;
+        }
+        stage.latencies_ms.push_back(
+          std::chrono::duration<double, std::milli>(stage.output_time - prev_time).count());
+        stage.allocation_counts.push_back(stage.output_allocation.count - prev_allocation.count);
+        stage.allocation_bytes.push_back(stage.output_allocation.bytes - prev_allocation.bytes);
+        prev_time = stage.output_time;
+        prev_allocation = stage.output_allocation;
+      }
+    }
+  }
+
+  // the latencies include the intra-process delivery of the output, and the copy of it for the
+  // subscription of the benchmark when the next component takes it as unique_ptr
+  std::ostringstream report;
+  report << std::fixed << std::setprecision(3)
+         << "stage,component,frames,dropped,mean_ms,p50_ms,p90_ms,p99_ms,max_ms,"
+            "allocations_per_frame,allocated_bytes_per_frame\n";
+  for (std::size_t i = 0; i < stages.size(); ++i) {
+    const auto & stage = stages.at(i);
+    report << i << "," << stage.plugin_name << "," << stage.latencies_ms.size() << ","
+           << stage.dropped_frame_num << "," << calcMean(stage.latencies_ms) << ","
+           << calcPercentile(stage.latencies_ms, 0.5) << ","
+           << calcPercentile(stage.latencies_ms, 0.9) << ","
+           << calcPercentile(stage.latencies_ms, 0.99) << ","
+           << calcPercentile(stage.latencies_ms, 1.0) << "," << calcMean(stage.allocation_counts)
+           << "," << calcMean(stage.allocation_bytes) << "\n";
+  }
+  RCLCPP_INFO_STREAM(
+    logger, "Replayed " << frames.size() << " frames of " << bag_path << " " << repeat_num
+                        << " times:\n"
+                        << report.str());
+  if (!output_file.empty()) {
+    std::ofstream(output_file) << report.str();
+  }
+
+  for (const auto & stage : stages) {
+    executor.remove_node(stage.node.get_node_base_interface());
+  }
+  rclcpp::shutdown();
+
+  return 0;
+}
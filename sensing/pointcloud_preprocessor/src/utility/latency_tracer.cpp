@@ -0,0 +1,93 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pointcloud_preprocessor/utility/latency_tracer.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace pointcloud_preprocessor
+{
+LatencyTracer::~LatencyTracer()
+{
+  if (header_) {
+    munmap(header_, size_);
+  }
+}
+
+bool LatencyTracer::open(const std::string & name)
+{
+  // a new object is zero-filled, which already is a valid empty ring
+  const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0666);
+  if (fd < 0) {
+    return false;
+  }
+  const std::size_t size = sizeof(LatencyTraceHeader) + capacity * sizeof(LatencyTraceRecord);
+  struct stat st;
+  if (fstat(fd, &st) != 0 || (static_cast<std::size_t>(st.st_size) < size &&
+                              ftruncate(fd, static_cast<off_t>(size)) != 0)) {
+    close(fd);
+    return false;
+  }
+  void * ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    return false;
+  }
+
+  header_ = static_cast<LatencyTraceHeader *>(ptr);
+  records_ = reinterpret_cast<LatencyTraceRecord *>(static_cast<uint8_t *>(ptr) + sizeof(*header_));
+  size_ = size;
+  pid_ = static_cast<uint32_t>(getpid());
+  // every writer stores the same values, so there is no initialization race
+  header_->capacity = capacity;
+  header_->version = version;
+  header_->magic = magic;
+  return true;
+}
+
+void LatencyTracer::record(
+  const std::string & stage, const int64_t header_stamp_ns, const int64_t entry_ns,
+  const int64_t exit_ns)
+{
+  if (!header_) {
+    return;
+  }
+  const uint64_t index = header_->write_index.fetch_add(1U, std::memory_order_relaxed);
+  auto & record = records_[index % capacity];
+  record.sequence.store(0U, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  record.header_stamp_ns = header_stamp_ns;
+  record.entry_ns = entry_ns;
+  record.exit_ns = exit_ns;
+  record.pid = pid_;
+  const std::size_t length = std::min(stage.size(), sizeof(record.stage) - 1U);
+  std::memcpy(record.stage, stage.data(), length);
+  record.stage[length] = '\0';
+  record.sequence.store(index + 1U, std::memory_order_release);
+}
+
+int64_t LatencyTracer::now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::system_clock::now().time_since_epoch())
+    .count();
+}
+}  // namespace pointcloud_preprocessor
@@ -14,6 +14,15 @@
 
 #include "pointcloud_preprocessor/utility/utilities.hpp"
 
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include <cstring>
+#include <string>
+
 namespace pointcloud_preprocessor::utils
 {
 void to_cgal_polygon(const geometry_msgs::msg::Polygon & polygon_in, PolygonCgal & polygon_out)
@@ -147,4 +156,129 @@ bool point_within_cgal_polys(
   return false;
 }
 
+
+namespace
+{
+constexpr std::size_t transform_block_size = 8;
+
+/**
+ * @brief transform a block of points held as structure of arrays
+ */
+inline void transform_block(const Eigen::Matrix4f & m, float * x, float * y, float * z)
+{
+#if defined(__AVX2__) && defined(__FMA__)
+  const __m256 px = _mm256_load_ps(x);
+  const __m256 py = _mm256_load_ps(y);
+  const __m256 pz = _mm256_load_ps(z);
+  const auto row = [&](const int r) {
+    __m256 v = _mm256_set1_ps(m(r, 3));
+    v = _mm256_fmadd_ps(_mm256_set1_ps(m(r, 0)), px, v);
+    v = _mm256_fmadd_ps(_mm256_set1_ps(m(r, 1)), py, v);
+    return _mm256_fmadd_ps(_mm256_set1_ps(m(r, 2)), pz, v);
+  };
+  _mm256_store_ps(x, row(0));
+  _mm256_store_ps(y, row(1));
+  _mm256_store_ps(z, row(2));
+#elif defined(__ARM_NEON)
+  for (std::size_t i = 0; i < transform_block_size; i += 4) {
+    const float32x4_t px = vld1q_f32(x + i);
+    const float32x4_t py = vld1q_f32(y + i);
+    const float32x4_t pz = vld1q_f32(z + i);
+    const auto row = [&](const int r) {
+      float32x4_t v = vdupq_n_f32(m(r, 3));
+      v = vmlaq_n_f32(v, px, m(r, 0));
+      v = vmlaq_n_f32(v, py, m(r, 1));
+      return vmlaq_n_f32(v, pz, m(r, 2));
+    };
+    vst1q_f32(x + i, row(0));
+    vst1q_f32(y + i, row(1));
+    vst1q_f32(z + i, row(2));
+  }
+#else
+  for (std::size_t i = 0; i < transform_block_size; ++i) {
+    const float px = x[i];
+    const float py = y[i];
+    const float pz = z[i];
+    x[i] = m(0, 0) * px + m(0, 1) * py + m(0, 2) * pz + m(0, 3);
+    y[i] = m(1, 0) * px + m(1, 1) * py + m(1, 2) * pz + m(1, 3);
+    z[i] = m(2, 0) * px + m(2, 1) * py + m(2, 2) * pz + m(2, 3);
+  }
+#endif
+}
+}  // namespace
+
+void transform_points_inplace(
+  const Eigen::Affine3f & transform, uint8_t * data, const std::size_t num_points,
+  const std::size_t point_step, const std::size_t x_offset, const std::size_t y_offset,
+  const std::size_t z_offset)
+{
+  const Eigen::Matrix4f m = transform.matrix();
+  alignas(32) float x[transform_block_size];
+  alignas(32) float y[transform_block_size];
+  alignas(32) float z[transform_block_size];
+
+  // gather blocks of points into SoA buffers so that any point_step can be handled
+  const std::size_t num_blocks = num_points / transform_block_size;
+  for (std::size_t b = 0; b < num_blocks; ++b) {
+    uint8_t * block_data = data + b * transform_block_size * point_step;
+    for (std::size_t i = 0; i < transform_block_size; ++i) {
+      const uint8_t * point = block_data + i * point_step;
+      std::memcpy(&x[i], point + x_offset, sizeof(float));
+      std::memcpy(&y[i], point + y_offset, sizeof(float));
+      std::memcpy(&z[i], point + z_offset, sizeof(float));
+    }
+    transform_block(m, x, y, z);
+    for (std::size_t i = 0; i < transform_block_size; ++i) {
+      uint8_t * point = block_data + i * point_step;
+      std::memcpy(point + x_offset, &x[i], sizeof(float));
+      std::memcpy(point + y_offset, &y[i], sizeof(float));
+      std::memcpy(point + z_offset, &z[i], sizeof(float));
+    }
+  }
+
+  for (std::size_t i = num_blocks * transform_block_size; i < num_points; ++i) {
+    uint8_t * point = data + i * point_step;
+    Eigen::Vector3f p;
+    std::memcpy(&p.x(), point + x_offset, sizeof(float));
+    std::memcpy(&p.y(), point + y_offset, sizeof(float));
+    std::memcpy(&p.z(), point + z_offset, sizeof(float));
+    p = transform * p;
+    std::memcpy(point + x_offset, &p.x(), sizeof(float));
+    std::memcpy(point + y_offset, &p.y(), sizeof(float));
+    std::memcpy(point + z_offset, &p.z(), sizeof(float));
+  }
+}
+
+bool transform_pointcloud_inplace(
+  const Eigen::Affine3f & transform, sensor_msgs::msg::PointCloud2 & cloud)
+{
+  const auto find_offset = [&cloud](const std::string & name, std::size_t & offset) {
+    const auto it = std::find_if(cloud.fields.cbegin(), cloud.fields.cend(), [&name](auto & f) {
+      return f.name == name && f.datatype == sensor_msgs::msg::PointField::FLOAT32;
+    });
+    if (it == cloud.fields.cend()) {
+      return false;
+    }
+    offset = it->offset;
+    return true;
+  };
+
+  std::size_t x_offset{};
+  std::size_t y_offset{};
+  std::size_t z_offset{};
+  if (
+    !find_offset("x", x_offset) || !find_offset("y", y_offset) || !find_offset("z", z_offset)) {
+    return false;
+  }
+  if (cloud.point_step == 0U) {
+    return true;
+  }
+
+  const std::size_t num_points =
+    std::min<std::size_t>(cloud.width * cloud.height, cloud.data.size() / cloud.point_step);
+  transform_points_inplace(
+    transform, cloud.data.data(), num_points, cloud.point_step, x_offset, y_offset, z_offset);
+  return true;
+}
+
 }  // namespace pointcloud_preprocessor::utils
@@ -41,6 +41,10 @@ Lanelet2MapFilterComponent::Lanelet2MapFilterComponent(const rclcpp::NodeOptions
   {
     voxel_size_x_ = declare_parameter("voxel_size_x", 0.04);
     voxel_size_y_ = declare_parameter("voxel_size_y", 0.04);
+    use_raster_mask_ = declare_parameter("use_raster_mask", false);
+    road_mask_.setGeometry(
+      declare_parameter("raster_mask_resolution", 0.1),
+      declare_parameter("raster_mask_size", 200.0));
   }
 
   // Set publisher
@@ -200,9 +204,16 @@ pcl::PointCloud<pcl::PointXYZ> Lanelet2MapFilterComponent::getLaneFilteredPointC
     downsampled2original_map[index].points.push_back(p);
   }
 
+  if (use_raster_mask_) {
+    road_mask_.updateCenter(centroid[0], centroid[1]);
+  }
+
   for (auto & point : downsampled_cloud->points) {
-    if (pointWithinLanelets(
-          Point2d(point.x + centroid[0], point.y + centroid[1]), intersected_lanelets)) {
+    const Point2d map_point(point.x + centroid[0], point.y + centroid[1]);
+    const bool is_within_lanelets =
+      use_raster_mask_ ? road_mask_.isInside(map_point.x(), map_point.y())
+                       : pointWithinLanelets(map_point, intersected_lanelets);
+    if (is_within_lanelets) {
       const size_t index = voxel_grid.getCentroidIndex(point);
       for (auto & original_point : downsampled2original_map[index].points) {
         original_point.x += centroid[0];
@@ -236,10 +247,12 @@ void Lanelet2MapFilterComponent::pointcloudCallback(const PointCloud2ConstPtr cl
   if (cloud->points.empty()) {
     return;
   }
-  // calculate convex hull
-  const auto convex_hull = getConvexHull(cloud);
-  // get intersected lanelets
-  lanelet::ConstLanelets intersected_lanelets = getIntersectedLanelets(convex_hull, road_lanelets_);
+  // get intersected lanelets, the raster mask holding all the road lanelets around the points
+  lanelet::ConstLanelets intersected_lanelets;
+  if (!use_raster_mask_) {
+    const auto convex_hull = getConvexHull(cloud);
+    intersected_lanelets = getIntersectedLanelets(convex_hull, road_lanelets_);
+  }
   // filter pointcloud by lanelet
   const auto filtered_cloud = getLaneFilteredPointCloud(intersected_lanelets, cloud);
   // transform pointcloud to input frame
@@ -265,6 +278,12 @@ void Lanelet2MapFilterComponent::mapCallback(
   lanelet::utils::conversion::fromBinMsg(*map_msg, lanelet_map_ptr_);
   const lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
   road_lanelets_ = lanelet::utils::query::roadLanelets(all_lanelets);
+
+  std::vector<lanelet::BasicPolygon2d> road_polygons;
+  for (const auto & road_lanelet : road_lanelets_) {
+    road_polygons.push_back(road_lanelet.polygon2d().basicPolygon());
+  }
+  road_mask_.setPolygons(road_polygons);
 }
 
 }  // namespace pointcloud_preprocessor
@@ -0,0 +1,154 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "pointcloud_preprocessor/vector_map_filter/polygon_raster_mask.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace pointcloud_preprocessor
+{
+void PolygonRasterMask::setGeometry(const double resolution, const double size)
+{
+  resolution_ = resolution;
+  size_ = size;
+  has_mask_ = false;
+}
+
+void PolygonRasterMask::setPolygons(const std::vector<lanelet::BasicPolygon2d> & polygons)
+{
+  polygons_.clear();
+  for (const auto & points : polygons) {
+    if (points.size() < 3) {
+      continue;
+    }
+    Polygon polygon;
+    polygon.points = points;
+    polygon.min_x = std::numeric_limits<double>::max();
+    polygon.min_y = std::numeric_limits<double>::max();
+    polygon.max_x = std::numeric_limits<double>::lowest();
+    polygon.max_y = std::numeric_limits<double>::lowest();
+    for (const auto & p : points) {
+      polygon.min_x = std::min(polygon.min_x, p.x());
+      polygon.min_y = std::min(polygon.min_y, p.y());
+      polygon.max_x = std::max(polygon.max_x, p.x());
+      polygon.max_y = std::max(polygon.max_y, p.y());
+    }
+    polygons_.push_back(polygon);
+  }
+  has_mask_ = false;
+}
+
+void PolygonRasterMask::updateCenter(const double x, const double y)
+{
+  if (
+    has_mask_ && std::abs(x - center_x_) <= 0.25 * size_ &&
+    std::abs(y - center_y_) <= 0.25 * size_) {
+    return;
+  }
+
+  cell_num_ = std::max(static_cast<int>(std::ceil(size_ / resolution_)), 1);
+  center_x_ = x;
+  center_y_ = y;
+  origin_x_ = x - 0.5 * cell_num_ * resolution_;
+  origin_y_ = y - 0.5 * cell_num_ * resolution_;
+  cells_.assign(static_cast<std::size_t>(cell_num_) * cell_num_, 0U);
+
+  const double end_x = origin_x_ + cell_num_ * resolution_;
+  const double end_y = origin_y_ + cell_num_ * resolution_;
+  for (const auto & polygon : polygons_) {
+    if (
+      polygon.max_x >= origin_x_ && polygon.min_x <= end_x && polygon.max_y >= origin_y_ &&
+      polygon.min_y <= end_y) {
+      rasterize(polygon);
+    }
+  }
+  has_mask_ = true;
+}
+
+void PolygonRasterMask::rasterize(const Polygon & polygon)
+{
+  const auto & points = polygon.points;
+  const int row_begin =
+    std::max(static_cast<int>(std::ceil((polygon.min_y - origin_y_) / resolution_ - 0.5)), 0);
+  const int row_end = std::min(
+    static_cast<int>(std::floor((polygon.max_y - origin_y_) / resolution_ - 0.5)), cell_num_ - 1);
+
+  // even-odd fill of the cell centers of every row, the polygons being filled one by one so that
+  // overlapping ones add up
+  for (int row = row_begin; row <= row_end; ++row) {
+    const double y = origin_y_ + (row + 0.5) * resolution_;
+    crossings_.clear();
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      const auto & a = points[i];
+      const auto & b = points[(i + 1) % points.size()];
+      if ((a.y() > y) != (b.y() > y)) {
+        crossings_.push_back(a.x() + (y - a.y()) * (b.x() - a.x()) / (b.y() - a.y()));
+      }
+    }
+    std::sort(crossings_.begin(), crossings_.end());
+
+    uint8_t * cells = &cells_[static_cast<std::size_t>(row) * cell_num_];
+    for (std::size_t i = 0; i + 1 < crossings_.size(); i += 2) {
+      const int col_begin =
+        std::max(static_cast<int>(std::ceil((crossings_[i] - origin_x_) / resolution_ - 0.5)), 0);
+      const int col_end = std::min(
+        static_cast<int>(std::floor((crossings_[i + 1] - origin_x_) / resolution_ - 0.5)),
+        cell_num_ - 1);
+      for (int col = col_begin; col <= col_end; ++col) {
+        cells[col] = 1U;
+      }
+    }
+  }
+}
+
+bool PolygonRasterMask::isInside(const double x, const double y) const
+{
+  if (has_mask_) {
+    const double col = std::floor((x - origin_x_) / resolution_);
+    const double row = std::floor((y - origin_y_) / resolution_);
+    if (col >= 0.0 && row >= 0.0 && col < cell_num_ && row < cell_num_) {
+      const auto index = static_cast<std::size_t>(row) * cell_num_ + static_cast<std::size_t>(col);
+      return cells_[index] != 0U;
+    }
+  }
+  return isInsidePolygons(x, y);
+}
+
+bool PolygonRasterMask::isInsidePolygons(const double x, const double y) const
+{
+  for (const auto & polygon : polygons_) {
+    if (x < polygon.min_x || x > polygon.max_x || y < polygon.min_y || y > polygon.max_y) {
+      continue;
+    }
+    // even-odd crossing test, as the rasterization
+    const auto & points = polygon.points;
+    bool inside = false;
+    for (std::size_t i = 0, j = points.size() - 1; i < points.size(); j = i++) {
+      const auto & a = points[i];
+      const auto & b = points[j];
+      if (
+        (a.y() > y) != (b.y() > y) && x < a.x() + (y - a.y()) * (b.x() - a.x()) / (b.y() - a.y())) {
+        inside = !inside;
+      }
+    }
+    if (inside) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace pointcloud_preprocessor
@@ -68,6 +68,10 @@ VectorMapInsideAreaFilterComponent::VectorMapInsideAreaFilterComponent(
 {
   polygon_type_ =
     static_cast<std::string>(declare_parameter("polygon_type", "no_obstacle_segmentation_area"));
+  use_raster_mask_ = static_cast<bool>(declare_parameter("use_raster_mask", false));
+  polygon_mask_.setGeometry(
+    static_cast<double>(declare_parameter("raster_mask_resolution", 0.1)),
+    static_cast<double>(declare_parameter("raster_mask_size", 200.0)));
 
   using std::placeholders::_1;
   // Set subscriber
@@ -92,6 +96,23 @@ void VectorMapInsideAreaFilterComponent::filter(
   // calculate bounding box of points
   const auto bounding_box = calcBoundingBox(pc_input);
 
+  if (use_raster_mask_) {
+    polygon_mask_.updateCenter(
+      0.5 * (bounding_box.min_corner().x() + bounding_box.max_corner().x()),
+      0.5 * (bounding_box.min_corner().y() + bounding_box.max_corner().y()));
+
+    pcl::PointCloud<pcl::PointXYZ> filtered_pc;
+    filtered_pc.reserve(pc_input->size());
+    for (const auto & p : pc_input->points) {
+      if (!polygon_mask_.isInside(p.x, p.y)) {
+        filtered_pc.push_back(p);
+      }
+    }
+    pcl::toROSMsg(filtered_pc, output);
+    output.header = input->header;
+    return;
+  }
+
   // use only intersected lanelets to reduce calculation cost
   const auto intersected_lanelets = calcIntersectedPolygons(bounding_box, polygon_lanelets_);
 
@@ -111,6 +132,12 @@ void VectorMapInsideAreaFilterComponent::mapCallback(
   const auto lanelet_map_ptr = std::make_shared<lanelet::LaneletMap>();
   lanelet::utils::conversion::fromBinMsg(*map_msg, lanelet_map_ptr);
   polygon_lanelets_ = lanelet::utils::query::getAllPolygonsByType(lanelet_map_ptr, polygon_type_);
+
+  std::vector<lanelet::BasicPolygon2d> polygons;
+  for (const auto & polygon : polygon_lanelets_) {
+    polygons.push_back(lanelet::utils::to2D(polygon).basicPolygon());
+  }
+  polygon_mask_.setPolygons(polygons);
 }
 
 }  // namespace pointcloud_preprocessor
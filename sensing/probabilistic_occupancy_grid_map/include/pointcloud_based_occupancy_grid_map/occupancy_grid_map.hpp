@@ -67,8 +67,10 @@ using sensor_msgs::msg::PointCloud2;
 class OccupancyGridMap : public nav2_costmap_2d::Costmap2D
 {
 public:
+  // with use_parallel_raytrace, the rays which only write a single cost are traced in parallel
   OccupancyGridMap(
-    const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution);
+    const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution,
+    const bool use_parallel_raytrace = false);
 
   void updateWithPointCloud(
     const PointCloud2 & raw_pointcloud, const PointCloud2 & obstacle_pointcloud,
@@ -85,6 +87,7 @@ public:
 private:
   bool worldToMap(double wx, double wy, unsigned int & mx, unsigned int & my) const;
 
+  bool use_parallel_raytrace_{false};
   rclcpp::Logger logger_{rclcpp::get_logger("pointcloud_based_occupancy_grid_map")};
   rclcpp::Clock clock_{RCL_ROS_TIME};
 };
@@ -59,7 +59,8 @@ private:
     const PointCloud2::ConstSharedPtr & input_raw_msg);
   OccupancyGrid::UniquePtr OccupancyGridMapToMsgPtr(
     const std::string & frame_id, const Time & stamp, const float & robot_pose_z,
-    const Costmap2D & occupancy_grid_map);
+    const Costmap2D & occupancy_grid_map, const unsigned int ring_offset_x = 0U,
+    const unsigned int ring_offset_y = 0U);
 
 private:
   rclcpp::Publisher<OccupancyGrid>::SharedPtr occupancy_grid_map_pub_;
@@ -80,6 +81,7 @@ private:
   std::string base_link_frame_;
   bool use_height_filter_;
   bool enable_single_frame_mode_;
+  bool use_parallel_raytrace_;
 };
 
 }  // namespace occupancy_grid_map
@@ -20,6 +20,8 @@
 #include <eigen3/Eigen/Core>
 #include <eigen3/Eigen/Geometry>
 
+#include <vector>
+
 namespace costmap_2d
 {
 class OccupancyGridMapBBFUpdater : public OccupancyGridMapUpdaterInterface
@@ -27,20 +29,16 @@ class OccupancyGridMapBBFUpdater : public OccupancyGridMapUpdaterInterface
 public:
   enum Index : size_t { OCCUPIED = 0U, FREE = 1U };
   OccupancyGridMapBBFUpdater(
-    const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution)
-  : OccupancyGridMapUpdaterInterface(cells_size_x, cells_size_y, resolution)
-  {
-    probability_matrix_(Index::OCCUPIED, Index::OCCUPIED) = 0.95;
-    probability_matrix_(Index::FREE, Index::OCCUPIED) =
-      1.0 - probability_matrix_(OCCUPIED, OCCUPIED);
-    probability_matrix_(Index::FREE, Index::FREE) = 0.8;
-    probability_matrix_(Index::OCCUPIED, Index::FREE) = 1.0 - probability_matrix_(FREE, FREE);
-  }
+    const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution,
+    const bool use_ring_buffer = false, const bool use_parallel_update = false);
   bool update(const Costmap2D & single_frame_occupancy_grid_map) override;
 
 private:
   inline unsigned char applyBBF(const unsigned char & z, const unsigned char & o);
   Eigen::Matrix2f probability_matrix_;
+  // applyBBF(z, o) of every pair of costs, at z * 256 + o
+  std::vector<unsigned char> bbf_table_;
+  bool use_parallel_update_;
 };
 
 }  // namespace costmap_2d
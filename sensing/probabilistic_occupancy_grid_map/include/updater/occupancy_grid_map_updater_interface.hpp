@@ -24,14 +24,38 @@ namespace costmap_2d
 class OccupancyGridMapUpdaterInterface : public nav2_costmap_2d::Costmap2D
 {
 public:
+  /**
+   * \param use_ring_buffer store the map as a ring buffer, so that moving the origin only clears
+   *     the newly exposed cells instead of copying the whole map. The cell (mx, my) then lives in
+   *     getCharMap() at the column mx + getRingOffsetX() and the row my + getRingOffsetY(), both
+   *     wrapped around, and getCost()/getIndex() do not apply.
+   */
   OccupancyGridMapUpdaterInterface(
-    const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution)
+    const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution,
+    const bool use_ring_buffer = false)
   : Costmap2D(
-      cells_size_x, cells_size_y, resolution, 0.f, 0.f, occupancy_cost_value::NO_INFORMATION)
+      cells_size_x, cells_size_y, resolution, 0.f, 0.f, occupancy_cost_value::NO_INFORMATION),
+    use_ring_buffer_(use_ring_buffer)
   {
   }
   virtual ~OccupancyGridMapUpdaterInterface() = default;
   virtual bool update(const Costmap2D & single_frame_occupancy_grid_map) = 0;
+  void updateOrigin(double new_origin_x, double new_origin_y) override;
+  unsigned int getRingOffsetX() const { return ring_offset_x_; }
+  unsigned int getRingOffsetY() const { return ring_offset_y_; }
+
+protected:
+  // the row of getCharMap() storing the cells of the row my
+  unsigned int getStorageRow(const unsigned int my) const
+  {
+    const unsigned int row = my + ring_offset_y_;
+    return row < size_y_ ? row : row - size_y_;
+  }
+
+private:
+  bool use_ring_buffer_;
+  unsigned int ring_offset_x_{0U};
+  unsigned int ring_offset_y_{0U};
 };
 
 }  // namespace costmap_2d
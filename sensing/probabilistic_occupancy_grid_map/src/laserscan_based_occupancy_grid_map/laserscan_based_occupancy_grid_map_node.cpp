@@ -117,6 +117,8 @@ LaserscanBasedOccupancyGridMapNode::LaserscanBasedOccupancyGridMapNode(
   const double map_length{declare_parameter("map_length", 100.0)};
   const double map_width{declare_parameter("map_width", 100.0)};
   const double map_resolution{declare_parameter("map_resolution", 0.5)};
+  const bool use_ring_buffer{declare_parameter("use_ring_buffer", false)};
+  const bool use_parallel_update{declare_parameter("use_parallel_update", false)};
   const bool input_obstacle_pointcloud{declare_parameter("input_obstacle_pointcloud", true)};
   const bool input_obstacle_and_raw_pointcloud{
     declare_parameter("input_obstacle_and_raw_pointcloud", true)};
@@ -149,7 +151,8 @@ LaserscanBasedOccupancyGridMapNode::LaserscanBasedOccupancyGridMapNode(
 
   /* Occupancy grid */
   occupancy_grid_map_updater_ptr_ = std::make_shared<OccupancyGridMapBBFUpdater>(
-    map_length / map_resolution, map_width / map_resolution, map_resolution);
+    map_length / map_resolution, map_width / map_resolution, map_resolution, use_ring_buffer,
+    use_parallel_update);
 }
 
 PointCloud2::SharedPtr LaserscanBasedOccupancyGridMapNode::convertLaserscanToPointCLoud2(
@@ -243,13 +246,15 @@ void LaserscanBasedOccupancyGridMapNode::onLaserscanPointCloud2WithObstacleAndRa
     // publish
     occupancy_grid_map_pub_->publish(OccupancyGridMapToMsgPtr(
       map_frame_, laserscan_pc_ptr->header.stamp, pose.position.z,
-      *occupancy_grid_map_updater_ptr_));
+      *occupancy_grid_map_updater_ptr_, occupancy_grid_map_updater_ptr_->getRingOffsetX(),
+      occupancy_grid_map_updater_ptr_->getRingOffsetY()));
   }
 }
 
 OccupancyGrid::UniquePtr LaserscanBasedOccupancyGridMapNode::OccupancyGridMapToMsgPtr(
   const std::string & frame_id, const Time & stamp, const float & robot_pose_z,
-  const Costmap2D & occupancy_grid_map)
+  const Costmap2D & occupancy_grid_map, const unsigned int ring_offset_x,
+  const unsigned int ring_offset_y)
 {
   auto msg_ptr = std::make_unique<OccupancyGrid>();
 
@@ -270,9 +275,22 @@ OccupancyGrid::UniquePtr LaserscanBasedOccupancyGridMapNode::OccupancyGridMapToM
 
   msg_ptr->data.resize(msg_ptr->info.width * msg_ptr->info.height);
 
+  // a ring buffered map is unrolled while translating the costs
   unsigned char * data = occupancy_grid_map.getCharMap();
-  for (unsigned int i = 0; i < msg_ptr->data.size(); ++i) {
-    msg_ptr->data[i] = occupancy_cost_value::cost_translation_table[data[i]];
+  const unsigned int width = msg_ptr->info.width;
+  const unsigned int height = msg_ptr->info.height;
+  const unsigned int split_x = width - ring_offset_x;
+  for (unsigned int y = 0; y < height; ++y) {
+    const unsigned int storage_y =
+      y < height - ring_offset_y ? y + ring_offset_y : y + ring_offset_y - height;
+    const unsigned char * row = data + storage_y * width;
+    auto msg_row = msg_ptr->data.begin() + y * width;
+    for (unsigned int x = 0; x < split_x; ++x) {
+      msg_row[x] = occupancy_cost_value::cost_translation_table[row[x + ring_offset_x]];
+    }
+    for (unsigned int x = split_x; x < width; ++x) {
+      msg_row[x] = occupancy_cost_value::cost_translation_table[row[x - split_x]];
+    }
   }
   return msg_ptr;
 }
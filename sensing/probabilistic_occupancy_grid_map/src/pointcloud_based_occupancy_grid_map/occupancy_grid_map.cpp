@@ -53,7 +53,7 @@
 
 #include "cost_value.hpp"
 
-#include <pcl_ros/transforms.hpp>
+#include <tier4_autoware_utils/geometry/polar_grid.hpp>
 #include <tier4_autoware_utils/tier4_autoware_utils.hpp>
 
 #include <sensor_msgs/point_cloud2_iterator.hpp>
@@ -68,18 +68,76 @@
 #endif
 
 #include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
 namespace
 {
-void transformPointcloud(
-  const sensor_msgs::msg::PointCloud2 & input, const geometry_msgs::msg::Pose & pose,
-  sensor_msgs::msg::PointCloud2 & output)
+struct BinInfo
+{
+  double range;
+  double wx;
+  double wy;
+};
+
+// the points of every angle bin sorted by range, bin i being
+// [grid.angleBinBegin(i), grid.angleBinEnd(i))
+struct AngleBins
+{
+  tier4_autoware_utils::PolarGrid grid;
+  std::vector<BinInfo> points;
+
+  size_t size() const { return grid.angleBinNum(); }
+  bool empty(const size_t bin_index) const
+  {
+    return grid.angleBinBegin(bin_index) == grid.angleBinEnd(bin_index);
+  }
+  size_t binSize(const size_t bin_index) const
+  {
+    return grid.angleBinEnd(bin_index) - grid.angleBinBegin(bin_index);
+  }
+  const BinInfo & at(const size_t bin_index, const size_t dist_index) const
+  {
+    return points[grid.angleBinBegin(bin_index) + dist_index];
+  }
+  const BinInfo & back(const size_t bin_index) const
+  {
+    return points[grid.angleBinEnd(bin_index) - 1];
+  }
+};
+
+// bin the points of the pointcloud by angle with a counting sort, transforming them to the map
+// frame in the same pass
+void createAngleBins(
+  const sensor_msgs::msg::PointCloud2 & pointcloud, const geometry_msgs::msg::Pose & pose,
+  const double min_angle, const double angle_increment, const size_t angle_bin_size,
+  AngleBins & angle_bins)
 {
   const auto transform = tier4_autoware_utils::pose2transform(pose);
-  Eigen::Matrix4f tf_matrix = tf2::transformToEigen(transform).matrix().cast<float>();
+  const Eigen::Matrix4f tf_matrix = tf2::transformToEigen(transform).matrix().cast<float>();
+
+  const size_t num_points = pointcloud.width * pointcloud.height;
+  std::vector<std::pair<float, float>> sensor_points(num_points);
+  std::vector<std::pair<double, double>> map_points(num_points);
+  size_t point_index = 0;
+  for (sensor_msgs::PointCloud2ConstIterator<float> iter_x(pointcloud, "x"),
+       iter_y(pointcloud, "y"), iter_z(pointcloud, "z");
+       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_z, ++point_index) {
+    const Eigen::Vector4f point = tf_matrix * Eigen::Vector4f(*iter_x, *iter_y, *iter_z, 1.0f);
+    sensor_points[point_index] = {*iter_x, *iter_y};
+    map_points[point_index] = {point.x(), point.y()};
+  }
+
+  angle_bins.grid.initialize(min_angle, angle_increment, angle_bin_size);
+  angle_bins.grid.bin(num_points, [&sensor_points](const size_t i) { return sensor_points[i]; });
+  angle_bins.grid.sortByRange();
 
-  pcl_ros::transformPointCloud(tf_matrix, input, output);
-  output.header.stamp = input.header.stamp;
-  output.header.frame_id = "";
+  angle_bins.points.resize(num_points);
+  for (size_t k = 0; k < num_points; ++k) {
+    const auto & map_point = map_points[angle_bins.grid.index(k)];
+    angle_bins.points[k] = BinInfo{angle_bins.grid.range(k), map_point.first, map_point.second};
+  }
 }
 }  // namespace
 
@@ -88,8 +146,10 @@ namespace costmap_2d
 using sensor_msgs::PointCloud2ConstIterator;
 
 OccupancyGridMap::OccupancyGridMap(
-  const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution)
-: Costmap2D(cells_size_x, cells_size_y, resolution, 0.f, 0.f, occupancy_cost_value::NO_INFORMATION)
+  const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution,
+  const bool use_parallel_raytrace)
+: Costmap2D(cells_size_x, cells_size_y, resolution, 0.f, 0.f, occupancy_cost_value::NO_INFORMATION),
+  use_parallel_raytrace_(use_parallel_raytrace)
 {
 }
 
@@ -169,104 +229,80 @@ void OccupancyGridMap::updateWithPointCloud(
   constexpr double angle_increment = tier4_autoware_utils::deg2rad(0.1);
   const size_t angle_bin_size = ((max_angle - min_angle) / angle_increment) + size_t(1 /*margin*/);
 
-  // Transform to map frame
-  PointCloud2 trans_raw_pointcloud, trans_obstacle_pointcloud;
-  transformPointcloud(raw_pointcloud, robot_pose, trans_raw_pointcloud);
-  transformPointcloud(obstacle_pointcloud, robot_pose, trans_obstacle_pointcloud);
-
-  // Create angle bins
-  struct BinInfo
-  {
-    BinInfo() = default;
-    BinInfo(const double _range, const double _wx, const double _wy)
-    : range(_range), wx(_wx), wy(_wy)
-    {
-    }
-    double range;
-    double wx;
-    double wy;
-  };
-  std::vector</*angle bin*/ std::vector<BinInfo>> obstacle_pointcloud_angle_bins;
-  std::vector</*angle bin*/ std::vector<BinInfo>> raw_pointcloud_angle_bins;
-  obstacle_pointcloud_angle_bins.resize(angle_bin_size);
-  raw_pointcloud_angle_bins.resize(angle_bin_size);
-  for (PointCloud2ConstIterator<float> iter_x(raw_pointcloud, "x"), iter_y(raw_pointcloud, "y"),
-       iter_wx(trans_raw_pointcloud, "x"), iter_wy(trans_raw_pointcloud, "y");
-       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_wx, ++iter_wy) {
-    const double angle = atan2(*iter_y, *iter_x);
-    const int angle_bin_index = (angle - min_angle) / angle_increment;
-    raw_pointcloud_angle_bins.at(angle_bin_index)
-      .push_back(BinInfo(std::hypot(*iter_y, *iter_x), *iter_wx, *iter_wy));
-  }
-  for (PointCloud2ConstIterator<float> iter_x(obstacle_pointcloud, "x"),
-       iter_y(obstacle_pointcloud, "y"), iter_wx(trans_obstacle_pointcloud, "x"),
-       iter_wy(trans_obstacle_pointcloud, "y");
-       iter_x != iter_x.end(); ++iter_x, ++iter_y, ++iter_wx, ++iter_wy) {
-    const double angle = atan2(*iter_y, *iter_x);
-    int angle_bin_index = (angle - min_angle) / angle_increment;
-    obstacle_pointcloud_angle_bins.at(angle_bin_index)
-      .push_back(BinInfo(std::hypot(*iter_y, *iter_x), *iter_wx, *iter_wy));
-  }
-
-  // Sort by distance
-  for (auto & obstacle_pointcloud_angle_bin : obstacle_pointcloud_angle_bins) {
-    std::sort(
-      obstacle_pointcloud_angle_bin.begin(), obstacle_pointcloud_angle_bin.end(),
-      [](auto a, auto b) { return a.range < b.range; });
-  }
-  for (auto & raw_pointcloud_angle_bin : raw_pointcloud_angle_bins) {
-    std::sort(raw_pointcloud_angle_bin.begin(), raw_pointcloud_angle_bin.end(), [](auto a, auto b) {
-      return a.range < b.range;
-    });
-  }
+  // Create angle bins in map frame
+  AngleBins obstacle_pointcloud_angle_bins;
+  AngleBins raw_pointcloud_angle_bins;
+  createAngleBins(
+    raw_pointcloud, robot_pose, min_angle, angle_increment, angle_bin_size,
+    raw_pointcloud_angle_bins);
+  createAngleBins(
+    obstacle_pointcloud, robot_pose, min_angle, angle_increment, angle_bin_size,
+    obstacle_pointcloud_angle_bins);
 
   // First step: Initialize cells to the final point with freespace
   constexpr double distance_margin = 1.0;
-  for (size_t bin_index = 0; bin_index < obstacle_pointcloud_angle_bins.size(); ++bin_index) {
-    auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
-    auto & raw_pointcloud_angle_bin = raw_pointcloud_angle_bins.at(bin_index);
-
+  std::vector<BinInfo> end_points;
+  end_points.reserve(angle_bin_size);
+  const unsigned int no_end_point_cell = size_x_ * size_y_;
+  unsigned int last_end_point_cell = no_end_point_cell;
+  for (size_t bin_index = 0; bin_index < angle_bin_size; ++bin_index) {
     BinInfo end_distance;
-    if (raw_pointcloud_angle_bin.empty() && obstacle_pointcloud_angle_bin.empty()) {
+    if (
+      raw_pointcloud_angle_bins.empty(bin_index) &&
+      obstacle_pointcloud_angle_bins.empty(bin_index)) {
       continue;
-    } else if (raw_pointcloud_angle_bin.empty()) {
-      end_distance = obstacle_pointcloud_angle_bin.back();
-    } else if (obstacle_pointcloud_angle_bin.empty()) {
-      end_distance = raw_pointcloud_angle_bin.back();
+    } else if (raw_pointcloud_angle_bins.empty(bin_index)) {
+      end_distance = obstacle_pointcloud_angle_bins.back(bin_index);
+    } else if (obstacle_pointcloud_angle_bins.empty(bin_index)) {
+      end_distance = raw_pointcloud_angle_bins.back(bin_index);
     } else {
-      end_distance = obstacle_pointcloud_angle_bin.back().range + distance_margin <
-                         raw_pointcloud_angle_bin.back().range
-                       ? raw_pointcloud_angle_bin.back()
-                       : obstacle_pointcloud_angle_bin.back();
+      end_distance = obstacle_pointcloud_angle_bins.back(bin_index).range + distance_margin <
+                         raw_pointcloud_angle_bins.back(bin_index).range
+                       ? raw_pointcloud_angle_bins.back(bin_index)
+                       : obstacle_pointcloud_angle_bins.back(bin_index);
     }
+    // the rays of the neighboring bins ending in the same cell are the same line, traced once
+    unsigned int mx{};
+    unsigned int my{};
+    const unsigned int end_point_cell =
+      worldToMap(end_distance.wx, end_distance.wy, mx, my) ? getIndex(mx, my) : no_end_point_cell;
+    if (end_point_cell != no_end_point_cell && end_point_cell == last_end_point_cell) {
+      continue;
+    }
+    last_end_point_cell = end_point_cell;
+    end_points.push_back(end_distance);
+  }
+#pragma omp parallel for if (use_parallel_raytrace_)
+  for (size_t i = 0; i < end_points.size(); ++i) {
     raytrace(
-      robot_pose.position.x, robot_pose.position.y, end_distance.wx, end_distance.wy,
+      robot_pose.position.x, robot_pose.position.y, end_points[i].wx, end_points[i].wy,
       occupancy_cost_value::FREE_SPACE);
   }
 
   // Second step: Add uknown cell
-  for (size_t bin_index = 0; bin_index < obstacle_pointcloud_angle_bins.size(); ++bin_index) {
-    auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
-    auto & raw_pointcloud_angle_bin = raw_pointcloud_angle_bins.at(bin_index);
-    auto raw_distance_iter = raw_pointcloud_angle_bin.begin();
-    for (size_t dist_index = 0; dist_index < obstacle_pointcloud_angle_bin.size(); ++dist_index) {
+  for (size_t bin_index = 0; bin_index < angle_bin_size; ++bin_index) {
+    const size_t obstacle_bin_size = obstacle_pointcloud_angle_bins.binSize(bin_index);
+    const size_t raw_bin_size = raw_pointcloud_angle_bins.binSize(bin_index);
+    size_t raw_dist_index = 0;
+    for (size_t dist_index = 0; dist_index < obstacle_bin_size; ++dist_index) {
+      const auto & obstacle_point = obstacle_pointcloud_angle_bins.at(bin_index, dist_index);
       // Calculate next raw point from obstacle point
-      while (raw_distance_iter != raw_pointcloud_angle_bin.end()) {
+      while (raw_dist_index < raw_bin_size) {
         if (
-          raw_distance_iter->range <
-          obstacle_pointcloud_angle_bin.at(dist_index).range + distance_margin)
-          raw_distance_iter++;
+          raw_pointcloud_angle_bins.at(bin_index, raw_dist_index).range <
+          obstacle_point.range + distance_margin)
+          raw_dist_index++;
         else
           break;
       }
 
       // There is no point far than the obstacle point.
-      const bool no_freespace_point = (raw_distance_iter == raw_pointcloud_angle_bin.end());
+      const bool no_freespace_point = (raw_dist_index == raw_bin_size);
 
-      if (dist_index + 1 == obstacle_pointcloud_angle_bin.size()) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
+      if (dist_index + 1 == obstacle_bin_size) {
+        const auto & source = obstacle_point;
         if (!no_freespace_point) {
-          const auto & target = *raw_distance_iter;
+          const auto & target = raw_pointcloud_angle_bins.at(bin_index, raw_dist_index);
           raytrace(
             source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
           setCellValue(target.wx, target.wy, occupancy_cost_value::FREE_SPACE);
@@ -274,29 +310,30 @@ void OccupancyGridMap::updateWithPointCloud(
         continue;
       }
 
-      auto next_obstacle_point_distance = std::abs(
-        obstacle_pointcloud_angle_bin.at(dist_index + 1).range -
-        obstacle_pointcloud_angle_bin.at(dist_index).range);
+      const auto & next_obstacle_point =
+        obstacle_pointcloud_angle_bins.at(bin_index, dist_index + 1);
+      auto next_obstacle_point_distance =
+        std::abs(next_obstacle_point.range - obstacle_point.range);
       if (next_obstacle_point_distance <= distance_margin) {
         continue;
       } else if (no_freespace_point) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
+        const auto & source = obstacle_point;
+        const auto & target = next_obstacle_point;
         raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
         continue;
       }
 
-      auto next_raw_distance =
-        std::abs(obstacle_pointcloud_angle_bin.at(dist_index).range - raw_distance_iter->range);
+      const auto & raw_point = raw_pointcloud_angle_bins.at(bin_index, raw_dist_index);
+      auto next_raw_distance = std::abs(obstacle_point.range - raw_point.range);
       if (next_raw_distance < next_obstacle_point_distance) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = *raw_distance_iter;
+        const auto & source = obstacle_point;
+        const auto & target = raw_point;
         raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
         setCellValue(target.wx, target.wy, occupancy_cost_value::FREE_SPACE);
         continue;
       } else {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
+        const auto & source = obstacle_point;
+        const auto & target = next_obstacle_point;
         raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::NO_INFORMATION);
         continue;
       }
@@ -304,22 +341,20 @@ void OccupancyGridMap::updateWithPointCloud(
   }
 
   // Third step: Overwrite occupied cell
-  for (size_t bin_index = 0; bin_index < obstacle_pointcloud_angle_bins.size(); ++bin_index) {
-    auto & obstacle_pointcloud_angle_bin = obstacle_pointcloud_angle_bins.at(bin_index);
-    for (size_t dist_index = 0; dist_index < obstacle_pointcloud_angle_bin.size(); ++dist_index) {
-      const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
+#pragma omp parallel for if (use_parallel_raytrace_)
+  for (size_t bin_index = 0; bin_index < angle_bin_size; ++bin_index) {
+    const size_t obstacle_bin_size = obstacle_pointcloud_angle_bins.binSize(bin_index);
+    for (size_t dist_index = 0; dist_index < obstacle_bin_size; ++dist_index) {
+      const auto & source = obstacle_pointcloud_angle_bins.at(bin_index, dist_index);
       setCellValue(source.wx, source.wy, occupancy_cost_value::LETHAL_OBSTACLE);
 
-      if (dist_index + 1 == obstacle_pointcloud_angle_bin.size()) {
+      if (dist_index + 1 == obstacle_bin_size) {
         continue;
       }
 
-      auto next_obstacle_point_distance = std::abs(
-        obstacle_pointcloud_angle_bin.at(dist_index + 1).range -
-        obstacle_pointcloud_angle_bin.at(dist_index).range);
+      const auto & target = obstacle_pointcloud_angle_bins.at(bin_index, dist_index + 1);
+      auto next_obstacle_point_distance = std::abs(target.range - source.range);
       if (next_obstacle_point_distance <= distance_margin) {
-        const auto & source = obstacle_pointcloud_angle_bin.at(dist_index);
-        const auto & target = obstacle_pointcloud_angle_bin.at(dist_index + 1);
         raytrace(source.wx, source.wy, target.wx, target.wy, occupancy_cost_value::LETHAL_OBSTACLE);
         continue;
       }
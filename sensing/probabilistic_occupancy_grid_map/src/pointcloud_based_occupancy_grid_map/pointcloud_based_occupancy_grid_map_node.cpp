@@ -113,6 +113,9 @@ PointcloudBasedOccupancyGridMapNode::PointcloudBasedOccupancyGridMapNode(
   base_link_frame_ = declare_parameter("base_link_frame", "base_link");
   use_height_filter_ = declare_parameter("use_height_filter", true);
   enable_single_frame_mode_ = declare_parameter("enable_single_frame_mode", false);
+  use_parallel_raytrace_ = declare_parameter("use_parallel_raytrace", false);
+  const bool use_ring_buffer{declare_parameter("use_ring_buffer", false)};
+  const bool use_parallel_update{declare_parameter("use_parallel_update", false)};
   const double map_length{declare_parameter("map_length", 100.0)};
   const double map_resolution{declare_parameter("map_resolution", 0.5)};
 
@@ -130,7 +133,8 @@ PointcloudBasedOccupancyGridMapNode::PointcloudBasedOccupancyGridMapNode(
 
   /* Occupancy grid */
   occupancy_grid_map_updater_ptr_ = std::make_shared<OccupancyGridMapBBFUpdater>(
-    map_length / map_resolution, map_length / map_resolution, map_resolution);
+    map_length / map_resolution, map_length / map_resolution, map_resolution, use_ring_buffer,
+    use_parallel_update);
 }
 
 void PointcloudBasedOccupancyGridMapNode::onPointcloudWithObstacleAndRaw(
@@ -169,7 +173,7 @@ void PointcloudBasedOccupancyGridMapNode::onPointcloudWithObstacleAndRaw(
   OccupancyGridMap single_frame_occupancy_grid_map(
     occupancy_grid_map_updater_ptr_->getSizeInCellsX(),
     occupancy_grid_map_updater_ptr_->getSizeInCellsY(),
-    occupancy_grid_map_updater_ptr_->getResolution());
+    occupancy_grid_map_updater_ptr_->getResolution(), use_parallel_raytrace_);
   single_frame_occupancy_grid_map.updateOrigin(
     pose.position.x - single_frame_occupancy_grid_map.getSizeInMetersX() / 2,
     pose.position.y - single_frame_occupancy_grid_map.getSizeInMetersY() / 2);
@@ -185,13 +189,16 @@ void PointcloudBasedOccupancyGridMapNode::onPointcloudWithObstacleAndRaw(
 
     // publish
     occupancy_grid_map_pub_->publish(OccupancyGridMapToMsgPtr(
-      map_frame_, input_raw_msg->header.stamp, pose.position.z, *occupancy_grid_map_updater_ptr_));
+      map_frame_, input_raw_msg->header.stamp, pose.position.z, *occupancy_grid_map_updater_ptr_,
+      occupancy_grid_map_updater_ptr_->getRingOffsetX(),
+      occupancy_grid_map_updater_ptr_->getRingOffsetY()));
   }
 }
 
 OccupancyGrid::UniquePtr PointcloudBasedOccupancyGridMapNode::OccupancyGridMapToMsgPtr(
   const std::string & frame_id, const Time & stamp, const float & robot_pose_z,
-  const Costmap2D & occupancy_grid_map)
+  const Costmap2D & occupancy_grid_map, const unsigned int ring_offset_x,
+  const unsigned int ring_offset_y)
 {
   auto msg_ptr = std::make_unique<OccupancyGrid>();
 
@@ -212,9 +219,22 @@ OccupancyGrid::UniquePtr PointcloudBasedOccupancyGridMapNode::OccupancyGridMapTo
 
   msg_ptr->data.resize(msg_ptr->info.width * msg_ptr->info.height);
 
+  // a ring buffered map is unrolled while translating the costs
   unsigned char * data = occupancy_grid_map.getCharMap();
-  for (unsigned int i = 0; i < msg_ptr->data.size(); ++i) {
-    msg_ptr->data[i] = occupancy_cost_value::cost_translation_table[data[i]];
+  const unsigned int width = msg_ptr->info.width;
+  const unsigned int height = msg_ptr->info.height;
+  const unsigned int split_x = width - ring_offset_x;
+  for (unsigned int y = 0; y < height; ++y) {
+    const unsigned int storage_y =
+      y < height - ring_offset_y ? y + ring_offset_y : y + ring_offset_y - height;
+    const unsigned char * row = data + storage_y * width;
+    auto msg_row = msg_ptr->data.begin() + y * width;
+    for (unsigned int x = 0; x < split_x; ++x) {
+      msg_row[x] = occupancy_cost_value::cost_translation_table[row[x + ring_offset_x]];
+    }
+    for (unsigned int x = split_x; x < width; ++x) {
+      msg_row[x] = occupancy_cost_value::cost_translation_table[row[x - split_x]];
+    }
   }
   return msg_ptr;
 }
@@ -20,6 +20,27 @@
 
 namespace costmap_2d
 {
+OccupancyGridMapBBFUpdater::OccupancyGridMapBBFUpdater(
+  const unsigned int cells_size_x, const unsigned int cells_size_y, const float resolution,
+  const bool use_ring_buffer, const bool use_parallel_update)
+: OccupancyGridMapUpdaterInterface(cells_size_x, cells_size_y, resolution, use_ring_buffer),
+  use_parallel_update_(use_parallel_update)
+{
+  probability_matrix_(Index::OCCUPIED, Index::OCCUPIED) = 0.95;
+  probability_matrix_(Index::FREE, Index::OCCUPIED) = 1.0 - probability_matrix_(OCCUPIED, OCCUPIED);
+  probability_matrix_(Index::FREE, Index::FREE) = 0.8;
+  probability_matrix_(Index::OCCUPIED, Index::FREE) = 1.0 - probability_matrix_(FREE, FREE);
+
+  // the update of a cell only depends on the two costs, so it is computed once for all of them
+  bbf_table_.resize(256U * 256U);
+  for (unsigned int z = 0; z < 256U; z++) {
+    for (unsigned int o = 0; o < 256U; o++) {
+      bbf_table_[z * 256U + o] =
+        applyBBF(static_cast<unsigned char>(z), static_cast<unsigned char>(o));
+    }
+  }
+}
+
 inline unsigned char OccupancyGridMapBBFUpdater::applyBBF(
   const unsigned char & z, const unsigned char & o)
 {
@@ -49,10 +70,21 @@ bool OccupancyGridMapBBFUpdater::update(const Costmap2D & single_frame_occupancy
 {
   updateOrigin(
     single_frame_occupancy_grid_map.getOriginX(), single_frame_occupancy_grid_map.getOriginY());
-  for (unsigned int x = 0; x < getSizeInCellsX(); x++) {
-    for (unsigned int y = 0; y < getSizeInCellsY(); y++) {
-      unsigned int index = getIndex(x, y);
-      costmap_[index] = applyBBF(single_frame_occupancy_grid_map.getCost(x, y), costmap_[index]);
+  const unsigned char * single_frame_costmap = single_frame_occupancy_grid_map.getCharMap();
+  // the rows are stored rotated by the ring offset, which is 0 without the ring buffer
+  const unsigned int ring_offset_x = getRingOffsetX();
+  const unsigned int split_x = size_x_ - ring_offset_x;
+  const unsigned char * bbf_table = bbf_table_.data();
+  // the rows are independent of each other
+#pragma omp parallel for if (use_parallel_update_)
+  for (unsigned int y = 0; y < size_y_; y++) {
+    const unsigned char * z = single_frame_costmap + y * size_x_;
+    unsigned char * o = costmap_ + getStorageRow(y) * size_x_;
+    for (unsigned int x = 0; x < split_x; x++) {
+      o[x + ring_offset_x] = bbf_table[(z[x] << 8U) | o[x + ring_offset_x]];
+    }
+    for (unsigned int x = split_x; x < size_x_; x++) {
+      o[x - split_x] = bbf_table[(z[x] << 8U) | o[x - split_x]];
     }
   }
   return true;
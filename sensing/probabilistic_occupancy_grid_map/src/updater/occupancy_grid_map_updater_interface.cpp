@@ -0,0 +1,73 @@
+// Copyright 2021 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "updater/occupancy_grid_map_updater_interface.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace costmap_2d
+{
+void OccupancyGridMapUpdaterInterface::updateOrigin(double new_origin_x, double new_origin_y)
+{
+  if (!use_ring_buffer_) {
+    Costmap2D::updateOrigin(new_origin_x, new_origin_y);
+    return;
+  }
+
+  // the origin moves by whole cells, as in Costmap2D::updateOrigin
+  const int cell_ox = static_cast<int>((new_origin_x - origin_x_) / resolution_);
+  const int cell_oy = static_cast<int>((new_origin_y - origin_y_) / resolution_);
+  origin_x_ = origin_x_ + cell_ox * resolution_;
+  origin_y_ = origin_y_ + cell_oy * resolution_;
+  if (cell_ox == 0 && cell_oy == 0) {
+    return;
+  }
+
+  const int size_x = static_cast<int>(size_x_);
+  const int size_y = static_cast<int>(size_y_);
+  if (std::abs(cell_ox) >= size_x || std::abs(cell_oy) >= size_y) {
+    resetMaps();
+    ring_offset_x_ = 0U;
+    ring_offset_y_ = 0U;
+    return;
+  }
+  ring_offset_x_ =
+    static_cast<unsigned int>((static_cast<int>(ring_offset_x_) + cell_ox + size_x) % size_x);
+  ring_offset_y_ =
+    static_cast<unsigned int>((static_cast<int>(ring_offset_y_) + cell_oy + size_y) % size_y);
+
+  // the cells which wrapped around to the other side of the map are the newly exposed ones
+  const unsigned int new_x_begin = cell_ox > 0 ? size_x - cell_ox : 0;
+  const unsigned int new_x_end = cell_ox > 0 ? size_x : -cell_ox;
+  const unsigned int new_y_begin = cell_oy > 0 ? size_y - cell_oy : 0;
+  const unsigned int new_y_end = cell_oy > 0 ? size_y : -cell_oy;
+  const unsigned int new_x_num = new_x_end - new_x_begin;
+  unsigned int storage_x_begin = new_x_begin + ring_offset_x_;
+  if (storage_x_begin >= size_x_) {
+    storage_x_begin -= size_x_;
+  }
+  for (unsigned int y = 0; y < size_y_; ++y) {
+    unsigned char * row = costmap_ + getStorageRow(y) * size_x_;
+    if (new_y_begin <= y && y < new_y_end) {
+      std::fill(row, row + size_x_, default_value_);
+    } else if (storage_x_begin + new_x_num <= size_x_) {
+      std::fill(row + storage_x_begin, row + storage_x_begin + new_x_num, default_value_);
+    } else {
+      std::fill(row + storage_x_begin, row + size_x_, default_value_);
+      std::fill(row, row + storage_x_begin + new_x_num - size_x_, default_value_);
+    }
+  }
+}
+}  // namespace costmap_2d
@@ -17,13 +17,19 @@
 
 #include <pcl/impl/point_types.hpp>
 
+#include <boost/optional.hpp>
+
 #include <pcl/filters/voxel_grid_occlusion_estimation.h>
 #include <tf2/LinearMath/Transform.h>
 #include <tf2/LinearMath/Vector3.h>
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -36,6 +42,8 @@ static constexpr double vertical_max_theta = (15.0 / 180.0) * M_PI;
 static constexpr double horizontal_theta_step = (0.1 / 180.0) * M_PI;
 static constexpr double horizontal_min_theta = (-180.0 / 180.0) * M_PI;
 static constexpr double horizontal_max_theta = (180.0 / 180.0) * M_PI;
+// tolerance of the sphere tracing, by which the boxes are inflated for the angular culling
+static constexpr double sphere_tracing_eps = 1e-2;
 
 pcl::PointXYZ getPointWrtBaseLink(
   const tf2::Transform & tf_base_link2moved_object, double x, double y, double z)
@@ -44,6 +52,89 @@ pcl::PointXYZ getPointWrtBaseLink(
   return pcl::PointXYZ(p_wrt_base.x(), p_wrt_base.y(), p_wrt_base.z());
 }
 
+// tan of the vertical angles, accumulated in the same way as the vertical sweep
+const std::vector<double> & getVerticalTangents()
+{
+  static const std::vector<double> tangents = [] {
+    std::vector<double> values;
+    for (double vertical_theta = vertical_min_theta; vertical_theta <= vertical_max_theta + epsilon;
+         vertical_theta += vertical_theta_step) {
+      values.push_back(std::tan(vertical_theta));
+    }
+    return values;
+  }();
+  return tangents;
+}
+
+struct HorizontalRay
+{
+  double angle;
+  double cos;
+  double sin;
+};
+
+// rays of the ego centric scan, at the angles accumulated from 0 to 2 pi
+const std::vector<HorizontalRay> & getHorizontalRays()
+{
+  static const std::vector<HorizontalRay> rays = [] {
+    const auto n_scan = static_cast<size_t>(std::floor(2 * M_PI / horizontal_theta_step));
+    std::vector<HorizontalRay> values;
+    values.reserve(n_scan);
+    double angle = 0.0;
+    for (size_t i = 0; i < n_scan; ++i) {
+      angle += horizontal_theta_step;
+      values.push_back(HorizontalRay{angle, std::cos(angle), std::sin(angle)});
+    }
+    return values;
+  }();
+  return rays;
+}
+
+double normalizeAngle(const double angle) { return std::remainder(angle, 2.0 * M_PI); }
+
+// angular range of the box seen from the origin of base_link, as the offsets of the both ends
+// from the angle of the center
+struct AngularRange
+{
+  double center_angle;
+  double min_offset;
+  double max_offset;
+
+  bool contains(const double angle) const
+  {
+    const double offset = normalizeAngle(angle - center_angle);
+    return min_offset <= offset && offset <= max_offset;
+  }
+};
+
+// nullopt if the origin is inside of the box, which is seen at all the angles
+boost::optional<AngularRange> getAngularRange(
+  const ObjectInfo & obj_info, const tf2::Transform & tf_base_link2moved_object)
+{
+  const double half_length = 0.5 * obj_info.length + sphere_tracing_eps;
+  const double half_width = 0.5 * obj_info.width + sphere_tracing_eps;
+  const auto origin_wrt_object = tf_base_link2moved_object.inverse()(tf2::Vector3(0, 0, 0));
+  if (
+    std::abs(origin_wrt_object.x()) <= half_length &&
+    std::abs(origin_wrt_object.y()) <= half_width) {
+    return {};
+  }
+
+  const auto & center = tf_base_link2moved_object.getOrigin();
+  const double center_angle = std::atan2(center.y(), center.x());
+  double min_offset = std::numeric_limits<double>::infinity();
+  double max_offset = -std::numeric_limits<double>::infinity();
+  for (const double x : {-half_length, half_length}) {
+    for (const double y : {-half_width, half_width}) {
+      const auto corner = tf_base_link2moved_object(tf2::Vector3(x, y, 0.0));
+      const double offset = normalizeAngle(std::atan2(corner.y(), corner.x()) - center_angle);
+      min_offset = std::min(min_offset, offset);
+      max_offset = std::max(max_offset, offset);
+    }
+  }
+  return AngularRange{center_angle, min_offset, max_offset};
+}
+
 }  // namespace
 
 void ObjectCentricPointCloudCreator::create_object_pointcloud(
@@ -122,9 +213,8 @@ void ObjectCentricPointCloudCreator::create_object_pointcloud(
       const double distance = std::hypot(
         horizontal_candidate_pointcloud.at(pointcloud_index).x,
         horizontal_candidate_pointcloud.at(pointcloud_index).y);
-      for (double vertical_theta = vertical_min_theta;
-           vertical_theta <= vertical_max_theta + epsilon; vertical_theta += vertical_theta_step) {
-        const double z = distance * std::tan(vertical_theta);
+      for (const double tangent : getVerticalTangents()) {
+        const double z = distance * tangent;
         if (min_z <= z && z <= max_z + epsilon) {
           pcl::PointXYZ point;
           point.x =
@@ -205,7 +295,6 @@ std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> EgoCentricPointCloudCreator::cr
       obj_info.length, obj_info.width, tf_base_link2map * obj_info.tf_map2moved_object);
     sdf_ptrs.push_back(sdf_ptr);
   }
-  const auto composite_sdf = signed_distance_function::CompositeSDF(sdf_ptrs);
 
   std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> pointclouds(obj_infos.size());
   for (size_t i = 0; i < obj_infos.size(); ++i) {
@@ -224,26 +313,79 @@ std::vector<pcl::PointCloud<pcl::PointXYZ>::Ptr> EgoCentricPointCloudCreator::cr
     max_zs.at(idx) = max_z;
   }
 
-  double angle = 0.0;
-  const auto n_scan = static_cast<size_t>(std::floor(2 * M_PI / horizontal_theta_step));
-  for (size_t i = 0; i < n_scan; ++i) {
-    angle += horizontal_theta_step;
-    const auto dist = composite_sdf.getSphereTracingDist(0.0, 0.0, angle, visible_range_);
+  // The rays are traced only against the objects in whose angular range they are, so the rays are
+  // grouped into the sectors of the same objects, each of which has the SDF of its objects.
+  struct Sector
+  {
+    size_t end_ray_idx;
+    std::vector<size_t> obj_indices;
+    std::unique_ptr<signed_distance_function::CompositeSDF> sdf;
+  };
+  std::vector<boost::optional<AngularRange>> angular_ranges;
+  for (size_t idx = 0; idx < obj_infos.size(); ++idx) {
+    angular_ranges.push_back(
+      getAngularRange(obj_infos.at(idx), tf_base_link2map * obj_infos.at(idx).tf_map2moved_object));
+  }
+  const auto & rays = getHorizontalRays();
+  std::vector<Sector> sectors;
+  for (size_t i = 0; i < rays.size(); ++i) {
+    std::vector<size_t> obj_indices;
+    for (size_t idx = 0; idx < obj_infos.size(); ++idx) {
+      const auto & range = angular_ranges.at(idx);
+      if (!range || range->contains(rays.at(i).angle)) {
+        obj_indices.push_back(idx);
+      }
+    }
+    if (!sectors.empty() && sectors.back().obj_indices == obj_indices) {
+      sectors.back().end_ray_idx = i + 1;
+    } else {
+      sectors.push_back(Sector{i + 1, std::move(obj_indices), nullptr});
+    }
+  }
+  std::vector<size_t> ray_sector_indices(rays.size());
+  for (size_t sector_idx = 0, i = 0; sector_idx < sectors.size(); ++sector_idx) {
+    auto & sector = sectors.at(sector_idx);
+    if (!sector.obj_indices.empty()) {
+      std::vector<std::shared_ptr<signed_distance_function::AbstractSignedDistanceFunction>>
+        sector_sdf_ptrs;
+      for (const auto idx : sector.obj_indices) {
+        sector_sdf_ptrs.push_back(sdf_ptrs.at(idx));
+      }
+      sector.sdf = std::make_unique<signed_distance_function::CompositeSDF>(sector_sdf_ptrs);
+    }
+    for (; i < sector.end_ray_idx; ++i) {
+      ray_sector_indices.at(i) = sector_idx;
+    }
+  }
+
+  // every ray is traced by a single thread, and the noise is added in the order of the rays
+  std::vector<double> dists(rays.size(), std::numeric_limits<double>::infinity());
+#pragma omp parallel for
+  for (size_t i = 0; i < rays.size(); ++i) {
+    const auto & sector = sectors[ray_sector_indices[i]];
+    if (sector.sdf) {
+      dists[i] = sector.sdf->getSphereTracingDist(
+        0.0, 0.0, rays[i].angle, visible_range_, sphere_tracing_eps);
+    }
+  }
+
+  for (size_t i = 0; i < rays.size(); ++i) {
+    const auto dist = dists.at(i);
 
     if (std::isfinite(dist)) {
-      const auto x_hit = dist * cos(angle);
-      const auto y_hit = dist * sin(angle);
-      const auto idx_hit = composite_sdf.nearest_sdf_index(x_hit, y_hit);
-      const auto obj_info_here = obj_infos.at(idx_hit);
+      const auto & sector = sectors.at(ray_sector_indices.at(i));
+      const auto x_hit = dist * rays.at(i).cos;
+      const auto y_hit = dist * rays.at(i).sin;
+      const auto idx_hit = sector.obj_indices.at(sector.sdf->nearest_sdf_index(x_hit, y_hit));
+      const auto & obj_info_here = obj_infos.at(idx_hit);
       const auto min_z_here = min_zs.at(idx_hit);
       const auto max_z_here = max_zs.at(idx_hit);
       std::normal_distribution<> x_random(0.0, obj_info_here.std_dev_x);
       std::normal_distribution<> y_random(0.0, obj_info_here.std_dev_y);
       std::normal_distribution<> z_random(0.0, obj_info_here.std_dev_z);
 
-      for (double vertical_theta = vertical_min_theta;
-           vertical_theta <= vertical_max_theta + epsilon; vertical_theta += vertical_theta_step) {
-        const double z = dist * std::tan(vertical_theta);
+      for (const double tangent : getVerticalTangents()) {
+        const double z = dist * tangent;
         if (min_z_here <= z && z <= max_z_here + epsilon) {
           pointclouds.at(idx_hit)->push_back(pcl::PointXYZ(
             x_hit + x_random(random_generator), y_hit + y_random(random_generator),
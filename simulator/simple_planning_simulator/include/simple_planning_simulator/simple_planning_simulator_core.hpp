@@ -42,6 +42,7 @@
 #include "geometry_msgs/msg/transform_stamped.hpp"
 #include "geometry_msgs/msg/twist.hpp"
 #include "nav_msgs/msg/odometry.hpp"
+#include "rosgraph_msgs/msg/clock.hpp"
 #include "tier4_external_api_msgs/srv/initialize_pose.hpp"
 #include "tier4_vehicle_msgs/msg/control_mode.hpp"
 #include "tier4_vehicle_msgs/srv/control_mode_request.hpp"
@@ -83,6 +84,7 @@ using geometry_msgs::msg::PoseWithCovarianceStamped;
 using geometry_msgs::msg::TransformStamped;
 using geometry_msgs::msg::Twist;
 using nav_msgs::msg::Odometry;
+using rosgraph_msgs::msg::Clock;
 using tier4_external_api_msgs::srv::InitializePose;
 using tier4_vehicle_msgs::msg::ControlMode;
 using tier4_vehicle_msgs::srv::ControlModeRequest;
@@ -135,6 +137,7 @@ private:
   rclcpp::Publisher<HazardLightsReport>::SharedPtr pub_hazard_lights_report_;
   rclcpp::Publisher<tf2_msgs::msg::TFMessage>::SharedPtr pub_tf_;
   rclcpp::Publisher<PoseStamped>::SharedPtr pub_current_pose_;
+  rclcpp::Publisher<Clock>::SharedPtr pub_clock_;
 
   rclcpp::Subscription<GearCommand>::SharedPtr sub_gear_cmd_;
   rclcpp::Subscription<GearCommand>::SharedPtr sub_manual_gear_cmd_;
@@ -155,6 +158,10 @@ private:
   uint32_t timer_sampling_time_ms_;        //!< @brief timer sampling time
   rclcpp::TimerBase::SharedPtr on_timer_;  //!< @brief timer for simulation
 
+  /* lockstep */
+  bool8_t enable_lockstep_;      //!< @brief flag to advance the simulation by the control command
+  rclcpp::Time lockstep_time_;  //!< @brief simulation time published on /clock in lockstep mode
+
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
   rcl_interfaces::msg::SetParametersResult on_parameter(
     const std::vector<rclcpp::Parameter> & parameters);
@@ -273,6 +280,30 @@ private:
    */
   void on_timer();
 
+  /**
+   * @brief advance the lockstep simulation, if the command is for the current simulation time
+   * @param [in] stamp timestamp of the received control command
+   */
+  void on_lockstep_command(const rclcpp::Time & stamp);
+
+  /**
+   * @brief advance the simulation time by timer_sampling_time_ms and publish it on /clock. It is
+   * called when the control command for the previous step is received, or on the timeout.
+   */
+  void step_lockstep();
+
+  /**
+   * @brief update the vehicle dynamics and publish the vehicle state
+   * @param [in] dt time step of the vehicle model
+   */
+  void simulate_step(const float64_t dt);
+
+  /**
+   * @brief get the timestamp of the published messages, which is the simulation time in lockstep
+   * mode and the time of the node clock otherwise
+   */
+  rclcpp::Time get_current_time();
+
   /**
    * @brief initialize vehicle_model_ptr
    */
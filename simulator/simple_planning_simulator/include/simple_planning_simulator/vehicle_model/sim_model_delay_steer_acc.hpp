@@ -137,6 +137,14 @@ private:
    * @param [in] input input vector to model
    */
   Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
+
+  /**
+   * @brief calculate derivatives of states of rollouts with time delay steering model
+   * @param [in] states model states, a row for each rollout
+   * @param [in] inputs input vectors to model, a row for each rollout
+   */
+  Eigen::MatrixXd calcModelBatch(
+    const Eigen::MatrixXd & states, const Eigen::MatrixXd & inputs) override;
 };
 
 #endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_DELAY_STEER_ACC_HPP_
@@ -138,6 +138,14 @@ private:
    */
   Eigen::VectorXd calcModel(const Eigen::VectorXd & state, const Eigen::VectorXd & input) override;
 
+  /**
+   * @brief calculate derivatives of states of rollouts with time delay steering model
+   * @param [in] states model states, a row for each rollout
+   * @param [in] inputs input vectors to model, a row for each rollout
+   */
+  Eigen::MatrixXd calcModelBatch(
+    const Eigen::MatrixXd & states, const Eigen::MatrixXd & inputs) override;
+
   /**
    * @brief update state considering current gear
    * @param [in] state current state
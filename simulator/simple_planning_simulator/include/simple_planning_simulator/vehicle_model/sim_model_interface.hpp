@@ -96,6 +96,16 @@ public:
    */
   void updateEuler(const float64_t & dt, const Eigen::VectorXd & input);
 
+  /**
+   * @brief update states of independent rollouts with Runge-Kutta methods, e.g. for parameter
+   * sweeps. The state of the model, the input delay and the gear of update() are not used.
+   * @param [in] dt delta time [s]
+   * @param [in] inputs vehicle inputs, a row for each rollout
+   * @param [inout] states vehicle states, a row for each rollout
+   */
+  void updateRungeKuttaBatch(
+    const float64_t & dt, const Eigen::MatrixXd & inputs, Eigen::MatrixXd & states);
+
   /**
    * @brief update vehicle states
    * @param [in] dt delta time [s]
@@ -164,6 +174,16 @@ public:
    */
   virtual Eigen::VectorXd calcModel(
     const Eigen::VectorXd & state, const Eigen::VectorXd & input) = 0;
+
+  /**
+   * @brief calculate derivatives of states of rollouts with vehicle model, by calcModel() for each
+   * rollout unless the model computes the columns, which are the state elements of all the
+   * rollouts, as arrays
+   * @param [in] states model states, a row for each rollout
+   * @param [in] inputs input vectors to model, a row for each rollout
+   */
+  virtual Eigen::MatrixXd calcModelBatch(
+    const Eigen::MatrixXd & states, const Eigen::MatrixXd & inputs);
 };
 
 #endif  // SIMPLE_PLANNING_SIMULATOR__VEHICLE_MODEL__SIM_MODEL_INTERFACE_HPP_
@@ -89,10 +89,20 @@ SimplePlanningSimulator::SimplePlanningSimulator(const rclcpp::NodeOptions & opt
     "/initialpose", QoS{1}, std::bind(&SimplePlanningSimulator::on_initialpose, this, _1));
   sub_ackermann_cmd_ = create_subscription<AckermannControlCommand>(
     "input/ackermann_control_command", QoS{1},
-    [this](const AckermannControlCommand::SharedPtr msg) { current_ackermann_cmd_ = *msg; });
+    [this](const AckermannControlCommand::SharedPtr msg) {
+      current_ackermann_cmd_ = *msg;
+      if (current_control_mode_.data == ControlMode::AUTO) {
+        on_lockstep_command(msg->stamp);
+      }
+    });
   sub_manual_ackermann_cmd_ = create_subscription<AckermannControlCommand>(
     "input/manual_ackermann_control_command", QoS{1},
-    [this](const AckermannControlCommand::SharedPtr msg) { current_manual_ackermann_cmd_ = *msg; });
+    [this](const AckermannControlCommand::SharedPtr msg) {
+      current_manual_ackermann_cmd_ = *msg;
+      if (current_control_mode_.data != ControlMode::AUTO) {
+        on_lockstep_command(msg->stamp);
+      }
+    });
   sub_gear_cmd_ = create_subscription<GearCommand>(
     "input/gear_command", QoS{1},
     [this](const GearCommand::SharedPtr msg) { current_gear_cmd_ = *msg; });
@@ -135,9 +145,27 @@ SimplePlanningSimulator::SimplePlanningSimulator(const rclcpp::NodeOptions & opt
     std::bind(&SimplePlanningSimulator::on_parameter, this, _1));
 
   timer_sampling_time_ms_ = static_cast<uint32_t>(declare_parameter("timer_sampling_time_ms", 25));
-  on_timer_ = rclcpp::create_timer(
-    this, get_clock(), std::chrono::milliseconds(timer_sampling_time_ms_),
-    std::bind(&SimplePlanningSimulator::on_timer, this));
+  enable_lockstep_ = declare_parameter("enable_lockstep", false);
+  if (enable_lockstep_) {
+    // The simulation time is owned by this node and advanced step by step, so the other nodes
+    // running with use_sim_time follow it as fast as they process the steps. The timeout keeps the
+    // time running while no control command is published, e.g. before the controller starts.
+    const auto lockstep_timeout_ms =
+      static_cast<uint32_t>(declare_parameter("lockstep_timeout_ms", 100));
+    const auto now = rclcpp::Clock(RCL_SYSTEM_TIME).now();
+    lockstep_time_ = rclcpp::Time(now.nanoseconds(), RCL_ROS_TIME);
+    pub_clock_ = create_publisher<Clock>("/clock", rclcpp::ClockQoS());
+    Clock clock;
+    clock.clock = lockstep_time_;
+    pub_clock_->publish(clock);
+    on_timer_ = create_wall_timer(
+      std::chrono::milliseconds(lockstep_timeout_ms),
+      std::bind(&SimplePlanningSimulator::step_lockstep, this));
+  } else {
+    on_timer_ = rclcpp::create_timer(
+      this, get_clock(), std::chrono::milliseconds(timer_sampling_time_ms_),
+      std::bind(&SimplePlanningSimulator::on_timer, this));
+  }
 
   tier4_api_utils::ServiceProxyNodeInterface proxy(this);
   group_api_service_ = create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
@@ -255,10 +283,43 @@ void SimplePlanningSimulator::on_timer()
     return;
   }
 
+  simulate_step(delta_time_.get_dt(get_clock()->now()));
+}
+
+void SimplePlanningSimulator::on_lockstep_command(const rclcpp::Time & stamp)
+{
+  // the commands computed before the latest step are not for it
+  if (enable_lockstep_ && stamp >= lockstep_time_) {
+    step_lockstep();
+  }
+}
+
+void SimplePlanningSimulator::step_lockstep()
+{
+  lockstep_time_ += rclcpp::Duration(std::chrono::milliseconds(timer_sampling_time_ms_));
+
+  // the state of the step is published before the time, so that it is received by the nodes
+  // triggered by the time
+  if (is_initialized_) {
+    simulate_step(timer_sampling_time_ms_ / 1000.0);
+  }
+  Clock clock;
+  clock.clock = lockstep_time_;
+  pub_clock_->publish(clock);
+
+  // the timeout is counted from the latest step
+  on_timer_->reset();
+}
+
+rclcpp::Time SimplePlanningSimulator::get_current_time()
+{
+  return enable_lockstep_ ? lockstep_time_ : get_clock()->now();
+}
+
+void SimplePlanningSimulator::simulate_step(const float64_t dt)
+{
   // update vehicle dynamics
   {
-    const float64_t dt = delta_time_.get_dt(get_clock()->now());
-
     if (current_control_mode_.data == ControlMode::AUTO) {
       vehicle_model_ptr_->setGear(current_gear_cmd_.command);
       set_input(current_ackermann_cmd_);
@@ -499,7 +560,7 @@ TransformStamped SimplePlanningSimulator::get_transform_msg(
 void SimplePlanningSimulator::publish_velocity(const VelocityReport & velocity)
 {
   VelocityReport msg = velocity;
-  msg.header.stamp = get_clock()->now();
+  msg.header.stamp = get_current_time();
   msg.header.frame_id = simulated_frame_id_;
   pub_velocity_->publish(msg);
 }
@@ -508,7 +569,7 @@ void SimplePlanningSimulator::publish_odometry(const Odometry & odometry)
 {
   Odometry msg = odometry;
   msg.header.frame_id = origin_frame_id_;
-  msg.header.stamp = get_clock()->now();
+  msg.header.stamp = get_current_time();
   msg.child_frame_id = simulated_frame_id_;
   pub_odom_->publish(msg);
 }
@@ -516,7 +577,7 @@ void SimplePlanningSimulator::publish_odometry(const Odometry & odometry)
 void SimplePlanningSimulator::publish_steering(const SteeringReport & steer)
 {
   SteeringReport msg = steer;
-  msg.stamp = get_clock()->now();
+  msg.stamp = get_current_time();
   pub_steer_->publish(msg);
 }
 
@@ -524,7 +585,7 @@ void SimplePlanningSimulator::publish_acceleration()
 {
   AccelWithCovarianceStamped msg;
   msg.header.frame_id = "/base_link";
-  msg.header.stamp = get_clock()->now();
+  msg.header.stamp = get_current_time();
   msg.accel.accel.linear.x = vehicle_model_ptr_->getAx();
 
   constexpr auto COV = 0.001;
@@ -540,7 +601,7 @@ void SimplePlanningSimulator::publish_acceleration()
 void SimplePlanningSimulator::publish_control_mode_report()
 {
   ControlModeReport msg;
-  msg.stamp = get_clock()->now();
+  msg.stamp = get_current_time();
   if (current_control_mode_.data == ControlMode::AUTO) {
     msg.mode = ControlModeReport::AUTONOMOUS;
   } else {
@@ -552,7 +613,7 @@ void SimplePlanningSimulator::publish_control_mode_report()
 void SimplePlanningSimulator::publish_gear_report()
 {
   GearReport msg;
-  msg.stamp = get_clock()->now();
+  msg.stamp = get_current_time();
   msg.report = vehicle_model_ptr_->getGear();
   pub_gear_report_->publish(msg);
 }
@@ -563,7 +624,7 @@ void SimplePlanningSimulator::publish_turn_indicators_report()
     return;
   }
   TurnIndicatorsReport msg;
-  msg.stamp = get_clock()->now();
+  msg.stamp = get_current_time();
   msg.report = current_turn_indicators_cmd_ptr_->command;
   pub_turn_indicators_report_->publish(msg);
 }
@@ -574,7 +635,7 @@ void SimplePlanningSimulator::publish_hazard_lights_report()
     return;
   }
   HazardLightsReport msg;
-  msg.stamp = get_clock()->now();
+  msg.stamp = get_current_time();
   msg.report = current_hazard_lights_cmd_ptr_->command;
   pub_hazard_lights_report_->publish(msg);
 }
@@ -582,7 +643,7 @@ void SimplePlanningSimulator::publish_hazard_lights_report()
 void SimplePlanningSimulator::publish_tf(const Odometry & odometry)
 {
   TransformStamped tf;
-  tf.header.stamp = get_clock()->now();
+  tf.header.stamp = get_current_time();
   tf.header.frame_id = origin_frame_id_;
   tf.child_frame_id = simulated_frame_id_;
   tf.transform.translation.x = odometry.pose.pose.position.x;
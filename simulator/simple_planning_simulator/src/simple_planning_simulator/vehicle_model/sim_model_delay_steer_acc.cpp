@@ -97,3 +97,28 @@ Eigen::VectorXd SimModelDelaySteerAcc::calcModel(
 
   return d_state;
 }
+
+Eigen::MatrixXd SimModelDelaySteerAcc::calcModelBatch(
+  const Eigen::MatrixXd & states, const Eigen::MatrixXd & inputs)
+{
+  const Eigen::ArrayXd vel = states.col(IDX::VX).array().min(vx_lim_).max(-vx_lim_);
+  const Eigen::ArrayXd acc = states.col(IDX::ACCX).array().min(vx_rate_lim_).max(-vx_rate_lim_);
+  const auto yaw = states.col(IDX::YAW).array();
+  const auto steer = states.col(IDX::STEER).array();
+  const Eigen::ArrayXd acc_des =
+    inputs.col(IDX_U::ACCX_DES).array().min(vx_rate_lim_).max(-vx_rate_lim_);
+  const Eigen::ArrayXd steer_des =
+    inputs.col(IDX_U::STEER_DES).array().min(steer_lim_).max(-steer_lim_);
+  const Eigen::ArrayXd steer_rate =
+    (-(steer - steer_des) / steer_time_constant_).min(steer_rate_lim_).max(-steer_rate_lim_);
+
+  Eigen::ArrayXXd d_states = Eigen::ArrayXXd::Zero(states.rows(), dim_x_);
+  d_states.col(IDX::X) = vel * yaw.cos();
+  d_states.col(IDX::Y) = vel * yaw.sin();
+  d_states.col(IDX::YAW) = vel * steer.tan() / wheelbase_;
+  d_states.col(IDX::VX) = acc;
+  d_states.col(IDX::STEER) = steer_rate;
+  d_states.col(IDX::ACCX) = -(acc - acc_des) / acc_time_constant_;
+
+  return d_states.matrix();
+}
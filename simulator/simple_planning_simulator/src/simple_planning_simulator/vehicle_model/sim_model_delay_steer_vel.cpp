@@ -100,3 +100,28 @@ Eigen::VectorXd SimModelDelaySteerVel::calcModel(
 
   return d_state;
 }
+
+Eigen::MatrixXd SimModelDelaySteerVel::calcModelBatch(
+  const Eigen::MatrixXd & states, const Eigen::MatrixXd & inputs)
+{
+  const Eigen::ArrayXd vx = states.col(IDX::VX).array().min(vx_lim_).max(-vx_lim_);
+  const Eigen::ArrayXd steer = states.col(IDX::STEER).array().min(steer_lim_).max(-steer_lim_);
+  const auto yaw = states.col(IDX::YAW).array();
+  const Eigen::ArrayXd delay_vx_des =
+    inputs.col(IDX_U::VX_DES).array().min(vx_lim_).max(-vx_lim_);
+  const Eigen::ArrayXd delay_steer_des =
+    inputs.col(IDX_U::STEER_DES).array().min(steer_lim_).max(-steer_lim_);
+  const Eigen::ArrayXd vx_rate =
+    (-(vx - delay_vx_des) / vx_time_constant_).min(vx_rate_lim_).max(-vx_rate_lim_);
+  const Eigen::ArrayXd steer_rate =
+    (-(steer - delay_steer_des) / steer_time_constant_).min(steer_rate_lim_).max(-steer_rate_lim_);
+
+  Eigen::ArrayXXd d_states = Eigen::ArrayXXd::Zero(states.rows(), dim_x_);
+  d_states.col(IDX::X) = vx * yaw.cos();
+  d_states.col(IDX::Y) = vx * yaw.sin();
+  d_states.col(IDX::YAW) = vx * steer.tan() / wheelbase_;
+  d_states.col(IDX::VX) = vx_rate;
+  d_states.col(IDX::STEER) = steer_rate;
+
+  return d_states.matrix();
+}
@@ -48,3 +48,20 @@ Eigen::VectorXd SimModelIdealSteerAcc::calcModel(
 
   return d_state;
 }
+
+Eigen::MatrixXd SimModelIdealSteerAcc::calcModelBatch(
+  const Eigen::MatrixXd & states, const Eigen::MatrixXd & inputs)
+{
+  const auto vx = states.col(IDX::VX).array();
+  const auto yaw = states.col(IDX::YAW).array();
+  const auto ax = inputs.col(IDX_U::AX_DES).array();
+  const auto steer = inputs.col(IDX_U::STEER_DES).array();
+
+  Eigen::ArrayXXd d_states = Eigen::ArrayXXd::Zero(states.rows(), dim_x_);
+  d_states.col(IDX::X) = vx * yaw.cos();
+  d_states.col(IDX::Y) = vx * yaw.sin();
+  d_states.col(IDX::VX) = ax;
+  d_states.col(IDX::YAW) = vx * steer.tan() / wheelbase_;
+
+  return d_states.matrix();
+}
@@ -61,6 +61,23 @@ Eigen::VectorXd SimModelIdealSteerAccGeared::calcModel(
   return d_state;
 }
 
+Eigen::MatrixXd SimModelIdealSteerAccGeared::calcModelBatch(
+  const Eigen::MatrixXd & states, const Eigen::MatrixXd & inputs)
+{
+  const auto vx = states.col(IDX::VX).array();
+  const auto yaw = states.col(IDX::YAW).array();
+  const auto ax = inputs.col(IDX_U::AX_DES).array();
+  const auto steer = inputs.col(IDX_U::STEER_DES).array();
+
+  Eigen::ArrayXXd d_states = Eigen::ArrayXXd::Zero(states.rows(), dim_x_);
+  d_states.col(IDX::X) = vx * yaw.cos();
+  d_states.col(IDX::Y) = vx * yaw.sin();
+  d_states.col(IDX::VX) = ax;
+  d_states.col(IDX::YAW) = vx * steer.tan() / wheelbase_;
+
+  return d_states.matrix();
+}
+
 void SimModelIdealSteerAccGeared::updateStateWithGear(
   Eigen::VectorXd & state, const Eigen::VectorXd & prev_state, const uint8_t gear, const double dt)
 {
@@ -51,3 +51,18 @@ Eigen::VectorXd SimModelIdealSteerVel::calcModel(
 
   return d_state;
 }
+
+Eigen::MatrixXd SimModelIdealSteerVel::calcModelBatch(
+  const Eigen::MatrixXd & states, const Eigen::MatrixXd & inputs)
+{
+  const auto yaw = states.col(IDX::YAW).array();
+  const auto vx = inputs.col(IDX_U::VX_DES).array();
+  const auto steer = inputs.col(IDX_U::STEER_DES).array();
+
+  Eigen::ArrayXXd d_states = Eigen::ArrayXXd::Zero(states.rows(), dim_x_);
+  d_states.col(IDX::X) = vx * yaw.cos();
+  d_states.col(IDX::Y) = vx * yaw.sin();
+  d_states.col(IDX::YAW) = vx * steer.tan() / wheelbase_;
+
+  return d_states.matrix();
+}
@@ -14,6 +14,8 @@
 
 #include "simple_planning_simulator/vehicle_model/sim_model_interface.hpp"
 
+#include <algorithm>
+
 SimModelInterface::SimModelInterface(int dim_x, int dim_u) : dim_x_(dim_x), dim_u_(dim_u)
 {
   state_ = Eigen::VectorXd::Zero(dim_x_);
@@ -29,6 +31,33 @@ void SimModelInterface::updateRungeKutta(const float64_t & dt, const Eigen::Vect
 
   state_ += 1.0 / 6.0 * (k1 + 2.0 * k2 + 2.0 * k3 + k4) * dt;
 }
+void SimModelInterface::updateRungeKuttaBatch(
+  const float64_t & dt, const Eigen::MatrixXd & inputs, Eigen::MatrixXd & states)
+{
+  // the rollouts are updated in blocks, so that the intermediate states stay in the cache
+  constexpr Eigen::Index block_size = 128;
+  for (Eigen::Index i = 0; i < states.rows(); i += block_size) {
+    const auto n = std::min(block_size, states.rows() - i);
+    const Eigen::MatrixXd input = inputs.middleRows(i, n);
+    auto state = states.middleRows(i, n);
+
+    const Eigen::MatrixXd k1 = calcModelBatch(state, input);
+    const Eigen::MatrixXd k2 = calcModelBatch(state + k1 * 0.5 * dt, input);
+    const Eigen::MatrixXd k3 = calcModelBatch(state + k2 * 0.5 * dt, input);
+    const Eigen::MatrixXd k4 = calcModelBatch(state + k3 * dt, input);
+
+    state += 1.0 / 6.0 * (k1 + 2.0 * k2 + 2.0 * k3 + k4) * dt;
+  }
+}
+Eigen::MatrixXd SimModelInterface::calcModelBatch(
+  const Eigen::MatrixXd & states, const Eigen::MatrixXd & inputs)
+{
+  Eigen::MatrixXd d_states(states.rows(), dim_x_);
+  for (Eigen::Index i = 0; i < states.rows(); ++i) {
+    d_states.row(i) = calcModel(states.row(i).transpose(), inputs.row(i).transpose()).transpose();
+  }
+  return d_states;
+}
 void SimModelInterface::updateEuler(const float64_t & dt, const Eigen::VectorXd & input)
 {
   state_ += calcModel(state_, input) * dt;
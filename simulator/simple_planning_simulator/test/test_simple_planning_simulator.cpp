@@ -14,6 +14,7 @@
 
 #include "gtest/gtest.h"
 #include "simple_planning_simulator/simple_planning_simulator_core.hpp"
+#include "simple_planning_simulator/vehicle_model/sim_model.hpp"
 #include "tf2/utils.h"
 
 #ifdef ROS_DISTRO_GALACTIC
@@ -23,6 +24,7 @@
 #endif
 
 #include <memory>
+#include <vector>
 
 using autoware_auto_control_msgs::msg::AckermannControlCommand;
 using autoware_auto_vehicle_msgs::msg::GearCommand;
@@ -267,6 +269,97 @@ TEST_P(TestSimplePlanningSimulator, TestIdealSteerVel)
   rclcpp::shutdown();
 }
 
+// Send control commands in lockstep mode.
+// Then check if the simulation advances by a step only for the commands of the current time.
+TEST(TestSimplePlanningSimulatorLockstep, TestStepByCommand)
+{
+  rclcpp::init(0, nullptr);
+
+  rclcpp::NodeOptions node_options;
+  node_options.append_parameter_override("initialize_source", "ORIGIN");
+  node_options.append_parameter_override("vehicle_model_type", "IDEAL_STEER_VEL");
+  node_options.append_parameter_override("initial_engage_state", true);
+  node_options.append_parameter_override("add_measurement_noise", false);
+  node_options.append_parameter_override("enable_lockstep", true);
+  node_options.append_parameter_override("lockstep_timeout_ms", 100000);
+  declareVehicleInfoParams(node_options);
+  const auto sim_node = std::make_shared<SimplePlanningSimulator>(node_options);
+
+  const auto pub_sub_node = std::make_shared<PubSubNode>();
+  std::vector<rclcpp::Time> odom_stamps;
+  const auto odom_sub = pub_sub_node->create_subscription<Odometry>(
+    "output/odometry", rclcpp::QoS{10},
+    [&odom_stamps](const Odometry::SharedPtr msg) { odom_stamps.emplace_back(msg->header.stamp); });
+
+  const auto sendCommandOnce = [&](const AckermannControlCommand & cmd) {
+    pub_sub_node->pub_ackermann_command_->publish(cmd);
+    std::this_thread::sleep_for(std::chrono::milliseconds{10LL});
+    rclcpp::spin_some(sim_node);
+    std::this_thread::sleep_for(std::chrono::milliseconds{10LL});
+    rclcpp::spin_some(pub_sub_node);
+  };
+
+  // the commands stamped after the simulation time are for the current step
+  const auto future = rclcpp::Clock(RCL_SYSTEM_TIME).now() + rclcpp::Duration::from_seconds(3600.0);
+  for (int i = 0; i < 10; ++i) {
+    sendCommandOnce(cmdGen(future, 0.0f, 0.0f, 5.0f, 5.0f, 0.0f));
+  }
+  ASSERT_FALSE(odom_stamps.empty());
+  for (const auto & stamp : odom_stamps) {
+    const auto elapsed = (stamp - odom_stamps.front()).nanoseconds();
+    EXPECT_EQ(elapsed % 25000000, 0);
+  }
+  EXPECT_GT(pub_sub_node->current_odom_->twist.twist.linear.x, 4.0);
+
+  // the commands stamped before the simulation time are not
+  const auto num_steps = odom_stamps.size();
+  for (int i = 0; i < 10; ++i) {
+    sendCommandOnce(cmdGen(rclcpp::Time(0, 0, RCL_ROS_TIME), 0.0f, 0.0f, 5.0f, 5.0f, 0.0f));
+  }
+  EXPECT_EQ(odom_stamps.size(), num_steps);
+
+  rclcpp::shutdown();
+}
+
+// Update the states of rollouts at once.
+// Then check if they are the same as the ones updated one by one.
+TEST(TestSimplePlanningSimulatorBatch, TestUpdateRungeKuttaBatch)
+{
+  const std::vector<std::shared_ptr<SimModelInterface>> models = {
+    std::make_shared<SimModelIdealSteerVel>(3.0),
+    std::make_shared<SimModelIdealSteerAcc>(3.0),
+    std::make_shared<SimModelIdealSteerAccGeared>(3.0),
+    std::make_shared<SimModelDelaySteerVel>(10.0, 0.6, 5.0, 1.0, 3.0, 0.03, 0.1, 0.2, 0.1, 0.3),
+    std::make_shared<SimModelDelaySteerAcc>(10.0, 0.6, 5.0, 1.0, 3.0, 0.03, 0.1, 0.2, 0.1, 0.3),
+    std::make_shared<SimModelDelaySteerAccGeared>(
+      10.0, 0.6, 5.0, 1.0, 3.0, 0.03, 0.1, 0.2, 0.1, 0.3),
+  };
+
+  const float64_t dt = 0.03;
+  const int num_rollouts = 300;
+  for (const auto & model : models) {
+    const Eigen::MatrixXd initial_states = Eigen::MatrixXd::Random(num_rollouts, model->getDimX());
+    const Eigen::MatrixXd inputs = Eigen::MatrixXd::Random(num_rollouts, model->getDimU());
+
+    Eigen::MatrixXd states = initial_states;
+    for (int step = 0; step < 10; ++step) {
+      model->updateRungeKuttaBatch(dt, inputs, states);
+    }
+
+    for (int i = 0; i < num_rollouts; ++i) {
+      model->setState(initial_states.row(i).transpose());
+      for (int step = 0; step < 10; ++step) {
+        model->updateRungeKutta(dt, inputs.row(i).transpose());
+      }
+      Eigen::VectorXd state;
+      model->getState(state);
+      for (int j = 0; j < model->getDimX(); ++j) {
+        EXPECT_NEAR(states(i, j), state(j), 1e-9);
+      }
+    }
+  }
+}
+
 // clang-format off
 const std::string VEHICLE_MODEL_LIST[] = {   // NOLINT
   "IDEAL_STEER_VEL", "IDEAL_STEER_ACC", "IDEAL_STEER_ACC_GEARED",
@@ -31,7 +31,9 @@ def _create_api_node(node_name, class_name, **kwargs):
 def generate_launch_description():
     components = [
         _create_api_node("interface", "InterfaceNode"),
-        _create_api_node("routing", "RoutingNode"),
+        _create_api_node(
+            "routing", "RoutingNode", parameters=[{"relay_serialized_message": False}]
+        ),
     ]
     container = ComposableNodeContainer(
         namespace="default_ad_api",
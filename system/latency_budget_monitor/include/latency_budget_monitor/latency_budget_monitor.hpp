@@ -0,0 +1,139 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LATENCY_BUDGET_MONITOR__LATENCY_BUDGET_MONITOR_HPP_
+#define LATENCY_BUDGET_MONITOR__LATENCY_BUDGET_MONITOR_HPP_
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace latency_budget_monitor
+{
+struct StageParam
+{
+  std::string name;
+  double budget;  // [s]
+};
+
+struct Param
+{
+  std::vector<StageParam> stages;  // the first one carries the origin stamp
+  double end_to_end_budget;        // [s]
+  size_t window_size;
+  double histogram_bin_width;  // [s]
+  size_t histogram_bin_num;
+};
+
+/**
+ * @brief Latencies against a budget, with the percentiles of the latest window and the counts of
+ *        all the latencies in bins of a fixed width. The last bin counts the ones beyond the
+ *        others.
+ */
+class LatencyHistogram
+{
+public:
+  LatencyHistogram(
+    const double budget, const size_t window_size, const double bin_width, const size_t bin_num);
+
+  void add(const double latency);
+
+  double getBudget() const { return budget_; }
+  size_t getCount() const { return count_; }
+  size_t getOverBudgetCount() const { return over_budget_count_; }
+  const std::vector<size_t> & getBins() const { return bins_; }
+  double getBinWidth() const { return bin_width_; }
+
+  /**
+   * @brief percentile of the latencies in the window, e.g. 0.99 for p99
+   */
+  boost::optional<double> getPercentile(const double ratio) const;
+  boost::optional<double> getMax() const;
+  boost::optional<double> getLatest() const;
+
+private:
+  double budget_;
+  size_t window_size_;
+  double bin_width_;
+
+  std::deque<double> window_;
+  std::vector<size_t> bins_;
+  size_t count_{0};
+  size_t over_budget_count_{0};
+};
+
+struct StageLatency
+{
+  double stage;  // from the reception of the previous stage [s]
+  double age;    // from the origin stamp [s]
+};
+
+/**
+ * @brief Latency of a chain of stages, e.g. perception, planning, control and the gate of the
+ *        control command, from the stamp of the data of the first stage. A stage is assumed to
+ *        process the latest message of the previous stage, so the origin stamp is propagated to
+ *        each message of a stage from the latest message of the previous one. The latency of a
+ *        stage is from the reception of that message, and the end-to-end latency is the age of
+ *        the origin stamp when the last stage is received.
+ */
+class LatencyBudgetMonitor
+{
+public:
+  explicit LatencyBudgetMonitor(const Param & param);
+
+  /**
+   * @brief update with a message of the stage
+   * @param stamp_ns stamp of the message, only used for the first stage
+   * @return latency of the message, or none until the previous stages are received
+   */
+  boost::optional<StageLatency> update(
+    const size_t stage_idx, const int64_t received_ns, const int64_t stamp_ns);
+
+  size_t getStageNum() const { return param_.stages.size(); }
+  const StageParam & getStageParam(const size_t stage_idx) const
+  {
+    return param_.stages.at(stage_idx);
+  }
+  const LatencyHistogram & getStageHistogram(const size_t stage_idx) const
+  {
+    return stage_histograms_.at(stage_idx);
+  }
+  const LatencyHistogram & getEndToEndHistogram() const { return end_to_end_histogram_; }
+
+private:
+  struct LatestMessage
+  {
+    bool is_received{false};
+    int64_t origin_stamp_ns{0};
+    int64_t received_ns{0};
+  };
+
+  Param param_;
+  std::vector<LatestMessage> latest_messages_;
+  std::vector<LatencyHistogram> stage_histograms_;
+  LatencyHistogram end_to_end_histogram_;
+};
+
+/**
+ * @brief stamp of a serialized message whose first field is a builtin_interfaces/Time, e.g. the
+ *        stamp of std_msgs/Header, following the CDR encapsulation header
+ */
+boost::optional<int64_t> readLeadingStamp(const uint8_t * buffer, const size_t length);
+}  // namespace latency_budget_monitor
+
+#endif  // LATENCY_BUDGET_MONITOR__LATENCY_BUDGET_MONITOR_HPP_
@@ -0,0 +1,71 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LATENCY_BUDGET_MONITOR__LATENCY_BUDGET_MONITOR_CORE_HPP_
+#define LATENCY_BUDGET_MONITOR__LATENCY_BUDGET_MONITOR_CORE_HPP_
+
+#include "latency_budget_monitor/latency_budget_monitor.hpp"
+
+#include <diagnostic_updater/diagnostic_updater.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <tier4_debug_msgs/msg/float64_stamped.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace latency_budget_monitor
+{
+struct NodeParam
+{
+  double update_rate;
+  std::vector<std::string> topics;
+  std::vector<std::string> topic_types;
+};
+
+class LatencyBudgetMonitorNode : public rclcpp::Node
+{
+public:
+  explicit LatencyBudgetMonitorNode(const rclcpp::NodeOptions & node_options);
+
+private:
+  // Parameter
+  NodeParam node_param_;
+
+  // Core
+  std::unique_ptr<LatencyBudgetMonitor> latency_budget_monitor_;
+
+  // Subscriber
+  std::vector<rclcpp::GenericSubscription::SharedPtr> sub_stages_;
+  void onStage(const size_t stage_idx, const rclcpp::SerializedMessage & msg);
+
+  // Publisher
+  std::vector<rclcpp::Publisher<tier4_debug_msgs::msg::Float64Stamped>::SharedPtr>
+    pub_stage_latencies_;
+  rclcpp::Publisher<tier4_debug_msgs::msg::Float64Stamped>::SharedPtr pub_end_to_end_latency_;
+
+  // Timer
+  void onTimer();
+  rclcpp::TimerBase::SharedPtr timer_;
+
+  // Diagnostic Updater
+  diagnostic_updater::Updater updater_;
+
+  void checkLatency(
+    diagnostic_updater::DiagnosticStatusWrapper & stat, const LatencyHistogram & histogram);
+};
+}  // namespace latency_budget_monitor
+
+#endif  // LATENCY_BUDGET_MONITOR__LATENCY_BUDGET_MONITOR_CORE_HPP_
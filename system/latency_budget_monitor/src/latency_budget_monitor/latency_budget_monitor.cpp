@@ -0,0 +1,152 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "latency_budget_monitor/latency_budget_monitor.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace latency_budget_monitor
+{
+LatencyHistogram::LatencyHistogram(
+  const double budget, const size_t window_size, const double bin_width, const size_t bin_num)
+: budget_(budget),
+  window_size_(std::max<size_t>(window_size, 1)),
+  bin_width_(bin_width),
+  bins_(std::max<size_t>(bin_num, 1), 0)
+{
+}
+
+void LatencyHistogram::add(const double latency)
+{
+  window_.push_back(latency);
+  if (window_.size() > window_size_) {
+    window_.pop_front();
+  }
+
+  const double bin = bin_width_ > 0.0 ? std::floor(std::max(latency, 0.0) / bin_width_) : 0.0;
+  const size_t last_bin = bins_.size() - 1;
+  ++bins_.at(bin < static_cast<double>(last_bin) ? static_cast<size_t>(bin) : last_bin);
+
+  ++count_;
+  if (latency > budget_) {
+    ++over_budget_count_;
+  }
+}
+
+boost::optional<double> LatencyHistogram::getPercentile(const double ratio) const
+{
+  if (window_.empty()) {
+    return {};
+  }
+
+  std::vector<double> latencies(window_.begin(), window_.end());
+  const double clamped_ratio = std::min(std::max(ratio, 0.0), 1.0);
+  const auto n = static_cast<size_t>(
+    std::ceil(clamped_ratio * static_cast<double>(latencies.size() - 1)));
+  std::nth_element(latencies.begin(), latencies.begin() + n, latencies.end());
+  return latencies.at(n);
+}
+
+boost::optional<double> LatencyHistogram::getMax() const
+{
+  if (window_.empty()) {
+    return {};
+  }
+  return *std::max_element(window_.begin(), window_.end());
+}
+
+boost::optional<double> LatencyHistogram::getLatest() const
+{
+  if (window_.empty()) {
+    return {};
+  }
+  return window_.back();
+}
+
+LatencyBudgetMonitor::LatencyBudgetMonitor(const Param & param)
+: param_(param),
+  latest_messages_(param.stages.size()),
+  end_to_end_histogram_(
+    param.end_to_end_budget, param.window_size, param.histogram_bin_width,
+    param.histogram_bin_num)
+{
+  for (const auto & stage : param_.stages) {
+    stage_histograms_.emplace_back(
+      stage.budget, param_.window_size, param_.histogram_bin_width, param_.histogram_bin_num);
+  }
+}
+
+boost::optional<StageLatency> LatencyBudgetMonitor::update(
+  const size_t stage_idx, const int64_t received_ns, const int64_t stamp_ns)
+{
+  auto & latest = latest_messages_.at(stage_idx);
+
+  int64_t origin_stamp_ns = stamp_ns;
+  int64_t input_ns = stamp_ns;
+  if (stage_idx != 0) {
+    const auto & prev = latest_messages_.at(stage_idx - 1);
+    if (!prev.is_received) {
+      return {};
+    }
+    origin_stamp_ns = prev.origin_stamp_ns;
+    input_ns = prev.received_ns;
+  }
+
+  latest.is_received = true;
+  latest.origin_stamp_ns = origin_stamp_ns;
+  latest.received_ns = received_ns;
+
+  StageLatency latency;
+  latency.stage = static_cast<double>(received_ns - input_ns) * 1e-9;
+  latency.age = static_cast<double>(received_ns - origin_stamp_ns) * 1e-9;
+
+  stage_histograms_.at(stage_idx).add(latency.stage);
+  if (stage_idx + 1 == latest_messages_.size()) {
+    end_to_end_histogram_.add(latency.age);
+  }
+
+  return latency;
+}
+
+boost::optional<int64_t> readLeadingStamp(const uint8_t * buffer, const size_t length)
+{
+  // encapsulation header (2 bytes of the representation and 2 bytes of the options), int32 sec
+  // and uint32 nanosec
+  constexpr size_t encapsulation_size = 4;
+  if (buffer == nullptr || length < encapsulation_size + 8) {
+    return {};
+  }
+
+  // CDR_BE (0x0000) or CDR_LE (0x0001)
+  if (buffer[0] != 0x00 || buffer[1] > 0x01) {
+    return {};
+  }
+  const bool is_little_endian = buffer[1] == 0x01;
+
+  const auto read_uint32 = [&](const size_t offset) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      const size_t byte_idx = is_little_endian ? 3 - i : i;
+      value = (value << 8) | buffer[offset + byte_idx];
+    }
+    return value;
+  };
+
+  const auto sec = static_cast<int32_t>(read_uint32(encapsulation_size));
+  const auto nanosec = read_uint32(encapsulation_size + 4);
+  return static_cast<int64_t>(sec) * 1000000000 + static_cast<int64_t>(nanosec);
+}
+}  // namespace latency_budget_monitor
@@ -0,0 +1,170 @@
+// Copyright 2022 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "latency_budget_monitor/latency_budget_monitor_core.hpp"
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace latency_budget_monitor
+{
+LatencyBudgetMonitorNode::LatencyBudgetMonitorNode(const rclcpp::NodeOptions & node_options)
+: Node("latency_budget_monitor", node_options), updater_(this)
+{
+  // Parameter
+  node_param_.update_rate = declare_parameter("update_rate", 10.0);
+  node_param_.topics = declare_parameter<std::vector<std::string>>("stage_topics");
+  node_param_.topic_types = declare_parameter<std::vector<std::string>>("stage_topic_types");
+  const auto stage_names = declare_parameter<std::vector<std::string>>("stage_names");
+  const auto stage_budgets = declare_parameter<std::vector<double>>("stage_budgets");
+
+  if (
+    node_param_.topics.empty() || node_param_.topic_types.size() != node_param_.topics.size() ||
+    stage_names.size() != node_param_.topics.size() ||
+    stage_budgets.size() != node_param_.topics.size()) {
+    throw std::invalid_argument(
+      "stage_topics, stage_topic_types, stage_names and stage_budgets must have the same size of "
+      "one or more.");
+  }
+
+  Param param;
+  for (size_t i = 0; i < stage_names.size(); ++i) {
+    param.stages.push_back(StageParam{stage_names.at(i), stage_budgets.at(i)});
+  }
+  param.end_to_end_budget = declare_parameter("end_to_end_budget", 0.5);
+  param.window_size = static_cast<size_t>(declare_parameter("window_size", 100));
+  param.histogram_bin_width = declare_parameter("histogram_bin_width", 0.01);
+  param.histogram_bin_num = static_cast<size_t>(declare_parameter("histogram_bin_num", 50));
+
+  // Core
+  latency_budget_monitor_ = std::make_unique<LatencyBudgetMonitor>(param);
+
+  // Publisher
+  for (const auto & stage : param.stages) {
+    pub_stage_latencies_.push_back(create_publisher<tier4_debug_msgs::msg::Float64Stamped>(
+      "~/debug/" + stage.name + "/latency_ms", 1));
+  }
+  pub_end_to_end_latency_ =
+    create_publisher<tier4_debug_msgs::msg::Float64Stamped>("~/debug/end_to_end_latency_ms", 1);
+
+  // Subscriber
+  // best effort to match both of the reliable and the best effort publishers
+  const auto qos = rclcpp::QoS{1}.best_effort();
+  for (size_t i = 0; i < node_param_.topics.size(); ++i) {
+    sub_stages_.push_back(create_generic_subscription(
+      node_param_.topics.at(i), node_param_.topic_types.at(i), qos,
+      [this, i](std::shared_ptr<rclcpp::SerializedMessage> msg) { onStage(i, *msg); }));
+  }
+
+  // Diagnostic Updater
+  updater_.setHardwareID("latency_budget_monitor");
+  for (size_t i = 0; i < param.stages.size(); ++i) {
+    updater_.add(param.stages.at(i).name + "_latency", [this, i](auto & stat) {
+      checkLatency(stat, latency_budget_monitor_->getStageHistogram(i));
+    });
+  }
+  updater_.add("end_to_end_latency", [this](auto & stat) {
+    checkLatency(stat, latency_budget_monitor_->getEndToEndHistogram());
+  });
+
+  // Timer
+  const auto period_ns = rclcpp::Rate(node_param_.update_rate).period();
+  timer_ = rclcpp::create_timer(
+    this, get_clock(), period_ns, std::bind(&LatencyBudgetMonitorNode::onTimer, this));
+}
+
+void LatencyBudgetMonitorNode::onStage(
+  const size_t stage_idx, const rclcpp::SerializedMessage & msg)
+{
+  const auto now = this->now();
+
+  int64_t stamp_ns = 0;
+  if (stage_idx == 0) {
+    const auto & serialized = msg.get_rcl_serialized_message();
+    const auto stamp = readLeadingStamp(serialized.buffer, serialized.buffer_length);
+    if (!stamp) {
+      RCLCPP_WARN_THROTTLE(
+        get_logger(), *get_clock(), 5000, "failed to read the stamp of %s",
+        node_param_.topics.front().c_str());
+      return;
+    }
+    stamp_ns = *stamp;
+  }
+
+  const auto latency = latency_budget_monitor_->update(stage_idx, now.nanoseconds(), stamp_ns);
+  if (!latency) {
+    return;
+  }
+
+  tier4_debug_msgs::msg::Float64Stamped stage_latency;
+  stage_latency.stamp = now;
+  stage_latency.data = latency->stage * 1e3;
+  pub_stage_latencies_.at(stage_idx)->publish(stage_latency);
+
+  if (stage_idx + 1 == latency_budget_monitor_->getStageNum()) {
+    tier4_debug_msgs::msg::Float64Stamped end_to_end_latency;
+    end_to_end_latency.stamp = now;
+    end_to_end_latency.data = latency->age * 1e3;
+    pub_end_to_end_latency_->publish(end_to_end_latency);
+  }
+}
+
+void LatencyBudgetMonitorNode::onTimer()
+{
+  // Publish diagnostics
+  updater_.force_update();
+}
+
+void LatencyBudgetMonitorNode::checkLatency(
+  diagnostic_updater::DiagnosticStatusWrapper & stat, const LatencyHistogram & histogram)
+{
+  using diagnostic_msgs::msg::DiagnosticStatus;
+
+  stat.addf("budget", "%.1f [ms]", histogram.getBudget() * 1e3);
+  stat.addf("count", "%zu", histogram.getCount());
+  stat.addf("over_budget_count", "%zu", histogram.getOverBudgetCount());
+
+  const auto p99 = histogram.getPercentile(0.99);
+  if (!p99) {
+    stat.summary(DiagnosticStatus::OK, "Not measured");
+    return;
+  }
+
+  stat.addf("latest", "%.1f [ms]", *histogram.getLatest() * 1e3);
+  stat.addf("p50", "%.1f [ms]", *histogram.getPercentile(0.5) * 1e3);
+  stat.addf("p90", "%.1f [ms]", *histogram.getPercentile(0.9) * 1e3);
+  stat.addf("p99", "%.1f [ms]", *p99 * 1e3);
+  stat.addf("max", "%.1f [ms]", *histogram.getMax() * 1e3);
+
+  // counts of the bins from 0 ms, the last one including the latencies beyond it
+  std::stringstream bins;
+  for (const auto count : histogram.getBins()) {
+    bins << count << " ";
+  }
+  stat.addf("histogram_bin_width", "%.1f [ms]", histogram.getBinWidth() * 1e3);
+  stat.add("histogram", bins.str());
+
+  if (*p99 > histogram.getBudget()) {
+    stat.summary(DiagnosticStatus::WARN, "p99 is over budget");
+  } else {
+    stat.summary(DiagnosticStatus::OK, "OK");
+  }
+}
+}  // namespace latency_budget_monitor
+
+#include <rclcpp_components/register_node_macro.hpp>
+RCLCPP_COMPONENTS_REGISTER_NODE(latency_budget_monitor::LatencyBudgetMonitorNode)
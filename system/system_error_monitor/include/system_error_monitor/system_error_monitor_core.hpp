@@ -27,7 +27,6 @@
 
 #include <boost/optional.hpp>
 
-#include <deque>
 #include <map>
 #include <string>
 #include <unordered_map>
@@ -39,8 +38,6 @@ struct DiagStamped
   diagnostic_msgs::msg::DiagnosticStatus status;
 };
 
-using DiagBuffer = std::deque<DiagStamped>;
-
 struct DiagConfig
 {
   std::string name;
@@ -48,6 +45,18 @@ struct DiagConfig
   std::string lf_at;
   std::string spf_at;
   bool auto_recovery;
+  // diag levels of sf_at, lf_at and spf_at, which are parsed once on loading
+  int sf_level;
+  int lf_level;
+  int spf_level;
+  size_t slot;  // index of the diag of name in the diag slots
+};
+
+// Latest diag of a required module and the leaf diagnostics under it in the latest diag array
+struct DiagSlot
+{
+  boost::optional<DiagStamped> latest;
+  std::vector<size_t> leaf_children;
 };
 
 using RequiredModules = std::vector<DiagConfig>;
@@ -108,8 +117,8 @@ private:
   void onControlMode(const autoware_auto_vehicle_msgs::msg::ControlModeReport::ConstSharedPtr msg);
   void onDiagArray(const diagnostic_msgs::msg::DiagnosticArray::ConstSharedPtr msg);
 
-  const size_t diag_buffer_size_ = 100;
-  std::unordered_map<std::string, DiagBuffer> diag_buffer_map_;
+  std::unordered_map<std::string, size_t> diag_slot_map_;
+  std::vector<DiagSlot> diag_slots_;
   diagnostic_msgs::msg::DiagnosticArray::ConstSharedPtr diag_array_;
   autoware_auto_system_msgs::msg::AutowareState::ConstSharedPtr autoware_state_;
   tier4_control_msgs::msg::GateMode::ConstSharedPtr current_gate_mode_;
@@ -134,7 +143,7 @@ private:
   rclcpp::Time control_mode_stamp_;
 
   // Algorithm
-  boost::optional<DiagStamped> getLatestDiag(const std::string & diag_name) const;
+  const DiagStamped * getLatestDiag(const DiagConfig & required_module) const;
   uint8_t getHazardLevel(const DiagConfig & required_module, const int diag_level) const;
   void appendHazardDiag(
     const DiagConfig & required_module, const diagnostic_msgs::msg::DiagnosticStatus & diag,
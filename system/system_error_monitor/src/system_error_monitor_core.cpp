@@ -13,10 +13,12 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <limits>
 #include <memory>
 #include <regex>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -73,6 +75,11 @@ int str2level(const std::string & level_str)
   using diagnostic_msgs::msg::DiagnosticStatus;
   using std::regex_constants::icase;
 
+  // no diag level is over it
+  if (level_str == "none") {
+    return std::numeric_limits<int>::max();
+  }
+
   if (std::regex_match(level_str, std::regex("warn", icase))) {
     return DiagnosticStatus::WARN;
   }
@@ -86,13 +93,9 @@ int str2level(const std::string & level_str)
   throw std::runtime_error(fmt::format("invalid level: {}", level_str));
 }
 
-bool isOverLevel(const int & diag_level, const std::string & failure_level_str)
+bool isOverLevel(const int & diag_level, const int & failure_level)
 {
-  if (failure_level_str == "none") {
-    return false;
-  }
-
-  return diag_level >= str2level(failure_level_str);
+  return diag_level >= failure_level;
 }
 
 std::vector<diagnostic_msgs::msg::DiagnosticStatus> & getTargetDiagnosticsRef(
@@ -339,7 +342,15 @@ void AutowareErrorMonitor::loadRequiredModules(const std::string & key)
     bool auto_recovery_approval{};
     std::istringstream(auto_recovery_approval_str) >> std::boolalpha >> auto_recovery_approval;
 
-    required_modules.push_back({param_module, sf_at, lf_at, spf_at, auto_recovery_approval});
+    // Share the slot of the diag with the other keys
+    const auto slot = diag_slot_map_.emplace(param_module, diag_slots_.size()).first->second;
+    if (slot == diag_slots_.size()) {
+      diag_slots_.emplace_back();
+    }
+
+    required_modules.push_back(
+      {param_module, sf_at, lf_at, spf_at, auto_recovery_approval, str2level(sf_at),
+       str2level(lf_at), str2level(spf_at), slot});
   }
 
   required_modules_map_.insert(std::make_pair(key, required_modules));
@@ -352,16 +363,33 @@ void AutowareErrorMonitor::onDiagArray(
 
   const auto & header = msg->header;
 
-  for (const auto & diag : msg->status) {
-    if (diag_buffer_map_.count(diag.name) == 0) {
-      diag_buffer_map_.insert(std::make_pair(diag.name, DiagBuffer{}));
+  for (auto & diag_slot : diag_slots_) {
+    diag_slot.leaf_children.clear();
+  }
+  const auto diag_name_set = params_.add_leaf_diagnostics
+                               ? diagnostics_filter::createDiagNameSet(msg->status)
+                               : std::unordered_set<std::string>{};
+
+  for (size_t i = 0; i < msg->status.size(); ++i) {
+    const auto & diag = msg->status.at(i);
+
+    // Only the diagnostics of the required modules are kept
+    const auto itr = diag_slot_map_.find(diag.name);
+    if (itr != diag_slot_map_.end()) {
+      diag_slots_.at(itr->second).latest = DiagStamped{header, diag};
     }
 
-    auto & diag_buffer = diag_buffer_map_.at(diag.name);
-    diag_buffer.push_back(DiagStamped{header, diag});
+    if (!params_.add_leaf_diagnostics || !diagnostics_filter::isLeaf(diag_name_set, diag)) {
+      continue;
+    }
 
-    while (diag_buffer.size() > diag_buffer_size_) {
-      diag_buffer.pop_front();
+    // Add the leaf to the required modules it is a child of, as extractLeafChildrenDiagnostics
+    for (auto name = diagnostics_filter::splitStringByLastSlash(diag.name); !name.empty();
+         name = diagnostics_filter::splitStringByLastSlash(name)) {
+      const auto parent_itr = diag_slot_map_.find(name);
+      if (parent_itr != diag_slot_map_.end()) {
+        diag_slots_.at(parent_itr->second).leaf_children.push_back(i);
+      }
     }
   }
 
@@ -477,20 +505,10 @@ void AutowareErrorMonitor::onTimer()
   publishHazardStatus(hazard_status_);
 }
 
-boost::optional<DiagStamped> AutowareErrorMonitor::getLatestDiag(
-  const std::string & diag_name) const
+const DiagStamped * AutowareErrorMonitor::getLatestDiag(const DiagConfig & required_module) const
 {
-  if (diag_buffer_map_.count(diag_name) == 0) {
-    return {};
-  }
-
-  const auto & diag_buffer = diag_buffer_map_.at(diag_name);
-
-  if (diag_buffer.empty()) {
-    return {};
-  }
-
-  return diag_buffer.back();
+  const auto & latest = diag_slots_.at(required_module.slot).latest;
+  return latest ? &latest.get() : nullptr;
 }
 
 uint8_t AutowareErrorMonitor::getHazardLevel(
@@ -498,13 +516,13 @@ uint8_t AutowareErrorMonitor::getHazardLevel(
 {
   using autoware_auto_system_msgs::msg::HazardStatus;
 
-  if (isOverLevel(diag_level, required_module.spf_at)) {
+  if (isOverLevel(diag_level, required_module.spf_level)) {
     return HazardStatus::SINGLE_POINT_FAULT;
   }
-  if (isOverLevel(diag_level, required_module.lf_at)) {
+  if (isOverLevel(diag_level, required_module.lf_level)) {
     return HazardStatus::LATENT_FAULT;
   }
-  if (isOverLevel(diag_level, required_module.sf_at)) {
+  if (isOverLevel(diag_level, required_module.sf_level)) {
     return HazardStatus::SAFE_FAULT;
   }
 
@@ -521,9 +539,8 @@ void AutowareErrorMonitor::appendHazardDiag(
   target_diagnostics_ref.push_back(hazard_diag);
 
   if (params_.add_leaf_diagnostics) {
-    for (const auto & diag :
-         diagnostics_filter::extractLeafChildrenDiagnostics(hazard_diag, diag_array_->status)) {
-      target_diagnostics_ref.push_back(diag);
+    for (const auto index : diag_slots_.at(required_module.slot).leaf_children) {
+      target_diagnostics_ref.push_back(diag_array_->status.at(index));
     }
   }
 
@@ -538,7 +555,7 @@ autoware_auto_system_msgs::msg::HazardStatus AutowareErrorMonitor::judgeHazardSt
   autoware_auto_system_msgs::msg::HazardStatus hazard_status;
   for (const auto & required_module : required_modules_map_.at(current_mode_)) {
     const auto & diag_name = required_module.name;
-    const auto latest_diag = getLatestDiag(diag_name);
+    const auto latest_diag = getLatestDiag(required_module);
 
     // no diag found
     if (!latest_diag) {
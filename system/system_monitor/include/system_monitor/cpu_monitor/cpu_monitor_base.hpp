@@ -26,6 +26,7 @@
 #include <tier4_external_api_msgs/msg/cpu_usage.hpp>
 
 #include <climits>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -54,6 +55,37 @@ typedef struct cpu_freq_info
   cpu_freq_info(int index, const std::string & path) : index_(index), path_(path) {}
 } cpu_freq_info;
 
+/**
+ * @brief CPU times (clock ticks) of /proc/stat
+ */
+typedef struct cpu_times
+{
+  uint64_t user_;        //!< @brief time in user mode, including guest_
+  uint64_t nice_;        //!< @brief time in user mode with low priority, including guest_nice_
+  uint64_t system_;      //!< @brief time in system mode
+  uint64_t idle_;        //!< @brief time in the idle task
+  uint64_t iowait_;      //!< @brief time waiting for I/O to complete
+  uint64_t irq_;         //!< @brief time servicing interrupts
+  uint64_t softirq_;     //!< @brief time servicing softirqs
+  uint64_t steal_;       //!< @brief time spent in other operating systems
+  uint64_t guest_;       //!< @brief time running a virtual CPU
+  uint64_t guest_nice_;  //!< @brief time running a niced guest
+
+  cpu_times()
+  : user_(0),
+    nice_(0),
+    system_(0),
+    idle_(0),
+    iowait_(0),
+    irq_(0),
+    softirq_(0),
+    steal_(0),
+    guest_(0),
+    guest_nice_(0)
+  {
+  }
+} cpu_times;
+
 class CPUMonitorBase : public rclcpp::Node
 {
 public:
@@ -102,7 +134,7 @@ protected:
 
   /**
    * @brief convert Cpu Usage To diagnostic Level
-   * @param [cpu_name] mpstat cpu name
+   * @param [cpu_name] cpu name, all or the cpu index
    * @param [usage] cpu usage value
    * @return DiagStatus::OK or WARN or ERROR
    */
@@ -141,7 +173,8 @@ protected:
   std::vector<cpu_freq_info> freqs_;        //!< @brief CPU list for frequency
   std::vector<int> usage_warn_check_cnt_;   //!< @brief CPU list for usage over warn check counter
   std::vector<int> usage_error_check_cnt_;  //!< @brief CPU list for usage over error check counter
-  bool mpstat_exists_;                      //!< @brief flag if mpstat exists
+  std::vector<cpu_times> cpu_times_;        //!< @brief CPU times at the last check, all first
+  std::vector<char> stat_buffer_;           //!< @brief buffer to read /proc/stat into
 
   float usage_warn_;       //!< @brief CPU usage(%) to generate warning
   float usage_error_;      //!< @brief CPU usage(%) to generate error
@@ -52,12 +52,35 @@ protected:
   void checkUsage(
     diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
 
+  /**
+   * @brief memory sizes (bytes) of /proc/meminfo
+   */
+  struct MemInfo
+  {
+    size_t mem_total{0};
+    size_t mem_free{0};
+    size_t mem_available{0};
+    size_t buffers{0};
+    size_t cached{0};
+    size_t s_reclaimable{0};
+    size_t shmem{0};
+    size_t swap_total{0};
+    size_t swap_free{0};
+  };
+
+  /**
+   * @brief read memory sizes from /proc/meminfo
+   * @param [out] info memory sizes
+   * @return true if /proc/meminfo is read
+   */
+  bool readMemInfo(MemInfo * info);
+
   /**
    * @brief get human-readable output for memory size
-   * @param [in] str size with bytes
+   * @param [in] bytes size with bytes
    * @return human-readable output
    */
-  std::string toHumanReadable(const std::string & str);
+  std::string toHumanReadable(const size_t bytes);
 
   diagnostic_updater::Updater updater_;  //!< @brief Updater class which advertises to /diagnostics
 
@@ -23,6 +23,7 @@
 #include <diagnostic_updater/diagnostic_updater.hpp>
 
 #include <climits>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <thread>
@@ -54,18 +55,18 @@ protected:
     diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
 
   /**
-   * @brief function to execute chronyc
+   * @brief function to query the tracking of chronyd on its command socket
    * @param [out] outOffset offset value of NTP time
    * @param [out] out_tracking_map "chronyc tracking" output for diagnostic
    * @return if error occurred, return error string
    */
-  std::string executeChronyc(
+  std::string queryChronyTracking(
     float & outOffset, std::map<std::string, std::string> & out_tracking_map);
 
   diagnostic_updater::Updater updater_;  //!< @brief Updater class which advertises to /diagnostics
 
   char hostname_[HOST_NAME_MAX + 1];  //!< @brief host name
-  bool chronyc_exists_;               //!< @brief flag if chronyc exists
+  uint32_t chrony_sequence_{0};       //!< @brief sequence number of the requests to chronyd
 
   float offset_warn_;   //!< @brief NTP offset(sec) to generate warning
   float offset_error_;  //!< @brief NTP offset(sec) to generate error
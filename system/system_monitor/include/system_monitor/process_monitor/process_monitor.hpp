@@ -24,15 +24,17 @@
 
 #include <diagnostic_updater/diagnostic_updater.hpp>
 
-#include <boost/process.hpp>
+#include <sys/types.h>
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
-namespace bp = boost::process;
-
 class ProcessMonitor : public rclcpp::Node
 {
 public:
@@ -46,54 +48,63 @@ protected:
   using DiagStatus = diagnostic_msgs::msg::DiagnosticStatus;
 
   /**
-   * @brief monitor processes
-   * @param [out] stat diagnostic message passed directly to diagnostic publish calls
-   * @note NOLINT syntax is needed since diagnostic_updater asks for a non-const reference
-   * to pass diagnostic message updated in this function to diagnostic publish calls.
+   * @brief summary of the states of the processes
    */
-  void monitorProcesses(
-    diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
+  struct TasksSummary
+  {
+    int total{0};     //!< @brief number of processes
+    int running{0};   //!< @brief number of running processes
+    int sleeping{0};  //!< @brief number of sleeping processes
+    int stopped{0};   //!< @brief number of stopped processes
+    int zombie{0};    //!< @brief number of zombie processes
+  };
 
   /**
-   * @brief get task summary
-   * @param [out] stat diagnostic message passed directly to diagnostic publish calls
-   * @param [in] output top command output
-   * @note NOLINT syntax is needed since diagnostic_updater asks for a non-const reference
-   * to pass diagnostic message updated in this function to diagnostic publish calls.
+   * @brief status of a process read from /proc/[pid]
    */
-  void getTasksSummary(
-    diagnostic_updater::DiagnosticStatusWrapper & stat,
-    const std::string & output);  // NOLINT(runtime/references)
+  struct ProcessStatus
+  {
+    pid_t pid{0};                  //!< @brief Process Id
+    uid_t uid{0};                  //!< @brief User Id
+    int64_t priority{0};           //!< @brief Priority
+    int64_t nice{0};               //!< @brief Nice value
+    uint64_t virtual_image{0};     //!< @brief Virtual Image (kb)
+    uint64_t resident_size{0};     //!< @brief Resident size (kb)
+    uint64_t shared_mem_size{0};   //!< @brief Shared Mem size (kb)
+    char state{'?'};               //!< @brief Process Status
+    double cpu_usage{0.0};         //!< @brief CPU usage
+    double memory_usage{0.0};      //!< @brief Memory usage
+    uint64_t cpu_time_ticks{0};    //!< @brief CPU Time (clock ticks)
+    uint64_t start_time_ticks{0};  //!< @brief Start time after boot (clock ticks)
+    std::string command;           //!< @brief Command name
+  };
 
   /**
-   * @brief remove header
+   * @brief monitor processes
    * @param [out] stat diagnostic message passed directly to diagnostic publish calls
-   * @param [in] output top command output
    * @note NOLINT syntax is needed since diagnostic_updater asks for a non-const reference
    * to pass diagnostic message updated in this function to diagnostic publish calls.
    */
-  void removeHeader(
-    diagnostic_updater::DiagnosticStatusWrapper & stat,
-    std::string & output);  // NOLINT(runtime/references)
-
-  /**
-   * @brief get high load processes
-   * @param [in] output top command output
-   */
-  void getHighLoadProcesses(const std::string & output);
+  void monitorProcesses(
+    diagnostic_updater::DiagnosticStatusWrapper & stat);  // NOLINT(runtime/references)
 
   /**
-   * @brief get high memory processes
-   * @param [in] output top command output
+   * @brief read the status of the processes from /proc
+   * @param [out] processes status of the processes
+   * @param [out] summary summary of the states of the processes
+   * @param [out] error error content
+   * @return true if /proc is read
    */
-  void getHighMemoryProcesses(const std::string & output);
+  bool readProcesses(
+    std::vector<ProcessStatus> * processes, TasksSummary * summary, std::string * error);
 
   /**
-   * @brief get top-rated processes
+   * @brief set top-rated processes
    * @param [in] tasks list of diagnostics tasks for high load procs
-   * @param [in] output top command output
+   * @param [in] processes top-rated processes
    */
-  void getTopratedProcesses(std::vector<std::shared_ptr<DiagTask>> * tasks, bp::pipe * p);
+  void setTopratedProcesses(
+    std::vector<std::shared_ptr<DiagTask>> * tasks, const std::vector<ProcessStatus> & processes);
 
   /**
    * @brief get top-rated processes
@@ -107,7 +118,14 @@ protected:
     const std::string & error_command, const std::string & content);
 
   /**
-   * @brief timer callback to execute top command
+   * @brief get user name, which is cached for each user id
+   * @param [in] uid user id
+   * @return user name, or user id if it has no name
+   */
+  std::string getUserName(uid_t uid);
+
+  /**
+   * @brief timer callback to read processes
    */
   void onTimer();
 
@@ -120,11 +138,24 @@ protected:
     load_tasks_;  //!< @brief list of diagnostics tasks for high load procs
   std::vector<std::shared_ptr<DiagTask>>
     memory_tasks_;                      //!< @brief list of diagnostics tasks for high memory procs
-  rclcpp::TimerBase::SharedPtr timer_;  //!< @brief timer to execute top command
-  std::string top_output_;              //!< @brief output from top command
-  bool is_top_error_;                   //!< @brief flag if an error occurs
-  double elapsed_ms_;                   //!< @brief Execution time of top command
-  std::mutex mutex_;                    //!< @brief mutex for output from top command
+  rclcpp::TimerBase::SharedPtr timer_;  //!< @brief timer to read processes
+
+  int64_t clock_ticks_per_sec_;  //!< @brief clock ticks per second of /proc/[pid]/stat
+  int64_t page_size_kb_;         //!< @brief page size (kb) of /proc/[pid]/statm
+  bool has_previous_sample_;     //!< @brief flag if the processes were read at the last timer
+  std::chrono::steady_clock::time_point previous_time_;  //!< @brief time of the last read
+  //!< @brief CPU time (clock ticks) of each process at the last read, with its start time
+  std::unordered_map<pid_t, std::pair<uint64_t, uint64_t>> previous_cpu_time_ticks_;
+  std::unordered_map<uid_t, std::string> user_names_;  //!< @brief cache of user names
+
+  TasksSummary tasks_summary_;                    //!< @brief summary of the processes
+  std::vector<ProcessStatus> high_load_procs_;    //!< @brief processes sorted by CPU usage
+  std::vector<ProcessStatus> high_memory_procs_;  //!< @brief processes sorted by memory usage
+  bool is_proc_read_;                             //!< @brief flag if the processes are read
+  bool is_proc_error_;                            //!< @brief flag if an error occurs
+  std::string proc_error_;                        //!< @brief error content of reading /proc
+  double elapsed_ms_;                             //!< @brief Execution time of reading /proc
+  std::mutex mutex_;                              //!< @brief mutex for the processes read
   rclcpp::CallbackGroup::SharedPtr timer_callback_group_;  //!< @brief Callback Group
 };
 
@@ -24,6 +24,9 @@
 #include <boost/foreach.hpp>
 #include <boost/range.hpp>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <chrono>
 #include <regex>
 #include <string>
@@ -96,6 +99,28 @@ public:
     }
   }
 
+  /**
+   * @brief read a small file of procfs or sysfs at once, without allocations
+   * @param [in] path file path
+   * @param [out] buffer buffer to read into, which is null-terminated
+   * @param [in] size size of buffer
+   * @return length read, or -1 if it fails
+   */
+  static ssize_t readProcFile(const char * path, char * buffer, const size_t size)
+  {
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return -1;
+    }
+    const ssize_t length = read(fd, buffer, size - 1);
+    close(fd);
+    if (length < 0) {
+      return -1;
+    }
+    buffer[length] = '\0';
+    return length;
+  }
+
   /**
    * @brief Remember start time to measure elapsed time
    * @return start time
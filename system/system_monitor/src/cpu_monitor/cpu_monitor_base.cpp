@@ -22,20 +22,31 @@
 #include "system_monitor/system_monitor_utility.hpp"
 
 #include <boost/filesystem.hpp>
-#include <boost/process.hpp>
-#include <boost/property_tree/json_parser.hpp>
-#include <boost/property_tree/ptree.hpp>
 #include <boost/thread.hpp>
 
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <regex>
 #include <string>
 
-namespace bp = boost::process;
 namespace fs = boost::filesystem;
-namespace pt = boost::property_tree;
+
+namespace
+{
+/**
+ * @brief counter difference, which is 0 if the counter is reset, e.g. by CPU hotplug
+ */
+uint64_t diffTicks(const uint64_t current, const uint64_t previous)
+{
+  return current > previous ? current - previous : 0;
+}
+}  // namespace
 
 CPUMonitorBase::CPUMonitorBase(const std::string & node_name, const rclcpp::NodeOptions & options)
 : Node(node_name, options),
@@ -44,7 +55,6 @@ CPUMonitorBase::CPUMonitorBase(const std::string & node_name, const rclcpp::Node
   num_cores_(0),
   temps_(),
   freqs_(),
-  mpstat_exists_(false),
   usage_warn_(declare_parameter<float>("usage_warn", 0.96)),
   usage_error_(declare_parameter<float>("usage_error", 1.00)),
   usage_warn_count_(declare_parameter<int>("usage_warn_count", 2)),
@@ -56,9 +66,9 @@ CPUMonitorBase::CPUMonitorBase(const std::string & node_name, const rclcpp::Node
   usage_warn_check_cnt_.resize(num_cores_ + 2);   // 2 = all + dummy
   usage_error_check_cnt_.resize(num_cores_ + 2);  // 2 = all + dummy
 
-  // Check if command exists
-  fs::path p = bp::search_path("mpstat");
-  mpstat_exists_ = (p.empty()) ? false : true;
+  cpu_times_.resize(num_cores_ + 1);  // 1 = all
+  // /proc/stat has a line of about 100 characters for each cpu before the other statistics
+  stat_buffer_.resize(4096 + 128 * num_cores_);
 
   updater_.setHardwareID(hostname_);
   updater_.add("CPU Temperature", this, &CPUMonitorBase::checkTemp);
@@ -124,26 +134,12 @@ void CPUMonitorBase::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & st
   tier4_external_api_msgs::msg::CpuUsage cpu_usage;
   using CpuStatus = tier4_external_api_msgs::msg::CpuStatus;
 
-  if (!mpstat_exists_) {
-    stat.summary(DiagStatus::ERROR, "mpstat error");
-    stat.add(
-      "mpstat", "Command 'mpstat' not found, but can be installed with: sudo apt install sysstat");
-    cpu_usage.all.status = CpuStatus::STALE;
-    publishCpuUsage(cpu_usage);
-    return;
-  }
-
-  // Get CPU Usage
-  bp::ipstream is_out;
-  bp::ipstream is_err;
-  bp::child c("mpstat -P ALL 1 1 -o JSON", bp::std_out > is_out, bp::std_err > is_err);
-  c.wait();
-
-  if (c.exit_code() != 0) {
-    std::ostringstream os;
-    is_err >> os.rdbuf();
-    stat.summary(DiagStatus::ERROR, "mpstat error");
-    stat.add("mpstat", os.str().c_str());
+  // Get CPU Usage as mpstat from the CPU times since the last check, or since boot for the first
+  const ssize_t length = SystemMonitorUtility::readProcFile(
+    "/proc/stat", stat_buffer_.data(), stat_buffer_.size());
+  if (length < 0) {
+    stat.summary(DiagStatus::ERROR, "stat error");
+    stat.add("stat", strerror(errno));
     cpu_usage.all.status = CpuStatus::STALE;
     publishCpuUsage(cpu_usage);
     return;
@@ -160,87 +156,102 @@ void CPUMonitorBase::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & st
   int level = DiagStatus::OK;
   int whole_level = DiagStatus::OK;
 
-  pt::ptree pt;
-  try {
-    // Analyze JSON output
-    read_json(is_out, pt);
-
-    for (const pt::ptree::value_type & child1 : pt.get_child("sysstat.hosts")) {
-      const pt::ptree & hosts = child1.second;
-
-      for (const pt::ptree::value_type & child2 : hosts.get_child("statistics")) {
-        const pt::ptree & statistics = child2.second;
-
-        for (const pt::ptree::value_type & child3 : statistics.get_child("cpu-load")) {
-          const pt::ptree & cpu_load = child3.second;
-          bool get_cpu_name = false;
-
-          CpuStatus cpu_status;
-
-          if (boost::optional<std::string> v = cpu_load.get_optional<std::string>("cpu")) {
-            cpu_name = v.get();
-            get_cpu_name = true;
-          }
-          if (boost::optional<float> v = cpu_load.get_optional<float>("usr")) {
-            usr = v.get();
-            cpu_status.usr = usr;
-          }
-          if (boost::optional<float> v = cpu_load.get_optional<float>("nice")) {
-            nice = v.get();
-            cpu_status.nice = nice;
-          }
-          if (boost::optional<float> v = cpu_load.get_optional<float>("sys")) {
-            sys = v.get();
-            cpu_status.sys = sys;
-          }
-          if (boost::optional<float> v = cpu_load.get_optional<float>("idle")) {
-            idle = v.get();
-            cpu_status.idle = idle;
-          }
-
-          total = 100.0 - iowait - idle;
-          usage = total * 1e-2;
-          if (get_cpu_name) {
-            level = CpuUsageToLevel(cpu_name, usage);
-          } else {
-            level = CpuUsageToLevel(std::string("err"), usage);
-          }
-
-          cpu_status.total = total;
-          cpu_status.status = level;
-
-          stat.add(fmt::format("CPU {}: status", cpu_name), load_dict_.at(level));
-          stat.addf(fmt::format("CPU {}: total", cpu_name), "%.2f%%", total);
-          stat.addf(fmt::format("CPU {}: usr", cpu_name), "%.2f%%", usr);
-          stat.addf(fmt::format("CPU {}: nice", cpu_name), "%.2f%%", nice);
-          stat.addf(fmt::format("CPU {}: sys", cpu_name), "%.2f%%", sys);
-          stat.addf(fmt::format("CPU {}: idle", cpu_name), "%.2f%%", idle);
-
-          if (usage_avg_ == true) {
-            if (cpu_name == "all") {
-              whole_level = level;
-            }
-          } else {
-            whole_level = std::max(whole_level, level);
-          }
-
-          if (cpu_name == "all") {
-            cpu_usage.all = cpu_status;
-          } else {
-            cpu_usage.cpus.push_back(cpu_status);
-          }
-        }
+  // Lines of "cpu" for all and "cpu<index>" for each cpu, followed by the other statistics
+  char * line = stat_buffer_.data();
+  while (std::strncmp(line, "cpu", 3) == 0) {
+    char * next = std::strchr(line, '\n');
+    if (next == nullptr) {
+      break;
+    }
+    *next = '\0';
+
+    char * fields = line + 3;
+    size_t index = 0;
+    if (*fields == ' ') {
+      cpu_name = "all";
+    } else {
+      const int64_t num = std::strtol(fields, &fields, 10);
+      cpu_name = std::to_string(num);
+      index = static_cast<size_t>(num) + 1;
+    }
+    line = next + 1;
+
+    cpu_times times;
+    const int num_fields = std::sscanf(
+      fields,
+      "%" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64 " %" SCNu64
+      " %" SCNu64 " %" SCNu64 " %" SCNu64,
+      &times.user_, &times.nice_, &times.system_,
+      &times.idle_, &times.iowait_, &times.irq_, &times.softirq_, &times.steal_, &times.guest_,
+      &times.guest_nice_);
+    if (num_fields < 4) {
+      stat.summary(DiagStatus::ERROR, "stat error");
+      stat.add("stat", fmt::format("invalid format of cpu{}", fields));
+      std::fill(usage_warn_check_cnt_.begin(), usage_warn_check_cnt_.end(), 0);
+      std::fill(usage_error_check_cnt_.begin(), usage_error_check_cnt_.end(), 0);
+      cpu_usage.all.status = CpuStatus::STALE;
+      cpu_usage.cpus.clear();
+      publishCpuUsage(cpu_usage);
+      return;
+    }
+
+    if (index >= cpu_times_.size()) {
+      cpu_times_.resize(index + 1);
+    }
+    const cpu_times & previous = cpu_times_.at(index);
+    const uint64_t user_ticks = diffTicks(times.user_, previous.user_);
+    const uint64_t nice_ticks = diffTicks(times.nice_, previous.nice_);
+    const uint64_t system_ticks = diffTicks(times.system_, previous.system_);
+    const uint64_t idle_ticks = diffTicks(times.idle_, previous.idle_);
+    const uint64_t guest_ticks = diffTicks(times.guest_, previous.guest_);
+    const uint64_t guest_nice_ticks = diffTicks(times.guest_nice_, previous.guest_nice_);
+    // The guest times are included in the user times
+    const uint64_t total_ticks = user_ticks + nice_ticks + system_ticks + idle_ticks +
+                                 diffTicks(times.iowait_, previous.iowait_) +
+                                 diffTicks(times.irq_, previous.irq_) +
+                                 diffTicks(times.softirq_, previous.softirq_) +
+                                 diffTicks(times.steal_, previous.steal_);
+    cpu_times_.at(index) = times;
+
+    const double ratio = total_ticks > 0 ? 100.0 / total_ticks : 0.0;
+    usr = diffTicks(user_ticks, guest_ticks) * ratio;
+    nice = diffTicks(nice_ticks, guest_nice_ticks) * ratio;
+    sys = system_ticks * ratio;
+    idle = total_ticks > 0 ? idle_ticks * ratio : 100.0;
+
+    CpuStatus cpu_status;
+    cpu_status.usr = usr;
+    cpu_status.nice = nice;
+    cpu_status.sys = sys;
+    cpu_status.idle = idle;
+
+    total = 100.0 - iowait - idle;
+    usage = total * 1e-2;
+    level = CpuUsageToLevel(cpu_name, usage);
+
+    cpu_status.total = total;
+    cpu_status.status = level;
+
+    stat.add(fmt::format("CPU {}: status", cpu_name), load_dict_.at(level));
+    stat.addf(fmt::format("CPU {}: total", cpu_name), "%.2f%%", total);
+    stat.addf(fmt::format("CPU {}: usr", cpu_name), "%.2f%%", usr);
+    stat.addf(fmt::format("CPU {}: nice", cpu_name), "%.2f%%", nice);
+    stat.addf(fmt::format("CPU {}: sys", cpu_name), "%.2f%%", sys);
+    stat.addf(fmt::format("CPU {}: idle", cpu_name), "%.2f%%", idle);
+
+    if (usage_avg_ == true) {
+      if (cpu_name == "all") {
+        whole_level = level;
       }
+    } else {
+      whole_level = std::max(whole_level, level);
+    }
+
+    if (cpu_name == "all") {
+      cpu_usage.all = cpu_status;
+    } else {
+      cpu_usage.cpus.push_back(cpu_status);
     }
-  } catch (const std::exception & e) {
-    stat.summary(DiagStatus::ERROR, "mpstat exception");
-    stat.add("mpstat", e.what());
-    std::fill(usage_warn_check_cnt_.begin(), usage_warn_check_cnt_.end(), 0);
-    std::fill(usage_error_check_cnt_.begin(), usage_error_check_cnt_.end(), 0);
-    cpu_usage.all.status = CpuStatus::STALE;
-    cpu_usage.cpus.clear();
-    publishCpuUsage(cpu_usage);
-    return;
   }
 
   stat.summary(whole_level, load_dict_.at(whole_level));
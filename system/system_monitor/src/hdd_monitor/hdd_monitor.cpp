@@ -26,17 +26,19 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
-#include <boost/process.hpp>
 #include <boost/serialization/vector.hpp>
 
 #include <fmt/format.h>
 
+#include <mntent.h>
+#include <sys/statvfs.h>
+
 #include <algorithm>
+#include <cerrno>
+#include <cstdio>
 #include <string>
 #include <vector>
 
-namespace bp = boost::process;
-
 HDDMonitor::HDDMonitor(const rclcpp::NodeOptions & options)
 : Node("hdd_monitor", options),
   updater_(this),
@@ -197,74 +199,66 @@ void HDDMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
   std::string error_str = "";
 
   for (auto itr = hdd_params_.begin(); itr != hdd_params_.end(); ++itr, ++hdd_index) {
-    // Get summary of disk space usage of ext4
-    bp::ipstream is_out;
-    bp::ipstream is_err;
-    // Invoke shell to use shell wildcard expansion
-    bp::child c(
-      "/bin/sh", "-c", fmt::format("df -Pm {}*", itr->first.c_str()), bp::std_out > is_out,
-      bp::std_err > is_err);
-    c.wait();
-
-    if (c.exit_code() != 0) {
-      std::ostringstream os;
-      is_err >> os.rdbuf();
-      error_str = "df error";
-      stat.add(fmt::format("HDD {}: status", hdd_index), "df error");
+    // Get summary of disk space usage of the file systems of the device as `df -Pm <device>*`
+    FILE * mounts = setmntent("/proc/self/mounts", "r");
+    if (mounts == nullptr) {
+      error_str = "mounts error";
+      stat.add(fmt::format("HDD {}: status", hdd_index), "mounts error");
       stat.add(fmt::format("HDD {}: name", hdd_index), itr->first.c_str());
-      stat.add(fmt::format("HDD {}: df", hdd_index), os.str().c_str());
+      stat.add(fmt::format("HDD {}: mounts", hdd_index), strerror(errno));
       continue;
     }
 
-    int level = DiagStatus::OK;
-    std::string line;
-    int index = 0;
-    std::vector<std::string> list;
-    int avail;
-
-    while (std::getline(is_out, line) && !line.empty()) {
-      // Skip header
-      if (index <= 0) {
-        ++index;
+    std::vector<std::string> filesystems;
+    struct mntent entry;
+    char buffer[4096];
+    while (getmntent_r(mounts, &entry, buffer, sizeof(buffer)) != nullptr) {
+      // The file system mounted on several mount points is shown once
+      if (
+        !boost::starts_with(entry.mnt_fsname, itr->first) ||
+        std::find(filesystems.begin(), filesystems.end(), entry.mnt_fsname) != filesystems.end()) {
         continue;
       }
-
-      boost::split(list, line, boost::is_space(), boost::token_compress_on);
-
-      try {
-        avail = std::stoi(list[3].c_str());
-      } catch (std::exception & e) {
-        avail = -1;
-        error_str = e.what();
-        stat.add(fmt::format("HDD {}: status", hdd_index), "avail string error");
+      filesystems.push_back(entry.mnt_fsname);
+
+      struct statvfs buf;
+      if (statvfs(entry.mnt_dir, &buf) != 0) {
+        error_str = "statvfs error";
+        stat.add(fmt::format("HDD {}: status", hdd_index), "statvfs error");
+        stat.add(fmt::format("HDD {}: name", hdd_index), entry.mnt_fsname);
+        stat.add(fmt::format("HDD {}: statvfs", hdd_index), strerror(errno));
+        continue;
       }
 
-      if (avail <= itr->second.free_error_) {
+      // Sizes are rounded up to MiB as df
+      constexpr uint64_t mib = 1024 * 1024;
+      const uint64_t size = (buf.f_blocks * buf.f_frsize + mib - 1) / mib;
+      const uint64_t used = ((buf.f_blocks - buf.f_bfree) * buf.f_frsize + mib - 1) / mib;
+      const uint64_t avail = (buf.f_bavail * buf.f_frsize + mib - 1) / mib;
+      // Percentage of the used blocks to the blocks for non-root users, rounded up
+      const uint64_t used_blocks = buf.f_blocks - buf.f_bfree;
+      const uint64_t nonroot_blocks = used_blocks + buf.f_bavail;
+      const uint64_t use =
+        nonroot_blocks > 0 ? (used_blocks * 100 + nonroot_blocks - 1) / nonroot_blocks : 0;
+
+      int level = DiagStatus::OK;
+      if (avail <= static_cast<uint64_t>(std::max(itr->second.free_error_, 0))) {
         level = DiagStatus::ERROR;
-      } else if (avail <= itr->second.free_warn_) {
+      } else if (avail <= static_cast<uint64_t>(std::max(itr->second.free_warn_, 0))) {
         level = DiagStatus::WARN;
-      } else {
-        level = DiagStatus::OK;
       }
 
       stat.add(fmt::format("HDD {}: status", hdd_index), usage_dict_.at(level));
-      stat.add(fmt::format("HDD {}: filesystem", hdd_index), list[0].c_str());
-      stat.add(fmt::format("HDD {}: size", hdd_index), (list[1] + " MiB").c_str());
-      stat.add(fmt::format("HDD {}: used", hdd_index), (list[2] + " MiB").c_str());
-      stat.add(fmt::format("HDD {}: avail", hdd_index), (list[3] + " MiB").c_str());
-      stat.add(fmt::format("HDD {}: use", hdd_index), list[4].c_str());
-      std::string mounted_ = list[5];
-      if (list.size() > 6) {
-        std::string::size_type pos = line.find("% /");
-        if (pos != std::string::npos) {
-          mounted_ = line.substr(pos + 2);  // 2 is "% " length
-        }
-      }
-      stat.add(fmt::format("HDD {}: mounted on", hdd_index), mounted_.c_str());
+      stat.add(fmt::format("HDD {}: filesystem", hdd_index), entry.mnt_fsname);
+      stat.add(fmt::format("HDD {}: size", hdd_index), fmt::format("{} MiB", size));
+      stat.add(fmt::format("HDD {}: used", hdd_index), fmt::format("{} MiB", used));
+      stat.add(fmt::format("HDD {}: avail", hdd_index), fmt::format("{} MiB", avail));
+      stat.add(fmt::format("HDD {}: use", hdd_index), fmt::format("{}%", use));
+      stat.add(fmt::format("HDD {}: mounted on", hdd_index), entry.mnt_dir);
 
       whole_level = std::max(whole_level, level);
-      ++index;
     }
+    endmntent(mounts);
   }
 
   if (!error_str.empty()) {
@@ -323,23 +317,25 @@ void HDDMonitor::getHDDParams()
 
 std::string HDDMonitor::getDeviceFromMountPoint(const std::string & mount_point)
 {
-  std::string ret;
-  bp::ipstream is_out;
-  bp::ipstream is_err;
-
-  bp::child c(
-    "/bin/sh", "-c", fmt::format("findmnt -n -o SOURCE {}", mount_point.c_str()),
-    bp::std_out > is_out, bp::std_err > is_err);
-  c.wait();
-
-  if (c.exit_code() != 0) {
-    RCLCPP_ERROR(get_logger(), "Failed to execute findmnt. %s", mount_point.c_str());
+  FILE * mounts = setmntent("/proc/self/mounts", "r");
+  if (mounts == nullptr) {
+    RCLCPP_ERROR(get_logger(), "Failed to open mounts. %s", strerror(errno));
     return "";
   }
 
-  if (!std::getline(is_out, ret)) {
+  // The last one is visible if several file systems are mounted on the mount point, as findmnt
+  std::string ret;
+  struct mntent entry;
+  char buffer[4096];
+  while (getmntent_r(mounts, &entry, buffer, sizeof(buffer)) != nullptr) {
+    if (mount_point == entry.mnt_dir) {
+      ret = entry.mnt_fsname;
+    }
+  }
+  endmntent(mounts);
+
+  if (ret.empty()) {
     RCLCPP_ERROR(get_logger(), "Failed to find device name. %s", mount_point.c_str());
-    return "";
   }
 
   return ret;
@@ -21,14 +21,13 @@
 
 #include "system_monitor/system_monitor_utility.hpp"
 
-#include <boost/process.hpp>
-
 #include <fmt/format.h>
 
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <string>
-#include <vector>
-
-namespace bp = boost::process;
+#include <utility>
 
 MemMonitor::MemMonitor(const rclcpp::NodeOptions & options)
 : Node("mem_monitor", options),
@@ -48,76 +47,48 @@ void MemMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
   const auto t_start = SystemMonitorUtility::startMeasurement();
 
   // Get total amount of free and used memory
-  bp::ipstream is_out;
-  bp::ipstream is_err;
-  bp::child c("free -tb", bp::std_out > is_out, bp::std_err > is_err);
-  c.wait();
-  if (c.exit_code() != 0) {
-    std::ostringstream os;
-    is_err >> os.rdbuf();
-    stat.summary(DiagStatus::ERROR, "free error");
-    stat.add("free", os.str().c_str());
+  MemInfo info;
+  if (!readMemInfo(&info)) {
+    stat.summary(DiagStatus::ERROR, "meminfo error");
+    stat.add("meminfo", strerror(errno));
     return;
   }
 
-  std::string line;
-  int index = 0;
-  std::vector<std::string> list;
-  float usage;
-  size_t mem_total = 0;
-  size_t mem_shared = 0;
-  size_t mem_available = 0;
-  size_t used_plus = 0;
-
-  /*
-   Output example of `free -tb`
-
-             list[0]     list[1]     list[2]     list[3]     list[4]     list[5]     list[6]
-   index 0 |               total        used        free      shared  buff/cache   available
-   index 1 | Mem:       32809744    12554780    13090376      292840     7164588    19622092
-   index 2 | Swap:      33554428     1767680    31786748
-   index 3 | Total:     66364172    14322460    44877124
-  */
-  while (std::getline(is_out, line) && !line.empty()) {
-    // Skip header
-    if (index <= 0) {
-      ++index;
-      continue;
-    }
-
-    boost::split(list, line, boost::is_space(), boost::token_compress_on);
-
-    // Physical memory
-    if (index == 1) {
-      mem_total = std::atoll(list[1].c_str());
-      mem_shared = std::atoll(list[4].c_str());
-      mem_available = std::atoll(list[6].c_str());
-
-      // available divided by total is available memory including calculation for buff/cache,
-      // so the subtraction of this from 1 gives real usage.
-      usage = 1.0f - static_cast<double>(mem_available) / mem_total;
-      stat.addf(fmt::format("{} usage", list[0]), "%.2f%%", usage * 1e+2);
-    }
-
-    stat.add(fmt::format("{} total", list[0]), toHumanReadable(list[1]));
-    stat.add(fmt::format("{} used", list[0]), toHumanReadable(list[2]));
-    stat.add(fmt::format("{} free", list[0]), toHumanReadable(list[3]));
-
-    // Add an additional information for physical memory
-    if (index == 1) {
-      stat.add(fmt::format("{} shared", list[0]), toHumanReadable(list[4]));
-      stat.add(fmt::format("{} buff/cache", list[0]), toHumanReadable(list[5]));
-      stat.add(fmt::format("{} available", list[0]), toHumanReadable(list[6]));
-    } else if (index == 3) {
-      // Total:used + Mem:shared
-      used_plus = std::atoll(list[2].c_str()) + mem_shared;
-      double giga = static_cast<double>(used_plus) / (1024 * 1024 * 1024);
-      stat.add(fmt::format("{} used+", list[0]), fmt::format("{:.1f}{}", giga, "G"));
-    } else {
-      /* nothing */
-    }
-    ++index;
-  }
+  // Same as `free -tb` of procps 3.3
+  const size_t mem_total = info.mem_total;
+  const size_t mem_free = info.mem_free;
+  const size_t mem_shared = info.shmem;
+  const size_t mem_buff_cache = info.buffers + info.cached + info.s_reclaimable;
+  const size_t mem_available = info.mem_available;
+  const size_t mem_used =
+    mem_total > mem_free + mem_buff_cache ? mem_total - mem_free - mem_buff_cache : 0;
+  const size_t swap_total = info.swap_total;
+  const size_t swap_free = info.swap_free;
+  const size_t swap_used = swap_total > swap_free ? swap_total - swap_free : 0;
+
+  // available divided by total is available memory including calculation for buff/cache,
+  // so the subtraction of this from 1 gives real usage.
+  const float usage = mem_total > 0 ? 1.0f - static_cast<double>(mem_available) / mem_total : 0.0f;
+  stat.addf("Mem: usage", "%.2f%%", usage * 1e+2);
+  stat.add("Mem: total", toHumanReadable(mem_total));
+  stat.add("Mem: used", toHumanReadable(mem_used));
+  stat.add("Mem: free", toHumanReadable(mem_free));
+  // Add an additional information for physical memory
+  stat.add("Mem: shared", toHumanReadable(mem_shared));
+  stat.add("Mem: buff/cache", toHumanReadable(mem_buff_cache));
+  stat.add("Mem: available", toHumanReadable(mem_available));
+
+  stat.add("Swap: total", toHumanReadable(swap_total));
+  stat.add("Swap: used", toHumanReadable(swap_used));
+  stat.add("Swap: free", toHumanReadable(swap_free));
+
+  stat.add("Total: total", toHumanReadable(mem_total + swap_total));
+  stat.add("Total: used", toHumanReadable(mem_used + swap_used));
+  stat.add("Total: free", toHumanReadable(mem_free + swap_free));
+  // Total:used + Mem:shared
+  const size_t used_plus = mem_used + swap_used + mem_shared;
+  const double giga = static_cast<double>(used_plus) / (1024 * 1024 * 1024);
+  stat.add("Total: used+", fmt::format("{:.1f}{}", giga, "G"));
 
   int level;
   if (mem_total > used_plus) {
@@ -134,11 +105,45 @@ void MemMonitor::checkUsage(diagnostic_updater::DiagnosticStatusWrapper & stat)
   SystemMonitorUtility::stopMeasurement(t_start, stat);
 }
 
-std::string MemMonitor::toHumanReadable(const std::string & str)
+bool MemMonitor::readMemInfo(MemInfo * info)
+{
+  char buffer[8192];
+  if (SystemMonitorUtility::readProcFile("/proc/meminfo", buffer, sizeof(buffer)) < 0) {
+    return false;
+  }
+
+  const std::pair<const char *, size_t *> fields[] = {
+    {"MemTotal:", &info->mem_total},
+    {"MemFree:", &info->mem_free},
+    {"MemAvailable:", &info->mem_available},
+    {"Buffers:", &info->buffers},
+    {"Cached:", &info->cached},
+    {"SReclaimable:", &info->s_reclaimable},
+    {"Shmem:", &info->shmem},
+    {"SwapTotal:", &info->swap_total},
+    {"SwapFree:", &info->swap_free}};
+
+  // Each line is "<name>: <value> kB"
+  for (char * line = buffer; line != nullptr && *line != '\0';) {
+    char * next = std::strchr(line, '\n');
+    for (const auto & field : fields) {
+      const size_t length = std::strlen(field.first);
+      if (std::strncmp(line, field.first, length) == 0) {
+        *field.second = std::strtoull(line + length, nullptr, 10) * 1024;
+        break;
+      }
+    }
+    line = next != nullptr ? next + 1 : nullptr;
+  }
+
+  return true;
+}
+
+std::string MemMonitor::toHumanReadable(const size_t bytes)
 {
   const char * units[] = {"B", "K", "M", "G", "T"};
   int count = 0;
-  double size = std::atol(str.c_str());
+  double size = static_cast<double>(bytes);
 
   while (size > 1024) {
     size /= 1024;
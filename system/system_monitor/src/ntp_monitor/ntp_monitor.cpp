@@ -21,17 +21,68 @@
 
 #include "system_monitor/system_monitor_utility.hpp"
 
-#include <boost/filesystem.hpp>
-#include <boost/process.hpp>
-
 #include <fmt/format.h>
 
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <ctime>
 #include <map>
-#include <regex>
 #include <string>
 
-namespace bp = boost::process;
-namespace fs = boost::filesystem;
+namespace
+{
+// Command and monitoring protocol of chrony, see candm.h of chrony
+constexpr uint16_t chrony_port = 323;
+constexpr uint8_t chrony_proto_version = 6;
+constexpr uint8_t chrony_pkt_type_request = 1;
+constexpr uint8_t chrony_pkt_type_reply = 2;
+constexpr uint16_t chrony_req_tracking = 33;
+constexpr uint16_t chrony_rpy_tracking = 5;
+constexpr uint16_t chrony_status_success = 0;
+constexpr size_t chrony_request_header_length = 20;
+constexpr size_t chrony_reply_header_length = 28;
+// Reply of tracking without the end of record, to which the request is padded
+constexpr size_t chrony_tracking_reply_length = chrony_reply_header_length + 76;
+
+uint16_t readUint16(const uint8_t * data)
+{
+  return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+uint32_t readUint32(const uint8_t * data)
+{
+  return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+         (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+}
+
+/**
+ * @brief decode Float of chrony, which has a 7-bit exponent and a 25-bit coefficient
+ */
+double readFloat(const uint8_t * data)
+{
+  constexpr int exp_bits = 7;
+  constexpr int coef_bits = 32 - exp_bits;
+  const uint32_t x = readUint32(data);
+
+  int32_t exp = static_cast<int32_t>(x >> coef_bits);
+  if (exp >= 1 << (exp_bits - 1)) {
+    exp -= 1 << exp_bits;
+  }
+  int32_t coef = static_cast<int32_t>(x % (1U << coef_bits));
+  if (coef >= 1 << (coef_bits - 1)) {
+    coef -= 1 << coef_bits;
+  }
+  return std::ldexp(coef, exp - coef_bits);
+}
+}  // namespace
 
 NTPMonitor::NTPMonitor(const rclcpp::NodeOptions & options)
 : Node("ntp_monitor", options),
@@ -41,10 +92,6 @@ NTPMonitor::NTPMonitor(const rclcpp::NodeOptions & options)
 {
   gethostname(hostname_, sizeof(hostname_));
 
-  // Check if command exists
-  fs::path p = bp::search_path("chronyc");
-  chronyc_exists_ = (p.empty()) ? false : true;
-
   updater_.setHardwareID(hostname_);
   updater_.add("NTP Offset", this, &NTPMonitor::checkOffset);
 }
@@ -56,20 +103,13 @@ void NTPMonitor::checkOffset(diagnostic_updater::DiagnosticStatusWrapper & stat)
   // Remember start time to measure elapsed time
   const auto t_start = SystemMonitorUtility::startMeasurement();
 
-  if (!chronyc_exists_) {
-    stat.summary(DiagStatus::ERROR, "chronyc error");
-    stat.add(
-      "chronyc", "Command 'chronyc' not found, but can be installed with: sudo apt install chrony");
-    return;
-  }
-
   std::string error_str;
   float offset = 0.0f;
   std::map<std::string, std::string> tracking_map;
-  error_str = executeChronyc(offset, tracking_map);
+  error_str = queryChronyTracking(offset, tracking_map);
   if (!error_str.empty()) {
-    stat.summary(DiagStatus::ERROR, "chronyc error");
-    stat.add("chronyc", error_str);
+    stat.summary(DiagStatus::ERROR, "chrony error");
+    stat.add("chrony", error_str);
     return;
   }
 
@@ -91,48 +131,139 @@ void NTPMonitor::checkOffset(diagnostic_updater::DiagnosticStatusWrapper & stat)
   SystemMonitorUtility::stopMeasurement(t_start, stat);
 }
 
-std::string NTPMonitor::executeChronyc(
+std::string NTPMonitor::queryChronyTracking(
   float & out_offset, std::map<std::string, std::string> & out_tracking_map)
 {
-  std::string result;
-
-  // Tracking chrony status
-  bp::ipstream is_out;
-  bp::child c("chronyc tracking", bp::std_out > is_out);
-  c.wait();
-  if (c.exit_code() != 0) {
-    std::ostringstream os;
-    is_out >> os.rdbuf();
-    result = os.str().c_str();
+  // Tracking chrony status as `chronyc tracking`, which is allowed from localhost
+  const int sock = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (sock < 0) {
+    return fmt::format("socket error: {}", strerror(errno));
+  }
+
+  struct timeval tv;
+  tv.tv_sec = 1;
+  tv.tv_usec = 0;
+  if (setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0) {
+    const std::string result = fmt::format("setsockopt error: {}", strerror(errno));
+    close(sock);
     return result;
   }
 
-  std::string line;
-  std::cmatch match;
-  const std::regex filter("^(.+[A-Za-z()]) *: (.*)");
-  const std::regex filter_system_time("([0-9.]*) seconds (slow|fast).*");
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(sockaddr_in));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(chrony_port);
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if (connect(sock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+    const std::string result = fmt::format("connect error: {}", strerror(errno));
+    close(sock);
+    return result;
+  }
 
-  while (std::getline(is_out, line) && !line.empty()) {
-    if (std::regex_match(line.c_str(), match, filter)) {
-      out_tracking_map[match[1].str()] = match[2].str();
-    }
+  // The request is padded to the length of the reply, which chronyd requires
+  uint8_t request[chrony_tracking_reply_length] = {};
+  const uint32_t sequence = ++chrony_sequence_;
+  request[0] = chrony_proto_version;
+  request[1] = chrony_pkt_type_request;
+  request[4] = chrony_req_tracking >> 8;
+  request[5] = chrony_req_tracking & 0xFF;
+  for (int i = 0; i < 4; ++i) {
+    request[8 + i] = static_cast<uint8_t>(sequence >> (24 - 8 * i));
   }
+  static_assert(sizeof(request) > chrony_request_header_length, "request has to be padded");
 
-  // System time : conversion string to float
-  std::string str_system_time = out_tracking_map["System time"];
-  if (std::regex_match(str_system_time.c_str(), match, filter_system_time)) {
-    out_offset = std::atof(match[1].str().c_str());
+  if (send(sock, request, sizeof(request), 0) < 0) {
+    const std::string result = fmt::format("send error: {}", strerror(errno));
+    close(sock);
+    return result;
+  }
 
-    if (match[2].str() == "fast") {
-      // "fast" is - value(match to ntpdate)
-      out_offset *= -1;
-    } else {
-      // "slow" is + value(match to ntpdate)
-    }
+  uint8_t reply[512];
+  const ssize_t length = recv(sock, reply, sizeof(reply), 0);
+  const int recv_errno = errno;
+  close(sock);
+  if (length < 0) {
+    return fmt::format("recv error: {}", strerror(recv_errno));
+  }
+  if (
+    static_cast<size_t>(length) < chrony_reply_header_length || reply[0] != chrony_proto_version ||
+    reply[1] != chrony_pkt_type_reply || readUint16(reply + 4) != chrony_req_tracking ||
+    readUint32(reply + 16) != sequence) {
+    return "invalid reply";
+  }
+  if (readUint16(reply + 8) != chrony_status_success) {
+    return fmt::format("reply status {}", readUint16(reply + 8));
+  }
+  if (
+    readUint16(reply + 6) != chrony_rpy_tracking ||
+    static_cast<size_t>(length) < chrony_tracking_reply_length) {
+    return "invalid tracking reply";
+  }
+
+  // RPY_Tracking
+  const uint8_t * data = reply + chrony_reply_header_length;
+  const uint32_t ref_id = readUint32(data);
+  const uint16_t family = readUint16(data + 20);
+  const uint16_t stratum = readUint16(data + 24);
+  const uint16_t leap_status = readUint16(data + 26);
+  const uint32_t ref_time_high = readUint32(data + 28);
+  const uint32_t ref_time_low = readUint32(data + 32);
+  const double current_correction = readFloat(data + 40);
+  const double last_offset = readFloat(data + 44);
+  const double rms_offset = readFloat(data + 48);
+  const double freq_ppm = readFloat(data + 52);
+  const double resid_freq_ppm = readFloat(data + 56);
+  const double skew_ppm = readFloat(data + 60);
+  const double root_delay = readFloat(data + 64);
+  const double root_dispersion = readFloat(data + 68);
+  const double last_update_interval = readFloat(data + 72);
+
+  // Source address, or the reference ID as characters for reference clocks
+  char name[INET6_ADDRSTRLEN] = "";
+  if (family == 1) {
+    inet_ntop(AF_INET, data + 4, name, sizeof(name));
+  } else if (family == 2) {
+    inet_ntop(AF_INET6, data + 4, name, sizeof(name));
   } else {
-    RCLCPP_WARN(get_logger(), "regex_match: illegal result. str = %s", str_system_time.c_str());
+    for (int i = 0, j = 0; i < 4; ++i) {
+      const char c = static_cast<char>(ref_id >> (24 - 8 * i));
+      if (std::isprint(static_cast<unsigned char>(c)) && c != ' ') {
+        name[j++] = c;
+      }
+    }
   }
-  return result;
+
+  // 0x7fffffff of the high bits means that they are not used
+  const time_t ref_time = static_cast<time_t>(
+    (ref_time_high == 0x7fffffff ? 0 : static_cast<uint64_t>(ref_time_high) << 32) | ref_time_low);
+  struct tm tm;
+  char ref_time_str[64] = "";
+  gmtime_r(&ref_time, &tm);
+  strftime(ref_time_str, sizeof(ref_time_str), "%a %b %d %H:%M:%S %Y", &tm);
+
+  const char * leap_status_str[] = {"Normal", "Insert second", "Delete second", "Not synchronised"};
+
+  out_tracking_map["Reference ID"] = fmt::format("{:08X} ({})", ref_id, name);
+  out_tracking_map["Stratum"] = std::to_string(stratum);
+  out_tracking_map["Ref time (UTC)"] = ref_time_str;
+  out_tracking_map["System time"] = fmt::format(
+    "{:.9f} seconds {} of NTP time", std::fabs(current_correction),
+    current_correction > 0.0 ? "slow" : "fast");
+  out_tracking_map["Last offset"] = fmt::format("{:+.9f} seconds", last_offset);
+  out_tracking_map["RMS offset"] = fmt::format("{:.9f} seconds", rms_offset);
+  out_tracking_map["Frequency"] =
+    fmt::format("{:.3f} ppm {}", std::fabs(freq_ppm), freq_ppm < 0.0 ? "slow" : "fast");
+  out_tracking_map["Residual freq"] = fmt::format("{:+.3f} ppm", resid_freq_ppm);
+  out_tracking_map["Skew"] = fmt::format("{:.3f} ppm", skew_ppm);
+  out_tracking_map["Root delay"] = fmt::format("{:.9f} seconds", root_delay);
+  out_tracking_map["Root dispersion"] = fmt::format("{:.9f} seconds", root_dispersion);
+  out_tracking_map["Update interval"] = fmt::format("{:.1f} seconds", last_update_interval);
+  out_tracking_map["Leap status"] = leap_status < 4 ? leap_status_str[leap_status] : "Unknown";
+
+  // "slow" is + value(match to ntpdate)
+  out_offset = static_cast<float>(current_correction);
+
+  return "";
 }
 
 #include <rclcpp_components/register_node_macro.hpp>
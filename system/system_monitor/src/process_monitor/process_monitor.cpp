@@ -25,16 +25,64 @@
 
 #include <fmt/format.h>
 
+#include <dirent.h>
+#include <pwd.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
-#include <regex>
 #include <string>
+#include <utility>
 #include <vector>
 
+namespace
+{
+/**
+ * @brief get a value (kb) of /proc/meminfo
+ * @param [in] name name of the value with the colon, e.g. "MemTotal:"
+ * @return the value, or 0 if it is not found
+ */
+uint64_t getMemInfo(const char * name)
+{
+  char buffer[8192];
+  if (SystemMonitorUtility::readProcFile("/proc/meminfo", buffer, sizeof(buffer)) < 0) {
+    return 0;
+  }
+  const char * line = std::strstr(buffer, name);
+  if (line == nullptr) {
+    return 0;
+  }
+  return std::strtoull(line + std::strlen(name), nullptr, 10);
+}
+
+/**
+ * @brief format CPU time as TIME+ of top, i.e. minutes:seconds.hundredths
+ * @param [in] ticks CPU time (clock ticks)
+ * @param [in] ticks_per_sec clock ticks per second
+ */
+std::string formatCPUTime(const uint64_t ticks, const int64_t ticks_per_sec)
+{
+  const uint64_t centiseconds = ticks * 100 / static_cast<uint64_t>(ticks_per_sec);
+  return fmt::format(
+    "{}:{:02}.{:02}", centiseconds / 6000, centiseconds / 100 % 60, centiseconds % 100);
+}
+}  // namespace
+
 ProcessMonitor::ProcessMonitor(const rclcpp::NodeOptions & options)
 : Node("process_monitor", options),
   updater_(this),
   num_of_procs_(declare_parameter<int>("num_of_procs", 5)),
-  is_top_error_(false)
+  clock_ticks_per_sec_(sysconf(_SC_CLK_TCK)),
+  page_size_kb_(sysconf(_SC_PAGESIZE) / 1024),
+  has_previous_sample_(false),
+  is_proc_read_(false),
+  is_proc_error_(false),
+  elapsed_ms_(0.0)
 {
   using namespace std::literals::chrono_literals;
 
@@ -56,7 +104,7 @@ ProcessMonitor::ProcessMonitor(const rclcpp::NodeOptions & options)
     updater_.add(*task);
   }
 
-  // Start timer to execute top command
+  // Start timer to read processes
   timer_callback_group_ = this->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
   timer_ = rclcpp::create_timer(
     this, get_clock(), 1s, std::bind(&ProcessMonitor::onTimer, this), timer_callback_group_);
@@ -65,245 +113,183 @@ ProcessMonitor::ProcessMonitor(const rclcpp::NodeOptions & options)
 void ProcessMonitor::monitorProcesses(diagnostic_updater::DiagnosticStatusWrapper & stat)
 {
   // thread-safe read
-  std::string str;
-  bool is_top_error;
+  TasksSummary summary;
+  std::vector<ProcessStatus> high_load_procs;
+  std::vector<ProcessStatus> high_memory_procs;
+  bool is_proc_read;
+  bool is_proc_error;
+  std::string proc_error;
   double elapsed_ms;
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    str = top_output_;
-    is_top_error = is_top_error_;
+    summary = tasks_summary_;
+    high_load_procs = high_load_procs_;
+    high_memory_procs = high_memory_procs_;
+    is_proc_read = is_proc_read_;
+    is_proc_error = is_proc_error_;
+    proc_error = proc_error_;
     elapsed_ms = elapsed_ms_;
   }
 
-  if (is_top_error) {
-    stat.summary(DiagStatus::ERROR, "top error");
-    stat.add("top", str);
-    setErrorContent(&load_tasks_, "top error", "top", str);
-    setErrorContent(&memory_tasks_, "top error", "top", str);
+  if (is_proc_error) {
+    stat.summary(DiagStatus::ERROR, "proc error");
+    stat.add("proc", proc_error);
+    setErrorContent(&load_tasks_, "proc error", "proc", proc_error);
+    setErrorContent(&memory_tasks_, "proc error", "proc", proc_error);
     return;
   }
 
-  // If top still not running
-  if (str.empty()) {
+  // If processes still not read
+  if (!is_proc_read) {
     // Send OK tentatively
     stat.summary(DiagStatus::OK, "starting up");
     return;
   }
 
-  // Get task summary
-  getTasksSummary(stat, str);
-  // Remove header
-  removeHeader(stat, str);
+  // Set task summary
+  stat.add("total", summary.total);
+  stat.add("running", summary.running);
+  stat.add("sleeping", summary.sleeping);
+  stat.add("stopped", summary.stopped);
+  stat.add("zombie", summary.zombie);
+  stat.summary(DiagStatus::OK, "OK");
 
-  // Get high load processes
-  getHighLoadProcesses(str);
+  // Set high load processes
+  setTopratedProcesses(&load_tasks_, high_load_procs);
 
-  // Get high memory processes
-  getHighMemoryProcesses(str);
+  // Set high memory processes
+  setTopratedProcesses(&memory_tasks_, high_memory_procs);
 
   stat.addf("execution time", "%f ms", elapsed_ms);
 }
 
-void ProcessMonitor::getTasksSummary(
-  diagnostic_updater::DiagnosticStatusWrapper & stat, const std::string & output)
+bool ProcessMonitor::readProcesses(
+  std::vector<ProcessStatus> * processes, TasksSummary * summary, std::string * error)
 {
-  bp::pipe p;
-  std::string line;
-
-  // Echo output for grep
-  {
-    bp::ipstream is_out;
-    bp::ipstream is_err;
-    bp::child c(fmt::format("echo {}", output), bp::std_out > p, bp::std_err > is_err);
-    c.wait();
-    if (c.exit_code() != 0) {
-      std::ostringstream os;
-      is_err >> os.rdbuf();
-      stat.summary(DiagStatus::ERROR, "echo error");
-      stat.add("echo", os.str().c_str());
-      return;
-    }
+  DIR * dir = opendir("/proc");
+  if (dir == nullptr) {
+    *error = fmt::format("Failed to open /proc: {}", std::strerror(errno));
+    return false;
   }
-  // Find matching pattern of summary
-  {
-    bp::ipstream is_out;
-    bp::child c("grep Tasks:", bp::std_out > is_out, bp::std_in < p);
-    c.wait();
-    // no matching line
-    if (c.exit_code() != 0) {
-      stat.summary(DiagStatus::ERROR, "matching pattern not found");
-      stat.add("name", "Tasks:");
-      return;
-    }
 
-    std::getline(is_out, line);
-    std::cmatch match;
-    const std::regex filter(
-      "^Tasks: (\\d+) total,\\s+(\\d+) running,\\s+(\\d+) sleeping,\\s+(\\d+) stopped,\\s+(\\d+) "
-      "zombie");
-
-    if (std::regex_match(line.c_str(), match, filter)) {
-      stat.add("total", match[1].str());
-      stat.add("running", match[2].str());
-      stat.add("sleeping", match[3].str());
-      stat.add("stopped", match[4].str());
-      stat.add("zombie", match[5].str());
-      stat.summary(DiagStatus::OK, "OK");
-    } else {
-      stat.summary(DiagStatus::ERROR, "invalid format");
-    }
-  }
-}
+  const uint64_t mem_total = getMemInfo("MemTotal:");
+  char path[64];
+  char buffer[4096];
 
-void ProcessMonitor::removeHeader(
-  diagnostic_updater::DiagnosticStatusWrapper & stat, std::string & output)
-{
-  bp::pipe p1;
-  bp::pipe p2;
-  std::ostringstream os;
+  while (const dirent * entry = readdir(dir)) {
+    char * end = nullptr;
+    const int64_t pid = std::strtol(entry->d_name, &end, 10);
+    if (end == entry->d_name || *end != '\0') {
+      continue;
+    }
 
-  // Echo output for sed
-  {
-    bp::ipstream is_err;
-    bp::child c(fmt::format("echo {}", output), bp::std_out > p1, bp::std_err > is_err);
-    c.wait();
-    if (c.exit_code() != 0) {
-      is_err >> os.rdbuf();
-      stat.summary(DiagStatus::ERROR, "echo error");
-      stat.add("echo", os.str().c_str());
-      return;
+    // The process may exit while it is read
+    std::snprintf(path, sizeof(path), "/proc/%ld", static_cast<long>(pid));  // NOLINT
+    struct stat st;
+    if (stat(path, &st) != 0) {
+      continue;
     }
-  }
-  // Remove %Cpu section
-  {
-    bp::ipstream is_err;
-    bp::child c("sed \"/^%Cpu/d\"", bp::std_out > p2, bp::std_err > is_err, bp::std_in < p1);
-    c.wait();
-    // no matching line
-    if (c.exit_code() != 0) {
-      stat.summary(DiagStatus::ERROR, "sed error");
-      stat.add("sed", "Failed to remove header");
-      return;
+
+    std::snprintf(path, sizeof(path), "/proc/%ld/stat", static_cast<long>(pid));  // NOLINT
+    if (SystemMonitorUtility::readProcFile(path, buffer, sizeof(buffer)) <= 0) {
+      continue;
     }
-  }
-  // Remove header
-  {
-    bp::ipstream is_out;
-    bp::ipstream is_err;
-    bp::child c("sed \"1,6d\"", bp::std_out > is_out, bp::std_err > is_err, bp::std_in < p2);
-    c.wait();
-    // no matching line
-    if (c.exit_code() != 0) {
-      stat.summary(DiagStatus::ERROR, "sed error");
-      stat.add("sed", "Failed to remove header");
-      return;
+    // The command name is enclosed by parentheses, which may contain any characters
+    char * comm_begin = std::strchr(buffer, '(');
+    char * comm_end = std::strrchr(buffer, ')');
+    if (comm_begin == nullptr || comm_end == nullptr || comm_end < comm_begin) {
+      continue;
     }
-    // overwrite
-    is_out >> os.rdbuf();
-    output = os.str();
-  }
-}
 
-void ProcessMonitor::getHighLoadProcesses(const std::string & output)
-{
-  bp::pipe p;
-  std::ostringstream os;
-
-  // Echo output for sed
-  bp::ipstream is_out;
-  bp::ipstream is_err;
-  bp::child c(fmt::format("echo {}", output), bp::std_out > p, bp::std_err > is_err);
-  c.wait();
-  if (c.exit_code() != 0) {
-    is_err >> os.rdbuf();
-    setErrorContent(&load_tasks_, "echo error", "echo", os.str().c_str());
-    return;
-  }
-
-  // Get top-rated
-  getTopratedProcesses(&load_tasks_, &p);
-}
-
-void ProcessMonitor::getHighMemoryProcesses(const std::string & output)
-{
-  bp::pipe p1;
-  bp::pipe p2;
-  std::ostringstream os;
+    ProcessStatus process;
+    process.pid = static_cast<pid_t>(pid);
+    process.uid = st.st_uid;
+    process.command.assign(comm_begin + 1, comm_end);
+
+    // Fields from (3) state, see proc(5)
+    char state;
+    unsigned long long utime, stime, starttime, vsize;  // NOLINT
+    long priority, nice, rss;                           // NOLINT
+    if (
+      std::sscanf(
+        comm_end + 1,
+        " %c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu %*d %*d %ld %ld %*d %*d %llu "
+        "%llu %ld",
+        &state, &utime, &stime, &priority, &nice, &starttime, &vsize, &rss) != 8) {
+      continue;
+    }
+    process.state = state;
+    process.priority = priority;
+    process.nice = nice;
+    process.cpu_time_ticks = utime + stime;
+    process.start_time_ticks = starttime;
+    process.virtual_image = vsize / 1024;
+    process.resident_size = static_cast<uint64_t>(std::max(rss, 0L)) * page_size_kb_;
+
+    std::snprintf(path, sizeof(path), "/proc/%ld/statm", static_cast<long>(pid));  // NOLINT
+    unsigned long long shared = 0;  // NOLINT
+    if (SystemMonitorUtility::readProcFile(path, buffer, sizeof(buffer)) > 0) {
+      std::sscanf(buffer, "%*u %*u %llu", &shared);
+    }
+    process.shared_mem_size = shared * page_size_kb_;
 
-  // Echo output for sed
-  {
-    bp::ipstream is_out;
-    bp::ipstream is_err;
-    bp::child c(fmt::format("echo {}", output), bp::std_out > p1, bp::std_err > is_err);
-    c.wait();
-    if (c.exit_code() != 0) {
-      is_err >> os.rdbuf();
-      setErrorContent(&memory_tasks_, "echo error", "echo", os.str().c_str());
-      return;
+    if (mem_total > 0) {
+      process.memory_usage = 100.0 * process.resident_size / mem_total;
     }
-  }
-  // Sort by memory usage
-  {
-    bp::ipstream is_out;
-    bp::ipstream is_err;
-    bp::child c("sort -r -k 10", bp::std_out > p2, bp::std_err > is_err, bp::std_in < p1);
-    c.wait();
-    if (c.exit_code() != 0) {
-      is_err >> os.rdbuf();
-      setErrorContent(&memory_tasks_, "sort error", "sort", os.str().c_str());
-      return;
+
+    ++summary->total;
+    switch (state) {
+      case 'R':
+        ++summary->running;
+        break;
+      case 'S':
+      case 'D':
+      case 'I':
+        ++summary->sleeping;
+        break;
+      case 'T':
+      case 't':
+        ++summary->stopped;
+        break;
+      case 'Z':
+        ++summary->zombie;
+        break;
+      default:
+        break;
     }
+
+    processes->push_back(std::move(process));
   }
+  closedir(dir);
 
-  // Get top-rated
-  getTopratedProcesses(&memory_tasks_, &p2);
+  return true;
 }
 
-void ProcessMonitor::getTopratedProcesses(
-  std::vector<std::shared_ptr<DiagTask>> * tasks, bp::pipe * p)
+void ProcessMonitor::setTopratedProcesses(
+  std::vector<std::shared_ptr<DiagTask>> * tasks, const std::vector<ProcessStatus> & processes)
 {
-  if (tasks == nullptr || p == nullptr) {
-    return;
-  }
-
-  bp::ipstream is_out;
-  bp::ipstream is_err;
-  std::ostringstream os;
-
-  bp::child c(
-    fmt::format("sed -n \"1,{} p\"", num_of_procs_), bp::std_out > is_out, bp::std_err > is_err,
-    bp::std_in < *p);
-
-  c.wait();
-  // Failed to modify line
-  if (c.exit_code() != 0) {
-    is_err >> os.rdbuf();
-    setErrorContent(tasks, "sed error", "sed", os.str().c_str());
+  if (tasks == nullptr) {
     return;
   }
 
-  std::vector<std::string> list;
-  std::string line;
-  int index = 0;
-
-  while (std::getline(is_out, line) && !line.empty()) {
-    boost::trim_left(line);
-    boost::split(list, line, boost::is_space(), boost::token_compress_on);
-
-    tasks->at(index)->setDiagnosticsStatus(DiagStatus::OK, "OK");
-    tasks->at(index)->setProcessId(list[0]);
-    tasks->at(index)->setUserName(list[1]);
-    tasks->at(index)->setPriority(list[2]);
-    tasks->at(index)->setNiceValue(list[3]);
-    tasks->at(index)->setVirtualImage(list[4]);
-    tasks->at(index)->setResidentSize(list[5]);
-    tasks->at(index)->setSharedMemSize(list[6]);
-    tasks->at(index)->setProcessStatus(list[7]);
-    tasks->at(index)->setCPUUsage(list[8]);
-    tasks->at(index)->setMemoryUsage(list[9]);
-    tasks->at(index)->setCPUTime(list[10]);
-    tasks->at(index)->setCommandName(list[11]);
-    ++index;
+  for (size_t index = 0; index < processes.size() && index < tasks->size(); ++index) {
+    const auto & process = processes.at(index);
+    auto & task = tasks->at(index);
+
+    task->setDiagnosticsStatus(DiagStatus::OK, "OK");
+    task->setProcessId(std::to_string(process.pid));
+    task->setUserName(getUserName(process.uid));
+    // top shows real-time priorities as rt
+    task->setPriority(process.priority < -99 ? "rt" : std::to_string(process.priority));
+    task->setNiceValue(std::to_string(process.nice));
+    task->setVirtualImage(std::to_string(process.virtual_image));
+    task->setResidentSize(std::to_string(process.resident_size));
+    task->setSharedMemSize(std::to_string(process.shared_mem_size));
+    task->setProcessStatus(std::string(1, process.state));
+    task->setCPUUsage(fmt::format("{:.1f}", process.cpu_usage));
+    task->setMemoryUsage(fmt::format("{:.1f}", process.memory_usage));
+    task->setCPUTime(formatCPUTime(process.cpu_time_ticks, clock_ticks_per_sec_));
+    task->setCommandName(process.command);
   }
 }
 
@@ -321,36 +307,85 @@ void ProcessMonitor::setErrorContent(
   }
 }
 
-void ProcessMonitor::onTimer()
+std::string ProcessMonitor::getUserName(const uid_t uid)
 {
-  bool is_top_error = false;
+  const auto itr = user_names_.find(uid);
+  if (itr != user_names_.end()) {
+    return itr->second;
+  }
 
+  std::string name = std::to_string(uid);
+  char buffer[4096];
+  struct passwd pwd;
+  struct passwd * result = nullptr;
+  if (getpwuid_r(uid, &pwd, buffer, sizeof(buffer), &result) == 0 && result != nullptr) {
+    name = result->pw_name;
+  }
+  user_names_.emplace(uid, name);
+  return name;
+}
+
+void ProcessMonitor::onTimer()
+{
   // Start to measure elapsed time
   tier4_autoware_utils::StopWatch<std::chrono::milliseconds> stop_watch;
   stop_watch.tic("execution_time");
 
-  bp::ipstream is_err;
-  bp::ipstream is_out;
-  std::ostringstream os;
-
-  // Get processes
-  bp::child c("top -bn1 -o %CPU -w 128", bp::std_out > is_out, bp::std_err > is_err);
-  c.wait();
-
-  if (c.exit_code() != 0) {
-    is_top_error = true;
-    is_err >> os.rdbuf();
-  } else {
-    is_out >> os.rdbuf();
+  std::vector<ProcessStatus> processes;
+  TasksSummary summary;
+  std::string error;
+  const auto now = std::chrono::steady_clock::now();
+  const bool is_proc_error = !readProcesses(&processes, &summary, &error);
+
+  // CPU usage over the timer period as top, which is 100% for a process using a core
+  std::unordered_map<pid_t, std::pair<uint64_t, uint64_t>> cpu_time_ticks;
+  cpu_time_ticks.reserve(processes.size());
+  const double elapsed_ticks =
+    std::chrono::duration<double>(now - previous_time_).count() * clock_ticks_per_sec_;
+  for (auto & process : processes) {
+    cpu_time_ticks.emplace(
+      process.pid, std::make_pair(process.start_time_ticks, process.cpu_time_ticks));
+    if (!has_previous_sample_ || elapsed_ticks <= 0.0) {
+      continue;
+    }
+    // A process started after the last read, or whose pid is reused, used all its CPU time since
+    uint64_t previous_ticks = 0;
+    const auto itr = previous_cpu_time_ticks_.find(process.pid);
+    if (itr != previous_cpu_time_ticks_.end() && itr->second.first == process.start_time_ticks) {
+      previous_ticks = std::min(itr->second.second, process.cpu_time_ticks);
+    }
+    process.cpu_usage = 100.0 * (process.cpu_time_ticks - previous_ticks) / elapsed_ticks;
   }
+  const bool is_proc_read = has_previous_sample_ && !is_proc_error;
+  has_previous_sample_ = !is_proc_error;
+  previous_time_ = now;
+  previous_cpu_time_ticks_ = std::move(cpu_time_ticks);
+
+  // Only the top-rated processes are shown
+  const size_t num_of_procs = std::min(processes.size(), static_cast<size_t>(num_of_procs_));
+  std::vector<ProcessStatus> high_load_procs = processes;
+  std::partial_sort(
+    high_load_procs.begin(), high_load_procs.begin() + num_of_procs, high_load_procs.end(),
+    [](const ProcessStatus & a, const ProcessStatus & b) { return a.cpu_usage > b.cpu_usage; });
+  high_load_procs.resize(num_of_procs);
+  std::partial_sort(
+    processes.begin(), processes.begin() + num_of_procs, processes.end(),
+    [](const ProcessStatus & a, const ProcessStatus & b) {
+      return a.resident_size > b.resident_size;
+    });
+  processes.resize(num_of_procs);
 
   const double elapsed_ms = stop_watch.toc("execution_time");
 
   // thread-safe copy
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    top_output_ = os.str();
-    is_top_error_ = is_top_error;
+    tasks_summary_ = summary;
+    high_load_procs_ = std::move(high_load_procs);
+    high_memory_procs_ = std::move(processes);
+    is_proc_read_ = is_proc_read;
+    is_proc_error_ = is_proc_error;
+    proc_error_ = error;
     elapsed_ms_ = elapsed_ms;
   }
 }
@@ -18,6 +18,7 @@
 #include <rclcpp/rclcpp.hpp>
 
 #include <deque>
+#include <optional>
 #include <string>
 
 namespace topic_state_monitor
@@ -33,6 +34,7 @@ struct Param
   double error_rate;
   double timeout;
   int window_size;
+  bool use_header_stamp;
 };
 
 enum class TopicStatus : int8_t {
@@ -52,8 +54,12 @@ public:
 
   rclcpp::Time getLastMessageTime() const { return last_message_time_; }
   double getTopicRate() const { return topic_rate_; }
+  // standard deviation of the intervals of the messages in the window
+  double getTopicJitter() const { return topic_jitter_; }
+  // latency of the header stamp of the last message, if it is given to update()
+  std::optional<double> getTopicLatency() const { return topic_latency_; }
 
-  void update();
+  void update(const std::optional<rclcpp::Time> & header_stamp = std::nullopt);
   TopicStatus getTopicStatus() const;
 
 private:
@@ -64,10 +70,13 @@ private:
   std::deque<rclcpp::Time> time_buffer_;
   rclcpp::Time last_message_time_ = rclcpp::Time(0);
   double topic_rate_ = TopicStateMonitor::max_rate;
+  double topic_jitter_ = 0.0;
+  std::optional<double> topic_latency_;
 
   rclcpp::Clock::SharedPtr clock_;
 
   double calcTopicRate() const;
+  double calcTopicJitter() const;
   bool isNotReceived() const;
   bool isWarnRate() const;
   bool isErrorRate() const;
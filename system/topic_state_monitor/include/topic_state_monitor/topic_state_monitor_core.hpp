@@ -39,9 +39,18 @@ public:
   explicit TopicStateMonitorNode(const rclcpp::NodeOptions & node_options);
 
 private:
+  // Monitor of a topic, whose parameters are under the prefix
+  struct Monitor
+  {
+    std::string param_prefix;
+    Param param;
+    std::unique_ptr<TopicStateMonitor> topic_state_monitor;
+    rclcpp::GenericSubscription::SharedPtr sub_topic;
+  };
+
   // Parameter
   NodeParam node_param_;
-  Param param_;
+  Param declareTopicParam(const std::string & prefix);
 
   // Parameter Reconfigure
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
@@ -49,10 +58,9 @@ private:
     const std::vector<rclcpp::Parameter> & parameters);
 
   // Core
-  std::unique_ptr<TopicStateMonitor> topic_state_monitor_;
-
-  // Subscriber
-  rclcpp::GenericSubscription::SharedPtr sub_topic_;
+  // the topic of the parameters without prefix, or each one of the topics parameter
+  std::vector<std::unique_ptr<Monitor>> monitors_;
+  void addMonitor(const std::string & param_prefix);
 
   // Timer
   void onTimer();
@@ -61,7 +69,8 @@ private:
   // Diagnostic Updater
   diagnostic_updater::Updater updater_;
 
-  void checkTopicStatus(diagnostic_updater::DiagnosticStatusWrapper & stat);
+  void checkTopicStatus(
+    const Monitor & monitor, diagnostic_updater::DiagnosticStatusWrapper & stat);
 };
 }  // namespace topic_state_monitor
 
@@ -14,11 +14,13 @@
 
 #include "topic_state_monitor/topic_state_monitor.hpp"
 
+#include <cmath>
+
 namespace topic_state_monitor
 {
 TopicStateMonitor::TopicStateMonitor(rclcpp::Node & node) : clock_(node.get_clock()) {}
 
-void TopicStateMonitor::update()
+void TopicStateMonitor::update(const std::optional<rclcpp::Time> & header_stamp)
 {
   // Add data
   last_message_time_ = clock_->now();
@@ -31,6 +33,12 @@ void TopicStateMonitor::update()
 
   // Calc topic rate
   topic_rate_ = calcTopicRate();
+  topic_jitter_ = calcTopicJitter();
+
+  // Calc latency
+  if (header_stamp) {
+    topic_latency_ = (last_message_time_ - *header_stamp).seconds();
+  }
 }
 
 TopicStatus TopicStateMonitor::getTopicStatus() const
@@ -64,6 +72,24 @@ double TopicStateMonitor::calcTopicRate() const
   return static_cast<double>(num_intervals) / time_diff;
 }
 
+double TopicStateMonitor::calcTopicJitter() const
+{
+  if (time_buffer_.size() < 3) {
+    return 0.0;
+  }
+
+  const auto num_intervals = static_cast<double>(time_buffer_.size() - 1);
+  const auto mean_interval = (time_buffer_.back() - time_buffer_.front()).seconds() / num_intervals;
+
+  double sum_squared_error = 0.0;
+  for (size_t i = 1; i < time_buffer_.size(); ++i) {
+    const auto error = (time_buffer_.at(i) - time_buffer_.at(i - 1)).seconds() - mean_interval;
+    sum_squared_error += error * error;
+  }
+
+  return std::sqrt(sum_squared_error / num_intervals);
+}
+
 bool TopicStateMonitor::isNotReceived() const { return time_buffer_.empty(); }
 
 bool TopicStateMonitor::isWarnRate() const
@@ -14,7 +14,9 @@
 
 #include "topic_state_monitor/topic_state_monitor_core.hpp"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -32,6 +34,33 @@ void update_param(
     value = it->template get_value<T>();
   }
 }
+
+/**
+ * @brief header stamp of a serialized message whose first field is std_msgs/Header, which
+ *        is read from the CDR encoding without deserializing the message
+ */
+std::optional<rclcpp::Time> getHeaderStamp(
+  const rclcpp::SerializedMessage & msg, const rcl_clock_type_t clock_type)
+{
+  // encapsulation (4 bytes), builtin_interfaces/Time (int32 sec, uint32 nanosec)
+  const auto & serialized_msg = msg.get_rcl_serialized_message();
+  if (serialized_msg.buffer_length < 12) {
+    return std::nullopt;
+  }
+
+  const uint8_t * buffer = serialized_msg.buffer;
+  const bool is_little_endian = buffer[1] == 0x01;
+  const auto read_uint32 = [&](const size_t offset) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < 4; ++i) {
+      const auto byte = static_cast<uint32_t>(buffer[offset + (is_little_endian ? i : 3 - i)]);
+      value |= byte << (8 * i);
+    }
+    return value;
+  };
+
+  return rclcpp::Time(static_cast<int32_t>(read_uint32(4)), read_uint32(8), clock_type);
+}
 }  // namespace
 
 namespace topic_state_monitor
@@ -42,46 +71,81 @@ TopicStateMonitorNode::TopicStateMonitorNode(const rclcpp::NodeOptions & node_op
   using std::placeholders::_1;
   // Parameter
   node_param_.update_rate = declare_parameter("update_rate", 10.0);
-  param_.topic = declare_parameter<std::string>("topic");
-  param_.topic_type = declare_parameter<std::string>("topic_type");
-  param_.transient_local = declare_parameter("transient_local", false);
-  param_.best_effort = declare_parameter("best_effort", false);
-  param_.diag_name = declare_parameter<std::string>("diag_name");
-  param_.warn_rate = declare_parameter("warn_rate", 0.5);
-  param_.error_rate = declare_parameter("error_rate", 0.1);
-  param_.timeout = declare_parameter("timeout", 1.0);
-  param_.window_size = declare_parameter("window_size", 10);
+
+  // Core
+  // Monitor many topics in the node with the parameters of each topic under its name, or the topic
+  const auto topics = declare_parameter("topics", std::vector<std::string>{});
+  if (topics.empty()) {
+    addMonitor("");
+  }
+  for (const auto & topic : topics) {
+    addMonitor(topic + ".");
+  }
 
   // Parameter Reconfigure
   set_param_res_ =
     this->add_on_set_parameters_callback(std::bind(&TopicStateMonitorNode::onParameter, this, _1));
 
-  // Core
-  topic_state_monitor_ = std::make_unique<TopicStateMonitor>(*this);
-  topic_state_monitor_->setParam(param_);
+  // Diagnostic Updater
+  updater_.setHardwareID("topic_state_monitor");
+  for (const auto & monitor : monitors_) {
+    updater_.add(
+      monitor->param.diag_name,
+      [this, &monitor = *monitor](diagnostic_updater::DiagnosticStatusWrapper & stat) {
+        checkTopicStatus(monitor, stat);
+      });
+  }
+
+  // Timer
+  const auto period_ns = rclcpp::Rate(node_param_.update_rate).period();
+  timer_ = rclcpp::create_timer(
+    this, get_clock(), period_ns, std::bind(&TopicStateMonitorNode::onTimer, this));
+}
+
+Param TopicStateMonitorNode::declareTopicParam(const std::string & prefix)
+{
+  Param param;
+  param.topic = declare_parameter<std::string>(prefix + "topic");
+  param.topic_type = declare_parameter<std::string>(prefix + "topic_type");
+  param.transient_local = declare_parameter(prefix + "transient_local", false);
+  param.best_effort = declare_parameter(prefix + "best_effort", false);
+  param.diag_name = declare_parameter<std::string>(prefix + "diag_name");
+  param.warn_rate = declare_parameter(prefix + "warn_rate", 0.5);
+  param.error_rate = declare_parameter(prefix + "error_rate", 0.1);
+  param.timeout = declare_parameter(prefix + "timeout", 1.0);
+  param.window_size = declare_parameter(prefix + "window_size", 10);
+  param.use_header_stamp = declare_parameter(prefix + "use_header_stamp", false);
+  return param;
+}
+
+void TopicStateMonitorNode::addMonitor(const std::string & param_prefix)
+{
+  auto monitor = std::make_unique<Monitor>();
+  monitor->param_prefix = param_prefix;
+  monitor->param = declareTopicParam(param_prefix);
+  monitor->topic_state_monitor = std::make_unique<TopicStateMonitor>(*this);
+  monitor->topic_state_monitor->setParam(monitor->param);
 
   // Subscriber
   rclcpp::QoS qos = rclcpp::QoS{1};
-  if (param_.transient_local) {
+  if (monitor->param.transient_local) {
     qos.transient_local();
   }
-  if (param_.best_effort) {
+  if (monitor->param.best_effort) {
     qos.best_effort();
   }
-  sub_topic_ = this->create_generic_subscription(
-    param_.topic, param_.topic_type, qos,
-    [this]([[maybe_unused]] std::shared_ptr<rclcpp::SerializedMessage> msg) {
-      topic_state_monitor_->update();
+  // The messages are not deserialized, and only the header stamp is read if it is used
+  monitor->sub_topic = this->create_generic_subscription(
+    monitor->param.topic, monitor->param.topic_type, qos,
+    [this, &monitor = *monitor](std::shared_ptr<rclcpp::SerializedMessage> msg) {
+      if (monitor.param.use_header_stamp) {
+        monitor.topic_state_monitor->update(getHeaderStamp(*msg, get_clock()->get_clock_type()));
+      } else {
+        monitor.topic_state_monitor->update();
+      }
     });
 
-  // Diagnostic Updater
-  updater_.setHardwareID("topic_state_monitor");
-  updater_.add(param_.diag_name, this, &TopicStateMonitorNode::checkTopicStatus);
-
-  // Timer
-  const auto period_ns = rclcpp::Rate(node_param_.update_rate).period();
-  timer_ = rclcpp::create_timer(
-    this, get_clock(), period_ns, std::bind(&TopicStateMonitorNode::onTimer, this));
+  monitors_.push_back(std::move(monitor));
 }
 
 rcl_interfaces::msg::SetParametersResult TopicStateMonitorNode::onParameter(
@@ -92,10 +156,14 @@ rcl_interfaces::msg::SetParametersResult TopicStateMonitorNode::onParameter(
   result.reason = "success";
 
   try {
-    update_param(parameters, "warn_rate", param_.warn_rate);
-    update_param(parameters, "error_rate", param_.error_rate);
-    update_param(parameters, "timeout", param_.timeout);
-    update_param(parameters, "window_size", param_.window_size);
+    for (auto & monitor : monitors_) {
+      const auto & prefix = monitor->param_prefix;
+      update_param(parameters, prefix + "warn_rate", monitor->param.warn_rate);
+      update_param(parameters, prefix + "error_rate", monitor->param.error_rate);
+      update_param(parameters, prefix + "timeout", monitor->param.timeout);
+      update_param(parameters, prefix + "window_size", monitor->param.window_size);
+      monitor->topic_state_monitor->setParam(monitor->param);
+    }
   } catch (const rclcpp::exceptions::InvalidParameterTypeException & e) {
     result.successful = false;
     result.reason = e.what();
@@ -110,17 +178,23 @@ void TopicStateMonitorNode::onTimer()
   updater_.force_update();
 }
 
-void TopicStateMonitorNode::checkTopicStatus(diagnostic_updater::DiagnosticStatusWrapper & stat)
+void TopicStateMonitorNode::checkTopicStatus(
+  const Monitor & monitor, diagnostic_updater::DiagnosticStatusWrapper & stat)
 {
   using diagnostic_msgs::msg::DiagnosticStatus;
 
+  const auto & param = monitor.param;
+  const auto & topic_state_monitor = monitor.topic_state_monitor;
+
   // Get information
-  const auto topic_status = topic_state_monitor_->getTopicStatus();
-  const auto last_message_time = topic_state_monitor_->getLastMessageTime();
-  const auto topic_rate = topic_state_monitor_->getTopicRate();
+  const auto topic_status = topic_state_monitor->getTopicStatus();
+  const auto last_message_time = topic_state_monitor->getLastMessageTime();
+  const auto topic_rate = topic_state_monitor->getTopicRate();
+  const auto topic_jitter = topic_state_monitor->getTopicJitter();
+  const auto topic_latency = topic_state_monitor->getTopicLatency();
 
   // Add topic name
-  stat.addf("topic", "%s", param_.topic.c_str());
+  stat.addf("topic", "%s", param.topic.c_str());
 
   // Judge level
   int8_t level = DiagnosticStatus::OK;
@@ -142,10 +216,14 @@ void TopicStateMonitorNode::checkTopicStatus(diagnostic_updater::DiagnosticStatu
   }
 
   // Add key-value
-  stat.addf("warn_rate", "%.2f [Hz]", param_.warn_rate);
-  stat.addf("error_rate", "%.2f [Hz]", param_.error_rate);
-  stat.addf("timeout", "%.2f [s]", param_.timeout);
+  stat.addf("warn_rate", "%.2f [Hz]", param.warn_rate);
+  stat.addf("error_rate", "%.2f [Hz]", param.error_rate);
+  stat.addf("timeout", "%.2f [s]", param.timeout);
   stat.addf("measured_rate", "%.2f [Hz]", topic_rate);
+  stat.addf("measured_jitter", "%.4f [s]", topic_jitter);
+  if (topic_latency) {
+    stat.addf("measured_latency", "%.4f [s]", *topic_latency);
+  }
   stat.addf("now", "%.2f [s]", this->now().seconds());
   stat.addf("last_message_time", "%.2f [s]", last_message_time.seconds());
 
@@ -1,9 +1,12 @@
+from glob import glob
+
 from setuptools import setup
 
 package_name = "simulator_compatibility_test"
 clients = "simulator_compatibility_test/clients/"
 publishers = "simulator_compatibility_test/publishers/"
 subscribers = "simulator_compatibility_test/subscribers/"
+benchmark = "simulator_compatibility_test/benchmark/"
 
 clients_moraisim = "simulator_compatibility_test/clients/moraisim/"
 publishers_moraisim = "simulator_compatibility_test/publishers/moraisim/"
@@ -16,12 +19,17 @@ setup(
         clients,
         publishers,
         subscribers,
+        benchmark,
         clients_moraisim,
         publishers_moraisim,
     ],
     data_files=[
         ("share/ament_index/resource_index/packages", ["resource/" + package_name]),
         ("share/" + package_name, ["package.xml"]),
+        (
+            "share/" + package_name + "/benchmark_scenarios",
+            glob("benchmark_scenarios/*.yaml"),
+        ),
     ],
     install_requires=["setuptools"],
     zip_safe=True,
@@ -95,6 +103,13 @@ setup(
                 + "simulator_compatibility_test"
                 + ".subscribers.hazard_lights_report:main"
             ),
+            # Benchmark
+            (
+                "planning_latency_benchmark"
+                + "="
+                + "simulator_compatibility_test"
+                + ".benchmark.planning_latency_benchmark:main"
+            ),
         ],
     },
 )
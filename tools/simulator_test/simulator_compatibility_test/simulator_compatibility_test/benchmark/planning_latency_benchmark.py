@@ -0,0 +1,365 @@
+import csv
+import math
+import sys
+import time
+import uuid
+
+from autoware_auto_perception_msgs.msg import ObjectClassification
+from autoware_auto_perception_msgs.msg import Shape
+from autoware_auto_planning_msgs.msg import Path
+from autoware_auto_planning_msgs.msg import PathWithLaneId
+from autoware_auto_planning_msgs.msg import Trajectory
+from autoware_auto_vehicle_msgs.msg import Engage
+from builtin_interfaces.msg import Time
+from dummy_perception_publisher.msg import Object
+from geometry_msgs.msg import PoseStamped
+from geometry_msgs.msg import PoseWithCovarianceStamped
+import rclpy
+from rclpy.node import Node
+from rclpy.qos import QoSDurabilityPolicy
+from rclpy.qos import QoSHistoryPolicy
+from rclpy.qos import QoSProfile
+from rclpy.qos import QoSReliabilityPolicy
+from rosgraph_msgs.msg import Clock
+import yaml
+
+# the chain of the lane driving planning, from the behavior path planner to the scenario output
+DEFAULT_STAGE_TOPICS = [
+    "/planning/scenario_planning/lane_driving/behavior_planning/path_with_lane_id",
+    "/planning/scenario_planning/lane_driving/behavior_planning/path",
+    "/planning/scenario_planning/lane_driving/motion_planning"
+    + "/obstacle_avoidance_planner/trajectory",
+    "/planning/scenario_planning/lane_driving/trajectory",
+    "/planning/scenario_planning/scenario_selector/trajectory",
+    "/planning/scenario_planning/trajectory",
+]
+
+OBJECT_LABELS = {
+    "car": ObjectClassification.CAR,
+    "truck": ObjectClassification.TRUCK,
+    "bus": ObjectClassification.BUS,
+    "bicycle": ObjectClassification.BICYCLE,
+    "pedestrian": ObjectClassification.PEDESTRIAN,
+}
+
+
+def stage_msg_type(topic):
+    if topic.endswith("path_with_lane_id"):
+        return PathWithLaneId
+    if topic.endswith("path"):
+        return Path
+    return Trajectory
+
+
+def yaw_to_quaternion(msg_orientation, yaw):
+    msg_orientation.z = math.sin(yaw / 2.0)
+    msg_orientation.w = math.cos(yaw / 2.0)
+
+
+def percentile(sorted_values, ratio):
+    if not sorted_values:
+        return float("nan")
+    index = min(len(sorted_values) - 1, max(0, math.ceil(ratio * len(sorted_values)) - 1))
+    return sorted_values[index]
+
+
+class PlanningLatencyBenchmark(Node):
+    """
+    Drive a scenario through the planning stack with simple_planning_simulator in lockstep.
+
+    The benchmark owns /clock: the simulator and the planning nodes are to run with use_sim_time.
+    The clock is advanced by a planning period in sub-steps, then held on the period boundary,
+    where the timers of the planning nodes fire, until the final trajectory of the cycle arrives.
+    So a cycle is measured alone whatever the load, and a run is reproducible.
+    """
+
+    def __init__(self):
+        super().__init__("planning_latency_benchmark")
+
+        self.declare_parameter("scenario", "")
+        self.declare_parameter("initial_pose", [0.0])
+        self.declare_parameter("goal_pose", [0.0])
+        self.declare_parameter("stage_topics", DEFAULT_STAGE_TOPICS)
+        self.declare_parameter("planning_period_sec", 0.1)
+        self.declare_parameter("sim_step_num", 10)
+        self.declare_parameter("sim_step_wait_sec", 0.002)
+        self.declare_parameter("timeout_sec", 1.0)
+        self.declare_parameter("warmup_cycle_num", 10)
+        self.declare_parameter("output_file", "")
+        self.declare_parameter("max_latency_p99_ms", 0.0)
+
+        with open(self.get_parameter("scenario").value) as f:
+            self.scenario = yaml.safe_load(f)
+        self.name = self.scenario.get("name", "scenario")
+
+        # the poses depend on the map, so that they are usually given apart from the scenario
+        self.initial_pose = self.get_pose_parameter("initial_pose")
+        self.goal_pose = self.get_pose_parameter("goal_pose")
+
+        self.stage_topics = self.scenario.get(
+            "stage_topics", self.get_parameter("stage_topics").value
+        )
+        self.planning_period = self.get_parameter("planning_period_sec").value
+        self.sim_step_num = self.get_parameter("sim_step_num").value
+        self.sim_step_wait = self.get_parameter("sim_step_wait_sec").value
+        self.timeout = self.get_parameter("timeout_sec").value
+        self.warmup_cycle_num = self.get_parameter("warmup_cycle_num").value
+        self.output_file = self.get_parameter("output_file").value
+        self.max_latency_p99_ms = self.get_parameter("max_latency_p99_ms").value
+
+        QOS_RKL1V = QoSProfile(
+            reliability=QoSReliabilityPolicy.RELIABLE,
+            history=QoSHistoryPolicy.KEEP_LAST,
+            depth=1,
+            durability=QoSDurabilityPolicy.VOLATILE,
+        )
+        QOS_RKL1TL = QoSProfile(
+            reliability=QoSReliabilityPolicy.RELIABLE,
+            history=QoSHistoryPolicy.KEEP_LAST,
+            depth=1,
+            durability=QoSDurabilityPolicy.TRANSIENT_LOCAL,
+        )
+        QOS_RKL100V = QoSProfile(
+            reliability=QoSReliabilityPolicy.RELIABLE,
+            history=QoSHistoryPolicy.KEEP_LAST,
+            depth=100,
+            durability=QoSDurabilityPolicy.VOLATILE,
+        )
+        self.clock_publisher_ = self.create_publisher(Clock, "/clock", QOS_RKL1V)
+        self.initial_pose_publisher_ = self.create_publisher(
+            PoseWithCovarianceStamped, "/initialpose", QOS_RKL1V
+        )
+        self.goal_publisher_ = self.create_publisher(
+            PoseStamped, "/planning/mission_planning/goal", QOS_RKL1V
+        )
+        self.object_publisher_ = self.create_publisher(
+            Object, "/simulation/dummy_perception_publisher/object_info", QOS_RKL100V
+        )
+        self.engage_publisher_ = self.create_publisher(Engage, "/autoware/engage", QOS_RKL1TL)
+
+        self.stage_subscriptions_ = [
+            self.create_subscription(
+                stage_msg_type(topic),
+                topic,
+                lambda msg, stage=stage: self.on_stage_output(stage),
+                QOS_RKL1V,
+            )
+            for stage, topic in enumerate(self.stage_topics)
+        ]
+
+        self.sim_time_ns = 0
+        self.cycle_start = None
+        self.stage_arrivals = [None] * len(self.stage_topics)
+        # the latencies of the stages from the period boundary per cycle, None for a missed stage
+        self.cycles = []
+        self.cycle_num = 0
+        self.timeout_num = 0
+
+    def get_pose_parameter(self, name):
+        pose = self.get_parameter(name).value
+        if len(pose) == 3:
+            return {"x": pose[0], "y": pose[1], "z": 0.0, "yaw": pose[2]}
+        if len(pose) == 4:
+            return {"x": pose[0], "y": pose[1], "z": pose[2], "yaw": pose[3]}
+        if name in self.scenario:
+            return self.scenario[name]
+        raise ValueError(f"{name} is neither given as [x, y, yaw] nor in the scenario")
+
+    def on_stage_output(self, stage):
+        # only the first output of a stage after the period boundary belongs to the cycle
+        if self.cycle_start is not None and self.stage_arrivals[stage] is None:
+            self.stage_arrivals[stage] = time.perf_counter()
+
+    def stamp(self):
+        return Time(sec=self.sim_time_ns // 1000000000, nanosec=self.sim_time_ns % 1000000000)
+
+    def spin_until(self, condition, timeout):
+        deadline = time.perf_counter() + timeout
+        while not condition():
+            remaining = deadline - time.perf_counter()
+            if remaining <= 0.0:
+                return False
+            rclpy.spin_once(self, timeout_sec=remaining)
+        return True
+
+    def step_clock(self, step_ns):
+        self.sim_time_ns += step_ns
+        msg = Clock()
+        msg.clock = self.stamp()
+        self.clock_publisher_.publish(msg)
+
+    def pose_from(self, frame, x, y, yaw):
+        cos_yaw = math.cos(frame["yaw"])
+        sin_yaw = math.sin(frame["yaw"])
+        return {
+            "x": frame["x"] + x * cos_yaw - y * sin_yaw,
+            "y": frame["y"] + x * sin_yaw + y * cos_yaw,
+            "z": frame.get("z", 0.0),
+            "yaw": frame["yaw"] + yaw,
+        }
+
+    def publish_initial_pose(self):
+        msg = PoseWithCovarianceStamped()
+        msg.header.stamp = self.stamp()
+        msg.header.frame_id = "map"
+        msg.pose.pose.position.x = self.initial_pose["x"]
+        msg.pose.pose.position.y = self.initial_pose["y"]
+        msg.pose.pose.position.z = self.initial_pose.get("z", 0.0)
+        yaw_to_quaternion(msg.pose.pose.orientation, self.initial_pose["yaw"])
+        self.initial_pose_publisher_.publish(msg)
+
+    def publish_goal(self):
+        msg = PoseStamped()
+        msg.header.stamp = self.stamp()
+        msg.header.frame_id = "map"
+        msg.pose.position.x = self.goal_pose["x"]
+        msg.pose.position.y = self.goal_pose["y"]
+        msg.pose.position.z = self.goal_pose.get("z", 0.0)
+        yaw_to_quaternion(msg.pose.orientation, self.goal_pose["yaw"])
+        self.goal_publisher_.publish(msg)
+
+    def publish_objects(self):
+        msg = Object()
+        msg.header.stamp = self.stamp()
+        msg.header.frame_id = "map"
+        msg.action = Object.DELETEALL
+        self.object_publisher_.publish(msg)
+
+        frames = {"start": self.initial_pose, "goal": self.goal_pose}
+        for obj in self.scenario.get("objects", []):
+            pose = self.pose_from(
+                frames[obj.get("relative_to", "start")],
+                obj.get("x", 0.0),
+                obj.get("y", 0.0),
+                obj.get("yaw", 0.0),
+            )
+            dimensions = obj.get("dimensions", [4.0, 1.8, 2.0])
+
+            msg = Object()
+            msg.header.stamp = self.stamp()
+            msg.header.frame_id = "map"
+            msg.id.uuid = list(uuid.uuid4().bytes)
+            msg.initial_state.pose_covariance.pose.position.x = pose["x"]
+            msg.initial_state.pose_covariance.pose.position.y = pose["y"]
+            msg.initial_state.pose_covariance.pose.position.z = pose["z"]
+            yaw_to_quaternion(msg.initial_state.pose_covariance.pose.orientation, pose["yaw"])
+            msg.initial_state.twist_covariance.twist.linear.x = float(obj.get("velocity", 0.0))
+            classification = ObjectClassification()
+            classification.label = OBJECT_LABELS[obj.get("label", "car")]
+            classification.probability = 1.0
+            msg.classification = classification
+            msg.shape.type = Shape.BOUNDING_BOX
+            msg.shape.dimensions.x = float(dimensions[0])
+            msg.shape.dimensions.y = float(dimensions[1])
+            msg.shape.dimensions.z = float(dimensions[2])
+            msg.action = Object.ADD
+            self.object_publisher_.publish(msg)
+
+    def run_cycle(self):
+        """Advance the clock by a planning period and wait for the final trajectory."""
+        period_ns = int(self.planning_period * 1e9)
+        step_ns = period_ns // self.sim_step_num
+        for _ in range(self.sim_step_num - 1):
+            self.step_clock(step_ns)
+            self.spin_until(lambda: False, self.sim_step_wait)
+
+        self.stage_arrivals = [None] * len(self.stage_topics)
+        self.cycle_start = time.perf_counter()
+        self.step_clock(period_ns - step_ns * (self.sim_step_num - 1))
+        arrived = self.spin_until(lambda: self.stage_arrivals[-1] is not None, self.timeout)
+        self.cycle_start, cycle_start = None, self.cycle_start
+        return arrived, cycle_start
+
+    def run(self):
+        # let the simulator and the planning nodes receive the clock before anything else
+        self.step_clock(int(self.planning_period * 1e9))
+        self.spin_until(lambda: False, 1.0)
+        self.publish_initial_pose()
+        for _ in range(10):
+            self.run_cycle()
+        self.publish_goal()
+        self.publish_objects()
+
+        # the cycles are measured from the first trajectory, i.e. once the route is planned
+        duration_cycle_num = int(self.scenario.get("duration_sec", 30.0) / self.planning_period)
+        first_trajectory = False
+        warmup_cycle_num = self.warmup_cycle_num
+        for _ in range(duration_cycle_num):
+            arrived, cycle_start = self.run_cycle()
+            if not first_trajectory:
+                first_trajectory = arrived
+                continue
+            if warmup_cycle_num > 0:
+                self.engage_publisher_.publish(Engage(engage=True))
+                warmup_cycle_num -= 1
+                continue
+
+            self.cycle_num += 1
+            if not arrived:
+                self.timeout_num += 1
+                continue
+            self.cycles.append(
+                [
+                    None if arrival is None else (arrival - cycle_start) * 1e3
+                    for arrival in self.stage_arrivals
+                ]
+            )
+
+    def report(self):
+        rows = []
+        for stage, topic in enumerate(self.stage_topics):
+            latencies = [c[stage] for c in self.cycles if c[stage] is not None]
+            rows.append(self.make_row("latency", topic, latencies))
+            # the time a stage took after the previous one, i.e. its processing and transport
+            if stage > 0:
+                stage_times = [
+                    c[stage] - c[stage - 1]
+                    for c in self.cycles
+                    if c[stage] is not None and c[stage - 1] is not None
+                ]
+                rows.append(self.make_row("stage", topic, stage_times))
+
+        header = ["scenario", "kind", "topic", "samples", "mean", "p50", "p90", "p99", "max"]
+        self.get_logger().info(
+            f"{self.name}: {self.cycle_num} cycles, {self.timeout_num} timeouts [ms]\n"
+            + "\n".join(",".join(str(v) for v in row) for row in [header] + rows)
+        )
+        if self.output_file:
+            with open(self.output_file, "w", newline="") as f:
+                writer = csv.writer(f)
+                writer.writerow(header)
+                writer.writerows(rows)
+
+        end_to_end = sorted(c[-1] for c in self.cycles)
+        if not end_to_end or self.timeout_num > 0:
+            return False
+        return self.max_latency_p99_ms <= 0.0 or percentile(end_to_end, 0.99) <= (
+            self.max_latency_p99_ms
+        )
+
+    def make_row(self, kind, topic, values):
+        values = sorted(values)
+        mean = sum(values) / len(values) if values else float("nan")
+        stats = [mean] + [percentile(values, r) for r in (0.5, 0.9, 0.99)]
+        stats.append(values[-1] if values else float("nan"))
+        return [self.name, kind, topic, len(values)] + [f"{v:.3f}" for v in stats]
+
+
+def main(args=None):
+    rclpy.init(args=args)
+
+    node = PlanningLatencyBenchmark()
+    passed = False
+    try:
+        node.run()
+        passed = node.report()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        node.destroy_node()
+        rclpy.shutdown()
+    sys.exit(0 if passed else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -49,6 +49,8 @@
 #include "tier4_vehicle_msgs/msg/actuation_status_stamped.hpp"
 #include "tier4_vehicle_msgs/srv/update_accel_brake_map.hpp"
 
+#include <cmath>
+#include <deque>
 #include <fstream>
 #include <iomanip>
 #include <memory>
@@ -69,6 +71,65 @@ struct DataStamped
 };
 using DataStampedPtr = std::shared_ptr<DataStamped>;
 
+// statistics of the measured accelerations of a map cell, updated without keeping the data
+struct CellStatistics
+{
+  std::size_t count{0};
+  double mean{0.0};
+  double m2{0.0};  // sum of the squared differences from the mean
+
+  // Welford's online update
+  void add(const double value)
+  {
+    ++count;
+    const double delta = value - mean;
+    mean += delta / static_cast<double>(count);
+    m2 += delta * (value - mean);
+  }
+  bool empty() const { return count == 0; }
+  double getStandardDeviation() const
+  {
+    return count == 0 ? 0.0 : std::sqrt(m2 / static_cast<double>(count));
+  }
+};
+
+// average of the latest max_size values, updated in O(1) for each value
+class MovingAverage
+{
+public:
+  explicit MovingAverage(const std::size_t max_size) : max_size_{max_size} {}
+
+  void push(const double value)
+  {
+    values_.push_back(value);
+    sum_ += value;
+    while (values_.size() > max_size_) {
+      sum_ -= values_.front();
+      values_.pop_front();
+    }
+
+    // sum up again once in a while not to accumulate the rounding errors
+    if (++push_count_ >= max_size_) {
+      push_count_ = 0;
+      sum_ = 0.0;
+      for (const auto v : values_) {
+        sum_ += v;
+      }
+    }
+  }
+  std::size_t size() const { return values_.size(); }
+  double getAverage() const
+  {
+    return values_.empty() ? 0.0 : sum_ / static_cast<double>(values_.size());
+  }
+
+private:
+  std::size_t max_size_;
+  std::size_t push_count_{0};
+  std::deque<double> values_;
+  double sum_{0.0};
+};
+
 class AccelBrakeMapCalibrator : public rclcpp::Node
 {
 private:
@@ -164,11 +225,11 @@ private:
   // for evaluation
   AccelMap new_accel_map_;
   BrakeMap new_brake_map_;
-  std::vector<double> part_original_accel_mse_que_;
-  std::vector<double> full_original_accel_mse_que_;
-  std::vector<double> new_accel_mse_que_;
   std::size_t full_mse_que_size_ = 100000;
   std::size_t part_mse_que_size_ = 3000;
+  MovingAverage part_original_accel_mse_que_{part_mse_que_size_};
+  MovingAverage full_original_accel_mse_que_{full_mse_que_size_};
+  MovingAverage new_accel_mse_que_{part_mse_que_size_};
   double full_original_accel_rmse_ = 0.0;
   double part_original_accel_rmse_ = 0.0;
   double new_accel_rmse_ = 0.0;
@@ -179,7 +240,7 @@ private:
   std::vector<std::vector<double>> brake_map_value_;
   std::vector<std::vector<double>> update_accel_map_value_;
   std::vector<std::vector<double>> update_brake_map_value_;
-  std::vector<std::vector<std::vector<double>>> map_value_data_;
+  std::vector<std::vector<CellStatistics>> map_value_data_;
   std::vector<double> accel_vel_index_;
   std::vector<double> brake_vel_index_;
   std::vector<double> accel_pedal_index_;
@@ -269,8 +330,6 @@ private:
     const T base_data, const double back_time, const std::vector<T> & vec);
   DataStampedPtr getNearestTimeDataFromVec(
     DataStampedPtr base_data, const double back_time, const std::vector<DataStampedPtr> & vec);
-  double getAverage(const std::vector<double> & vec);
-  double getStandardDeviation(const std::vector<double> & vec);
   bool isTimeout(const builtin_interfaces::msg::Time & stamp, const double timeout_sec);
   bool isTimeout(const DataStampedPtr & data_stamped, const double timeout_sec);
 
@@ -785,10 +785,10 @@ void AccelBrakeMapCalibrator::executeUpdate(
   // add accel data to map
   accel_mode ? map_value_data_.at(getUnifiedIndexFromAccelBrakeIndex(true, accel_pedal_index))
                  .at(accel_vel_index)
-                 .emplace_back(measured_acc)
+                 .add(measured_acc)
              : map_value_data_.at(getUnifiedIndexFromAccelBrakeIndex(false, brake_pedal_index))
                  .at(brake_vel_index)
-                 .emplace_back(measured_acc);
+                 .add(measured_acc);
 }
 
 bool AccelBrakeMapCalibrator::updateEachValOffset(
@@ -921,20 +921,20 @@ void AccelBrakeMapCalibrator::executeEvaluation()
   const double full_orig_accel_sq_error = calculateAccelSquaredError(
     delayed_accel_pedal_ptr_->data, delayed_brake_pedal_ptr_->data, twist_ptr_->twist.linear.x,
     accel_map_, brake_map_);
-  pushDataToVec(full_orig_accel_sq_error, full_mse_que_size_, &full_original_accel_mse_que_);
-  full_original_accel_rmse_ = getAverage(full_original_accel_mse_que_);
+  full_original_accel_mse_que_.push(full_orig_accel_sq_error);
+  full_original_accel_rmse_ = full_original_accel_mse_que_.getAverage();
 
   const double part_orig_accel_sq_error = calculateAccelSquaredError(
     delayed_accel_pedal_ptr_->data, delayed_brake_pedal_ptr_->data, twist_ptr_->twist.linear.x,
     accel_map_, brake_map_);
-  pushDataToVec(part_orig_accel_sq_error, part_mse_que_size_, &part_original_accel_mse_que_);
-  part_original_accel_rmse_ = getAverage(part_original_accel_mse_que_);
+  part_original_accel_mse_que_.push(part_orig_accel_sq_error);
+  part_original_accel_rmse_ = part_original_accel_mse_que_.getAverage();
 
   const double new_accel_sq_error = calculateAccelSquaredError(
     delayed_accel_pedal_ptr_->data, delayed_brake_pedal_ptr_->data, twist_ptr_->twist.linear.x,
     new_accel_map_, new_brake_map_);
-  pushDataToVec(new_accel_sq_error, part_mse_que_size_, &new_accel_mse_que_);
-  new_accel_rmse_ = getAverage(new_accel_mse_que_);
+  new_accel_mse_que_.push(new_accel_sq_error);
+  new_accel_rmse_ = new_accel_mse_que_.getAverage();
 }
 
 double AccelBrakeMapCalibrator::calculateEstimatedAcc(
@@ -1018,34 +1018,6 @@ DataStampedPtr AccelBrakeMapCalibrator::getNearestTimeDataFromVec(
   return nearest_time_data;
 }
 
-double AccelBrakeMapCalibrator::getAverage(const std::vector<double> & vec)
-{
-  if (vec.empty()) {
-    return 0.0;
-  }
-
-  double sum = 0.0;
-  for (const auto num : vec) {
-    sum += num;
-  }
-  return sum / vec.size();
-}
-
-double AccelBrakeMapCalibrator::getStandardDeviation(const std::vector<double> & vec)
-{
-  if (vec.empty()) {
-    return 0.0;
-  }
-
-  const double ave = getAverage(vec);
-
-  double sum = 0.0;
-  for (const auto num : vec) {
-    sum += std::pow(num - ave, 2);
-  }
-  return std::sqrt(sum / vec.size());
-}
-
 bool AccelBrakeMapCalibrator::isTimeout(
   const builtin_interfaces::msg::Time & stamp, const double timeout_sec)
 {
@@ -1220,26 +1192,26 @@ void AccelBrakeMapCalibrator::publishCountMap()
 
   for (int i = 0; i < h; i++) {
     for (int j = 0; j < w; j++) {
-      const auto data_vec = map_value_data_.at(i).at(j);
-      if (data_vec.empty()) {
+      const auto & data_statistics = map_value_data_.at(i).at(j);
+      if (data_statistics.empty()) {
         // input *UNKNOWN* value
         count_map.at(i * w + j) = -1;
         ave_map.at(i * w + j) = -1;
       } else {
         const auto count_rate =
-          MAX_OCC_VALUE * (static_cast<double>(data_vec.size()) / max_data_count_);
+          MAX_OCC_VALUE * (static_cast<double>(data_statistics.count) / max_data_count_);
         count_map.at(i * w + j) = static_cast<int8_t>(
           std::max(std::min(static_cast<int>(MAX_OCC_VALUE), static_cast<int>(count_rate)), 0));
         // calculate average
         {
-          const double average = getAverage(data_vec);
+          const double average = data_statistics.mean;
           int8_t int_average = static_cast<uint8_t>(
             MAX_OCC_VALUE * ((average - min_accel_) / (max_accel_ - min_accel_)));
           ave_map.at(i * w + j) = std::max(std::min(MAX_OCC_VALUE, int_average), (int8_t)0);
         }
         // calculate standard deviation
         {
-          const double std_dev = getStandardDeviation(data_vec);
+          const double std_dev = data_statistics.getStandardDeviation();
           const double max_std_dev = 0.2;
           const double min_std_dev = 0.0;
           int8_t int_std_dev = static_cast<uint8_t>(
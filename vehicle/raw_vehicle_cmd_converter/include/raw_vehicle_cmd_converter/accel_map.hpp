@@ -16,11 +16,13 @@
 #define RAW_VEHICLE_CMD_CONVERTER__ACCEL_MAP_HPP_
 
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
+#include "raw_vehicle_cmd_converter/map_lookup_table.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -32,6 +34,17 @@ public:
   bool readAccelMapFromCSV(std::string csv_path);
   bool getThrottle(double acc, double vel, double & throttle);
   bool getAcceleration(double throttle, double vel, double & acc);
+  /**
+   * @brief getAcceleration() of each pair of the throttles and the velocities, on the lookup table
+   * if it is used
+   */
+  bool getAccelerations(
+    const std::vector<double> & throttles, const std::vector<double> & vels,
+    std::vector<double> & accs);
+  /**
+   * @brief Resample the read map on uniform grids for the queries, see MapLookupTable
+   */
+  bool useLookupTable(const size_t subdivision_num);
   std::vector<double> getVelIdx() { return vel_index_; }
   std::vector<double> getThrottleIdx() { return throttle_index_; }
   std::vector<std::vector<double>> getAccelMap() { return accel_map_; }
@@ -43,6 +56,7 @@ private:
   std::vector<double> vel_index_;
   std::vector<double> throttle_index_;
   std::vector<std::vector<double>> accel_map_;
+  std::shared_ptr<const MapLookupTable> lookup_table_;
 };
 }  // namespace raw_vehicle_cmd_converter
 
@@ -16,11 +16,13 @@
 #define RAW_VEHICLE_CMD_CONVERTER__BRAKE_MAP_HPP_
 
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
+#include "raw_vehicle_cmd_converter/map_lookup_table.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -32,6 +34,17 @@ public:
   bool readBrakeMapFromCSV(std::string csv_path);
   bool getBrake(double acc, double vel, double & brake);
   bool getAcceleration(double brake, double vel, double & acc);
+  /**
+   * @brief getAcceleration() of each pair of the brakes and the velocities, on the lookup table
+   * if it is used
+   */
+  bool getAccelerations(
+    const std::vector<double> & brakes, const std::vector<double> & vels,
+    std::vector<double> & accs);
+  /**
+   * @brief Resample the read map on uniform grids for the queries, see MapLookupTable
+   */
+  bool useLookupTable(const size_t subdivision_num);
   std::vector<double> getVelIdx() { return vel_index_; }
   std::vector<double> getBrakeIdx() { return brake_index_; }
   std::vector<std::vector<double>> getBrakeMap() { return brake_map_; }
@@ -44,6 +57,8 @@ private:
   std::vector<double> brake_index_;
   std::vector<double> brake_index_rev_;
   std::vector<std::vector<double>> brake_map_;
+  std::shared_ptr<const MapLookupTable> lookup_table_;
+  std::vector<double> lookup_table_brake_index_rev_;
 };
 }  // namespace raw_vehicle_cmd_converter
 
@@ -0,0 +1,76 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RAW_VEHICLE_CMD_CONVERTER__MAP_LOOKUP_TABLE_HPP_
+#define RAW_VEHICLE_CMD_CONVERTER__MAP_LOOKUP_TABLE_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace raw_vehicle_cmd_converter
+{
+/**
+ * @brief Values of a map on the velocity and pedal indices (e.g. the accelerations of the accel
+ * map), resampled once on uniform grids, so that the cells of a query are found in O(1) instead
+ * of the searches over the indices. The spacing of the grids is the smallest one of the indices
+ * divided by subdivision_num, and the values are interpolated bilinearly in them.
+ */
+class MapLookupTable
+{
+public:
+  MapLookupTable(
+    const std::vector<double> & vel_index, const std::vector<double> & pedal_index,
+    const std::vector<std::vector<double>> & map, const size_t subdivision_num);
+
+  /**
+   * @brief Pedal values on the uniform grid
+   */
+  const std::vector<double> & getPedalIndex() const { return pedal_index_; }
+
+  /**
+   * @brief Values of each pedal of getPedalIndex() at the velocity clamped to the map
+   */
+  void getValuesAtVelocity(const double vel, std::vector<double> & values) const;
+
+  /**
+   * @brief Value at the pedal and the velocity, which are clamped to the map
+   */
+  double getValue(const double pedal, const double vel) const;
+
+  /**
+   * @brief getValue() of each pair of the pedals and the velocities
+   */
+  void getValues(
+    const std::vector<double> & pedals, const std::vector<double> & vels,
+    std::vector<double> & values) const;
+
+private:
+  struct Axis
+  {
+    double min;
+    double resolution;
+    size_t num;
+  };
+
+  static Axis createAxis(const std::vector<double> & index, const size_t subdivision_num);
+  static size_t findCell(const Axis & axis, const double x, double & ratio);
+
+  Axis vel_axis_;
+  Axis pedal_axis_;
+  std::vector<double> pedal_index_;
+  std::vector<double> values_;  // values of the pedals for each velocity
+};
+}  // namespace raw_vehicle_cmd_converter
+
+#endif  // RAW_VEHICLE_CMD_CONVERTER__MAP_LOOKUP_TABLE_HPP_
@@ -16,10 +16,12 @@
 #define RAW_VEHICLE_CMD_CONVERTER__STEER_CONVERTER_HPP_
 
 #include "raw_vehicle_cmd_converter/csv_loader.hpp"
+#include "raw_vehicle_cmd_converter/map_lookup_table.hpp"
 #include "raw_vehicle_cmd_converter/pid.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -29,6 +31,10 @@ class SteerConverter
 {
 public:
   bool setFFMap(const std::string & csv_path);
+  /**
+   * @brief Resample the FF map on uniform grids for the queries, see MapLookupTable
+   */
+  bool useFFMapLookupTable(const size_t subdivision_num);
   void setFBGains(const double kp, const double ki, const double kd);
   bool setFBLimits(
     const double max_ret, const double min_ret, const double max_ret_p, const double min_ret_p,
@@ -47,6 +53,7 @@ private:
   std::vector<double> vel_index_;
   std::vector<double> output_index_;
   std::vector<std::vector<double>> steer_map_;
+  std::shared_ptr<const MapLookupTable> lookup_table_;
   PIDController pid_;
   bool ff_map_initialized_{false};
   bool fb_gains_initialized_{false};
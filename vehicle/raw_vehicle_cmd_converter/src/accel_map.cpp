@@ -18,6 +18,8 @@
 
 #include <algorithm>
 #include <chrono>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -40,6 +42,7 @@ bool AccelMap::readAccelMapFromCSV(std::string csv_path)
       logger_, "Cannot read %s. CSV file should have at least 2 column", csv_path.c_str());
     return false;
   }
+  lookup_table_.reset();
   vehicle_name_ = table[0][0];
   for (unsigned int i = 1; i < table[0].size(); i++) {
     vel_index_.push_back(std::stod(table[0][i]));
@@ -83,8 +86,13 @@ bool AccelMap::getThrottle(double acc, double vel, double & throttle)
   }
 
   // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accs : accel_map_) {
-    accs_interpolated.push_back(interpolation::lerp(vel_index_, accs, vel));
+  const auto & throttle_index = lookup_table_ ? lookup_table_->getPedalIndex() : throttle_index_;
+  if (lookup_table_) {
+    lookup_table_->getValuesAtVelocity(vel, accs_interpolated);
+  } else {
+    for (std::vector<double> accs : accel_map_) {
+      accs_interpolated.push_back(interpolation::lerp(vel_index_, accs, vel));
+    }
   }
 
   // calculate throttle
@@ -93,10 +101,10 @@ bool AccelMap::getThrottle(double acc, double vel, double & throttle)
   if (acc < accs_interpolated.front()) {
     return false;
   } else if (accs_interpolated.back() < acc) {
-    throttle = throttle_index_.back();
+    throttle = throttle_index.back();
     return true;
   }
-  throttle = interpolation::lerp(accs_interpolated, throttle_index_, acc);
+  throttle = interpolation::lerp(accs_interpolated, throttle_index, acc);
 
   return true;
 }
@@ -121,11 +129,6 @@ bool AccelMap::getAcceleration(double throttle, double vel, double & acc)
     vel = vel_index_.back();
   }
 
-  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accs : accel_map_) {
-    accs_interpolated.push_back(interpolation::lerp(vel_index_, accs, vel));
-  }
-
   // calculate throttle
   // When the desired acceleration is smaller than the throttle area, return false => brake sequence
   // When the desired acceleration is greater than the throttle area, return max throttle
@@ -137,8 +140,59 @@ bool AccelMap::getAcceleration(double throttle, double vel, double & acc)
     throttle = std::min(std::max(throttle, min_throttle), max_throttle);
   }
 
+  if (lookup_table_) {
+    acc = lookup_table_->getValue(throttle, vel);
+    return true;
+  }
+
+  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
+  for (std::vector<double> accs : accel_map_) {
+    accs_interpolated.push_back(interpolation::lerp(vel_index_, accs, vel));
+  }
+
   acc = interpolation::lerp(throttle_index_, accs_interpolated, throttle);
 
   return true;
 }
+
+bool AccelMap::getAccelerations(
+  const std::vector<double> & throttles, const std::vector<double> & vels,
+  std::vector<double> & accs)
+{
+  if (throttles.size() != vels.size()) {
+    RCLCPP_ERROR(logger_, "The size of throttles and vels are not the same.");
+    return false;
+  }
+
+  // the queries are clamped to the map without the warnings
+  if (lookup_table_) {
+    lookup_table_->getValues(throttles, vels, accs);
+    return true;
+  }
+
+  accs.resize(throttles.size());
+  for (size_t i = 0; i < throttles.size(); ++i) {
+    const double vel = std::clamp(vels.at(i), vel_index_.front(), vel_index_.back());
+    const double throttle =
+      std::clamp(throttles.at(i), throttle_index_.front(), throttle_index_.back());
+    std::vector<double> accs_interpolated;
+    for (const auto & accs_at_throttle : accel_map_) {
+      accs_interpolated.push_back(interpolation::lerp(vel_index_, accs_at_throttle, vel));
+    }
+    accs.at(i) = interpolation::lerp(throttle_index_, accs_interpolated, throttle);
+  }
+  return true;
+}
+
+bool AccelMap::useLookupTable(const size_t subdivision_num)
+{
+  try {
+    lookup_table_ =
+      std::make_shared<MapLookupTable>(vel_index_, throttle_index_, accel_map_, subdivision_num);
+  } catch (const std::invalid_argument & e) {
+    RCLCPP_ERROR(logger_, "Cannot create the lookup table of the accel map: %s", e.what());
+    return false;
+  }
+  return true;
+}
 }  // namespace raw_vehicle_cmd_converter
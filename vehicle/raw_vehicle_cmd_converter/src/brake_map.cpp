@@ -17,6 +17,8 @@
 #include "interpolation/linear_interpolation.hpp"
 
 #include <algorithm>
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -38,6 +40,7 @@ bool BrakeMap::readBrakeMapFromCSV(std::string csv_path)
     return false;
   }
 
+  lookup_table_.reset();
   vehicle_name_ = table[0][0];
   for (unsigned int i = 1; i < table[0].size(); i++) {
     vel_index_.push_back(std::stod(table[0][i]));
@@ -84,8 +87,13 @@ bool BrakeMap::getBrake(double acc, double vel, double & brake)
   }
 
   // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accs : brake_map_) {
-    accs_interpolated.push_back(interpolation::lerp(vel_index_, accs, vel));
+  const auto & brake_index_rev = lookup_table_ ? lookup_table_brake_index_rev_ : brake_index_rev_;
+  if (lookup_table_) {
+    lookup_table_->getValuesAtVelocity(vel, accs_interpolated);
+  } else {
+    for (std::vector<double> accs : brake_map_) {
+      accs_interpolated.push_back(interpolation::lerp(vel_index_, accs, vel));
+    }
   }
 
   // calculate brake
@@ -105,7 +113,7 @@ bool BrakeMap::getBrake(double acc, double vel, double & brake)
   }
 
   std::reverse(std::begin(accs_interpolated), std::end(accs_interpolated));
-  brake = interpolation::lerp(accs_interpolated, brake_index_rev_, acc);
+  brake = interpolation::lerp(accs_interpolated, brake_index_rev, acc);
 
   return true;
 }
@@ -130,11 +138,6 @@ bool BrakeMap::getAcceleration(double brake, double vel, double & acc)
     vel = vel_index_.back();
   }
 
-  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
-  for (std::vector<double> accs : brake_map_) {
-    accs_interpolated.push_back(interpolation::lerp(vel_index_, accs, vel));
-  }
-
   // calculate brake
   // When the desired acceleration is smaller than the brake area, return max brake on the map
   // When the desired acceleration is greater than the brake area, return min brake on the map
@@ -146,8 +149,60 @@ bool BrakeMap::getAcceleration(double brake, double vel, double & acc)
     brake = std::min(std::max(brake, min_brake), max_brake);
   }
 
+  if (lookup_table_) {
+    acc = lookup_table_->getValue(brake, vel);
+    return true;
+  }
+
+  // (throttle, vel, acc) map => (throttle, acc) map by fixing vel
+  for (std::vector<double> accs : brake_map_) {
+    accs_interpolated.push_back(interpolation::lerp(vel_index_, accs, vel));
+  }
+
   acc = interpolation::lerp(brake_index_, accs_interpolated, brake);
 
   return true;
 }
+
+bool BrakeMap::getAccelerations(
+  const std::vector<double> & brakes, const std::vector<double> & vels, std::vector<double> & accs)
+{
+  if (brakes.size() != vels.size()) {
+    RCLCPP_ERROR(logger_, "The size of brakes and vels are not the same.");
+    return false;
+  }
+
+  // the queries are clamped to the map without the warnings
+  if (lookup_table_) {
+    lookup_table_->getValues(brakes, vels, accs);
+    return true;
+  }
+
+  accs.resize(brakes.size());
+  for (size_t i = 0; i < brakes.size(); ++i) {
+    const double vel = std::clamp(vels.at(i), vel_index_.front(), vel_index_.back());
+    const double brake = std::clamp(brakes.at(i), brake_index_.front(), brake_index_.back());
+    std::vector<double> accs_interpolated;
+    for (const auto & accs_at_brake : brake_map_) {
+      accs_interpolated.push_back(interpolation::lerp(vel_index_, accs_at_brake, vel));
+    }
+    accs.at(i) = interpolation::lerp(brake_index_, accs_interpolated, brake);
+  }
+  return true;
+}
+
+bool BrakeMap::useLookupTable(const size_t subdivision_num)
+{
+  try {
+    lookup_table_ =
+      std::make_shared<MapLookupTable>(vel_index_, brake_index_, brake_map_, subdivision_num);
+  } catch (const std::invalid_argument & e) {
+    RCLCPP_ERROR(logger_, "Cannot create the lookup table of the brake map: %s", e.what());
+    return false;
+  }
+  lookup_table_brake_index_rev_ = lookup_table_->getPedalIndex();
+  std::reverse(
+    std::begin(lookup_table_brake_index_rev_), std::end(lookup_table_brake_index_rev_));
+  return true;
+}
 }  // namespace raw_vehicle_cmd_converter
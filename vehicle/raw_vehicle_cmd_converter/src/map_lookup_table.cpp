@@ -0,0 +1,144 @@
+// Copyright 2022 Tier IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "raw_vehicle_cmd_converter/map_lookup_table.hpp"
+
+#include "interpolation/linear_interpolation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+// limit of the number of the grid points of an axis, e.g. for an index with close values
+constexpr size_t max_grid_num = 1000;
+}  // namespace
+
+namespace raw_vehicle_cmd_converter
+{
+MapLookupTable::MapLookupTable(
+  const std::vector<double> & vel_index, const std::vector<double> & pedal_index,
+  const std::vector<std::vector<double>> & map, const size_t subdivision_num)
+{
+  if (subdivision_num == 0) {
+    throw std::invalid_argument("subdivision_num must be positive.");
+  }
+  if (map.size() != pedal_index.size()) {
+    throw std::invalid_argument("The size of the map and pedal_index are not the same.");
+  }
+
+  vel_axis_ = createAxis(vel_index, subdivision_num);
+  pedal_axis_ = createAxis(pedal_index, subdivision_num);
+
+  pedal_index_.reserve(pedal_axis_.num);
+  for (size_t i = 0; i < pedal_axis_.num; ++i) {
+    pedal_index_.push_back(
+      i + 1 == pedal_axis_.num ? pedal_index.back()
+                               : pedal_axis_.min + pedal_axis_.resolution * static_cast<double>(i));
+  }
+
+  // as the queries on the original map: fix the velocity, and then interpolate by the pedal
+  values_.reserve(vel_axis_.num * pedal_axis_.num);
+  std::vector<double> values_at_vel(map.size());
+  for (size_t i = 0; i < vel_axis_.num; ++i) {
+    const double vel = i + 1 == vel_axis_.num
+                         ? vel_index.back()
+                         : vel_axis_.min + vel_axis_.resolution * static_cast<double>(i);
+    for (size_t j = 0; j < map.size(); ++j) {
+      values_at_vel.at(j) = interpolation::lerp(vel_index, map.at(j), vel);
+    }
+    const auto values = interpolation::lerp(pedal_index, values_at_vel, pedal_index_);
+    values_.insert(values_.end(), values.begin(), values.end());
+  }
+}
+
+void MapLookupTable::getValuesAtVelocity(const double vel, std::vector<double> & values) const
+{
+  double ratio;
+  const auto i = findCell(vel_axis_, vel, ratio);
+  const auto * src = values_.data() + i * pedal_axis_.num;
+  const auto * dst = src + pedal_axis_.num;
+
+  values.resize(pedal_axis_.num);
+  for (size_t j = 0; j < pedal_axis_.num; ++j) {
+    values[j] = src[j] + (dst[j] - src[j]) * ratio;
+  }
+}
+
+double MapLookupTable::getValue(const double pedal, const double vel) const
+{
+  double vel_ratio;
+  double pedal_ratio;
+  const auto i = findCell(vel_axis_, vel, vel_ratio);
+  const auto j = findCell(pedal_axis_, pedal, pedal_ratio);
+
+  const auto * src = values_.data() + i * pedal_axis_.num + j;
+  const auto * dst = src + pedal_axis_.num;
+  const double src_value = src[0] + (src[1] - src[0]) * pedal_ratio;
+  const double dst_value = dst[0] + (dst[1] - dst[0]) * pedal_ratio;
+  return src_value + (dst_value - src_value) * vel_ratio;
+}
+
+void MapLookupTable::getValues(
+  const std::vector<double> & pedals, const std::vector<double> & vels,
+  std::vector<double> & values) const
+{
+  if (pedals.size() != vels.size()) {
+    throw std::invalid_argument("The size of pedals and vels are not the same.");
+  }
+
+  values.resize(pedals.size());
+  for (size_t i = 0; i < pedals.size(); ++i) {
+    values[i] = getValue(pedals[i], vels[i]);
+  }
+}
+
+MapLookupTable::Axis MapLookupTable::createAxis(
+  const std::vector<double> & index, const size_t subdivision_num)
+{
+  if (index.size() < 2) {
+    throw std::invalid_argument("The size of the index is less than 2.");
+  }
+
+  double min_interval = index.at(1) - index.at(0);
+  for (size_t i = 1; i + 1 < index.size(); ++i) {
+    min_interval = std::min(min_interval, index.at(i + 1) - index.at(i));
+  }
+  if (min_interval <= 0.0) {
+    throw std::invalid_argument("The index is not sorted.");
+  }
+
+  const double length = index.back() - index.front();
+  const auto interval_num = std::min(
+    static_cast<size_t>(std::ceil(length / min_interval - 1e-6)) * subdivision_num,
+    max_grid_num - 1);
+
+  Axis axis;
+  axis.min = index.front();
+  axis.resolution = length / static_cast<double>(interval_num);
+  axis.num = interval_num + 1;
+  return axis;
+}
+
+size_t MapLookupTable::findCell(const Axis & axis, const double x, double & ratio)
+{
+  const double s =
+    std::clamp((x - axis.min) / axis.resolution, 0.0, static_cast<double>(axis.num - 1));
+  const auto i = std::min(static_cast<size_t>(s), axis.num - 2);
+  ratio = s - static_cast<double>(i);
+  return i;
+}
+}  // namespace raw_vehicle_cmd_converter
@@ -37,6 +37,9 @@ RawVehicleCommandConverterNode::RawVehicleCommandConverterNode(
   max_steer_cmd_ = declare_parameter("max_steer", 10.0);
   min_steer_cmd_ = declare_parameter("min_steer", -10.0);
   is_debugging_ = declare_parameter("is_debugging", false);
+  const auto use_map_lookup_table = declare_parameter("use_map_lookup_table", false);
+  const auto map_lookup_table_subdivision_num =
+    static_cast<size_t>(declare_parameter("map_lookup_table_subdivision_num", 4));
   // for steering steer controller
   use_steer_ff_ = declare_parameter("use_steer_ff", true);
   use_steer_fb_ = declare_parameter("use_steer_fb", true);
@@ -60,6 +63,8 @@ RawVehicleCommandConverterNode::RawVehicleCommandConverterNode(
         get_logger(), "Cannot read accelmap. csv path = %s. stop calculation.",
         csv_path_accel_map.c_str());
       ff_map_initialized_ = false;
+    } else if (use_map_lookup_table) {
+      ff_map_initialized_ &= accel_map_.useLookupTable(map_lookup_table_subdivision_num);
     }
   }
   if (convert_brake_cmd_) {
@@ -68,6 +73,8 @@ RawVehicleCommandConverterNode::RawVehicleCommandConverterNode(
         get_logger(), "Cannot read brakemap. csv path = %s. stop calculation.",
         csv_path_brake_map.c_str());
       ff_map_initialized_ = false;
+    } else if (use_map_lookup_table) {
+      ff_map_initialized_ &= brake_map_.useLookupTable(map_lookup_table_subdivision_num);
     }
   }
   if (convert_steer_cmd_) {
@@ -77,6 +84,9 @@ RawVehicleCommandConverterNode::RawVehicleCommandConverterNode(
         get_logger(), "Cannot read steer map. csv path = %s. stop calculation.",
         csv_path_steer_map.c_str());
       ff_map_initialized_ = false;
+    } else if (use_map_lookup_table) {
+      ff_map_initialized_ &=
+        steer_controller_.useFFMapLookupTable(map_lookup_table_subdivision_num);
     }
     steer_controller_.setFBGains(kp_steer, ki_steer, kd_steer);
     steer_controller_.setFBLimits(
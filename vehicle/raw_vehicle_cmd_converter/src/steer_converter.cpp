@@ -16,6 +16,8 @@
 
 #include "interpolation/linear_interpolation.hpp"
 
+#include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -26,10 +28,23 @@ bool SteerConverter::setFFMap(const std::string & csv_path)
   if (!readSteerMapFromCSV(csv_path, vehicle_name_, vel_index_, output_index_, steer_map_)) {
     return false;
   }
+  lookup_table_.reset();
   ff_map_initialized_ = true;
   return true;
 }
 
+bool SteerConverter::useFFMapLookupTable(const size_t subdivision_num)
+{
+  try {
+    lookup_table_ =
+      std::make_shared<MapLookupTable>(vel_index_, output_index_, steer_map_, subdivision_num);
+  } catch (const std::invalid_argument & e) {
+    RCLCPP_ERROR(logger_, "Cannot create the lookup table of the steer map: %s", e.what());
+    return false;
+  }
+  return true;
+}
+
 void SteerConverter::setFBGains(const double kp, const double ki, const double kd)
 {
   pid_.setGains(kp, ki, kd);
@@ -154,15 +169,20 @@ void SteerConverter::calcFFMap(double steer_vel, double vehicle_vel, double & ou
     vehicle_vel = vel_index_.back();
   }
 
-  for (std::vector<double> steer_angle_velocities : steer_map_) {
-    steer_angle_velocities_interp.push_back(
-      interpolation::lerp(vel_index_, steer_angle_velocities, vehicle_vel));
+  const auto & output_index = lookup_table_ ? lookup_table_->getPedalIndex() : output_index_;
+  if (lookup_table_) {
+    lookup_table_->getValuesAtVelocity(vehicle_vel, steer_angle_velocities_interp);
+  } else {
+    for (std::vector<double> steer_angle_velocities : steer_map_) {
+      steer_angle_velocities_interp.push_back(
+        interpolation::lerp(vel_index_, steer_angle_velocities, vehicle_vel));
+    }
   }
   if (steer_vel < steer_angle_velocities_interp.front()) {
     steer_vel = steer_angle_velocities_interp.front();
   } else if (steer_angle_velocities_interp.back() < steer_vel) {
     steer_vel = steer_angle_velocities_interp.back();
   }
-  output = interpolation::lerp(steer_angle_velocities_interp, output_index_, steer_vel);
+  output = interpolation::lerp(steer_angle_velocities_interp, output_index, steer_vel);
 }
 }  // namespace raw_vehicle_cmd_converter
@@ -19,6 +19,7 @@
 #include "raw_vehicle_cmd_converter/steer_converter.hpp"
 
 #include <cmath>
+#include <vector>
 
 /*
  * Throttle data: (vel, throttle -> acc)
@@ -163,3 +164,78 @@ TEST(ConverterTests, SteerMapCalculation)
   // case for interpolation
   EXPECT_DOUBLE_EQ(calcSteer(5.0, 5.0), 5.0);
 }
+
+TEST(ConverterTests, LookupTableCalculation)
+{
+  // the indices of the test maps are evenly spaced, so that the lookup tables give the same values
+  AccelMap accel_map;
+  loadAccelMapData(accel_map);
+  AccelMap accel_map_lut;
+  loadAccelMapData(accel_map_lut);
+  ASSERT_TRUE(accel_map_lut.useLookupTable(4));
+
+  BrakeMap brake_map;
+  loadBrakeMapData(brake_map);
+  BrakeMap brake_map_lut;
+  loadBrakeMapData(brake_map_lut);
+  ASSERT_TRUE(brake_map_lut.useLookupTable(4));
+
+  SteerConverter steer_map;
+  loadSteerMapData(steer_map);
+  SteerConverter steer_map_lut;
+  loadSteerMapData(steer_map_lut);
+  ASSERT_TRUE(steer_map_lut.useFFMapLookupTable(4));
+
+  std::vector<double> pedals;
+  std::vector<double> vels;
+  for (double vel = -1.0; vel <= 21.0; vel += 0.7) {
+    for (double pedal = -0.1; pedal <= 1.1; pedal += 0.03) {
+      pedals.push_back(pedal);
+      vels.push_back(vel);
+
+      double expected;
+      double actual;
+      EXPECT_EQ(
+        accel_map.getAcceleration(pedal, vel, expected),
+        accel_map_lut.getAcceleration(pedal, vel, actual));
+      EXPECT_NEAR(expected, actual, 1e-9);
+      EXPECT_EQ(
+        brake_map.getAcceleration(pedal, vel, expected),
+        brake_map_lut.getAcceleration(pedal, vel, actual));
+      EXPECT_NEAR(expected, actual, 1e-9);
+
+      const double acc = 50.0 * pedal - 2.0;
+      if (accel_map.getThrottle(acc, vel, expected)) {
+        ASSERT_TRUE(accel_map_lut.getThrottle(acc, vel, actual));
+        EXPECT_NEAR(expected, actual, 1e-9);
+      }
+      EXPECT_EQ(brake_map.getBrake(-acc, vel, expected), brake_map_lut.getBrake(-acc, vel, actual));
+      EXPECT_NEAR(expected, actual, 1e-9);
+
+      const double steer = vel - 10.0;
+      const double steer_vel = 25.0 * pedal - 12.5;
+      EXPECT_NEAR(
+        steer_map.calcFFSteer(steer_vel, steer), steer_map_lut.calcFFSteer(steer_vel, steer), 1e-9);
+    }
+  }
+
+  // batch queries
+  std::vector<double> expected_accs;
+  std::vector<double> actual_accs;
+  ASSERT_TRUE(accel_map.getAccelerations(pedals, vels, expected_accs));
+  ASSERT_TRUE(accel_map_lut.getAccelerations(pedals, vels, actual_accs));
+  ASSERT_EQ(expected_accs.size(), pedals.size());
+  ASSERT_EQ(actual_accs.size(), pedals.size());
+  for (size_t i = 0; i < pedals.size(); ++i) {
+    double acc;
+    accel_map.getAcceleration(pedals.at(i), vels.at(i), acc);
+    EXPECT_DOUBLE_EQ(expected_accs.at(i), acc);
+    EXPECT_NEAR(actual_accs.at(i), acc, 1e-9);
+  }
+  ASSERT_TRUE(brake_map.getAccelerations(pedals, vels, expected_accs));
+  ASSERT_TRUE(brake_map_lut.getAccelerations(pedals, vels, actual_accs));
+  for (size_t i = 0; i < pedals.size(); ++i) {
+    EXPECT_NEAR(expected_accs.at(i), actual_accs.at(i), 1e-9);
+  }
+  EXPECT_FALSE(accel_map.getAccelerations(pedals, {}, actual_accs));
+}